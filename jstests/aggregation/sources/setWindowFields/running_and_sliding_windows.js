@@ -0,0 +1,75 @@
+/**
+ * Tests that $setWindowFields computes running and sliding accumulators over the documents of each
+ * partition, in the order of its 'sortBy' fields, whether or not its sort is provided by an index
+ * or coalesced with an earlier $sort.
+ */
+(function() {
+"use strict";
+
+const coll = db.set_window_fields_running_and_sliding;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 200; i++) {
+    docs.push({_id: i, p: i % 3, t: (i * 37) % 200, x: i % 7});
+}
+assert.commandWorked(coll.insert(docs));
+
+const output = {
+    total: {$sum: "$x"},
+    count: {$sum: 1},
+    avg: {$avg: "$x", window: {documents: [-2, 2]}},
+    low: {$min: "$x", window: {documents: [-1, "current"]}},
+    next: {$push: "$x", window: {documents: [1, 2]}},
+};
+
+// Computes the expected results of the window fields above, in partition and 'sortBy' order.
+function computeExpected() {
+    const expected = [];
+    for (const p of [0, 1, 2]) {
+        const partition = docs.filter(doc => doc.p === p).sort((a, b) => a.t - b.t);
+        const xs = partition.map(doc => doc.x);
+        const window = (i, lower, upper) =>
+            xs.slice(Math.max(i + lower, 0), Math.max(Math.min(i + upper + 1, xs.length), 0));
+        partition.forEach((doc, i) => {
+            const avgWindow = window(i, -2, 2);
+            expected.push(Object.assign({}, doc, {
+                total: window(i, -i, 0).reduce((a, b) => a + b, 0),
+                count: i + 1,
+                avg: avgWindow.reduce((a, b) => a + b, 0) / avgWindow.length,
+                low: Math.min(...window(i, -1, 0)),
+                next: window(i, 1, 2),
+            }));
+        });
+    }
+    return expected;
+}
+
+const expected = computeExpected();
+const setWindowFields = {$setWindowFields: {partitionBy: "$p", sortBy: {t: 1}, output: output}};
+assert.eq(expected, coll.aggregate([setWindowFields]).toArray());
+
+// The sort of the stage coalesces with an earlier $sort, and can be answered by an index.
+assert.eq(expected, coll.aggregate([{$sort: {x: -1}}, setWindowFields]).toArray());
+assert.commandWorked(coll.createIndex({p: 1, t: 1}));
+assert.eq(expected, coll.aggregate([setWindowFields]).toArray());
+
+// Without 'partitionBy', the whole input is a single partition.
+const running =
+    coll.aggregate([
+            {$setWindowFields: {sortBy: {_id: 1}, output: {total: {$sum: "$x"}}}},
+            {$project: {total: 1}},
+        ])
+        .toArray();
+let total = 0;
+assert.eq(docs.map(doc => ({_id: doc._id, total: (total += doc.x)})), running);
+
+// A window can't extend to the end of its partition.
+const unboundedWindow = {documents: ["current", "unbounded"]};
+const res = db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{$setWindowFields: {output: {total: {$sum: "$x", window: unboundedWindow}}}}],
+    cursor: {},
+});
+assert.commandFailedWithCode(res, 5190318);
+}());
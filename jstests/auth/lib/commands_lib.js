@@ -4731,6 +4731,56 @@ var authCommandsLib = {
               },
           ]
         },
+        {
+          testname: "planCacheRestore",
+          command: {planCacheRestore: "x"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.x.save({}));
+          },
+          teardown: function(db) {
+              db.x.drop();
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+          ]
+        },
+        {
+          testname: "planCacheSnapshot",
+          command: {planCacheSnapshot: "x"},
+          skipSharded: true,
+          setup: function(db) {
+              assert.writeOK(db.x.save({}));
+          },
+          teardown: function(db) {
+              db.x.drop();
+          },
+          testcases: [
+              {
+                runOnDb: firstDbName,
+                roles: roles_dbAdmin,
+                privileges:
+                    [{resource: {db: firstDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+              {
+                runOnDb: secondDbName,
+                roles: roles_dbAdminAny,
+                privileges:
+                    [{resource: {db: secondDbName, collection: "x"}, actions: ["planCacheWrite"]}],
+              },
+          ]
+        },
         {
           testname: "ping",
           command: {ping: 1},
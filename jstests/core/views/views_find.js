@@ -114,9 +114,7 @@ assertFindResultEq({find: "identityView", filter: {state: "NY"}, singleBatch: tr
 assert.eq(viewsDB.identityView.findOne({_id: "San Francisco"}),
           {_id: "San Francisco", state: "CA", pop: 4});
 
-// The readOnce cursor option is not allowed on views.  But if we're in a transaction,
-// the error code saying that it's not allowed in a transaction takes precedence.
-assert.commandFailedWithCode(
-    viewsDB.runCommand({find: "identityView", readOnce: true}),
-    [ErrorCodes.OperationNotSupportedInTransaction, ErrorCodes.InvalidPipelineOperator]);
+// The readOnce cursor option is allowed on views, unless we're in a transaction.
+assert.commandWorkedOrFailedWithCode(viewsDB.runCommand({find: "identityView", readOnce: true}),
+                                     ErrorCodes.OperationNotSupportedInTransaction);
 }());
@@ -0,0 +1,43 @@
+/**
+ * Tests that aggregations return the same results when they reuse the buffers of the documents
+ * they free, including across getMores and when documents are kept by blocking stages.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.aggregate_document_buffer_cache;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 500; i++) {
+    docs.push({_id: i, a: i % 11, arr: [i, i + 1, {x: i}], sub: {b: i, c: "str" + i}});
+}
+assert.commandWorked(coll.insert(docs));
+
+function runAggregate(pipeline, enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableDocumentBufferCache: enabled}));
+    return coll.aggregate(pipeline, {cursor: {batchSize: 7}}).toArray();
+}
+
+const pipelines = [
+    [{$project: {a: 1, "sub.b": 1, total: {$add: ["$a", "$sub.b"]}}}],
+    [{$addFields: {d: {$concat: ["$sub.c", "-x"]}, "sub.e": "$a"}}, {$project: {arr: 0}}],
+    [{$unwind: {path: "$arr", includeArrayIndex: "idx"}}, {$addFields: {y: "$idx"}}],
+    [
+        {$unwind: "$arr"},
+        {$project: {a: 1, arr: 1}},
+        {$group: {_id: "$a", vals: {$push: "$arr"}, n: {$sum: 1}}},
+        {$sort: {_id: 1}},
+    ],
+    [{$addFields: {big: {$range: [0, 50]}}}, {$sort: {a: -1, _id: 1}}, {$limit: 100}],
+];
+for (const pipeline of pipelines.map(p => [{$sort: {_id: 1}}, ...p])) {
+    assert.eq(runAggregate(pipeline, false), runAggregate(pipeline, true), tojson(pipeline));
+}
+
+MongoRunner.stopMongod(conn);
+}());
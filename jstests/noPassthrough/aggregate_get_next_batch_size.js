@@ -0,0 +1,45 @@
+/**
+ * Tests that aggregations return the same results whether their stages pass documents to each other
+ * one at a time or in batches.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.aggregate_get_next_batch_size;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i % 7, b: i % 3, arr: [i, i + 1], str: "str" + (i % 11)});
+}
+assert.commandWorked(coll.insert(docs));
+
+function runAggregate(pipeline, batchSize) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalDocumentSourceGetNextBatchSize: batchSize}));
+    return coll.aggregate(pipeline, {cursor: {batchSize: 13}}).toArray();
+}
+
+const pipelines = [
+    [{$match: {b: 1}}, {$project: {a: 1, total: {$add: ["$a", "$b"]}}}, {$sort: {_id: 1}}],
+    [
+        {$match: {a: {$gt: 2}}},
+        {$addFields: {c: {$concat: ["$str", "-c"]}}},
+        {$sort: {c: 1, _id: -1}},
+    ],
+    [{$match: {b: {$ne: 2}}}, {$group: {_id: "$a", n: {$sum: 1}, ids: {$max: "$_id"}}}],
+    [{$unwind: "$arr"}, {$match: {arr: {$mod: [5, 0]}}}, {$group: {_id: "$str", n: {$sum: 1}}}],
+    [{$project: {a: 1}}, {$sort: {a: 1, _id: 1}}, {$limit: 50}],
+    [{$match: {_id: {$lt: 0}}}, {$group: {_id: null, n: {$sum: 1}}}],
+];
+for (const pipeline of pipelines) {
+    const batched = runAggregate(pipeline, 128);
+    assert.sameMembers(runAggregate(pipeline, 1), batched, tojson(pipeline));
+    assert.sameMembers(runAggregate(pipeline, 5), batched, tojson(pipeline));
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,38 @@
+/**
+ * Tests that the background compaction monitor compacts a collection with reusable space and
+ * reports its progress in serverStatus.
+ *
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({setParameter: {backgroundCompactionSleepSecs: 1}});
+const db = conn.getDB("test");
+const coll = db.background_compaction;
+
+const bigString = "x".repeat(1024);
+const docs = [];
+for (let i = 0; i < 10000; i++) {
+    docs.push({_id: i, s: bigString});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.remove({_id: {$gte: 1000}}));
+assert.commandWorked(db.adminCommand({fsync: 1}));
+
+const metrics = () => db.serverStatus().metrics.backgroundCompaction;
+assert.eq(0, metrics().collectionsCompacted);
+
+assert.commandWorked(db.adminCommand({
+    setParameter: 1,
+    backgroundCompactionMinFreeBytes: 1,
+    backgroundCompactionEnabled: true,
+}));
+
+assert.soon(() => metrics().collectionsCompacted >= 1, () => tojson(metrics()));
+checkLog.containsJson(conn, 5191187, {namespace: coll.getFullName()});
+assert.eq(0, metrics().failures, metrics());
+assert.eq(1000, coll.find().itcount());
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,42 @@
+/**
+ * Tests that the checkpoint thread reports its checkpoints, applies an I/O budget to them and takes
+ * an early checkpoint once the cache is dirty enough.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod(
+    {syncdelay: 3600, setParameter: {wiredTigerCheckpointIOBudgetMBPerSec: 50}});
+const db = conn.getDB('test');
+const coll = db.checkpoint_pacing;
+
+function checkpointMetrics() {
+    return db.serverStatus().metrics.storage.checkpoints;
+}
+
+const pacing = db.serverStatus().wiredTiger['checkpoint pacing'];
+assert.eq(pacing['io budget MB per second'], 50, tojson(pacing));
+
+// With a long syncdelay, only the dirty cache trigger can start a checkpoint.
+const before = checkpointMetrics();
+const payload = 'x'.repeat(1024 * 1024);
+for (let i = 0; i < 20; ++i) {
+    assert.commandWorked(coll.insert({_id: i, payload: payload}));
+}
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, checkpointDirtyCacheTriggerFraction: 0.0001}));
+
+assert.soon(() => checkpointMetrics().triggeredByDirtyCache > before.triggeredByDirtyCache,
+            () => tojson(checkpointMetrics()));
+assert.soon(() => checkpointMetrics().count > before.count, () => tojson(checkpointMetrics()));
+
+assert.commandWorked(db.adminCommand({setParameter: 1, checkpointDirtyCacheTriggerFraction: 0}));
+assert.soon(() => {
+    const stats = db.serverStatus().wiredTiger['checkpoint pacing'];
+    return stats['total checkpoint bytes written'] > 0;
+}, () => tojson(db.serverStatus().wiredTiger['checkpoint pacing']));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,84 @@
+/**
+ * Tests that a collection created with {clusteredIndex: true} keys its records by their integral
+ * _id without a separate _id index, keeps _id unique, finds documents by _id with a single seek,
+ * and is replicated.
+ * @tags: [requires_replication, requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+let primary = rst.getPrimary();
+let db = primary.getDB("test");
+const collName = "clustered_collection";
+
+// Clustered collections can't be capped, or have a separate _id index.
+assert.commandFailedWithCode(
+    db.createCollection("capped", {clusteredIndex: true, capped: true, size: 4096}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    db.createCollection("autoIndexId", {clusteredIndex: true, autoIndexId: true}),
+    ErrorCodes.InvalidOptions);
+
+assert.commandWorked(db.createCollection(collName, {clusteredIndex: true}));
+let coll = db[collName];
+assert.eq(true, db.getCollectionInfos({name: collName})[0].options.clusteredIndex);
+assert.eq([], coll.getIndexes());
+assert.commandFailedWithCode(coll.createIndex({_id: 1}), ErrorCodes.CannotCreateIndex);
+
+const docs = [];
+for (let i = 1; i <= 100; i++) {
+    docs.push({_id: i, x: i % 10});
+}
+assert.commandWorked(coll.insert(docs));
+
+// The _id must be unique, and integral.
+assert.commandFailedWithCode(coll.insert({_id: 5}), ErrorCodes.DuplicateKey);
+assert.commandFailedWithCode(coll.insert({_id: NumberLong(5)}), ErrorCodes.DuplicateKey);
+assert.commandFailedWithCode(coll.insert({x: 1}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.insert({_id: 1.5}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(coll.insert({_id: "a"}), ErrorCodes.BadValue);
+assert.eq(100, coll.find().itcount());
+
+// A lookup by _id examines a single document.
+assert.eq({_id: 42, x: 2}, coll.findOne({_id: 42}));
+assert.eq({_id: 42, x: 2}, coll.findOne({_id: NumberLong(42), x: 2}));
+assert.eq(null, coll.findOne({_id: 42, x: 3}));
+assert.eq(null, coll.findOne({_id: 1000}));
+const explain = coll.find({_id: 42}).explain("executionStats");
+assert.eq(1, explain.executionStats.totalDocsExamined, explain);
+assert.eq(NumberLong(42), explain.queryPlanner.winningPlan.minRecord, explain);
+
+// Other predicates on _id, and secondary indexes, still work.
+assert.eq(10, coll.find({_id: {$gt: 90}}).itcount());
+assert.eq(10, coll.find({_id: {$in: [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]}}).itcount());
+assert.commandWorked(coll.createIndex({x: 1}));
+assert.eq(10, coll.find({x: 3}).itcount());
+assert.eq({_id: 43, x: 3}, coll.findOne({_id: 43, x: 3}));
+
+// Updates and deletes by _id.
+assert.commandWorked(coll.update({_id: 7}, {$set: {y: 1}}));
+assert.eq({_id: 7, x: 7, y: 1}, coll.findOne({_id: 7}));
+assert.commandWorked(coll.update({_id: 200}, {$set: {x: 0}}, {upsert: true}));
+assert.eq({_id: 200, x: 0}, coll.findOne({_id: 200}));
+assert.commandWorked(coll.remove({_id: 8}));
+assert.eq(null, coll.findOne({_id: 8}));
+assert.commandWorked(coll.insert({_id: 8, x: 80}));
+
+rst.awaitReplication();
+assert.eq(coll.find().sort({_id: 1}).toArray(),
+          rst.getSecondary().getDB("test")[collName].find().sort({_id: 1}).toArray());
+
+// The collection is clustered after a restart.
+rst.restart(primary);
+primary = rst.getPrimary();
+db = primary.getDB("test");
+coll = db[collName];
+assert.eq({_id: 8, x: 80}, coll.findOne({_id: 8}));
+assert.commandFailedWithCode(coll.insert({_id: 8}), ErrorCodes.DuplicateKey);
+
+rst.stopSet();
+}());
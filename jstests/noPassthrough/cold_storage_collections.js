@@ -0,0 +1,59 @@
+/**
+ * Tests that the files of collections created with {coldStorage: true}, and of their indexes, are
+ * kept in the 'cold' directory of the dbpath, including for the collections written by $out.
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+// Returns the WiredTiger tables of the collection and of its indexes.
+function getTables(coll) {
+    const stats = coll.stats({indexDetails: true});
+    const tables = [stats.wiredTiger.uri];
+    for (const index of Object.keys(stats.indexDetails)) {
+        tables.push(stats.indexDetails[index].uri);
+    }
+    return tables.map(uri => uri.replace("statistics:table:", ""));
+}
+
+function assertColdStorage(coll, cold) {
+    const tables = getTables(coll);
+    assert.eq(cold, tables.every(table => table.startsWith("cold/")), tables);
+    assert.eq(cold, tables.some(table => table.startsWith("cold/")), tables);
+    assert.eq(cold, coll.getDB().getCollectionInfos({name: coll.getName()})[0].options.coldStorage);
+}
+
+for (const options of [{}, {directoryperdb: ""}]) {
+    let conn = MongoRunner.runMongod(options);
+    assert.neq(null, conn, "mongod was unable to start up");
+    let db = conn.getDB("test");
+
+    assert.commandWorked(db.hot.insert({_id: 1, a: 1}));
+    assertColdStorage(db.hot, undefined);
+
+    assert.commandWorked(db.createCollection("archive", {coldStorage: true}));
+    assert.commandWorked(db.archive.createIndex({a: 1}));
+    assert.commandWorked(db.archive.insert({_id: 2, a: 2}));
+    assertColdStorage(db.archive, true);
+    const table = getTables(db.archive)[0];
+    assert(listFiles(conn.dbpath + "/" + table.substring(0, table.lastIndexOf("/")))
+               .some(file => file.baseName === table.substring(table.lastIndexOf("/") + 1) + ".wt"),
+           table);
+
+    // $out replaces the collection with one created with the same options.
+    db.hot.aggregate([{$out: "archive"}]);
+    assert.eq([{_id: 1, a: 1}], db.archive.find().toArray());
+    assertColdStorage(db.archive, true);
+
+    // The catalog keeps tracking the collection across a restart.
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({restart: conn, noCleanData: true});
+    assert.neq(null, conn, "mongod was unable to restart");
+    db = conn.getDB("test");
+    assert.eq([{_id: 1, a: 1}], db.archive.find().toArray());
+    assertColdStorage(db.archive, true);
+
+    assert(db.archive.drop());
+    MongoRunner.stopMongod(conn);
+}
+}());
@@ -0,0 +1,55 @@
+/**
+ * Tests that a collection can be given a low cache priority when it is created or with collMod, and
+ * that the queries of a low priority collection return the same results.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+
+function getCachePriority(collName) {
+    const infos = db.getCollectionInfos({name: collName});
+    assert.eq(1, infos.length, infos);
+    return infos[0].options.cachePriority;
+}
+
+assert.commandFailedWithCode(db.createCollection("invalid", {cachePriority: "high"}),
+                             ErrorCodes.InvalidOptions);
+assert.commandWorked(db.createCollection("analytics", {cachePriority: "low"}));
+assert.eq("low", getCachePriority("analytics"));
+
+const coll = db.analytics;
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, x: i % 10});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({x: 1}));
+
+function runQueries() {
+    assert.eq(docs, coll.find().sort({_id: 1}).batchSize(10).toArray());
+    assert.eq(100, coll.find({x: 3}).hint({x: 1}).itcount());
+    assert.eq(
+        [{_id: 3, n: 100}],
+        coll.aggregate([{$match: {x: 3}}, {$group: {_id: "$x", n: {$sum: 1}}}], {cursor: {}})
+            .toArray());
+    assert.eq(docs, coll.aggregate([{$sort: {_id: 1}}], {cursor: {batchSize: 10}}).toArray());
+}
+runQueries();
+
+// The cache priority of a collection can be changed, and is kept by other collMods.
+assert.commandWorked(db.runCommand({collMod: coll.getName(), cachePriority: "normal"}));
+assert.eq(undefined, getCachePriority("analytics"));
+runQueries();
+
+assert.commandWorked(db.runCommand({collMod: coll.getName(), cachePriority: "low"}));
+assert.commandWorked(db.runCommand({collMod: coll.getName(), validationLevel: "moderate"}));
+assert.eq("low", getCachePriority("analytics"));
+assert.commandFailedWithCode(db.runCommand({collMod: coll.getName(), cachePriority: 1}),
+                             ErrorCodes.InvalidOptions);
+
+MongoRunner.stopMongod(conn);
+}());
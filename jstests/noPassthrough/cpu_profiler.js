@@ -0,0 +1,54 @@
+/**
+ * Tests that the CPU profiler samples the stacks of running operations, attributes them to their
+ * command and namespace, and reports them through the getCpuProfile command.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const adminDB = conn.getDB('admin');
+
+// The profiler is disabled by default, and has nothing to report.
+let profile = assert.commandWorked(adminDB.runCommand({getCpuProfile: 1}));
+assert.eq(profile.sampleRateHz, 0, profile);
+
+const res = adminDB.runCommand({setParameter: 1, cpuProfilerSampleRateHz: 1000});
+if (res.code === ErrorCodes.IllegalOperation) {
+    jsTestLog("Skipping test since CPU profiling is not supported on this platform");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+assert.commandWorked(res);
+
+const coll = db.cpu_profiler;
+const docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, a: i % 10, s: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+
+const isAggregateStack = (stack) => stack.opType === "aggregate" && stack.ns === coll.getFullName();
+const sumOfRange =
+    {$reduce: {input: {$range: [0, 500]}, initialValue: 0, in: {$add: ["$$value", "$$this"]}}};
+assert.soon(() => {
+    coll.aggregate([{$project: {n: sumOfRange}}, {$group: {_id: null, total: {$sum: "$n"}}}])
+        .toArray();
+    profile = assert.commandWorked(adminDB.runCommand({getCpuProfile: 1}));
+    return profile.stacks.some(isAggregateStack);
+}, () => tojson(profile));
+
+assert.eq(profile.sampleRateHz, 1000, profile);
+assert.gt(profile.samples, 0, profile);
+const stack = profile.stacks.find(isAggregateStack);
+assert.gt(stack.count, 0, stack);
+assert.gt(stack.backtrace.length, 0, stack);
+
+// The number of stacks returned can be limited.
+profile = assert.commandWorked(adminDB.runCommand({getCpuProfile: 1, limit: 1}));
+assert.lte(profile.stacks.length, 1, profile);
+assert.commandFailedWithCode(adminDB.runCommand({getCpuProfile: 1, limit: 0}), 5191081);
+
+assert.commandWorked(adminDB.runCommand({setParameter: 1, cpuProfilerSampleRateHz: 0}));
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,53 @@
+/**
+ * Tests that the dbHash command returns the same hashes whether it hashes one collection at a time
+ * or several at once, including when reading at a cluster time.
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+
+for (let i = 0; i < 10; ++i) {
+    const coll = db["coll" + i];
+    const docs = [];
+    for (let j = 0; j < 100 * i; ++j) {
+        docs.push({_id: j, x: i * j});
+    }
+    if (docs.length > 0) {
+        assert.commandWorked(coll.insert(docs));
+    } else {
+        assert.commandWorked(db.createCollection(coll.getName()));
+    }
+}
+assert.commandWorked(db.createCollection("capped", {capped: true, size: 4096}));
+assert.commandWorked(db.capped.insert([{a: 1}, {a: 2}]));
+
+const clusterTime = db.getSession().getOperationTime();
+
+function runDbHash(parallelism, cmdExtra) {
+    assert.commandWorked(db.adminCommand({setParameter: 1, dbHashParallelism: parallelism}));
+    const res = assert.commandWorked(db.runCommand(Object.assign({dbHash: 1}, cmdExtra)));
+    return {md5: res.md5, collections: res.collections};
+}
+
+for (let cmdExtra of [{}, {$_internalReadAtClusterTime: clusterTime}]) {
+    const serial = runDbHash(1, cmdExtra);
+    for (let parallelism of [2, 4, 16]) {
+        assert.eq(serial, runDbHash(parallelism, cmdExtra), tojson(cmdExtra));
+    }
+}
+
+// Writes after the cluster time don't change the hashes read at it.
+const atClusterTime = runDbHash(4, {$_internalReadAtClusterTime: clusterTime});
+assert.commandWorked(db.coll5.insert({_id: "new"}));
+assert.eq(atClusterTime, runDbHash(4, {$_internalReadAtClusterTime: clusterTime}));
+assert.neq(atClusterTime.md5, runDbHash(4, {}).md5);
+
+rst.stopSet();
+}());
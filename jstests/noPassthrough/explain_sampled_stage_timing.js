@@ -0,0 +1,49 @@
+/**
+ * Tests that when internalQueryExecStageTimingSampleRate is set, explain reports the time spent in
+ * each stage as estimated from a sample of the calls, in microseconds as well as in milliseconds.
+ */
+(function() {
+'use strict';
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStages.
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const coll = db.explain_sampled_stage_timing;
+
+const docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, a: i % 10});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function getStages(explain, stageName) {
+    return getPlanStages(explain.executionStats.executionStages, stageName);
+}
+
+// By default every call is timed with the coarse clock, and no microsecond estimate is reported.
+let explain = coll.find({a: {$gte: 5}}).explain("executionStats");
+let [ixscan] = getStages(explain, "IXSCAN");
+assert(ixscan.hasOwnProperty("executionTimeMillisEstimate"), explain);
+assert(!ixscan.hasOwnProperty("executionTimeMicrosEstimate"), explain);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryExecStageTimingSampleRate: 10}));
+
+explain = coll.find({a: {$gte: 5}}).explain("executionStats");
+for (let stageName of ["FETCH", "IXSCAN"]) {
+    const [stage] = getStages(explain, stageName);
+    assert.gte(stage.executionTimeMicrosEstimate, 0, explain);
+    assert.eq(stage.executionTimeMillisEstimate,
+              Math.floor(stage.executionTimeMicrosEstimate / 1000),
+              explain);
+}
+
+// Aggregation stages are sampled the same way.
+explain = coll.explain("executionStats").aggregate([{$match: {a: 1}}, {$group: {_id: "$a"}}]);
+const groupStage = explain.stages.find(stage => stage.hasOwnProperty("$group"));
+assert(groupStage.hasOwnProperty("executionTimeMicrosEstimate"), explain);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,88 @@
+/**
+ * Tests that the sub-pipelines of a $facet stage produce the same results whether they consume
+ * their input one after another or concurrently, including when the input is split into many
+ * batches and when some facets stop consuming input early.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.facet_parallel_sub_pipelines;
+coll.drop();
+const foreign = db.facet_parallel_sub_pipelines_foreign;
+foreign.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i % 13, b: i % 4, price: i * 1.5, str: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(foreign.insert([{_id: 0, name: "zero"}, {_id: 1, name: "one"}]));
+
+function setParameter(param) {
+    assert.commandWorked(db.adminCommand(Object.assign({setParameter: 1}, param)));
+}
+
+function runFacet(facetSpec, parallelism) {
+    setParameter({internalQueryFacetParallelism: parallelism});
+    return coll.aggregate([{$sort: {_id: 1}}, {$facet: facetSpec}]).toArray();
+}
+
+function assertSameResults(facetSpec) {
+    const sequential = runFacet(facetSpec, 1);
+    assert.eq(sequential, runFacet(facetSpec, 4), tojson(facetSpec));
+    assert.eq(sequential, runFacet(facetSpec, 2), tojson(facetSpec));
+}
+
+const facetSpecs = [
+    {
+        byA: [{$group: {_id: "$a", count: {$sum: 1}, total: {$sum: "$price"}}}, {$sort: {_id: 1}}],
+        byB: [{$group: {_id: "$b", ids: {$push: "$_id"}}}, {$sort: {_id: 1}}],
+        buckets: [{$bucket: {groupBy: "$price", boundaries: [0, 100, 500, 2000], default: "rest"}}],
+        top: [{$sort: {price: -1}}, {$limit: 5}, {$project: {str: 0}}],
+        count: [{$match: {b: 2}}, {$count: "n"}],
+    },
+    // Facets which stop consuming input after a few documents.
+    {
+        first: [{$limit: 2}, {$project: {_id: 1}}],
+        skipped: [{$skip: 990}, {$project: {_id: 1}}],
+        count: [{$count: "n"}],
+    },
+    // A facet which reads from another collection makes all the facets run one after another.
+    {
+        lookedUp: [
+            {$match: {_id: {$lt: 3}}},
+            {$lookup: {from: foreign.getName(), localField: "_id", foreignField: "_id", as: "f"}},
+            {$project: {f: 1}},
+        ],
+        count: [{$count: "n"}],
+    },
+];
+
+for (const facetSpec of facetSpecs) {
+    assertSameResults(facetSpec);
+}
+
+// The input is split into many batches.
+setParameter({internalQueryFacetBufferSizeBytes: 4 * 1024});
+for (const facetSpec of facetSpecs) {
+    assertSameResults(facetSpec);
+}
+
+// The output size limit is still enforced across all the facets.
+setParameter({internalQueryFacetMaxOutputDocSizeBytes: 64 * 1024});
+for (const parallelism of [1, 4]) {
+    setParameter({internalQueryFacetParallelism: parallelism});
+    assert.commandFailedWithCode(
+        db.runCommand({
+            aggregate: coll.getName(),
+            pipeline: [{$facet: {a: [{$match: {b: {$lt: 2}}}], b: [{$match: {b: {$gte: 2}}}]}}],
+            cursor: {},
+        }),
+        4031700);
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,48 @@
+/**
+ * Tests that FETCH stages return the same documents whether they read the records of their index
+ * entries one at a time or in batches, including across yields, sorts and limits.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.fetch_multi_get;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: (i * 37) % 1000, b: i % 13});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function runFind(query, batchSize) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryExecFetchBatchSize: batchSize}));
+    return query().toArray();
+}
+
+const queries = [
+    () => coll.find({a: {$gte: 100}}).hint({a: 1}),
+    () => coll.find({a: {$gte: 100}}).hint({a: 1}).sort({a: -1}),
+    () => coll.find({b: {$in: [1, 5]}, a: {$lt: 600}}).hint({b: 1}),
+    () => coll.find({a: {$lt: 500}}).hint({a: 1}).limit(3),
+    () => coll.find({a: {$lt: 500}}).hint({a: 1}).batchSize(5),
+];
+
+// Yield often, so that batches of records are read again after the snapshot is given up.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 2}));
+for (const query of queries) {
+    assert.eq(runFind(query, 1), runFind(query, 64), tojson(query));
+}
+
+// Records are read in RecordId order but returned in the order of their index entries.
+assert.commandWorked(coll.remove({b: 5}));
+const expected = docs.filter(doc => doc.b !== 5 && doc.a >= 100).sort((x, y) => x.a - y.a);
+assert.eq(expected, runFind(queries[0], 64));
+
+MongoRunner.stopMongod(conn);
+}());
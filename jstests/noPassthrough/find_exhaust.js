@@ -0,0 +1,39 @@
+/**
+ * Tests that a find command which allows exhaust streams the batches following its first one as
+ * getMore replies, without waiting for a request for each of them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const testDB = conn.getDB("test");
+const coll = testDB.find_exhaust;
+coll.drop();
+
+const docCount = 10;
+for (let i = 0; i < docCount; i++) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+
+assert.commandWorked(testDB.setProfilingLevel(2));
+
+const docs = coll.find().sort({_id: 1}).batchSize(2).addOption(DBQuery.Option.exhaust).toArray();
+assert.eq(docCount, docs.length, tojson(docs));
+for (let i = 0; i < docCount; i++) {
+    assert.eq(i, docs[i]._id, tojson(docs));
+}
+
+// The find is marked as the start of an exhaust stream, and the stream is made of getMores.
+const findEntry = testDB.system.profile.findOne({op: "query", ns: coll.getFullName()});
+assert.neq(null, findEntry);
+assert.eq(true, findEntry.exhaust, tojson(findEntry));
+assert.gte(testDB.system.profile.find({op: "getmore", ns: coll.getFullName()}).itcount(),
+           docCount / 2 - 1,
+           tojson(testDB.system.profile.find().toArray()));
+
+// A cursor which is exhausted by its first batch does not start a stream.
+assert.eq(docCount,
+          coll.find().batchSize(docCount + 1).addOption(DBQuery.Option.exhaust).itcount());
+
+MongoRunner.stopMongod(conn);
+}());
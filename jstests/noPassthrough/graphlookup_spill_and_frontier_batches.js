@@ -0,0 +1,72 @@
+/**
+ * Tests that $graphLookup spills the documents it found to disk when they outgrow its memory limit
+ * and allowDiskUse is specified, and that it finds the same documents when its frontier is queried
+ * in several batches.
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For assertErrorCode().
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const local = db.local;
+const foreign = db.foreign;
+
+assert.commandWorked(local.insert({_id: 0, start: 0}));
+
+// A binary tree of 'nNodes' nodes, each of about 1KB.
+const nNodes = 500;
+const padding = "x".repeat(1024);
+const bulk = foreign.initializeUnorderedBulkOp();
+for (let i = 0; i < nNodes; ++i) {
+    bulk.insert({_id: i, children: [2 * i + 1, 2 * i + 2], padding: padding});
+}
+assert.commandWorked(bulk.execute());
+
+const graphLookup = {
+    $graphLookup: {
+        from: foreign.getName(),
+        startWith: "$start",
+        connectFromField: "children",
+        connectToField: "_id",
+        as: "nodes",
+        depthField: "depth"
+    }
+};
+const unwindPipeline = [graphLookup, {$unwind: "$nodes"}, {$project: {_id: "$nodes._id"}}];
+const arrayPipeline = [graphLookup, {$project: {n: {$size: "$nodes"}}}];
+
+function checkResults() {
+    for (let options of [{}, {allowDiskUse: true}]) {
+        const ids = local.aggregate(unwindPipeline, options).toArray().map(doc => doc._id);
+        assert.eq(ids.length, nNodes, options);
+        assert.eq(new Set(ids).size, nNodes, options);
+        assert.eq(local.aggregate(arrayPipeline, options).toArray(), [{_id: 0, n: nNodes}]);
+    }
+}
+
+checkResults();
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceGraphLookupMaxFrontierBatchSize: 3}));
+checkResults();
+
+// With a limit of about a fifth of the documents found, the search only succeeds if it may spill.
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalDocumentSourceGraphLookupMaxMemoryBytes: 100 * 1024}));
+for (let pipeline of [unwindPipeline, arrayPipeline]) {
+    assertErrorCode(local, pipeline, 40099);
+
+    const results = local.aggregate(pipeline, {allowDiskUse: true}).toArray();
+    if (pipeline === unwindPipeline) {
+        const ids = results.map(doc => doc._id);
+        assert.eq(ids.length, nNodes);
+        assert.eq(new Set(ids).size, nNodes);
+    } else {
+        assert.eq(results, [{_id: 0, n: nNodes}]);
+    }
+}
+
+MongoRunner.stopMongod(conn);
+}());
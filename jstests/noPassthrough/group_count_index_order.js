@@ -0,0 +1,87 @@
+/**
+ * Tests that a $group which only counts the documents per value of an indexed field runs as a
+ * covered index scan, and returns the same groups as when it reads the whole collection.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage().
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.group_count_index_order;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 500; i++) {
+    docs.push({_id: i, a: i % 17, b: i % 5, c: "str" + (i % 7)});
+}
+docs.push({_id: 500, b: 1});
+docs.push({_id: 501, a: null, b: 2});
+docs.push({_id: 502, a: {x: 1}, b: 3});
+docs.push({_id: 503, a: "str", b: 4});
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+function setIndexOrder(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryGroupCountUsesIndexOrder: enabled}));
+}
+
+function assertSameGroups(pipeline) {
+    setIndexOrder(true);
+    const fromIndex = coll.aggregate(pipeline).toArray();
+    setIndexOrder(false);
+    const fromCollection = coll.aggregate(pipeline).toArray();
+    assert.sameMembers(fromCollection, fromIndex, tojson(pipeline));
+}
+
+function assertCoveredIndexScan(pipeline) {
+    setIndexOrder(true);
+    const explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "IXSCAN"), explain);
+    assert.eq(null, getAggPlanStage(explain, "FETCH"), explain);
+    assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+    assert.eq(null, getAggPlanStage(explain, "COLLSCAN"), explain);
+}
+
+const countPipelines = [
+    [{$group: {_id: "$a", count: {$sum: 1}}}],
+    [{$group: {_id: {v: "$a"}, count: {$sum: 1}, twice: {$sum: 2}}}],
+    [{$match: {a: {$gte: 3, $lt: 9}}}, {$group: {_id: "$a", count: {$sum: 1}}}],
+    [{$group: {_id: "$a", count: {$sum: 1}}}, {$match: {count: {$gt: 29}}}],
+];
+for (const pipeline of countPipelines) {
+    assertSameGroups(pipeline);
+    assertCoveredIndexScan(pipeline);
+}
+
+// Missing and null group keys end up in the same group either way.
+assert.eq(2,
+          coll.aggregate([{$group: {_id: "$a", count: {$sum: 1}}}, {$match: {_id: null}}])
+              .toArray()[0]
+              .count);
+
+// A $group which accumulates document fields, a predicate on another field, or a $limit before
+// the $group keep the plan they had.
+const otherPipelines = [
+    [{$group: {_id: "$a", ids: {$push: "$_id"}}}],
+    [{$match: {c: "str1"}}, {$group: {_id: "$a", count: {$sum: 1}}}],
+    [{$limit: 10}, {$group: {_id: "$a", count: {$sum: 1}}}],
+];
+for (const pipeline of otherPipelines) {
+    setIndexOrder(true);
+    const explain = coll.explain().aggregate(pipeline);
+    assert.neq(null, getAggPlanStage(explain, "COLLSCAN"), explain);
+}
+
+// The index cannot cover the group key once it is multikey.
+assert.commandWorked(coll.insert({_id: 600, a: [1, 2]}));
+const multikeyPipeline = [{$group: {_id: "$a", count: {$sum: 1}}}];
+assertSameGroups(multikeyPipeline);
+setIndexOrder(true);
+assert.neq(null, getAggPlanStage(coll.explain().aggregate(multikeyPipeline), "COLLSCAN"));
+
+MongoRunner.stopMongod(conn);
+}());
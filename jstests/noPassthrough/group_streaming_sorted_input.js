@@ -0,0 +1,74 @@
+/**
+ * Tests that a $group which follows a $sort on its group key returns the same groups whether or not
+ * it streams its output, including for group keys with arrays and missing fields.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.group_streaming_sorted_input;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 500; i++) {
+    docs.push({_id: i, a: i % 17, b: i % 5, c: "str" + (i % 7), d: "x".repeat(100)});
+}
+docs.push({_id: 500, a: [1, 2], b: 1});
+docs.push({_id: 501, a: [], b: 2});
+docs.push({_id: 502, b: 3});
+docs.push({_id: 503, a: null, b: 3});
+docs.push({_id: 504, a: 1, b: [3, 4]});
+docs.push({_id: 505, a: 1, b: null});
+docs.push({_id: 506, a: 1});
+docs.push({_id: 507, a: {x: 1}, b: 1});
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+function setStreamingGroup(enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableStreamingGroup: enabled}));
+}
+
+// The order of the pushed values depends on the plan, and is not preserved across spills.
+function runAggregate(pipeline, options) {
+    return coll.aggregate(pipeline, options).toArray().map(group => {
+        if (group.ids) {
+            group.ids.sort((x, y) => x - y);
+        }
+        return group;
+    });
+}
+
+function assertSameGroups(pipeline, options = {}) {
+    setStreamingGroup(true);
+    const streamed = runAggregate(pipeline, options);
+    setStreamingGroup(false);
+    const hashed = runAggregate(pipeline, options);
+    assert.sameMembers(hashed, streamed, tojson(pipeline));
+}
+
+const accumulators = {count: {$sum: 1}, ids: {$push: "$_id"}, maxC: {$max: "$c"}};
+const pipelines = [
+    [{$sort: {a: 1}}, {$group: Object.assign({_id: "$a"}, accumulators)}],
+    [{$sort: {a: -1, b: 1}}, {$group: Object.assign({_id: "$a"}, accumulators)}],
+    [{$sort: {b: 1, a: 1}}, {$group: Object.assign({_id: {x: "$a", y: "$b"}}, accumulators)}],
+    [{$sort: {c: 1}}, {$group: Object.assign({_id: "$c"}, accumulators)}],
+    [{$match: {b: {$gte: 1}}}, {$sort: {a: 1}}, {$group: {_id: "$a", count: {$sum: 1}}}],
+    [{$sort: {a: 1}}, {$group: {_id: "$a"}}, {$sort: {_id: 1}}, {$limit: 5}],
+];
+for (const pipeline of pipelines) {
+    assertSameGroups(pipeline);
+    assertSameGroups(pipeline, {collation: {locale: "en_US", strength: 1}});
+}
+
+// The groups are also the same when the $group has to spill, including the one being streamed.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceGroupMaxMemoryBytes: 4 * 1024}));
+for (const pipeline of pipelines) {
+    assertSameGroups(pipeline, {allowDiskUse: true});
+}
+
+MongoRunner.stopMongod(conn);
+}());
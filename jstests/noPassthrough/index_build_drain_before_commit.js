@@ -0,0 +1,66 @@
+/**
+ * Tests that an index build drains the side writes which accumulated while it waited to commit
+ * while only holding intent locks, and reports how long it held the exclusive collection lock to
+ * commit, and how many side writes it drained while holding it.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/noPassthrough/libs/index_build.js");
+
+const replSet = new ReplSetTest({nodes: 1});
+replSet.startSet();
+replSet.initiate();
+
+const primary = replSet.getPrimary();
+const testDB = primary.getDB('test');
+const coll = testDB.getCollection(jsTestName());
+
+assert.commandWorked(coll.insert({a: -1}));
+
+function commitMetrics() {
+    return assert.commandWorked(testDB.adminCommand({serverStatus: 1}))
+        .metrics.indexBuilds.commitExclusiveLock;
+}
+
+function buildIndexWithWritesBeforeCommit(keyPattern, numWrites) {
+    const hangBeforeCommit = configureFailPoint(primary, "hangIndexBuildBeforeCommit");
+    const createIdx = IndexBuildTest.startIndexBuild(primary, coll.getFullName(), keyPattern);
+    hangBeforeCommit.wait();
+
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numWrites; i++) {
+        bulk.insert({a: i, b: i});
+    }
+    assert.commandWorked(bulk.execute());
+
+    const before = commitMetrics();
+    hangBeforeCommit.off();
+    createIdx();
+    const after = commitMetrics();
+    assert.gte(after.count, before.count + 1, tojson(after));
+    assert.gte(after.totalMillis, before.totalMillis, tojson(after));
+    return after.sideWritesDrained - before.sideWritesDrained;
+}
+
+const numWrites = 5000;
+
+// Nothing writes to the collection once the index build resumes, so all the side writes are
+// drained before it takes the exclusive lock.
+assert.commandWorked(
+    testDB.adminCommand({setParameter: 1, maxIndexBuildSideWritesDrainedOnCommit: 100}));
+assert.lte(buildIndexWithWritesBeforeCommit({a: 1}, numWrites), 100);
+
+// Without drains before commit, all of them are drained under the exclusive lock.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, maxIndexBuildDrainsBeforeCommit: 0}));
+assert.gte(buildIndexWithWritesBeforeCommit({b: 1}, numWrites), numWrites);
+
+assert.eq(2 * numWrites + 1, coll.find().hint({a: 1}).itcount());
+assert.eq(2 * numWrites + 1, coll.find().hint({b: 1}).itcount());
+assert.commandWorked(coll.validate());
+
+replSet.stopSet();
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that concurrent j:true writers share journal syncs when the journal waits for more writers
+ * before each sync, and that serverStatus reports how many writers shared them.
+ * @tags: [requires_journaling, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({setParameter: {wiredTigerJournalGroupCommitWindowMicros: 2000}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.journal_group_commit;
+
+function getBatchSizes() {
+    return db.serverStatus().wiredTiger["journal sync batch sizes"];
+}
+const sizesBefore = getBatchSizes();
+
+const kNumWriters = 8;
+const kNumWrites = 200;
+const writers = [];
+for (let i = 0; i < kNumWriters; i++) {
+    writers.push(startParallelShell(funWithArgs(function(writer, numWrites) {
+        const coll = db.getSiblingDB("test").journal_group_commit;
+        for (let j = 0; j < numWrites; j++) {
+            assert.commandWorked(coll.insert({writer: writer, j: j}, {writeConcern: {j: true}}));
+        }
+    }, i, kNumWrites), conn.port));
+}
+writers.forEach(join => join());
+assert.eq(kNumWriters * kNumWrites, coll.find().itcount());
+
+// Every write waited for a sync, and at least some of the syncs were shared.
+const sizesAfter = getBatchSizes();
+let numSyncs = 0;
+let numSharedSyncs = 0;
+for (const bucket of Object.keys(sizesAfter)) {
+    const count = sizesAfter[bucket] - sizesBefore[bucket];
+    numSyncs += count;
+    if (bucket !== "1") {
+        numSharedSyncs += count;
+    }
+}
+assert.gt(numSyncs, 0, tojson(sizesAfter));
+assert.lt(numSyncs, kNumWriters * kNumWrites, tojson(sizesAfter));
+assert.gt(numSharedSyncs, 0, tojson(sizesAfter));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,111 @@
+/**
+ * Tests that aggregations running JavaScript on a reused scope see the same results as on a new
+ * one, and that scopes initialized with scope variables, or holding an 'emit' function, are not
+ * reused.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const coll = db.js_execution_scope_reuse;
+
+assert.commandWorked(coll.insert([{_id: 0, x: 1}, {_id: 1, x: 2}, {_id: 2, x: 3}]));
+
+function runFunction() {
+    return coll
+        .aggregate([
+            {
+                $project: {
+                    y: {
+                        $function: {
+                            body: function(x) {
+                                return x * 10;
+                            },
+                            args: ["$x"],
+                            lang: "js"
+                        }
+                    }
+                }
+            },
+            {$sort: {_id: 1}}
+        ])
+        .toArray();
+}
+
+function runAccumulator() {
+    return coll
+        .aggregate([{
+            $group: {
+                _id: null,
+                total: {
+                    $accumulator: {
+                        init: function() {
+                            return 0;
+                        },
+                        accumulate: function(state, x) {
+                            return state + x;
+                        },
+                        accumulateArgs: ["$x"],
+                        merge: function(a, b) {
+                            return a + b;
+                        },
+                        lang: "js"
+                    }
+                }
+            }
+        }])
+        .toArray();
+}
+
+const expectedFunction = [{_id: 0, y: 10}, {_id: 1, y: 20}, {_id: 2, y: 30}];
+const expectedAccumulator = [{_id: null, total: 6}];
+
+for (let maxIdleScopes of [16, 0, 16]) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryJavaScriptMaxIdleScopes: maxIdleScopes}));
+    for (let i = 0; i < 5; ++i) {
+        assert.eq(runFunction(), expectedFunction);
+        assert.eq(runAccumulator(), expectedAccumulator);
+    }
+}
+
+// A mapReduce with scope variables, which also injects 'emit', between two aggregations on the same
+// connection must not leave either behind.
+const out = db.runCommand({
+    mapReduce: coll.getName(),
+    map: function() {
+        emit(this.x % 2, this.x * factor);
+    },
+    reduce: function(key, values) {
+        return Array.sum(values);
+    },
+    scope: {factor: 100},
+    out: {inline: 1}
+});
+assert.commandWorked(out);
+assert.sameMembers(out.results, [{_id: 0, value: 200}, {_id: 1, value: 400}]);
+
+assert.eq(runFunction(), expectedFunction);
+const factorVisible = coll.aggregate([
+                              {$limit: 1},
+                              {
+                                  $project: {
+                                      visible: {
+                                          $function: {
+                                              body: function() {
+                                                  return typeof factor !== "undefined" ||
+                                                      typeof emit !== "undefined";
+                                              },
+                                              args: [],
+                                              lang: "js"
+                                          }
+                                      }
+                                  }
+                              }
+                          ])
+                          .toArray();
+assert.eq(factorVisible, [{_id: 0, visible: false}]);
+
+MongoRunner.stopMongod(conn);
+}());
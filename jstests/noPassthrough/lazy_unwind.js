@@ -0,0 +1,46 @@
+/**
+ * Tests that $unwind returns the same results whether or not it builds the documents it outputs
+ * over the BSON of their parents, or over only the fields read by the next $group or $project.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.lazy_unwind;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 200; i++) {
+    docs.push({_id: i, a: i % 7, arr: [i, {x: i}, [i]], sub: {b: i, arr: [i % 3, i % 5]}, s: "s"});
+}
+docs.push({_id: 200, arr: []}, {_id: 201, arr: null}, {_id: 202, arr: 5}, {_id: 203});
+assert.commandWorked(coll.insert(docs));
+
+function runAggregate(pipeline, enabled) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableLazyUnwind: enabled}));
+    return coll.aggregate([{$sort: {_id: 1}}, ...pipeline]).toArray();
+}
+
+const pipelines = [
+    [{$unwind: {path: "$arr", includeArrayIndex: "idx", preserveNullAndEmptyArrays: true}}],
+    [{$unwind: "$sub.arr"}],
+    [{$addFields: {c: "$a"}}, {$unwind: {path: "$arr", includeArrayIndex: "sub.b"}}],
+    [{$unwind: "$arr"}, {$project: {a: 1, arr: 1, "sub.b": 1}}],
+    [{$unwind: "$sub.arr"}, {$project: {_id: 0, s: 1, v: "$sub.arr"}}],
+    [{$unwind: "$arr"}, {$project: {arr: 0}}],
+    [
+        {$unwind: "$sub.arr"},
+        {$group: {_id: "$sub.arr", n: {$sum: 1}, t: {$sum: "$a"}}},
+        {$sort: {_id: 1}},
+    ],
+    [{$unwind: "$arr"}, {$group: {_id: "$a", docs: {$push: "$$ROOT"}}}, {$sort: {_id: 1}}],
+];
+for (const pipeline of pipelines) {
+    assert.eq(runAggregate(pipeline, false), runAggregate(pipeline, true), tojson(pipeline));
+}
+
+MongoRunner.stopMongod(conn);
+}());
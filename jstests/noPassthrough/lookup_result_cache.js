@@ -0,0 +1,66 @@
+/**
+ * Tests that a $lookup returns the same results whether or not it reuses the results of its
+ * sub-pipeline for the local documents with the same correlated values.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const local = db.lookup_result_cache_local;
+const foreign = db.lookup_result_cache_foreign;
+local.drop();
+foreign.drop();
+
+const localDocs = [];
+for (let i = 0; i < 300; i++) {
+    localDocs.push({_id: i, k: i % 5, s: ["a", "A", "b"][i % 3]});
+}
+localDocs.push({_id: 300, k: 1.0});
+localDocs.push({_id: 301, k: NumberLong(1)});
+localDocs.push({_id: 302});
+assert.commandWorked(local.insert(localDocs));
+
+const foreignDocs = [];
+for (let i = 0; i < 50; i++) {
+    foreignDocs.push({_id: i, k: i % 7, s: i % 2 ? "a" : "b"});
+}
+assert.commandWorked(foreign.insert(foreignDocs));
+
+function runLookup(pipeline, options, maxMemoryBytes) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryLookupResultCacheMaxMemoryBytes: maxMemoryBytes}));
+    return local.aggregate([{$sort: {_id: 1}}, ...pipeline], options).toArray();
+}
+
+const pipelines = [
+    [{
+        $lookup: {
+            from: foreign.getName(),
+            let: {k: "$k"},
+            pipeline: [{$match: {$expr: {$eq: ["$k", "$$k"]}}}, {$addFields: {localK: "$$k"}}],
+            as: "joined"
+        }
+    }],
+    [{
+        $lookup: {
+            from: foreign.getName(),
+            let: {s: "$s"},
+            pipeline: [{$match: {$expr: {$eq: ["$s", "$$s"]}}}, {$project: {s: 1, localS: "$$s"}}],
+            as: "joined"
+        }
+    }],
+    [{$lookup: {from: foreign.getName(), localField: "k", foreignField: "k", as: "joined"}}],
+];
+for (const pipeline of pipelines) {
+    for (const options of [{}, {collation: {locale: "en_US", strength: 2}}]) {
+        const expected = runLookup(pipeline, options, 0);
+        assert.eq(expected, runLookup(pipeline, options, 32 * 1024 * 1024), tojson(pipeline));
+        // The cache evicts results to stay under a small memory limit.
+        assert.eq(expected, runLookup(pipeline, options, 1024), tojson(pipeline));
+    }
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,80 @@
+/**
+ * Tests that the results of a materialized view are kept up to date as the documents of its
+ * collection are inserted, updated and deleted, and are replicated to the secondaries.
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.materialized_view_group_sums;
+const viewName = "materialized_view_group_sums_view";
+const pipeline =
+    [{$match: {ignored: {$ne: true}}}, {$group: {_id: "$g", total: {$sum: "$x"}, n: {$sum: 1}}}];
+
+assert.commandWorked(db.createCollection(coll.getName()));
+
+// The collection must record the pre-images of its updates.
+const viewOptions = {viewOn: coll.getName(), pipeline: pipeline, materialized: true};
+assert.commandFailedWithCode(db.createCollection(viewName, viewOptions), ErrorCodes.InvalidOptions);
+assert.commandWorked(db.runCommand({collMod: coll.getName(), recordPreImages: true}));
+
+// Only $match stages followed by a $group of $sum accumulators can be materialized.
+const maxPipeline = [{$group: {_id: "$g", top: {$max: "$x"}}}];
+assert.commandFailedWithCode(
+    db.createCollection(viewName,
+                        {viewOn: coll.getName(), pipeline: maxPipeline, materialized: true}),
+    ErrorCodes.OptionNotSupportedOnView);
+
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    docs.push({_id: i, g: i % 7, x: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(db.createCollection(viewName, viewOptions));
+const view = db[viewName];
+
+function assertViewIsUpToDate() {
+    const expected = coll.aggregate(pipeline).toArray();
+    assert.sameMembers(expected, view.find().toArray());
+    rst.awaitReplication();
+    assert.sameMembers(expected, rst.getSecondary().getDB("test")[viewName].find().toArray());
+}
+assertViewIsUpToDate();
+
+assert.commandWorked(coll.insert([{_id: 100, g: 7, x: 5}, {_id: 101, g: "str", x: 1.5}]));
+assertViewIsUpToDate();
+
+// Updates which keep documents in their groups, move them between groups, and filter them out.
+assert.commandWorked(coll.update({g: 1}, {$inc: {x: 10}}, {multi: true}));
+assert.commandWorked(coll.update({_id: 2}, {$set: {g: 3}}));
+assert.commandWorked(coll.update({_id: 100}, {$set: {ignored: true}}));
+assertViewIsUpToDate();
+
+// Deleting the last document of a group removes it from the view.
+assert.commandWorked(coll.remove({g: "str"}));
+assert.commandWorked(coll.remove({_id: {$lt: 50}}));
+assertViewIsUpToDate();
+
+// A group key which can't be stored as an _id fails the write.
+assert.commandFailedWithCode(coll.insert({_id: 200, g: [1, 2], x: 1}), 5190280);
+assert.eq(null, coll.findOne({_id: 200}));
+assertViewIsUpToDate();
+
+// A materialized view can't be modified, and dropping it drops its results.
+assert.commandFailedWithCode(
+    db.runCommand({collMod: viewName, viewOn: coll.getName(), pipeline: pipeline}),
+    ErrorCodes.OptionNotSupportedOnView);
+assert(view.drop());
+assert.eq(0,
+          db.getCollectionInfos({name: "system.materialized." + viewName}).length,
+          db.getCollectionInfos());
+assert.commandWorked(coll.insert({_id: 300, g: 1, x: 1}));
+
+rst.stopSet();
+}());
@@ -0,0 +1,68 @@
+/**
+ * Tests that $merge produces the same results whether or not it writes each batch of documents
+ * while it builds the next one, and that the errors of the writes made in the background are
+ * reported by the aggregation.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const source = db.merge_write_behind_source;
+const target = db.merge_write_behind_target;
+source.drop();
+
+// Large enough documents for the input to be written in several batches.
+const docs = [];
+for (let i = 0; i < 3000; i++) {
+    docs.push({_id: i, a: i % 17, str: "x".repeat(16 * 1024)});
+}
+assert.commandWorked(source.insert(docs));
+
+function runMerge(mergeSpec, writeBehind, existingIds) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryEnableMergeWriteBehind: writeBehind}));
+    target.drop();
+    assert.commandWorked(target.insert(existingIds.map(id => ({_id: id}))));
+    return db.runCommand({
+        aggregate: source.getName(),
+        pipeline: [{$sort: {_id: 1}}, {$merge: Object.assign({into: target.getName()}, mergeSpec)}],
+        cursor: {},
+    });
+}
+
+function getMergeResults(mergeSpec, writeBehind) {
+    // Half of the documents already exist in the target collection.
+    const oddIds = docs.filter(doc => doc._id % 2).map(doc => doc._id);
+    assert.commandWorked(runMerge(mergeSpec, writeBehind, oddIds));
+    return target.find().sort({_id: 1}).toArray();
+}
+
+const mergeSpecs = [
+    {whenMatched: "replace", whenNotMatched: "insert"},
+    {whenMatched: "merge", whenNotMatched: "insert"},
+    {whenMatched: "keepExisting", whenNotMatched: "insert"},
+    {whenMatched: "replace", whenNotMatched: "discard"},
+    {whenMatched: "merge", whenNotMatched: "discard"},
+    {whenMatched: [{$set: {b: "$a"}}], whenNotMatched: "insert"},
+    {whenMatched: [{$set: {b: "$$new.a"}}], whenNotMatched: "discard"},
+    {let: {c: "$a"}, whenMatched: [{$set: {c: "$$c"}}], whenNotMatched: "discard"},
+];
+for (const mergeSpec of mergeSpecs) {
+    assert.eq(
+        getMergeResults(mergeSpec, false), getMergeResults(mergeSpec, true), tojson(mergeSpec));
+}
+
+// A write which fails in the background, in the first or the last batch, fails the aggregation.
+const lastId = docs.length - 1;
+for (const writeBehind of [false, true]) {
+    assert.commandFailedWithCode(
+        runMerge({whenMatched: "fail", whenNotMatched: "insert"}, writeBehind, [lastId]),
+        ErrorCodes.DuplicateKey);
+    assert.commandFailedWithCode(
+        runMerge({whenMatched: "replace", whenNotMatched: "fail"}, writeBehind, [lastId]), 13113);
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,27 @@
+/**
+ * Tests that --wiredTigerOplogBlockCompressor sets the block compressor of the oplog, and only of
+ * the oplog, in place of --wiredTigerCollectionBlockCompressor.
+ *
+ * @tags: [requires_replication,requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions:
+        {wiredTigerCollectionBlockCompressor: "snappy", wiredTigerOplogBlockCompressor: "zstd"}
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const oplogStats = primary.getDB("local").oplog.rs.stats();
+assert(oplogStats.wiredTiger.creationString.search("block_compressor=zstd") > -1, oplogStats);
+
+assert.commandWorked(primary.getDB("test").coll.insert({}));
+const collStats = primary.getDB("test").coll.stats();
+assert(collStats.wiredTiger.creationString.search("block_compressor=snappy") > -1, collStats);
+
+rst.stopSet();
+}());
@@ -0,0 +1,36 @@
+/**
+ * Tests that a node restarted with storageEngineCatalogLoadThreads > 1 opens every collection and
+ * index in the durable catalog.
+ *
+ * @tags: [requires_persistence]
+ */
+(function() {
+'use strict';
+
+const numCollections = 50;
+
+let conn = MongoRunner.runMongod();
+let db = conn.getDB("test");
+for (let i = 0; i < numCollections; i++) {
+    const coll = db.getCollection("coll" + i);
+    assert.commandWorked(coll.insert({_id: i, a: i}));
+    assert.commandWorked(coll.createIndex({a: 1}));
+}
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod({
+    dbpath: conn.dbpath,
+    noCleanData: true,
+    setParameter: {storageEngineCatalogLoadThreads: 8},
+});
+db = conn.getDB("test");
+checkLog.containsJson(conn, 5191150);
+
+assert.eq(numCollections, db.getCollectionNames().length);
+for (let i = 0; i < numCollections; i++) {
+    const coll = db.getCollection("coll" + i);
+    assert.eq(1, coll.find({a: i}).hint({a: 1}).itcount());
+    assert.eq(2, coll.getIndexes().length);
+}
+MongoRunner.stopMongod(conn);
+}());
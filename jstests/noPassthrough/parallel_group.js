@@ -0,0 +1,90 @@
+/**
+ * Tests that a $group over a collection scan computes the same results when its partial groups are
+ * computed by several threads, and that errors and interruptions of the workers are reported.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const coll = db.parallel_group;
+
+const numDocs = 20000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, k: i % 97, x: i % 13, s: 'str' + (i % 5)});
+}
+assert.commandWorked(bulk.execute());
+
+const pipelines = [
+    [{$group: {_id: '$k', total: {$sum: '$x'}, avg: {$avg: '$x'}, n: {$sum: 1}}}],
+    [
+        {$match: {x: {$gte: 3}}},
+        {$addFields: {y: {$multiply: ['$x', 2]}}},
+        {$group: {_id: {k: '$k', s: '$s'}, min: {$min: '$y'}, max: {$max: '$y'}}},
+        {$sort: {'_id.k': 1, '_id.s': 1}},
+        {$limit: 50}
+    ],
+    [
+        {$group: {_id: '$s', xs: {$addToSet: '$x'}}},
+        {$project: {n: {$size: '$xs'}}},
+        {$sort: {_id: 1}}
+    ],
+    [{$group: {_id: null, stdDev: {$stdDevPop: '$x'}, count: {$sum: 1}}}],
+];
+
+function setWorkers(n) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalDocumentSourceGroupParallelWorkers: n}));
+}
+
+setWorkers(0);
+const expected = pipelines.map((pipeline) => coll.aggregate(pipeline).toArray());
+
+for (let workers of [2, 4, 8]) {
+    setWorkers(workers);
+    pipelines.forEach((pipeline, i) => {
+        const results = coll.aggregate(pipeline).toArray();
+        if (pipeline.some((stage) => stage.$sort)) {
+            assert.eq(expected[i], results, tojson(pipeline));
+        } else {
+            assert.sameMembers(expected[i], results, tojson(pipeline));
+        }
+    });
+}
+
+// An error in one of the workers fails the aggregation with that error.
+setWorkers(4);
+const error = assert.throws(() => coll.aggregate([
+                                          {$group: {_id: '$k', q: {$sum: {$divide: [1, '$x']}}}}
+                                      ])
+                                .toArray());
+assert.commandFailedWithCode(error, 16608);
+
+// The time limit of the aggregation applies to the workers.
+assert.commandFailedWithCode(db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{
+        $group: {
+            _id: '$k',
+            slow: {
+                $sum: {
+                    $function: {
+                        body: function(x) {
+                            sleep(10);
+                            return x;
+                        },
+                        args: ['$x'],
+                        lang: 'js'
+                    }
+                }
+            }
+        }
+    }],
+    cursor: {},
+    maxTimeMS: 1000
+}),
+                             ErrorCodes.MaxTimeMSExpired);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -141,5 +141,44 @@ verifyPlanCacheSizeIncrease(coll);
 assert.commandWorked(coll.dropIndexes());
 assert.eq(getPlanCacheSize(), originalPlanCacheSize);
 
+// Test the hit, miss and eviction counters of the server-wide plan cache.
+
+function getPlanCacheCounters() {
+    const serverStatus = assert.commandWorked(db.serverStatus());
+    return serverStatus.metrics.query.planCache;
+}
+
+coll = db.query_metrics_counters;
+coll.drop();
+verifyPlanCacheSizeIncrease(coll);
+
+// The entry for the shape was created inactive by the first run, and activated by the second.
+// Running the query again uses the cached plan.
+let prevCounters = getPlanCacheCounters();
+assert.eq(1, coll.find(queryObj).itcount(), 'unexpected document count');
+assert.eq(1, coll.find(queryObj).itcount(), 'unexpected document count');
+let counters = getPlanCacheCounters();
+assert.gt(counters.hits, prevCounters.hits, counters);
+
+// A new shape misses the cache.
+prevCounters = counters;
+assert.eq(1, coll.find({a: {$gte: 99}, b: {$lt: 0}}).itcount(), 'unexpected document count');
+counters = getPlanCacheCounters();
+assert.gt(counters.misses, prevCounters.misses, counters);
+
+// With no memory to spare, new cache entries are evicted as soon as they are created.
+const originalPlanCacheSizeBytes =
+    assert.commandWorked(db.adminCommand({getParameter: 1, internalQueryPlanCacheSizeBytes: 1}))
+        .internalQueryPlanCacheSizeBytes;
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryPlanCacheSizeBytes: 0}));
+coll.getPlanCache().clear();
+prevCounters = counters;
+assert.eq(1, coll.find(queryObj).itcount(), 'unexpected document count');
+counters = getPlanCacheCounters();
+assert.gt(counters.evictions, prevCounters.evictions, counters);
+assertCacheLength(coll, 0);
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQueryPlanCacheSizeBytes: originalPlanCacheSizeBytes}));
+
 MongoRunner.stopMongod(conn);
 })();
@@ -0,0 +1,78 @@
+/**
+ * Tests that the plan cache entries recorded by the planCacheSnapshot command warm up the plan
+ * cache of a node when it steps up, and when the planCacheRestore command is run.
+ * @tags: [
+ *     requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const coll = primary.getDB("test").plan_cache_snapshot_restore;
+
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    docs.push({_id: i, a: i, b: i % 10});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+function getCacheEntries(node) {
+    return node.getDB("test")
+        .plan_cache_snapshot_restore.aggregate([{$planCacheStats: {}}])
+        .toArray()
+        .map(entry => ({query: entry.createdFromQuery.query, isActive: entry.isActive}));
+}
+
+// Run each query twice, so that its plan cache entry becomes active.
+const queries = [{a: {$gte: 10, $lt: 20}, b: 5}, {a: {$gte: 50}, b: {$in: [1, 2]}}];
+for (let i = 0; i < 2; i++) {
+    for (const query of queries) {
+        coll.find(query).itcount();
+    }
+}
+const entries = getCacheEntries(primary);
+assert.eq(queries.length, entries.length, entries);
+
+const res = assert.commandWorked(coll.runCommand("planCacheSnapshot"));
+assert.eq(queries.length, res.numEntries, res);
+rst.awaitReplication();
+
+// The secondary hasn't run the queries, so its plan cache is cold until it steps up.
+const secondary = rst.getSecondary();
+secondary.setSecondaryOk();
+assert.eq([], getCacheEntries(secondary));
+rst.stepUp(secondary);
+assert.sameMembers(entries, getCacheEntries(secondary));
+
+// The planCacheRestore command seeds an empty plan cache, but leaves existing entries in place.
+const newPrimaryColl = secondary.getDB("test").plan_cache_snapshot_restore;
+assert.commandWorked(newPrimaryColl.runCommand("planCacheClear"));
+assert.eq(queries.length,
+          assert.commandWorked(newPrimaryColl.runCommand("planCacheRestore")).numRestored);
+assert.sameMembers(entries, getCacheEntries(secondary));
+assert.eq(0, assert.commandWorked(newPrimaryColl.runCommand("planCacheRestore")).numRestored);
+
+// Nothing is restored on step-up when the knob is disabled.
+const oldPrimary = rst.getSecondary();
+oldPrimary.setSecondaryOk();
+const oldPrimaryColl = oldPrimary.getDB("test").plan_cache_snapshot_restore;
+assert.commandWorked(
+    oldPrimary.adminCommand({setParameter: 1, internalQueryPlanCacheRestoreOnStepUp: false}));
+assert.commandWorked(oldPrimaryColl.runCommand("planCacheClear"));
+rst.stepUp(oldPrimary);
+assert.eq([], getCacheEntries(oldPrimary));
+
+// Entries whose plan uses an index which has been dropped are not restored.
+assert.commandWorked(oldPrimaryColl.dropIndexes(["a_1", "b_1"]));
+assert.eq(0, assert.commandWorked(oldPrimaryColl.runCommand("planCacheRestore")).numRestored);
+assert.eq([], getCacheEntries(oldPrimary));
+
+rst.stopSet();
+}());
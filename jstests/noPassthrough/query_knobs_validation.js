@@ -15,6 +15,7 @@ const expectedParamDefaults = {
     internalQueryPlanEvaluationCollFraction: 0.3,
     internalQueryPlanEvaluationMaxResults: 101,
     internalQueryCacheSize: 5000,
+    internalQueryPlanCacheSizeBytes: 100 * 1024 * 1024,
     internalQueryCacheEvictionRatio: 10.0,
     internalQueryCacheWorksGrowthCoefficient: 2.0,
     internalQueryCacheDisableInactiveEntries: false,
@@ -90,6 +91,10 @@ assertSetParameterSucceeds("internalQueryCacheSize", 1);
 assertSetParameterSucceeds("internalQueryCacheSize", 0);
 assertSetParameterFails("internalQueryCacheSize", -1);
 
+assertSetParameterSucceeds("internalQueryPlanCacheSizeBytes", 1024);
+assertSetParameterSucceeds("internalQueryPlanCacheSizeBytes", 0);
+assertSetParameterFails("internalQueryPlanCacheSizeBytes", -1);
+
 assertSetParameterSucceeds("internalQueryCacheEvictionRatio", 1.0);
 assertSetParameterSucceeds("internalQueryCacheEvictionRatio", 0.0);
 assertSetParameterFails("internalQueryCacheEvictionRatio", -0.1);
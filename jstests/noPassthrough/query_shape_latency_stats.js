@@ -0,0 +1,102 @@
+/**
+ * Tests the per query shape statistics reported by the queryShapeLatencies serverStatus section and
+ * the $queryShapeStats aggregation stage, including the bound on the number of tracked shapes.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.query_shape_latency_stats;
+assert.commandWorked(coll.insert([{a: 1, b: 1}, {a: 2, b: 2}]));
+
+function getShapes() {
+    return assert.commandWorked(db.adminCommand({serverStatus: 1, queryShapeLatencies: 1}))
+        .queryShapeLatencies.shapes;
+}
+
+function getShape(queryHash) {
+    return getShapes().find((shape) => shape.queryHash === queryHash);
+}
+
+function getQueryHash(filter) {
+    return assert.commandWorked(coll.find(filter).explain()).queryPlanner.queryHash;
+}
+
+// Look up the query hashes while tracking is still disabled, so that the explains do not take up
+// entries of their own.
+const hashA = getQueryHash({a: 1});
+const hashB = getQueryHash({b: 1});
+const hashAB = getQueryHash({a: 1, b: 1});
+assert.eq(0, getShapes().length, getShapes());
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryShapeLatencyStatsMaxEntries: 16}));
+
+// The section is not part of the default serverStatus output.
+assert(!db.adminCommand({serverStatus: 1}).hasOwnProperty("queryShapeLatencies"));
+
+// Queries of the same shape share a histogram.
+assert.eq(1, coll.find({a: 1}).itcount());
+assert.eq(1, coll.find({a: 2}).itcount());
+const shapeA = getShape(hashA);
+assert(shapeA, getShapes());
+assert.eq(coll.getFullName(), shapeA.ns, shapeA);
+assert.eq("find", shapeA.command, shapeA);
+assert.eq(2, shapeA.execCount, shapeA);
+assert.eq(2, shapeA.latencyStats.reads.ops, shapeA);
+assert.eq(4, shapeA.docsExamined, shapeA);
+assert.eq(0, shapeA.keysExamined, shapeA);
+assert.eq("COLLSCAN", shapeA.lastPlanSummary, shapeA);
+
+// A second shape gets its own histogram.
+assert.eq(1, coll.find({b: 1}).itcount());
+const shapeB = getShape(hashB);
+assert(shapeB, getShapes());
+assert.eq(1, shapeB.latencyStats.reads.ops, shapeB);
+assert.eq(2, getShapes().length, getShapes());
+
+// The last plan summary follows the plan that was used most recently.
+assert.commandWorked(coll.createIndex({b: 1}));
+assert.eq(1, coll.find({b: 1}).itcount());
+const shapeBIndexed = getShape(hashB);
+assert.eq(2, shapeBIndexed.execCount, shapeBIndexed);
+assert.eq("IXSCAN { b: 1 }", shapeBIndexed.lastPlanSummary, shapeBIndexed);
+assert.gte(shapeBIndexed.keysExamined, 1, shapeBIndexed);
+
+// $queryShapeStats reports the shapes of its own collection only.
+const otherColl = db.query_shape_latency_stats_other;
+assert.commandWorked(otherColl.insert({a: 1}));
+assert.eq(1, otherColl.find({a: 1}).itcount());
+const stageShapes = coll.aggregate([{$queryShapeStats: {}}]).toArray();
+assert.eq(2, stageShapes.length, stageShapes);
+for (let shape of stageShapes) {
+    assert.eq(coll.getFullName(), shape.ns, shape);
+    assert(shape.hasOwnProperty("host"), shape);
+    assert(shape.latencyStats.reads.hasOwnProperty("histogram"), shape);
+}
+assert.eq(1, otherColl.aggregate([{$queryShapeStats: {}}]).itcount());
+
+// The number of tracked shapes stays bounded, and a new shape always has room.
+for (let i = 0; i < 40; i++) {
+    assert.eq(0, coll.find({["f" + i]: 1}).itcount());
+}
+assert.eq(1, coll.find({a: 1, b: 1}).itcount());
+assert.lte(getShapes().length, 16, getShapes());
+assert(getShape(hashAB), getShapes());
+
+// Histograms are included on request.
+assert(getShapes()[0].latencyStats.reads.hasOwnProperty("ops"));
+const withHistograms = assert.commandWorked(
+    db.adminCommand({serverStatus: 1, queryShapeLatencies: {histograms: true}}));
+assert(withHistograms.queryShapeLatencies.shapes[0].latencyStats.reads.hasOwnProperty("histogram"),
+       withHistograms.queryShapeLatencies);
+
+// Setting the limit to 0 stops the tracking of new operations.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryShapeLatencyStatsMaxEntries: 0}));
+const opsBefore = getShape(hashAB).latencyStats.reads.ops;
+assert.eq(1, coll.find({a: 1, b: 1}).itcount());
+assert.eq(opsBefore, getShape(hashAB).latencyStats.reads.ops);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,61 @@
+/**
+ * Tests that queries return the same results when their storage-layer cursors are read once,
+ * whether it is requested by the query or chosen for a large unindexed collection scan, and that
+ * validate can read collections with read once cursors.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.read_once_collection_scans;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 500; i++) {
+    docs.push({_id: i, x: i % 10, s: "a".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({x: 1}));
+assert.commandWorked(db.createView("read_once_view", coll.getName(), [{$match: {x: 3}}]));
+
+function runQueries(readOnce) {
+    const findCmd = {find: coll.getName(), sort: {_id: 1}, batchSize: 10, readOnce: readOnce};
+    const findCursor = new DBCommandCursor(db, assert.commandWorked(db.runCommand(findCmd)));
+    assert.eq(docs, findCursor.toArray());
+    assert.eq(50, coll.find({x: 3}).hint({x: 1}).itcount());
+
+    const options = {cursor: {batchSize: 10}, readOnce: readOnce};
+    const pipeline = [{$match: {s: {$exists: true}}}, {$sort: {_id: 1}}];
+    assert.eq(docs, coll.aggregate(pipeline, options).toArray());
+    const groupPipeline = [{$match: {x: 3}}, {$group: {_id: "$x", n: {$sum: 1}}}];
+    assert.eq([{_id: 3, n: 50}], coll.aggregate(groupPipeline, options).toArray());
+
+    // A view runs its aggregation with the option of the query.
+    const viewCmd = {find: "read_once_view", batchSize: 10, readOnce: readOnce};
+    const viewCursor = new DBCommandCursor(db, assert.commandWorked(db.runCommand(viewCmd)));
+    assert.eq(50, viewCursor.itcount());
+}
+runQueries(false);
+runQueries(true);
+
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [], cursor: {}, readOnce: 1}),
+    ErrorCodes.TypeMismatch);
+
+// Collection scans of collections above the threshold are read once without asking for it.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryReadOnceCollectionScanMinBytes: 1}));
+runQueries(false);
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryReadOnceCollectionScanMinBytes: 0}));
+
+// Validate reads with read once cursors by default.
+assert.commandWorked(coll.validate({full: true}));
+assert.commandWorked(db.adminCommand({setParameter: 1, useReadOnceCursorsForValidate: false}));
+assert.commandWorked(coll.validate({full: true}));
+
+MongoRunner.stopMongod(conn);
+}());
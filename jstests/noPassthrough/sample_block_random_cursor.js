@@ -0,0 +1,55 @@
+/**
+ * Tests that a $sample read with a random cursor returns distinct documents, both one record per
+ * random position and in blocks of neighboring records, and that raising the maximum sample ratio
+ * lets larger samples use the random cursor.
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load('jstests/libs/analyze_plan.js');  // For aggPlanHasStage().
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.sample_block_random_cursor;
+
+const nDocs = 5000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; ++i) {
+    bulk.insert({_id: i, x: i % 7});
+}
+assert.commandWorked(bulk.execute());
+
+function runSample(sampleSize, expectRandomCursor) {
+    const pipeline = [{$sample: {size: sampleSize}}];
+    assert.eq(aggPlanHasStage(coll.explain().aggregate(pipeline), "$sampleFromRandomCursor"),
+              expectRandomCursor);
+
+    const results = coll.aggregate(pipeline).toArray();
+    assert.eq(results.length, sampleSize);
+    const ids = new Set(results.map(doc => doc._id));
+    assert.eq(ids.size, sampleSize, tojson(results));
+    for (let doc of results) {
+        assert.eq(doc.x, doc._id % 7, tojson(doc));
+    }
+}
+
+for (let blockSize of [1, 10, 1000]) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQuerySampleFromRandomCursorBlockSize: blockSize}));
+    runSample(200, true);
+}
+
+// A 20% sample scans the collection by default.
+runSample(1000, false);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryMaxSampleRatioForRandomCursor: 0.25}));
+for (let blockSize of [1, 50]) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQuerySampleFromRandomCursorBlockSize: blockSize}));
+    runSample(1000, true);
+}
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,54 @@
+/**
+ * Test that the slot-based execution engine answers queries with index intersection plans
+ * correctly, both for sorted and for hashed intersections.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalQueryEnableSlotBasedExecutionEngine: true,
+        internalQueryForceIntersectionPlans: true,
+    }
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_index_intersection;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 300; i++) {
+    docs.push({_id: i, a: i % 7, b: i % 11, c: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+assert.commandWorked(coll.createIndex({c: 1}));
+
+function assertResults(filter, sort, predicate) {
+    const expected = docs.filter(predicate).map(doc => doc._id);
+    if (sort.c === -1) {
+        expected.reverse();
+    }
+    const actual = coll.find(filter).sort(sort).toArray().map(doc => doc._id);
+    assert.eq(expected, actual, tojson(filter));
+}
+
+// Equality predicates on both indexes produce RecordId-ordered scans, and so a sorted intersection.
+assertResults({a: 3, b: 5}, {_id: 1}, doc => doc.a === 3 && doc.b === 5);
+assertResults({a: 3, b: 5, c: {$gte: 100}},
+              {_id: 1},
+              doc => doc.a === 3 && doc.b === 5 && doc.c >= 100);
+
+// Range predicates call for a hashed intersection, which must provide the sort of its last child.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerEnableHashIntersection: true}));
+assertResults({a: {$gte: 5}, c: {$gte: 150, $lt: 250}},
+              {c: -1},
+              doc => doc.a >= 5 && doc.c >= 150 && doc.c < 250);
+assertResults({a: {$lte: 1}, b: {$gt: 8}},
+              {_id: 1},
+              doc => doc.a <= 1 && doc.b > 8);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,60 @@
+/**
+ * Tests that SBE index scans return the same entries whether they read them from the index one at
+ * a time or in blocks, including when they yield in the middle of a block.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter:
+        {internalQueryEnableSlotBasedExecutionEngine: true, internalQueryExecYieldIterations: 7}
+});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_index_scan_blocks;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i % 50, b: "str" + (i % 37), c: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.commandWorked(coll.createIndex({c: 1}, {unique: true}));
+
+function runQuery(query, blockSize) {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQuerySlotBasedExecutionIndexScanBlockSize: blockSize}));
+    return query().toArray();
+}
+
+const queries = [
+    () => coll.find({a: {$gte: 10, $lt: 20}}, {_id: 0, a: 1, b: 1}).hint({a: 1, b: 1}),
+    () => coll.find({a: {$gte: 10, $lte: 20}}).sort({a: -1, b: -1}).hint({a: 1, b: 1}),
+    () => coll.find({a: {$in: [3, 7, 49]}, b: {$gt: "str2"}}).hint({a: 1, b: 1}),
+    () => coll.find({c: {$gt: 100, $lte: 900}}).hint({c: 1}),
+    () => coll.find({c: {$gte: 0}}).sort({c: -1}).hint({c: 1}),
+    () => coll.find({_id: {$gte: 500}}).hint({_id: 1}),
+];
+for (const query of queries) {
+    const expected = runQuery(query, 0);
+    assert.gt(expected.length, 0);
+    for (const blockSize of [1, 4, 128]) {
+        assert.eq(expected, runQuery(query, blockSize), query.toString());
+    }
+}
+
+// The entries read ahead of a batch are read again by the getMore, so it doesn't return those
+// removed in the meantime.
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQuerySlotBasedExecutionIndexScanBlockSize: 128}));
+const cursor = coll.find({c: {$gte: 0}}, {_id: 0, c: 1}).sort({c: 1}).hint({c: 1}).batchSize(10);
+for (let i = 0; i < 10; i++) {
+    assert.eq({c: i}, cursor.next());
+}
+assert.commandWorked(coll.remove({c: {$gte: 10, $lt: 100}}));
+assert.eq({c: 100}, cursor.next());
+assert.eq(899, cursor.itcount());
+
+MongoRunner.stopMongod(conn);
+}());
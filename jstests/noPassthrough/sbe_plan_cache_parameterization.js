@@ -0,0 +1,71 @@
+/**
+ * Test that queries of the same shape which differ in their values return correct results when the
+ * slot-based execution engine reuses the trees built for each other from the plan cache.
+ */
+(function() {
+"use strict";
+
+const conn =
+    MongoRunner.runMongod({setParameter: {internalQueryEnableSlotBasedExecutionEngine: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.sbe_plan_cache_parameterization;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 200; i++) {
+    docs.push({_id: i, a: i, b: i % 10, c: "str" + (i % 20), d: new Date(i * 1000)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+assert.commandWorked(coll.createIndex({c: 1, a: 1}));
+
+function assertResults(filter, predicate) {
+    const expected = docs.filter(predicate).map(doc => doc._id);
+    const actual = coll.find(filter).sort({_id: 1}).toArray().map(doc => doc._id);
+    assert.eq(expected, actual, tojson(filter));
+}
+
+// Run each query several times, interleaved with the other queries of the same shape, so that its
+// plan cache entry becomes active and the trees are reused with the values of the other queries.
+function runInterleaved(queries) {
+    for (let round = 0; round < 3; round++) {
+        for (const [filter, predicate] of queries) {
+            assertResults(filter, predicate);
+        }
+    }
+}
+
+// Range predicates, which make up both the index bounds and the residual filters.
+runInterleaved([10, 50, 120, 190, 300].map(
+    low => [{a: {$gte: low, $lt: low + 25}, b: {$gt: 3}},
+            doc => doc.a >= low && doc.a < low + 25 && doc.b > 3]));
+
+// Equality predicates on strings, with a compound index scan.
+runInterleaved(["str1", "str7", "str19", "nonexistent"].map(
+    str => [{c: str, a: {$lte: 150}}, doc => doc.c === str && doc.a <= 150]));
+
+// Dates, and values of different numeric types, which are parameterized separately.
+runInterleaved([[5, 5], [50.5, 50.5], [NumberLong(100), 100], [NumberDecimal("150.5"), 150.5]].map(
+    ([bound, number]) => [{a: {$lt: bound}, d: {$gte: new Date(20000)}},
+                          doc => doc.a < number && doc.d >= new Date(20000)]));
+
+// Disjunctions, whose index bounds consist of several intervals.
+runInterleaved([[1, 2], [3, 8], [0, 9]].map(
+    ([x, y]) => [{$or: [{b: x}, {b: y}], a: {$gt: 100}},
+                 doc => (doc.b === x || doc.b === y) && doc.a > 100]));
+
+// Values which are not parameterized must still be taken into account. No document has a missing
+// or an array 'b' field.
+runInterleaved([[null, doc => false], [5, doc => doc.b === 5], [[1, 2], doc => false]].map(
+    ([value, predicate]) => [{b: value, a: {$gte: 0}}, predicate]));
+
+// The same queries are answered correctly once parameterization is disabled.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableSlotBasedPlanParameterization: false}));
+runInterleaved([10, 50].map(low => [{a: {$gte: low, $lt: low + 25}, b: {$gt: 3}},
+                                    doc => doc.a >= low && doc.a < low + 25 && doc.b > 3]));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,76 @@
+/**
+ * Test that with pinSnapshotHistoryOnlyForActiveReaders, the server keeps snapshot history for the
+ * active snapshot readers only, and releases it once they finish, even within
+ * minSnapshotHistoryWindowInSeconds.
+ *
+ * @tags: [
+ *   requires_majority_read_concern,
+ *   requires_persistence,
+ *   requires_replication,
+ *   uses_transactions,
+ * ]
+ */
+(function() {
+"use strict";
+
+const replSet = new ReplSetTest({nodes: 1});
+replSet.startSet();
+replSet.initiate();
+
+const collName = "coll";
+const primary = replSet.getPrimary();
+const primaryDB = primary.getDB('test');
+
+assert.commandWorked(
+    primaryDB.adminCommand({setParameter: 1, minSnapshotHistoryWindowInSeconds: 600}));
+assert.commandWorked(
+    primaryDB.adminCommand({setParameter: 1, pinSnapshotHistoryOnlyForActiveReaders: true}));
+
+let nextId = 0;
+function majorityInsert() {
+    return assert
+        .commandWorked(primaryDB.runCommand(
+            {insert: collName, documents: [{_id: nextId++}], writeConcern: {w: "majority"}}))
+        .operationTime;
+}
+
+function advanceStableTimestamp() {
+    for (let i = 0; i < 5; ++i) {
+        majorityInsert();
+    }
+}
+
+// An open transaction keeps reading from its snapshot while the stable timestamp moves on.
+const insertTimestamp = majorityInsert();
+const session = primary.startSession({causalConsistency: false});
+const sessionColl = session.getDatabase('test')[collName];
+session.startTransaction({readConcern: {level: "snapshot"}});
+const numDocsInSnapshot = sessionColl.find().itcount();
+advanceStableTimestamp();
+assert.eq(numDocsInSnapshot, sessionColl.find().itcount());
+
+const settings = assert.commandWorked(primaryDB.adminCommand({serverStatus: 1}))
+                     .wiredTiger["snapshot-window-settings"];
+assert.eq(true, settings["snapshot history pinned only for active readers"], tojson(settings));
+assert(settings.hasOwnProperty("oldest active snapshot reader timestamp"), tojson(settings));
+assert(settings.hasOwnProperty("history store table on-disk size"), tojson(settings));
+
+// Once no reader needs it, the history is released although it is within the window.
+assert.commandWorked(session.commitTransaction_forTesting());
+session.endSession();
+advanceStableTimestamp();
+assert.commandFailedWithCode(
+    primaryDB.runCommand(
+        {find: collName, readConcern: {level: "snapshot", atClusterTime: insertTimestamp}}),
+    ErrorCodes.SnapshotTooOld);
+
+// Without the parameter, the whole window is kept again for the new history.
+assert.commandWorked(
+    primaryDB.adminCommand({setParameter: 1, pinSnapshotHistoryOnlyForActiveReaders: false}));
+const laterTimestamp = majorityInsert();
+advanceStableTimestamp();
+assert.commandWorked(primaryDB.runCommand(
+    {find: collName, readConcern: {level: "snapshot", atClusterTime: laterTimestamp}}));
+
+replSet.stopSet();
+})();
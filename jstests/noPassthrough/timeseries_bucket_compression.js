@@ -0,0 +1,42 @@
+/**
+ * Tests that the columns of dates and doubles of the closed buckets of a time-series collection are
+ * compressed, and that the measurements read back from them are unchanged.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {timeseriesBucketMaxCount: 10}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.timeseries_bucket_compression;
+const buckets = db.getCollection("system.buckets." + coll.getName());
+coll.drop();
+
+assert.commandWorked(db.createCollection(coll.getName(), {timeseries: {timeField: "t"}}));
+
+const start = ISODate("2021-01-01T00:00:00Z").getTime();
+const docs = [];
+for (let i = 0; i < 35; i++) {
+    docs.push({_id: NumberInt(i), t: new Date(start + i * 1000), x: 20 + i / 4, s: "s" + i});
+}
+assert.commandWorked(coll.insert(docs.slice(0, 20)));
+for (const doc of docs.slice(20)) {
+    assert.commandWorked(coll.insert(doc));
+}
+
+// The three buckets closed when the next measurement didn't fit are compressed, but the columns of
+// integers and strings and the open bucket are not.
+assert.eq(4, buckets.find().itcount());
+assert.eq(3, buckets.find({"data.t": {$type: "binData"}, "data.x": {$type: "binData"}}).itcount());
+assert.eq(4, buckets.find({"data._id": {$type: "object"}, "data.s": {$type: "object"}}).itcount());
+assert.eq(1, buckets.find({"data.t": {$type: "object"}}).itcount());
+
+// The bounds of the buckets are kept, so queries can still skip compressed buckets.
+assert.eq(2, buckets.find({"control.max.x": {$lt: 27}}).itcount());
+
+assert.sameMembers(docs, coll.find().toArray());
+const later = new Date(start + 15 * 1000);
+assert.sameMembers(docs.filter(doc => doc.t >= later), coll.find({t: {$gte: later}}).toArray());
+
+MongoRunner.stopMongod(conn);
+}());
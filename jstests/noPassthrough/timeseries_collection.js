@@ -0,0 +1,77 @@
+/**
+ * Tests that the measurements inserted into a time-series collection are stored in buckets of
+ * measurements with the same metadata and close times, and are read back from the collection.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.timeseries_collection;
+const buckets = db.getCollection("system.buckets." + coll.getName());
+coll.drop();
+
+// The time and metadata fields must be distinct top-level fields.
+assert.commandFailedWithCode(
+    db.createCollection(coll.getName(), {timeseries: {timeField: "t", metaField: "t"}}),
+    ErrorCodes.BadValue);
+assert.commandFailedWithCode(
+    db.createCollection(coll.getName(), {timeseries: {timeField: "a.b"}}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(
+    db.createCollection(coll.getName(),
+                        {timeseries: {timeField: "t"}, capped: true, size: 1024 * 1024}),
+    ErrorCodes.InvalidOptions);
+
+assert.commandWorked(db.createCollection(
+    coll.getName(), {timeseries: {timeField: "t", metaField: "m", bucketMaxSpanSeconds: 60}}));
+assert.eq(1, db.getCollectionInfos({name: coll.getName(), type: "view"}).length);
+assert.commandFailedWithCode(db.createCollection(coll.getName(), {timeseries: {timeField: "t"}}),
+                             ErrorCodes.NamespaceExists);
+
+const start = ISODate("2021-01-01T00:00:00Z").getTime();
+const docs = [];
+for (let i = 0; i < 100; i++) {
+    docs.push({_id: i, t: new Date(start + i * 1000), x: i, m: {sensor: i % 2}});
+}
+assert.commandWorked(coll.insert(docs.slice(0, 50)));
+assert.commandWorked(coll.insert(docs.slice(50), {ordered: false}));
+
+// Two sensors, each with measurements spanning 100 seconds, in buckets spanning 60 seconds.
+assert.eq(4, buckets.find().itcount(), tojson(buckets.find().toArray()));
+const bucket = buckets.findOne({"meta.sensor": 0, "control.min.t": new Date(start)});
+assert.eq(1, bucket.control.version, tojson(bucket));
+assert.eq(new Date(start + 58 * 1000), bucket.control.max.t, tojson(bucket));
+assert.eq(0, bucket.control.min.x, tojson(bucket));
+assert.eq(58, bucket.control.max.x, tojson(bucket));
+
+assert.sameMembers(docs, coll.find().toArray());
+assert.eq(100, coll.count());
+
+// A $match on the time or metadata of the measurements only unpacks the buckets which can match.
+const later = new Date(start + 70 * 1000);
+assert.sameMembers(docs.filter(doc => doc.t >= later && doc.m.sensor === 1),
+                   coll.find({t: {$gte: later}, "m.sensor": 1}).toArray());
+const explain = coll.explain("executionStats").aggregate([{$match: {t: {$gte: later}}}]);
+assert.eq(2, explain.stages[0].$cursor.executionStats.nReturned, tojson(explain));
+
+// Measurements must have a date in their time field.
+let res = coll.insert([{_id: 100, t: new Date(start), x: 1}, {_id: 101, t: 1}, {_id: 102}],
+                      {ordered: false});
+assert.eq(1, res.nInserted, tojson(res));
+assert.eq(2, res.getWriteErrors().length, tojson(res));
+assert.eq(5190411, res.getWriteErrors()[0].code, tojson(res));
+res = coll.insert([{_id: 103, t: 1}, {_id: 104, t: new Date(start)}]);
+assert.eq(0, res.nInserted, tojson(res));
+assert.eq(null, coll.findOne({_id: 104}));
+assert.eq(1, coll.find({_id: 100}).itcount());
+
+// Measurements without metadata go into their own buckets.
+assert.eq(null, buckets.findOne({"data._id.0": 100}).meta);
+
+// Dropping the collection drops its buckets.
+assert(coll.drop());
+assert.eq(0, db.getCollectionInfos({name: buckets.getName()}).length);
+
+MongoRunner.stopMongod(conn);
+}());
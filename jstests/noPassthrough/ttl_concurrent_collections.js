@@ -0,0 +1,42 @@
+/**
+ * Tests that the TTL monitor expires documents from several collections when their TTL indexes are
+ * processed concurrently, and that it still does so serially.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {ttlMonitorSleepSecs: 1, ttlMonitorMaxConcurrentCollections: 4}});
+const db = conn.getDB("test");
+
+const numColls = 6;
+const now = new Date();
+const past = new Date(now.getTime() - 1000 * 60 * 60);
+
+function populate() {
+    for (let i = 0; i < numColls; i++) {
+        const coll = db.getCollection("ttl_concurrent_" + i);
+        assert.commandWorked(coll.createIndex({x: 1}, {expireAfterSeconds: 60}));
+        assert.commandWorked(coll.insert([{x: past}, {x: past}, {x: now}]));
+    }
+}
+
+function waitForExpiry() {
+    // Wait for two passes in case the first one started before the documents were inserted.
+    const passes = db.serverStatus().metrics.ttl.passes;
+    assert.soon(() => db.serverStatus().metrics.ttl.passes >= passes + 2);
+    for (let i = 0; i < numColls; i++) {
+        const coll = db.getCollection("ttl_concurrent_" + i);
+        assert.eq(1, coll.find().itcount(), coll.getName());
+    }
+}
+
+populate();
+waitForExpiry();
+
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorMaxConcurrentCollections: 1}));
+populate();
+waitForExpiry();
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,98 @@
+/**
+ * Tests that $unionWith on mongos returns the same results whether or not it reads ahead from its
+ * sub-pipeline while the documents of its input are being returned, including across getMores,
+ * views, nested $unionWith stages and errors in the sub-pipeline.
+ *
+ * @tags: [
+ *   requires_replication,
+ *   requires_sharding,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // arrayEq
+
+const st = new ShardingTest({shards: 2, mongos: 1, config: 1});
+const mongos = st.s;
+const dbName = jsTestName();
+assert.commandWorked(mongos.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+const testDB = mongos.getDB(dbName);
+
+const sharded = testDB.sharded;
+const unsharded = testDB.unsharded;
+st.shardColl(sharded, {_id: 1}, {_id: 50}, {_id: 51}, dbName);
+
+assert.commandWorked(sharded.insert(Array.from({length: 100}, (_, i) => ({_id: i, a: i % 7}))));
+assert.commandWorked(
+    unsharded.insert(Array.from({length: 300}, (_, i) => ({_id: 1000 + i, a: i % 5, _z: 0}))));
+assert.commandWorked(testDB.createView("unshardedView", unsharded.getName(), [{$match: {a: 1}}]));
+assert.commandWorked(testDB.createView("shardedView", sharded.getName(), [{$match: {a: 2}}]));
+
+const pipelines = [
+    [{$unionWith: unsharded.getName()}],
+    [{$unionWith: {coll: sharded.getName(), pipeline: [{$match: {a: {$lt: 3}}}]}}],
+    [{$unionWith: "unshardedView"}],
+    [{$unionWith: "shardedView"}],
+    [
+        {$unionWith: {coll: unsharded.getName(), pipeline: [{$unionWith: "shardedView"}]}},
+        {$group: {_id: "$a", n: {$sum: 1}}}
+    ],
+    [{$unionWith: unsharded.getName()}, {$limit: 10}],
+];
+
+function setPrefetch(numDocs) {
+    assert.commandWorked(mongos.adminCommand(
+        {setParameter: 1, internalDocumentSourceUnionWithPrefetchDocuments: numDocs}));
+}
+
+function runAll(batchSize) {
+    return pipelines.map(
+        pipeline => sharded.aggregate(pipeline, {cursor: {batchSize: batchSize}}).toArray());
+}
+
+setPrefetch(0);
+const expected = runAll(2);
+assert.eq(expected[0].length, 400);
+
+for (let numDocs of [1, 101, 1000]) {
+    setPrefetch(numDocs);
+    for (let batchSize of [2, 1000]) {
+        const results = runAll(batchSize);
+        for (let i = 0; i < pipelines.length; ++i) {
+            if (i == pipelines.length - 1) {
+                // Only the count of a $limit without a sort is deterministic.
+                assert.eq(results[i].length, expected[i].length);
+                continue;
+            }
+            assert(arrayEq(results[i], expected[i]),
+                   tojson(pipelines[i]) + " expected: " + tojson(expected[i]) +
+                       " got: " + tojson(results[i]));
+        }
+    }
+
+    // An error in the sub-pipeline is reported to the client.
+    assert.commandFailedWithCode(testDB.runCommand({
+        aggregate: sharded.getName(),
+        pipeline: [{
+            $unionWith:
+                {coll: unsharded.getName(), pipeline: [{$project: {x: {$divide: [1, "$_z"]}}}]}
+        }],
+        cursor: {}
+    }),
+                                 16608);
+
+    // A cursor killed before reaching the sub-pipeline stops the prefetch.
+    const res = assert.commandWorked(testDB.runCommand({
+        aggregate: sharded.getName(),
+        pipeline: [{$unionWith: unsharded.getName()}],
+        cursor: {batchSize: 1}
+    }));
+    assert.commandWorked(
+        testDB.runCommand({killCursors: sharded.getName(), cursors: [res.cursor.id]}));
+}
+
+setPrefetch(0);
+st.stop();
+}());
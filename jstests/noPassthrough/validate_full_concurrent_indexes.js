@@ -0,0 +1,33 @@
+/**
+ * Tests that validate with {full: true} reports the same per-index results when the internal
+ * structure of the indexes is verified concurrently through 'maxValidateIndexThreads'.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.validate_full_concurrent_indexes;
+
+const docs = [];
+for (let i = 0; i < 1000; i++) {
+    docs.push({_id: i, a: i, b: -i, c: "str" + i, d: [i, i + 1]});
+}
+assert.commandWorked(coll.insert(docs));
+for (const key of [{a: 1}, {b: 1}, {c: 1}, {d: 1}, {a: 1, b: 1}]) {
+    assert.commandWorked(coll.createIndex(key));
+}
+
+const serial = assert.commandWorked(coll.validate({full: true}));
+assert(serial.valid, serial);
+
+assert.commandWorked(db.adminCommand({setParameter: 1, maxValidateIndexThreads: 4}));
+const concurrent = assert.commandWorked(coll.validate({full: true}));
+assert(concurrent.valid, concurrent);
+assert.eq(serial.nIndexes, concurrent.nIndexes);
+assert.eq(serial.keysPerIndex, concurrent.keysPerIndex);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,59 @@
+/**
+ * Tests that the time operations spend waiting on locks is reported as a wait event in $currentOp,
+ * the slow query log and serverStatus.
+ *
+ * @tags: [requires_fsync]
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB('test');
+const adminDB = conn.getDB('admin');
+
+const waitEventsBefore = assert.commandWorked(db.serverStatus()).waitEvents;
+assert(waitEventsBefore.hasOwnProperty("lock"), waitEventsBefore);
+assert(waitEventsBefore.hasOwnProperty("ticket"), waitEventsBefore);
+
+// Log every operation, so that the blocked one below is logged as a slow query.
+assert.commandWorked(db.setProfilingLevel(0, {slowms: 0}));
+
+// Lock the server, and in parallel start an operation that needs the lock, so it blocks.
+assert.commandWorked(db.fsyncLock());
+
+const awaitSleepCmd = startParallelShell(() => {
+    assert.commandWorked(
+        db.adminCommand({sleep: 1, millis: 10, lock: "w", $comment: "Wait event sleep"}));
+}, conn.port);
+
+const blockedOpFilter = {"command.$comment": "Wait event sleep", "waitingFor.event": "lock"};
+assert.soon(() => {
+    return adminDB.aggregate([{$currentOp: {}}, {$match: blockedOpFilter}]).toArray().length === 1;
+}, () => tojson(adminDB.aggregate([{$currentOp: {}}]).toArray()));
+
+const minBlockedMillis = 100;
+sleep(minBlockedMillis);
+assert.commandWorked(db.fsyncUnlock());
+awaitSleepCmd();
+
+// The slow query log line of the blocked operation reports its lock wait.
+let slowQuery;
+assert.soon(() => {
+    const log = assert.commandWorked(adminDB.adminCommand({getLog: "global"})).log;
+    slowQuery = log.map(line => JSON.parse(line))
+                    .find(line => line.id === 51803 &&
+                              line.attr.command.$comment === "Wait event sleep");
+    return slowQuery !== undefined;
+});
+const lockWait = slowQuery.attr.waitEvents.lock;
+assert.gte(lockWait.count, 1, slowQuery);
+assert.gte(lockWait.timeWaitingMicros, minBlockedMillis * 1000, slowQuery);
+
+const waitEventsAfter = assert.commandWorked(db.serverStatus()).waitEvents;
+assert.gt(waitEventsAfter.lock.count, waitEventsBefore.lock.count, waitEventsAfter);
+assert.gte(waitEventsAfter.lock.timeWaitingMicros - waitEventsBefore.lock.timeWaitingMicros,
+           minBlockedMillis * 1000,
+           waitEventsAfter);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,49 @@
+/**
+ * Tests that collection scans and fetches return the same documents whether or not WiredTiger
+ * reads their Records ahead of the cursor, including while the documents are being removed.
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {wiredTigerReadAheadThreads: 2}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.wt_cursor_read_ahead;
+coll.drop();
+
+const docs = [];
+for (let i = 0; i < 5000; i++) {
+    docs.push({_id: i, a: (i * 37) % 5000, pad: "x".repeat(200)});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+function runFind(query, readAheadRecords) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, wiredTigerCursorReadAheadRecords: readAheadRecords}));
+    return query().toArray();
+}
+
+const queries = [
+    () => coll.find().hint({$natural: 1}),
+    () => coll.find().hint({$natural: -1}),
+    () => coll.find({a: {$gte: 1000}}).hint({a: 1}),
+    () => coll.find().hint({$natural: 1}).batchSize(10),
+];
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryExecYieldIterations: 10}));
+for (const query of queries) {
+    assert.eq(runFind(query, 0), runFind(query, 1000), tojson(query));
+}
+
+// A scan keeps returning the documents which remain while the ones ahead of it are removed.
+assert.commandWorked(db.adminCommand({setParameter: 1, wiredTigerCursorReadAheadRecords: 500}));
+const cursor = coll.find().hint({$natural: 1}).batchSize(100);
+assert.eq(0, cursor.next()._id);
+assert.commandWorked(coll.remove({_id: {$gte: 2000, $lt: 3000}}));
+const ids = cursor.toArray().map(doc => doc._id);
+assert.eq(3999, ids.length);
+assert.eq([], ids.filter(id => id >= 2000 && id < 3000));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -74,6 +74,7 @@ const allCommands = {
         expectFailure: true,
         expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
     },
+    analyze: {skip: isPrimaryOnly},
     appendOplogNote: {skip: isPrimaryOnly},
     applyOps: {skip: isPrimaryOnly},
     authenticate: {skip: isNotAUserDataRead},
@@ -242,7 +243,9 @@ const allCommands = {
     planCacheClear: {skip: isNotAUserDataRead},
     planCacheClearFilters: {skip: isNotAUserDataRead},
     planCacheListFilters: {skip: isNotAUserDataRead},
+    planCacheRestore: {skip: isNotAUserDataRead},
     planCacheSetFilter: {skip: isNotAUserDataRead},
+    planCacheSnapshot: {skip: isPrimaryOnly},
     prepareTransaction: {skip: isPrimaryOnly},
     profile: {skip: isPrimaryOnly},
     reapLogicalSessionCacheNow: {skip: isNotAUserDataRead},
@@ -441,6 +441,7 @@ const testCases = {
             assert(!collectionExists(db, collName + "Out"));
         }
     },
+    analyze: {skip: isNotRunOnUserDatabase},
     appendOplogNote: {skip: isNotRunOnUserDatabase},
     applyOps: {
         explicitlyCreateCollection: true,
@@ -742,7 +743,9 @@ const testCases = {
     planCacheClear: {skip: isNotWriteCommand},
     planCacheClearFilters: {skip: isNotWriteCommand},
     planCacheListFilters: {skip: isNotWriteCommand},
+    planCacheRestore: {skip: isNotWriteCommand},
     planCacheSetFilter: {skip: isNotWriteCommand},
+    planCacheSnapshot: {skip: isNotRunOnUserDatabase},
     prepareTransaction: {skip: isOnlySupportedOnShardedCluster},
     profile: {skip: isNotRunOnUserDatabase},
     reIndex: {skip: isOnlySupportedOnStandalone},
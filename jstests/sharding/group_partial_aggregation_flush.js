@@ -0,0 +1,55 @@
+/**
+ * Tests that the part of a split $group which runs on the shards outputs its partial groups when it
+ * reaches its memory limit, and that the merging $group combines them into the same groups as when
+ * the shards spill to disk instead. Also tests the shards stop grouping when that doesn't reduce
+ * the number of documents they return.
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2});
+const db = st.s.getDB("test");
+const coll = db.group_partial_aggregation_flush;
+
+assert.commandWorked(st.s.adminCommand({enableSharding: "test"}));
+st.ensurePrimaryShard("test", st.shard0.shardName);
+st.shardColl(coll.getName(), {_id: 1}, {_id: 1000}, {_id: 1000}, "test", true);
+
+const docs = [];
+for (let i = 0; i < 2000; i++) {
+    docs.push({_id: i, lowCardinality: i % 10, highCardinality: i % 1500, str: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+
+function setParameterOnShards(param) {
+    for (const shard of [st.shard0, st.shard1]) {
+        assert.commandWorked(shard.adminCommand(Object.assign({setParameter: 1}, param)));
+    }
+}
+
+function runGroup(key) {
+    return coll
+        .aggregate([{$group: {_id: "$" + key, count: {$sum: 1}, avg: {$avg: "$_id"}}}],
+                   {allowDiskUse: true})
+        .toArray();
+}
+
+// The shards have to flush or spill their partial groups several times.
+setParameterOnShards({internalDocumentSourceGroupMaxMemoryBytes: 16 * 1024});
+
+for (const key of ["lowCardinality", "highCardinality"]) {
+    setParameterOnShards({internalQueryFlushPartialGroupsOnShards: false});
+    const spilled = runGroup(key);
+
+    setParameterOnShards({internalQueryFlushPartialGroupsOnShards: true});
+    const flushed = runGroup(key);
+    assert.sameMembers(spilled, flushed, key);
+
+    // With a minimum reduction ratio of 1, the shards never stop grouping.
+    setParameterOnShards({internalQueryPartialGroupMinReductionRatio: 1.0});
+    assert.sameMembers(spilled, runGroup(key), key);
+    setParameterOnShards({internalQueryPartialGroupMinReductionRatio: 1.25});
+}
+
+st.stop();
+}());
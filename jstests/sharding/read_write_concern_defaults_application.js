@@ -154,6 +154,7 @@ let testCases = {
         checkReadConcern: true,
         checkWriteConcern: true,
     },
+    analyze: {skip: "only writes to the system.statistics collection"},
     appendOplogNote: {
         command: {appendOplogNote: 1, data: {foo: 1}},
         checkReadConcern: false,
@@ -502,7 +503,9 @@ let testCases = {
     planCacheClear: {skip: "does not accept read or write concern"},
     planCacheClearFilters: {skip: "does not accept read or write concern"},
     planCacheListFilters: {skip: "does not accept read or write concern"},
+    planCacheRestore: {skip: "does not accept read or write concern"},
     planCacheSetFilter: {skip: "does not accept read or write concern"},
+    planCacheSnapshot: {skip: "does not accept read or write concern"},
     prepareTransaction: {skip: "internal command"},
     profile: {skip: "does not accept read or write concern"},
     reIndex: {skip: "does not accept read or write concern"},
@@ -0,0 +1,63 @@
+// Ensure that repeated TLS connections from a client to the server resume an earlier session, and
+// that the server counts resumed and new sessions.
+(function() {
+'use strict';
+
+const SERVER_CERT = "jstests/libs/server.pem";
+const CLIENT_CERT = "jstests/libs/client.pem";
+const CA_CERT = "jstests/libs/ca.pem";
+
+function runTest(sessionCacheSize) {
+    const conn = MongoRunner.runMongod({
+        sslMode: 'requireSSL',
+        sslPEMKeyFile: SERVER_CERT,
+        sslCAFile: CA_CERT,
+        setParameter: {tlsSessionCacheSize: sessionCacheSize},
+    });
+
+    const getCounts = () =>
+        assert.commandWorked(conn.adminCommand({serverStatus: 1})).tlsSessionResumption;
+    const before = getCounts();
+
+    // Each new connection made by the client after the first can offer the session the server
+    // issued to an earlier one.
+    const exitStatus = runMongoProgram('mongo',
+                                       '--ssl',
+                                       '--sslAllowInvalidHostnames',
+                                       '--sslPEMKeyFile',
+                                       CLIENT_CERT,
+                                       '--sslCAFile',
+                                       CA_CERT,
+                                       '--port',
+                                       conn.port,
+                                       '--eval',
+                                       'for (let i = 0; i < 5; ++i) {' +
+                                           '    const other = new Mongo(db.getMongo().host);' +
+                                           '    assert.commandWorked(' +
+                                           '        other.getDB("admin").runCommand({ping: 1}));' +
+                                           '}');
+    assert.eq(0, exitStatus, "the client failed to connect");
+
+    const after = getCounts();
+    const counts = {
+        incoming: {
+            new: after.incoming.new - before.incoming.new,
+            resumed: after.incoming.resumed - before.incoming.resumed
+        }
+    };
+    jsTestLog("TLS session resumption with a cache of " + sessionCacheSize +
+              " sessions: " + tojson(counts));
+    assert.gte(counts.incoming.new, 1, tojson(counts));
+    assert.eq(counts.incoming.new + counts.incoming.resumed, 6, tojson(counts));
+    if (sessionCacheSize > 0) {
+        assert.gt(counts.incoming.resumed, 0, tojson(counts));
+    } else {
+        assert.eq(counts.incoming.resumed, 0, tojson(counts));
+    }
+
+    MongoRunner.stopMongod(conn);
+}
+
+runTest(1000);
+runTest(0);
+}());
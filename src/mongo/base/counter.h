@@ -29,9 +29,11 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 #include "mongo/platform/atomic_word.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 /**
@@ -65,4 +67,54 @@ public:
 private:
     AtomicWord<long long> _counter;
 };
+
+/**
+ * A 64bit (atomic) counter for hot paths updated by many threads at once.
+ *
+ * The value is split across cache aligned stripes, and each thread always updates the same
+ * stripe, so that concurrent increments do not bounce a single cache line between cores. Reads
+ * sum the stripes, which makes get() more expensive than Counter64::get() and only eventually
+ * consistent with respect to concurrent updates.
+ */
+class StripedCounter64 {
+public:
+    static constexpr size_t kNumStripes = 16;
+
+    /** Atomically increment. */
+    void increment(uint64_t n = 1) {
+        _stripes[stripeIndex()].addAndFetch(n);
+    }
+
+    /** Atomically decrement. */
+    void decrement(uint64_t n = 1) {
+        _stripes[stripeIndex()].subtractAndFetch(n);
+    }
+
+    /** Return the current value, summed over all stripes */
+    long long get() const {
+        long long sum = 0;
+        for (const auto& stripe : _stripes) {
+            sum += stripe.load();
+        }
+        return sum;
+    }
+
+    operator long long() const {
+        return get();
+    }
+
+    /**
+     * Returns the stripe used by the calling thread. Threads are assigned stripes round robin
+     * the first time they ask, so other striped structures can use this to spread their own
+     * updates the same way.
+     */
+    static size_t stripeIndex() {
+        static AtomicWord<unsigned> nextStripe{0};
+        thread_local const size_t stripe = nextStripe.fetchAndAdd(1) % kNumStripes;
+        return stripe;
+    }
+
+private:
+    std::array<CacheAligned<AtomicWord<long long>>, kNumStripes> _stripes;
+};
 }  // namespace mongo
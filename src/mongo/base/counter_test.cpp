@@ -32,8 +32,10 @@
 
 #include <climits>
 #include <iostream>
+#include <vector>
 
 #include "mongo/base/counter.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -55,5 +57,35 @@ TEST(CounterTest, Test1) {
     ASSERT_EQUALS(static_cast<long long>(c), 0);
 }
 
+TEST(CounterTest, StripedCounter) {
+    StripedCounter64 c;
+    ASSERT_EQUALS(c.get(), 0);
+    c.increment();
+    ASSERT_EQUALS(c.get(), 1);
+    c.decrement(3);
+    ASSERT_EQUALS(c.get(), -2);
+    c.increment(2);
+    ASSERT_EQUALS(static_cast<long long>(c), 0);
+}
+
+TEST(CounterTest, StripedCounterSumsAcrossThreads) {
+    constexpr int kThreads = 2 * StripedCounter64::kNumStripes;
+    constexpr int kIncrementsPerThread = 1000;
+
+    StripedCounter64 c;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kIncrementsPerThread; ++j) {
+                c.increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQUALS(c.get(), kThreads * kIncrementsPerThread);
+}
+
 }  // namespace
 }  // namespace mongo
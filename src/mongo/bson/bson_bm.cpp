@@ -59,6 +59,28 @@ BSONObj buildSampleObj(long long unsigned int i) {
                        << "random" << random << "phone_no" << phone_no << "long_string"
                        << long_string);
 }
+
+// An order-like document with a nested array of line items, like a typical insert payload.
+BSONObj buildOrderObj(long long unsigned int i) {
+    BSONArrayBuilder items;
+    for (auto j = 0ull; j < 1 + i % 8; j++)
+        items.append(BSON("sku" << fmt::format("SKU-{:06d}", (i + j) * 7919 % 1'000'000)
+                                << "quantity" << static_cast<int>(1 + j % 5) << "unitPrice"
+                                << 9.99 + j << "tags" << BSON_ARRAY("retail"
+                                                                    << "standard")));
+
+    return BSON(GENOID << "customerId" << static_cast<long long>(i * 104'729 % 1'000'003)
+                       << "status"
+                       << "shipped"
+                       << "createdAt" << Date_t::fromMillisSinceEpoch(1'600'000'000'000 + i)
+                       << "items" << items.arr() << "shippingAddress"
+                       << BSON("line1"
+                               << "433 W 43rd St"
+                               << "city"
+                               << "New York"
+                               << "postalCode" << fmt::format("{:05d}", 10'000 + i % 90'000))
+                       << "notes" << fmt::format("{:x<{}s}", "", 16 + i % 64));
+}
 }  // namespace
 
 void BM_arrayBuilder(benchmark::State& state) {
@@ -112,8 +134,46 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+void BM_validateOrders(benchmark::State& state) {
+    BSONArrayBuilder builder;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++)
+        builder.append(buildOrderObj(j));
+    BSONObj array = builder.done();
+    invariant(validateBSON(array.objdata(), array.objsize()).isOK());
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(array.objdata(), array.objsize()));
+        totalSize += array.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
+// Validates documents laid out back to back, as in an OP_MSG document sequence of an insert.
+void BM_validateSequence(benchmark::State& state) {
+    BufBuilder sequence;
+    auto len = state.range(0);
+    size_t totalSize = 0;
+    for (auto j = 0; j < len; j++) {
+        auto obj = buildOrderObj(j);
+        sequence.appendBuf(obj.objdata(), obj.objsize());
+    }
+    invariant(validateBSONSequence(sequence.buf(), sequence.len()).isOK());
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSONSequence(sequence.buf(), sequence.len()));
+        totalSize += sequence.len();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateOrders)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateSequence)->Ranges({{{1}, {1'000}}});
 
 }  // namespace mongo
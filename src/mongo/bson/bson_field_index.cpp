@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+namespace mongo {
+namespace {
+
+thread_local BSONFieldIndexScope* currentScope = nullptr;
+
+}  // namespace
+
+BSONElement BSONFieldIndex::getField(StringData name) {
+    switch (_state) {
+        case State::kUnscanned:
+            _state = State::kScannedOnce;
+            return _obj.getField(name);
+        case State::kTooSmall:
+            return _obj.getField(name);
+        case State::kScannedOnce: {
+            // This is the second lookup, so more are likely to follow: build the table.
+            size_t numFields = 0;
+            for (auto&& elem : _obj) {
+                _fields.try_emplace(elem.fieldNameStringData(), elem);  // Keep the first one.
+                ++numFields;
+            }
+            if (numFields < kMinFieldsToIndex) {
+                _fields.clear();
+                _state = State::kTooSmall;
+                return _obj.getField(name);
+            }
+            _state = State::kIndexed;
+            break;
+        }
+        case State::kIndexed:
+            break;
+    }
+
+    auto it = _fields.find(name);
+    return it == _fields.end() ? BSONElement() : it->second;
+}
+
+BSONFieldIndexScope::BSONFieldIndexScope(const std::vector<const BSONObj*>& docs)
+    : _previous(currentScope) {
+    for (auto doc : docs) {
+        _indexes.try_emplace(doc->objdata(), *doc);
+    }
+    currentScope = this;
+}
+
+BSONFieldIndexScope::~BSONFieldIndexScope() {
+    invariant(currentScope == this);
+    currentScope = _previous;
+}
+
+BSONElement BSONFieldIndexScope::getField(const BSONObj& obj, StringData name) {
+    if (currentScope) {
+        auto it = currentScope->_indexes.find(obj.objdata());
+        if (it != currentScope->_indexes.end()) {
+            return it->second.getField(name);
+        }
+    }
+    return obj.getField(name);
+}
+
+}  // namespace mongo
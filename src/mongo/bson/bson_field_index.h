@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/container/node_hash_map.h>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * Accelerates repeated lookups of top-level fields of a single BSONObj. The first lookup scans
+ * the object linearly, like BSONObj::getField. A second lookup builds a hash table from field name
+ * to element in one more pass, which then serves all further lookups, unless the object has too
+ * few fields for the table to pay off.
+ *
+ * Lookups return the first element with the requested name, exactly as BSONObj::getField does.
+ * The object's buffer must outlive this index and must not be modified.
+ */
+class BSONFieldIndex {
+    BSONFieldIndex(const BSONFieldIndex&) = delete;
+    BSONFieldIndex& operator=(const BSONFieldIndex&) = delete;
+
+public:
+    // Objects with fewer top-level fields are always scanned linearly.
+    static constexpr size_t kMinFieldsToIndex = 16;
+
+    explicit BSONFieldIndex(const BSONObj& obj) : _obj(obj) {}
+
+    BSONElement getField(StringData name);
+
+    /**
+     * Returns whether the hash table has been built. For testing.
+     */
+    bool isIndexed() const {
+        return _state == State::kIndexed;
+    }
+
+private:
+    enum class State { kUnscanned, kScannedOnce, kIndexed, kTooSmall };
+
+    const BSONObj _obj;
+    State _state = State::kUnscanned;
+    StringDataMap<BSONElement> _fields;
+};
+
+/**
+ * RAII-style class which registers field indexes for a set of documents with the current thread
+ * while in scope. Code which looks up top-level fields of a document it was merely handed, such
+ * as index key generators and match expression path traversal, calls getField below so that all
+ * consumers of a registered document share one BSONFieldIndex. Documents which are not registered
+ * are scanned as usual.
+ *
+ * The documents must stay alive and unmodified for the lifetime of the scope. Scopes may nest, in
+ * which case only the innermost one is consulted.
+ */
+class BSONFieldIndexScope {
+    BSONFieldIndexScope(const BSONFieldIndexScope&) = delete;
+    BSONFieldIndexScope& operator=(const BSONFieldIndexScope&) = delete;
+
+public:
+    explicit BSONFieldIndexScope(const std::vector<const BSONObj*>& docs);
+    ~BSONFieldIndexScope();
+
+    /**
+     * Returns the field named 'name' of 'obj', through its registered BSONFieldIndex if there is
+     * one in scope, or by scanning 'obj' otherwise.
+     */
+    static BSONElement getField(const BSONObj& obj, StringData name);
+
+private:
+    BSONFieldIndexScope* const _previous;
+
+    // Keyed by the start of each document's buffer. The node map keeps the indexes in place.
+    absl::node_hash_map<const char*, BSONFieldIndex> _indexes;
+};
+
+}  // namespace mongo
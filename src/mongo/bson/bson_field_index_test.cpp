@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bson_field_index.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeWideObj(int numFields) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < numFields; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    return bob.obj();
+}
+
+TEST(BSONFieldIndex, LookupsMatchGetField) {
+    BSONObj obj = makeWideObj(200);
+    BSONFieldIndex index(obj);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 200; i += 7) {
+            std::string name = "f" + std::to_string(i);
+            BSONElement elt = index.getField(name);
+            ASSERT_EQ(elt.rawdata(), obj.getField(name).rawdata());
+            ASSERT_EQ(elt.numberInt(), i);
+        }
+        ASSERT(index.getField("missing").eoo());
+    }
+}
+
+TEST(BSONFieldIndex, WideObjectIsIndexedOnSecondLookup) {
+    BSONObj obj = makeWideObj(200);
+    BSONFieldIndex index(obj);
+    index.getField("f10");
+    ASSERT_FALSE(index.isIndexed());
+    index.getField("f20");
+    ASSERT_TRUE(index.isIndexed());
+}
+
+TEST(BSONFieldIndex, SmallObjectIsNotIndexed) {
+    BSONObj obj = makeWideObj(BSONFieldIndex::kMinFieldsToIndex - 1);
+    BSONFieldIndex index(obj);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(index.getField("f3").numberInt(), 3);
+    }
+    ASSERT_FALSE(index.isIndexed());
+}
+
+TEST(BSONFieldIndex, DuplicateFieldsReturnFirst) {
+    BSONObjBuilder bob;
+    bob.append("dup", 1);
+    for (int i = 0; i < 32; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    bob.append("dup", 2);
+    BSONObj obj = bob.obj();
+
+    BSONFieldIndex index(obj);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(index.getField("dup").numberInt(), 1);
+    }
+    ASSERT_TRUE(index.isIndexed());
+}
+
+TEST(BSONFieldIndexScope, RegisteredAndUnregisteredDocuments) {
+    BSONObj registered = makeWideObj(50);
+    BSONObj unregistered = makeWideObj(50);
+    BSONFieldIndexScope scope({&registered});
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(BSONFieldIndexScope::getField(registered, "f42").rawdata(),
+                  registered.getField("f42").rawdata());
+        ASSERT_EQ(BSONFieldIndexScope::getField(unregistered, "f42").rawdata(),
+                  unregistered.getField("f42").rawdata());
+    }
+    ASSERT(BSONFieldIndexScope::getField(registered, "missing").eoo());
+}
+
+TEST(BSONFieldIndexScope, NoScope) {
+    BSONObj obj = makeWideObj(20);
+    ASSERT_EQ(BSONFieldIndexScope::getField(obj, "f5").numberInt(), 5);
+}
+
+TEST(BSONFieldIndexScope, ScopesNest) {
+    BSONObj outerDoc = makeWideObj(30);
+    BSONObj innerDoc = makeWideObj(40);
+    BSONFieldIndexScope outer({&outerDoc});
+    {
+        BSONFieldIndexScope inner({&innerDoc});
+        ASSERT_EQ(BSONFieldIndexScope::getField(innerDoc, "f35").numberInt(), 35);
+        ASSERT_EQ(BSONFieldIndexScope::getField(outerDoc, "f25").numberInt(), 25);
+    }
+    ASSERT_EQ(BSONFieldIndexScope::getField(outerDoc, "f25").numberInt(), 25);
+    ASSERT_EQ(BSONFieldIndexScope::getField(innerDoc, "f35").numberInt(), 35);
+}
+
+}  // namespace
+}  // namespace mongo
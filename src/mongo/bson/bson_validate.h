@@ -50,4 +50,11 @@ namespace mongo {
  * Length is only limited by the buffer's maxLength and the inherent 2GB - 1 format limitation.
  */
 Status validateBSON(const char* buf, uint64_t maxLength) noexcept;
+
+/**
+ * Checks that buf holds a sequence of BSON objects, each one as validated by validateBSON, which
+ * exactly fills the 'length' bytes of the buffer, such as an OP_MSG document sequence. This is
+ * faster than validating the objects one by one, and returns the same error for invalid input.
+ */
+Status validateBSONSequence(const char* buf, uint64_t length) noexcept;
 }  // namespace mongo
@@ -431,4 +431,46 @@ TEST(BSONValidateFast, MaxNestingDepth) {
     Status status = validateBSON(tooDeepNesting.objdata(), tooDeepNesting.objsize());
     ASSERT_EQ(status.code(), ErrorCodes::Overflow);
 }
+
+TEST(BSONValidateFast, LongFieldNames) {
+    // Field names of every length around the word size used to scan for their terminator.
+    BSONObjBuilder b;
+    for (size_t len = 1; len <= 40; ++len)
+        b.append(std::string(len, 'f'), static_cast<int>(len));
+    BSONObj x = b.obj();
+    ASSERT_OK(validateBSON(x.objdata(), x.objsize()));
+}
+
+TEST(BSONValidateFast, Sequence) {
+    BufBuilder bb;
+    std::vector<BSONObj> objs = {BSON("_id" << 1),
+                                 BSON("a" << BSONCodeWScope("code", BSON("c" << 1))),
+                                 nest(40),
+                                 BSONObj()};
+    for (const auto& obj : objs)
+        bb.appendBuf(obj.objdata(), obj.objsize());
+    ASSERT_OK(validateBSONSequence(bb.buf(), bb.len()));
+    ASSERT_OK(validateBSONSequence(bb.buf(), 0));
+
+    // A truncated sequence, or one with trailing bytes, is invalid.
+    ASSERT_NOT_OK(validateBSONSequence(bb.buf(), bb.len() - 1));
+    bb.appendChar(0);
+    ASSERT_NOT_OK(validateBSONSequence(bb.buf(), bb.len()));
+}
+
+TEST(BSONValidateFast, SequenceErrorMatchesSingleObject) {
+    BufBuilder bb;
+    BSONObjBuilder ob(bb);
+    ob.append("_id", 1);
+    appendInvalidStringElement("not_id", &bb);
+    const BSONObj invalid = ob.done();
+    const BSONObj valid = BSON("_id" << 2);
+
+    BufBuilder sequence;
+    sequence.appendBuf(valid.objdata(), valid.objsize());
+    sequence.appendBuf(invalid.objdata(), invalid.objsize());
+    const Status status = validateBSONSequence(sequence.buf(), sequence.len());
+    ASSERT_EQ(status, validateBSON(invalid.objdata(), invalid.objsize()));
+    ASSERT_EQ(status.reason(), validateBSON(invalid.objdata(), invalid.objsize()).reason());
+}
 }  // namespace
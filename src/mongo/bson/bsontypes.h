@@ -193,6 +193,7 @@ enum BinDataType {
     newUUID = 4,             /* language-independent UUID format across all drivers */
     MD5Type = 5,
     Encrypt = 6, /* encryption placeholder or encrypted data */
+    Column = 7,  /* compressed column of the measurements of a time-series bucket */
     bdtCustom = 128
 };
 
@@ -330,6 +331,9 @@ struct BSONObjAppendFormat<long long> : FormatKind<NumberLong> {};
 template <>
 struct BSONObjAppendFormat<Counter64> : FormatKind<NumberLong> {};
 
+template <>
+struct BSONObjAppendFormat<StripedCounter64> : FormatKind<NumberLong> {};
+
 template <>
 struct BSONObjAppendFormat<Decimal128> : FormatKind<NumberDecimal> {};
 
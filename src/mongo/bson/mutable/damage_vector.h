@@ -35,21 +35,39 @@
 namespace mongo {
 namespace mutablebson {
 
-// A damage event represents a change of size 'size' byte at starting at offset
-// 'target_offset' in some target buffer, with the replacement data being 'size' bytes of
-// data from the 'source' offset. The base addresses against which these offsets are to be
-// applied are not captured here.
+// A damage event represents a change of 'targetSize' bytes starting at offset 'targetOffset' in
+// some target buffer, with the replacement data being 'sourceSize' bytes of data from the
+// 'sourceOffset' offset. The base addresses against which these offsets are to be applied are not
+// captured here.
+//
+// Damage events are applied in order. When 'sourceSize' and 'targetSize' differ the target buffer
+// grows or shrinks, and the offsets of later events refer to the buffer as modified by the earlier
+// ones.
 struct DamageEvent {
     typedef uint32_t OffsetSizeType;
 
+    DamageEvent() = default;
+
+    DamageEvent(OffsetSizeType srcOffset,
+                size_t srcSize,
+                OffsetSizeType tgtOffset,
+                size_t tgtSize)
+        : sourceOffset(srcOffset),
+          sourceSize(srcSize),
+          targetOffset(tgtOffset),
+          targetSize(tgtSize) {}
+
     // Offset of source data (in some buffer held elsewhere).
     OffsetSizeType sourceOffset;
 
+    // Size of the data to be copied from the source buffer.
+    size_t sourceSize;
+
     // Offset of target data (in some buffer held elsewhere).
     OffsetSizeType targetOffset;
 
-    // Size of the damage region.
-    size_t size;
+    // Size of the region of the target buffer being replaced.
+    size_t targetSize;
 };
 
 typedef std::vector<DamageEvent> DamageVector;
@@ -418,6 +418,10 @@ constexpr auto kRootFieldName = ""_sd;
 // logic errors. We don't make it zero so that we do execute the fastRep code paths.
 const size_t kFastReps = kDebugBuild ? 2 : 128;
 
+// How many destroyed Impls each thread keeps for reuse, and how much memory each may hold on to.
+constexpr size_t kMaxPooledImpls = 4;
+constexpr size_t kMaxPooledImplHeapBytes = 64 * 1024;
+
 // An ElementRep contains the information necessary to locate the data for an Element,
 // and the topology information for how the Element is related to other Elements in the
 // document.
@@ -625,6 +629,39 @@ public:
         _leafBuilder.abandon();
     }
 
+    // Returns an Impl, reusing the storage of one destroyed on this thread if there is one.
+    static std::unique_ptr<Impl> make(Document::InPlaceMode inPlaceMode) {
+        auto& pool = _pooledImpls();
+        if (pool.empty()) {
+            return std::make_unique<Impl>(inPlaceMode);
+        }
+        auto impl = std::move(pool.back());
+        pool.pop_back();
+        impl->_inPlaceMode = inPlaceMode;
+        return impl;
+    }
+
+    // Keeps the storage of 'impl' for the next Impl made on this thread, unless it grew large.
+    static void recycle(std::unique_ptr<Impl> impl) {
+        auto& pool = _pooledImpls();
+        if (pool.size() >= kMaxPooledImpls || impl->getHeapBytes() > kMaxPooledImplHeapBytes) {
+            return;
+        }
+        // Release the BSONObjs we reference now, rather than when the Impl is next used.
+        impl->reset(Document::kInPlaceDisabled);
+        pool.push_back(std::move(impl));
+    }
+
+    // The sum of the sizes of the objects we reference and of the leaves we built, which bounds
+    // the size of the serialized document, unless it is larger than any BSONObj can be.
+    int getSerializedSizeHint() const {
+        size_t hint = _leafBuf.len();
+        for (size_t objIdx = kLeafObjIdx + 1; objIdx < _objects.size(); ++objIdx) {
+            hint += _objects[objIdx].objsize();
+        }
+        return std::min(hint, static_cast<size_t>(BSONObjMaxInternalSize));
+    }
+
     void reset(Document::InPlaceMode inPlaceMode) {
         // Clear out the state in the vectors.
         _slowElements.clear();
@@ -1030,10 +1067,7 @@ public:
     void recordDamageEvent(DamageEvent::OffsetSizeType targetOffset,
                            DamageEvent::OffsetSizeType sourceOffset,
                            size_t size) {
-        _damages.push_back(DamageEvent());
-        _damages.back().targetOffset = targetOffset;
-        _damages.back().sourceOffset = sourceOffset;
-        _damages.back().size = size;
+        _damages.emplace_back(sourceOffset, size, targetOffset, size);
         if (kDebugBuild && paranoid) {
             // Force damage events to new addresses to catch invalidation errors.
             DamageVector new_damages(_damages);
@@ -1082,6 +1116,19 @@ public:
     void writeChildren(Element::RepIdx repIdx, Builder* builder) const;
 
 private:
+    static std::vector<std::unique_ptr<Impl>>& _pooledImpls() {
+        thread_local std::vector<std::unique_ptr<Impl>> pool;
+        return pool;
+    }
+
+    // The memory allocated for our vectors and leaf buffer, which a pooled Impl keeps.
+    size_t getHeapBytes() const {
+        return _slowElements.capacity() * sizeof(ElementRep) +
+            _objects.capacity() * sizeof(BSONObj) + _fieldNames.capacity() +
+            _leafBuf.getSize() + _fieldNameScratch.capacity() +
+            _damages.capacity() * sizeof(DamageEvent);
+    }
+
     // Insert the given field name into the field name heap, and return an ID for this
     // field name.
     int32_t insertFieldName(StringData fieldName) {
@@ -2266,12 +2313,12 @@ void Document::Impl::writeChildren(Element::RepIdx repIdx, Builder* builder) con
     }
 }
 
-Document::Document() : _impl(new Impl(Document::kInPlaceDisabled)), _root(makeRootElement()) {
+Document::Document() : _impl(Impl::make(Document::kInPlaceDisabled)), _root(makeRootElement()) {
     dassert(_root._repIdx == kRootRepIdx);
 }
 
 Document::Document(const BSONObj& value, InPlaceMode inPlaceMode)
-    : _impl(new Impl(inPlaceMode)), _root(makeRootElement(value)) {
+    : _impl(Impl::make(inPlaceMode)), _root(makeRootElement(value)) {
     dassert(_root._repIdx == kRootRepIdx);
 }
 
@@ -2289,7 +2336,13 @@ void Document::reset(const BSONObj& value, InPlaceMode inPlaceMode) {
     dassert(_root._repIdx == kRootRepIdx);
 }
 
-Document::~Document() {}
+Document::~Document() {
+    Impl::recycle(std::move(_impl));
+}
+
+int Document::getSerializedSizeHint() const {
+    return getImpl().getSerializedSizeHint();
+}
 
 void Document::reserveDamageEvents(size_t expectedEvents) {
     return getImpl().reserveDamageEvents(expectedEvents);
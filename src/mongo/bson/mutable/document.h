@@ -513,7 +513,11 @@ private:
     MONGO_PRIVATE Element makeRootElement(const BSONObj& value);
     MONGO_PRIVATE Element makeElement(ConstElement element, const StringData* fieldName);
 
-    const std::unique_ptr<Impl> _impl;
+    // Returns an estimate of the size of the serialized document, so that the buffer it is
+    // serialized to is allocated once.
+    MONGO_PRIVATE int getSerializedSizeHint() const;
+
+    std::unique_ptr<Impl> _impl;
 
     // The root element of this document.
     const Element _root;
@@ -539,7 +543,7 @@ inline void Document::writeTo(BSONObjBuilder* builder) const {
 }
 
 inline BSONObj Document::getObject() const {
-    BSONObjBuilder builder;
+    BSONObjBuilder builder(getSerializedSizeHint());
     writeTo(&builder);
     return builder.obj();
 }
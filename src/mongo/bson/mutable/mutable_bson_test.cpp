@@ -954,7 +954,7 @@ void apply(mongo::BSONObj* obj, const mmb::DamageVector& damages, const char* so
     mmb::DamageVector::const_iterator where = damages.begin();
     char* const target = const_cast<char*>(obj->objdata());
     for (; where != end; ++where) {
-        std::memcpy(target + where->targetOffset, source + where->sourceOffset, where->size);
+        std::memcpy(target + where->targetOffset, source + where->sourceOffset, where->sourceSize);
     }
 }
 }  // namespace
@@ -2871,7 +2871,7 @@ TEST(DocumentInPlace, GettingInPlaceUpdatesWhenDisabledClearsArguments) {
     ASSERT_FALSE(doc.isInPlaceModeEnabled());
 
     mmb::DamageVector damages;
-    const mmb::DamageEvent event = {0};
+    const mmb::DamageEvent event{};
     damages.push_back(event);
     const char* source = "foo";
     ASSERT_FALSE(doc.getInPlaceUpdates(&damages, &source));
@@ -3449,4 +3449,26 @@ TEST(SERVER_36024, RegressionCheck) {
     ASSERT_OK(field.setValueInt(1));
 }
 
+TEST(Document, DocumentsReusingStorageOfDestroyedOnesStartClean) {
+    const mongo::BSONObj original = mongo::fromjson("{ a : 1, b : { c : 'x' } }");
+    for (int i = 0; i < 3; ++i) {
+        mmb::Document used(original, mmb::Document::kInPlaceEnabled);
+        for (int j = 0; j < 200; ++j) {
+            ASSERT_OK(used.root().appendString("f" + std::to_string(j), "a long string value"));
+        }
+        ASSERT_OK(used.root()["a"].setValueInt(2));
+        ASSERT_FALSE(used.isInPlaceModeEnabled());
+    }
+
+    mmb::Document doc(original, mmb::Document::kInPlaceEnabled);
+    ASSERT_TRUE(doc.isInPlaceModeEnabled());
+    ASSERT_BSONOBJ_EQ(original, doc.getObject());
+    ASSERT_OK(doc.root()["a"].setValueInt(3));
+    ASSERT_BSONOBJ_EQ(mongo::fromjson("{ a : 3, b : { c : 'x' } }"), doc.getObject());
+
+    mmb::Document empty;
+    ASSERT_BSONOBJ_EQ(mongo::BSONObj(), empty.getObject());
+    ASSERT_FALSE(empty.isInPlaceModeEnabled());
+}
+
 }  // namespace
@@ -159,7 +159,13 @@ Message DBClientCursor::_assembleInit() {
                           .obj();
             }
 
-            return assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            auto msg = assembleCommandRequest(_client, ns.db(), opts, std::move(cmd));
+            // Set the exhaust flag if needed, so that the server streams the batches which follow
+            // the first one.
+            if (opts & QueryOption_Exhaust && msg.operation() == dbMsg) {
+                OpMsg::setFlag(&msg, OpMsg::kExhaustSupported);
+            }
+            return msg;
         }
         // else use legacy OP_QUERY request.
         // Legacy OP_QUERY request does not support UUIDs.
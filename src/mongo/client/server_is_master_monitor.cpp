@@ -353,6 +353,13 @@ StatusWith<TaskExecutor::CallbackHandle> SingleServerIsMasterMonitor::_scheduleS
 
             if (result.response.isOK()) {
                 self->_onIsMasterSuccess(result.response.data);
+
+                // Unlike an awaitable isMaster, a single isMaster is answered right away, so its
+                // latency is a round trip time sample as good as a ping.
+                if (result.response.elapsed) {
+                    self->_eventListener->onServerPingSucceededEvent(*result.response.elapsed,
+                                                                     self->_host);
+                }
             } else {
                 self->_onIsMasterFailure(result.response.status, result.response.data);
             }
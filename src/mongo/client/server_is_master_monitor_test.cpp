@@ -327,6 +327,31 @@ TEST_F(ServerIsMasterMonitorTestFixture, singleServerIsMasterMonitorReportsFailu
     ASSERT_EQ(response[0], ErrorCodes::HostUnreachable);
 }
 
+/**
+ * Checks that a successful single isMaster also reports a round trip time sample, so that no
+ * separate ping is needed when isMaster responses are not streamed.
+ */
+TEST_F(ServerIsMasterMonitorTestFixture, singleServerIsMasterMonitorReportsRoundTripTime) {
+    auto replSet = std::make_unique<MockReplicaSet>(
+        "test", 1, /* hasPrimary = */ false, /* dollarPrefixHosts = */ false);
+    auto hostAndPort = HostAndPort(replSet->getSecondaries()[0]);
+
+    const auto config = SdamConfiguration(std::vector<HostAndPort>{hostAndPort});
+    auto ssIsMasterMonitor = initSingleServerIsMasterMonitor(config, hostAndPort, replSet.get());
+    ssIsMasterMonitor->disableExpeditedChecking();
+
+    processIsMasterRequest(replSet.get(), hostAndPort);
+    auto topologyListener = getTopologyListener();
+    auto timeoutMS = config.getConnectionTimeout();
+    while (elapsed() < timeoutMS && !topologyListener->hasPingResponse(hostAndPort)) {
+        advanceTime(Milliseconds(1));
+    }
+    ASSERT_TRUE(topologyListener->hasPingResponse(hostAndPort));
+    auto rtts = topologyListener->getPingResponse(hostAndPort);
+    ASSERT_EQ(rtts.size(), 1);
+    ASSERT_OK(rtts[0].getStatus());
+}
+
 TEST_F(ServerIsMasterMonitorTestFixture, serverIsMasterMonitorOnTopologyDescriptionChangeAddHost) {
     auto replSet = std::make_unique<MockReplicaSet>(
         "test", 2, /* hasPrimary = */ false, /* dollarPrefixHosts = */ false);
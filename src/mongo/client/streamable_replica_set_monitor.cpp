@@ -40,6 +40,7 @@
 #include "mongo/client/connpool.h"
 #include "mongo/client/global_conn_pool.h"
 #include "mongo/client/read_preference.h"
+#include "mongo/client/replica_set_monitor_server_parameters.h"
 #include "mongo/client/streamable_replica_set_monitor_query_processor.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/repl/bson_extract_optime.h"
@@ -194,9 +195,13 @@ void StreamableReplicaSetMonitor::init() {
 
     _eventsPublisher->registerListener(shared_from_this());
 
-    _pingMonitor = std::make_unique<ServerPingMonitor>(
-        _uri, _eventsPublisher.get(), _sdamConfig.getHeartBeatFrequency(), _executor);
-    _eventsPublisher->registerListener(_pingMonitor);
+    // Without streaming, every heartbeat is a single isMaster whose latency also serves as a round
+    // trip time sample, so separate pings would only double the monitoring traffic.
+    if (gReplicaSetMonitorProtocol == ReplicaSetMonitorProtocol::kStreamable) {
+        _pingMonitor = std::make_unique<ServerPingMonitor>(
+            _uri, _eventsPublisher.get(), _sdamConfig.getHeartBeatFrequency(), _executor);
+        _eventsPublisher->registerListener(_pingMonitor);
+    }
 
     _isMasterMonitor = std::make_unique<ServerIsMasterMonitor>(
         _uri, _sdamConfig, _eventsPublisher, _topologyManager->getTopologyDescription(), _executor);
@@ -223,7 +228,9 @@ void StreamableReplicaSetMonitor::drop() {
           "Closing Replica Set Monitor",
           "replicaSet"_attr = getName());
     _queryProcessor->shutdown();
-    _pingMonitor->shutdown();
+    if (_pingMonitor) {
+        _pingMonitor->shutdown();
+    }
     _isMasterMonitor->shutdown();
 
     ReplicaSetMonitorManager::get()->getNotifier().onDroppedSet(getName());
@@ -51,6 +51,7 @@
 #include "mongo/db/auth/sasl_options.h"
 #include "mongo/db/auth/user_document_parser.h"
 #include "mongo/db/auth/user_management_commands_parser.h"
+#include "mongo/db/client.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/mongod_options.h"
 #include "mongo/logv2/log.h"
@@ -610,9 +611,50 @@ Status AuthorizationManagerImpl::initialize(OperationContext* opCtx) {
 
     authorizationManagerPinnedUsers.setAuthzManager(this);
     invalidateUserCache(opCtx);
+
+    if (authorizationManagerWarmUpUserCache && isAuthEnabled()) {
+        _threadPool.schedule([this, service = opCtx->getServiceContext()](Status status) {
+            if (!status.isOK()) {
+                return;
+            }
+            ThreadClient tc("AuthorizationManagerUserCacheWarmUp", service);
+            auto opCtx = tc->makeOperationContext();
+            _warmUpUserCache(opCtx.get());
+        });
+    }
     return Status::OK();
 }
 
+void AuthorizationManagerImpl::_warmUpUserCache(OperationContext* opCtx) try {
+    std::vector<UserName> userNames;
+    auto status = _externalState->getUserNames(
+        opCtx, static_cast<size_t>(authorizationManagerCacheSize), &userNames);
+    if (!status.isOK()) {
+        LOGV2_DEBUG(5191300,
+                    1,
+                    "Not warming up the user cache, unable to list users",
+                    "error"_attr = status);
+        return;
+    }
+
+    size_t numLoaded = 0;
+    for (const auto& userName : userNames) {
+        auto swUser = acquireUser(opCtx, userName);
+        if (swUser.isOK()) {
+            ++numLoaded;
+        } else {
+            LOGV2_DEBUG(5191301,
+                        2,
+                        "Unable to load user while warming up the user cache",
+                        "user"_attr = userName,
+                        "error"_attr = swUser.getStatus());
+        }
+    }
+    LOGV2_DEBUG(5191302, 1, "Warmed up the user cache", "numUsers"_attr = numLoaded);
+} catch (const DBException& ex) {
+    LOGV2_DEBUG(5191303, 1, "Failed to warm up the user cache", "error"_attr = ex.toStatus());
+}
+
 void AuthorizationManagerImpl::logOp(OperationContext* opCtx,
                                      StringData op,
                                      const NamespaceString& nss,
@@ -126,6 +126,11 @@ private:
 
     void _pinnedUsersThreadRoutine() noexcept;
 
+    /**
+     * Loads the users listed by the external state into the user cache, up to its capacity.
+     */
+    void _warmUpUserCache(OperationContext* opCtx);
+
     std::unique_ptr<AuthzManagerExternalState> _externalState;
 
     // True if AuthSchema startup checks should be applied in this AuthorizationManager. Changes to
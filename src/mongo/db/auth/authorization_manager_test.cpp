@@ -300,5 +300,28 @@ TEST_F(AuthorizationManagerTest, testAcquireV2UserWithUnrecognizedActions) {
     ASSERT(actions.empty());
 }
 
+TEST_F(AuthorizationManagerTest, testGetUserNamesForCacheWarmUp) {
+    for (auto&& name : {"alice", "bob", "carol"}) {
+        ASSERT_OK(externalState->insertPrivilegeDocument(
+            opCtx.get(),
+            BSON("_id" << std::string("test.") + name << "user" << name << "db"
+                       << "test"
+                       << "credentials" << credentials << "roles" << BSONArray()),
+            BSONObj()));
+    }
+
+    std::vector<UserName> userNames;
+    ASSERT_OK(externalState->getUserNames(opCtx.get(), 10, &userNames));
+    std::sort(userNames.begin(), userNames.end());
+    ASSERT_EQ(userNames.size(), 3U);
+    ASSERT_EQ(userNames[0], UserName("alice", "test"));
+    ASSERT_EQ(userNames[2], UserName("carol", "test"));
+
+    // The listing stops at the requested limit, such as the capacity of the user cache.
+    userNames.clear();
+    ASSERT_OK(externalState->getUserNames(opCtx.get(), 2, &userNames));
+    ASSERT_EQ(userNames.size(), 2U);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -166,6 +166,17 @@ public:
      */
     virtual bool hasAnyPrivilegeDocuments(OperationContext* opCtx) = 0;
 
+    /**
+     * Appends to "result" the names of up to "limit" users with privilege documents, which the
+     * AuthorizationManager may use to warm up its user cache. Returns ErrorCodes::NotImplemented
+     * if user documents are not stored locally.
+     */
+    virtual Status getUserNames(OperationContext* opCtx,
+                                size_t limit,
+                                std::vector<UserName>* result) {
+        return {ErrorCodes::NotImplemented, "Listing users is not supported"};
+    }
+
     virtual void logOp(OperationContext* opCtx,
                        AuthorizationManagerImpl* authManager,
                        StringData op,
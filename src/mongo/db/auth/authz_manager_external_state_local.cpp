@@ -245,6 +245,31 @@ bool AuthzManagerExternalStateLocal::hasAnyPrivilegeDocuments(OperationContext*
     return false;
 }
 
+Status AuthzManagerExternalStateLocal::getUserNames(OperationContext* opCtx,
+                                                    size_t limit,
+                                                    std::vector<UserName>* result) {
+    return query(opCtx,
+                 AuthorizationManager::usersCollectionNamespace,
+                 BSONObj(),
+                 BSON(AuthorizationManager::USER_NAME_FIELD_NAME
+                      << 1 << AuthorizationManager::USER_DB_FIELD_NAME << 1),
+                 [&](const BSONObj& userDoc) {
+                     if (result->size() >= limit) {
+                         return;
+                     }
+                     std::string user;
+                     std::string db;
+                     if (bsonExtractStringField(
+                             userDoc, AuthorizationManager::USER_NAME_FIELD_NAME, &user)
+                             .isOK() &&
+                         bsonExtractStringField(
+                             userDoc, AuthorizationManager::USER_DB_FIELD_NAME, &db)
+                             .isOK()) {
+                         result->emplace_back(user, db);
+                     }
+                 });
+}
+
 AuthzManagerExternalStateLocal::RolesLocks::RolesLocks(OperationContext* opCtx) {
     _adminLock =
         std::make_unique<Lock::DBLock>(opCtx, NamespaceString::kAdminDb, LockMode::MODE_IS);
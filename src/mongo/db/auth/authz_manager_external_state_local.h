@@ -80,6 +80,10 @@ public:
 
     bool hasAnyPrivilegeDocuments(OperationContext* opCtx) final;
 
+    Status getUserNames(OperationContext* opCtx,
+                        size_t limit,
+                        std::vector<UserName>* result) final;
+
     /**
      * Finds a document matching "query" in "collectionName", and store a shared-ownership
      * copy into "result".
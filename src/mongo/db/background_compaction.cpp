@@ -0,0 +1,284 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/background_compaction.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/background_compaction_gen.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/collection_compact.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/background.h"
+#include "mongo/util/concurrency/idle_thread_block.h"
+
+namespace mongo {
+
+class BackgroundCompactionMonitor;
+
+namespace {
+
+const auto getBackgroundCompactionMonitor =
+    ServiceContext::declareDecoration<std::unique_ptr<BackgroundCompactionMonitor>>();
+
+Counter64 backgroundCompactionPasses;
+Counter64 backgroundCompactionCollectionsCompacted;
+Counter64 backgroundCompactionBytesFreed;
+Counter64 backgroundCompactionFailures;
+
+ServerStatusMetricField<Counter64> backgroundCompactionPassesDisplay(
+    "backgroundCompaction.passes", &backgroundCompactionPasses);
+ServerStatusMetricField<Counter64> backgroundCompactionCollectionsCompactedDisplay(
+    "backgroundCompaction.collectionsCompacted", &backgroundCompactionCollectionsCompacted);
+ServerStatusMetricField<Counter64> backgroundCompactionBytesFreedDisplay(
+    "backgroundCompaction.bytesFreed", &backgroundCompactionBytesFreed);
+ServerStatusMetricField<Counter64> backgroundCompactionFailuresDisplay(
+    "backgroundCompaction.failures", &backgroundCompactionFailures);
+
+}  // namespace
+
+class BackgroundCompactionMonitor : public BackgroundJob {
+public:
+    BackgroundCompactionMonitor() : BackgroundJob(false /* selfDelete */) {}
+
+    static BackgroundCompactionMonitor* get(ServiceContext* serviceCtx) {
+        return getBackgroundCompactionMonitor(serviceCtx).get();
+    }
+
+    static void set(ServiceContext* serviceCtx,
+                    std::unique_ptr<BackgroundCompactionMonitor> monitor) {
+        auto& compactionMonitor = getBackgroundCompactionMonitor(serviceCtx);
+        if (compactionMonitor) {
+            invariant(!compactionMonitor->running(),
+                      "Tried to reset the BackgroundCompactionMonitor without shutting down the "
+                      "original instance.");
+        }
+
+        invariant(monitor);
+        compactionMonitor = std::move(monitor);
+    }
+
+    std::string name() const {
+        return "BackgroundCompactionMonitor";
+    }
+
+    void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+
+        {
+            stdx::lock_guard<Client> lk(*tc.get());
+            tc.get()->setSystemOperationKillableByStepdown(lk);
+        }
+
+        while (true) {
+            {
+                // Wait until either backgroundCompactionSleepSecs passes or a shutdown is
+                // requested.
+                auto deadline = Date_t::now() + Seconds(gBackgroundCompactionSleepSecs.load());
+                stdx::unique_lock<Latch> lk(_stateMutex);
+
+                MONGO_IDLE_THREAD_BLOCK;
+                _shuttingDownCV.wait_until(
+                    lk, deadline.toSystemTimePoint(), [&] { return _shuttingDown; });
+
+                if (_shuttingDown) {
+                    return;
+                }
+            }
+
+            if (!gBackgroundCompactionEnabled.load()) {
+                LOGV2_DEBUG(5191180, 2, "Background compaction is disabled");
+                continue;
+            }
+
+            if (lockedForWriting()) {
+                LOGV2_DEBUG(5191181, 2, "Skipping background compaction while locked for writing");
+                continue;
+            }
+
+            try {
+                doCompactionPass();
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>& interruption) {
+                LOGV2_DEBUG(5191182,
+                            1,
+                            "Background compaction pass was interrupted",
+                            "error"_attr = interruption);
+            }
+        }
+    }
+
+    /**
+     * Signals the thread to quit and then waits until it does.
+     */
+    void shutdown() {
+        LOGV2(5191183, "Shutting down the background compaction monitor thread");
+        {
+            stdx::lock_guard<Latch> lk(_stateMutex);
+            _shuttingDown = true;
+            _shuttingDownCV.notify_one();
+        }
+        wait();
+        LOGV2(5191184, "Finished shutting down the background compaction monitor thread");
+    }
+
+private:
+    struct Candidate {
+        NamespaceString nss;
+        int64_t freeBytes;
+    };
+
+    /**
+     * Finds the collections whose record store reports at least backgroundCompactionMinFreeBytes
+     * of reusable space and compacts up to backgroundCompactionMaxCollectionsPerPass of them, most
+     * reusable space first.
+     */
+    void doCompactionPass() {
+        const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxPtr.get();
+
+        // Compaction is background work and must not take tickets ahead of user operations.
+        opCtx->lockState()->setAdmissionPriority(TicketHolder::Priority::kLow);
+
+        backgroundCompactionPasses.increment();
+
+        const int64_t minFreeBytes = gBackgroundCompactionMinFreeBytes.load();
+        std::vector<Candidate> candidates;
+        const auto& catalog = CollectionCatalog::get(opCtx);
+        for (const auto& dbName : catalog.getAllDbNames()) {
+            for (const auto& nss : catalog.getAllCollectionNamesFromDb(opCtx, dbName)) {
+                // The compact command refuses system namespaces, and the oplog manages its own
+                // space by truncation.
+                if (nss.isSystem() || nss.isOplog() || nss.isDropPendingNamespace()) {
+                    continue;
+                }
+
+                AutoGetCollection coll(opCtx, nss, MODE_IS);
+                if (!coll || !coll->getRecordStore()->compactSupported()) {
+                    continue;
+                }
+
+                const auto freeBytes = coll->getRecordStore()->freeStorageSize(opCtx);
+                if (freeBytes > 0 && freeBytes >= minFreeBytes) {
+                    candidates.push_back({nss, freeBytes});
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.freeBytes > rhs.freeBytes;
+        });
+
+        const size_t maxCollections =
+            static_cast<size_t>(gBackgroundCompactionMaxCollectionsPerPass.load());
+        if (candidates.size() > maxCollections) {
+            candidates.resize(maxCollections);
+        }
+
+        for (const auto& candidate : candidates) {
+            opCtx->checkForInterrupt();
+            compactOne(opCtx, candidate);
+        }
+    }
+
+    void compactOne(OperationContext* opCtx, const Candidate& candidate) {
+        LOGV2(5191185,
+              "Starting background compaction",
+              logAttrs(candidate.nss),
+              "freeStorageSize"_attr = candidate.freeBytes);
+
+        try {
+            auto swBytesFreed = compactCollection(opCtx, candidate.nss);
+            if (!swBytesFreed.isOK()) {
+                backgroundCompactionFailures.increment();
+                LOGV2_WARNING(5191186,
+                              "Background compaction failed",
+                              logAttrs(candidate.nss),
+                              "error"_attr = swBytesFreed.getStatus());
+                return;
+            }
+
+            backgroundCompactionCollectionsCompacted.increment();
+            if (swBytesFreed.getValue() > 0) {
+                backgroundCompactionBytesFreed.increment(swBytesFreed.getValue());
+            }
+            LOGV2(5191187,
+                  "Finished background compaction",
+                  logAttrs(candidate.nss),
+                  "bytesFreed"_attr = swBytesFreed.getValue());
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            throw;
+        } catch (const DBException& ex) {
+            // The collection may have been dropped or renamed since the candidates were gathered.
+            backgroundCompactionFailures.increment();
+            LOGV2_WARNING(5191188,
+                          "Background compaction failed",
+                          logAttrs(candidate.nss),
+                          "error"_attr = ex.toStatus());
+        }
+    }
+
+    // Protects the state below.
+    mutable Mutex _stateMutex = MONGO_MAKE_LATCH("BackgroundCompactionMonitorStateMutex");
+
+    // Signaled to wake up the thread, if the thread is waiting. The thread will check whether
+    // _shuttingDown is set and stop accordingly.
+    mutable stdx::condition_variable _shuttingDownCV;
+
+    bool _shuttingDown = false;
+};
+
+void startBackgroundCompactionMonitor(ServiceContext* serviceContext) {
+    auto monitor = std::make_unique<BackgroundCompactionMonitor>();
+    monitor->go();
+    BackgroundCompactionMonitor::set(serviceContext, std::move(monitor));
+}
+
+void shutdownBackgroundCompactionMonitor(ServiceContext* serviceContext) {
+    auto monitor = BackgroundCompactionMonitor::get(serviceContext);
+    // The monitor may not be set if shutdown occurs before it has been started.
+    if (monitor) {
+        monitor->shutdown();
+    }
+}
+
+}  // namespace mongo
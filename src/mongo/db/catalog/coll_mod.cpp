@@ -108,6 +108,7 @@ struct CollModRequest {
     boost::optional<std::string> collValidationAction;
     boost::optional<std::string> collValidationLevel;
     bool recordPreImages = false;
+    boost::optional<bool> lowCachePriority;
 };
 
 StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
@@ -289,6 +290,17 @@ StatusWith<CollModRequest> parseCollModRequest(OperationContext* opCtx,
             }
 
             cmr.recordPreImages = e.trueValue();
+        } else if (fieldName == "cachePriority") {
+            if (isView) {
+                return {ErrorCodes::InvalidOptions,
+                        str::stream() << "option not supported on a view: " << fieldName};
+            }
+
+            auto swLowCachePriority = CollectionOptions::parseCachePriority(e);
+            if (!swLowCachePriority.isOK()) {
+                return swLowCachePriority.getStatus();
+            }
+            cmr.lowCachePriority = swLowCachePriority.getValue();
         } else {
             if (isView) {
                 return Status(ErrorCodes::InvalidOptions,
@@ -525,6 +537,11 @@ Status _collModInternal(OperationContext* opCtx,
             coll.getWritableCollection()->setRecordPreImages(opCtx, cmrNew.recordPreImages);
         }
 
+        if (cmrNew.lowCachePriority &&
+            *cmrNew.lowCachePriority != oldCollOptions.lowCachePriority) {
+            coll.getWritableCollection()->setLowCachePriority(opCtx, *cmrNew.lowCachePriority);
+        }
+
         // Only observe non-view collMods, as view operations are observed as operations on the
         // system.views collection.
         auto* const opObserver = opCtx->getServiceContext()->getOpObserver();
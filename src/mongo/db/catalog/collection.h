@@ -401,10 +401,11 @@ public:
     virtual bool updateWithDamagesSupported() const = 0;
 
     /**
-     * Not allowed to modify indexes.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
+     * If 'indexesAffected' is true, the index entries of the record are updated to match the
+     * damaged document; 'opDebug' may be null.
      * @return the contents of the updated record.
      */
     virtual StatusWith<RecordData> updateDocumentWithDamages(
@@ -413,6 +414,8 @@ public:
         const Snapshotted<RecordData>& oldRec,
         const char* const damageSource,
         const mutablebson::DamageVector& damages,
+        const bool indexesAffected,
+        OpDebug* const opDebug,
         CollectionUpdateArgs* const args) const = 0;
 
     // -----------
@@ -476,6 +479,13 @@ public:
     virtual bool getRecordPreImages() const = 0;
     virtual void setRecordPreImages(OperationContext* opCtx, bool val) = 0;
 
+    /**
+     * Returns true if the reads of this collection should bring its pages into the storage engine
+     * cache as the first to be evicted.
+     */
+    virtual bool getLowCachePriority() const = 0;
+    virtual void setLowCachePriority(OperationContext* opCtx, bool val) = 0;
+
     /**
      * Returns true if this is a temporary collection.
      *
@@ -490,6 +500,13 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if the records of this collection are keyed by their _id, as created with the
+     * 'clusteredIndex' option. Such a collection has no separate _id index: its documents are found
+     * by seeking to the RecordId computed by clustered_id::keyForId().
+     */
+    virtual bool isClustered() const = 0;
+
     /**
      * Returns a pointer to a capped callback object.
      * The storage engine interacts with capped collections through a CappedCallback interface.
@@ -214,6 +214,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
     _collections[toCollection] = _collections[fromCollection];
     _collections.erase(fromCollection);
+    _catalogVersion.fetchAndAdd(1);
 
     ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
     ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -227,6 +228,7 @@ void CollectionCatalog::setCollectionNamespace(OperationContext* opCtx,
 
         _collections[fromCollection] = _collections[toCollection];
         _collections.erase(toCollection);
+        _catalogVersion.fetchAndAdd(1);
 
         ResourceId oldRid = ResourceId(RESOURCE_COLLECTION, fromCollection.ns());
         ResourceId newRid = ResourceId(RESOURCE_COLLECTION, toCollection.ns());
@@ -249,6 +251,7 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     _shadowCatalog.emplace();
     for (auto& entry : _catalog)
         _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _catalogVersion.fetchAndAdd(1);
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -257,12 +260,17 @@ void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
     invariant(_shadowCatalog);
     _shadowCatalog.reset();
     ++_epoch;
+    _catalogVersion.fetchAndAdd(1);
 }
 
 uint64_t CollectionCatalog::getEpoch() const {
     return _epoch;
 }
 
+uint64_t CollectionCatalog::getCatalogVersion() const {
+    return _catalogVersion.load();
+}
+
 std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByUUIDForRead(
     OperationContext* opCtx, CollectionUUID uuid) const {
     if (auto coll = UncommittedCollections::getForTxn(opCtx, uuid)) {
@@ -291,6 +299,7 @@ Collection* CollectionCatalog::lookupCollectionByUUIDForMetadataWrite(OperationC
     auto coll = _lookupCollectionByUUID(lock, uuid);
     if (coll && coll->isCommitted()) {
         invariant(opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_X));
+        _onMetadataWrite(lock, opCtx, mode);
         return coll.get();
     }
 
@@ -312,6 +321,7 @@ void CollectionCatalog::makeCollectionVisible(CollectionUUID uuid) {
     stdx::lock_guard<Latch> lock(_catalogLock);
     auto coll = _lookupCollectionByUUID(lock, uuid);
     coll->setCommitted(true);
+    _catalogVersion.fetchAndAdd(1);
 }
 
 bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) const {
@@ -320,6 +330,24 @@ bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) cons
     return coll && !coll->isCommitted();
 }
 
+void CollectionCatalog::_onMetadataWrite(WithLock, OperationContext* opCtx, LifetimeMode mode) {
+    _catalogVersion.fetchAndAdd(1);
+    if (mode != LifetimeMode::kManagedInWriteUnitOfWork) {
+        return;
+    }
+
+    // The Collection is modified in place, so lock-free readers that establish their snapshot
+    // while the write is in progress must also observe a version change once it finishes.
+    opCtx->recoveryUnit()->onCommit([this](boost::optional<Timestamp>) {
+        stdx::lock_guard<Latch> lock(_catalogLock);
+        _catalogVersion.fetchAndAdd(1);
+    });
+    opCtx->recoveryUnit()->onRollback([this] {
+        stdx::lock_guard<Latch> lock(_catalogLock);
+        _catalogVersion.fetchAndAdd(1);
+    });
+}
+
 std::shared_ptr<Collection> CollectionCatalog::_lookupCollectionByUUID(WithLock,
                                                                        CollectionUUID uuid) const {
     auto foundIt = _catalog.find(uuid);
@@ -355,6 +383,7 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
     auto coll = (it == _collections.end() ? nullptr : it->second);
     if (coll && coll->isCommitted()) {
         invariant(opCtx->lockState()->isCollectionLockedForMode(nss, MODE_X));
+        _onMetadataWrite(lock, opCtx, mode);
         return coll.get();
     }
 
@@ -555,6 +584,7 @@ void CollectionCatalog::registerCollection(CollectionUUID uuid, std::shared_ptr<
     _catalog[uuid] = coll;
     _collections[ns] = coll;
     _orderedCollections[dbIdPair] = coll;
+    _catalogVersion.fetchAndAdd(1);
 
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
@@ -582,6 +612,7 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(CollectionUU
     _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
     _catalog.erase(uuid);
+    _catalogVersion.fetchAndAdd(1);
 
     coll->onDeregisterFromCatalog();
 
@@ -619,6 +650,7 @@ void CollectionCatalog::deregisterAllCollections() {
     _collections.clear();
     _orderedCollections.clear();
     _catalog.clear();
+    _catalogVersion.fetchAndAdd(1);
 
     stdx::lock_guard<Latch> resourceLock(_resourceLock);
     _resourceInformation.clear();
@@ -36,6 +36,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/uuid.h"
 
@@ -324,6 +325,17 @@ public:
      */
     uint64_t getEpoch() const;
 
+    /**
+     * The catalog version is incremented whenever the set of registered collections, their
+     * namespaces or their visibility changes, and whenever a writable Collection is handed out for
+     * a metadata write or that write commits or aborts.
+     *
+     * Unlike the epoch, this may be read without holding any locks. Lock-free readers compare the
+     * version observed before and after establishing their storage snapshot to detect concurrent
+     * catalog changes.
+     */
+    uint64_t getCatalogVersion() const;
+
     iterator begin(StringData db) const;
     iterator end() const;
 
@@ -361,6 +373,12 @@ private:
 
     std::shared_ptr<Collection> _lookupCollectionByUUID(WithLock, CollectionUUID uuid) const;
 
+    /**
+     * Bumps the catalog version when a writable Collection is handed out, and again when the
+     * write unit of work managing it commits or aborts.
+     */
+    void _onMetadataWrite(WithLock, OperationContext* opCtx, LifetimeMode mode);
+
     const std::vector<CollectionUUID>& _getOrdering_inlock(const StringData& db,
                                                            const stdx::lock_guard<Latch>&);
     mutable mongo::Mutex _catalogLock;
@@ -402,6 +420,9 @@ private:
     // global lock in at least MODE_IS to read it.
     uint64_t _epoch = 0;
 
+    // See getCatalogVersion. Only incremented while holding '_catalogLock'.
+    AtomicWord<uint64_t> _catalogVersion{0};
+
     // Protects _resourceInformation.
     mutable Mutex _resourceLock = MONGO_MAKE_LATCH("CollectionCatalog::_resourceLock");
 
@@ -527,6 +527,37 @@ TEST_F(CollectionCatalogTest, RenameCollection) {
     ASSERT_EQUALS(catalog.lookupCollectionByUUID(&opCtx, uuid), collection);
 }
 
+TEST_F(CollectionCatalogTest, CatalogVersionChangesOnCatalogChanges) {
+    auto version = catalog.getCatalogVersion();
+    auto expectVersionChange = [&] {
+        ASSERT_GT(catalog.getCatalogVersion(), version);
+        version = catalog.getCatalogVersion();
+    };
+
+    // Lookups do not change the version.
+    ASSERT(catalog.lookupCollectionByNamespaceForRead(&opCtx, nss));
+    ASSERT_EQ(catalog.getCatalogVersion(), version);
+
+    auto uuid = CollectionUUID::gen();
+    NamespaceString oldNss(nss.db(), "oldcol");
+    std::shared_ptr<Collection> collShared = std::make_shared<CollectionMock>(oldNss);
+    auto collection = collShared.get();
+    catalog.registerCollection(uuid, std::move(collShared));
+    expectVersionChange();
+
+    NamespaceString newNss(nss.db(), "newcol");
+    catalog.setCollectionNamespace(&opCtx, collection, oldNss, newNss);
+    expectVersionChange();
+
+    catalog.deregisterCollection(uuid);
+    expectVersionChange();
+
+    catalog.onCloseCatalog(&opCtx);
+    expectVersionChange();
+    catalog.onOpenCatalog(&opCtx);
+    expectVersionChange();
+}
+
 TEST_F(CollectionCatalogTest, LookupNSSByUUIDForClosedCatalogReturnsOldNSSIfDropped) {
     catalog.onCloseCatalog(&opCtx);
     catalog.deregisterCollection(colUUID);
@@ -70,7 +70,9 @@
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/record_store.h"
+#include "mongo/db/update/document_diff_applier.h"
 #include "mongo/db/update/update_driver.h"
+#include "mongo/db/update/update_oplog_entry_serialization.h"
 
 #include "mongo/db/auth/user_document_parser.h"  // XXX-ANDY
 #include "mongo/logv2/log.h"
@@ -307,6 +309,10 @@ void CollectionImpl::init(OperationContext* opCtx) {
         uassertStatusOK(validatePreImageRecording(opCtx, _ns));
         _recordPreImages = true;
     }
+    _lowCachePriority = collectionOptions.lowCachePriority;
+    uassert(5190400,
+            str::stream() << "The storage engine does not support clustered collections: " << _ns,
+            collectionOptions.clusteredIndex == _recordStore->isClustered());
 
     // Store the result (OK / error) of parsing the validator, but do not enforce that the result is
     // OK. This is intentional, as users may have validators on disk which were considered well
@@ -346,6 +352,11 @@ bool CollectionImpl::requiresIdIndex() const {
         return false;
     }
 
+    if (isClustered()) {
+        // The records are keyed by _id.
+        return false;
+    }
+
     if (_ns.isSystem()) {
         StringData shortName = _ns.coll().substr(_ns.coll().find('.') + 1);
         if (shortName == "indexes" || shortName == "namespaces" || shortName == "profile") {
@@ -835,8 +846,28 @@ RecordId CollectionImpl::updateDocument(OperationContext* opCtx,
     }
     args->preImageRecordingEnabledForCollection = getRecordPreImages();
 
-    uassertStatusOK(
-        _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    // A $v:2 delta entry describes exactly which fields changed, so the storage write can be
+    // limited to those bytes rather than the whole document.
+    boost::optional<mutablebson::DamageVector> damages;
+    if (!args->update.isEmpty() && !_recordStore->isCapped() &&
+        _recordStore->updateWithDamagesSupported() &&
+        update_oplog_entry::extractUpdateType(args->update) ==
+            update_oplog_entry::UpdateType::kV2Delta) {
+        damages = doc_diff::computeDamages(
+            oldDoc.value(),
+            newDoc,
+            args->update[update_oplog_entry::kDiffObjectFieldName].embeddedObject());
+    }
+
+    if (damages) {
+        const RecordData oldRec(oldDoc.value().objdata(), oldDoc.value().objsize());
+        uassertStatusOK(
+            _recordStore->updateWithDamages(opCtx, oldLocation, oldRec, newDoc.objdata(), *damages)
+                .getStatus());
+    } else {
+        uassertStatusOK(
+            _recordStore->updateRecord(opCtx, oldLocation, newDoc.objdata(), newDoc.objsize()));
+    }
 
     if (indexesAffected) {
         int64_t keysInserted, keysDeleted;
@@ -872,15 +903,18 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
     const Snapshotted<RecordData>& oldRec,
     const char* damageSource,
     const mutablebson::DamageVector& damages,
+    bool indexesAffected,
+    OpDebug* opDebug,
     CollectionUpdateArgs* args) const {
     dassert(opCtx->lockState()->isCollectionLockedForMode(ns(), MODE_IX));
     invariant(oldRec.snapshotId() == opCtx->recoveryUnit()->getSnapshotId());
     invariant(updateWithDamagesSupported());
 
     // For in-place updates we need to grab an owned copy of the pre-image doc if pre-image
-    // recording is enabled and we haven't already set the pre-image due to this update being
-    // a retryable findAndModify or a possible update to the shard key.
-    if (!args->preImageDoc && getRecordPreImages()) {
+    // recording is enabled or the index entries of the old document must be removed, and we
+    // haven't already set the pre-image due to this update being a retryable findAndModify or a
+    // possible update to the shard key.
+    if (!args->preImageDoc && (getRecordPreImages() || indexesAffected)) {
         args->preImageDoc = oldRec.value().toBson().getOwned();
     }
 
@@ -889,6 +923,24 @@ StatusWith<RecordData> CollectionImpl::updateDocumentWithDamages(
 
     if (newRecStatus.isOK()) {
         args->updatedDoc = newRecStatus.getValue().toBson();
+
+        if (indexesAffected) {
+            int64_t keysInserted, keysDeleted;
+
+            uassertStatusOK(_indexCatalog->updateRecord(opCtx,
+                                                        this,
+                                                        *args->preImageDoc,
+                                                        args->updatedDoc,
+                                                        loc,
+                                                        &keysInserted,
+                                                        &keysDeleted));
+
+            if (opDebug) {
+                opDebug->additiveMetrics.incrementKeysInserted(keysInserted);
+                opDebug->additiveMetrics.incrementKeysDeleted(keysDeleted);
+            }
+        }
+
         args->preImageRecordingEnabledForCollection = getRecordPreImages();
         OplogUpdateEntryArgs entryArgs(*args, ns(), _uuid);
         getGlobalServiceContext()->getOpObserver()->onUpdate(opCtx, entryArgs);
@@ -912,10 +964,23 @@ void CollectionImpl::setRecordPreImages(OperationContext* opCtx, bool val) {
     _recordPreImages = val;
 }
 
+bool CollectionImpl::getLowCachePriority() const {
+    return _lowCachePriority;
+}
+
+void CollectionImpl::setLowCachePriority(OperationContext* opCtx, bool val) {
+    DurableCatalog::get(opCtx)->setLowCachePriority(opCtx, getCatalogId(), val);
+    _lowCachePriority = val;
+}
+
 bool CollectionImpl::isCapped() const {
     return _cappedNotifier.get();
 }
 
+bool CollectionImpl::isClustered() const {
+    return _recordStore->isClustered();
+}
+
 CappedCallback* CollectionImpl::getCappedCallback() {
     return this;
 }
@@ -203,10 +203,11 @@ public:
     bool updateWithDamagesSupported() const final;
 
     /**
-     * Not allowed to modify indexes.
      * Illegal to call if updateWithDamagesSupported() returns false.
      * Sets 'args.updatedDoc' to the updated version of the document with damages applied, on
      * success.
+     * If 'indexesAffected' is true, the index entries of the record are updated to match the
+     * damaged document; 'opDebug' may be null.
      * @return the contents of the updated record.
      */
     StatusWith<RecordData> updateDocumentWithDamages(OperationContext* opCtx,
@@ -214,6 +215,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) const final;
 
     // -----------
@@ -275,6 +278,9 @@ public:
     bool getRecordPreImages() const final;
     void setRecordPreImages(OperationContext* opCtx, bool val) final;
 
+    bool getLowCachePriority() const final;
+    void setLowCachePriority(OperationContext* opCtx, bool val) final;
+
     bool isTemporary(OperationContext* opCtx) const final;
 
     //
@@ -283,6 +289,8 @@ public:
 
     bool isCapped() const final;
 
+    bool isClustered() const final;
+
     CappedCallback* getCappedCallback() final;
     const CappedCallback* getCappedCallback() const final;
 
@@ -411,6 +419,7 @@ private:
     ValidationLevel _validationLevel;
 
     bool _recordPreImages = false;
+    bool _lowCachePriority = false;
 
     // Notifier object for awaitData. Threads polling a capped collection for new data can wait
     // on this object until notified of the arrival of new data.
@@ -162,6 +162,8 @@ public:
                                                      const Snapshotted<RecordData>& oldRec,
                                                      const char* damageSource,
                                                      const mutablebson::DamageVector& damages,
+                                                     bool indexesAffected,
+                                                     OpDebug* opDebug,
                                                      CollectionUpdateArgs* args) const {
         std::abort();
     }
@@ -219,10 +221,22 @@ public:
         std::abort();
     }
 
+    bool getLowCachePriority() const {
+        return false;
+    }
+
+    void setLowCachePriority(OperationContext* opCtx, bool val) {
+        std::abort();
+    }
+
     bool isCapped() const {
         std::abort();
     }
 
+    bool isClustered() const {
+        std::abort();
+    }
+
     CappedCallback* getCappedCallback() {
         std::abort();
     }
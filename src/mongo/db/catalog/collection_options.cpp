@@ -56,6 +56,21 @@ bool CollectionOptions::validMaxCappedDocs(long long* max) {
     return false;
 }
 
+// static
+StatusWith<bool> CollectionOptions::parseCachePriority(const BSONElement& elem) {
+    if (elem.type() == String) {
+        if (elem.valueStringData() == "low") {
+            return true;
+        }
+        if (elem.valueStringData() == "normal") {
+            return false;
+        }
+    }
+    return {ErrorCodes::InvalidOptions,
+            str::stream() << "'cachePriority' must be either \"low\" or \"normal\", found: "
+                          << elem};
+}
+
 namespace {
 
 Status checkStorageEngineOptions(const BSONElement& elem) {
@@ -93,6 +108,45 @@ Status checkStorageEngineOptions(const BSONElement& elem) {
     return Status::OK();
 }
 
+Status checkTimeseriesField(StringData option, StringData field) {
+    if (field.empty() || field.find('.') != std::string::npos || field.startsWith("$")) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "'timeseries." << option
+                              << "' must be the name of a top-level field, not '" << field << "'"};
+    }
+    return Status::OK();
+}
+
+StatusWith<TimeseriesOptions> parseTimeseriesOptions(const BSONElement& elem) {
+    if (elem.type() != mongo::Object) {
+        return {ErrorCodes::TypeMismatch, "'timeseries' has to be an object."};
+    }
+
+    TimeseriesOptions options;
+    try {
+        options = TimeseriesOptions::parse({"timeseries"}, elem.Obj());
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+
+    if (auto status = checkTimeseriesField("timeField", options.getTimeField()); !status.isOK()) {
+        return status;
+    }
+    if (auto metaField = options.getMetaField()) {
+        if (auto status = checkTimeseriesField("metaField", *metaField); !status.isOK()) {
+            return status;
+        }
+        if (*metaField == options.getTimeField()) {
+            return {ErrorCodes::BadValue,
+                    "'timeseries.metaField' cannot be the same as 'timeseries.timeField'"};
+        }
+    }
+    if (options.getBucketMaxSpanSeconds() < 1) {
+        return {ErrorCodes::BadValue, "'timeseries.bucketMaxSpanSeconds' must be at least 1"};
+    }
+    return options;
+}
+
 }  // namespace
 
 bool CollectionOptions::isView() const {
@@ -170,6 +224,16 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             collectionOptions.temp = e.trueValue();
         } else if (fieldName == "recordPreImages") {
             collectionOptions.recordPreImages = e.trueValue();
+        } else if (fieldName == "coldStorage") {
+            collectionOptions.coldStorage = e.trueValue();
+        } else if (fieldName == "clusteredIndex") {
+            collectionOptions.clusteredIndex = e.trueValue();
+        } else if (fieldName == "cachePriority") {
+            auto swLowCachePriority = parseCachePriority(e);
+            if (!swLowCachePriority.isOK()) {
+                return swLowCachePriority.getStatus();
+            }
+            collectionOptions.lowCachePriority = swLowCachePriority.getValue();
         } else if (fieldName == "storageEngine") {
             Status status = checkStorageEngineOptions(e);
             if (!status.isOK()) {
@@ -237,6 +301,14 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
             }
 
             collectionOptions.pipeline = e.Obj().getOwned();
+        } else if (fieldName == "materialized") {
+            collectionOptions.materialized = e.trueValue();
+        } else if (fieldName == "timeseries") {
+            auto timeseries = parseTimeseriesOptions(e);
+            if (!timeseries.isOK()) {
+                return timeseries.getStatus();
+            }
+            collectionOptions.timeseries = std::move(timeseries.getValue());
         } else if (fieldName == "idIndex" && kind == parseForCommand) {
             if (e.type() != mongo::Object) {
                 return Status(ErrorCodes::TypeMismatch, "'idIndex' has to be an object.");
@@ -260,6 +332,29 @@ StatusWith<CollectionOptions> CollectionOptions::parse(const BSONObj& options, P
         return Status(ErrorCodes::BadValue, "'pipeline' cannot be specified without 'viewOn'");
     }
 
+    if (collectionOptions.viewOn.empty() && collectionOptions.materialized) {
+        return Status(ErrorCodes::BadValue, "'materialized' cannot be specified without 'viewOn'");
+    }
+
+    if (collectionOptions.timeseries &&
+        (collectionOptions.capped || collectionOptions.clusteredIndex ||
+         !collectionOptions.viewOn.empty() || !collectionOptions.validator.isEmpty())) {
+        return Status(ErrorCodes::InvalidOptions,
+                      "'timeseries' cannot be specified for capped or clustered collections, "
+                      "views or collections with a validator");
+    }
+
+    if (collectionOptions.clusteredIndex) {
+        if (collectionOptions.capped || !collectionOptions.viewOn.empty()) {
+            return Status(ErrorCodes::InvalidOptions,
+                          "'clusteredIndex' cannot be specified for capped collections or views");
+        }
+        if (collectionOptions.autoIndexId == YES || !collectionOptions.idIndex.isEmpty()) {
+            return Status(ErrorCodes::InvalidOptions,
+                          "A clustered collection cannot have a separate _id index");
+        }
+    }
+
     return collectionOptions;
 }
 
@@ -292,6 +387,18 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendBool("recordPreImages", true);
     }
 
+    if (coldStorage) {
+        builder->appendBool("coldStorage", true);
+    }
+
+    if (clusteredIndex) {
+        builder->appendBool("clusteredIndex", true);
+    }
+
+    if (lowCachePriority) {
+        builder->append("cachePriority", "low");
+    }
+
     if (!storageEngine.isEmpty()) {
         builder->append("storageEngine", storageEngine);
     }
@@ -324,6 +431,14 @@ void CollectionOptions::appendBSON(BSONObjBuilder* builder) const {
         builder->appendArray("pipeline", pipeline);
     }
 
+    if (materialized) {
+        builder->appendBool("materialized", true);
+    }
+
+    if (timeseries) {
+        builder->append("timeseries", timeseries->toBSON());
+    }
+
     if (!idIndex.isEmpty()) {
         builder->append("idIndex", idIndex);
     }
@@ -351,6 +466,18 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (coldStorage != other.coldStorage) {
+        return false;
+    }
+
+    if (clusteredIndex != other.clusteredIndex) {
+        return false;
+    }
+
+    if (lowCachePriority != other.lowCachePriority) {
+        return false;
+    }
+
     if (temp != other.temp) {
         return false;
     }
@@ -395,6 +522,15 @@ bool CollectionOptions::matchesStorageOptions(const CollectionOptions& other,
         return false;
     }
 
+    if (materialized != other.materialized) {
+        return false;
+    }
+
+    if ((timeseries ? timeseries->toBSON() : BSONObj())
+            .woCompare(other.timeseries ? other.timeseries->toBSON() : BSONObj()) != 0) {
+        return false;
+    }
+
     return true;
 }
 }  // namespace mongo
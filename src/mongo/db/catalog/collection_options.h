@@ -35,6 +35,7 @@
 
 #include "mongo/base/status.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -91,6 +92,12 @@ struct CollectionOptions {
      */
     static bool validMaxCappedDocs(long long* max);
 
+    /**
+     * Parses a 'cachePriority' option, which is either "low" or "normal", and returns whether it
+     * is "low".
+     */
+    static StatusWith<bool> parseCachePriority(const BSONElement& elem);
+
     /**
      * Returns true if given options matches to this.
      *
@@ -120,6 +127,15 @@ struct CollectionOptions {
 
     bool temp = false;
     bool recordPreImages = false;
+    // Whether the files of the collection and its indexes are kept in the cold storage directory
+    // of the dbpath, which may be on cheaper and slower storage than the rest of the data.
+    bool coldStorage = false;
+    // Whether the records of the collection are keyed by their integral _id, in place of a separate
+    // _id index.
+    bool clusteredIndex = false;
+    // Whether the collection has a low cache priority, in which case the reads of its records and
+    // indexes bring their pages into the storage engine cache as the first to be evicted.
+    bool lowCachePriority = false;
 
     // Storage engine collection options. Always owned or empty.
     BSONObj storageEngine;
@@ -144,5 +160,13 @@ struct CollectionOptions {
     std::string viewOn;
     // The aggregation pipeline that defines this view.
     BSONObj pipeline;
+    // Whether the results of this view are kept up to date in a collection instead of computed on
+    // each read.
+    bool materialized = false;
+
+    // The options of a time-series collection. When creating a time-series collection, these are
+    // stored on the collection which holds its buckets, and the collection itself is a view of
+    // the unpacked measurements of the buckets.
+    boost::optional<TimeseriesOptions> timeseries;
 };
 }  // namespace mongo
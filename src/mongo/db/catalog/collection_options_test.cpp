@@ -349,6 +349,22 @@ TEST(CollectionOptions, MaxNumberLimits) {
     ASSERT_EQ(options.cappedMaxDocs, 0);
 }
 
+TEST(CollectionOptions, CachePriority) {
+    CollectionOptions options =
+        assertGet(CollectionOptions::parse(fromjson("{cachePriority: 'low'}")));
+    ASSERT(options.lowCachePriority);
+    ASSERT_BSONOBJ_EQ(fromjson("{cachePriority: 'low'}"), options.toBSON());
+
+    options = assertGet(CollectionOptions::parse(fromjson("{cachePriority: 'normal'}")));
+    ASSERT_FALSE(options.lowCachePriority);
+    ASSERT_BSONOBJ_EQ(BSONObj(), options.toBSON());
+
+    ASSERT_EQ(CollectionOptions::parse(fromjson("{cachePriority: 'high'}")).getStatus().code(),
+              ErrorCodes::InvalidOptions);
+    ASSERT_EQ(CollectionOptions::parse(fromjson("{cachePriority: true}")).getStatus().code(),
+              ErrorCodes::InvalidOptions);
+}
+
 TEST(CollectionOptions, NExtentsNoError) {
     // Check that $nExtents does not cause an error for backwards compatability
     assertGet(CollectionOptions::parse(fromjson("{$nExtents: 'a'}")));
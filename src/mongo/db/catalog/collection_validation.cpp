@@ -39,12 +39,16 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/validate_adaptor.h"
+#include "mongo/db/catalog/validate_gen.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -61,9 +65,74 @@ namespace {
 // Indicates whether the failpoint turned on by testing has been reached.
 AtomicWord<bool> _validationIsPausedForTest{false};
 
+/**
+ * Runs 'validateEntry' for entries [0, numEntries) on 'numThreads' thread pool workers, each with
+ * its own OperationContext. Workers stop claiming entries once 'opCtx' is killed, and an entry
+ * whose worker could not finish it is left with 'done[i]' unset for the caller to validate.
+ */
+void _validateIndexesInternalStructureConcurrently(
+    OperationContext* opCtx,
+    size_t numThreads,
+    size_t numEntries,
+    std::vector<char>* done,
+    const std::function<void(OperationContext*, size_t)>& validateEntry) {
+    ThreadPool::Options options;
+    options.poolName = "ValidateIndexes";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    ThreadPool pool(options);
+    pool.startup();
+
+    AtomicWord<size_t> nextEntry{0};
+    for (size_t i = 0; i < numThreads; ++i) {
+        pool.schedule([&](Status status) {
+            invariant(status);
+            auto workerOpCtx = cc().makeOperationContext();
+
+            // The caller's exclusive collection lock already keeps writers out. Workers only take
+            // the global intent lock that index validation expects to be held. The wait is
+            // bounded so that a queued global exclusive request, which is itself waiting on the
+            // caller, cannot deadlock a worker; whatever the workers leave behind is validated by
+            // the caller.
+            Lock::GlobalLock globalLock(workerOpCtx.get(),
+                                        MODE_IS,
+                                        Date_t::now() + Milliseconds(100),
+                                        Lock::InterruptBehavior::kLeaveUnlocked);
+            if (!globalLock.isLocked()) {
+                return;
+            }
+
+            auto callerKilled = [opCtx] {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                return opCtx->isKillPending();
+            };
+
+            try {
+                for (auto idx = nextEntry.fetchAndAdd(1); idx < numEntries && !callerKilled();
+                     idx = nextEntry.fetchAndAdd(1)) {
+                    validateEntry(workerOpCtx.get(), idx);
+                    (*done)[idx] = true;
+                }
+            } catch (const DBException& ex) {
+                LOGV2_OPTIONS(5191170,
+                              {LogComponent::kIndex},
+                              "Concurrent index validation failed, the remaining indexes will be "
+                              "validated serially",
+                              "error"_attr = ex.toStatus());
+            }
+        });
+    }
+    pool.shutdown();
+    pool.join();
+}
+
 /**
  * Validates the internal structure of each index in the Index Catalog 'indexCatalog', ensuring that
- * the index files have not been corrupted or compromised.
+ * the index files have not been corrupted or compromised. When 'maxValidateIndexThreads' is greater
+ * than 1, several indexes are validated at the same time.
  *
  * May close or invalidate open cursors.
  */
@@ -76,14 +145,20 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
     const std::unique_ptr<IndexCatalog::IndexIterator> it =
         indexCatalog->getIndexIterator(opCtx, false);
 
-    // Validate Indexes Internal Structure, checking if index files have been compromised or
-    // corrupted.
+    // Look up every result slot up front so that concurrent workers only ever write to distinct,
+    // already existing elements of 'indexResultsMap'.
+    std::vector<const IndexCatalogEntry*> entries;
+    std::vector<IndexValidateResults*> entryResults;
     while (it->more()) {
-        opCtx->checkForInterrupt();
-
         const IndexCatalogEntry* entry = it->next();
-        const IndexDescriptor* descriptor = entry->descriptor();
-        const IndexAccessMethod* iam = entry->accessMethod();
+        entries.push_back(entry);
+        entryResults.push_back(&(results->indexResultsMap)[entry->descriptor()->indexName()]);
+    }
+
+    std::vector<int64_t> numValidated(entries.size(), 0);
+    auto validateEntry = [&](OperationContext* validateOpCtx, size_t i) {
+        const IndexDescriptor* descriptor = entries[i]->descriptor();
+        const IndexAccessMethod* iam = entries[i]->accessMethod();
 
         LOGV2_OPTIONS(20295,
                       {LogComponent::kIndex},
@@ -91,16 +166,34 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
                       "index"_attr = descriptor->indexName(),
                       "namespace"_attr = validateState->nss());
 
-        auto& curIndexResults = (results->indexResultsMap)[descriptor->indexName()];
+        // Start from a clean slate in case an earlier attempt on a worker did not finish.
+        *entryResults[i] = IndexValidateResults();
+        iam->validate(validateOpCtx, &numValidated[i], entryResults[i]);
+    };
+
+    std::vector<char> done(entries.size(), false);
+    const size_t numThreads =
+        std::min(static_cast<size_t>(gMaxValidateIndexThreads.load()), entries.size());
+    if (numThreads > 1) {
+        _validateIndexesInternalStructureConcurrently(
+            opCtx, numThreads, entries.size(), &done, validateEntry);
+    }
 
-        int64_t numValidated;
-        iam->validate(opCtx, &numValidated, &curIndexResults);
+    // Validate Indexes Internal Structure, checking if index files have been compromised or
+    // corrupted.
+    for (size_t i = 0; i < entries.size(); ++i) {
+        opCtx->checkForInterrupt();
+
+        if (!done[i]) {
+            validateEntry(opCtx, i);
+        }
 
+        auto& curIndexResults = *entryResults[i];
         if (!curIndexResults.valid) {
             results->valid = false;
         }
 
-        curIndexResults.keysTraversedFromFullValidate = numValidated;
+        curIndexResults.keysTraversedFromFullValidate = numValidated[i];
     }
 }
 
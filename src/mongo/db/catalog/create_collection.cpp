@@ -46,7 +46,9 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/views/materialized_view.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 
@@ -60,6 +62,18 @@ Status _createView(OperationContext* opCtx,
     return writeConflictRetry(opCtx, "create", nss.ns(), [&] {
         AutoGetOrCreateDb autoDb(opCtx, nss.db(), MODE_IX);
         Lock::CollectionLock collLock(opCtx, nss, MODE_IX);
+        // The results of a materialized view are computed from its collection as it is created.
+        boost::optional<Lock::CollectionLock> viewOnLock;
+        boost::optional<Lock::CollectionLock> materializedLock;
+        if (collectionOptions.materialized) {
+            viewOnLock.emplace(opCtx, NamespaceString(nss.db(), collectionOptions.viewOn), MODE_S);
+            materializedLock.emplace(
+                opCtx,
+                NamespaceString(
+                    nss.db(),
+                    NamespaceString::kMaterializedViewCollectionPrefix.toString() + nss.coll()),
+                MODE_X);
+        }
         // Operations all lock system.views in the end to prevent deadlock.
         Lock::CollectionLock systemViewsLock(
             opCtx,
@@ -103,6 +117,16 @@ Status _createView(OperationContext* opCtx,
         if (!status.isOK()) {
             return status;
         }
+
+        // Secondaries replicate the results of a materialized view rather than computing them.
+        if (collectionOptions.materialized && opCtx->writesAreReplicated()) {
+            auto view = ViewCatalog::get(db)->lookup(opCtx, nss.ns());
+            invariant(view);
+            status = materialized_view::materialize(opCtx, db, *view);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
         wunit.commit();
 
         return Status::OK();
@@ -159,6 +183,95 @@ Status _createCollection(OperationContext* opCtx,
     });
 }
 
+/**
+ * Creates a time-series collection as a view of the measurements of the buckets stored in the
+ * collection 'system.buckets.<coll>', which is created along with it.
+ */
+Status _createTimeseries(OperationContext* opCtx,
+                         const NamespaceString& nss,
+                         const CollectionOptions& collectionOptions) {
+    const auto bucketsNss = nss.makeTimeseriesBucketsNamespace();
+    return writeConflictRetry(opCtx, "create", nss.ns(), [&] {
+        AutoGetOrCreateDb autoDb(opCtx, nss.db(), MODE_IX);
+        Lock::CollectionLock collLock(opCtx, nss, MODE_IX);
+        Lock::CollectionLock bucketsLock(opCtx, bucketsNss, MODE_IX);
+        // Operations all lock system.views in the end to prevent deadlock.
+        Lock::CollectionLock systemViewsLock(
+            opCtx,
+            NamespaceString(nss.db(), NamespaceString::kSystemDotViewsCollectionName),
+            MODE_X);
+
+        Database* db = autoDb.getDb();
+        for (const auto& existingNss : {nss, bucketsNss}) {
+            if (CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, existingNss)) {
+                return Status(ErrorCodes::NamespaceExists,
+                              str::stream() << "Collection already exists. NS: " << existingNss);
+            }
+            if (ViewCatalog::get(db)->lookup(opCtx, existingNss.ns())) {
+                return Status(ErrorCodes::NamespaceExists,
+                              str::stream() << "A view already exists. NS: " << existingNss);
+            }
+        }
+
+        if (opCtx->writesAreReplicated() &&
+            !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, nss)) {
+            return Status(ErrorCodes::NotWritablePrimary,
+                          str::stream() << "Not primary while creating collection " << nss);
+        }
+
+        // Create 'system.views' in a separate WUOW if it does not exist.
+        WriteUnitOfWork wuow(opCtx);
+        const Collection* coll = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(
+            opCtx, NamespaceString(db->getSystemViewsName()));
+        if (!coll) {
+            coll = db->createCollection(opCtx, NamespaceString(db->getSystemViewsName()));
+        }
+        invariant(coll);
+        wuow.commit();
+
+        WriteUnitOfWork wunit(opCtx);
+
+        AutoStatsTracker statsTracker(
+            opCtx,
+            nss,
+            Top::LockType::NotLocked,
+            AutoStatsTracker::LogMode::kUpdateTopAndCurOp,
+            CollectionCatalog::get(opCtx).getDatabaseProfileLevel(nss.db()));
+
+        // If the creation rolls back, ensure that the Top entries created for the view and its
+        // buckets are deleted.
+        opCtx->recoveryUnit()->onRollback(
+            [nss, bucketsNss, serviceContext = opCtx->getServiceContext()]() {
+                Top::get(serviceContext).collectionDropped(nss);
+                Top::get(serviceContext).collectionDropped(bucketsNss);
+            });
+
+        // The buckets collection keeps the options of the time-series collection.
+        Status status = db->userCreateNS(opCtx, bucketsNss, collectionOptions, true, BSONObj());
+        if (!status.isOK()) {
+            return status;
+        }
+
+        BSONObjBuilder unpackSpec;
+        unpackSpec.append("timeField", collectionOptions.timeseries->getTimeField());
+        if (auto metaField = collectionOptions.timeseries->getMetaField()) {
+            unpackSpec.append("metaField", *metaField);
+        }
+        CollectionOptions viewOptions;
+        viewOptions.viewOn = bucketsNss.coll().toString();
+        viewOptions.pipeline = BSON_ARRAY(
+            BSON(DocumentSourceInternalUnpackBucket::kStageName << unpackSpec.obj()));
+        viewOptions.collation = collectionOptions.collation;
+        status = db->userCreateNS(opCtx, nss, viewOptions, true, BSONObj());
+        if (!status.isOK()) {
+            return status;
+        }
+        wunit.commit();
+
+        return Status::OK();
+    });
+}
+
 /**
  * Shared part of the implementation of the createCollection versions for replicated and regular
  * collection creation.
@@ -211,6 +324,14 @@ Status createCollection(OperationContext* opCtx,
                                  "transaction.",
                 !opCtx->inMultiDocumentTransaction());
         return _createView(opCtx, nss, collectionOptions, idIndex);
+    } else if (collectionOptions.timeseries && !nss.isTimeseriesBucketsCollection()) {
+        // The buckets collection itself is created with the options of its time-series
+        // collection, e.g. when the creation of the time-series collection is replicated.
+        uassert(ErrorCodes::OperationNotSupportedInTransaction,
+                str::stream() << "Cannot create a time-series collection in a multi-document "
+                                 "transaction.",
+                !opCtx->inMultiDocumentTransaction());
+        return _createTimeseries(opCtx, nss, collectionOptions);
     } else {
         uassert(ErrorCodes::OperationNotSupportedInTransaction,
                 str::stream() << "Cannot create system collection " << nss.toString()
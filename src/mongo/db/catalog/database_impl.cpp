@@ -338,7 +338,8 @@ Status DatabaseImpl::dropCollection(OperationContext* opCtx,
                               "turn off profiling before dropping system.profile collection");
         } else if (!(nss.isSystemDotViews() || nss.isHealthlog() ||
                      nss == NamespaceString::kLogicalSessionsNamespace ||
-                     nss == NamespaceString::kSystemKeysNamespace)) {
+                     nss == NamespaceString::kSystemKeysNamespace ||
+                     nss.isMaterializedViewCollection() || nss.isTimeseriesBucketsCollection())) {
             return Status(ErrorCodes::IllegalOperation,
                           str::stream() << "can't drop system collection " << nss);
         }
@@ -607,8 +608,12 @@ Status DatabaseImpl::createView(OperationContext* opCtx,
         return Status(ErrorCodes::InvalidNamespace,
                       str::stream() << "invalid namespace name for a view: " + viewName.toString());
 
-    return ViewCatalog::get(this)->createView(
-        opCtx, viewName, viewOnNss, BSONArray(options.pipeline), options.collation);
+    return ViewCatalog::get(this)->createView(opCtx,
+                                              viewName,
+                                              viewOnNss,
+                                              BSONArray(options.pipeline),
+                                              options.collation,
+                                              options.materialized);
 }
 
 Collection* DatabaseImpl::createCollection(OperationContext* opCtx,
@@ -44,6 +44,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
@@ -53,6 +54,18 @@ namespace mongo {
 MONGO_FAIL_POINT_DEFINE(hangDropCollectionBeforeLockAcquisition);
 MONGO_FAIL_POINT_DEFINE(hangDuringDropCollection);
 
+/**
+ * Forgets the open buckets of the time-series buckets collection 'nss' once its drop commits.
+ */
+void clearBucketCatalogOnCommit(OperationContext* opCtx, const NamespaceString& nss) {
+    if (nss.isTimeseriesBucketsCollection()) {
+        opCtx->recoveryUnit()->onCommit(
+            [svcCtx = opCtx->getServiceContext(), nss](boost::optional<Timestamp>) {
+                BucketCatalog::get(svcCtx).clear(nss);
+            });
+    }
+}
+
 Status _checkNssAndReplState(OperationContext* opCtx, const Collection* coll) {
     if (!coll) {
         return Status(ErrorCodes::NamespaceNotFound, "ns not found");
@@ -84,6 +97,18 @@ Status _dropView(OperationContext* opCtx,
     ViewCatalog::get(db)->lookup(opCtx, collectionName.ns());
 
     Lock::CollectionLock collLock(opCtx, collectionName, MODE_IX);
+    // The results of a materialized view are dropped along with it.
+    boost::optional<Lock::CollectionLock> materializedLock;
+    if (view->materialized()) {
+        materializedLock.emplace(opCtx, view->materializedNss(), MODE_X);
+    }
+    // So are the buckets of a time-series collection.
+    const auto bucketsNss = collectionName.makeTimeseriesBucketsNamespace();
+    const bool isTimeseries = view->viewOn() == bucketsNss;
+    boost::optional<Lock::CollectionLock> bucketsLock;
+    if (isTimeseries) {
+        bucketsLock.emplace(opCtx, bucketsNss, MODE_X);
+    }
     // Operations all lock system.views in the end to prevent deadlock.
     Lock::CollectionLock systemViewsLock(opCtx, db->getSystemViewsName(), MODE_X);
 
@@ -112,6 +137,28 @@ Status _dropView(OperationContext* opCtx,
     if (!status.isOK()) {
         return status;
     }
+    // Secondaries replicate the drop of the results of a materialized view, and of the buckets of a
+    // time-series collection.
+    if (view->materialized() && opCtx->writesAreReplicated() &&
+        CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx,
+                                                                  view->materializedNss())) {
+        status = db->dropCollection(opCtx, view->materializedNss());
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    if (isTimeseries && opCtx->writesAreReplicated()) {
+        if (auto buckets =
+                CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, bucketsNss)) {
+            IndexBuildsCoordinator::get(opCtx)->assertNoIndexBuildInProgForCollection(
+                buckets->uuid());
+            status = db->dropCollection(opCtx, bucketsNss);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        clearBucketCatalogOnCommit(opCtx, bucketsNss);
+    }
     wunit.commit();
 
     result.append("ns", collectionName.ns());
@@ -222,6 +269,7 @@ Status _abortIndexBuildsAndDropCollection(OperationContext* opCtx,
     if (!status.isOK()) {
         return status;
     }
+    clearBucketCatalogOnCommit(opCtx, resolvedNss);
     wunit.commit();
 
     result.append("nIndexesWas", numIndexes);
@@ -270,6 +318,7 @@ Status _dropCollection(OperationContext* opCtx,
     if (!status.isOK()) {
         return status;
     }
+    clearBucketCatalogOnCommit(opCtx, collectionName);
     wunit.commit();
 
     result.append("nIndexesWas", numIndexes);
@@ -276,6 +276,12 @@ Status IndexBuildsManager::drainBackgroundWrites(
     return builder->drainBackgroundWrites(opCtx, readSource, drainYieldPolicy);
 }
 
+int64_t IndexBuildsManager::getNumPendingBackgroundWrites(OperationContext* opCtx,
+                                                          const UUID& buildUUID) {
+    auto builder = invariant(_getBuilder(buildUUID));
+    return builder->getNumPendingBackgroundWrites(opCtx);
+}
+
 Status IndexBuildsManager::retrySkippedRecords(OperationContext* opCtx,
                                                const UUID& buildUUID,
                                                const Collection* collection) {
@@ -123,6 +123,11 @@ public:
                                  RecoveryUnit::ReadSource readSource,
                                  IndexBuildInterceptor::DrainYieldPolicy drainYieldPolicy);
 
+    /**
+     * Returns the number of side writes which drainBackgroundWrites() would have left to drain.
+     */
+    int64_t getNumPendingBackgroundWrites(OperationContext* opCtx, const UUID& buildUUID);
+
     /**
      * Retries the key generation and insertion of records that were skipped during the scanning
      * phase due to error suppression.
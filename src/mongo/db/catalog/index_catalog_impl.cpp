@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "mongo/base/init.h"
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/audit.h"
@@ -727,6 +728,11 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
     }
 
     if (IndexDescriptor::isIdIndexPattern(key)) {
+        if (_collection->isClustered()) {
+            return Status(ErrorCodes::CannotCreateIndex,
+                          "a clustered collection cannot have a separate _id index");
+        }
+
         BSONElement uniqueElt = spec["unique"];
         if (uniqueElt && !uniqueElt.trueValue()) {
             return Status(ErrorCodes::CannotCreateIndex, "_id index cannot be non-unique");
@@ -1392,8 +1398,31 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
-    for (auto bsonRecord : bsonRecords) {
+    std::vector<const BSONObj*> docs;
+    std::vector<RecordId> ids;
+    docs.reserve(bsonRecords.size());
+    ids.reserve(bsonRecords.size());
+    for (const auto& bsonRecord : bsonRecords) {
         invariant(bsonRecord.id != RecordId());
+        docs.push_back(bsonRecord.docPtr);
+        ids.push_back(bsonRecord.id);
+    }
+
+    // Generate the keys of the whole batch up front into the pooled buffer. They are inserted one
+    // record at a time below, as each record's keys must carry that record's timestamp.
+    IndexAccessMethod::BatchedKeys batch;
+    index->accessMethod()->getKeysForBatch(executionCtx.pooledBufferBuilder(),
+                                           docs,
+                                           ids,
+                                           options.getKeysMode,
+                                           IndexAccessMethod::GetKeysContext::kAddingKeys,
+                                           &batch,
+                                           IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+    size_t keysBegin = 0;
+    size_t multikeyMetadataKeysBegin = 0;
+    for (size_t i = 0; i < bsonRecords.size(); ++i) {
+        const auto& bsonRecord = bsonRecords[i];
 
         if (!bsonRecord.ts.isNull()) {
             Status status = opCtx->recoveryUnit()->setTimestamp(bsonRecord.ts);
@@ -1403,24 +1432,23 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
 
         auto keys = executionCtx.keys();
         auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
-        auto multikeyPaths = executionCtx.multikeyPaths();
-
-        index->accessMethod()->getKeys(executionCtx.pooledBufferBuilder(),
-                                       *bsonRecord.docPtr,
-                                       options.getKeysMode,
-                                       IndexAccessMethod::GetKeysContext::kAddingKeys,
-                                       keys.get(),
-                                       multikeyMetadataKeys.get(),
-                                       multikeyPaths.get(),
-                                       bsonRecord.id,
-                                       IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        keys->insert(boost::container::ordered_unique_range,
+                     batch.keys.begin() + keysBegin,
+                     batch.keys.begin() + batch.keyEnds[i]);
+        keysBegin = batch.keyEnds[i];
+        multikeyMetadataKeys->insert(
+            boost::container::ordered_unique_range,
+            batch.multikeyMetadataKeys.begin() + multikeyMetadataKeysBegin,
+            batch.multikeyMetadataKeys.begin() + batch.multikeyMetadataKeyEnds[i]);
+        multikeyMetadataKeysBegin = batch.multikeyMetadataKeyEnds[i];
 
         Status status = _indexKeys(opCtx,
                                    coll,
                                    index,
                                    *keys,
                                    *multikeyMetadataKeys,
-                                   *multikeyPaths,
+                                   batch.multikeyPaths[i],
                                    *bsonRecord.docPtr,
                                    bsonRecord.id,
                                    options,
@@ -1604,6 +1632,18 @@ Status IndexCatalogImpl::indexRecords(OperationContext* opCtx,
         *keysInsertedOut = 0;
     }
 
+    // With several indexes, each document's fields are looked up once per index. Let them share a
+    // field name lookup table per document instead of each scanning the document from the start.
+    boost::optional<BSONFieldIndexScope> fieldIndexScope;
+    if (_readyIndexes.size() + _buildingIndexes.size() > 1) {
+        std::vector<const BSONObj*> docs;
+        docs.reserve(bsonRecords.size());
+        for (const auto& bsonRecord : bsonRecords) {
+            docs.push_back(bsonRecord.docPtr);
+        }
+        fieldIndexScope.emplace(docs);
+    }
+
     for (auto&& it : _readyIndexes) {
         Status s = _indexRecords(opCtx, coll, it.get(), bsonRecords, keysInsertedOut);
         if (!s.isOK())
@@ -45,6 +45,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
@@ -56,6 +57,7 @@
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/quick_exit.h"
@@ -246,9 +248,9 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
         indexInfoObjs.reserve(indexSpecs.size());
         std::size_t eachIndexBuildMaxMemoryUsageBytes = 0;
         if (!indexSpecs.empty()) {
-            eachIndexBuildMaxMemoryUsageBytes =
-                static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
-                indexSpecs.size();
+            const std::size_t maxMemoryUsageBytes = _maxMemoryUsageBytes.value_or(
+                static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024);
+            eachIndexBuildMaxMemoryUsageBytes = maxMemoryUsageBytes / indexSpecs.size();
         }
 
         for (size_t i = 0; i < indexSpecs.size(); i++) {
@@ -314,7 +316,10 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
             if (!status.isOK())
                 return status;
 
-            index.bulk = index.real->initiateBulk(eachIndexBuildMaxMemoryUsageBytes, stateInfo);
+            index.bulk = index.real->initiateBulk(
+                eachIndexBuildMaxMemoryUsageBytes,
+                static_cast<std::size_t>(maxIndexBuildSortThreads.load()),
+                stateInfo);
 
             const IndexDescriptor* descriptor = indexCatalogEntry->descriptor();
 
@@ -456,6 +461,33 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
     bool readOnce = useReadOnceCursorsForIndexBuilds.load();
     opCtx->recoveryUnit()->setReadOnce(readOnce);
 
+    // When key generation is spread across threads, the scanned documents are buffered into
+    // batches whose keys are generated on a pool owned by this collection scan. The scan itself
+    // stays on this thread, on the index build's snapshot.
+    const size_t numKeyGenerationThreads = _getNumKeyGenerationThreads(opCtx, collection);
+    std::unique_ptr<ThreadPool> keyGenerationPool;
+    if (numKeyGenerationThreads > 1) {
+        ThreadPool::Options options;
+        options.threadNamePrefix = "IndexBuildKeyGen-";
+        options.minThreads = 0;
+        options.maxThreads = numKeyGenerationThreads - 1;
+        keyGenerationPool = std::make_unique<ThreadPool>(std::move(options));
+        keyGenerationPool->startup();
+    }
+    ON_BLOCK_EXIT([&] {
+        if (keyGenerationPool) {
+            keyGenerationPool->shutdown();
+            keyGenerationPool->join();
+        }
+    });
+
+    // Documents are only inserted once their batch is, so '_lastRecordIdInserted' never moves past
+    // a buffered document and a resumed build scans it again.
+    const size_t kMaxBatchDocs = 1024 * numKeyGenerationThreads;
+    const size_t kMaxBatchBytes = 16 * 1024 * 1024;
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+
     try {
         // The phase will be kCollectionScan when resuming an index build from the collection scan
         // phase.
@@ -486,7 +518,21 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
 
             // The external sorter is not part of the storage engine and therefore does not need a
             // WriteUnitOfWork to write keys.
-            uassertStatusOK(insertSingleDocumentForInitialSyncOrRecovery(opCtx, objToIndex, loc));
+            if (keyGenerationPool) {
+                // The document must be owned because the collection scan may yield before the
+                // batch is inserted.
+                batchBytes += objToIndex.objsize();
+                batch.emplace_back(objToIndex.getOwned(), loc);
+                if (batch.size() >= kMaxBatchDocs || batchBytes >= kMaxBatchBytes) {
+                    uassertStatusOK(_insertBatch(
+                        opCtx, batch, keyGenerationPool.get(), numKeyGenerationThreads));
+                    batch.clear();
+                    batchBytes = 0;
+                }
+            } else {
+                uassertStatusOK(
+                    insertSingleDocumentForInitialSyncOrRecovery(opCtx, objToIndex, loc));
+            }
 
             failPointHangDuringBuild(opCtx,
                                      &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
@@ -499,6 +545,11 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
             progress->hit();
             n++;
         }
+
+        if (!batch.empty()) {
+            uassertStatusOK(
+                _insertBatch(opCtx, batch, keyGenerationPool.get(), numKeyGenerationThreads));
+        }
     } catch (DBException& ex) {
         if (ex.isA<ErrorCategory::Interruption>() || ex.isA<ErrorCategory::ShutdownError>()) {
             // If the collection scan is stopped because due to an interrupt or shutdown event, we
@@ -569,6 +620,63 @@ Status MultiIndexBlock::insertAllDocumentsInCollection(
     return Status::OK();
 }
 
+size_t MultiIndexBlock::_getNumKeyGenerationThreads(OperationContext* opCtx,
+                                                    const Collection* collection) const {
+    const size_t numThreads = static_cast<size_t>(maxIndexBuildKeyGenerationThreads.load());
+    if (numThreads <= 1) {
+        return 1;
+    }
+
+    // Only btree and hashed key generation is known to be safe to run concurrently on one index.
+    for (const auto& index : _indexes) {
+        const auto& accessMethodName =
+            index.block->getEntry(opCtx, collection)->descriptor()->getAccessMethodName();
+        if (accessMethodName != IndexNames::BTREE && accessMethodName != IndexNames::HASHED) {
+            return 1;
+        }
+    }
+    return numThreads;
+}
+
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     const std::vector<std::pair<BSONObj, RecordId>>& batch,
+                                     ThreadPoolInterface* executor,
+                                     size_t numThreads) {
+    invariant(!_buildIsCleanedUp);
+    invariant(!batch.empty());
+
+    std::vector<std::pair<BSONObj, RecordId>> filteredBatch;
+    for (auto& index : _indexes) {
+        const auto* docs = &batch;
+        if (index.filterExpression) {
+            filteredBatch.clear();
+            std::copy_if(batch.begin(),
+                         batch.end(),
+                         std::back_inserter(filteredBatch),
+                         [&](const auto& doc) {
+                             return index.filterExpression->matchesBSON(doc.first);
+                         });
+            docs = &filteredBatch;
+        }
+
+        // When calling insertBatch, BulkBuilderImpl's Sorter performs file I/O that may result in
+        // an exception.
+        Status idxStatus = Status::OK();
+        try {
+            idxStatus = index.bulk->insertBatch(opCtx, *docs, index.options, executor, numThreads);
+        } catch (...) {
+            return exceptionToStatus();
+        }
+
+        if (!idxStatus.isOK())
+            return idxStatus;
+    }
+
+    _lastRecordIdInserted = batch.back().second;
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(OperationContext* opCtx,
                                                                      const BSONObj& doc,
                                                                      const RecordId& loc) {
@@ -711,6 +819,20 @@ Status MultiIndexBlock::drainBackgroundWrites(
     return Status::OK();
 }
 
+int64_t MultiIndexBlock::getNumPendingBackgroundWrites(OperationContext* opCtx) const {
+    invariant(!_buildIsCleanedUp);
+    const Collection* coll =
+        CollectionCatalog::get(opCtx).lookupCollectionByUUID(opCtx, _collectionUUID.get());
+
+    int64_t numPending = 0;
+    for (auto&& index : _indexes) {
+        if (auto interceptor = index.block->getEntry(opCtx, coll)->indexBuildInterceptor()) {
+            numPending += interceptor->getNumPendingWrites();
+        }
+    }
+    return numPending;
+}
+
 Status MultiIndexBlock::retrySkippedRecords(OperationContext* opCtx, const Collection* collection) {
     invariant(!_buildIsCleanedUp);
     for (auto&& index : _indexes) {
@@ -89,6 +89,15 @@ public:
      */
     void ignoreUniqueConstraint();
 
+    /**
+     * Limits the memory the index builds of this block may use to sort their keys to 'bytes' in
+     * total, in place of the maxIndexBuildMemoryUsageMegabytes server parameter. Must be called
+     * before init().
+     */
+    void setMaxMemoryUsageBytes(std::size_t bytes) {
+        _maxMemoryUsageBytes = bytes;
+    }
+
     /**
      * Sets an index build UUID associated with the indexes for this builder. This call is required
      * for two-phase index builds.
@@ -197,6 +206,11 @@ public:
                                  RecoveryUnit::ReadSource readSource,
                                  IndexBuildInterceptor::DrainYieldPolicy drainYieldPolicy);
 
+    /**
+     * Returns the number of background writes, across all indexes, which a call to
+     * drainBackgroundWrites() would have left to drain.
+     */
+    int64_t getNumPendingBackgroundWrites(OperationContext* opCtx) const;
 
     /**
      * Retries key generation and insertion for all records skipped during the collection scanning
@@ -329,6 +343,22 @@ private:
 
     BSONObj _constructStateObject(OperationContext* opCtx, const Collection* collection) const;
 
+    /**
+     * Returns the number of threads the collection scan phase may use to generate keys, which is
+     * one unless every index being built is a btree or hashed index.
+     */
+    size_t _getNumKeyGenerationThreads(OperationContext* opCtx,
+                                       const Collection* collection) const;
+
+    /**
+     * Inserts a batch of documents read by the collection scan into the indexes, generating their
+     * keys on up to 'numThreads' threads using 'executor'.
+     */
+    Status _insertBatch(OperationContext* opCtx,
+                        const std::vector<std::pair<BSONObj, RecordId>>& batch,
+                        ThreadPoolInterface* executor,
+                        size_t numThreads);
+
 
     // Is set during init() and ensures subsequent function calls act on the same Collection.
     boost::optional<UUID> _collectionUUID;
@@ -339,6 +369,9 @@ private:
 
     bool _ignoreUnique = false;
 
+    // Overrides the maxIndexBuildMemoryUsageMegabytes server parameter when set.
+    boost::optional<std::size_t> _maxMemoryUsageBytes;
+
     // Set to true when no work remains to be done, the object can safely destruct without leaving
     // incorrect state set anywhere.
     bool _buildIsCleanedUp = true;
@@ -0,0 +1,215 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/database_holder_impl.h"
+#include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/index/index_access_method_factory_impl.h"
+#include "mongo/db/index_builds_coordinator_mongod.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/s/collection_sharding_state_factory_shard.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/control/storage_control.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kInsertBatchSize = 1000;
+
+/**
+ * A standalone catalog over the ephemeralForTest storage engine, set up the same way as
+ * ServiceContextMongoDTest, so that the benchmarks measure index build work rather than disk I/O.
+ * It is built by the first benchmark that needs it and torn down at exit.
+ */
+class IndexBuildBenchmarkEnvironment {
+public:
+    static IndexBuildBenchmarkEnvironment& get() {
+        static IndexBuildBenchmarkEnvironment env;
+        return env;
+    }
+
+private:
+    IndexBuildBenchmarkEnvironment() : _serviceContext(getGlobalServiceContext()) {
+        storageGlobalParams.engine = "ephemeralForTest";
+        storageGlobalParams.engineSetByUser = true;
+        storageGlobalParams.dbpath = _tempDir.path();
+        serverGlobalParams.enableMajorityReadConcern = false;
+
+        _serviceContext->setPeriodicRunner(makePeriodicRunner(_serviceContext));
+        _serviceContext->setOpObserver(std::make_unique<OpObserverRegistry>());
+        repl::ReplicationCoordinator::set(
+            _serviceContext,
+            std::make_unique<repl::ReplicationCoordinatorMock>(_serviceContext,
+                                                               repl::ReplSettings()));
+
+        auto client = _serviceContext->makeClient("multi_index_block_bm");
+        AlternativeClientRegion acr(client);
+        {
+            auto opCtx = cc().makeOperationContext();
+            initializeStorageEngine(opCtx.get(),
+                                    StorageEngineInitFlags::kAllowNoLockFile |
+                                        StorageEngineInitFlags::kSkipMetadataFile);
+        }
+        StorageControl::startStorageControls(_serviceContext, true /*forTestOnly*/);
+
+        DatabaseHolder::set(_serviceContext, std::make_unique<DatabaseHolderImpl>());
+        IndexAccessMethodFactory::set(_serviceContext,
+                                      std::make_unique<IndexAccessMethodFactoryImpl>());
+        Collection::Factory::set(_serviceContext, std::make_unique<CollectionImpl::FactoryImpl>());
+        IndexBuildsCoordinator::set(_serviceContext,
+                                    std::make_unique<IndexBuildsCoordinatorMongod>());
+        CollectionShardingStateFactory::set(
+            _serviceContext,
+            std::make_unique<CollectionShardingStateFactoryShard>(_serviceContext));
+        _serviceContext->getStorageEngine()->notifyStartupComplete();
+    }
+
+    ~IndexBuildBenchmarkEnvironment() {
+        auto client = _serviceContext->makeClient("multi_index_block_bm");
+        AlternativeClientRegion acr(client);
+        auto opCtx = cc().makeOperationContext();
+        IndexBuildsCoordinator::get(opCtx.get())->shutdown(opCtx.get());
+        {
+            Lock::GlobalLock lk(opCtx.get(), MODE_X);
+            DatabaseHolder::get(opCtx.get())->closeAll(opCtx.get());
+        }
+        opCtx.reset();
+        shutdownGlobalStorageEngineCleanly(_serviceContext);
+        CollectionShardingStateFactory::clear(_serviceContext);
+    }
+
+    ServiceContext* const _serviceContext;
+    unittest::TempDir _tempDir{"multi_index_block_bm"};
+};
+
+/**
+ * Creates 'nss' and fills it with 'numDocs' documents of the form {_id: i, a: <int>}, where 'a'
+ * either increases with _id or is random.
+ */
+void createAndFillCollection(OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             int numDocs,
+                             bool randomKeys) {
+    {
+        Lock::DBLock dbLock(opCtx, nss.db(), MODE_X);
+        auto db = DatabaseHolder::get(opCtx)->openDb(opCtx, nss.db());
+        WriteUnitOfWork wuow(opCtx);
+        invariant(db->createCollection(opCtx, nss));
+        wuow.commit();
+    }
+
+    PseudoRandom random(1);
+    AutoGetCollection coll(opCtx, nss, MODE_IX);
+    for (int i = 0; i < numDocs; i += kInsertBatchSize) {
+        std::vector<InsertStatement> inserts;
+        for (int j = i; j < std::min(i + kInsertBatchSize, numDocs); ++j) {
+            inserts.emplace_back(BSON("_id" << j << "a" << (randomKeys ? random.nextInt32() : j)));
+        }
+        WriteUnitOfWork wuow(opCtx);
+        uassertStatusOK(coll->insertDocuments(opCtx, inserts.begin(), inserts.end(), nullptr));
+        wuow.commit();
+    }
+}
+
+/**
+ * Builds an index on {a: 1} with MultiIndexBlock over a collection of state.range(0) documents,
+ * going through the same init, collection scan, bulk load and commit steps as a foreground index
+ * build. The index is dropped again, untimed, between iterations. state.range(1) is non-zero for
+ * random key order.
+ */
+void BM_MultiIndexBlockBuild(benchmark::State& state) {
+    IndexBuildBenchmarkEnvironment::get();
+    auto client = getGlobalServiceContext()->makeClient("multi_index_block_bm");
+    AlternativeClientRegion acr(client);
+    auto opCtx = cc().makeOperationContext();
+
+    const auto numDocs = state.range(0);
+    const bool randomKeys = state.range(1);
+    const NamespaceString nss("multi_index_block_bm",
+                              str::stream() << "coll_" << numDocs << (randomKeys ? "_random" : ""));
+    createAndFillCollection(opCtx.get(), nss, numDocs, randomKeys);
+
+    const auto spec = BSON("v" << 2 << "key" << BSON("a" << 1) << "name"
+                               << "a_1");
+    for (auto _ : state) {
+        AutoGetCollection autoColl(opCtx.get(), nss, MODE_X);
+        CollectionWriter coll(autoColl);
+
+        MultiIndexBlock indexer;
+        uassertStatusOK(
+            indexer.init(opCtx.get(), coll, spec, MultiIndexBlock::kNoopOnInitFn).getStatus());
+        uassertStatusOK(indexer.insertAllDocumentsInCollection(opCtx.get(), coll.get()));
+        uassertStatusOK(indexer.checkConstraints(opCtx.get(), coll.get()));
+        {
+            WriteUnitOfWork wuow(opCtx.get());
+            uassertStatusOK(indexer.commit(opCtx.get(),
+                                           coll.getWritableCollection(),
+                                           MultiIndexBlock::kNoopOnCreateEachFn,
+                                           MultiIndexBlock::kNoopOnCommitFn));
+            wuow.commit();
+        }
+
+        state.PauseTiming();
+        {
+            WriteUnitOfWork wuow(opCtx.get());
+            coll.getWritableCollection()->getIndexCatalog()->dropAllIndexes(
+                opCtx.get(), false /* includingIdIndex */);
+            wuow.commit();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs);
+}
+
+BENCHMARK(BM_MultiIndexBlockBuild)
+    ->Args({10 * 1000, 0})
+    ->Args({10 * 1000, 1})
+    ->Args({100 * 1000, 0})
+    ->Args({100 * 1000, 1})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
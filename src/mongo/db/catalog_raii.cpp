@@ -34,6 +34,8 @@
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/s/database_sharding_state.h"
+#include "mongo/db/storage/snapshot_helper.h"
+#include "mongo/db/storage/storage_options.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/util/fail_point.h"
 
@@ -192,6 +194,64 @@ Collection* AutoGetCollection::getWritableCollection(CollectionCatalog::Lifetime
     return _writableColl;
 }
 
+AutoGetCollectionLockFree::AutoGetCollectionLockFree(OperationContext* opCtx,
+                                                     const NamespaceStringOrUUID& nsOrUUID,
+                                                     AutoGetCollectionViewMode viewMode,
+                                                     Date_t deadline)
+    : _lockFreeReadsBlock(opCtx->lockState()),
+      _globalLock(opCtx, MODE_IS, deadline, Lock::InterruptBehavior::kThrow) {
+    if (auto& nss = nsOrUUID.nss()) {
+        uassert(ErrorCodes::InvalidNamespace,
+                str::stream() << "Namespace " << *nss << " is not a valid collection name",
+                nss->isValid());
+    }
+
+    // Without a collection lock, a concurrent create, drop, rename or metadata write may commit at
+    // any point. Retry until the catalog lookup and the storage snapshot were both obtained without
+    // an intervening catalog change, so that they describe the same state of the collection.
+    auto& catalog = CollectionCatalog::get(opCtx);
+    while (true) {
+        const auto catalogVersion = catalog.getCatalogVersion();
+        _resolvedNss = catalog.resolveNamespaceStringOrUUID(opCtx, nsOrUUID);
+        _coll = catalog.lookupCollectionByNamespaceForRead(opCtx, _resolvedNss);
+
+        // The ReadSource cannot change once the snapshot is open, so choose it up front.
+        if (auto newReadSource = SnapshotHelper::getNewReadSource(opCtx, _resolvedNss)) {
+            opCtx->recoveryUnit()->setTimestampReadSource(*newReadSource);
+        }
+        opCtx->recoveryUnit()->preallocateSnapshot();
+        if (catalog.getCatalogVersion() == catalogVersion) {
+            break;
+        }
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
+
+    setAutoGetCollectionWait.execute(
+        [&](const BSONObj& data) { sleepFor(Milliseconds(data["waitForMillis"].numberInt())); });
+
+    const auto dbName = _resolvedNss.db();
+    _db = DatabaseHolder::get(opCtx)->getDb(opCtx, dbName);
+    {
+        auto dss = DatabaseShardingState::get(opCtx, dbName);
+        auto dssLock = DatabaseShardingState::DSSLock::lockShared(opCtx, dss);
+        dss->checkDbVersion(opCtx, dssLock);
+    }
+
+    if (_coll || !_db) {
+        return;
+    }
+
+    _view = ViewCatalog::get(_db)->lookup(opCtx, _resolvedNss.ns());
+    uassert(ErrorCodes::CommandNotSupportedOnView,
+            str::stream() << "Namespace " << _resolvedNss.ns() << " is a view, not a collection",
+            !_view || viewMode == AutoGetCollectionViewMode::kViewsPermitted);
+}
+
+bool AutoGetCollectionLockFree::isEligible(OperationContext* opCtx) {
+    return !storageGlobalParams.disableLockFreeReads && !opCtx->inMultiDocumentTransaction() &&
+        !opCtx->lockState()->isLocked() && !opCtx->recoveryUnit()->inActiveTxn();
+}
+
 struct CollectionWriter::SharedImpl {
     SharedImpl(CollectionWriter* parent) : _parent(parent) {}
 
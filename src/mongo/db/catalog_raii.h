@@ -229,6 +229,78 @@ private:
     OperationContext* _opCtx = nullptr;
 };
 
+/**
+ * RAII-style class for reading a collection without taking database or collection locks. Only the
+ * global lock is acquired, in MODE_IS, which keeps the operation admitted and conflicting with
+ * replication state transitions and with closing the catalog.
+ *
+ * The Collection is looked up and the storage snapshot established in a loop until no catalog
+ * change was made in between, as observed through CollectionCatalog::getCatalogVersion. The
+ * returned Collection is kept alive for the lifetime of this object.
+ *
+ * NOTE: Throws NamespaceNotFound if the collection UUID cannot be resolved to a name.
+ */
+class AutoGetCollectionLockFree {
+    AutoGetCollectionLockFree(const AutoGetCollectionLockFree&) = delete;
+    AutoGetCollectionLockFree& operator=(const AutoGetCollectionLockFree&) = delete;
+
+public:
+    AutoGetCollectionLockFree(
+        OperationContext* opCtx,
+        const NamespaceStringOrUUID& nsOrUUID,
+        AutoGetCollectionViewMode viewMode = AutoGetCollectionViewMode::kViewsForbidden,
+        Date_t deadline = Date_t::max());
+
+    /**
+     * Returns whether the current operation may use this lock-free read path: lock-free reads must
+     * be enabled, and the operation must neither hold locks, nor have an open storage transaction,
+     * nor be part of a multi-document transaction.
+     */
+    static bool isEligible(OperationContext* opCtx);
+
+    explicit operator bool() const {
+        return static_cast<bool>(_coll);
+    }
+
+    /**
+     * Returns the database, or nullptr if it didn't exist.
+     */
+    Database* getDb() const {
+        return _db;
+    }
+
+    /**
+     * Returns nullptr if the collection didn't exist.
+     */
+    const Collection* getCollection() const {
+        return _coll.get();
+    }
+
+    /**
+     * Returns nullptr if the view didn't exist.
+     */
+    ViewDefinition* getView() const {
+        return _view.get();
+    }
+
+    /**
+     * Returns the resolved namespace of the collection or view.
+     */
+    const NamespaceString& getNss() const {
+        return _resolvedNss;
+    }
+
+private:
+    // Declared first so that the lock-free reads mode outlives the global lock.
+    LockFreeReadsBlock _lockFreeReadsBlock;
+    Lock::GlobalLock _globalLock;
+
+    NamespaceString _resolvedNss;
+    Database* _db = nullptr;
+    std::shared_ptr<const Collection> _coll;
+    std::shared_ptr<ViewDefinition> _view;
+};
+
 /**
  * RAII-style class to handle the lifetime of writable Collections.
  * It does not take any locks, concurrency needs to be handled separately using explicit locks or
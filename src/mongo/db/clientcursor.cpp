@@ -89,6 +89,7 @@ ClientCursor::ClientCursor(ClientCursorParams params,
       _originatingCommand(params.originatingCommandObj),
       _originatingPrivileges(std::move(params.originatingPrivileges)),
       _queryOptions(params.queryOptions),
+      _readOnce(params.readOnce),
       _exec(std::move(params.exec)),
       _operationUsingCursor(operationUsingCursor),
       _lastUseDate(now),
@@ -100,6 +100,8 @@ struct ClientCursorParams {
     const WriteConcernOptions writeConcernOptions;
     const repl::ReadConcernArgs readConcernArgs;
     int queryOptions = 0;
+    // Whether the storage-layer cursors opened by the getMores of this cursor are read once.
+    bool readOnce = false;
     BSONObj originatingCommandObj;
     PrivilegeVector originatingPrivileges;
 };
@@ -182,6 +184,10 @@ public:
         return _queryOptions & QueryOption_AwaitData;
     }
 
+    bool isReadOnce() const {
+        return _readOnce;
+    }
+
     /**
      * Returns the original command object which created this cursor.
      */
@@ -389,6 +395,9 @@ private:
     // See the QueryOptions enum in dbclientinterface.h.
     const int _queryOptions = 0;
 
+    // Whether the storage-layer cursors opened by the getMores of this cursor are read once.
+    const bool _readOnce = false;
+
     // Unused maxTime budget for this cursor.
     Microseconds _leftoverMaxTimeMicros = Microseconds::max();
 
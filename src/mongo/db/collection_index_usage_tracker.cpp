@@ -42,12 +42,13 @@
 
 namespace mongo {
 namespace {
-Counter64 collectionScansCounter;
-Counter64 collectionScansNonTailableCounter;
+// Bumped by every collection scan on every collection, so striped to avoid contention.
+StripedCounter64 collectionScansCounter;
+StripedCounter64 collectionScansNonTailableCounter;
 
-ServerStatusMetricField<Counter64> displayCollectionScans("queryExecutor.collectionScans.total",
-                                                          &collectionScansCounter);
-ServerStatusMetricField<Counter64> displayCollectionScansNonTailable(
+ServerStatusMetricField<StripedCounter64> displayCollectionScans(
+    "queryExecutor.collectionScans.total", &collectionScansCounter);
+ServerStatusMetricField<StripedCounter64> displayCollectionScansNonTailable(
     "queryExecutor.collectionScans.nonTailable", &collectionScansNonTailableCounter);
 }  // namespace
 
@@ -0,0 +1,192 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/ops/write_ops_gen.h"
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+constexpr long long kDefaultSampleSize = 10000;
+constexpr long long kMaxSampleSize = 1000 * 1000;
+constexpr long long kDefaultNumBuckets = 100;
+constexpr long long kMaxNumBuckets = 1000;
+
+long long parsePositiveOption(const BSONObj& cmdObj,
+                              StringData fieldName,
+                              long long defaultValue,
+                              long long maxValue) {
+    auto elem = cmdObj[fieldName];
+    if (elem.eoo()) {
+        return defaultValue;
+    }
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "'" << fieldName << "' must be a number between 1 and " << maxValue,
+            elem.isNumber() && elem.safeNumberLong() >= 1 && elem.safeNumberLong() <= maxValue);
+    return elem.safeNumberLong();
+}
+
+/**
+ * Builds the statistics of the btree indexes of 'collection' from a sample of 'sampleSize'
+ * documents, or from all of its documents if it doesn't hold more than that.
+ */
+CollectionIndexStatistics buildIndexStatistics(OperationContext* opCtx,
+                                               const Collection* collection,
+                                               long long sampleSize,
+                                               long long numBuckets) {
+    // Values under a collation compare differently than they do in the histograms, so skip the
+    // indexes which have one.
+    std::vector<IndexStatisticsBuilder> builders;
+    auto it = collection->getIndexCatalog()->getIndexIterator(opCtx, false);
+    while (it->more()) {
+        auto desc = it->next()->descriptor();
+        if (desc->getIndexType() == INDEX_BTREE && desc->collation().isEmpty()) {
+            builders.emplace_back(desc->indexName(), desc->keyPattern());
+        }
+    }
+
+    auto addDocument = [&](const BSONObj& doc) {
+        for (auto&& builder : builders) {
+            builder.addDocument(doc);
+        }
+    };
+
+    auto randomCursor = collection->numRecords(opCtx) > sampleSize
+        ? collection->getRecordStore()->getRandomCursor(opCtx)
+        : nullptr;
+    if (randomCursor) {
+        for (long long i = 0; i < sampleSize; ++i) {
+            auto record = randomCursor->next();
+            if (!record) {
+                break;
+            }
+            addDocument(record->data.toBson());
+        }
+    } else {
+        auto cursor = collection->getCursor(opCtx);
+        while (auto record = cursor->next()) {
+            addDocument(record->data.toBson());
+        }
+    }
+
+    CollectionIndexStatistics stats{collection->uuid()};
+    for (auto&& builder : builders) {
+        stats.indexes.push_back(builder.done(numBuckets));
+    }
+    return stats;
+}
+
+class CmdAnalyze : public BasicCommand {
+public:
+    CmdAnalyze() : BasicCommand("analyze") {}
+
+    std::string help() const override {
+        return "Builds histograms and distinct value sketches of the leading fields of the btree "
+               "indexes of a collection from a sample of its documents, and stores them in the "
+               "system.statistics collection of the database for the query planner.\n"
+               "{analyze: <collection>, sampleSize: <number>, numBuckets: <number>}";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return true;
+    }
+
+    bool maintenanceOk() const override {
+        return false;
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        ActionSet actions;
+        actions.addAction(ActionType::analyze);
+        out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        const auto sampleSize =
+            parsePositiveOption(cmdObj, "sampleSize", kDefaultSampleSize, kMaxSampleSize);
+        const auto numBuckets =
+            parsePositiveOption(cmdObj, "numBuckets", kDefaultNumBuckets, kMaxNumBuckets);
+
+        auto stats = [&] {
+            AutoGetCollectionForReadCommand autoColl(opCtx, nss);
+            auto collection = autoColl.getCollection();
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nss << " does not exist",
+                    collection);
+            return buildIndexStatistics(opCtx, collection, sampleSize, numBuckets);
+        }();
+
+        DBDirectClient client(opCtx);
+        auto response = client.runCommand([&] {
+            write_ops::Update updateOp(
+                NamespaceString(nss.db(), NamespaceString::kSystemDotStatisticsCollectionName));
+            write_ops::UpdateOpEntry updateEntry(
+                BSON("_id" << nss.coll()),
+                write_ops::UpdateModification::parseFromClassicUpdate(stats.toBSON(nss.coll())));
+            updateEntry.setUpsert(true);
+            updateOp.setUpdates({updateEntry});
+            return updateOp.serialize({});
+        }());
+        uassertStatusOK(getStatusFromWriteCommandReply(response->getCommandReply()));
+
+        BSONArrayBuilder indexesBuilder(result.subarrayStart("indexes"));
+        for (auto&& index : stats.indexes) {
+            indexesBuilder.append(BSON("name" << index.indexName << "sampledDocs"
+                                              << index.sampledDocs << "buckets"
+                                              << static_cast<int>(index.histogram.buckets().size())
+                                              << "distinctValues"
+                                              << index.distinctValues.estimate()));
+        }
+        indexesBuilder.done();
+        return true;
+    }
+} cmdAnalyze;
+
+}  // namespace
+}  // namespace mongo
@@ -399,6 +399,9 @@ private:
             return {ErrorCodes::NamespaceNotFound, "dbCheck collection no longer exists"};
         }
 
+        // Hint to the storage engine that the data read by this batch need not be cached.
+        opCtx->recoveryUnit()->setReadOnce(gUseReadOnceCursorsForDbCheck.load());
+
         boost::optional<DbCheckHasher> hasher;
         try {
             hasher.emplace(opCtx,
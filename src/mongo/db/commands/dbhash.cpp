@@ -41,7 +41,9 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/dbhash_gen.h"
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/namespace_string.h"
@@ -51,6 +53,8 @@
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
 #include "mongo/util/timer.h"
@@ -59,6 +63,196 @@ namespace mongo {
 
 namespace {
 
+// How long a helper thread of the dbHash command waits for the global lock. The command's thread
+// already holds the locks which protect the collections, so a helper which waits behind a
+// conflicting lock request gives up, and leaves the collections to the command's thread.
+constexpr Milliseconds kHelperLockTimeout{100};
+
+std::unique_ptr<ThreadPool> dbHashThreadPool;
+
+MONGO_INITIALIZER(DBHashThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "DBHash";
+    options.threadNamePrefix = "DBHash";
+    options.minThreads = 0;
+    options.maxThreads = 16;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    dbHashThreadPool = std::make_unique<ThreadPool>(options);
+    dbHashThreadPool->startup();
+
+    return Status::OK();
+}
+
+/**
+ * Hashes a list of collections on the thread of the dbHash command and on up to 'parallelism - 1'
+ * helper threads, which all take the next collection from the list until it is exhausted.
+ *
+ * The command's locks protect the collections until run() returns, which only happens once all of
+ * the helpers stopped. The helpers read from the same point in time as the command: either its
+ * read timestamp, or the latest data, which the command's locks keep from changing.
+ */
+class ParallelCollectionHasher {
+public:
+    using HashFn = std::function<std::string(OperationContext*, const Collection*)>;
+
+    ParallelCollectionHasher(std::vector<const Collection*> collections, HashFn hashFn)
+        : _collections(std::move(collections)),
+          _hashFn(std::move(hashFn)),
+          _hashes(_collections.size()) {}
+
+    /**
+     * Returns the hash of each collection, in the order of the list.
+     */
+    std::vector<std::string> run(OperationContext* opCtx, int parallelism) {
+        const auto readTimestamp = opCtx->recoveryUnit()->getTimestampReadSource() ==
+                RecoveryUnit::ReadSource::kProvided
+            ? opCtx->recoveryUnit()->getPointInTimeReadTimestamp()
+            : boost::none;
+        const auto prepareConflictBehavior = opCtx->recoveryUnit()->getPrepareConflictBehavior();
+        const auto deadline = opCtx->getDeadline();
+        const auto timeoutError = opCtx->getTimeoutError();
+
+        const auto numHelpers =
+            std::min(static_cast<size_t>(parallelism - 1), _collections.size() - 1);
+        for (size_t i = 0; i < numHelpers; ++i) {
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                ++_runningHelpers;
+            }
+            dbHashThreadPool->schedule([this,
+                                        readTimestamp,
+                                        prepareConflictBehavior,
+                                        deadline,
+                                        timeoutError](auto status) {
+                if (!status.isOK()) {
+                    _helperDone();
+                    return;
+                }
+                _runHelper(readTimestamp, prepareConflictBehavior, deadline, timeoutError);
+            });
+        }
+
+        // If the command is interrupted, interrupt the helpers too. Either way, wait for all of
+        // them to stop before returning.
+        try {
+            _hashAll(opCtx);
+            uassertStatusOK(opCtx->checkForInterruptNoAssert());
+
+            stdx::unique_lock<Latch> lk(_mutex);
+            opCtx->waitForConditionOrInterrupt(
+                _helpersDone, lk, [&] { return _runningHelpers == 0; });
+        } catch (const DBException& ex) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _recordError(lk, ex.toStatus());
+            _killCode = ex.code();
+            for (auto helperOpCtx : _helperOpCtxs) {
+                stdx::lock_guard<Client> clientLock(*helperOpCtx->getClient());
+                helperOpCtx->getServiceContext()->killOperation(
+                    clientLock, helperOpCtx, *_killCode);
+            }
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _helpersDone.wait(lk, [&] { return _runningHelpers == 0; });
+        uassertStatusOK(_error);
+        return std::move(_hashes);
+    }
+
+private:
+    void _runHelper(boost::optional<Timestamp> readTimestamp,
+                    PrepareConflictBehavior prepareConflictBehavior,
+                    Date_t deadline,
+                    ErrorCodes::Error timeoutError) {
+        ON_BLOCK_EXIT([&] { _helperDone(); });
+
+        auto opCtx = cc().makeOperationContext();
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_killCode) {
+                return;
+            }
+            _helperOpCtxs.push_back(opCtx.get());
+        }
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _helperOpCtxs.erase(
+                std::find(_helperOpCtxs.begin(), _helperOpCtxs.end(), opCtx.get()));
+        });
+
+        if (readTimestamp) {
+            opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                          readTimestamp);
+        }
+        opCtx->recoveryUnit()->setPrepareConflictBehavior(prepareConflictBehavior);
+        if (deadline != Date_t::max()) {
+            opCtx->setDeadlineByDate(deadline, timeoutError);
+        }
+
+        // Reading from the storage engine only needs the global lock. The command's locks already
+        // keep secondary batch application from running, and the command holds a ticket.
+        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWMBlock(opCtx->lockState());
+        opCtx->lockState()->skipAcquireTicket();
+        Lock::GlobalLock globalLock(opCtx.get(),
+                                    MODE_IS,
+                                    Date_t::now() + kHelperLockTimeout,
+                                    Lock::InterruptBehavior::kLeaveUnlocked);
+        if (!globalLock.isLocked()) {
+            return;
+        }
+
+        _hashAll(opCtx.get());
+    }
+
+    void _helperDone() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        --_runningHelpers;
+        _helpersDone.notify_all();
+    }
+
+    void _hashAll(OperationContext* opCtx) {
+        while (auto idx = _takeNext()) {
+            try {
+                auto hash = _hashFn(opCtx, _collections[*idx]);
+                stdx::lock_guard<Latch> lk(_mutex);
+                _hashes[*idx] = std::move(hash);
+            } catch (const DBException& ex) {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _recordError(lk, ex.toStatus());
+                return;
+            }
+        }
+    }
+
+    boost::optional<size_t> _takeNext() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_error.isOK() || _next == _collections.size()) {
+            return boost::none;
+        }
+        return _next++;
+    }
+
+    void _recordError(WithLock, Status status) {
+        // Keep the first error, rather than the interruptions it causes.
+        if (_error.isOK()) {
+            _error = std::move(status);
+        }
+    }
+
+    const std::vector<const Collection*> _collections;
+    const HashFn _hashFn;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ParallelCollectionHasher::_mutex");
+    stdx::condition_variable _helpersDone;
+
+    std::vector<std::string> _hashes;
+    size_t _next = 0;
+    Status _error = Status::OK();
+
+    size_t _runningHelpers = 0;
+    std::vector<OperationContext*> _helperOpCtxs;
+    boost::optional<ErrorCodes::Error> _killCode;
+};
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -230,6 +424,12 @@ public:
         std::map<std::string, OptionalCollectionUUID> collectionToUUIDMap;
         std::set<std::string> cappedCollectionSet;
 
+        // With more than one thread, the collections are hashed once they are all known, so keep
+        // them locked until then.
+        const int parallelism = gDbHashParallelism.load();
+        std::vector<const Collection*> collectionsToHash;
+        std::vector<Lock::CollectionLock> collectionLocks;
+
         bool noError = true;
         catalog::forEachCollectionFromDb(opCtx, dbname, MODE_IS, [&](const Collection* collection) {
             auto collNss = collection->ns();
@@ -266,8 +466,15 @@ public:
                 collectionToUUIDMap[collNss.coll().toString()] = uuid;
             }
 
+            _checkCanHashCollection(opCtx, db, collection);
+            if (parallelism > 1) {
+                collectionLocks.emplace_back(opCtx, collNss, MODE_IS);
+                collectionsToHash.push_back(collection);
+                return true;
+            }
+
             // Compute the hash for this collection.
-            std::string hash = _hashCollection(opCtx, db, collNss);
+            std::string hash = _hashCollection(opCtx, collection);
 
             collectionToHashMap[collNss.coll().toString()] = hash;
 
@@ -276,6 +483,18 @@ public:
         if (!noError)
             return false;
 
+        if (!collectionsToHash.empty()) {
+            ParallelCollectionHasher hasher(
+                collectionsToHash, [this](OperationContext* opCtx, const Collection* collection) {
+                    return _hashCollection(opCtx, collection);
+                });
+            auto hashes = hasher.run(opCtx, parallelism);
+            for (size_t i = 0; i < collectionsToHash.size(); ++i) {
+                collectionToHashMap[collectionsToHash[i]->ns().coll().toString()] =
+                    std::move(hashes[i]);
+            }
+        }
+
         BSONObjBuilder bb(result.subobjStart("collections"));
         BSONArrayBuilder cappedCollections;
         BSONObjBuilder collectionsByUUID;
@@ -313,13 +532,10 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
-
-        const Collection* collection =
-            CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, nss);
-        invariant(collection);
-
-        boost::optional<Lock::CollectionLock> collLock;
+    void _checkCanHashCollection(OperationContext* opCtx,
+                                 Database* db,
+                                 const Collection* collection) {
+        const auto& nss = collection->ns();
         if (opCtx->recoveryUnit()->getTimestampReadSource() ==
             RecoveryUnit::ReadSource::kProvided) {
             // When performing a read at a timestamp, we are only holding the database lock in
@@ -342,7 +558,10 @@ private:
         } else {
             invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_S));
         }
+    }
 
+    std::string _hashCollection(OperationContext* opCtx, const Collection* collection) {
+        const auto& nss = collection->ns();
         auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
@@ -48,6 +48,7 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/getmore_request.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -121,6 +122,31 @@ boost::intrusive_ptr<ExpressionContext> makeExpressionContext(
     return expCtx;
 }
 
+/**
+ * Returns the getMore command which is run on behalf of a client that allows exhaust, so that the
+ * batches following the first one of the cursor 'cursorId' are streamed to it without waiting for
+ * a request for each of them.
+ */
+BSONObj makeExhaustGetMore(OperationContext* opCtx,
+                           const NamespaceString& nss,
+                           CursorId cursorId,
+                           boost::optional<long long> batchSize) {
+    const auto getMoreBatchSize =
+        batchSize ? boost::optional<std::int64_t>(*batchSize) : boost::none;
+    BSONObjBuilder getMoreBob(
+        GetMoreRequest(nss, cursorId, getMoreBatchSize, boost::none, boost::none, boost::none)
+            .toBSON());
+
+    // The cursor may only be used from the session which created it.
+    if (auto lsid = opCtx->getLogicalSessionId()) {
+        BSONObjBuilder lsidBob(getMoreBob.subobjStart(OperationSessionInfo::kSessionIdFieldName));
+        lsid->serialize(&lsidBob);
+        lsidBob.doneFast();
+    }
+    getMoreBob.append("$db", nss.db());
+    return getMoreBob.obj();
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -381,6 +407,13 @@ public:
             const int ntoskip = -1;
             beginQueryOp(opCtx, nss, _request.body, ntoreturn, ntoskip);
 
+            // The reads of a collection with a low cache priority are read once, outside of a
+            // transaction, so that they don't evict the pages of the other collections.
+            if (ctx->getCollection() && ctx->getCollection()->getLowCachePriority() &&
+                !opCtx->inMultiDocumentTransaction()) {
+                qr->setReadOnce(true);
+            }
+
             // Finish the parsing step by using the QueryRequest to create a CanonicalQuery.
             const ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
             auto expCtx = makeExpressionContext(opCtx, *qr, boost::none /* verbosity */);
@@ -425,6 +458,12 @@ public:
             auto exec =
                 uassertStatusOK(getExecutorFind(opCtx, collection, std::move(cq), permitYield));
 
+            // A large collection scan is read once too. Its plan has not opened any cursors yet.
+            if (!opCtx->recoveryUnit()->getReadOnce() && !opCtx->inMultiDocumentTransaction() &&
+                isLargeUnindexedCollectionScan(opCtx, collection, *exec)) {
+                opCtx->recoveryUnit()->setReadOnce(true);
+            }
+
             {
                 stdx::lock_guard<Client> lk(*opCtx->getClient());
                 CurOp::get(opCtx)->setPlanSummary_inlock(exec->getPlanSummary());
@@ -451,6 +490,8 @@ public:
             if (!opCtx->inMultiDocumentTransaction()) {
                 options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
             }
+            result->reserveBytes(FindCommon::estimateFirstBatchBytes(
+                originalQR, collection->numRecords(opCtx), collection->averageObjectSize(opCtx)));
             CursorResponseBuilder firstBatch(result, options);
             BSONObj obj;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
@@ -488,18 +529,23 @@ public:
             }
 
             // Set up the cursor for getMore.
+            const auto batchSize = originalQR.getBatchSize();
+            const bool waitsForResults =
+                !originalQR.isTailable() || originalQR.isTailableAndAwaitData();
             CursorId cursorId = 0;
             if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
-                ClientCursorPin pinnedCursor = CursorManager::get(opCtx)->registerCursor(
-                    opCtx,
-                    {std::move(exec),
-                     nss,
-                     AuthorizationSession::get(opCtx->getClient())->getAuthenticatedUserNames(),
-                     APIParameters::get(opCtx),
-                     opCtx->getWriteConcern(),
-                     repl::ReadConcernArgs::get(opCtx),
-                     _request.body,
-                     {Privilege(ResourcePattern::forExactNamespace(nss), ActionType::find)}});
+                ClientCursorParams cursorParams(
+                    std::move(exec),
+                    nss,
+                    AuthorizationSession::get(opCtx->getClient())->getAuthenticatedUserNames(),
+                    APIParameters::get(opCtx),
+                    opCtx->getWriteConcern(),
+                    repl::ReadConcernArgs::get(opCtx),
+                    _request.body,
+                    {Privilege(ResourcePattern::forExactNamespace(nss), ActionType::find)});
+                cursorParams.readOnce = opCtx->recoveryUnit()->getReadOnce();
+                ClientCursorPin pinnedCursor =
+                    CursorManager::get(opCtx)->registerCursor(opCtx, std::move(cursorParams));
                 cursorId = pinnedCursor.getCursor()->cursorid();
 
                 invariant(!exec);
@@ -527,6 +573,16 @@ public:
 
             // Generate the response object to send to the client.
             firstBatch.done(cursorId, nss.ns());
+
+            // A client which allows exhaust is sent the remaining batches as a stream of getMore
+            // replies. The getMore requests of a transaction must carry its txnNumber, so cursors
+            // opened in one are iterated by the client as usual. So are tailable cursors which do
+            // not await data, whose stream would spin on empty batches.
+            if (cursorId && opCtx->isExhaust() && !opCtx->inMultiDocumentTransaction() &&
+                waitsForResults) {
+                CurOp::get(opCtx)->debug().exhaust = true;
+                result->setNextInvocation(makeExhaustGetMore(opCtx, nss, cursorId, batchSize));
+            }
         }
 
         void appendMirrorableRequest(BSONObjBuilder* bob) const override {
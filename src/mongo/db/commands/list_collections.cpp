@@ -149,6 +149,9 @@ BSONObj buildViewBson(const ViewDefinition& view, bool nameOnly) {
     BSONObjBuilder optionsBuilder(b.subobjStart("options"));
     optionsBuilder.append("viewOn", view.viewOn().coll());
     optionsBuilder.append("pipeline", view.pipeline());
+    if (view.materialized()) {
+        optionsBuilder.append("materialized", true);
+    }
     if (view.defaultCollator()) {
         optionsBuilder.append("collation", view.defaultCollator()->getSpec().toBSON());
     }
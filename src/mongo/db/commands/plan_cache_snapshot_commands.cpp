@@ -0,0 +1,392 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/client.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/plan_cache_commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_cache_snapshot.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner.h"
+#include "mongo/db/repl/replica_set_aware_service.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+
+PlanCache* getPlanCache(const Collection* collection) {
+    invariant(collection);
+    PlanCache* planCache = CollectionQueryInfo::get(collection).getPlanCache();
+    invariant(planCache);
+    return planCache;
+}
+
+/**
+ * Returns the documents recording the entries in the plan cache of 'nss' in the
+ * config.planCacheSnapshots collection. Each document is identified by the namespace and the plan
+ * cache key of the entry.
+ */
+std::vector<BSONObj> snapshotPlanCache(OperationContext* opCtx, const NamespaceString& nss) {
+    AutoGetCollectionForReadCommand ctx(opCtx, nss);
+    if (!ctx.getCollection()) {
+        return {};
+    }
+
+    std::vector<BSONObj> snapshots;
+    for (auto&& entry : getPlanCache(ctx.getCollection())->getAllEntries()) {
+        BSONObjBuilder bob;
+        bob.append("_id",
+                   BSON("ns" << nss.ns() << "planCacheKey" << zeroPaddedHex(entry->planCacheKey)));
+        bob.appendElements(plan_cache_snapshot::serializeEntry(*entry));
+        snapshots.push_back(bob.obj());
+    }
+    return snapshots;
+}
+
+/**
+ * Runs 'fn' with an operation context of its own, whose client is authorized to access the
+ * config.planCacheSnapshots collection, unlike the users of the plan cache commands in general.
+ */
+template <typename Fn>
+auto runWithInternalClient(OperationContext* opCtx, const std::string& name, Fn&& fn) {
+    auto client = opCtx->getServiceContext()->makeClient(name);
+    AuthorizationSession::get(client.get())->grantInternalAuthorization(client.get());
+    AlternativeClientRegion acr(client);
+    auto internalOpCtx = cc().makeOperationContext();
+    return fn(internalOpCtx.get());
+}
+
+/**
+ * Replaces the recorded plan cache entries of 'nss' with 'snapshots'.
+ */
+void writePlanCacheSnapshots(OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             const std::vector<BSONObj>& snapshots) {
+    DBDirectClient client(opCtx);
+
+    auto deleteResponse = client.runCommand([&] {
+        write_ops::Delete deleteOp(NamespaceString::kPlanCacheSnapshotsNamespace);
+        deleteOp.setDeletes({[&] {
+            write_ops::DeleteOpEntry entry;
+            entry.setQ(BSON("_id.ns" << nss.ns()));
+            entry.setMulti(true);
+            return entry;
+        }()});
+        return deleteOp.serialize({});
+    }());
+    uassertStatusOK(getStatusFromWriteCommandReply(deleteResponse->getCommandReply()));
+
+    if (snapshots.empty()) {
+        return;
+    }
+
+    auto insertResponse = client.runCommand([&] {
+        write_ops::Insert insertOp(NamespaceString::kPlanCacheSnapshotsNamespace);
+        insertOp.setDocuments(snapshots);
+        return insertOp.serialize({});
+    }());
+    uassertStatusOK(getStatusFromWriteCommandReply(insertResponse->getCommandReply()));
+}
+
+/**
+ * Returns the recorded plan cache entries of each namespace, or of 'nss' only if it is provided.
+ */
+std::map<NamespaceString, std::vector<BSONObj>> readPlanCacheSnapshots(
+    OperationContext* opCtx, const boost::optional<NamespaceString>& nss) {
+    DBDirectClient client(opCtx);
+    auto cursor = client.query(NamespaceString::kPlanCacheSnapshotsNamespace,
+                               nss ? BSON("_id.ns" << nss->ns()) : BSONObj());
+    uassert(5190206, "Failed to read the plan cache snapshots", cursor);
+
+    std::map<NamespaceString, std::vector<BSONObj>> snapshots;
+    while (cursor->more()) {
+        auto snapshot = cursor->nextSafe().getOwned();
+        auto ns = snapshot["_id"]["ns"];
+        if (ns.type() != BSONType::String) {
+            continue;
+        }
+        snapshots[NamespaceString{ns.valueStringData()}].push_back(std::move(snapshot));
+    }
+    return snapshots;
+}
+
+/**
+ * Installs the plan cache entry recorded by 'snapshot' in 'planCache', provided that its plan can
+ * still be built with the current indexes of 'collection'. Returns whether the entry was installed.
+ */
+StatusWith<bool> restorePlanCacheEntry(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       const Collection* collection,
+                                       PlanCache* planCache,
+                                       const BSONObj& snapshot) {
+    try {
+        auto cq = uassertStatusOK(plan_cache_commands::canonicalize(opCtx, nss.ns(), snapshot));
+
+        QueryPlannerParams plannerParams;
+        fillOutPlannerParams(opCtx, collection, cq.get(), &plannerParams);
+
+        auto works = snapshot["works"];
+        if (!works.isNumber() || works.safeNumberLong() < 0) {
+            return Status(ErrorCodes::BadValue, "field works must be a non-negative integer");
+        }
+        auto solution = snapshot["solution"];
+        if (solution.type() != BSONType::Object) {
+            return Status(ErrorCodes::BadValue, "field solution must be an object");
+        }
+
+        auto restored = planCache->restore(
+            *cq,
+            plan_cache_snapshot::parseSolution(solution.Obj(), plannerParams.indices),
+            works.safeNumberLong(),
+            snapshot["isActive"].trueValue(),
+            opCtx->getServiceContext()->getPreciseClockSource()->now());
+        if (!restored.isOK() || !restored.getValue()) {
+            return restored;
+        }
+
+        // Make sure that the planner can build the plan of the new entry, in case the query shape
+        // or the indexes it uses have changed in a way which the identifiers don't reflect.
+        auto entry = uassertStatusOK(planCache->getEntry(*cq));
+        auto soln = QueryPlanner::planFromCache(
+            *cq, plannerParams, CachedSolution(planCache->computeKey(*cq), *entry));
+        if (!soln.isOK()) {
+            planCache->remove(*cq).ignore();
+            return soln.getStatus();
+        }
+        return true;
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+}
+
+/**
+ * Seeds the plan cache of 'nss' with the entries recorded by 'snapshots'. Entries which no longer
+ * apply, e.g. because an index they use has been dropped, are skipped. Returns the number of
+ * entries installed.
+ */
+size_t restorePlanCache(OperationContext* opCtx,
+                        const NamespaceString& nss,
+                        const std::vector<BSONObj>& snapshots) {
+    AutoGetCollectionForRead ctx(opCtx, nss);
+    const Collection* collection = ctx.getCollection();
+    if (!collection) {
+        return 0;
+    }
+
+    auto planCache = getPlanCache(collection);
+    size_t numRestored = 0;
+    for (auto&& snapshot : snapshots) {
+        auto restored = restorePlanCacheEntry(opCtx, nss, collection, planCache, snapshot);
+        if (!restored.isOK()) {
+            LOGV2_DEBUG(5190207,
+                        1,
+                        "Skipping plan cache snapshot which cannot be restored",
+                        "namespace"_attr = nss,
+                        "snapshot"_attr = redact(snapshot),
+                        "error"_attr = restored.getStatus());
+            continue;
+        }
+        numRestored += restored.getValue();
+    }
+    return numRestored;
+}
+
+/**
+ * Warms up the plan caches with the recorded entries when the node steps up, so that a new primary
+ * doesn't have to plan every query shape the old one had cached once it takes over the workload.
+ */
+class PlanCacheWarmer final : public ReplicaSetAwareService<PlanCacheWarmer> {
+public:
+    static PlanCacheWarmer* get(ServiceContext* serviceContext);
+
+private:
+    void onStartup(OperationContext* opCtx) final {}
+    void onShutdown() final {}
+    void onStepUpBegin(OperationContext* opCtx, long long term) final;
+    void onStepUpComplete(OperationContext* opCtx, long long term) final {}
+    void onStepDown() final {}
+    void onBecomeArbiter() final {}
+};
+
+const auto planCacheWarmerDecoration = ServiceContext::declareDecoration<PlanCacheWarmer>();
+
+const ReplicaSetAwareServiceRegistry::Registerer<PlanCacheWarmer> planCacheWarmerRegisterer(
+    "PlanCacheWarmer");
+
+PlanCacheWarmer* PlanCacheWarmer::get(ServiceContext* serviceContext) {
+    return &planCacheWarmerDecoration(serviceContext);
+}
+
+void PlanCacheWarmer::onStepUpBegin(OperationContext* opCtx, long long term) {
+    if (!internalQueryPlanCacheRestoreOnStepUp.load()) {
+        return;
+    }
+
+    try {
+        size_t numRestored = 0;
+        for (auto&& [nss, snapshots] : readPlanCacheSnapshots(opCtx, boost::none)) {
+            numRestored += restorePlanCache(opCtx, nss, snapshots);
+        }
+        LOGV2(5190208, "Restored plan cache entries on step-up", "numRestored"_attr = numRestored);
+    } catch (const DBException& ex) {
+        // A cold plan cache only costs planning time, so the failure must not prevent step-up.
+        LOGV2_WARNING(5190209,
+                      "Failed to restore plan cache entries on step-up",
+                      "error"_attr = redact(ex.toStatus()));
+    }
+}
+
+Status checkAuthForPlanCacheWrite(Client* client,
+                                  const std::string& dbname,
+                                  const BSONObj& cmdObj,
+                                  const BasicCommand& command) {
+    AuthorizationSession* authzSession = AuthorizationSession::get(client);
+    ResourcePattern pattern = command.parseResourcePattern(dbname, cmdObj);
+
+    if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+        return Status::OK();
+    }
+
+    return Status(ErrorCodes::Unauthorized, "unauthorized");
+}
+
+}  // namespace
+
+/**
+ * The 'planCacheSnapshot' command records the entries in the plan cache of a collection in the
+ * config.planCacheSnapshots collection, replacing the ones recorded before:
+ *
+ *    {
+ *        planCacheSnapshot: <collection>
+ *    }
+ *
+ * Since the collection is replicated, the secondaries can seed their plan caches with the entries
+ * when they step up, or when they run the 'planCacheRestore' command.
+ */
+class PlanCacheSnapshotCommand final : public BasicCommand {
+public:
+    PlanCacheSnapshotCommand() : BasicCommand("planCacheSnapshot") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        const auto snapshots = snapshotPlanCache(opCtx, nss);
+        runWithInternalClient(opCtx, "planCacheSnapshot", [&](OperationContext* internalOpCtx) {
+            writePlanCacheSnapshots(internalOpCtx, nss, snapshots);
+        });
+        result.appendNumber("numEntries", static_cast<long long>(snapshots.size()));
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        return checkAuthForPlanCacheWrite(client, dbname, cmdObj, *this);
+    }
+
+    std::string help() const override {
+        return "Records the plan cache entries of a collection, so that they can be restored.";
+    }
+} planCacheSnapshotCommand;
+
+/**
+ * The 'planCacheRestore' command seeds the plan cache of a collection with the entries recorded by
+ * the 'planCacheSnapshot' command. Entries for query shapes which are in the plan cache already are
+ * left as they are.
+ *
+ *    {
+ *        planCacheRestore: <collection>
+ *    }
+ */
+class PlanCacheRestoreCommand final : public BasicCommand {
+public:
+    PlanCacheRestoreCommand() : BasicCommand("planCacheRestore") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+        auto snapshots =
+            runWithInternalClient(opCtx, "planCacheRestore", [&](OperationContext* internalOpCtx) {
+                return readPlanCacheSnapshots(internalOpCtx, nss);
+            });
+        const auto numRestored = restorePlanCache(opCtx, nss, snapshots[nss]);
+        result.appendNumber("numRestored", static_cast<long long>(numRestored));
+        return true;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        return checkAuthForPlanCacheWrite(client, dbname, cmdObj, *this);
+    }
+
+    std::string help() const override {
+        return "Seeds the plan cache of a collection with the entries recorded for it.";
+    }
+} planCacheRestoreCommand;
+
+}  // namespace mongo
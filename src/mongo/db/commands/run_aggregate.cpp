@@ -49,6 +49,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_parallel_exchange.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/pipeline.h"
@@ -58,10 +59,12 @@
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/cursor_response.h"
+#include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -423,6 +426,26 @@ void _adjustChangeStreamReadConcern(OperationContext* opCtx) {
         opCtx, readConcernArgs, PrepareConflictBehavior::kIgnoreConflicts);
 }
 
+/**
+ * Spreads a $group over the documents of the collection over several threads, if the knob allows
+ * it and nothing about the aggregation requires it to run on a single thread. See
+ * DocumentSourceParallelExchange::parallelizeGroup() for the pipelines which are eligible.
+ */
+std::unique_ptr<Pipeline, PipelineDeleter> parallelizeGroupIfPossible(
+    OperationContext* opCtx,
+    const AggregationRequest& request,
+    const LiteParsedPipeline& liteParsedPipeline,
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
+    const auto numWorkers = internalDocumentSourceGroupParallelWorkers.load();
+    const auto& expCtx = pipeline->getContext();
+    if (numWorkers <= 1 || request.getExchangeSpec() || expCtx->explain || expCtx->needsMerge ||
+        expCtx->tailableMode != TailableModeEnum::kNormal || opCtx->inMultiDocumentTransaction() ||
+        liteParsedPipeline.hasChangeStream()) {
+        return pipeline;
+    }
+    return DocumentSourceParallelExchange::parallelizeGroup(std::move(pipeline), numWorkers);
+}
+
 /**
  * If the aggregation 'request' contains an exchange specification, create a new pipeline for each
  * consumer and put it into the resulting vector. Otherwise, return the original 'pipeline' as a
@@ -505,6 +528,9 @@ Status runAggregate(OperationContext* opCtx,
         if (opCtx->inMultiDocumentTransaction()) {
             liteParsedPipeline.assertSupportsMultiDocumentTransaction(request.getExplain());
         }
+        uassert(ErrorCodes::OperationNotSupportedInTransaction,
+                "The 'readOnce' option is not supported within a transaction.",
+                !opCtx->inMultiDocumentTransaction() || !request.isReadOnce());
 
         const auto& pipelineInvolvedNamespaces = liteParsedPipeline.getInvolvedNamespaces();
 
@@ -646,6 +672,16 @@ Status runAggregate(OperationContext* opCtx,
         auto hasGeoNearStage = !pipeline->getSources().empty() &&
             dynamic_cast<DocumentSourceGeoNear*>(pipeline->peekFront());
 
+        // The readOnce option causes any storage-layer cursors created during plan execution to
+        // assume read data will not be needed again and need not be cached. The reads of a
+        // collection with a low cache priority are read once as well, outside of a transaction, so
+        // that they don't evict the pages of the other collections.
+        if (request.isReadOnce() ||
+            (collection && collection->getLowCachePriority() &&
+             !opCtx->inMultiDocumentTransaction())) {
+            opCtx->recoveryUnit()->setReadOnce(true);
+        }
+
         // Prepare a PlanExecutor to provide input into the pipeline, if needed.
         std::pair<PipelineD::AttachExecutorCallback,
                   std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
@@ -662,6 +698,13 @@ Status runAggregate(OperationContext* opCtx,
                 PipelineD::buildInnerQueryExecutor(collection, nss, &request, pipeline.get());
         }
 
+        // A large collection scan is read once as well. Its plan has not opened any cursors yet.
+        if (attachExecutorCallback.second && !opCtx->recoveryUnit()->getReadOnce() &&
+            !opCtx->inMultiDocumentTransaction() &&
+            isLargeUnindexedCollectionScan(opCtx, collection, *attachExecutorCallback.second)) {
+            opCtx->recoveryUnit()->setReadOnce(true);
+        }
+
         if (canOptimizeAwayPipeline(pipeline.get(),
                                     attachExecutorCallback.second.get(),
                                     request,
@@ -680,6 +723,9 @@ Status runAggregate(OperationContext* opCtx,
                                                           std::move(attachExecutorCallback.second),
                                                           pipeline.get());
 
+            pipeline = parallelizeGroupIfPossible(
+                opCtx, request, liteParsedPipeline, std::move(pipeline));
+
             auto pipelines =
                 createExchangePipelinesIfNeeded(opCtx, expCtx, request, std::move(pipeline), uuid);
             for (auto&& pipelineIt : pipelines) {
@@ -731,6 +777,7 @@ Status runAggregate(OperationContext* opCtx,
             repl::ReadConcernArgs::get(opCtx),
             cmdObj,
             privileges);
+        cursorParams.readOnce = opCtx->recoveryUnit()->getReadOnce();
         if (expCtx->tailableMode == TailableModeEnum::kTailable) {
             cursorParams.setTailable(true);
         } else if (expCtx->tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -238,6 +238,25 @@ public:
 
 } extraInfo;
 
+class Numa : public ServerStatusSection {
+public:
+    Numa() : ServerStatusSection("numa") {}
+
+    bool includeByDefault() const override {
+        return !ProcessInfo::getNumaNodes().empty();
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder bb;
+        bb.append("numNodes", static_cast<int>(ProcessInfo::getNumaNodes().size()));
+        bb.append("interleaved", !ProcessInfo::hasNumaEnabled());
+        ProcessInfo::appendNumaStats(&bb);
+        return bb.obj();
+    }
+
+} numa;
+
 class Asserts : public ServerStatusSection {
 public:
     Asserts() : ServerStatusSection("asserts") {}
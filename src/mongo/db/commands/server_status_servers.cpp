@@ -31,6 +31,7 @@
 
 #include "mongo/config.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/wait_event.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/service_entry_point.h"
 #include "mongo/util/net/hostname_canonicalization.h"
@@ -150,6 +151,37 @@ public:
         return builder.obj();
     }
 } tlsVersionStatus;
+
+/**
+ * Status section of how many TLS handshakes resumed an earlier session rather than negotiating a
+ * new one, for incoming and outgoing connections.
+ */
+class TLSSessionResumptionStatus : public ServerStatusSection {
+public:
+    TLSSessionResumptionStatus() : ServerStatusSection("tlsSessionResumption") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        auto& counts = TLSSessionResumptionCounts::get(opCtx->getServiceContext());
+
+        BSONObjBuilder builder;
+        {
+            BSONObjBuilder incoming(builder.subobjStart("incoming"));
+            incoming.append("resumed", counts.incomingResumed.load());
+            incoming.append("new", counts.incomingNew.load());
+        }
+        {
+            BSONObjBuilder outgoing(builder.subobjStart("outgoing"));
+            outgoing.append("resumed", counts.outgoingResumed.load());
+            outgoing.append("new", counts.outgoingNew.load());
+        }
+        return builder.obj();
+    }
+} tlsSessionResumptionStatus;
 #endif
 
 class AdvisoryHostFQDNs final : public ServerStatusSection {
@@ -168,6 +200,22 @@ public:
             getHostFQDNs(getHostNameCached(), HostnameCanonicalizationMode::kForwardAndReverse));
     }
 } advisoryHostFQDNs;
+
+class WaitEvents final : public ServerStatusSection {
+public:
+    WaitEvents() : ServerStatusSection("waitEvents") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder b;
+        WaitEventStats::reportGlobal(&b);
+        return b.obj();
+    }
+} waitEvents;
 }  // namespace
 
 }  // namespace mongo
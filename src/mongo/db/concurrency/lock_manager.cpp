@@ -46,6 +46,7 @@
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/str.h"
 #include "mongo/util/timer.h"
 
@@ -413,9 +414,16 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+// Balance scalability of intent locks against potential added cost of conflicting locks. A
+// conflicting lock only visits the partitions which hold intent locks on its resource, so use
+// enough partitions that the lockers running on different cores rarely share one.
+unsigned numPartitions() {
+    return std::clamp<unsigned>(2 * ProcessInfo::getNumAvailableCores(), 32, 256);
+}
+
+}  // namespace
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -443,9 +451,9 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
-    _lockBuckets = new LockBucket[_numLockBuckets];
-    _partitions = new Partition[_numPartitions];
+LockManager::LockManager() : _numPartitions(numPartitions()) {
+    _lockBuckets = new CacheAligned<LockBucket>[_numLockBuckets];
+    _partitions = new CacheAligned<Partition>[_numPartitions];
 }
 
 LockManager::~LockManager() {
@@ -44,6 +44,7 @@
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -216,10 +217,12 @@ private:
      */
     void _cleanupUnusedLocksInBucket(LockBucket* bucket);
 
+    // The buckets and partitions are cache aligned, so that threads working on neighbouring ones do
+    // not contend for the same cache line.
     static const unsigned _numLockBuckets;
-    LockBucket* _lockBuckets;
+    CacheAligned<LockBucket>* _lockBuckets;
 
-    static const unsigned _numPartitions;
-    Partition* _partitions;
+    const unsigned _numPartitions;
+    CacheAligned<Partition>* _partitions;
 };
 }  // namespace mongo
@@ -41,6 +41,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/flow_control.h"
+#include "mongo/db/wait_event.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/new.h"
@@ -360,10 +361,14 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
-        if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
-            return false;
+        if (!holder->tryAcquire()) {
+            WaitEventTimer waitTimer(opCtx, WaitEvent::kTicket);
+            if (deadline == Date_t::max()) {
+                holder->waitForTicket(interruptible, getAdmissionPriority());
+            } else if (!holder->waitForTicketUntil(
+                           interruptible, deadline, getAdmissionPriority())) {
+                return false;
+            }
         }
         restoreStateOnErrorGuard.dismiss();
     }
@@ -611,6 +616,8 @@ bool LockerImpl::isDbLockedForMode(StringData dbName, LockMode mode) const {
         return true;
     if (isR() && isSharedLockMode(mode))
         return true;
+    if (inLockFreeReadsMode() && isReadLocked() && isSharedLockMode(mode))
+        return true;
 
     const ResourceId resIdDb(RESOURCE_DATABASE, dbName);
     return isLockHeldForMode(resIdDb, mode);
@@ -623,6 +630,8 @@ bool LockerImpl::isCollectionLockedForMode(const NamespaceString& nss, LockMode
         return true;
     if (isR() && isSharedLockMode(mode))
         return true;
+    if (inLockFreeReadsMode() && isReadLocked() && isSharedLockMode(mode))
+        return true;
 
     const ResourceId resIdDb(RESOURCE_DATABASE, nss.db());
 
@@ -936,6 +945,7 @@ void LockerImpl::_lockComplete(OperationContext* opCtx,
     const uint64_t startOfTotalWaitTime = curTimeMicros64();
     uint64_t startOfCurrentWaitTime = startOfTotalWaitTime;
 
+    WaitEventTimer waitTimer(opCtx, WaitEvent::kLock);
     while (true) {
         // It is OK if this call wakes up spuriously, because we re-evaluate the remaining
         // wait time anyways.
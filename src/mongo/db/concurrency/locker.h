@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/ticketholder.h"
 
 namespace mongo {
 
@@ -491,6 +492,31 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Sets the lane in which this locker queues when it has to wait for a ticket. User operations
+     * run at normal priority.
+     */
+    void setAdmissionPriority(TicketHolder::Priority priority) {
+        _admissionPriority = priority;
+    }
+
+    TicketHolder::Priority getAdmissionPriority() const {
+        return _admissionPriority;
+    }
+
+    /**
+     * Lock-free readers hold only the global lock and rely on the CollectionCatalog version and
+     * their storage snapshot, rather than database and collection locks, for a consistent view of
+     * the catalog. While this mode is enabled, database and collection locks are reported as held
+     * for shared modes. Use LockFreeReadsBlock rather than calling this directly.
+     */
+    void setLockFreeReadsMode(bool newValue) {
+        _lockFreeReadsMode = newValue;
+    }
+    bool inLockFreeReadsMode() const {
+        return _lockFreeReadsMode;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -539,6 +565,8 @@ protected:
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    bool _lockFreeReadsMode = false;
+    TicketHolder::Priority _admissionPriority = TicketHolder::Priority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
@@ -600,4 +628,27 @@ private:
     const bool _originalShouldConflict;
 };
 
+/**
+ * RAII-style class to put the locker into lock-free reads mode for its lifetime. See
+ * Locker::setLockFreeReadsMode.
+ */
+class LockFreeReadsBlock {
+    LockFreeReadsBlock(const LockFreeReadsBlock&) = delete;
+    LockFreeReadsBlock& operator=(const LockFreeReadsBlock&) = delete;
+
+public:
+    explicit LockFreeReadsBlock(Locker* lockState)
+        : _lockState(lockState), _originalValue(_lockState->inLockFreeReadsMode()) {
+        _lockState->setLockFreeReadsMode(true);
+    }
+
+    ~LockFreeReadsBlock() {
+        _lockState->setLockFreeReadsMode(_originalValue);
+    }
+
+private:
+    Locker* const _lockState;
+    const bool _originalValue;
+};
+
 }  // namespace mongo
@@ -0,0 +1,383 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/cpu_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/cpu_profiler_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/stacktrace.h"
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+namespace mongo {
+namespace {
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+using OperationTag = CpuProfilerOperationScope::OperationTag;
+
+// Frames of rawBacktrace() and of the signal handler at the top of every sampled stack.
+constexpr size_t kFramesToSkip = 2;
+constexpr size_t kMaxFrames = 32;
+constexpr size_t kRingSize = 4096;
+
+/**
+ * The attribution of the samples taken on a thread. It is only written by the thread itself, so
+ * the signal handler, which interrupts that thread, only has to check 'updating' to not read a
+ * partially written tag.
+ */
+struct ThreadTag {
+    volatile sig_atomic_t updating;
+    OperationTag tag;
+};
+
+// Initial-exec TLS, so that the signal handler never causes the allocation of the thread's block.
+thread_local ThreadTag threadTag __attribute__((tls_model("initial-exec")));
+
+struct SampleData {
+    size_t numFrames;
+    void* frames[kMaxFrames];
+    OperationTag tag;
+};
+
+struct Sample {
+    // Odd while a signal handler writes the sample, and 0 until the sample is first written.
+    std::atomic<uint64_t> seq{0};  // NOLINT
+    SampleData data;
+};
+
+// Allocated when the profiler is first enabled, and never freed since a signal may still be in
+// flight when it is disabled.
+Sample* ring = nullptr;
+bool signalHandlerInstalled = false;
+std::atomic<uint64_t> nextSample{0};      // NOLINT
+std::atomic<uint64_t> droppedSamples{0};  // NOLINT
+
+// Serializes the changes of the sampling rate, and the reads of 'ring' by report().
+auto profilerMutex = MONGO_MAKE_LATCH("CpuProfiler::profilerMutex");
+
+void sampleHandler(int, siginfo_t*, void*) {
+    const int savedErrno = errno;
+
+    Sample& sample = ring[nextSample.fetch_add(1, std::memory_order_relaxed) % kRingSize];
+    uint64_t seq = sample.seq.load(std::memory_order_relaxed);
+    if ((seq & 1) ||
+        !sample.seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+        // Another thread is still writing this sample, after the ring wrapped around.
+        droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        errno = savedErrno;
+        return;
+    }
+
+    auto& data = sample.data;
+    void* frames[kMaxFrames + kFramesToSkip];
+    const auto numFrames = rawBacktrace(frames, kMaxFrames + kFramesToSkip);
+    data.numFrames = numFrames > kFramesToSkip ? numFrames - kFramesToSkip : 0;
+    std::copy(frames + kFramesToSkip, frames + kFramesToSkip + data.numFrames, data.frames);
+
+    if (threadTag.updating) {
+        data.tag.isSet = false;
+    } else {
+        data.tag = threadTag.tag;
+    }
+
+    sample.seq.store(seq + 2, std::memory_order_release);
+    errno = savedErrno;
+}
+
+Status setSampleRate(WithLock, int sampleRateHz) {
+    if (!signalHandlerInstalled) {
+        if (sampleRateHz == 0) {
+            return Status::OK();
+        }
+
+        if (!ring) {
+            ring = new Sample[kRingSize];
+        }
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sigemptyset(&sa.sa_mask);
+        sa.sa_sigaction = sampleHandler;
+        sa.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+        if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+            return Status(ErrorCodes::InternalError,
+                          str::stream() << "Failed to install the CPU profiler signal handler: "
+                                        << errnoWithDescription());
+        }
+        signalHandlerInstalled = true;
+    }
+
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    if (sampleRateHz > 0) {
+        const auto intervalMicros = 1000 * 1000 / sampleRateHz;
+        timer.it_interval.tv_sec = intervalMicros / (1000 * 1000);
+        timer.it_interval.tv_usec = intervalMicros % (1000 * 1000);
+        timer.it_value = timer.it_interval;
+    }
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        return Status(ErrorCodes::InternalError,
+                      str::stream()
+                          << "Failed to set the CPU profiler timer: " << errnoWithDescription());
+    }
+
+    LOGV2(5191080, "Set the CPU profiler sample rate", "sampleRateHz"_attr = sampleRateHz);
+    return Status::OK();
+}
+
+/**
+ * Returns a consistent copy of 'sample', or boost::none if it was never written or is being
+ * written.
+ */
+boost::optional<SampleData> readSample(const Sample& sample) {
+    const auto seq = sample.seq.load(std::memory_order_acquire);
+    if (seq == 0 || (seq & 1)) {
+        return boost::none;
+    }
+
+    SampleData copy = sample.data;
+    copy.numFrames = std::min(copy.numFrames, kMaxFrames);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sample.seq.load(std::memory_order_relaxed) != seq) {
+        return boost::none;
+    }
+    return copy;
+}
+
+void copyTruncated(StringData src, char* dest, size_t destSize) {
+    const auto len = std::min(src.size(), destSize - 1);
+    std::memcpy(dest, src.rawData(), len);
+    dest[len] = '\0';
+}
+
+void appendFrame(StackTraceAddressMetadataGenerator* metaGen,
+                 void* addr,
+                 BSONArrayBuilder* backtrace) {
+    using Hex = stack_trace_detail::Hex;
+
+    const auto& meta = metaGen->load(addr);
+    const auto address = reinterpret_cast<uintptr_t>(addr);
+
+    BSONObjBuilder frame(backtrace->subobjStart());
+    frame.append("a", Hex(address));
+    if (const auto& file = meta.file(); file) {
+        frame.append("b", Hex(file.base()));
+        frame.append("o", Hex(address - file.base()));
+    }
+    if (const auto& symbol = meta.symbol(); symbol) {
+        frame.append("s", symbol.name());
+        frame.append("s+", Hex(address - symbol.base()));
+    }
+}
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+/**
+ * Returns the CPU profile collected so far.
+ */
+class GetCpuProfileCommand final : public BasicCommand {
+public:
+    GetCpuProfileCommand() : BasicCommand("getCpuProfile") {}
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    std::string help() const override {
+        return "get the most frequently sampled stacks of the CPU profiler. Optional 'limit' "
+               "field caps the number of stacks returned";
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        if (!AuthorizationSession::get(client)->isAuthorizedForActionsOnResource(
+                ResourcePattern::forClusterResource(), ActionType::serverStatus)) {
+            return Status(ErrorCodes::Unauthorized, "Unauthorized");
+        }
+        return Status::OK();
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& db,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        int limit = CpuProfiler::kDefaultReportLimit;
+        if (auto limitElem = cmdObj["limit"]; !limitElem.eoo()) {
+            uassert(5191081,
+                    "The 'limit' field of getCpuProfile must be a positive number",
+                    limitElem.isNumber() && limitElem.safeNumberLong() > 0);
+            limit = static_cast<int>(std::min(limitElem.safeNumberLong(), 100000LL));
+        }
+
+        CpuProfiler::report(limit, &result);
+        return true;
+    }
+} getCpuProfileCommand;
+
+}  // namespace
+
+Status CpuProfiler::onUpdateSampleRate(const int& sampleRateHz) {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    stdx::lock_guard<Latch> lk(profilerMutex);
+    return setSampleRate(lk, sampleRateHz);
+#else
+    if (sampleRateHz > 0) {
+        return Status(ErrorCodes::IllegalOperation,
+                      "CPU profiling is not supported on this platform");
+    }
+    return Status::OK();
+#endif
+}
+
+void CpuProfiler::report(int limit, BSONObjBuilder* builder) {
+    builder->append("sampleRateHz", gCpuProfilerSampleRateHz.load());
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    struct StackCount {
+        long long count = 0;
+        SampleData sample;
+    };
+
+    // Identical stacks of the same operation are keyed by the raw bytes of their frames and tag.
+    std::map<std::string, StackCount> stackCounts;
+    long long numSamples = 0;
+
+    {
+        stdx::lock_guard<Latch> lk(profilerMutex);
+        for (size_t i = 0; ring && i < kRingSize; ++i) {
+            auto sample = readSample(ring[i]);
+            if (!sample) {
+                continue;
+            }
+
+            std::string key(reinterpret_cast<const char*>(sample->frames),
+                            sample->numFrames * sizeof(void*));
+            if (sample->tag.isSet) {
+                key.append(sample->tag.opType).push_back('\0');
+                key.append(sample->tag.ns);
+            }
+
+            auto& stackCount = stackCounts[key];
+            if (stackCount.count++ == 0) {
+                stackCount.sample = *sample;
+            }
+            ++numSamples;
+        }
+    }
+
+    std::vector<const StackCount*> sorted;
+    sorted.reserve(stackCounts.size());
+    for (const auto& [key, stackCount] : stackCounts) {
+        sorted.push_back(&stackCount);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const StackCount* lhs, const StackCount* rhs) {
+        return lhs->count > rhs->count;
+    });
+    if (sorted.size() > static_cast<size_t>(limit)) {
+        sorted.resize(limit);
+    }
+
+    builder->append("samples", numSamples);
+    builder->append("droppedSamples",
+                    static_cast<long long>(droppedSamples.load(std::memory_order_relaxed)));
+
+    StackTraceAddressMetadataGenerator metaGen;
+    BSONArrayBuilder stacks(builder->subarrayStart("stacks"));
+    for (const auto* stackCount : sorted) {
+        const auto& sample = stackCount->sample;
+
+        BSONObjBuilder stack(stacks.subobjStart());
+        stack.append("count", stackCount->count);
+        if (sample.tag.isSet) {
+            stack.append("opType", sample.tag.opType);
+            stack.append("ns", sample.tag.ns);
+        }
+
+        BSONArrayBuilder backtrace(stack.subarrayStart("backtrace"));
+        for (size_t i = 0; i < sample.numFrames; ++i) {
+            appendFrame(&metaGen, sample.frames[i], &backtrace);
+        }
+    }
+#endif
+}
+
+CpuProfilerOperationScope::CpuProfilerOperationScope(StringData opType, StringData ns) {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    _previousTag = threadTag.tag;
+
+    threadTag.updating = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    copyTruncated(opType, threadTag.tag.opType, sizeof(threadTag.tag.opType));
+    copyTruncated(ns, threadTag.tag.ns, sizeof(threadTag.tag.ns));
+    threadTag.tag.isSet = true;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    threadTag.updating = 0;
+#endif
+}
+
+CpuProfilerOperationScope::~CpuProfilerOperationScope() {
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+    threadTag.updating = 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    threadTag.tag = _previousTag;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    threadTag.updating = 0;
+#endif
+}
+
+}  // namespace mongo
@@ -0,0 +1,94 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+
+/**
+ * A sampling CPU profiler. While enabled, a SIGPROF timer fires for every 1/cpuProfilerSampleRateHz
+ * seconds of CPU time consumed by the process, and the signal handler records the stack of the
+ * interrupted thread in a fixed size ring buffer, along with the operation it was running.
+ *
+ * Sampling is only supported where backtraces are async-signal-safe, that is on Linux with
+ * libunwind.
+ */
+class CpuProfiler {
+public:
+    /**
+     * Unique stacks are reported by descending number of samples, up to this many by default.
+     */
+    static constexpr int kDefaultReportLimit = 100;
+
+    /**
+     * Starts, restarts at a different rate or stops the sampling. Called when the
+     * cpuProfilerSampleRateHz server parameter is set.
+     */
+    static Status onUpdateSampleRate(const int& sampleRateHz);
+
+    /**
+     * Aggregates the samples in the ring buffer by stack and operation, and appends the 'limit'
+     * most frequent ones to 'builder' as
+     *
+     *     {sampleRateHz: <hz>, samples: <n>, droppedSamples: <n>,
+     *      stacks: [{count: <n>, opType: <command>, ns: <namespace>, backtrace: [...]}, ...]}
+     *
+     * The frames of the backtraces have the same format as in the server's own stack traces.
+     */
+    static void report(int limit, BSONObjBuilder* builder);
+};
+
+/**
+ * Attributes the CPU profiler samples taken on the current thread to the given operation type and
+ * namespace while in scope. Scopes can nest; the attribution of the enclosing scope is restored on
+ * destruction. Both strings are truncated to fit fixed size buffers.
+ */
+class CpuProfilerOperationScope {
+    CpuProfilerOperationScope(const CpuProfilerOperationScope&) = delete;
+    CpuProfilerOperationScope& operator=(const CpuProfilerOperationScope&) = delete;
+
+public:
+    struct OperationTag {
+        char opType[32];
+        char ns[96];
+        bool isSet;
+    };
+
+    CpuProfilerOperationScope(StringData opType, StringData ns);
+    ~CpuProfilerOperationScope();
+
+private:
+    OperationTag _previousTag;
+};
+
+}  // namespace mongo
@@ -50,6 +50,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/wait_event.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/client_metadata_ismaster.h"
@@ -729,6 +730,11 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (BSONObj waitEventsObj = OpDebug::makeWaitEventsObject(opCtx); waitEventsObj.nFields() > 0) {
+        builder->append("waitEvents", waitEventsObj);
+    }
+    WaitEventStats::get(opCtx).reportCurrentWait(opCtx, builder);
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -889,6 +895,11 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " flowControl:" << flowControlObj.toString();
     }
 
+    BSONObj waitEventsObj = makeWaitEventsObject(opCtx);
+    if (waitEventsObj.nFields() > 0) {
+        s << " waitEvents:" << waitEventsObj.toString();
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1058,6 +1069,11 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("flowControl", flowControlObj);
     }
 
+    BSONObj waitEventsObj = makeWaitEventsObject(opCtx);
+    if (waitEventsObj.nFields() > 0) {
+        pAttrs->add("waitEvents", waitEventsObj);
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1172,6 +1188,10 @@ void OpDebug::append(OperationContext* opCtx,
         flowControlBuilder.appendElements(flowControlMetrics);
     }
 
+    if (BSONObj waitEventsObj = makeWaitEventsObject(opCtx); waitEventsObj.nFields() > 0) {
+        b.append("waitEvents", waitEventsObj);
+    }
+
     {
         const auto& readConcern = repl::ReadConcernArgs::get(opCtx);
         if (readConcern.isSpecified()) {
@@ -1433,6 +1453,10 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         flowControlBuilder.appendElements(flowControlMetrics);
     });
 
+    addIfNeeded("waitEvents", [](auto field, auto args, auto& b) {
+        b.append(field, makeWaitEventsObject(args.opCtx));
+    });
+
     addIfNeeded("writeConcern", [](auto field, auto args, auto& b) {
         if (args.op.writeConcern && !args.op.writeConcern->usedDefault) {
             b.append(field, args.op.writeConcern->toBSON());
@@ -1548,6 +1572,12 @@ BSONObj OpDebug::makeFlowControlObject(FlowControlTicketholder::CurOp stats) {
     return builder.obj();
 }
 
+BSONObj OpDebug::makeWaitEventsObject(OperationContext* opCtx) {
+    BSONObjBuilder builder;
+    WaitEventStats::get(opCtx).report(&builder);
+    return builder.obj();
+}
+
 BSONObj OpDebug::makeMongotDebugStatsObject() const {
     BSONObjBuilder cursorBuilder;
     invariant(mongotCursorId);
@@ -193,6 +193,11 @@ public:
      */
     static BSONObj makeFlowControlObject(FlowControlTicketholder::CurOp flowControlStats);
 
+    /**
+     * Makes an object from the wait events of the operation, omitting the events never waited on.
+     */
+    static BSONObj makeWaitEventsObject(OperationContext* opCtx);
+
     /**
      * Make object from $search stats with non-populated values omitted.
      */
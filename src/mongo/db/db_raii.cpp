@@ -102,14 +102,22 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
         _shouldNotConflictWithSecondaryBatchApplicationBlock.emplace(opCtx->lockState());
     }
     const auto collectionLockMode = getLockModeForQuery(opCtx, nsOrUUID.nss());
-    _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+    const bool lockFree = AutoGetCollectionLockFree::isEligible(opCtx);
+    auto acquireCollection = [&] {
+        if (lockFree) {
+            _autoCollLockFree.emplace(opCtx, nsOrUUID, viewMode, deadline);
+        } else {
+            _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+        }
+    };
+    acquireCollection();
 
     repl::ReplicationCoordinator* const replCoord = repl::ReplicationCoordinator::get(opCtx);
     const auto readConcernLevel = repl::ReadConcernArgs::get(opCtx).getLevel();
 
     // If the collection doesn't exist or disappears after releasing locks and waiting, there is no
     // need to check for pending catalog changes.
-    while (auto coll = _autoColl->getCollection()) {
+    while (auto coll = getCollection()) {
         // Ban snapshot reads on capped collections.
         uassert(ErrorCodes::SnapshotUnavailable,
                 "Reading from capped collections with readConcern snapshot is not supported",
@@ -206,6 +214,7 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
 
         // Yield locks in order to do the blocking call below.
         _autoColl = boost::none;
+        _autoCollLockFree = boost::none;
 
         // If there are pending catalog changes when using a no-overlap or lastApplied read source,
         // we choose to take the PBWM lock to conflict with any in-progress batches. This prevents
@@ -257,7 +266,7 @@ AutoGetCollectionForRead::AutoGetCollectionForRead(OperationContext* opCtx,
             CurOp::get(opCtx)->yielded();
         }
 
-        _autoColl.emplace(opCtx, nsOrUUID, collectionLockMode, viewMode, deadline);
+        acquireCollection();
     }
 }
 
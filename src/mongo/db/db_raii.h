@@ -93,6 +93,9 @@ private:
  * some command. This will ensure your reads obey any requested readConcern, but will not update the
  * status of CurrentOp, or add a Top entry.
  *
+ * When lock-free reads are enabled and the operation is eligible, no database or collection locks
+ * are taken. See AutoGetCollectionLockFree.
+ *
  * NOTE: Must not be used with any locks held, because it needs to block waiting on the committed
  * snapshot to become available.
  */
@@ -108,19 +111,19 @@ public:
         Date_t deadline = Date_t::max());
 
     Database* getDb() const {
-        return _autoColl->getDb();
+        return _autoCollLockFree ? _autoCollLockFree->getDb() : _autoColl->getDb();
     }
 
     const Collection* getCollection() const {
-        return _autoColl->getCollection();
+        return _autoCollLockFree ? _autoCollLockFree->getCollection() : _autoColl->getCollection();
     }
 
     ViewDefinition* getView() const {
-        return _autoColl->getView();
+        return _autoCollLockFree ? _autoCollLockFree->getView() : _autoColl->getView();
     }
 
     const NamespaceString& getNss() const {
-        return _autoColl->getNss();
+        return _autoCollLockFree ? _autoCollLockFree->getNss() : _autoColl->getNss();
     }
 
 private:
@@ -133,6 +136,9 @@ private:
     // This field is optional, because the code to wait for majority committed snapshot needs to
     // release locks in order to block waiting
     boost::optional<AutoGetCollectionBase<CatalogCollectionLookupForRead>> _autoColl;
+
+    // Set instead of '_autoColl' when the read is served without database and collection locks.
+    boost::optional<AutoGetCollectionLockFree> _autoCollLockFree;
 };
 
 /**
@@ -48,6 +48,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/query_planner.h"
+#include "mongo/db/storage/clustered_id.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
@@ -139,6 +140,14 @@ bool Helpers::findById(OperationContext* opCtx,
     if (nsFound)
         *nsFound = true;
 
+    if (collection->isClustered()) {
+        RecordId loc = findById(opCtx, collection, query);
+        if (loc.isNull())
+            return false;
+        result = collection->docFor(opCtx, loc).value();
+        return true;
+    }
+
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
 
@@ -159,6 +168,15 @@ RecordId Helpers::findById(OperationContext* opCtx,
                            const Collection* collection,
                            const BSONObj& idquery) {
     verify(collection);
+    if (collection->isClustered()) {
+        // The records of a clustered collection are keyed by _id, so there is no index to consult.
+        auto loc = clustered_id::keyForId(idquery["_id"]);
+        RecordData unused;
+        if (!loc.isOK() ||
+            !collection->getRecordStore()->findRecord(opCtx, loc.getValue(), &unused))
+            return RecordId();
+        return loc.getValue();
+    }
     const IndexCatalog* catalog = collection->getIndexCatalog();
     const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
     uassert(13430, "no _id index", desc);
@@ -142,6 +142,10 @@ private:
                         const VariablesParseState& variablesParseState,
                         const FieldPath& pathToObj);
 
+    void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions) final {
+        _root->collectExpressions(expressions);
+    }
+
     // The InclusionNode tree does most of the execution work once constructed.
     std::unique_ptr<InclusionNode> _root;
 };
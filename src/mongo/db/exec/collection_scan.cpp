@@ -41,6 +41,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/logv2/log.h"
@@ -69,6 +70,8 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     _specificStats.direction = params.direction;
     _specificStats.minTs = params.minTs;
     _specificStats.maxTs = params.maxTs;
+    _specificStats.minRecord = params.minRecord;
+    _specificStats.maxRecord = params.maxRecord;
     _specificStats.tailable = params.tailable;
     if (params.minTs || params.maxTs) {
         // The 'minTs' and 'maxTs' parameters are used for a special optimization that
@@ -91,12 +94,22 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
 
+    if (params.minRecord || params.maxRecord) {
+        // Bounds on the RecordIds are only meaningful for collections keyed by _id.
+        invariant(collection->isClustered());
+        invariant(!params.resumeAfterRecordId && !params.tailable);
+    }
+
     // Set early stop condition.
     if (params.maxTs) {
         _endConditionBSON = BSON("$gte"_sd << *(params.maxTs));
         _endCondition = std::make_unique<GTEMatchExpression>(repl::OpTime::kTimestampFieldName,
                                                              _endConditionBSON.firstElement());
     }
+
+    if (_filter && internalQueryEnableCompiledMatchExpression.load()) {
+        _compiledFilter = std::make_unique<CompiledMatchExpression>(_filter);
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -181,6 +194,15 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             }
         }
 
+        if (_lastSeenId.isNull() && _params.minRecord && _params.minRecord == _params.maxRecord) {
+            // There is at most one record within the bounds, so seek directly to it.
+            record = _cursor->seekExact(*_params.minRecord);
+            if (!record) {
+                _commonStats.isEOF = true;
+                return PlanStage::IS_EOF;
+            }
+        }
+
         if (!record) {
             record = _cursor->next();
         }
@@ -203,6 +225,20 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_params.minRecord || _params.maxRecord) {
+        const bool forward = _params.direction == CollectionScanParams::FORWARD;
+        const auto& endBound = forward ? _params.maxRecord : _params.minRecord;
+        const auto& startBound = forward ? _params.minRecord : _params.maxRecord;
+        if (endBound && (forward ? record->id > *endBound : record->id < *endBound)) {
+            _commonStats.isEOF = true;
+            return PlanStage::IS_EOF;
+        }
+        if (startBound && (forward ? record->id < *startBound : record->id > *startBound)) {
+            _lastSeenId = record->id;
+            return PlanStage::NEED_TIME;
+        }
+    }
+
     _lastSeenId = record->id;
     if (_params.assertMinTsHasNotFallenOffOplog) {
         assertMinTsHasNotFallenOffOplog(*record);
@@ -251,9 +287,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
                                                       WorkingSetID memberID,
                                                       WorkingSetID* out) {
     ++_specificStats.docsTested;
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
@@ -61,6 +61,13 @@ struct CollectionScanParams {
     // This field cannot be used in conjunction with 'minTs' or 'maxTs'.
     boost::optional<RecordId> resumeAfterRecordId;
 
+    // If present, the collection scan only returns the records whose RecordIds are at least
+    // 'minRecord' and at most 'maxRecord', and ends on the first record past the bound in its
+    // direction. When both are the same RecordId, the scan seeks directly to that record.
+    // These fields cannot be used in conjunction with 'resumeAfterRecordId'.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     Direction direction = FORWARD;
 
     // Do we want the scan to be 'tailable'?  Only meaningful if the collection is capped.
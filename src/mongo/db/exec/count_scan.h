@@ -29,12 +29,12 @@
 
 #pragma once
 
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/sorted_data_interface.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -130,7 +130,7 @@ private:
 
     // The set of record ids we've returned so far. Used to avoid returning duplicates, if
     // '_shouldDedup' is set to true.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdBitmap _returned;
 
     CountScanStats _specificStats;
 };
@@ -46,6 +46,75 @@ using std::vector;
 
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
+namespace {
+// The cache which the DocumentStorage buffers allocated and freed on this thread go through.
+thread_local DocumentStorageBufferCache* activeBufferCache = nullptr;
+}  // namespace
+
+DocumentStorageBufferCache::Scope::Scope(DocumentStorageBufferCache* cache) {
+    if (cache && !activeBufferCache) {
+        activeBufferCache = cache;
+        _activated = true;
+    }
+}
+
+DocumentStorageBufferCache::Scope::~Scope() {
+    if (_activated) {
+        activeBufferCache = nullptr;
+    }
+}
+
+DocumentStorageBufferCache::DocumentStorageBufferCache() {
+    // Reserve all the space up front, so that keeping a buffer never allocates.
+    for (auto&& buffers : _freeBuffers) {
+        buffers.reserve(kMaxBuffersPerSize);
+    }
+}
+
+void DocumentStorageBufferCache::release() {
+    for (auto&& buffers : _freeBuffers) {
+        for (char* buffer : buffers) {
+            delete[] buffer;
+        }
+        buffers.clear();
+    }
+}
+
+size_t DocumentStorageBufferCache::sizeIndex(size_t bytes) {
+    if (bytes < kMinCachedBytes || bytes > kMaxCachedBytes || (bytes & (bytes - 1)) != 0) {
+        return kNumSizes;
+    }
+    size_t index = 0;
+    while ((kMinCachedBytes << index) < bytes) {
+        ++index;
+    }
+    return index;
+}
+
+char* DocumentStorageBufferCache::allocate(size_t bytes) {
+    if (activeBufferCache) {
+        const size_t index = sizeIndex(bytes);
+        if (index < kNumSizes && !activeBufferCache->_freeBuffers[index].empty()) {
+            char* buffer = activeBufferCache->_freeBuffers[index].back();
+            activeBufferCache->_freeBuffers[index].pop_back();
+            return buffer;
+        }
+    }
+    return new char[bytes];
+}
+
+void DocumentStorageBufferCache::deallocate(char* buffer, size_t bytes) {
+    if (activeBufferCache) {
+        const size_t index = sizeIndex(bytes);
+        if (index < kNumSizes &&
+            activeBufferCache->_freeBuffers[index].size() < kMaxBuffersPerSize) {
+            activeBufferCache->_freeBuffers[index].push_back(buffer);
+            return;
+        }
+    }
+    delete[] buffer;
+}
+
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
                                                     Document::metaFieldRandVal,
                                                     Document::metaFieldSortKey,
@@ -156,18 +225,81 @@ Position DocumentStorage::findFieldInCache(StringData requested) const {
 }
 
 Position DocumentStorage::findField(StringData requested, LookupPolicy policy) const {
-    if (auto pos = findFieldInCache(requested); pos.found() || policy == LookupPolicy::kCacheOnly) {
+    if (auto pos = findFieldInCache(requested);
+        pos.found() || policy == LookupPolicy::kCacheOnly || _bsonLoadedIntoCache) {
         return pos;
     }
 
+    if (auto bsonElement = findFieldInBson(requested); !bsonElement.eoo()) {
+        return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+    }
+
+    // if we got here, there's no such field
+    return Position();
+}
+
+BSONElement DocumentStorage::findFieldInBson(StringData requested) const {
+    // A storage loaded into its cache may be read by several threads, so it is left as it is.
+    if (_bsonFieldIndex.empty() && !_bsonLoadedIntoCache &&
+        _numBsonFieldsScanned >= kBsonFieldIndexMinScanned) {
+        buildBsonFieldIndex();
+    }
+
+    if (!_bsonFieldIndex.empty()) {
+        const size_t mask = _bsonFieldIndex.size() - 1;
+        for (size_t slot = hashKey(requested) & mask; _bsonFieldIndex[slot] != -1;
+             slot = (slot + 1) & mask) {
+            BSONElement bsonElement(_bson.objdata() + _bsonFieldIndex[slot]);
+            if (requested == bsonElement.fieldNameStringData()) {
+                return bsonElement;
+            }
+        }
+        return BSONElement();
+    }
+
+    unsigned numScanned = 0;
+    BSONElement found;
     for (auto&& bsonElement : _bson) {
+        ++numScanned;
         if (requested == bsonElement.fieldNameStringData()) {
-            return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+            found = bsonElement;
+            break;
         }
     }
+    if (!_bsonLoadedIntoCache) {
+        _numBsonFieldsScanned += numScanned;
+    }
+    return found;
+}
 
-    // if we got here, there's no such field
-    return Position();
+void DocumentStorage::buildBsonFieldIndex() const {
+    std::vector<int> offsets;
+    for (auto&& bsonElement : _bson) {
+        offsets.push_back(bsonElement.rawdata() - _bson.objdata());
+    }
+
+    // Keep the load factor at or below one half.
+    size_t numSlots = 16;
+    while (numSlots < offsets.size() * 2) {
+        numSlots *= 2;
+    }
+    _bsonFieldIndex.assign(numSlots, -1);
+
+    const size_t mask = numSlots - 1;
+    for (int offset : offsets) {
+        const auto name = BSONElement(_bson.objdata() + offset).fieldNameStringData();
+        for (size_t slot = hashKey(name) & mask;; slot = (slot + 1) & mask) {
+            if (_bsonFieldIndex[slot] == -1) {
+                _bsonFieldIndex[slot] = offset;
+                break;
+            }
+            // Like a scan, lookups find the first of several fields with the same name.
+            const BSONElement indexed(_bson.objdata() + _bsonFieldIndex[slot]);
+            if (name == indexed.fieldNameStringData()) {
+                break;
+            }
+        }
+    }
 }
 
 Position DocumentStorage::constructInCache(const BSONElement& elem) {
@@ -241,6 +373,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldBufferBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -253,13 +386,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* const oldBuf = _cache;
+    _cache = DocumentStorageBufferCache::allocate(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -267,9 +400,10 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
+        DocumentStorageBufferCache::deallocate(oldBuf, oldBufferBytes);
     }
 }
 
@@ -286,8 +420,13 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
-    _cacheEnd = _cache + newSize;
+    // Round up to a power of two like alloc() does, which lets the buffer be cached for reuse.
+    size_t capacity = 128;
+    while (capacity < newSize + hashTabBytes())
+        capacity *= 2;
+
+    _cache = DocumentStorageBufferCache::allocate(capacity);
+    _cacheEnd = _cache + capacity - hashTabBytes();
 }
 
 intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
@@ -297,7 +436,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = DocumentStorageBufferCache::allocate(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -324,16 +463,42 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
     return out;
 }
 
+namespace {
+void loadValueIntoCache(const Value& value) {
+    if (value.getType() == BSONType::Object) {
+        value.getDocument().loadIntoCache();
+    } else if (value.getType() == BSONType::Array) {
+        for (auto&& element : value.getArray()) {
+            loadValueIntoCache(element);
+        }
+    }
+}
+}  // namespace
+
+void DocumentStorage::loadIntoCache() const {
+    if (_bsonLoadedIntoCache) {
+        return;
+    }
+
+    metadata();
+    for (auto it = iterator(); !it.atEnd(); it.advance()) {
+        loadValueIntoCache(it->val);
+    }
+    _bsonLoadedIntoCache = true;
+}
+
 size_t DocumentStorage::getMetadataApproximateSize() const {
     return _metadataFields.getApproximateSize();
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    if (_cache) {
+        DocumentStorageBufferCache::deallocate(_cache, allocatedBytes());
+    }
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
@@ -346,10 +511,18 @@ void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
         it->val.~Value();  // explicit destructor call
     }
 
+    // The next field added reallocates the buffer anyway, since it has no space left.
+    if (_cache) {
+        DocumentStorageBufferCache::deallocate(_cache, allocatedBytes());
+        _cache = nullptr;
+    }
     _cacheEnd = _cache;
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
+    _bsonLoadedIntoCache = false;
+    _numBsonFieldsScanned = 0;
+    _bsonFieldIndex.clear();
 
     // Clean metadata.
     _metadataFields = DocumentMetadataFields{};
@@ -469,6 +642,22 @@ boost::optional<BSONObj> Document::toBsonIfTriviallyConvertible() const {
     }
 }
 
+bool Document::hasUnmodifiedBson() const {
+    if (!_storage) {
+        return true;
+    }
+    if (_storage->isModified()) {
+        return false;
+    }
+    // Fields added with MutableDocument::addField() don't mark the storage as modified.
+    for (auto it = _storage->iteratorCacheOnly(); !it.atEnd(); it.advance()) {
+        if (it->kind != ValueElement::Kind::kCached) {
+            return false;
+        }
+    }
+    return true;
+}
+
 constexpr StringData Document::metaFieldTextScore;
 constexpr StringData Document::metaFieldRandVal;
 constexpr StringData Document::metaFieldSortKey;
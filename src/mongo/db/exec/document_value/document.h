@@ -312,6 +312,17 @@ public:
      */
     Document getOwned() const;
 
+    /**
+     * Constructs all the fields of the underlying BSONObj in the cache, including those of
+     * sub-documents, and loads the metadata. Reading the document afterwards doesn't modify its
+     * storage, so several threads may read it at once.
+     */
+    void loadIntoCache() const {
+        if (_storage) {
+            _storage->loadIntoCache();
+        }
+    }
+
     /**
      * Returns true if the underlying BSONObj is owned.
      */
@@ -326,6 +337,12 @@ public:
         return _storage ? _storage->isModified() : false;
     }
 
+    /**
+     * Returns true if every field of the document is the field of the underlying BSONObj, so that
+     * a document built over the same BSONObj has the same fields and values.
+     */
+    bool hasUnmodifiedBson() const;
+
     bool hasExclusivelyOwnedStorage() const {
         return _storage && !_storage->isShared();
     }
@@ -659,6 +676,18 @@ public:
         return const_cast<DocumentStorage&>(*storagePtr());
     }
 
+    /**
+     * Replaces the current base Document with a new storage over the BSONObj of 'source', which
+     * must satisfy Document::hasUnmodifiedBson(), and copies its metadata. Unlike reset(), the new
+     * storage shares no cached fields with 'source', so modifying it never clones them.
+     */
+    void resetToBsonOf(const Document& source) {
+        dassert(source.hasUnmodifiedBson());
+        const auto& sourceStorage = source.storage();
+        auto& storage = newStorageWithBson(sourceStorage.bsonObj(), sourceStorage.stripMetadata());
+        storage.copyMetaDataFrom(sourceStorage);
+    }
+
 private:
     friend class MutableValue;  // for access to next constructor
     explicit MutableDocument(MutableValue mv) : _storageHolder(nullptr), _storage(mv.getDocPtr()) {}
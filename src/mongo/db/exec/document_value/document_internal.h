@@ -31,8 +31,10 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#include <array>
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
+#include <vector>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
@@ -275,6 +277,75 @@ private:
     const ValueElement* _end;
 };
 
+/**
+ * Keeps the field buffers of the DocumentStorage objects freed while it is active on a thread, and
+ * hands them out again to the DocumentStorage objects allocated on that thread, instead of going
+ * back to the allocator each time. Only buffers of a power-of-two size up to kMaxCachedBytes are
+ * kept, at most kMaxBuffersPerSize of each size. All of them are freed by release(), and by the
+ * destructor. A buffer handed out by the cache may outlive it, and is then freed normally.
+ *
+ * A cache belongs to one operation, and must only be active on one thread at a time.
+ */
+class DocumentStorageBufferCache {
+public:
+    static constexpr size_t kMinCachedBytes = 128;
+    static constexpr size_t kMaxCachedBytes = 32 * 1024;
+    static constexpr size_t kMaxBuffersPerSize = 32;
+
+    /**
+     * Makes 'cache' the active cache of the current thread for the lifetime of the Scope, unless
+     * the thread already has one. 'cache' may be null, in which case the Scope does nothing.
+     */
+    class Scope {
+    public:
+        explicit Scope(DocumentStorageBufferCache* cache);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool _activated = false;
+    };
+
+    DocumentStorageBufferCache();
+    ~DocumentStorageBufferCache() {
+        release();
+    }
+
+    DocumentStorageBufferCache(const DocumentStorageBufferCache&) = delete;
+    DocumentStorageBufferCache& operator=(const DocumentStorageBufferCache&) = delete;
+
+    /**
+     * Frees all the buffers kept by the cache.
+     */
+    void release();
+
+    /**
+     * Returns a buffer of 'bytes' bytes, from the current thread's active cache if it has one of
+     * that size. The buffer must be freed with deallocate().
+     */
+    static char* allocate(size_t bytes);
+
+    /**
+     * Frees 'buffer', which is 'bytes' bytes long, or keeps it in the current thread's active
+     * cache.
+     */
+    static void deallocate(char* buffer, size_t bytes);
+
+private:
+    static constexpr size_t kNumSizes = 9;  // 128 bytes to 32KB.
+    MONGO_STATIC_ASSERT((kMinCachedBytes << (kNumSizes - 1)) == kMaxCachedBytes);
+
+    /**
+     * Returns the index in '_freeBuffers' of the buffers of 'bytes' bytes, or kNumSizes if buffers
+     * of that size aren't cached.
+     */
+    static size_t sizeIndex(size_t bytes);
+
+    std::array<std::vector<char*>, kNumSizes> _freeBuffers;
+};
+
 /// Storage class used by both Document and MutableDocument
 class DocumentStorage : public RefCountable {
 public:
@@ -363,10 +434,8 @@ public:
             return {getField(pos).val};
         }
 
-        for (auto&& bsonElement : _bson) {
-            if (name == bsonElement.fieldNameStringData()) {
-                return {bsonElement};
-            }
+        if (auto bsonElement = findFieldInBson(name); !bsonElement.eoo()) {
+            return {bsonElement};
         }
 
         // Field not found. Return EOO Value.
@@ -394,6 +463,12 @@ public:
     /// Shallow copy of this. Caller owns memory.
     boost::intrusive_ptr<DocumentStorage> clone() const;
 
+    /**
+     * Constructs all the fields of '_bson' in the cache, including those of sub-documents, and
+     * loads the metadata. Lookups are then answered from the cache alone.
+     */
+    void loadIntoCache() const;
+
     size_t allocatedBytes() const {
         return !_cache ? 0 : (_cacheEnd - _cache + hashTabBytes());
     }
@@ -533,12 +608,25 @@ private:
 
     void loadLazyMetadata() const;
 
+    /**
+     * Returns the first field of '_bson' named 'name', or an EOO element if there is none. Scans
+     * '_bson' until the scans have examined kBsonFieldIndexMinScanned fields in total, and from
+     * then on looks the field up in '_bsonFieldIndex', so that reading a few fields of a wide
+     * document doesn't cost a scan of all the fields in front of each of them.
+     */
+    BSONElement findFieldInBson(StringData name) const;
+
+    /// Fills '_bsonFieldIndex' with the offsets of the fields of '_bson'.
+    void buildBsonFieldIndex() const;
+
     enum {
         HASH_TAB_INIT_SIZE = 8,  // must be power of 2
         HASH_TAB_MIN = 4,        // don't hash fields for docs smaller than this
                                  // set to 1 to always hash
     };
 
+    static constexpr unsigned kBsonFieldIndexMinScanned = 64;
+
     // _cache layout:
     // -------------------------------------------------------------------------------
     // | ValueElement1 Name1 | ValueElement2 Name2 | ... FREE SPACE ... | Hash Table |
@@ -581,6 +669,17 @@ private:
     // a conversion to BSON; i.e. if there are not any modifications we can directly return _bson.
     bool _modified{false};
 
+    // Set by loadIntoCache() once every field of '_bson' is in the cache, after which lookups no
+    // longer fall back to scanning '_bson'.
+    mutable bool _bsonLoadedIntoCache{false};
+
+    // The number of fields of '_bson' examined by findFieldInBson() while scanning it.
+    mutable unsigned _numBsonFieldsScanned{0};
+
+    // Open-addressed hash table of the offsets of the fields of '_bson' from its start, keyed by
+    // the hash of their names, with -1 marking an empty slot. Empty until it is built.
+    mutable std::vector<int> _bsonFieldIndex;
+
     // Defined in document.cpp
     static const DocumentStorage kEmptyDoc;
 
@@ -137,6 +137,151 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, FromBsonResetAfterAddingFields) {
+    auto bson = BSON("a" << 1 << "b"
+                         << "q");
+
+    MutableDocument md;
+    md.addField("x", mongo::Value(1));
+    md.addField("y", mongo::Value(2));
+    md.reset(bson, false);
+    md.addField("c", mongo::Value(3));
+
+    ASSERT_BSONOBJ_EQ(BSON("a" << 1 << "b"
+                               << "q"
+                               << "c" << 3),
+                      toBson(md.freeze()));
+}
+
+TEST(DocumentConstruction, LoadIntoCacheKeepsTheFieldsAndTheirOrder) {
+    auto bson = fromjson("{a: 1, b: {c: 2, d: [{e: 3}, 4]}, f: 'x'}");
+    auto document = fromBson(bson);
+    document.loadIntoCache();
+
+    ASSERT_VALUE_EQ(document["a"], mongo::Value(1));
+    ASSERT_VALUE_EQ(document.getNestedField(FieldPath("b.c")), mongo::Value(2));
+    ASSERT_VALUE_EQ(document["b"]["d"][0]["e"], mongo::Value(3));
+    ASSERT_TRUE(document["nonexistent"].missing());
+    ASSERT_EQ(document.computeSize(), 3UL);
+    ASSERT_BSONOBJ_EQ(bson, toBson(document));
+
+    // The document can still be modified through a MutableDocument.
+    MutableDocument md(document);
+    md.remove("a");
+    md.addField("g", mongo::Value(5));
+    ASSERT_BSONOBJ_EQ(fromjson("{b: {c: 2, d: [{e: 3}, 4]}, f: 'x', g: 5}"), toBson(md.freeze()));
+}
+
+TEST(DocumentConstruction, ResetToBsonOfSharesOnlyTheUnmodifiedBson) {
+    auto bson = fromjson("{a: 1, b: {c: 2}, d: 'x'}");
+    auto document = fromBson(bson);
+    ASSERT_VALUE_EQ(document["b"], mongo::Value(fromjson("{c: 2}")));
+    ASSERT_TRUE(document.hasUnmodifiedBson());
+
+    MutableDocument md;
+    md.resetToBsonOf(document);
+    md.setNestedField(FieldPath("b.c"), mongo::Value(3));
+    ASSERT_BSONOBJ_EQ(fromjson("{a: 1, b: {c: 3}, d: 'x'}"), toBson(md.freeze()));
+    ASSERT_BSONOBJ_EQ(bson, toBson(document));
+
+    // Neither modified fields nor added fields are in the BSON.
+    MutableDocument modified(document);
+    modified.setField("a", mongo::Value(2));
+    ASSERT_FALSE(modified.peek().hasUnmodifiedBson());
+    MutableDocument added;
+    added.addField("a", mongo::Value(1));
+    ASSERT_FALSE(added.peek().hasUnmodifiedBson());
+}
+
+TEST(DocumentGetField, LooksUpFieldsOfWideDocuments) {
+    BSONObjBuilder bob;
+    for (int i = 0; i < 500; ++i) {
+        bob.append("f" + std::to_string(i), i);
+    }
+    // A scan finds the first of the fields with the same name, and so must the lookups.
+    bob.append("f10", -1);
+    auto bson = bob.obj();
+
+    auto document = fromBson(bson);
+    for (int i = 499; i >= 0; i -= 7) {
+        ASSERT_VALUE_EQ(document["f" + std::to_string(i)], mongo::Value(i));
+    }
+    ASSERT_VALUE_EQ(document["f10"], mongo::Value(10));
+    ASSERT_TRUE(document["f500"].missing());
+    ASSERT_TRUE(document["nonexistent"].missing());
+    ASSERT_EQ(document.computeSize(), 501UL);
+    ASSERT_BSONOBJ_EQ(bson, toBson(document));
+
+    // Lookups which leave the fields out of the cache go through the same index.
+    auto other = fromBson(bson);
+    for (int i = 0; i < 500; i += 3) {
+        auto field = other.getNestedFieldNonCaching(FieldPath("f" + std::to_string(i)));
+        ASSERT_EQ(stdx::get<BSONElement>(field).numberInt(), i);
+    }
+
+    // Resetting a storage to other BSON forgets the lookups of the old BSON.
+    MutableDocument md;
+    md.reset(bson, false);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_VALUE_EQ(md.peek()["f" + std::to_string(i)], mongo::Value(i));
+    }
+    md.reset(BSON("f1" << "x"), false);
+    ASSERT_VALUE_EQ(md.peek()["f1"], mongo::Value("x"_sd));
+    ASSERT_TRUE(md.peek()["f2"].missing());
+}
+
+/**
+ * Returns the address of the name of the first field in 'document', which is stored in the field
+ * buffer of its storage.
+ */
+const char* firstFieldNameAddress(const mongo::Document& document) {
+    return document.fieldIterator().next().first.rawData();
+}
+
+TEST(DocumentStorageBufferCache, ReusesTheBuffersOfFreedDocumentsWhileActive) {
+    DocumentStorageBufferCache cache;
+    DocumentStorageBufferCache::Scope scope(&cache);
+
+    const char* firstAddress;
+    {
+        auto document = mongo::Document{{"a", 1}, {"b", 2}};
+        firstAddress = firstFieldNameAddress(document);
+    }
+    auto document = mongo::Document{{"c", 3}, {"d", 4}};
+    ASSERT_EQ(static_cast<const void*>(firstAddress),
+              static_cast<const void*>(firstFieldNameAddress(document)));
+    ASSERT_DOCUMENT_EQ(document, (mongo::Document{{"c", 3}, {"d", 4}}));
+}
+
+TEST(DocumentStorageBufferCache, NestedScopeKeepsTheOuterCacheActive) {
+    DocumentStorageBufferCache outerCache;
+    DocumentStorageBufferCache innerCache;
+    DocumentStorageBufferCache::Scope outerScope(&outerCache);
+
+    const char* firstAddress;
+    {
+        DocumentStorageBufferCache::Scope innerScope(&innerCache);
+        auto document = mongo::Document{{"a", 1}};
+        firstAddress = firstFieldNameAddress(document);
+    }
+    auto document = mongo::Document{{"b", 2}};
+    ASSERT_EQ(static_cast<const void*>(firstAddress),
+              static_cast<const void*>(firstFieldNameAddress(document)));
+}
+
+TEST(DocumentStorageBufferCache, DocumentsCanOutliveTheCache) {
+    boost::optional<mongo::Document> document;
+    {
+        auto cache = std::make_unique<DocumentStorageBufferCache>();
+        DocumentStorageBufferCache::Scope scope(cache.get());
+        mongo::Document{{"a", 1}};
+        document = mongo::Document{{"b", 2}};
+        cache->release();
+        mongo::Document{{"c", 3}};
+    }
+    ASSERT_DOCUMENT_EQ(*document, (mongo::Document{{"b", 2}}));
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
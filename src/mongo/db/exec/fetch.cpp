@@ -38,6 +38,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -56,16 +57,18 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
                        const Collection* collection)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
-      _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr) {
     _children.emplace_back(std::move(child));
+    if (_filter && internalQueryEnableCompiledMatchExpression.load()) {
+        _compiledFilter = std::make_unique<CompiledMatchExpression>(_filter);
+    }
 }
 
 FetchStage::~FetchStage() {}
 
 bool FetchStage::isEOF() {
-    if (WorkingSet::INVALID_ID != _idRetrying) {
-        // We have a working set member that we need to retry.
+    if (!_buffered.empty()) {
+        // We have working set members that we still need to return.
         return false;
     }
 
@@ -77,55 +80,103 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    // Either retry the last WSM we worked on or get a new one from our child.
-    WorkingSetID id;
-    StageState status;
-    if (_idRetrying == WorkingSet::INVALID_ID) {
-        status = child()->work(&id);
-    } else {
-        status = ADVANCED;
-        id = _idRetrying;
-        _idRetrying = WorkingSet::INVALID_ID;
+    // Buffer the members from our child until there are enough of them to fetch together. The
+    // batches start small so that a limit above us doesn't make us fetch more than it needs.
+    if (!_draining) {
+        WorkingSetID id = WorkingSet::INVALID_ID;
+        StageState status = child()->isEOF() ? PlanStage::IS_EOF : child()->work(&id);
+        if (PlanStage::ADVANCED == status) {
+            // The obj of a member may be owned by the storage cursor of our child.
+            _ws->get(id)->makeObjOwnedIfNeeded();
+            _buffered.push_back(id);
+            if (_buffered.size() < _batchSize) {
+                return PlanStage::NEED_TIME;
+            }
+        } else if (PlanStage::NEED_YIELD == status) {
+            *out = id;
+            return status;
+        } else if (PlanStage::IS_EOF != status) {
+            return status;
+        } else if (_buffered.empty()) {
+            return PlanStage::IS_EOF;
+        }
+
+        _draining = true;
+        _batchSize = std::min(_batchSize * 2,
+                              static_cast<size_t>(internalQueryExecFetchBatchSize.load()));
     }
 
-    if (PlanStage::ADVANCED == status) {
-        WorkingSetMember* member = _ws->get(id);
-
-        // If there's an obj there, there is no fetching to perform.
-        if (member->hasObj()) {
-            ++_specificStats.alreadyHasObj;
-        } else {
-            // We need a valid RecordId to fetch from and this is the only state that has one.
-            verify(WorkingSetMember::RID_AND_IDX == member->getState());
-            verify(member->hasRecordId());
-
-            try {
-                if (!_cursor)
-                    _cursor = collection()->getCursor(opCtx());
-
-                if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor, collection()->ns())) {
-                    _ws->free(id);
-                    return NEED_TIME;
-                }
-            } catch (const WriteConflictException&) {
-                // Ensure that the BSONObj underlying the WorkingSetMember is owned because it may
-                // be freed when we yield.
-                member->makeObjOwnedIfNeeded();
-                _idRetrying = id;
-                *out = WorkingSet::INVALID_ID;
-                return NEED_YIELD;
+    WorkingSetID id = _buffered.front();
+    WorkingSetMember* member = _ws->get(id);
+
+    // If there's an obj there, there is no fetching to perform.
+    if (member->hasObj()) {
+        ++_specificStats.alreadyHasObj;
+    } else {
+        // We need a valid RecordId to fetch from and this is the only state that has one.
+        verify(WorkingSetMember::RID_AND_IDX == member->getState());
+        verify(member->hasRecordId());
+
+        try {
+            if (!_cursor)
+                _cursor = collection()->getCursor(opCtx());
+
+            if (!_prefetched) {
+                prefetch();
             }
+        } catch (const WriteConflictException&) {
+            // The members stay buffered, and their records are read again after we yield.
+            _records.clear();
+            _prefetched = false;
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
         }
 
-        return returnIfMatches(member, id, out);
-    } else if (PlanStage::NEED_YIELD == status) {
-        *out = id;
+        if (!WorkingSetCommon::fetch(
+                opCtx(), _ws, id, std::move(_records.front()), collection()->ns())) {
+            _ws->free(id);
+            id = WorkingSet::INVALID_ID;
+        }
     }
 
-    return status;
+    _buffered.pop_front();
+    if (_prefetched) {
+        _records.pop_front();
+    }
+    if (_buffered.empty()) {
+        _draining = false;
+        _prefetched = false;
+    }
+
+    if (WorkingSet::INVALID_ID == id) {
+        return NEED_TIME;
+    }
+    return returnIfMatches(member, id, out);
+}
+
+void FetchStage::prefetch() {
+    std::vector<RecordId> recordIds;
+    for (auto&& id : _buffered) {
+        auto member = _ws->get(id);
+        if (!member->hasObj()) {
+            recordIds.push_back(member->recordId);
+        }
+    }
+    auto records = _cursor->multiGet(recordIds);
+
+    _records.clear();
+    auto record = records.begin();
+    for (auto&& id : _buffered) {
+        _records.push_back(_ws->get(id)->hasObj() ? boost::none : std::move(*record++));
+    }
+    _prefetched = true;
 }
 
 void FetchStage::doSaveStateRequiresCollection() {
+    // The records read for the buffered members belong to the snapshot we are giving up.
+    _records.clear();
+    _prefetched = false;
+
     if (_cursor) {
         _cursor->saveUnpositioned();
     }
@@ -167,7 +218,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (Filter::passes(member, _filter, _compiledFilter.get())) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
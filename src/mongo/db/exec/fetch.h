@@ -29,23 +29,28 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/record_store.h"
 
 namespace mongo {
 
-class SeekableRecordCursor;
-
 /**
  * This stage turns a RecordId into a BSONObj.
  *
  * In WorkingSetMember terms, it transitions from RID_AND_IDX to RID_AND_OBJ by reading
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
+ * The members from the child are buffered, in batches which grow up to
+ * internalQueryExecFetchBatchSize members, so that their records are read together with a single
+ * SeekableRecordCursor::multiGet(). The members are still returned in the order of the child.
+ *
  * Preconditions: Valid RecordId.
  */
 class FetchStage : public RequiresCollectionStage {
@@ -86,6 +91,11 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * Reads the records of the buffered members which don't have an obj yet into '_records'.
+     */
+    void prefetch();
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -95,8 +105,19 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
-    // If not Null, we use this rather than asking our child what to do next.
-    WorkingSetID _idRetrying;
+    // Evaluates '_filter' against the fetched documents, if it is enabled and '_filter' is set.
+    std::unique_ptr<CompiledMatchExpression> _compiledFilter;
+
+    // The members from the child which haven't been returned yet, and whether the stage is still
+    // adding members to them or is returning them.
+    std::deque<WorkingSetID> _buffered;
+    bool _draining = false;
+    size_t _batchSize = 1;
+
+    // When '_prefetched', the records read for the members in '_buffered', each at the same
+    // position as its member. They are read again after a yield.
+    std::deque<boost::optional<Record>> _records;
+    bool _prefetched = false;
 
     // Stats
     FetchStats _specificStats;
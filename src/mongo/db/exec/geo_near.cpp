@@ -49,8 +49,11 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/query/expression_index.h"
 #include "mongo/db/query/expression_index_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 
 #include <algorithm>
+#include <tuple>
 
 namespace mongo {
 
@@ -760,6 +763,58 @@ S2Region* buildS2Region(const R2Annulus& sphereBounds) {
     // Takes ownership of caps
     return new S2RegionIntersection(&regions);
 }
+
+/**
+ * Process-wide cache of the S2 coverings of geoNear annuli. Repeated queries around the same center
+ * usually expand through the same sequence of annuli, so their coverings are looked up here instead
+ * of being recomputed by the region coverer for every interval. The covering level and cell knobs
+ * are part of the key, since changing them changes the covering.
+ */
+class AnnulusCoveringCache {
+public:
+    // Center longitude and latitude, inner and outer radius, coarsest and finest level, max cells.
+    using Key = std::tuple<double, double, double, double, int, int, int>;
+
+    static AnnulusCoveringCache& get() {
+        static AnnulusCoveringCache cache(gInternalQueryS2GeoNearCoveringCacheSize);
+        return cache;
+    }
+
+    std::vector<S2CellId> getCovering(const R2Annulus& bounds, const S2Region& region) {
+        if (_maxSize == 0) {
+            return ExpressionMapping::get2dsphereCovering(region);
+        }
+
+        const Key key{bounds.center().x,
+                      bounds.center().y,
+                      bounds.getInner(),
+                      bounds.getOuter(),
+                      gInternalQueryS2GeoCoarsestLevel.load(),
+                      gInternalQueryS2GeoFinestLevel.load(),
+                      gInternalQueryS2GeoMaxCells.load()};
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto it = _cache.promote(key);
+            if (it != _cache.end()) {
+                return it->second;
+            }
+        }
+
+        // Compute the covering outside of the mutex, the coverer can be expensive.
+        auto cover = ExpressionMapping::get2dsphereCovering(region);
+        stdx::lock_guard<Latch> lk(_mutex);
+        _cache.add(key, cover);
+        return cover;
+    }
+
+private:
+    explicit AnnulusCoveringCache(size_t maxSize) : _maxSize(maxSize), _cache(maxSize) {}
+
+    const size_t _maxSize;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("AnnulusCoveringCache::_mutex");
+    LRUCache<Key, std::vector<S2CellId>> _cache;
+};
 }  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const Collection* collection,
@@ -964,7 +1019,7 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     scanParams.bounds.fields[s2FieldPosition].intervals.clear();
     std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
 
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
+    std::vector<S2CellId> cover = AnnulusCoveringCache::get().getCovering(_currBounds, *region);
 
     // Generate a covering that does not intersect with any previous coverings
     S2CellUnion coverUnion;
@@ -241,6 +241,10 @@ public:
     }
 
 private:
+    void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions) final {
+        _root->collectExpressions(expressions);
+    }
+
     // The InclusionNode tree does most of the execution work once constructed.
     std::unique_ptr<InclusionNode> _root;
 };
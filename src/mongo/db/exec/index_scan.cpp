@@ -83,6 +83,7 @@ IndexScan::IndexScan(ExpressionContext* expCtx,
     _specificStats.isSparse = params.indexDescriptor->isSparse();
     _specificStats.isPartial = params.indexDescriptor->isPartial();
     _specificStats.indexVersion = static_cast<int>(params.indexDescriptor->version());
+    _specificStats.estimatedKeysExamined = params.estimatedKeysExamined;
     _specificStats.collation = params.indexDescriptor->infoObj()
                                    .getObjectField(IndexDescriptor::kCollationFieldName)
                                    .getOwned();
@@ -213,7 +214,7 @@ PlanStage::StageState IndexScan::doWork(WorkingSetID* out) {
 
     if (_shouldDedup) {
         ++_specificStats.dupsTested;
-        if (!_returned.insert(kv->loc).second) {
+        if (!_returned.insert(kv->loc)) {
             // We've seen this RecordId before. Skip it this time.
             ++_specificStats.dupsDropped;
             return PlanStage::NEED_TIME;
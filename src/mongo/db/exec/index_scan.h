@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -37,7 +38,6 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/sorted_data_interface.h"
-#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 
@@ -80,6 +80,9 @@ struct IndexScanParams {
 
     // Do we want to add the key as metadata?
     bool addKeyMetadata{false};
+
+    // The number of keys the scan is expected to examine, if the index has statistics.
+    boost::optional<double> estimatedKeysExamined;
 };
 
 /**
@@ -168,7 +171,7 @@ private:
     ScanState _scanState = ScanState::INITIALIZING;
 
     // Could our index have duplicates?  If so, we use _returned to dedup.
-    stdx::unordered_set<RecordId, RecordId::Hasher> _returned;
+    RecordIdBitmap _returned;
 
     //
     // This class employs one of two different algorithms for determining when the index scan
@@ -94,18 +94,16 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
                 } else {
                     ++_specificStats.dupsTested;
                     // ...and there's a RecordId and and we've seen the RecordId before
-                    if (_seen.end() != _seen.find(member->recordId)) {
+                    // (noting it as seen otherwise)...
+                    if (!_seen.insert(member->recordId)) {
                         // ...drop it.
                         _ws->free(id);
                         ++_specificStats.dupsDropped;
                         return PlanStage::NEED_TIME;
-                    } else {
-                        // Otherwise, note that we've seen it.
-                        _seen.insert(member->recordId);
-                        // We're going to use the result from the child, so we remove it from
-                        // the queue of children without a result.
-                        _noResultToMerge.pop();
                     }
+                    // We're going to use the result from the child, so we remove it from the
+                    // queue of children without a result.
+                    _noResultToMerge.pop();
                 }
             } else {
                 // Not deduping.  We use any result we get from the child.  Remove the child
@@ -34,6 +34,7 @@
 #include "mongo/db/exec/plan_stage.h"
 
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 
 namespace mongo {
@@ -81,4 +82,17 @@ ClockSource* PlanStage::getClock() const {
     return _opCtx->getServiceContext()->getFastClockSource();
 }
 
+TickSource* PlanStage::getTickSource() const {
+    return _opCtx->getServiceContext()->getTickSource();
+}
+
+void PlanStage::enableTiming() {
+    _commonStats.executionTimeMillis.emplace(0);
+
+    _timingSampleRate = internalQueryExecStageTimingSampleRate.load();
+    if (_timingSampleRate) {
+        _commonStats.sampledExecutionTimeMicros.emplace(0);
+    }
+}
+
 }  // namespace mongo
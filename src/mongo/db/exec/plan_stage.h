@@ -114,7 +114,7 @@ public:
         if (expCtx->explain || expCtx->mayDbProfile) {
             // Populating the field for execution time indicates that this stage should time each
             // call to work().
-            _commonStats.executionTimeMillis.emplace(0);
+            enableTiming();
         }
     }
 
@@ -196,7 +196,8 @@ public:
      * Throws an exception if an error is encountered while executing the query.
      */
     StageState work(WorkingSetID* out) {
-        auto optTimer(getOptTimer());
+        auto optTimer(getOptWorkTimer());
+        auto optSampledTimer(getOptSampledWorkTimer());
 
         ++_commonStats.works;
 
@@ -344,7 +345,7 @@ public:
      */
     void markShouldCollectTimingInfo() {
         invariant(!_commonStats.executionTimeMillis || *_commonStats.executionTimeMillis == 0);
-        _commonStats.executionTimeMillis.emplace(0);
+        enableTiming();
     }
 
 protected:
@@ -404,10 +405,46 @@ protected:
         return boost::none;
     }
 
+    /**
+     * Returns the timer for the current call to work(), when every call is timed.
+     */
+    boost::optional<ScopedTimer> getOptWorkTimer() {
+        if (_timingSampleRate) {
+            return boost::none;
+        }
+
+        return getOptTimer();
+    }
+
+    /**
+     * Returns the timer for the current call to work(), when only a sample of the calls is timed
+     * and the current call is part of it.
+     */
+    boost::optional<SampledScopedTimer> getOptSampledWorkTimer() {
+        if (_timingSampleRate && _commonStats.works % _timingSampleRate == 0) {
+            return {{getTickSource(),
+                     _timingSampleRate,
+                     _commonStats.sampledExecutionTimeMicros.get_ptr(),
+                     _commonStats.executionTimeMillis.get_ptr()}};
+        }
+
+        return boost::none;
+    }
+
     Children _children;
     CommonStats _commonStats;
 
 private:
+    /**
+     * Populates the fields for execution time, according to internalQueryExecStageTimingSampleRate.
+     */
+    void enableTiming();
+
+    TickSource* getTickSource() const;
+
+    // When non-zero, only one in this many calls to work() is timed, with the tick source.
+    long long _timingSampleRate = 0;
+
     OperationContext* _opCtx;
 
     // The PlanExecutor holds a strong reference to this which ensures that this pointer remains
@@ -37,6 +37,7 @@
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/query/stage_types.h"
+#include "mongo/db/record_id.h"
 #include "mongo/util/container_size_helper.h"
 #include "mongo/util/time_support.h"
 
@@ -99,6 +100,12 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // Estimate of the time elapsed while working inside this stage, extrapolated from the calls
+    // which were timed precisely. Only set when timing a sample of the calls, as configured by
+    // internalQueryExecStageTimingSampleRate, in which case 'executionTimeMillis' is derived from
+    // it as well.
+    boost::optional<long long> sampledExecutionTimeMicros;
+
     // TODO: have some way of tracking WSM sizes (or really any series of #s).  We can measure
     // the size of our inputs and the size of our outputs.  We can do a lot with the WS here.
 
@@ -249,6 +256,11 @@ struct CollectionScanStats : public SpecificStats {
     // document that does not pass the filter and has a "ts" Timestamp field greater than 'maxTs'.
     // Must only be set on forward oplog scans.
     boost::optional<Timestamp> maxTs;
+
+    // The bounds on the RecordIds of the records the scan returns, for scans of clustered
+    // collections.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
 };
 
 struct CountStats : public SpecificStats {
@@ -534,6 +546,9 @@ struct IndexScanStats : public SpecificStats {
 
     // Number of times the index cursor is re-positioned during the execution of the scan.
     size_t seeks;
+
+    // Number of entries the scan was expected to retrieve according to the index statistics.
+    boost::optional<double> estimatedKeysExamined;
 };
 
 struct LimitStats : public SpecificStats {
@@ -637,6 +652,9 @@ struct SortStats : public SpecificStats {
 
     // Whether we spilled data to disk during the execution of this query.
     bool wasDiskUsed = false;
+
+    // The number of sorted runs spilled to disk during the execution of this query.
+    uint64_t spills = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -35,6 +35,7 @@
 #include <memory>
 
 #include "mongo/bson/bsonelement.h"
+#include "mongo/db/pipeline/expression_common_subexpression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/transformer_interface.h"
@@ -74,13 +75,24 @@ public:
      * Apply the projection transformation.
      */
     Document applyTransformation(const Document& input) override {
+        resetCommonSubexpressions();
         auto output = applyProjection(input);
         if (_rootReplacementExpression) {
-            return _applyRootReplacementExpression(input, output);
+            output = _applyRootReplacementExpression(input, output);
         }
+        resetCommonSubexpressions();
         return output;
     }
 
+    void eliminateCommonSubexpressions() final {
+        std::vector<boost::intrusive_ptr<Expression>*> expressions;
+        if (_rootReplacementExpression) {
+            expressions.push_back(&_rootReplacementExpression);
+        }
+        collectExpressions(&expressions);
+        _commonSubexpressions = ExpressionCommonSubexpression::eliminate(expressions);
+    }
+
     /**
      * Sets 'expr' as a root-replacement expression to this tree. A root-replacement expression,
      * once evaluated, will replace an entire output document. A projection post image document
@@ -110,6 +122,12 @@ protected:
      */
     virtual Document applyProjection(const Document& input) const = 0;
 
+    /**
+     * Appends a pointer to each expression which computes a field of the projection to
+     * 'expressions'.
+     */
+    virtual void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions) {}
+
     boost::intrusive_ptr<ExpressionContext> _expCtx;
 
     ProjectionPolicies _policies;
@@ -117,6 +135,12 @@ protected:
     boost::intrusive_ptr<Expression> _rootReplacementExpression;
 
 private:
+    void resetCommonSubexpressions() {
+        for (auto&& subexpression : _commonSubexpressions) {
+            subexpression->reset();
+        }
+    }
+
     Document _applyRootReplacementExpression(const Document& input, const Document& output) {
         using namespace fmt::literals;
 
@@ -133,5 +157,9 @@ private:
     // root-replacement expressions which apply projection to the entire post-image document, rather
     // than to a specific field.
     Variables::Id _projectionPostImageVarId;
+
+    // The subexpressions shared by eliminateCommonSubexpressions(), which are reset before and
+    // after each document.
+    std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>> _commonSubexpressions;
 };
 }  // namespace mongo::projection_executor
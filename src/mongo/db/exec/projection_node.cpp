@@ -269,6 +269,16 @@ void ProjectionNode::optimize() {
     _maxFieldsToProject = maxFieldsToProject();
 }
 
+void ProjectionNode::collectExpressions(
+    std::vector<boost::intrusive_ptr<Expression>*>* expressions) {
+    for (auto&& expressionIt : _expressions) {
+        expressions->push_back(&expressionIt.second);
+    }
+    for (auto&& childPair : _children) {
+        childPair.second->collectExpressions(expressions);
+    }
+}
+
 Document ProjectionNode::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument outputDoc;
     serialize(explain, &outputDoc);
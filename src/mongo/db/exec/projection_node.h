@@ -128,6 +128,12 @@ public:
 
     void optimize();
 
+    /**
+     * Appends a pointer to each expression which computes a field of this node or of one of its
+     * descendants to 'expressions'.
+     */
+    void collectExpressions(std::vector<boost::intrusive_ptr<Expression>*>* expressions);
+
     Document serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
 
     void serialize(boost::optional<ExplainOptions::Verbosity> explain,
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mongo {
+
+bool RecordIdBitmap::Container::insert(uint16_t low) {
+    if (bitmap) {
+        uint64_t& word = bitmap[low / 64];
+        const uint64_t bit = uint64_t{1} << (low % 64);
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++cardinality;
+        return true;
+    }
+
+    // RecordIds mostly arrive in increasing order, in which case this appends.
+    auto pos = array.empty() || array.back() < low
+        ? array.end()
+        : std::lower_bound(array.begin(), array.end(), low);
+    if (pos != array.end() && *pos == low) {
+        return false;
+    }
+    array.insert(pos, low);
+    ++cardinality;
+
+    if (cardinality > kMaxArrayCardinality) {
+        bitmap = std::make_unique<uint64_t[]>(kBitmapWords);
+        std::memset(bitmap.get(), 0, kBitmapWords * sizeof(uint64_t));
+        for (auto value : array) {
+            bitmap[value / 64] |= uint64_t{1} << (value % 64);
+        }
+        array.clear();
+        array.shrink_to_fit();
+    }
+    return true;
+}
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (bitmap) {
+        return bitmap[low / 64] & (uint64_t{1} << (low % 64));
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool RecordIdBitmap::insert(const RecordId& id) {
+    const int64_t repr = id.repr();
+    if (!_containers[repr >> 16].insert(static_cast<uint16_t>(repr & 0xFFFF))) {
+        return false;
+    }
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(const RecordId& id) const {
+    const int64_t repr = id.repr();
+    auto it = _containers.find(repr >> 16);
+    return it != _containers.end() && it->second.contains(static_cast<uint16_t>(repr & 0xFFFF));
+}
+
+void RecordIdBitmap::clear() {
+    _containers.clear();
+    _size = 0;
+}
+
+size_t RecordIdBitmap::memUsage() const {
+    size_t bytes =
+        sizeof(*this) + _containers.capacity() * sizeof(decltype(_containers)::value_type);
+    for (auto&& [key, container] : _containers) {
+        bytes += container.bitmap ? kBitmapWords * sizeof(uint64_t)
+                                  : container.array.capacity() * sizeof(uint16_t);
+    }
+    return bytes;
+}
+
+}  // namespace mongo
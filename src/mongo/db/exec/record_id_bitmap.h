@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+
+namespace mongo {
+
+/**
+ * A compact set of RecordIds, used by plan stages which deduplicate their results on RecordId.
+ *
+ * RecordIds are partitioned on their high 48 bits into containers of up to 2^16 ids each, in the
+ * style of a roaring bitmap: a sparse container stores the low 16 bits of its ids as a sorted
+ * array, and a dense one as a bitmap of 8KB. Since RecordIds are mostly allocated sequentially,
+ * this takes a few bytes per id at most, where a node-based hash set takes several tens.
+ */
+class RecordIdBitmap {
+public:
+    /**
+     * Adds 'id' to the set. Returns true if it was not in the set already.
+     */
+    bool insert(const RecordId& id);
+
+    bool contains(const RecordId& id) const;
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    void clear();
+
+    /**
+     * Returns an estimate of the memory used by the set, in bytes.
+     */
+    size_t memUsage() const;
+
+private:
+    // A sorted array of more than this many ids takes more space than a bitmap.
+    static constexpr size_t kMaxArrayCardinality = 4096;
+    static constexpr size_t kBitmapWords = (1 << 16) / 64;
+
+    struct Container {
+        bool insert(uint16_t low);
+        bool contains(uint16_t low) const;
+
+        std::vector<uint16_t> array;
+        std::unique_ptr<uint64_t[]> bitmap;
+        size_t cardinality = 0;
+    };
+
+    absl::flat_hash_map<int64_t, Container> _containers;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
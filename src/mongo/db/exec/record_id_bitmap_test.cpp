@@ -0,0 +1,99 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <set>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, InsertReportsDuplicates) {
+    RecordIdBitmap set;
+    ASSERT_TRUE(set.empty());
+    ASSERT_TRUE(set.insert(RecordId(5)));
+    ASSERT_TRUE(set.insert(RecordId(3)));
+    ASSERT_FALSE(set.insert(RecordId(5)));
+    ASSERT_FALSE(set.insert(RecordId(3)));
+    ASSERT_EQ(2U, set.size());
+    ASSERT_TRUE(set.contains(RecordId(3)));
+    ASSERT_FALSE(set.contains(RecordId(4)));
+
+    set.clear();
+    ASSERT_TRUE(set.empty());
+    ASSERT_FALSE(set.contains(RecordId(3)));
+    ASSERT_TRUE(set.insert(RecordId(3)));
+}
+
+TEST(RecordIdBitmapTest, SeparatesIdsWhichShareTheirLowBits) {
+    RecordIdBitmap set;
+    const int64_t ids[] = {1, 1 + (int64_t{1} << 16), 1 + (int64_t{1} << 40), -1, -1 - (1 << 16)};
+    for (auto id : ids) {
+        ASSERT_TRUE(set.insert(RecordId(id)));
+    }
+    for (auto id : ids) {
+        ASSERT_TRUE(set.contains(RecordId(id)));
+        ASSERT_FALSE(set.insert(RecordId(id)));
+    }
+    ASSERT_FALSE(set.contains(RecordId(2)));
+    ASSERT_TRUE(set.insert(RecordId(RecordId::kMinRepr)));
+    ASSERT_TRUE(set.insert(RecordId(RecordId::kMaxRepr)));
+    ASSERT_EQ(7U, set.size());
+}
+
+TEST(RecordIdBitmapTest, DenseContainersMatchAnOrderedSet) {
+    RecordIdBitmap set;
+    std::set<int64_t> expected;
+    PseudoRandom random(12345);
+    for (int i = 0; i < 50000; ++i) {
+        const int64_t id = random.nextInt32(100000);
+        ASSERT_EQ(expected.insert(id).second, set.insert(RecordId(id)));
+    }
+    ASSERT_EQ(expected.size(), set.size());
+    for (int64_t id = 0; id < 100000; ++id) {
+        ASSERT_EQ(expected.count(id) == 1, set.contains(RecordId(id)));
+    }
+}
+
+TEST(RecordIdBitmapTest, SequentialIdsUseLittleMemory) {
+    RecordIdBitmap set;
+    for (int64_t id = 1; id <= 1000000; ++id) {
+        ASSERT_TRUE(set.insert(RecordId(id)));
+    }
+    ASSERT_EQ(1000000U, set.size());
+    ASSERT_LT(set.memUsage(), 1000000U / 4);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -747,6 +747,14 @@ value::SlotId RuntimeEnvironment::getSlot(StringData type) {
     uasserted(4946305, str::stream() << "environment slot is not registered for type: " << type);
 }
 
+boost::optional<value::SlotId> RuntimeEnvironment::getSlotIfExists(StringData type) {
+    if (auto it = _state->slots.find(type); it != _state->slots.end()) {
+        return it->second.first;
+    }
+
+    return boost::none;
+}
+
 void RuntimeEnvironment::resetSlot(value::SlotId slot,
                                    value::TypeTags tag,
                                    value::Value val,
@@ -780,6 +788,23 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+    env->_state->slots = _state->slots;
+    env->_state->owned = _state->owned;
+    for (size_t idx = 0; idx < _state->vals.size(); ++idx) {
+        auto [tag, val] = _state->owned[idx]
+            ? copyValue(_state->typeTags[idx], _state->vals[idx])
+            : std::make_pair(_state->typeTags[idx], _state->vals[idx]);
+        env->_state->typeTags.push_back(tag);
+        env->_state->vals.push_back(val);
+    }
+    for (auto&& [type, slot] : env->_state->slots) {
+        env->emplaceAccessor(slot.first, slot.second);
+    }
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     *builder << "env: { ";
     for (auto&& [type, slot] : _state->slots) {
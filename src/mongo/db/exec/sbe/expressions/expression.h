@@ -92,6 +92,12 @@ public:
      */
     value::SlotId getSlot(StringData type);
 
+    /**
+     * Returns a SlotId registered for the given slot 'type', or boost::none if the slot hasn't been
+     * registered.
+     */
+    boost::optional<value::SlotId> getSlotIfExists(StringData type);
+
     /**
      * Store the given value in the specified slot within this runtime environment instance.
      *
@@ -118,6 +124,12 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make a copy of this environment with its own copies of the owned slot values, which can be
+     * reset without affecting this environment. Unowned values are shared.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -855,7 +855,10 @@ void Parser::walkGroup(AstQuery& ast) {
 
     ast.stage = makeS<HashAggStage>(std::move(ast.nodes[2]->stage),
                                     lookupSlots(std::move(ast.nodes[0]->identifiers)),
-                                    lookupSlots(std::move(ast.nodes[1]->projects)));
+                                    lookupSlots(std::move(ast.nodes[1]->projects)),
+                                    makeEM(),
+                                    std::numeric_limits<size_t>::max(),
+                                    false);
 }
 
 void Parser::walkHashJoin(AstQuery& ast) {
@@ -866,8 +869,9 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(ast.nodes[0]->nodes[0]->identifiers),  // outer conditions
                              lookupSlots(ast.nodes[0]->nodes[1]->identifiers),  // outer projections
                              lookupSlots(ast.nodes[1]->nodes[0]->identifiers),  // inner conditions
-                             lookupSlots(ast.nodes[1]->nodes[1]->identifiers)   // inner projections
-        );
+                             lookupSlots(ast.nodes[1]->nodes[1]->identifiers),  // inner projections
+                             std::numeric_limits<size_t>::max(),
+                             false);
 }
 
 void Parser::walkNLJoin(AstQuery& ast) {
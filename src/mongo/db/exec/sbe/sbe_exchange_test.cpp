@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::ExchangeConsumer and sbe::ExchangeProducer.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/exchange.h"
+
+namespace mongo::sbe {
+
+using ExchangeStageTest = PlanStageTestFixture;
+
+TEST_F(ExchangeStageTest, RoundRobinGathersOutputOfAllProducers) {
+    const size_t numProducers = 4;
+    const int64_t numInputs = 1000;
+
+    // Make an input array containing 64-integers 0 thru 999, inclusive.
+    auto [inputTag, inputVal] = value::makeNewArray();
+    value::ValueGuard inputGuard{inputTag, inputVal};
+    auto inputView = value::getArrayView(inputVal);
+    for (int64_t i = 0; i < numInputs; ++i) {
+        inputView->push_back(value::TypeTags::NumberInt64, i);
+    }
+
+    // Every producer runs its own clone of the mock scan, so each input value is expected to be
+    // gathered once per producer.
+    inputGuard.reset();
+    auto [scanSlot, scanStage] = generateMockScan(inputTag, inputVal);
+    auto exchange = makeS<ExchangeConsumer>(std::move(scanStage),
+                                            numProducers,
+                                            makeSV(scanSlot),
+                                            ExchangePolicy::roundrobin,
+                                            nullptr,
+                                            nullptr);
+
+    auto resultAccessor = prepareTree(exchange.get(), scanSlot);
+
+    std::map<int64_t, size_t> counts;
+    while (exchange->getNext() == PlanState::ADVANCED) {
+        auto [tag, val] = resultAccessor->getViewOfValue();
+        ASSERT_TRUE(tag == value::TypeTags::NumberInt64);
+        ++counts[value::bitcastTo<int64_t>(val)];
+    }
+    exchange->close();
+
+    ASSERT_EQ(counts.size(), static_cast<size_t>(numInputs));
+    for (auto&& [value, count] : counts) {
+        ASSERT_GTE(value, 0);
+        ASSERT_LT(value, numInputs);
+        ASSERT_EQ(count, numProducers);
+    }
+}
+
+}  // namespace mongo::sbe
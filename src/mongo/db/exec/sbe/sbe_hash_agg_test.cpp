@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+/**
+ * This file contains tests for sbe::HashAggStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+
+class HashAggStageTest : public PlanStageTestFixture {
+public:
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _tempDir = std::make_unique<unittest::TempDir>("sbe_hash_agg_test");
+        _oldDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir->path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _oldDbPath;
+        _tempDir.reset();
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Builds a HashAggStage which groups by the first input slot and sums up the second input
+     * slot, merging spilled partial sums with another sum.
+     */
+    MakeStageFn<value::SlotVector> makeSumStageFn(size_t memoryLimit, bool allowDiskUse) {
+        return [this, memoryLimit, allowDiskUse](value::SlotVector scanSlots,
+                                                 std::unique_ptr<PlanStage> scanStage) {
+            auto sumSlot = generateSlotId();
+            auto stage = makeS<HashAggStage>(
+                std::move(scanStage),
+                makeSV(scanSlots[0]),
+                makeEM(sumSlot,
+                       makeE<EFunction>("sum", makeEs(makeE<EVariable>(scanSlots[1])))),
+                makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(sumSlot)))),
+                memoryLimit,
+                allowDiskUse);
+            return std::make_pair(makeSV(scanSlots[0], sumSlot), std::move(stage));
+        };
+    }
+
+private:
+    std::unique_ptr<unittest::TempDir> _tempDir;
+    std::string _oldDbPath;
+};
+
+TEST_F(HashAggStageTest, SpilledGroupsAreMergedInKeyOrder) {
+    auto [inputTag, inputVal] =
+        makeValue(BSON_ARRAY(BSON_ARRAY(3 << 1) << BSON_ARRAY(1 << 2) << BSON_ARRAY(2 << 3)
+                                                << BSON_ARRAY(1 << 4) << BSON_ARRAY(3 << 5)
+                                                << BSON_ARRAY(1 << 6)));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = makeValue(
+        BSON_ARRAY(BSON_ARRAY(1 << 12) << BSON_ARRAY(2 << 3) << BSON_ARRAY(3 << 6)));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    // A memory limit of a single byte forces the hash table to be spilled after every row.
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeSumStageFn(1, true));
+}
+
+TEST_F(HashAggStageTest, SpillingIsReportedInStats) {
+    auto [scanSlots, scanStage] = generateMockScanMulti(
+        2, BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(2 << 2) << BSON_ARRAY(1 << 3)));
+    auto [outSlots, stage] = makeSumStageFn(1, true)(scanSlots, std::move(scanStage));
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), accessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_EQ(stats->spills, 3U);
+    ASSERT_EQ(stats->spilledRecords, 3U);
+    ASSERT_GT(stats->spilledBytes, 0U);
+}
+
+TEST_F(HashAggStageTest, ExceedingMemoryLimitWithoutDiskUseFails) {
+    auto [scanSlots, scanStage] = generateMockScanMulti(
+        2, BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(2 << 2) << BSON_ARRAY(3 << 3)));
+    auto [outSlots, stage] = makeSumStageFn(1, false)(scanSlots, std::move(scanStage));
+
+    ASSERT_THROWS_CODE(prepareTree(stage.get(), outSlots),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashAggStageTest, NoSpillingBelowMemoryLimit) {
+    auto [scanSlots, scanStage] = generateMockScanMulti(
+        2, BSON_ARRAY(BSON_ARRAY(1 << 1) << BSON_ARRAY(1 << 2) << BSON_ARRAY(1 << 3)));
+    auto [outSlots, stage] =
+        makeSumStageFn(100 * 1024 * 1024, false)(scanSlots, std::move(scanStage));
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT_TRUE(stage->getNext() == PlanState::ADVANCED);
+    auto [sumTag, sumVal] = accessors[1]->getViewOfValue();
+    ASSERT_TRUE(
+        valueEquals(sumTag, sumVal, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(6)));
+    ASSERT_TRUE(stage->getNext() == PlanState::IS_EOF);
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_FALSE(stats->usedDisk);
+    ASSERT_EQ(stats->spills, 0U);
+}
+
+}  // namespace mongo::sbe
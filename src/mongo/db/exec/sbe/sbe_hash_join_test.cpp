@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::HashJoinStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo::sbe {
+
+class HashJoinStageTest : public PlanStageTestFixture {
+public:
+    using JoinedRow = std::tuple<int32_t, int32_t, int32_t>;
+
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _tempDir = std::make_unique<unittest::TempDir>("sbe_hash_join_test");
+        _oldDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir->path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _oldDbPath;
+        _tempDir.reset();
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Builds a HashJoinStage which joins [key, value] rows of 'outer' and 'inner' on the key.
+     * Produces [key, outer value, inner value] rows.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeJoin(BSONArray outer,
+                                                                     BSONArray inner,
+                                                                     size_t memoryLimit,
+                                                                     bool allowDiskUse) {
+        auto [outerSlots, outerStage] = generateMockScanMulti(2, outer);
+        auto [innerSlots, innerStage] = generateMockScanMulti(2, inner);
+        auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                          std::move(innerStage),
+                                          makeSV(outerSlots[0]),
+                                          makeSV(outerSlots[1]),
+                                          makeSV(innerSlots[0]),
+                                          makeSV(innerSlots[1]),
+                                          memoryLimit,
+                                          allowDiskUse);
+        return {makeSV(outerSlots[0], outerSlots[1], innerSlots[1]), std::move(stage)};
+    }
+
+    /**
+     * Returns all rows produced by 'stage' sorted, as the grace hash join mode does not preserve
+     * the order of the inner side.
+     */
+    std::vector<JoinedRow> getAllRowsSorted(PlanStage* stage,
+                                            const std::vector<value::SlotAccessor*>& accessors) {
+        std::vector<JoinedRow> rows;
+        while (stage->getNext() == PlanState::ADVANCED) {
+            std::array<int32_t, 3> row;
+            for (size_t idx = 0; idx < row.size(); ++idx) {
+                auto [tag, val] = accessors[idx]->getViewOfValue();
+                ASSERT_TRUE(tag == value::TypeTags::NumberInt32);
+                row[idx] = value::bitcastTo<int32_t>(val);
+            }
+            rows.emplace_back(row[0], row[1], row[2]);
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+private:
+    std::unique_ptr<unittest::TempDir> _tempDir;
+    std::string _oldDbPath;
+};
+
+TEST_F(HashJoinStageTest, PartitionedJoinMatchesInMemoryJoin) {
+    auto outer = BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20) << BSON_ARRAY(3 << 30)
+                                                << BSON_ARRAY(1 << 11) << BSON_ARRAY(4 << 40));
+    auto inner = BSON_ARRAY(BSON_ARRAY(1 << 100) << BSON_ARRAY(3 << 300) << BSON_ARRAY(5 << 500)
+                                                 << BSON_ARRAY(1 << 101));
+    const std::vector<JoinedRow> expected = {
+        {1, 10, 100}, {1, 10, 101}, {1, 11, 100}, {1, 11, 101}, {3, 30, 300}};
+
+    auto [inMemorySlots, inMemoryStage] =
+        makeJoin(outer, inner, std::numeric_limits<size_t>::max(), false);
+    auto inMemoryAccessors = prepareTree(inMemoryStage.get(), inMemorySlots);
+    ASSERT(getAllRowsSorted(inMemoryStage.get(), inMemoryAccessors) == expected);
+
+    // A memory limit of a single byte forces the stage into the grace hash join mode after the
+    // first outer row.
+    auto [partitionedSlots, partitionedStage] = makeJoin(outer, inner, 1, true);
+    auto partitionedAccessors = prepareTree(partitionedStage.get(), partitionedSlots);
+    ASSERT(getAllRowsSorted(partitionedStage.get(), partitionedAccessors) == expected);
+}
+
+TEST_F(HashJoinStageTest, PartitioningIsReportedInStats) {
+    auto [outSlots, stage] =
+        makeJoin(BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20)),
+                 BSON_ARRAY(BSON_ARRAY(1 << 100) << BSON_ARRAY(2 << 200) << BSON_ARRAY(3 << 300)),
+                 1,
+                 true);
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT_EQ(getAllRowsSorted(stage.get(), accessors).size(), 2U);
+
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_GT(stats->numPartitions, 0U);
+    ASSERT_EQ(stats->spilledOuterRecords, 2U);
+    ASSERT_EQ(stats->spilledInnerRecords, 3U);
+}
+
+TEST_F(HashJoinStageTest, ReopenAfterPartitioning) {
+    auto [outSlots, stage] = makeJoin(BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20)),
+                                      BSON_ARRAY(BSON_ARRAY(2 << 200) << BSON_ARRAY(1 << 100)),
+                                      1,
+                                      true);
+    const std::vector<JoinedRow> expected = {{1, 10, 100}, {2, 20, 200}};
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT(getAllRowsSorted(stage.get(), accessors) == expected);
+
+    stage->close();
+    stage->open(false);
+    ASSERT(getAllRowsSorted(stage.get(), accessors) == expected);
+}
+
+TEST_F(HashJoinStageTest, ExceedingMemoryLimitWithoutDiskUseFails) {
+    auto [outSlots, stage] = makeJoin(BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20)),
+                                      BSON_ARRAY(BSON_ARRAY(1 << 100)),
+                                      1,
+                                      false);
+
+    ASSERT_THROWS_CODE(prepareTree(stage.get(), outSlots),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+}  // namespace mongo::sbe
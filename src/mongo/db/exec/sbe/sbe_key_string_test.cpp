@@ -200,4 +200,31 @@ TEST(SBEKeyStringTest, KeyComponentInclusion) {
         << "Incorrect value from accessor: " << valueDebugString(value);
 }
 
+TEST(SBEKeyStringTest, SkippedKeyComponentsKeepTypeBitsInStep) {
+    // The skipped components all have type bits, which have to be read past for the included
+    // components after them to be converted to the right types.
+    auto key = BSON("" << 5 << "" << 1.5 << "" << Decimal128("2.50") << "" << 7 << "" << 3.0);
+    auto ordering =
+        Ordering::make(BSON("a" << 1 << "b" << -1 << "c" << 1 << "d" << -1 << "e" << 1));
+    KeyString::Builder keyStringBuilder(KeyString::Version::V1, key, ordering);
+    auto keyString = keyStringBuilder.getValueCopy();
+
+    IndexKeysInclusionSet indexKeysToInclude;
+    indexKeysToInclude.set(3);
+    indexKeysToInclude.set(4);
+
+    std::vector<value::ViewOfValueAccessor> accessors;
+    accessors.resize(2);
+
+    BufBuilder builder;
+    readKeyStringValueIntoAccessors(keyString, ordering, &builder, &accessors, indexKeysToInclude);
+
+    ASSERT(std::make_pair(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7)) ==
+           accessors[0].getViewOfValue())
+        << "Incorrect value from accessor: " << valueDebugString(accessors[0].getViewOfValue());
+    ASSERT(std::make_pair(value::TypeTags::NumberDouble, value::bitcastFrom<double>(3.0)) ==
+           accessors[1].getViewOfValue())
+        << "Incorrect value from accessor: " << valueDebugString(accessors[1].getViewOfValue());
+}
+
 }  // namespace mongo::sbe
@@ -0,0 +1,114 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::value::MaterializedRowHashMap.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/materialized_row_hash_map.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+value::MaterializedRow makeIntRow(int64_t i) {
+    value::MaterializedRow row{1};
+    row.reset(0, false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+    return row;
+}
+
+value::MaterializedRow makeStringRow(StringData str) {
+    value::MaterializedRow row{1};
+    auto [tag, val] = value::makeNewString({str.rawData(), str.size()});
+    row.reset(0, true, tag, val);
+    return row;
+}
+}  // namespace
+
+TEST(MaterializedRowHashMapTest, InsertAndFind) {
+    value::MaterializedRowHashMap<int> map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.find(makeIntRow(1)) == map.end());
+
+    auto [it, inserted] = map.try_emplace(makeIntRow(1), 10);
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->second, 10);
+
+    std::tie(it, inserted) = map.try_emplace(makeIntRow(1), 20);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(it->second, 10);
+
+    map[makeStringRow("a long string key which is not stored inline")] = 30;
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(map.find(makeStringRow("a long string key which is not stored inline"))->second, 30);
+    ASSERT_TRUE(map.find(makeIntRow(2)) == map.end());
+}
+
+TEST(MaterializedRowHashMapTest, IteratorsSurviveGrowth) {
+    value::MaterializedRowHashMap<int64_t> map;
+    auto first = map.try_emplace(makeIntRow(0), 0).first;
+
+    const int64_t count = 10000;
+    for (int64_t i = 1; i < count; ++i) {
+        ASSERT_TRUE(map.try_emplace(makeIntRow(i), i).second);
+    }
+    ASSERT_EQ(map.size(), static_cast<size_t>(count));
+    ASSERT_EQ(first->second, 0);
+
+    // Entries are iterated in insertion order.
+    int64_t expected = 0;
+    for (auto& [key, value] : map) {
+        ASSERT_EQ(value, expected++);
+    }
+
+    for (int64_t i = 0; i < count; ++i) {
+        auto it = map.find(makeIntRow(i));
+        ASSERT_TRUE(it != map.end());
+        ASSERT_EQ(it->second, i);
+    }
+    ASSERT_TRUE(map.find(makeIntRow(count)) == map.end());
+}
+
+TEST(MaterializedRowHashMapTest, ClearAndReuse) {
+    value::MaterializedRowHashMap<int> map;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 2000; ++i) {
+            map.try_emplace(makeIntRow(i), round);
+        }
+        ASSERT_EQ(map.size(), 2000U);
+        ASSERT_EQ(map.find(makeIntRow(1999))->second, round);
+
+        map.clear();
+        ASSERT_TRUE(map.empty());
+        ASSERT_TRUE(map.begin() == map.end());
+        ASSERT_TRUE(map.find(makeIntRow(0)) == map.end());
+    }
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::MergeJoinStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/merge_join.h"
+
+namespace mongo::sbe {
+
+class MergeJoinStageTest : public PlanStageTestFixture {
+public:
+    using JoinedRow = std::tuple<int32_t, int32_t, int32_t>;
+
+    /**
+     * Builds a MergeJoinStage which joins the [key, value] rows of 'outer' and 'inner', both sorted
+     * on the key in direction 'dir'. Produces [key, outer value, inner value] rows.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeJoin(BSONArray outer,
+                                                                     BSONArray inner,
+                                                                     value::SortDirection dir) {
+        auto [outerSlots, outerStage] = generateMockScanMulti(2, outer);
+        auto [innerSlots, innerStage] = generateMockScanMulti(2, inner);
+        auto stage = makeS<MergeJoinStage>(std::move(outerStage),
+                                           std::move(innerStage),
+                                           makeSV(outerSlots[0]),
+                                           makeSV(outerSlots[1]),
+                                           makeSV(innerSlots[0]),
+                                           std::vector<value::SortDirection>{dir});
+        return {makeSV(outerSlots[0], outerSlots[1], innerSlots[1]), std::move(stage)};
+    }
+
+    /**
+     * Returns all rows produced by 'stage', in the order of production.
+     */
+    std::vector<JoinedRow> getAllRows(PlanStage* stage,
+                                      const std::vector<value::SlotAccessor*>& accessors) {
+        std::vector<JoinedRow> rows;
+        while (stage->getNext() == PlanState::ADVANCED) {
+            std::array<int32_t, 3> row;
+            for (size_t idx = 0; idx < row.size(); ++idx) {
+                auto [tag, val] = accessors[idx]->getViewOfValue();
+                ASSERT_TRUE(tag == value::TypeTags::NumberInt32);
+                row[idx] = value::bitcastTo<int32_t>(val);
+            }
+            rows.emplace_back(row[0], row[1], row[2]);
+        }
+        return rows;
+    }
+};
+
+TEST_F(MergeJoinStageTest, JoinsAscendingInputsWithDuplicateKeys) {
+    auto [outSlots, stage] =
+        makeJoin(BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(1 << 11) << BSON_ARRAY(2 << 20)
+                                                << BSON_ARRAY(4 << 40)),
+                 BSON_ARRAY(BSON_ARRAY(0 << 0) << BSON_ARRAY(1 << 100) << BSON_ARRAY(1 << 101)
+                                               << BSON_ARRAY(3 << 300) << BSON_ARRAY(4 << 400)
+                                               << BSON_ARRAY(5 << 500)),
+                 value::SortDirection::Ascending);
+    const std::vector<JoinedRow> expected = {
+        {1, 10, 100}, {1, 11, 100}, {1, 10, 101}, {1, 11, 101}, {4, 40, 400}};
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT(getAllRows(stage.get(), accessors) == expected);
+}
+
+TEST_F(MergeJoinStageTest, JoinsDescendingInputs) {
+    auto [outSlots, stage] =
+        makeJoin(BSON_ARRAY(BSON_ARRAY(5 << 50) << BSON_ARRAY(3 << 30) << BSON_ARRAY(1 << 10)),
+                 BSON_ARRAY(BSON_ARRAY(4 << 400) << BSON_ARRAY(3 << 300) << BSON_ARRAY(1 << 100)
+                                                 << BSON_ARRAY(0 << 0)),
+                 value::SortDirection::Descending);
+    const std::vector<JoinedRow> expected = {{3, 30, 300}, {1, 10, 100}};
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT(getAllRows(stage.get(), accessors) == expected);
+}
+
+TEST_F(MergeJoinStageTest, ProducesNothingWhenOuterIsEmpty) {
+    auto [outSlots, stage] = makeJoin(BSONArray{},
+                                      BSON_ARRAY(BSON_ARRAY(1 << 100) << BSON_ARRAY(2 << 200)),
+                                      value::SortDirection::Ascending);
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT_TRUE(getAllRows(stage.get(), accessors).empty());
+}
+
+TEST_F(MergeJoinStageTest, Reopen) {
+    auto [outSlots, stage] =
+        makeJoin(BSON_ARRAY(BSON_ARRAY(1 << 10) << BSON_ARRAY(2 << 20)),
+                 BSON_ARRAY(BSON_ARRAY(1 << 100) << BSON_ARRAY(2 << 200) << BSON_ARRAY(3 << 300)),
+                 value::SortDirection::Ascending);
+    const std::vector<JoinedRow> expected = {{1, 10, 100}, {2, 20, 200}};
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    ASSERT(getAllRows(stage.get(), accessors) == expected);
+
+    stage->close();
+    stage->open(false);
+    ASSERT(getAllRows(stage.get(), accessors) == expected);
+}
+
+}  // namespace mongo::sbe
@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/filter.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
+#include "mongo/db/exec/sbe/stages/limit_skip.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/exec/sbe/stages/unwind.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo::sbe {
+namespace {
+
+constexpr size_t kMemoryLimit = 100 * 1024 * 1024;
+
+/**
+ * Owns the operation context and slot id generator shared by the stage benchmarks below. Each
+ * benchmark builds a plan over a synthetic scan of 'state.range(0)' integers, then reopens and
+ * drains it once per iteration.
+ */
+class SbePlanStageBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(benchmark::State& state) override {
+        _client = getGlobalServiceContext()->makeClient("sbe_plan_stage_bm");
+        _opCtx = _client->makeOperationContext();
+    }
+
+    void TearDown(benchmark::State& state) override {
+        _opCtx.reset();
+        _client.reset();
+    }
+
+protected:
+    value::SlotId generateSlotId() {
+        return _slotIdGenerator.generate();
+    }
+
+    /**
+     * Returns a scan producing the integers [0, 'numRows') in a single slot. The rows are unwound
+     * from an array constant, the same shape the SBE unit tests use to mock a collection scan.
+     */
+    std::pair<value::SlotId, std::unique_ptr<PlanStage>> makeScan(int64_t numRows) {
+        auto [arrTag, arrVal] = value::makeNewArray();
+        auto arr = value::getArrayView(arrVal);
+        arr->reserve(numRows);
+        for (int64_t i = 0; i < numRows; ++i) {
+            arr->push_back(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+        }
+
+        auto projectSlot = generateSlotId();
+        auto unwindSlot = generateSlotId();
+        auto unwind = makeS<UnwindStage>(
+            makeProjectStage(makeS<LimitSkipStage>(makeS<CoScanStage>(), 1, boost::none),
+                             projectSlot,
+                             makeE<EConstant>(arrTag, arrVal)),
+            projectSlot,
+            unwindSlot,
+            generateSlotId(),
+            false);
+        return {unwindSlot, std::move(unwind)};
+    }
+
+    /**
+     * Prepares 'root' for execution, then drains it once per benchmark iteration, reading
+     * 'outSlot' for every row produced.
+     */
+    void runPlan(benchmark::State& state, PlanStage* root, value::SlotId outSlot) {
+        CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+        root->prepare(ctx);
+        auto accessor = root->getAccessor(ctx, outSlot);
+        root->attachFromOperationContext(_opCtx.get());
+
+        bool reOpen = false;
+        for (auto _ : state) {
+            root->open(reOpen);
+            reOpen = true;
+            while (root->getNext() == PlanState::ADVANCED) {
+                benchmark::DoNotOptimize(accessor->getViewOfValue());
+            }
+        }
+        root->close();
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+private:
+    ServiceContext::UniqueClient _client;
+    ServiceContext::UniqueOperationContext _opCtx;
+    value::SlotIdGenerator _slotIdGenerator;
+};
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_Scan)(benchmark::State& state) {
+    auto [scanSlot, scan] = makeScan(state.range(0));
+    runPlan(state, scan.get(), scanSlot);
+}
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_Filter)(benchmark::State& state) {
+    auto [scanSlot, scan] = makeScan(state.range(0));
+    auto filter = makeS<FilterStage<false>>(
+        std::move(scan),
+        makeE<EPrimBinary>(
+            EPrimBinary::less,
+            makeE<EVariable>(scanSlot),
+            makeE<EConstant>(value::TypeTags::NumberInt64,
+                             value::bitcastFrom<int64_t>(state.range(0) / 2))));
+    runPlan(state, filter.get(), scanSlot);
+}
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_Project)(benchmark::State& state) {
+    auto [scanSlot, scan] = makeScan(state.range(0));
+    auto outSlot = generateSlotId();
+    auto project = makeProjectStage(
+        std::move(scan),
+        outSlot,
+        makeE<EPrimBinary>(
+            EPrimBinary::add,
+            makeE<EVariable>(scanSlot),
+            makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1))));
+    runPlan(state, project.get(), outSlot);
+}
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_HashAgg)(benchmark::State& state) {
+    auto [scanSlot, scan] = makeScan(state.range(0));
+    auto keySlot = generateSlotId();
+    auto project = makeProjectStage(
+        std::move(scan),
+        keySlot,
+        makeE<EFunction>("mod",
+                         makeEs(makeE<EVariable>(scanSlot),
+                                makeE<EConstant>(value::TypeTags::NumberInt64,
+                                                 value::bitcastFrom<int64_t>(100)))));
+    auto sumSlot = generateSlotId();
+    auto agg = makeS<HashAggStage>(
+        std::move(project),
+        makeSV(keySlot),
+        makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(scanSlot)))),
+        makeEM(sumSlot, makeE<EFunction>("sum", makeEs(makeE<EVariable>(sumSlot)))),
+        kMemoryLimit,
+        false);
+    runPlan(state, agg.get(), sumSlot);
+}
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_HashJoin)(benchmark::State& state) {
+    auto [outerSlot, outer] = makeScan(state.range(0));
+    auto [innerSlot, inner] = makeScan(state.range(0));
+    auto join = makeS<HashJoinStage>(std::move(outer),
+                                     std::move(inner),
+                                     makeSV(outerSlot),
+                                     makeSV(),
+                                     makeSV(innerSlot),
+                                     makeSV(),
+                                     kMemoryLimit,
+                                     false);
+    runPlan(state, join.get(), outerSlot);
+}
+
+BENCHMARK_DEFINE_F(SbePlanStageBenchmark, BM_Sort)(benchmark::State& state) {
+    auto [scanSlot, scan] = makeScan(state.range(0));
+    auto sort =
+        makeS<SortStage>(std::move(scan),
+                         makeSV(scanSlot),
+                         std::vector<value::SortDirection>{value::SortDirection::Descending},
+                         makeSV(),
+                         std::numeric_limits<std::size_t>::max(),
+                         kMemoryLimit,
+                         false,
+                         nullptr);
+    runPlan(state, sort.get(), scanSlot);
+}
+
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_Scan)->Range(1 << 10, 1 << 16);
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_Filter)->Range(1 << 10, 1 << 16);
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_Project)->Range(1 << 10, 1 << 16);
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_HashAgg)->Range(1 << 10, 1 << 16);
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_HashJoin)->Range(1 << 10, 1 << 16);
+BENCHMARK_REGISTER_F(SbePlanStageBenchmark, BM_Sort)->Range(1 << 10, 1 << 16);
+
+}  // namespace
+}  // namespace mongo::sbe
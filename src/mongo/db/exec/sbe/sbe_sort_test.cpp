@@ -37,6 +37,8 @@
 
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/unittest/temp_dir.h"
 
 namespace mongo::sbe {
 
@@ -73,4 +75,122 @@ TEST_F(SortStageTest, SortNumbersTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+class SortStageSpillTest : public PlanStageTestFixture {
+public:
+    void setUp() override {
+        PlanStageTestFixture::setUp();
+        _tempDir = std::make_unique<unittest::TempDir>("sbe_sort_test");
+        _oldDbPath = storageGlobalParams.dbpath;
+        storageGlobalParams.dbpath = _tempDir->path();
+    }
+
+    void tearDown() override {
+        storageGlobalParams.dbpath = _oldDbPath;
+        _tempDir.reset();
+        PlanStageTestFixture::tearDown();
+    }
+
+    /**
+     * Builds a SortStage which sorts by the first input slot in ascending order.
+     */
+    std::pair<value::SlotVector, std::unique_ptr<PlanStage>> makeSort(
+        BSONArray input,
+        size_t memoryLimit,
+        bool allowDiskUse,
+        size_t limit = std::numeric_limits<std::size_t>::max()) {
+        auto [scanSlots, scanStage] = generateMockScanMulti(2, input);
+        auto sortStage =
+            makeS<SortStage>(std::move(scanStage),
+                             makeSV(scanSlots[0]),
+                             std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                             makeSV(scanSlots[1]),
+                             limit,
+                             memoryLimit,
+                             allowDiskUse,
+                             nullptr);
+        return {scanSlots, std::move(sortStage)};
+    }
+
+private:
+    std::unique_ptr<unittest::TempDir> _tempDir;
+    std::string _oldDbPath;
+};
+
+TEST_F(SortStageSpillTest, SpilledRunsAreMerged) {
+    auto input = BSON_ARRAY(BSON_ARRAY(5 << "E") << BSON_ARRAY(3 << "C") << BSON_ARRAY(1 << "A")
+                                                 << BSON_ARRAY(4 << "D") << BSON_ARRAY(2 << "B"));
+    // A memory limit of a single byte forces every row to be spilled as its own sorted run.
+    auto [outSlots, stage] = makeSort(input, 1, true);
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), accessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    auto [expectedTag, expectedVal] =
+        makeValue(BSON_ARRAY(BSON_ARRAY(1 << "A") << BSON_ARRAY(2 << "B") << BSON_ARRAY(3 << "C")
+                                                  << BSON_ARRAY(4 << "D") << BSON_ARRAY(5 << "E")));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+    ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+    auto stats = static_cast<const SortStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->wasDiskUsed);
+    ASSERT_EQ(stats->spills, 5U);
+    ASSERT_GT(stats->totalDataSizeBytes, 0U);
+}
+
+TEST_F(SortStageSpillTest, LimitedSortKeepsOnlyTheFirstRows) {
+    auto input = BSON_ARRAY(BSON_ARRAY(5 << "E") << BSON_ARRAY(3 << "C") << BSON_ARRAY(1 << "A")
+                                                 << BSON_ARRAY(4 << "D") << BSON_ARRAY(2 << "B"));
+    auto [expectedTag, expectedVal] =
+        makeValue(BSON_ARRAY(BSON_ARRAY(1 << "A") << BSON_ARRAY(2 << "B") << BSON_ARRAY(3 << "C")));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    // The rows which can't be among the first three are dropped before they reach the sorter.
+    {
+        auto [outSlots, stage] = makeSort(input, 204857600, false, 3);
+        auto accessors = prepareTree(stage.get(), outSlots);
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), accessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+        ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+        auto stats = static_cast<const SortStats*>(stage->getSpecificStats());
+        ASSERT_FALSE(stats->wasDiskUsed);
+        ASSERT_EQ(stats->limit, 3U);
+    }
+
+    // Once the first rows exceed the memory limit, the sorter gets every row and spills them.
+    {
+        auto [outSlots, stage] = makeSort(input, 1, true, 3);
+        auto accessors = prepareTree(stage.get(), outSlots);
+        auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), accessors);
+        value::ValueGuard resultsGuard{resultsTag, resultsVal};
+        ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+        auto stats = static_cast<const SortStats*>(stage->getSpecificStats());
+        ASSERT_TRUE(stats->wasDiskUsed);
+    }
+}
+
+TEST_F(SortStageSpillTest, ExceedingMemoryLimitWithoutDiskUseFails) {
+    auto [outSlots, stage] =
+        makeSort(BSON_ARRAY(BSON_ARRAY(2 << "B") << BSON_ARRAY(1 << "A")), 1, false);
+
+    ASSERT_THROWS_CODE(prepareTree(stage.get(), outSlots),
+                       DBException,
+                       ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(SortStageSpillTest, NoSpillingBelowMemoryLimit) {
+    auto [outSlots, stage] = makeSort(
+        BSON_ARRAY(BSON_ARRAY(2 << "B") << BSON_ARRAY(1 << "A")), 100 * 1024 * 1024, false);
+
+    auto accessors = prepareTree(stage.get(), outSlots);
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), accessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    auto stats = static_cast<const SortStats*>(stage->getSpecificStats());
+    ASSERT_FALSE(stats->wasDiskUsed);
+    ASSERT_EQ(stats->spills, 0U);
+}
+
 }  // namespace mongo::sbe
@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/unittest/unittest.h"
@@ -199,4 +200,145 @@ TEST(SBEVM, Add) {
     }
 }
 
+TEST(SBEVM, CompareBlock) {
+    vm::ByteCode interpreter;
+    std::vector<value::TypeTags> outTags(4);
+    std::vector<value::Value> outVals(4);
+
+    // A block of 64-bit integers compared with a 32-bit integer uses the vectorized loop.
+    {
+        std::vector<value::TypeTags> tags(4, value::TypeTags::NumberInt64);
+        std::vector<value::Value> vals = {value::bitcastFrom<int64_t>(-1),
+                                          value::bitcastFrom<int64_t>(5),
+                                          value::bitcastFrom<int64_t>(6),
+                                          value::bitcastFrom<int64_t>(100)};
+
+        interpreter.compareBlock(vm::Instruction::less,
+                                 tags.size(),
+                                 tags.data(),
+                                 vals.data(),
+                                 value::TypeTags::NumberInt32,
+                                 value::bitcastFrom<int32_t>(6),
+                                 outTags.data(),
+                                 outVals.data());
+
+        const std::vector<bool> expected = {true, true, false, false};
+        for (size_t idx = 0; idx < expected.size(); ++idx) {
+            ASSERT_EQUALS(outTags[idx], value::TypeTags::Boolean);
+            ASSERT_EQUALS(value::bitcastTo<bool>(outVals[idx]), expected[idx]);
+        }
+    }
+
+    // A block of mixed types falls back to the per-value comparison.
+    {
+        auto [strTag, strVal] = value::makeNewString("a");
+        value::ValueGuard strGuard{strTag, strVal};
+
+        std::vector<value::TypeTags> tags = {value::TypeTags::NumberInt32,
+                                             value::TypeTags::NumberDouble,
+                                             strTag,
+                                             value::TypeTags::Nothing};
+        std::vector<value::Value> vals = {
+            value::bitcastFrom<int32_t>(7), value::bitcastFrom<double>(6.5), strVal, 0};
+
+        interpreter.compareBlock(vm::Instruction::eq,
+                                 tags.size(),
+                                 tags.data(),
+                                 vals.data(),
+                                 value::TypeTags::NumberInt64,
+                                 value::bitcastFrom<int64_t>(7),
+                                 outTags.data(),
+                                 outVals.data());
+
+        ASSERT_EQUALS(outTags[0], value::TypeTags::Boolean);
+        ASSERT_TRUE(value::bitcastTo<bool>(outVals[0]));
+        ASSERT_EQUALS(outTags[1], value::TypeTags::Boolean);
+        ASSERT_FALSE(value::bitcastTo<bool>(outVals[1]));
+        ASSERT_EQUALS(outTags[2], value::TypeTags::Nothing);
+        ASSERT_EQUALS(outTags[3], value::TypeTags::Nothing);
+    }
+}
+
+TEST(SBEVM, ArithmeticBlock) {
+    vm::ByteCode interpreter;
+    std::vector<uint8_t> outOwned(3);
+    std::vector<value::TypeTags> outTags(3);
+    std::vector<value::Value> outVals(3);
+
+    // The result which overflows a 32-bit integer is widened like in the 'add' instruction.
+    std::vector<value::TypeTags> tags(3, value::TypeTags::NumberInt32);
+    std::vector<value::Value> vals = {value::bitcastFrom<int32_t>(-7),
+                                      value::bitcastFrom<int32_t>(0),
+                                      value::bitcastFrom<int32_t>(2147483647)};
+
+    interpreter.arithmeticBlock(vm::Instruction::add,
+                                tags.size(),
+                                tags.data(),
+                                vals.data(),
+                                value::TypeTags::NumberInt32,
+                                value::bitcastFrom<int32_t>(1),
+                                outOwned.data(),
+                                outTags.data(),
+                                outVals.data());
+
+    ASSERT_EQUALS(outTags[0], value::TypeTags::NumberInt32);
+    ASSERT_EQUALS(value::bitcastTo<int32_t>(outVals[0]), -6);
+    ASSERT_EQUALS(outTags[1], value::TypeTags::NumberInt32);
+    ASSERT_EQUALS(value::bitcastTo<int32_t>(outVals[1]), 1);
+    ASSERT_EQUALS(outTags[2], value::TypeTags::NumberInt64);
+    ASSERT_EQUALS(value::bitcastTo<int64_t>(outVals[2]), 2147483648LL);
+    for (auto owned : outOwned) {
+        ASSERT_FALSE(owned);
+    }
+
+    // A block of doubles multiplied by an integer.
+    std::fill(tags.begin(), tags.end(), value::TypeTags::NumberDouble);
+    vals = {value::bitcastFrom<double>(1.5),
+            value::bitcastFrom<double>(-2.0),
+            value::bitcastFrom<double>(0.25)};
+
+    interpreter.arithmeticBlock(vm::Instruction::mul,
+                                tags.size(),
+                                tags.data(),
+                                vals.data(),
+                                value::TypeTags::NumberInt64,
+                                value::bitcastFrom<int64_t>(4),
+                                outOwned.data(),
+                                outTags.data(),
+                                outVals.data());
+
+    const std::vector<double> expected = {6.0, -8.0, 1.0};
+    for (size_t idx = 0; idx < expected.size(); ++idx) {
+        ASSERT_EQUALS(outTags[idx], value::TypeTags::NumberDouble);
+        ASSERT_EQUALS(value::bitcastTo<double>(outVals[idx]), expected[idx]);
+    }
+}
+
+TEST(SBERuntimeEnvironment, DeepCopyHasItsOwnValues) {
+    value::SlotIdGenerator slotIdGenerator;
+    RuntimeEnvironment env;
+    auto [strTag, strVal] = value::makeNewString("a long enough string to be heap allocated");
+    auto strSlot = env.registerSlot("str"_sd, strTag, strVal, true, &slotIdGenerator);
+    auto intSlot = env.registerSlot("int"_sd,
+                                    value::TypeTags::NumberInt32,
+                                    value::bitcastFrom<int32_t>(1),
+                                    false,
+                                    &slotIdGenerator);
+
+    auto copy = env.makeDeepCopy();
+    ASSERT_EQ(*copy->getSlotIfExists("str"_sd), strSlot);
+    ASSERT_EQ(copy->getSlot("int"_sd), intSlot);
+    ASSERT_FALSE(copy->getSlotIfExists("missing"_sd));
+
+    // Resetting a slot of the copy leaves the original environment intact.
+    copy->resetSlot(intSlot, value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2), false);
+    ASSERT_EQ(value::bitcastTo<int32_t>(env.getAccessor(intSlot)->getViewOfValue().second), 1);
+    ASSERT_EQ(value::bitcastTo<int32_t>(copy->getAccessor(intSlot)->getViewOfValue().second), 2);
+
+    auto [copyStrTag, copyStrVal] = copy->getAccessor(strSlot)->getViewOfValue();
+    ASSERT_NE(copyStrVal, strVal);
+    ASSERT_EQ(value::getStringView(copyStrTag, copyStrVal),
+              value::getStringView(strTag, strVal));
+}
+
 }  // namespace mongo::sbe
@@ -33,6 +33,7 @@
 
 #include "mongo/base/init.h"
 #include "mongo/db/client.h"
+#include "mongo/db/storage/recovery_unit.h"
 
 namespace mongo::sbe {
 std::unique_ptr<ThreadPool> s_globalThreadPool;
@@ -248,15 +249,25 @@ void ExchangeConsumer::open(bool reOpen) {
                 }
             }
 
+            // Every producer runs under its own operation context. If the consumer reads at a
+            // timestamp, make the producers read at the same timestamp so that all of them see a
+            // single snapshot of the data.
+            auto readTimestamp = _opCtx->recoveryUnit()->getPointInTimeReadTimestamp();
+
             // Start n producers.
             invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
                 s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
+                    [this, idx, readTimestamp, promise = std::move(pf.promise)](
+                        auto status) mutable {
                         invariant(status);
 
                         auto opCtx = cc().makeOperationContext();
+                        if (readTimestamp) {
+                            opCtx->recoveryUnit()->setTimestampReadSource(
+                                RecoveryUnit::ReadSource::kProvided, readTimestamp);
+                        }
 
                         promise.setWith([&] {
                             ExchangeProducer::start(opCtx.get(),
@@ -31,23 +31,86 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Orders the (key, partial aggregates) records of the spilled runs by the group key, so that the
+ * records which belong to the same group are read back from the merged runs one after another.
+ */
+struct SpilledKeyComparator {
+    int operator()(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) const {
+        for (size_t idx = 0; idx < lhs.size(); ++idx) {
+            auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+            auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+            auto result = value::bitcastTo<int32_t>(val);
+            if (result) {
+                return result;
+            }
+        }
+
+        return 0;
+    }
+
+    int operator()(const std::pair<value::MaterializedRow, value::MaterializedRow>& lhs,
+                   const std::pair<value::MaterializedRow, value::MaterializedRow>& rhs) const {
+        return (*this)(lhs.first, rhs.first);
+    }
+};
+}  // namespace
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
-                           value::SlotMap<std::unique_ptr<EExpression>> aggs)
-    : PlanStage("group"_sd), _gbs(std::move(gbs)), _aggs(std::move(aggs)) {
+                           value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                           value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
+                           size_t memoryLimit,
+                           bool allowDiskUse)
+    : PlanStage("group"_sd),
+      _gbs(std::move(gbs)),
+      _aggs(std::move(aggs)),
+      _mergingExprs(std::move(mergingExprs)),
+      _memoryLimit(memoryLimit),
+      _allowDiskUse(allowDiskUse),
+      _mergeData({0, 0}) {
     _children.emplace_back(std::move(input));
 }
 
+HashAggStage::~HashAggStage() {
+    if (_ownsSpillFile) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+    }
+}
+
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
     value::SlotMap<std::unique_ptr<EExpression>> aggs;
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(_children[0]->clone(), _gbs, std::move(aggs));
+    value::SlotMap<std::unique_ptr<EExpression>> mergingExprs;
+    for (auto& [k, v] : _mergingExprs) {
+        mergingExprs.emplace(k, v->clone());
+    }
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          std::move(mergingExprs),
+                                          _memoryLimit,
+                                          _allowDiskUse);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -84,6 +147,39 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         _aggCodes.emplace_back(expr->compile(ctx));
         ctx.aggExpression = false;
     }
+
+    // Compile the merging expressions. A merging expression reads the spilled partial aggregate
+    // through the aggregate's own output slot, so we temporarily bind that slot to an accessor
+    // over the record which has been read back from disk.
+    if (!_mergingExprs.empty()) {
+        uassert(5190010,
+                "every aggregate of a group stage must have a merging expression",
+                _mergingExprs.size() == _aggs.size());
+
+        counter = 0;
+        for (auto& [slot, expr] : _aggs) {
+            const auto slotId = slot;
+            auto mergingIt = _mergingExprs.find(slotId);
+            uassert(5190011,
+                    str::stream() << "missing merging expression for field: " << slotId,
+                    mergingIt != _mergingExprs.end());
+
+            _spilledAggAccessors.emplace_back(
+                std::make_unique<SpilledAggAccessor>(_mergeDataIt, counter));
+
+            ctx.root = this;
+            ctx.aggExpression = true;
+            ctx.accumulator = _outAggAccessors[counter].get();
+            ctx.pushCorrelated(slotId, _spilledAggAccessors.back().get());
+
+            _mergingCodes.emplace_back(mergingIt->second->compile(ctx));
+
+            ctx.popCorrelated();
+            ctx.aggExpression = false;
+            ++counter;
+        }
+    }
+
     _compiled = true;
 }
 
@@ -99,10 +195,79 @@ value::SlotAccessor* HashAggStage::getAccessor(CompileCtx& ctx, value::SlotId sl
     return ctx.getAccessor(slot);
 }
 
+void HashAggStage::trackMemoryUsage(int64_t delta) {
+    _memoryUsage += delta;
+    if (_memoryUsage <= 0 || static_cast<size_t>(_memoryUsage) <= _memoryLimit) {
+        return;
+    }
+
+    uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+            "Exceeded memory limit for group, but didn't allow external spilling;"
+            " pass allowDiskUse:true to opt in",
+            _allowDiskUse);
+    uassert(5190012,
+            "Exceeded memory limit for group, but its aggregates cannot be spilled to disk",
+            _mergingCodes.size() == _aggCodes.size());
+
+    spill();
+}
+
+void HashAggStage::spill() {
+    if (_spillFileName.empty()) {
+        _spillFileName = storageGlobalParams.dbpath + "/_tmp/" + nextFileName();
+        _ownsSpillFile = true;
+    }
+
+    // Sort the pointers to the hash table entries rather than the entries themselves.
+    std::vector<const TableType::value_type*> ptrs;
+    ptrs.reserve(_ht.size());
+    for (auto& entry : _ht) {
+        ptrs.push_back(&entry);
+    }
+
+    SpilledKeyComparator comp;
+    std::sort(ptrs.begin(), ptrs.end(), [&](auto lhs, auto rhs) {
+        return comp(lhs->first, rhs->first) < 0;
+    });
+
+    SortedFileWriter<value::MaterializedRow, value::MaterializedRow> writer(
+        SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp"),
+        _spillFileName,
+        _nextSpillFileOffset);
+    for (auto entry : ptrs) {
+        writer.addAlreadySorted(entry->first, entry->second);
+    }
+    _spilledRuns.emplace_back(writer.done());
+
+    auto fileEndOffset = writer.getFileEndOffset();
+    _specificStats.usedDisk = true;
+    ++_specificStats.spills;
+    _specificStats.spilledRecords += ptrs.size();
+    _specificStats.spilledBytes += static_cast<size_t>(fileEndOffset - _nextSpillFileOffset);
+    _nextSpillFileOffset = fileEndOffset;
+
+    _ht.clear();
+    _memoryUsage = 0;
+}
+
 void HashAggStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
+    _ht.clear();
+    _memoryUsage = 0;
+    _mergeIt.reset();
+    _spilledRuns.clear();
+    _hasMergeData = false;
+    if (_ownsSpillFile) {
+        boost::filesystem::remove(_spillFileName);
+        _ownsSpillFile = false;
+    }
+    _spillFileName.clear();
+    _nextSpillFileOffset = 0;
+
+    const bool trackMemory = _memoryLimit != std::numeric_limits<size_t>::max();
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
         // Copy keys in order to do the lookup.
@@ -113,27 +278,88 @@ void HashAggStage::open(bool reOpen) {
         }
 
         auto [it, inserted] = _ht.try_emplace(std::move(key), value::MaterializedRow{0});
+        int64_t memoryDelta = 0;
         if (inserted) {
             // Copy keys.
             const_cast<value::MaterializedRow&>(it->first).makeOwned();
             // Initialize accumulators.
             it->second.resize(_outAggAccessors.size());
+
+            if (trackMemory) {
+                memoryDelta += it->first.memUsageForSorter();
+            }
         }
 
         // Accumulate.
         _htIt = it;
+        if (trackMemory) {
+            memoryDelta -= it->second.memUsageForSorter();
+        }
         for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
             auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
             _outAggAccessors[idx]->reset(owned, tag, val);
         }
+
+        if (trackMemory) {
+            memoryDelta += it->second.memUsageForSorter();
+            trackMemoryUsage(memoryDelta);
+        }
     }
 
     _children[0]->close();
 
+    if (!_spilledRuns.empty()) {
+        // Spill the rest of the groups so that all of them are read back in key order.
+        if (!_ht.empty()) {
+            spill();
+        }
+
+        _mergeIt.reset(SpilledIterator::merge(
+            _spilledRuns, _spillFileName, SortOptions(), SpilledKeyComparator{}));
+        _ownsSpillFile = false;
+        _spilledRuns.clear();
+
+        _hasMergeData = _mergeIt->more();
+        if (_hasMergeData) {
+            _mergeData = _mergeIt->next();
+        }
+    }
+
     _htIt = _ht.end();
 }
 
+PlanState HashAggStage::getNextSpilled() {
+    if (!_hasMergeData) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    // The hash table holds only the group which is currently being produced.
+    _ht.clear();
+    auto [it, inserted] = _ht.try_emplace(std::move(_mergeData.first),
+                                          value::MaterializedRow{_outAggAccessors.size()});
+    _htIt = it;
+
+    SpilledKeyComparator comp;
+    do {
+        for (size_t idx = 0; idx < _outAggAccessors.size(); ++idx) {
+            auto [owned, tag, val] = _bytecode.run(_mergingCodes[idx].get());
+            _outAggAccessors[idx]->reset(owned, tag, val);
+        }
+
+        _hasMergeData = _mergeIt->more();
+        if (_hasMergeData) {
+            _mergeData = _mergeIt->next();
+        }
+    } while (_hasMergeData && comp(_mergeData.first, _htIt->first) == 0);
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
 PlanState HashAggStage::getNext() {
+    if (_mergeIt) {
+        return getNextSpilled();
+    }
+
     if (_htIt == _ht.end()) {
         _htIt = _ht.begin();
     } else {
@@ -149,16 +375,18 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     return ret;
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
     _commonStats.closes++;
+    _mergeIt.reset();
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
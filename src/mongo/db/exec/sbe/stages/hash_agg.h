@@ -29,20 +29,40 @@
 
 #pragma once
 
-#include <unordered_map>
-
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/values/materialized_row_hash_map.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
-#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+}  // namespace mongo
 
 namespace mongo {
 namespace sbe {
+/**
+ * Groups the rows produced by its child by the values of the 'gbs' slots and computes the 'aggs'
+ * aggregate expressions for every group in a hash table.
+ *
+ * When the approximate size of the hash table exceeds 'memoryLimit' and 'allowDiskUse' is true,
+ * the contents of the table are sorted by key and spilled to disk as a sorted run, and the table
+ * is cleared. Once the child is exhausted the remaining in-memory groups are spilled as well and
+ * all of the runs are merged back. Partial aggregates which belong to the same group are combined
+ * using 'mergingExprs', which maps every aggregate output slot to an aggregate expression which
+ * reads a spilled partial aggregate through that very slot (e.g. 's2 = sum(s2)'). Spilling is only
+ * possible if every aggregate has a merging expression.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
-                 value::SlotMap<std::unique_ptr<EExpression>> aggs);
+                 value::SlotMap<std::unique_ptr<EExpression>> aggs,
+                 value::SlotMap<std::unique_ptr<EExpression>> mergingExprs,
+                 size_t memoryLimit,
+                 bool allowDiskUse);
+
+    ~HashAggStage();
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -57,14 +77,39 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
-    using TableType = stdx::
-        unordered_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
+    using TableType = value::MaterializedRowHashMap<value::MaterializedRow>;
 
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpilledIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledData = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledAggAccessor = value::MaterializedRowValueAccessor<SpilledData*>;
+
+    /**
+     * Accounts for the memory consumed by a newly inserted group key, or by the change in size of
+     * the accumulators of a group, and spills the hash table to disk if the memory limit has been
+     * exceeded.
+     */
+    void trackMemoryUsage(int64_t delta);
+
+    /**
+     * Writes the contents of the hash table to the spill file as a run sorted by the group key
+     * and clears the table.
+     */
+    void spill();
+
+    /**
+     * Produces the next group by merging the partial aggregates of consecutive records with equal
+     * keys read back from the spilled runs.
+     */
+    PlanState getNextSpilled();
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
+    const value::SlotMap<std::unique_ptr<EExpression>> _mergingExprs;
+    const size_t _memoryLimit;
+    const bool _allowDiskUse;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
@@ -76,9 +121,33 @@ private:
     TableType _ht;
     TableType::iterator _htIt;
 
+    // Accessors and compiled merging expressions used to combine partial aggregates which have
+    // been read back from disk. Each merging expression reads a partial aggregate through the
+    // accessor with the same index.
+    std::vector<std::unique_ptr<SpilledAggAccessor>> _spilledAggAccessors;
+    std::vector<std::unique_ptr<vm::CodeFragment>> _mergingCodes;
+
+    // The approximate amount of memory consumed by the hash table.
+    int64_t _memoryUsage{0};
+
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset{0};
+    // Whether this stage is responsible for deleting the spill file. Once the spilled runs are
+    // merged, the merging iterator takes over this responsibility.
+    bool _ownsSpillFile{false};
+    std::vector<std::shared_ptr<SpilledIterator>> _spilledRuns;
+    std::unique_ptr<SpilledIterator> _mergeIt;
+    SpilledData _mergeData;
+    SpilledData* _mergeDataIt{&_mergeData};
+    // Whether '_mergeData' holds a record which has been read from '_mergeIt' but not yet merged
+    // into a group.
+    bool _hasMergeData{false};
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
+
+    HashAggStats _specificStats;
 };
 }  // namespace sbe
 }  // namespace mongo
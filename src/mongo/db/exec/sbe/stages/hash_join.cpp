@@ -32,22 +32,59 @@
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashJoinFileCounter;
+    return "extsort-hash-join-sbe." + std::to_string(hashJoinFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+/**
+ * Provides the value of a slot owned by another accessor. Used as the in-memory alternative of
+ * the inner side accessors that switch to the rows read back from disk in the grace hash join mode.
+ */
+class ForwardingAccessor final : public value::SlotAccessor {
+public:
+    ForwardingAccessor(value::SlotAccessor* accessor) : _accessor(accessor) {}
+
+    std::pair<value::TypeTags, value::Value> getViewOfValue() const override {
+        return _accessor->getViewOfValue();
+    }
+    std::pair<value::TypeTags, value::Value> copyOrMoveValue() override {
+        return _accessor->copyOrMoveValue();
+    }
+
+private:
+    value::SlotAccessor* _accessor;
+};
+}  // namespace
+
 HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              std::unique_ptr<PlanStage> inner,
                              value::SlotVector outerCond,
                              value::SlotVector outerProjects,
                              value::SlotVector innerCond,
-                             value::SlotVector innerProjects)
+                             value::SlotVector innerProjects,
+                             size_t memoryLimit,
+                             bool allowDiskUse)
     : PlanStage("hj"_sd),
       _outerCond(std::move(outerCond)),
       _outerProjects(std::move(outerProjects)),
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
-      _probeKey(0) {
+      _memoryLimit(memoryLimit),
+      _allowDiskUse(allowDiskUse),
+      _probeKey(0),
+      _innerData({0, 0}) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
     }
@@ -56,13 +93,19 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
     _children.emplace_back(std::move(inner));
 }
 
+HashJoinStage::~HashJoinStage() {
+    DESTRUCTOR_GUARD(removePartitions());
+}
+
 std::unique_ptr<PlanStage> HashJoinStage::clone() const {
     return std::make_unique<HashJoinStage>(_children[0]->clone(),
                                            _children[1]->clone(),
                                            _outerCond,
                                            _outerProjects,
                                            _innerCond,
-                                           _innerProjects);
+                                           _innerProjects,
+                                           _memoryLimit,
+                                           _allowDiskUse);
 }
 
 void HashJoinStage::prepare(CompileCtx& ctx) {
@@ -86,6 +129,28 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         uassert(4822825, str::stream() << "duplicate field: " << slot, inserted);
 
         _inInnerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+
+        std::vector<std::unique_ptr<value::SlotAccessor>> accessors;
+        accessors.emplace_back(std::make_unique<ForwardingAccessor>(_inInnerKeyAccessors.back()));
+        accessors.emplace_back(
+            std::make_unique<value::MaterializedRowKeyAccessor<PartitionData*>>(_innerDataIt,
+                                                                                counter++));
+        _outInnerAccessors[slot] = std::make_unique<value::SwitchAccessor>(std::move(accessors));
+    }
+
+    counter = 0;
+    for (auto& slot : _innerProjects) {
+        _inInnerProjectAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+
+        std::vector<std::unique_ptr<value::SlotAccessor>> accessors;
+        accessors.emplace_back(
+            std::make_unique<ForwardingAccessor>(_inInnerProjectAccessors.back()));
+        accessors.emplace_back(
+            std::make_unique<value::MaterializedRowValueAccessor<PartitionData*>>(_innerDataIt,
+                                                                                  counter++));
+        // A slot which is also an inner condition slot is served from the spilled key.
+        _outInnerAccessors.try_emplace(
+            slot, std::make_unique<value::SwitchAccessor>(std::move(accessors)));
     }
 
     counter = 0;
@@ -110,20 +175,159 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+            return it->second.get();
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
     return ctx.getAccessor(slot);
 }
 
+void HashJoinStage::switchToPartitionedMode() {
+    _partitioned = true;
+    _outerPartitions.fileNames.resize(kNumPartitions);
+    _outerPartitions.writers.resize(kNumPartitions);
+    _outerPartitions.iterators.resize(kNumPartitions);
+    _innerPartitions.fileNames.resize(kNumPartitions);
+    _innerPartitions.writers.resize(kNumPartitions);
+    _innerPartitions.iterators.resize(kNumPartitions);
+
+    for (auto& [key, project] : _ht) {
+        writeToPartition(_outerPartitions, key, project);
+    }
+    _specificStats.spilledOuterRecords += _ht.size();
+    _specificStats.usedDisk = true;
+    _specificStats.numPartitions = kNumPartitions;
+
+    _ht.clear();
+    _memoryUsage = 0;
+
+    for (auto& [slot, accessor] : _outInnerAccessors) {
+        accessor->setIndex(1);
+    }
+}
+
+void HashJoinStage::writeToPartition(SpilledSide& side,
+                                     const value::MaterializedRow& key,
+                                     const value::MaterializedRow& project) {
+    const auto partition = value::MaterializedRowHasher()(key) % kNumPartitions;
+
+    auto& writer = side.writers[partition];
+    if (!writer) {
+        // An empty partition file cannot be read back, so the files are only created on demand.
+        side.fileNames[partition] = storageGlobalParams.dbpath + "/_tmp/" + nextFileName();
+        writer = std::make_unique<PartitionWriter>(
+            SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp"),
+            side.fileNames[partition],
+            0);
+    }
+
+    writer->addAlreadySorted(key, project);
+}
+
+void HashJoinStage::finishPartitions(SpilledSide& side) {
+    for (size_t partition = 0; partition < side.writers.size(); ++partition) {
+        if (auto& writer = side.writers[partition]; writer) {
+            side.iterators[partition].reset(writer->done());
+            writer.reset();
+        }
+    }
+}
+
+bool HashJoinStage::loadNextPartition() {
+    if (_innerIt) {
+        _innerIt->closeSource();
+        _innerIt = nullptr;
+    }
+
+    _ht.clear();
+    _htIt = _ht.end();
+    _htItEnd = _ht.end();
+
+    while (_currentPartition < kNumPartitions) {
+        const auto partition = _currentPartition++;
+        auto& outerIt = _outerPartitions.iterators[partition];
+        auto& innerIt = _innerPartitions.iterators[partition];
+
+        // Rows of a partition can only match the rows of the same partition on the other side.
+        if (!outerIt || !innerIt) {
+            continue;
+        }
+
+        outerIt->openSource();
+        while (outerIt->more()) {
+            auto [key, project] = outerIt->next();
+            _ht.emplace(std::move(key), std::move(project));
+        }
+        outerIt->closeSource();
+        outerIt.reset();
+
+        _innerIt = innerIt.get();
+        _innerIt->openSource();
+
+        _htIt = _ht.end();
+        _htItEnd = _ht.end();
+        return true;
+    }
+
+    return false;
+}
+
+void HashJoinStage::removePartitions() {
+    _innerIt = nullptr;
+    for (auto side : {&_outerPartitions, &_innerPartitions}) {
+        side->iterators.clear();
+        side->writers.clear();
+        for (auto& fileName : side->fileNames) {
+            if (!fileName.empty()) {
+                boost::filesystem::remove(fileName);
+            }
+        }
+        side->fileNames.clear();
+    }
+}
+
 void HashJoinStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
+
+    _ht.clear();
+    _memoryUsage = 0;
+    _partitioned = false;
+    _currentPartition = 0;
+    removePartitions();
+    for (auto& [slot, accessor] : _outInnerAccessors) {
+        accessor->setIndex(0);
+    }
+
+    const bool trackMemory = _memoryLimit != std::numeric_limits<size_t>::max();
+
     // Insert the outer side into the hash table.
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inOuterKeyAccessors.size()};
         value::MaterializedRow project{_inOuterProjectAccessors.size()};
 
+        if (_partitioned) {
+            // The row is serialized straight away, so there is no need to copy the values.
+            size_t idx = 0;
+            for (auto& p : _inOuterKeyAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                key.reset(idx++, false, tag, val);
+            }
+
+            idx = 0;
+            for (auto& p : _inOuterProjectAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                project.reset(idx++, false, tag, val);
+            }
+
+            writeToPartition(_outerPartitions, key, project);
+            ++_specificStats.spilledOuterRecords;
+            continue;
+        }
+
         size_t idx = 0;
         // Copy keys in order to do the lookup.
         for (auto& p : _inOuterKeyAccessors) {
@@ -138,18 +342,84 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
+        if (trackMemory) {
+            _memoryUsage += key.memUsageForSorter() + project.memUsageForSorter();
+        }
+
         _ht.emplace(std::move(key), std::move(project));
+
+        if (trackMemory && _memoryUsage > _memoryLimit) {
+            uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                    "Exceeded memory limit for hash join, but didn't allow external spilling;"
+                    " pass allowDiskUse:true to opt in",
+                    _allowDiskUse);
+            switchToPartitionedMode();
+        }
     }
 
     _children[0]->close();
 
     _children[1]->open(reOpen);
 
+    if (_partitioned) {
+        finishPartitions(_outerPartitions);
+
+        // Partition the inner side by the same hash function, so that matching rows end up in the
+        // partitions with the same index.
+        value::MaterializedRow key{_inInnerKeyAccessors.size()};
+        value::MaterializedRow project{_inInnerProjectAccessors.size()};
+        while (_children[1]->getNext() == PlanState::ADVANCED) {
+            size_t idx = 0;
+            for (auto& p : _inInnerKeyAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                key.reset(idx++, false, tag, val);
+            }
+
+            idx = 0;
+            for (auto& p : _inInnerProjectAccessors) {
+                auto [tag, val] = p->getViewOfValue();
+                project.reset(idx++, false, tag, val);
+            }
+
+            writeToPartition(_innerPartitions, key, project);
+            ++_specificStats.spilledInnerRecords;
+        }
+
+        finishPartitions(_innerPartitions);
+    }
+
     _htIt = _ht.end();
     _htItEnd = _ht.end();
 }
 
+PlanState HashJoinStage::getNextPartitioned() {
+    if (_htIt != _htItEnd) {
+        ++_htIt;
+    }
+
+    while (_htIt == _htItEnd) {
+        if (!_innerIt || !_innerIt->more()) {
+            if (!loadNextPartition()) {
+                return trackPlanState(PlanState::IS_EOF);
+            }
+            continue;
+        }
+
+        _innerData = _innerIt->next();
+
+        auto [low, hi] = _ht.equal_range(_innerData.first);
+        _htIt = low;
+        _htItEnd = hi;
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
 PlanState HashJoinStage::getNext() {
+    if (_partitioned) {
+        return getNextPartitioned();
+    }
+
     if (_htIt != _htItEnd) {
         ++_htIt;
     }
@@ -183,17 +453,19 @@ PlanState HashJoinStage::getNext() {
 void HashJoinStage::close() {
     _commonStats.closes++;
     _children[1]->close();
+    removePartitions();
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     ret->children.emplace_back(_children[1]->getStats());
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
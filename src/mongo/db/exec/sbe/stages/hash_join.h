@@ -34,7 +34,25 @@
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+template <typename Key, typename Value>
+class SortedFileWriter;
+}  // namespace mongo
+
 namespace mongo::sbe {
+/**
+ * Joins the rows of the 'outer' (build) side with the rows of the 'inner' (probe) side which have
+ * equal 'outerCond' and 'innerCond' key values.
+ *
+ * The outer side is loaded into an in-memory hash table. If the approximate size of the hash table
+ * exceeds 'memoryLimit' and 'allowDiskUse' is true, the stage switches to the grace hash join
+ * mode: the rows of both sides are hash partitioned by key into temporary files, and the join is
+ * performed one partition at a time, so that only the hash table of a single outer partition has
+ * to fit in memory. In this mode the inner side only exposes the 'innerCond' and 'innerProjects'
+ * slots, as these are the only inner values which are materialized.
+ */
 class HashJoinStage final : public PlanStage {
 public:
     HashJoinStage(std::unique_ptr<PlanStage> outer,
@@ -42,7 +60,11 @@ public:
                   value::SlotVector outerCond,
                   value::SlotVector outerProjects,
                   value::SlotVector innerCond,
-                  value::SlotVector innerProjects);
+                  value::SlotVector innerProjects,
+                  size_t memoryLimit,
+                  bool allowDiskUse);
+
+    ~HashJoinStage();
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -64,10 +86,61 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashProjectAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using PartitionData = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using PartitionIterator =
+        SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+    using PartitionWriter = SortedFileWriter<value::MaterializedRow, value::MaterializedRow>;
+
+    /**
+     * The temporary files and the contents of one side (outer or inner) of a partitioned join.
+     * Partition files are created lazily, when the first row of the partition is written.
+     */
+    struct SpilledSide {
+        std::vector<std::string> fileNames;
+        std::vector<std::unique_ptr<PartitionWriter>> writers;
+        std::vector<std::unique_ptr<PartitionIterator>> iterators;
+    };
+
+    // The number of partitions each side of the join is split into in the grace hash join mode.
+    static constexpr size_t kNumPartitions = 16;
+
+    /**
+     * Moves the contents of the hash table into the outer partitions and switches the stage into
+     * the grace hash join mode.
+     */
+    void switchToPartitionedMode();
+
+    /**
+     * Appends the (key, projects) row to the given partition of 'side'.
+     */
+    void writeToPartition(SpilledSide& side,
+                          const value::MaterializedRow& key,
+                          const value::MaterializedRow& project);
+
+    /**
+     * Finishes writing of all partitions of 'side' so that they can be read back.
+     */
+    void finishPartitions(SpilledSide& side);
+
+    /**
+     * Loads the next outer partition into the hash table and positions the stage on the matching
+     * inner partition. Returns false if there are no more partitions to join.
+     */
+    bool loadNextPartition();
+
+    PlanState getNextPartitioned();
+
+    /**
+     * Closes all partition files and deletes them from disk.
+     */
+    void removePartitions();
+
     const value::SlotVector _outerCond;
     const value::SlotVector _outerProjects;
     const value::SlotVector _innerCond;
     const value::SlotVector _innerProjects;
+    const size_t _memoryLimit;
+    const bool _allowDiskUse;
 
     // All defined values from the outer side (i.e. they come from the hash table).
     value::SlotAccessorMap _outOuterAccessors;
@@ -87,6 +160,13 @@ private:
     // Accessors of input codition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of input projection values from the inner side.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // Accessors of the inner condition and projection values. They read either directly from the
+    // inner child or, in the grace hash join mode, from the inner row read back from disk.
+    value::SlotMap<std::unique_ptr<value::SwitchAccessor>> _outInnerAccessors;
+
     // Key used to probe inside the hash table.
     value::MaterializedRow _probeKey;
 
@@ -94,8 +174,22 @@ private:
     TableType::iterator _htIt;
     TableType::iterator _htItEnd;
 
+    // The approximate amount of memory consumed by the hash table.
+    size_t _memoryUsage{0};
+
+    // State of the grace hash join mode.
+    bool _partitioned{false};
+    SpilledSide _outerPartitions;
+    SpilledSide _innerPartitions;
+    size_t _currentPartition{0};
+    PartitionIterator* _innerIt{nullptr};
+    PartitionData _innerData;
+    PartitionData* _innerDataIt{&_innerData};
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
+
+    HashJoinStats _specificStats;
 };
 }  // namespace mongo::sbe
@@ -35,6 +35,7 @@
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 
 namespace mongo::sbe {
@@ -121,6 +122,22 @@ value::SlotAccessor* IndexScanStage::getAccessor(CompileCtx& ctx, value::SlotId
 }
 
 void IndexScanStage::doSaveState() {
+    if (_block && !_block->exhausted()) {
+        // The entries read ahead may be modified while the cursor is saved. The entries of unique
+        // indexes may be stored without their RecordIds, so they're sought by key.
+        auto entry = _block->next();
+        _reseekKey = _uniqueIndex
+            ? IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                  KeyString::toBson(entry->keyString, *_ordering),
+                  entry->keyString.getVersion(),
+                  *_ordering,
+                  _forward,
+                  true /* inclusive */)
+            : entry->keyString;
+        _block->clear();
+        _blockReachedEnd = false;
+    }
+
     if (_cursor) {
         _cursor->save();
     }
@@ -226,6 +243,18 @@ void IndexScanStage::open(bool reOpen) {
             // TODO SERVER-49385: When the 'prepare()' phase takes the collection lock, it will be
             // possible to intialize '_ordering' there instead of here.
             _ordering = entry->ordering();
+            _uniqueIndex = entry->descriptor()->unique();
+
+            _maxBlockSize = internalQuerySlotBasedExecutionIndexScanBlockSize.load();
+            if (_maxBlockSize > 0 && !_block) {
+                _block.emplace(
+                    entry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
+            } else if (_block) {
+                _block->clear();
+            }
+            _blockSize = 1;
+            _blockReachedEnd = false;
+            _reseekKey.reset();
         } else {
             _cursor.reset();
         }
@@ -241,9 +270,17 @@ PlanState IndexScanStage::getNext() {
 
     checkForInterrupt(_opCtx);
 
+    // The entries of '_block' have already been checked against '_seekKeyHi'.
+    bool checkBound = true;
     if (_firstGetNext) {
         _firstGetNext = false;
         _nextRecord = _cursor->seekForKeyString(*_seekKeyLow);
+    } else if (_reseekKey) {
+        _nextRecord = _cursor->seekForKeyString(*_reseekKey);
+        _reseekKey.reset();
+    } else if (_block && _maxBlockSize > 0) {
+        _nextRecord = nextFromBlock();
+        checkBound = false;
     } else {
         _nextRecord = _cursor->nextKeyString();
     }
@@ -252,7 +289,7 @@ PlanState IndexScanStage::getNext() {
         return trackPlanState(PlanState::IS_EOF);
     }
 
-    if (_seekKeyHi) {
+    if (_seekKeyHi && checkBound) {
         auto cmp = _nextRecord->keyString.compare(*_seekKeyHi);
 
         if (_forward) {
@@ -293,6 +330,27 @@ PlanState IndexScanStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
+boost::optional<KeyStringEntry> IndexScanStage::nextFromBlock() {
+    if (_block->exhausted()) {
+        if (_blockReachedEnd) {
+            return boost::none;
+        }
+
+        _block->clear();
+        _cursor->nextKeyStringBlock(&*_block, _blockSize);
+        _blockReachedEnd = _block->size() < _blockSize;
+        if (_seekKeyHi) {
+            auto numWithinBound = _block->numWithinBound(*_seekKeyHi, _forward);
+            if (numWithinBound < _block->size()) {
+                _block->truncate(numWithinBound);
+                _blockReachedEnd = true;
+            }
+        }
+        _blockSize = std::min(_blockSize * 2, _maxBlockSize);
+    }
+    return _block->next();
+}
+
 void IndexScanStage::close() {
     _commonStats.closes++;
 
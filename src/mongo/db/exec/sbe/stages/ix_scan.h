@@ -85,12 +85,27 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 protected:
+    /**
+     * Drops the entries read ahead into '_block' which haven't been returned yet, so that they are
+     * read again once the cursor is restored.
+     */
     void doSaveState() override;
     void doRestoreState() override;
     void doDetachFromOperationContext() override;
     void doAttachFromOperationContext(OperationContext* opCtx) override;
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override {
+        if (_tracker) {
+            _tracker = tracker;
+        }
+    }
 
 private:
+    /**
+     * Returns the next entry of '_block', refilling it from '_cursor' with entries which are not
+     * past '_seekKeyHi' when it is exhausted, or boost::none past the last of them.
+     */
+    boost::optional<KeyStringEntry> nextFromBlock();
+
     const NamespaceStringOrUUID _name;
     const std::string _indexName;
     const bool _forward;
@@ -122,6 +137,19 @@ private:
     boost::optional<AutoGetCollectionForRead> _coll;
     boost::optional<KeyStringEntry> _nextRecord;
 
+    // Unless internalQuerySlotBasedExecutionIndexScanBlockSize is 0, the entries after the one the
+    // scan seeks to are read ahead from '_cursor' into '_block', in blocks which grow from a single
+    // entry to that many entries so that short scans don't read far past their bound.
+    boost::optional<KeyStringBlock> _block;
+    size_t _blockSize{0};
+    size_t _maxBlockSize{0};
+    bool _blockReachedEnd{false};
+
+    // The entry after the last one returned, which the cursor seeks to on the next call to
+    // getNext() when the entries read ahead were dropped on save.
+    boost::optional<KeyString::Value> _reseekKey;
+    bool _uniqueIndex{false};
+
     // This buffer stores values that are projected out of the index entry. Values in the
     // '_accessors' list that are pointers point to data in this buffer.
     BufBuilder _valuesBuffer;
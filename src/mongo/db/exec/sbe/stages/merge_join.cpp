@@ -0,0 +1,326 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/merge_join.h"
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+MergeJoinStage::MergeJoinStage(std::unique_ptr<PlanStage> outer,
+                               std::unique_ptr<PlanStage> inner,
+                               value::SlotVector outerKeys,
+                               value::SlotVector outerProjects,
+                               value::SlotVector innerKeys,
+                               std::vector<value::SortDirection> dirs)
+    : PlanStage("mj"_sd),
+      _outerKeys(std::move(outerKeys)),
+      _outerProjects(std::move(outerProjects)),
+      _innerKeys(std::move(innerKeys)),
+      _dirs(std::move(dirs)),
+      _outerKey(_outerKeys.size()),
+      _innerKey(_innerKeys.size()) {
+    uassert(5190170,
+            "merge join keys and sort directions do not match",
+            _outerKeys.size() == _innerKeys.size() && _outerKeys.size() == _dirs.size());
+
+    _children.emplace_back(std::move(outer));
+    _children.emplace_back(std::move(inner));
+}
+
+std::unique_ptr<PlanStage> MergeJoinStage::clone() const {
+    return std::make_unique<MergeJoinStage>(_children[0]->clone(),
+                                            _children[1]->clone(),
+                                            _outerKeys,
+                                            _outerProjects,
+                                            _innerKeys,
+                                            _dirs);
+}
+
+void MergeJoinStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+    _children[1]->prepare(ctx);
+
+    // The outer rows are buffered as their key values followed by their projection values.
+    size_t counter = 0;
+    value::SlotSet dupCheck;
+    for (auto& slot : _outerKeys) {
+        auto [it, inserted] = dupCheck.emplace(slot);
+        uassert(5190171, str::stream() << "duplicate field: " << slot, inserted);
+
+        _inOuterKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
+        _outOuterAccessorsStorage.emplace_back(
+            std::make_unique<BufferAccessor>(_outerBuffer, _outerBufferIt, counter++));
+        _outOuterAccessors[slot] = _outOuterAccessorsStorage.back().get();
+    }
+
+    for (auto& slot : _outerProjects) {
+        auto [it, inserted] = dupCheck.emplace(slot);
+        uassert(5190172, str::stream() << "duplicate field: " << slot, inserted);
+
+        _inOuterProjectAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
+        _outOuterAccessorsStorage.emplace_back(
+            std::make_unique<BufferAccessor>(_outerBuffer, _outerBufferIt, counter++));
+        _outOuterAccessors[slot] = _outOuterAccessorsStorage.back().get();
+    }
+
+    for (auto& slot : _innerKeys) {
+        auto [it, inserted] = dupCheck.emplace(slot);
+        uassert(5190173, str::stream() << "duplicate field: " << slot, inserted);
+
+        _inInnerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+    }
+
+    _compiled = true;
+}
+
+value::SlotAccessor* MergeJoinStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    if (_compiled) {
+        if (auto it = _outOuterAccessors.find(slot); it != _outOuterAccessors.end()) {
+            return it->second;
+        }
+
+        return _children[1]->getAccessor(ctx, slot);
+    }
+
+    return ctx.getAccessor(slot);
+}
+
+int MergeJoinStage::compareKeys(const value::MaterializedRow& lhs,
+                                const value::MaterializedRow& rhs) const {
+    for (size_t idx = 0; idx < _dirs.size(); ++idx) {
+        auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+        uassert(5190174,
+                "merge join keys are not comparable",
+                tag == value::TypeTags::NumberInt32);
+
+        if (auto result = value::bitcastTo<int32_t>(val); result != 0) {
+            return _dirs[idx] == value::SortDirection::Ascending ? result : -result;
+        }
+    }
+
+    return 0;
+}
+
+bool MergeJoinStage::hasNothingKey(const value::MaterializedRow& row) const {
+    for (size_t idx = 0; idx < _dirs.size(); ++idx) {
+        if (row.getViewOfValue(idx).first == value::TypeTags::Nothing) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MergeJoinStage::advanceOuter() {
+    while ((_outerAdvanced = _children[0]->getNext() == PlanState::ADVANCED)) {
+        size_t idx = 0;
+        for (auto& p : _inOuterKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _outerKey.reset(idx++, false, tag, val);
+        }
+
+        if (!hasNothingKey(_outerKey)) {
+            return;
+        }
+    }
+}
+
+void MergeJoinStage::bufferOuterRows() {
+    _outerBuffer.clear();
+    do {
+        value::MaterializedRow row{_inOuterKeyAccessors.size() + _inOuterProjectAccessors.size()};
+        size_t idx = 0;
+        for (auto& p : _inOuterKeyAccessors) {
+            auto [tag, val] = p->copyOrMoveValue();
+            row.reset(idx++, true, tag, val);
+        }
+        for (auto& p : _inOuterProjectAccessors) {
+            auto [tag, val] = p->copyOrMoveValue();
+            row.reset(idx++, true, tag, val);
+        }
+        _outerBuffer.emplace_back(std::move(row));
+
+        advanceOuter();
+    } while (_outerAdvanced && compareKeys(_outerKey, _outerBuffer.front()) == 0);
+}
+
+void MergeJoinStage::open(bool reOpen) {
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+    _children[1]->open(reOpen);
+
+    _outerBuffer.clear();
+    _outerBufferIt = 0;
+    _matching = false;
+    advanceOuter();
+}
+
+PlanState MergeJoinStage::getNext() {
+    // Combine the current inner row with the remaining buffered outer rows first.
+    if (_matching && ++_outerBufferIt < _outerBuffer.size()) {
+        return trackPlanState(PlanState::ADVANCED);
+    }
+    _matching = false;
+
+    for (;;) {
+        // No more inner rows can match once the outer side is exhausted.
+        if (_outerBuffer.empty() && !_outerAdvanced) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        auto state = _children[1]->getNext();
+        if (state != PlanState::ADVANCED) {
+            return trackPlanState(state);
+        }
+
+        size_t idx = 0;
+        for (auto& p : _inInnerKeyAccessors) {
+            auto [tag, val] = p->getViewOfValue();
+            _innerKey.reset(idx++, false, tag, val);
+        }
+
+        if (hasNothingKey(_innerKey)) {
+            continue;
+        }
+
+        // The buffered outer rows are kept for as long as the inner rows have their key, and
+        // discarded once the inner side moves past it.
+        if (!_outerBuffer.empty()) {
+            auto result = compareKeys(_outerBuffer.front(), _innerKey);
+            if (result > 0) {
+                continue;
+            }
+            if (result < 0) {
+                _outerBuffer.clear();
+            }
+        }
+
+        if (_outerBuffer.empty()) {
+            while (_outerAdvanced && compareKeys(_outerKey, _innerKey) < 0) {
+                advanceOuter();
+            }
+            if (!_outerAdvanced || compareKeys(_outerKey, _innerKey) > 0) {
+                continue;
+            }
+
+            bufferOuterRows();
+        }
+
+        _matching = true;
+        _outerBufferIt = 0;
+        return trackPlanState(PlanState::ADVANCED);
+    }
+}
+
+void MergeJoinStage::close() {
+    _commonStats.closes++;
+    _children[1]->close();
+    _children[0]->close();
+    _outerBuffer.clear();
+}
+
+std::unique_ptr<PlanStageStats> MergeJoinStage::getStats() const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->children.emplace_back(_children[0]->getStats());
+    ret->children.emplace_back(_children[1]->getStats());
+    return ret;
+}
+
+const SpecificStats* MergeJoinStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> MergeJoinStage::debugPrint() const {
+    std::vector<DebugPrinter::Block> ret;
+    DebugPrinter::addKeyword(ret, "mj");
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _dirs.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+
+        DebugPrinter::addKeyword(ret,
+                                 _dirs[idx] == value::SortDirection::Ascending ? "asc" : "desc");
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+
+    DebugPrinter::addKeyword(ret, "left");
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _outerKeys.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+
+        DebugPrinter::addIdentifier(ret, _outerKeys[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _outerProjects.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+
+        DebugPrinter::addIdentifier(ret, _outerProjects[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    DebugPrinter::addKeyword(ret, "right");
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _innerKeys.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+
+        DebugPrinter::addIdentifier(ret, _innerKeys[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block::cmdIncIndent);
+    DebugPrinter::addBlocks(ret, _children[1]->debugPrint());
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    ret.emplace_back(DebugPrinter::Block::cmdDecIndent);
+
+    return ret;
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+
+namespace mongo::sbe {
+/**
+ * Joins the rows of the 'outer' side with the rows of the 'inner' side which have equal
+ * 'outerKeys' and 'innerKeys' values. Both sides must produce their rows sorted on the keys, in
+ * the directions given by 'dirs'.
+ *
+ * Unlike the hash join, the stage streams both sides in a single pass, and only keeps in memory
+ * the outer rows which share the key value currently being joined, with their 'outerProjects'
+ * values. The joined rows are produced in the order of the inner side, with every matching inner
+ * row combined with each buffered outer row. Rows with a Nothing key value do not match any row.
+ */
+class MergeJoinStage final : public PlanStage {
+public:
+    MergeJoinStage(std::unique_ptr<PlanStage> outer,
+                   std::unique_ptr<PlanStage> inner,
+                   value::SlotVector outerKeys,
+                   value::SlotVector outerProjects,
+                   value::SlotVector innerKeys,
+                   std::vector<value::SortDirection> dirs);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats() const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+private:
+    using BufferType = std::vector<value::MaterializedRow>;
+    using BufferAccessor = value::MaterializedRowAccessor<BufferType>;
+
+    /**
+     * Compares the keys, which are the leading values of the rows 'lhs' and 'rhs', in the sort
+     * order of the join. Returns a negative number, zero or a positive number if the 'lhs' key
+     * sorts before, equal to or after the 'rhs' key respectively.
+     */
+    int compareKeys(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) const;
+
+    /**
+     * Returns whether any of the key values of 'row' is Nothing, so that the row cannot match.
+     */
+    bool hasNothingKey(const value::MaterializedRow& row) const;
+
+    /**
+     * Advances the outer side, skipping the rows which cannot match because of a Nothing key.
+     * Sets '_outerAdvanced' to whether the outer side is positioned on a row, and '_outerKey' to
+     * the key of that row.
+     */
+    void advanceOuter();
+
+    /**
+     * Loads the outer rows which share the key value of the current outer row into the buffer,
+     * leaving the outer side positioned on the first row with a different key.
+     */
+    void bufferOuterRows();
+
+    const value::SlotVector _outerKeys;
+    const value::SlotVector _outerProjects;
+    const value::SlotVector _innerKeys;
+    const std::vector<value::SortDirection> _dirs;
+
+    // Accessors of the key and projection values produced by the outer child.
+    std::vector<value::SlotAccessor*> _inOuterKeyAccessors;
+    std::vector<value::SlotAccessor*> _inOuterProjectAccessors;
+
+    // Accessors of the key values produced by the inner child.
+    std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
+
+    // The outer rows, made of the key values followed by the projection values, which share the
+    // key value currently being joined.
+    BufferType _outerBuffer;
+    size_t _outerBufferIt{0};
+
+    // Views of the keys of the current outer and inner child rows.
+    value::MaterializedRow _outerKey;
+    value::MaterializedRow _innerKey;
+
+    // Accessors of the outer values, which all come from the currently emitted buffered row.
+    std::vector<std::unique_ptr<BufferAccessor>> _outOuterAccessorsStorage;
+    value::SlotAccessorMap _outOuterAccessors;
+
+    // Whether the outer child is positioned on a row which has not been buffered yet.
+    bool _outerAdvanced{false};
+
+    // Whether the current inner row matches the buffered outer rows.
+    bool _matching{false};
+
+    bool _compiled{false};
+};
+}  // namespace mongo::sbe
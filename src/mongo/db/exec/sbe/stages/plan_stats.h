@@ -99,6 +99,43 @@ struct LimitSkipStats : public SpecificStats {
     boost::optional<long long> skip;
 };
 
+struct HashAggStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashAggStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return sizeof(*this);
+    }
+
+    // Whether the hash table was spilled to disk during the execution of this stage.
+    bool usedDisk{false};
+    // The number of times the hash table was spilled to disk.
+    size_t spills{0};
+    // The total number of (key, partial aggregate) records written to disk.
+    size_t spilledRecords{0};
+    // The total number of bytes written to the spill file.
+    size_t spilledBytes{0};
+};
+
+struct HashJoinStats : public SpecificStats {
+    SpecificStats* clone() const final {
+        return new HashJoinStats(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const {
+        return sizeof(*this);
+    }
+
+    // Whether the stage switched to the grace hash join mode and partitioned its inputs to disk.
+    bool usedDisk{false};
+    // The number of partitions each input was split into.
+    size_t numPartitions{0};
+    // The number of rows written to the partitions of the outer and inner sides.
+    size_t spilledOuterRecords{0};
+    size_t spilledInnerRecords{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
@@ -69,6 +69,11 @@ protected:
     void doRestoreState() override;
     void doDetachFromOperationContext() override;
     void doAttachFromOperationContext(OperationContext* opCtx) override;
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override {
+        if (_tracker) {
+            _tracker = tracker;
+        }
+    }
 
 private:
     const NamespaceStringOrUUID _name;
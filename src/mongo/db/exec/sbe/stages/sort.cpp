@@ -31,6 +31,8 @@
 
 #include "mongo/db/exec/sbe/stages/sort.h"
 
+#include <algorithm>
+
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/util/str.h"
 
@@ -65,6 +67,9 @@ SortStage::SortStage(std::unique_ptr<PlanStage> input,
     _children.emplace_back(std::move(input));
 
     invariant(_obs.size() == _dirs.size());
+
+    _specificStats.limit = _limit != std::numeric_limits<size_t>::max() ? _limit : 0;
+    _specificStats.maxMemoryUsageBytes = _memoryLimit;
 }
 
 SortStage ::~SortStage() {}
@@ -118,51 +123,110 @@ void SortStage::makeSorter() {
     opts.limit = _limit != std::numeric_limits<size_t>::max() ? _limit : 0;
 
     auto comp = [&](const SorterData& lhs, const SorterData& rhs) {
-        auto size = lhs.first.size();
-        auto& left = lhs.first;
-        auto& right = rhs.first;
-        for (size_t idx = 0; idx < size; ++idx) {
-            auto [lhsTag, lhsVal] = left.getViewOfValue(idx);
-            auto [rhsTag, rhsVal] = right.getViewOfValue(idx);
-            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
-
-            auto result = value::bitcastTo<int32_t>(val);
-            if (result) {
-                return _dirs[idx] == value::SortDirection::Descending ? -result : result;
-            }
-        }
-
-        return 0;
+        return compareKeys(lhs.first, rhs.first);
     };
 
     _sorter.reset(Sorter<value::MaterializedRow, value::MaterializedRow>::make(opts, comp, {}));
     _mergeIt.reset();
 }
 
+int SortStage::compareKeys(const value::MaterializedRow& lhs,
+                           const value::MaterializedRow& rhs) const {
+    auto size = lhs.size();
+    for (size_t idx = 0; idx < size; ++idx) {
+        auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return _dirs[idx] == value::SortDirection::Descending ? -result : result;
+        }
+    }
+
+    return 0;
+}
+
+int SortStage::compareInputKeys(const value::MaterializedRow& rhs) const {
+    for (size_t idx = 0; idx < _inKeyAccessors.size(); ++idx) {
+        auto [lhsTag, lhsVal] = _inKeyAccessors[idx]->getViewOfValue();
+        auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+        auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+
+        auto result = value::bitcastTo<int32_t>(val);
+        if (result) {
+            return _dirs[idx] == value::SortDirection::Descending ? -result : result;
+        }
+    }
+
+    return 0;
+}
+
+SortStage::SorterData SortStage::materializeInput() {
+    value::MaterializedRow keys{_inKeyAccessors.size()};
+    value::MaterializedRow vals{_inValueAccessors.size()};
+
+    size_t idx = 0;
+    for (auto accesor : _inKeyAccessors) {
+        auto [tag, val] = accesor->copyOrMoveValue();
+        keys.reset(idx++, true, tag, val);
+    }
+
+    idx = 0;
+    for (auto accesor : _inValueAccessors) {
+        auto [tag, val] = accesor->copyOrMoveValue();
+        vals.reset(idx++, true, tag, val);
+    }
+
+    _specificStats.totalDataSizeBytes += keys.memUsageForSorter() + vals.memUsageForSorter();
+    return {std::move(keys), std::move(vals)};
+}
+
+void SortStage::flushTopK() {
+    for (auto&& [keys, vals] : _topK) {
+        _sorter->emplace(std::move(keys), std::move(vals));
+    }
+    _topK.clear();
+    _topKMemUsageBytes = 0;
+}
+
 void SortStage::open(bool reOpen) {
     _commonStats.opens++;
     _children[0]->open(reOpen);
 
     makeSorter();
 
+    _topK.clear();
+    _topKMemUsageBytes = 0;
+    bool useTopK = _limit != 0 && _limit != std::numeric_limits<size_t>::max();
+    auto heapComp = [&](const SorterData& lhs, const SorterData& rhs) {
+        return compareKeys(lhs.first, rhs.first) < 0;
+    };
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
-        value::MaterializedRow keys{_inKeyAccessors.size()};
-        value::MaterializedRow vals{_inValueAccessors.size()};
+        if (!useTopK) {
+            auto [keys, vals] = materializeInput();
+            _sorter->emplace(std::move(keys), std::move(vals));
+        } else if (_topK.size() < _limit || compareInputKeys(_topK.front().first) < 0) {
+            if (_topK.size() == _limit) {
+                std::pop_heap(_topK.begin(), _topK.end(), heapComp);
+                _topKMemUsageBytes -= _topK.back().first.memUsageForSorter() +
+                    _topK.back().second.memUsageForSorter();
+                _topK.pop_back();
+            }
 
-        size_t idx = 0;
-        for (auto accesor : _inKeyAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            keys.reset(idx++, true, tag, val);
-        }
+            _topK.push_back(materializeInput());
+            _topKMemUsageBytes +=
+                _topK.back().first.memUsageForSorter() + _topK.back().second.memUsageForSorter();
+            std::push_heap(_topK.begin(), _topK.end(), heapComp);
 
-        idx = 0;
-        for (auto accesor : _inValueAccessors) {
-            auto [tag, val] = accesor->copyOrMoveValue();
-            vals.reset(idx++, true, tag, val);
+            // Let the sorter spill, or fail, once the first rows take more memory than allowed.
+            if (_topKMemUsageBytes > _memoryLimit) {
+                flushTopK();
+                useTopK = false;
+            }
         }
 
-        _sorter->emplace(std::move(keys), std::move(vals));
-
         if (_tracker && _tracker->trackProgress<TrialRunProgressTracker::kNumResults>(1)) {
             // If we either hit the maximum number of document to return during the trial run, or
             // if we've performed enough physical reads, stop populating the sort heap and bail out
@@ -178,7 +242,10 @@ void SortStage::open(bool reOpen) {
         }
     }
 
+    flushTopK();
     _mergeIt.reset(_sorter->done());
+    _specificStats.wasDiskUsed = _specificStats.wasDiskUsed || _sorter->usedDisk();
+    _specificStats.spills += _sorter->numSpills();
 
     _children[0]->close();
 }
@@ -198,16 +265,19 @@ void SortStage::close() {
     _commonStats.closes++;
     _mergeIt.reset();
     _sorter.reset();
+    _topK.clear();
+    _topKMemUsageBytes = 0;
 }
 
 std::unique_ptr<PlanStageStats> SortStage::getStats() const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<SortStats>(_specificStats);
     ret->children.emplace_back(_children[0]->getStats());
     return ret;
 }
 
 const SpecificStats* SortStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> SortStage::debugPrint() const {
@@ -65,12 +65,36 @@ public:
     const SpecificStats* getSpecificStats() const final;
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
-private:
-    void makeSorter();
+protected:
+    void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) override {
+        if (_tracker) {
+            _tracker = tracker;
+        }
+    }
 
+private:
     using SorterIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
     using SorterData = std::pair<value::MaterializedRow, value::MaterializedRow>;
 
+    void makeSorter();
+
+    /**
+     * Compares the sort keys of two rows, or the sort keys of the current input row with those of
+     * 'rhs', in the sort order. Returns a negative number if the left side sorts first.
+     */
+    int compareKeys(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) const;
+    int compareInputKeys(const value::MaterializedRow& rhs) const;
+
+    /**
+     * Copies the current input row into a row which can be handed to the sorter.
+     */
+    SorterData materializeInput();
+
+    /**
+     * Hands the rows of '_topK' over to the sorter.
+     */
+    void flushTopK();
+
     const value::SlotVector _obs;
     const std::vector<value::SortDirection> _dirs;
     const value::SlotVector _vals;
@@ -88,8 +112,17 @@ private:
     SorterData* _mergeDataIt{&_mergeData};
     std::unique_ptr<Sorter<value::MaterializedRow, value::MaterializedRow>> _sorter;
 
+    // Only used when '_limit' is set. A heap of the first '_limit' input rows in the sort order,
+    // with the last of them on top, and its memory footprint. An input row which doesn't sort
+    // before the top of the heap is dropped without being copied. The rows are handed over to the
+    // sorter once the input is exhausted, or once they exceed '_memoryLimit'.
+    std::vector<SorterData> _topK;
+    size_t _topKMemUsageBytes{0};
+
     // If provided, used during a trial run to accumulate certain execution stats. Once the trial
     // run is complete, this pointer is reset to nullptr.
     TrialRunProgressTracker* _tracker{nullptr};
+
+    SortStats _specificStats;
 };
 }  // namespace mongo::sbe
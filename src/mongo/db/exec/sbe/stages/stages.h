@@ -38,6 +38,8 @@
 #include "mongo/db/query/plan_yield_policy.h"
 
 namespace mongo {
+class TrialRunProgressTracker;
+
 namespace sbe {
 
 struct CompileCtx;
@@ -208,7 +210,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -239,6 +241,23 @@ public:
      */
     virtual std::unique_ptr<PlanStage> clone() const = 0;
 
+    /**
+     * Makes the stages of this tree which yield, and the stages which track the progress of a
+     * trial run, use 'yieldPolicy' and 'tracker' in place of the ones the tree was built with.
+     * This allows a copy of a tree built for another query to run. Must be called before
+     * prepare().
+     */
+    void attachToYieldPolicyAndTracker(PlanYieldPolicy* yieldPolicy,
+                                       TrialRunProgressTracker* tracker) {
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+        doAttachToTrialRunTracker(tracker);
+        for (auto&& child : _children) {
+            child->attachToYieldPolicyAndTracker(yieldPolicy, tracker);
+        }
+    }
+
     /**
      * Prepare this SBE PlanStage tree for execution. Must be called once, and must be called
      * prior to open(), getNext(), close(), saveState(), or restoreState(),
@@ -279,6 +298,12 @@ public:
     friend class CanChangeState;
 
 protected:
+    /**
+     * Stages which track the progress of a trial run override this to report to 'tracker' instead
+     * of the tracker they were built with, if they were built with one.
+     */
+    virtual void doAttachToTrialRunTracker(TrialRunProgressTracker* tracker) {}
+
     std::vector<std::unique_ptr<PlanStage>> _children;
 };
 
@@ -0,0 +1,266 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/slot.h"
+
+namespace mongo::sbe::value {
+/**
+ * An open-addressing hash map keyed by 'MaterializedRow', tuned for the hash tables built by the
+ * SBE stages.
+ *
+ * The (key, value) entries are stored contiguously in insertion order. The table itself is a flat
+ * array of small slots, each holding the full precomputed hash of a key and the index of its entry.
+ * Lookups use linear probing over the slot array and only compare the keys whose hashes are equal,
+ * so that a probe rarely touches the entries, and a rehash never rehashes or moves the keys.
+ *
+ * Iterators are indices into the entry array. Unlike the iterators of 'std::unordered_map', they
+ * remain valid when the map grows, but the references returned by them do not. Erasing individual
+ * entries is not supported.
+ */
+template <typename V>
+class MaterializedRowHashMap {
+public:
+    using key_type = MaterializedRow;
+    using mapped_type = V;
+    using value_type = std::pair<MaterializedRow, V>;
+
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using MapType =
+            std::conditional_t<IsConst, const MaterializedRowHashMap, MaterializedRowHashMap>;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        Iterator() = default;
+        Iterator(MapType* map, size_t index) : _map(map), _index(index) {}
+
+        reference operator*() const {
+            return _map->_entries[_index];
+        }
+        pointer operator->() const {
+            return &_map->_entries[_index];
+        }
+
+        Iterator& operator++() {
+            ++_index;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _index == other._index;
+        }
+        bool operator!=(const Iterator& other) const {
+            return _index != other._index;
+        }
+
+    private:
+        MapType* _map{nullptr};
+        size_t _index{0};
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() {
+        return {this, 0};
+    }
+    iterator end() {
+        return {this, _entries.size()};
+    }
+    const_iterator begin() const {
+        return {this, 0};
+    }
+    const_iterator end() const {
+        return {this, _entries.size()};
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    /**
+     * Removes all entries. Keeps the allocated memory of small tables so that a table which is
+     * repeatedly cleared and refilled with a few entries does not reallocate.
+     */
+    void clear() {
+        _entries.clear();
+        if (_capacity > kMaxRetainedCapacity) {
+            _slots.reset();
+            _capacity = 0;
+            _shift = kHashBits;
+            _entries.shrink_to_fit();
+        } else {
+            std::fill(_slots.get(), _slots.get() + _capacity, Slot{});
+        }
+    }
+
+    /**
+     * Makes room for at least 'count' entries without growing the table.
+     */
+    void reserve(size_t count) {
+        _entries.reserve(count);
+        if (count > maxSizeFor(_capacity)) {
+            rehash(capacityFor(count));
+        }
+    }
+
+    iterator find(const MaterializedRow& key) {
+        return {this, findIndex(key, MaterializedRowHasher()(key))};
+    }
+    const_iterator find(const MaterializedRow& key) const {
+        return {this, findIndex(key, MaterializedRowHasher()(key))};
+    }
+
+    /**
+     * Inserts an entry constructed from 'key' and 'args' unless the map already contains an equal
+     * key. Returns the iterator to the entry with this key and whether the insertion took place.
+     */
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const size_t hash = MaterializedRowHasher()(key);
+        if (auto index = findIndex(key, hash); index != _entries.size()) {
+            return {{this, index}, false};
+        }
+
+        if (_entries.size() + 1 > maxSizeFor(_capacity)) {
+            rehash(_capacity ? _capacity * 2 : kMinCapacity);
+        }
+
+        const size_t index = _entries.size();
+        _entries.emplace_back(std::piecewise_construct,
+                              std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        insertSlot(hash, index);
+        return {{this, index}, true};
+    }
+
+    V& operator[](const MaterializedRow& key) {
+        return try_emplace(key).first->second;
+    }
+
+private:
+    static constexpr size_t kEmptySlot = std::numeric_limits<size_t>::max();
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr size_t kMaxRetainedCapacity = 1024;
+    static constexpr size_t kHashBits = std::numeric_limits<size_t>::digits;
+
+    struct Slot {
+        size_t hash{0};
+        size_t index{kEmptySlot};
+    };
+
+    // The table is grown when it becomes more than 3/4 full.
+    static size_t maxSizeFor(size_t capacity) {
+        return capacity - capacity / 4;
+    }
+
+    static size_t capacityFor(size_t count) {
+        size_t capacity = kMinCapacity;
+        while (maxSizeFor(capacity) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    /**
+     * Maps a hash onto the slot array. The hash is scrambled with the multiplicative (Fibonacci)
+     * method and its high bits are used, as 'MaterializedRowHasher' does not guarantee that the
+     * low bits of hashes are evenly distributed.
+     */
+    size_t slotFor(size_t hash) const {
+        return (hash * 11400714819323198485llu) >> _shift;
+    }
+
+    size_t findIndex(const MaterializedRow& key, size_t hash) const {
+        if (!_capacity) {
+            return _entries.size();
+        }
+
+        const size_t mask = _capacity - 1;
+        for (size_t pos = slotFor(hash);; pos = (pos + 1) & mask) {
+            const auto& slot = _slots[pos];
+            if (slot.index == kEmptySlot) {
+                return _entries.size();
+            }
+            if (slot.hash == hash && _entries[slot.index].first == key) {
+                return slot.index;
+            }
+        }
+    }
+
+    void insertSlot(size_t hash, size_t index) {
+        const size_t mask = _capacity - 1;
+        size_t pos = slotFor(hash);
+        while (_slots[pos].index != kEmptySlot) {
+            pos = (pos + 1) & mask;
+        }
+        _slots[pos] = {hash, index};
+    }
+
+    void rehash(size_t capacity) {
+        auto oldSlots = std::move(_slots);
+        const size_t oldCapacity = _capacity;
+
+        _slots = std::make_unique<Slot[]>(capacity);
+        _capacity = capacity;
+        _shift = kHashBits;
+        for (size_t cap = capacity; cap > 1; cap /= 2) {
+            --_shift;
+        }
+
+        // The precomputed hashes let us rebuild the slot array without touching the entries.
+        for (size_t pos = 0; pos < oldCapacity; ++pos) {
+            if (oldSlots[pos].index != kEmptySlot) {
+                insertSlot(oldSlots[pos].hash, oldSlots[pos].index);
+            }
+        }
+    }
+
+    std::vector<value_type> _entries;
+    std::unique_ptr<Slot[]> _slots;
+    // The number of slots. Always zero or a power of two.
+    size_t _capacity{0};
+    // The number of low bits dropped from a scrambled hash to get a slot position.
+    size_t _shift{kHashBits};
+};
+}  // namespace mongo::sbe::value
@@ -0,0 +1,194 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/materialized_row_hash_map.h"
+#include "mongo/stdx/unordered_map.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <string>
+
+namespace mongo::sbe {
+namespace {
+
+constexpr uint32_t kMaxContainerSize = 1000000;
+// Two fixed seeds, what they are doesn't matter much, they should just generate distict ranges.
+constexpr uint32_t kDefaultSeed = 34862;
+constexpr uint32_t kOtherSeed = 76453;
+
+using StdUnorderedRow = stdx::
+    unordered_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
+using AbslFlatHashMapRow = absl::
+    flat_hash_map<value::MaterializedRow, value::MaterializedRow, value::MaterializedRowHasher>;
+using SbeRowHashMap = value::MaterializedRowHashMap<value::MaterializedRow>;
+
+/**
+ * Generates single column keys, either 64-bit integers or strings which are too long to be stored
+ * inline in a value.
+ */
+template <bool StringKeys, uint32_t Seed>
+class RowGenerator {
+public:
+    RowGenerator() : _gen(Seed) {}
+
+    value::MaterializedRow generate() {
+        const uint32_t i = _dist(_gen);
+        value::MaterializedRow row{1};
+        if constexpr (StringKeys) {
+            auto [tag, val] = value::makeNewString("key-" + std::to_string(i));
+            row.reset(0, true, tag, val);
+        } else {
+            row.reset(0, true, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+        }
+        return row;
+    }
+
+private:
+    std::uniform_int_distribution<uint32_t> _dist;
+    std::mt19937 _gen;
+};
+
+template <class Container, class StorageGenerator, class LookupGenerator>
+void LookupTest(benchmark::State& state) {
+    Container container;
+    StorageGenerator storage_gen;
+
+    const int num = state.range(0) + 1;
+    for (int i = num - 1; i; --i) {
+        container.try_emplace(storage_gen.generate(), value::MaterializedRow{1});
+    }
+
+    std::vector<value::MaterializedRow> lookup_keys;
+    LookupGenerator lookup_gen;
+    for (int i = num; i; --i) {
+        lookup_keys.push_back(lookup_gen.generate());
+    }
+    // Make sure we don't do the lookup in the same order as insert.
+    std::shuffle(lookup_keys.begin(),
+                 lookup_keys.end(),
+                 std::default_random_engine(kDefaultSeed + kOtherSeed));
+
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(container.find(lookup_keys[i++]));
+        if (i == num) {
+            i = 0;
+        }
+    }
+
+    state.counters["size"] = state.range(0);
+}
+
+template <class Container, class StorageGenerator>
+void InsertTest(benchmark::State& state) {
+    std::vector<value::MaterializedRow> insert_keys;
+    StorageGenerator storage_gen;
+
+    const int num = state.range(0);
+    for (int i = num; i; --i) {
+        insert_keys.push_back(storage_gen.generate());
+    }
+
+    int i = 0;
+    Container container;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(
+            container.try_emplace(insert_keys[i++], value::MaterializedRow{1}));
+        if (i == num) {
+            i = 0;
+
+            Container swap_container;
+            std::swap(container, swap_container);
+        }
+    }
+
+    state.counters["size"] = state.range(0);
+}
+
+template <class Container, bool StringKeys>
+void BM_SuccessfulLookup(benchmark::State& state) {
+    LookupTest<Container,
+               RowGenerator<StringKeys, kDefaultSeed>,
+               RowGenerator<StringKeys, kDefaultSeed>>(state);
+}
+
+template <class Container, bool StringKeys>
+void BM_UnsuccessfulLookup(benchmark::State& state) {
+    LookupTest<Container,
+               RowGenerator<StringKeys, kDefaultSeed>,
+               RowGenerator<StringKeys, kOtherSeed>>(state);
+}
+
+template <class Container, bool StringKeys>
+void BM_Insert(benchmark::State& state) {
+    InsertTest<Container, RowGenerator<StringKeys, kDefaultSeed>>(state);
+}
+
+template <uint32_t Start = 0>
+static void Range(benchmark::internal::Benchmark* b) {
+    b->Arg(Start);
+    for (uint32_t n = 16; n <= kMaxContainerSize; n *= 4) {
+        b->Arg(n);
+    }
+}
+
+// Integer key tests
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, StdUnorderedRow, false)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, AbslFlatHashMapRow, false)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, SbeRowHashMap, false)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, StdUnorderedRow, false)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, AbslFlatHashMapRow, false)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, SbeRowHashMap, false)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_Insert, StdUnorderedRow, false)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_Insert, AbslFlatHashMapRow, false)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_Insert, SbeRowHashMap, false)->Apply(Range<1>);
+
+// String key tests
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, StdUnorderedRow, true)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, AbslFlatHashMapRow, true)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_SuccessfulLookup, SbeRowHashMap, true)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, StdUnorderedRow, true)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, AbslFlatHashMapRow, true)->Apply(Range);
+BENCHMARK_TEMPLATE(BM_UnsuccessfulLookup, SbeRowHashMap, true)->Apply(Range);
+
+BENCHMARK_TEMPLATE(BM_Insert, StdUnorderedRow, true)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_Insert, AbslFlatHashMapRow, true)->Apply(Range<1>);
+BENCHMARK_TEMPLATE(BM_Insert, SbeRowHashMap, true)->Apply(Range<1>);
+
+}  // namespace
+}  // namespace mongo::sbe
@@ -742,20 +742,18 @@ void readKeyStringValueIntoAccessors(const KeyString::Value& keyString,
             ? (ordering.get(componentIndex) == -1)
             : false;
 
-        keepReading = KeyString::readSBEValue(
-            &reader, &typeBitsReader, inverted, typeBits.version, &valBuilder);
+        // If 'indexKeysToInclude' indicates that this index key component is not part of the
+        // projection, skip over it without converting it. It still has to be read to advance the
+        // 'reader' and 'typeBitsReader' streams.
+        const bool include = !indexKeysToInclude ||
+            componentIndex >= Ordering::kMaxCompoundIndexKeys ||
+            (*indexKeysToInclude)[componentIndex];
+        keepReading = include
+            ? KeyString::readSBEValue(
+                  &reader, &typeBitsReader, inverted, typeBits.version, &valBuilder)
+            : KeyString::skipSBEValue(&reader, &typeBitsReader, inverted, typeBits.version);
 
         invariant(componentIndex < Ordering::kMaxCompoundIndexKeys || !keepReading);
-
-        // If 'indexKeysToInclude' indicates that this index key component is not part of the
-        // projection, remove it from the list of values that will be fed to the 'accessors' list.
-        // Note that, even when we are excluding a key component, we can't skip the call to
-        // 'KeyString::readSBEValue()' because it is needed to advance the 'reader' and
-        // 'typeBitsReader' stream.
-        if (indexKeysToInclude && (componentIndex < Ordering::kMaxCompoundIndexKeys) &&
-            !(*indexKeysToInclude)[componentIndex]) {
-            valBuilder.popValue();
-        }
         ++componentIndex;
     } while (keepReading && valBuilder.numValues() < accessors->size());
 
@@ -491,6 +491,227 @@ std::pair<value::TypeTags, value::Value> ByteCode::compare3way(value::TypeTags l
 
     return value::compareValue(lhsTag, lhsValue, rhsTag, rhsValue);
 }
+
+namespace {
+/**
+ * Returns the tag shared by all values of the block, or Nothing if the block holds values of
+ * different types.
+ */
+value::TypeTags commonBlockTag(size_t count, const value::TypeTags* tags) {
+    if (!count) {
+        return value::TypeTags::Nothing;
+    }
+    for (size_t idx = 1; idx < count; ++idx) {
+        if (tags[idx] != tags[0]) {
+            return value::TypeTags::Nothing;
+        }
+    }
+    return tags[0];
+}
+
+/**
+ * Returns true if the fast path for a block of numbers with the tag 'blockTag' can be used with
+ * the scalar operand with the tag 'rhsTag', i.e. the block values do not have to be widened.
+ */
+bool canUseNumericBlockPath(value::TypeTags blockTag, value::TypeTags rhsTag) {
+    switch (blockTag) {
+        case value::TypeTags::NumberInt32:
+        case value::TypeTags::NumberInt64:
+        case value::TypeTags::NumberDouble:
+            return value::isNumber(rhsTag) && getWidestNumericalType(blockTag, rhsTag) == blockTag;
+        default:
+            return false;
+    }
+}
+
+template <typename T, typename Fn>
+void compareNumericBlock(
+    size_t count, const value::Value* vals, T rhs, value::Value* outVals, Fn fn) {
+    for (size_t idx = 0; idx < count; ++idx) {
+        outVals[idx] = fn(value::bitcastTo<T>(vals[idx]), rhs);
+    }
+}
+
+/**
+ * Applies the comparison to a block of values. The comparison is given both as the function 'fn' on
+ * C++ numbers, used by the vectorizable loops, and as 'scalar', the per-value implementation of the
+ * instruction.
+ */
+template <typename Fn, typename Scalar>
+void compareBlockImpl(size_t count,
+                      const value::TypeTags* tags,
+                      const value::Value* vals,
+                      value::TypeTags rhsTag,
+                      value::Value rhsVal,
+                      value::TypeTags* outTags,
+                      value::Value* outVals,
+                      Fn fn,
+                      Scalar scalar) {
+    auto blockTag = commonBlockTag(count, tags);
+    if (!canUseNumericBlockPath(blockTag, rhsTag)) {
+        for (size_t idx = 0; idx < count; ++idx) {
+            std::tie(outTags[idx], outVals[idx]) = scalar(tags[idx], vals[idx], rhsTag, rhsVal);
+        }
+        return;
+    }
+
+    std::fill(outTags, outTags + count, value::TypeTags::Boolean);
+    switch (blockTag) {
+        case value::TypeTags::NumberInt32:
+            compareNumericBlock(count, vals, numericCast<int32_t>(rhsTag, rhsVal), outVals, fn);
+            break;
+        case value::TypeTags::NumberInt64:
+            compareNumericBlock(count, vals, numericCast<int64_t>(rhsTag, rhsVal), outVals, fn);
+            break;
+        case value::TypeTags::NumberDouble:
+            compareNumericBlock(count, vals, numericCast<double>(rhsTag, rhsVal), outVals, fn);
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Applies the arithmetic operation 'Op' to a block of values. Integer results which overflow are
+ * recomputed by the per-value implementation of the instruction, which widens them.
+ */
+template <typename Op, typename Scalar>
+void arithmeticBlockImpl(size_t count,
+                         const value::TypeTags* tags,
+                         const value::Value* vals,
+                         value::TypeTags rhsTag,
+                         value::Value rhsVal,
+                         uint8_t* outOwned,
+                         value::TypeTags* outTags,
+                         value::Value* outVals,
+                         Scalar scalar) {
+    auto blockTag = commonBlockTag(count, tags);
+    if (!canUseNumericBlockPath(blockTag, rhsTag)) {
+        for (size_t idx = 0; idx < count; ++idx) {
+            std::tie(outOwned[idx], outTags[idx], outVals[idx]) =
+                scalar(tags[idx], vals[idx], rhsTag, rhsVal);
+        }
+        return;
+    }
+
+    std::fill(outOwned, outOwned + count, false);
+    std::fill(outTags, outTags + count, blockTag);
+    switch (blockTag) {
+        case value::TypeTags::NumberInt32: {
+            auto rhs = numericCast<int32_t>(rhsTag, rhsVal);
+            for (size_t idx = 0; idx < count; ++idx) {
+                int32_t result;
+                if (Op::doOperation(value::bitcastTo<int32_t>(vals[idx]), rhs, result)) {
+                    std::tie(outOwned[idx], outTags[idx], outVals[idx]) =
+                        scalar(tags[idx], vals[idx], rhsTag, rhsVal);
+                } else {
+                    outVals[idx] = value::bitcastFrom<int32_t>(result);
+                }
+            }
+            break;
+        }
+        case value::TypeTags::NumberInt64: {
+            auto rhs = numericCast<int64_t>(rhsTag, rhsVal);
+            for (size_t idx = 0; idx < count; ++idx) {
+                int64_t result;
+                if (Op::doOperation(value::bitcastTo<int64_t>(vals[idx]), rhs, result)) {
+                    std::tie(outOwned[idx], outTags[idx], outVals[idx]) =
+                        scalar(tags[idx], vals[idx], rhsTag, rhsVal);
+                } else {
+                    outVals[idx] = value::bitcastFrom<int64_t>(result);
+                }
+            }
+            break;
+        }
+        case value::TypeTags::NumberDouble: {
+            auto rhs = numericCast<double>(rhsTag, rhsVal);
+            for (size_t idx = 0; idx < count; ++idx) {
+                double result;
+                Op::doOperation(value::bitcastTo<double>(vals[idx]), rhs, result);
+                outVals[idx] = value::bitcastFrom<double>(result);
+            }
+            break;
+        }
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+}  // namespace
+
+void ByteCode::compareBlock(Instruction::Tags op,
+                            size_t count,
+                            const value::TypeTags* tags,
+                            const value::Value* vals,
+                            value::TypeTags rhsTag,
+                            value::Value rhsVal,
+                            value::TypeTags* outTags,
+                            value::Value* outVals) {
+    auto numericCompare = [](auto fn) {
+        return [fn](value::TypeTags lhsTag,
+                    value::Value lhsVal,
+                    value::TypeTags rhsTag,
+                    value::Value rhsVal) {
+            return genericNumericCompare(lhsTag, lhsVal, rhsTag, rhsVal, fn);
+        };
+    };
+    auto compareEq = [this](auto... args) { return genericCompareEq(args...); };
+    auto compareNeq = [this](auto... args) { return genericCompareNeq(args...); };
+    auto compare = [&](auto fn, auto scalar) {
+        compareBlockImpl(count, tags, vals, rhsTag, rhsVal, outTags, outVals, fn, scalar);
+    };
+
+    switch (op) {
+        case Instruction::less:
+            compare(std::less<>{}, numericCompare(std::less<>{}));
+            break;
+        case Instruction::lessEq:
+            compare(std::less_equal<>{}, numericCompare(std::less_equal<>{}));
+            break;
+        case Instruction::greater:
+            compare(std::greater<>{}, numericCompare(std::greater<>{}));
+            break;
+        case Instruction::greaterEq:
+            compare(std::greater_equal<>{}, numericCompare(std::greater_equal<>{}));
+            break;
+        case Instruction::eq:
+            compare(std::equal_to<>{}, compareEq);
+            break;
+        case Instruction::neq:
+            compare(std::not_equal_to<>{}, compareNeq);
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+void ByteCode::arithmeticBlock(Instruction::Tags op,
+                               size_t count,
+                               const value::TypeTags* tags,
+                               const value::Value* vals,
+                               value::TypeTags rhsTag,
+                               value::Value rhsVal,
+                               uint8_t* outOwned,
+                               value::TypeTags* outTags,
+                               value::Value* outVals) {
+    auto compute = [&](auto arithmeticOp, auto scalar) {
+        arithmeticBlockImpl<decltype(arithmeticOp)>(
+            count, tags, vals, rhsTag, rhsVal, outOwned, outTags, outVals, scalar);
+    };
+
+    switch (op) {
+        case Instruction::add:
+            compute(Addition{}, [this](auto... args) { return genericAdd(args...); });
+            break;
+        case Instruction::sub:
+            compute(Subtraction{}, [this](auto... args) { return genericSub(args...); });
+            break;
+        case Instruction::mul:
+            compute(Multiplication{}, [this](auto... args) { return genericMul(args...); });
+            break;
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
 }  // namespace vm
 }  // namespace sbe
 }  // namespace mongo
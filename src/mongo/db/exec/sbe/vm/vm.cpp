@@ -44,6 +44,14 @@
 
 MONGO_FAIL_POINT_DEFINE(failOnPoisonedFieldLookup);
 
+// Threaded code dispatch relies on the "labels as values" extension of GCC, which is supported by
+// clang as well.
+#if defined(__GNUC__)
+#define MONGO_SBE_VM_THREADED_DISPATCH 1
+#else
+#define MONGO_SBE_VM_THREADED_DISPATCH 0
+#endif
+
 namespace mongo {
 namespace sbe {
 namespace vm {
@@ -1346,6 +1354,77 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
     auto pcPointer = code->instrs().data();
     auto pcEnd = pcPointer + code->instrs().size();
 
+#if MONGO_SBE_VM_THREADED_DISPATCH
+    // With threaded code each instruction handler decodes the next instruction and jumps straight
+    // to its handler. Compared to a single switch, this saves a bounds check and a jump per
+    // instruction, and it gives each handler its own indirect branch, which the CPU predicts much
+    // better.
+    static const void* const dispatchTable[] = {
+        &&instruction_pushConstVal,
+        &&instruction_pushAccessVal,
+        &&instruction_pushMoveVal,
+        &&instruction_pushLocalVal,
+        &&instruction_pop,
+        &&instruction_swap,
+        &&instruction_add,
+        &&instruction_sub,
+        &&instruction_mul,
+        &&instruction_div,
+        &&instruction_idiv,
+        &&instruction_mod,
+        &&instruction_negate,
+        &&instruction_numConvert,
+        &&instruction_logicNot,
+        &&instruction_less,
+        &&instruction_lessEq,
+        &&instruction_greater,
+        &&instruction_greaterEq,
+        &&instruction_eq,
+        &&instruction_neq,
+        &&instruction_cmp3w,
+        &&instruction_fillEmpty,
+        &&instruction_getField,
+        &&instruction_getElement,
+        &&instruction_aggSum,
+        &&instruction_aggMin,
+        &&instruction_aggMax,
+        &&instruction_aggFirst,
+        &&instruction_aggLast,
+        &&instruction_exists,
+        &&instruction_isNull,
+        &&instruction_isObject,
+        &&instruction_isArray,
+        &&instruction_isString,
+        &&instruction_isNumber,
+        &&instruction_isBinData,
+        &&instruction_isDate,
+        &&instruction_typeMatch,
+        &&instruction_function,
+        &&instruction_jmp,
+        &&instruction_jmpTrue,
+        &&instruction_jmpNothing,
+        &&instruction_fail,
+    };
+    static_assert(sizeof(dispatchTable) / sizeof(dispatchTable[0]) ==
+                      Instruction::lastInstruction,
+                  "dispatchTable must have a handler for every instruction");
+
+#define SBE_VM_INSTRUCTION(name) instruction_##name:
+#define SBE_VM_NEXT()                                                 \
+    do {                                                              \
+        if (pcPointer == pcEnd) {                                     \
+            goto finished;                                            \
+        }                                                             \
+        auto nextTag = value::readFromMemory<Instruction>(pcPointer).tag; \
+        pcPointer += sizeof(Instruction);                             \
+        goto* dispatchTable[nextTag];                                 \
+    } while (false)
+
+    SBE_VM_NEXT();
+#else
+#define SBE_VM_INSTRUCTION(name) case Instruction::name:
+#define SBE_VM_NEXT() break
+
     for (;;) {
         if (pcPointer == pcEnd) {
             break;
@@ -1353,7 +1432,8 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
             Instruction i = value::readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+#endif
+                SBE_VM_INSTRUCTION(pushConstVal) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = value::readFromMemory<value::Value>(pcPointer);
@@ -1361,27 +1441,27 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::pushAccessVal: {
+                SBE_VM_INSTRUCTION(pushAccessVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::pushMoveVal: {
+                SBE_VM_INSTRUCTION(pushMoveVal) {
                     auto accessor = value::readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::pushLocalVal: {
+                SBE_VM_INSTRUCTION(pushLocalVal) {
                     auto stackOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -1389,9 +1469,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(false, tag, val);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::pop: {
+                SBE_VM_INSTRUCTION(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
@@ -1399,9 +1479,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(tag, val);
                     }
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::swap: {
+                SBE_VM_INSTRUCTION(swap) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(1);
 
@@ -1417,9 +1497,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         invariant(!rhsOwned);
                     }
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::add: {
+                SBE_VM_INSTRUCTION(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1434,9 +1514,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::sub: {
+                SBE_VM_INSTRUCTION(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1451,9 +1531,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::mul: {
+                SBE_VM_INSTRUCTION(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1468,9 +1548,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::div: {
+                SBE_VM_INSTRUCTION(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1485,9 +1565,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::idiv: {
+                SBE_VM_INSTRUCTION(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1502,9 +1582,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::mod: {
+                SBE_VM_INSTRUCTION(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1519,9 +1599,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::negate: {
+                SBE_VM_INSTRUCTION(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] =
@@ -1533,9 +1613,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(resultTag, resultVal);
                     }
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::numConvert: {
+                SBE_VM_INSTRUCTION(numConvert) {
                     auto tag = value::readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -1549,9 +1629,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                         value::releaseValue(lhsTag, lhsVal);
                     }
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::logicNot: {
+                SBE_VM_INSTRUCTION(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericNot(tag, val);
@@ -1561,9 +1641,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::less: {
+                SBE_VM_INSTRUCTION(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1578,9 +1658,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::lessEq: {
+                SBE_VM_INSTRUCTION(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1596,9 +1676,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::greater: {
+                SBE_VM_INSTRUCTION(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1614,9 +1694,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::greaterEq: {
+                SBE_VM_INSTRUCTION(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1632,9 +1712,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::eq: {
+                SBE_VM_INSTRUCTION(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1649,9 +1729,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::neq: {
+                SBE_VM_INSTRUCTION(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1666,9 +1746,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::cmp3w: {
+                SBE_VM_INSTRUCTION(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1683,9 +1763,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::fillEmpty: {
+                SBE_VM_INSTRUCTION(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1701,9 +1781,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::getField: {
+                SBE_VM_INSTRUCTION(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1718,9 +1798,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::getElement: {
+                SBE_VM_INSTRUCTION(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1735,9 +1815,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::aggSum: {
+                SBE_VM_INSTRUCTION(aggSum) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1752,9 +1832,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::aggMin: {
+                SBE_VM_INSTRUCTION(aggMin) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1769,9 +1849,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::aggMax: {
+                SBE_VM_INSTRUCTION(aggMax) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1786,9 +1866,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::aggFirst: {
+                SBE_VM_INSTRUCTION(aggFirst) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1803,9 +1883,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::aggLast: {
+                SBE_VM_INSTRUCTION(aggLast) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -1820,9 +1900,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::exists: {
+                SBE_VM_INSTRUCTION(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false, value::TypeTags::Boolean, tag != value::TypeTags::Nothing);
@@ -1830,9 +1910,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isNull: {
+                SBE_VM_INSTRUCTION(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1842,9 +1922,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isObject: {
+                SBE_VM_INSTRUCTION(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1854,9 +1934,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isArray: {
+                SBE_VM_INSTRUCTION(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1866,9 +1946,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isString: {
+                SBE_VM_INSTRUCTION(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1878,9 +1958,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isNumber: {
+                SBE_VM_INSTRUCTION(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1890,9 +1970,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isBinData: {
+                SBE_VM_INSTRUCTION(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1902,9 +1982,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::isDate: {
+                SBE_VM_INSTRUCTION(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -1914,9 +1994,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::typeMatch: {
+                SBE_VM_INSTRUCTION(typeMatch) {
                     auto typeMask = value::readFromMemory<uint32_t>(pcPointer);
                     pcPointer += sizeof(typeMask);
 
@@ -1930,9 +2010,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::function: {
+                SBE_VM_INSTRUCTION(function) {
                     auto f = value::readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     auto arity = value::readFromMemory<uint8_t>(pcPointer);
@@ -1950,16 +2030,16 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     pushStack(owned, tag, val);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::jmp: {
+                SBE_VM_INSTRUCTION(jmp) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::jmpTrue: {
+                SBE_VM_INSTRUCTION(jmpTrue) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -1973,9 +2053,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::jmpNothing: {
+                SBE_VM_INSTRUCTION(jmpNothing) {
                     auto jumpOffset = value::readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -1983,9 +2063,9 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
+                    SBE_VM_NEXT();
                 }
-                case Instruction::fail: {
+                SBE_VM_INSTRUCTION(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -1998,13 +2078,19 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
 
                     uasserted(code, message);
 
-                    break;
+                    SBE_VM_NEXT();
                 }
+#if MONGO_SBE_VM_THREADED_DISPATCH
+finished:
+#else
                 default:
                     MONGO_UNREACHABLE;
             }
         }
     }
+#endif
+#undef SBE_VM_NEXT
+#undef SBE_VM_INSTRUCTION
     uassert(
         4822801, "The evaluation stack must hold only a single value", _argStackOwned.size() == 1);
 
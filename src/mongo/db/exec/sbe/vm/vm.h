@@ -311,6 +311,38 @@ public:
     std::tuple<uint8_t, value::TypeTags, value::Value> run(const CodeFragment* code);
     bool runPredicate(const CodeFragment* code);
 
+    /**
+     * Block-at-a-time versions of the comparison instructions (less, lessEq, greater, greaterEq,
+     * eq, and neq). Compares each of the 'count' values of the block given by 'tags' and 'vals'
+     * with the scalar right hand side and writes the results into 'outTags' and 'outVals'.
+     *
+     * A block of numbers of a single type is processed by a tight loop which the compiler can
+     * vectorize. Any other block falls back to the per-value implementation of the instruction, so
+     * the results are always the same as when running the instruction once per value.
+     */
+    void compareBlock(Instruction::Tags op,
+                      size_t count,
+                      const value::TypeTags* tags,
+                      const value::Value* vals,
+                      value::TypeTags rhsTag,
+                      value::Value rhsVal,
+                      value::TypeTags* outTags,
+                      value::Value* outVals);
+
+    /**
+     * Block-at-a-time versions of the add, sub, and mul instructions, with the same contract as
+     * compareBlock(). The caller owns the results which have their 'outOwned' flag set.
+     */
+    void arithmeticBlock(Instruction::Tags op,
+                         size_t count,
+                         const value::TypeTags* tags,
+                         const value::Value* vals,
+                         value::TypeTags rhsTag,
+                         value::Value rhsVal,
+                         uint8_t* outOwned,
+                         value::TypeTags* outTags,
+                         value::Value* outVals);
+
 private:
     std::vector<uint8_t> _argStackOwned;
     std::vector<value::TypeTags> _argStackTags;
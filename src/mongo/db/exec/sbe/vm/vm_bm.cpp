@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo::sbe {
+namespace {
+
+/**
+ * Runs a chain of 'state.range(0)' additions of constants, which measures the cost of dispatching
+ * the pushConstVal and add instructions.
+ */
+void BM_AddChain(benchmark::State& state) {
+    vm::CodeFragment code;
+    code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(0));
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+        code.appendAdd();
+    }
+
+    vm::ByteCode interpreter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.run(&code));
+    }
+    state.SetItemsProcessed(state.iterations() * (2 * state.range(0) + 1));
+}
+
+/**
+ * Evaluates the predicate 'slot < 100', the shape of a simple filter over a scanned field.
+ */
+void BM_CompareSlotToConstant(benchmark::State& state) {
+    value::ViewOfValueAccessor accessor;
+    vm::CodeFragment code;
+    code.appendAccessVal(&accessor);
+    code.appendConstVal(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(100));
+    code.appendLess();
+
+    vm::ByteCode interpreter;
+    int64_t i = 0;
+    for (auto _ : state) {
+        accessor.reset(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i++ % 200));
+        benchmark::DoNotOptimize(interpreter.runPredicate(&code));
+    }
+    state.SetItemsProcessed(state.iterations() * 3);
+}
+
+/**
+ * Evaluates the predicate 'getField(slot, "b") > 5' over a small BSON document.
+ */
+void BM_GetFieldCompare(benchmark::State& state) {
+    auto obj = BSON("a" << 1 << "b" << 10 << "c"
+                        << "string");
+    value::ViewOfValueAccessor accessor;
+    accessor.reset(value::TypeTags::bsonObject, value::bitcastFrom<const char*>(obj.objdata()));
+
+    auto [fieldTag, fieldVal] = value::makeNewString("b");
+    value::ValueGuard fieldGuard{fieldTag, fieldVal};
+
+    vm::CodeFragment code;
+    code.appendAccessVal(&accessor);
+    code.appendConstVal(fieldTag, fieldVal);
+    code.appendGetField();
+    code.appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(5));
+    code.appendGreater();
+
+    vm::ByteCode interpreter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(interpreter.runPredicate(&code));
+    }
+    state.SetItemsProcessed(state.iterations() * 5);
+}
+
+BENCHMARK(BM_AddChain)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_CompareSlotToConstant);
+BENCHMARK(BM_GetFieldCompare);
+
+}  // namespace
+}  // namespace mongo::sbe
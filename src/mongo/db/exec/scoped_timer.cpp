@@ -42,4 +42,22 @@ ScopedTimer::~ScopedTimer() {
     *_counter += elapsed;
 }
 
+SampledScopedTimer::SampledScopedTimer(TickSource* ts,
+                                       long long scale,
+                                       long long* microsCounter,
+                                       long long* millisCounter)
+    : _tickSource(ts),
+      _scale(scale),
+      _microsCounter(microsCounter),
+      _millisCounter(millisCounter),
+      _start(ts->getTicks()) {}
+
+SampledScopedTimer::~SampledScopedTimer() {
+    long long elapsed = durationCount<Microseconds>(
+        _tickSource->ticksTo<Microseconds>(_tickSource->getTicks() - _start));
+    const long long millisBefore = *_microsCounter / 1000;
+    *_microsCounter += elapsed * _scale;
+    *_millisCounter += *_microsCounter / 1000 - millisBefore;
+}
+
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #pragma once
 
 
+#include "mongo/util/tick_source.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -59,4 +60,33 @@ private:
     const Date_t _start;
 };
 
+/**
+ * This class measures the time elapsed since its construction with a TickSource, which is precise
+ * enough to time a single call, and adds it multiplied by 'scale' to a counter of microseconds when
+ * it goes out of scope. Timing one in 'scale' calls this way estimates the time spent in all of
+ * them. A counter of milliseconds is kept in step with the counter of microseconds.
+ */
+class SampledScopedTimer {
+    SampledScopedTimer(const SampledScopedTimer&) = delete;
+    SampledScopedTimer& operator=(const SampledScopedTimer&) = delete;
+
+public:
+    SampledScopedTimer(SampledScopedTimer&& other) = default;
+    SampledScopedTimer(TickSource* ts,
+                       long long scale,
+                       long long* microsCounter,
+                       long long* millisCounter);
+
+    ~SampledScopedTimer();
+
+private:
+    TickSource* const _tickSource;
+    const long long _scale;
+    long long* _microsCounter;
+    long long* _millisCounter;
+
+    // Tick at which the timer was constructed.
+    const TickSource::Tick _start;
+};
+
 }  // namespace mongo
@@ -30,10 +30,12 @@
 #pragma once
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
@@ -55,13 +57,17 @@ public:
     class Comparator {
     public:
         Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
+        Comparator(const ValueComparator& keyComparator)
+            : _sortKeyComparator(BSONObj()), _keyComparator(keyComparator) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            return _keyComparator ? _keyComparator->compare(lhs.first, rhs.first)
+                                  : _sortKeyComparator(lhs.first, rhs.first);
         }
 
     private:
         SortKeyComparator _sortKeyComparator;
+        boost::optional<ValueComparator> _keyComparator;
     };
 
     /**
@@ -81,6 +87,23 @@ public:
         _stats.maxMemoryUsageBytes = maxMemoryUsageBytes;
     }
 
+    /**
+     * Sorts the data by keys which are whole values compared by 'keyComparator', rather than by
+     * the sort keys of a sort pattern. This lets a caller sort by a value it returns as is, such as
+     * the result of an expression, when the order of that value under a collation is wanted.
+     */
+    SortExecutor(ValueComparator keyComparator,
+                 uint64_t maxMemoryUsageBytes,
+                 std::string tempDir,
+                 bool allowDiskUse)
+        : SortExecutor(SortPattern(std::vector<SortPattern::SortPatternPart>{}, {}),
+                       0,
+                       maxMemoryUsageBytes,
+                       std::move(tempDir),
+                       allowDiskUse) {
+        _keyComparator = std::move(keyComparator);
+    }
+
     const SortPattern& sortPattern() const {
         return _sortPattern;
     }
@@ -124,7 +147,7 @@ public:
      */
     void add(const Value& sortKey, const T& data) {
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(DocumentSorter::make(makeSortOptions(), makeComparator()));
         }
         _sorter->add(sortKey, data);
 
@@ -137,10 +160,11 @@ public:
     void loadingDone() {
         // This conditional should only pass if no documents were added to the sorter.
         if (!_sorter) {
-            _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
+            _sorter.reset(DocumentSorter::make(makeSortOptions(), makeComparator()));
         }
         _output.reset(_sorter->done());
         _stats.wasDiskUsed = _stats.wasDiskUsed || _sorter->usedDisk();
+        _stats.spills += _sorter->numSpills();
         _sorter.reset();
     }
 
@@ -172,6 +196,10 @@ public:
     }
 
 private:
+    Comparator makeComparator() const {
+        return _keyComparator ? Comparator(*_keyComparator) : Comparator(_sortPattern);
+    }
+
     SortOptions makeSortOptions() const {
         SortOptions opts;
         if (_stats.limit) {
@@ -182,6 +210,7 @@ private:
         if (_diskUseAllowed) {
             opts.extSortAllowed = true;
             opts.tempDir = _tempDir;
+            opts.numSortThreads = static_cast<size_t>(internalQueryMaxBlockingSortThreads.load());
         }
 
         return opts;
@@ -191,6 +220,9 @@ private:
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
+    // Set when the keys are compared as whole values rather than as sort keys of '_sortPattern'.
+    boost::optional<ValueComparator> _keyComparator;
+
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
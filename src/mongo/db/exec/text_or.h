@@ -138,7 +138,7 @@ private:
     /**
      *  Temporary score data filled out by children.
      *  Maps from RecordID -> (aggregate score for doc, wsid).
-     *  Map each buffered record id to this data.
+     *  Map each buffered record id to this data. The member is not fetched until it is returned.
      */
     struct TextRecordData {
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
@@ -154,7 +154,6 @@ private:
 
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
-    WorkingSetID _idRetrying;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 };
 }  // namespace mongo
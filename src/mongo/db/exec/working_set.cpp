@@ -39,7 +39,56 @@ using std::string;
 
 namespace dps = ::mongo::dotted_path_support;
 
-WorkingSet::WorkingSet() : _freeList(INVALID_ID) {}
+namespace {
+
+// The number of WorkingSets whose members each thread keeps for reuse, and the size above which a
+// WorkingSet's members are released instead, so that the pools don't hold on to the memory of
+// large queries.
+constexpr size_t kMaxPooledWorkingSets = 4;
+constexpr size_t kMaxPooledMembers = 256;
+
+}  // namespace
+
+std::vector<WorkingSet::MemberHolders>& WorkingSet::_pooledMembers() {
+    thread_local std::vector<MemberHolders> pool;
+    return pool;
+}
+
+WorkingSet::WorkingSet() : _freeList(INVALID_ID) {
+    auto& pool = _pooledMembers();
+    if (pool.empty()) {
+        return;
+    }
+
+    // The pooled members are all free, and linked in order.
+    _data = std::move(pool.back());
+    pool.pop_back();
+    _freeList = 0;
+}
+
+WorkingSet::~WorkingSet() {
+    auto& pool = _pooledMembers();
+    if (_data.empty() || _data.size() > kMaxPooledMembers || pool.size() >= kMaxPooledWorkingSets) {
+        return;
+    }
+
+    for (WorkingSetID id = 0; id < _data.size(); ++id) {
+        auto& holder = _data[id];
+        if (holder.nextFreeOrSelf == id) {
+            holder.member.clear();
+        }
+
+        // A cleared member keeps the storage of its document only if nothing else refers to it.
+        // Otherwise the document may be shared with a result which outlives the WorkingSet, maybe
+        // on another thread, so drop it.
+        if (!holder.member.doc.value().hasExclusivelyOwnedStorage()) {
+            holder.member.doc = {SnapshotId(), Document()};
+        }
+        holder.member.recordId = RecordId();
+        holder.nextFreeOrSelf = (id + 1 < _data.size()) ? id + 1 : INVALID_ID;
+    }
+    pool.push_back(std::move(_data));
+}
 
 WorkingSetID WorkingSet::allocate() {
     if (_freeList == INVALID_ID) {
@@ -306,9 +306,14 @@ class WorkingSet {
 public:
     static const WorkingSetID INVALID_ID = WorkingSetID(-1);
 
+    /**
+     * Takes the members of a WorkingSet which was destroyed before on this thread, if any, so that
+     * their storage is reused. A destroyed WorkingSet returns its members to a small per-thread
+     * pool, unless it grew too large.
+     */
     WorkingSet();
 
-    ~WorkingSet() = default;
+    ~WorkingSet();
 
     /**
      * Allocate a new query result and return the ID used to get and free it.
@@ -397,6 +402,11 @@ private:
         WorkingSetMember member;
     };
 
+    using MemberHolders = std::vector<MemberHolder>;
+
+    // The pools of the members of destroyed WorkingSets, one per thread.
+    static std::vector<MemberHolders>& _pooledMembers();
+
     // All WorkingSetIDs are indexes into this, except for INVALID_ID.
     // Elements are added to _freeList rather than removed when freed.
     std::vector<MemberHolder> _data;
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/util/unowned_ptr.h"
@@ -36,6 +38,7 @@
 namespace mongo {
 
 class OperationContext;
+struct Record;
 class SeekableRecordCursor;
 
 class WorkingSetCommon {
@@ -54,6 +57,16 @@ public:
                       WorkingSetID id,
                       unowned_ptr<SeekableRecordCursor> cursor,
                       const NamespaceString& ns);
+
+    /**
+     * Like above, but with the 'record' of the member which the caller has already read in the
+     * current snapshot, or boost::none if the record couldn't be found.
+     */
+    static bool fetch(OperationContext* opCtx,
+                      WorkingSet* workingSet,
+                      WorkingSetID id,
+                      boost::optional<Record> record,
+                      const NamespaceString& ns);
 };
 
 }  // namespace mongo
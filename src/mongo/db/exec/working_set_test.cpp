@@ -313,4 +313,32 @@ TEST_F(WorkingSetFixture, WsmCanBeExtractedAndReinserted) {
     ASSERT_FALSE(emplacedWsm->metadata());
 }
 
+TEST(WorkingSetTest, MembersReusedFromDestroyedWorkingSetAreClean) {
+    {
+        WorkingSet ws;
+        auto inUse = ws.allocate();
+        auto freed = ws.allocate();
+        for (auto id : {inUse, freed}) {
+            auto member = ws.get(id);
+            member->recordId = RecordId(42);
+            member->keyData.push_back(
+                IndexKeyDatum(BSON("a" << 1), BSON("" << 1), 0, SnapshotId()));
+            member->doc = {SnapshotId(), Document{BSON("a" << 1)}};
+            member->metadata().setTextScore(1.0);
+            ws.transitionToRecordIdAndObj(id);
+        }
+        ws.free(freed);
+    }
+
+    WorkingSet ws;
+    for (int i = 0; i < 3; ++i) {
+        auto member = ws.get(ws.allocate());
+        ASSERT_EQUALS(WorkingSetMember::INVALID, member->getState());
+        ASSERT_EQUALS(RecordId(), member->recordId);
+        ASSERT_TRUE(member->keyData.empty());
+        ASSERT_TRUE(member->doc.value().empty());
+        ASSERT_FALSE(member->metadata());
+    }
+}
+
 }  // namespace mongo
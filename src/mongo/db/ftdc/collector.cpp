@@ -43,12 +43,14 @@
 
 namespace mongo {
 
-void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collector,
+                                  FTDCCollectorPeriod period) {
     // TODO: ensure the collectors all have unique names.
-    _collectors.emplace_back(std::move(collector));
+    _collectors.push_back({std::move(collector), period, BSONObj(), Date_t()});
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             Milliseconds slowPeriod) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -58,7 +60,7 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     BSONObjBuilder builder;
 
     Date_t start = client->getServiceContext()->getPreciseClockSource()->now();
-    Date_t end;
+    Date_t end = start;
     bool firstLoop = true;
 
     builder.appendDate(kFTDCCollectStartField, start);
@@ -74,11 +76,9 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     invariant(RecoveryUnit::ReadSource::kNoTimestamp ==
               opCtx->recoveryUnit()->getTimestampReadSource());
 
-    for (auto& collector : _collectors) {
-        BSONObjBuilder subObjBuilder(builder.subobjStart(collector->name()));
-
-        // Add a Date_t before and after each BSON is collected so that we can track timing of the
-        // collector.
+    // Add a Date_t before and after each BSON is collected so that we can track timing of the
+    // collector.
+    auto collectOne = [&](FTDCCollectorInterface* collector, BSONObjBuilder& subObjBuilder) {
         Date_t now = start;
 
         if (!firstLoop) {
@@ -93,6 +93,26 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
 
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
+    };
+
+    for (auto& entry : _collectors) {
+        const auto name = entry.collector->name();
+
+        if (entry.period == FTDCCollectorPeriod::kEveryPeriod) {
+            BSONObjBuilder subObjBuilder(builder.subobjStart(name));
+            collectOne(entry.collector.get(), subObjBuilder);
+            continue;
+        }
+
+        // A slow collector's sub-document is built on its own, so that it can be repeated until
+        // the collector is due to run again.
+        if (entry.lastSample.isEmpty() || start - entry.lastCollected >= slowPeriod) {
+            BSONObjBuilder subObjBuilder;
+            collectOne(entry.collector.get(), subObjBuilder);
+            entry.lastSample = subObjBuilder.obj();
+            entry.lastCollected = start;
+        }
+        builder.append(name, entry.lastSample);
     }
 
     builder.appendDate(kFTDCCollectEndField, end);
@@ -34,12 +34,12 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
-class BSONObj;
 class BSONObjBuilder;
-class Date_t;
 class Client;
 class OperationContext;
 
@@ -74,6 +74,22 @@ protected:
     FTDCCollectorInterface() = default;
 };
 
+/**
+ * How often a periodic collector is run.
+ */
+enum class FTDCCollectorPeriod {
+    /**
+     * Run on every period of the controller.
+     */
+    kEveryPeriod,
+
+    /**
+     * Run at most once per slow period, for collectors that are too expensive to run on every
+     * period. See FTDCConfig::slowPeriod.
+     */
+    kSlowPeriod,
+};
+
 /**
  * Manages the set of BSON collectors
  *
@@ -90,7 +106,8 @@ public:
      * Add a metric collector to the collection.
      * Must be called before collect. Cannot be called after collect is called.
      */
-    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+    void add(std::unique_ptr<FTDCCollectorInterface> collector,
+             FTDCCollectorPeriod period = FTDCCollectorPeriod::kEveryPeriod);
 
     /**
      * Collect a sample from all collectors. Called after all adding is complete.
@@ -107,12 +124,25 @@ public:
      *    ...
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
+     *
+     * A kSlowPeriod collector that last ran less than 'slowPeriod' ago is not run again. Its most
+     * recent sub-document is repeated instead, start and end included, so that every sample keeps
+     * the same schema and the repeated values compress to runs of zero deltas.
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(Client* client, Milliseconds slowPeriod = Milliseconds(0));
 
 private:
+    struct CollectorEntry {
+        std::unique_ptr<FTDCCollectorInterface> collector;
+        FTDCCollectorPeriod period;
+
+        // Most recent sub-document of a kSlowPeriod collector, and when it was collected.
+        BSONObj lastSample;
+        Date_t lastCollected;
+    };
+
     // collection of collectors
-    std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
+    std::vector<CollectorEntry> _collectors;
 };
 
 }  // namespace mongo
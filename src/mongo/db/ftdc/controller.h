@@ -75,6 +75,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for data collection by the slow periodic collectors.
+     */
+    void setSlowPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -108,8 +113,12 @@ public:
 
     /**
      * Add a metric collector to collect periodically. i.e., serverStatus
+     *
+     * Collectors that are expensive to run can be registered with kSlowPeriod, so that they only
+     * run once per slow period.
      */
-    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+    void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector,
+                              FTDCCollectorPeriod period = FTDCCollectorPeriod::kEveryPeriod);
 
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
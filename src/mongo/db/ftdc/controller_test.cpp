@@ -283,4 +283,56 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+class FTDCCountingCollector : public FTDCCollectorInterface {
+public:
+    explicit FTDCCountingCollector(std::string name) : _name(std::move(name)) {}
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final {
+        builder.append("count", ++_count);
+    }
+
+    std::string name() const final {
+        return _name;
+    }
+
+    int getCount() const {
+        return _count;
+    }
+
+private:
+    std::string _name;
+    int _count{0};
+};
+
+// Test that slow collectors only run once per slow period, and that their last sample is repeated
+// in between
+TEST_F(FTDCControllerTest, TestSlowPeriodCollector) {
+    FTDCCollectorCollection collectors;
+
+    auto fast = std::make_unique<FTDCCountingCollector>("fast");
+    auto slow = std::make_unique<FTDCCountingCollector>("slow");
+    auto fastPtr = fast.get();
+    auto slowPtr = slow.get();
+
+    collectors.add(std::move(fast));
+    collectors.add(std::move(slow), FTDCCollectorPeriod::kSlowPeriod);
+
+    Client* client = &cc();
+
+    auto first = std::get<0>(collectors.collect(client, Hours(1)));
+    auto second = std::get<0>(collectors.collect(client, Hours(1)));
+
+    ASSERT_EQUALS(fastPtr->getCount(), 2);
+    ASSERT_EQUALS(slowPtr->getCount(), 1);
+    ASSERT_EQUALS(second["fast"].Obj()["count"].numberInt(), 2);
+    ASSERT_BSONOBJ_EQ(first["slow"].Obj(), second["slow"].Obj());
+
+    // With no slow period, the slow collector runs on every collection
+    auto third = std::get<0>(collectors.collect(client, Milliseconds(0)));
+
+    ASSERT_EQUALS(fastPtr->getCount(), 3);
+    ASSERT_EQUALS(slowPtr->getCount(), 2);
+    ASSERT_EQUALS(third["slow"].Obj()["count"].numberInt(), 2);
+}
+
 }  // namespace mongo
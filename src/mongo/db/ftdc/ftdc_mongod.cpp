@@ -54,13 +54,16 @@ void registerMongoDCollectors(FTDCController* controller) {
             BSON("replSetGetStatus" << 1 << "initialSync" << 0)));
 
         // CollectionStats
+        // Storage statistics of the oplog are expensive to gather, so they are only collected once
+        // per slow period.
         controller->addPeriodicCollector(
             std::make_unique<FTDCSimpleInternalCommandCollector>("collStats",
                                                                  "local.oplog.rs.stats",
                                                                  "local",
                                                                  BSON("collStats"
                                                                       << "oplog.rs"
-                                                                      << "waitForLock" << false)));
+                                                                      << "waitForLock" << false)),
+            FTDCCollectorPeriod::kSlowPeriod);
         if (serverGlobalParams.clusterRole != ClusterRole::ShardServer) {
             // GetDefaultRWConcern
             controller->addOnRotateCollector(std::make_unique<FTDCSimpleInternalCommandCollector>(
@@ -77,4 +77,24 @@ void BtreeAccessMethod::doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuild
     _keyGenerator->getKeys(pooledBufferBuilder, obj, skipMultikey, keys, multikeyPaths, id);
 }
 
+void BtreeAccessMethod::doGetKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                          const std::vector<const BSONObj*>& objs,
+                                          const std::vector<RecordId>& ids,
+                                          GetKeysContext context,
+                                          BatchedKeys* batch) const {
+    const auto skipMultikey = context == IndexAccessMethod::GetKeysContext::kValidatingKeys &&
+        !_descriptor->getEntry()->isMultikey();
+    _keyGenerator->getKeysForBatch(pooledBufferBuilder,
+                                   objs,
+                                   ids,
+                                   skipMultikey,
+                                   &batch->keys,
+                                   &batch->keyEnds,
+                                   &batch->multikeyPaths);
+
+    // Btree indexes do not generate multikey metadata keys.
+    batch->multikeyMetadataKeys.clear();
+    batch->multikeyMetadataKeyEnds.assign(objs.size(), 0);
+}
+
 }  // namespace mongo
@@ -56,6 +56,12 @@ private:
                    MultikeyPaths* multikeyPaths,
                    boost::optional<RecordId> id) const final;
 
+    void doGetKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                           const std::vector<const BSONObj*>& objs,
+                           const std::vector<RecordId>& ids,
+                           GetKeysContext context,
+                           BatchedKeys* batch) const final;
+
     // Our keys differ for V0 and V1.
     std::unique_ptr<BtreeKeyGenerator> _keyGenerator;
 };
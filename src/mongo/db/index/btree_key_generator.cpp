@@ -29,9 +29,11 @@
 
 #include "mongo/db/index/btree_key_generator.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <memory>
 
+#include "mongo/bson/bson_field_index.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/field_ref.h"
@@ -68,9 +70,10 @@ BSONElement extractNonArrayElementAtPath(const BSONObj& obj, StringData path) {
 
     auto&& [elt, tail] = [&]() -> std::pair<BSONElement, StringData> {
         if (auto dotOffset = path.find("."); dotOffset != std::string::npos) {
-            return {obj.getField(path.substr(0, dotOffset)), path.substr(dotOffset + 1)};
+            return {BSONFieldIndexScope::getField(obj, path.substr(0, dotOffset)),
+                    path.substr(dotOffset + 1)};
         }
-        return {obj.getField(path), ""_sd};
+        return {BSONFieldIndexScope::getField(obj, path), ""_sd};
     }();
     invariant(elt.type() != BSONType::Array);
 
@@ -121,7 +124,8 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
                                                    const char** field,
                                                    bool* arrayNestedArray) const {
     StringData firstField = str::before(*field, '.');
-    bool haveObjField = !obj.getField(firstField).eoo();
+    BSONElement objField = BSONFieldIndexScope::getField(obj, firstField);
+    bool haveObjField = !objField.eoo();
     BSONElement arrField = positionalInfo.positionallyIndexedElt;
 
     // An index component field name cannot exist in both a document
@@ -148,7 +152,16 @@ BSONElement BtreeKeyGenerator::_extractNextElement(const BSONObj& obj,
 
     *arrayNestedArray = false;
     if (haveObjField) {
-        return dps::extractElementAtPathOrArrayAlongPath(obj, *field);
+        // Continue below the first field found above, as extractElementAtPathOrArrayAlongPath
+        // would after looking it up again.
+        const char* rest = *field + firstField.size();
+        *field = *rest == '.' ? rest + 1 : rest;
+        if (objField.type() == Array || **field == '\0') {
+            return objField;
+        } else if (objField.type() == Object) {
+            return dps::extractElementAtPathOrArrayAlongPath(objField.embeddedObject(), *field);
+        }
+        return BSONElement();
     } else if (positionalInfo.hasPositionallyIndexedElt()) {
         if (arrField.type() == Array) {
             *arrayNestedArray = true;
@@ -208,11 +221,84 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
                                 KeyStringSet* keys,
                                 MultikeyPaths* multikeyPaths,
                                 boost::optional<RecordId> id) const {
+    // Extract the underlying sequence and insert elements unsorted to avoid O(N^2) when
+    // inserting element by element if array
+    auto seq = keys->extract_sequence();
+    std::vector<const char*> fieldNames;
+    std::vector<BSONElement> fixed;
+    _appendKeys(
+        pooledBufferBuilder, obj, skipMultikey, &fieldNames, &fixed, &seq, multikeyPaths, id);
+    // Put the sequence back into the set, it will sort and guarantee uniqueness, this is
+    // O(NlogN)
+    keys->adopt_sequence(std::move(seq));
+
+    if (keys->empty() && !_isSparse) {
+        keys->insert(_nullKeyString);
+    }
+}
+
+void BtreeKeyGenerator::getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                        const std::vector<const BSONObj*>& objs,
+                                        const std::vector<RecordId>& ids,
+                                        bool skipMultikey,
+                                        KeyStringSet::sequence_type* keys,
+                                        std::vector<size_t>* keyEnds,
+                                        std::vector<MultikeyPaths>* multikeyPaths) const {
+    invariant(ids.empty() || ids.size() == objs.size());
+
+    keys->clear();
+    keyEnds->clear();
+    keyEnds->reserve(objs.size());
+    if (multikeyPaths) {
+        multikeyPaths->resize(objs.size());
+    }
+
+    // Scratch space shared by all the documents of the batch, so that the array path does not
+    // copy '_fieldNames' and '_fixed' into fresh vectors for each of them.
+    std::vector<const char*> fieldNames;
+    std::vector<BSONElement> fixed;
+
+    for (size_t i = 0; i < objs.size(); ++i) {
+        MultikeyPaths* docMultikeyPaths = nullptr;
+        if (multikeyPaths) {
+            docMultikeyPaths = &(*multikeyPaths)[i];
+            docMultikeyPaths->clear();
+        }
+
+        const auto docBegin = keys->size();
+        _appendKeys(pooledBufferBuilder,
+                    *objs[i],
+                    skipMultikey,
+                    &fieldNames,
+                    &fixed,
+                    keys,
+                    docMultikeyPaths,
+                    ids.empty() ? boost::none : boost::make_optional(ids[i]));
+
+        if (keys->size() - docBegin > 1) {
+            auto docKeys = keys->begin() + docBegin;
+            std::sort(docKeys, keys->end());
+            keys->erase(std::unique(docKeys, keys->end()), keys->end());
+        } else if (keys->size() == docBegin && !_isSparse) {
+            keys->push_back(_nullKeyString);
+        }
+        keyEnds->push_back(keys->size());
+    }
+}
+
+void BtreeKeyGenerator::_appendKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                    const BSONObj& obj,
+                                    bool skipMultikey,
+                                    std::vector<const char*>* fieldNames,
+                                    std::vector<BSONElement>* fixed,
+                                    KeyStringSet::sequence_type* keys,
+                                    MultikeyPaths* multikeyPaths,
+                                    boost::optional<RecordId> id) const {
     if (_isIdIndex) {
         // we special case for speed
         BSONElement e = obj["_id"];
         if (e.eoo()) {
-            keys->insert(_nullKeyString);
+            keys->push_back(_nullKeyString);
         } else {
             KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
 
@@ -228,7 +314,7 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
                 keyString.appendRecordId(*id);
             }
 
-            keys->insert(keyString.release());
+            keys->push_back(keyString.release());
         }
 
         // The {_id: 1} index can never be multikey because the _id field isn't allowed to be an
@@ -249,35 +335,25 @@ void BtreeKeyGenerator::getKeys(SharedBufferFragmentBuilder& pooledBufferBuilder
             invariant(multikeyPaths->empty());
             multikeyPaths->resize(_fieldNames.size());
         }
-        // Extract the underlying sequence and insert elements unsorted to avoid O(N^2) when
-        // inserting element by element if array
-        auto seq = keys->extract_sequence();
         // '_fieldNames' and '_fixed' are mutated by _getKeysWithArray so pass in copies
-        auto fieldNamesCopy = _fieldNames;
-        auto fixedCopy = _fixed;
-        _getKeysWithArray(&fieldNamesCopy,
-                          &fixedCopy,
+        *fieldNames = _fieldNames;
+        *fixed = _fixed;
+        _getKeysWithArray(fieldNames,
+                          fixed,
                           pooledBufferBuilder,
                           obj,
-                          &seq,
+                          keys,
                           0,
                           _emptyPositionalInfo,
                           multikeyPaths,
                           id);
-        // Put the sequence back into the set, it will sort and guarantee uniqueness, this is
-        // O(NlogN)
-        keys->adopt_sequence(std::move(seq));
-    }
-
-    if (keys->empty() && !_isSparse) {
-        keys->insert(_nullKeyString);
     }
 }
 
 void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              const BSONObj& obj,
                                              boost::optional<RecordId> id,
-                                             KeyStringSet* keys) const {
+                                             KeyStringSet::sequence_type* keys) const {
 
     KeyString::PooledBuilder keyString{pooledBufferBuilder, _keyStringVersion, _ordering};
     size_t numNotFound{0};
@@ -304,7 +380,7 @@ void BtreeKeyGenerator::_getKeysWithoutArray(SharedBufferFragmentBuilder& pooled
     if (id) {
         keyString.appendRecordId(*id);
     }
-    keys->insert(keyString.release());
+    keys->push_back(keyString.release());
 }
 
 void BtreeKeyGenerator::_getKeysWithArray(std::vector<const char*>* fieldNames,
@@ -82,6 +82,24 @@ public:
                  MultikeyPaths* multikeyPaths,
                  boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * Generates the index keys for each of the documents 'objs' as getKeys() would, appending them
+     * to the single sequence 'keys' instead of one set per document. The keys of 'objs[i]' end at
+     * offset 'keyEnds[i]' of 'keys' and start where those of the previous document end; within
+     * that range they are sorted and unique. 'ids' is either empty or holds the RecordId of each
+     * document.
+     *
+     * If the 'multikeyPaths' pointer is non-null, it is resized to hold one entry per document,
+     * filled as getKeys() fills its 'multikeyPaths' argument.
+     */
+    void getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                         const std::vector<const BSONObj*>& objs,
+                         const std::vector<RecordId>& ids,
+                         bool skipMultikey,
+                         KeyStringSet::sequence_type* keys,
+                         std::vector<size_t>* keyEnds,
+                         std::vector<MultikeyPaths>* multikeyPaths) const;
+
 private:
     const KeyString::Version _keyStringVersion;
     const Ordering _ordering;
@@ -145,6 +163,19 @@ private:
         const char* remainingPath;
     };
 
+    /**
+     * Appends the keys of 'obj' to 'keys', unsorted, for getKeys() and getKeysForBatch().
+     * 'fieldNames' and 'fixed' are scratch space for _getKeysWithArray(), overwritten on each call.
+     */
+    void _appendKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                     const BSONObj& obj,
+                     bool skipMultikey,
+                     std::vector<const char*>* fieldNames,
+                     std::vector<BSONElement>* fixed,
+                     KeyStringSet::sequence_type* keys,
+                     MultikeyPaths* multikeyPaths,
+                     boost::optional<RecordId> id) const;
+
     /**
      * This recursive method does the heavy-lifting for getKeys().
      * It will modify 'fieldNames' and 'fixed'.
@@ -166,7 +197,7 @@ private:
     void _getKeysWithoutArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                               const BSONObj& obj,
                               boost::optional<RecordId> id,
-                              KeyStringSet* keys) const;
+                              KeyStringSet::sequence_type* keys) const;
 
     /**
      * A call to _getKeysWithArray() begins by calling this for each field in the key pattern. It
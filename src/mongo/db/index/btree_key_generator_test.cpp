@@ -167,6 +167,45 @@ bool testKeygen(const BSONObj& kp,
             return false;
         }
 
+        //
+        // Check that generating the keys of a batch holding 'obj' twice finds the same keys for
+        // each copy.
+        //
+        KeyStringSet::sequence_type batchKeys;
+        std::vector<size_t> batchKeyEnds;
+        std::vector<MultikeyPaths> batchMultikeyPaths;
+        keyGen->getKeysForBatch(allocator,
+                                {&obj, &obj},
+                                {},
+                                skipMultikey,
+                                &batchKeys,
+                                &batchKeyEnds,
+                                &batchMultikeyPaths);
+        if (batchKeyEnds.size() != 2 || batchMultikeyPaths.size() != 2) {
+            return false;
+        }
+        size_t docBegin = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            KeyStringSet docKeys(boost::container::ordered_unique_range,
+                                 batchKeys.begin() + docBegin,
+                                 batchKeys.begin() + batchKeyEnds[i]);
+            docBegin = batchKeyEnds[i];
+            if (!keysetsEqual(expectedKeys, docKeys)) {
+                LOGV2(5190860,
+                      "Batched key generation mismatch",
+                      "expected"_attr = dumpKeyset(expectedKeys),
+                      "actual"_attr = dumpKeyset(docKeys));
+                return false;
+            }
+            if (expectedMultikeyPaths != batchMultikeyPaths[i]) {
+                LOGV2(5190861,
+                      "Batched multikey paths mismatch",
+                      "expected"_attr = dumpMultikeyPaths(expectedMultikeyPaths),
+                      "actual"_attr = dumpMultikeyPaths(batchMultikeyPaths[i]));
+                return false;
+            }
+        }
+
         return true;
     };
 
@@ -1385,4 +1424,57 @@ TEST(BtreeKeyGeneratorTest, GetCollationAwareKeysFromNestedArray) {
         testKeygen(keyPattern, genKeysFrom, expectedKeys, expectedMultikeyPaths, false, &collator));
 }
 
+TEST(BtreeKeyGeneratorTest, GetKeysForBatchMatchesGetKeys) {
+    std::vector<const char*> fieldNames{"a"};
+    std::vector<BSONElement> fixed{BSONElement()};
+    BtreeKeyGenerator keyGen(fieldNames,
+                             fixed,
+                             true /* isSparse */,
+                             nullptr,
+                             KeyString::Version::kLatestVersion,
+                             Ordering::make(BSONObj()));
+
+    std::vector<BSONObj> docs{fromjson("{a: [3, 1, 2, 1]}"),
+                              fromjson("{b: 1}"),
+                              fromjson("{a: 5}"),
+                              fromjson("{a: [[1, 2], {b: 1}]}")};
+    std::vector<const BSONObj*> docPtrs;
+    std::vector<RecordId> ids;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        docPtrs.push_back(&docs[i]);
+        ids.push_back(RecordId(i + 1));
+    }
+
+    SharedBufferFragmentBuilder allocator(BufBuilder::kDefaultInitSizeBytes);
+    KeyStringSet::sequence_type batchKeys;
+    std::vector<size_t> batchKeyEnds;
+    std::vector<MultikeyPaths> batchMultikeyPaths;
+
+    // Reuse the output containers, as callers generating keys for several batches would.
+    for (int round = 0; round < 2; ++round) {
+        keyGen.getKeysForBatch(
+            allocator, docPtrs, ids, false, &batchKeys, &batchKeyEnds, &batchMultikeyPaths);
+        ASSERT_EQ(batchKeyEnds.size(), docs.size());
+        ASSERT_EQ(batchMultikeyPaths.size(), docs.size());
+
+        size_t docBegin = 0;
+        for (size_t i = 0; i < docs.size(); ++i) {
+            KeyStringSet expectedKeys;
+            MultikeyPaths expectedMultikeyPaths;
+            keyGen.getKeys(
+                allocator, docs[i], false, &expectedKeys, &expectedMultikeyPaths, ids[i]);
+
+            KeyStringSet docKeys(boost::container::ordered_unique_range,
+                                 batchKeys.begin() + docBegin,
+                                 batchKeys.begin() + batchKeyEnds[i]);
+            docBegin = batchKeyEnds[i];
+            ASSERT(keysetsEqual(expectedKeys, docKeys));
+            ASSERT(expectedMultikeyPaths == batchMultikeyPaths[i]);
+        }
+    }
+
+    // The sparse index has no key for the document without 'a'.
+    ASSERT_EQ(batchKeyEnds[0], batchKeyEnds[1]);
+}
+
 }  // namespace
@@ -53,7 +53,9 @@
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/future.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/stacktrace.h"
@@ -84,11 +86,32 @@ bool isMultikeyFromPaths(const MultikeyPaths& multikeyPaths) {
                        [](const MultikeyComponents& components) { return !components.empty(); });
 }
 
-SortOptions makeSortOptions(size_t maxMemoryUsageBytes) {
+SortOptions makeSortOptions(size_t maxMemoryUsageBytes, size_t numSortThreads) {
     return SortOptions()
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
-        .MaxMemoryUsageBytes(maxMemoryUsageBytes);
+        .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        .NumSortThreads(numSortThreads);
+}
+
+/**
+ * Adds the path components in 'multikeyPaths' to those already accumulated in 'into'.
+ */
+void mergeMultikeyPaths(MultikeyPaths* into, const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+
+    if (into->empty()) {
+        *into = multikeyPaths;
+    } else {
+        invariant(into->size() == multikeyPaths.size());
+        for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+            (*into)[i].insert(boost::container::ordered_unique_range_t(),
+                              multikeyPaths[i].begin(),
+                              multikeyPaths[i].end());
+        }
+    }
 }
 
 MultikeyPaths createMultikeyPaths(const std::vector<MultikeyPath>& multikeyPathsVec) {
@@ -471,10 +494,13 @@ Status AbstractIndexAccessMethod::compact(OperationContext* opCtx) {
 
 class AbstractIndexAccessMethod::BulkBuilderImpl : public IndexAccessMethod::BulkBuilder {
 public:
-    BulkBuilderImpl(IndexCatalogEntry* indexCatalogEntry, size_t maxMemoryUsageBytes);
+    BulkBuilderImpl(IndexCatalogEntry* indexCatalogEntry,
+                    size_t maxMemoryUsageBytes,
+                    size_t numSortThreads);
 
     BulkBuilderImpl(IndexCatalogEntry* index,
                     size_t maxMemoryUsageBytes,
+                    size_t numSortThreads,
                     const IndexStateInfo& stateInfo);
 
     Status insert(OperationContext* opCtx,
@@ -482,6 +508,12 @@ public:
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status insertBatch(OperationContext* opCtx,
+                       const std::vector<std::pair<BSONObj, RecordId>>& docs,
+                       const InsertDeleteOptions& options,
+                       ThreadPoolInterface* executor,
+                       size_t numThreads) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -501,8 +533,18 @@ public:
 private:
     void _insertMultikeyMetadataKeysIntoSorter();
 
+    /**
+     * Records a document whose key generation error was suppressed as "skipped" so the index
+     * builder can retry at a point when data is consistent.
+     */
+    void _recordSuppressedKeyGenerationError(OperationContext* opCtx,
+                                             const Status& status,
+                                             const BSONObj& obj,
+                                             const RecordId& loc);
+
     Sorter* _makeSorter(
         size_t maxMemoryUsageBytes,
+        size_t numSortThreads,
         boost::optional<StringData> fileName = boost::none,
         const boost::optional<std::vector<SorterRange>>& ranges = boost::none) const;
 
@@ -526,21 +568,29 @@ private:
 };
 
 std::unique_ptr<IndexAccessMethod::BulkBuilder> AbstractIndexAccessMethod::initiateBulk(
-    size_t maxMemoryUsageBytes, const boost::optional<IndexStateInfo>& stateInfo) {
-    return stateInfo
-        ? std::make_unique<BulkBuilderImpl>(_indexCatalogEntry, maxMemoryUsageBytes, *stateInfo)
-        : std::make_unique<BulkBuilderImpl>(_indexCatalogEntry, maxMemoryUsageBytes);
+    size_t maxMemoryUsageBytes,
+    size_t numSortThreads,
+    const boost::optional<IndexStateInfo>& stateInfo) {
+    return stateInfo ? std::make_unique<BulkBuilderImpl>(
+                           _indexCatalogEntry, maxMemoryUsageBytes, numSortThreads, *stateInfo)
+                     : std::make_unique<BulkBuilderImpl>(
+                           _indexCatalogEntry, maxMemoryUsageBytes, numSortThreads);
 }
 
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* index,
-                                                            size_t maxMemoryUsageBytes)
-    : _indexCatalogEntry(index), _sorter(_makeSorter(maxMemoryUsageBytes)) {}
+                                                            size_t maxMemoryUsageBytes,
+                                                            size_t numSortThreads)
+    : _indexCatalogEntry(index), _sorter(_makeSorter(maxMemoryUsageBytes, numSortThreads)) {}
 
 AbstractIndexAccessMethod::BulkBuilderImpl::BulkBuilderImpl(IndexCatalogEntry* index,
                                                             size_t maxMemoryUsageBytes,
+                                                            size_t numSortThreads,
                                                             const IndexStateInfo& stateInfo)
     : _indexCatalogEntry(index),
-      _sorter(_makeSorter(maxMemoryUsageBytes, stateInfo.getFileName(), stateInfo.getRanges())),
+      _sorter(_makeSorter(maxMemoryUsageBytes,
+                          numSortThreads,
+                          stateInfo.getFileName(),
+                          stateInfo.getRanges())),
       _keysInserted(stateInfo.getNumKeys().value_or(0)),
       _isMultiKey(stateInfo.getIsMultikey()),
       _indexMultikeyPaths(createMultikeyPaths(stateInfo.getMultikeyPaths())) {}
@@ -565,36 +615,13 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
             multikeyPaths.get(),
             loc,
             [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                }
+                _recordSuppressedKeyGenerationError(opCtx, status, obj, loc);
             });
     } catch (...) {
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
-                _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
-            }
-        }
-    }
+    mergeMultikeyPaths(&_indexMultikeyPaths, *multikeyPaths);
 
     for (const auto& keyString : *keys) {
         _sorter->add(keyString, mongo::NullValue());
@@ -608,6 +635,132 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insertBatch(
+    OperationContext* opCtx,
+    const std::vector<std::pair<BSONObj, RecordId>>& docs,
+    const InsertDeleteOptions& options,
+    ThreadPoolInterface* executor,
+    size_t numThreads) {
+    // The key generation state of one piece of the batch. Each piece is only touched by the
+    // thread generating its keys until all of the pieces are done.
+    struct Piece {
+        std::vector<KeyString::Value> keys;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+        bool isMultikey = false;
+        std::vector<std::tuple<Status, BSONObj, RecordId>> suppressedErrors;
+    };
+
+    const size_t numPieces = std::max(size_t(1), std::min(numThreads, docs.size()));
+    std::vector<Piece> pieces(numPieces);
+    auto accessMethod = _indexCatalogEntry->accessMethod();
+
+    auto generateKeys = [&](size_t pieceIdx) {
+        auto& piece = pieces[pieceIdx];
+        SharedBufferFragmentBuilder pooledBufferBuilder(
+            gOperationMemoryPoolBlockInitialSizeKB.loadRelaxed() * static_cast<size_t>(1024),
+            SharedBufferFragmentBuilder::DoubleGrowStrategy(
+                gOperationMemoryPoolBlockMaxSizeKB.loadRelaxed() * static_cast<size_t>(1024)));
+        KeyStringSet keys;
+        MultikeyPaths multikeyPaths;
+
+        const size_t end = docs.size() * (pieceIdx + 1) / numPieces;
+        for (size_t i = docs.size() * pieceIdx / numPieces; i < end; ++i) {
+            const auto& [obj, loc] = docs[i];
+            keys.clear();
+            multikeyPaths.clear();
+            accessMethod->getKeys(
+                pooledBufferBuilder,
+                obj,
+                options.getKeysMode,
+                GetKeysContext::kAddingKeys,
+                &keys,
+                &piece.multikeyMetadataKeys,
+                &multikeyPaths,
+                loc,
+                [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+                    piece.suppressedErrors.emplace_back(std::move(status), obj, loc);
+                });
+
+            mergeMultikeyPaths(&piece.multikeyPaths, multikeyPaths);
+            piece.isMultikey = piece.isMultikey ||
+                accessMethod->shouldMarkIndexAsMultikey(
+                    keys.size(), piece.multikeyMetadataKeys, multikeyPaths);
+            piece.keys.insert(piece.keys.end(), keys.begin(), keys.end());
+        }
+    };
+
+    std::vector<Future<void>> scheduled;
+    scheduled.reserve(numPieces - 1);
+    for (size_t pieceIdx = 1; pieceIdx < numPieces; ++pieceIdx) {
+        auto pf = makePromiseFuture<void>();
+        executor->schedule(
+            [&generateKeys, pieceIdx, promise = std::move(pf.promise)](Status status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(std::move(status));
+                    return;
+                }
+                promise.setWith([&] { generateKeys(pieceIdx); });
+            });
+        scheduled.push_back(std::move(pf.future));
+    }
+
+    // The scheduled pieces reference the batch and 'pieces', so all of them must have finished
+    // before returning, even if generating the keys of another piece failed.
+    Status status = Status::OK();
+    try {
+        generateKeys(0);
+    } catch (...) {
+        status = exceptionToStatus();
+    }
+    for (auto& future : scheduled) {
+        auto pieceStatus = future.getNoThrow();
+        if (status.isOK()) {
+            status = std::move(pieceStatus);
+        }
+    }
+    if (!status.isOK()) {
+        return status;
+    }
+
+    try {
+        for (auto& piece : pieces) {
+            for (const auto& [suppressedStatus, obj, loc] : piece.suppressedErrors) {
+                _recordSuppressedKeyGenerationError(opCtx, suppressedStatus, obj, loc);
+            }
+
+            mergeMultikeyPaths(&_indexMultikeyPaths, piece.multikeyPaths);
+            _multikeyMetadataKeys.insert(piece.multikeyMetadataKeys.begin(),
+                                         piece.multikeyMetadataKeys.end());
+            _isMultiKey = _isMultiKey || piece.isMultikey;
+
+            for (const auto& keyString : piece.keys) {
+                _sorter->add(keyString, mongo::NullValue());
+                ++_keysInserted;
+            }
+        }
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    return Status::OK();
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_recordSuppressedKeyGenerationError(
+    OperationContext* opCtx, const Status& status, const BSONObj& obj, const RecordId& loc) {
+    auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+    if (interceptor && interceptor->getSkippedRecordTracker()) {
+        LOGV2_DEBUG(20684,
+                    1,
+                    "Recording suppressed key generation error to retry later: "
+                    "{error} on {loc}: {obj}",
+                    "error"_attr = status,
+                    "loc"_attr = loc,
+                    "obj"_attr = redact(obj));
+        interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+    }
+}
+
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
     return _indexMultikeyPaths;
 }
@@ -657,16 +810,18 @@ AbstractIndexAccessMethod::BulkBuilderImpl::_makeSorterSettings() const {
 AbstractIndexAccessMethod::BulkBuilderImpl::Sorter*
 AbstractIndexAccessMethod::BulkBuilderImpl::_makeSorter(
     size_t maxMemoryUsageBytes,
+    size_t numSortThreads,
     boost::optional<StringData> fileName,
     const boost::optional<std::vector<SorterRange>>& ranges) const {
-    return fileName ? Sorter::makeFromExistingRanges(fileName->toString(),
-                                                     *ranges,
-                                                     makeSortOptions(maxMemoryUsageBytes),
-                                                     BtreeExternalSortComparison(),
-                                                     _makeSorterSettings())
-                    : Sorter::make(makeSortOptions(maxMemoryUsageBytes),
-                                   BtreeExternalSortComparison(),
-                                   _makeSorterSettings());
+    return fileName
+        ? Sorter::makeFromExistingRanges(fileName->toString(),
+                                         *ranges,
+                                         makeSortOptions(maxMemoryUsageBytes, numSortThreads),
+                                         BtreeExternalSortComparison(),
+                                         _makeSorterSettings())
+        : Sorter::make(makeSortOptions(maxMemoryUsageBytes, numSortThreads),
+                       BtreeExternalSortComparison(),
+                       _makeSorterSettings());
 }
 
 Status AbstractIndexAccessMethod::commitBulk(OperationContext* opCtx,
@@ -828,6 +983,94 @@ void AbstractIndexAccessMethod::getKeys(SharedBufferFragmentBuilder& pooledBuffe
     }
 }
 
+namespace {
+
+void appendToBatch(const KeyStringSet& keys,
+                   KeyStringSet::sequence_type* batchKeys,
+                   std::vector<size_t>* batchKeyEnds) {
+    batchKeys->insert(batchKeys->end(), keys.begin(), keys.end());
+    batchKeyEnds->push_back(batchKeys->size());
+}
+
+void clearBatch(size_t numDocs, IndexAccessMethod::BatchedKeys* batch) {
+    batch->keys.clear();
+    batch->keyEnds.clear();
+    batch->multikeyMetadataKeys.clear();
+    batch->multikeyMetadataKeyEnds.clear();
+    batch->multikeyPaths.resize(numDocs);
+    for (auto& multikeyPaths : batch->multikeyPaths) {
+        multikeyPaths.clear();
+    }
+}
+
+}  // namespace
+
+void AbstractIndexAccessMethod::getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                                const std::vector<const BSONObj*>& objs,
+                                                const std::vector<RecordId>& ids,
+                                                GetKeysMode mode,
+                                                GetKeysContext context,
+                                                BatchedKeys* batch,
+                                                OnSuppressedErrorFn onSuppressedError) const {
+    invariant(objs.size() == ids.size());
+
+    clearBatch(objs.size(), batch);
+    try {
+        doGetKeysForBatch(pooledBufferBuilder, objs, ids, context, batch);
+        return;
+    } catch (const AssertionException& ex) {
+        if (mode == GetKeysMode::kEnforceConstraints || ex.isA<ErrorCategory::Interruption>() ||
+            ex.isA<ErrorCategory::ShutdownError>()) {
+            throw;
+        }
+    }
+
+    // Some document of the batch failed to generate keys, and errors may be suppressed. Start
+    // over one document at a time so that getKeys() handles the failure of each one.
+    clearBatch(objs.size(), batch);
+    KeyStringSet keys;
+    KeyStringSet multikeyMetadataKeys;
+    for (size_t i = 0; i < objs.size(); ++i) {
+        keys.clear();
+        multikeyMetadataKeys.clear();
+        getKeys(pooledBufferBuilder,
+                *objs[i],
+                mode,
+                context,
+                &keys,
+                &multikeyMetadataKeys,
+                &batch->multikeyPaths[i],
+                ids[i],
+                onSuppressedError);
+        appendToBatch(keys, &batch->keys, &batch->keyEnds);
+        appendToBatch(
+            multikeyMetadataKeys, &batch->multikeyMetadataKeys, &batch->multikeyMetadataKeyEnds);
+    }
+}
+
+void AbstractIndexAccessMethod::doGetKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                                  const std::vector<const BSONObj*>& objs,
+                                                  const std::vector<RecordId>& ids,
+                                                  GetKeysContext context,
+                                                  BatchedKeys* batch) const {
+    KeyStringSet keys;
+    KeyStringSet multikeyMetadataKeys;
+    for (size_t i = 0; i < objs.size(); ++i) {
+        keys.clear();
+        multikeyMetadataKeys.clear();
+        doGetKeys(pooledBufferBuilder,
+                  *objs[i],
+                  context,
+                  &keys,
+                  &multikeyMetadataKeys,
+                  &batch->multikeyPaths[i],
+                  ids[i]);
+        appendToBatch(keys, &batch->keys, &batch->keyEnds);
+        appendToBatch(
+            multikeyMetadataKeys, &batch->multikeyMetadataKeys, &batch->multikeyMetadataKeyEnds);
+    }
+}
+
 bool AbstractIndexAccessMethod::shouldMarkIndexAsMultikey(
     size_t numberOfKeys,
     const KeyStringSet& multikeyMetadataKeys,
@@ -42,6 +42,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/sorter/sorter.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/util/concurrency/thread_pool_interface.h"
 
 namespace mongo {
 
@@ -237,6 +238,18 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * Inserts a batch of documents as-if by calling insert() on each of them, but splits the
+         * key generation across up to 'numThreads' pieces of the batch. The calling thread handles
+         * the first piece and the others are scheduled on 'executor'. The generated keys are
+         * added to the underlying Sorter on the calling thread.
+         */
+        virtual Status insertBatch(OperationContext* opCtx,
+                                   const std::vector<std::pair<BSONObj, RecordId>>& docs,
+                                   const InsertDeleteOptions& options,
+                                   ThreadPoolInterface* executor,
+                                   size_t numThreads) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -274,11 +287,14 @@ public:
      *
      * maxMemoryUsageBytes: amount of memory consumed before the external sorter starts spilling to
      *                      disk
+     * numSortThreads: number of threads the sorter may use to sort each batch of keys in memory
      * stateInfo: the information to use to resume the index build, or boost::none if starting a
      * new index build.
      */
     virtual std::unique_ptr<BulkBuilder> initiateBulk(
-        size_t maxMemoryUsageBytes, const boost::optional<IndexStateInfo>& stateInfo) = 0;
+        size_t maxMemoryUsageBytes,
+        size_t numSortThreads,
+        const boost::optional<IndexStateInfo>& stateInfo) = 0;
 
     /**
      * Call this when you are ready to finish your bulk work.
@@ -351,6 +367,34 @@ public:
 
     static OnSuppressedErrorFn kNoopOnSuppressedErrorFn;
 
+    /**
+     * Keys generated for a batch of documents by getKeysForBatch(). The keys of the i-th document
+     * of the batch are the range of 'keys' ending at offset 'keyEnds[i]' and starting where those
+     * of the previous document end, sorted and unique; its multikey metadata keys are likewise
+     * delimited by 'multikeyMetadataKeyEnds'. Keeping one instance around across calls reuses the
+     * memory of its containers.
+     */
+    struct BatchedKeys {
+        KeyStringSet::sequence_type keys;
+        std::vector<size_t> keyEnds;
+        KeyStringSet::sequence_type multikeyMetadataKeys;
+        std::vector<size_t> multikeyMetadataKeyEnds;
+        std::vector<MultikeyPaths> multikeyPaths;
+    };
+
+    /**
+     * Generates the keys of each of the documents 'objs', whose RecordIds are 'ids', into 'batch'.
+     * The result is the same as calling getKeys() for each document in turn, but the keys of all
+     * documents share one sequence, and index types which support it generate them in one pass.
+     */
+    virtual void getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                 const std::vector<const BSONObj*>& objs,
+                                 const std::vector<RecordId>& ids,
+                                 GetKeysMode mode,
+                                 GetKeysContext context,
+                                 BatchedKeys* batch,
+                                 OnSuppressedErrorFn onSuppressedError) const = 0;
+
     /**
      * Given the set of keys, multikeyMetadataKeys and multikeyPaths generated by a particular
      * document, return 'true' if the index should be marked as multikey and 'false' otherwise.
@@ -530,7 +574,9 @@ public:
                             MultikeyPaths paths) final;
 
     std::unique_ptr<BulkBuilder> initiateBulk(
-        size_t maxMemoryUsageBytes, const boost::optional<IndexStateInfo>& stateInfo) final;
+        size_t maxMemoryUsageBytes,
+        size_t numSortThreads,
+        const boost::optional<IndexStateInfo>& stateInfo) final;
 
     Status commitBulk(OperationContext* opCtx,
                       BulkBuilder* bulk,
@@ -548,6 +594,14 @@ public:
                  boost::optional<RecordId> id,
                  OnSuppressedErrorFn onSuppressedError) const final;
 
+    void getKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                         const std::vector<const BSONObj*>& objs,
+                         const std::vector<RecordId>& ids,
+                         GetKeysMode mode,
+                         GetKeysContext context,
+                         BatchedKeys* batch,
+                         OnSuppressedErrorFn onSuppressedError) const final;
+
     bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
                                    const KeyStringSet& multikeyMetadataKeys,
                                    const MultikeyPaths& multikeyPaths) const override;
@@ -579,6 +633,17 @@ protected:
                            MultikeyPaths* multikeyPaths,
                            boost::optional<RecordId> id) const = 0;
 
+    /**
+     * Fills 'batch' with the keys of each of 'objs' as doGetKeys() would. The default
+     * implementation calls doGetKeys() for each document; index types whose key generator can do
+     * better for a batch override it.
+     */
+    virtual void doGetKeysForBatch(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                   const std::vector<const BSONObj*>& objs,
+                                   const std::vector<RecordId>& ids,
+                                   GetKeysContext context,
+                                   BatchedKeys* batch) const;
+
     IndexCatalogEntry* const _indexCatalogEntry;  // owned by IndexCatalog
     const IndexDescriptor* const _descriptor;
 
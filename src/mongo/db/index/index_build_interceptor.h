@@ -158,6 +158,14 @@ public:
      */
     bool areAllWritesApplied(OperationContext* opCtx) const;
 
+    /**
+     * Returns the number of writes recorded in the side writes table which have not been applied
+     * yet, including those which are not visible yet.
+     */
+    int64_t getNumPendingWrites() const {
+        return _sideWritesCounter->load() - _numApplied;
+    }
+
     /**
      * When an index builder wants to commit, use this to retrieve any recorded multikey paths
      * that were tracked during the build.
@@ -165,6 +165,95 @@ void BM_KeyGenArrayOfArray(benchmark::State& state, int32_t elements) {
     }
 }
 
+constexpr int kNumIndexes = 10;
+
+// Documents with one field per index, as inserted by an insertMany into a collection with
+// kNumIndexes single-field indexes.
+std::vector<BSONObj> makeBatch(size_t numDocs) {
+    std::mt19937 gen(numGen());
+    std::vector<BSONObj> docs;
+    for (size_t i = 0; i < numDocs; ++i) {
+        BSONObjBuilder builder;
+        for (int j = 0; j < kNumIndexes; ++j) {
+            builder.append("f" + std::to_string(j), static_cast<int32_t>(gen()));
+        }
+        docs.push_back(builder.obj());
+    }
+    return docs;
+}
+
+std::vector<std::string> makeIndexFieldNames() {
+    std::vector<std::string> fieldNames;
+    for (int j = 0; j < kNumIndexes; ++j) {
+        fieldNames.push_back("f" + std::to_string(j));
+    }
+    return fieldNames;
+}
+
+std::vector<std::unique_ptr<BtreeKeyGenerator>> makeGenerators(
+    const std::vector<std::string>& fieldNames) {
+    std::vector<std::unique_ptr<BtreeKeyGenerator>> generators;
+    for (const auto& fieldName : fieldNames) {
+        generators.push_back(
+            std::make_unique<BtreeKeyGenerator>(std::vector<const char*>{fieldName.c_str()},
+                                                std::vector<BSONElement>{BSONElement{}},
+                                                false,
+                                                nullptr,
+                                                KeyString::Version::kLatestVersion,
+                                                makeOrdering(fieldName.c_str())));
+    }
+    return generators;
+}
+
+void BM_KeyGenBatchOneByOne(benchmark::State& state, size_t numDocs) {
+    auto docs = makeBatch(numDocs);
+    auto fieldNames = makeIndexFieldNames();
+    auto generators = makeGenerators(fieldNames);
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+
+    for (auto _ : state) {
+        for (const auto& generator : generators) {
+            for (size_t i = 0; i < docs.size(); ++i) {
+                KeyStringSet keys;
+                MultikeyPaths multikeyPaths;
+                generator->getKeys(allocator, docs[i], false, &keys, &multikeyPaths, RecordId(i));
+                benchmark::DoNotOptimize(keys);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs * kNumIndexes);
+}
+
+void BM_KeyGenBatch(benchmark::State& state, size_t numDocs) {
+    auto docs = makeBatch(numDocs);
+    auto fieldNames = makeIndexFieldNames();
+    auto generators = makeGenerators(fieldNames);
+
+    std::vector<const BSONObj*> docPtrs;
+    std::vector<RecordId> ids;
+    for (size_t i = 0; i < docs.size(); ++i) {
+        docPtrs.push_back(&docs[i]);
+        ids.push_back(RecordId(i));
+    }
+
+    SharedBufferFragmentBuilder allocator(kMemBlockSize,
+                                          SharedBufferFragmentBuilder::ConstantGrowStrategy());
+    KeyStringSet::sequence_type keys;
+    std::vector<size_t> keyEnds;
+    std::vector<MultikeyPaths> multikeyPaths;
+
+    for (auto _ : state) {
+        for (const auto& generator : generators) {
+            generator->getKeysForBatch(
+                allocator, docPtrs, ids, false, &keys, &keyEnds, &multikeyPaths);
+            benchmark::DoNotOptimize(keys);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs * kNumIndexes);
+}
+
 BENCHMARK_CAPTURE(BM_KeyGenBasic, Generic, false);
 BENCHMARK_CAPTURE(BM_KeyGenBasic, SkipMultikey, true);
 
@@ -180,5 +269,10 @@ BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 10x10, 10);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 100x100, 100);
 BENCHMARK_CAPTURE(BM_KeyGenArrayOfArray, 1Kx1K, 1000);
 
+BENCHMARK_CAPTURE(BM_KeyGenBatchOneByOne, 100, 100);
+BENCHMARK_CAPTURE(BM_KeyGenBatchOneByOne, 1K, 1000);
+BENCHMARK_CAPTURE(BM_KeyGenBatch, 100, 100);
+BENCHMARK_CAPTURE(BM_KeyGenBatch, 1K, 1000);
+
 }  // namespace
 }  // namespace mongo
@@ -47,18 +47,29 @@ static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 // If the enclosing object is an array, then the current element's fieldname is the array index, so
 // we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
 // element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
+void pushPathComponent(BSONElement elem,
+                       bool enclosingObjIsArray,
+                       WildcardKeyGenerator::TraversalPath* pathPrefix) {
     if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
+        if (pathPrefix->numParts++ > 0) {
+            pathPrefix->dotted.push_back('.');
+        }
+        pathPrefix->dotted.append(elem.fieldName(), elem.fieldNameSize() - 1);
     }
 }
 
 // If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
+// Verify that this is the case and then pop it off the path.
+void popPathComponent(BSONElement elem,
+                      bool enclosingObjIsArray,
+                      WildcardKeyGenerator::TraversalPath* pathToElem) {
     if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
+        const auto fieldName = elem.fieldNameStringData();
+        invariant(pathToElem->numParts > 0 && StringData(pathToElem->dotted).endsWith(fieldName));
+        pathToElem->dotted.resize(pathToElem->dotted.size() - fieldName.size());
+        if (--pathToElem->numParts > 0) {
+            pathToElem->dotted.pop_back();
+        }
     }
 }
 }  // namespace
@@ -102,6 +113,9 @@ WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
                                            KeyString::Version keyStringVersion,
                                            Ordering ordering)
     : _proj(createProjectionExecutor(keyPattern, pathProjection)),
+      _excludesOnlyId(pathProjection.isEmpty() &&
+                      keyPattern.firstElement().fieldNameStringData().find(kSubtreeSuffix) ==
+                          std::string::npos),
       _collator(collator),
       _keyPattern(keyPattern),
       _keyStringVersion(keyStringVersion),
@@ -112,14 +126,16 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
+    TraversalPath rootPath;
     auto keysSequence = keys->extract_sequence();
     // multikeyPaths is allowed to be nullptr
     KeyStringSet::sequence_type multikeyPathsSequence;
     if (multikeyPaths)
         multikeyPathsSequence = multikeyPaths->extract_sequence();
     _traverseWildcard(pooledBufferBuilder,
-                      _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
+                      _excludesOnlyId
+                          ? inputDoc
+                          : _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
                       false,
                       &rootPath,
                       &keysSequence,
@@ -133,7 +149,7 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
 void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             TraversalPath* path,
                                              KeyStringSet::sequence_type* keys,
                                              KeyStringSet::sequence_type* multikeyPaths,
                                              boost::optional<RecordId> id) const {
@@ -142,20 +158,26 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
 
+        // The default projection excludes the top-level _id field, which has its own index.
+        if (_excludesOnlyId && path->numParts == 0 && !objIsArray &&
+            elem.fieldNameStringData() == "_id"_sd)
+            continue;
+
         // Append the element's fieldname to the path, if the enclosing object is not an array.
         pushPathComponent(elem, objIsArray, path);
 
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(pooledBufferBuilder, elem, *path, objIsArray, keys, id))
+                if (_addKeyForNestedArray(
+                        pooledBufferBuilder, elem, path->dotted, objIsArray, keys, id))
                     break;
 
                 // Add an entry for the multi-key path, and then fall through to BSONType::Object.
-                _addMultiKey(pooledBufferBuilder, *path, multikeyPaths);
+                _addMultiKey(pooledBufferBuilder, path->dotted, multikeyPaths);
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(pooledBufferBuilder, elem, *path, keys, id))
+                if (_addKeyForEmptyLeaf(pooledBufferBuilder, elem, path->dotted, keys, id))
                     break;
 
                 _traverseWildcard(pooledBufferBuilder,
@@ -168,7 +190,7 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
                 break;
 
             default:
-                _addKey(pooledBufferBuilder, elem, *path, keys, id);
+                _addKey(pooledBufferBuilder, elem, path->dotted, keys, id);
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
@@ -178,7 +200,7 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
 
 bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                  BSONElement elem,
-                                                 const FieldRef& fullPath,
+                                                 StringData fullPath,
                                                  bool enclosingObjIsArray,
                                                  KeyStringSet::sequence_type* keys,
                                                  boost::optional<RecordId> id) const {
@@ -192,7 +214,7 @@ bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& po
 
 bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                                BSONElement elem,
-                                               const FieldRef& fullPath,
+                                               StringData fullPath,
                                                KeyStringSet::sequence_type* keys,
                                                boost::optional<RecordId> id) const {
     invariant(elem.isABSONObj());
@@ -211,12 +233,12 @@ bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pool
 
 void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                    BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet::sequence_type* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -234,13 +256,13 @@ void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuil
 }
 
 void WildcardKeyGenerator::_addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                        const FieldRef& fullPath,
+                                        StringData fullPath,
                                         KeyStringSet::sequence_type* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::PooledBuilder keyString(
             pooledBufferBuilder,
             _keyStringVersion,
@@ -29,8 +29,9 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/db/exec/wildcard_projection.h"
-#include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
@@ -80,40 +81,55 @@ public:
                       KeyStringSet* multikeyPaths,
                       boost::optional<RecordId> id = boost::none) const;
 
+    /**
+     * The dotted path of the element being traversed. It is maintained incrementally as the
+     * traversal descends and returns, so that the path string is not rebuilt for every key.
+     */
+    struct TraversalPath {
+        std::string dotted;
+        size_t numParts = 0;
+    };
+
 private:
     // Traverses every path of the post-projection document, adding keys to the set as it goes.
     void _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                            BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           TraversalPath* path,
                            KeyStringSet::sequence_type* keys,
                            KeyStringSet::sequence_type* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                      const FieldRef& fullPath,
+                      StringData fullPath,
                       KeyStringSet::sequence_type* multikeyPaths) const;
     void _addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                  BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet::sequence_type* keys,
                  boost::optional<RecordId> id) const;
 
     // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
     bool _addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                BSONElement elem,
-                               const FieldRef& fullPath,
+                               StringData fullPath,
                                bool enclosingObjIsArray,
                                KeyStringSet::sequence_type* keys,
                                boost::optional<RecordId> id) const;
     bool _addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
                              BSONElement elem,
-                             const FieldRef& fullPath,
+                             StringData fullPath,
                              KeyStringSet::sequence_type* keys,
                              boost::optional<RecordId> id) const;
 
     WildcardProjection _proj;
+
+    // True if the index uses the default projection, which only excludes the top-level _id field.
+    // The projection is then applied during the traversal instead of materializing a projected
+    // copy of every document.
+    const bool _excludesOnlyId;
+
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
     const KeyString::Version _keyStringVersion;
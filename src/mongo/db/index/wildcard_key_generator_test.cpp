@@ -204,6 +204,30 @@ TEST_F(WildcardKeyGeneratorFullDocumentTest, ExtractMultikeyPath) {
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST_F(WildcardKeyGeneratorFullDocumentTest, ExtractKeysWithEmptyFieldNamesAndNestedIds) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                {},
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+    auto inputDoc = fromjson("{_id: 0, '': {'': 1, a: {_id: 2}}, b: [{'': 3}]}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': '.', '': 1}"),
+                                    fromjson("{'': '.a._id', '': 2}"),
+                                    fromjson("{'': 'b.', '': 3}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'b'}")},
+                   RecordId{RecordId::ReservedId::kWildcardMultikeyMetadataId});
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
 TEST_F(WildcardKeyGeneratorFullDocumentTest, ExtractMultikeyPathAndDedupKeys) {
     WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
                                 {},
@@ -39,6 +39,7 @@
 #include "mongo/db/catalog/index_build_entry_gen.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/concurrency/replication_state_transition_lock_guard.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -64,7 +65,9 @@
 #include "mongo/logv2/log.h"
 #include "mongo/s/shard_key_pattern.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/transform_iterator.hpp>
@@ -72,6 +75,7 @@
 namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildFirstDrain);
+MONGO_FAIL_POINT_DEFINE(hangBeforeIndexBuildDrainBeforeCommit);
 MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildSecondDrain);
 MONGO_FAIL_POINT_DEFINE(hangAfterIndexBuildDumpsInsertsFromBulk);
 MONGO_FAIL_POINT_DEFINE(hangAfterInitializingIndexBuild);
@@ -94,6 +98,18 @@ constexpr StringData kIndexesFieldName = "indexes"_sd;
 constexpr StringData kKeyFieldName = "key"_sd;
 constexpr StringData kUniqueFieldName = "unique"_sd;
 
+// How often, and for how long, index builds held the exclusive collection lock to commit, and how
+// many side writes they drained while holding it.
+Counter64 exclusiveLockOnCommitCount;
+Counter64 exclusiveLockOnCommitMillis;
+Counter64 exclusiveLockOnCommitSideWrites;
+ServerStatusMetricField<Counter64> displayExclusiveLockOnCommitCount(
+    "indexBuilds.commitExclusiveLock.count", &exclusiveLockOnCommitCount);
+ServerStatusMetricField<Counter64> displayExclusiveLockOnCommitMillis(
+    "indexBuilds.commitExclusiveLock.totalMillis", &exclusiveLockOnCommitMillis);
+ServerStatusMetricField<Counter64> displayExclusiveLockOnCommitSideWrites(
+    "indexBuilds.commitExclusiveLock.sideWritesDrained", &exclusiveLockOnCommitSideWrites);
+
 /**
  * Checks if unique index specification is compatible with sharding configuration.
  */
@@ -2672,6 +2688,42 @@ void IndexBuildsCoordinator::_insertKeysFromSideTablesWithoutBlockingWrites(
         hangAfterIndexBuildFirstDrain.pauseWhileSet(opCtx);
     }
 }
+
+void IndexBuildsCoordinator::_insertKeysFromSideTablesBeforeCommit(
+    OperationContext* opCtx, std::shared_ptr<ReplIndexBuildState> replState) {
+    // Narrow the writes left for the final drain under the exclusive lock by draining while
+    // holding intent locks, until few enough are left or the number of drains runs out.
+    const NamespaceStringOrUUID dbAndUUID(replState->dbName, replState->collectionUUID);
+    const auto maxDrains = maxIndexBuildDrainsBeforeCommit.load();
+    for (int drain = 0; drain < maxDrains; ++drain) {
+        Lock::DBLock autoDb(opCtx, replState->dbName, MODE_IX);
+        Lock::CollectionLock collLock(opCtx, dbAndUUID, MODE_IX);
+
+        const auto numPending =
+            _indexBuildsManager.getNumPendingBackgroundWrites(opCtx, replState->buildUUID);
+        if (numPending <= maxIndexBuildSideWritesDrainedOnCommit.load()) {
+            return;
+        }
+
+        if (MONGO_unlikely(hangBeforeIndexBuildDrainBeforeCommit.shouldFail())) {
+            LOGV2(5191470, "Hanging before index build drain before commit");
+            hangBeforeIndexBuildDrainBeforeCommit.pauseWhileSet(opCtx);
+        }
+
+        LOGV2_DEBUG(5191471,
+                    1,
+                    "Index build: draining side writes before commit",
+                    "buildUUID"_attr = replState->buildUUID,
+                    "pendingWrites"_attr = numPending,
+                    "drain"_attr = drain + 1);
+        uassertStatusOK(_indexBuildsManager.drainBackgroundWrites(
+            opCtx,
+            replState->buildUUID,
+            RecoveryUnit::ReadSource::kNoTimestamp,
+            IndexBuildInterceptor::DrainYieldPolicy::kYield));
+    }
+}
+
 void IndexBuildsCoordinator::_insertKeysFromSideTablesBlockingWrites(
     OperationContext* opCtx,
     std::shared_ptr<ReplIndexBuildState> replState,
@@ -2715,6 +2767,8 @@ IndexBuildsCoordinator::CommitResult IndexBuildsCoordinator::_insertKeysFromSide
         hangIndexBuildBeforeCommit.pauseWhileSet();
     }
 
+    _insertKeysFromSideTablesBeforeCommit(opCtx, replState);
+
     Lock::DBLock autoDb(opCtx, replState->dbName, MODE_IX);
 
     // Unlock RSTL to avoid deadlocks with prepare conflicts and state transitions caused by waiting
@@ -2725,6 +2779,12 @@ IndexBuildsCoordinator::CommitResult IndexBuildsCoordinator::_insertKeysFromSide
     const NamespaceStringOrUUID dbAndUUID(replState->dbName, replState->collectionUUID);
     Lock::CollectionLock collLock(opCtx, dbAndUUID, MODE_X);
 
+    Timer exclusiveLockTimer;
+    ON_BLOCK_EXIT([&] {
+        exclusiveLockOnCommitCount.increment();
+        exclusiveLockOnCommitMillis.increment(exclusiveLockTimer.millis());
+    });
+
     // If we can't acquire the RSTL within a given time period, there is an active state transition
     // and we should release our locks and try again. We would otherwise introduce a deadlock with
     // step-up by holding the Collection lock in exclusive mode. After it has enqueued its RSTL X
@@ -2773,6 +2833,8 @@ IndexBuildsCoordinator::CommitResult IndexBuildsCoordinator::_insertKeysFromSide
 
     // Perform the third and final drain after releasing a shared lock and reacquiring an exclusive
     // lock on the collection.
+    exclusiveLockOnCommitSideWrites.increment(
+        _indexBuildsManager.getNumPendingBackgroundWrites(opCtx, replState->buildUUID));
     uassertStatusOK(_indexBuildsManager.drainBackgroundWrites(
         opCtx,
         replState->buildUUID,
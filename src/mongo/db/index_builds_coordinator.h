@@ -673,6 +673,14 @@ protected:
                                                  std::shared_ptr<ReplIndexBuildState> replState,
                                                  const IndexBuildOptions& indexBuildOptions);
 
+    /**
+     * Before taking the exclusive collection lock to commit, catches up on the writes that occurred
+     * while waiting to commit, while only holding intent locks, so that the final drain under the
+     * exclusive lock is short.
+     */
+    void _insertKeysFromSideTablesBeforeCommit(OperationContext* opCtx,
+                                               std::shared_ptr<ReplIndexBuildState> replState);
+
     /**
      * Reads the commit ready members list for index build UUID in 'replState' from
      * "config.system.indexBuilds" collection. And, signals the index builder thread on primary to
@@ -359,6 +359,12 @@ MONGO_INITIALIZER_GENERAL(ServerLogRedirection,
             ? logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kAppend
             : logv2::LogDomainGlobal::ConfigurationOptions::OpenMode::kTruncate;
 
+        lv2Config.fileAsync = gLogAsyncFileWrites;
+        lv2Config.fileAsyncBufferBytes = static_cast<size_t>(gLogAsyncBufferSizeKB) * 1024;
+        lv2Config.fileAsyncOverflowPolicy = gLogAsyncDropOnOverflow
+            ? logv2::LogDomainGlobal::ConfigurationOptions::AsyncOverflowPolicy::kDrop
+            : logv2::LogDomainGlobal::ConfigurationOptions::AsyncOverflowPolicy::kBlock;
+
         if (serverGlobalParams.logAppend && exists) {
             writeServerRestartedAfterLogConfig = true;
         }
@@ -179,6 +179,13 @@ Status LogicalTimeValidator::validate(OperationContext* opCtx, const SignedLogic
         return res;
     }
 
+    // The cluster times up to a validated one need no validation, since the cluster has already
+    // reached it. Gossip of the times up to it then skips the key lookup and the HMAC.
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (newTime.getTime() > _lastSeenValidTime.getTime()) {
+        _lastSeenValidTime = newTime;
+    }
+
     return Status::OK();
 }
 
@@ -71,7 +71,8 @@ public:
     SignedLogicalTime signLogicalTime(OperationContext* opCtx, const LogicalTime& newTime);
 
     /**
-     * Returns true if the signature of newTime is valid.
+     * Returns true if the signature of newTime is valid. Times up to the greatest one signed or
+     * validated so far are valid without checking their signature.
      */
     Status validate(OperationContext* opCtx, const SignedLogicalTime& newTime);
 
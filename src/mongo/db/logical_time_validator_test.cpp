@@ -93,6 +93,10 @@ protected:
         _keyManager->refreshNow(operationContext());
     }
 
+    KeysCollectionManager* keyManager() {
+        return _keyManager.get();
+    }
+
 private:
     std::unique_ptr<LogicalTimeValidator> _validator;
     std::shared_ptr<KeysCollectionManager> _keyManager;
@@ -162,6 +166,34 @@ TEST_F(LogicalTimeValidatorTest, ValidateErrorsOnInvalidTimeWithImplicitRefresh)
     ASSERT_EQ(ErrorCodes::TimeProofMismatch, status);
 }
 
+TEST_F(LogicalTimeValidatorTest, ValidateSkipsTimesUpToTheGreatestValidatedTime) {
+    validator()->enableKeyGenerator(operationContext(), true);
+
+    LogicalTime t1(Timestamp(20, 0));
+    refreshKeyManager();
+    auto newTime = validator()->trySignLogicalTime(t1);
+
+    // A time greater than any signed one needs a valid signature, which then makes the times up to
+    // it valid.
+    TimeProofService::TimeProof invalidProof = {{{1, 2, 3}}};
+    TimeProofService timeProofService;
+    auto keyDoc = uassertStatusOK(keyManager()->getKeyForValidation(
+        operationContext(), newTime.getKeyId(), newTime.getTime()));
+    const auto& key = keyDoc.getKey();
+    LogicalTime t2(Timestamp(30, 0));
+    SignedLogicalTime validTime(t2, timeProofService.getProof(t2, key), newTime.getKeyId());
+    ASSERT_OK(validator()->validate(operationContext(), validTime));
+
+    SignedLogicalTime belowValidTime(
+        LogicalTime(Timestamp(25, 0)), invalidProof, newTime.getKeyId());
+    ASSERT_OK(validator()->validate(operationContext(), belowValidTime));
+
+    SignedLogicalTime aboveValidTime(
+        LogicalTime(Timestamp(40, 0)), invalidProof, newTime.getKeyId());
+    ASSERT_EQ(ErrorCodes::TimeProofMismatch,
+              validator()->validate(operationContext(), aboveValidTime));
+}
+
 TEST_F(LogicalTimeValidatorTest, ShouldGossipLogicalTimeIsFalseUntilKeysAreFound) {
     // shouldGossipLogicalTime initially returns false.
     ASSERT_EQ(false, validator()->shouldGossipLogicalTime());
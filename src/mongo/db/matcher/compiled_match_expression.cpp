@@ -0,0 +1,215 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "mongo/db/field_ref.h"
+#include "mongo/db/matcher/expression_path.h"
+
+namespace mongo {
+
+CompiledMatchExpression::CompiledMatchExpression(const MatchExpression* expr) {
+    invariant(expr);
+    if (expr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            _addConjunct(expr->getChild(i));
+        }
+    } else {
+        _addConjunct(expr);
+    }
+    _resolvedPaths.resize(_paths.size());
+}
+
+bool CompiledMatchExpression::_isCompilable(const MatchExpression* expr) {
+    // These leaves test each element their path reaches with matchesSingleElement(). Absent arrays
+    // the path reaches exactly one element, which is EOO when the path is missing.
+    switch (expr->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::TYPE_OPERATOR:
+            return !expr->path().empty();
+        default:
+            return false;
+    }
+}
+
+void CompiledMatchExpression::_addConjunct(const MatchExpression* expr) {
+    if (!_isCompilable(expr)) {
+        _interpreted.push_back(expr);
+        return;
+    }
+
+    CompiledLeaf leaf;
+    leaf.expr = static_cast<const PathMatchExpression*>(expr);
+    leaf.path = _addPath(expr->path());
+    _leaves.push_back(leaf);
+}
+
+int CompiledMatchExpression::_addPath(StringData dottedPath) {
+    FieldRef fieldRef(dottedPath);
+    int parent = -1;
+    for (FieldIndex i = 0; i < fieldRef.numParts(); ++i) {
+        const auto part = fieldRef.getPart(i);
+        auto it = std::find_if(_paths.begin(), _paths.end(), [&](const PathComponent& component) {
+            return component.parent == parent && component.fieldName == part;
+        });
+        if (it == _paths.end()) {
+            _paths.push_back({parent, part.toString()});
+            parent = _paths.size() - 1;
+        } else {
+            parent = it - _paths.begin();
+        }
+    }
+    return parent;
+}
+
+const CompiledMatchExpression::ResolvedPath& CompiledMatchExpression::_resolve(const BSONObj& doc,
+                                                                               int path) {
+    auto& resolved = _resolvedPaths[path];
+    if (resolved.resolved) {
+        return resolved;
+    }
+    resolved.resolved = true;
+
+    const auto& component = _paths[path];
+    BSONElement element;
+    if (component.parent < 0) {
+        element = doc.getField(component.fieldName);
+    } else {
+        const auto& parent = _resolve(doc, component.parent);
+        if (parent.traversesArray) {
+            resolved.traversesArray = true;
+            return resolved;
+        }
+        // A path through a missing field or a scalar is missing, like in getFieldDottedOrArray().
+        if (parent.element.type() == Object) {
+            element = parent.element.embeddedObject().getField(component.fieldName);
+        }
+    }
+
+    resolved.element = element;
+    resolved.traversesArray = element.type() == Array;
+    return resolved;
+}
+
+bool CompiledMatchExpression::_matchesLeaf(const BSONObj& doc, const CompiledLeaf& leaf) {
+    const auto& resolved = _resolve(doc, leaf.path);
+    return resolved.traversesArray ? leaf.expr->matchesBSON(doc)
+                                   : leaf.expr->matchesSingleElement(resolved.element);
+}
+
+bool CompiledMatchExpression::matchesBSON(const BSONObj& doc) {
+    std::fill(_resolvedPaths.begin(), _resolvedPaths.end(), ResolvedPath());
+
+    if (++_docsSinceReorder == kReorderInterval) {
+        _reorder();
+    }
+
+    for (auto& leaf : _leaves) {
+        bool matched;
+        if (leaf.evaluated++ % kCostSampleInterval == 0) {
+            const auto start = std::chrono::steady_clock::now();
+            matched = _matchesLeaf(doc, leaf);
+            leaf.timedNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count();
+            ++leaf.timedEvaluations;
+        } else {
+            matched = _matchesLeaf(doc, leaf);
+        }
+        if (!matched) {
+            ++leaf.rejected;
+            return false;
+        }
+    }
+
+    for (auto expr : _interpreted) {
+        if (!expr->matchesBSON(doc)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void CompiledMatchExpression::_reorder() {
+    _docsSinceReorder = 0;
+
+    // Running the leaves in decreasing order of rejected documents per unit of cost minimizes the
+    // expected cost of a conjunction of independent predicates. A leaf is only evaluated on the
+    // documents the leaves before it accepted, so its rate is conditional on them, which is enough
+    // to move predicates that are much cheaper or more selective than the ones ahead of them to
+    // the front. A leaf whose cost was not sampled yet counts as costing one nanosecond.
+    auto rank = [](const CompiledLeaf& leaf) {
+        if (!leaf.evaluated) {
+            return 0.0;
+        }
+        const double rejectRate = static_cast<double>(leaf.rejected) / leaf.evaluated;
+        const double cost = leaf.timedEvaluations
+            ? static_cast<double>(leaf.timedNanos) / leaf.timedEvaluations
+            : 0.0;
+        return rejectRate / std::max(cost, 1.0);
+    };
+    std::stable_sort(_leaves.begin(), _leaves.end(), [&](const auto& lhs, const auto& rhs) {
+        return rank(lhs) > rank(rhs);
+    });
+
+    // Decay the statistics so that the order follows changes in the data.
+    for (auto& leaf : _leaves) {
+        leaf.evaluated /= 2;
+        leaf.rejected /= 2;
+        leaf.timedEvaluations /= 2;
+        leaf.timedNanos /= 2;
+    }
+}
+
+std::vector<const MatchExpression*> CompiledMatchExpression::leafOrder() const {
+    std::vector<const MatchExpression*> order;
+    for (const auto& leaf : _leaves) {
+        order.push_back(leaf.expr);
+    }
+    return order;
+}
+
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+class PathMatchExpression;
+
+/**
+ * A MatchExpression flattened into a list of conjuncts, for callers which test many documents
+ * against the same expression, such as the filter of a collection scan or a $match stage.
+ *
+ * The leaf predicates of a top-level $and (or a lone leaf) whose semantics only depend on a
+ * single element when no array is involved are evaluated directly against that element. Their
+ * paths are organized as a tree of path components, so that a prefix shared by several
+ * predicates is looked up once per document. When a path traverses an array, the predicate falls
+ * back to the interpreted MatchExpression::matchesBSON() for that document, as do all conjuncts
+ * which cannot be compiled.
+ *
+ * The compiled leaves are evaluated first, in an order adapted periodically to the fraction of
+ * documents each rejects and to its measured cost, so that cheap and selective predicates run
+ * first. The remaining conjuncts run afterwards in their original order.
+ *
+ * The MatchExpression must outlive this object and must not be modified while it is in use.
+ * Instances keep per-document scratch state and statistics, and are not thread safe.
+ */
+class CompiledMatchExpression {
+    CompiledMatchExpression(const CompiledMatchExpression&) = delete;
+    CompiledMatchExpression& operator=(const CompiledMatchExpression&) = delete;
+
+public:
+    // The number of documents tested between two reorderings of the compiled leaves.
+    static constexpr uint64_t kReorderInterval = 1024;
+
+    // One in this many evaluations of each compiled leaf is timed to estimate its cost.
+    static constexpr uint64_t kCostSampleInterval = 16;
+
+    explicit CompiledMatchExpression(const MatchExpression* expr);
+
+    /**
+     * Returns whether 'doc' matches the expression, with the same result as
+     * MatchExpression::matchesBSON() without MatchDetails.
+     */
+    bool matchesBSON(const BSONObj& doc);
+
+    /**
+     * Returns the number of conjuncts evaluated directly against an element. For testing.
+     */
+    size_t numCompiledLeaves() const {
+        return _leaves.size();
+    }
+
+    /**
+     * Returns the number of distinct path components looked up per document. For testing.
+     */
+    size_t numPathComponents() const {
+        return _paths.size();
+    }
+
+    /**
+     * Returns the leaves in their current evaluation order. For testing.
+     */
+    std::vector<const MatchExpression*> leafOrder() const;
+
+private:
+    /**
+     * One component of a path used by a compiled leaf. Components with the same parent and field
+     * name are shared.
+     */
+    struct PathComponent {
+        // Index of the parent component in '_paths', or -1 for a top-level field.
+        int parent;
+        std::string fieldName;
+    };
+
+    /**
+     * The element at the end of a path in the current document. 'traversesArray' is set when the
+     * element or any of its ancestors along the path is an array, in which case 'element' is
+     * meaningless and the interpreted matcher must be used.
+     */
+    struct ResolvedPath {
+        BSONElement element;
+        bool traversesArray = false;
+        bool resolved = false;
+    };
+
+    struct CompiledLeaf {
+        const PathMatchExpression* expr;
+        // Index in '_paths' of the last component of the leaf's path.
+        int path;
+        uint64_t evaluated = 0;
+        uint64_t rejected = 0;
+        uint64_t timedEvaluations = 0;
+        uint64_t timedNanos = 0;
+    };
+
+    static bool _isCompilable(const MatchExpression* expr);
+
+    void _addConjunct(const MatchExpression* expr);
+
+    int _addPath(StringData dottedPath);
+
+    const ResolvedPath& _resolve(const BSONObj& doc, int path);
+
+    bool _matchesLeaf(const BSONObj& doc, const CompiledLeaf& leaf);
+
+    void _reorder();
+
+    std::vector<PathComponent> _paths;
+    std::vector<CompiledLeaf> _leaves;
+    std::vector<const MatchExpression*> _interpreted;
+
+    // Per-document scratch space, one entry per element of '_paths'.
+    std::vector<ResolvedPath> _resolvedPaths;
+
+    uint64_t _docsSinceReorder = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/compiled_match_expression.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
+    auto result = MatchExpressionParser::parse(query, expCtx);
+    ASSERT_OK(result.getStatus());
+    return MatchExpression::optimize(std::move(result.getValue()));
+}
+
+const std::vector<BSONObj> kDocs{
+    fromjson("{}"),
+    fromjson("{a: 1}"),
+    fromjson("{a: 5, b: 'x'}"),
+    fromjson("{a: null, b: 'abc'}"),
+    fromjson("{a: [1, 5, 7], b: 'y'}"),
+    fromjson("{a: {b: 1, c: 2}}"),
+    fromjson("{a: {b: [1, 2], c: 3}}"),
+    fromjson("{a: [{b: 1}, {b: 4}], c: 1}"),
+    fromjson("{a: {b: {c: 6}}, b: 4}"),
+    fromjson("{a: 'str', b: 10, c: 3}"),
+    fromjson("{a: {'0': 5}, b: NaN}"),
+    fromjson("{a: [[5]], b: 7, c: {d: null}}"),
+};
+
+void assertMatchesLikeInterpreted(const char* query) {
+    auto expr = parse(fromjson(query));
+    CompiledMatchExpression compiled(expr.get());
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& doc : kDocs) {
+            ASSERT_EQ(compiled.matchesBSON(doc), expr->matchesBSON(doc))
+                << "query: " << query << ", document: " << doc;
+        }
+    }
+}
+
+TEST(CompiledMatchExpressionTest, MatchesLikeInterpreted) {
+    for (const char* query : {"{}",
+                              "{a: 5}",
+                              "{a: null}",
+                              "{a: {$gt: 1}, b: {$lt: 8}}",
+                              "{a: {$gte: 1, $lte: 5}, b: {$exists: true}}",
+                              "{'a.b': 1}",
+                              "{'a.b': null, 'a.c': {$gte: 2}}",
+                              "{'a.b': {$in: [1, 4]}, c: 1}",
+                              "{'a.0': 5}",
+                              "{'a.b.c': {$exists: false}}",
+                              "{b: /^a/}",
+                              "{b: {$type: 'string'}, a: {$ne: 1}}",
+                              "{b: {$mod: [2, 0]}}",
+                              "{b: {$bitsAllSet: [1]}}",
+                              "{b: {$eq: NaN}}",
+                              "{a: [1, 5, 7]}",
+                              "{$or: [{a: 1}, {b: 4}]}",
+                              "{a: {$elemMatch: {$gt: 4}}, b: 'y'}",
+                              "{'c.d': null, a: {$size: 1}}",
+                              "{$expr: {$eq: ['$b', 4]}, 'a.b.c': 6}"}) {
+        assertMatchesLikeInterpreted(query);
+    }
+}
+
+TEST(CompiledMatchExpressionTest, SharesPathPrefixes) {
+    auto expr = parse(fromjson("{'a.b': 1, 'a.c': 2, 'a.b.d': 3, b: 4}"));
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numCompiledLeaves(), 4U);
+    // a, a.b, a.c, a.b.d and b.
+    ASSERT_EQ(compiled.numPathComponents(), 5U);
+}
+
+TEST(CompiledMatchExpressionTest, InterpretsNonLeafConjuncts) {
+    auto expr = parse(fromjson("{a: 1, $or: [{b: 1}, {c: 1}], d: {$not: {$gt: 1}}}"));
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numCompiledLeaves(), 1U);
+    ASSERT_TRUE(compiled.matchesBSON(fromjson("{a: 1, c: 1, d: 0}")));
+    ASSERT_FALSE(compiled.matchesBSON(fromjson("{a: 1, c: 2}")));
+}
+
+TEST(CompiledMatchExpressionTest, ReordersBySelectivity) {
+    auto expr = parse(fromjson("{a: {$gte: 0}, b: 1}"));
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numCompiledLeaves(), 2U);
+    const auto* bLeaf = compiled.leafOrder()[0]->path() == "b" ? compiled.leafOrder()[0]
+                                                               : compiled.leafOrder()[1];
+
+    // Every document passes 'a' and almost none pass 'b', so 'b' must end up first.
+    for (uint64_t i = 0; i < CompiledMatchExpression::kReorderInterval + 1; ++i) {
+        BSONObj doc = BSON("a" << static_cast<int>(i) << "b" << (i % 100 == 0 ? 1 : 2));
+        ASSERT_EQ(compiled.matchesBSON(doc), i % 100 == 0);
+    }
+    ASSERT_EQ(compiled.leafOrder()[0], bLeaf);
+}
+
+TEST(CompiledMatchExpressionTest, ReordersByCost) {
+    auto expr = parse(fromjson("{a: /x$/, b: 1}"));
+    CompiledMatchExpression compiled(expr.get());
+    ASSERT_EQ(compiled.numCompiledLeaves(), 2U);
+
+    // Both predicates reject half of the documents independently, but the regex scans a long
+    // string while the equality is a single comparison, so the equality must end up first.
+    const std::string longString(16 * 1024, 'a');
+    for (uint64_t i = 0; i < CompiledMatchExpression::kReorderInterval + 1; ++i) {
+        BSONObj doc = BSON("a" << longString + (i % 2 ? "x" : "y") << "b"
+                               << static_cast<int>((i / 2) % 2));
+        ASSERT_EQ(compiled.matchesBSON(doc), i % 4 == 3);
+    }
+    ASSERT_EQ(compiled.leafOrder()[0]->path(), "b");
+}
+
+}  // namespace
+}  // namespace mongo
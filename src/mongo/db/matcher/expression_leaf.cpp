@@ -31,6 +31,8 @@
 
 #include "mongo/db/matcher/expression_leaf.h"
 
+#include <absl/container/flat_hash_set.h>
+#include <bitset>
 #include <cmath>
 #include <memory>
 #include <pcrecpp.h>
@@ -371,6 +373,129 @@ bool ExistsMatchExpression::equivalent(const MatchExpression* other) const {
 
 // ----
 
+/**
+ * Hash tables over the integer, ObjectId and string equalities of an InMatchExpression, grouped
+ * by canonical type. Elements of a canonical type which has no equalities are rejected right
+ * away.
+ */
+struct InMatchExpression::HashedEqualities {
+    HashedEqualities(const std::vector<BSONElement>& equalities, const CollatorInterface* collator)
+        : collator(collator) {
+        for (auto&& equality : equalities) {
+            canonicalTypes.set(canonicalizeBSONType(equality.type()) + 1);
+            switch (equality.type()) {
+                case NumberInt:
+                    integers.insert(equality._numberInt());
+                    break;
+                case NumberLong:
+                    integers.insert(equality._numberLong());
+                    break;
+                case NumberDouble: {
+                    auto asInteger = toInteger(equality._numberDouble());
+                    if (asInteger) {
+                        integers.insert(*asInteger);
+                    } else {
+                        integersOnly = false;
+                    }
+                    break;
+                }
+                case NumberDecimal:
+                    integersOnly = false;
+                    break;
+                case jstOID:
+                    objectIds.insert(equality.__oid());
+                    break;
+                case String:
+                    strings.insert(comparisonString(equality.valueStringData()));
+                    break;
+                case Symbol:
+                    stringsOnly = false;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    /**
+     * Returns the value of 'd' if it is an integer which a long long can hold exactly.
+     */
+    static boost::optional<long long> toInteger(double d) {
+        // Both bounds are powers of two, exactly representable as doubles. NaN fails either test.
+        if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0)) {
+            return boost::none;
+        }
+        const auto asInteger = static_cast<long long>(d);
+        if (static_cast<double>(asInteger) != d) {
+            return boost::none;
+        }
+        return asInteger;
+    }
+
+    std::string comparisonString(StringData str) const {
+        return collator ? collator->getComparisonKey(str).getKeyData().toString() : str.toString();
+    }
+
+    /**
+     * Returns whether 'e' is equal to one of the equalities, or boost::none when this can only be
+     * answered by searching them for elements of its type.
+     */
+    boost::optional<bool> contains(const BSONElement& e) const {
+        if (!canonicalTypes[canonicalizeBSONType(e.type()) + 1]) {
+            return false;
+        }
+
+        switch (e.type()) {
+            case NumberInt:
+                return integersOnly ? boost::make_optional(integers.contains(e._numberInt()))
+                                    : boost::none;
+            case NumberLong:
+                return integersOnly ? boost::make_optional(integers.contains(e._numberLong()))
+                                    : boost::none;
+            case NumberDouble: {
+                if (!integersOnly) {
+                    return boost::none;
+                }
+                // A double equals an integer only if it holds that integer exactly.
+                auto asInteger = toInteger(e._numberDouble());
+                return asInteger && integers.contains(*asInteger);
+            }
+            case jstOID:
+                return objectIds.contains(e.__oid());
+            case String: {
+                if (!stringsOnly) {
+                    return boost::none;
+                }
+                auto str = e.valueStringData();
+                if (collator) {
+                    auto key = collator->getComparisonKey(str);
+                    auto keyData = key.getKeyData();
+                    return strings.contains(absl::string_view(keyData.rawData(), keyData.size()));
+                }
+                return strings.contains(absl::string_view(str.rawData(), str.size()));
+            }
+            default:
+                return boost::none;
+        }
+    }
+
+    const CollatorInterface* const collator;
+
+    // The canonical types of the equalities, offset by one to make room for MinKey.
+    std::bitset<MaxKey + 2> canonicalTypes;
+
+    // Whether every numeric equality is an integer held by 'integers'.
+    bool integersOnly = true;
+    absl::flat_hash_set<long long> integers;
+
+    absl::flat_hash_set<OID, OID::Hasher> objectIds;
+
+    // Whether every equality of canonical type String is a string, rather than a symbol, and is
+    // therefore held by 'strings' as its comparison key or as is, without a collator.
+    bool stringsOnly = true;
+    absl::flat_hash_set<std::string> strings;
+};
+
 InMatchExpression::InMatchExpression(StringData path, clonable_ptr<ErrorAnnotation> annotation)
     : LeafMatchExpression(MATCH_IN, path, std::move(annotation)),
       _eltCmp(BSONElementComparator::FieldNamesMode::kIgnore, _collator) {}
@@ -384,6 +509,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasNull = _hasNull;
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
+    next->_hashedEqualities = _hashedEqualities;
     next->_originalEqualityVector = _originalEqualityVector;
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
@@ -394,6 +520,11 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_hashedEqualities) {
+        if (auto found = _hashedEqualities->contains(e)) {
+            return *found;
+        }
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
@@ -505,6 +636,7 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _updateHashedEqualities();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -538,10 +670,19 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _updateHashedEqualities();
 
     return Status::OK();
 }
 
+void InMatchExpression::_updateHashedEqualities() {
+    const auto minEqualities =
+        _collator ? kMinCollatedEqualitiesForHashing : kMinEqualitiesForHashing;
+    _hashedEqualities = _equalitySet.size() >= minEqualities
+        ? std::make_shared<const HashedEqualities>(_equalitySet, _collator)
+        : nullptr;
+}
+
 Status InMatchExpression::addRegex(std::unique_ptr<RegexMatchExpression> expr) {
     _regexes.push_back(std::move(expr));
     return Status::OK();
@@ -94,6 +94,8 @@ public:
  */
 class ComparisonMatchExpressionBase : public LeafMatchExpression {
 public:
+    using InputParamId = int32_t;
+
     static bool isEquality(MatchType matchType) {
         switch (matchType) {
             case MatchExpression::EQ:
@@ -141,6 +143,19 @@ public:
         return _collator;
     }
 
+    /**
+     * Marks the RHS of this expression as an input parameter of the query. A plan built for the
+     * query may then read the value via 'id' instead of embedding it, so that the plan can be run
+     * again with a different value. See expression_parameterization.h.
+     */
+    void setInputParamId(boost::optional<InputParamId> id) {
+        _inputParamId = id;
+    }
+
+    boost::optional<InputParamId> getInputParamId() const {
+        return _inputParamId;
+    }
+
 protected:
     /**
      * 'collator' must outlive the ComparisonMatchExpression and any clones made of it.
@@ -156,6 +171,8 @@ protected:
     // Collator used to compare elements. By default, simple binary comparison will be used.
     const CollatorInterface* _collator = nullptr;
 
+    boost::optional<InputParamId> _inputParamId;
+
 private:
     ExpressionOptimizerFunc getOptimizer() const final {
         return [](std::unique_ptr<MatchExpression> expression) { return expression; };
@@ -217,6 +234,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -253,6 +271,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -289,6 +308,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -330,6 +350,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -370,6 +391,7 @@ public:
             e->setTag(getTag()->clone());
         }
         e->setCollator(_collator);
+        e->setInputParamId(_inputParamId);
         return e;
     }
 
@@ -541,6 +563,14 @@ private:
  */
 class InMatchExpression : public LeafMatchExpression {
 public:
+    // Equality sets of at least this many elements are also indexed by hash tables for lookups.
+    static constexpr size_t kMinEqualitiesForHashing = 32;
+
+    // Under a non-simple collation each step of a binary search over strings is a collator
+    // comparison, while a hashed lookup computes a single comparison key, so smaller equality sets
+    // are hashed as well.
+    static constexpr size_t kMinCollatedEqualitiesForHashing = 8;
+
     explicit InMatchExpression(StringData path, clonable_ptr<ErrorAnnotation> annotation = nullptr);
 
     virtual std::unique_ptr<MatchExpression> shallowClone() const;
@@ -584,6 +614,13 @@ public:
         return _hasEmptyArray;
     }
 
+    /**
+     * Returns whether lookups go through hash tables rather than binary search. For testing.
+     */
+    bool isHashed() const {
+        return static_cast<bool>(_hashedEqualities);
+    }
+
     void acceptVisitor(MatchExpressionMutableVisitor* visitor) final {
         visitor->visit(this);
     }
@@ -593,8 +630,15 @@ public:
     }
 
 private:
+    struct HashedEqualities;
+
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds '_hashedEqualities' after '_equalitySet' or '_collator' changed.
+     */
+    void _updateHashedEqualities();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -618,10 +662,13 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // Hash tables answering lookups of the most common types in '_equalitySet' in constant time,
+    // when it holds at least kMinEqualitiesForHashing elements. Lookups of other types still binary
+    // search '_equalitySet'. Immutable, and therefore shared between clones.
+    std::shared_ptr<const HashedEqualities> _hashedEqualities;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
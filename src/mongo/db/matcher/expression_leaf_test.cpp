@@ -1370,6 +1370,140 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+bool containsByComparison(const BSONObj& equalities,
+                          const BSONElement& e,
+                          const CollatorInterface* collator) {
+    for (auto&& equality : equalities) {
+        if (equality.woCompare(e, false, collator) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void assertHashedLookupsMatchComparison(const BSONObj& equalitiesObj,
+                                        const BSONObj& probes,
+                                        const CollatorInterface* collator = nullptr) {
+    InMatchExpression in("");
+    in.setCollator(collator);
+    std::vector<BSONElement> equalities;
+    for (auto&& equality : equalitiesObj) {
+        equalities.push_back(equality);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT(in.isHashed());
+
+    for (auto&& probe : probes) {
+        ASSERT_EQ(in.contains(probe), containsByComparison(equalitiesObj, probe, collator))
+            << probe;
+    }
+}
+
+BSONObj makeLargeInList(bool withDecimal, bool withSymbol) {
+    BSONObjBuilder bob;
+    size_t n = 0;
+    auto name = [&] { return std::to_string(n++); };
+    for (int i = 0; i < static_cast<int>(InMatchExpression::kMinEqualitiesForHashing); ++i) {
+        bob.append(name(), i);
+        bob.append(name(), static_cast<long long>(i) << 40);
+        bob.append(name(), "str" + std::to_string(i));
+    }
+    bob.append(name(), 2.0);
+    bob.append(name(), -0.0);
+    bob.append(name(), std::numeric_limits<long long>::max());
+    bob.append(name(), OID("5f7c2b0e1c9d440000a1b2c3"));
+    bob.append(name(), BSON("x" << 1));
+    bob.append(name(), "MiXeD");
+    if (withDecimal) {
+        bob.append(name(), Decimal128("7.5"));
+    }
+    if (withSymbol) {
+        bob.appendSymbol(name(), "sym");
+    }
+    return bob.obj();
+}
+
+BSONObj makeInListProbes() {
+    BSONObjBuilder bob;
+    size_t n = 0;
+    auto name = [&] { return std::to_string(n++); };
+    bob.append(name(), 3);
+    bob.append(name(), 3LL);
+    bob.append(name(), 3.0);
+    bob.append(name(), 3.5);
+    bob.append(name(), 7.5);
+    bob.append(name(), Decimal128("7.5"));
+    bob.append(name(), Decimal128("3"));
+    bob.append(name(), 0);
+    bob.append(name(), std::numeric_limits<double>::quiet_NaN());
+    bob.append(name(), 9223372036854775808.0);
+    bob.append(name(), std::numeric_limits<long long>::max());
+    bob.append(name(), static_cast<double>(1LL << 50));
+    bob.append(name(), static_cast<long long>(5) << 40);
+    bob.append(name(), 1000);
+    bob.append(name(), "str7");
+    bob.append(name(), "str");
+    bob.append(name(), "mixed");
+    bob.append(name(), "MiXeD");
+    bob.appendSymbol(name(), "sym");
+    bob.appendSymbol(name(), "str7");
+    bob.append(name(), OID("5f7c2b0e1c9d440000a1b2c3"));
+    bob.append(name(), OID("5f7c2b0e1c9d440000a1b2c4"));
+    bob.append(name(), BSON("x" << 1));
+    bob.append(name(), BSON("x" << 2));
+    bob.append(name(), true);
+    bob.appendNull(name());
+    return bob.obj();
+}
+
+TEST(InMatchExpression, SmallInListIsNotHashed) {
+    BSONObj operand = BSON_ARRAY(1 << 2 << 3);
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities{operand[0], operand[1], operand[2]};
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+    ASSERT_FALSE(in.isHashed());
+}
+
+TEST(InMatchExpression, HashedLookupsMatchComparison) {
+    assertHashedLookupsMatchComparison(makeLargeInList(false, false), makeInListProbes());
+}
+
+TEST(InMatchExpression, HashedLookupsMatchComparisonWithDecimalAndSymbol) {
+    assertHashedLookupsMatchComparison(makeLargeInList(true, true), makeInListProbes());
+}
+
+TEST(InMatchExpression, HashedLookupsRespectCollation) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    assertHashedLookupsMatchComparison(
+        makeLargeInList(false, false), makeInListProbes(), &collator);
+}
+
+TEST(InMatchExpression, SmallCollatedInListIsHashed) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    BSONArrayBuilder operand;
+    for (size_t i = 0; i < InMatchExpression::kMinCollatedEqualitiesForHashing; ++i) {
+        operand.append("Str" + std::to_string(i));
+    }
+    assertHashedLookupsMatchComparison(
+        operand.arr(), BSON_ARRAY("str1" << "STR7" << "str" << 1), &collator);
+}
+
+TEST(InMatchExpression, ClonesShareHashedEqualities) {
+    BSONObj operand = makeLargeInList(false, false);
+    InMatchExpression in("a");
+    std::vector<BSONElement> equalities;
+    for (auto&& equality : operand) {
+        equalities.push_back(equality);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    auto clone = in.shallowClone();
+    auto inClone = static_cast<InMatchExpression*>(clone.get());
+    ASSERT(inClone->isHashed());
+    ASSERT(inClone->matchesBSON(BSON("a" << 4.0)));
+    ASSERT(!inClone->matchesBSON(BSON("a" << 4.5)));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/matcher/expression_parameterization.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo::expression_parameterization {
+namespace {
+bool isLogicalNode(const MatchExpression& expr) {
+    switch (expr.matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool canParameterize(const BSONElement& elem) {
+    switch (elem.type()) {
+        case BSONType::NumberInt:
+        case BSONType::NumberLong:
+        case BSONType::NumberDouble:
+        case BSONType::NumberDecimal:
+        case BSONType::String:
+        case BSONType::Date:
+        case BSONType::Bool:
+        case BSONType::jstOID:
+        case BSONType::bsonTimestamp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Invokes 'callback' on each comparison with a parameterizable value which is reachable from
+ * 'expr' through logical nodes alone, in pre-order.
+ */
+template <typename ExprType, typename Callback>
+void forEachParameterizableComparison(ExprType* expr, const Callback& callback) {
+    if (isLogicalNode(*expr)) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            forEachParameterizableComparison<ExprType>(expr->getChild(i), callback);
+        }
+        return;
+    }
+
+    if (ComparisonMatchExpression::isComparisonMatchExpression(expr) &&
+        canParameterize(static_cast<const ComparisonMatchExpressionBase*>(expr)->getData())) {
+        callback(expr);
+    }
+}
+
+void appendParameterized(const MatchExpression& expr, BSONArrayBuilder* builder) {
+    BSONObjBuilder node{builder->subobjStart()};
+    if (isLogicalNode(expr)) {
+        node.append("t", static_cast<int>(expr.matchType()));
+        BSONArrayBuilder children{node.subarrayStart("c")};
+        for (size_t i = 0; i < expr.numChildren(); ++i) {
+            appendParameterized(*expr.getChild(i), &children);
+        }
+        return;
+    }
+
+    if (ComparisonMatchExpression::isComparisonMatchExpression(&expr)) {
+        auto comparison = static_cast<const ComparisonMatchExpressionBase*>(&expr);
+        if (auto id = comparison->getInputParamId()) {
+            node.append("t", static_cast<int>(expr.matchType()));
+            node.append("p", expr.path());
+            node.append("param", *id);
+            node.append("type", static_cast<int>(comparison->getData().type()));
+            return;
+        }
+    }
+
+    BSONObjBuilder value{node.subobjStart("v")};
+    expr.serialize(&value);
+}
+}  // namespace
+
+void parameterize(MatchExpression* root) {
+    ComparisonMatchExpressionBase::InputParamId nextId = 0;
+    forEachParameterizableComparison(root, [&](MatchExpression* expr) {
+        static_cast<ComparisonMatchExpressionBase*>(expr)->setInputParamId(nextId++);
+    });
+}
+
+std::vector<const ComparisonMatchExpressionBase*> getInputParams(const MatchExpression& root) {
+    std::vector<const ComparisonMatchExpressionBase*> params;
+    forEachParameterizableComparison(&root, [&](const MatchExpression* expr) {
+        auto comparison = static_cast<const ComparisonMatchExpressionBase*>(expr);
+        if (comparison->getInputParamId()) {
+            params.push_back(comparison);
+        }
+    });
+    return params;
+}
+
+BSONObj serializeParameterized(const MatchExpression& expr) {
+    BSONArrayBuilder builder;
+    appendParameterized(expr, &builder);
+    return builder.arr();
+}
+
+}  // namespace mongo::expression_parameterization
@@ -0,0 +1,64 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/matcher/expression_leaf.h"
+
+namespace mongo::expression_parameterization {
+
+/**
+ * Marks the values of the comparisons ($eq, $lt, $lte, $gt and $gte) reachable from 'root' through
+ * logical nodes alone as input parameters of the query, assigning them ids in pre-order. Only
+ * scalar values are marked, as the plans built for arrays, objects, null and other special values
+ * differ from those of regular values.
+ *
+ * Canonical queries of the same shape get the same ids for the same nodes, so the values of one
+ * can stand in for those of another in a plan built for either of them.
+ */
+void parameterize(MatchExpression* root);
+
+/**
+ * Returns the comparisons reachable from 'root' through logical nodes which are marked as input
+ * parameters, in the order of their ids.
+ */
+std::vector<const ComparisonMatchExpressionBase*> getInputParams(const MatchExpression& root);
+
+/**
+ * Serializes 'expr' with the values of input parameters replaced by their ids and types. Two
+ * parameterized expressions of the same shape serialize to the same BSON if and only if they
+ * differ in nothing but the values of their input parameters.
+ */
+BSONObj serializeParameterized(const MatchExpression& expr);
+
+}  // namespace mongo::expression_parameterization
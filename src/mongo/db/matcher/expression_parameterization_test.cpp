@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/json.h"
+#include "mongo/db/matcher/expression_parameterization.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using namespace expression_parameterization;
+
+std::unique_ptr<MatchExpression> parse(const BSONObj& query) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto swExpr = MatchExpressionParser::parse(query, expCtx);
+    ASSERT_OK(swExpr.getStatus());
+    return std::move(swExpr.getValue());
+}
+
+TEST(ExpressionParameterizationTest, ScalarComparisonsUnderLogicalNodesAreParameterized) {
+    auto query = fromjson(
+        "{a: 1, b: {$gt: 'x', $lte: 'z'}, $or: [{c: {$lt: {$date: 0}}}, {d: {$ne: true}}]}");
+    auto expr = parse(query);
+    parameterize(expr.get());
+
+    auto params = getInputParams(*expr);
+    ASSERT_EQ(params.size(), 5U);
+    for (size_t i = 0; i < params.size(); ++i) {
+        ASSERT_EQ(*params[i]->getInputParamId(), static_cast<int>(i));
+    }
+    ASSERT_EQ(params[0]->path(), "a");
+    ASSERT_EQ(params[1]->matchType(), MatchExpression::GT);
+    ASSERT_EQ(params[2]->matchType(), MatchExpression::LTE);
+    ASSERT_EQ(params[3]->path(), "c");
+    ASSERT_EQ(params[4]->path(), "d");
+}
+
+TEST(ExpressionParameterizationTest, SpecialValuesAndNonLogicalNodesAreNotParameterized) {
+    auto query = fromjson(
+        "{a: null, b: [1, 2], c: {x: 1}, d: {$in: [1, 2]}, e: {$elemMatch: {$gt: 1}}, "
+        "f: {$gt: {$minKey: 1}}}");
+    auto expr = parse(query);
+    parameterize(expr.get());
+
+    ASSERT_TRUE(getInputParams(*expr).empty());
+}
+
+TEST(ExpressionParameterizationTest, InputParamIdIsKeptByClones) {
+    auto query = fromjson("{a: {$gte: 5}}");
+    auto expr = parse(query);
+    parameterize(expr.get());
+
+    auto clone = expr->shallowClone();
+    auto params = getInputParams(*clone);
+    ASSERT_EQ(params.size(), 1U);
+    ASSERT_EQ(*params[0]->getInputParamId(), 0);
+}
+
+TEST(ExpressionParameterizationTest, SerializationIgnoresOnlyTheValuesOfInputParams) {
+    auto serialize = [](const BSONObj& query) {
+        auto expr = parse(query);
+        parameterize(expr.get());
+        return serializeParameterized(*expr);
+    };
+
+    auto base = serialize(fromjson("{a: 1, b: {$lt: 'x'}, c: null}"));
+    ASSERT_BSONOBJ_EQ(base, serialize(fromjson("{a: 2, b: {$lt: 'y'}, c: null}")));
+
+    // The types of the input params, and the values of everything else, are kept.
+    ASSERT_BSONOBJ_NE(base, serialize(fromjson("{a: 1.5, b: {$lt: 'x'}, c: null}")));
+    ASSERT_BSONOBJ_NE(base, serialize(fromjson("{a: 1, b: {$lt: 'x'}, c: [1]}")));
+    ASSERT_BSONOBJ_NE(base, serialize(fromjson("{a: 1, b: {$lte: 'x'}, c: null}")));
+}
+
+}  // namespace
+}  // namespace mongo
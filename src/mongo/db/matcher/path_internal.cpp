@@ -29,6 +29,8 @@
 
 #include "mongo/db/matcher/path_internal.h"
 
+#include "mongo/bson/bson_field_index.h"
+
 namespace mongo {
 
 bool isAllDigits(StringData str) {
@@ -52,7 +54,7 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
     bool stop = false;
     size_t partNum = startIndex;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        res = BSONFieldIndexScope::getField(curr, path.getPart(partNum));
 
         switch (res.type()) {
             case EOO:
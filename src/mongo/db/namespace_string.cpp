@@ -50,8 +50,11 @@ constexpr StringData NamespaceString::kAdminDb;
 constexpr StringData NamespaceString::kLocalDb;
 constexpr StringData NamespaceString::kConfigDb;
 constexpr StringData NamespaceString::kSystemDotViewsCollectionName;
+constexpr StringData NamespaceString::kSystemDotStatisticsCollectionName;
 constexpr StringData NamespaceString::kOrphanCollectionPrefix;
 constexpr StringData NamespaceString::kOrphanCollectionDb;
+constexpr StringData NamespaceString::kMaterializedViewCollectionPrefix;
+constexpr StringData NamespaceString::kTimeseriesBucketsCollectionPrefix;
 
 const NamespaceString NamespaceString::kServerConfigurationNamespace(NamespaceString::kAdminDb,
                                                                      "system.version");
@@ -102,6 +105,9 @@ const NamespaceString NamespaceString::kConfigSettingsNamespace(NamespaceString:
 const NamespaceString NamespaceString::kVectorClockNamespace(NamespaceString::kConfigDb,
                                                              "vectorClock");
 
+const NamespaceString NamespaceString::kPlanCacheSnapshotsNamespace(NamespaceString::kConfigDb,
+                                                                    "planCacheSnapshots");
+
 
 bool NamespaceString::isListCollectionsCursorNS() const {
     return coll() == listCollectionsCursorCol;
@@ -139,10 +145,20 @@ bool NamespaceString::isLegalClientSystemNS() const {
         return true;
     if (coll() == kSystemDotViewsCollectionName)
         return true;
+    if (coll() == kSystemDotStatisticsCollectionName)
+        return true;
     if (isTemporaryReshardingCollection()) {
         // Permit integration testing on resharding collections.
         return true;
     }
+    if (isMaterializedViewCollection()) {
+        // Materialized view results are written through the oplog like a user collection.
+        return true;
+    }
+    if (isTimeseriesBucketsCollection()) {
+        // Buckets are written by inserts into their time-series collection, and may be indexed.
+        return true;
+    }
 
     return false;
 }
@@ -273,6 +289,23 @@ bool NamespaceString::isTemporaryReshardingCollection() const {
     return coll().startsWith(kTemporaryReshardingCollectionPrefix);
 }
 
+bool NamespaceString::isMaterializedViewCollection() const {
+    return coll().startsWith(kMaterializedViewCollectionPrefix);
+}
+
+bool NamespaceString::isTimeseriesBucketsCollection() const {
+    return coll().startsWith(kTimeseriesBucketsCollectionPrefix);
+}
+
+NamespaceString NamespaceString::makeTimeseriesBucketsNamespace() const {
+    return NamespaceString(db(), kTimeseriesBucketsCollectionPrefix.toString() + coll());
+}
+
+NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
+    invariant(isTimeseriesBucketsCollection());
+    return NamespaceString(db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size()));
+}
+
 bool NamespaceString::isReplicated() const {
     if (isLocal()) {
         return false;
@@ -65,6 +65,9 @@ public:
     // Name for the system views collection
     static constexpr StringData kSystemDotViewsCollectionName = "system.views"_sd;
 
+    // Name for the system collection holding the index statistics built by the analyze command
+    static constexpr StringData kSystemDotStatisticsCollectionName = "system.statistics"_sd;
+
     // Names of privilege document collections
     static constexpr StringData kSystemUsers = "system.users"_sd;
     static constexpr StringData kSystemRoles = "system.roles"_sd;
@@ -76,6 +79,12 @@ public:
     // Prefix for temporary resharding collection.
     static constexpr StringData kTemporaryReshardingCollectionPrefix = "system.resharding."_sd;
 
+    // Prefix for the collections which hold the results of materialized views.
+    static constexpr StringData kMaterializedViewCollectionPrefix = "system.materialized."_sd;
+
+    // Prefix for the collections which hold the buckets of time-series collections.
+    static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
+
     // Namespace for storing configuration data, which needs to be replicated if the server is
     // running as a replica set. Documents in this collection should represent some configuration
     // state of the server, which needs to be recovered/consulted at startup. Each document in this
@@ -139,6 +148,9 @@ public:
     // Namespace for vector clock state.
     static const NamespaceString kVectorClockNamespace;
 
+    // Namespace for the plan cache entries recorded to warm up the plan caches of a new primary.
+    static const NamespaceString kPlanCacheSnapshotsNamespace;
+
     /**
      * Constructs an empty NamespaceString.
      */
@@ -304,6 +316,28 @@ public:
      */
     bool isTemporaryReshardingCollection() const;
 
+    /**
+     * Returns whether this namespace holds the results of a materialized view.
+     */
+    bool isMaterializedViewCollection() const;
+
+    /**
+     * Returns whether this namespace holds the buckets of a time-series collection.
+     */
+    bool isTimeseriesBucketsCollection() const;
+
+    /**
+     * Returns the namespace of the collection which holds the buckets of the time-series collection
+     * with this namespace.
+     */
+    NamespaceString makeTimeseriesBucketsNamespace() const;
+
+    /**
+     * Returns the namespace of the time-series collection whose buckets this namespace holds. Only
+     * valid if isTimeseriesBucketsCollection().
+     */
+    NamespaceString getTimeseriesViewNamespace() const;
+
     /**
      * Returns whether a namespace is replicated, based only on its string value. One notable
      * omission is that map reduce `tmp.mr` collections may or may not be replicated. Callers must
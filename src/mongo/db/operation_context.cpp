@@ -36,6 +36,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/operation_key_manager.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/wait_event.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
@@ -313,6 +314,7 @@ StatusWith<stdx::cv_status> OperationContext::waitForConditionOrInterruptNoAsser
     }
 
     const auto waitStatus = [&] {
+        WaitEventTimer waitTimer(this, WaitEvent::kInterruptibleWait);
         if (Date_t::max() == deadline) {
             Waitable::wait(_baton.get(), getServiceContext()->getPreciseClockSource(), cv, m);
             return stdx::cv_status::no_timeout;
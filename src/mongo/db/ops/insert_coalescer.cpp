@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ops/insert_coalescer.h"
+
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getInsertCoalescer = ServiceContext::declareDecoration<InsertCoalescer>();
+
+}  // namespace
+
+InsertCoalescer& InsertCoalescer::get(ServiceContext* serviceContext) {
+    return getInsertCoalescer(serviceContext);
+}
+
+StatusWith<repl::OpTime> InsertCoalescer::insert(const NamespaceString& nss,
+                                                 InsertStatement doc,
+                                                 size_t maxGroupSize,
+                                                 InsertGroupFn insertGroup) {
+    auto runGroup = [&insertGroup](std::vector<InsertStatement>* docs) {
+        try {
+            return insertGroup(docs);
+        } catch (const DBException& ex) {
+            return StatusWith<repl::OpTime>(ex.toStatus());
+        }
+    };
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    auto& queue = _queues[nss];
+    if (!queue) {
+        queue = std::make_unique<NamespaceQueue>();
+    }
+
+    if (auto group = queue->openGroup) {
+        if (group->docs.size() >= maxGroupSize) {
+            // The next group is already full, so rather than waiting for a later one, insert the
+            // document on its own alongside the group in progress.
+            lk.unlock();
+            std::vector<InsertStatement> docs{std::move(doc)};
+            return runGroup(&docs);
+        }
+
+        // Join the next group and let its leader insert the document. The leader cannot be
+        // interrupted while it holds documents on behalf of other operations, so neither is the
+        // wait for it.
+        group->docs.push_back(std::move(doc));
+        group->doneCV.wait(lk, [&] { return group->done; });
+        return group->result;
+    }
+
+    // Become the leader of the next group and wait for the group in progress, if any, to be done.
+    auto group = std::make_shared<Group>();
+    group->docs.push_back(std::move(doc));
+    queue->openGroup = group;
+    queue->turnCV.wait(lk, [&] { return !queue->inProgress; });
+
+    // Close the group so that later arrivals start the one after it.
+    queue->openGroup.reset();
+    queue->inProgress = true;
+    lk.unlock();
+
+    auto result = runGroup(&group->docs);
+
+    lk.lock();
+    group->result = result;
+    group->done = true;
+    group->doneCV.notify_all();
+
+    queue->inProgress = false;
+    if (queue->openGroup) {
+        queue->turnCV.notify_all();
+    } else {
+        // No leader is waiting on the queue, so there is no more use for it.
+        _queues.erase(nss);
+    }
+    return result;
+}
+
+}  // namespace mongo
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/optime.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/functional.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Groups concurrent single-document inserts into the same namespace, so that they are written in
+ * one storage transaction, with their oplog slots reserved together, instead of one each.
+ *
+ * For each namespace, at most one group is being inserted at a time. Inserts which arrive in the
+ * meantime join the next group, whose first member becomes its leader: once the group before it is
+ * done, the leader inserts every document of its group on behalf of the others, which wait for the
+ * outcome. An insert which finds no group in progress is thus written right away, without waiting
+ * to be grouped.
+ *
+ * This class is thread-safe.
+ */
+class InsertCoalescer {
+public:
+    /**
+     * Inserts all of the documents of a group in one storage transaction and returns the client
+     * opTime which the operations of the group must wait on, or an error if none of the documents
+     * were inserted.
+     */
+    using InsertGroupFn = unique_function<StatusWith<repl::OpTime>(std::vector<InsertStatement>*)>;
+
+    static InsertCoalescer& get(ServiceContext* serviceContext);
+
+    /**
+     * Inserts 'doc' into 'nss' as part of a group of at most 'maxGroupSize' documents. If the
+     * caller becomes the group's leader, 'insertGroup' is called on its thread with all of the
+     * group's documents; otherwise it is not called at all.
+     *
+     * Returns the opTime returned by the group's insert. If it returns an error, 'doc' was not
+     * inserted and the caller must insert it on its own, which also reports the error for the
+     * right document. Must not be called while holding any locks, since the caller may have to wait
+     * for other groups to be inserted.
+     */
+    StatusWith<repl::OpTime> insert(const NamespaceString& nss,
+                                    InsertStatement doc,
+                                    size_t maxGroupSize,
+                                    InsertGroupFn insertGroup);
+
+private:
+    struct Group {
+        std::vector<InsertStatement> docs;
+
+        // Set once the group's leader has inserted its documents, after which 'result' is final
+        bool done{false};
+        StatusWith<repl::OpTime> result{repl::OpTime()};
+
+        // Signaled when 'done' becomes true
+        stdx::condition_variable doneCV;
+    };
+
+    struct NamespaceQueue {
+        // The group which inserts arriving for the namespace join, if any
+        std::shared_ptr<Group> openGroup;
+
+        // Whether a group of the namespace is currently being inserted
+        bool inProgress{false};
+
+        // Signaled when the group in progress is done
+        stdx::condition_variable turnCV;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("InsertCoalescer::_mutex");
+    stdx::unordered_map<NamespaceString, std::unique_ptr<NamespaceQueue>> _queues;
+};
+
+}  // namespace mongo
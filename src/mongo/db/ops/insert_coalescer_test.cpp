@@ -0,0 +1,229 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+
+#include "mongo/db/ops/insert_coalescer.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+InsertStatement makeDoc(int id) {
+    return InsertStatement(BSON("_id" << id));
+}
+
+repl::OpTime opTimeForGroup(int group) {
+    return repl::OpTime(Timestamp(group, 0), 1);
+}
+
+/**
+ * Records the groups inserted through an InsertCoalescer, holding up the first one until released
+ * so that the inserts which arrive in the meantime have to be grouped.
+ */
+class GroupRecorder {
+public:
+    InsertCoalescer::InsertGroupFn makeInsertGroupFn(Status laterGroupsStatus = Status::OK()) {
+        return [this, laterGroupsStatus](std::vector<InsertStatement>* docs) {
+            int group;
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                group = ++_numGroups;
+                for (const auto& doc : *docs) {
+                    _groupOfDoc[doc.doc["_id"].numberInt()] = group;
+                }
+            }
+
+            if (group == 1) {
+                _firstGroupStarted.set();
+                _releaseFirstGroup.get();
+                return StatusWith<repl::OpTime>(opTimeForGroup(group));
+            }
+            if (!laterGroupsStatus.isOK()) {
+                return StatusWith<repl::OpTime>(laterGroupsStatus);
+            }
+            return StatusWith<repl::OpTime>(opTimeForGroup(group));
+        };
+    }
+
+    void waitForFirstGroup() {
+        _firstGroupStarted.get();
+    }
+
+    void releaseFirstGroup() {
+        _releaseFirstGroup.set();
+    }
+
+    int numGroups() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _numGroups;
+    }
+
+    int groupOfDoc(int id) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _groupOfDoc.at(id);
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("GroupRecorder::_mutex");
+    int _numGroups{0};
+    std::map<int, int> _groupOfDoc;
+
+    Notification<void> _firstGroupStarted;
+    Notification<void> _releaseFirstGroup;
+};
+
+TEST(InsertCoalescerTest, InsertWithoutContentionIsNotDelayed) {
+    InsertCoalescer coalescer;
+    std::vector<int> inserted;
+    auto result = coalescer.insert(kNss, makeDoc(1), 16, [&](std::vector<InsertStatement>* docs) {
+        for (const auto& doc : *docs) {
+            inserted.push_back(doc.doc["_id"].numberInt());
+        }
+        return StatusWith<repl::OpTime>(opTimeForGroup(1));
+    });
+
+    ASSERT_EQ(opTimeForGroup(1), unittest::assertGet(result));
+    ASSERT_EQ(1U, inserted.size());
+    ASSERT_EQ(1, inserted.front());
+}
+
+TEST(InsertCoalescerTest, InsertsArrivingDuringAGroupAreGroupedAfterIt) {
+    const int kNumLaterInserts = 8;
+
+    InsertCoalescer coalescer;
+    GroupRecorder recorder;
+
+    stdx::thread first([&] {
+        auto result = coalescer.insert(kNss, makeDoc(0), 16, recorder.makeInsertGroupFn());
+        ASSERT_EQ(opTimeForGroup(1), unittest::assertGet(result));
+    });
+    recorder.waitForFirstGroup();
+
+    std::vector<stdx::thread> later;
+    std::vector<StatusWith<repl::OpTime>> results(kNumLaterInserts, repl::OpTime());
+    for (int i = 1; i <= kNumLaterInserts; ++i) {
+        later.emplace_back([&, i] {
+            results[i - 1] = coalescer.insert(kNss, makeDoc(i), 16, recorder.makeInsertGroupFn());
+        });
+    }
+
+    recorder.releaseFirstGroup();
+    first.join();
+    for (auto& thread : later) {
+        thread.join();
+    }
+
+    // However the later inserts were grouped, none of them was inserted with the first one, and
+    // each waited for the group which inserted its document.
+    ASSERT_LTE(recorder.numGroups(), 1 + kNumLaterInserts);
+    for (int i = 1; i <= kNumLaterInserts; ++i) {
+        auto group = recorder.groupOfDoc(i);
+        ASSERT_GT(group, 1);
+        ASSERT_EQ(opTimeForGroup(group), unittest::assertGet(results[i - 1]));
+    }
+}
+
+TEST(InsertCoalescerTest, FailedGroupIsReportedToAllOfItsInserts) {
+    const int kNumLaterInserts = 4;
+    const Status kFailure(ErrorCodes::WriteConflict, "failed group");
+
+    InsertCoalescer coalescer;
+    GroupRecorder recorder;
+
+    stdx::thread first([&] {
+        auto result = coalescer.insert(kNss, makeDoc(0), 16, recorder.makeInsertGroupFn(kFailure));
+        ASSERT_OK(result.getStatus());
+    });
+    recorder.waitForFirstGroup();
+
+    std::vector<stdx::thread> later;
+    std::vector<StatusWith<repl::OpTime>> results(kNumLaterInserts, repl::OpTime());
+    for (int i = 1; i <= kNumLaterInserts; ++i) {
+        later.emplace_back([&, i] {
+            results[i - 1] =
+                coalescer.insert(kNss, makeDoc(i), 16, recorder.makeInsertGroupFn(kFailure));
+        });
+    }
+
+    recorder.releaseFirstGroup();
+    first.join();
+    for (auto& thread : later) {
+        thread.join();
+    }
+
+    for (const auto& result : results) {
+        ASSERT_EQ(kFailure, result.getStatus());
+    }
+}
+
+TEST(InsertCoalescerTest, InsertBypassesFullGroup) {
+    InsertCoalescer coalescer;
+    GroupRecorder recorder;
+
+    stdx::thread first([&] {
+        ASSERT_OK(coalescer.insert(kNss, makeDoc(0), 1, recorder.makeInsertGroupFn()).getStatus());
+    });
+    recorder.waitForFirstGroup();
+
+    // With groups of one document, of the two inserts arriving while the first group is held up,
+    // one waits for it as the leader of the next group and the other finds that group full and is
+    // inserted right away.
+    AtomicWord<bool> anyFinished{false};
+    Notification<void> oneFinished;
+    std::vector<stdx::thread> later;
+    for (int i = 1; i <= 2; ++i) {
+        later.emplace_back([&, i] {
+            ASSERT_OK(
+                coalescer.insert(kNss, makeDoc(i), 1, recorder.makeInsertGroupFn()).getStatus());
+            if (!anyFinished.swap(true)) {
+                oneFinished.set();
+            }
+        });
+    }
+
+    oneFinished.get();
+    recorder.releaseFirstGroup();
+    first.join();
+    for (auto& thread : later) {
+        thread.join();
+    }
+    ASSERT_EQ(3, recorder.numGroups());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -45,6 +45,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/curop_metrics.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/error_labels.h"
 #include "mongo/db/exec/delete.h"
 #include "mongo/db/exec/update_stage.h"
@@ -53,6 +54,7 @@
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/ops/delete_request_gen.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/ops/insert_coalescer.h"
 #include "mongo/db/ops/parsed_delete.h"
 #include "mongo/db/ops/parsed_update.h"
 #include "mongo/db/ops/update_request.h"
@@ -72,6 +74,9 @@
 #include "mongo/db/stats/server_write_concern_metrics.h"
 #include "mongo/db/stats/top.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
+#include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/update/path_support.h"
 #include "mongo/db/write_concern.h"
@@ -508,6 +513,252 @@ SingleWriteResult makeWriteResultForInsertOrDeleteRetry() {
 
 }  // namespace
 
+/**
+ * Returns the options of the time-series collection whose buckets are stored in 'bucketsNs'.
+ */
+static TimeseriesOptions getTimeseriesOptions(OperationContext* opCtx,
+                                              const NamespaceString& bucketsNs) {
+    AutoGetCollection bucketsColl(opCtx, bucketsNs, MODE_IS);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Time-series buckets collection " << bucketsNs << " was dropped",
+            bucketsColl.getCollection());
+    auto options = DurableCatalog::get(opCtx)->getCollectionOptions(
+        opCtx, bucketsColl.getCollection()->getCatalogId());
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << bucketsNs << " is not the buckets collection of a time-series "
+                          << "collection",
+            options.timeseries);
+    return *options.timeseries;
+}
+
+/**
+ * Replaces the closed bucket 'bucketId' with its compressed form. The bucket is left as is if it
+ * can't be compressed.
+ */
+static void compressClosedBucket(OperationContext* opCtx,
+                                 const NamespaceString& bucketsNs,
+                                 const OID& bucketId) {
+    try {
+        writeConflictRetry(opCtx, "compressBucket", bucketsNs.ns(), [&] {
+            AutoGetCollection bucketsColl(opCtx, bucketsNs, MODE_IX);
+            if (!bucketsColl.getCollection() ||
+                !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesFor(opCtx, bucketsNs)) {
+                return;
+            }
+            BSONObj bucket;
+            if (!Helpers::findById(
+                    opCtx, bucketsColl.getDb(), bucketsNs.ns(), BSON("_id" << bucketId), bucket)) {
+                return;
+            }
+            if (auto compressed = timeseries::compressBucket(bucket)) {
+                Helpers::update(opCtx, bucketsNs.ns(), BSON("_id" << bucketId), *compressed);
+            }
+        });
+    } catch (const DBException& ex) {
+        if (ErrorCodes::isInterruption(ex.code())) {
+            throw;
+        }
+        LOGV2_DEBUG(5190420,
+                    1,
+                    "Failed to compress a closed time-series bucket",
+                    "namespace"_attr = bucketsNs,
+                    "bucketId"_attr = bucketId,
+                    "error"_attr = ex.toStatus());
+    }
+}
+
+/**
+ * Inserts the measurements of 'wholeOp' into the buckets of the time-series collection it targets,
+ * which are stored in 'bucketsNs'. The measurements of the batch which go into the same bucket are
+ * written by a single upsert of the bucket. A measurement fails if the write of its bucket fails.
+ */
+static WriteResult performTimeseriesInserts(OperationContext* opCtx,
+                                            const write_ops::Insert& wholeOp,
+                                            const NamespaceString& bucketsNs) {
+    uassert(5190410,
+            "Cannot insert into a time-series collection in a transaction or as a retryable write",
+            !opCtx->getTxnNumber());
+    const auto options = getTimeseriesOptions(opCtx, bucketsNs);
+    auto& bucketCatalog = BucketCatalog::get(opCtx);
+
+    // Reserves a position in a bucket for each measurement, stopping at the first measurement which
+    // can't be inserted if the batch is ordered.
+    std::vector<StatusWith<BucketCatalog::Slot>> slots;
+    std::vector<BSONObj> measurements;
+    std::vector<OID> closedBucketIds;
+    for (auto&& doc : wholeOp.getDocuments()) {
+        try {
+            auto fixedDoc =
+                uassertStatusOK(fixDocumentForInsert(opCtx->getServiceContext(), doc));
+            auto measurement = fixedDoc.isEmpty() ? doc : std::move(fixedDoc);
+            slots.push_back(bucketCatalog.insert(bucketsNs, options, measurement));
+            measurements.push_back(std::move(measurement));
+        } catch (const DBException& ex) {
+            slots.push_back(ex.toStatus());
+            if (wholeOp.getOrdered()) {
+                break;
+            }
+        }
+    }
+
+    // Groups the measurements by bucket, in the order of the first measurement of each bucket.
+    std::map<OID, size_t> bucketIndexes;
+    std::vector<OID> bucketIds;
+    std::vector<std::vector<std::pair<int, BSONObj>>> bucketMeasurements;
+    std::vector<size_t> updateIndexes(slots.size());
+    for (size_t i = 0, measurement = 0; i < slots.size(); ++i) {
+        if (!slots[i].isOK()) {
+            continue;
+        }
+        const auto& slot = slots[i].getValue();
+        if (slot.closedBucketId) {
+            closedBucketIds.push_back(*slot.closedBucketId);
+        }
+        auto [it, inserted] = bucketIndexes.emplace(slot.bucketId, bucketIds.size());
+        if (inserted) {
+            bucketIds.push_back(slot.bucketId);
+            bucketMeasurements.emplace_back();
+        }
+        bucketMeasurements[it->second].emplace_back(slot.index, measurements[measurement++]);
+        updateIndexes[i] = it->second;
+    }
+
+    std::vector<write_ops::UpdateOpEntry> updates;
+    updates.reserve(bucketIds.size());
+    for (size_t i = 0; i < bucketIds.size(); ++i) {
+        write_ops::UpdateOpEntry update(
+            BSON("_id" << bucketIds[i]),
+            write_ops::UpdateModification::parseFromClassicUpdate(
+                BucketCatalog::makeBucketUpdate(options, bucketMeasurements[i])));
+        update.setUpsert(true);
+        updates.push_back(std::move(update));
+    }
+
+    WriteResult bucketsOut;
+    if (!updates.empty()) {
+        write_ops::Update updateOp(bucketsNs);
+        updateOp.setUpdates(std::move(updates));
+        updateOp.setWriteCommandBase([&] {
+            write_ops::WriteCommandBase wcb;
+            wcb.setOrdered(false);
+            wcb.setBypassDocumentValidation(
+                wholeOp.getWriteCommandBase().getBypassDocumentValidation());
+            return wcb;
+        }());
+        ON_BLOCK_EXIT([&] {
+            for (size_t i = 0; i < bucketIds.size(); ++i) {
+                if (bucketCatalog.finish(bucketIds[i], bucketMeasurements[i].size())) {
+                    closedBucketIds.push_back(bucketIds[i]);
+                }
+            }
+        });
+        bucketsOut = performUpdates(opCtx, updateOp);
+    }
+    for (auto&& bucketId : closedBucketIds) {
+        compressClosedBucket(opCtx, bucketsNs, bucketId);
+    }
+
+    WriteResult out;
+    out.results.reserve(slots.size());
+    auto& curOp = *CurOp::get(opCtx);
+    for (size_t i = 0; i < slots.size(); ++i) {
+        auto status = slots[i].getStatus();
+        if (status.isOK() && updateIndexes[i] < bucketsOut.results.size()) {
+            status = bucketsOut.results[updateIndexes[i]].getStatus();
+        }
+        if (status.isOK()) {
+            SingleWriteResult result;
+            result.setN(1);
+            result.setNModified(0);
+            out.results.emplace_back(std::move(result));
+            curOp.debug().additiveMetrics.incrementNinserted(1);
+            continue;
+        }
+
+        try {
+            uassertStatusOK(status);
+        } catch (const DBException& ex) {
+            if (!handleError(
+                    opCtx, ex, wholeOp.getNamespace(), wholeOp.getWriteCommandBase(), &out)) {
+                break;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * Inserts the single document of 'wholeOp' together with concurrent single-document inserts into
+ * the same collection, if insert coalescing is enabled and the insert is eligible for it. Returns
+ * boost::none if the document was not inserted, in which case the caller must insert it on its own.
+ */
+boost::optional<WriteResult> tryCoalescedInsert(OperationContext* opCtx,
+                                                const write_ops::Insert& wholeOp,
+                                                bool fromMigrate) {
+    const auto& nss = wholeOp.getNamespace();
+    const int maxGroupSize = internalInsertCoalescingMaxDocs.load();
+
+    // Only plain inserts are grouped, because the leader of a group inserts the documents of all of
+    // its members on their behalf: the statements of retryable writes and transactions have to be
+    // recorded against their own session, while versioned operations have to be checked against
+    // their own shard version. Inserts which already hold locks cannot wait for other groups.
+    if (maxGroupSize <= 1 || wholeOp.getDocuments().size() != 1 || fromMigrate ||
+        opCtx->getTxnNumber() || opCtx->getClient()->isInDirectClient() ||
+        opCtx->lockState()->isLocked() || nss.isSystem() || nss.isLocal() ||
+        wholeOp.getWriteCommandBase().getBypassDocumentValidation() ||
+        OperationShardingState::isOperationVersioned(opCtx)) {
+        return boost::none;
+    }
+
+    const auto& doc = wholeOp.getDocuments().front();
+    auto fixedDoc = fixDocumentForInsert(opCtx->getServiceContext(), doc);
+    if (!fixedDoc.isOK()) {
+        return boost::none;
+    }
+
+    InsertStatement toInsert(getStmtIdForWriteOp(opCtx, wholeOp, 0),
+                             fixedDoc.getValue().isEmpty() ? doc : fixedDoc.getValue());
+
+    auto insertGroup = [opCtx, &nss](std::vector<InsertStatement>* docs) {
+        if (MONGO_unlikely(failAllInserts.shouldFail())) {
+            uasserted(ErrorCodes::InternalError, "failAllInserts failpoint active!");
+        }
+
+        AutoGetCollection collection(opCtx, nss, MODE_IX);
+        uassert(ErrorCodes::NamespaceNotFound,
+                "Collection to coalesce inserts into does not exist",
+                collection.getCollection());
+        // See Collection::_insertDocuments for why capped inserts are done one at a time.
+        uassert(ErrorCodes::IllegalOperation,
+                "Cannot coalesce inserts into a capped collection",
+                !collection.getCollection()->isCapped());
+        assertCanWrite_inlock(opCtx, nss);
+
+        insertDocuments(opCtx, collection.getCollection(), docs->begin(), docs->end(), false);
+        return StatusWith<repl::OpTime>(
+            repl::ReplClientInfo::forClient(opCtx->getClient()).getLastOp());
+    };
+
+    auto opTime = InsertCoalescer::get(opCtx->getServiceContext())
+                      .insert(nss, std::move(toInsert), maxGroupSize, std::move(insertGroup));
+    if (!opTime.isOK()) {
+        return boost::none;
+    }
+
+    // Wait for the write concern of the whole group, which includes this insert.
+    repl::ReplClientInfo::forClient(opCtx->getClient()).setLastOp(opCtx, opTime.getValue());
+    globalOpCounters.gotInsert();
+    ServerWriteConcernMetrics::get(opCtx)->recordWriteConcernForInsert(opCtx->getWriteConcern());
+    CurOp::get(opCtx)->debug().additiveMetrics.incrementNinserted(1);
+
+    SingleWriteResult result;
+    result.setN(1);
+
+    WriteResult out;
+    out.results.emplace_back(std::move(result));
+    return out;
+}
+
 WriteResult performInserts(OperationContext* opCtx,
                            const write_ops::Insert& wholeOp,
                            bool fromMigrate) {
@@ -541,10 +792,23 @@ WriteResult performInserts(OperationContext* opCtx,
 
     uassertStatusOK(userAllowedWriteNS(wholeOp.getNamespace()));
 
+    // The measurements inserted into a time-series collection are stored in its buckets.
+    if (!wholeOp.getNamespace().isSystem()) {
+        const auto bucketsNs = wholeOp.getNamespace().makeTimeseriesBucketsNamespace();
+        if (CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, bucketsNs)) {
+            return performTimeseriesInserts(opCtx, wholeOp, bucketsNs);
+        }
+    }
+
     DisableDocumentValidationIfTrue docValidationDisabler(
         opCtx, wholeOp.getWriteCommandBase().getBypassDocumentValidation());
     LastOpFixer lastOpFixer(opCtx, wholeOp.getNamespace());
 
+    if (auto coalesced = tryCoalescedInsert(opCtx, wholeOp, fromMigrate)) {
+        lastOpFixer.finishedOpSuccessfully();
+        return std::move(*coalesced);
+    }
+
     WriteResult out;
     out.results.reserve(wholeOp.getDocuments().size());
 
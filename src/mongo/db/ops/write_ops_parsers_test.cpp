@@ -249,6 +249,27 @@ TEST(CommandWriteOpsParsers, RealMultiInsert) {
     }
 }
 
+TEST(CommandWriteOpsParsers, MultiInsertDocumentsAreViewsIntoTheMessage) {
+    const auto ns = NamespaceString("test", "foo");
+    const BSONObj obj0 = BSON("x" << 0);
+    const BSONObj obj1 = BSON("x" << 1);
+    auto cmd = BSON("insert" << ns.coll() << "documents" << BSON_ARRAY(obj0 << obj1));
+    for (bool seq : {false, true}) {
+        // Parse out of a serialized message, as the server does with the requests it receives.
+        const auto message = toOpMsg(ns.db(), cmd, seq).serialize();
+        const auto op = InsertOp::parse(OpMsgRequest::parseOwned(message));
+        ASSERT_EQ(op.getDocuments().size(), 2u);
+
+        const char* const messageBegin = message.buf();
+        const char* const messageEnd = messageBegin + message.size();
+        for (const auto& doc : op.getDocuments()) {
+            ASSERT(doc.isOwned());
+            ASSERT_GTE(doc.objdata(), messageBegin);
+            ASSERT_LTE(doc.objdata() + doc.objsize(), messageEnd);
+        }
+    }
+}
+
 TEST(CommandWriteOpsParsers, MultiInsertWithStmtId) {
     const auto ns = NamespaceString("test", "foo");
     const BSONObj obj0 = BSON("x" << 0);
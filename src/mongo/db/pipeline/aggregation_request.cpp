@@ -171,6 +171,13 @@ StatusWith<AggregationRequest> AggregationRequest::parseFromBSON(
                                       << typeName(elem.type())};
             }
             request.setAllowDiskUse(elem.Bool());
+        } else if (kReadOnceName == fieldName) {
+            if (elem.type() != BSONType::Bool) {
+                return {ErrorCodes::TypeMismatch,
+                        str::stream() << kReadOnceName << " must be a boolean, not a "
+                                      << typeName(elem.type())};
+            }
+            request.setReadOnce(elem.Bool());
         } else if (kExchangeName == fieldName) {
             try {
                 IDLParserErrorContext ctx("internalExchange");
@@ -330,6 +337,7 @@ Document AggregationRequest::serializeToCommandObj() const {
         {kNeedsMergeName, _needsMerge ? Value(true) : Value()},
         {bypassDocumentValidationCommandOption(),
          _bypassDocumentValidation ? Value(true) : Value()},
+        {kReadOnceName, _readOnce ? Value(true) : Value()},
         {kRequestResumeToken, _requestResumeToken ? Value(true) : Value()},
         // Only serialize a collation if one was specified.
         {kCollationName, _collation.isEmpty() ? Value() : Value(_collation)},
@@ -60,6 +60,7 @@ public:
     static constexpr StringData kCollationName = "collation"_sd;
     static constexpr StringData kExplainName = "explain"_sd;
     static constexpr StringData kAllowDiskUseName = "allowDiskUse"_sd;
+    static constexpr StringData kReadOnceName = "readOnce"_sd;
     static constexpr StringData kHintName = "hint"_sd;
     static constexpr StringData kExchangeName = "exchange"_sd;
     static constexpr StringData kRuntimeConstantsName = "runtimeConstants"_sd;
@@ -182,6 +183,14 @@ public:
         return _bypassDocumentValidation;
     }
 
+    /**
+     * Returns true if the storage-layer cursors of this aggregation should assume that the data
+     * they read will not be needed again, and need not be cached.
+     */
+    bool isReadOnce() const {
+        return _readOnce;
+    }
+
     bool getRequestResumeToken() const {
         return _requestResumeToken;
     }
@@ -277,6 +286,10 @@ public:
         _bypassDocumentValidation = shouldBypassDocumentValidation;
     }
 
+    void setReadOnce(bool readOnce) {
+        _readOnce = readOnce;
+    }
+
     void setRequestResumeToken(bool requestResumeToken) {
         _requestResumeToken = requestResumeToken;
     }
@@ -351,6 +364,7 @@ private:
     bool _fromMongos = false;
     bool _needsMerge = false;
     bool _bypassDocumentValidation = false;
+    bool _readOnce = false;
     bool _requestResumeToken = false;
 
     // A user-specified maxTimeMS limit, or a value of '0' if not specified.
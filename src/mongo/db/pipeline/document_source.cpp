@@ -42,6 +42,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/semantic_analysis.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -57,6 +58,11 @@ DocumentSource::DocumentSource(const StringData stageName,
     : pSource(nullptr), pExpCtx(pCtx), _commonStats(stageName.rawData()) {
     if (pExpCtx->shouldCollectDocumentSourceExecStats()) {
         _commonStats.executionTimeMillis.emplace(0);
+
+        _timingSampleRate = internalQueryExecStageTimingSampleRate.load();
+        if (_timingSampleRate) {
+            _commonStats.sampledExecutionTimeMicros.emplace(0);
+        }
     }
 }
 
@@ -259,13 +259,8 @@ public:
             return doGetNext();
         }
 
-        auto serviceCtx = pExpCtx->opCtx->getServiceContext();
-        invariant(serviceCtx);
-        auto fcs = serviceCtx->getFastClockSource();
-        invariant(fcs);
-
-        invariant(_commonStats.executionTimeMillis);
-        ScopedTimer timer(fcs, _commonStats.executionTimeMillis.get_ptr());
+        auto optTimer(getOptTimer());
+        auto optSampledTimer(getOptSampledTimer());
         ++_commonStats.works;
 
         GetNextResult next = doGetNext();
@@ -275,6 +270,39 @@ public:
         return next;
     }
 
+    /**
+     * Batch counterpart of getNext(). Appends up to 'maxDocs' results of this DocumentSource to
+     * 'batch', and returns the status which follows them: kAdvanced if there may be more results,
+     * in which case at least one result was appended, or else kEOF or kPauseExecution, which the
+     * caller must act on once it has processed the appended results.
+     *
+     * Stages which do the same amount of work for each of their inputs override doGetNextBatch(),
+     * so that a whole batch costs them one virtual call. Other stages return one result per call.
+     */
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxDocs) {
+        invariant(maxDocs > 0);
+        pExpCtx->checkForInterrupt();
+
+        if (MONGO_likely(!pExpCtx->shouldCollectDocumentSourceExecStats())) {
+            return doGetNextBatch(batch, maxDocs);
+        }
+
+        auto optTimer(getOptTimer());
+        auto optSampledTimer(getOptSampledTimer());
+
+        const size_t sizeBefore = batch->size();
+        auto status = doGetNextBatch(batch, maxDocs);
+
+        // Count the works and advances which getNext() would have counted for the same results.
+        const size_t numAdvanced = batch->size() - sizeBefore;
+        _commonStats.works += numAdvanced;
+        _commonStats.advanced += numAdvanced;
+        if (status != GetNextResult::ReturnStatus::kAdvanced) {
+            ++_commonStats.works;
+        }
+        return status;
+    }
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
@@ -523,6 +551,20 @@ protected:
      */
     virtual GetNextResult doGetNext() = 0;
 
+    /**
+     * The batch execution API of a DocumentSource. See comment at getNextBatch(). By default
+     * returns one result per call: a streaming stage may modify a document it has returned once the
+     * caller releases it, which holding on to a whole batch of them would prevent.
+     */
+    virtual GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                                       size_t maxDocs) {
+        auto next = doGetNext();
+        if (next.isAdvanced()) {
+            batch->push_back(next.releaseDocument());
+        }
+        return next.getStatus();
+    }
+
     /**
      * Attempt to perform an optimization with the following source in the pipeline. 'container'
      * refers to the entire pipeline, and 'itr' points to this stage within the pipeline.
@@ -558,8 +600,43 @@ protected:
     boost::intrusive_ptr<ExpressionContext> pExpCtx;
 
 private:
+    /**
+     * Returns the timer for the current call to getNext() or getNextBatch(), when every call is
+     * timed.
+     */
+    boost::optional<ScopedTimer> getOptTimer() {
+        invariant(_commonStats.executionTimeMillis);
+        if (_timingSampleRate) {
+            return boost::none;
+        }
+
+        auto fcs = pExpCtx->opCtx->getServiceContext()->getFastClockSource();
+        invariant(fcs);
+        return {{fcs, _commonStats.executionTimeMillis.get_ptr()}};
+    }
+
+    /**
+     * Returns the timer for the current call to getNext() or getNextBatch(), when only a sample
+     * of the calls is timed and the current call is part of it.
+     */
+    boost::optional<SampledScopedTimer> getOptSampledTimer() {
+        if (!_timingSampleRate || _numTimedCalls++ % _timingSampleRate != 0) {
+            return boost::none;
+        }
+
+        return {{pExpCtx->opCtx->getServiceContext()->getTickSource(),
+                 _timingSampleRate,
+                 _commonStats.sampledExecutionTimeMicros.get_ptr(),
+                 _commonStats.executionTimeMillis.get_ptr()}};
+    }
+
     CommonStats _commonStats;
 
+    // When non-zero, only one in this many calls to getNext() or getNextBatch() is timed, with the
+    // tick source. '_numTimedCalls' counts the calls eligible for timing.
+    long long _timingSampleRate = 0;
+    long long _numTimedCalls = 0;
+
     /**
      * Create a Value that represents the document source.
      *
@@ -66,21 +66,6 @@ boost::intrusive_ptr<Expression> parseGroupByExpression(
     }
 }
 
-/**
- * Generates a new file name on each call using a static, atomic and monotonically increasing
- * number.
- *
- * Each user of the Sorter must implement this function to ensure that all temporary files that the
- * Sorter instances produce are uniquely identified using a unique file name extension with separate
- * atomic variable. This is necessary because the sorter.cpp code is separately included in multiple
- * places, rather than compiled in one place and linked, and so cannot provide a globally unique ID.
- */
-std::string nextFileName() {
-    static AtomicWord<unsigned> documentSourceBucketAutoFileCounter;
-    return "extsort-doc-bucket." +
-        std::to_string(documentSourceBucketAutoFileCounter.fetchAndAdd(1));
-}
-
 }  // namespace
 
 const char* DocumentSourceBucketAuto::getSourceName() const {
@@ -136,26 +121,17 @@ DepsTracker::State DocumentSourceBucketAuto::getDependencies(DepsTracker* deps)
 }
 
 DocumentSource::GetNextResult DocumentSourceBucketAuto::populateSorter() {
-    if (!_sorter) {
-        SortOptions opts;
-        opts.maxMemoryUsageBytes = _maxMemoryUsageBytes;
-        if (pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
-            opts.extSortAllowed = true;
-            opts.tempDir = pExpCtx->tempDir;
-        }
-        const auto& valueCmp = pExpCtx->getValueComparator();
-        auto comparator = [valueCmp](const Sorter<Value, Document>::Data& lhs,
-                                     const Sorter<Value, Document>::Data& rhs) {
-            return valueCmp.compare(lhs.first, rhs.first);
-        };
-
-        _sorter.reset(Sorter<Value, Document>::make(opts, comparator));
+    if (!_sortExecutor) {
+        _sortExecutor.emplace(pExpCtx->getValueComparator(),
+                              _maxMemoryUsageBytes,
+                              pExpCtx->tempDir,
+                              pExpCtx->allowDiskUse && !pExpCtx->inMongos);
     }
 
     auto next = pSource->getNext();
     for (; next.isAdvanced(); next = pSource->getNext()) {
         auto nextDoc = next.releaseDocument();
-        _sorter->add(extractKey(nextDoc), nextDoc);
+        _sortExecutor->add(extractKey(nextDoc), nextDoc);
         ++_nDocuments;
     }
     return next;
@@ -206,10 +182,9 @@ void DocumentSourceBucketAuto::addDocumentToBucket(const pair<Value, Document>&
 }
 
 void DocumentSourceBucketAuto::initalizeBucketIteration() {
-    // Initialize the iterator on '_sorter'.
-    invariant(_sorter);
-    _sortedInput.reset(_sorter->done());
-    _sorter.reset();
+    // Switch '_sortExecutor' from loading the input to returning it in order.
+    invariant(_sortExecutor);
+    _sortExecutor->loadingDone();
 
     // If there are no buckets, then we don't need to populate anything.
     if (_nBuckets == 0) {
@@ -230,8 +205,9 @@ void DocumentSourceBucketAuto::initalizeBucketIteration() {
 boost::optional<pair<Value, Document>>
 DocumentSourceBucketAuto::adjustBoundariesAndGetMinForNextBucket(Bucket* currentBucket) {
     auto getNextValIfPresent = [this]() {
-        return _sortedInput->more() ? boost::optional<pair<Value, Document>>(_sortedInput->next())
-                                    : boost::none;
+        return _sortExecutor->hasNext()
+            ? boost::optional<pair<Value, Document>>(_sortExecutor->getNext())
+            : boost::none;
     };
 
     auto nextValue = getNextValIfPresent();
@@ -280,12 +256,13 @@ DocumentSourceBucketAuto::adjustBoundariesAndGetMinForNextBucket(Bucket* current
 boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::populateNextBucket() {
     // If there was a bucket before this, the 'currentMin' should be populated, or there are no more
     // documents.
-    if (!_currentBucketDetails.currentMin && !_sortedInput->more()) {
+    if (!_currentBucketDetails.currentMin && !_sortExecutor->hasNext()) {
         return {};
     }
 
-    std::pair<Value, Document> currentValue =
-        _currentBucketDetails.currentMin ? *_currentBucketDetails.currentMin : _sortedInput->next();
+    std::pair<Value, Document> currentValue = _currentBucketDetails.currentMin
+        ? *_currentBucketDetails.currentMin
+        : _sortExecutor->getNext();
 
     Bucket currentBucket(pExpCtx, currentValue.first, currentValue.first, _accumulatedFields);
 
@@ -313,9 +290,9 @@ boost::optional<DocumentSourceBucketAuto::Bucket> DocumentSourceBucketAuto::popu
     addDocumentToBucket(currentValue, currentBucket);
     const auto isLastBucket = (_currentBucketDetails.currentBucketNum == _nBuckets);
     for (long long i = 1;
-         _sortedInput->more() && (i < _currentBucketDetails.approxBucketSize || isLastBucket);
+         _sortExecutor->hasNext() && (i < _currentBucketDetails.approxBucketSize || isLastBucket);
          i++) {
-        addDocumentToBucket(_sortedInput->next(), currentBucket);
+        addDocumentToBucket(_sortExecutor->getNext(), currentBucket);
     }
 
     // Modify the bucket details for next bucket.
@@ -355,7 +332,7 @@ Document DocumentSourceBucketAuto::makeDocument(const Bucket& bucket) {
 }
 
 void DocumentSourceBucketAuto::doDispose() {
-    _sortedInput.reset();
+    _sortExecutor.reset();
 }
 
 Value DocumentSourceBucketAuto::serialize(
@@ -507,6 +484,3 @@ intrusive_ptr<DocumentSource> DocumentSourceBucketAuto::createFromBson(
 }
 
 }  // namespace mongo
-
-#include "mongo/db/sorter/sorter.cpp"
-// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
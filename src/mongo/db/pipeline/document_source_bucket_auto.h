@@ -29,12 +29,12 @@
 
 #pragma once
 
+#include "mongo/db/exec/sort_executor.h"
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/granularity_rounder.h"
-#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -158,8 +158,9 @@ private:
      */
     Document makeDocument(const Bucket& bucket);
 
-    std::unique_ptr<Sorter<Value, Document>> _sorter;
-    std::unique_ptr<Sorter<Value, Document>::Iterator> _sortedInput;
+    // Sorts the input by its 'groupBy' values, compared as whole values under the collation of the
+    // query, through the same executor as $sort.
+    boost::optional<SortExecutor<Document>> _sortExecutor;
 
     std::vector<AccumulationStatement> _accumulatedFields;
 
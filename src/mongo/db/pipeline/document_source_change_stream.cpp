@@ -34,6 +34,7 @@
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/bson_helper.h"
 #include "mongo/db/commands/feature_compatibility_version_documentation.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/pipeline/change_stream_constants.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_change_stream_close_cursor.h"
@@ -152,6 +153,18 @@ void DocumentSourceChangeStream::checkValueType(const Value v,
 //
 namespace {
 
+std::string regexEscape(StringData source) {
+    std::string result = "";
+    std::string escapes = "*+|()^?[]./\\$";
+    for (const char& c : source) {
+        if (escapes.find(c) != std::string::npos) {
+            result.append("\\");
+        }
+        result += c;
+    }
+    return result;
+}
+
 /**
  * Constructs a filter matching any 'applyOps' commands that commit a transaction. An 'applyOps'
  * command implicitly commits a transaction if _both_ of the following are true:
@@ -208,18 +221,6 @@ DocumentSourceChangeStream::ChangeStreamType DocumentSourceChangeStream::getChan
 }
 
 std::string DocumentSourceChangeStream::getNsRegexForChangeStream(const NamespaceString& nss) {
-    auto regexEscape = [](const std::string& source) {
-        std::string result = "";
-        std::string escapes = "*+|()^?[]./\\$";
-        for (const char& c : source) {
-            if (escapes.find(c) != std::string::npos) {
-                result.append("\\");
-            }
-            result += c;
-        }
-        return result;
-    };
-
     auto type = getChangeStreamType(nss);
     switch (type) {
         case ChangeStreamType::kSingleCollection:
@@ -330,6 +331,164 @@ BSONObj DocumentSourceChangeStream::buildMatchFilter(
                                      << BSON(OR(opMatch, commandAndApplyOpsMatch))));
 }
 
+//
+// Helpers for rewriting the user's $match into a filter on the oplog.
+//
+namespace {
+
+/**
+ * Returns the op type of the CRUD oplog entries which are transformed into change events of type
+ * 'operationType', or boost::none if such events are not generated from CRUD oplog entries.
+ */
+boost::optional<StringData> getCrudOpType(StringData operationType) {
+    if (operationType == DocumentSourceChangeStream::kInsertOpType) {
+        return "i"_sd;
+    }
+    if (operationType == DocumentSourceChangeStream::kUpdateOpType ||
+        operationType == DocumentSourceChangeStream::kReplaceOpType) {
+        return "u"_sd;
+    }
+    if (operationType == DocumentSourceChangeStream::kDeleteOpType) {
+        return "d"_sd;
+    }
+    return boost::none;
+}
+
+/**
+ * Returns a filter which passes every oplog entry that is not a CRUD operation, and passes CRUD
+ * operations only if they match 'crudFilter'.
+ */
+BSONObj applyToCrudOpsOnly(BSONObj crudFilter) {
+    return BSON("$or" << BSON_ARRAY(BSON("op" << BSON("$nin" << BSON_ARRAY("i"
+                                                                            << "u"
+                                                                            << "d")))
+                                    << crudFilter));
+}
+
+boost::optional<BSONObj> rewriteOperationTypePredicate(const MatchExpression* expr) {
+    std::vector<BSONElement> operationTypes;
+    if (expr->matchType() == MatchExpression::EQ) {
+        operationTypes.push_back(static_cast<const ComparisonMatchExpression*>(expr)->getData());
+    } else if (expr->matchType() == MatchExpression::MATCH_IN) {
+        auto inExpr = static_cast<const InMatchExpression*>(expr);
+        if (!inExpr->getRegexes().empty()) {
+            return boost::none;
+        }
+        operationTypes = inExpr->getEqualities();
+    } else {
+        return boost::none;
+    }
+
+    // The 'operationType' of an event is always a string, so any other value never matches.
+    std::set<StringData> excludedOpTypes{"i"_sd, "u"_sd, "d"_sd};
+    for (auto&& operationType : operationTypes) {
+        if (operationType.type() != BSONType::String) {
+            continue;
+        }
+        if (auto opType = getCrudOpType(operationType.valueStringData())) {
+            excludedOpTypes.erase(*opType);
+        }
+    }
+    if (excludedOpTypes.empty()) {
+        return boost::none;
+    }
+
+    BSONArrayBuilder excluded;
+    for (auto&& opType : excludedOpTypes) {
+        excluded.append(opType);
+    }
+    return BSON("op" << BSON("$nin" << excluded.arr()));
+}
+
+boost::optional<BSONObj> rewriteNamespacePredicate(const ComparisonMatchExpression* expr) {
+    const auto& rhs = expr->getData();
+    if (expr->path() == "ns.db"_sd && rhs.type() == BSONType::String) {
+        return applyToCrudOpsOnly(
+            BSON("ns" << BSONRegEx("^" + regexEscape(rhs.valueStringData()) + "\\.")));
+    }
+    if (expr->path() == "ns.coll"_sd && rhs.type() == BSONType::String) {
+        return applyToCrudOpsOnly(
+            BSON("ns" << BSONRegEx("^[^.]+\\." + regexEscape(rhs.valueStringData()) + "$")));
+    }
+    if (expr->path() == DocumentSourceChangeStream::kNamespaceField &&
+        rhs.type() == BSONType::Object) {
+        // The 'ns' field of an event is a document with exactly the fields 'db' and 'coll', in
+        // that order.
+        auto nsObj = rhs.embeddedObject();
+        auto db = nsObj["db"];
+        auto coll = nsObj["coll"];
+        if (nsObj.nFields() == 2 && nsObj.firstElementFieldNameStringData() == "db"_sd &&
+            db.type() == BSONType::String && coll.type() == BSONType::String) {
+            return applyToCrudOpsOnly(
+                BSON("ns" << (db.str() + "." + coll.str())));
+        }
+    }
+    return boost::none;
+}
+
+boost::optional<BSONObj> rewriteDocumentKeyPredicate(const ComparisonMatchExpression* expr) {
+    const auto& rhs = expr->getData();
+    if (rhs.type() == BSONType::RegEx) {
+        return boost::none;
+    }
+
+    // The document key of an insert or delete is taken from the 'o' field of the oplog entry, and
+    // that of an update or replacement from its 'o2' field.
+    BSONObjBuilder idEq;
+    idEq.appendAs(rhs, "$eq");
+    auto idMatch = idEq.obj();
+    return applyToCrudOpsOnly(
+        BSON("$or" << BSON_ARRAY(BSON("op" << BSON("$in" << BSON_ARRAY("i"
+                                                                       << "d"))
+                                           << "o._id" << idMatch)
+                                 << BSON("op"
+                                         << "u"
+                                         << "o2._id" << idMatch))));
+}
+
+boost::optional<BSONObj> rewritePredicate(const MatchExpression* expr) {
+    const auto path = expr->path();
+    if (path == DocumentSourceChangeStream::kOperationTypeField) {
+        return rewriteOperationTypePredicate(expr);
+    }
+    if (expr->matchType() != MatchExpression::EQ) {
+        return boost::none;
+    }
+    auto eqExpr = static_cast<const ComparisonMatchExpression*>(expr);
+    if (path == DocumentSourceChangeStream::kNamespaceField || path == "ns.db"_sd ||
+        path == "ns.coll"_sd) {
+        return rewriteNamespacePredicate(eqExpr);
+    }
+    if (path == "documentKey._id"_sd) {
+        return rewriteDocumentKeyPredicate(eqExpr);
+    }
+    return boost::none;
+}
+}  // namespace
+
+BSONObj DocumentSourceChangeStream::buildOplogFilterFromUserMatch(
+    const MatchExpression* userFilter) {
+    std::vector<const MatchExpression*> predicates;
+    if (userFilter->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < userFilter->numChildren(); ++i) {
+            predicates.push_back(userFilter->getChild(i));
+        }
+    } else {
+        predicates.push_back(userFilter);
+    }
+
+    // Each predicate of the conjunction must hold for an event to pass the user's filter, so it is
+    // safe to rewrite any subset of them and ignore the rest.
+    BSONArrayBuilder rewritten;
+    for (auto&& predicate : predicates) {
+        if (auto oplogPredicate = rewritePredicate(predicate)) {
+            rewritten.append(*oplogPredicate);
+        }
+    }
+    auto oplogPredicates = rewritten.arr();
+    return oplogPredicates.isEmpty() ? BSONObj() : BSON("$and" << oplogPredicates);
+}
+
 namespace {
 
 list<intrusive_ptr<DocumentSource>> buildPipeline(const intrusive_ptr<ExpressionContext>& expCtx,
@@ -174,6 +174,16 @@ public:
                                     Timestamp startFrom,
                                     bool showMigrationEvents);
 
+    /**
+     * Rewrites the predicates on 'operationType', 'ns' and 'documentKey._id' in the conjunction
+     * 'userFilter' into a filter on raw oplog entries. The produced filter only rejects CRUD oplog
+     * entries whose change events would also be rejected by 'userFilter', and never rejects
+     * commands or no-ops, so it can be joined with the oplog filter to avoid transforming entries
+     * which are irrelevant to the user. Returns an empty object if no predicate can be rewritten.
+     * Must only be used when 'userFilter' is evaluated with the simple collation.
+     */
+    static BSONObj buildOplogFilterFromUserMatch(const MatchExpression* userFilter);
+
     /**
      * Parses a $changeStream stage from 'elem' and produces the $match and transformation
      * stages required.
@@ -236,6 +246,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxDocs) final {
+        MONGO_UNREACHABLE;
+    }
+
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final;
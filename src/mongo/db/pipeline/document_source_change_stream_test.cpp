@@ -1619,6 +1619,97 @@ TEST_F(ChangeStreamStageTest, MatchFiltersNoOp) {
     checkTransformation(noOp, boost::none);
 }
 
+/**
+ * Builds and optimizes a pipeline made of the $changeStream described by 'spec' followed by a
+ * $match on 'userFilter', and returns the filter that the pipeline applies to the oplog.
+ */
+BSONObj getOptimizedOplogFilter(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                const BSONObj& spec,
+                                const BSONObj& userFilter) {
+    auto stages = DSChangeStream::createFromBson(spec.firstElement(), expCtx);
+    stages.push_back(DocumentSourceMatch::create(userFilter, expCtx));
+    auto pipeline = Pipeline::create(std::move(stages), expCtx);
+    pipeline->optimizePipeline();
+
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(pipeline->getSources().front().get());
+    ASSERT(oplogMatch);
+    return oplogMatch->getQuery();
+}
+
+TEST_F(ChangeStreamStageTest, UserMatchOnOperationTypeIsRewrittenIntoOplogFilter) {
+    auto oplogFilter = getOptimizedOplogFilter(
+        getExpCtx(), kDefaultSpec, fromjson("{operationType: {$in: ['insert', 'drop']}}"));
+    Matcher matcher(oplogFilter, getExpCtx());
+
+    auto insert = makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1));
+    ASSERT_TRUE(matcher.matches(insert.toBSON(), nullptr));
+
+    auto update = makeOplogEntry(OpTypeEnum::kUpdate,
+                                 nss,
+                                 BSON("$set" << BSON("y" << 1)),
+                                 testUuid(),
+                                 boost::none,  // fromMigrate
+                                 BSON("_id" << 1));
+    ASSERT_FALSE(matcher.matches(update.toBSON(), nullptr));
+
+    auto deleteEntry = makeOplogEntry(OpTypeEnum::kDelete, nss, BSON("_id" << 1));
+    ASSERT_FALSE(matcher.matches(deleteEntry.toBSON(), nullptr));
+
+    // Commands are never filtered out by the rewritten predicates.
+    OplogEntry dropColl = createCommand(BSON("drop" << nss.coll()), testUuid());
+    ASSERT_TRUE(matcher.matches(dropColl.toBSON(), nullptr));
+}
+
+TEST_F(ChangeStreamStageTest, UserMatchOnNamespaceAndDocumentKeyIsRewrittenIntoOplogFilter) {
+    auto oplogFilter = getOptimizedOplogFilter(
+        getExpCtx(),
+        kDefaultSpec,
+        BSON("ns" << BSON("db" << nss.db() << "coll" << nss.coll()) << "documentKey._id" << 1));
+    Matcher matcher(oplogFilter, getExpCtx());
+
+    ASSERT_TRUE(matcher.matches(
+        makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 1 << "x" << 1)).toBSON(), nullptr));
+    ASSERT_FALSE(matcher.matches(
+        makeOplogEntry(OpTypeEnum::kInsert, nss, BSON("_id" << 2 << "x" << 1)).toBSON(), nullptr));
+
+    auto makeUpdate = [&](int id) {
+        return makeOplogEntry(OpTypeEnum::kUpdate,
+                              nss,
+                              BSON("$set" << BSON("y" << 1)),
+                              testUuid(),
+                              boost::none,  // fromMigrate
+                              BSON("_id" << id));
+    };
+    ASSERT_TRUE(matcher.matches(makeUpdate(1).toBSON(), nullptr));
+    ASSERT_FALSE(matcher.matches(makeUpdate(2).toBSON(), nullptr));
+}
+
+TEST_F(ChangeStreamStageTest, UserMatchRewrittenIntoOplogFilterKeepsResumeTokenEntries) {
+    const auto uuid = testUuid();
+    std::shared_ptr<Collection> collection = std::make_shared<CollectionMock>(nss);
+    CollectionCatalog::get(getExpCtx()->opCtx).registerCollection(uuid, std::move(collection));
+
+    auto resumeToken = makeResumeToken(kDefaultTs, uuid, BSON("_id" << 1));
+    auto oplogFilter =
+        getOptimizedOplogFilter(getExpCtx(),
+                                BSON("$changeStream" << BSON("resumeAfter" << resumeToken)),
+                                fromjson("{operationType: 'insert'}"));
+    Matcher matcher(oplogFilter, getExpCtx());
+
+    // The delete at the resume point must reach the resume stage, but later deletes are filtered.
+    auto deleteAtResumePoint = makeOplogEntry(OpTypeEnum::kDelete, nss, BSON("_id" << 1));
+    ASSERT_TRUE(matcher.matches(deleteAtResumePoint.toBSON(), nullptr));
+
+    auto laterDelete = makeOplogEntry(OpTypeEnum::kDelete,
+                                      nss,
+                                      BSON("_id" << 1),
+                                      uuid,
+                                      boost::none,  // fromMigrate
+                                      boost::none,  // o2
+                                      repl::OpTime(Timestamp(kDefaultTs.getSecs() + 1, 1), 1));
+    ASSERT_FALSE(matcher.matches(laterDelete.toBSON(), nullptr));
+}
+
 TEST_F(ChangeStreamStageTest, TransformationShouldBeAbleToReParseSerializedStage) {
     auto expCtx = getExpCtx();
 
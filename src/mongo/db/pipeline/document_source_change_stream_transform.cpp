@@ -141,6 +141,55 @@ StageConstraints DocumentSourceChangeStreamTransform::constraints(
     return constraints;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceChangeStreamTransform::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // The oplog filter always uses the simple collation, so the user's predicates can only be
+    // rewritten if they use it too.
+    if (_pushedDownUserFilter || itr == container->begin() || pExpCtx->getCollator()) {
+        return std::next(itr);
+    }
+    auto oplogMatch = dynamic_cast<DocumentSourceOplogMatch*>(std::prev(itr)->get());
+    if (!oplogMatch) {
+        return std::next(itr);
+    }
+
+    // Look past the other stages generated by the $changeStream for the first stage added by the
+    // user. None of them filter events on, or modify, the fields that can be rewritten.
+    boost::optional<Timestamp> resumeTs;
+    auto userStage = std::next(itr);
+    for (; userStage != container->end(); ++userStage) {
+        if (auto resumeStage = dynamic_cast<DocumentSourceCheckResumability*>(userStage->get())) {
+            resumeTs = resumeStage->getTokenFromClient().clusterTime;
+        }
+        if (!(*userStage)->constraints(Pipeline::SplitState::kUnsplit).isChangeStreamStage()) {
+            break;
+        }
+    }
+    auto userMatch = userStage == container->end()
+        ? nullptr
+        : dynamic_cast<DocumentSourceMatch*>(userStage->get());
+    if (!userMatch) {
+        return std::next(itr);
+    }
+
+    auto oplogFilter =
+        DocumentSourceChangeStream::buildOplogFilterFromUserMatch(userMatch->getMatchExpression());
+    if (oplogFilter.isEmpty()) {
+        return std::next(itr);
+    }
+
+    // The resume stages must see the entries at the resume point, whether or not they produce
+    // events which pass the user's filter.
+    if (resumeTs) {
+        oplogFilter = BSON("$or" << BSON_ARRAY(BSON("ts" << *resumeTs) << oplogFilter));
+    }
+    oplogMatch->joinMatchWith(DocumentSourceMatch::create(oplogFilter, pExpCtx));
+    _pushedDownUserFilter = true;
+    return std::next(itr);
+}
+
 ResumeTokenData DocumentSourceChangeStreamTransform::getResumeToken(Value ts,
                                                                     Value uuid,
                                                                     Value documentKey) {
@@ -63,6 +63,14 @@ public:
         return DocumentSourceChangeStream::kStageName.rawData();
     }
 
+    /**
+     * Rewrites the predicates of the user's $match that the change stream stages leave untouched
+     * into a filter on the oplog, and joins it with the preceding DocumentSourceOplogMatch. This
+     * keeps oplog entries which could never produce a matching event from being transformed.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
 protected:
     DocumentSource::GetNextResult doGetNext() override;
 
@@ -219,6 +227,10 @@ private:
     // Set to true if the pre-image optime should be included in output documents.
     bool _includePreImageOptime = false;
 
+    // Set to true once the user's $match has been rewritten into the oplog filter, so that the
+    // rewrite is applied only once if the pipeline is optimized again.
+    bool _pushedDownUserFilter = false;
+
     // '_fcv' is used to determine which version of the resume token to generate for each change.
     // This is a snapshot of what the feature compatibility version was at the time the stream was
     // opened or resumed.
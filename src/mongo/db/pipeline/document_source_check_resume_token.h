@@ -97,6 +97,10 @@ public:
     static boost::intrusive_ptr<DocumentSourceCheckResumability> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx, ResumeTokenData token);
 
+    const ResumeTokenData& getTokenFromClient() const {
+        return _tokenFromClient;
+    }
+
 protected:
     /**
      * Use the create static method to create a DocumentSourceCheckResumability.
@@ -120,6 +120,28 @@ DocumentSource::GetNextResult DocumentSourceCursor::doGetNext() {
     return _currentBatch.dequeue();
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceCursor::doGetNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    // The latest oplog timestamp has to be observed by the consumer after each document.
+    if (_trackOplogTS) {
+        return DocumentSource::doGetNextBatch(batch, maxDocs);
+    }
+
+    if (_currentBatch.isEmpty()) {
+        loadBatch();
+    }
+    if (_currentBatch.isEmpty()) {
+        return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    // Only hand out what has already been read from '_exec', so that the locks are not taken again
+    // to fill a single batch.
+    for (size_t i = 0; i < maxDocs && !_currentBatch.isEmpty(); ++i) {
+        batch->push_back(_currentBatch.dequeue());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSourceCursor::loadBatch() {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
@@ -119,6 +119,8 @@ protected:
                          bool trackOplogTimestamp = false);
 
     GetNextResult doGetNext() final;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxDocs) final;
 
     ~DocumentSourceCursor();
 
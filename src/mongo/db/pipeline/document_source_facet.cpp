@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -38,6 +39,7 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
@@ -45,7 +47,13 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -66,11 +74,31 @@ DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelin
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
         facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer));
+            DocumentSourceTeeConsumer::create(facet.pipeline->getContext(), facetId, _teeBuffer));
     }
 }
 
 namespace {
+/**
+ * Returns the process-wide pool on which the facets of $facet stages consume their batches of
+ * input concurrently. It is separate from the sorter's pool, since the sorts run by a facet may
+ * wait on that pool.
+ */
+ThreadPool& getFacetThreadPool() {
+    // Intentionally leaked so that the pool's threads never race with static destruction.
+    static auto pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "FacetThreadPool";
+        options.minThreads = 0;
+        options.maxThreads = std::max(1UL, ProcessInfo::getNumAvailableCores());
+
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return *pool;
+}
+
 /**
  * Extracts the names of the facets and the vectors of raw BSONObjs representing the stages within
  * that facet's pipeline.
@@ -151,26 +179,99 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     }
 
     const size_t maxBytes = _maxOutputDocSizeBytes;
-    auto ensureUnderMemoryLimit = [usedBytes = 0ul, &maxBytes](long long additional) mutable {
-        usedBytes += additional;
+    AtomicWord<size_t> usedBytes{0};
+    auto ensureUnderMemoryLimit = [&usedBytes, &maxBytes](size_t additional) {
+        const size_t total = usedBytes.addAndFetch(additional);
         uassert(4031700,
-                str::stream() << "document constructed by $facet is " << usedBytes
+                str::stream() << "document constructed by $facet is " << total
                               << " bytes, which exceeds the limit of " << maxBytes << " bytes",
-                usedBytes <= maxBytes);
+                total <= maxBytes);
     };
 
+    // Returns true if the facet has returned all of its results, and false if it has consumed the
+    // current batch of input and is waiting for the next one.
     vector<vector<Value>> results(_facets.size());
-    bool allPipelinesEOF = false;
-    while (!allPipelinesEOF) {
-        allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
-        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
-            const auto& pipeline = _facets[facetId].pipeline;
-            auto next = pipeline->getSources().back()->getNext();
-            for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
-                results[facetId].emplace_back(next.releaseDocument());
+    auto drainFacet = [&](size_t facetId) {
+        const auto& pipeline = _facets[facetId].pipeline;
+        auto next = pipeline->getSources().back()->getNext();
+        for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+            ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
+            results[facetId].emplace_back(next.releaseDocument());
+        }
+        return next.isEOF();
+    };
+
+    const size_t parallelism = getParallelism();
+    if (parallelism == 1) {
+        bool allPipelinesEOF = false;
+        while (!allPipelinesEOF) {
+            allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
+            for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+                allPipelinesEOF = drainFacet(facetId) && allPipelinesEOF;
+            }
+        }
+    } else {
+        // The input is still read on this thread, one batch at a time. Each batch is then consumed
+        // by the facets concurrently, with facet 'i' running on thread 'i % parallelism'. This
+        // thread runs the facets of thread 0, and the others run on the pool under operation
+        // contexts of their own, since an OperationContext must only be used by one thread.
+        OperationContext* const opCtx = pExpCtx->opCtx;
+        std::vector<char> facetEOF(_facets.size(), false);
+        auto drainFacets = [&](size_t thread) {
+            for (size_t facetId = thread; facetId < _facets.size(); facetId += parallelism) {
+                if (!facetEOF[facetId]) {
+                    facetEOF[facetId] = drainFacet(facetId);
+                }
+            }
+        };
+        auto reattachFacets = [&](size_t thread, OperationContext* facetOpCtx) {
+            for (size_t facetId = thread; facetId < _facets.size(); facetId += parallelism) {
+                _facets[facetId].pipeline->reattachToOperationContext(facetOpCtx);
+            }
+        };
+
+        while (std::find(facetEOF.begin(), facetEOF.end(), false) != facetEOF.end()) {
+            _teeBuffer->startConcurrentBatch();
+            ON_BLOCK_EXIT([&] { _teeBuffer->endConcurrentBatch(); });
+
+            std::vector<Future<void>> threads;
+            threads.reserve(parallelism - 1);
+            for (size_t thread = 1; thread < parallelism; ++thread) {
+                auto pf = makePromiseFuture<void>();
+                getFacetThreadPool().schedule(
+                    [&, thread, promise = std::move(pf.promise)](Status status) mutable {
+                        if (!status.isOK()) {
+                            promise.setError(std::move(status));
+                            return;
+                        }
+                        promise.setWith([&] {
+                            auto client = opCtx->getServiceContext()->makeClient("FacetWorker");
+                            AlternativeClientRegion clientRegion(client);
+                            auto facetOpCtx = cc().makeOperationContext();
+                            reattachFacets(thread, facetOpCtx.get());
+                            ON_BLOCK_EXIT([&] { reattachFacets(thread, opCtx); });
+                            drainFacets(thread);
+                        });
+                    });
+                threads.push_back(std::move(pf.future));
+            }
+
+            // The facets running on the pool reference the state of this function, so every one
+            // of them must have finished before an error from any of them, or from this thread, is
+            // allowed to escape.
+            Status status = Status::OK();
+            try {
+                drainFacets(0);
+            } catch (const DBException& ex) {
+                status = ex.toStatus();
+            }
+            for (auto& thread : threads) {
+                auto threadStatus = thread.getNoThrow();
+                if (status.isOK()) {
+                    status = std::move(threadStatus);
+                }
             }
-            allPipelinesEOF = allPipelinesEOF && next.isEOF();
+            uassertStatusOK(status);
         }
     }
 
@@ -183,6 +284,33 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     return resultDoc.freeze();
 }
 
+size_t DocumentSourceFacet::getParallelism() const {
+    const size_t maxParallelism = internalQueryFacetParallelism.load();
+    if (maxParallelism <= 1 || _facets.size() <= 1) {
+        return 1;
+    }
+
+    // The other threads run the facets under operation contexts which hold no locks, so a facet
+    // must not read from a collection, either through a stage or through the stored procedures
+    // loaded for $where.
+    stdx::unordered_set<const ExpressionContext*> expCtxs{pExpCtx.get()};
+    for (auto&& facet : _facets) {
+        const auto& facetExpCtx = facet.pipeline->getContext();
+        if (!expCtxs.insert(facetExpCtx.get()).second || facetExpCtx->hasWhereClause) {
+            return 1;
+        }
+
+        stdx::unordered_set<NamespaceString> involvedNamespaces;
+        for (auto&& source : facet.pipeline->getSources()) {
+            source->addInvolvedCollections(&involvedNamespaces);
+        }
+        if (!involvedNamespaces.empty()) {
+            return 1;
+        }
+    }
+    return std::min(maxParallelism, _facets.size());
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -308,7 +436,17 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        // Facets which may consume their input concurrently each need an ExpressionContext of their
+        // own, since its variables and interrupt counter aren't safe to share between threads.
+        auto facetExpCtx = expCtx;
+        if (internalQueryFacetParallelism.load() > 1 && expCtx->subPipelineDepth == 0) {
+            facetExpCtx = expCtx->copyWith(expCtx->ns, expCtx->uuid);
+            facetExpCtx->inMultiDocumentTransaction = expCtx->inMultiDocumentTransaction;
+            facetExpCtx->hasWhereClause = expCtx->hasWhereClause;
+            facetExpCtx->isParsingViewDefinition = expCtx->isParsingViewDefinition;
+        }
+
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
@@ -157,6 +157,13 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns the number of threads on which the facets can consume each batch of input, which is
+     * one unless every facet has an ExpressionContext of its own and doesn't read from any
+     * collection.
+     */
+    size_t getParallelism() const;
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -44,8 +44,10 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 using std::deque;
@@ -455,6 +457,77 @@ TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSub
     ASSERT_DOCUMENT_EQ(output.getDocument(), Document(fromjson("{subPipe: [{_id: 0}, {_id: 1}]}")));
 }
 
+/**
+ * Parses 'spec' with 'internalQueryFacetParallelism' set to 'parallelism', and runs the $facet over
+ * 100 documents which are buffered a few at a time.
+ */
+Document runParsedFacet(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                        const BSONObj& spec,
+                        int parallelism) {
+    const auto oldParallelism = internalQueryFacetParallelism.load();
+    const auto oldBufferSize = internalQueryFacetBufferSizeBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryFacetParallelism.store(oldParallelism);
+        internalQueryFacetBufferSizeBytes.store(oldBufferSize);
+    });
+    internalQueryFacetParallelism.store(parallelism);
+    internalQueryFacetBufferSizeBytes.store(500);
+
+    deque<DocumentSource::GetNextResult> inputs;
+    for (int i = 0; i < 100; ++i) {
+        inputs.emplace_back(Document{{"_id", i}, {"a", i % 7}});
+    }
+    auto mock = DocumentSourceMock::createForTest(inputs, expCtx);
+
+    auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), expCtx);
+    facetStage->setSource(mock.get());
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT(facetStage->getNext().isEOF());
+    return output.releaseDocument();
+}
+
+TEST_F(DocumentSourceFacetTest, ShouldProduceTheSameResultsWhenFacetsRunConcurrently) {
+    auto spec = fromjson(
+        "{$facet: {"
+        "  all: [{$skip: 0}],"
+        "  limited: [{$limit: 3}],"
+        "  grouped: [{$group: {_id: '$a', n: {$sum: 1}}}, {$sort: {_id: 1}}],"
+        "  filtered: [{$match: {a: 3}}, {$project: {_id: 1}}],"
+        "  counted: [{$count: 'n'}]"
+        "}}");
+
+    auto sequential = runParsedFacet(getExpCtx(), spec, 1);
+    ASSERT_EQ(sequential["all"].getArrayLength(), 100UL);
+    ASSERT_EQ(sequential["limited"].getArrayLength(), 3UL);
+    ASSERT_EQ(sequential["grouped"].getArrayLength(), 7UL);
+    ASSERT_VALUE_EQ(sequential["counted"], Value(vector<Value>{Value(Document{{"n", 100}})}));
+
+    ASSERT_DOCUMENT_EQ(runParsedFacet(getExpCtx(), spec, 4), sequential);
+    ASSERT_DOCUMENT_EQ(runParsedFacet(getExpCtx(), spec, 2), sequential);
+}
+
+TEST_F(DocumentSourceFacetTest, ShouldGiveEachFacetItsOwnContextOnlyWhenFacetsMayRunConcurrently) {
+    auto ctx = getExpCtx();
+    auto spec = fromjson("{$facet: {a: [{$skip: 1}], b: [{$limit: 1}]}}");
+
+    const auto oldParallelism = internalQueryFacetParallelism.load();
+    ON_BLOCK_EXIT([&] { internalQueryFacetParallelism.store(oldParallelism); });
+
+    internalQueryFacetParallelism.store(1);
+    auto facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+    for (auto&& facet : static_cast<DocumentSourceFacet*>(facetStage.get())->getFacetPipelines()) {
+        ASSERT(facet.pipeline->getContext() == ctx);
+    }
+
+    internalQueryFacetParallelism.store(4);
+    facetStage = DocumentSourceFacet::createFromBson(spec.firstElement(), ctx);
+    const auto& facets = static_cast<DocumentSourceFacet*>(facetStage.get())->getFacetPipelines();
+    ASSERT(facets[0].pipeline->getContext() != ctx);
+    ASSERT(facets[1].pipeline->getContext() != ctx);
+    ASSERT(facets[0].pipeline->getContext() != facets[1].pipeline->getContext());
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldPropagateDisposeThroughToSource) {
     auto ctx = getExpCtx();
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
@@ -51,6 +53,16 @@ namespace {
 bool foreignShardedLookupAllowed() {
     return getTestCommandsEnabled() && internalQueryAllowShardedLookup.load();
 }
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the comment on nextFileName() in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookUpFileCounter;
+    return "extsort-doc-graph-lookup." +
+        std::to_string(documentSourceGraphLookUpFileCounter.fetchAndAdd(1));
+}
 }  // namespace
 
 using boost::intrusive_ptr;
@@ -106,11 +118,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (!visitedEmpty()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popVisited()));
     }
 
     MutableDocument output(*_input);
@@ -118,7 +128,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
 
     _visitedUsageBytes = 0;
 
-    invariant(_visited.empty());
+    invariant(visitedEmpty());
 
     return output.freeze();
 }
@@ -129,7 +139,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (visitedEmpty()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -145,7 +155,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (visitedEmpty()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -159,13 +169,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popVisited()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -176,6 +184,60 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    removeSpilledVisited();
+}
+
+Document DocumentSourceGraphLookUp::popVisited() {
+    invariant(!visitedEmpty());
+
+    if (!_visited.empty()) {
+        auto it = _visited.begin();
+        auto result = std::move(it->second);
+        _visited.erase(it);
+        return result;
+    }
+
+    // Only spilled documents are left. Each of them has an '_id' in '_spilledVisitedIds', so there
+    // is one in one of the spill files.
+    while (!_spilledVisited.back()->more()) {
+        _spilledVisited.back()->closeSource();
+        _spilledVisited.pop_back();
+    }
+    auto [id, result] = _spilledVisited.back()->next();
+    _spilledVisitedIds.erase(id);
+    return result;
+}
+
+void DocumentSourceGraphLookUp::spillVisited() {
+    if (_visited.empty()) {
+        return;
+    }
+    _usedDisk = true;
+
+    // The documents are read back in any order, so they are not sorted.
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _spillFileName, _nextSpillFileOffset);
+    for (auto&& [id, result] : _visited) {
+        writer.addAlreadySorted(id, result);
+        _spilledVisitedIdsUsageBytes += id.getApproximateSize();
+        _spilledVisitedIds.insert(id);
+    }
+    _visited.clear();
+    _visitedUsageBytes = _spilledVisitedIdsUsageBytes;
+
+    _spilledVisited.emplace_back(writer.done());
+    _spilledVisited.back()->openSource();
+    _nextSpillFileOffset = writer.getFileEndOffset();
+}
+
+void DocumentSourceGraphLookUp::removeSpilledVisited() {
+    _spilledVisited.clear();
+    _spilledVisitedIds.clear();
+    _spilledVisitedIdsUsageBytes = 0;
+    if (_nextSpillFileOffset != 0) {
+        boost::filesystem::remove(_spillFileName);
+        _nextSpillFileOffset = 0;
+    }
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -191,7 +253,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -206,12 +268,12 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
-            // Query for all keys that were in the frontier and not in the cache, populating
-            // '_frontier' for the next iteration of search.
+        for (auto&& matchStage : matchStages) {
+            // Query for a batch of the keys that were in the frontier and not in the cache,
+            // populating '_frontier' for the next iteration of search.
 
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = matchStage;
             MakePipelineOptions pipelineOpts;
             pipelineOpts.optimize = true;
             pipelineOpts.attachCursorSource = true;
@@ -244,7 +306,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() ||
+        _spilledVisitedIds.find(id) != _spilledVisitedIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -291,7 +354,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -309,41 +372,49 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
+    // Create queries of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
     //
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+    // We wrap the queries in a $match so that they can be parsed into a DocumentSourceMatch when
     // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    {
-        BSONObjBuilder query(match.subobjStart("$match"));
+    const size_t maxBatchSize = internalDocumentSourceGraphLookupMaxFrontierBatchSize.load();
+    std::vector<BSONObj> matches;
+    for (auto frontierIt = _frontier.begin(); frontierIt != _frontier.end();) {
+        BSONObjBuilder match;
         {
-            BSONArrayBuilder andObj(query.subarrayStart("$and"));
-            if (_additionalFilter) {
-                andObj << *_additionalFilter;
-            }
-
+            BSONObjBuilder query(match.subobjStart("$match"));
             {
-                BSONObjBuilder connectToObj(andObj.subobjStart());
+                BSONArrayBuilder andObj(query.subarrayStart("$and"));
+                if (_additionalFilter) {
+                    andObj << *_additionalFilter;
+                }
+
                 {
-                    BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                    BSONObjBuilder connectToObj(andObj.subobjStart());
                     {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                        {
+                            BSONArrayBuilder in(subObj.subarrayStart("$in"));
+                            for (size_t i = 0; i < maxBatchSize && frontierIt != _frontier.end();
+                                 ++i, ++frontierIt) {
+                                in << *frontierIt;
+                            }
                         }
                     }
                 }
             }
         }
+        matches.push_back(match.obj());
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return matches;
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
 
+    removeSpilledVisited();
+
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
     // If _startWith evaluates to an array, treat each value as a separate starting point.
@@ -403,7 +474,11 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    // With allowDiskUse, only the '_id's of the documents found and the frontier have to fit.
+    if ((_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes &&
+        !_spillFileName.empty()) {
+        spillVisited();
+    }
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
@@ -477,8 +552,10 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledVisitedIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -491,6 +568,14 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline = resolvedNamespace.pipeline;
     _fromPipeline.reserve(_fromPipeline.size() + 1);
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
+
+    if (!pExpCtx->inMongos && pExpCtx->allowDiskUse) {
+        _spillFileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+}
+
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    DESTRUCTOR_GUARD(removeSpilledVisited());
 }
 
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
@@ -626,3 +711,5 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -95,7 +96,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -136,6 +137,12 @@ public:
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
 
+    ~DocumentSourceGraphLookUp();
+
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
 protected:
     GetNextResult doGetNext() final;
     void doDispose() final;
@@ -165,15 +172,15 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection wrapped in a $match by using the
+     * contents of '_frontier', each for at most
+     * 'internalDocumentSourceGraphLookupMaxFrontierBatchSize' of its values.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns no queries if none is necessary, i.e., all values were retrieved from the cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -213,6 +220,31 @@ private:
      */
     bool addToVisitedAndFrontier(Document result, long long depth);
 
+    /**
+     * Returns whether all of the documents found for the current input, in memory or spilled, were
+     * returned by popVisited().
+     */
+    bool visitedEmpty() const {
+        return _visited.empty() && _spilledVisitedIds.empty();
+    }
+
+    /**
+     * Removes one of the documents found for the current input and returns it, reading it back
+     * from disk once those in memory are exhausted.
+     */
+    Document popVisited();
+
+    /**
+     * Writes the documents of '_visited' to disk, and only keeps their '_id's in memory, so that
+     * the following results are still de-duplicated.
+     */
+    void spillVisited();
+
+    /**
+     * Forgets the documents spilled for the previous input and removes the spill file.
+     */
+    void removeSpilledVisited();
+
     // $graphLookup options.
     NamespaceString _from;
     FieldPath _as;
@@ -230,7 +262,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -244,6 +276,15 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // The documents of '_visited' which were spilled to disk, if allowDiskUse was specified, and
+    // their '_id's. The spill files of an input are removed when the next input is searched.
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset = 0;
+    std::vector<std::unique_ptr<SortIteratorInterface<Value, Document>>> _spilledVisited;
+    ValueUnorderedSet _spilledVisitedIds;
+    size_t _spilledVisitedIdsUsageBytes = 0;
+    bool _usedDisk = false;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
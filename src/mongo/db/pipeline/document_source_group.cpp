@@ -41,6 +41,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/util/destructor_guard.h"
 
 namespace mongo {
@@ -164,12 +165,32 @@ int DocumentSourceGroup::freeMemory() {
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::doGetNext() {
+    if (!_flushedGroups.empty()) {
+        auto out = std::move(_flushedGroups.front());
+        _flushedGroups.pop_front();
+        return out;
+    }
+
+    if (!_commonSubexpressionsEliminated) {
+        std::vector<boost::intrusive_ptr<Expression>*> expressions;
+        for (auto&& idExpression : _idExpressions) {
+            expressions.push_back(&idExpression);
+        }
+        for (auto&& accumulatedField : _accumulatedFields) {
+            expressions.push_back(&accumulatedField.expr.argument);
+        }
+        _commonSubexpressions = ExpressionCommonSubexpression::eliminate(expressions);
+        _commonSubexpressionsEliminated = true;
+    }
+
     if (!_initialized) {
-        const auto initializationResult = initialize();
-        if (initializationResult.isPaused()) {
+        // A streaming $group outputs the groups which it completes while consuming its input, and
+        // only gets initialized once the input is exhausted.
+        const auto initializationResult = _streaming ? getNextStreaming() : initialize();
+        if (!initializationResult.isEOF()) {
+            invariant(_streaming || _canFlushPartialGroups || initializationResult.isPaused());
             return initializationResult;
         }
-        invariant(initializationResult.isEOF());
     }
 
     for (auto&& accum : _currentAccumulators) {
@@ -233,7 +254,8 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     if (_groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    Document out = makeDocument(
+        groupKeyToId(groupsIterator->first), groupsIterator->second, pExpCtx->needsMerge);
 
     if (++groupsIterator == _groups->end())
         dispose();
@@ -243,8 +265,13 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
 
 void DocumentSourceGroup::doDispose() {
     // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    _groups = GroupsMap();
     _sorterIterator.reset();
+    _streamingId = Value();
+    _streamingAccumulators.clear();
+    _flushedGroups.clear();
+    _inputBatch.clear();
+    _inputBatchPos = 0;
 
     // Make us look done.
     groupsIterator = _groups->end();
@@ -374,11 +401,13 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
     : DocumentSource(kStageName, pExpCtx),
       _usedDisk(false),
       _doingMerge(false),
+      _canFlushPartialGroups(pExpCtx->needsMerge && pExpCtx->subPipelineDepth == 0 &&
+                             internalQueryFlushPartialGroupsOnShards.load()),
       _memoryTracker{pExpCtx->allowDiskUse && !pExpCtx->inMongos,
                      maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                          : internalDocumentSourceGroupMaxMemoryBytes.load()},
       _initialized(false),
-      _groups(pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
+      _groups(GroupsMap()),
       _spilled(false) {
     if (!pExpCtx->inMongos && (pExpCtx->allowDiskUse || kDebugBuild)) {
         // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
@@ -497,10 +526,12 @@ private:
 
 class SpillSTLComparator {
 public:
+    typedef pair<Value, const DocumentSourceGroup::Accumulators*> Data;
+
     SpillSTLComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
 
-    bool operator()(const GroupsMap::value_type* lhs, const GroupsMap::value_type* rhs) const {
-        return _valueComparator.evaluate(lhs->first < rhs->first);
+    bool operator()(const Data& lhs, const Data& rhs) const {
+        return _valueComparator.evaluate(lhs.first < rhs.first);
     }
 
 private:
@@ -509,118 +540,345 @@ private:
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
-    const size_t numAccumulators = _accumulatedFields.size();
+    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'. The input is read
+    // in batches, the rest of which is kept for the next call when a partial group is returned.
+    const size_t batchSize = internalDocumentSourceGetNextBatchSize.load();
+    for (;;) {
+        if (_inputBatchPos == _inputBatch.size()) {
+            if (_inputBatchStatus != GetNextResult::ReturnStatus::kAdvanced) {
+                break;
+            }
+            _inputBatch.clear();
+            _inputBatchPos = 0;
+            _inputBatchStatus = pSource->getNextBatch(&_inputBatch, batchSize);
+            continue;
+        }
+
+        if (_memoryTracker.shouldSpillWithAttemptToSaveMemory([this]() { return freeMemory(); })) {
+            _sortedFiles.push_back(spill());
+        }
+
+        // We release the input document here so that it does not outlive the end of this loop
+        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
+        auto rootDocument = std::move(_inputBatch[_inputBatchPos++]);
+        if (_bypassPartialGrouping) {
+            return makePartialGroup(rootDocument);
+        }
+
+        accumulateInGroupsMap(computeId(rootDocument), rootDocument);
+        ++_numInputsSinceFlush;
+        if (shouldFlushPartialGroups()) {
+            return flushPartialGroups();
+        }
+    }
+
+    // The status which ended the input is only reported once, so that a paused input is read again.
+    const auto status = _inputBatchStatus;
+    _inputBatchStatus = GetNextResult::ReturnStatus::kAdvanced;
+    switch (status) {
+        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
+            MONGO_UNREACHABLE;  // We consumed all advances above.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
+            return GetNextResult::makePauseExecution();  // Propagate pause.
+        }
+        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
+            prepareToOutputGroups();
+
+            // This must happen last so that, unless control gets here, we will re-enter
+            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
+            _initialized = true;
+            return GetNextResult::makeEOF();
+        }
+    }
+    MONGO_UNREACHABLE;
+}
 
-    // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
+DocumentSource::GetNextResult DocumentSourceGroup::getNextStreaming() {
+    const ValueComparator& valueComparator = pExpCtx->getValueComparator();
+
+    // Barring any pausing, this loop consumes 'pSource' until the group key changes.
     GetNextResult input = pSource->getNext();
 
     for (; input.isAdvanced(); input = pSource->getNext()) {
         if (_memoryTracker.shouldSpillWithAttemptToSaveMemory([this]() { return freeMemory(); })) {
+            deferStreamingGroup();
             _sortedFiles.push_back(spill());
         }
 
-        // We release the result document here so that it does not outlive the end of this loop
-        // iteration. Not releasing could lead to an array copy when this group follows an unwind.
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
-
-        if (inserted) {
-            _memoryTracker.memoryUsageBytes += id.getApproximateSize();
-
-            // Initialize and add the accumulators
-            Value expandedId = expandId(id);
-            Document idDoc =
-                expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
-                Value initializerValue =
-                    accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
-            }
-        } else {
-            for (auto&& groupObj : group) {
+        if (!canStream(id) ||
+            (!_deferredStreamingId.missing() &&
+             valueComparator.evaluate(id == _deferredStreamingId))) {
+            accumulateInGroupsMap(id, rootDocument);
+            continue;
+        }
+
+        if (!_streamingId.missing() && valueComparator.evaluate(id == _streamingId)) {
+            for (auto&& accum : _streamingAccumulators) {
                 // subtract old mem usage. New usage added back after processing.
-                _memoryTracker.memoryUsageBytes -= groupObj->memUsageForSorter();
+                _memoryTracker.memoryUsageBytes -= accum->memUsageForSorter();
             }
+            accumulate(_streamingAccumulators, rootDocument);
+            continue;
         }
 
-        /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
+        // The group key changed, so the open group is complete. Since the input is sorted, none of
+        // the following documents belongs to the open group, or to the deferred one.
+        boost::optional<Document> completedGroup;
+        if (!_streamingId.missing()) {
+            completedGroup = closeStreamingGroup();
+        }
+        _deferredStreamingId = Value();
 
-        for (size_t i = 0; i < numAccumulators; i++) {
-            group[i]->process(
-                _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
-                _doingMerge);
+        _memoryTracker.memoryUsageBytes += id.getApproximateSize();
+        _streamingAccumulators = makeAccumulators(id);
+        _streamingId = std::move(id);
+        accumulate(_streamingAccumulators, rootDocument);
 
-            _memoryTracker.memoryUsageBytes += group[i]->memUsageForSorter();
+        if (completedGroup) {
+            return std::move(*completedGroup);
         }
+    }
 
-        if (kDebugBuild && !storageGlobalParams.readOnly) {
-            // In debug mode, spill every time we have a duplicate id to stress merge logic.
-            if (!inserted &&                     // is a dup
-                !pExpCtx->inMongos &&            // can't spill to disk in mongos
-                !_memoryTracker.allowDiskUse &&  // don't change behavior when testing external sort
-                _sortedFiles.size() < 20) {      // don't open too many FDs
+    if (input.isPaused()) {
+        return input;
+    }
+    invariant(input.isEOF());
 
-                _sortedFiles.push_back(spill());
-            }
+    // Output the groups which were not streamed once the last streamed group has been output.
+    prepareToOutputGroups();
+    _initialized = true;
+    if (!_streamingId.missing()) {
+        return closeStreamingGroup();
+    }
+    return input;
+}
+
+bool DocumentSourceGroup::canStream(const Value& id) const {
+    auto sortsByValue = [](const Value& value) {
+        return !value.missing() && value.getType() != BSONType::Array &&
+            value.getType() != BSONType::Undefined;
+    };
+
+    // A single group key expression which evaluates to missing is grouped on null instead, and
+    // both sort the same. The components of a compound group key are kept as they are.
+    if (_idExpressions.size() == 1) {
+        return sortsByValue(id);
+    }
+    const auto& components = id.getArray();
+    return std::all_of(components.begin(), components.end(), sortsByValue);
+}
+
+Document DocumentSourceGroup::closeStreamingGroup() {
+    invariant(!_streamingId.missing());
+    Document out = makeDocument(_streamingId, _streamingAccumulators, pExpCtx->needsMerge);
+
+    _memoryTracker.memoryUsageBytes -= _streamingId.getApproximateSize();
+    for (auto&& accum : _streamingAccumulators) {
+        _memoryTracker.memoryUsageBytes -= accum->memUsageForSorter();
+    }
+    _streamingId = Value();
+    _streamingAccumulators.clear();
+    return out;
+}
+
+void DocumentSourceGroup::deferStreamingGroup() {
+    if (_streamingId.missing()) {
+        return;
+    }
+
+    // The memory of the open group is already accounted for, and is released by the spill.
+    (*_groups)[makeGroupKey(_streamingId)] = std::move(_streamingAccumulators);
+    _streamingAccumulators.clear();
+    _deferredStreamingId = std::move(_streamingId);
+    _streamingId = Value();
+}
+
+DocumentSourceGroup::Accumulators DocumentSourceGroup::makeAccumulators(const Value& id) {
+    Value expandedId = expandId(id);
+    Document idDoc =
+        expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
+
+    Accumulators accumulators;
+    accumulators.reserve(_accumulatedFields.size());
+    for (auto&& accumulatedField : _accumulatedFields) {
+        auto accum = accumulatedField.makeAccumulator();
+        Value initializerValue =
+            accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
+        accum->startNewGroup(initializerValue);
+        accumulators.push_back(accum);
+    }
+    return accumulators;
+}
+
+void DocumentSourceGroup::accumulate(const Accumulators& accumulators, const Document& root) {
+    const size_t numAccumulators = _accumulatedFields.size();
+    dassert(numAccumulators == accumulators.size());
+
+    for (size_t i = 0; i < numAccumulators; i++) {
+        accumulators[i]->process(
+            _accumulatedFields[i].expr.argument->evaluate(root, &pExpCtx->variables),
+            _doingMerge);
+
+        _memoryTracker.memoryUsageBytes += accumulators[i]->memUsageForSorter();
+    }
+    resetCommonSubexpressions();
+}
+
+void DocumentSourceGroup::accumulateInGroupsMap(const Value& id, const Document& root) {
+    // Look for the _id value in the map. If it's not there, add a new entry with a blank
+    // accumulator. This is done in a somewhat odd way in order to avoid encoding 'id' and
+    // looking it up in '_groups' multiple times.
+    auto [it, inserted] = _groups->try_emplace(makeGroupKey(id));
+    auto& group = it->second;
+
+    if (inserted) {
+        _memoryTracker.memoryUsageBytes += it->first.getApproximateSize();
+
+        // Initialize and add the accumulators
+        group = makeAccumulators(id);
+    } else {
+        for (auto&& groupObj : group) {
+            // subtract old mem usage. New usage added back after processing.
+            _memoryTracker.memoryUsageBytes -= groupObj->memUsageForSorter();
         }
     }
 
-    switch (input.getStatus()) {
-        case DocumentSource::GetNextResult::ReturnStatus::kAdvanced: {
-            MONGO_UNREACHABLE;  // We consumed all advances above.
+    /* tickle all the accumulators for the group we found */
+    accumulate(group, root);
+
+    if (kDebugBuild && !storageGlobalParams.readOnly) {
+        // In debug mode, spill every time we have a duplicate id to stress merge logic.
+        if (!inserted &&                     // is a dup
+            !pExpCtx->inMongos &&            // can't spill to disk in mongos
+            !_canFlushPartialGroups &&       // partial groups are flushed rather than spilled
+            !_memoryTracker.allowDiskUse &&  // don't change behavior when testing external sort
+            _sortedFiles.size() < 20) {      // don't open too many FDs
+
+            _sortedFiles.push_back(spill());
         }
-        case DocumentSource::GetNextResult::ReturnStatus::kPauseExecution: {
-            return input;  // Propagate pause.
+    }
+}
+
+void DocumentSourceGroup::prepareToOutputGroups() {
+    const size_t numAccumulators = _accumulatedFields.size();
+
+    // Do any final steps necessary to prepare to output results.
+    if (!_sortedFiles.empty()) {
+        _spilled = true;
+        if (!_groups->empty()) {
+            _sortedFiles.push_back(spill());
         }
-        case DocumentSource::GetNextResult::ReturnStatus::kEOF: {
-            // Do any final steps necessary to prepare to output results.
-            if (!_sortedFiles.empty()) {
-                _spilled = true;
-                if (!_groups->empty()) {
-                    _sortedFiles.push_back(spill());
-                }
 
-                // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+        // We won't be using groups again so free its memory.
+        _groups = GroupsMap();
 
-                _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
-                    _sortedFiles,
-                    _fileName,
-                    SortOptions(),
-                    SorterComparator(pExpCtx->getValueComparator())));
-                _ownsFileDeletion = false;
+        _sorterIterator.reset(
+            Sorter<Value, Value>::Iterator::merge(_sortedFiles,
+                                                  _fileName,
+                                                  SortOptions(),
+                                                  SorterComparator(pExpCtx->getValueComparator())));
+        _ownsFileDeletion = false;
 
-                // prepare current to accumulate data
-                _currentAccumulators.reserve(numAccumulators);
-                for (auto&& accumulatedField : _accumulatedFields) {
-                    _currentAccumulators.push_back(accumulatedField.makeAccumulator());
-                }
+        // prepare current to accumulate data
+        _currentAccumulators.reserve(numAccumulators);
+        for (auto&& accumulatedField : _accumulatedFields) {
+            _currentAccumulators.push_back(accumulatedField.makeAccumulator());
+        }
 
-                verify(_sorterIterator->more());  // we put data in, we should get something out.
-                _firstPartOfNextGroup = _sorterIterator->next();
-            } else {
-                // start the group iterator
-                groupsIterator = _groups->begin();
-            }
+        verify(_sorterIterator->more());  // we put data in, we should get something out.
+        _firstPartOfNextGroup = _sorterIterator->next();
+    } else {
+        // start the group iterator
+        groupsIterator = _groups->begin();
+    }
+}
 
-            // This must happen last so that, unless control gets here, we will re-enter
-            // initialization after getting a GetNextResult::ResultState::kPauseExecution.
-            _initialized = true;
-            return input;
+bool DocumentSourceGroup::shouldFlushPartialGroups() const {
+    return _canFlushPartialGroups &&
+        _memoryTracker.memoryUsageBytes > _memoryTracker.maxMemoryUsageBytes;
+}
+
+Document DocumentSourceGroup::flushPartialGroups() {
+    invariant(!_groups->empty());
+
+    // When most input documents start a group of their own, grouping them on the shards costs
+    // memory and CPU without reducing the number of documents sent to the merging $group much.
+    const double reductionRatio = static_cast<double>(_numInputsSinceFlush) / _groups->size();
+    if (reductionRatio < internalQueryPartialGroupMinReductionRatio.load()) {
+        _bypassPartialGrouping = true;
+    }
+
+    for (auto&& group : *_groups) {
+        _flushedGroups.push_back(
+            makeDocument(groupKeyToId(group.first), group.second, pExpCtx->needsMerge));
+    }
+    _groups->clear();
+    _memoryTracker.memoryUsageBytes = 0;
+    _numInputsSinceFlush = 0;
+
+    auto out = std::move(_flushedGroups.front());
+    _flushedGroups.pop_front();
+    return out;
+}
+
+Document DocumentSourceGroup::makePartialGroup(const Document& root) {
+    Value id = computeId(root);
+    auto accumulators = makeAccumulators(id);
+    for (size_t i = 0; i < accumulators.size(); i++) {
+        accumulators[i]->process(
+            _accumulatedFields[i].expr.argument->evaluate(root, &pExpCtx->variables), _doingMerge);
+    }
+    resetCommonSubexpressions();
+    return makeDocument(id, accumulators, pExpCtx->needsMerge);
+}
+
+bool DocumentSourceGroup::groupKeyCoveredBySort(const SortPattern& sortPattern) const {
+    // Each group key expression represents at most one path, so the group key fields are exactly
+    // the leading fields of the sort pattern if each of those is a group key field.
+    if (sortPattern.size() < _idExpressions.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < _idExpressions.size(); ++i) {
+        if (!sortPattern[i].fieldPath ||
+            !pathIncludedInGroupKeys(sortPattern[i].fieldPath->fullPath())) {
+            return false;
         }
     }
-    MONGO_UNREACHABLE;
+    return true;
+}
+
+boost::optional<std::string> DocumentSourceGroup::getSingleFieldGroupKey() const {
+    if (_idExpressions.size() != 1) {
+        return boost::none;
+    }
+
+    auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
+    if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath()) {
+        return boost::none;
+    }
+
+    const auto fieldPath = fieldPathExpr->getFieldPath();
+    if (fieldPath.getPathLength() == 1) {
+        // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by (since
+        // each document has a unique _id, it will just return the entire collection), and it is
+        // the entire document rather than a single field.
+        invariant(fieldPath.getFieldName(0) == "CURRENT" || fieldPath.getFieldName(0) == "ROOT");
+        return boost::none;
+    }
+
+    return fieldPath.tail().fullPath();
+}
+
+bool DocumentSourceGroup::accumulatesOnlyConstants() const {
+    return std::all_of(
+        _accumulatedFields.begin(), _accumulatedFields.end(), [](const auto& accumulator) {
+            return dynamic_cast<ExpressionConstant*>(accumulator.expr.initializer.get()) &&
+                dynamic_cast<ExpressionConstant*>(accumulator.expr.argument.get());
+        });
 }
 
 bool DocumentSourceGroup::usedDisk() {
@@ -629,10 +887,12 @@ bool DocumentSourceGroup::usedDisk() {
 
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _usedDisk = true;
-    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
+    // The groups are sorted by their decoded keys, in the order of the comparator which merges the
+    // spilled files.
+    vector<SpillSTLComparator::Data> ptrs;  // using pointers to speed sorting
     ptrs.reserve(_groups->size());
     for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
-        ptrs.push_back(&*it);
+        ptrs.emplace_back(groupKeyToId(it->first), &it->second);
     }
 
     stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
@@ -642,24 +902,24 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
         case 0:                           // no values, essentially a distinct
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+                writer.addAlreadySorted(ptrs[i].first, Value());
             }
             break;
 
         case 1:  // just one value, use optimized serialization as single Value
             for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+                writer.addAlreadySorted(ptrs[i].first,
+                                        (*ptrs[i].second)[0]->getValue(/*toBeMerged=*/true));
             }
             break;
 
         default:  // multiple values, serialize as array-typed Value
             for (size_t i = 0; i < ptrs.size(); i++) {
                 vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+                for (size_t j = 0; j < ptrs[i].second->size(); j++) {
+                    accums.push_back((*ptrs[i].second)[j]->getValue(/*toBeMerged=*/true));
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+                writer.addAlreadySorted(ptrs[i].first, Value(std::move(accums)));
             }
             break;
     }
@@ -672,6 +932,10 @@ shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
 }
 
 Value DocumentSourceGroup::computeId(const Document& root) {
+    // The group key is computed first for each input document, so this is where the values of the
+    // previous one are discarded if accumulating it threw.
+    resetCommonSubexpressions();
+
     // If only one expression, return result directly
     if (_idExpressions.size() == 1) {
         Value retValue = _idExpressions[0]->evaluate(root, &pExpCtx->variables);
@@ -687,6 +951,68 @@ Value DocumentSourceGroup::computeId(const Document& root) {
     return Value(std::move(vals));
 }
 
+DocumentSourceGroup::GroupKey DocumentSourceGroup::makeGroupKey(const Value& id) const {
+    KeyString::StringTransformFn transform;
+    if (const auto* collator = pExpCtx->getCollator()) {
+        transform = [collator](StringData str) {
+            return collator->getComparisonKey(str).getKeyData().toString();
+        };
+    }
+
+    // The components of a compound group key may be missing, which BSON cannot represent, so each
+    // component is preceded by whether it is present.
+    BSONObjBuilder bob;
+    KeyString::Builder builder(KeyString::Version::kLatestVersion);
+    if (_idExpressions.size() == 1) {
+        invariant(!id.missing());
+        id.addToBsonObj(&bob, ""_sd);
+        builder.appendBSONElement(bob.done().firstElement(), transform);
+    } else {
+        const auto& components = id.getArray();
+        for (auto&& component : components) {
+            component.addToBsonObj(&bob, ""_sd);
+        }
+        BSONObjIterator elements(bob.done());
+        for (auto&& component : components) {
+            builder.appendNumberLong(component.missing() ? 0 : 1);
+            if (!component.missing()) {
+                builder.appendBSONElement(elements.next(), transform);
+            }
+        }
+    }
+
+    GroupKey key;
+    key.encoded = builder.getValueCopy();
+    key.hash = absl::hash_internal::CityHash64(key.encoded.getBuffer(), key.encoded.getSize());
+    if (transform) {
+        key.id = id;
+    }
+    return key;
+}
+
+Value DocumentSourceGroup::groupKeyToId(const GroupKey& key) const {
+    if (!key.id.missing()) {
+        return key.id;
+    }
+
+    BSONObj decoded = KeyString::toBson(key.encoded.getBuffer(),
+                                        key.encoded.getSize(),
+                                        KeyString::ALL_ASCENDING,
+                                        key.encoded.getTypeBits());
+    BSONObjIterator elements(decoded);
+    if (_idExpressions.size() == 1) {
+        return Value(elements.next());
+    }
+
+    vector<Value> components;
+    components.reserve(_idExpressions.size());
+    while (elements.more()) {
+        const bool present = elements.next().numberLong() != 0;
+        components.push_back(present ? Value(elements.next()) : Value());
+    }
+    return Value(std::move(components));
+}
+
 Value DocumentSourceGroup::expandId(const Value& val) {
     // _id doesn't get wrapped in a document
     if (_idFieldNames.empty())
@@ -790,27 +1116,13 @@ bool DocumentSourceGroup::canRunInParallelBeforeWriteStage(
 
 std::unique_ptr<GroupFromFirstDocumentTransformation>
 DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
-    if (_idExpressions.size() != 1) {
-        // This transformation is only intended for $group stages that group on a single field.
-        return nullptr;
-    }
-
-    auto fieldPathExpr = dynamic_cast<ExpressionFieldPath*>(_idExpressions.front().get());
-    if (!fieldPathExpr || !fieldPathExpr->isRootFieldPath()) {
-        return nullptr;
-    }
-
-    const auto fieldPath = fieldPathExpr->getFieldPath();
-    if (fieldPath.getPathLength() == 1) {
-        // The path is $$CURRENT or $$ROOT. This isn't really a sensible value to group by (since
-        // each document has a unique _id, it will just return the entire collection). We only
-        // apply the rewrite when grouping by a single field, so we cannot apply it in this case,
-        // where we are grouping by the entire document.
-        invariant(fieldPath.getFieldName(0) == "CURRENT" || fieldPath.getFieldName(0) == "ROOT");
+    // This transformation is only intended for $group stages that group on a single field.
+    const auto singleFieldGroupKey = getSingleFieldGroupKey();
+    if (!singleFieldGroupKey) {
         return nullptr;
     }
 
-    const auto groupId = fieldPath.tail().fullPath();
+    const auto& groupId = *singleFieldGroupKey;
 
     // We can't do this transformation if there are any non-$first accumulators.
     for (auto&& accumulator : _accumulatedFields) {
@@ -29,14 +29,20 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression_common_subexpression.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 
@@ -89,7 +95,40 @@ private:
 class DocumentSourceGroup final : public DocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<AccumulatorState>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
+
+    /**
+     * The key of a group in the groups map. The group key of an input document is encoded once as
+     * a KeyString, with the collation applied to its strings, so that the map hashes and compares
+     * flat byte strings instead of walking nested documents and arrays on every insert and probe.
+     * Equal group keys have the same encoding, regardless of their numeric types. The _id of the
+     * group is decoded from the KeyString when the group is output, unless the collation made the
+     * encoding lossy, in which case the original _id is kept in 'id'.
+     */
+    struct GroupKey {
+        struct Hasher {
+            size_t operator()(const GroupKey& key) const {
+                return key.hash;
+            }
+        };
+
+        struct EqualTo {
+            bool operator()(const GroupKey& lhs, const GroupKey& rhs) const {
+                return lhs.hash == rhs.hash && lhs.encoded.compare(rhs.encoded) == 0;
+            }
+        };
+
+        size_t getApproximateSize() const {
+            return sizeof(GroupKey) + encoded.getSize() + encoded.getTypeBits().getSize() +
+                id.getApproximateSize() - sizeof(Value);
+        }
+
+        KeyString::Value encoded;
+        size_t hash = 0;
+        Value id;
+    };
+
+    using GroupsMap =
+        stdx::unordered_map<GroupKey, Accumulators, GroupKey::Hasher, GroupKey::EqualTo>;
 
     static constexpr StringData kStageName = "$group"_sd;
 
@@ -156,6 +195,41 @@ public:
         _doingMerge = doingMerge;
     }
 
+    /**
+     * Returns true if input sorted by 'sortPattern' has all the documents with the same group key
+     * next to each other. This is the case when the leading fields of the sort pattern are exactly
+     * the fields this $group groups on.
+     */
+    bool groupKeyCoveredBySort(const SortPattern& sortPattern) const;
+
+    /**
+     * If this $group groups on a single field of its input documents, as {_id: "$a"} or
+     * {_id: {v: "$a"}} do, returns the path of that field. Returns boost::none otherwise.
+     */
+    boost::optional<std::string> getSingleFieldGroupKey() const;
+
+    /**
+     * Returns true if every accumulator of this $group takes a constant argument, as a count
+     * ({$sum: 1}) does, so that its output only depends on the group keys of its input.
+     */
+    bool accumulatesOnlyConstants() const;
+
+    /**
+     * Returns true if this $group stage outputs each group as soon as the group key of its input
+     * changes.
+     */
+    bool isStreaming() const {
+        return _streaming;
+    }
+
+    /**
+     * Tell this source if its input is sorted such that groupKeyCoveredBySort() holds. Defaults to
+     * false.
+     */
+    void setStreaming(bool streaming) {
+        _streaming = streaming;
+    }
+
     /**
      * Returns true if this $group stage used disk during execution and false otherwise.
      */
@@ -203,29 +277,98 @@ private:
     ~DocumentSourceGroup();
 
     /**
-     * getNext() dispatches to one of these three depending on what type of $group it is. These
-     * methods expect '_currentAccumulators' to have been reset before being called, and also expect
-     * initialize() to have been called already.
+     * getNext() dispatches to one of these two depending on whether the groups were spilled to
+     * disk. These methods expect '_currentAccumulators' to have been reset before being called, and
+     * also expect initialize() to have been called already.
      */
     GetNextResult getNextSpilled();
     GetNextResult getNextStandard();
 
     /**
-     * Before returning anything, this source must prepare itself. In a streaming $group,
-     * initialize() requests the first document from the previous source, and uses it to prepare the
-     * accumulators. In an unsorted $group, initialize() exhausts the previous source before
-     * returning. The '_initialized' boolean indicates that initialize() has finished.
+     * Before returning anything, an unsorted $group must prepare itself. initialize() exhausts the
+     * previous source, accumulating each input document into '_groups', and then prepares to
+     * output the groups. The '_initialized' boolean indicates that initialize() has finished.
      *
      * This method may not be able to finish initialization in a single call if 'pSource' returns a
      * DocumentSource::GetNextResult::kPauseExecution, so it returns the last GetNextResult
-     * encountered, which may be either kEOF or kPauseExecution.
+     * encountered, which may be either kEOF or kPauseExecution. When this is the part of a split
+     * $group which runs on the shards, it also returns before finishing with each partial group it
+     * outputs early.
      */
     GetNextResult initialize();
 
     /**
-     * Spill groups map to disk and returns an iterator to the file. Note: Since a sorted $group
-     * does not exhaust the previous stage before returning, and thus does not maintain as large a
-     * store of documents at any one time, only an unsorted group can spill to disk.
+     * Used instead of initialize() by a streaming $group. Consumes the previous source until the
+     * group key changes, and returns the group which was completed by that. Documents whose group
+     * key may not be next to the other documents of their group in the sort order are accumulated
+     * into '_groups' instead, which are output once the previous source is exhausted.
+     *
+     * Returns the last GetNextResult from the previous source when it pauses. Once the previous
+     * source is exhausted, this method returns the last streamed group, if any, and marks this
+     * source as initialized. It then returns kEOF.
+     */
+    GetNextResult getNextStreaming();
+
+    /**
+     * Returns true if a document with the group key 'id' sorts next to the other documents of its
+     * group, given that groupKeyCoveredBySort() holds. This is not the case for group keys with
+     * arrays, which sort by one of their elements. It is also not the case for missing and
+     * undefined components of the group key, which sort the same as null.
+     */
+    bool canStream(const Value& id) const;
+
+    /**
+     * Outputs the open group of a streaming $group, and releases its memory.
+     */
+    Document closeStreamingGroup();
+
+    /**
+     * Moves the open group of a streaming $group into '_groups', so that it gets spilled to disk.
+     */
+    void deferStreamingGroup();
+
+    /**
+     * Creates the accumulators of a new group with key 'id'.
+     */
+    Accumulators makeAccumulators(const Value& id);
+
+    /**
+     * Passes 'root' to 'accumulators', and adds their new memory usage to the memory tracker.
+     */
+    void accumulate(const Accumulators& accumulators, const Document& root);
+
+    /**
+     * Adds 'root' to the group with key 'id' in '_groups', creating the group if necessary.
+     */
+    void accumulateInGroupsMap(const Value& id, const Document& root);
+
+    /**
+     * Called once the previous source is exhausted, to prepare iterating over the groups, be they
+     * in '_groups' or spilled to disk.
+     */
+    void prepareToOutputGroups();
+
+    /**
+     * Returns true if this is the part of a split $group which runs on the shards, and it has
+     * reached its memory limit. Since the merging $group combines the partial groups anyway, they
+     * can be output right away rather than spilled to disk.
+     */
+    bool shouldFlushPartialGroups() const;
+
+    /**
+     * Moves the partial groups in '_groups' to '_flushedGroups' and returns the first one. If the
+     * groups didn't reduce the number of input documents enough, stops grouping the following
+     * input documents.
+     */
+    Document flushPartialGroups();
+
+    /**
+     * Returns the partial group made of the single input document 'root'.
+     */
+    Document makePartialGroup(const Document& root);
+
+    /**
+     * Spill groups map to disk and returns an iterator to the file.
      */
     std::shared_ptr<Sorter<Value, Value>::Iterator> spill();
 
@@ -242,6 +385,18 @@ private:
      */
     Value computeId(const Document& root);
 
+    /**
+     * Encodes 'id', the internal representation of a group key, as the key of its group in
+     * '_groups'.
+     */
+    GroupKey makeGroupKey(const Value& id) const;
+
+    /**
+     * Returns the internal representation of the group key which 'key' was made from. If the key
+     * was decoded, numbers and strings are of the same types as in the original.
+     */
+    Value groupKeyToId(const GroupKey& key) const;
+
     /**
      * Converts the internal representation of the group key to the _id shape specified by the
      * user.
@@ -253,10 +408,24 @@ private:
      */
     bool pathIncludedInGroupKeys(const std::string& dottedPath) const;
 
+    /**
+     * Discards the values of '_commonSubexpressions' computed for the last input document.
+     */
+    void resetCommonSubexpressions() {
+        for (auto&& subexpression : _commonSubexpressions) {
+            subexpression->reset();
+        }
+    }
+
     std::vector<AccumulationStatement> _accumulatedFields;
 
     bool _usedDisk;  // Keeps track of whether this $group spilled to disk.
     bool _doingMerge;
+    bool _streaming = false;
+
+    // Whether this is the part of a split $group which runs on the shards, and can therefore output
+    // its partial groups before it reaches the end of its input.
+    const bool _canFlushPartialGroups;
 
     MemoryUsageTracker _memoryTracker;
 
@@ -267,14 +436,20 @@ private:
     std::vector<std::string> _idFieldNames;  // used when id is a document
     std::vector<boost::intrusive_ptr<Expression>> _idExpressions;
 
+    // The subexpressions which occur more than once among '_idExpressions' and the accumulator
+    // arguments, each evaluated once per input document. They are only shared once execution
+    // starts, as indicated by '_commonSubexpressionsEliminated'.
+    std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>> _commonSubexpressions;
+    bool _commonSubexpressionsEliminated = false;
+
     bool _initialized;
 
     Value _currentId;
     Accumulators _currentAccumulators;
 
-    // We use boost::optional to defer initialization until the ExpressionContext containing the
-    // correct comparator is injected, since the groups must be built using the comparator's
-    // definition of equality.
+    // The groups are keyed on their KeyString-encoded group keys. The encoding applies the
+    // collation of the ExpressionContext, so that the keys which are equal by the comparator's
+    // definition of equality are in the same group.
     boost::optional<GroupsMap> _groups;
 
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
@@ -287,6 +462,32 @@ private:
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
 
     std::pair<Value, Value> _firstPartOfNextGroup;
+
+    // Only used when '_streaming' is true. The key and the accumulators of the group which the
+    // latest input documents belong to. The key is missing until the first input document arrives,
+    // and after the open group has been output or deferred.
+    Value _streamingId;
+    Accumulators _streamingAccumulators;
+
+    // Only used when '_streaming' is true. The key of the open group when it was deferred to
+    // '_groups' in order to be spilled. The following input documents of that group are
+    // accumulated into '_groups' too.
+    Value _deferredStreamingId;
+
+    // Only used when '_canFlushPartialGroups' is true. The partial groups which are yet to be
+    // output after a flush, and the number of input documents accumulated since the last flush.
+    std::deque<Document> _flushedGroups;
+    size_t _numInputsSinceFlush = 0;
+
+    // Set when the partial groups of a flush reduced the number of input documents too little for
+    // grouping to be worth its cost. Every following input document is output as a partial group.
+    bool _bypassPartialGrouping = false;
+
+    // Only used when '_streaming' is false. The batch of input documents being consumed by
+    // initialize(), the position of the next one, and the status returned with the batch.
+    std::vector<Document> _inputBatch;
+    size_t _inputBatchPos = 0;
+    GetNextResult::ReturnStatus _inputBatchStatus = GetNextResult::ReturnStatus::kAdvanced;
 };
 
 }  // namespace mongo
@@ -46,9 +46,11 @@
 #include "mongo/db/pipeline/aggregation_request.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/stdx/unordered_set.h"
@@ -101,6 +103,43 @@ TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoading) {
     ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", BSONNULL}, {"count", 4}}));
 }
 
+TEST_F(DocumentSourceGroupTest, ShouldKeepTheRestOfAnInputBatchAcrossPauses) {
+    auto expCtx = getExpCtx();
+    auto&& parser = AccumulationStatement::getParser("$sum", boost::none);
+    auto accumulatorArg = BSON("" << 1);
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement countStatement{"count", accExpr};
+    auto group = DocumentSourceGroup::create(
+        expCtx, ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState),
+        {countStatement});
+
+    // The $match hands its input over to the $group in batches of matching documents.
+    auto match = DocumentSourceMatch::create(fromjson("{b: {$gt: 0}}"), expCtx);
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}, {"b", 1}},
+                                           Document{{"a", 2}, {"b", 0}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 1}, {"b", 1}},
+                                           Document{{"a", 2}, {"b", 1}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 3}, {"b", 0}}},
+                                          expCtx);
+    match->setSource(mock.get());
+    group->setSource(match.get());
+
+    ASSERT_TRUE(group->getNext().isPaused());
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    std::map<int, int> countByKey;
+    auto result = group->getNext();
+    for (; result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        countByKey[doc["_id"].coerceToInt()] = doc["count"].coerceToInt();
+    }
+    ASSERT_TRUE(result.isEOF());
+    ASSERT(countByKey == (std::map<int, int>{{1, 2}, {2, 1}}));
+}
+
 TEST_F(DocumentSourceGroupTest, ShouldBeAbleToPauseLoadingWhileSpilled) {
     auto expCtx = getExpCtx();
 
@@ -244,6 +283,308 @@ TEST_F(DocumentSourceGroupTest, ShouldNotReportDottedGroupKeyAsARename) {
     ASSERT_EQ(modifiedPathsRet.renames.size(), 0UL);
 }
 
+intrusive_ptr<DocumentSourceGroup> makeStreamingGroup(
+    const intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& spec) {
+    auto source = DocumentSourceGroup::createFromBson(spec.firstElement(), expCtx);
+    intrusive_ptr<DocumentSourceGroup> group(static_cast<DocumentSourceGroup*>(source.get()));
+    group->setStreaming(true);
+    return group;
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldOutputEachGroupWhenTheGroupKeyChanges) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    auto group = makeStreamingGroup(expCtx, fromjson("{$group: {_id: '$a', count: {$sum: 1}}}"));
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}},
+                                           Document{{"a", 1}},
+                                           Document{{"a", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 2}},
+                                           Document{{"a", 3}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    // The group with key 2 is still open when the input pauses.
+    ASSERT_TRUE(group->getNext().isPaused());
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 2}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 3}, {"count", 1}}));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldOutputArrayGroupKeysLast) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    auto group = makeStreamingGroup(expCtx, fromjson("{$group: {_id: '$a', count: {$sum: 1}}}"));
+
+    // The input is sorted by {a: 1}, which sorts the array by its smallest element.
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 1}},
+                                                   Document(fromjson("{a: [1, 2]}")),
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 2}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 1}, {"count", 2}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), (Document{{"_id", 2}, {"count", 1}}));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), Document(fromjson("{_id: [1, 2], count: 1}")));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldNotMixMissingAndNullGroupKeyComponents) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    auto group = makeStreamingGroup(
+        expCtx, fromjson("{$group: {_id: {x: '$a', y: '$b'}, count: {$sum: 1}}}"));
+
+    // The input is sorted by {a: 1, b: 1}, which sorts missing the same as null.
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 1}, {"b", BSONNULL}},
+                                                   Document{{"a", 1}},
+                                                   Document{{"a", 1}, {"b", BSONNULL}},
+                                                   Document{{"a", 2}, {"b", 1}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(),
+                       Document(fromjson("{_id: {x: 1, y: null}, count: 2}")));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(),
+                       Document(fromjson("{_id: {x: 2, y: 1}, count: 1}")));
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    ASSERT_DOCUMENT_EQ(result.releaseDocument(), Document(fromjson("{_id: {x: 1}, count: 1}")));
+    ASSERT_TRUE(group->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceGroupTest, StreamingGroupShouldMergeTheOpenGroupWithItsSpilledPart) {
+    auto expCtx = getExpCtx();
+
+    // Allow the $group stage to spill to disk.
+    TempDir tempDir("DocumentSourceGroupTest");
+    expCtx->tempDir = tempDir.path();
+    expCtx->allowDiskUse = true;
+    const size_t maxMemoryUsageBytes = 1000;
+
+    auto&& parser = AccumulationStatement::getParser("$push", boost::none);
+    auto accumulatorArg = BSON(""
+                               << "$largeStr");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement pushStatement{"spaceHog", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    auto group = DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, maxMemoryUsageBytes);
+    group->setStreaming(true);
+
+    string largeStr(maxMemoryUsageBytes / 2, 'x');
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 0}, {"largeStr", largeStr}},
+                                           Document{{"a", 0}, {"largeStr", largeStr}},
+                                           Document{{"a", 0}, {"largeStr", largeStr}},
+                                           Document{{"a", 1}, {"largeStr", largeStr}}},
+                                          expCtx);
+    group->setSource(mock.get());
+
+    // The group with key 0 is spilled while it is open, so it is output after the streamed group.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    auto doc = result.releaseDocument();
+    ASSERT_VALUE_EQ(doc["_id"], Value(1));
+    ASSERT_EQ(doc["spaceHog"].getArrayLength(), 1UL);
+
+    result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    doc = result.releaseDocument();
+    ASSERT_VALUE_EQ(doc["_id"], Value(0));
+    ASSERT_EQ(doc["spaceHog"].getArrayLength(), 3UL);
+    ASSERT_TRUE(group->getNext().isEOF());
+    ASSERT_TRUE(group->usedDisk());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldGroupEqualKeysOfDifferentNumericTypesAndKeepTheFirstId) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: {x: '$a', y: '$b'}, count: {$sum: 1}}}").firstElement(), expCtx);
+
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", 1}, {"b", Document{{"c", 1}}}},
+         Document{{"a", 1.0}, {"b", Document{{"c", 1LL}}}},
+         Document{{"a", Decimal128("1.00")}, {"b", Document{{"c", 1.0}}}},
+         Document{{"a", 1}, {"b", BSONNULL}},
+         Document{{"a", 1}, {"b", BSONNULL}},
+         Document{{"a", 1}, {"b", BSONNULL}},
+         Document{{"a", 1}, {"b", BSONNULL}},
+         Document{{"a", 1}}},
+        expCtx);
+    group->setSource(mock.get());
+
+    // The groups are output in no particular order, so tell them apart by their counts.
+    map<int, Document> groupsByCount;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        groupsByCount.emplace(doc["count"].coerceToInt(), doc);
+    }
+    ASSERT_EQ(groupsByCount.size(), 3U);
+
+    // The _id of a group is its first group key, with the same numeric types.
+    const auto& numeric = groupsByCount[3];
+    ASSERT_DOCUMENT_EQ(numeric, Document(fromjson("{_id: {x: 1, y: {c: 1}}, count: 3}")));
+    ASSERT_EQ(numeric["_id"]["x"].getType(), BSONType::NumberInt);
+    ASSERT_EQ(numeric["_id"]["y"]["c"].getType(), BSONType::NumberInt);
+
+    // A missing group key component is not grouped with null.
+    ASSERT_DOCUMENT_EQ(groupsByCount[4], Document(fromjson("{_id: {x: 1, y: null}, count: 4}")));
+    ASSERT_DOCUMENT_EQ(groupsByCount[1], Document(fromjson("{_id: {x: 1}, count: 1}")));
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldGroupKeysEqualUnderTheCollationAndKeepTheFirstId) {
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;  // Disallow external sort.
+                              // This is the only way to do this in a debug build.
+    expCtx->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    auto group = DocumentSourceGroup::createFromBson(
+        fromjson("{$group: {_id: '$a', count: {$sum: 1}}}").firstElement(), expCtx);
+
+    auto mock = DocumentSourceMock::createForTest(
+        {Document{{"a", "Abc"_sd}}, Document{{"a", "ABC"_sd}}, Document{{"a", "xyz"_sd}}}, expCtx);
+    group->setSource(mock.get());
+
+    map<int, Document> groupsByCount;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        groupsByCount.emplace(doc["count"].coerceToInt(), doc);
+    }
+    ASSERT_EQ(groupsByCount.size(), 2U);
+
+    // Compare the _id without the collation, which would consider any spelling of it equal.
+    ASSERT_EQ(groupsByCount[2]["_id"].getString(), "Abc");
+    ASSERT_EQ(groupsByCount[1]["_id"].getString(), "xyz");
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldReportGroupKeyCoveredByLeadingSortFields) {
+    auto expCtx = getExpCtx();
+    auto isCovered = [&](const char* groupSpec, const char* sortSpec) {
+        auto source =
+            DocumentSourceGroup::createFromBson(fromjson(groupSpec).firstElement(), expCtx);
+        return static_cast<DocumentSourceGroup*>(source.get())
+            ->groupKeyCoveredBySort(SortPattern(fromjson(sortSpec), expCtx));
+    };
+
+    ASSERT_TRUE(isCovered("{$group: {_id: '$a'}}", "{a: 1}"));
+    ASSERT_TRUE(isCovered("{$group: {_id: '$a.b'}}", "{'a.b': -1, c: 1}"));
+    ASSERT_TRUE(isCovered("{$group: {_id: {x: '$a', y: '$b'}}}", "{b: 1, a: -1, c: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: '$a'}}", "{b: 1, a: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: {x: '$a', y: '$b'}}}", "{a: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: {x: '$a', y: '$b'}}}", "{a: 1, c: 1, b: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: {$add: ['$a', 1]}}}", "{a: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: null}}", "{a: 1}"));
+    ASSERT_FALSE(isCovered("{$group: {_id: '$$ROOT'}}", "{a: 1}"));
+}
+
+intrusive_ptr<DocumentSourceGroup> makePartialPushGroup(
+    const intrusive_ptr<ExpressionContext>& expCtx, size_t maxMemoryUsageBytes) {
+    auto&& parser = AccumulationStatement::getParser("$push", boost::none);
+    auto accumulatorArg = BSON(""
+                               << "$largeStr");
+    auto accExpr = parser(expCtx.get(), accumulatorArg.firstElement(), expCtx->variablesParseState);
+    AccumulationStatement pushStatement{"spaceHog", accExpr};
+    auto groupByExpression =
+        ExpressionFieldPath::parse(expCtx.get(), "$a", expCtx->variablesParseState);
+    return DocumentSourceGroup::create(
+        expCtx, groupByExpression, {pushStatement}, maxMemoryUsageBytes);
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldFlushPartialGroupsInsteadOfSpillingWhenMergingIsNeeded) {
+    auto expCtx = getExpCtx();
+    expCtx->needsMerge = true;
+    const size_t maxMemoryUsageBytes = 1000;
+    auto group = makePartialPushGroup(expCtx, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes / 3, 'x');
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}, {"largeStr", largeStr}},
+                                                   Document{{"a", 0}, {"largeStr", largeStr}},
+                                                   Document{{"a", 0}, {"largeStr", largeStr}},
+                                                   Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 0}, {"largeStr", largeStr}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    // The memory limit is reached by the third document, which doesn't fail the query even though
+    // spilling to disk isn't allowed. The merging $group combines the two partial groups of key 0.
+    auto result = group->getNext();
+    ASSERT_TRUE(result.isAdvanced());
+    auto doc = result.releaseDocument();
+    ASSERT_VALUE_EQ(doc["_id"], Value(0));
+    ASSERT_EQ(doc["spaceHog"].getArrayLength(), 3UL);
+
+    std::map<int, size_t> numPushedByKey;
+    for (result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        doc = result.releaseDocument();
+        numPushedByKey[doc["_id"].coerceToInt()] += doc["spaceHog"].getArrayLength();
+    }
+    ASSERT_TRUE(result.isEOF());
+    ASSERT_EQ(numPushedByKey.size(), 2UL);
+    ASSERT_EQ(numPushedByKey[0], 1UL);
+    ASSERT_EQ(numPushedByKey[1], 1UL);
+    ASSERT_FALSE(group->usedDisk());
+}
+
+TEST_F(DocumentSourceGroupTest, ShouldStopPartialGroupingWhenTheGroupsDontReduceTheInput) {
+    auto expCtx = getExpCtx();
+    expCtx->needsMerge = true;
+    const size_t maxMemoryUsageBytes = 1000;
+    auto group = makePartialPushGroup(expCtx, maxMemoryUsageBytes);
+
+    string largeStr(maxMemoryUsageBytes / 3, 'x');
+    auto mock = DocumentSourceMock::createForTest({Document{{"a", 0}, {"largeStr", largeStr}},
+                                                   Document{{"a", 1}, {"largeStr", largeStr}},
+                                                   Document{{"a", 2}, {"largeStr", largeStr}},
+                                                   Document{{"a", 3}, {"largeStr", largeStr}},
+                                                   Document{{"a", 3}, {"largeStr", largeStr}}},
+                                                  expCtx);
+    group->setSource(mock.get());
+
+    // Each of the first three documents starts a group of its own, so the documents which follow
+    // the flush are output as partial groups of one document each.
+    std::vector<int> keys;
+    for (auto result = group->getNext(); result.isAdvanced(); result = group->getNext()) {
+        auto doc = result.releaseDocument();
+        ASSERT_EQ(doc["spaceHog"].getArrayLength(), 1UL);
+        keys.push_back(doc["_id"].coerceToInt());
+    }
+    std::sort(keys.begin(), keys.end());
+    ASSERT(keys == (std::vector<int>{0, 1, 2, 3, 3}));
+}
+
 BSONObj toBson(const intrusive_ptr<DocumentSource>& source) {
     vector<Value> arr;
     source->serializeToArray(arr);
@@ -0,0 +1,312 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(_internalUnpackBucket,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalUnpackBucket::createFromBson);
+
+namespace {
+
+constexpr StringData kTimeFieldName = "timeField"_sd;
+constexpr StringData kMetaFieldName = "metaField"_sd;
+
+// The fields of a bucket.
+constexpr StringData kBucketDataFieldName = "data"_sd;
+constexpr StringData kBucketMetaFieldName = "meta"_sd;
+constexpr StringData kBucketControlMinFieldPrefix = "control.min."_sd;
+constexpr StringData kBucketControlMaxFieldPrefix = "control.max."_sd;
+
+/**
+ * Returns the values of the column 'column' of a bucket by their positions, decompressing them if
+ * the bucket is compressed.
+ */
+BSONObj getColumnValues(const BSONElement& column) {
+    if (timeseries::isCompressedColumn(column)) {
+        return timeseries::decompressColumn(column);
+    }
+    return column.type() == BSONType::Object ? column.embeddedObject() : BSONObj();
+}
+
+}  // namespace
+
+DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::string timeField,
+    boost::optional<std::string> metaField)
+    : DocumentSource(kStageName, expCtx),
+      _timeField(std::move(timeField)),
+      _metaField(std::move(metaField)) {}
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBson(
+    BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(5190412,
+            str::stream() << "The argument to " << kStageName
+                          << " must be an object, but found type: " << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+
+    boost::optional<std::string> timeField;
+    boost::optional<std::string> metaField;
+    for (auto&& specElem : elem.embeddedObject()) {
+        const auto fieldName = specElem.fieldNameStringData();
+        uassert(5190413,
+                str::stream() << "Unrecognized option to " << kStageName << ": " << fieldName,
+                fieldName == kTimeFieldName || fieldName == kMetaFieldName);
+        uassert(5190414,
+                str::stream() << "The '" << fieldName << "' option of " << kStageName
+                              << " must be a string, but found type: "
+                              << typeName(specElem.type()),
+                specElem.type() == BSONType::String);
+        (fieldName == kTimeFieldName ? timeField : metaField) = specElem.str();
+    }
+    uassert(5190415,
+            str::stream() << kStageName << " requires a '" << kTimeFieldName << "' option",
+            timeField);
+
+    return make_intrusive<DocumentSourceInternalUnpackBucket>(
+        pExpCtx, std::move(*timeField), std::move(metaField));
+}
+
+Value DocumentSourceInternalUnpackBucket::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    spec[kTimeFieldName] = Value(_timeField);
+    if (_metaField) {
+        spec[kMetaFieldName] = Value(*_metaField);
+    }
+    return Value(Document{{kStageName, spec.freeze()}});
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
+    while (_nextMeasurement == _measurements.size()) {
+        auto next = pSource->getNext();
+        if (!next.isAdvanced()) {
+            return next;
+        }
+        unpackBucket(next.getDocument().toBson());
+    }
+    return std::move(_measurements[_nextMeasurement++]);
+}
+
+void DocumentSourceInternalUnpackBucket::unpackBucket(const BSONObj& bucket) {
+    _measurements.clear();
+    _nextMeasurement = 0;
+
+    auto data = bucket[kBucketDataFieldName];
+    if (data.type() != BSONType::Object) {
+        return;
+    }
+
+    // The positions of the measurements of a bucket are those of its times. A position missing from
+    // the times was reserved for a measurement which was never written.
+    std::map<size_t, BSONObjBuilder> measurements;
+    for (auto&& time : getColumnValues(data.embeddedObject()[_timeField])) {
+        if (auto index = str::parseUnsignedBase10Integer(time.fieldNameStringData())) {
+            measurements[*index];
+        }
+    }
+    if (measurements.empty()) {
+        return;
+    }
+
+    for (auto&& column : data.embeddedObject()) {
+        for (auto&& value : getColumnValues(column)) {
+            auto index = str::parseUnsignedBase10Integer(value.fieldNameStringData());
+            if (auto it = index ? measurements.find(*index) : measurements.end();
+                it != measurements.end()) {
+                it->second.appendAs(value, column.fieldNameStringData());
+            }
+        }
+    }
+
+    auto meta = bucket[kBucketMetaFieldName];
+    _measurements.reserve(measurements.size());
+    for (auto&& [index, measurement] : measurements) {
+        if (_metaField && meta) {
+            measurement.appendAs(meta, *_metaField);
+        }
+        _measurements.emplace_back(measurement.obj());
+    }
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
+    const MatchExpression* matchExpr) const {
+    if (matchExpr->matchType() == MatchExpression::AND) {
+        // Leaving out the children which can't be answered from the buckets only matches more
+        // buckets.
+        BSONArrayBuilder children;
+        for (size_t i = 0; i < matchExpr->numChildren(); ++i) {
+            auto child = createPredicatesOnBucketLevelField(matchExpr->getChild(i));
+            if (!child.isEmpty()) {
+                children.append(child);
+            }
+        }
+        return children.arrSize() ? BSON("$and" << children.arr()) : BSONObj();
+    }
+
+    auto comparison = dynamic_cast<const ComparisonMatchExpression*>(matchExpr);
+    if (!comparison) {
+        return BSONObj();
+    }
+    const auto path = comparison->path();
+    const auto& rhs = comparison->getData();
+
+    // The metadata of the measurements of a bucket is the metadata of the bucket.
+    if (_metaField &&
+        (path == *_metaField || path.startsWith(str::stream() << *_metaField << "."))) {
+        BSONObjBuilder predicate;
+        BSONObjBuilder operand(predicate.subobjStart(
+            str::stream() << kBucketMetaFieldName << path.substr(_metaField->size())));
+        operand.appendAs(rhs, comparison->name());
+        operand.done();
+        return predicate.obj();
+    }
+
+    if (path != _timeField) {
+        return createPredicatesOnMeasurementBounds(comparison);
+    }
+
+    // The times of the measurements of a bucket are within the bounds of the bucket.
+    if (rhs.type() != BSONType::Date) {
+        return BSONObj();
+    }
+    const std::string minPath = str::stream() << kBucketControlMinFieldPrefix << _timeField;
+    const std::string maxPath = str::stream() << kBucketControlMaxFieldPrefix << _timeField;
+    switch (comparison->matchType()) {
+        case MatchExpression::EQ:
+            return BSON(minPath << BSON("$lte" << rhs.Date()) << maxPath
+                                << BSON("$gte" << rhs.Date()));
+        case MatchExpression::GT:
+        case MatchExpression::GTE: {
+            BSONObjBuilder predicate;
+            BSONObjBuilder operand(predicate.subobjStart(maxPath));
+            operand.appendAs(rhs, comparison->name());
+            operand.done();
+            return predicate.obj();
+        }
+        case MatchExpression::LT:
+        case MatchExpression::LTE: {
+            BSONObjBuilder predicate;
+            BSONObjBuilder operand(predicate.subobjStart(minPath));
+            operand.appendAs(rhs, comparison->name());
+            operand.done();
+            return predicate.obj();
+        }
+        default:
+            return BSONObj();
+    }
+}
+
+BSONObj DocumentSourceInternalUnpackBucket::createPredicatesOnMeasurementBounds(
+    const ComparisonMatchExpression* comparison) const {
+    // The bounds of a bucket are the minimum and maximum of each top-level field across the
+    // measurements, in the order of BSON types. A query comparison only matches values of the
+    // type of its operand, or arrays which hold such values. So the bounds can only be compared
+    // with $expr, which uses the same order as the bounds, and only for numeric operands: an array
+    // value sorts after every number, which keeps its bucket. Operands of other types are left to
+    // the stage itself.
+    const auto path = comparison->path();
+    const auto& rhs = comparison->getData();
+    if (path.empty() || path.find('.') != std::string::npos || !rhs.isNumber()) {
+        return BSONObj();
+    }
+
+    const std::string minRef = str::stream() << "$" << kBucketControlMinFieldPrefix << path;
+    const std::string maxRef = str::stream() << "$" << kBucketControlMaxFieldPrefix << path;
+    auto compare = [](StringData op, StringData ref, const BSONObj& operand) {
+        return BSON(op << BSON_ARRAY(ref << operand));
+    };
+    const auto value = BSON("$const" << rhs);
+
+    // A bucket whose maximum is at least a string may hold an array, whose elements the bounds say
+    // nothing about.
+    const auto mayHoldArray = compare("$gte"_sd, maxRef, BSON("$const"
+                                                              << ""_sd));
+    switch (comparison->matchType()) {
+        case MatchExpression::EQ:
+            return BSON("$expr" << BSON(
+                            "$or" << BSON_ARRAY(
+                                BSON("$and" << BSON_ARRAY(compare("$lte"_sd, minRef, value)
+                                                          << compare("$gte"_sd, maxRef, value)))
+                                << mayHoldArray)));
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return BSON("$expr" << compare(comparison->name(), maxRef, value));
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+            return BSON("$expr" << BSON("$or" << BSON_ARRAY(
+                                            compare(comparison->name(), minRef, value)
+                                            << mayHoldArray)));
+        default:
+            return BSONObj();
+    }
+}
+
+Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    auto nextStage = std::next(itr);
+    if (_triedBucketLevelMatch || nextStage == container->end()) {
+        return nextStage;
+    }
+    auto nextMatch = dynamic_cast<DocumentSourceMatch*>(nextStage->get());
+    if (!nextMatch) {
+        return nextStage;
+    }
+
+    // The $match after this stage is kept, since the buckets it lets through may still hold
+    // measurements it doesn't match.
+    _triedBucketLevelMatch = true;
+    auto bucketPredicate = createPredicatesOnBucketLevelField(nextMatch->getMatchExpression());
+    if (bucketPredicate.isEmpty()) {
+        return nextStage;
+    }
+    container->insert(itr, DocumentSourceMatch::create(bucketPredicate, pExpCtx));
+
+    // The new $match may be able to optimize with the stages before it.
+    return std::prev(itr);
+}
+
+}  // namespace mongo
@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/document_source.h"
+
+namespace mongo {
+
+class ComparisonMatchExpression;
+class MatchExpression;
+
+/**
+ * Unpacks the buckets of a time-series collection into the measurements they store. Each bucket
+ * stores the values of each field of its measurements by their positions in the bucket, and the
+ * metadata shared by its measurements once, as 'meta'. The measurements of a bucket are output in
+ * the order of their positions, with the metadata as 'metaField'.
+ *
+ * When followed by a $match, the stage puts a $match on the bounds of the buckets before itself,
+ * so that buckets which can't hold any matching measurement aren't unpacked.
+ */
+class DocumentSourceInternalUnpackBucket final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
+
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    DocumentSourceInternalUnpackBucket(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                       std::string timeField,
+                                       boost::optional<std::string> metaField);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed,
+                UnionRequirement::kAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    /**
+     * The measurements are made from the whole bucket.
+     */
+    DepsTracker::State getDependencies(DepsTracker* deps) const final {
+        return DepsTracker::State::NOT_SUPPORTED;
+    }
+
+    GetModPathsReturn getModifiedPaths() const final {
+        return {GetModPathsReturn::Type::kAllPaths, std::set<std::string>{}, {}};
+    }
+
+    /**
+     * Returns a predicate on the bounds and metadata of a bucket which matches every bucket holding
+     * a measurement matched by 'matchExpr', or an empty object if there is no such predicate.
+     */
+    BSONObj createPredicatesOnBucketLevelField(const MatchExpression* matchExpr) const;
+
+protected:
+    GetNextResult doGetNext() final;
+
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
+private:
+    /**
+     * Unpacks the measurements of 'bucket' into '_measurements'.
+     */
+    void unpackBucket(const BSONObj& bucket);
+
+    /**
+     * Returns a predicate on the bounds of a bucket which matches every bucket holding a
+     * measurement matched by 'comparison' on a field other than the time and metadata fields, or
+     * an empty object if there is no such predicate.
+     */
+    BSONObj createPredicatesOnMeasurementBounds(const ComparisonMatchExpression* comparison) const;
+
+    const std::string _timeField;
+    const boost::optional<std::string> _metaField;
+
+    // The measurements of the current bucket which have not been returned yet.
+    std::vector<Document> _measurements;
+    size_t _nextMeasurement = 0;
+
+    // Whether a $match on the buckets has already been considered for the $match after this stage.
+    bool _triedBucketLevelMatch = false;
+};
+
+}  // namespace mongo
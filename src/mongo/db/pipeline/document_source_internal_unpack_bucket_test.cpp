@@ -0,0 +1,216 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <deque>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+using boost::intrusive_ptr;
+using std::deque;
+using std::vector;
+
+class InternalUnpackBucketTest : public AggregationContextFixture {
+public:
+    intrusive_ptr<DocumentSource> parse(const char* spec) {
+        auto specObj = fromjson(spec);
+        return DocumentSourceInternalUnpackBucket::createFromBson(specObj.firstElement(),
+                                                                  getExpCtx());
+    }
+
+    vector<Document> getResults(const char* spec, deque<DocumentSource::GetNextResult> buckets) {
+        auto stage = parse(spec);
+        auto source = DocumentSourceMock::createForTest(std::move(buckets), getExpCtx());
+        stage->setSource(source.get());
+
+        vector<Document> results;
+        for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+            ASSERT(next.isAdvanced());
+            results.push_back(next.releaseDocument());
+        }
+        return results;
+    }
+
+    BSONObj getBucketPredicate(const char* spec, const char* match) {
+        auto stage = parse(spec);
+        auto expr = uassertStatusOK(MatchExpressionParser::parse(fromjson(match), getExpCtx()));
+        return dynamic_cast<DocumentSourceInternalUnpackBucket*>(stage.get())
+            ->createPredicatesOnBucketLevelField(expr.get());
+    }
+};
+
+TEST_F(InternalUnpackBucketTest, UnpacksMeasurementsInPositionOrder) {
+    auto results = getResults("{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}",
+                              {Document(fromjson("{_id: 1, meta: 'a', data: {"
+                                                 "t: {'1': 20, '0': 10, '10': 30},"
+                                                 "x: {'0': 1, '10': 3}}}")),
+                               Document(fromjson("{_id: 2, data: {t: {'0': 40}, x: {'0': 4}}}"))});
+
+    ASSERT_EQ(4U, results.size());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 10, x: 1, m: 'a'}")), results[0]);
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 20, m: 'a'}")), results[1]);
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 30, x: 3, m: 'a'}")), results[2]);
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 40, x: 4}")), results[3]);
+}
+
+TEST_F(InternalUnpackBucketTest, SkipsPositionsWithoutATime) {
+    auto results = getResults("{$_internalUnpackBucket: {timeField: 't'}}",
+                              {Document(fromjson("{data: {t: {'1': 20}, x: {'0': 1, '1': 2}}}")),
+                               Document(fromjson("{data: {}}"))});
+
+    ASSERT_EQ(1U, results.size());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: 20, x: 2}")), results[0]);
+}
+
+TEST_F(InternalUnpackBucketTest, UnpacksCompressedBuckets) {
+    auto bucket = fromjson(
+        "{meta: 'a', data: {t: {'0': {$date: 1000}, '1': {$date: 2000}, '2': {$date: 3500}},"
+        "x: {'0': 1.5, '1': 2.5, '2': 0.25}, y: {'1': 'b'}}}");
+    auto compressed = timeseries::compressBucket(bucket);
+    ASSERT(compressed);
+    ASSERT(timeseries::isCompressedColumn(compressed->getObjectField("data")["t"]));
+
+    auto spec = "{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}";
+    auto expected = getResults(spec, {Document(bucket)});
+    ASSERT_EQ(3U, expected.size());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{t: {$date: 2000}, x: 2.5, y: 'b', m: 'a'}")),
+                       expected[1]);
+
+    auto results = getResults(spec, {Document(*compressed)});
+    ASSERT_EQ(expected.size(), results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        ASSERT_DOCUMENT_EQ(expected[i], results[i]);
+    }
+}
+
+TEST_F(InternalUnpackBucketTest, RejectsInvalidSpecs) {
+    ASSERT_THROWS_CODE(parse("{$_internalUnpackBucket: 1}"), AssertionException, 5190412);
+    ASSERT_THROWS_CODE(
+        parse("{$_internalUnpackBucket: {timeField: 't', foo: 1}}"), AssertionException, 5190413);
+    ASSERT_THROWS_CODE(
+        parse("{$_internalUnpackBucket: {timeField: 1}}"), AssertionException, 5190414);
+    ASSERT_THROWS_CODE(
+        parse("{$_internalUnpackBucket: {metaField: 'm'}}"), AssertionException, 5190415);
+}
+
+TEST_F(InternalUnpackBucketTest, SerializesSpec) {
+    const char* spec = "{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}";
+    vector<Value> serialized;
+    parse(spec)->serializeToArray(serialized);
+    ASSERT_EQ(1U, serialized.size());
+    ASSERT_VALUE_EQ(Value(fromjson(spec)), serialized[0]);
+}
+
+TEST_F(InternalUnpackBucketTest, PredicatesOnTimeUseTheBoundsOfTheBucket) {
+    const char* spec = "{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}";
+    ASSERT_BSONOBJ_EQ(fromjson("{'control.max.t': {$gt: {$date: 1000}}}"),
+                      getBucketPredicate(spec, "{t: {$gt: {$date: 1000}}}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{'control.min.t': {$lte: {$date: 1000}}}"),
+                      getBucketPredicate(spec, "{t: {$lte: {$date: 1000}}}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{'control.min.t': {$lte: {$date: 1000}}, "
+                               "'control.max.t': {$gte: {$date: 1000}}}"),
+                      getBucketPredicate(spec, "{t: {$date: 1000}}"));
+    ASSERT_BSONOBJ_EQ(BSONObj(), getBucketPredicate(spec, "{t: {$gt: 1000}}"));
+}
+
+TEST_F(InternalUnpackBucketTest, PredicatesOnMetadataUseTheMetadataOfTheBucket) {
+    const char* spec = "{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}";
+    ASSERT_BSONOBJ_EQ(fromjson("{'meta.a': {$eq: 1}}"), getBucketPredicate(spec, "{'m.a': 1}"));
+    ASSERT_BSONOBJ_EQ(fromjson("{$and: [{meta: {$lt: 5}}]}"),
+                      getBucketPredicate(spec, "{m: {$lt: 5}, x: 'a', mm: 'b'}"));
+    ASSERT_BSONOBJ_EQ(BSONObj(), getBucketPredicate(spec, "{$or: [{m: 1}, {x: 1}]}"));
+}
+
+TEST_F(InternalUnpackBucketTest, NumericPredicatesOnOtherFieldsUseTheBoundsOfTheBucket) {
+    const char* spec = "{$_internalUnpackBucket: {timeField: 't', metaField: 'm'}}";
+    auto matchesBucket = [&](const char* match, const char* bucket) {
+        auto predicate = getBucketPredicate(spec, match);
+        ASSERT_FALSE(predicate.isEmpty());
+        auto expr = uassertStatusOK(MatchExpressionParser::parse(predicate, getExpCtx()));
+        return expr->matchesBSON(fromjson(bucket));
+    };
+
+    const char* bucket = "{control: {min: {x: 1}, max: {x: 5}}}";
+    ASSERT_FALSE(matchesBucket("{x: {$gt: 5}}", bucket));
+    ASSERT_TRUE(matchesBucket("{x: {$gte: 5}}", bucket));
+    ASSERT_FALSE(matchesBucket("{x: {$lt: 1}}", bucket));
+    ASSERT_TRUE(matchesBucket("{x: {$lte: 1}}", bucket));
+    ASSERT_FALSE(matchesBucket("{x: 7}", bucket));
+    ASSERT_TRUE(matchesBucket("{x: 3.5}", bucket));
+
+    // None of the measurements of the bucket has a 'y' field.
+    ASSERT_FALSE(matchesBucket("{y: 3}", bucket));
+    ASSERT_FALSE(matchesBucket("{y: {$gt: 3}}", bucket));
+
+    // The bounds say nothing about the elements of arrays, so buckets which may hold one are kept.
+    ASSERT_TRUE(matchesBucket("{x: {$lt: 1}}", "{control: {min: {x: 5}, max: {x: [0]}}}"));
+    ASSERT_TRUE(matchesBucket("{x: 0}", "{control: {min: {x: [0]}, max: {x: [0]}}}"));
+    ASSERT_TRUE(matchesBucket("{x: {$gt: 1}}", "{control: {min: {x: 0}, max: {x: [0]}}}"));
+
+    // Only numeric operands on top-level fields are used.
+    ASSERT_BSONOBJ_EQ(BSONObj(), getBucketPredicate(spec, "{x: 'a'}"));
+    ASSERT_BSONOBJ_EQ(BSONObj(), getBucketPredicate(spec, "{x: {$gt: {$date: 1000}}}"));
+    ASSERT_BSONOBJ_EQ(BSONObj(), getBucketPredicate(spec, "{'x.y': 1}"));
+}
+
+TEST_F(InternalUnpackBucketTest, OptimizePutsABucketMatchBeforeTheStage) {
+    auto pipeline = Pipeline::parse(
+        {fromjson("{$_internalUnpackBucket: {timeField: 't'}}"), fromjson("{$match: {x: 'a'}}")},
+        getExpCtx());
+    pipeline->optimizePipeline();
+    ASSERT_EQ(2U, pipeline->getSources().size());
+
+    pipeline = Pipeline::parse({fromjson("{$_internalUnpackBucket: {timeField: 't'}}"),
+                                fromjson("{$match: {t: {$gte: {$date: 1000}}}}")},
+                               getExpCtx());
+    pipeline->optimizePipeline();
+    auto sources = pipeline->getSources();
+    ASSERT_EQ(3U, sources.size());
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(sources.front().get()));
+    ASSERT(dynamic_cast<DocumentSourceInternalUnpackBucket*>(std::next(sources.begin())->get()));
+    ASSERT(dynamic_cast<DocumentSourceMatch*>(sources.back().get()));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -31,11 +31,13 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/init.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/field_ref.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/pipeline/document_path_support.h"
@@ -87,6 +89,65 @@ bool foreignShardedLookupAllowed() {
     return getTestCommandsEnabled() && internalQueryAllowShardedLookup.load();
 }
 
+/**
+ * Appends 'result' to the 'results' matching a local document, enforcing the maximum total size of
+ * the results.
+ */
+void appendLookupResult(Document result,
+                        const NamespaceString& fromNs,
+                        long long* objsize,
+                        std::vector<Value>* results) {
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    long long safeSum = 0;
+    bool hasOverflowed = overflow::add(*objsize, result.getApproximateSize(), &safeSum);
+    uassert(4568,
+            str::stream() << "Total size of documents in " << fromNs.coll()
+                          << " matching pipeline's $lookup stage exceeds " << maxBytes << " bytes",
+
+            !hasOverflowed && safeSum <= maxBytes);
+    *objsize = safeSum;
+    results->emplace_back(std::move(result));
+}
+
+/**
+ * Returns the values at 'localFieldPath' in the local document 'input', if the foreign documents
+ * which match all of these values are those with an equal value of the foreign field. Returns
+ * boost::none otherwise. Null and undefined, to which missing local values are equivalent, also
+ * match missing foreign fields, and an array value also matches the foreign arrays equal to it as
+ * a whole, so these are left to a query.
+ */
+boost::optional<std::vector<Value>> getEqualityJoinValues(const Document& input,
+                                                          const FieldPath& localFieldPath) {
+    std::vector<Value> values;
+    bool canJoin = true;
+    document_path_support::visitAllValuesAtPath(input, localFieldPath, [&](const Value& nextValue) {
+        canJoin = canJoin && !nextValue.nullish() && nextValue.getType() != BSONType::Array;
+        if (canJoin) {
+            values.push_back(nextValue);
+        }
+    });
+
+    if (!canJoin || values.empty()) {
+        return boost::none;
+    }
+    return values;
+}
+
+/**
+ * Like getEqualityJoinValues(), but also rejects regular expressions, which an $in query would use
+ * for pattern matching.
+ */
+boost::optional<std::vector<Value>> getBatchedJoinValues(const Document& input,
+                                                         const FieldPath& localFieldPath) {
+    auto values = getEqualityJoinValues(input, localFieldPath);
+    if (values && std::any_of(values->begin(), values->end(), [](auto&& value) {
+            return value.getType() == BSONType::RegEx;
+        })) {
+        return boost::none;
+    }
+    return values;
+}
+
 // Parses $lookup 'from' field. The 'from' field must be a string or an object in the form of
 // {from: {db: "config", coll: "cache.chunks.*}, ...}.
 NamespaceString parseLookupFromAndResolveNamespace(const BSONElement& elem, StringData defaultDb) {
@@ -110,6 +171,25 @@ NamespaceString parseLookupFromAndResolveNamespace(const BSONElement& elem, Stri
     return nss;
 }
 
+/**
+ * Returns whether 'obj' holds a stage or an operator which may output different results when the
+ * same pipeline is run twice on the same documents.
+ */
+bool hasNonDeterministicOperator(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        const auto name = elem.fieldNameStringData();
+        if (name == "$sample"_sd || name == "$sampleRate"_sd || name == "$rand"_sd ||
+            name == "$where"_sd || name == "$function"_sd || name == "$accumulator"_sd) {
+            return true;
+        }
+        if ((elem.type() == BSONType::Object || elem.type() == BSONType::Array) &&
+            hasNonDeterministicOperator(elem.embeddedObject())) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace
 
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
@@ -276,7 +356,15 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
-    auto nextInput = pSource->getNext();
+    if (!_batchedOutput.empty()) {
+        auto output = std::move(_batchedOutput.front());
+        _batchedOutput.pop_front();
+        return output;
+    }
+
+    boost::optional<GetNextResult> pendingInput;
+    std::swap(pendingInput, _pendingInput);
+    auto nextInput = pendingInput ? std::move(*pendingInput) : pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
@@ -288,15 +376,105 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     invariant(!_matchSrc);
 
     if (!wasConstructedWithPipelineSyntax()) {
+        if (auto results = lookUpInForeignHashTable(inputDoc)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(std::move(*results)));
+            return output.freeze();
+        }
+
+        if (internalQueryLookupBatchSize.load() > 1 && canJoinByEquality()) {
+            if (auto localValues = getBatchedJoinValues(inputDoc, *_localField)) {
+                return lookUpBatch(std::move(inputDoc), *localValues);
+            }
+        }
+
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
         // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
         _resolvedPipeline.back() = matchStage;
     }
 
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    auto cacheKey = makeResultCacheKey(inputDoc);
+    if (cacheKey) {
+        if (auto cachedResults = (*_resultCache)[*cacheKey]) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(
+                _as, Value(std::vector<Value>(cachedResults->begin(), cachedResults->end())));
+            return output.freeze();
+        }
+    }
+
+    auto pipeline = buildPipelineForInput(inputDoc);
+
+    std::vector<Value> results;
+    std::vector<Document> resultsToCache;
+    long long objsize = 0;
+
+    while (auto result = pipeline->getNext()) {
+        if (cacheKey) {
+            resultsToCache.push_back(*result);
+        }
+        appendLookupResult(std::move(*result), _fromNs, &objsize, &results);
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    if (cacheKey) {
+        cacheResults(std::move(*cacheKey), std::move(resultsToCache), objsize);
+    }
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+boost::optional<Value> DocumentSourceLookUp::makeResultCacheKey(const Document& inputDoc) {
+    if (_resultCacheState == ResultCacheState::kPending) {
+        const bool deterministic =
+            std::none_of(_resolvedPipeline.begin(), _resolvedPipeline.end(), [](auto&& stage) {
+                return hasNonDeterministicOperator(stage);
+            });
+        if (deterministic && internalQueryLookupResultCacheMaxMemoryBytes.load() > 0) {
+            _resultCache.emplace(ValueComparator::kInstance);
+            _resultCacheState = ResultCacheState::kEnabled;
+        } else {
+            _resultCacheState = ResultCacheState::kDisabled;
+        }
+    }
+    if (_resultCacheState != ResultCacheState::kEnabled) {
+        return boost::none;
+    }
+
+    // The results only depend on the local document through the values of the 'let' variables, or
+    // through the $match stage on the foreign field. The key holds their exact BSON, so that values
+    // which compare equal but differ in type or case don't share results.
+    BSONObjBuilder key;
+    if (wasConstructedWithPipelineSyntax()) {
+        for (auto&& letVar : _letVariables) {
+            letVar.expression->evaluate(inputDoc, &pExpCtx->variables)
+                .addToBsonObj(&key, letVar.name);
+        }
+    } else {
+        key.appendElements(_resolvedPipeline.back());
+    }
+    const BSONObj keyObj = key.done();
+    return Value(BSONBinData(keyObj.objdata(), keyObj.objsize(), BinDataGeneral));
+}
+
+void DocumentSourceLookUp::cacheResults(Value key,
+                                        std::vector<Document> results,
+                                        long long resultsSize) {
+    const auto maxMemoryBytes =
+        static_cast<size_t>(internalQueryLookupResultCacheMaxMemoryBytes.load());
+    if (static_cast<size_t>(resultsSize) + key.getApproximateSize() <= maxMemoryBytes) {
+        _resultCache->insert(std::move(key), std::move(results));
+    }
+    _resultCache->evictDownTo(maxMemoryBytes);
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipelineForInput(
+    const Document& inputDoc) {
     try {
-        pipeline = buildPipeline(inputDoc);
+        return buildPipeline(inputDoc);
     } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
         // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
         // throw a custom exception.
@@ -308,28 +486,165 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         }
         throw;
     }
+}
+
+bool DocumentSourceLookUp::canJoinByEquality() const {
+    // The foreign documents are matched by implicit traversal of the arrays along '_foreignField'
+    // only, so a numeric path component, which may also refer to an array position, rules out the
+    // join by equality. A sharded foreign collection does not: it is then read with a single
+    // scatter-gather query, rather than with one per local document.
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (FieldRef::isNumericPathComponentStrict(_foreignField->getFieldName(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+DocumentSource::GetNextResult DocumentSourceLookUp::lookUpBatch(
+    Document inputDoc, const std::vector<Value>& localValues) {
+    // Collect the following local documents until the batch is full, or until one which cannot be
+    // part of it, which is left to be looked up after the batch. 'localDocsByValue' maps each
+    // local value to the positions of the documents of the batch which hold it.
+    const auto batchSize = static_cast<size_t>(internalQueryLookupBatchSize.load());
+    std::vector<Document> batch;
+    auto localDocsByValue =
+        pExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    BSONArrayBuilder inValues;
+    auto addToBatch = [&](Document doc, const std::vector<Value>& values) {
+        for (auto&& value : values) {
+            auto& positions = localDocsByValue[value];
+            if (positions.empty()) {
+                inValues << value;
+            }
+            if (positions.empty() || positions.back() != batch.size()) {
+                positions.push_back(batch.size());
+            }
+        }
+        batch.push_back(std::move(doc));
+    };
+
+    addToBatch(std::move(inputDoc), localValues);
+    while (batch.size() < batchSize) {
+        auto nextInput = pSource->getNext();
+        if (nextInput.isAdvanced()) {
+            if (auto values = getBatchedJoinValues(nextInput.getDocument(), *_localField)) {
+                addToBatch(nextInput.releaseDocument(), *values);
+                continue;
+            }
+        }
+        _pendingInput = std::move(nextInput);
+        break;
+    }
+    _numLookups += batch.size() - 1;
+
+    // We've already allocated space for the trailing $match stage in '_resolvedPipeline'.
+    _resolvedPipeline.back() =
+        BSON("$match" << BSON(_foreignField->fullPath() << BSON("$in" << inValues.arr())));
+    auto pipeline = buildPipelineForInput(Document());
+
+    // Hand each foreign document to every local document holding one of its values.
+    std::vector<std::vector<Value>> results(batch.size());
+    std::vector<long long> objsizes(batch.size(), 0);
+    while (auto result = pipeline->getNext()) {
+        std::vector<size_t> matches;
+        document_path_support::visitAllValuesAtPath(
+            *result, *_foreignField, [&](const Value& nextValue) {
+                if (auto it = localDocsByValue.find(nextValue); it != localDocsByValue.end()) {
+                    matches.insert(matches.end(), it->second.begin(), it->second.end());
+                }
+            });
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        for (auto idx : matches) {
+            appendLookupResult(*result, _fromNs, &objsizes[idx], &results[idx]);
+        }
+    }
+    _usedDisk = _usedDisk || pipeline->usedDisk();
+
+    for (size_t idx = 0; idx < batch.size(); ++idx) {
+        MutableDocument output(std::move(batch[idx]));
+        output.setNestedField(_as, Value(std::move(results[idx])));
+        _batchedOutput.push_back(output.freeze());
+    }
+
+    auto output = std::move(_batchedOutput.front());
+    _batchedOutput.pop_front();
+    return output;
+}
+
+boost::optional<std::vector<Value>> DocumentSourceLookUp::lookUpInForeignHashTable(
+    const Document& inputDoc) {
+    if (_hashJoinState == HashJoinState::kPending) {
+        if (!internalQueryEnableLookupHashJoin.load() || !canJoinByEquality()) {
+            _hashJoinState = HashJoinState::kAbandoned;
+        } else if (_numLookups++ >= internalQueryLookupHashJoinMinLookups.load()) {
+            buildForeignHashTable();
+        }
+    }
+
+    if (_hashJoinState != HashJoinState::kBuilt) {
+        return boost::none;
+    }
+
+    auto localValues = getEqualityJoinValues(inputDoc, *_localField);
+    if (!localValues) {
+        return boost::none;
+    }
+
+    // Gather the positions of the foreign documents matching any of the local values.
+    std::vector<size_t> matches;
+    for (auto&& value : *localValues) {
+        if (auto it = _foreignHashTable->find(value); it != _foreignHashTable->end()) {
+            matches.insert(matches.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    // Produce each matching document once, in the order in which the foreign collection was read.
+    std::sort(matches.begin(), matches.end());
+    matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
 
     std::vector<Value> results;
     long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    for (auto idx : matches) {
+        appendLookupResult(_foreignDocs[idx], _fromNs, &objsize, &results);
+    }
+    return results;
+}
 
+void DocumentSourceLookUp::buildForeignHashTable() {
+    // Read the whole foreign collection, through the resolved view pipeline if there is one.
+    _resolvedPipeline.back() = BSON("$match" << BSONObj());
+    auto pipeline = buildPipeline(Document());
+
+    _foreignHashTable = pExpCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>();
+    const auto maxMemoryUsageBytes = internalQueryLookupHashJoinMaxMemoryUsageBytes.load();
+    long long memoryUsageBytes = 0;
     while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
+        memoryUsageBytes += result->getApproximateSize();
+        if (memoryUsageBytes > maxMemoryUsageBytes) {
+            _usedDisk = _usedDisk || pipeline->usedDisk();
+            _hashJoinState = HashJoinState::kAbandoned;
+            _foreignHashTable.reset();
+            _foreignDocs.clear();
+            return;
+        }
 
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+        const auto idx = _foreignDocs.size();
+        document_path_support::visitAllValuesAtPath(
+            *result, *_foreignField, [&](const Value& nextValue) {
+                auto& positions = (*_foreignHashTable)[nextValue];
+                // A document holding the same value several times is only recorded once.
+                if (positions.empty() || positions.back() != idx) {
+                    positions.push_back(idx);
+                }
+            });
+        _foreignDocs.emplace_back(std::move(*result));
     }
     _usedDisk = _usedDisk || pipeline->usedDisk();
 
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+    _hashJoinState = HashJoinState::kBuilt;
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
@@ -531,6 +846,13 @@ bool DocumentSourceLookUp::usedDisk() {
 }
 
 void DocumentSourceLookUp::doDispose() {
+    _resultCache.reset();
+    _resultCacheState = ResultCacheState::kDisabled;
+    _foreignHashTable.reset();
+    _foreignDocs.clear();
+    _batchedOutput.clear();
+    _pendingInput.reset();
+
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         _pipeline->dispose(pExpCtx->opCtx);
@@ -817,6 +1139,15 @@ boost::optional<DocumentSource::DistributedPlanLogic> DocumentSourceLookUp::dist
         return boost::none;
     }
 
+    if (internalQueryEnableLookupBroadcastJoin.load() && !wasConstructedWithPipelineSyntax() &&
+        foreignShardedLookupAllowed() &&
+        pExpCtx->mongoProcessInterface->isSharded(pExpCtx->opCtx, _fromNs)) {
+        // Join the local documents on the shards which hold them, in parallel, rather than on the
+        // single merging node. Each shard reads the sharded foreign collection itself and, once it
+        // has looked up enough documents, loads all of it into its hash table.
+        return boost::none;
+    }
+
     // {shardsStage, mergingStage, sortPattern}
     return DistributedPlanLogic{nullptr, this, boost::none};
 }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -239,6 +240,54 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns whether the foreign documents matching a local document can be determined by
+     * comparing the values of '_foreignField' with the local values for equality.
+     */
+    bool canJoinByEquality() const;
+
+    /**
+     * Builds the pipeline for 'inputDoc' with buildPipeline(), reporting an attempt to look up in
+     * a sharded foreign collection when that is not allowed.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineForInput(const Document& inputDoc);
+
+    /**
+     * Looks up 'inputDoc', whose values of '_localField' are 'localValues', together with the
+     * following local documents which can be looked up by equality, up to the batch size, by
+     * running a single query for all of their values. Returns the result for 'inputDoc' and keeps
+     * those of the other documents in '_batchedOutput'.
+     */
+    GetNextResult lookUpBatch(Document inputDoc, const std::vector<Value>& localValues);
+
+    /**
+     * Returns the documents of the foreign collection matching 'inputDoc' from the hash table of
+     * the foreign collection, loading that table first once enough local documents have been
+     * looked up. Returns boost::none if the table is not available, or if the local values of
+     * 'inputDoc' must be looked up by running a query.
+     */
+    boost::optional<std::vector<Value>> lookUpInForeignHashTable(const Document& inputDoc);
+
+    /**
+     * Loads the documents of the foreign collection into '_foreignDocs' and indexes them by the
+     * values of '_foreignField' in '_foreignHashTable'. Abandons the hash join if the documents
+     * exceed the memory limit.
+     */
+    void buildForeignHashTable();
+
+    /**
+     * Returns the key of the results of the sub-pipeline for 'inputDoc' in '_resultCache': the
+     * values of the 'let' variables, or the $match stage on the foreign field, for 'inputDoc'.
+     * Returns boost::none if the results are not cached.
+     */
+    boost::optional<Value> makeResultCacheKey(const Document& inputDoc);
+
+    /**
+     * Adds 'results', of approximate size 'resultsSize', to '_resultCache' with key 'key' if they
+     * fit in the memory limit of the cache, evicting the least recently used results as needed.
+     */
+    void cacheResults(Value key, std::vector<Document> results, long long resultsSize);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -289,6 +338,15 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // Caches the results of the sub-pipeline for the local documents which are looked up one at a
+    // time, keyed by the values which the results depend on, so that the following local documents
+    // with the same values don't run the sub-pipeline again. It is not used when the sub-pipeline
+    // may return different results for the same values, or when it is disabled by
+    // 'internalQueryLookupResultCacheMaxMemoryBytes'. Created on the first lookup.
+    enum class ResultCacheState { kPending, kEnabled, kDisabled };
+    ResultCacheState _resultCacheState = ResultCacheState::kPending;
+    boost::optional<LookupSetCache> _resultCache;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
@@ -305,6 +363,22 @@ private:
 
     std::vector<LetVariable> _letVariables;
 
+    // For use when $lookup is specified with localField/foreignField syntax. Once enough local
+    // documents have been looked up by running a query per document, the foreign collection is
+    // loaded into '_foreignDocs', and indexed by the values of '_foreignField' into
+    // '_foreignHashTable', which maps each value to the positions of the matching documents.
+    enum class HashJoinState { kPending, kBuilt, kAbandoned };
+    HashJoinState _hashJoinState = HashJoinState::kPending;
+    long long _numLookups = 0;
+    std::vector<Document> _foreignDocs;
+    boost::optional<ValueUnorderedMap<std::vector<size_t>>> _foreignHashTable;
+
+    // For use when $lookup is specified with localField/foreignField syntax. Holds the results of
+    // a batch of local documents which have been looked up together, and the input which ended the
+    // batch, if it has not been looked up yet.
+    std::deque<Document> _batchedOutput;
+    boost::optional<GetNextResult> _pendingInput;
+
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
@@ -32,6 +32,8 @@
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -52,19 +54,84 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
-    auto input = pSource->getNext();
-    if (!input.isAdvanced()) {
-        return input;
+    if (_window.empty() && _sourceStatus == GetNextResult::ReturnStatus::kAdvanced) {
+        fillWindow();
     }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
+
+    if (_window.empty()) {
+        auto status = std::exchange(_sourceStatus, GetNextResult::ReturnStatus::kAdvanced);
+        return status == GetNextResult::ReturnStatus::kEOF ? GetNextResult::makeEOF()
+                                                           : GetNextResult::makePauseExecution();
+    }
+
+    auto next = std::move(_window.front());
+    _window.pop_front();
+    return next;
+}
+
+void DocumentSourceLookupChangePostImage::fillWindow() {
+    const size_t windowSize = internalChangeStreamPostImageLookupWindowSize.load();
+
+    std::vector<Document> events;
+    std::vector<boost::optional<BSONObj>> lookupKeys;
+    auto latestUpdates = SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<size_t>();
+    while (events.size() < windowSize) {
+        auto input = pSource->getNext();
+        if (!input.isAdvanced()) {
+            _sourceStatus = input.getStatus();
+            break;
+        }
+
+        auto opTypeVal = assertFieldHasType(
+            input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+        const auto opType = opTypeVal.getString();
+        if (opType == DocumentSourceChangeStream::kUpdateOpType) {
+            auto key = makeLookupKey(input.getDocument());
+            latestUpdates[key] = events.size();
+            lookupKeys.push_back(std::move(key));
+        } else {
+            lookupKeys.push_back(boost::none);
+        }
+        events.push_back(input.releaseDocument());
+
+        // The stages before this one close the cursor once they have returned an invalidate, so
+        // it must not read past one.
+        if (opType == DocumentSourceChangeStream::kInvalidateOpType) {
+            break;
+        }
     }
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+    // Looking up a document on behalf of its latest update in the window serves the earlier ones
+    // too, since the lookup returns the current version of the document at least as recent as the
+    // update. This also waits for the right 'afterClusterTime' on mongoS.
+    auto postImages = SimpleBSONObjComparator::kInstance.makeBSONObjIndexedMap<Value>();
+    for (auto&& [key, latestUpdate] : latestUpdates) {
+        postImages[key] = lookupPostImage(events[latestUpdate]);
+    }
+
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (!lookupKeys[i]) {
+            _window.push_back(std::move(events[i]));
+            continue;
+        }
+        MutableDocument output(std::move(events[i]));
+        output[kFullDocumentFieldName] = postImages[*lookupKeys[i]];
+        _window.push_back(output.freeze());
+    }
+}
+
+BSONObj DocumentSourceLookupChangePostImage::makeLookupKey(const Document& updateOp) const {
+    auto nss = assertValidNamespace(updateOp);
+    auto documentKey = assertFieldHasType(updateOp,
+                                          DocumentSourceChangeStream::kDocumentKeyField,
+                                          BSONType::Object)
+                           .getDocument();
+    auto resumeToken =
+        ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
+    invariant(resumeToken.getData().uuid);
+
+    return BSON("ns" << nss.ns() << "uuid" << *resumeToken.getData().uuid << "documentKey"
+                     << documentKey.toBson());
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -37,6 +39,10 @@ namespace mongo {
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
  * "documentKey" field of the input to look up the new version of the document.
+ *
+ * The stage reads a window of the events which are already available from its source before
+ * returning any of them, and looks up the post-image of each updated document in the window only
+ * once, on behalf of its latest update.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -110,10 +116,23 @@ private:
         : DocumentSource(kStageName, expCtx) {}
 
     /**
-     * Performs the lookup to retrieve the full document.
+     * Returns the next event of the window, refilling it from the source once it is exhausted.
      */
     GetNextResult doGetNext() final;
 
+    /**
+     * Reads up to internalChangeStreamPostImageLookupWindowSize events from the source into
+     * '_window', stopping early at the first pause or EOF, and adds the post-image to each update
+     * event among them.
+     */
+    void fillWindow();
+
+    /**
+     * Validates 'updateOp' and returns the key identifying the document that it updated, so that
+     * the updates of a window which share a key can share a lookup.
+     */
+    BSONObj makeLookupKey(const Document& updateOp) const;
+
     /**
      * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
      * Returns Value(BSONNULL) if the document couldn't be found.
@@ -126,6 +145,13 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // The events read from the source which have not been returned yet, with their post-images.
+    std::deque<Document> _window;
+
+    // The status with which the source ended the last window, to be returned once '_window' has
+    // been drained. kAdvanced if the window was ended by its size limit.
+    GetNextResult::ReturnStatus _sourceStatus = GetNextResult::ReturnStatus::kAdvanced;
 };
 
 }  // namespace mongo
@@ -45,6 +45,8 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -334,5 +336,98 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+/**
+ * A mock MongoProcessInterface which returns the document key of each lookup, extended by the
+ * number of lookups performed so far.
+ */
+class CountingLookupProcessInterface final : public StubMongoProcessInterface {
+public:
+    boost::optional<Document> lookupSingleDocument(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const Document& documentKey,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead) final {
+        MutableDocument lookedUpDocument(documentKey);
+        lookedUpDocument["lookup"] = Value(++numLookups);
+        return lookedUpDocument.freeze();
+    }
+
+    int numLookups = 0;
+};
+
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpEachDocumentOnceInAWindow) {
+    auto expCtx = getExpCtx();
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    auto makeUpdate = [&](int id) {
+        return Document{{"_id", makeResumeToken(id)},
+                        {"documentKey", Document{{"_id", id}}},
+                        {"operationType", "update"_sd},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {makeUpdate(0),
+         makeUpdate(1),
+         makeUpdate(0),
+         DocumentSource::GetNextResult::makePauseExecution(),
+         makeUpdate(0)},
+        expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    getExpCtx()->mongoProcessInterface = std::make_unique<CountingLookupProcessInterface>();
+    auto mongoProcessInterface =
+        static_cast<CountingLookupProcessInterface*>(getExpCtx()->mongoProcessInterface.get());
+
+    // Returns the number of the lookup which produced the post-image of the next update.
+    auto getNextLookup = [&](int id) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        auto fullDocument = next.getDocument()["fullDocument"].getDocument();
+        ASSERT_VALUE_EQ(fullDocument["_id"], Value(id));
+        return fullDocument["lookup"].getInt();
+    };
+
+    // The three updates before the pause form one window, in which document 0 is looked up once.
+    const auto firstLookup = getNextLookup(0);
+    getNextLookup(1);
+    ASSERT_EQ(getNextLookup(0), firstLookup);
+    ASSERT_EQ(mongoProcessInterface->numLookups, 2);
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+
+    // Updates after the pause are looked up again.
+    ASSERT_EQ(getNextLookup(0), 3);
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpEachUpdateAloneWithAWindowOfOne) {
+    auto expCtx = getExpCtx();
+    const auto oldWindowSize = internalChangeStreamPostImageLookupWindowSize.load();
+    ON_BLOCK_EXIT([&] { internalChangeStreamPostImageLookupWindowSize.store(oldWindowSize); });
+    internalChangeStreamPostImageLookupWindowSize.store(1);
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    auto makeUpdate = [&] {
+        return Document{{"_id", makeResumeToken(0)},
+                        {"documentKey", Document{{"_id", 0}}},
+                        {"operationType", "update"_sd},
+                        {"ns", Document{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}}}};
+    };
+    auto mockLocalSource = DocumentSourceMock::createForTest({makeUpdate(), makeUpdate()}, expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    getExpCtx()->mongoProcessInterface = std::make_unique<CountingLookupProcessInterface>();
+    auto mongoProcessInterface =
+        static_cast<CountingLookupProcessInterface*>(getExpCtx()->mongoProcessInterface.get());
+
+    ASSERT_TRUE(lookupChangeStage->getNext().isAdvanced());
+    ASSERT_TRUE(lookupChangeStage->getNext().isAdvanced());
+    ASSERT_EQ(mongoProcessInterface->numLookups, 2);
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+}
+
 }  // namespace
 }  // namespace mongo
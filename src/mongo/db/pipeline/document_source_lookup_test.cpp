@@ -50,6 +50,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -684,12 +685,18 @@ public:
 
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        ++_numAttachedCursorSources;
         return pipeline;
     }
 
+    int numAttachedCursorSources() const {
+        return _numAttachedCursorSources;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numAttachedCursorSources = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -1243,6 +1250,58 @@ TEST_F(DocumentSourceLookUpTest,
         secondResult.getDocument());
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldReuseTheResultsOfTheSameLetVariableValues) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    auto runLookup = [&](StringData pipeline) {
+        auto mongoProcessInterface = std::make_shared<MockMongoInterface>(
+            deque<DocumentSource::GetNextResult>{Document{{"x", 0}}, Document{{"x", 1}}});
+        expCtx->mongoProcessInterface = mongoProcessInterface;
+
+        // Abandon the cache of the non-correlated prefix, so that each run of the sub-pipeline
+        // reads from the mocked foreign collection.
+        auto docSource = DocumentSourceLookUp::createFromBsonWithCacheSize(
+            fromjson(str::stream() << "{$lookup: {let: {var1: '$k'}, pipeline: " << pipeline
+                                   << ", from: 'coll', as: 'as'}}")
+                .firstElement(),
+            expCtx,
+            0);
+        auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"k", 1}},
+                                                                  Document{{"k", 2}},
+                                                                  Document{{"k", 1}},
+                                                                  Document{{"k", 1.0}},
+                                                                  Document{{"k", 2}}},
+                                                                 expCtx);
+        docSource->setSource(mockLocalSource.get());
+
+        for (auto next = docSource->getNext(); next.isAdvanced(); next = docSource->getNext()) {
+            const auto k = next.getDocument()["k"];
+            ASSERT_VALUE_EQ(Value(vector<Value>{Value(Document{{"x", 0}, {"v", k}}),
+                                                Value(Document{{"x", 1}, {"v", k}})}),
+                            next.getDocument()["as"]);
+        }
+        docSource->dispose();
+        return mongoProcessInterface->numAttachedCursorSources();
+    };
+
+    // The sub-pipeline runs once for each distinct value of the variable. Values which compare
+    // equal but have different types are looked up separately.
+    const auto pipeline = "[{$addFields: {v: '$$var1'}}]"_sd;
+    ASSERT_EQ(3, runLookup(pipeline));
+
+    // A sub-pipeline whose results may change from one run to the next runs for each document.
+    ASSERT_EQ(5, runLookup("[{$match: {$expr: {$lt: [{$rand: {}}, 2]}}}, {$addFields: {v: "
+                           "'$$var1'}}]"_sd));
+
+    const auto oldMaxMemoryBytes = internalQueryLookupResultCacheMaxMemoryBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryLookupResultCacheMaxMemoryBytes.store(oldMaxMemoryBytes); });
+    internalQueryLookupResultCacheMaxMemoryBytes.store(0);
+    ASSERT_EQ(5, runLookup(pipeline));
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldNotCacheIfCorrelatedStageIsAbsorbedIntoPlanExecutor) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "coll");
@@ -1272,5 +1331,144 @@ TEST_F(DocumentSourceLookUpTest, ShouldNotCacheIfCorrelatedStageIsAbsorbedIntoPl
     ASSERT_VALUE_EQ(Value(subPipeline->writeExplainOps(kExplain)), Value(BSONArray(expectedPipe)));
 }
 
+/**
+ * Runs a $lookup from 'coll' on 'x' for the local documents in 'localDocs', and returns the
+ * '_id' values of the foreign documents found for each of them. The foreign collection answers
+ * every query with all of the documents in 'foreignDocs', so only the documents looked up in the
+ * hash table of the foreign collection, or as part of a batch, are filtered.
+ */
+vector<vector<int>> runHashJoinLookup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                      deque<DocumentSource::GetNextResult> localDocs,
+                                      deque<DocumentSource::GetNextResult> foreignDocs) {
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    const bool removeLeadingQueryStages = true;
+    expCtx->mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(foreignDocs), removeLeadingQueryStages);
+
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {from: 'coll', localField: 'y', foreignField: 'x', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+    auto mockLocalSource = DocumentSourceMock::createForTest(std::move(localDocs), expCtx);
+    docSource->setSource(mockLocalSource.get());
+
+    vector<vector<int>> results;
+    for (auto next = docSource->getNext(); next.isAdvanced(); next = docSource->getNext()) {
+        vector<int> ids;
+        for (auto&& foreignDoc : next.getDocument()["as"].getArray()) {
+            ids.push_back(foreignDoc["_id"].getInt());
+        }
+        results.push_back(std::move(ids));
+    }
+    docSource->dispose();
+    return results;
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldLookUpInForeignHashTableAfterEnoughLookups) {
+    const auto oldBatchSize = internalQueryLookupBatchSize.load();
+    const auto oldMinLookups = internalQueryLookupHashJoinMinLookups.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryLookupBatchSize.store(oldBatchSize);
+        internalQueryLookupHashJoinMinLookups.store(oldMinLookups);
+    });
+    internalQueryLookupBatchSize.store(1);
+    internalQueryLookupHashJoinMinLookups.store(1);
+
+    auto results = runHashJoinLookup(
+        getExpCtx(),
+        {Document{{"y", 1}},
+         Document{{"y", vector<Value>{Value(2), Value(3)}}},
+         Document{{"y", 3.0}},
+         Document{{"y", 5}},
+         Document{{"z", 1}}},
+        {Document{{"_id", 0}, {"x", 1}},
+         Document{{"_id", 1}, {"x", vector<Value>{Value(1), Value(2), Value(2)}}},
+         Document{{"_id", 2}, {"x", 3}},
+         Document{{"_id", 3}}});
+
+    // The first local document is looked up with a query. The following ones are found in the hash
+    // table, apart from the one with a missing local field, which may match missing foreign fields.
+    const vector<vector<int>> expected = {{0, 1, 2, 3}, {1, 2}, {2}, {}, {0, 1, 2, 3}};
+    ASSERT(results == expected);
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldLookUpInForeignHashTableOnMongos) {
+    const auto oldBatchSize = internalQueryLookupBatchSize.load();
+    const auto oldMinLookups = internalQueryLookupHashJoinMinLookups.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryLookupBatchSize.store(oldBatchSize);
+        internalQueryLookupHashJoinMinLookups.store(oldMinLookups);
+    });
+    internalQueryLookupBatchSize.store(1);
+    internalQueryLookupHashJoinMinLookups.store(1);
+
+    auto expCtx = getExpCtx();
+    expCtx->inMongos = true;
+    auto results = runHashJoinLookup(
+        expCtx,
+        {Document{{"y", 1}}, Document{{"y", 2}}, Document{{"y", 3}}},
+        {Document{{"_id", 0}, {"x", 1}}, Document{{"_id", 1}, {"x", 2}}});
+
+    // Only the first local document is looked up with a query, which returns every foreign
+    // document. The following ones are found in the hash table.
+    const vector<vector<int>> expected = {{0, 1}, {1}, {}};
+    ASSERT(results == expected);
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldAbandonForeignHashTableIfMaxMemoryUsageIsExceeded) {
+    const auto oldBatchSize = internalQueryLookupBatchSize.load();
+    const auto oldMinLookups = internalQueryLookupHashJoinMinLookups.load();
+    const auto oldMaxMemoryUsage = internalQueryLookupHashJoinMaxMemoryUsageBytes.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryLookupBatchSize.store(oldBatchSize);
+        internalQueryLookupHashJoinMinLookups.store(oldMinLookups);
+        internalQueryLookupHashJoinMaxMemoryUsageBytes.store(oldMaxMemoryUsage);
+    });
+    internalQueryLookupBatchSize.store(1);
+    internalQueryLookupHashJoinMinLookups.store(0);
+    internalQueryLookupHashJoinMaxMemoryUsageBytes.store(1);
+
+    auto results =
+        runHashJoinLookup(getExpCtx(),
+                          {Document{{"y", 1}}, Document{{"y", 2}}},
+                          {Document{{"_id", 0}, {"x", 1}}, Document{{"_id", 1}, {"x", 2}}});
+
+    const vector<vector<int>> expected = {{0, 1}, {0, 1}};
+    ASSERT(results == expected);
+}
+
+
+TEST_F(DocumentSourceLookUpTest, ShouldLookUpBatchesOfLocalDocumentsWithASingleQuery) {
+    const auto oldBatchSize = internalQueryLookupBatchSize.load();
+    const auto oldEnableHashJoin = internalQueryEnableLookupHashJoin.load();
+    ON_BLOCK_EXIT([&] {
+        internalQueryLookupBatchSize.store(oldBatchSize);
+        internalQueryEnableLookupHashJoin.store(oldEnableHashJoin);
+    });
+    internalQueryLookupBatchSize.store(3);
+    internalQueryEnableLookupHashJoin.store(false);
+
+    auto results = runHashJoinLookup(
+        getExpCtx(),
+        {Document{{"y", 1}},
+         Document{{"y", vector<Value>{Value(1), Value(3)}}},
+         Document{{"y", 2}},
+         Document{{"y", 3}},
+         Document{{"z", 1}},
+         Document{{"y", 5}}},
+        {Document{{"_id", 0}, {"x", 1}},
+         Document{{"_id", 1}, {"x", vector<Value>{Value(2), Value(3)}}},
+         Document{{"_id", 2}}});
+
+    // The foreign documents returned by the query of each batch are handed to the local documents
+    // holding their values. The batch of the fourth document is ended by the document with a
+    // missing local field, which is looked up on its own.
+    const vector<vector<int>> expected = {{0}, {0, 1}, {1}, {1}, {0, 1, 2}, {}};
+    ASSERT(results == expected);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_match.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/exec/document_value/document.h"
@@ -43,6 +44,7 @@
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -76,6 +78,7 @@ intrusive_ptr<DocumentSource> DocumentSourceMatch::optimize() {
     }
 
     _expression = MatchExpression::optimize(std::move(_expression));
+    _compiledExpression.reset();
 
     return this;
 }
@@ -86,14 +89,7 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
 
     auto nextInput = pSource->getNext();
     for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        // MatchExpression only takes BSON documents, so we have to make one. As an optimization,
-        // only serialize the fields we need to do the match.
-        BSONObj toMatch = _dependencies.needWholeDocument
-            ? nextInput.getDocument().toBson()
-            : document_path_support::documentToBsonWithPaths(nextInput.getDocument(),
-                                                             _dependencies.fields);
-
-        if (_expression->matchesBSON(toMatch)) {
+        if (matches(nextInput.getDocument())) {
             return nextInput;
         }
 
@@ -108,6 +104,39 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::doGetNextBatch(
+    std::vector<Document>* batch, size_t maxDocs) {
+    massert(5190260,
+            "Should never call getNextBatch on a $match stage with $text clause",
+            !_isTextQuery);
+
+    // Filter each batch from 'pSource' in place, until one of them has a match or ends the input.
+    const size_t firstInput = batch->size();
+    for (;;) {
+        const auto status = pSource->getNextBatch(batch, maxDocs);
+        batch->erase(std::remove_if(batch->begin() + firstInput,
+                                    batch->end(),
+                                    [&](const Document& doc) { return !matches(doc); }),
+                     batch->end());
+        if (batch->size() > firstInput || status != GetNextResult::ReturnStatus::kAdvanced) {
+            return status;
+        }
+    }
+}
+
+bool DocumentSourceMatch::matches(const Document& doc) const {
+    // MatchExpression only takes BSON documents, so we have to make one. As an optimization, only
+    // serialize the fields we need to do the match.
+    BSONObj toMatch = _dependencies.needWholeDocument
+        ? doc.toBson()
+        : document_path_support::documentToBsonWithPaths(doc, _dependencies.fields);
+    if (!_compiledExpression && internalQueryEnableCompiledMatchExpression.load()) {
+        _compiledExpression = std::make_unique<CompiledMatchExpression>(_expression.get());
+    }
+    return _compiledExpression ? _compiledExpression->matchesBSON(toMatch)
+                               : _expression->matchesBSON(toMatch);
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -387,6 +416,7 @@ DocumentSourceMatch::splitSourceBy(const std::set<std::string>& fields,
                                    const StringMap<std::string>& renames) {
     pair<unique_ptr<MatchExpression>, unique_ptr<MatchExpression>> newExpr(
         expression::splitMatchExpressionBy(std::move(_expression), fields, renames));
+    _compiledExpression.reset();
 
     invariant(newExpr.first || newExpr.second);
 
@@ -505,6 +535,7 @@ DocumentSourceMatch::DocumentSourceMatch(const BSONObj& query,
 
 void DocumentSourceMatch::rebuild(BSONObj filter) {
     _predicate = filter.getOwned();
+    _compiledExpression.reset();
     _expression = uassertStatusOK(MatchExpressionParser::parse(
         _predicate, pExpCtx, ExtensionsCallbackNoop(), Pipeline::kAllowedMatcherFeatures));
     _isTextQuery = isTextQuery(_predicate);
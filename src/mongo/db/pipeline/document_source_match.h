@@ -34,6 +34,7 @@
 #include <utility>
 
 #include "mongo/client/connpool.h"
+#include "mongo/db/matcher/compiled_match_expression.h"
 #include "mongo/db/matcher/matcher.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/util/intrusive_counter.h"
@@ -201,14 +202,25 @@ protected:
               other.pExpCtx) {}
 
     GetNextResult doGetNext() override;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxDocs) override;
     DocumentSourceMatch(const BSONObj& query,
                         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     BSONObj _predicate;
 
 private:
+    /**
+     * Returns whether 'doc' matches '_expression'.
+     */
+    bool matches(const Document& doc) const;
+
     std::unique_ptr<MatchExpression> _expression;
 
+    // Evaluates '_expression', if enabled. Built on the first call to matches(), once the pipeline
+    // has been optimized, and dropped whenever '_expression' changes.
+    mutable std::unique_ptr<CompiledMatchExpression> _compiledExpression;
+
     bool _isTextQuery;
 
     // Cache the dependencies so that we know what fields we need to serialize to BSON for matching.
@@ -632,6 +632,35 @@ TEST_F(DocumentSourceMatchTest, ShouldCorrectlyEvaluateJSONSchemaPredicate) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, ShouldFilterBatchesAndPropagatePauses) {
+    using ReturnStatus = DocumentSource::GetNextResult::ReturnStatus;
+    const auto match = DocumentSourceMatch::create(fromjson("{a: 1}"), getExpCtx());
+    const auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}, {"b", 1}},
+                                           Document{{"a", 2}, {"b", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 2}, {"b", 3}},
+                                           Document{{"a", 1}, {"b", 4}},
+                                           Document{{"a", 3}, {"b", 5}}},
+                                          getExpCtx());
+    match->setSource(mock.get());
+
+    // The documents which don't match are skipped without ending the batch.
+    std::vector<Document> batch;
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 1}}));
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kPauseExecution);
+    ASSERT_EQ(batch.size(), 1U);
+
+    // The batch is appended to.
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 1}, {"b", 4}}));
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+    ASSERT_EQ(batch.size(), 2U);
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldShowOptimizationsInExplainOutputWhenOptimized) {
     const auto match = DocumentSourceMatch::create(fromjson("{$and: [{a: 1}]}"), getExpCtx());
 
@@ -41,6 +41,7 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/variable_validation.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -545,19 +546,26 @@ std::pair<DocumentSourceMerge::BatchObject, int> DocumentSourceMerge::makeBatchO
     return {{std::move(mergeOnFields), std::move(mod), std::move(vars)}, modSize};
 }
 
-void DocumentSourceMerge::spill(BatchedObjects&& batch) try {
-    DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+void DocumentSourceMerge::spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                BatchedObjects&& batch) try {
+    DocumentSourceWriteBlock writeBlock(expCtx->opCtx);
     auto targetEpoch = _targetCollectionVersion
         ? boost::optional<OID>(_targetCollectionVersion->epoch())
         : boost::none;
 
-    _descriptor.strategy(pExpCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
+    _descriptor.strategy(expCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
 } catch (const ExceptionFor<ErrorCodes::ImmutableField>& ex) {
     uassertStatusOKWithContext(ex.toStatus(),
                                "$merge failed to update the matching document, did you "
                                "attempt to modify the _id or the shard key?");
 }
 
+bool DocumentSourceMerge::canWriteBehind() const {
+    // Each batch is written by the merge strategy through the ExpressionContext it is given, and
+    // only reads state of this stage which doesn't change once the stage has started.
+    return internalQueryEnableMergeWriteBehind.load();
+}
+
 void DocumentSourceMerge::waitWhileFailPointEnabled() {
     CurOpFailpointHelpers::waitWhileFailPointEnabled(
         &hangWhileBuildingDocumentSourceMergeBatch,
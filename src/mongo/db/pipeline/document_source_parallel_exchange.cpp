@@ -0,0 +1,332 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_parallel_exchange.h"
+
+#include "mongo/base/init.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_limit.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+// The size of the exchange buffer of each worker. The exchange only loads more documents once one
+// of the buffers is full, while the workers cannot take documents out of theirs, so the buffers are
+// kept small enough for the workers to be handed new documents often.
+constexpr int kWorkerBufferSize = 1024 * 1024;
+
+std::unique_ptr<ThreadPool> parallelExchangeThreadPool;
+
+MONGO_INITIALIZER(ParallelExchangeThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "ParallelExchange";
+    options.threadNamePrefix = "ParallelExchange";
+    options.minThreads = 0;
+    options.maxThreads = 128;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    parallelExchangeThreadPool = std::make_unique<ThreadPool>(options);
+    parallelExchangeThreadPool->startup();
+
+    return Status::OK();
+}
+
+bool isStreamingStage(DocumentSource* stage) {
+    return dynamic_cast<DocumentSourceMatch*>(stage) ||
+        dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage);
+}
+
+bool canRunAfterMerge(DocumentSource* stage) {
+    return isStreamingStage(stage) || dynamic_cast<DocumentSourceGroup*>(stage) ||
+        dynamic_cast<DocumentSourceSort*>(stage) || dynamic_cast<DocumentSourceLimit*>(stage) ||
+        dynamic_cast<DocumentSourceSkip*>(stage);
+}
+
+void serializeStage(const DocumentSource& stage, std::vector<BSONObj>* serialized) {
+    std::vector<Value> values;
+    stage.serializeToArray(values);
+    for (auto&& value : values) {
+        serialized->push_back(value.getDocument().toBson());
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceParallelExchange::parallelizeGroup(
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline, size_t numWorkers) {
+    auto& sources = pipeline->getSources();
+    if (numWorkers <= 1 || sources.empty() ||
+        !dynamic_cast<DocumentSourceCursor*>(sources.front().get())) {
+        return pipeline;
+    }
+
+    auto groupIt = std::next(sources.begin());
+    while (groupIt != sources.end() && isStreamingStage(groupIt->get())) {
+        ++groupIt;
+    }
+    auto group =
+        groupIt != sources.end() ? dynamic_cast<DocumentSourceGroup*>(groupIt->get()) : nullptr;
+    if (!group || group->doingMerge() ||
+        !std::all_of(std::next(groupIt), sources.end(), [](const auto& stage) {
+            return canRunAfterMerge(stage.get());
+        })) {
+        return pipeline;
+    }
+
+    // The workers run the stages up to and including the $group, which outputs partial groups
+    // under their expression contexts, while the merging $group and the stages after it run on top
+    // of this stage.
+    auto distributedPlanLogic = group->distributedPlanLogic();
+    invariant(distributedPlanLogic && distributedPlanLogic->shardsStage.get() == group &&
+              distributedPlanLogic->mergingStage);
+
+    std::vector<BSONObj> workerStages;
+    for (auto it = std::next(sources.begin()); it != std::next(groupIt); ++it) {
+        serializeStage(**it, &workerStages);
+    }
+
+    std::vector<BSONObj> mergeStages;
+    serializeStage(*distributedPlanLogic->mergingStage, &mergeStages);
+    for (auto it = std::next(groupIt); it != sources.end(); ++it) {
+        serializeStage(**it, &mergeStages);
+    }
+
+    // Every pipeline runs under its own expression context, as the contexts are not thread-safe
+    // and the one of the $cursor stage is attached to each worker's operation context in turn.
+    auto expCtx = pipeline->getContext();
+    auto mergeExpCtx = expCtx->copyWith(expCtx->ns, expCtx->uuid);
+    auto mergePipeline = Pipeline::parse(mergeStages, mergeExpCtx);
+    mergePipeline->optimizePipeline();
+
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workerPipelines;
+    for (size_t idx = 0; idx < numWorkers; ++idx) {
+        auto workerExpCtx = expCtx->copyWith(expCtx->ns, expCtx->uuid);
+        workerExpCtx->needsMerge = true;
+        workerPipelines.push_back(Pipeline::parse(workerStages, workerExpCtx));
+        workerPipelines.back()->optimizePipeline();
+    }
+
+    // Leave only the $cursor stage in the pipeline, as the input of the exchange.
+    sources.erase(std::next(sources.begin()), sources.end());
+
+    ExchangeSpec spec(ExchangePolicyEnum::kRoundRobin, static_cast<int32_t>(numWorkers));
+    spec.setBufferSize(kWorkerBufferSize);
+    boost::intrusive_ptr<Exchange> exchange = new Exchange(std::move(spec), std::move(pipeline));
+
+    for (size_t idx = 0; idx < numWorkers; ++idx) {
+        auto& workerPipeline = workerPipelines[idx];
+        workerPipeline->addInitialSource(
+            new DocumentSourceExchange(workerPipeline->getContext(), exchange, idx, nullptr));
+    }
+
+    mergePipeline->addInitialSource(make_intrusive<DocumentSourceParallelExchange>(
+        mergeExpCtx, std::move(exchange), std::move(workerPipelines)));
+    return mergePipeline;
+}
+
+DocumentSourceParallelExchange::DocumentSourceParallelExchange(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    boost::intrusive_ptr<Exchange> exchange,
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers)
+    : DocumentSource(kStageName, expCtx),
+      _exchange(std::move(exchange)),
+      _workers(std::move(workers)),
+      _workerOpCtxs(_workers.size(), nullptr) {}
+
+const char* DocumentSourceParallelExchange::getSourceName() const {
+    return kStageName.rawData();
+}
+
+Value DocumentSourceParallelExchange::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(DOC(getSourceName() << DOC(
+                         "workers" << static_cast<long long>(_exchange->getConsumers()))));
+}
+
+void DocumentSourceParallelExchange::detachFromOperationContext() {
+    for (auto&& worker : _workers) {
+        if (worker) {
+            worker->detachFromOperationContext();
+        }
+    }
+}
+
+void DocumentSourceParallelExchange::reattachToOperationContext(OperationContext* opCtx) {
+    for (auto&& worker : _workers) {
+        if (worker) {
+            worker->reattachToOperationContext(opCtx);
+        }
+    }
+}
+
+DocumentSource::GetNextResult DocumentSourceParallelExchange::doGetNext() {
+    if (!_ranWorkers) {
+        _ranWorkers = true;
+        runWorkers();
+    }
+
+    if (_results.empty()) {
+        return GetNextResult::makeEOF();
+    }
+
+    auto next = std::move(_results.front());
+    _results.pop_front();
+    return next;
+}
+
+void DocumentSourceParallelExchange::doDispose() {
+    // Disposing of the workers which never ran disposes of the exchange's input as well.
+    for (auto&& worker : _workers) {
+        if (worker) {
+            worker->dispose(pExpCtx->opCtx);
+            worker.get_deleter().dismissDisposal();
+            worker.reset();
+        }
+    }
+}
+
+void DocumentSourceParallelExchange::runWorkers() {
+    auto opCtx = pExpCtx->opCtx;
+
+    // Every worker runs under its own operation context. Make the workers read at the
+    // operation's read timestamp, if it has one, and give them its time limit.
+    const auto readTimestamp = opCtx->recoveryUnit()->getPointInTimeReadTimestamp();
+    const auto deadline = opCtx->getDeadline();
+    const auto timeoutError = opCtx->getTimeoutError();
+
+    std::vector<Future<std::vector<Document>>> futures;
+    for (size_t idx = 0; idx < _workers.size(); ++idx) {
+        auto pf = makePromiseFuture<std::vector<Document>>();
+        parallelExchangeThreadPool->schedule(
+            [this, idx, readTimestamp, deadline, timeoutError, promise = std::move(pf.promise)](
+                auto status) mutable {
+                invariant(status);
+
+                auto workerOpCtx = cc().makeOperationContext();
+                if (readTimestamp) {
+                    workerOpCtx->recoveryUnit()->setTimestampReadSource(
+                        RecoveryUnit::ReadSource::kProvided, readTimestamp);
+                }
+                if (deadline != Date_t::max()) {
+                    workerOpCtx->setDeadlineByDate(deadline, timeoutError);
+                }
+
+                promise.setWith([&] { return runWorker(workerOpCtx.get(), idx); });
+            });
+        futures.push_back(std::move(pf.future));
+    }
+
+    // If the operation is interrupted, interrupt the workers, which may be waiting for each other,
+    // and wait for all of them to stop before returning.
+    Status interruptStatus = Status::OK();
+    for (auto&& future : futures) {
+        if (!interruptStatus.isOK()) {
+            break;
+        }
+        interruptStatus = future.waitNoThrow(opCtx);
+        if (!interruptStatus.isOK()) {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _killCode = interruptStatus.code();
+            for (auto workerOpCtx : _workerOpCtxs) {
+                if (workerOpCtx) {
+                    stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+                    workerOpCtx->getServiceContext()->killOperation(
+                        clientLock, workerOpCtx, *_killCode);
+                }
+            }
+        }
+    }
+
+    // A worker which fails makes the others fail with ExchangePassthrough, so report the error of
+    // the worker which failed first.
+    Status workerStatus = Status::OK();
+    std::vector<std::vector<Document>> workerResults;
+    for (auto&& future : futures) {
+        auto swResults = future.getNoThrow();
+        if (swResults.isOK()) {
+            workerResults.push_back(std::move(swResults.getValue()));
+        } else if (workerStatus.isOK() ||
+                   workerStatus.code() == ErrorCodes::ExchangePassthrough) {
+            workerStatus = swResults.getStatus();
+        }
+    }
+    uassertStatusOK(interruptStatus);
+    uassertStatusOK(workerStatus);
+
+    for (auto&& results : workerResults) {
+        std::move(results.begin(), results.end(), std::back_inserter(_results));
+    }
+}
+
+std::vector<Document> DocumentSourceParallelExchange::runWorker(OperationContext* opCtx,
+                                                                size_t idx) {
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_killCode) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_killCode);
+        }
+        _workerOpCtxs[idx] = opCtx;
+    }
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _workerOpCtxs[idx] = nullptr;
+    });
+
+    // Once disposed of, a worker no longer blocks the exchange from loading documents for the
+    // others, even if it stopped because of an error.
+    auto& pipeline = _workers[idx];
+    pipeline->reattachToOperationContext(opCtx);
+    ON_BLOCK_EXIT([&] {
+        pipeline->dispose(opCtx);
+        pipeline.get_deleter().dismissDisposal();
+        pipeline.reset();
+    });
+
+    std::vector<Document> results;
+    while (auto next = pipeline->getNext()) {
+        results.push_back(std::move(*next));
+    }
+    return results;
+}
+
+}  // namespace mongo
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * Runs a number of worker pipelines concurrently on their own threads, and returns what all of
+ * them produce in no particular order. The workers read their input from the consumers of a
+ * round robin Exchange, which distributes the documents of the stages below it among them.
+ *
+ * This is how a $group over a collection scan is spread over several cores of a single node: each
+ * worker runs the streaming stages before the $group and a partial $group over its share of the
+ * documents, and the partial groups are merged by a merging $group after this stage.
+ */
+class DocumentSourceParallelExchange final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalParallelExchange"_sd;
+
+    /**
+     * Returns a pipeline which computes the same results as 'pipeline' with 'numWorkers' threads,
+     * if 'pipeline' consists of an initial $cursor stage, any number of $match and single document
+     * transformation stages, and a $group, optionally followed by other streaming or sorting
+     * stages. Otherwise 'pipeline' is returned unchanged.
+     *
+     * The stages before the $group and the partial $group are run by the workers. The $group's
+     * merging stage and the stages after it are run by the returned pipeline, on top of a
+     * DocumentSourceParallelExchange.
+     */
+    static std::unique_ptr<Pipeline, PipelineDeleter> parallelizeGroup(
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline, size_t numWorkers);
+
+    DocumentSourceParallelExchange(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                   boost::intrusive_ptr<Exchange> exchange,
+                                   std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> workers);
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        StageConstraints constraints(StreamType::kBlocking,
+                                     PositionRequirement::kFirst,
+                                     HostTypeRequirement::kNone,
+                                     DiskUseRequirement::kNoDiskUse,
+                                     FacetRequirement::kNotAllowed,
+                                     TransactionRequirement::kNotAllowed,
+                                     LookupRequirement::kNotAllowed,
+                                     UnionRequirement::kNotAllowed);
+        constraints.requiresInputDocSource = false;
+        return constraints;
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    const char* getSourceName() const final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    void setSource(DocumentSource* source) final {
+        invariant(!source);
+    }
+
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+private:
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Runs all of the worker pipelines to completion and collects their results into '_results'.
+     * If the operation is interrupted while waiting for the workers, interrupts the workers too.
+     */
+    void runWorkers();
+
+    /**
+     * Runs the worker pipeline with the given index under 'opCtx' and returns its results.
+     */
+    std::vector<Document> runWorker(OperationContext* opCtx, size_t idx);
+
+    boost::intrusive_ptr<Exchange> _exchange;
+
+    // The pipelines which the workers run. A worker releases its pipeline after running it.
+    std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> _workers;
+
+    // Protects '_workerOpCtxs', through which the workers are interrupted.
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceParallelExchange::_mutex");
+    std::vector<OperationContext*> _workerOpCtxs;
+    boost::optional<ErrorCodes::Error> _killCode;
+
+    bool _ranWorkers{false};
+    std::deque<Document> _results;
+};
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_query_shape_stats.h"
+
+namespace mongo {
+
+REGISTER_DOCUMENT_SOURCE(queryShapeStats,
+                         DocumentSourceQueryShapeStats::LiteParsed::parse,
+                         DocumentSourceQueryShapeStats::createFromBson);
+
+boost::intrusive_ptr<DocumentSource> DocumentSourceQueryShapeStats::createFromBson(
+    BSONElement spec, const boost::intrusive_ptr<ExpressionContext>& pExpCtx) {
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName
+                          << " value must be an object. Found: " << typeName(spec.type()),
+            spec.type() == BSONType::Object);
+
+    uassert(ErrorCodes::FailedToParse,
+            str::stream() << kStageName << " parameters object must be empty. Found: "
+                          << spec.embeddedObject(),
+            spec.embeddedObject().isEmpty());
+
+    return new DocumentSourceQueryShapeStats(pExpCtx);
+}
+
+DocumentSourceQueryShapeStats::DocumentSourceQueryShapeStats(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx)
+    : DocumentSource(kStageName, expCtx) {}
+
+DocumentSource::GetNextResult DocumentSourceQueryShapeStats::doGetNext() {
+    if (!_haveRetrievedStats) {
+        _results = pExpCtx->mongoProcessInterface->getQueryShapeStats(pExpCtx->opCtx, pExpCtx->ns);
+        _resultsIter = _results.begin();
+        _haveRetrievedStats = true;
+    }
+
+    if (_resultsIter == _results.end()) {
+        return GetNextResult::makeEOF();
+    }
+
+    MutableDocument nextQueryShape{Document{*_resultsIter++}};
+
+    // Augment each query shape with this node's host and port string.
+    if (_hostAndPort.empty()) {
+        _hostAndPort = pExpCtx->mongoProcessInterface->getHostAndPort(pExpCtx->opCtx);
+        uassert(5191050,
+                "Unable to retrieve host name for $queryShapeStats pipeline stage.",
+                !_hostAndPort.empty());
+    }
+    nextQueryShape.setField("host", Value{_hostAndPort});
+
+    // If we're returning results to mongos, then additionally augment each query shape with the
+    // shard name, for the node from which we're collecting the statistics.
+    if (pExpCtx->fromMongos) {
+        if (_shardName.empty()) {
+            _shardName = pExpCtx->mongoProcessInterface->getShardName(pExpCtx->opCtx);
+            uassert(5191051,
+                    "Aggregation request specified 'fromMongos' but unable to retrieve shard name "
+                    "for $queryShapeStats pipeline stage.",
+                    !_shardName.empty());
+        }
+        nextQueryShape.setField("shard", Value{_shardName});
+    }
+
+    return nextQueryShape.freeze();
+}
+
+}  // namespace mongo
@@ -0,0 +1,501 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+using std::list;
+using std::vector;
+
+REGISTER_MULTI_STAGE_ALIAS(setWindowFields,
+                           LiteParsedDocumentSourceDefault::parse,
+                           DocumentSourceSetWindowFields::createFromBson);
+
+REGISTER_DOCUMENT_SOURCE(_internalSetWindowFields,
+                         LiteParsedDocumentSourceDefault::parse,
+                         DocumentSourceInternalSetWindowFields::createFromBson);
+
+namespace {
+
+constexpr StringData kPartitionByField = "partitionBy"_sd;
+constexpr StringData kSortByField = "sortBy"_sd;
+constexpr StringData kOutputField = "output"_sd;
+constexpr StringData kWindowField = "window"_sd;
+constexpr StringData kDocumentsField = "documents"_sd;
+constexpr StringData kUnbounded = "unbounded"_sd;
+constexpr StringData kCurrent = "current"_sd;
+
+BSONObj getSpecObject(const BSONElement& elem) {
+    uassert(5190313,
+            str::stream() << "The argument to " << elem.fieldNameStringData()
+                          << " must be an object, but found type: " << typeName(elem.type()),
+            elem.type() == BSONType::Object);
+    return elem.embeddedObject();
+}
+
+/**
+ * Parses one bound of a window. An unbounded bound is returned as boost::none.
+ */
+boost::optional<long long> parseWindowBound(const BSONElement& elem, bool isLower) {
+    if (elem.type() == BSONType::String) {
+        const auto bound = elem.valueStringData();
+        if (bound == kCurrent) {
+            return 0LL;
+        }
+        if (bound == kUnbounded && isLower) {
+            return boost::none;
+        }
+    } else if (Value bound(elem); bound.integral64Bit()) {
+        return bound.coerceToLong();
+    }
+    uasserted(5190318,
+              str::stream() << "The " << (isLower ? "lower" : "upper")
+                            << " bound of a $setWindowFields window must be "
+                            << (isLower ? "'unbounded', 'current' or an integer"
+                                        : "'current' or an integer")
+                            << ", but found: " << elem.toString(false, false));
+}
+
+/**
+ * Parses a window of the form {documents: [<lower>, <upper>]}.
+ */
+DocumentSourceInternalSetWindowFields::WindowBounds parseWindowBounds(const BSONElement& elem) {
+    const bool isDocumentsWindow = elem.type() == BSONType::Object &&
+        elem.embeddedObject().nFields() == 1 &&
+        elem.embeddedObject().firstElementFieldNameStringData() == kDocumentsField &&
+        elem.embeddedObject().firstElement().type() == BSONType::Array &&
+        elem.embeddedObject().firstElement().embeddedObject().nFields() == 2;
+    uassert(5190317,
+            str::stream() << "A $setWindowFields window must be of the form {" << kDocumentsField
+                          << ": [<lower>, <upper>]}, but found: " << elem.toString(false, false),
+            isDocumentsWindow);
+
+    auto bounds = elem.embeddedObject().firstElement().embeddedObject();
+    DocumentSourceInternalSetWindowFields::WindowBounds window;
+    window.lower = parseWindowBound(bounds["0"], true);
+    window.upper = *parseWindowBound(bounds["1"], false);
+    uassert(5190319,
+            str::stream() << "The lower bound of a $setWindowFields window must not be greater "
+                             "than its upper bound, but found: "
+                          << elem.toString(false, false),
+            !window.lower || *window.lower <= window.upper);
+    return window;
+}
+
+/**
+ * Parses an output field of the form {<accumulator>: <argument>, window: <window>}.
+ */
+DocumentSourceInternalSetWindowFields::WindowField parseWindowField(
+    ExpressionContext* const expCtx, const BSONElement& elem, const VariablesParseState& vps) {
+    FieldPath path(elem.fieldNameStringData());
+
+    BSONElement accumulatorElem;
+    BSONElement windowElem;
+    bool isValid = elem.type() == BSONType::Object;
+    for (auto&& specElem : isValid ? elem.embeddedObject() : BSONObj()) {
+        if (specElem.fieldNameStringData() == kWindowField && windowElem.eoo()) {
+            windowElem = specElem;
+        } else if (specElem.fieldNameStringData()[0] == '$' && accumulatorElem.eoo() &&
+                   specElem.type() != BSONType::Array) {
+            accumulatorElem = specElem;
+        } else {
+            isValid = false;
+        }
+    }
+    uassert(5190316,
+            str::stream() << "The $setWindowFields output field '" << path.fullPath()
+                          << "' must be an object with one unary accumulator and an optional '"
+                          << kWindowField << "', but found: " << elem.toString(false, false),
+            isValid && !accumulatorElem.eoo());
+
+    auto&& parser = AccumulationStatement::getParser(accumulatorElem.fieldNameStringData(),
+                                                     expCtx->maxFeatureCompatibilityVersion);
+    auto [initializer, argument, factory] = parser(expCtx, accumulatorElem, vps);
+
+    DocumentSourceInternalSetWindowFields::WindowBounds bounds;
+    if (!windowElem.eoo()) {
+        bounds = parseWindowBounds(windowElem);
+    }
+    return {path,
+            AccumulationStatement(path.fullPath(),
+                                  AccumulationExpression(initializer, argument, factory)),
+            bounds};
+}
+
+}  // namespace
+
+list<intrusive_ptr<DocumentSource>> DocumentSourceSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    auto spec = getSpecObject(elem);
+
+    // The $sort puts the documents of each partition together, then orders them by 'sortBy'.
+    BSONObj sortBy;
+    boost::optional<std::string> partitionPath;
+    BSONObjBuilder internalSpec;
+    for (auto&& argument : spec) {
+        const auto argName = argument.fieldNameStringData();
+        if (kSortByField == argName) {
+            sortBy = argument.embeddedObjectUserCheck();
+        } else {
+            if (kPartitionByField == argName) {
+                const auto path = argument.type() == BSONType::String
+                    ? argument.valueStringData()
+                    : StringData();
+                uassert(5190312,
+                        str::stream() << "The $setWindowFields '" << kPartitionByField
+                                      << "' field must be a $-prefixed path, but found: "
+                                      << argument.toString(false, false),
+                        path.startsWith("$") && !path.startsWith("$$"));
+                partitionPath = path.substr(1).toString();
+            }
+            internalSpec.append(argument);
+        }
+    }
+
+    list<intrusive_ptr<DocumentSource>> stages;
+    if (partitionPath || !sortBy.isEmpty()) {
+        BSONObjBuilder sortPattern;
+        if (partitionPath) {
+            auto direction = sortBy[*partitionPath];
+            sortPattern.append(*partitionPath, direction ? direction.numberInt() : 1);
+        }
+        for (auto&& sortElem : sortBy) {
+            if (!partitionPath || sortElem.fieldNameStringData() != *partitionPath) {
+                sortPattern.append(sortElem);
+            }
+        }
+        stages.push_back(DocumentSourceSort::create(pExpCtx, sortPattern.obj()));
+    }
+
+    auto internalSpecObj = BSON(DocumentSourceInternalSetWindowFields::kStageName
+                                << internalSpec.obj());
+    stages.push_back(DocumentSourceInternalSetWindowFields::createFromBson(
+        internalSpecObj.firstElement(), pExpCtx));
+    return stages;
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    auto spec = getSpecObject(elem);
+
+    VariablesParseState vps = pExpCtx->variablesParseState;
+    intrusive_ptr<Expression> partitionBy;
+    BSONElement outputSpec;
+    for (auto&& argument : spec) {
+        const auto argName = argument.fieldNameStringData();
+        if (kPartitionByField == argName) {
+            partitionBy = Expression::parseOperand(pExpCtx.get(), argument, vps);
+        } else if (kOutputField == argName) {
+            outputSpec = argument;
+        } else {
+            uasserted(5190314,
+                      str::stream() << "Unrecognized option to $setWindowFields: " << argName);
+        }
+    }
+    uassert(5190315,
+            str::stream() << "$setWindowFields requires '" << kOutputField
+                          << "' to be specified as a non-empty object, but found: "
+                          << outputSpec.toString(false, false),
+            outputSpec.type() == BSONType::Object && !outputSpec.embeddedObject().isEmpty());
+
+    vector<WindowField> outputFields;
+    for (auto&& outputElem : outputSpec.embeddedObject()) {
+        outputFields.push_back(parseWindowField(pExpCtx.get(), outputElem, vps));
+    }
+    return create(pExpCtx, std::move(partitionBy), std::move(outputFields));
+}
+
+intrusive_ptr<DocumentSourceInternalSetWindowFields> DocumentSourceInternalSetWindowFields::create(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    intrusive_ptr<Expression> partitionBy,
+    vector<WindowField> outputFields) {
+    return new DocumentSourceInternalSetWindowFields(
+        expCtx, std::move(partitionBy), std::move(outputFields));
+}
+
+DocumentSourceInternalSetWindowFields::DocumentSourceInternalSetWindowFields(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    intrusive_ptr<Expression> partitionBy,
+    vector<WindowField> outputFields)
+    : DocumentSource(kStageName, expCtx),
+      _partitionBy(std::move(partitionBy)),
+      _outputFields(std::move(outputFields)),
+      _maxMemoryUsageBytes(internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load()) {
+    invariant(!_outputFields.empty());
+    _runningAccumulators.resize(_outputFields.size());
+    _lastProcessed.resize(_outputFields.size(), -1);
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        const auto& bounds = _outputFields[i].bounds;
+        _maxFollowingOffset = std::max(_maxFollowingOffset, bounds.upper);
+        // A running accumulator only needs the documents it hasn't processed yet, which start at
+        // the upper bound of the window of the next document.
+        _minBufferedOffset = std::min(_minBufferedOffset, bounds.lower.value_or(bounds.upper));
+    }
+}
+
+Value DocumentSourceInternalSetWindowFields::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    MutableDocument spec;
+    if (_partitionBy) {
+        spec[kPartitionByField] = _partitionBy->serialize(static_cast<bool>(explain));
+    }
+
+    MutableDocument outputSpec(_outputFields.size());
+    for (auto&& field : _outputFields) {
+        const auto& expr = field.accumulation.expr;
+        MutableDocument fieldSpec(field.accumulation.makeAccumulator()->serialize(
+            expr.initializer, expr.argument, static_cast<bool>(explain)));
+        auto lower = field.bounds.lower ? Value(*field.bounds.lower) : Value(kUnbounded);
+        fieldSpec[kWindowField] =
+            Value(Document{{kDocumentsField, vector<Value>{lower, Value(field.bounds.upper)}}});
+        outputSpec.addField(field.path.fullPath(), fieldSpec.freezeToValue());
+    }
+    spec[kOutputField] = outputSpec.freezeToValue();
+
+    return Value(Document{{getSourceName(), spec.freezeToValue()}});
+}
+
+DepsTracker::State DocumentSourceInternalSetWindowFields::getDependencies(
+    DepsTracker* deps) const {
+    if (_partitionBy) {
+        _partitionBy->addDependencies(deps);
+    }
+    for (auto&& field : _outputFields) {
+        field.accumulation.expr.argument->addDependencies(deps);
+        field.accumulation.expr.initializer->addDependencies(deps);
+    }
+    return DepsTracker::State::SEE_NEXT;
+}
+
+DocumentSource::GetModPathsReturn DocumentSourceInternalSetWindowFields::getModifiedPaths() const {
+    std::set<std::string> modifiedPaths;
+    for (auto&& field : _outputFields) {
+        modifiedPaths.insert(field.path.fullPath());
+    }
+    return {GetModPathsReturn::Type::kFiniteSet, std::move(modifiedPaths), {}};
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::optimize() {
+    if (_partitionBy) {
+        _partitionBy = _partitionBy->optimize();
+    }
+    for (auto&& field : _outputFields) {
+        field.accumulation.expr.argument = field.accumulation.expr.argument->optimize();
+        field.accumulation.expr.initializer = field.accumulation.expr.initializer->optimize();
+    }
+    return this;
+}
+
+DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext() {
+    while (true) {
+        if (canOutputNextDocument()) {
+            return outputNextDocument();
+        }
+
+        if (_partitionEnded) {
+            if (!_nextPartition) {
+                return GetNextResult::makeEOF();
+            }
+            startNextPartition();
+            continue;
+        }
+
+        auto next = pSource->getNext();
+        if (next.isPaused()) {
+            return next;
+        }
+        if (next.isEOF()) {
+            _partitionEnded = true;
+            continue;
+        }
+
+        auto doc = next.releaseDocument();
+        auto key = getPartitionKey(doc);
+        if (_partitionKey && pExpCtx->getValueComparator().evaluate(*_partitionKey != key)) {
+            _nextPartition.emplace(std::move(key), std::move(doc));
+            _partitionEnded = true;
+            continue;
+        }
+        _partitionKey = std::move(key);
+        bufferDocument(std::move(doc));
+    }
+}
+
+Value DocumentSourceInternalSetWindowFields::getPartitionKey(const Document& doc) {
+    if (!_partitionBy) {
+        return Value(BSONNULL);
+    }
+
+    auto key = _partitionBy->evaluate(doc, &pExpCtx->variables);
+    // A $sort orders an array by one of its elements, so the documents of a partition on an array
+    // may not be next to each other.
+    uassert(5190311,
+            str::stream() << "The $setWindowFields '" << kPartitionByField
+                          << "' expression must not evaluate to an array, but found: "
+                          << key.toString(),
+            !key.isArray());
+    return key.missing() ? Value(BSONNULL) : std::move(key);
+}
+
+void DocumentSourceInternalSetWindowFields::bufferDocument(Document doc) {
+    BufferedDocument buffered{std::move(doc), {}, 0};
+    buffered.arguments.reserve(_outputFields.size());
+    buffered.memUsageBytes = buffered.doc.getApproximateSize();
+    for (auto&& field : _outputFields) {
+        buffered.arguments.push_back(
+            field.accumulation.expr.argument->evaluate(buffered.doc, &pExpCtx->variables));
+        buffered.memUsageBytes += buffered.arguments.back().getApproximateSize();
+    }
+
+    _memUsageBytes += buffered.memUsageBytes;
+    _buffer.push_back(std::move(buffered));
+    checkMemoryUsage();
+}
+
+void DocumentSourceInternalSetWindowFields::startNextPartition() {
+    invariant(_nextPartition);
+    invariant(_nextOutputPosition == _bufferStart + static_cast<long long>(_buffer.size()));
+
+    _buffer.clear();
+    _bufferStart = 0;
+    _nextOutputPosition = 0;
+    _memUsageBytes = 0;
+    std::fill(_runningAccumulators.begin(), _runningAccumulators.end(), nullptr);
+    std::fill(_lastProcessed.begin(), _lastProcessed.end(), -1);
+
+    _partitionKey = std::move(_nextPartition->first);
+    auto doc = std::move(_nextPartition->second);
+    _nextPartition = boost::none;
+    _partitionEnded = false;
+    bufferDocument(std::move(doc));
+}
+
+bool DocumentSourceInternalSetWindowFields::canOutputNextDocument() const {
+    const auto end = _bufferStart + static_cast<long long>(_buffer.size());
+    return _nextOutputPosition < end &&
+        (_partitionEnded || _nextOutputPosition + _maxFollowingOffset < end);
+}
+
+Document DocumentSourceInternalSetWindowFields::outputNextDocument() {
+    const auto position = _nextOutputPosition++;
+    const auto lastPosition = _bufferStart + static_cast<long long>(_buffer.size()) - 1;
+
+    MutableDocument output(_buffer[position - _bufferStart].doc);
+    for (size_t i = 0; i < _outputFields.size(); ++i) {
+        output.setNestedField(_outputFields[i].path,
+                              computeWindowValue(i, position, lastPosition));
+    }
+    checkMemoryUsage();
+
+    // Drop the documents which none of the windows of the next documents include.
+    while (!_buffer.empty() && _bufferStart < _nextOutputPosition + _minBufferedOffset) {
+        _memUsageBytes -= _buffer.front().memUsageBytes;
+        _buffer.pop_front();
+        ++_bufferStart;
+    }
+    return output.freeze();
+}
+
+Value DocumentSourceInternalSetWindowFields::computeWindowValue(size_t fieldIndex,
+                                                                long long position,
+                                                                long long lastPosition) {
+    const auto& field = _outputFields[fieldIndex];
+    const auto upper = std::min(position + field.bounds.upper, lastPosition);
+    auto process = [&](const intrusive_ptr<AccumulatorState>& accumulator, long long first) {
+        for (auto i = first; i <= upper; ++i) {
+            accumulator->process(_buffer[i - _bufferStart].arguments[fieldIndex], false);
+        }
+    };
+    auto makeAccumulator = [&] {
+        auto accumulator = field.accumulation.makeAccumulator();
+        // As in $bucketAuto, there is no group key for the initializer to refer to.
+        accumulator->startNewGroup(
+            field.accumulation.expr.initializer->evaluate(Document{}, &pExpCtx->variables));
+        return accumulator;
+    };
+
+    Value value;
+    if (!field.bounds.lower) {
+        // Windows which start at the beginning of the partition only grow from one document to
+        // the next, so their accumulator processes each document once.
+        auto& accumulator = _runningAccumulators[fieldIndex];
+        if (!accumulator) {
+            accumulator = makeAccumulator();
+        }
+        process(accumulator, _lastProcessed[fieldIndex] + 1);
+        _lastProcessed[fieldIndex] = std::max(_lastProcessed[fieldIndex], upper);
+        value = accumulator->getValue(false);
+    } else {
+        auto accumulator = makeAccumulator();
+        process(accumulator, std::max(position + *field.bounds.lower, 0LL));
+        value = accumulator->getValue(false);
+    }
+
+    // To be consistent with the $group stage, we consider "missing" to be equivalent to null when
+    // evaluating accumulators.
+    return value.missing() ? Value(BSONNULL) : value;
+}
+
+void DocumentSourceInternalSetWindowFields::checkMemoryUsage() const {
+    auto memUsageBytes = _memUsageBytes;
+    for (auto&& accumulator : _runningAccumulators) {
+        if (accumulator) {
+            memUsageBytes += accumulator->memUsageForSorter();
+        }
+    }
+    uassert(5190310,
+            str::stream() << "$setWindowFields exceeded its memory limit of "
+                          << _maxMemoryUsageBytes
+                          << " bytes. Use narrower windows, or accumulators which keep less state",
+            memUsageBytes <= _maxMemoryUsageBytes);
+}
+
+void DocumentSourceInternalSetWindowFields::doDispose() {
+    _buffer.clear();
+    _memUsageBytes = 0;
+    std::fill(_runningAccumulators.begin(), _runningAccumulators.end(), nullptr);
+    _nextPartition = boost::none;
+    _partitionEnded = true;
+}
+
+}  // namespace mongo
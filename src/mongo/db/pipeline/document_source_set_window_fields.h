@@ -0,0 +1,210 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <vector>
+
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * The $setWindowFields stage is an alias for a $sort on its 'partitionBy' and 'sortBy' fields,
+ * followed by a $_internalSetWindowFields stage which computes the window fields over the sorted
+ * input. The $sort is left out when neither field is specified. As an ordinary $sort, it coalesces
+ * with an earlier $sort of the pipeline and can be answered by an index once pushed down.
+ */
+class DocumentSourceSetWindowFields final {
+public:
+    static constexpr StringData kStageName = "$setWindowFields"_sd;
+
+    /**
+     * Returns the $sort stage, if any, followed by the $_internalSetWindowFields stage.
+     */
+    static std::list<boost::intrusive_ptr<DocumentSource>> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+private:
+    // It is illegal to construct a DocumentSourceSetWindowFields directly, use createFromBson()
+    // instead.
+    DocumentSourceSetWindowFields() = default;
+};
+
+/**
+ * Adds to each document the values of accumulators over a window of the documents of its
+ * partition. The input must be sorted so that the documents of each partition are next to each
+ * other, in the order the windows are defined over.
+ *
+ * A window is given by offsets from the position of the current document within the partition. A
+ * window which starts at the beginning of the partition is accumulated incrementally as the stage
+ * moves through the partition, while any other window is accumulated over the documents buffered
+ * for it. The stage only buffers the documents its widest window spans, so its memory use doesn't
+ * grow with the size of its partitions.
+ */
+class DocumentSourceInternalSetWindowFields final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalSetWindowFields"_sd;
+
+    /**
+     * The offsets of the first and last documents of a window from the current document. No
+     * 'lower' offset means the window starts at the beginning of the partition.
+     */
+    struct WindowBounds {
+        boost::optional<long long> lower;
+        long long upper = 0;
+    };
+
+    /**
+     * A field set to the value of an accumulator over a window of documents.
+     */
+    struct WindowField {
+        FieldPath path;
+        AccumulationStatement accumulation;
+        WindowBounds bounds;
+    };
+
+    static boost::intrusive_ptr<DocumentSourceInternalSetWindowFields> create(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        boost::intrusive_ptr<Expression> partitionBy,
+        std::vector<WindowField> outputFields);
+
+    /**
+     * Parses a $_internalSetWindowFields stage from the user-supplied BSON.
+     */
+    static boost::intrusive_ptr<DocumentSource> createFromBson(
+        BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
+
+    const char* getSourceName() const final {
+        return kStageName.rawData();
+    }
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kStreaming,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kNoDiskUse,
+                FacetRequirement::kAllowed,
+                TransactionRequirement::kAllowed,
+                LookupRequirement::kAllowed,
+                UnionRequirement::kAllowed};
+    }
+
+    /**
+     * The windows span all the documents of a partition, so the stage must run on the merging
+     * shard, after the sort which puts the partitions together.
+     */
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return DistributedPlanLogic{nullptr, this, boost::none};
+    }
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+    DepsTracker::State getDependencies(DepsTracker* deps) const final;
+    GetModPathsReturn getModifiedPaths() const final;
+    boost::intrusive_ptr<DocumentSource> optimize() final;
+
+protected:
+    GetNextResult doGetNext() final;
+    void doDispose() final;
+
+private:
+    // A buffered document, along with the arguments of each of the accumulators for it.
+    struct BufferedDocument {
+        Document doc;
+        std::vector<Value> arguments;
+        size_t memUsageBytes;
+    };
+
+    DocumentSourceInternalSetWindowFields(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                          boost::intrusive_ptr<Expression> partitionBy,
+                                          std::vector<WindowField> outputFields);
+
+    /**
+     * Returns the value of the 'partitionBy' expression for 'doc', with missing treated as null.
+     */
+    Value getPartitionKey(const Document& doc);
+
+    void bufferDocument(Document doc);
+
+    /**
+     * Clears the state of the finished partition and starts the next one with '_nextPartition'.
+     */
+    void startNextPartition();
+
+    /**
+     * Returns whether every document of the window of the next document to output is buffered.
+     */
+    bool canOutputNextDocument() const;
+
+    Document outputNextDocument();
+
+    /**
+     * Returns the value of the accumulator of the field at 'fieldIndex' over its window around the
+     * document at 'position', where 'lastPosition' is the position of the last buffered document.
+     */
+    Value computeWindowValue(size_t fieldIndex, long long position, long long lastPosition);
+
+    void checkMemoryUsage() const;
+
+    boost::intrusive_ptr<Expression> _partitionBy;
+    std::vector<WindowField> _outputFields;
+
+    // The accumulators of the fields whose windows start at the beginning of the partition, or
+    // null for the other fields, and the position of the last document each of them has processed.
+    std::vector<boost::intrusive_ptr<AccumulatorState>> _runningAccumulators;
+    std::vector<long long> _lastProcessed;
+
+    // The furthest offset any window reaches past the current document, and the lowest offset of a
+    // document which must be kept buffered for the windows of the next documents, which is never
+    // greater than zero.
+    long long _maxFollowingOffset = 0;
+    long long _minBufferedOffset = 0;
+
+    // The buffered documents of the current partition, starting at position '_bufferStart'.
+    std::deque<BufferedDocument> _buffer;
+    long long _bufferStart = 0;
+    long long _nextOutputPosition = 0;
+    size_t _memUsageBytes = 0;
+    const size_t _maxMemoryUsageBytes;
+
+    boost::optional<Value> _partitionKey;
+    bool _partitionEnded = false;
+
+    // The first document of the next partition, with its partition key, read while looking for the
+    // end of the current one.
+    boost::optional<std::pair<Value, Document>> _nextPartition;
+};
+
+}  // namespace mongo
@@ -0,0 +1,289 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <deque>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_set_window_fields.h"
+#include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+using boost::intrusive_ptr;
+using std::deque;
+using std::vector;
+
+class SetWindowFieldsTest : public AggregationContextFixture {
+public:
+    std::list<intrusive_ptr<DocumentSource>> parse(const char* spec) {
+        auto specObj = fromjson(spec);
+        return DocumentSourceSetWindowFields::createFromBson(specObj.firstElement(), getExpCtx());
+    }
+
+    /**
+     * Runs the $_internalSetWindowFields stage of 'spec' over 'inputs', which must already be in
+     * the order of its $sort.
+     */
+    vector<Document> getResults(const char* spec, deque<DocumentSource::GetNextResult> inputs) {
+        auto stage = parse(spec).back();
+        ASSERT(dynamic_cast<DocumentSourceInternalSetWindowFields*>(stage.get()));
+        auto source = DocumentSourceMock::createForTest(std::move(inputs), getExpCtx());
+        stage->setSource(source.get());
+
+        vector<Document> results;
+        for (auto next = stage->getNext(); !next.isEOF(); next = stage->getNext()) {
+            if (next.isAdvanced()) {
+                results.push_back(next.releaseDocument());
+            }
+        }
+        return results;
+    }
+
+    /**
+     * Returns an array of the values of 'field' in the results of 'spec' over documents with the
+     * values 'xs' of the field 'x', all in one partition.
+     */
+    Value getWindowValues(const char* spec, const vector<int>& xs, StringData field) {
+        deque<DocumentSource::GetNextResult> inputs;
+        for (auto x : xs) {
+            inputs.emplace_back(Document{{"x", x}});
+        }
+        vector<Value> values;
+        for (auto&& doc : getResults(spec, std::move(inputs))) {
+            values.push_back(doc[field]);
+        }
+        return Value(std::move(values));
+    }
+};
+
+Value values(const vector<int>& ints) {
+    return Value(vector<Value>(ints.begin(), ints.end()));
+}
+
+TEST_F(SetWindowFieldsTest, ComputesRunningTotalsWithinEachPartition) {
+    auto results = getResults(
+        "{$setWindowFields: {partitionBy: '$p', output: {total: {$sum: '$x'}, 'n.count': {$sum: "
+        "1}}}}",
+        {Document{{"p", 1}, {"x", 1}},
+         Document{{"p", 1}, {"x", 2}},
+         Document{{"p", 2}, {"x", 5}},
+         Document{{"p", 2}, {"x", 1}},
+         Document{{"x", 3}},
+         Document{{"p", BSONNULL}, {"x", 4}}});
+
+    ASSERT_EQ(results.size(), 6UL);
+    ASSERT_DOCUMENT_EQ(results[0], Document(fromjson("{p: 1, x: 1, total: 1, n: {count: 1}}")));
+    ASSERT_DOCUMENT_EQ(results[1], Document(fromjson("{p: 1, x: 2, total: 3, n: {count: 2}}")));
+    ASSERT_DOCUMENT_EQ(results[2], Document(fromjson("{p: 2, x: 5, total: 5, n: {count: 1}}")));
+    ASSERT_DOCUMENT_EQ(results[3], Document(fromjson("{p: 2, x: 1, total: 6, n: {count: 2}}")));
+    // A missing partition key is the same partition as null.
+    ASSERT_DOCUMENT_EQ(results[4], Document(fromjson("{x: 3, total: 3, n: {count: 1}}")));
+    ASSERT_DOCUMENT_EQ(results[5], Document(fromjson("{p: null, x: 4, total: 7, n: {count: 2}}")));
+}
+
+TEST_F(SetWindowFieldsTest, ComputesSlidingWindowsAroundEachDocument) {
+    const auto spec =
+        "{$setWindowFields: {output: {"
+        "  s: {$sum: '$x', window: {documents: [-1, 1]}},"
+        "  m: {$max: '$x', window: {documents: ['current', 2]}},"
+        "  p: {$push: '$x', window: {documents: [-2, -1]}}"
+        "}}}";
+    const vector<int> xs{1, 2, 3, 4};
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "s"), values({3, 6, 9, 7}));
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "m"), values({3, 4, 4, 4}));
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "p"),
+                    Value(vector<Value>{
+                        Value(vector<Value>{}), values({1}), values({1, 2}), values({2, 3})}));
+}
+
+TEST_F(SetWindowFieldsTest, ComputesRunningWindowsWhichEndBeforeOrAfterEachDocument) {
+    const auto spec =
+        "{$setWindowFields: {output: {"
+        "  following: {$sum: '$x', window: {documents: ['unbounded', 1]}},"
+        "  preceding: {$sum: '$x', window: {documents: ['unbounded', -1]}},"
+        "  first: {$first: '$x', window: {documents: ['unbounded', 'current']}}"
+        "}}}";
+    const vector<int> xs{1, 2, 3, 4};
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "following"), values({3, 6, 10, 10}));
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "preceding"), values({0, 1, 3, 6}));
+    ASSERT_VALUE_EQ(getWindowValues(spec, xs, "first"), values({1, 1, 1, 1}));
+}
+
+TEST_F(SetWindowFieldsTest, WaitsForTheFollowingDocumentsOfAWindowAcrossPauses) {
+    auto stage =
+        parse("{$setWindowFields: {output: {s: {$sum: '$x', window: {documents: [0, 1]}}}}}")
+            .back();
+    deque<DocumentSource::GetNextResult> inputs{Document{{"x", 1}},
+                                                DocumentSource::GetNextResult::makePauseExecution(),
+                                                Document{{"x", 2}}};
+    auto source = DocumentSourceMock::createForTest(std::move(inputs), getExpCtx());
+    stage->setSource(source.get());
+
+    ASSERT_TRUE(stage->getNext().isPaused());
+    ASSERT_DOCUMENT_EQ(stage->getNext().releaseDocument(), Document(fromjson("{x: 1, s: 3}")));
+    ASSERT_DOCUMENT_EQ(stage->getNext().releaseDocument(), Document(fromjson("{x: 2, s: 2}")));
+    ASSERT_TRUE(stage->getNext().isEOF());
+    ASSERT_TRUE(stage->getNext().isEOF());
+}
+
+TEST_F(SetWindowFieldsTest, SortsByThePartitionThenByTheSortByFields) {
+    auto stages = parse(
+        "{$setWindowFields: {partitionBy: '$p', sortBy: {t: -1, p: -1}, output: {n: {$sum: 1}}}}");
+    ASSERT_EQ(stages.size(), 2UL);
+    auto sort = dynamic_cast<DocumentSourceSort*>(stages.front().get());
+    ASSERT(sort);
+    ASSERT_DOCUMENT_EQ(
+        sort->getSortKeyPattern().serialize(SortPattern::SortKeySerialization::kForExplain),
+        Document(fromjson("{p: -1, t: -1}")));
+
+    stages = parse("{$setWindowFields: {partitionBy: '$p', output: {n: {$sum: 1}}}}");
+    ASSERT_EQ(stages.size(), 2UL);
+    sort = dynamic_cast<DocumentSourceSort*>(stages.front().get());
+    ASSERT(sort);
+    ASSERT_DOCUMENT_EQ(
+        sort->getSortKeyPattern().serialize(SortPattern::SortKeySerialization::kForExplain),
+        Document(fromjson("{p: 1}")));
+
+    // Without either field, the stage reads its input in the order it comes in.
+    ASSERT_EQ(parse("{$setWindowFields: {output: {n: {$sum: 1}}}}").size(), 1UL);
+}
+
+TEST_F(SetWindowFieldsTest, SerializesToASpecWhichParsesIntoTheSameStage) {
+    auto stage = parse(
+                     "{$setWindowFields: {partitionBy: '$p', output: {"
+                     "  a: {$sum: '$x'},"
+                     "  'b.c': {$avg: '$x', window: {documents: [-3, 'current']}},"
+                     "  d: {$push: '$y', window: {documents: ['unbounded', 2]}}"
+                     "}}}")
+                     .back();
+    vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(serialized.size(), 1UL);
+    ASSERT_VALUE_EQ(serialized[0],
+                    Value(fromjson("{$_internalSetWindowFields: {partitionBy: '$p', output: {"
+                                   "  a: {$sum: '$x', window: {documents: ['unbounded', 0]}},"
+                                   "  'b.c': {$avg: '$x', window: {documents: [-3, 0]}},"
+                                   "  d: {$push: '$y', window: {documents: ['unbounded', 2]}}"
+                                   "}}}")));
+
+    auto reparsed = DocumentSourceInternalSetWindowFields::createFromBson(
+        serialized[0].getDocument().toBson().firstElement(), getExpCtx());
+    vector<Value> reserialized;
+    reparsed->serializeToArray(reserialized);
+    ASSERT_EQ(reserialized.size(), 1UL);
+    ASSERT_VALUE_EQ(reserialized[0], serialized[0]);
+}
+
+TEST_F(SetWindowFieldsTest, RejectsInvalidSpecifications) {
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: 1}"), AssertionException, 5190313);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {partitionBy: {$add: ['$a', 1]}, output: "
+                             "{n: {$sum: 1}}}}"),
+                       AssertionException,
+                       5190312);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {partitionBy: '$$ROOT', output: {n: {$sum: 1}}}}"),
+                       AssertionException,
+                       5190312);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {foo: 1, output: {n: {$sum: 1}}}}"),
+                       AssertionException,
+                       5190314);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {sortBy: {a: 1}}}"), AssertionException, 5190315);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {}}}"), AssertionException, 5190315);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {n: {$sum: 1, $max: 1}}}}"),
+                       AssertionException,
+                       5190316);
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {n: {window: {documents: [0, 1]}}}}}"),
+                       AssertionException,
+                       5190316);
+    ASSERT_THROWS_CODE(
+        parse("{$setWindowFields: {output: {n: {$sum: 1, window: {range: [0, 1]}}}}}"),
+        AssertionException,
+        5190317);
+    ASSERT_THROWS_CODE(
+        parse("{$setWindowFields: {output: {n: {$sum: 1, window: {documents: [0]}}}}}"),
+        AssertionException,
+        5190317);
+    // An upper bound can't be unbounded, so that the stage never holds a whole partition.
+    ASSERT_THROWS_CODE(parse("{$setWindowFields: {output: {n: {$sum: 1, window: {documents: "
+                             "[0, 'unbounded']}}}}}"),
+                       AssertionException,
+                       5190318);
+    ASSERT_THROWS_CODE(
+        parse("{$setWindowFields: {output: {n: {$sum: 1, window: {documents: [0.5, 1]}}}}}"),
+        AssertionException,
+        5190318);
+    ASSERT_THROWS_CODE(
+        parse("{$setWindowFields: {output: {n: {$sum: 1, window: {documents: [1, -1]}}}}}"),
+        AssertionException,
+        5190319);
+}
+
+TEST_F(SetWindowFieldsTest, FailsOnAnArrayPartitionKey) {
+    ASSERT_THROWS_CODE(getResults("{$setWindowFields: {partitionBy: '$p', output: {n: {$sum: 1}}}}",
+                                  {Document{{"p", 1}}, Document{{"p", vector<Value>{Value(1)}}}}),
+                       AssertionException,
+                       5190311);
+}
+
+TEST_F(SetWindowFieldsTest, OnlyHoldsItsWidestWindowInMemory) {
+    const auto oldMaxMemoryBytes = internalDocumentSourceSetWindowFieldsMaxMemoryBytes.load();
+    internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(8 * 1024);
+    ON_BLOCK_EXIT(
+        [&] { internalDocumentSourceSetWindowFieldsMaxMemoryBytes.store(oldMaxMemoryBytes); });
+
+    const vector<int> xs(2000, 1);
+    auto sums = getWindowValues(
+        "{$setWindowFields: {output: {"
+        "  s: {$sum: '$x', window: {documents: [-5, 5]}},"
+        "  total: {$sum: '$x'}"
+        "}}}",
+        xs,
+        "total");
+    ASSERT_EQ(sums.getArrayLength(), xs.size());
+    ASSERT_VALUE_EQ(sums.getArray().back(), Value(2000));
+
+    // A running $push keeps every document of the partition.
+    ASSERT_THROWS_CODE(
+        getWindowValues("{$setWindowFields: {output: {all: {$push: '$x'}}}}", xs, "all"),
+        AssertionException,
+        5190310);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -65,9 +65,26 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::doGetN
     }
 
     // Apply and return the document with added fields.
+    eliminateCommonSubexpressionsOnce();
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceSingleDocumentTransformation::doGetNextBatch(std::vector<Document>* batch,
+                                                           size_t maxDocs) {
+    const size_t firstInput = batch->size();
+    const auto status = pSource->getNextBatch(batch, maxDocs);
+    eliminateCommonSubexpressionsOnce();
+
+    // Transform the new documents in place, releasing each input before its output is stored so
+    // that the transformation doesn't have to copy it on write.
+    for (auto it = batch->begin() + firstInput; it != batch->end(); ++it) {
+        Document input = std::move(*it);
+        *it = _parsedTransform->applyTransformation(input);
+    }
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     _parsedTransform->optimize();
     return this;
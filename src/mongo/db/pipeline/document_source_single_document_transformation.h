@@ -96,15 +96,30 @@ public:
 
 protected:
     GetNextResult doGetNext() final;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxDocs) final;
     void doDispose() final;
 
     Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
                                                      Pipeline::SourceContainer* container) final;
 
 private:
+    /**
+     * Lets '_parsedTransform' share repeated subexpressions the first time it runs, once no more
+     * rewrites of the pipeline can happen.
+     */
+    void eliminateCommonSubexpressionsOnce() {
+        if (!_commonSubexpressionsEliminated) {
+            _parsedTransform->eliminateCommonSubexpressions();
+            _commonSubexpressionsEliminated = true;
+        }
+    }
+
     // Stores transformation logic.
     std::unique_ptr<TransformerInterface> _parsedTransform;
 
+    bool _commonSubexpressionsEliminated = false;
+
     // Specific name of the transformation.
     std::string _name;
 
@@ -42,6 +42,7 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/query/collation/collation_index_key.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
 
@@ -225,14 +226,22 @@ intrusive_ptr<DocumentSourceSort> DocumentSourceSort::create(
 }
 
 DocumentSource::GetNextResult DocumentSourceSort::populate() {
-    auto nextInput = pSource->getNext();
-    for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
-        loadDocument(nextInput.releaseDocument());
+    const size_t batchSize = internalDocumentSourceGetNextBatchSize.load();
+    std::vector<Document> batch;
+    auto status = GetNextResult::ReturnStatus::kAdvanced;
+    while (status == GetNextResult::ReturnStatus::kAdvanced) {
+        batch.clear();
+        status = pSource->getNextBatch(&batch, batchSize);
+        for (auto&& doc : batch) {
+            loadDocument(std::move(doc));
+        }
     }
-    if (nextInput.isEOF()) {
+
+    if (status == GetNextResult::ReturnStatus::kEOF) {
         loadingDone();
+        return GetNextResult::makeEOF();
     }
-    return nextInput;
+    return GetNextResult::makePauseExecution();
 }
 
 void DocumentSourceSort::loadDocument(Document&& doc) {
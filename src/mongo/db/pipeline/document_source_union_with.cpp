@@ -32,13 +32,21 @@
 
 #include <iterator>
 
+#include "mongo/base/init.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/api_parameters.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -47,6 +55,22 @@ REGISTER_DOCUMENT_SOURCE(unionWith,
                          DocumentSourceUnionWith::createFromBson);
 
 namespace {
+
+std::unique_ptr<ThreadPool> unionWithPrefetchThreadPool;
+
+MONGO_INITIALIZER(UnionWithPrefetchThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "UnionWithPrefetch";
+    options.threadNamePrefix = "UnionWithPrefetch";
+    options.minThreads = 0;
+    options.maxThreads = 64;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    unionWithPrefetchThreadPool = std::make_unique<ThreadPool>(options);
+    unionWithPrefetchThreadPool->startup();
+
+    return Status::OK();
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineFromViewDefinition(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     ExpressionContext::ResolvedNamespace resolvedNs,
@@ -83,6 +107,10 @@ std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineFromViewDefinition(
 }  // namespace
 
 DocumentSourceUnionWith::~DocumentSourceUnionWith() {
+    if (_prefetch) {
+        killPrefetch(ErrorCodes::Interrupted);
+        _prefetch->waitNoThrow().ignore();
+    }
     if (_pipeline && _pipeline->getContext()->explain) {
         _pipeline->dispose(pExpCtx->opCtx);
         _pipeline.reset();
@@ -164,13 +192,163 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceUnionWith::createFromBson(
             expCtx, expCtx->getResolvedNamespace(std::move(unionNss)), std::move(pipeline)));
 }
 
+bool DocumentSourceUnionWith::shouldPrefetch() const {
+    return pExpCtx->inMongos && !pExpCtx->explain &&
+        internalDocumentSourceUnionWithPrefetchDocuments.load() > 0;
+}
+
+void DocumentSourceUnionWith::startPrefetch() {
+    auto opCtx = pExpCtx->opCtx;
+
+    // The prefetch runs under its own operation context, which reads with the operation's read
+    // concern and read preference, and gets its time limit.
+    auto readConcern = repl::ReadConcernArgs::get(opCtx);
+    auto readPreference = ReadPreferenceSetting::get(opCtx);
+    auto apiParameters = APIParameters::get(opCtx);
+    const auto deadline = opCtx->getDeadline();
+    const auto timeoutError = opCtx->getTimeoutError();
+    const size_t maxDocs = internalDocumentSourceUnionWithPrefetchDocuments.load();
+
+    _pipeline->detachFromOperationContext();
+    _pipeline.get_deleter().dismissDisposal();
+    auto pipeline = _pipeline.release();
+
+    auto pf = makePromiseFuture<PrefetchResult>();
+    unionWithPrefetchThreadPool->schedule(
+        [this,
+         pipeline,
+         maxDocs,
+         readConcern = std::move(readConcern),
+         readPreference = std::move(readPreference),
+         apiParameters = std::move(apiParameters),
+         deadline,
+         timeoutError,
+         promise = std::move(pf.promise)](auto status) mutable {
+            if (!status.isOK()) {
+                // Hand the sub-pipeline back untouched, to be attached on the operation's thread.
+                PrefetchResult result;
+                result.pipeline = {pipeline, PipelineDeleter(nullptr)};
+                result.pipeline.get_deleter().dismissDisposal();
+                promise.emplaceValue(std::move(result));
+                return;
+            }
+
+            auto prefetchOpCtx = cc().makeOperationContext();
+            repl::ReadConcernArgs::get(prefetchOpCtx.get()) = std::move(readConcern);
+            ReadPreferenceSetting::get(prefetchOpCtx.get()) = std::move(readPreference);
+            APIParameters::get(prefetchOpCtx.get()) = std::move(apiParameters);
+            if (deadline != Date_t::max()) {
+                prefetchOpCtx->setDeadlineByDate(deadline, timeoutError);
+            }
+
+            promise.setWith([&] { return prefetch(prefetchOpCtx.get(), pipeline, maxDocs); });
+        });
+    _prefetch = std::move(pf.future);
+}
+
+DocumentSourceUnionWith::PrefetchResult DocumentSourceUnionWith::prefetch(
+    OperationContext* opCtx, Pipeline* ownedPipeline, size_t maxDocs) {
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline(ownedPipeline, PipelineDeleter(opCtx));
+    {
+        stdx::lock_guard<Latch> lk(_prefetchMutex);
+        if (_prefetchKillCode) {
+            stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_prefetchKillCode);
+        }
+        _prefetchOpCtx = opCtx;
+    }
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard<Latch> lk(_prefetchMutex);
+        _prefetchOpCtx = nullptr;
+    });
+
+    pipeline->reattachToOperationContext(opCtx);
+    PrefetchResult result;
+    auto serializedPipe = pipeline->serializeToBson();
+    try {
+        pipeline = pipeline->getContext()->mongoProcessInterface->attachCursorSourceToPipeline(
+            pipeline.release());
+    } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
+        // The cursor source was not attached, so there is nothing to dispose of. The view is
+        // resolved on the operation's thread.
+        result.view = ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()};
+        result.serializedPipeline = std::move(serializedPipe);
+        return result;
+    }
+    result.attached = true;
+
+    while (result.docs.size() < maxDocs) {
+        auto next = pipeline->getNext();
+        if (!next) {
+            break;
+        }
+        result.docs.push_back(std::move(*next));
+    }
+
+    pipeline->detachFromOperationContext();
+    pipeline.get_deleter().dismissDisposal();
+    result.pipeline = std::move(pipeline);
+    return result;
+}
+
+void DocumentSourceUnionWith::killPrefetch(ErrorCodes::Error code) {
+    stdx::lock_guard<Latch> lk(_prefetchMutex);
+    _prefetchKillCode = code;
+    if (_prefetchOpCtx) {
+        stdx::lock_guard<Client> clientLock(*_prefetchOpCtx->getClient());
+        _prefetchOpCtx->getServiceContext()->killOperation(clientLock, _prefetchOpCtx, code);
+    }
+}
+
+void DocumentSourceUnionWith::finishPrefetch() {
+    auto opCtx = pExpCtx->opCtx;
+    auto future = std::move(*_prefetch);
+    _prefetch.reset();
+
+    // If the operation is interrupted, interrupt the prefetch too. Either way, wait for the
+    // prefetch to stop and take the sub-pipeline back, so that it is disposed of along with this
+    // stage.
+    auto interruptStatus = future.waitNoThrow(opCtx);
+    if (!interruptStatus.isOK()) {
+        killPrefetch(interruptStatus.code());
+    }
+    auto swResult = std::move(future).getNoThrow();
+    if (swResult.isOK() && swResult.getValue().pipeline) {
+        _pipeline = {swResult.getValue().pipeline.release(), PipelineDeleter(opCtx)};
+        _pipeline->reattachToOperationContext(opCtx);
+    }
+    uassertStatusOK(interruptStatus);
+    auto result = uassertStatusOK(std::move(swResult));
+
+    if (result.view) {
+        _pipeline =
+            buildPipelineFromViewDefinition(pExpCtx, *result.view, result.serializedPipeline);
+        LOGV2_DEBUG(5191430,
+                    3,
+                    "$unionWith prefetch found view definition. ns: {ns}, pipeline: {pipeline}. "
+                    "New $unionWith sub-pipeline: {new_pipe}",
+                    "ns"_attr = result.view->ns,
+                    "pipeline"_attr = Value(result.view->pipeline),
+                    "new_pipe"_attr = _pipeline->serializeToBson());
+    } else if (result.attached) {
+        _prefetchedDocs = std::move(result.docs);
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
+    }
+}
+
 DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
-    if (!_pipeline) {
+    if (!_pipeline && !_prefetch) {
         // We must have already been disposed, so we're finished.
         return GetNextResult::makeEOF();
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        if (!_prefetchStarted && shouldPrefetch()) {
+            // Start the sub-pipeline now, so that its cursors are established and its first
+            // documents read while the documents of 'pSource' are still being returned.
+            _prefetchStarted = true;
+            startPrefetch();
+        }
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
@@ -180,6 +358,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         // pipeline by falling through below.
     }
 
+    if (_prefetch) {
+        finishPrefetch();
+    }
+
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
         auto serializedPipe = _pipeline->serializeToBson();
         LOGV2_DEBUG(23869,
@@ -206,6 +388,12 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
         }
     }
 
+    if (!_prefetchedDocs.empty()) {
+        auto doc = std::move(_prefetchedDocs.front());
+        _prefetchedDocs.pop_front();
+        return std::move(doc);
+    }
+
     auto res = _pipeline->getNext();
     if (res)
         return std::move(*res);
@@ -240,6 +428,19 @@ bool DocumentSourceUnionWith::usedDisk() {
 }
 
 void DocumentSourceUnionWith::doDispose() {
+    if (_prefetch) {
+        // Stop the prefetch and take the sub-pipeline back to dispose of it.
+        killPrefetch(ErrorCodes::Interrupted);
+        try {
+            finishPrefetch();
+        } catch (const DBException& ex) {
+            LOGV2_DEBUG(5191431,
+                        3,
+                        "$unionWith prefetch stopped on dispose",
+                        "error"_attr = ex.toStatus());
+        }
+    }
+    _prefetchedDocs.clear();
     if (_pipeline) {
         _usedDisk = _usedDisk || _pipeline->usedDisk();
         if (!_pipeline->getContext()->explain) {
@@ -30,11 +30,14 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/stage_constraints.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/future.h"
 
 namespace mongo {
 
@@ -160,10 +163,62 @@ private:
 
     void addViewDefinition(NamespaceString nss, std::vector<BSONObj> viewPipeline);
 
+    /**
+     * What a prefetch of the sub-pipeline hands back to the operation's thread: the sub-pipeline,
+     * along with the documents read from it, or the view which must be resolved before it can
+     * run.
+     */
+    struct PrefetchResult {
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+        bool attached = false;
+        std::deque<Document> docs;
+        boost::optional<ExpressionContext::ResolvedNamespace> view;
+        std::vector<BSONObj> serializedPipeline;
+    };
+
+    /**
+     * Returns whether the sub-pipeline should be started, on another thread, while the documents
+     * of 'pSource' are still being returned.
+     */
+    bool shouldPrefetch() const;
+
+    /**
+     * Hands '_pipeline' over to another thread, which attaches its cursor source and reads its
+     * first documents. The sub-pipeline is handed back by finishPrefetch().
+     */
+    void startPrefetch();
+
+    /**
+     * Runs on the prefetching thread, under 'opCtx'.
+     */
+    PrefetchResult prefetch(OperationContext* opCtx, Pipeline* ownedPipeline, size_t maxDocs);
+
+    /**
+     * Waits for the prefetch started by startPrefetch() and takes the sub-pipeline back into
+     * '_pipeline'. Moves to kIteratingSubPipeline if the sub-pipeline was attached.
+     */
+    void finishPrefetch();
+
+    /**
+     * Interrupts an in-progress prefetch with 'code'.
+     */
+    void killPrefetch(ErrorCodes::Error code);
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     bool _usedDisk = false;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+
+    // Set while a prefetch of the sub-pipeline is in progress. The prefetching thread owns the
+    // sub-pipeline until finishPrefetch().
+    boost::optional<Future<PrefetchResult>> _prefetch;
+    bool _prefetchStarted = false;
+    std::deque<Document> _prefetchedDocs;
+
+    // Protects '_prefetchOpCtx', through which the prefetch is interrupted.
+    Mutex _prefetchMutex = MONGO_MAKE_LATCH("DocumentSourceUnionWith::_prefetchMutex");
+    OperationContext* _prefetchOpCtx = nullptr;
+    boost::optional<ErrorCodes::Error> _prefetchKillCode;
 };
 
 }  // namespace mongo
@@ -34,8 +34,11 @@
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -60,7 +63,21 @@ public:
      */
     DocumentSource::GetNextResult getNext();
 
+    /**
+     * Limits the documents unwound from arrays to the top-level fields named in 'fields', plus the
+     * fields of the unwound and index paths, or lifts the limit if 'fields' is boost::none.
+     */
+    void setOutputFields(boost::optional<std::set<std::string>> fields) {
+        _outputFields = std::move(fields);
+    }
+
 private:
+    /**
+     * Returns a document with the fields of 'document' which are named in '_outputFields', in the
+     * same order, and with the same metadata.
+     */
+    Document narrowToOutputFields(const Document& document) const;
+
     // Tracks whether or not we can possibly return any more documents. Note we may return
     // boost::none even if this is true.
     bool _haveNext = false;
@@ -76,8 +93,18 @@ private:
     // existing value, setting to null when the value was a non-array or empty array.
     const boost::optional<FieldPath> _indexPath;
 
+    // When set, the only top-level fields which the stage after this one reads.
+    boost::optional<std::set<std::string>> _outputFields;
+
     Value _inputArray;
 
+    // The document whose array is being unwound.
+    Document _parent;
+
+    // If true, the document output for each element is built over the unmodified BSON of
+    // '_parent', rather than over a copy of its cached fields.
+    bool _outputOverParentBson = false;
+
     MutableDocument _output;
 
     // Document indexes of the field path components.
@@ -96,11 +123,40 @@ DocumentSourceUnwind::Unwinder::Unwinder(const FieldPath& unwindPath,
 
 void DocumentSourceUnwind::Unwinder::resetDocument(const Document& document) {
     // Reset document specific attributes.
-    _output.reset(document);
     _unwindPathFieldIndexes.clear();
     _index = 0;
     _inputArray = document.getNestedField(_unwindPath, &_unwindPathFieldIndexes);
     _haveNext = true;
+    _outputOverParentBson = false;
+    _parent = document;
+
+    // Copying the parent for each element of an array costs as much as the fields cached in the
+    // parent, so when there are several elements the copies are made from a cheaper document.
+    if (_inputArray.getType() == Array && _inputArray.getArrayLength() > 1 &&
+        internalQueryEnableLazyUnwind.load()) {
+        if (_outputFields) {
+            _parent = narrowToOutputFields(document);
+            _unwindPathFieldIndexes.clear();
+            _parent.getNestedField(_unwindPath, &_unwindPathFieldIndexes);
+        } else {
+            _outputOverParentBson = document.hasUnmodifiedBson();
+        }
+    }
+    _output.reset(_parent);
+}
+
+Document DocumentSourceUnwind::Unwinder::narrowToOutputFields(const Document& document) const {
+    MutableDocument narrowed;
+    auto fields = document.fieldIterator();
+    while (fields.more()) {
+        auto&& [name, value] = fields.next();
+        if (_outputFields->count(name.toString()) || name == _unwindPath.front() ||
+            (_indexPath && name == _indexPath->front())) {
+            narrowed.addField(name, value);
+        }
+    }
+    narrowed.copyMetaDataFrom(document);
+    return narrowed.freeze();
 }
 
 DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
@@ -132,7 +188,14 @@ DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
             // clone. Because the value at the end will be replaced, everything along the path
             // leading to that will be replaced in order not to share that change with any other
             // clones (or the original).
-            _output.setNestedField(_unwindPathFieldIndexes, _inputArray[_index]);
+            if (_outputOverParentBson) {
+                // A new storage over the parent's BSON caches only the fields along the path, so
+                // the parent's positions don't apply to it.
+                _output.resetToBsonOf(_parent);
+                _output.setNestedField(_unwindPath, _inputArray[_index]);
+            } else {
+                _output.setNestedField(_unwindPathFieldIndexes, _inputArray[_index]);
+            }
             indexForOutput = _index;
             _index++;
             _haveNext = _index < length;
@@ -153,7 +216,7 @@ DocumentSource::GetNextResult DocumentSourceUnwind::Unwinder::getNext() {
             indexForOutput ? Value(*indexForOutput) : Value(BSONNULL);
     }
 
-    return _haveNext ? _output.peek() : _output.freeze();
+    return _haveNext && !_outputOverParentBson ? _output.peek() : _output.freeze();
 }
 
 DocumentSourceUnwind::DocumentSourceUnwind(const intrusive_ptr<ExpressionContext>& pExpCtx,
@@ -205,6 +268,43 @@ DocumentSource::GetNextResult DocumentSourceUnwind::doGetNext() {
     return nextOut;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceUnwind::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // This is recomputed whenever the stages after this one change.
+    _unwinder->setOutputFields(boost::none);
+    auto nextItr = std::next(itr);
+    if (nextItr == container->end()) {
+        return nextItr;
+    }
+
+    auto next = nextItr->get();
+    auto transformation = dynamic_cast<DocumentSourceSingleDocumentTransformation*>(next);
+    if (!dynamic_cast<DocumentSourceGroup*>(next) &&
+        !(transformation &&
+          transformation->getType() ==
+              TransformerInterface::TransformerType::kInclusionProjection)) {
+        return nextItr;
+    }
+
+    // The outputs of a $group and of an inclusion $project depend only on the fields they read.
+    DepsTracker deps;
+    auto state = next->getDependencies(&deps);
+    if (deps.needWholeDocument ||
+        (state != DepsTracker::State::EXHAUSTIVE_ALL &&
+         state != DepsTracker::State::EXHAUSTIVE_FIELDS)) {
+        return nextItr;
+    }
+
+    std::set<std::string> topLevelFields;
+    for (auto&& field : deps.fields) {
+        topLevelFields.insert(FieldPath(field).front().toString());
+    }
+    _unwinder->setOutputFields(std::move(topLevelFields));
+    return nextItr;
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceUnwind::getModifiedPaths() const {
     std::set<std::string> modifiedFields{_unwindPath.fullPath()};
     if (_indexPath) {
@@ -100,6 +100,13 @@ private:
 
     GetNextResult doGetNext() final;
 
+    /**
+     * If the next stage is a $group or an inclusion $project which reads a known set of fields,
+     * limits the documents unwound from arrays to the top-level fields it reads.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
     // Configuration state.
     const FieldPath _unwindPath;
     // Documents that have a nullish value, or an empty array for the field '_unwindPath', will pass
@@ -43,12 +43,15 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/dependencies.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_project.h"
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -733,6 +736,88 @@ TEST_F(UnwindStageTest, UnwindIncludesIndexPathWhenIncludingIndex) {
     ASSERT_EQUALS(1U, modifiedPaths.paths.count("arrIndex"));
 }
 
+TEST_F(UnwindStageTest, UnwindsOverParentBsonWithTheSameResults) {
+    auto input = fromjson("{_id: 0, a: {b: [1, 2, 3], c: 'x'}, d: [4, 5]}");
+    auto unwindAll = [&](bool lazy) {
+        const bool wasLazy = internalQueryEnableLazyUnwind.load();
+        internalQueryEnableLazyUnwind.store(lazy);
+        ON_BLOCK_EXIT([&] { internalQueryEnableLazyUnwind.store(wasLazy); });
+
+        auto unwind =
+            DocumentSourceUnwind::create(getExpCtx(), "a.b", false, boost::optional<string>("i"));
+        auto source = DocumentSourceMock::createForTest(Document(input), getExpCtx());
+        unwind->setSource(source.get());
+        vector<Value> results;
+        for (auto next = unwind->getNext(); next.isAdvanced(); next = unwind->getNext()) {
+            results.push_back(Value(next.releaseDocument()));
+        }
+        return Value(results);
+    };
+
+    auto results = unwindAll(true);
+    ASSERT_VALUE_EQ(unwindAll(false), results);
+    ASSERT_VALUE_EQ(Value(fromjson("{_id: 0, a: {b: 3, c: 'x'}, d: [4, 5], i: 2}")),
+                    results[2]);
+}
+
+TEST_F(UnwindStageTest, UnwindsModifiedParentWithTheSameResults) {
+    MutableDocument parent(Document(fromjson("{_id: 0, arr: [1, 2], x: 1}")));
+    parent.addField("y", Value(2));
+    auto unwind = DocumentSourceUnwind::create(getExpCtx(), "arr", false, boost::none);
+    auto source = DocumentSourceMock::createForTest({parent.freeze()}, getExpCtx());
+    unwind->setSource(source.get());
+
+    auto next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 0, arr: 1, x: 1, y: 2}")), next.getDocument());
+    next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 0, arr: 2, x: 1, y: 2}")), next.getDocument());
+    ASSERT_TRUE(unwind->getNext().isEOF());
+}
+
+TEST_F(UnwindStageTest, UnwindsOnlyFieldsReadByNextInclusionProjection) {
+    auto unwind = DocumentSourceUnwind::create(getExpCtx(), "arr", false, boost::none);
+    auto project =
+        DocumentSourceProject::createFromBson(fromjson("{$project: {'b.c': 1}}").firstElement(),
+                                              getExpCtx());
+    Pipeline::SourceContainer container{unwind, project};
+    unwind->optimizeAt(container.begin(), &container);
+
+    auto source = DocumentSourceMock::createForTest(
+        {"{_id: 0, a: 1, b: {c: 2, d: 3}, arr: [4, 5], e: 6}", "{_id: 1, a: 1, arr: [7]}"},
+        getExpCtx());
+    unwind->setSource(source.get());
+    auto next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 0, b: {c: 2, d: 3}, arr: 4}")), next.getDocument());
+    next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 0, b: {c: 2, d: 3}, arr: 5}")), next.getDocument());
+
+    // A single element is output without copying the parent.
+    next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 1, a: 1, arr: 7}")), next.getDocument());
+    ASSERT_TRUE(unwind->getNext().isEOF());
+}
+
+TEST_F(UnwindStageTest, UnwindsWholeDocumentsWhenNextStageNeedsThem) {
+    auto unwind = DocumentSourceUnwind::create(getExpCtx(), "arr", false, boost::none);
+    auto project =
+        DocumentSourceProject::createFromBson(fromjson("{$project: {e: 0}}").firstElement(),
+                                              getExpCtx());
+    Pipeline::SourceContainer container{unwind, project};
+    unwind->optimizeAt(container.begin(), &container);
+
+    auto source = DocumentSourceMock::createForTest("{_id: 0, a: 1, arr: [4, 5], e: 6}",
+                                                    getExpCtx());
+    unwind->setSource(source.get());
+    auto next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(Document(fromjson("{_id: 0, a: 1, arr: 4, e: 6}")), next.getDocument());
+}
+
 //
 // Error cases.
 //
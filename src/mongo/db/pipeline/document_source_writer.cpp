@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_writer.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/locker.h"
+#include "mongo/db/repl/repl_client_info.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/processinfo.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+ThreadPool& getWriteBehindThreadPool() {
+    // Intentionally leaked so that the pool's threads never race with static destruction.
+    static auto pool = [] {
+        ThreadPool::Options options;
+        options.poolName = "WriteBehindThreadPool";
+        options.minThreads = 0;
+        options.maxThreads = std::max(1UL, ProcessInfo::getNumAvailableCores());
+
+        auto pool = new ThreadPool(std::move(options));
+        pool->startup();
+        return pool;
+    }();
+    return *pool;
+}
+
+}  // namespace
+
+bool DocumentSourceWriteBehind::canWriteBehind(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    // The query waits for each write while it holds its locks, so a write queued behind a writer
+    // which is itself queued behind the query's locks would never finish.
+    return !expCtx->inMongos && !expCtx->opCtx->inMultiDocumentTransaction() &&
+        !expCtx->opCtx->lockState()->isLocked();
+}
+
+DocumentSourceWriteBehind::~DocumentSourceWriteBehind() {
+    // The write references the batch and the stage which scheduled it, so it must have finished
+    // before either goes away, even if the query was interrupted while it waited for it.
+    if (_inFlight) {
+        _inFlight->getNoThrow().getStatus().ignore();
+    }
+}
+
+void DocumentSourceWriteBehind::schedule(Write write) {
+    wait();
+
+    auto opCtx = _expCtx->opCtx;
+    auto writeExpCtx = _expCtx->copyWith(_expCtx->ns);
+    auto pf = makePromiseFuture<repl::OpTime>();
+    getWriteBehindThreadPool().schedule([serviceContext = opCtx->getServiceContext(),
+                                         deadline = opCtx->getDeadline(),
+                                         timeoutError = opCtx->getTimeoutError(),
+                                         writeExpCtx = std::move(writeExpCtx),
+                                         write = std::move(write),
+                                         promise = std::move(pf.promise)](Status status) mutable {
+        if (!status.isOK()) {
+            promise.setError(std::move(status));
+            return;
+        }
+        promise.setWith([&] {
+            auto client = serviceContext->makeClient("WriteBehindWorker");
+            AlternativeClientRegion clientRegion(client);
+            auto writeOpCtx = cc().makeOperationContext();
+            if (deadline != Date_t::max()) {
+                writeOpCtx->setDeadlineByDate(deadline, timeoutError);
+            }
+            writeExpCtx->opCtx = writeOpCtx.get();
+            ON_BLOCK_EXIT([&] { writeExpCtx->opCtx = nullptr; });
+
+            write(writeExpCtx);
+            return repl::ReplClientInfo::forClient(cc()).getLastOp();
+        });
+    });
+    _inFlight = std::move(pf.future);
+}
+
+void DocumentSourceWriteBehind::wait() {
+    if (!_inFlight) {
+        return;
+    }
+    // Only stop tracking the write once it has finished, as the destructor must still wait for it
+    // if this thread is interrupted.
+    auto opCtx = _expCtx->opCtx;
+    _inFlight->wait(opCtx);
+    auto future = std::move(*_inFlight);
+    _inFlight = boost::none;
+
+    auto lastOp = std::move(future).get();
+    auto& replClientInfo = repl::ReplClientInfo::forClient(opCtx->getClient());
+    if (lastOp > replClientInfo.getLastOp()) {
+        replClientInfo.setLastOp(opCtx, lastOp);
+    }
+}
+
+}  // namespace mongo
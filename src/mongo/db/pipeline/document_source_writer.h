@@ -37,7 +37,10 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/read_concern.h"
+#include "mongo/db/repl/optime.h"
 #include "mongo/db/storage/recovery_unit.h"
+#include "mongo/util/functional.h"
+#include "mongo/util/future.h"
 
 namespace mongo {
 using namespace fmt::literals;
@@ -78,6 +81,49 @@ public:
     }
 };
 
+/**
+ * Runs the writes of a writer stage on another thread, so that the stage can read and build its
+ * next batch while the previous one is being written. At most one write is in flight at a time.
+ *
+ * Each write runs under an operation context of its own on a copy of the stage's
+ * ExpressionContext, since an OperationContext must only be used by one thread at a time. Once a
+ * write has finished, the last operation it wrote is handed to the client of the query, so that
+ * the write concern of the command also waits for the writes made in the background. The
+ * destructor waits for the write in flight, if any, without reporting its error.
+ */
+class DocumentSourceWriteBehind {
+public:
+    using Write = unique_function<void(const boost::intrusive_ptr<ExpressionContext>&)>;
+
+    /**
+     * Returns whether the writes of the query running within 'expCtx' can be made on another
+     * thread. This is not the case on mongos, within a multi-document transaction, or while the
+     * query holds locks which the writes may be queued behind.
+     */
+    static bool canWriteBehind(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+
+    explicit DocumentSourceWriteBehind(const boost::intrusive_ptr<ExpressionContext>& expCtx)
+        : _expCtx(expCtx) {}
+
+    ~DocumentSourceWriteBehind();
+
+    /**
+     * Waits for the write in flight, then starts making 'write' on another thread.
+     */
+    void schedule(Write write);
+
+    /**
+     * Waits for the write in flight, if any, and rethrows its error.
+     */
+    void wait();
+
+private:
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+
+    // Resolves to the last operation written by the write in flight.
+    boost::optional<Future<repl::OpTime>> _inFlight;
+};
+
 /**
  * This is a base abstract class for all stages performing a write operation into an output
  * collection. The writes are organized in batches in which elements are objects of the templated
@@ -90,6 +136,10 @@ public:
  * Two other virtual methods exist which a subclass may override: 'initialize()' and 'finalize()',
  * which are called before the first element is read from the input source, and after the last one
  * has been read, respectively.
+ *
+ * A subclass whose 'spill()' only uses the ExpressionContext it is given may also override
+ * 'canWriteBehind()', to have each batch written on another thread while the next one is built.
+ * The writes in flight are always waited for before 'doGetNext()' returns.
  */
 template <typename B>
 class DocumentSourceWriter : public DocumentSource {
@@ -141,9 +191,19 @@ protected:
     virtual void finalize() {}
 
     /**
-     * Writes the documents in 'batch' to the output namespace.
+     * Writes the documents in 'batch' to the output namespace, through the operation context of
+     * 'expCtx'. This is either the stage's own ExpressionContext or, when the stage writes behind,
+     * a copy of it used by another thread.
+     */
+    virtual void spill(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                       BatchedObjects&& batch) = 0;
+
+    /**
+     * Returns whether the batches may be written on another thread while the next one is built.
      */
-    virtual void spill(BatchedObjects&& batch) = 0;
+    virtual bool canWriteBehind() const {
+        return false;
+    }
 
     /**
      * Creates a batch object from the given document and returns it to the caller along with the
@@ -196,6 +256,24 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             _initialized = true;
         }
 
+        // Declared after the scope guard above so that the writes in flight have finished, and
+        // handed their last operation to the client, before its operationTime is updated.
+        boost::optional<DocumentSourceWriteBehind> writeBehind;
+        if (canWriteBehind() && DocumentSourceWriteBehind::canWriteBehind(pExpCtx)) {
+            writeBehind.emplace(pExpCtx);
+        }
+        auto spillBatch = [&](BatchedObjects&& batch) {
+            if (!writeBehind) {
+                spill(pExpCtx, std::move(batch));
+                return;
+            }
+            writeBehind->schedule(
+                [this, batch = std::move(batch)](
+                    const boost::intrusive_ptr<ExpressionContext>& writeExpCtx) mutable {
+                    spill(writeExpCtx, std::move(batch));
+                });
+        };
+
         BatchedObjects batch;
         int bufferedBytes = 0;
 
@@ -210,16 +288,19 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             if (!batch.empty() &&
                 (bufferedBytes > BSONObjMaxUserSize ||
                  batch.size() >= write_ops::kMaxWriteBatchSize)) {
-                spill(std::move(batch));
+                spillBatch(std::move(batch));
                 batch.clear();
                 bufferedBytes = objSize;
             }
             batch.push_back(obj);
         }
         if (!batch.empty()) {
-            spill(std::move(batch));
+            spillBatch(std::move(batch));
             batch.clear();
         }
+        if (writeBehind) {
+            writeBehind->wait();
+        }
 
         switch (nextInput.getStatus()) {
             case GetNextResult::ReturnStatus::kAdvanced: {
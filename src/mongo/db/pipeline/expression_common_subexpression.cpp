@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_common_subexpression.h"
+
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/expression_js_emit.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+/**
+ * Returns true if 'expr' may produce a different value each time it is evaluated on the same
+ * document, or has side effects.
+ */
+bool isNondeterministic(const Expression* expr) {
+    return dynamic_cast<const ExpressionRandom*>(expr) ||
+        dynamic_cast<const ExpressionFunction*>(expr) ||
+        dynamic_cast<const ExpressionInternalJsEmit*>(expr);
+}
+
+/**
+ * Returns the serialization of 'expr' as BSON bytes, which are the same for two subexpressions
+ * exactly if they compute the same value, given that neither refers to user variables.
+ */
+std::string makeKey(const Expression& expr) {
+    BSONObjBuilder bob;
+    expr.serialize(false).addToBsonObj(&bob, "");
+    const auto obj = bob.done();
+    return std::string(obj.objdata(), obj.objsize());
+}
+
+class Eliminator {
+public:
+    /**
+     * Records the key of every sharable subexpression of 'expr', returning whether the whole
+     * subtree is deterministic.
+     */
+    bool count(const Expression* expr) {
+        bool deterministic = !isNondeterministic(expr);
+        for (auto&& child : expr->getChildren()) {
+            // Some expressions keep a null child for an omitted optional argument.
+            if (child && !count(child.get())) {
+                deterministic = false;
+            }
+        }
+        if (deterministic && isCandidate(expr)) {
+            auto key = makeKey(*expr);
+            ++_occurrences[key];
+            _keys.emplace(expr, std::move(key));
+        }
+        return deterministic;
+    }
+
+    /**
+     * Replaces 'slot', or else its subexpressions, with the shared node for its key if that occurs
+     * more than once.
+     */
+    void share(boost::intrusive_ptr<Expression>* slot) {
+        if (!*slot) {
+            return;
+        }
+        Expression* const expr = slot->get();
+        if (auto keyIt = _keys.find(expr);
+            keyIt != _keys.end() && _occurrences[keyIt->second] > 1) {
+            auto& shared = _shared[keyIt->second];
+            if (shared) {
+                *slot = shared;
+                return;
+            }
+            shared = new ExpressionCommonSubexpression(expr->getExpressionContext(), *slot);
+            _result.push_back(shared);
+            *slot = shared;
+            // The subexpressions of the first occurrence, which the shared node evaluates, may
+            // also occur elsewhere on their own.
+        }
+        for (auto&& child : expr->getChildren()) {
+            share(&child);
+        }
+    }
+
+    std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>> release() {
+        return std::move(_result);
+    }
+
+private:
+    static bool isCandidate(const Expression* expr) {
+        if (dynamic_cast<const ExpressionConstant*>(expr) ||
+            dynamic_cast<const ExpressionFieldPath*>(expr) ||
+            dynamic_cast<const ExpressionCommonSubexpression*>(expr)) {
+            return false;
+        }
+        // The value of a subexpression which refers to a user variable, such as the '$$this' of
+        // a $map, may change while evaluating a single document.
+        DepsTracker deps;
+        expr->addDependencies(&deps);
+        return deps.vars.empty();
+    }
+
+    StringMap<int> _occurrences;
+    stdx::unordered_map<const Expression*, std::string> _keys;
+    StringMap<boost::intrusive_ptr<ExpressionCommonSubexpression>> _shared;
+    std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>> _result;
+};
+}  // namespace
+
+std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>>
+ExpressionCommonSubexpression::eliminate(
+    const std::vector<boost::intrusive_ptr<Expression>*>& expressions) {
+    if (!internalQueryEliminateCommonSubexpressions.load()) {
+        return {};
+    }
+
+    Eliminator eliminator;
+    for (auto&& slot : expressions) {
+        if (*slot) {
+            eliminator.count(slot->get());
+        }
+    }
+    for (auto&& slot : expressions) {
+        eliminator.share(slot);
+    }
+    return eliminator.release();
+}
+}  // namespace mongo
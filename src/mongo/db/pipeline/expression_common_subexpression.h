@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+/**
+ * Evaluates a subexpression which occurs several times among the expressions of a stage once per
+ * input document. Every occurrence is replaced by the same ExpressionCommonSubexpression, which
+ * keeps the value of its first evaluation until the stage calls reset() before the next document.
+ *
+ * These are only created once a stage starts executing, so that no stage rewrite can carry them
+ * into another context, and are transparent to serialization.
+ */
+class ExpressionCommonSubexpression final : public Expression {
+public:
+    /**
+     * Replaces each subexpression which occurs more than once among the expressions pointed to by
+     * 'expressions' with a shared ExpressionCommonSubexpression, and returns those. The caller
+     * must reset() each of them between input documents. A subexpression is only shared if its
+     * value depends on nothing but the input document and the system variables, which are
+     * constant for the whole query. Constants and field paths are left alone, since they are no
+     * cheaper to cache than to evaluate.
+     */
+    static std::vector<boost::intrusive_ptr<ExpressionCommonSubexpression>> eliminate(
+        const std::vector<boost::intrusive_ptr<Expression>*>& expressions);
+
+    ExpressionCommonSubexpression(ExpressionContext* const expCtx,
+                                  boost::intrusive_ptr<Expression> subexpression)
+        : Expression(expCtx, {std::move(subexpression)}) {}
+
+    Value evaluate(const Document& root, Variables* variables) const final {
+        if (!_value) {
+            _value = _children[0]->evaluate(root, variables);
+        }
+        return *_value;
+    }
+
+    Value serialize(bool explain) const final {
+        return _children[0]->serialize(explain);
+    }
+
+    boost::intrusive_ptr<Expression> optimize() final {
+        _children[0] = _children[0]->optimize();
+        return this;
+    }
+
+    void acceptVisitor(ExpressionVisitor* visitor) final {
+        return visitor->visit(this);
+    }
+
+    /**
+     * Discards the value computed for the current input document.
+     */
+    void reset() {
+        _value = boost::none;
+    }
+
+private:
+    void _doAddDependencies(DepsTracker* deps) const final {
+        _children[0]->addDependencies(deps);
+    }
+
+    mutable boost::optional<Value> _value;
+};
+}  // namespace mongo
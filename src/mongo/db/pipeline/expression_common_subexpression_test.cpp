@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/json.h"
+#include "mongo/db/pipeline/expression_common_subexpression.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+using boost::intrusive_ptr;
+
+intrusive_ptr<Expression> parse(ExpressionContext* expCtx, const std::string& json) {
+    auto obj = fromjson("{expr: " + json + "}");
+    return Expression::parseOperand(expCtx, obj.firstElement(), expCtx->variablesParseState);
+}
+
+std::vector<intrusive_ptr<ExpressionCommonSubexpression>> eliminate(
+    std::vector<intrusive_ptr<Expression>>* expressions) {
+    std::vector<intrusive_ptr<Expression>*> slots;
+    for (auto&& expr : *expressions) {
+        slots.push_back(&expr);
+    }
+    return ExpressionCommonSubexpression::eliminate(slots);
+}
+
+TEST(ExpressionCommonSubexpressionTest, RepeatedSubexpressionIsSharedAcrossExpressions) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{
+        parse(&expCtx, "{$multiply: [{$add: ['$a', 1]}, 2]}"),
+        parse(&expCtx, "{$add: ['$a', 1]}")};
+
+    auto shared = eliminate(&expressions);
+    ASSERT_EQ(shared.size(), 1U);
+    ASSERT_EQ(expressions[1].get(), shared[0].get());
+    ASSERT_EQ(expressions[0]->getChildren()[0].get(), shared[0].get());
+
+    // Sharing is invisible to serialization.
+    ASSERT_VALUE_EQ(expressions[0]->serialize(false),
+                    parse(&expCtx, "{$multiply: [{$add: ['$a', 1]}, 2]}")->serialize(false));
+    ASSERT_VALUE_EQ(expressions[1]->serialize(false),
+                    parse(&expCtx, "{$add: ['$a', 1]}")->serialize(false));
+}
+
+TEST(ExpressionCommonSubexpressionTest, SharedValueIsKeptUntilReset) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{
+        parse(&expCtx, "{$multiply: [{$add: ['$a', 1]}, 2]}"),
+        parse(&expCtx, "{$add: ['$a', 1]}")};
+    auto shared = eliminate(&expressions);
+    ASSERT_EQ(shared.size(), 1U);
+
+    auto first = Document{{"a", 1}};
+    ASSERT_VALUE_EQ(expressions[0]->evaluate(first, &expCtx.variables), Value(4));
+    ASSERT_VALUE_EQ(expressions[1]->evaluate(first, &expCtx.variables), Value(2));
+
+    // Without a reset the value computed for the previous document is returned.
+    auto second = Document{{"a", 10}};
+    ASSERT_VALUE_EQ(expressions[1]->evaluate(second, &expCtx.variables), Value(2));
+
+    shared[0]->reset();
+    ASSERT_VALUE_EQ(expressions[1]->evaluate(second, &expCtx.variables), Value(11));
+    ASSERT_VALUE_EQ(expressions[0]->evaluate(second, &expCtx.variables), Value(22));
+}
+
+TEST(ExpressionCommonSubexpressionTest, FieldPathsAndConstantsAreNotShared) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{parse(&expCtx, "{$add: ['$a', 1]}"),
+                                                       parse(&expCtx, "{$multiply: ['$a', 1]}")};
+    ASSERT(eliminate(&expressions).empty());
+}
+
+TEST(ExpressionCommonSubexpressionTest, NondeterministicSubexpressionIsNotShared) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{
+        parse(&expCtx, "{$multiply: [{$rand: {}}, 10]}"),
+        parse(&expCtx, "{$multiply: [{$rand: {}}, 10]}")};
+    ASSERT(eliminate(&expressions).empty());
+}
+
+TEST(ExpressionCommonSubexpressionTest, SubexpressionReferringToUserVariableIsNotShared) {
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{
+        parse(&expCtx, "{$map: {input: '$arr', in: {$add: ['$$this', 1]}}}"),
+        parse(&expCtx, "{$map: {input: '$arr', in: {$add: ['$$this', 1]}}}")};
+    ASSERT(eliminate(&expressions).empty());
+}
+
+TEST(ExpressionCommonSubexpressionTest, NothingIsSharedWhenDisabled) {
+    const bool oldValue = internalQueryEliminateCommonSubexpressions.load();
+    ON_BLOCK_EXIT([&] { internalQueryEliminateCommonSubexpressions.store(oldValue); });
+    internalQueryEliminateCommonSubexpressions.store(false);
+
+    auto expCtx = ExpressionContextForTest{};
+    std::vector<intrusive_ptr<Expression>> expressions{parse(&expCtx, "{$add: ['$a', 1]}"),
+                                                       parse(&expCtx, "{$add: ['$a', 1]}")};
+    ASSERT(eliminate(&expressions).empty());
+}
+}  // namespace
+}  // namespace mongo
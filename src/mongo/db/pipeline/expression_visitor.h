@@ -150,6 +150,7 @@ class ExpressionInternalFindPositional;
 class ExpressionInternalFindElemMatch;
 class ExpressionInternalJsEmit;
 class ExpressionFunction;
+class ExpressionCommonSubexpression;
 class ExpressionDegreesToRadians;
 class ExpressionRadiansToDegrees;
 
@@ -297,6 +298,7 @@ public:
     virtual void visit(ExpressionTests::Testable*) = 0;
     virtual void visit(ExpressionInternalJsEmit*) = 0;
     virtual void visit(ExpressionFunction*) = 0;
+    virtual void visit(ExpressionCommonSubexpression*) = 0;
     virtual void visit(ExpressionInternalFindSlice*) = 0;
     virtual void visit(ExpressionInternalFindPositional*) = 0;
     virtual void visit(ExpressionInternalFindElemMatch*) = 0;
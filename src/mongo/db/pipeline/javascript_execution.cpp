@@ -34,14 +34,97 @@
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Scopes older than this are not reused, which bounds how long garbage left behind by earlier
+// operations can accumulate in one.
+constexpr Seconds kMaxScopeReuseTime{10};
+
+/**
+ * The scope which the last operation to run JavaScript on this thread left behind, for the next
+ * one with the same pool key. Scopes created by newScopeForCurrentThread() can only run on the
+ * thread which created them, and a thread can only have one at a time, so any idle scope must be
+ * destroyed before another is created.
+ */
+struct IdleScope {
+    ~IdleScope() {
+        if (scope) {
+            numIdleScopes.subtractAndFetch(1);
+        }
+    }
+
+    std::unique_ptr<Scope> take() {
+        if (scope) {
+            numIdleScopes.subtractAndFetch(1);
+        }
+        return std::move(scope);
+    }
+
+    // The number of idle scopes across all threads, at most internalQueryJavaScriptMaxIdleScopes.
+    static inline AtomicWord<int> numIdleScopes;
+
+    std::string poolKey;
+    std::unique_ptr<Scope> scope;
+};
+
+thread_local IdleScope idleScope;
+
+/**
+ * Returns the key under which a scope for this operation may be reused, or an empty string if it
+ * must not be. Global variables set by user functions survive in a reused scope, so scopes are
+ * only shared between operations of the same users.
+ */
+std::string makePoolKey(OperationContext* opCtx,
+                        StringData database,
+                        bool loadStoredProcedures,
+                        boost::optional<int> jsHeapLimitMB) {
+    auto client = opCtx->getClient();
+    if (internalQueryJavaScriptMaxIdleScopes.load() <= 0 || !AuthorizationSession::exists(client)) {
+        return {};
+    }
+
+    StringBuilder sb;
+    sb << database << '\0' << loadStoredProcedures << '\0' << jsHeapLimitMB.value_or(0);
+    auto as = AuthorizationSession::get(client);
+    for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+        // Using a NUL byte which isn't valid in usernames to separate them.
+        sb << '\0' << nameIter->getUnambiguousName();
+    }
+    return sb.str();
+}
 }  // namespace
 
+JsExecution::JsExecution(OperationContext* opCtx, std::unique_ptr<Scope> scope, std::string poolKey)
+    : _scope(std::move(scope)), _poolKey(std::move(poolKey)) {
+    _scope->reset();
+    _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
+    _scope->registerOperation(opCtx);
+}
+
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+
+    // Scopes which failed, or which hold an 'emit' function bound to this operation, are not
+    // reused.
+    if (_poolKey.empty() || _emitCreated || _scope->hasOutOfMemoryException() ||
+        !_scope->getError().empty() ||
+        Date_t::now() - _scope->getCreateTime() > kMaxScopeReuseTime || idleScope.scope) {
+        return;
+    }
+    if (IdleScope::numIdleScopes.addAndFetch(1) > internalQueryJavaScriptMaxIdleScopes.load()) {
+        IdleScope::numIdleScopes.subtractAndFetch(1);
+        return;
+    }
+    idleScope.poolKey = std::move(_poolKey);
+    idleScope.scope = std::move(_scope);
+}
+
 JsExecution* JsExecution::get(OperationContext* opCtx,
                               const BSONObj& scope,
                               StringData database,
@@ -49,7 +132,18 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        auto poolKey = scope.isEmpty()
+            ? makePoolKey(opCtx, database, loadStoredProcedures, jsHeapLimitMB)
+            : std::string();
+        const bool keyMatches = !poolKey.empty() && poolKey == idleScope.poolKey;
+        if (auto idle = idleScope.take(); idle && keyMatches) {
+            exec.reset(new JsExecution(opCtx, std::move(idle), std::move(poolKey)));
+        } else {
+            // Destroy any idle scope which can't be reused before creating the new one.
+            idle.reset();
+            exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+            exec->_poolKey = std::move(poolKey);
+        }
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
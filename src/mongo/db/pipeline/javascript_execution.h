@@ -52,6 +52,10 @@ public:
      * and reading the return value. If `loadStoredProcedures` is true, this will load all stored
      * procedures from database unless 'disableLoadStored' is set on the global ScriptEngine. The
      * JsExecution* returned is owned by 'opCtx'.
+     *
+     * When no scope variables are given, the scope is reused from an earlier operation on this
+     * thread by the same users on the same database if there is one, along with the functions it
+     * has compiled, and is kept for a later operation once 'opCtx' is done with it.
      */
     static JsExecution* get(OperationContext* opCtx,
                             const BSONObj& scope,
@@ -71,9 +75,7 @@ public:
         _scope->registerOperation(opCtx);
     }
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    ~JsExecution();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -116,8 +118,19 @@ public:
     }
 
 private:
+    /**
+     * Construct with a reused thread-local scope, which is returned to the idle scope of this
+     * thread under 'poolKey' on destruction.
+     */
+    JsExecution(OperationContext* opCtx, std::unique_ptr<Scope> scope, std::string poolKey);
+
     BSONObj _scopeVars;
     std::unique_ptr<Scope> _scope;
+
+    // Identifies the operations which may reuse '_scope' once this one is done with it. Empty if
+    // '_scope' must not be reused.
+    std::string _poolKey;
+
     bool _emitCreated = false;
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
@@ -122,6 +122,42 @@ public:
         _memoryUsage += docSize;
     }
 
+    /**
+     * Insert the documents "docs" into the set with key "key", like insert() does for each of them.
+     * Unlike insert(), this adds "key" to the cache even if "docs" is empty, so that an empty set
+     * can be distinguished from a missing one.
+     */
+    void insert(Value key, std::vector<Document> docs) {
+        size_t middle = size() / 2;
+        auto it = _container.begin();
+        std::advance(it, middle);
+        const auto keySize = key.getApproximateSize();
+
+        auto insertionResult = _container.insert(it, {std::move(key), {}});
+        if (insertionResult.second) {
+            _memoryUsage += keySize;
+        } else {
+            _container.relocate(it, insertionResult.first);
+        }
+
+        for (auto&& doc : docs) {
+            _memoryUsage += doc.getApproximateSize();
+        }
+        _container.modify(insertionResult.first,
+                          [&docs](std::pair<Value, std::vector<Document>>& entry) {
+                              entry.second.insert(entry.second.end(),
+                                                  std::make_move_iterator(docs.begin()),
+                                                  std::make_move_iterator(docs.end()));
+                          });
+    }
+
+    /**
+     * Returns the approximate size of the keys and documents in the cache.
+     */
+    size_t getMemoryUsage() const {
+        return _memoryUsage;
+    }
+
     /**
      * Evict the least-recently-used item.
      */
@@ -207,4 +207,27 @@ TEST(LookupSetCacheTest, CachedValuesDontRespectCollation) {
     ASSERT_EQ(2U, fooResult->size());
 }
 
+TEST(LookupSetCacheTest, InsertingASetKeepsEmptySetsAndCountsItsMemory) {
+    LookupSetCache cache(defaultComparator);
+
+    cache.insert(Value(0), std::vector<Document>{});
+    cache.insert(Value(1), std::vector<Document>{intToDoc(1), intToDoc(2)});
+    ASSERT(cache[Value(0)]);
+    ASSERT_EQ(0U, cache[Value(0)]->size());
+    ASSERT_EQ(2U, cache[Value(1)]->size());
+    ASSERT_FALSE(cache[Value(2)]);
+
+    const auto memoryUsage = static_cast<size_t>(Value(0).getApproximateSize() +
+                                                 Value(1).getApproximateSize() +
+                                                 intToDoc(1).getApproximateSize() +
+                                                 intToDoc(2).getApproximateSize());
+    ASSERT_EQ(memoryUsage, cache.getMemoryUsage());
+
+    // Both sets are evicted, after which no memory is used.
+    cache.evictDownTo(0);
+    ASSERT_FALSE(cache[Value(0)]);
+    ASSERT_FALSE(cache[Value(1)]);
+    ASSERT_EQ(0U, cache.getMemoryUsage());
+}
+
 }  // namespace mongo
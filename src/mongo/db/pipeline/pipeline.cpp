@@ -60,6 +60,10 @@ Value appendExecStats(Value docSource, const CommonStats& stats) {
     auto executionTimeMillisEstimate = static_cast<long long>(*stats.executionTimeMillis);
     doc.addField("nReturned", Value(nReturned));
     doc.addField("executionTimeMillisEstimate", Value(executionTimeMillisEstimate));
+    if (stats.sampledExecutionTimeMicros) {
+        doc.addField("executionTimeMicrosEstimate",
+                     Value(static_cast<long long>(*stats.sampledExecutionTimeMicros)));
+    }
     return Value(doc.freeze());
 }
 
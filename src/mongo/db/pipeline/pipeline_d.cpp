@@ -38,6 +38,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/index_catalog_entry.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -49,6 +50,7 @@
 #include "mongo/db/exec/trial_stage.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops_exec.h"
@@ -69,6 +71,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -89,6 +92,67 @@ using std::unique_ptr;
 using write_ops::Insert;
 
 namespace {
+/**
+ * Reads runs of 'blockSize' consecutive records, each starting at a record returned by a random
+ * cursor. Neighboring records are mostly stored on the same page, so a large sample needs far fewer
+ * random positionings of the storage engine.
+ */
+class BlockSamplingRecordCursor final : public RecordCursor {
+public:
+    BlockSamplingRecordCursor(std::unique_ptr<RecordCursor> randomCursor,
+                              std::unique_ptr<SeekableRecordCursor> forwardCursor,
+                              int blockSize)
+        : _randomCursor(std::move(randomCursor)),
+          _forwardCursor(std::move(forwardCursor)),
+          _blockSize(blockSize) {}
+
+    boost::optional<Record> next() final {
+        if (_remainingInBlock > 0) {
+            --_remainingInBlock;
+            if (auto record = _forwardCursor->next()) {
+                return record;
+            }
+            // The block ran past the end of the collection, so start another one.
+        }
+
+        auto record = _randomCursor->next();
+        if (record) {
+            // The random cursor's record stays valid while the forward cursor moves.
+            _remainingInBlock = _forwardCursor->seekExact(record->id) ? _blockSize - 1 : 0;
+        }
+        return record;
+    }
+
+    void save() final {
+        _randomCursor->save();
+        _forwardCursor->save();
+    }
+
+    bool restore() final {
+        const bool restoredRandom = _randomCursor->restore();
+        const bool restoredForward = _forwardCursor->restore();
+        return restoredRandom && restoredForward;
+    }
+
+    void detachFromOperationContext() final {
+        _randomCursor->detachFromOperationContext();
+        _forwardCursor->detachFromOperationContext();
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) final {
+        _randomCursor->reattachToOperationContext(opCtx);
+        _forwardCursor->reattachToOperationContext(opCtx);
+    }
+
+private:
+    std::unique_ptr<RecordCursor> _randomCursor;
+    std::unique_ptr<SeekableRecordCursor> _forwardCursor;
+    const int _blockSize;
+
+    // The number of records still to read from the forward cursor before the next random position.
+    int _remainingInBlock = 0;
+};
+
 /**
  * Returns a PlanExecutor which uses a random cursor to sample documents if successful. Returns {}
  * if the storage engine doesn't support random cursors, or if 'sampleSize' is a large enough
@@ -110,17 +174,25 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorEx
     // function because double-locking forces any PlanExecutor we create to adopt a NO_YIELD policy.
     invariant(opCtx->lockState()->isCollectionLockedForMode(coll->ns(), MODE_IS));
 
-    static const double kMaxSampleRatioForRandCursor = 0.05;
-    if (sampleSize > numRecords * kMaxSampleRatioForRandCursor || numRecords <= 100) {
+    const double maxSampleRatio = internalQueryMaxSampleRatioForRandomCursor.load();
+    if (sampleSize > numRecords * maxSampleRatio || numRecords <= 100) {
         return {nullptr};
     }
 
-    // Attempt to get a random cursor from the RecordStore.
-    auto rsRandCursor = coll->getRecordStore()->getRandomCursor(opCtx);
+    // Attempt to get a random cursor from the RecordStore, telling it how many random positions we
+    // expect to read from.
+    const int blockSize = internalQuerySampleFromRandomCursorBlockSize.load();
+    const long long numRandomPositions = std::max(1LL, (sampleSize + blockSize - 1) / blockSize);
+    std::unique_ptr<RecordCursor> rsRandCursor =
+        coll->getRecordStore()->getRandomCursorForSampleSize(opCtx, numRandomPositions);
     if (!rsRandCursor) {
         // The storage engine has no random cursor support.
         return {nullptr};
     }
+    if (blockSize > 1) {
+        rsRandCursor = std::make_unique<BlockSamplingRecordCursor>(
+            std::move(rsRandCursor), coll->getCursor(opCtx), blockSize);
+    }
 
     // Build a MultiIteratorStage and pass it the random-sampling RecordCursor.
     auto ws = std::make_unique<WorkingSet>();
@@ -149,7 +221,7 @@ StatusWith<unique_ptr<PlanExecutor, PlanExecutor::Deleter>> createRandomCursorEx
         // of the documents in the collection are owned, we default to the backup plan.
         static const size_t kMaxPresampleSize = 100;
         const auto minWorkAdvancedRatio = std::max(
-            sampleSize / (numRecords * kMaxSampleRatioForRandCursor), kMaxSampleRatioForRandCursor);
+            sampleSize / (numRecords * maxSampleRatio), maxSampleRatio);
         // The trial plan is SHARDING_FILTER-MULTI_ITERATOR.
         auto randomCursorPlan = std::make_unique<ShardFilterStage>(
             expCtx.get(), collectionFilter, ws.get(), std::move(root));
@@ -310,6 +382,76 @@ StringData extractGeoNearFieldFromIndexes(OperationContext* opCtx, const Collect
     }
     MONGO_UNREACHABLE;
 }
+
+/**
+ * If the pipeline starts with a $group on a single field which only counts its documents, such as
+ * {$group: {_id: "$a", n: {$sum: 1}}}, and the query only restricts that field, the $group can be
+ * computed from the keys of an index on the field: scanning the index in order is a covered plan
+ * which yields each group's documents one after the other. Returns the sort on the group key
+ * which makes the query planner pick such an index scan, or boost::none if there is no suitable
+ * index.
+ */
+boost::optional<BSONObj> getSortForIndexedGroupCount(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const Collection* collection,
+    Pipeline* pipeline,
+    const BSONObj& queryObj) {
+    if (!collection) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    if (!groupStage || !groupStage->accumulatesOnlyConstants()) {
+        return boost::none;
+    }
+
+    const auto groupKey = groupStage->getSingleFieldGroupKey();
+    if (!groupKey) {
+        return boost::none;
+    }
+
+    // A predicate on any other field would have to be evaluated against the documents.
+    for (auto&& elem : queryObj) {
+        if (elem.fieldNameStringData() != *groupKey) {
+            return boost::none;
+        }
+    }
+
+    // On a sharded collection the documents are filtered by shard key, which the index must then
+    // cover as well.
+    const auto collDesc = CollectionShardingState::get(expCtx->opCtx, collection->ns())
+                              ->getCollectionDescription(expCtx->opCtx);
+    auto coversShardKey = [&](const IndexDescriptor* desc) {
+        if (!collDesc.isSharded()) {
+            return true;
+        }
+        const auto& shardKeyFields = collDesc.getKeyPatternFields();
+        return std::all_of(
+            shardKeyFields.begin(), shardKeyFields.end(), [&](const auto& shardKeyField) {
+                return desc->keyPattern().hasField(shardKeyField->dottedField());
+            });
+    };
+
+    // The index scan only covers the group key if the index has one key per document, and the
+    // planner only uses it to provide the sort if it indexes every document and compares strings
+    // the way the query does.
+    auto indexIterator = collection->getIndexCatalog()->getIndexIterator(expCtx->opCtx, false);
+    while (indexIterator->more()) {
+        const IndexCatalogEntry* entry = indexIterator->next();
+        const IndexDescriptor* desc = entry->descriptor();
+        if (desc->getIndexType() != INDEX_BTREE || desc->hidden() || desc->isSparse() ||
+            desc->isPartial() || entry->isMultikey() ||
+            !CollatorInterface::collatorsMatch(entry->getCollator(), expCtx->getCollator())) {
+            continue;
+        }
+
+        const BSONElement firstKeyElem = desc->keyPattern().firstElement();
+        if (firstKeyElem.fieldNameStringData() == *groupKey && coversShardKey(desc)) {
+            return BSON(*groupKey << (firstKeyElem.number() < 0 ? -1 : 1));
+        }
+    }
+    return boost::none;
+}
 }  // namespace
 
 std::pair<PipelineD::AttachExecutorCallback, std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
@@ -739,18 +881,45 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
-    return attemptToGetExecutor(expCtx,
-                                collection,
-                                nss,
-                                queryObj,
-                                projObj,
-                                deps.metadataDeps(),
-                                sortObj,
-                                limit,
-                                boost::none, /* groupIdForDistinctScan */
-                                aggRequest,
-                                plannerOpts,
-                                matcherFeatures);
+    // A $group which counts the documents per value of an indexed field asks for its input in
+    // index order, so that it is computed from a covered index scan rather than a collection scan.
+    // A $limit before the $group, or a hint, would make the sort apply to the wrong documents or be
+    // a blocking one.
+    bool sortedForGroup = false;
+    if (!sortStage && !limit && !(aggRequest && !aggRequest->getHint().isEmpty()) &&
+        internalQueryGroupCountUsesIndexOrder.load()) {
+        if (auto groupSort = getSortForIndexedGroupCount(expCtx, collection, pipeline, queryObj)) {
+            sortObj = std::move(*groupSort);
+            sortedForGroup = true;
+        }
+    }
+
+    auto swExecutor = attemptToGetExecutor(expCtx,
+                                           collection,
+                                           nss,
+                                           queryObj,
+                                           projObj,
+                                           deps.metadataDeps(),
+                                           sortObj,
+                                           limit,
+                                           boost::none, /* groupIdForDistinctScan */
+                                           aggRequest,
+                                           plannerOpts,
+                                           matcherFeatures);
+
+    // The executor returns the documents in the order of the pushed down $sort. If the $group which
+    // followed the $sort groups on the leading fields of the sort pattern, it can output each group
+    // as soon as the group key changes rather than waiting for the end of its input.
+    if (swExecutor.isOK() && (sortStage || sortedForGroup) &&
+        internalQueryEnableStreamingGroup.load()) {
+        auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+        if (groupStage &&
+            (sortedForGroup ||
+             groupStage->groupKeyCoveredBySort(sortStage->getSortKeyPattern()))) {
+            groupStage->setStreaming(true);
+        }
+    }
+    return swExecutor;
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
@@ -33,6 +33,7 @@
 
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
 
 namespace mongo {
@@ -49,6 +50,10 @@ PlanExecutorPipeline::PlanExecutorPipeline(boost::intrusive_ptr<ExpressionContex
     // again when it is destroyed.
     _pipeline.get_deleter().dismissDisposal();
 
+    if (internalQueryEnableDocumentBufferCache.load()) {
+        _documentBufferCache = std::make_unique<DocumentStorageBufferCache>();
+    }
+
     if (_isChangeStream) {
         // Set _postBatchResumeToken to the initial PBRT that was added to the expression context
         // during pipeline construction, and use it to obtain the starting time for
@@ -66,6 +71,9 @@ PlanExecutor::ExecState PlanExecutorPipeline::getNext(BSONObj* objOut, RecordId*
     invariant(!recordIdOut);
     invariant(objOut);
 
+    // Declared before 'docOut', so that its buffer goes back to the cache once it is serialized.
+    DocumentStorageBufferCache::Scope bufferCacheScope(_documentBufferCache.get());
+
     if (!_stash.empty()) {
         *objOut = std::move(_stash.front());
         _stash.pop();
@@ -94,6 +102,7 @@ PlanExecutor::ExecState PlanExecutorPipeline::getNextDocument(Document* docOut,
     // use 'getNext()'.
     invariant(_stash.empty());
 
+    DocumentStorageBufferCache::Scope bufferCacheScope(_documentBufferCache.get());
     if (auto next = _getNext()) {
         *docOut = std::move(*next);
         ++_nReturned;
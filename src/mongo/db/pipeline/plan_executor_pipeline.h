@@ -66,6 +66,9 @@ public:
 
     void detachFromOperationContext() override {
         _pipeline->detachFromOperationContext();
+        if (_documentBufferCache) {
+            _documentBufferCache->release();
+        }
     }
 
     void reattachToOperationContext(OperationContext* opCtx) override {
@@ -94,6 +97,7 @@ public:
 
     void dispose(OperationContext* opCtx) override {
         _pipeline->dispose(opCtx);
+        _documentBufferCache.reset();
     }
 
     void enqueue(const BSONObj& obj) override {
@@ -176,6 +180,11 @@ private:
 
     std::queue<BSONObj> _stash;
 
+    // Reuses the buffers of the documents freed while building a batch, when
+    // 'internalQueryEnableDocumentBufferCache' is set. The buffers are released once the batch is
+    // done, when the executor is detached from its operation context.
+    std::unique_ptr<DocumentStorageBufferCache> _documentBufferCache;
+
     // If _killStatus has a non-OK value, then we have been killed and the value represents the
     // reason for the kill.
     Status _killStatus = Status::OK();
@@ -422,6 +422,11 @@ std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCacheEntryStat
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> CommonMongodProcessInterface::getQueryShapeStats(
+    OperationContext* opCtx, const NamespaceString& nss) const {
+    return Top::get(opCtx->getServiceContext()).getQueryShapeStats(nss, true /* histograms */);
+}
+
 bool CommonMongodProcessInterface::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -201,6 +201,13 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    /**
+     * Query shape statistics are tracked by the shards, which run $queryShapeStats themselves.
+     */
+    std::vector<BSONObj> getQueryShapeStats(OperationContext*, const NamespaceString&) const final {
+        MONGO_UNREACHABLE;
+    }
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>&,
                                          const NamespaceString&,
                                          const std::set<FieldPath>& fieldPaths) const;
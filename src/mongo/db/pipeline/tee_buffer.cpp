@@ -50,6 +50,16 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_concurrentConsumers) {
+        if (_buffer.empty()) {
+            return DocumentSource::GetNextResult::makeEOF();
+        }
+        if (_consumers[consumerId].nLeftToReturn == 0) {
+            return DocumentSource::GetNextResult::makePauseExecution();
+        }
+        return _buffer[_buffer.size() - _consumers[consumerId].nLeftToReturn--];
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -76,6 +86,30 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+void TeeBuffer::startConcurrentBatch() {
+    invariant(!_concurrentConsumers);
+    loadNextBatch();
+
+    // Reading a field of a document constructs it in the document's cache, so every field is
+    // constructed up front to let the consumers read the documents at the same time.
+    for (auto&& result : _buffer) {
+        result.getDocument().loadIntoCache();
+    }
+    _concurrentConsumers = true;
+}
+
+void TeeBuffer::endConcurrentBatch() {
+    _concurrentConsumers = false;
+    if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        _buffer.clear();
+        if (_source) {
+            _source->dispose();
+        }
+    }
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
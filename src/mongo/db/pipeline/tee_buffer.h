@@ -66,6 +66,9 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
+        if (_concurrentConsumers) {
+            return;
+        }
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
@@ -83,6 +86,21 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Loads the next batch for consumers which then call getNext() and dispose() concurrently, each
+     * with its own 'consumerId'. The documents of the batch are loaded into their caches, so that
+     * the consumers can read them at the same time. Until endConcurrentBatch() is called,
+     * getNext() only returns documents from this batch, and returns
+     * GetNextState::ResultState::kPauseExecution once the consumer has seen all of them.
+     */
+    void startConcurrentBatch();
+
+    /**
+     * Called once all the concurrent consumers of the batch loaded by startConcurrentBatch() have
+     * returned. Disposes of the source if none of them is still in use.
+     */
+    void endConcurrentBatch();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -103,5 +121,9 @@ private:
         int nLeftToReturn = 0;
     };
     std::vector<ConsumerInfo> _consumers;
+
+    // Set between startConcurrentBatch() and endConcurrentBatch(). While set, each consumer only
+    // touches its own ConsumerInfo, and '_buffer' and '_source' are left alone.
+    bool _concurrentConsumers = false;
 };
 }  // namespace mongo
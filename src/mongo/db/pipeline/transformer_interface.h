@@ -61,6 +61,13 @@ public:
     virtual DepsTracker::State addDependencies(DepsTracker* deps) const = 0;
     virtual DocumentSource::GetModPathsReturn getModifiedPaths() const = 0;
 
+    /**
+     * Called once before the first document is transformed, after which the expressions of this
+     * transformation are no longer rewritten. A transformation may use it to evaluate each
+     * subexpression which occurs more than once among its expressions only once per document.
+     */
+    virtual void eliminateCommonSubexpressions() {}
+
     /**
      * Returns a document describing this transformation. For example, this function will return
      * {_id: 0, x: 1} for the stage parsed from {$project: {_id: 0, x: 1}}.
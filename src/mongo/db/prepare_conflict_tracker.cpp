@@ -28,6 +28,7 @@
  */
 
 #include "mongo/db/prepare_conflict_tracker.h"
+#include "mongo/db/wait_event.h"
 #include "mongo/platform/basic.h"
 
 namespace mongo {
@@ -44,6 +45,8 @@ void PrepareConflictTracker::beginPrepareConflict(OperationContext* opCtx) {
     _waitOnPrepareConflict.store(true);
     invariant(_prepareConflictStartTime == 0);
     _prepareConflictStartTime = opCtx->getServiceContext()->getTickSource()->getTicks();
+    _isRecordingWaitEvent =
+        WaitEventStats::get(opCtx).beginWait(opCtx, WaitEvent::kPrepareConflict);
 }
 
 void PrepareConflictTracker::endPrepareConflict(OperationContext* opCtx) {
@@ -62,6 +65,11 @@ void PrepareConflictTracker::endPrepareConflict(OperationContext* opCtx) {
         _prepareConflictDuration.store(_prepareConflictDuration.load() + curConflictDuration);
         _prepareConflictStartTime = 0;
 
+        if (_isRecordingWaitEvent) {
+            WaitEventStats::get(opCtx).endWait(opCtx);
+            _isRecordingWaitEvent = false;
+        }
+
         // Implies that the current read operation is not blocked on a prepared transaction.
         _waitOnPrepareConflict.store(false);
     }
@@ -83,6 +83,11 @@ private:
      */
     TickSource::Tick _prepareConflictStartTime{0};
 
+    /**
+     * Set to true when the current prepare conflict is recorded as a wait event for the operation.
+     */
+    bool _isRecordingWaitEvent{false};
+
     /**
      * Stores the total amount of time spent blocked on prepare read conflicts.
      */
@@ -84,6 +84,8 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.maxTs = csn->maxTs;
             params.requestResumeToken = csn->requestResumeToken;
             params.resumeAfterRecordId = csn->resumeAfterRecordId;
+            params.minRecord = csn->minRecord;
+            params.maxRecord = csn->maxRecord;
             params.stopApplyingFilterAfterFirstMatch = csn->stopApplyingFilterAfterFirstMatch;
             return std::make_unique<CollectionScan>(
                 expCtx, _collection, params, _ws, csn->filter.get());
@@ -110,6 +112,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.direction = ixn->direction;
             params.addKeyMetadata = ixn->addKeyMetadata;
             params.shouldDedup = ixn->shouldDedup;
+            params.estimatedKeysExamined = ixn->estimatedKeysExamined;
             return std::make_unique<IndexScan>(
                 expCtx, _collection, std::move(params), _ws, ixn->filter.get());
         }
@@ -39,6 +39,10 @@
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+// Size of the stack buffer that sort keys are generated into before being copied to the heap.
+constexpr int32_t kStackSortKeySize = 256;
+}  // namespace
 
 CollatorInterfaceICU::CollatorInterfaceICU(CollationSpec spec,
                                            std::unique_ptr<icu::Collator> collator)
@@ -78,25 +82,34 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
-    UErrorCode status = U_ZERO_ERROR;
-    icu::CollationKey icuKey;
-    _collator->getCollationKey(icu::UnicodeString::fromUTF8(stringPiece), icuKey, status);
+    const auto unicodeString = icu::UnicodeString::fromUTF8(stringPiece);
+
+    // Sort keys are generated for every string in a collation-aware sort, so those of typical
+    // strings are written to the stack rather than to a heap allocated icu::CollationKey which
+    // would then be copied once more. Longer keys are written straight into the result.
+    uint8_t stackBuffer[kStackSortKeySize];
+    const int32_t keyLength = _collator->getSortKey(unicodeString, stackBuffer, kStackSortKeySize);
 
     // Any sequence of bytes, even invalid UTF-8, has defined comparison behavior in ICU (invalid
-    // subsequences are weighted as the replacement character, U+FFFD). A non-ok error code is only
+    // subsequences are weighted as the replacement character, U+FFFD). A zero length is only
     // expected when a memory allocation fails inside ICU, which we consider fatal to the process.
-    fassert(34439, U_SUCCESS(status));
-
-    int32_t keyLength;
-    const uint8_t* keyBuffer = icuKey.getByteArray(keyLength);
-    invariant(keyLength > 0);
-    invariant(keyBuffer);
+    fassert(34439, keyLength > 0);
+
+    std::string key;
+    if (keyLength <= kStackSortKeySize) {
+        key.assign(reinterpret_cast<const char*>(stackBuffer), keyLength);
+    } else {
+        key.resize(keyLength);
+        fassert(5191260,
+                _collator->getSortKey(
+                    unicodeString, reinterpret_cast<uint8_t*>(&key[0]), keyLength) == keyLength);
+    }
 
     // The last byte of the sort key should always be null. When we construct the comparison key, we
     // omit the trailing null byte.
-    invariant(keyBuffer[keyLength - 1u] == '\0');
-    const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
-    return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    invariant(key.back() == '\0');
+    key.pop_back();
+    return makeComparisonKey(std::move(key));
 }
 
 }  // namespace mongo
@@ -594,4 +594,11 @@ TEST(CollatorInterfaceICUTest, ComparisonKeysForFrCaCollatorCorrect) {
               "\x2D\x45\x4F\x31\x01\x88\x44\x8E\x06\x01\x0A");
 }
 
+TEST(CollatorInterfaceICUTest, ComparisonKeysLongerThanStackBufferAreComplete) {
+    const std::string prefix(1000, 'a');
+    assertLessThanEnUS(prefix + "b", prefix + "c");
+    assertLessThanEnUS(prefix + "a", prefix + "B");
+    assertEnUSComparison(prefix + "\xC3\xA9", prefix + "\xC3\xA9", ExpectedComparison::EQUAL);
+}
+
 }  // namespace
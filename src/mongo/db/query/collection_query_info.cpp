@@ -243,6 +243,27 @@ void CollectionQueryInfo::droppedIndex(OperationContext* opCtx,
         .unregisterIndex(indexName);
 }
 
+std::shared_ptr<const CollectionIndexStatistics> CollectionQueryInfo::getIndexStatistics(
+    const std::function<std::shared_ptr<const CollectionIndexStatistics>()>& loadFn) const {
+    const auto version = index_statistics::getPersistedVersion();
+    {
+        stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+        if (_indexStatisticsVersion == version) {
+            return _indexStatistics;
+        }
+    }
+
+    // Load the statistics without holding the mutex, as loading reads another collection.
+    auto stats = loadFn();
+
+    stdx::lock_guard<Latch> lk(_indexStatisticsMutex);
+    if (_indexStatisticsVersion < version) {
+        _indexStatisticsVersion = version;
+        _indexStatistics = stats;
+    }
+    return stats;
+}
+
 void CollectionQueryInfo::rebuildIndexData(OperationContext* opCtx, const Collection* coll) {
     clearQueryCache(coll);
 
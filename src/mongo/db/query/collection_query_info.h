@@ -29,10 +29,15 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/index_statistics.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -90,6 +95,14 @@ public:
                        const Collection* coll,
                        const PlanSummaryStats& summaryStats) const;
 
+    /**
+     * Returns the index statistics the analyze command stored for this collection, or nullptr if
+     * there are none. The statistics are read with 'loadFn' when they are first requested, and
+     * again after any statistics collection has been modified.
+     */
+    std::shared_ptr<const CollectionIndexStatistics> getIndexStatistics(
+        const std::function<std::shared_ptr<const CollectionIndexStatistics>()>& loadFn) const;
+
 private:
     void computeIndexKeys(OperationContext* opCtx, const Collection* coll);
     void updatePlanCacheIndexEntries(OperationContext* opCtx, const Collection* coll);
@@ -106,6 +119,13 @@ private:
 
     // A cache for query plans.
     std::unique_ptr<PlanCache> _planCache;
+
+    // The cached index statistics of the collection, and the version of the persisted statistics
+    // they were loaded at. A version of 0 means that they haven't been loaded yet.
+    mutable Mutex _indexStatisticsMutex =
+        MONGO_MAKE_LATCH("CollectionQueryInfo::_indexStatisticsMutex");
+    mutable uint64_t _indexStatisticsVersion{0};
+    mutable std::shared_ptr<const CollectionIndexStatistics> _indexStatistics;
 };
 
 }  // namespace mongo
@@ -197,6 +197,64 @@ void executePlan(PlanExecutor* exec) {
     }
 }
 
+/**
+ * Converts the SBE stats tree 'stats' into BSON, appending the result to 'bob'.
+ */
+void sbeStatsToBSON(const sbe::PlanStageStats& stats,
+                    ExplainOptions::Verbosity verbosity,
+                    BSONObjBuilder* bob) {
+    bob->append("stage", stats.common.stageType);
+
+    if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
+        bob->appendNumber("nReturned", static_cast<long long>(stats.common.advances));
+        bob->appendNumber("opens", static_cast<long long>(stats.common.opens));
+        bob->appendNumber("closes", static_cast<long long>(stats.common.closes));
+        bob->appendNumber("saveState", static_cast<long long>(stats.common.yields));
+        bob->appendNumber("restoreState", static_cast<long long>(stats.common.unyields));
+        bob->appendBool("isEOF", stats.common.isEOF);
+
+        if (auto spec = dynamic_cast<const sbe::HashAggStats*>(stats.specific.get())) {
+            bob->appendBool("usedDisk", spec->usedDisk);
+            bob->appendNumber("spills", static_cast<long long>(spec->spills));
+            bob->appendNumber("spilledRecords", static_cast<long long>(spec->spilledRecords));
+            bob->appendNumber("spilledBytes", static_cast<long long>(spec->spilledBytes));
+        }
+        if (auto spec = dynamic_cast<const SortStats*>(stats.specific.get())) {
+            bob->appendIntOrLL("memLimit", spec->maxMemoryUsageBytes);
+            if (spec->limit > 0) {
+                bob->appendIntOrLL("limitAmount", spec->limit);
+            }
+            bob->appendIntOrLL("totalDataSizeSorted", spec->totalDataSizeBytes);
+            bob->appendBool("usedDisk", spec->wasDiskUsed);
+            bob->appendIntOrLL("spills", spec->spills);
+        }
+        if (auto spec = dynamic_cast<const sbe::HashJoinStats*>(stats.specific.get())) {
+            bob->appendBool("usedDisk", spec->usedDisk);
+            bob->appendNumber("numPartitions", static_cast<long long>(spec->numPartitions));
+            bob->appendNumber("spilledOuterRecords",
+                              static_cast<long long>(spec->spilledOuterRecords));
+            bob->appendNumber("spilledInnerRecords",
+                              static_cast<long long>(spec->spilledInnerRecords));
+        }
+    }
+
+    if (stats.children.empty()) {
+        return;
+    }
+
+    if (stats.children.size() == 1) {
+        BSONObjBuilder childBob(bob->subobjStart("inputStage"));
+        sbeStatsToBSON(*stats.children[0], verbosity, &childBob);
+        return;
+    }
+
+    BSONArrayBuilder childrenBob(bob->subarrayStart("inputStages"));
+    for (auto&& child : stats.children) {
+        BSONObjBuilder childBob(childrenBob.subobjStart());
+        sbeStatsToBSON(*child, verbosity, &childBob);
+    }
+}
+
 }  // namespace
 
 namespace mongo {
@@ -284,6 +342,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (stats.common.executionTimeMillis) {
             bob->appendNumber("executionTimeMillisEstimate", *stats.common.executionTimeMillis);
         }
+        if (stats.common.sampledExecutionTimeMicros) {
+            bob->appendNumber("executionTimeMicrosEstimate",
+                              *stats.common.sampledExecutionTimeMicros);
+        }
 
         bob->appendNumber("works", stats.common.works);
         bob->appendNumber("advanced", stats.common.advanced);
@@ -326,6 +388,12 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (spec->maxTs) {
             bob->append("maxTs", *(spec->maxTs));
         }
+        if (spec->minRecord) {
+            bob->append("minRecord", spec->minRecord->repr());
+        }
+        if (spec->maxRecord) {
+            bob->append("maxRecord", spec->maxRecord->repr());
+        }
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", spec->docsTested);
         }
@@ -459,6 +527,10 @@ void Explain::statsToBSON(const PlanStageStats& stats,
             bob->append("indexBounds", spec->indexBounds);
         }
 
+        if (spec->estimatedKeysExamined) {
+            bob->append("estimatedKeysExamined", *spec->estimatedKeysExamined);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("keysExamined", spec->keysExamined);
             bob->appendNumber("seeks", spec->seeks);
@@ -508,6 +580,7 @@ void Explain::statsToBSON(const PlanStageStats& stats,
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendIntOrLL("totalDataSizeSorted", spec->totalDataSizeBytes);
             bob->appendBool("usedDisk", spec->wasDiskUsed);
+            bob->appendIntOrLL("spills", spec->spills);
         }
     } else if (STAGE_SORT_MERGE == stats.stageType) {
         MergeSortStats* spec = static_cast<MergeSortStats*>(stats.specific.get());
@@ -581,6 +654,7 @@ BSONObj Explain::statsToBSON(const PlanStageStats& stats, ExplainOptions::Verbos
 BSONObj Explain::statsToBSON(const sbe::PlanStageStats& stats,
                              ExplainOptions::Verbosity verbosity) {
     BSONObjBuilder bob;
+    sbeStatsToBSON(stats, verbosity, &bob);
     return bob.obj();
 }
 
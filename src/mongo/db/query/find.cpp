@@ -55,6 +55,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -146,6 +147,20 @@ void endQueryOp(OperationContext* opCtx,
     }
 }
 
+bool isLargeUnindexedCollectionScan(OperationContext* opCtx,
+                                    const Collection* collection,
+                                    const PlanExecutor& exec) {
+    const long long minBytes = internalQueryReadOnceCollectionScanMinBytes.load();
+    if (!collection || minBytes == 0) {
+        return false;
+    }
+
+    PlanSummaryStats summaryStats;
+    exec.getSummaryStats(&summaryStats);
+    return summaryStats.collectionScansNonTailable > 0 && summaryStats.indexesUsed.empty() &&
+        collection->dataSize(opCtx) >= minBytes;
+}
+
 namespace {
 
 /**
@@ -84,6 +84,15 @@ void endQueryOp(OperationContext* opCtx,
                 long long numResults,
                 CursorId cursorId);
 
+/**
+ * Returns true if 'exec' scans 'collection' without an index, and the data of the collection is at
+ * least 'internalQueryReadOnceCollectionScanMinBytes' large. The storage-layer cursors of such a
+ * scan should be read once, so that it doesn't evict the working set from the cache.
+ */
+bool isLargeUnindexedCollectionScan(OperationContext* opCtx,
+                                    const Collection* collection,
+                                    const PlanExecutor& exec);
+
 /**
  * Called from the getMore entry point in ops/query.cpp.
  * Returned buffer is the message to return to the client.
@@ -67,6 +67,21 @@ bool FindCommon::enoughForFirstBatch(const QueryRequest& qr, long long numDocs)
     return numDocs >= qr.getEffectiveBatchSize().value();
 }
 
+std::size_t FindCommon::estimateFirstBatchBytes(const QueryRequest& qr,
+                                                long long numRecords,
+                                                int averageObjectSize) {
+    long long numDocs = qr.getEffectiveBatchSize().value_or(QueryRequest::kDefaultBatchSize);
+    if (auto limit = qr.getLimit()) {
+        numDocs = std::min(numDocs, *limit);
+    }
+    numDocs = std::max(std::min(numDocs, numRecords), 0LL);
+
+    // Each document in the batch array is preceded by its type byte and its index as field name.
+    constexpr long long kArrayElementOverhead = 8;
+    const long long estimate = numDocs * (std::max(averageObjectSize, 0) + kArrayElementOverhead);
+    return std::min(estimate, static_cast<long long>(kMaxBytesToReturnToClientAtOnce + 1024));
+}
+
 bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered) {
     invariant(numDocs >= 0);
     if (!numDocs) {
@@ -120,6 +120,18 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, int bytesBuffered);
 
+    /**
+     * Returns how many bytes the first batch of a find described by 'qr' will likely take in the
+     * reply, given the number of documents in the collection and their average size, up to the
+     * batch size limit.
+     *
+     * Reserving this much before building the batch lets a large batch be copied into the reply
+     * buffer once, instead of again each time the buffer doubles.
+     */
+    static std::size_t estimateFirstBatchBytes(const QueryRequest& qr,
+                                               long long numRecords,
+                                               int averageObjectSize);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
@@ -39,7 +39,9 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/count.h"
@@ -61,6 +63,7 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/index_names.h"
+#include "mongo/db/matcher/expression_parameterization.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/canonical_query.h"
@@ -69,8 +72,10 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/db/query/index_statistics.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/plan_cost_estimator.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
@@ -84,6 +89,8 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_stage_builder_filter.h"
+#include "mongo/db/query/sbe_stage_builder_index_scan.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -153,6 +160,51 @@ bool isIdHackEligibleQuery(const Collection* collection, const CanonicalQuery& q
         !query.getQueryRequest().isTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Reads the index statistics the analyze command stored for 'collection'. Returns nullptr if there
+ * are none, or if they belong to an earlier collection of the same name.
+ */
+std::shared_ptr<const CollectionIndexStatistics> loadIndexStatistics(
+    OperationContext* opCtx, const Collection* collection) {
+    // Don't widen the set of collections a multi-document transaction reads from.
+    if (opCtx->inMultiDocumentTransaction()) {
+        return nullptr;
+    }
+
+    const NamespaceString statsNss(collection->ns().db(), index_statistics::kCollectionName);
+    Lock::CollectionLock statsLock(opCtx, statsNss, MODE_IS);
+    auto statsColl = CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, statsNss);
+    if (!statsColl) {
+        return nullptr;
+    }
+
+    auto idIndex = statsColl->getIndexCatalog()->findIdIndex(opCtx);
+    if (!idIndex) {
+        return nullptr;
+    }
+
+    auto recordId =
+        statsColl->getIndexCatalog()->getEntry(idIndex)->accessMethod()->findSingle(
+            opCtx, BSON("" << collection->ns().coll()));
+    if (recordId.isNull()) {
+        return nullptr;
+    }
+
+    try {
+        auto stats = CollectionIndexStatistics::parse(statsColl->docFor(opCtx, recordId).value());
+        if (stats.collectionUUID != collection->uuid()) {
+            return nullptr;
+        }
+        return std::make_shared<const CollectionIndexStatistics>(std::move(stats));
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5190128,
+                      "Ignoring invalid index statistics",
+                      "namespace"_attr = collection->ns(),
+                      "error"_attr = ex.toStatus());
+        return nullptr;
+    }
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -331,6 +383,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
             opCtx, collection, canonicalQuery->getQueryRequest().isTailable())) {
         plannerParams->options |= QueryPlannerParams::OPLOG_SCAN_WAIT_FOR_VISIBLE;
     }
+
+    if (collection->isClustered()) {
+        plannerParams->options |= QueryPlannerParams::COLLECTION_IS_CLUSTERED;
+    }
 }
 
 bool shouldWaitForOplogVisibility(OperationContext* opCtx,
@@ -583,11 +639,18 @@ public:
             if (auto cs = CollectionQueryInfo::get(_collection)
                               .getPlanCache()
                               ->getCacheEntryIfActive(planCacheKey)) {
+                // An identical query may have run the plan already, leaving behind an executable
+                // tree which we can copy.
+                if (auto result = buildCachedPlanFromExecutableTree(*cs)) {
+                    return std::move(result);
+                }
+
                 // We have a CachedSolution.  Have the planner turn it into a QuerySolution.
                 auto statusWithQs = QueryPlanner::planFromCache(*_cq, plannerParams, *cs);
 
                 if (statusWithQs.isOK()) {
                     auto querySolution = std::move(statusWithQs.getValue());
+                    annotateEstimates(querySolution.get());
                     if ((plannerParams.options & QueryPlannerParams::IS_COUNT) &&
                         turnIxscanIntoCount(querySolution.get())) {
                         LOGV2_DEBUG(20923,
@@ -596,8 +659,7 @@ public:
                                     "query"_attr = redact(_cq->toStringShort()));
                     }
 
-                    return buildCachedPlan(
-                        std::move(querySolution), plannerParams, cs->decisionWorks);
+                    return buildCachedPlan(std::move(querySolution), plannerParams, *cs);
                 }
             }
         }
@@ -622,6 +684,24 @@ public:
         // The planner should have returned an error status if there are no solutions.
         invariant(solutions.size() > 0);
 
+        for (auto&& solution : solutions) {
+            annotateEstimates(solution.get());
+        }
+
+        // Discard the index intersections which the index statistics show to cost more than a
+        // plan using one of the intersected indexes alone, so that no trial run is spent on them,
+        // unless no other plan is left.
+        auto isCostly = [&](const std::unique_ptr<QuerySolution>& solution) {
+            return plan_cost_estimator::hasCostlyIndexIntersection(
+                solution->root(),
+                _collection->numRecords(_opCtx),
+                internalQueryPlannerIndexIntersectionFetchCost.load());
+        };
+        if (!std::all_of(solutions.begin(), solutions.end(), isCostly)) {
+            solutions.erase(std::remove_if(solutions.begin(), solutions.end(), isCostly),
+                            solutions.end());
+        }
+
         // See if one of our solutions is a fast count hack in disguise.
         if (plannerParams.options & QueryPlannerParams::IS_COUNT) {
             for (size_t i = 0; i < solutions.size(); ++i) {
@@ -655,10 +735,40 @@ public:
             return std::move(result);
         }
 
+        // If one of the plans is known to be cheap enough, run it without a trial run. As with a
+        // single plan, the choice is cheap to repeat, so it isn't cached.
+        if (auto winner = plan_cost_estimator::pickPlanWithoutTrialRun(
+                solutions, internalQueryPlanCostBasedSelectionMaxExamined.load())) {
+            auto result = makeResult();
+            auto root = buildExecutableTree(*solutions[*winner]);
+            result->emplace(std::move(root), std::move(solutions[*winner]));
+
+            LOGV2_DEBUG(5190110,
+                        2,
+                        "Plan chosen by cost estimate without a trial run; it will not be cached",
+                        "query"_attr = redact(_cq->toStringShort()),
+                        "planSummary"_attr = result->getPlanSummary());
+
+            return std::move(result);
+        }
+
         return buildMultiPlan(std::move(solutions), plannerParams);
     }
 
 protected:
+    /**
+     * Attaches the estimates derived from the index statistics of the collection, if it has any,
+     * to the index scans of 'solution', so that explain can report them.
+     */
+    void annotateEstimates(QuerySolution* solution) const {
+        auto stats = CollectionQueryInfo::get(_collection).getIndexStatistics(
+            [&] { return loadIndexStatistics(_opCtx, _collection); });
+        if (stats) {
+            plan_cost_estimator::annotateEstimatedKeys(
+                solution->root(), *stats, _collection->numRecords(_opCtx));
+        }
+    }
+
     /**
      * Creates a result instance to be returned to the caller holding the result of the
      * prepare() call.
@@ -695,7 +805,17 @@ protected:
      */
     virtual std::unique_ptr<ResultType> buildCachedPlan(std::unique_ptr<QuerySolution> solution,
                                                         const QueryPlannerParams& plannerParams,
-                                                        size_t decisionWorks) = 0;
+                                                        const CachedSolution& cs) = 0;
+
+    /**
+     * If the execution engine keeps the executable trees it builds from cached plans, and it kept
+     * one for a query identical to this one, constructs the result from a copy of that tree as
+     * buildCachedPlan() would have. Otherwise, returns nullptr.
+     */
+    virtual std::unique_ptr<ResultType> buildCachedPlanFromExecutableTree(
+        const CachedSolution& cs) {
+        return nullptr;
+    }
 
     /**
      * Constructs a special PlanStage tree for rooted $or queries. Each clause of the $or is planned
@@ -817,7 +937,7 @@ protected:
     std::unique_ptr<ClassicPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cs) final {
         auto result = makeResult();
         auto&& root = buildExecutableTree(*solution);
 
@@ -830,7 +950,7 @@ protected:
                                                           _ws,
                                                           _cq,
                                                           plannerParams,
-                                                          decisionWorks,
+                                                          cs.decisionWorks,
                                                           std::move(root)),
                         std::move(solution));
         return result;
@@ -873,6 +993,216 @@ private:
     WorkingSet* _ws;
 };
 
+/**
+ * A copy of a slot-based executable tree built from a cached plan, along with the data needed to
+ * run it and the solution it was built from. Each query which reuses it runs a copy of its own.
+ *
+ * If the tree reads all values of the query which it depends on from its runtime environment (see
+ * expression_parameterization.h), it is parameterized: it can also be run for the queries of the
+ * same shape which differ in these values alone, once the environment is bound to their values.
+ */
+class CachedSlotBasedExecutableTree final : public CachedExecutableTree {
+public:
+    /**
+     * Returns whether the tree built from 'solution' can be copied to run other queries. Trees
+     * which keep state in their runtime environment between runs, or which depend on data outside
+     * of the tree, cannot.
+     */
+    static bool canCache(const stage_builder::PlanStageData& data, const QuerySolution& solution) {
+        return internalQueryPlanCacheMaxExecutableTreesPerEntry.load() > 0 &&
+            !data.shouldTrackLatestOplogTimestamp && !data.shouldTrackResumeToken &&
+            !data.shouldUseTailableScan && !solution.hasNode(STAGE_TEXT);
+    }
+
+    CachedSlotBasedExecutableTree(OperationContext* opCtx,
+                                  const Collection* collection,
+                                  const CanonicalQuery& cq,
+                                  const sbe::PlanStage& root,
+                                  const stage_builder::PlanStageData& data,
+                                  const QuerySolution& solution)
+        : _root(root.clone()),
+          _env(data.env->makeDeepCopy()),
+          _resultSlot(data.resultSlot),
+          _recordIdSlot(data.recordIdSlot),
+          _oplogTsSlot(data.oplogTsSlot),
+          _solutionRoot(std::unique_ptr<QuerySolutionNode>(solution.root()->clone())),
+          _filterData(solution.filterData.getOwned()),
+          _hasBlockingStage(solution.hasBlockingStage),
+          _indexFilterApplied(solution.indexFilterApplied),
+          _parameterizedShape(
+              makeParameterizedShape(opCtx, collection, cq, solution, _env.get())) {}
+
+    bool isParameterized() const {
+        return _parameterizedShape.has_value();
+    }
+
+    /**
+     * Returns a copy of the tree, ready for runtime planning with 'yieldPolicy'.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData> makeExecutableTree(
+        OperationContext* opCtx,
+        const Collection* collection,
+        const CanonicalQuery& cq,
+        PlanYieldPolicy* yieldPolicy) const {
+        return makeExecutableTree(opCtx, collection, cq, yieldPolicy, _env->makeCopy(false));
+    }
+
+    /**
+     * Returns a copy of the parameterized tree bound to the values of 'cq', ready to run
+     * 'solution', which the planner built for 'cq' from the same cached plan as the tree. Returns
+     * boost::none if the tree cannot be run with these values, either because the planner made
+     * different choices for them, or because their index bounds need a tree of another shape.
+     */
+    boost::optional<std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>>
+    makeParameterizedExecutableTree(OperationContext* opCtx,
+                                    const Collection* collection,
+                                    const CanonicalQuery& cq,
+                                    const QuerySolution& solution,
+                                    PlanYieldPolicy* yieldPolicy) const {
+        invariant(isParameterized());
+        auto env = _env->makeDeepCopy();
+        if (makeParameterizedShape(opCtx, collection, cq, solution, env.get()) !=
+            _parameterizedShape) {
+            return boost::none;
+        }
+        return makeExecutableTree(opCtx, collection, cq, yieldPolicy, std::move(env));
+    }
+
+    std::unique_ptr<QuerySolution> makeSolution() const {
+        auto solution = std::make_unique<QuerySolution>();
+        solution->setRoot(std::unique_ptr<QuerySolutionNode>(_solutionRoot->clone()));
+        solution->filterData = _filterData;
+        solution->hasBlockingStage = _hasBlockingStage;
+        solution->indexFilterApplied = _indexFilterApplied;
+        return solution;
+    }
+
+private:
+    /**
+     * Appends the shape of the solution sub-tree rooted at 'node' to 'builder', leaving out the
+     * values of input parameters, and binds the index bounds of the sub-tree to 'env'. Returns
+     * false if the sub-tree depends on the values of the query in other ways, or if its bounds
+     * cannot be bound.
+     */
+    static bool appendParameterizedShape(OperationContext* opCtx,
+                                         const Collection* collection,
+                                         const QuerySolutionNode& node,
+                                         sbe::RuntimeEnvironment* env,
+                                         BSONArrayBuilder* builder) {
+        switch (node.getType()) {
+            case STAGE_COLLSCAN: {
+                // The oplog timestamps the scan starts and stops at are taken from the query.
+                auto& csn = static_cast<const CollectionScanNode&>(node);
+                if (csn.minTs || csn.maxTs) {
+                    return false;
+                }
+                break;
+            }
+            case STAGE_IXSCAN:
+                if (!stage_builder::bindIndexScanBounds(
+                        opCtx, collection, static_cast<const IndexScanNode*>(&node), env)) {
+                    return false;
+                }
+                break;
+            case STAGE_FETCH:
+            case STAGE_LIMIT:
+            case STAGE_SKIP:
+            case STAGE_SORT_SIMPLE:
+            case STAGE_SORT_DEFAULT:
+            case STAGE_SORT_KEY_GENERATOR:
+            case STAGE_PROJECTION_SIMPLE:
+            case STAGE_PROJECTION_DEFAULT:
+            case STAGE_OR:
+            case STAGE_AND_HASH:
+            case STAGE_AND_SORTED:
+            case STAGE_RETURN_KEY:
+                break;
+            default:
+                return false;
+        }
+
+        BSONObjBuilder nodeBuilder{builder->subobjStart()};
+        nodeBuilder.append("type", static_cast<int>(node.getType()));
+        if (node.filter) {
+            nodeBuilder.appendArray("filter",
+                                    expression_parameterization::serializeParameterized(
+                                        *node.filter));
+        }
+        BSONArrayBuilder children{nodeBuilder.subarrayStart("children")};
+        for (auto&& child : node.children) {
+            if (!appendParameterizedShape(opCtx, collection, *child, env, &children)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Binds 'env' to the values of 'cq' and the index bounds of 'solution', and returns the shape
+     * of 'solution' with the values left out. Returns boost::none if a tree built from 'solution'
+     * cannot be parameterized.
+     */
+    static boost::optional<std::string> makeParameterizedShape(OperationContext* opCtx,
+                                                               const Collection* collection,
+                                                               const CanonicalQuery& cq,
+                                                               const QuerySolution& solution,
+                                                               sbe::RuntimeEnvironment* env) {
+        if (!internalQueryEnableSlotBasedPlanParameterization.load()) {
+            return boost::none;
+        }
+
+        BSONArrayBuilder builder;
+        if (!appendParameterizedShape(opCtx, collection, *solution.root(), env, &builder)) {
+            return boost::none;
+        }
+        stage_builder::bindInputParams(*cq.root(), env);
+
+        auto shape = builder.arr();
+        return std::string(shape.objdata(), shape.objsize());
+    }
+
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData> makeExecutableTree(
+        OperationContext* opCtx,
+        const Collection* collection,
+        const CanonicalQuery& cq,
+        PlanYieldPolicy* yieldPolicy,
+        std::unique_ptr<sbe::RuntimeEnvironment> env) const {
+        auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(yieldPolicy);
+        invariant(sbeYieldPolicy);
+
+        stage_builder::PlanStageData data{std::move(env)};
+        data.resultSlot = _resultSlot;
+        data.recordIdSlot = _recordIdSlot;
+        data.oplogTsSlot = _oplogTsSlot;
+        data.trialRunProgressTracker = std::make_unique<TrialRunProgressTracker>(
+            trial_period::getTrialPeriodNumToReturn(cq),
+            trial_period::getTrialPeriodMaxWorks(opCtx, collection));
+
+        auto root = _root->clone();
+        root->attachToYieldPolicyAndTracker(sbeYieldPolicy, data.trialRunProgressTracker.get());
+        sbeYieldPolicy->registerPlan(root.get());
+        return {std::move(root), std::move(data)};
+    }
+
+    const std::unique_ptr<sbe::PlanStage> _root;
+    // Holds the slot values of the queries the tree was built for. They are never modified once
+    // the tree is cached: trees which modify them are not cached, and the trees which are bound to
+    // the values of other queries run with copies of them.
+    const std::unique_ptr<sbe::RuntimeEnvironment> _env;
+    const boost::optional<sbe::value::SlotId> _resultSlot;
+    const boost::optional<sbe::value::SlotId> _recordIdSlot;
+    const boost::optional<sbe::value::SlotId> _oplogTsSlot;
+
+    const std::unique_ptr<QuerySolutionNode> _solutionRoot;
+    const BSONObj _filterData;
+    const bool _hasBlockingStage;
+    const bool _indexFilterApplied;
+
+    // The shape of the solution the tree was built from, with the values of the query left out, if
+    // the tree is parameterized. Only the solutions of this shape can be run by the tree.
+    const boost::optional<std::string> _parameterizedShape;
+};
+
 /**
  * A helper class to prepare an SBE PlanStage tree for execution.
  */
@@ -912,11 +1242,43 @@ protected:
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlan(
         std::unique_ptr<QuerySolution> solution,
         const QueryPlannerParams& plannerParams,
-        size_t decisionWorks) final {
+        const CachedSolution& cs) final {
         auto result = makeResult();
+        result->setDecisionWorks(cs.decisionWorks);
+
+        // A query of the same shape, differing in the values of input parameters alone, may have
+        // left behind a tree which we can bind to the values of this query.
+        if (auto cachedTree = cs.executableTrees->find(executableTreeKey(true))) {
+            auto& tree = static_cast<const CachedSlotBasedExecutableTree&>(*cachedTree);
+            if (auto execTree = tree.makeParameterizedExecutableTree(
+                    _opCtx, _collection, *_cq, *solution, _yieldPolicy)) {
+                result->emplace(std::move(*execTree), std::move(solution));
+                return result;
+            }
+        }
+
         auto execTree = buildExecutableTree(*solution, true);
+        if (CachedSlotBasedExecutableTree::canCache(execTree.second, *solution)) {
+            auto tree = std::make_shared<CachedSlotBasedExecutableTree>(
+                _opCtx, _collection, *_cq, *execTree.first, execTree.second, *solution);
+            cs.executableTrees->add(executableTreeKey(tree->isParameterized()), std::move(tree));
+        }
         result->emplace(std::move(execTree), std::move(solution));
-        result->setDecisionWorks(decisionWorks);
+        return result;
+    }
+
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlanFromExecutableTree(
+        const CachedSolution& cs) final {
+        auto cachedTree = cs.executableTrees->find(executableTreeKey(false));
+        if (!cachedTree) {
+            return nullptr;
+        }
+
+        auto& tree = static_cast<const CachedSlotBasedExecutableTree&>(*cachedTree);
+        auto result = makeResult();
+        result->emplace(tree.makeExecutableTree(_opCtx, _collection, *_cq, _yieldPolicy),
+                        tree.makeSolution());
+        result->setDecisionWorks(cs.decisionWorks);
         return result;
     }
 
@@ -949,6 +1311,30 @@ private:
         return stage_builder::buildSlotBasedExecutableTree(
             _opCtx, _collection, *_cq, solution, _yieldPolicy, needsTrialRunProgressTracker);
     }
+
+    /**
+     * Returns the key of the executable trees built for this query within the plan cache entry of
+     * its shape. Queries with the same key build identical trees from the same cached plan. If
+     * 'parameterized' is true, the values of the input parameters of the query are left out of the
+     * key, so that it is shared by the queries which can run the same parameterized tree.
+     */
+    std::string executableTreeKey(bool parameterized) const {
+        BSONObjBuilder bob;
+        bob.append("options", static_cast<long long>(_plannerOptions));
+        bob.append("metadataDeps", _cq->metadataDeps().to_string());
+        bob.append("parameterized", parameterized);
+        if (parameterized) {
+            BSONObjBuilder findCommand;
+            _cq->getQueryRequest().asFindCommand(&findCommand);
+            bob.appendElements(findCommand.obj().removeField(QueryRequest::kFilterField));
+            bob.appendArray("parameterizedFilter",
+                            expression_parameterization::serializeParameterized(*_cq->root()));
+        } else {
+            _cq->getQueryRequest().asFindCommand(&bob);
+        }
+        auto key = bob.done();
+        return std::string(key.objdata(), key.objsize());
+    }
 };
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecutor(
@@ -1055,6 +1441,11 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
     PlanYieldPolicy::YieldPolicy requestedYieldPolicy,
     size_t plannerOptions) {
     invariant(cq);
+    // Let the trees built for the query read its values from their runtime environments, so that
+    // they can be reused for other queries of the same shape.
+    if (internalQueryEnableSlotBasedPlanParameterization.load()) {
+        expression_parameterization::parameterize(cq->root());
+    }
     auto nss = cq->nss();
     auto yieldPolicy = makeSbeYieldPolicy(opCtx, requestedYieldPolicy, nss);
     SlotBasedPrepareExecutionHelper helper{
@@ -0,0 +1,340 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/bson/bsonelement_comparator_interface.h"
+#include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/bits.h"
+
+namespace mongo {
+namespace {
+AtomicWord<uint64_t> persistedVersion{1};
+
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    return lhs.woCompare(rhs, 0);
+}
+
+// Finalizes the hash of a value so that its bits are uniformly distributed, which the register
+// selection and rank computation of HyperLogLog rely on.
+uint64_t mixHash(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+}  // namespace
+
+void DistinctValueSketch::add(const BSONElement& elem) {
+    const uint64_t hash = mixHash(SimpleBSONElementComparator::kInstance.hash(elem));
+    const size_t index = hash >> (64 - kIndexBits);
+    const uint64_t rest = hash << kIndexBits;
+    const uint8_t rank = rest == 0 ? 64 - kIndexBits + 1 : countLeadingZeros64(rest) + 1;
+    _registers[index] = std::max(_registers[index], rank);
+}
+
+double DistinctValueSketch::estimate() const {
+    const double numRegisters = kNumRegisters;
+    double sum = 0;
+    size_t numZeroRegisters = 0;
+    for (auto reg : _registers) {
+        sum += std::ldexp(1.0, -reg);
+        numZeroRegisters += reg == 0;
+    }
+
+    const double alpha = 0.7213 / (1 + 1.079 / numRegisters);
+    const double estimate = alpha * numRegisters * numRegisters / sum;
+
+    // Use linear counting for small cardinalities, where the raw estimate is biased.
+    if (estimate <= 2.5 * numRegisters && numZeroRegisters != 0) {
+        return numRegisters * std::log(numRegisters / numZeroRegisters);
+    }
+    return estimate;
+}
+
+void DistinctValueSketch::serialize(StringData fieldName, BSONObjBuilder* bob) const {
+    bob->appendBinData(fieldName, _registers.size(), BinDataGeneral, _registers.data());
+}
+
+DistinctValueSketch DistinctValueSketch::parse(const BSONElement& elem) {
+    int length = 0;
+    const char* data = elem.type() == BinData ? elem.binData(length) : nullptr;
+    uassert(5190120,
+            str::stream() << "Distinct value sketch must be binary data of " << kNumRegisters
+                          << " bytes",
+            data && static_cast<size_t>(length) == kNumRegisters);
+
+    DistinctValueSketch sketch;
+    std::copy(data, data + length, sketch._registers.begin());
+    return sketch;
+}
+
+EquiDepthHistogram EquiDepthHistogram::build(const std::vector<BSONElement>& values,
+                                             size_t maxBuckets) {
+    EquiDepthHistogram histogram;
+    if (values.empty() || maxBuckets == 0) {
+        return histogram;
+    }
+
+    const double depth = std::ceil(static_cast<double>(values.size()) / maxBuckets);
+    Bucket bucket;
+    for (size_t first = 0; first < values.size();) {
+        // Find the run of values equal to 'values[first]'.
+        size_t last = first + 1;
+        while (last < values.size() && compareValues(values[first], values[last]) == 0) {
+            ++last;
+        }
+
+        // Close the bucket with the value of the run as its upper bound once the bucket is deep
+        // enough, otherwise the run falls strictly inside the bucket.
+        const double runLength = last - first;
+        if (bucket.rangeCount + runLength >= depth || last == values.size()) {
+            bucket.upperBound = values[first].wrap("");
+            bucket.equalCount = runLength;
+            histogram._buckets.push_back(std::move(bucket));
+            bucket = Bucket{};
+        } else {
+            bucket.rangeCount += runLength;
+            bucket.rangeDistinct += 1;
+        }
+        first = last;
+    }
+    return histogram;
+}
+
+double EquiDepthHistogram::estimateCount(const Interval& interval) const {
+    // The intervals of a descending index field run from high to low values.
+    auto low = interval.start;
+    auto high = interval.end;
+    auto lowInclusive = interval.startInclusive;
+    auto highInclusive = interval.endInclusive;
+    if (compareValues(low, high) > 0) {
+        std::swap(low, high);
+        std::swap(lowInclusive, highInclusive);
+    }
+
+    auto contains = [&](const BSONElement& value) {
+        const int cmpLow = compareValues(value, low);
+        const int cmpHigh = compareValues(value, high);
+        return (cmpLow > 0 || (cmpLow == 0 && lowInclusive)) &&
+            (cmpHigh < 0 || (cmpHigh == 0 && highInclusive));
+    };
+
+    double count = 0;
+    boost::optional<BSONElement> lowerBound;
+    for (auto&& bucket : _buckets) {
+        const auto upperBound = bucket.upperBound.firstElement();
+        if (contains(upperBound)) {
+            count += bucket.equalCount;
+        }
+
+        // Account for the values strictly between the bounds of the bucket, assuming that they
+        // are spread evenly over the distinct values of the range.
+        const bool overlaps = (!lowerBound || compareValues(high, *lowerBound) > 0) &&
+            compareValues(low, upperBound) < 0;
+        if (bucket.rangeCount > 0 && overlaps) {
+            const bool coversLow =
+                lowerBound ? compareValues(low, *lowerBound) <= 0 : low.type() == MinKey;
+            const bool coversHigh = compareValues(high, upperBound) >= 0;
+            if (coversLow && coversHigh) {
+                count += bucket.rangeCount;
+            } else if (compareValues(low, high) == 0) {
+                count += bucket.rangeCount / std::max(bucket.rangeDistinct, 1.0);
+            } else {
+                count += bucket.rangeCount / 2;
+            }
+        }
+        lowerBound = upperBound;
+    }
+    return count;
+}
+
+void EquiDepthHistogram::serialize(StringData fieldName, BSONObjBuilder* bob) const {
+    BSONArrayBuilder bucketsBuilder(bob->subarrayStart(fieldName));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.appendAs(bucket.upperBound.firstElement(), "upperBound");
+        bucketBuilder.append("equalCount", bucket.equalCount);
+        bucketBuilder.append("rangeCount", bucket.rangeCount);
+        bucketBuilder.append("rangeDistinct", bucket.rangeDistinct);
+    }
+}
+
+EquiDepthHistogram EquiDepthHistogram::parse(const BSONElement& elem) {
+    uassert(5190121, "Histogram must be an array", elem.type() == Array);
+
+    EquiDepthHistogram histogram;
+    for (auto&& bucketElem : elem.Obj()) {
+        uassert(5190122, "Histogram bucket must be an object", bucketElem.type() == Object);
+        auto bucketObj = bucketElem.Obj();
+        auto upperBound = bucketObj["upperBound"];
+        uassert(5190123, "Histogram bucket must have an upper bound", !upperBound.eoo());
+
+        Bucket bucket;
+        bucket.upperBound = upperBound.wrap("");
+        bucket.equalCount = bucketObj["equalCount"].numberDouble();
+        bucket.rangeCount = bucketObj["rangeCount"].numberDouble();
+        bucket.rangeDistinct = bucketObj["rangeDistinct"].numberDouble();
+        histogram._buckets.push_back(std::move(bucket));
+    }
+    return histogram;
+}
+
+double IndexStatistics::estimateKeys(const OrderedIntervalList& leadingFieldBounds,
+                                     long long numRecords) const {
+    if (sampledDocs == 0) {
+        return 0;
+    }
+
+    double count = 0;
+    for (auto&& interval : leadingFieldBounds.intervals) {
+        count += histogram.estimateCount(interval);
+    }
+    return count / sampledDocs * numRecords;
+}
+
+BSONObj IndexStatistics::toBSON() const {
+    BSONObjBuilder bob;
+    bob.append("name", indexName);
+    bob.append("key", keyPattern);
+    bob.append("sampledDocs", sampledDocs);
+    bob.append("sampledKeys", sampledKeys);
+    histogram.serialize("histogram", &bob);
+    distinctValues.serialize("distinctValues", &bob);
+    return bob.obj();
+}
+
+IndexStatistics IndexStatistics::parse(const BSONObj& obj) {
+    uassert(5190124, "Index statistics must have a name", obj["name"].type() == String);
+    uassert(5190125, "Index statistics must have a key pattern", obj["key"].type() == Object);
+
+    IndexStatistics stats;
+    stats.indexName = obj["name"].str();
+    stats.keyPattern = obj["key"].Obj().getOwned();
+    stats.sampledDocs = obj["sampledDocs"].safeNumberLong();
+    stats.sampledKeys = obj["sampledKeys"].safeNumberLong();
+    stats.histogram = EquiDepthHistogram::parse(obj["histogram"]);
+    stats.distinctValues = DistinctValueSketch::parse(obj["distinctValues"]);
+    return stats;
+}
+
+IndexStatisticsBuilder::IndexStatisticsBuilder(std::string indexName, BSONObj keyPattern)
+    : _indexName(std::move(indexName)),
+      _keyPattern(keyPattern.getOwned()),
+      _leadingField(_keyPattern.firstElementFieldName()) {}
+
+void IndexStatisticsBuilder::addDocument(const BSONObj& doc) {
+    ++_sampledDocs;
+
+    // Like the keys of a btree index, a document with no value for the field counts as null and
+    // every element of an array counts as a value of its own.
+    BSONElementSet elements;
+    dotted_path_support::extractAllElementsAlongPath(doc, _leadingField, elements);
+    if (elements.empty()) {
+        _values.push_back(BSON("" << BSONNULL));
+    }
+    for (auto&& elem : elements) {
+        _values.push_back(elem.wrap(""));
+    }
+}
+
+IndexStatistics IndexStatisticsBuilder::done(size_t maxBuckets) {
+    std::sort(_values.begin(), _values.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return compareValues(lhs.firstElement(), rhs.firstElement()) < 0;
+    });
+
+    std::vector<BSONElement> values;
+    values.reserve(_values.size());
+    for (auto&& value : _values) {
+        values.push_back(value.firstElement());
+        _distinctValues.add(value.firstElement());
+    }
+
+    IndexStatistics stats;
+    stats.indexName = _indexName;
+    stats.keyPattern = _keyPattern;
+    stats.sampledDocs = _sampledDocs;
+    stats.sampledKeys = values.size();
+    stats.histogram = EquiDepthHistogram::build(values, maxBuckets);
+    stats.distinctValues = _distinctValues;
+    return stats;
+}
+
+const IndexStatistics* CollectionIndexStatistics::find(StringData indexName,
+                                                       const BSONObj& keyPattern) const {
+    for (auto&& index : indexes) {
+        if (index.indexName == indexName) {
+            return index.keyPattern.binaryEqual(keyPattern) ? &index : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+BSONObj CollectionIndexStatistics::toBSON(StringData collectionName) const {
+    BSONObjBuilder bob;
+    bob.append("_id", collectionName);
+    collectionUUID.appendToBuilder(&bob, "uuid");
+    BSONArrayBuilder indexesBuilder(bob.subarrayStart("indexes"));
+    for (auto&& index : indexes) {
+        indexesBuilder.append(index.toBSON());
+    }
+    indexesBuilder.done();
+    return bob.obj();
+}
+
+CollectionIndexStatistics CollectionIndexStatistics::parse(const BSONObj& obj) {
+    CollectionIndexStatistics stats{uassertStatusOK(UUID::parse(obj["uuid"]))};
+    uassert(5190126, "Index statistics must be an array", obj["indexes"].type() == Array);
+    for (auto&& indexElem : obj["indexes"].Obj()) {
+        uassert(5190127, "Index statistics must be an object", indexElem.type() == Object);
+        stats.indexes.push_back(IndexStatistics::parse(indexElem.Obj()));
+    }
+    return stats;
+}
+
+namespace index_statistics {
+uint64_t getPersistedVersion() {
+    return persistedVersion.load();
+}
+
+void onPersistedChange() {
+    persistedVersion.fetchAndAdd(1);
+}
+}  // namespace index_statistics
+
+}  // namespace mongo
@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+/**
+ * A HyperLogLog sketch which approximates the number of distinct values added to it.
+ */
+class DistinctValueSketch {
+public:
+    static constexpr int kIndexBits = 10;
+    static constexpr size_t kNumRegisters = size_t{1} << kIndexBits;
+
+    DistinctValueSketch() : _registers(kNumRegisters, 0) {}
+
+    /**
+     * Adds the value of 'elem'. The hash of an element covers its field name, so all the elements
+     * added to a sketch should have the same field name.
+     */
+    void add(const BSONElement& elem);
+
+    /**
+     * Returns the estimated number of distinct values added so far.
+     */
+    double estimate() const;
+
+    void serialize(StringData fieldName, BSONObjBuilder* bob) const;
+    static DistinctValueSketch parse(const BSONElement& elem);
+
+private:
+    std::vector<uint8_t> _registers;
+};
+
+/**
+ * An equi-depth histogram over a sample of values. Each bucket covers the values greater than the
+ * upper bound of the previous bucket and less than or equal to its own upper bound, and records
+ * how many of the sampled values are equal to the upper bound and how many fall strictly between
+ * the two bounds.
+ */
+class EquiDepthHistogram {
+public:
+    struct Bucket {
+        // A single-field object holding the upper bound of the bucket.
+        BSONObj upperBound;
+        double equalCount{0};
+        double rangeCount{0};
+        double rangeDistinct{0};
+    };
+
+    /**
+     * Builds a histogram with at most 'maxBuckets' buckets from 'values', which must be sorted.
+     */
+    static EquiDepthHistogram build(const std::vector<BSONElement>& values, size_t maxBuckets);
+
+    /**
+     * Estimates how many of the sampled values fall into 'interval'.
+     */
+    double estimateCount(const Interval& interval) const;
+
+    const std::vector<Bucket>& buckets() const {
+        return _buckets;
+    }
+
+    void serialize(StringData fieldName, BSONObjBuilder* bob) const;
+    static EquiDepthHistogram parse(const BSONElement& elem);
+
+private:
+    std::vector<Bucket> _buckets;
+};
+
+/**
+ * Data-distribution statistics of the leading field of a btree index, built by the analyze command
+ * from a sample of the documents of the collection.
+ */
+struct IndexStatistics {
+    /**
+     * Estimates how many keys of the index fall into 'leadingFieldBounds', the bounds of the first
+     * field of an index scan, if the collection holds 'numRecords' documents.
+     */
+    double estimateKeys(const OrderedIntervalList& leadingFieldBounds, long long numRecords) const;
+
+    BSONObj toBSON() const;
+    static IndexStatistics parse(const BSONObj& obj);
+
+    std::string indexName;
+    BSONObj keyPattern;
+    // The number of sampled documents and the number of keys they generated for the leading field.
+    long long sampledDocs{0};
+    long long sampledKeys{0};
+    EquiDepthHistogram histogram;
+    DistinctValueSketch distinctValues;
+};
+
+/**
+ * Accumulates the values of the leading field of an index over a sample of documents.
+ */
+class IndexStatisticsBuilder {
+public:
+    IndexStatisticsBuilder(std::string indexName, BSONObj keyPattern);
+
+    void addDocument(const BSONObj& doc);
+
+    IndexStatistics done(size_t maxBuckets);
+
+private:
+    std::string _indexName;
+    BSONObj _keyPattern;
+    std::string _leadingField;
+    long long _sampledDocs{0};
+    // Each key value is held as the only field of an owned object.
+    std::vector<BSONObj> _values;
+    DistinctValueSketch _distinctValues;
+};
+
+/**
+ * The statistics of the indexes of one collection, as stored by the analyze command.
+ */
+struct CollectionIndexStatistics {
+    explicit CollectionIndexStatistics(UUID uuid) : collectionUUID(uuid) {}
+
+    /**
+     * Returns the statistics of the index named 'indexName', or nullptr if there are none or they
+     * were built for an index with a different key pattern.
+     */
+    const IndexStatistics* find(StringData indexName, const BSONObj& keyPattern) const;
+
+    BSONObj toBSON(StringData collectionName) const;
+    static CollectionIndexStatistics parse(const BSONObj& obj);
+
+    UUID collectionUUID;
+    std::vector<IndexStatistics> indexes;
+};
+
+namespace index_statistics {
+/**
+ * The name of the collection in each database which stores the statistics of its collections.
+ * Every document holds the CollectionIndexStatistics of the collection named by its _id.
+ */
+constexpr auto kCollectionName = NamespaceString::kSystemDotStatisticsCollectionName;
+
+/**
+ * Returns a version which is bumped whenever a statistics collection is modified, so that cached
+ * statistics can tell whether they need to be reloaded.
+ */
+uint64_t getPersistedVersion();
+
+/**
+ * Called by the OpObserver whenever a document of a statistics collection is written.
+ */
+void onPersistedChange();
+}  // namespace index_statistics
+
+}  // namespace mongo
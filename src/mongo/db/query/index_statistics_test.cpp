@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/index_statistics.h"
+
+#include "mongo/db/query/index_bounds_builder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds the statistics of the index {a: 1} over documents holding each of the values 0 to
+ * 'numValues' - 1, 'copies' times each.
+ */
+IndexStatistics buildStatistics(int numValues, int copies, size_t maxBuckets) {
+    IndexStatisticsBuilder builder("a_1", BSON("a" << 1));
+    for (int i = 0; i < numValues; ++i) {
+        for (int j = 0; j < copies; ++j) {
+            builder.addDocument(BSON("_id" << i * copies + j << "a" << i));
+        }
+    }
+    return builder.done(maxBuckets);
+}
+
+OrderedIntervalList makeBounds(std::vector<Interval> intervals) {
+    OrderedIntervalList oil("a");
+    oil.intervals = std::move(intervals);
+    return oil;
+}
+
+TEST(IndexStatisticsTest, DistinctValueSketchEstimatesNumberOfDistinctValues) {
+    DistinctValueSketch sketch;
+    for (int i = 0; i < 10000; ++i) {
+        sketch.add(BSON("" << i % 1000).firstElement());
+    }
+    ASSERT_APPROX_EQUAL(sketch.estimate(), 1000.0, 100.0);
+}
+
+TEST(IndexStatisticsTest, HistogramBucketsCoverAllSampledValues) {
+    auto stats = buildStatistics(1000, 2, 10);
+    ASSERT_EQ(stats.sampledDocs, 2000);
+    ASSERT_EQ(stats.sampledKeys, 2000);
+    ASSERT_LTE(stats.histogram.buckets().size(), 10U);
+
+    double total = 0;
+    for (auto&& bucket : stats.histogram.buckets()) {
+        total += bucket.equalCount + bucket.rangeCount;
+    }
+    ASSERT_EQ(total, 2000.0);
+}
+
+TEST(IndexStatisticsTest, EstimatesPointAndRangeIntervals) {
+    auto stats = buildStatistics(1000, 2, 100);
+
+    auto point = makeBounds({IndexBoundsBuilder::makePointInterval(BSON("" << 500))});
+    ASSERT_APPROX_EQUAL(stats.estimateKeys(point, 2000), 2.0, 1.0);
+
+    auto range = makeBounds({IndexBoundsBuilder::makeRangeInterval(
+        BSON("" << 100 << "" << 300), BoundInclusion::kIncludeStartKeyOnly)});
+    ASSERT_APPROX_EQUAL(stats.estimateKeys(range, 2000), 400.0, 40.0);
+
+    // The estimate scales with the size of the collection.
+    ASSERT_APPROX_EQUAL(stats.estimateKeys(range, 20000), 4000.0, 400.0);
+}
+
+TEST(IndexStatisticsTest, MissingFieldIsCountedAsNull) {
+    IndexStatisticsBuilder builder("a_1", BSON("a" << 1));
+    builder.addDocument(BSON("_id" << 1));
+    builder.addDocument(BSON("_id" << 2 << "a" << BSONNULL));
+    builder.addDocument(BSON("_id" << 3 << "a" << 1));
+    auto stats = builder.done(10);
+
+    auto nullPoint = makeBounds({IndexBoundsBuilder::makePointInterval(BSON("" << BSONNULL))});
+    ASSERT_APPROX_EQUAL(stats.estimateKeys(nullPoint, 3), 2.0, 0.01);
+}
+
+TEST(IndexStatisticsTest, RoundTripsThroughBSON) {
+    CollectionIndexStatistics collStats(UUID::gen());
+    collStats.indexes.push_back(buildStatistics(100, 3, 8));
+
+    auto parsed = CollectionIndexStatistics::parse(collStats.toBSON("coll"));
+    ASSERT_EQ(parsed.collectionUUID, collStats.collectionUUID);
+    ASSERT_EQ(parsed.indexes.size(), 1U);
+
+    auto* stats = parsed.find("a_1", BSON("a" << 1));
+    ASSERT(stats);
+    ASSERT_EQ(stats->sampledDocs, 300);
+    ASSERT_EQ(stats->histogram.buckets().size(),
+              collStats.indexes[0].histogram.buckets().size());
+    ASSERT_EQ(stats->distinctValues.estimate(), collStats.indexes[0].distinctValues.estimate());
+
+    // Statistics built for another key pattern are not returned.
+    ASSERT_FALSE(parsed.find("a_1", BSON("a" << -1)));
+}
+
+TEST(IndexStatisticsTest, ParseRejectsMalformedDocument) {
+    ASSERT_THROWS(CollectionIndexStatistics::parse(BSON("_id"
+                                                        << "coll"
+                                                        << "indexes" << 1)),
+                  DBException);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,9 +33,11 @@
 
 #include "mongo/db/query/plan_cache.h"
 
+#include <boost/functional/hash.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <math.h>
 #include <memory>
 #include <vector>
@@ -54,6 +56,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/hex.h"
+#include "mongo/util/static_immortal.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 #include "mongo/util/visit_helper.h"
 
@@ -62,6 +65,15 @@ namespace {
 
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &PlanCacheEntry::planCacheTotalSizeEstimateBytes);
+ServerStatusMetricField<Counter64> planCacheHitsMetric("query.planCache.hits",
+                                                       &PlanCache::planCacheHits);
+ServerStatusMetricField<Counter64> planCacheMissesMetric("query.planCache.misses",
+                                                         &PlanCache::planCacheMisses);
+ServerStatusMetricField<Counter64> planCacheEvictionsMetric("query.planCache.evictions",
+                                                            &PlanCache::planCacheEvictions);
+
+// The number of partitions of the server-wide plan cache store.
+const size_t kNumSharedPlanCachePartitions = 16;
 
 // Delimiters for cache key encoding.
 const char kEncodeDiscriminatorsBegin = '<';
@@ -104,6 +116,17 @@ void encodeIndexability(const MatchExpression* tree,
     }
 }
 
+void logEvictedEntries(const CanonicalQuery& query,
+                       const std::vector<std::unique_ptr<PlanCacheEntry>>& evictedEntries) {
+    for (auto&& evictedEntry : evictedEntries) {
+        LOGV2_DEBUG(20942,
+                    1,
+                    "Plan cache maximum size exceeded - removed least recently used entry",
+                    "namespace"_attr = query.nss(),
+                    "evictedEntry"_attr = redact(evictedEntry->toString()));
+    }
+}
+
 }  // namespace
 
 std::ostream& operator<<(std::ostream& stream, const PlanCacheKey& key) {
@@ -175,7 +198,8 @@ CachedSolution::CachedSolution(const PlanCacheKey& key, const PlanCacheEntry& en
       sort(entry.sort.getOwned()),
       projection(entry.projection.getOwned()),
       collation(entry.collation.getOwned()),
-      decisionWorks(entry.works) {
+      decisionWorks(entry.works),
+      executableTrees(entry.executableTrees) {
     // CachedSolution should not having any references into
     // cache entry. All relevant data should be cloned/copied.
     for (size_t i = 0; i < entry.plannerData.size(); ++i) {
@@ -409,6 +433,10 @@ std::string SolutionCacheData::toString() const {
             return str::stream() << "(whole index scan solution: "
                                  << "dir=" << this->wholeIXSolnDir << "; "
                                  << "tree=" << this->tree->toString() << ")";
+        case SKIP_SCAN_SOLN:
+            verify(this->tree.get());
+            return str::stream() << "(index skip scan solution: "
+                                 << "tree=" << this->tree->toString() << ")";
         case COLLSCAN_SOLN:
             return "(collection scan)";
         case USE_INDEX_TAGS_SOLN:
@@ -419,15 +447,241 @@ std::string SolutionCacheData::toString() const {
     MONGO_UNREACHABLE;
 }
 
+//
+// ExecutableTreeCache
+//
+
+ExecutableTreeCache::ExecutableTreeCache()
+    : _trees(internalQueryPlanCacheMaxExecutableTreesPerEntry.load()) {}
+
+std::shared_ptr<const CachedExecutableTree> ExecutableTreeCache::find(
+    const std::string& queryKey) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    std::shared_ptr<const CachedExecutableTree>* tree = nullptr;
+    if (!_trees.get(queryKey, &tree).isOK()) {
+        return nullptr;
+    }
+    return *tree;
+}
+
+void ExecutableTreeCache::add(const std::string& queryKey,
+                              std::shared_ptr<const CachedExecutableTree> tree) {
+    std::unique_ptr<std::shared_ptr<const CachedExecutableTree>> evicted;
+    stdx::lock_guard<Latch> lk(_mutex);
+    evicted =
+        _trees.add(queryKey, new std::shared_ptr<const CachedExecutableTree>(std::move(tree)));
+}
+
+//
+// PlanCacheStore
+//
+
+PlanCacheStore& PlanCacheStore::getShared() {
+    static StaticImmortal<PlanCacheStore> store{
+        kNumSharedPlanCachePartitions,
+        [] { return std::numeric_limits<size_t>::max(); },
+        [] { return static_cast<size_t>(internalQueryPlanCacheSizeBytes.load()); }};
+    return *store;
+}
+
+PlanCacheStore::PlanCacheStore(size_t numPartitions,
+                               std::function<size_t()> maxEntries,
+                               std::function<size_t()> maxBytes)
+    : _partitions(numPartitions),
+      _maxEntries(std::move(maxEntries)),
+      _maxBytes(std::move(maxBytes)) {
+    invariant(numPartitions > 0);
+}
+
+PlanCacheStore::OwnerId PlanCacheStore::makeOwnerId() {
+    return _nextOwnerId.fetchAndAdd(1);
+}
+
+size_t PlanCacheStore::SlotKeyHasher::operator()(const SlotKey& k) const {
+    size_t hash = PlanCacheKeyHasher{}(*k.key);
+    boost::hash_combine(hash, k.owner);
+    return hash;
+}
+
+PlanCacheStore::Partition& PlanCacheStore::_partitionFor(OwnerId owner, const PlanCacheKey& key) {
+    return _partitions[SlotKeyHasher{}({owner, &key}) % _partitions.size()];
+}
+
+void PlanCacheStore::_erase(Partition* partition, SlotList::iterator it) {
+    partition->index.erase({it->owner, &it->key});
+    partition->bytes -= it->bytes;
+    auto ownerIt = partition->numEntriesByOwner.find(it->owner);
+    if (--ownerIt->second == 0) {
+        partition->numEntriesByOwner.erase(ownerIt);
+    }
+    partition->slots.erase(it);
+}
+
+void PlanCacheStore::_evict(Partition* partition,
+                            SlotList::iterator inserted,
+                            std::vector<std::unique_ptr<PlanCacheEntry>>* evicted) {
+    // Give each partition an equal share of the limits, rounding up so that a store with a single
+    // partition gets all of it.
+    const size_t numPartitions = _partitions.size();
+    const size_t maxEntries = _maxEntries();
+    const size_t maxBytes = _maxBytes();
+    const size_t partitionMaxEntries =
+        maxEntries / numPartitions + (maxEntries % numPartitions != 0 ? 1 : 0);
+    const size_t partitionMaxBytes =
+        maxBytes / numPartitions + (maxBytes % numPartitions != 0 ? 1 : 0);
+
+    auto& slots = partition->slots;
+    while (!slots.empty() &&
+           (slots.size() > partitionMaxEntries || partition->bytes > partitionMaxBytes)) {
+        auto victim = std::prev(slots.end());
+        if (victim->useCount > 0 || (victim == inserted && slots.size() > 1)) {
+            // Either the entry has been used since it was last considered for eviction, or it is
+            // the entry just inserted, which only goes once all the others have. This terminates
+            // as every pass over the list decrements the use count of each other entry.
+            if (victim->useCount > 0) {
+                --victim->useCount;
+            }
+            slots.splice(slots.begin(), slots, victim);
+            continue;
+        }
+
+        evicted->push_back(std::move(victim->entry));
+        _erase(partition, victim);
+        PlanCache::planCacheEvictions.increment();
+    }
+}
+
+void PlanCacheStore::visit(OwnerId owner,
+                           const PlanCacheKey& key,
+                           bool recordUse,
+                           const std::function<void(PlanCacheEntry*)>& fn) {
+    auto& partition = _partitionFor(owner, key);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.index.find({owner, &key});
+    if (it == partition.index.end()) {
+        fn(nullptr);
+        return;
+    }
+
+    auto slot = it->second;
+    if (recordUse) {
+        partition.slots.splice(partition.slots.begin(), partition.slots, slot);
+        slot->useCount = std::min<uint8_t>(slot->useCount + 1, kMaxUseCount);
+    }
+    fn(slot->entry.get());
+}
+
+std::vector<std::unique_ptr<PlanCacheEntry>> PlanCacheStore::upsert(
+    OwnerId owner,
+    const PlanCacheKey& key,
+    const std::function<std::unique_ptr<PlanCacheEntry>(PlanCacheEntry*)>& fn) {
+    std::vector<std::unique_ptr<PlanCacheEntry>> evicted;
+
+    auto& partition = _partitionFor(owner, key);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.index.find({owner, &key});
+    auto newEntry = fn(it != partition.index.end() ? it->second->entry.get() : nullptr);
+    if (!newEntry) {
+        return evicted;
+    }
+
+    // A replaced entry keeps its use count, as the new entry caches a plan for the same query
+    // shape.
+    uint8_t useCount = 0;
+    if (it != partition.index.end()) {
+        useCount = it->second->useCount;
+        evicted.push_back(std::move(it->second->entry));
+        _erase(&partition, it->second);
+    }
+
+    const size_t bytes = newEntry->estimatedEntrySizeBytes() + key.toString().size();
+    partition.slots.push_front({owner, key, std::move(newEntry), bytes, useCount});
+    partition.index.emplace(SlotKey{owner, &partition.slots.front().key},
+                            partition.slots.begin());
+    partition.bytes += bytes;
+    ++partition.numEntriesByOwner[owner];
+
+    // The replaced entry, if any, is not an eviction.
+    const size_t numReplaced = evicted.size();
+    _evict(&partition, partition.slots.begin(), &evicted);
+    evicted.erase(evicted.begin(), evicted.begin() + numReplaced);
+    return evicted;
+}
+
+bool PlanCacheStore::remove(OwnerId owner, const PlanCacheKey& key) {
+    std::unique_ptr<PlanCacheEntry> removed;
+
+    auto& partition = _partitionFor(owner, key);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto it = partition.index.find({owner, &key});
+    if (it == partition.index.end()) {
+        return false;
+    }
+    removed = std::move(it->second->entry);
+    _erase(&partition, it->second);
+    return true;
+}
+
+void PlanCacheStore::removeAll(OwnerId owner) {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (!partition.numEntriesByOwner.count(owner)) {
+            continue;
+        }
+        for (auto it = partition.slots.begin(); it != partition.slots.end();) {
+            auto next = std::next(it);
+            if (it->owner == owner) {
+                _erase(&partition, it);
+            }
+            it = next;
+        }
+    }
+}
+
+void PlanCacheStore::forEach(OwnerId owner,
+                             const std::function<void(const PlanCacheEntry&)>& fn) const {
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        if (!partition.numEntriesByOwner.count(owner)) {
+            continue;
+        }
+        for (auto&& slot : partition.slots) {
+            if (slot.owner == owner) {
+                fn(*slot.entry);
+            }
+        }
+    }
+}
+
+size_t PlanCacheStore::size(OwnerId owner) const {
+    size_t size = 0;
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition.mutex);
+        auto it = partition.numEntriesByOwner.find(owner);
+        if (it != partition.numEntriesByOwner.end()) {
+            size += it->second;
+        }
+    }
+    return size;
+}
+
 //
 // PlanCache
 //
 
-PlanCache::PlanCache() : PlanCache(internalQueryCacheSize.load()) {}
+PlanCache::PlanCache() : _store(&PlanCacheStore::getShared()), _ownerId(_store->makeOwnerId()) {}
 
-PlanCache::PlanCache(size_t size) : _cache(size) {}
+PlanCache::PlanCache(size_t size)
+    : _ownStore(std::make_unique<PlanCacheStore>(
+          1, [size] { return size; }, [] { return std::numeric_limits<size_t>::max(); })),
+      _store(_ownStore.get()),
+      _ownerId(_store->makeOwnerId()) {}
 
-PlanCache::~PlanCache() {}
+PlanCache::~PlanCache() {
+    if (!_ownStore) {
+        _store->removeAll(_ownerId);
+    }
+}
 
 std::unique_ptr<CachedSolution> PlanCache::getCacheEntryIfActive(const PlanCacheKey& key) const {
 
@@ -577,55 +831,101 @@ Status PlanCache::set(const CanonicalQuery& query,
                                  }},
         why->stats);
     const auto key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    bool isNewEntryActive = false;
-    uint32_t queryHash;
-    uint32_t planCacheKey;
-    if (internalQueryCacheDisableInactiveEntries.load()) {
-        // All entries are always active.
-        isNewEntryActive = true;
-        planCacheKey = canonical_query_encoder::computeHash(key.stringData());
-        queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
-    } else {
-        PlanCacheEntry* oldEntry = nullptr;
-        Status cacheStatus = _cache.get(key, &oldEntry);
-        invariant(cacheStatus.isOK() || cacheStatus == ErrorCodes::NoSuchKey);
-        if (oldEntry) {
-            queryHash = oldEntry->queryHash;
-            planCacheKey = oldEntry->planCacheKey;
-        } else {
-            planCacheKey = canonical_query_encoder::computeHash(key.stringData());
-            queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
-        }
+    const double growthCoefficient =
+        worksGrowthCoefficient.get_value_or(internalQueryCacheWorksGrowthCoefficient);
+    auto evictedEntries = _store->upsert(
+        _ownerId, key, [&](PlanCacheEntry* oldEntry) -> std::unique_ptr<PlanCacheEntry> {
+            bool isNewEntryActive = false;
+            uint32_t queryHash;
+            uint32_t planCacheKey;
+            if (internalQueryCacheDisableInactiveEntries.load()) {
+                // All entries are always active.
+                isNewEntryActive = true;
+                planCacheKey = canonical_query_encoder::computeHash(key.stringData());
+                queryHash = canonical_query_encoder::computeHash(key.getStableKeyStringData());
+            } else {
+                if (oldEntry) {
+                    queryHash = oldEntry->queryHash;
+                    planCacheKey = oldEntry->planCacheKey;
+                } else {
+                    planCacheKey = canonical_query_encoder::computeHash(key.stringData());
+                    queryHash =
+                        canonical_query_encoder::computeHash(key.getStableKeyStringData());
+                }
 
-        const auto newState = getNewEntryState(
-            query,
-            queryHash,
-            planCacheKey,
-            oldEntry,
-            newWorks,
-            worksGrowthCoefficient.get_value_or(internalQueryCacheWorksGrowthCoefficient));
+                const auto newState = getNewEntryState(
+                    query, queryHash, planCacheKey, oldEntry, newWorks, growthCoefficient);
 
-        if (!newState.shouldBeCreated) {
-            return Status::OK();
-        }
-        isNewEntryActive = newState.shouldBeActive;
-    }
+                if (!newState.shouldBeCreated) {
+                    return nullptr;
+                }
+                isNewEntryActive = newState.shouldBeActive;
+            }
 
-    auto newEntry(PlanCacheEntry::create(
-        solns, std::move(why), query, queryHash, planCacheKey, now, isNewEntryActive, newWorks));
+            return PlanCacheEntry::create(solns,
+                                          std::move(why),
+                                          query,
+                                          queryHash,
+                                          planCacheKey,
+                                          now,
+                                          isNewEntryActive,
+                                          newWorks);
+        });
 
-    std::unique_ptr<PlanCacheEntry> evictedEntry = _cache.add(key, newEntry.release());
+    logEvictedEntries(query, evictedEntries);
 
-    if (nullptr != evictedEntry.get()) {
-        LOGV2_DEBUG(20942,
-                    1,
-                    "Plan cache maximum size exceeded - removed least recently used entry",
-                    "namespace"_attr = query.nss(),
-                    "evictedEntry"_attr = redact(evictedEntry->toString()));
+    return Status::OK();
+}
+
+StatusWith<bool> PlanCache::restore(const CanonicalQuery& query,
+                                    std::unique_ptr<SolutionCacheData> cacheData,
+                                    size_t works,
+                                    bool isActive,
+                                    Date_t now) {
+    invariant(cacheData);
+
+    if (!shouldCacheQuery(query)) {
+        return Status(ErrorCodes::BadValue, "query is not eligible for the plan cache");
     }
 
-    return Status::OK();
+    // The restored plan is recorded as the only candidate, which was picked after 'works' work
+    // cycles.
+    auto stats = std::make_unique<PlanStageStats>(CommonStats("CACHED_PLAN"), STAGE_CACHED_PLAN);
+    stats->common.works = works;
+    std::vector<std::unique_ptr<PlanStageStats>> candidateStats;
+    candidateStats.push_back(std::move(stats));
+    auto why = std::make_unique<plan_ranker::PlanRankingDecision>();
+    why->stats = std::move(candidateStats);
+    why->scores.push_back(0);
+    why->candidateOrder.push_back(0);
+
+    QuerySolution soln;
+    soln.cacheData = std::move(cacheData);
+    const std::vector<QuerySolution*> solns{&soln};
+
+    const auto key = computeKey(query);
+    bool restored = false;
+    auto evictedEntries = _store->upsert(
+        _ownerId, key, [&](PlanCacheEntry* oldEntry) -> std::unique_ptr<PlanCacheEntry> {
+            if (oldEntry) {
+                return nullptr;
+            }
+
+            restored = true;
+            return PlanCacheEntry::create(
+                solns,
+                std::move(why),
+                query,
+                canonical_query_encoder::computeHash(key.getStableKeyStringData()),
+                canonical_query_encoder::computeHash(key.stringData()),
+                now,
+                isActive || internalQueryCacheDisableInactiveEntries.load(),
+                works);
+        });
+
+    logEvictedEntries(query, evictedEntries);
+
+    return restored;
 }
 
 void PlanCache::deactivate(const CanonicalQuery& query) {
@@ -635,15 +935,11 @@ void PlanCache::deactivate(const CanonicalQuery& query) {
     }
 
     PlanCacheKey key = computeKey(query);
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
-    if (!cacheStatus.isOK()) {
-        invariant(cacheStatus == ErrorCodes::NoSuchKey);
-        return;
-    }
-    invariant(entry);
-    entry->isActive = false;
+    _store->visit(_ownerId, key, false, [](PlanCacheEntry* entry) {
+        if (entry) {
+            entry->isActive = false;
+        }
+    });
 }
 
 PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
@@ -652,28 +948,33 @@ PlanCache::GetResult PlanCache::get(const CanonicalQuery& query) const {
 }
 
 PlanCache::GetResult PlanCache::get(const PlanCacheKey& key) const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    PlanCacheEntry* entry = nullptr;
-    Status cacheStatus = _cache.get(key, &entry);
-    if (!cacheStatus.isOK()) {
-        invariant(cacheStatus == ErrorCodes::NoSuchKey);
-        return {CacheEntryState::kNotPresent, nullptr};
-    }
-    invariant(entry);
+    GetResult result{CacheEntryState::kNotPresent, nullptr};
+    _store->visit(_ownerId, key, true, [&](PlanCacheEntry* entry) {
+        if (!entry) {
+            return;
+        }
+        result.state =
+            entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
+        result.cachedSolution = std::make_unique<CachedSolution>(key, *entry);
+    });
 
-    auto state =
-        entry->isActive ? CacheEntryState::kPresentActive : CacheEntryState::kPresentInactive;
-    return {state, std::make_unique<CachedSolution>(key, *entry)};
+    if (result.state == CacheEntryState::kPresentActive) {
+        planCacheHits.increment();
+    } else {
+        planCacheMisses.increment();
+    }
+    return result;
 }
 
 Status PlanCache::remove(const CanonicalQuery& canonicalQuery) {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.remove(computeKey(canonicalQuery));
+    if (!_store->remove(_ownerId, computeKey(canonicalQuery))) {
+        return Status(ErrorCodes::NoSuchKey, "no such key in plan cache");
+    }
+    return Status::OK();
 }
 
 void PlanCache::clear() {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    _cache.clear();
+    _store->removeAll(_ownerId);
 }
 
 PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
@@ -687,32 +988,27 @@ PlanCacheKey PlanCache::computeKey(const CanonicalQuery& cq) const {
 StatusWith<std::unique_ptr<PlanCacheEntry>> PlanCache::getEntry(const CanonicalQuery& query) const {
     PlanCacheKey key = computeKey(query);
 
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    PlanCacheEntry* entry;
-    Status cacheStatus = _cache.get(key, &entry);
-    if (!cacheStatus.isOK()) {
-        return cacheStatus;
+    std::unique_ptr<PlanCacheEntry> entryCopy;
+    _store->visit(_ownerId, key, false, [&](PlanCacheEntry* entry) {
+        if (entry) {
+            entryCopy = entry->clone();
+        }
+    });
+    if (!entryCopy) {
+        return Status(ErrorCodes::NoSuchKey, "no such key in plan cache");
     }
-    invariant(entry);
-
-    return std::unique_ptr<PlanCacheEntry>(entry->clone());
+    return std::move(entryCopy);
 }
 
 std::vector<std::unique_ptr<PlanCacheEntry>> PlanCache::getAllEntries() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
     std::vector<std::unique_ptr<PlanCacheEntry>> entries;
-
-    for (auto&& cacheEntry : _cache) {
-        auto entry = cacheEntry.second;
-        entries.push_back(std::unique_ptr<PlanCacheEntry>(entry->clone()));
-    }
-
+    _store->forEach(_ownerId,
+                    [&](const PlanCacheEntry& entry) { entries.push_back(entry.clone()); });
     return entries;
 }
 
 size_t PlanCache::size() const {
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-    return _cache.size();
+    return _store->size(_ownerId);
 }
 
 void PlanCache::notifyOfIndexUpdates(const std::vector<CoreIndexInfo>& indexCores) {
@@ -723,15 +1019,12 @@ std::vector<BSONObj> PlanCache::getMatchingStats(
     const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
     const std::function<bool(const BSONObj&)>& filterFunc) const {
     std::vector<BSONObj> results;
-    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
-
-    for (auto&& cacheEntry : _cache) {
-        const auto entry = cacheEntry.second;
-        auto serializedEntry = serializationFunc(*entry);
+    _store->forEach(_ownerId, [&](const PlanCacheEntry& entry) {
+        auto serializedEntry = serializationFunc(entry);
         if (filterFunc(serializedEntry)) {
             results.push_back(serializedEntry);
         }
-    }
+    });
 
     return results;
 }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional/optional.hpp>
+#include <list>
 #include <set>
 
 #include "mongo/db/exec/plan_stats.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/container_size_helper.h"
 
 namespace mongo {
@@ -247,6 +249,11 @@ struct SolutionCacheData {
         // scan (e.g. using index to provide sort).
         WHOLE_IXSCAN_SOLN,
 
+        // The plan scans the index in 'tree' with bounds on its
+        // non-leading fields, skipping from one leading value
+        // to the next.
+        SKIP_SCAN_SOLN,
+
         // The cached plan is a collection scan.
         COLLSCAN_SOLN,
 
@@ -266,6 +273,34 @@ struct SolutionCacheData {
 
 class PlanCacheEntry;
 
+/**
+ * An executable tree built from the cached plan of a query shape for one particular query, which
+ * the execution engine that built it can copy to run an identical query without planning it from
+ * the cache again. The plan cache treats it as opaque.
+ */
+class CachedExecutableTree {
+public:
+    virtual ~CachedExecutableTree() = default;
+};
+
+/**
+ * The executable trees built from a plan cache entry, keyed by a string which identifies the query
+ * each was built for. Holds at most 'internalQueryPlanCacheMaxExecutableTreesPerEntry' trees,
+ * evicting the least recently used. Safe to use from several threads.
+ */
+class ExecutableTreeCache {
+public:
+    ExecutableTreeCache();
+
+    std::shared_ptr<const CachedExecutableTree> find(const std::string& queryKey) const;
+
+    void add(const std::string& queryKey, std::shared_ptr<const CachedExecutableTree> tree);
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ExecutableTreeCache::_mutex");
+    LRUKeyValue<std::string, std::shared_ptr<const CachedExecutableTree>> _trees;
+};
+
 /**
  * Information returned from a get(...) query.
  */
@@ -298,6 +333,10 @@ public:
     // The number of work cycles taken to decide on a winning plan when the plan was first
     // cached.
     size_t decisionWorks;
+
+    // The executable trees built from the plan of the entry. Unlike the rest of the data, they are
+    // shared with the entry, so that the trees built for this solution outlive it.
+    std::shared_ptr<ExecutableTreeCache> executableTrees;
 };
 
 /**
@@ -331,6 +370,10 @@ public:
     // For debugging.
     std::string toString() const;
 
+    uint64_t estimatedEntrySizeBytes() const {
+        return _entireObjectSize;
+    }
+
     //
     // Planner data
     //
@@ -375,6 +418,11 @@ public:
     // cause this value to be increased.
     size_t works = 0;
 
+    // The executable trees built from the plan of this entry. They are discarded along with the
+    // entry, so the trees built from a replaced or removed plan are never run again.
+    const std::shared_ptr<ExecutableTreeCache> executableTrees =
+        std::make_shared<ExecutableTreeCache>();
+
     /**
      * Tracks the approximate cumulative size of the plan cache entries across all the collections.
      */
@@ -407,6 +455,143 @@ private:
     const uint64_t _entireObjectSize;
 };
 
+/**
+ * Holds the entries of one or more plan caches, each of which is identified by an OwnerId. Every
+ * plan cache created with the default constructor keeps its entries in the server-wide store
+ * returned by getShared(), so that the entries of all collections compete for a single memory
+ * budget of 'internalQueryPlanCacheSizeBytes'.
+ *
+ * The entries are spread over a number of partitions by the hash of their owner and key, each with
+ * its own mutex and an equal share of the budget. Within a partition, entries are evicted in least
+ * recently used order, except that an entry which has been used since it was last considered for
+ * eviction gets a second chance: its use count is decremented and it moves back to the front. A
+ * newly inserted entry is evicted last.
+ * This keeps the entries of frequently run queries cached while a burst of one-off query shapes
+ * passes through the cache.
+ */
+class PlanCacheStore {
+public:
+    using OwnerId = uint64_t;
+
+    /**
+     * Returns the server-wide store.
+     */
+    static PlanCacheStore& getShared();
+
+    /**
+     * Creates a store bounded by 'maxEntries' entries and 'maxBytes' bytes, re-evaluated whenever
+     * an entry is added.
+     */
+    PlanCacheStore(size_t numPartitions,
+                   std::function<size_t()> maxEntries,
+                   std::function<size_t()> maxBytes);
+
+    PlanCacheStore(const PlanCacheStore&) = delete;
+    PlanCacheStore& operator=(const PlanCacheStore&) = delete;
+
+    /**
+     * Returns an id which no plan cache has used before.
+     */
+    OwnerId makeOwnerId();
+
+    /**
+     * Calls 'fn' with the entry of 'owner' for 'key', or with nullptr if there is none, under the
+     * lock of its partition. If 'recordUse' is true, the entry becomes the most recently used and
+     * its use count is incremented.
+     */
+    void visit(OwnerId owner,
+               const PlanCacheKey& key,
+               bool recordUse,
+               const std::function<void(PlanCacheEntry*)>& fn);
+
+    /**
+     * Calls 'fn' with the entry of 'owner' for 'key', or with nullptr if there is none, under the
+     * lock of its partition, and stores the entry 'fn' returns in its place unless it returns
+     * nullptr. Returns the entries evicted to make room for the new entry, which the caller
+     * should destroy once it no longer needs to hold any lock.
+     */
+    std::vector<std::unique_ptr<PlanCacheEntry>> upsert(
+        OwnerId owner,
+        const PlanCacheKey& key,
+        const std::function<std::unique_ptr<PlanCacheEntry>(PlanCacheEntry*)>& fn);
+
+    /**
+     * Removes the entry of 'owner' for 'key'. Returns false if there was no such entry.
+     */
+    bool remove(OwnerId owner, const PlanCacheKey& key);
+
+    /**
+     * Removes all the entries of 'owner'.
+     */
+    void removeAll(OwnerId owner);
+
+    /**
+     * Calls 'fn' with each entry of 'owner', partition by partition and, within a partition, from
+     * the most to the least recently used.
+     */
+    void forEach(OwnerId owner, const std::function<void(const PlanCacheEntry&)>& fn) const;
+
+    /**
+     * Returns the number of entries of 'owner'.
+     */
+    size_t size(OwnerId owner) const;
+
+private:
+    // Entries which were used more often than this are treated as if they had been used this many
+    // times, so that an entry which was popular once cannot stay cached forever.
+    static constexpr uint8_t kMaxUseCount = 3;
+
+    struct Slot {
+        OwnerId owner;
+        PlanCacheKey key;
+        std::unique_ptr<PlanCacheEntry> entry;
+        // The size of the entry and its key, as accounted against the budget.
+        size_t bytes;
+        uint8_t useCount{0};
+    };
+    using SlotList = std::list<Slot>;
+
+    struct SlotKey {
+        OwnerId owner;
+        // Points into the key held by the slot.
+        const PlanCacheKey* key;
+    };
+    struct SlotKeyHasher {
+        size_t operator()(const SlotKey& k) const;
+    };
+    struct SlotKeyEq {
+        bool operator()(const SlotKey& lhs, const SlotKey& rhs) const {
+            return lhs.owner == rhs.owner && *lhs.key == *rhs.key;
+        }
+    };
+
+    struct Partition {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("PlanCacheStore::Partition::mutex");
+        // Sorted from the most to the least recently used.
+        SlotList slots;
+        stdx::unordered_map<SlotKey, SlotList::iterator, SlotKeyHasher, SlotKeyEq> index;
+        stdx::unordered_map<OwnerId, size_t> numEntriesByOwner;
+        size_t bytes{0};
+    };
+
+    Partition& _partitionFor(OwnerId owner, const PlanCacheKey& key);
+
+    static void _erase(Partition* partition, SlotList::iterator it);
+
+    /**
+     * Evicts entries from 'partition' until it fits into its share of the limits, moving them to
+     * 'evicted'. The entry 'inserted' is only evicted if it is the last one left.
+     */
+    void _evict(Partition* partition,
+                SlotList::iterator inserted,
+                std::vector<std::unique_ptr<PlanCacheEntry>>* evicted);
+
+    std::vector<Partition> _partitions;
+    const std::function<size_t()> _maxEntries;
+    const std::function<size_t()> _maxBytes;
+    AtomicWord<OwnerId> _nextOwnerId{1};
+};
+
 /**
  * Caches the best solution to a query.  Aside from the (CanonicalQuery -> QuerySolution)
  * mapping, the cache contains information on why that mapping was made and statistics on the
@@ -453,10 +638,13 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * Creates a plan cache which keeps its entries in the server-wide PlanCacheStore.
      */
     PlanCache();
 
+    /**
+     * Creates a plan cache with a store of its own, which holds at most 'size' entries.
+     */
     PlanCache(size_t size);
 
     ~PlanCache();
@@ -481,6 +669,20 @@ public:
                Date_t now,
                boost::optional<double> worksGrowthCoefficient = boost::none);
 
+    /**
+     * Installs an entry for 'query' whose winning plan is described by 'cacheData', which was
+     * taken from a snapshot of a plan cache, e.g. the one of the previous primary. The entry
+     * takes over the 'works' value and the state of the snapshotted entry. Does nothing if the
+     * cache already holds an entry for the query shape, since that entry is more recent.
+     *
+     * Returns whether the entry was installed.
+     */
+    StatusWith<bool> restore(const CanonicalQuery& query,
+                             std::unique_ptr<SolutionCacheData> cacheData,
+                             size_t works,
+                             bool isActive,
+                             Date_t now);
+
     /**
      * Set a cache entry back to the 'inactive' state. Rather than completely evicting an entry
      * when the associated plan starts to perform poorly, we deactivate it, so that plans which
@@ -569,6 +771,14 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Count the lookups of the planner which found an active entry, the lookups which didn't, and
+     * the entries evicted to stay within the size limits of the plan caches.
+     */
+    inline static Counter64 planCacheHits;
+    inline static Counter64 planCacheMisses;
+    inline static Counter64 planCacheEvictions;
+
 private:
     struct NewEntryState {
         bool shouldBeCreated = false;
@@ -582,10 +792,12 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    // The store owned by this cache, if it doesn't use the server-wide one.
+    std::unique_ptr<PlanCacheStore> _ownStore;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    // The store holding the entries of this cache, which are identified by '_ownerId'.
+    PlanCacheStore* _store;
+    const PlanCacheStore::OwnerId _ownerId;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
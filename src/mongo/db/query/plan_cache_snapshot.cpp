@@ -0,0 +1,254 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_snapshot.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo::plan_cache_snapshot {
+namespace {
+constexpr StringData kWholeIndexScanSolution = "wholeIndexScan"_sd;
+constexpr StringData kSkipScanSolution = "skipScan"_sd;
+constexpr StringData kCollectionScanSolution = "collectionScan"_sd;
+constexpr StringData kIndexTagsSolution = "indexTags"_sd;
+
+BSONObj serializeIndexIdentifier(const IndexEntry::Identifier& identifier) {
+    BSONObjBuilder bob;
+    bob.append("name", identifier.catalogName);
+    if (!identifier.disambiguator.empty()) {
+        bob.append("disambiguator", identifier.disambiguator);
+    }
+    return bob.obj();
+}
+
+BSONObj serializeIndexTree(const PlanCacheIndexTree& tree) {
+    BSONObjBuilder bob;
+    if (tree.entry) {
+        bob.append("index", serializeIndexIdentifier(tree.entry->identifier));
+        bob.append("position", static_cast<long long>(tree.index_pos));
+        bob.append("canCombineBounds", tree.canCombineBounds);
+    }
+
+    BSONArrayBuilder orPushdowns(bob.subarrayStart("orPushdowns"));
+    for (auto&& orPushdown : tree.orPushdowns) {
+        BSONObjBuilder orPushdownBob(orPushdowns.subobjStart());
+        orPushdownBob.append("index", serializeIndexIdentifier(orPushdown.indexEntryId));
+        orPushdownBob.append("position", static_cast<long long>(orPushdown.position));
+        orPushdownBob.append("canCombineBounds", orPushdown.canCombineBounds);
+        BSONArrayBuilder route(orPushdownBob.subarrayStart("route"));
+        for (auto position : orPushdown.route) {
+            route.append(static_cast<long long>(position));
+        }
+    }
+    orPushdowns.doneFast();
+
+    BSONArrayBuilder children(bob.subarrayStart("children"));
+    for (auto&& child : tree.children) {
+        children.append(serializeIndexTree(*child));
+    }
+    children.doneFast();
+    return bob.obj();
+}
+
+BSONElement getField(const BSONObj& obj, StringData name, BSONType type) {
+    auto elem = obj[name];
+    uassert(5190200,
+            str::stream() << "Plan cache snapshot field '" << name << "' must be of type "
+                          << typeName(type) << ", found: " << elem,
+            elem.type() == type);
+    return elem;
+}
+
+BSONObj getObject(const BSONElement& elem) {
+    uassert(5190203,
+            str::stream() << "Plan cache snapshot field '" << elem.fieldNameStringData()
+                          << "' must contain objects, found: " << elem,
+            elem.type() == BSONType::Object);
+    return elem.Obj();
+}
+
+size_t getNonNegativeNumber(const BSONElement& elem) {
+    uassert(5190201,
+            str::stream() << "Plan cache snapshot field '" << elem.fieldNameStringData()
+                          << "' must be a non-negative integer, found: " << elem,
+            elem.isNumber() && elem.safeNumberLong() >= 0);
+    return static_cast<size_t>(elem.safeNumberLong());
+}
+
+IndexEntry::Identifier parseIndexIdentifier(const BSONObj& obj) {
+    IndexEntry::Identifier identifier{getField(obj, "name", BSONType::String).str()};
+    if (obj.hasField("disambiguator")) {
+        identifier.disambiguator = getField(obj, "disambiguator", BSONType::String).str();
+    }
+    return identifier;
+}
+
+/**
+ * Returns the index with the given identifier. Wildcard indexes are listed once under their
+ * catalog name, whereas the planner refers to one expanded entry per path, which is identified by
+ * the path as well. Such entries are resolved to a copy of the wildcard index identified the same
+ * way.
+ */
+IndexEntry resolveIndex(const IndexEntry::Identifier& identifier,
+                        const std::vector<IndexEntry>& indexes) {
+    auto index = std::find_if(indexes.begin(), indexes.end(), [&](auto&& entry) {
+        return entry.identifier.catalogName == identifier.catalogName;
+    });
+    uassert(5190202,
+            str::stream() << "Plan cache snapshot refers to index " << identifier
+                          << ", which does not exist",
+            index != indexes.end() &&
+                (identifier.disambiguator.empty() || index->type == INDEX_WILDCARD));
+
+    IndexEntry resolved{*index};
+    resolved.identifier = identifier;
+    return resolved;
+}
+
+std::unique_ptr<PlanCacheIndexTree> parseIndexTree(const BSONObj& obj,
+                                                   const std::vector<IndexEntry>& indexes) {
+    auto tree = std::make_unique<PlanCacheIndexTree>();
+    if (obj.hasField("index")) {
+        tree->setIndexEntry(
+            resolveIndex(parseIndexIdentifier(getField(obj, "index", BSONType::Object).Obj()),
+                         indexes));
+        tree->index_pos = getNonNegativeNumber(obj["position"]);
+        tree->canCombineBounds = getField(obj, "canCombineBounds", BSONType::Bool).boolean();
+    }
+
+    for (auto&& elem : getField(obj, "orPushdowns", BSONType::Array).Obj()) {
+        const auto orPushdownObj = getObject(elem);
+
+        auto index = resolveIndex(
+            parseIndexIdentifier(getField(orPushdownObj, "index", BSONType::Object).Obj()),
+            indexes);
+        std::deque<size_t> route;
+        for (auto&& position : getField(orPushdownObj, "route", BSONType::Array).Obj()) {
+            route.push_back(getNonNegativeNumber(position));
+        }
+        PlanCacheIndexTree::OrPushdown orPushdown{
+            std::move(index.identifier),
+            getNonNegativeNumber(orPushdownObj["position"]),
+            getField(orPushdownObj, "canCombineBounds", BSONType::Bool).boolean(),
+            std::move(route)};
+        tree->orPushdowns.push_back(std::move(orPushdown));
+    }
+
+    for (auto&& elem : getField(obj, "children", BSONType::Array).Obj()) {
+        tree->children.push_back(parseIndexTree(getObject(elem), indexes).release());
+    }
+    return tree;
+}
+}  // namespace
+
+BSONObj serializeEntry(const PlanCacheEntry& entry) {
+    invariant(!entry.plannerData.empty());
+
+    BSONObjBuilder bob;
+    bob.append("query", entry.query);
+    bob.append("sort", entry.sort);
+    bob.append("projection", entry.projection);
+    if (!entry.collation.isEmpty()) {
+        bob.append("collation", entry.collation);
+    }
+    bob.append("works", static_cast<long long>(entry.works));
+    bob.append("isActive", entry.isActive);
+    bob.append("solution", serializeSolution(*entry.plannerData[0]));
+    return bob.obj();
+}
+
+BSONObj serializeSolution(const SolutionCacheData& cacheData) {
+    BSONObjBuilder bob;
+    switch (cacheData.solnType) {
+        case SolutionCacheData::WHOLE_IXSCAN_SOLN:
+            bob.append("type", kWholeIndexScanSolution);
+            bob.append("direction", cacheData.wholeIXSolnDir);
+            break;
+        case SolutionCacheData::SKIP_SCAN_SOLN:
+            bob.append("type", kSkipScanSolution);
+            break;
+        case SolutionCacheData::COLLSCAN_SOLN:
+            bob.append("type", kCollectionScanSolution);
+            break;
+        case SolutionCacheData::USE_INDEX_TAGS_SOLN:
+            bob.append("type", kIndexTagsSolution);
+            break;
+    }
+    bob.append("indexFilterApplied", cacheData.indexFilterApplied);
+    if (cacheData.tree) {
+        bob.append("tree", serializeIndexTree(*cacheData.tree));
+    }
+    return bob.obj();
+}
+
+std::unique_ptr<SolutionCacheData> parseSolution(const BSONObj& obj,
+                                                 const std::vector<IndexEntry>& indexes) {
+    auto cacheData = std::make_unique<SolutionCacheData>();
+
+    const auto type = getField(obj, "type", BSONType::String).valueStringData();
+    if (type == kWholeIndexScanSolution) {
+        cacheData->solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
+        auto direction = obj["direction"];
+        uassert(5190204,
+                str::stream() << "Plan cache snapshot field 'direction' must be 1 or -1, found: "
+                              << direction,
+                direction.isNumber() &&
+                    (direction.numberInt() == 1 || direction.numberInt() == -1));
+        cacheData->wholeIXSolnDir = direction.numberInt();
+    } else if (type == kSkipScanSolution) {
+        cacheData->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+    } else if (type == kCollectionScanSolution) {
+        cacheData->solnType = SolutionCacheData::COLLSCAN_SOLN;
+    } else {
+        uassert(5190205,
+                str::stream() << "Unknown plan cache snapshot solution type: " << type,
+                type == kIndexTagsSolution);
+        cacheData->solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    }
+    cacheData->indexFilterApplied = getField(obj, "indexFilterApplied", BSONType::Bool).boolean();
+
+    if (cacheData->solnType != SolutionCacheData::COLLSCAN_SOLN) {
+        const auto treeObj = getField(obj, "tree", BSONType::Object).Obj();
+        if (cacheData->solnType == SolutionCacheData::WHOLE_IXSCAN_SOLN ||
+            cacheData->solnType == SolutionCacheData::SKIP_SCAN_SOLN) {
+            // The bounds are rebuilt from the query, so the tree consists of the index entry only.
+            getField(treeObj, "index", BSONType::Object);
+        }
+        cacheData->tree = parseIndexTree(treeObj, indexes);
+    }
+    return cacheData;
+}
+}  // namespace mongo::plan_cache_snapshot
@@ -0,0 +1,75 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/db/query/plan_cache.h"
+
+/**
+ * Converts plan cache entries to BSON and back, so that the plans chosen by one node can be used
+ * to warm up the plan cache of a node which has not planned the queries yet, e.g. a new primary.
+ */
+namespace mongo::plan_cache_snapshot {
+/**
+ * Serializes the query shape and the winning plan of 'entry'. The result has the form
+ *
+ *    {
+ *        query: <query>,
+ *        sort: <sort>,
+ *        projection: <projection>,
+ *        collation: <collation>,
+ *        works: <works>,
+ *        isActive: <bool>,
+ *        solution: <plan serialized by serializeSolution()>
+ *    }
+ *
+ * where 'collation' is omitted if the query has none. The query shape fields can be passed to
+ * plan_cache_commands::canonicalize() as they are.
+ */
+BSONObj serializeEntry(const PlanCacheEntry& entry);
+
+/**
+ * Serializes the plan described by 'cacheData'. The indexes which the plan uses are referred to by
+ * their identifiers only.
+ */
+BSONObj serializeSolution(const SolutionCacheData& cacheData);
+
+/**
+ * Parses a plan serialized by serializeSolution() and resolves the identifiers of the indexes it
+ * uses against 'indexes'. Throws if the plan is malformed or uses an index which is not in
+ * 'indexes'.
+ */
+std::unique_ptr<SolutionCacheData> parseSolution(const BSONObj& obj,
+                                                 const std::vector<IndexEntry>& indexes);
+}  // namespace mongo::plan_cache_snapshot
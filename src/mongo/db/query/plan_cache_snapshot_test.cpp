@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_snapshot.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/query/index_entry.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+IndexEntry buildIndexEntry(const BSONObj& kp, const std::string& indexName) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            false,
+            {},
+            {},
+            false,
+            false,
+            IndexEntry::Identifier{indexName},
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+std::vector<IndexEntry> buildIndexes() {
+    return {buildIndexEntry(BSON("a" << 1), "a_1"), buildIndexEntry(BSON("b" << 1), "b_1")};
+}
+
+std::unique_ptr<PlanCacheIndexTree> makeLeaf(const IndexEntry& index, size_t position) {
+    auto leaf = std::make_unique<PlanCacheIndexTree>();
+    leaf->setIndexEntry(index);
+    leaf->index_pos = position;
+    return leaf;
+}
+
+std::unique_ptr<SolutionCacheData> roundTrip(const SolutionCacheData& cacheData) {
+    return plan_cache_snapshot::parseSolution(plan_cache_snapshot::serializeSolution(cacheData),
+                                              buildIndexes());
+}
+
+TEST(PlanCacheSnapshotTest, IndexTaggedSolutionRoundTrips) {
+    const auto indexes = buildIndexes();
+
+    SolutionCacheData cacheData;
+    cacheData.solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    cacheData.indexFilterApplied = true;
+    cacheData.tree = std::make_unique<PlanCacheIndexTree>();
+    cacheData.tree->children.push_back(makeLeaf(indexes[0], 0).release());
+
+    auto pushedDown = makeLeaf(indexes[1], 0);
+    pushedDown->canCombineBounds = false;
+    pushedDown->orPushdowns.push_back({indexes[0].identifier, 1, true, {0, 2}});
+    cacheData.tree->children.push_back(pushedDown.release());
+    cacheData.tree->children.push_back(new PlanCacheIndexTree());
+
+    auto parsed = roundTrip(cacheData);
+    ASSERT_EQ(SolutionCacheData::USE_INDEX_TAGS_SOLN, parsed->solnType);
+    ASSERT_TRUE(parsed->indexFilterApplied);
+    ASSERT_EQ(cacheData.toString(), parsed->toString());
+    ASSERT_BSONOBJ_EQ(indexes[1].keyPattern, parsed->tree->children[1]->entry->keyPattern);
+}
+
+TEST(PlanCacheSnapshotTest, WholeIndexScanAndCollectionScanSolutionsRoundTrip) {
+    SolutionCacheData wholeIndexScan;
+    wholeIndexScan.solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
+    wholeIndexScan.wholeIXSolnDir = -1;
+    wholeIndexScan.tree = makeLeaf(buildIndexes()[1], 0);
+
+    auto parsed = roundTrip(wholeIndexScan);
+    ASSERT_EQ(SolutionCacheData::WHOLE_IXSCAN_SOLN, parsed->solnType);
+    ASSERT_EQ(-1, parsed->wholeIXSolnDir);
+    ASSERT_EQ(wholeIndexScan.toString(), parsed->toString());
+
+    SolutionCacheData collectionScan;
+    collectionScan.solnType = SolutionCacheData::COLLSCAN_SOLN;
+
+    parsed = roundTrip(collectionScan);
+    ASSERT_EQ(SolutionCacheData::COLLSCAN_SOLN, parsed->solnType);
+    ASSERT_FALSE(parsed->tree);
+}
+
+TEST(PlanCacheSnapshotTest, SolutionUsingUnknownIndexFailsToParse) {
+    SolutionCacheData cacheData;
+    cacheData.solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    cacheData.tree = makeLeaf(buildIndexEntry(BSON("c" << 1), "c_1"), 0);
+
+    ASSERT_THROWS_CODE(roundTrip(cacheData), DBException, 5190202);
+}
+
+TEST(PlanCacheSnapshotTest, MalformedSolutionFailsToParse) {
+    const auto indexes = buildIndexes();
+    ASSERT_THROWS_CODE(plan_cache_snapshot::parseSolution(BSON("type"
+                                                               << "unknown"
+                                                               << "indexFilterApplied" << false),
+                                                          indexes),
+                       DBException,
+                       5190205);
+    ASSERT_THROWS_CODE(
+        plan_cache_snapshot::parseSolution(BSON("type"
+                                                << "wholeIndexScan"
+                                                << "direction" << 1 << "indexFilterApplied"
+                                                << false << "tree"
+                                                << BSON("orPushdowns" << BSONArray() << "children"
+                                                                      << BSONArray())),
+                                           indexes),
+        DBException,
+        5190200);
+}
+
+}  // namespace
+}  // namespace mongo
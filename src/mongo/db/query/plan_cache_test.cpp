@@ -572,6 +572,141 @@ TEST(PlanCacheTest, PlanCacheLRUPolicyRemovesInactiveEntries) {
     ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
 }
 
+TEST(PlanCacheTest, PlanCacheEvictionGivesFrequentlyUsedEntriesASecondChance) {
+    const size_t kCacheSize = 2;
+    PlanCache planCache(kCacheSize);
+    QueryTestServiceContext serviceContext;
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cqA.get(), &planCache);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+
+    // Add another entry without using it. The entry for {a: 1} is now the least recently used,
+    // but it has been used once.
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    addCacheEntryForShape(*cqB.get(), &planCache);
+
+    // Inserting a third entry evicts {b: 1}, which has never been used.
+    const auto evictionsBefore = PlanCache::planCacheEvictions.get();
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+    addCacheEntryForShape(*cqC.get(), &planCache);
+    ASSERT_EQ(PlanCache::planCacheEvictions.get(), evictionsBefore + 1);
+    ASSERT_EQ(planCache.size(), kCacheSize);
+
+    ASSERT_EQ(planCache.get(*cqB).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(planCache.get(*cqA).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(planCache.get(*cqC).state, PlanCache::CacheEntryState::kPresentInactive);
+}
+
+TEST(PlanCacheTest, PlanCacheLookupsAreCountedAsHitsAndMisses) {
+    internalQueryCacheDisableInactiveEntries.store(true);
+    ON_BLOCK_EXIT([] { internalQueryCacheDisableInactiveEntries.store(false); });
+
+    PlanCache planCache;
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+
+    const auto hitsBefore = PlanCache::planCacheHits.get();
+    const auto missesBefore = PlanCache::planCacheMisses.get();
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kNotPresent);
+    addCacheEntryForShape(*cq.get(), &planCache);
+    ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentActive);
+
+    ASSERT_EQ(PlanCache::planCacheHits.get(), hitsBefore + 1);
+    ASSERT_EQ(PlanCache::planCacheMisses.get(), missesBefore + 1);
+}
+
+TEST(PlanCacheTest, SharedPlanCacheStoreEnforcesByteBudget) {
+    const auto sizeBytes = internalQueryPlanCacheSizeBytes.load();
+    ON_BLOCK_EXIT([&] { internalQueryPlanCacheSizeBytes.store(sizeBytes); });
+
+    PlanCache planCache1;
+    PlanCache planCache2;
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+
+    // Entries over the budget are evicted straight away.
+    internalQueryPlanCacheSizeBytes.store(0);
+    const auto evictionsBefore = PlanCache::planCacheEvictions.get();
+    addCacheEntryForShape(*cq.get(), &planCache1);
+    ASSERT_EQ(planCache1.size(), 0U);
+    ASSERT_EQ(PlanCache::planCacheEvictions.get(), evictionsBefore + 1);
+
+    // The caches of different collections keep the entries of the same shape apart.
+    internalQueryPlanCacheSizeBytes.store(sizeBytes);
+    addCacheEntryForShape(*cq.get(), &planCache1);
+    addCacheEntryForShape(*cq.get(), &planCache2);
+    ASSERT_EQ(planCache1.size(), 1U);
+    ASSERT_EQ(planCache2.size(), 1U);
+
+    planCache1.clear();
+    ASSERT_EQ(planCache1.size(), 0U);
+    ASSERT_EQ(planCache2.size(), 1U);
+}
+
+TEST(PlanCacheTest, PlanCacheStoreEvictsLeastRecentlyUsedEntryOfAnyOwner) {
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    auto qs = getQuerySolutionForCaching();
+    std::vector<QuerySolution*> solns = {qs.get()};
+    auto makeEntry = [&] {
+        return PlanCacheEntry::create(solns, createDecision(1U), *cq, 0, 0, Date_t{}, false, 1);
+    };
+
+    // Size the budget to hold two entries.
+    const PlanCacheKey keyA("a", "");
+    const PlanCacheKey keyB("b", "");
+    const PlanCacheKey keyC("c", "");
+    const size_t entryBytes = makeEntry()->estimatedEntrySizeBytes() + 1;
+    PlanCacheStore store(
+        1, [] { return std::numeric_limits<size_t>::max(); }, [&] { return 2 * entryBytes; });
+    const auto owner1 = store.makeOwnerId();
+    const auto owner2 = store.makeOwnerId();
+
+    auto insert = [&](PlanCacheStore::OwnerId owner, const PlanCacheKey& key) {
+        return store.upsert(owner, key, [&](PlanCacheEntry*) { return makeEntry(); }).size();
+    };
+    ASSERT_EQ(insert(owner1, keyA), 0U);
+    ASSERT_EQ(insert(owner2, keyB), 0U);
+    ASSERT_EQ(insert(owner2, keyC), 1U);
+
+    ASSERT_EQ(store.size(owner1), 0U);
+    ASSERT_EQ(store.size(owner2), 2U);
+    ASSERT_TRUE(store.remove(owner2, keyB));
+    ASSERT_FALSE(store.remove(owner1, keyA));
+    ASSERT_EQ(store.size(owner2), 1U);
+}
+
+TEST(PlanCacheTest, ExecutableTreesAreSharedWithCachedSolutionsAndDiscardedWithTheirEntry) {
+    const auto maxTrees = internalQueryPlanCacheMaxExecutableTreesPerEntry.load();
+    internalQueryPlanCacheMaxExecutableTreesPerEntry.store(1);
+    ON_BLOCK_EXIT([&] { internalQueryPlanCacheMaxExecutableTreesPerEntry.store(maxTrees); });
+
+    internalQueryCacheDisableInactiveEntries.store(true);
+    ON_BLOCK_EXIT([] { internalQueryCacheDisableInactiveEntries.store(false); });
+
+    PlanCache planCache;
+    QueryTestServiceContext serviceContext;
+    unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
+    addCacheEntryForShape(*cq.get(), &planCache);
+
+    // A tree added through one cached solution is found through another.
+    auto tree = std::make_shared<CachedExecutableTree>();
+    planCache.get(*cq).cachedSolution->executableTrees->add("query1", tree);
+    auto cachedSolution = planCache.get(*cq).cachedSolution;
+    ASSERT_EQ(cachedSolution->executableTrees->find("query1"), tree);
+    ASSERT_FALSE(cachedSolution->executableTrees->find("query2"));
+
+    // Only one tree is kept per entry.
+    cachedSolution->executableTrees->add("query2", std::make_shared<CachedExecutableTree>());
+    ASSERT_FALSE(cachedSolution->executableTrees->find("query1"));
+    ASSERT(cachedSolution->executableTrees->find("query2"));
+
+    // Replacing the entry discards its trees.
+    addCacheEntryForShape(*cq.get(), &planCache);
+    ASSERT_FALSE(planCache.get(*cq).cachedSolution->executableTrees->find("query2"));
+}
+
 TEST(PlanCacheTest, PlanCacheRemoveDeletesInactiveEntries) {
     PlanCache planCache;
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
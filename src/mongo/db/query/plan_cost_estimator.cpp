@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/db/index_names.h"
+
+namespace mongo::plan_cost_estimator {
+namespace {
+/**
+ * Returns the maximum number of index keys an index scan with the given bounds can examine, if the
+ * scan is known to look up a bounded number of keys. This is the case if every field of the bounds
+ * consists of point intervals only and the index is unique, so that each combination of the points
+ * matches at most one key.
+ */
+boost::optional<double> maxKeysExamined(const IndexScanNode* ixn) {
+    if (!ixn->index.unique || ixn->index.type != INDEX_BTREE || ixn->bounds.isSimpleRange) {
+        return boost::none;
+    }
+
+    double numPoints = 1;
+    for (auto&& oil : ixn->bounds.fields) {
+        if (!std::all_of(oil.intervals.begin(), oil.intervals.end(), [](auto&& interval) {
+                return interval.isPoint();
+            })) {
+            return boost::none;
+        }
+        numPoints *= oil.intervals.size();
+    }
+    return numPoints;
+}
+}  // namespace
+
+boost::optional<CostBound> estimateCostBound(const QuerySolutionNode* root) {
+    std::vector<CostBound> childBounds;
+    for (auto&& child : root->children) {
+        auto childBound = estimateCostBound(child);
+        if (!childBound) {
+            return boost::none;
+        }
+        childBounds.push_back(*childBound);
+    }
+
+    switch (root->getType()) {
+        case STAGE_IXSCAN: {
+            auto keys = maxKeysExamined(static_cast<const IndexScanNode*>(root));
+            if (!keys) {
+                return boost::none;
+            }
+            return CostBound{*keys, *keys};
+        }
+        case STAGE_FETCH: {
+            // Every result of the child is fetched.
+            auto& child = childBounds[0];
+            return CostBound{child.examined + child.results, child.results};
+        }
+        case STAGE_LIMIT: {
+            auto& child = childBounds[0];
+            auto limit = static_cast<double>(static_cast<const LimitNode*>(root)->limit);
+            return CostBound{child.examined, std::min(child.results, limit)};
+        }
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            CostBound bound{0, childBounds[0].results};
+            for (auto&& child : childBounds) {
+                bound.examined += child.examined;
+                bound.results = std::min(bound.results, child.results);
+            }
+            return bound;
+        }
+        case STAGE_OR:
+        case STAGE_SORT_MERGE: {
+            CostBound bound;
+            for (auto&& child : childBounds) {
+                bound.examined += child.examined;
+                bound.results += child.results;
+            }
+            return bound;
+        }
+        case STAGE_PROJECTION_COVERED:
+        case STAGE_PROJECTION_DEFAULT:
+        case STAGE_PROJECTION_SIMPLE:
+        case STAGE_RETURN_KEY:
+        case STAGE_SHARDING_FILTER:
+        case STAGE_SKIP:
+        case STAGE_SORT_DEFAULT:
+        case STAGE_SORT_KEY_GENERATOR:
+        case STAGE_SORT_SIMPLE:
+            // These stages don't examine anything themselves and return at most as many results
+            // as their child.
+            return childBounds[0];
+        default:
+            return boost::none;
+    }
+}
+
+boost::optional<size_t> pickPlanWithoutTrialRun(
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions, size_t maxExamined) {
+    boost::optional<size_t> winner;
+    double winnerExamined = 0;
+    for (size_t ix = 0; ix < solutions.size(); ++ix) {
+        auto bound = estimateCostBound(solutions[ix]->root());
+        if (!bound || bound->examined > maxExamined) {
+            continue;
+        }
+        if (!winner || bound->examined < winnerExamined) {
+            winner = ix;
+            winnerExamined = bound->examined;
+        }
+    }
+    return winner;
+}
+
+bool hasCostlyIndexIntersection(const QuerySolutionNode* root,
+                                long long numRecords,
+                                double fetchCost) {
+    for (auto&& child : root->children) {
+        if (hasCostlyIndexIntersection(child, numRecords, fetchCost)) {
+            return true;
+        }
+    }
+
+    if ((root->getType() != STAGE_AND_HASH && root->getType() != STAGE_AND_SORTED) ||
+        numRecords <= 0) {
+        return false;
+    }
+
+    double keysExamined = 0;
+    double intersectionSize = numRecords;
+    double cheapestScanCost = std::numeric_limits<double>::infinity();
+    for (auto&& child : root->children) {
+        if (child->getType() != STAGE_IXSCAN) {
+            return false;
+        }
+        auto keys = static_cast<const IndexScanNode*>(child)->estimatedKeysExamined;
+        if (!keys) {
+            return false;
+        }
+        keysExamined += *keys;
+        intersectionSize *= std::min(*keys / numRecords, 1.0);
+        cheapestScanCost = std::min(cheapestScanCost, *keys * (1 + fetchCost));
+    }
+    return keysExamined + intersectionSize * fetchCost >= cheapestScanCost;
+}
+
+void annotateEstimatedKeys(QuerySolutionNode* root,
+                           const CollectionIndexStatistics& stats,
+                           long long numRecords) {
+    for (auto&& child : root->children) {
+        annotateEstimatedKeys(child, stats, numRecords);
+    }
+
+    if (root->getType() != STAGE_IXSCAN) {
+        return;
+    }
+
+    auto ixn = static_cast<IndexScanNode*>(root);
+    auto indexStats = stats.find(ixn->index.identifier.catalogName, ixn->index.keyPattern);
+    if (!indexStats || ixn->bounds.isSimpleRange || ixn->bounds.fields.empty()) {
+        return;
+    }
+    ixn->estimatedKeysExamined = indexStats->estimateKeys(ixn->bounds.fields[0], numRecords);
+}
+
+}  // namespace mongo::plan_cost_estimator
@@ -0,0 +1,90 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/db/query/index_statistics.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo::plan_cost_estimator {
+
+/**
+ * An upper bound on the cost of running a query solution to completion.
+ */
+struct CostBound {
+    // The maximum number of index keys and documents the plan examines.
+    double examined{0};
+    // The maximum number of results the plan returns.
+    double results{0};
+};
+
+/**
+ * Computes an upper bound on the cost of running the solution tree rooted at 'root', using only
+ * the index bounds of its index scans and the properties of the scanned indexes. Returns
+ * boost::none if the cost cannot be bounded, for example because the tree scans the collection or
+ * a range of an index.
+ */
+boost::optional<CostBound> estimateCostBound(const QuerySolutionNode* root);
+
+/**
+ * Attempts to pick the winning plan out of 'solutions' without running them, and returns the
+ * index of the chosen solution. A solution is only chosen if it is guaranteed to examine at most
+ * 'maxExamined' index keys and documents, because such a plan would quickly run to completion in a
+ * trial run as well, leaving little for the trial run to gain. Of all such solutions, the one with
+ * the lowest bound wins. Returns boost::none if the choice must be left to a trial run.
+ */
+boost::optional<size_t> pickPlanWithoutTrialRun(
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions, size_t maxExamined);
+
+/**
+ * Returns true if some index intersection in the tree rooted at 'root' is estimated to cost more
+ * than its cheapest index scan alone would, with every document the scan finds fetched, in a
+ * collection of 'numRecords' documents. Fetching a document is taken to cost as much as examining
+ * 'fetchCost' index keys, and the predicates of the intersected scans are taken to be independent.
+ * Intersections of index scans without an estimated number of keys examined are not costly, as
+ * nothing is known about them.
+ */
+bool hasCostlyIndexIntersection(const QuerySolutionNode* root,
+                                long long numRecords,
+                                double fetchCost);
+
+/**
+ * Sets the estimated number of keys examined of every index scan in the tree rooted at 'root'
+ * whose index has statistics in 'stats', for a collection of 'numRecords' documents. The estimate
+ * only accounts for the bounds of the leading field of the index.
+ */
+void annotateEstimatedKeys(QuerySolutionNode* root,
+                           const CollectionIndexStatistics& stats,
+                           long long numRecords);
+
+}  // namespace mongo::plan_cost_estimator
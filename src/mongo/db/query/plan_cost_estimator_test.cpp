@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cost_estimator.h"
+
+#include "mongo/db/query/index_entry.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+IndexEntry buildIndexEntry(const BSONObj& kp, bool unique) {
+    return {kp,
+            IndexNames::nameToType(IndexNames::findPluginName(kp)),
+            false,
+            {},
+            {},
+            false,
+            unique,
+            CoreIndexInfo::Identifier("test_foo"),
+            nullptr,
+            {},
+            nullptr,
+            nullptr};
+}
+
+/**
+ * Makes a FETCH over an IXSCAN of the index {a: 1} with one point interval for each of 'points'.
+ */
+std::unique_ptr<QuerySolution> makePointLookup(const std::vector<int>& points, bool unique) {
+    auto ixn = std::make_unique<IndexScanNode>(buildIndexEntry(BSON("a" << 1), unique));
+    OrderedIntervalList oil("a");
+    for (auto point : points) {
+        oil.intervals.push_back(Interval(BSON("" << point << "" << point), true, true));
+    }
+    ixn->bounds.fields.push_back(oil);
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->children.push_back(ixn.release());
+
+    auto solution = std::make_unique<QuerySolution>();
+    solution->setRoot(std::move(fetch));
+    return solution;
+}
+
+std::unique_ptr<QuerySolution> makeCollScan() {
+    auto solution = std::make_unique<QuerySolution>();
+    solution->setRoot(std::make_unique<CollectionScanNode>());
+    return solution;
+}
+
+TEST(PlanCostEstimatorTest, UniquePointLookupIsBounded) {
+    auto solution = makePointLookup({1, 2, 3}, true);
+    auto bound = plan_cost_estimator::estimateCostBound(solution->root());
+    ASSERT(bound);
+    // Three keys plus three fetched documents.
+    ASSERT_EQ(bound->examined, 6);
+    ASSERT_EQ(bound->results, 3);
+}
+
+TEST(PlanCostEstimatorTest, NonUniquePointLookupIsNotBounded) {
+    auto solution = makePointLookup({1}, false);
+    ASSERT_FALSE(plan_cost_estimator::estimateCostBound(solution->root()));
+}
+
+TEST(PlanCostEstimatorTest, UniqueRangeScanIsNotBounded) {
+    auto solution = makePointLookup({1}, true);
+    auto ixn = static_cast<IndexScanNode*>(solution->root()->children[0]);
+    ixn->bounds.fields[0].intervals[0] = Interval(BSON("" << 1 << "" << 5), true, true);
+    ASSERT_FALSE(plan_cost_estimator::estimateCostBound(solution->root()));
+}
+
+TEST(PlanCostEstimatorTest, CollScanIsNotBounded) {
+    auto solution = makeCollScan();
+    ASSERT_FALSE(plan_cost_estimator::estimateCostBound(solution->root()));
+}
+
+TEST(PlanCostEstimatorTest, PicksCheapestBoundedPlan) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeCollScan());
+    solutions.push_back(makePointLookup({1, 2, 3}, true));
+    solutions.push_back(makePointLookup({1}, true));
+    solutions.push_back(makePointLookup({1}, false));
+
+    auto winner = plan_cost_estimator::pickPlanWithoutTrialRun(solutions, 100);
+    ASSERT(winner);
+    ASSERT_EQ(*winner, 2U);
+}
+
+TEST(PlanCostEstimatorTest, LeavesChoiceToTrialRunAboveThreshold) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(makeCollScan());
+    solutions.push_back(makePointLookup({1, 2, 3}, true));
+
+    ASSERT_FALSE(plan_cost_estimator::pickPlanWithoutTrialRun(solutions, 5));
+    ASSERT_FALSE(plan_cost_estimator::pickPlanWithoutTrialRun(solutions, 0));
+}
+
+/**
+ * Makes an AND_SORTED of IXSCANs of the indexes {a: 1}, {b: 1}, ... with the given estimated
+ * numbers of keys examined.
+ */
+std::unique_ptr<QuerySolution> makeIntersection(
+    const std::vector<boost::optional<double>>& estimatedKeys) {
+    auto andNode = std::make_unique<AndSortedNode>();
+    char field = 'a';
+    for (auto&& keys : estimatedKeys) {
+        auto ixn = std::make_unique<IndexScanNode>(
+            buildIndexEntry(BSON(std::string(1, field++) << 1), false));
+        ixn->estimatedKeysExamined = keys;
+        andNode->children.push_back(ixn.release());
+    }
+
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->children.push_back(andNode.release());
+
+    auto solution = std::make_unique<QuerySolution>();
+    solution->setRoot(std::move(fetch));
+    return solution;
+}
+
+TEST(PlanCostEstimatorTest, IntersectionOfSelectiveScansIsNotCostly) {
+    auto solution = makeIntersection({1000.0, 2000.0});
+    ASSERT_FALSE(plan_cost_estimator::hasCostlyIndexIntersection(solution->root(), 1000000, 4));
+}
+
+TEST(PlanCostEstimatorTest, IntersectionWithUnselectiveScanIsCostly) {
+    // Scanning the keys of the second index costs more than fetching the documents of the first.
+    auto solution = makeIntersection({1000.0, 500000.0});
+    ASSERT_TRUE(plan_cost_estimator::hasCostlyIndexIntersection(solution->root(), 1000000, 4));
+}
+
+TEST(PlanCostEstimatorTest, IntersectionWithoutEstimatesIsNotCostly) {
+    auto solution = makeIntersection({1000.0, boost::none});
+    ASSERT_FALSE(plan_cost_estimator::hasCostlyIndexIntersection(solution->root(), 1000000, 4));
+    ASSERT_FALSE(plan_cost_estimator::hasCostlyIndexIntersection(makeCollScan()->root(), 1000, 4));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -50,6 +50,7 @@
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/storage/clustered_id.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/transitional_tools_do_not_use/vector_spooling.h"
 
@@ -206,6 +207,53 @@ bool isOplogTsLowerBoundPred(const mongo::MatchExpression* me) {
 
     return me->path() == repl::OpTime::kTimestampFieldName;
 }
+
+/**
+ * Returns the RecordId of the document of a clustered collection which 'me' matches by _id
+ * equality, either at the top level or inside a top-level $and, or boost::none if there is no such
+ * predicate.
+ */
+boost::optional<RecordId> extractClusteredRecordId(const MatchExpression* me,
+                                                   bool topLevel = true) {
+    if (me->matchType() == MatchExpression::AND && topLevel) {
+        for (size_t i = 0; i < me->numChildren(); ++i) {
+            if (auto recordId = extractClusteredRecordId(me->getChild(i), false)) {
+                return recordId;
+            }
+        }
+        return boost::none;
+    }
+
+    if (me->matchType() != MatchExpression::EQ || me->path() != "_id") {
+        return boost::none;
+    }
+
+    auto recordId =
+        clustered_id::keyForId(static_cast<const ComparisonMatchExpression*>(me)->getData());
+    if (!recordId.isOK()) {
+        return boost::none;
+    }
+    return recordId.getValue();
+}
+
+/**
+ * Returns true if 'pred' is a leaf predicate whose index bounds contain every key of a matching
+ * document, so that it can bound one field of an index skip scan.
+ */
+bool isSkipScanPredicate(const MatchExpression* pred) {
+    switch (pred->matchType()) {
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return true;
+        case MatchExpression::MATCH_IN:
+            return static_cast<const InMatchExpression*>(pred)->getRegexes().empty();
+        default:
+            return false;
+    }
+}
 }  // namespace
 
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
@@ -256,6 +304,16 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         }
     }
 
+    // The records of a clustered collection are keyed by _id, so a scan for one _id only needs to
+    // look at the record with its RecordId. The filter is kept to check the rest of the query.
+    if ((params.options & QueryPlannerParams::COLLECTION_IS_CLUSTERED) && !tailable &&
+        resumeAfterObj.isEmpty()) {
+        if (auto recordId = extractClusteredRecordId(query.root())) {
+            csn->minRecord = recordId;
+            csn->maxRecord = recordId;
+        }
+    }
+
     return csn;
 }
 
@@ -1371,6 +1429,70 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::scanWholeIndex(
     return solnRoot;
 }
 
+std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::skipScanIndex(
+    const IndexEntry& index, const CanonicalQuery& query, const QueryPlannerParams& params) {
+    // Intersecting the bounds of several predicates on one field, and compounding the bounds of
+    // different fields, is only correct when each document has a single key in the index.
+    invariant(index.type == INDEX_BTREE && !index.multikey);
+
+    std::vector<const MatchExpression*> predicates;
+    const MatchExpression* root = query.root();
+    if (MatchExpression::AND == root->matchType()) {
+        for (size_t i = 0; i < root->numChildren(); ++i) {
+            predicates.push_back(root->getChild(i));
+        }
+    } else {
+        predicates.push_back(root);
+    }
+
+    auto isn = std::make_unique<IndexScanNode>(index);
+    isn->addKeyMetadata = query.metadataDeps()[DocumentMetadataFields::kIndexKey];
+    isn->queryCollator = query.getCollator();
+
+    // Fields without a predicate, including the leading one, get [MinKey, MaxKey] bounds. The
+    // scan's bounds checker turns those into a seek past the current value whenever a key falls
+    // outside the bounds of a later field.
+    bool hasBoundedField = false;
+    size_t position = 0;
+    for (auto&& keyElt : index.keyPattern) {
+        OrderedIntervalList oil;
+        bool translated = false;
+        for (auto&& pred : predicates) {
+            if (pred->path() != keyElt.fieldNameStringData() || !isSkipScanPredicate(pred)) {
+                continue;
+            }
+            if (0 == position) {
+                // The regular planner already handles a predicate on the leading field.
+                return nullptr;
+            }
+            IndexBoundsBuilder::BoundsTightness tightness;
+            if (translated) {
+                IndexBoundsBuilder::translateAndIntersect(pred, keyElt, index, &oil, &tightness);
+            } else {
+                IndexBoundsBuilder::translate(pred, keyElt, index, &oil, &tightness);
+                translated = true;
+            }
+        }
+        if (!translated) {
+            IndexBoundsBuilder::allValuesForField(keyElt, &oil);
+        }
+        hasBoundedField = hasBoundedField || translated;
+        isn->bounds.fields.push_back(std::move(oil));
+        ++position;
+    }
+
+    if (!hasBoundedField) {
+        return nullptr;
+    }
+    IndexBoundsBuilder::alignBounds(&isn->bounds, index.keyPattern);
+
+    // The bounds may be inexact, so the fetched documents are filtered by the whole query.
+    auto fetch = std::make_unique<FetchNode>();
+    fetch->filter = query.root()->shallowClone();
+    fetch->children.push_back(isn.release());
+    return fetch;
+}
+
 void QueryPlannerAccess::addFilterToSolutionNode(QuerySolutionNode* node,
                                                  MatchExpression* match,
                                                  MatchExpression::MatchType type) {
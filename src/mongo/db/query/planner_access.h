@@ -110,6 +110,18 @@ public:
                                                              const QueryPlannerParams& params,
                                                              int direction = 1);
 
+    /**
+     * Return a plan that scans 'index' with bounds built from the predicates of 'query' on its
+     * non-leading fields, for a query without a predicate on the leading field. The scan seeks
+     * from each distinct leading value to the next instead of examining every key in between.
+     *
+     * The index must be a non-multikey btree index. Returns nullptr if 'query' has a predicate on
+     * the leading field or none on a later field that can be translated into index bounds.
+     */
+    static std::unique_ptr<QuerySolutionNode> skipScanIndex(const IndexEntry& index,
+                                                            const CanonicalQuery& query,
+                                                            const QueryPlannerParams& params);
+
     /**
      * Return a plan that scans the provided index from [startKey to endKey).
      */
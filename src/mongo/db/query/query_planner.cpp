@@ -52,6 +52,7 @@
 #include "mongo/db/query/planner_access.h"
 #include "mongo/db/query/planner_analysis.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/logv2/log.h"
@@ -334,6 +335,29 @@ std::unique_ptr<QuerySolution> buildWholeIXSoln(const IndexEntry& index,
     return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
 }
 
+/**
+ * Returns true if 'index' can answer 'query' with a skip scan: each document must have exactly one
+ * key in the index, which must also agree with the query on string comparison.
+ */
+bool canSkipScanIndex(const IndexEntry& index, const CanonicalQuery& query) {
+    if (index.type != INDEX_BTREE || index.multikey || index.sparse ||
+        index.keyPattern.nFields() < 2 ||
+        !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
+        return false;
+    }
+    return !index.filterExpr || expression::isSubsetOf(query.root(), index.filterExpr);
+}
+
+std::unique_ptr<QuerySolution> buildSkipScanSoln(const IndexEntry& index,
+                                                 const CanonicalQuery& query,
+                                                 const QueryPlannerParams& params) {
+    auto solnRoot = QueryPlannerAccess::skipScanIndex(index, query, params);
+    if (!solnRoot) {
+        return nullptr;
+    }
+    return QueryPlannerAnalysis::analyzeDataAccess(query, params, std::move(solnRoot));
+}
+
 bool providesSort(const CanonicalQuery& query, const BSONObj& kp) {
     return query.getQueryRequest().getSort().isPrefixOf(kp, SimpleBSONElementComparator::kInstance);
 }
@@ -503,6 +527,15 @@ StatusWith<std::unique_ptr<QuerySolution>> QueryPlanner::planFromCache(
         } else {
             return {std::move(soln)};
         }
+    } else if (SolutionCacheData::SKIP_SCAN_SOLN == winnerCacheData.solnType) {
+        // The bounds of a skip scan are rebuilt from the predicates of this query.
+        auto soln = buildSkipScanSoln(*winnerCacheData.tree->entry, query, params);
+        if (!soln) {
+            return Status(ErrorCodes::NoQueryExecutionPlans,
+                          "plan cache error: index skip scan soln");
+        } else {
+            return {std::move(soln)};
+        }
     } else if (SolutionCacheData::COLLSCAN_SOLN == winnerCacheData.solnType) {
         // The cached solution is a collection scan. We don't cache collscans
         // with tailable==true, hence the false below.
@@ -1056,7 +1089,11 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
 
         const auto* indicesToConsider = hintedIndex.isEmpty() ? &fullIndexList : &relevantIndices;
         for (auto&& index : *indicesToConsider) {
-            if (index.type != INDEX_BTREE || index.multikey || index.sparse || index.filterExpr ||
+            // A multikey index can still cover the projection if its path-level multikey metadata
+            // shows that none of the projected fields are arrays. The analysis below will add a
+            // FETCH otherwise, and the resulting solution is rejected as not covered.
+            if (index.type != INDEX_BTREE || (index.multikey && index.multikeyPaths.empty()) ||
+                index.sparse || index.filterExpr ||
                 !CollatorInterface::collatorsMatch(index.collator, query.getCollator())) {
                 continue;
             }
@@ -1081,8 +1118,44 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         }
     }
 
+    // If no index has a predicate on its leading field, an index with predicates on its later
+    // fields can still be scanned by seeking from one leading value to the next. Whether that
+    // beats a collection scan depends on the number of distinct leading values, so the skip scans
+    // are raced against the collscan below.
+    bool skipScanAdded = false;
+    if (internalQueryPlannerEnableIndexSkipScan.load() && out.size() == 0 &&
+        hintedIndex.isEmpty() &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::TEXT) &&
+        !QueryPlannerCommon::hasNode(query.root(), MatchExpression::GEO_NEAR)) {
+        for (auto&& index : fullIndexList) {
+            if (!canSkipScanIndex(index, query)) {
+                continue;
+            }
+            auto soln = buildSkipScanSoln(index, query, params);
+            if (!soln) {
+                continue;
+            }
+            LOGV2_DEBUG(5191250,
+                        5,
+                        "Planner: outputting an index skip scan",
+                        "index"_attr = index.identifier.catalogName,
+                        "solution"_attr = redact(soln->toString()));
+            PlanCacheIndexTree* indexTree = new PlanCacheIndexTree();
+            indexTree->setIndexEntry(index);
+
+            SolutionCacheData* scd = new SolutionCacheData();
+            scd->tree.reset(indexTree);
+            scd->solnType = SolutionCacheData::SKIP_SCAN_SOLN;
+            soln->cacheData.reset(scd);
+
+            out.push_back(std::move(soln));
+            skipScanAdded = true;
+        }
+    }
+
     // The caller can explicitly ask for a collscan.
-    bool collscanRequested = (params.options & QueryPlannerParams::INCLUDE_COLLSCAN);
+    bool collscanRequested =
+        (params.options & QueryPlannerParams::INCLUDE_COLLSCAN) || skipScanAdded;
 
     // No indexed plans?  We must provide a collscan if possible or else we can't run the query.
     bool collScanRequired = 0 == out.size();
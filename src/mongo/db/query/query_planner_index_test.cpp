@@ -1191,6 +1191,29 @@ TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfIndexIsMultikey)
         "{cscan: {dir: 1}}}}");
 }
 
+TEST_F(QueryPlannerTest,
+       EmptyQueryWithProjectionUsesCoveredIxscanIfProjectedFieldsOfMultikeyIndexAreNotArrays) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1), MultikeyPaths{MultikeyComponents{}, {0U}});
+    runQueryAsCommand(fromjson("{find: 'testns', projection: {_id: 0, a: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: "
+        "{ixscan: {filter: null, pattern: {a: 1, b: 1},"
+        "bounds: {a: [['MinKey', 'MaxKey', true, true]],"
+        "b: [['MinKey', 'MaxKey', true, true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfProjectedFieldOfIndexIsMultikey) {
+    params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
+    addIndex(BSON("a" << 1 << "b" << 1), MultikeyPaths{MultikeyComponents{}, {0U}});
+    runQueryAsCommand(fromjson("{find: 'testns', projection: {_id: 0, a: 1, b: 1}}"));
+    assertNumSolutions(1);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1, b: 1}, node: "
+        "{cscan: {dir: 1}}}}");
+}
+
 TEST_F(QueryPlannerTest, EmptyQueryWithProjectionUsesCollscanIfIndexIsSparse) {
     params.options = QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     constexpr bool isMultikey = false;
@@ -1426,5 +1449,45 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanRacesCollscanWhenLeadingFieldIsUnconstrained) {
+    bool oldEnableIndexSkipScan = internalQueryPlannerEnableIndexSkipScan.load();
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+
+    runQuery(fromjson("{b: 5, c: {$gt: 1, $lte: 3}}"));
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5, c: {$gt: 1, $lte: 3}}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: 5, c: {$gt: 1, $lte: 3}}, node: {ixscan: {pattern: {a: 1, b: 1, c: "
+        "1}, bounds: {a: [['MinKey','MaxKey',true,true]], b: [[5,5,true,true]], "
+        "c: [[1,3,false,true]]}}}}}");
+
+    internalQueryPlannerEnableIndexSkipScan.store(oldEnableIndexSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsNotGeneratedForMultikeyIndex) {
+    bool oldEnableIndexSkipScan = internalQueryPlannerEnableIndexSkipScan.load();
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+
+    runQuery(fromjson("{b: 5}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+
+    internalQueryPlannerEnableIndexSkipScan.store(oldEnableIndexSkipScan);
+}
+
+TEST_F(QueryPlannerTest, SkipScanIsNotGeneratedWithoutPredicateOnLaterField) {
+    bool oldEnableIndexSkipScan = internalQueryPlannerEnableIndexSkipScan.load();
+    internalQueryPlannerEnableIndexSkipScan.store(true);
+    addIndex(BSON("a" << 1 << "b" << 1));
+
+    runQuery(fromjson("{c: 5, b: /^x/}"));
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {c: 5, b: /^x/}}}");
+
+    internalQueryPlannerEnableIndexSkipScan.store(oldEnableIndexSkipScan);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -118,6 +118,10 @@ struct QueryPlannerParams {
         // is thought to be helpful in general, but particularly in cases where all children of the
         // $or use the same fields and have the same indexes available, as in this example.
         ENUMERATE_OR_CHILDREN_LOCKSTEP = 1 << 12,
+
+        // Set this if the records of the collection are keyed by _id, so that a collection scan can
+        // be bounded by the RecordIds of the _id values that the query matches.
+        COLLECTION_IS_CLUSTERED = 1 << 13,
     };
 
     // See Options enum above.
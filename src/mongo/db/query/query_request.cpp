@@ -989,11 +989,6 @@ StatusWith<BSONObj> QueryRequest::asAggregationCommand() const {
                 str::stream() << "Option " << kSingleBatchField
                               << " not supported in aggregation."};
     }
-    if (_readOnce) {
-        return {ErrorCodes::InvalidPipelineOperator,
-                str::stream() << "Option " << kReadOnceField << " not supported in aggregation."};
-    }
-
     if (_allowSpeculativeMajorityRead) {
         return {ErrorCodes::InvalidPipelineOperator,
                 str::stream() << "Option " << kAllowSpeculativeMajorityReadField
@@ -1068,6 +1063,9 @@ StatusWith<BSONObj> QueryRequest::asAggregationCommand() const {
     if (_allowDiskUse) {
         aggregationBuilder.append(QueryRequest::kAllowDiskUseField, _allowDiskUse);
     }
+    if (_readOnce) {
+        aggregationBuilder.append(kReadOnceField, _readOnce);
+    }
     if (_runtimeConstants) {
         BSONObjBuilder rtcBuilder(aggregationBuilder.subobjStart(kRuntimeConstantsField));
         _runtimeConstants->serialize(&rtcBuilder);
@@ -1486,11 +1486,15 @@ TEST(QueryRequestTest, ConvertToAggregationWithCollationSucceeds) {
     ASSERT_BSONOBJ_EQ(ar.getValue().getCollation(), BSON("f" << 1));
 }
 
-TEST(QueryRequestTest, ConvertToAggregationWithReadOnceFails) {
+TEST(QueryRequestTest, ConvertToAggregationWithReadOnceSucceeds) {
     QueryRequest qr(testns);
     qr.setReadOnce(true);
     const auto aggCmd = qr.asAggregationCommand();
-    ASSERT_EQ(ErrorCodes::InvalidPipelineOperator, aggCmd.getStatus().code());
+    ASSERT_OK(aggCmd.getStatus());
+
+    auto ar = AggregationRequest::parseFromBSON(testns, aggCmd.getValue());
+    ASSERT_OK(ar.getStatus());
+    ASSERT_TRUE(ar.getValue().isReadOnce());
 }
 
 TEST(QueryRequestTest, ConvertToAggregationWithAllowSpeculativeMajorityReadFails) {
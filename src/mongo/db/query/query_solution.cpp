@@ -212,6 +212,11 @@ void CollectionScanNode::appendToString(str::stream* ss, int indent) const {
     *ss << "COLLSCAN\n";
     addIndent(ss, indent + 1);
     *ss << "ns = " << name << '\n';
+    if (minRecord || maxRecord) {
+        addIndent(ss, indent + 1);
+        *ss << "records = [" << (minRecord ? std::to_string(minRecord->repr()) : "") << ", "
+            << (maxRecord ? std::to_string(maxRecord->repr()) : "") << "]\n";
+    }
     if (nullptr != filter) {
         addIndent(ss, indent + 1);
         *ss << "filter = " << filter->debugString();
@@ -229,6 +234,8 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->shouldTrackLatestOplogTimestamp = this->shouldTrackLatestOplogTimestamp;
     copy->assertMinTsHasNotFallenOffOplog = this->assertMinTsHasNotFallenOffOplog;
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
+    copy->minRecord = this->minRecord;
+    copy->maxRecord = this->maxRecord;
 
     return copy;
 }
@@ -498,6 +505,10 @@ void IndexScanNode::appendToString(str::stream* ss, int indent) const {
     *ss << "direction = " << direction << '\n';
     addIndent(ss, indent + 1);
     *ss << "bounds = " << bounds.toString() << '\n';
+    if (estimatedKeysExamined) {
+        addIndent(ss, indent + 1);
+        *ss << "estimatedKeysExamined = " << *estimatedKeysExamined << '\n';
+    }
     addCommon(ss, indent);
 }
 
@@ -916,6 +927,7 @@ QuerySolutionNode* IndexScanNode::clone() const {
     copy->addKeyMetadata = this->addKeyMetadata;
     copy->bounds = this->bounds;
     copy->queryCollator = this->queryCollator;
+    copy->estimatedKeysExamined = this->estimatedKeysExamined;
 
     return copy;
 }
@@ -464,6 +464,12 @@ struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
     // This field cannot be used in conjunction with 'minTs' or 'maxTs'.
     boost::optional<RecordId> resumeAfterRecordId;
 
+    // If present, the collection scan only returns the records whose RecordIds are at least
+    // 'minRecord' and at most 'maxRecord'. Should only be set on scans of clustered collections.
+    // These fields cannot be used in conjunction with 'resumeAfterRecordId'.
+    boost::optional<RecordId> minRecord;
+    boost::optional<RecordId> maxRecord;
+
     // Should we make a tailable cursor?
     bool tailable;
 
@@ -651,6 +657,10 @@ struct IndexScanNode : public QuerySolutionNodeWithSortSet {
     //
     // The correct set of paths is computed and stored here by computeProperties().
     std::set<StringData> multikeyFields;
+
+    // The number of keys the scan is expected to examine according to the statistics of the
+    // index, if the index has any.
+    boost::optional<double> estimatedKeysExamined;
 };
 
 struct ReturnKeyNode : public QuerySolutionNode {
@@ -35,9 +35,11 @@
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/exec/sbe/stages/limit_skip.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/exec/sbe/stages/makeobj.h"
+#include "mongo/db/exec/sbe/stages/merge_join.h"
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/sort.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
@@ -106,6 +109,7 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildIndexScan(
                                            _returnKeySlot,
                                            &_slotIdGenerator,
                                            &_spoolIdGenerator,
+                                           _data.env,
                                            _yieldPolicy,
                                            _data.trialRunProgressTracker.get());
     _data.recordIdSlot = slot;
@@ -141,6 +145,22 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::makeLoopJoinForFetch(
         nullptr);
 }
 
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::makeDedupStage(
+    std::unique_ptr<sbe::PlanStage> inputStage, sbe::value::SlotId dedupSlot) {
+    // Deduplication has no aggregates to merge, so the hash table can always be spilled. Without
+    // disk use the hash table is not limited in size, just like in the classic engine.
+    const bool allowDiskUse = _cq.getExpCtx()->allowDiskUse;
+    return sbe::makeS<sbe::HashAggStage>(
+        std::move(inputStage),
+        sbe::makeSV(dedupSlot),
+        sbe::makeEM(),
+        sbe::makeEM(),
+        allowDiskUse
+            ? static_cast<size_t>(internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.load())
+            : std::numeric_limits<size_t>::max(),
+        allowDiskUse);
+}
+
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildFetch(const QuerySolutionNode* root) {
     auto fn = static_cast<const FetchNode*>(root);
     auto inputStage = build(fn->children[0]);
@@ -372,8 +392,7 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildOr(const QuerySoluti
                                              sbe::makeSV(*_data.resultSlot, *_data.recordIdSlot));
 
     if (orn->dedup) {
-        stage = sbe::makeS<sbe::HashAggStage>(
-            std::move(stage), sbe::makeSV(*_data.recordIdSlot), sbe::makeEM());
+        stage = makeDedupStage(std::move(stage), *_data.recordIdSlot);
     }
 
     if (orn->filter) {
@@ -391,6 +410,98 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildOr(const QuerySoluti
     return stage;
 }
 
+namespace {
+/**
+ * Returns the estimated number of RecordIds produced by the child 'node' of an index intersection,
+ * or infinity if there is no estimate.
+ */
+double estimateIntersectedRecordIds(const QuerySolutionNode* node) {
+    if (node->getType() == STAGE_IXSCAN) {
+        if (auto keys = static_cast<const IndexScanNode*>(node)->estimatedKeysExamined) {
+            return *keys;
+        }
+    }
+    return std::numeric_limits<double>::infinity();
+}
+}  // namespace
+
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::makeIndexIntersection(
+    const QuerySolutionNode* root,
+    const std::vector<const QuerySolutionNode*>& children,
+    bool sortedByRecordId) {
+    uassert(5190160, "Index intersections with a filter are not supported in SBE", !root->filter);
+    invariant(children.size() >= 2);
+
+    auto buildChild = [&](const QuerySolutionNode* child) {
+        uassert(5190161,
+                "Index intersections of fetched children are not supported in SBE",
+                !child->fetched());
+        auto stage = build(child);
+        uassert(5190162, "RecordId slot is not defined", _data.recordIdSlot);
+        return std::make_pair(std::move(stage), *_data.recordIdSlot);
+    };
+
+    // Like deduplication, the hash tables of the joins can always be spilled to disk if disk use
+    // is allowed.
+    const bool allowDiskUse = _cq.getExpCtx()->allowDiskUse;
+    const auto memoryLimit = allowDiskUse
+        ? static_cast<size_t>(internalQuerySlotBasedExecutionHashAggMaxMemoryUsageBytes.load())
+        : std::numeric_limits<size_t>::max();
+
+    // Each join intersects the RecordIds of the children preceding it with those of its inner
+    // child, and produces them in the order of the inner child.
+    auto [stage, recordIdSlot] = buildChild(children[0]);
+    for (size_t i = 1; i < children.size(); ++i) {
+        auto [innerStage, innerRecordIdSlot] = buildChild(children[i]);
+        if (sortedByRecordId) {
+            stage = sbe::makeS<sbe::MergeJoinStage>(
+                std::move(stage),
+                std::move(innerStage),
+                sbe::makeSV(recordIdSlot),
+                sbe::makeSV(),
+                sbe::makeSV(innerRecordIdSlot),
+                std::vector<sbe::value::SortDirection>{sbe::value::SortDirection::Ascending});
+        } else {
+            stage = sbe::makeS<sbe::HashJoinStage>(std::move(stage),
+                                                   std::move(innerStage),
+                                                   sbe::makeSV(recordIdSlot),
+                                                   sbe::makeSV(),
+                                                   sbe::makeSV(innerRecordIdSlot),
+                                                   sbe::makeSV(),
+                                                   memoryLimit,
+                                                   allowDiskUse);
+        }
+        recordIdSlot = innerRecordIdSlot;
+    }
+
+    _data.recordIdSlot = recordIdSlot;
+    return std::move(stage);
+}
+
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildAndHash(
+    const QuerySolutionNode* root) {
+    // The AND_HASH provides the sort order of its last child, so that child must be the one probing
+    // the hash tables. The others are loaded starting with the one which produces the fewest
+    // RecordIds, to keep the hash tables of the following joins small.
+    std::vector<const QuerySolutionNode*> children{root->children.begin(), root->children.end()};
+    std::stable_sort(children.begin(), children.end() - 1, [](auto lhs, auto rhs) {
+        return estimateIntersectedRecordIds(lhs) < estimateIntersectedRecordIds(rhs);
+    });
+    return makeIndexIntersection(root, children, false);
+}
+
+std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildAndSorted(
+    const QuerySolutionNode* root) {
+    // All children produce their RecordIds in order, so the order of the joins does not matter for
+    // the result. Starting with the child which produces the fewest RecordIds lets the chain of
+    // merge joins stop as soon as that child is exhausted.
+    std::vector<const QuerySolutionNode*> children{root->children.begin(), root->children.end()};
+    std::stable_sort(children.begin(), children.end(), [](auto lhs, auto rhs) {
+        return estimateIntersectedRecordIds(lhs) < estimateIntersectedRecordIds(rhs);
+    });
+    return makeIndexIntersection(root, children, true);
+}
+
 std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildText(const QuerySolutionNode* root) {
     auto textNode = static_cast<const TextNode*>(root);
 
@@ -461,8 +572,7 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::buildText(const QuerySolu
     // TODO: If text score metadata is requested, then we should sum over the text scores inside the
     // index keys for a given document. This will require expression evaluation to be able to
     // extract the score directly from the key string.
-    auto hashAggStage = sbe::makeS<sbe::HashAggStage>(
-        std::move(unionStage), sbe::makeSV(*_data.recordIdSlot), sbe::makeEM());
+    auto hashAggStage = makeDedupStage(std::move(unionStage), *_data.recordIdSlot);
 
     auto nljStage = makeLoopJoinForFetch(std::move(hashAggStage), *_data.recordIdSlot);
 
@@ -602,6 +712,8 @@ std::unique_ptr<sbe::PlanStage> SlotBasedStageBuilder::build(const QuerySolution
             {STAGE_PROJECTION_SIMPLE, std::mem_fn(&SlotBasedStageBuilder::buildProjectionSimple)},
             {STAGE_PROJECTION_DEFAULT, std::mem_fn(&SlotBasedStageBuilder::buildProjectionDefault)},
             {STAGE_OR, &SlotBasedStageBuilder::buildOr},
+            {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHash},
+            {STAGE_AND_SORTED, &SlotBasedStageBuilder::buildAndSorted},
             {STAGE_TEXT, &SlotBasedStageBuilder::buildText},
             {STAGE_RETURN_KEY, &SlotBasedStageBuilder::buildReturnKey}};
 
@@ -120,6 +120,8 @@ private:
     std::unique_ptr<sbe::PlanStage> buildProjectionSimple(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildProjectionDefault(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildOr(const QuerySolutionNode* root);
+    std::unique_ptr<sbe::PlanStage> buildAndHash(const QuerySolutionNode* root);
+    std::unique_ptr<sbe::PlanStage> buildAndSorted(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildText(const QuerySolutionNode* root);
     std::unique_ptr<sbe::PlanStage> buildReturnKey(const QuerySolutionNode* root);
 
@@ -128,8 +130,29 @@ private:
         sbe::value::SlotId recordIdKeySlot,
         const sbe::value::SlotVector& slotsToForward = {});
 
+    /**
+     * Constructs a hash aggregation stage which removes the rows with duplicate values of
+     * 'dedupSlot'. If disk use is allowed, the hash table of the stage is limited in size and is
+     * spilled to disk once the limit is exceeded.
+     */
+    std::unique_ptr<sbe::PlanStage> makeDedupStage(std::unique_ptr<sbe::PlanStage> inputStage,
+                                                   sbe::value::SlotId dedupSlot);
+
     std::unique_ptr<sbe::PlanStage> makeUnionForTailableCollScan(const QuerySolutionNode* root);
 
+    /**
+     * Constructs an intersection of the RecordIds produced by the 'children' of the index
+     * intersection node 'root', out of a chain of joins on RecordId, which produces the
+     * intersection in the order of the last child. If 'sortedByRecordId' is true, every child
+     * produces its RecordIds in ascending order, and the children are merge joined in constant
+     * memory. Otherwise the RecordIds of all children but the last are loaded into the hash tables
+     * of hash joins.
+     */
+    std::unique_ptr<sbe::PlanStage> makeIndexIntersection(
+        const QuerySolutionNode* root,
+        const std::vector<const QuerySolutionNode*>& children,
+        bool sortedByRecordId);
+
     sbe::value::SlotIdGenerator _slotIdGenerator;
     sbe::value::FrameIdGenerator _frameIdGenerator;
     sbe::value::SpoolIdGenerator _spoolIdGenerator;
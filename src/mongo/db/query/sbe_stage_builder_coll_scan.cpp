@@ -42,6 +42,7 @@
 #include "mongo/db/exec/sbe/stages/project.h"
 #include "mongo/db/exec/sbe/stages/scan.h"
 #include "mongo/db/exec/sbe/stages/union.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/storage/oplog_hack.h"
@@ -282,6 +283,81 @@ generateOptimizedOplogScan(OperationContext* opCtx,
             std::move(stage)};
 }
 
+/**
+ * Returns the number of threads a generic collection scan may use to scan RecordId ranges of the
+ * collection concurrently. Scans which must return records in their natural order, such as scans of
+ * capped collections, of the oplog or resumable scans, always run on the query's thread. So do
+ * scans running under a trial run tracker, as the tracker isn't thread-safe.
+ */
+size_t getNumParallelCollScanThreads(const Collection* collection,
+                                     const CollectionScanNode* csn,
+                                     bool isTailableResumeBranch,
+                                     TrialRunProgressTracker* tracker) {
+    const auto numThreads = internalQuerySlotBasedExecutionParallelCollScanThreads.load();
+    if (numThreads <= 1 || csn->direction != CollectionScanParams::FORWARD || csn->tailable ||
+        isTailableResumeBranch || csn->resumeAfterRecordId || csn->requestResumeToken ||
+        csn->shouldTrackLatestOplogTimestamp || csn->shouldWaitForOplogVisibility || tracker ||
+        collection->isCapped() || collection->ns().isOplog()) {
+        return 1;
+    }
+    return numThreads;
+}
+
+/**
+ * Generates a parallel collection scan sub-tree. The sub-tree below the exchange, a parallel scan
+ * with an optional filter on top of it, is cloned for each of the 'numThreads' producers. The
+ * producers pick RecordId ranges of the collection off a shared list and scan them concurrently,
+ * and the exchange hands the matching records over to the query's thread in no particular order.
+ */
+std::tuple<sbe::value::SlotId,
+           sbe::value::SlotId,
+           boost::optional<sbe::value::SlotId>,
+           std::unique_ptr<sbe::PlanStage>>
+generateParallelCollScan(OperationContext* opCtx,
+                         const Collection* collection,
+                         const CollectionScanNode* csn,
+                         size_t numThreads,
+                         sbe::value::SlotIdGenerator* slotIdGenerator,
+                         sbe::value::FrameIdGenerator* frameIdGenerator,
+                         sbe::RuntimeEnvironment* env) {
+    auto resultSlot = slotIdGenerator->generate();
+    auto recordIdSlot = slotIdGenerator->generate();
+
+    // The producers run on their own threads under their own operation contexts, so the range
+    // scans cannot be yielded through the query's yield policy.
+    NamespaceStringOrUUID nss{collection->ns().db().toString(), collection->uuid()};
+    std::unique_ptr<sbe::PlanStage> stage =
+        sbe::makeS<sbe::ParallelScanStage>(nss,
+                                           resultSlot,
+                                           recordIdSlot,
+                                           std::vector<std::string>{},
+                                           sbe::makeSV(),
+                                           nullptr);
+
+    // Apply the filter below the exchange, so that it is evaluated by the producers as well.
+    if (csn->filter) {
+        invariant(!csn->stopApplyingFilterAfterFirstMatch);
+
+        stage = generateFilter(opCtx,
+                               csn->filter.get(),
+                               std::move(stage),
+                               slotIdGenerator,
+                               frameIdGenerator,
+                               resultSlot,
+                               env,
+                               sbe::makeSV(resultSlot, recordIdSlot));
+    }
+
+    stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                              numThreads,
+                                              sbe::makeSV(resultSlot, recordIdSlot),
+                                              sbe::ExchangePolicy::roundrobin,
+                                              nullptr,
+                                              nullptr);
+
+    return {resultSlot, recordIdSlot, boost::none, std::move(stage)};
+}
+
 /**
  * Generates a generic collecion scan sub-tree. If a resume token has been provided, the scan will
  * start from a RecordId contained within this token, otherwise from the beginning of the
@@ -306,6 +382,13 @@ generateGenericCollScan(OperationContext* opCtx,
     invariant(!csn->resumeAfterRecordId || forward);
     invariant(!csn->resumeAfterRecordId || !csn->tailable);
 
+    if (auto numThreads =
+            getNumParallelCollScanThreads(collection, csn, isTailableResumeBranch, tracker);
+        numThreads > 1) {
+        return generateParallelCollScan(
+            opCtx, collection, csn, numThreads, slotIdGenerator, frameIdGenerator, env);
+    }
+
     auto resultSlot = slotIdGenerator->generate();
     auto recordIdSlot = slotIdGenerator->generate();
     auto seekRecordIdSlot = [&]() -> boost::optional<sbe::value::SlotId> {
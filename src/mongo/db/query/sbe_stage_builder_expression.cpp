@@ -563,6 +563,7 @@ public:
     void visit(ExpressionInternalFindPositional* expr) final {}
     void visit(ExpressionInternalFindElemMatch* expr) final {}
     void visit(ExpressionFunction* expr) final {}
+    void visit(ExpressionCommonSubexpression* expr) final {}
     void visit(ExpressionRandom* expr) final {}
     void visit(ExpressionToHashedIndexKey* expr) final {}
 
@@ -756,6 +757,7 @@ public:
     void visit(ExpressionInternalFindPositional* expr) final {}
     void visit(ExpressionInternalFindElemMatch* expr) final {}
     void visit(ExpressionFunction* expr) final {}
+    void visit(ExpressionCommonSubexpression* expr) final {}
     void visit(ExpressionRandom* expr) final {}
     void visit(ExpressionToHashedIndexKey* expr) final {}
 
@@ -1819,6 +1821,10 @@ public:
         unsupportedExpression("$function");
     }
 
+    void visit(ExpressionCommonSubexpression* expr) final {
+        unsupportedExpression("common subexpression");
+    }
+
     void visit(ExpressionRandom* expr) final {
         unsupportedExpression(expr->getOpName());
     }
@@ -45,6 +45,7 @@
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_expr_eq.h"
 #include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_parameterization.h"
 #include "mongo/db/matcher/expression_text.h"
 #include "mongo/db/matcher/expression_text_noop.h"
 #include "mongo/db/matcher/expression_tree.h"
@@ -92,6 +93,36 @@ std::unique_ptr<sbe::EExpression> makeFillEmptyFalse(std::unique_ptr<sbe::EExpre
         sbe::makeEs(std::move(e), sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Boolean, 0)));
 }
 
+/**
+ * Returns an owned SBE copy of the RHS of the comparison 'expr'.
+ */
+std::pair<sbe::value::TypeTags, sbe::value::Value> convertInputParam(
+    const ComparisonMatchExpressionBase& expr) {
+    const auto& rhs = expr.getData();
+    auto [tagView, valView] = sbe::bson::convertFrom(
+        true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
+    return sbe::value::copyValue(tagView, valView);
+}
+
+std::string makeInputParamSlotName(ComparisonMatchExpressionBase::InputParamId id) {
+    return str::stream() << "inputParam" << id;
+}
+
+/**
+ * Returns the runtime environment slot which holds the value of the input parameter 'expr',
+ * registering it if the tree has not used the parameter yet.
+ */
+sbe::value::SlotId registerInputParamSlot(sbe::RuntimeEnvironment* env,
+                                          const ComparisonMatchExpressionBase& expr,
+                                          sbe::value::SlotIdGenerator* slotIdGenerator) {
+    auto slotName = makeInputParamSlotName(*expr.getInputParamId());
+    if (auto slot = env->getSlotIfExists(slotName)) {
+        return *slot;
+    }
+    auto [tag, val] = convertInputParam(expr);
+    return env->registerSlot(slotName, tag, val, true, slotIdGenerator);
+}
+
 /**
  * EvalExpr is a wrapper around an EExpression that can also carry a SlotId.
  */
@@ -550,20 +581,23 @@ void generateComparison(MatchExpressionVisitorContext* context,
                         const ComparisonMatchExpression* expr,
                         sbe::EPrimBinary::Op binaryOp) {
     auto makePredicate =
-        [expr, binaryOp](sbe::value::SlotId inputSlot,
-                         std::unique_ptr<sbe::PlanStage> inputStage) -> MakePredicateReturnType {
-        const auto& rhs = expr->getData();
-        auto [tagView, valView] = sbe::bson::convertFrom(
-            true, rhs.rawdata(), rhs.rawdata() + rhs.size(), rhs.fieldNameSize() - 1);
-
-        // SBE EConstant assumes ownership of the value so we have to make a copy here.
-        auto [tag, val] = sbe::value::copyValue(tagView, valView);
-
-        return {
-            makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(binaryOp,
-                                                            sbe::makeE<sbe::EVariable>(inputSlot),
-                                                            sbe::makeE<sbe::EConstant>(tag, val))),
-            std::move(inputStage)};
+        [context, expr, binaryOp](
+            sbe::value::SlotId inputSlot,
+            std::unique_ptr<sbe::PlanStage> inputStage) -> MakePredicateReturnType {
+        // If the value is an input parameter of the query, read it from the runtime environment,
+        // so that the tree can be run again with a different value.
+        auto rhsExpr = [&]() -> std::unique_ptr<sbe::EExpression> {
+            if (expr->getInputParamId()) {
+                return sbe::makeE<sbe::EVariable>(
+                    registerInputParamSlot(context->env, *expr, context->slotIdGenerator));
+            }
+            auto [tag, val] = convertInputParam(*expr);
+            return sbe::makeE<sbe::EConstant>(tag, val);
+        }();
+
+        return {makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+                    binaryOp, sbe::makeE<sbe::EVariable>(inputSlot), std::move(rhsExpr))),
+                std::move(inputStage)};
     };
 
     generateTraverse(context, expr->path(), std::move(makePredicate));
@@ -1332,4 +1366,13 @@ std::unique_ptr<sbe::PlanStage> generateFilter(OperationContext* opCtx,
     tree_walker::walk<true, MatchExpression>(root, &walker);
     return context.done();
 }
+
+void bindInputParams(const MatchExpression& root, sbe::RuntimeEnvironment* env) {
+    for (auto&& param : expression_parameterization::getInputParams(root)) {
+        if (auto slot = env->getSlotIfExists(makeInputParamSlotName(*param->getInputParamId()))) {
+            auto [tag, val] = convertInputParam(*param);
+            env->resetSlot(*slot, tag, val, true);
+        }
+    }
+}
 }  // namespace mongo::stage_builder
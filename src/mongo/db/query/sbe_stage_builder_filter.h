@@ -51,4 +51,10 @@ std::unique_ptr<sbe::PlanStage> generateFilter(OperationContext* opCtx,
                                                sbe::RuntimeEnvironment* env,
                                                sbe::value::SlotVector relevantSlotsIn);
 
+/**
+ * Stores the values of the input parameters of 'root' (see expression_parameterization.h) in the
+ * slots of 'env' which the filters generated for a query of the same shape read them from.
+ */
+void bindInputParams(const MatchExpression& root, sbe::RuntimeEnvironment* env);
+
 }  // namespace mongo::stage_builder
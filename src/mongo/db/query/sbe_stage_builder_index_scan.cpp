@@ -241,6 +241,105 @@ makeIntervalsFromIndexBounds(const IndexBounds& bounds,
     return result;
 }
 
+std::string makeBoundsSlotName(StringData kind, const IndexScanNode* ixn) {
+    return str::stream() << "ixscan" << kind << ixn->nodeId();
+}
+
+/**
+ * Returns an expression producing the given bounds value of an index scan, and takes ownership of
+ * the value. If 'env' is provided, the value is stored in its slot 'slotName', so that the tree can
+ * be run again with the bounds of another query of the same shape (see bindIndexScanBounds()).
+ */
+std::unique_ptr<sbe::EExpression> makeBoundsExpr(sbe::RuntimeEnvironment* env,
+                                                 const std::string& slotName,
+                                                 sbe::value::TypeTags tag,
+                                                 sbe::value::Value val,
+                                                 sbe::value::SlotIdGenerator* slotIdGenerator) {
+    if (env && !env->getSlotIfExists(slotName)) {
+        return sbe::makeE<sbe::EVariable>(
+            env->registerSlot(slotName, tag, val, true, slotIdGenerator));
+    }
+    return sbe::makeE<sbe::EConstant>(tag, val);
+}
+
+/**
+ * Constructs an array containing objects with the low and high keys for each interval. E.g.,
+ *    [ {l: KS(...), h: KS(...)},
+ *      {l: KS(...), h: KS(...)}, ... ]
+ */
+std::pair<sbe::value::TypeTags, sbe::value::Value> makeIntervalsArray(
+    std::vector<std::pair<std::unique_ptr<KeyString::Value>, std::unique_ptr<KeyString::Value>>>
+        intervals) {
+    using namespace std::literals;
+
+    auto [boundsTag, boundsVal] = sbe::value::makeNewArray();
+    auto arr = sbe::value::getArrayView(boundsVal);
+    for (auto&& [lowKey, highKey] : intervals) {
+        auto [tag, val] = sbe::value::makeNewObject();
+        auto obj = sbe::value::getObjectView(val);
+        obj->push_back(
+            "l"sv, sbe::value::TypeTags::ksValue, sbe::value::bitcastFrom(lowKey.release()));
+        obj->push_back(
+            "h"sv, sbe::value::TypeTags::ksValue, sbe::value::bitcastFrom(highKey.release()));
+        arr->push_back(tag, val);
+    }
+    return {boundsTag, boundsVal};
+}
+
+/**
+ * Constructs the single interval index scan described by generateSingleIntervalIndexScan(), with
+ * the low and high keys produced by the given expressions.
+ */
+std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
+    const Collection* collection,
+    const std::string& indexName,
+    bool forward,
+    std::unique_ptr<sbe::EExpression> lowKeyExpr,
+    std::unique_ptr<sbe::EExpression> highKeyExpr,
+    sbe::IndexKeysInclusionSet indexKeysToInclude,
+    sbe::value::SlotVector vars,
+    boost::optional<sbe::value::SlotId> recordSlot,
+    sbe::value::SlotIdGenerator* slotIdGenerator,
+    PlanYieldPolicy* yieldPolicy,
+    TrialRunProgressTracker* tracker) {
+    auto recordIdSlot = slotIdGenerator->generate();
+    auto lowKeySlot = slotIdGenerator->generate();
+    auto highKeySlot = slotIdGenerator->generate();
+
+    // Construct a constant table scan to deliver a single row with two fields 'lowKeySlot' and
+    // 'highKeySlot', representing seek boundaries, into the index scan.
+    auto project = sbe::makeProjectStage(
+        sbe::makeS<sbe::LimitSkipStage>(sbe::makeS<sbe::CoScanStage>(), 1, boost::none),
+        lowKeySlot,
+        std::move(lowKeyExpr),
+        highKeySlot,
+        std::move(highKeyExpr));
+
+    // Scan the index in the range {'lowKeySlot', 'highKeySlot'} (subject to inclusive or
+    // exclusive boundaries), and produce a single field recordIdSlot that can be used to
+    // position into the collection.
+    auto ixscan = sbe::makeS<sbe::IndexScanStage>(
+        NamespaceStringOrUUID{collection->ns().db().toString(), collection->uuid()},
+        indexName,
+        forward,
+        recordSlot,
+        recordIdSlot,
+        indexKeysToInclude,
+        std::move(vars),
+        lowKeySlot,
+        highKeySlot,
+        yieldPolicy,
+        tracker);
+
+    // Finally, get the keys from the outer side and feed them to the inner side.
+    return {recordIdSlot,
+            sbe::makeS<sbe::LoopJoinStage>(std::move(project),
+                                           std::move(ixscan),
+                                           sbe::makeSV(),
+                                           sbe::makeSV(lowKeySlot, highKeySlot),
+                                           nullptr)};
+}
+
 /**
  * Constructs an optimized version of an index scan for multi-interval index bounds for the case
  * when the bounds can be decomposed in a number of single-interval bounds. In this case, instead
@@ -269,8 +368,7 @@ generateOptimizedMultiIntervalIndexScan(
     const Collection* collection,
     const std::string& indexName,
     bool forward,
-    std::vector<std::pair<std::unique_ptr<KeyString::Value>, std::unique_ptr<KeyString::Value>>>
-        intervals,
+    std::unique_ptr<sbe::EExpression> boundsExpr,
     sbe::IndexKeysInclusionSet indexKeysToInclude,
     sbe::value::SlotVector vars,
     sbe::value::SlotIdGenerator* slotIdGenerator,
@@ -282,31 +380,15 @@ generateOptimizedMultiIntervalIndexScan(
     auto lowKeySlot = slotIdGenerator->generate();
     auto highKeySlot = slotIdGenerator->generate();
 
-    // Construct an array containing objects with the low and high keys for each interval. E.g.,
-    //    [ {l: KS(...), h: KS(...)},
-    //      {l: KS(...), h: KS(...)}, ... ]
-    auto [boundsTag, boundsVal] = sbe::value::makeNewArray();
-    auto arr = sbe::value::getArrayView(boundsVal);
-    for (auto&& [lowKey, highKey] : intervals) {
-        auto [tag, val] = sbe::value::makeNewObject();
-        auto obj = sbe::value::getObjectView(val);
-        obj->push_back(
-            "l"sv, sbe::value::TypeTags::ksValue, sbe::value::bitcastFrom(lowKey.release()));
-        obj->push_back(
-            "h"sv, sbe::value::TypeTags::ksValue, sbe::value::bitcastFrom(highKey.release()));
-        arr->push_back(tag, val);
-    }
-
     auto boundsSlot = slotIdGenerator->generate();
     auto unwindSlot = slotIdGenerator->generate();
 
-    // Project out the constructed array as a constant value and add an unwind stage on top to
-    // flatten the array.
+    // Project out the array of intervals and add an unwind stage on top to flatten the array.
     auto unwind = sbe::makeS<sbe::UnwindStage>(
         sbe::makeProjectStage(
             sbe::makeS<sbe::LimitSkipStage>(sbe::makeS<sbe::CoScanStage>(), 1, boost::none),
             boundsSlot,
-            sbe::makeE<sbe::EConstant>(boundsTag, boundsVal)),
+            std::move(boundsExpr)),
         boundsSlot,
         unwindSlot,
         slotIdGenerator->generate(), /* We don't need an index slot but must to provide it. */
@@ -598,47 +680,22 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     sbe::value::SlotIdGenerator* slotIdGenerator,
     PlanYieldPolicy* yieldPolicy,
     TrialRunProgressTracker* tracker) {
-    auto recordIdSlot = slotIdGenerator->generate();
-    auto lowKeySlot = slotIdGenerator->generate();
-    auto highKeySlot = slotIdGenerator->generate();
-
-    // Construct a constant table scan to deliver a single row with two fields 'lowKeySlot' and
-    // 'highKeySlot', representing seek boundaries, into the index scan.
-    auto project = sbe::makeProjectStage(
-        sbe::makeS<sbe::LimitSkipStage>(sbe::makeS<sbe::CoScanStage>(), 1, boost::none),
-        lowKeySlot,
+    return generateSingleIntervalIndexScan(
+        collection,
+        indexName,
+        forward,
         sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
                                    sbe::value::bitcastFrom(lowKey.release())),
-        highKeySlot,
         sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::ksValue,
-                                   sbe::value::bitcastFrom(highKey.release())));
-
-    // Scan the index in the range {'lowKeySlot', 'highKeySlot'} (subject to inclusive or
-    // exclusive boundaries), and produce a single field recordIdSlot that can be used to
-    // position into the collection.
-    auto ixscan = sbe::makeS<sbe::IndexScanStage>(
-        NamespaceStringOrUUID{collection->ns().db().toString(), collection->uuid()},
-        indexName,
-        forward,
-        recordSlot,
-        recordIdSlot,
+                                   sbe::value::bitcastFrom(highKey.release())),
         indexKeysToInclude,
         std::move(vars),
-        lowKeySlot,
-        highKeySlot,
+        recordSlot,
+        slotIdGenerator,
         yieldPolicy,
         tracker);
-
-    // Finally, get the keys from the outer side and feed them to the inner side.
-    return {recordIdSlot,
-            sbe::makeS<sbe::LoopJoinStage>(std::move(project),
-                                           std::move(ixscan),
-                                           sbe::makeSV(),
-                                           sbe::makeSV(lowKeySlot, highKeySlot),
-                                           nullptr)};
 }
 
-
 std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan(
     OperationContext* opCtx,
     const Collection* collection,
@@ -646,6 +703,7 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
     boost::optional<sbe::value::SlotId> returnKeySlot,
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
+    sbe::RuntimeEnvironment* env,
     PlanYieldPolicy* yieldPolicy,
     TrialRunProgressTracker* tracker) {
     invariant(returnKeySlot || !ixn->addKeyMetadata);
@@ -697,11 +755,21 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
         if (intervals.size() == 1) {
             // If we have just a single interval, we can construct a simplified sub-tree.
             auto&& [lowKey, highKey] = intervals[0];
+            auto lowKeyExpr = makeBoundsExpr(env,
+                                             makeBoundsSlotName("LowKey"_sd, ixn),
+                                             sbe::value::TypeTags::ksValue,
+                                             sbe::value::bitcastFrom(lowKey.release()),
+                                             slotIdGenerator);
+            auto highKeyExpr = makeBoundsExpr(env,
+                                              makeBoundsSlotName("HighKey"_sd, ixn),
+                                              sbe::value::TypeTags::ksValue,
+                                              sbe::value::bitcastFrom(highKey.release()),
+                                              slotIdGenerator);
             return generateSingleIntervalIndexScan(collection,
                                                    ixn->index.identifier.catalogName,
                                                    ixn->direction == 1,
-                                                   std::move(lowKey),
-                                                   std::move(highKey),
+                                                   std::move(lowKeyExpr),
+                                                   std::move(highKeyExpr),
                                                    indexKeysToInclude,
                                                    vars,
                                                    boost::none,  // recordSlot
@@ -712,10 +780,16 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
             // Or, if we were able to decompose multi-interval index bounds into a number of
             // single-interval bounds, we can also built an optimized sub-tree to perform an index
             // scan.
+            auto [boundsTag, boundsVal] = makeIntervalsArray(std::move(intervals));
+            auto boundsExpr = makeBoundsExpr(env,
+                                             makeBoundsSlotName("Intervals"_sd, ixn),
+                                             boundsTag,
+                                             boundsVal,
+                                             slotIdGenerator);
             return generateOptimizedMultiIntervalIndexScan(collection,
                                                            ixn->index.identifier.catalogName,
                                                            ixn->direction == 1,
-                                                           std::move(intervals),
+                                                           std::move(boundsExpr),
                                                            indexKeysToInclude,
                                                            vars,
                                                            slotIdGenerator,
@@ -745,8 +819,12 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
                  sbe::makeE<sbe::EFunction>("first",
                                             sbe::makeEs(sbe::makeE<sbe::EVariable>(varSlot)))});
         }
-        stage = sbe::makeS<sbe::HashAggStage>(
-            std::move(stage), sbe::makeSV(slot), std::move(forwardedVarSlots));
+        stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                              sbe::makeSV(slot),
+                                              std::move(forwardedVarSlots),
+                                              sbe::makeEM(),
+                                              std::numeric_limits<size_t>::max(),
+                                              false);
     }
 
     if (returnKeyExpr) {
@@ -755,4 +833,52 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
 
     return {slot, std::move(stage)};
 }
+
+bool bindIndexScanBounds(OperationContext* opCtx,
+                         const Collection* collection,
+                         const IndexScanNode* ixn,
+                         sbe::RuntimeEnvironment* env) {
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
+    if (!descriptor) {
+        return false;
+    }
+    auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+    auto intervals =
+        makeIntervalsFromIndexBounds(ixn->bounds,
+                                     ixn->direction == 1,
+                                     accessMethod->getSortedDataInterface()->getKeyStringVersion(),
+                                     accessMethod->getSortedDataInterface()->getOrdering());
+
+    if (intervals.size() == 1) {
+        auto lowKeySlot = env->getSlotIfExists(makeBoundsSlotName("LowKey"_sd, ixn));
+        auto highKeySlot = env->getSlotIfExists(makeBoundsSlotName("HighKey"_sd, ixn));
+        if (!lowKeySlot || !highKeySlot) {
+            return false;
+        }
+
+        auto&& [lowKey, highKey] = intervals[0];
+        env->resetSlot(*lowKeySlot,
+                       sbe::value::TypeTags::ksValue,
+                       sbe::value::bitcastFrom(lowKey.release()),
+                       true);
+        env->resetSlot(*highKeySlot,
+                       sbe::value::TypeTags::ksValue,
+                       sbe::value::bitcastFrom(highKey.release()),
+                       true);
+        return true;
+    } else if (intervals.size() > 1) {
+        auto boundsSlot = env->getSlotIfExists(makeBoundsSlotName("Intervals"_sd, ixn));
+        if (!boundsSlot) {
+            return false;
+        }
+
+        auto [boundsTag, boundsVal] = makeIntervalsArray(std::move(intervals));
+        env->resetSlot(*boundsSlot, boundsTag, boundsVal, true);
+        return true;
+    }
+
+    // The bounds of a generic index scan are embedded into the tree.
+    return false;
+}
 }  // namespace mongo::stage_builder
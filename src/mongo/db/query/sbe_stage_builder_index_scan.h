@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/db/exec/trial_run_progress_tracker.h"
@@ -36,7 +37,9 @@
 
 namespace mongo::stage_builder {
 /**
- * Generates an SBE plan stage sub-tree implementing an index scan.
+ * Generates an SBE plan stage sub-tree implementing an index scan. Unless the bounds can only be
+ * checked by a generic multi-interval scan, they are kept in slots of 'env', so that the tree can
+ * be run again with other bounds (see bindIndexScanBounds()).
  */
 std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan(
     OperationContext* opCtx,
@@ -45,9 +48,21 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateIndexScan
     boost::optional<sbe::value::SlotId> returnKeySlot,
     sbe::value::SlotIdGenerator* slotIdGenerator,
     sbe::value::SpoolIdGenerator* spoolIdGenerator,
+    sbe::RuntimeEnvironment* env,
     PlanYieldPolicy* yieldPolicy,
     TrialRunProgressTracker* tracker);
 
+/**
+ * Stores the bounds of the index scan 'ixn' in the runtime environment slots which an index scan
+ * generated for the node with the same id in a solution of the same shape reads them from. Returns
+ * false if the index scan did not read its bounds from 'env', or if it read bounds with a different
+ * number of intervals, in which case the tree cannot be run with the bounds of 'ixn'.
+ */
+bool bindIndexScanBounds(OperationContext* opCtx,
+                         const Collection* collection,
+                         const IndexScanNode* ixn,
+                         sbe::RuntimeEnvironment* env);
+
 /**
  * Constructs the most simple version of an index scan from the single interval index bounds. The
  * generated subtree will have the following form:
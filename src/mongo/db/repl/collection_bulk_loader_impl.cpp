@@ -31,12 +31,15 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/status.h"
 #include "mongo/base/status_with.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -83,6 +86,12 @@ Status CollectionBulkLoaderImpl::init(const std::vector<BSONObj>& secondaryIndex
         CollectionWriter collWriter(*_collection);
         auto indexCatalog = collWriter.getWritableCollection()->getIndexCatalog();
         auto specs = indexCatalog->removeExistingIndexesNoChecks(_opCtx.get(), secondaryIndexSpecs);
+        // The collections cloned concurrently share the memory index builds may use.
+        const std::size_t maxMemoryUsageBytes =
+            static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 /
+            std::max(initialSyncCollectionClonerConcurrency.load(), 1);
+        _idIndexBlock->setMaxMemoryUsageBytes(maxMemoryUsageBytes);
+        _secondaryIndexesBlock->setMaxMemoryUsageBytes(maxMemoryUsageBytes);
         if (specs.size()) {
             _secondaryIndexesBlock->ignoreUniqueConstraint();
             auto status =
@@ -220,6 +220,10 @@ BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
     waitForDatabaseWorkToComplete();
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
+    if (_deferIndexBuilds && _unfinishedIndexSpecs.empty()) {
+        _uncommittedLoader = std::move(loader);
+        return kContinueNormally;
+    }
     uassertStatusOK(loader->commit());
     return kContinueNormally;
 }
@@ -91,6 +91,24 @@ public:
 
     Stats getStats() const;
 
+    /**
+     * Makes the cloner leave the indexes of its collection to be built after run() returns, by
+     * committing the loader returned by releaseUncommittedLoader(). This lets the caller build
+     * them while it clones other collections. Collections with unfinished index builds on the sync
+     * source still build their indexes before run() returns.
+     */
+    void deferIndexBuilds() {
+        _deferIndexBuilds = true;
+    }
+
+    /**
+     * Returns the loader of a collection cloned after deferIndexBuilds(), whose indexes are built
+     * by committing it, or null if there is none.
+     */
+    std::unique_ptr<CollectionBulkLoader> releaseUncommittedLoader() {
+        return std::move(_uncommittedLoader);
+    }
+
     std::string toString() const;
 
     NamespaceString getSourceNss() const {
@@ -254,6 +272,11 @@ private:
     std::vector<BSONObj> _unfinishedIndexSpecs;         // (X)
     BSONObj _idIndexSpec;                               // (X)
     std::unique_ptr<CollectionBulkLoader> _collLoader;  // (X)
+
+    // Whether the indexes are left to be built after run(), and the loader to build them with.
+    bool _deferIndexBuilds = false;                            // (X)
+    std::unique_ptr<CollectionBulkLoader> _uncommittedLoader;  // (X)
+
     //  Function for scheduling database work using the executor.
     ScheduleDbWorkFn _scheduleDbWorkFn;  // (R)
     // Documents read from source to insert.
@@ -31,13 +31,25 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+#include <deque>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace repl {
@@ -51,7 +63,9 @@ DatabaseCloner::DatabaseCloner(const std::string& dbName,
     : InitialSyncBaseCloner(
           "DatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
-      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage) {
+      _listCollectionsStage("listCollections", this, &DatabaseCloner::listCollectionsStage),
+      _createClientFn(
+          [] { return std::make_unique<DBClientConnection>(true /* autoReconnect */); }) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
 }
@@ -117,6 +131,14 @@ bool DatabaseCloner::isMyFailPoint(const BSONObj& data) const {
     return data["database"].str() == _dbName && BaseCloner::isMyFailPoint(data);
 }
 
+std::unique_ptr<DBClientConnection> DatabaseCloner::connectToSource() {
+    auto client = _createClientFn();
+    uassertStatusOK(client->connect(getSource(), StringData()));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+    return client;
+}
+
 void DatabaseCloner::postStage() {
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -127,26 +149,89 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    // The indexes of the collections already cloned which are still being built, oldest first.
+    // They are built on the database work threads while the next collections are cloned.
+    auto pendingIndexBuildsMutex = MONGO_MAKE_LATCH("DatabaseCloner::pendingIndexBuildsMutex");
+    std::deque<std::pair<NamespaceString, Future<void>>> pendingIndexBuilds;
+    auto waitForIndexBuilds = [&](size_t maxPending) {
+        Status status = Status::OK();
+        while (true) {
+            boost::optional<std::pair<NamespaceString, Future<void>>> pendingIndexBuild;
+            {
+                stdx::lock_guard<Latch> lk(pendingIndexBuildsMutex);
+                if (pendingIndexBuilds.size() <= maxPending) {
+                    break;
+                }
+                pendingIndexBuild.emplace(std::move(pendingIndexBuilds.front()));
+                pendingIndexBuilds.pop_front();
+            }
+            auto& [nss, indexBuild] = *pendingIndexBuild;
+            auto indexBuildStatus = indexBuild.getNoThrow();
+            if (!indexBuildStatus.isOK() && status.isOK()) {
+                LOGV2_ERROR(5190510,
+                            "Building the indexes of the cloned collection failed",
+                            "namespace"_attr = nss,
+                            "error"_attr = indexBuildStatus);
+                status = indexBuildStatus.withContext(
+                    str::stream() << "Error building the indexes of collection '" << nss.toString()
+                                  << "'");
+                // Every index build must finish before returning.
+                maxPending = 0;
+            }
+        }
+        if (!status.isOK()) {
+            setSyncFailedStatus({ErrorCodes::InitialSyncFailure, status.toString()});
+        }
+        return status;
+    };
+    ON_BLOCK_EXIT([&] { waitForIndexBuilds(0).ignore(); });
+
+    // Clones the collection at 'index' in _collections over 'client', returning false if the
+    // database clone must stop.
+    auto cloneCollection = [&](size_t index, DBClientConnection* client) {
+        auto& sourceNss = _collections[index].first;
+        auto& collectionOptions = _collections[index].second;
+        const size_t maxPendingIndexBuilds = initialSyncMaxPendingIndexBuilds.load();
+        if (maxPendingIndexBuilds > 0 && !waitForIndexBuilds(maxPendingIndexBuilds - 1).isOK()) {
+            return false;
+        }
+        CollectionCloner* collectionCloner;
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+            auto& currentCollectionCloner = _currentCollectionCloners[index];
+            currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
+                                                                         collectionOptions,
+                                                                         getSharedData(),
+                                                                         getSource(),
+                                                                         client,
+                                                                         getStorageInterface(),
+                                                                         getDBPool());
+            collectionCloner = currentCollectionCloner.get();
+        }
+        if (maxPendingIndexBuilds > 0) {
+            collectionCloner->deferIndexBuilds();
         }
-        auto collStatus = _currentCollectionCloner->run();
+        auto collStatus = collectionCloner->run();
         if (collStatus.isOK()) {
             LOGV2_DEBUG(21148,
                         1,
                         "collection clone finished: {namespace}",
                         "Collection clone finished",
                         "namespace"_attr = sourceNss);
+            if (auto loader = collectionCloner->releaseUncommittedLoader()) {
+                auto [promise, future] = makePromiseFuture<void>();
+                getDBPool()->schedule([loader = std::move(loader),
+                                       promise = std::move(promise)](auto status) mutable {
+                    if (!status.isOK()) {
+                        promise.setError(status);
+                        return;
+                    }
+                    promise.setWith([&] { uassertStatusOK(loader->commit()); });
+                });
+                stdx::lock_guard<Latch> lk(pendingIndexBuildsMutex);
+                pendingIndexBuilds.emplace_back(sourceNss, std::move(future));
+            }
         } else {
             LOGV2_ERROR(21149,
                         "collection clone for '{namespace}' failed due to {error}",
@@ -161,13 +246,82 @@ void DatabaseCloner::postStage() {
         }
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
+            _stats.collectionStats[index] = collectionCloner->getStats();
+            _currentCollectionCloners.erase(index);
             // Abort the database cloner if the collection clone failed.
             if (!collStatus.isOK())
-                return;
+                return false;
             _stats.clonedCollections++;
         }
+        return true;
+    };
+
+    // Each connection clones the next collection nobody has started cloning yet, in order.
+    AtomicWord<size_t> nextCollection{0};
+    AtomicWord<bool> stopCloning{false};
+    auto cloneCollections = [&](DBClientConnection* client) {
+        while (!stopCloning.load()) {
+            const size_t index = nextCollection.fetchAndAdd(1);
+            if (index >= _collections.size()) {
+                return;
+            }
+            if (!cloneCollection(index, client)) {
+                stopCloning.store(true);
+            }
+        }
+    };
+
+    const size_t concurrency = std::min(
+        static_cast<size_t>(initialSyncCollectionClonerConcurrency.load()), _collections.size());
+    std::vector<std::unique_ptr<DBClientConnection>> clients;
+    while (clients.size() + 1 < concurrency) {
+        try {
+            clients.push_back(connectToSource());
+        } catch (const DBException& e) {
+            LOGV2_WARNING(5190520,
+                          "Cloning the collections of the database over fewer connections to the "
+                          "sync source because connecting to it failed",
+                          "database"_attr = _dbName,
+                          "numConnections"_attr = clients.size() + 1,
+                          "error"_attr = e.toStatus());
+            break;
+        }
+    }
+
+    AtomicWord<size_t> numRunningThreads{clients.size()};
+    std::vector<stdx::thread> threads;
+    auto joinThreads = [&] {
+        // Canceling the initial sync only interrupts the cloner's own connection, so the others
+        // are shut down here.
+        bool clientsShutDown = false;
+        while (numRunningThreads.load() > 0) {
+            if (!clientsShutDown && mustExit()) {
+                for (auto& client : clients) {
+                    client->shutdownAndDisallowReconnect();
+                }
+                clientsShutDown = true;
+            }
+            sleepmillis(10);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    };
+    ON_BLOCK_EXIT(joinThreads);
+    for (auto& client : clients) {
+        threads.emplace_back([&, client = client.get()] {
+            Client::initThread("DatabaseClonerCollectionCloner");
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+            ON_BLOCK_EXIT([&] { numRunningThreads.subtractAndFetch(1); });
+            cloneCollections(client);
+        });
+    }
+    cloneCollections(getClient());
+    joinThreads();
+
+    if (stopCloning.load() || !waitForIndexBuilds(0).isOK()) {
+        return;
     }
     stdx::lock_guard<Latch> lk(_mutex);
     _stats.end = getSharedData()->getClock()->now();
@@ -176,8 +330,8 @@ void DatabaseCloner::postStage() {
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (const auto& [index, collectionCloner] : _currentCollectionCloners) {
+        stats.collectionStats[index] = collectionCloner->getStats();
     }
     return stats;
 }
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -54,6 +57,8 @@ public:
         void append(BSONObjBuilder* builder) const;
     };
 
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
+
     DatabaseCloner(const std::string& dbName,
                    InitialSyncSharedData* sharedData,
                    const HostAndPort& source,
@@ -69,6 +74,14 @@ public:
 
     static CollectionOptions parseCollectionOptions(const BSONObj& element);
 
+    /**
+     * Overrides how the connections used to clone collections concurrently with the one cloned
+     * over 'client' are created.
+     */
+    void setCreateClientFn_forTest(const CreateClientFn& createClientFn) {
+        _createClientFn = createClientFn;
+    }
+
 protected:
     ClonerStages getStages() final;
 
@@ -89,10 +102,18 @@ private:
 
     /**
      * The postStage creates and runs the individual CollectionCloners on each database found on
-     * the sync source, and sets the end time in _stats when done.
+     * the sync source, and sets the end time in _stats when done. Up to
+     * initialSyncCollectionClonerConcurrency collections are cloned at once, each over its own
+     * connection.
      */
     void postStage() final;
 
+    /**
+     * Creates, connects and authenticates another connection to the sync source. Throws on
+     * failure.
+     */
+    std::unique_ptr<DBClientConnection> connectToSource();
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -109,8 +130,11 @@ private:
     const std::string _dbName;                                                // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    Stats _stats;                                                             // (M)
+
+    // The collection cloners which are running, by the index of their collection in _collections.
+    std::map<size_t, std::unique_ptr<CollectionCloner>> _currentCollectionCloners;  // (M)
+    CreateClientFn _createClientFn;                                                 // (X)
 };
 
 }  // namespace repl
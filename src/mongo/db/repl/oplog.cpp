@@ -347,6 +347,9 @@ OpTime logOp(OperationContext* opCtx, MutableOplogEntry* oplogEntry) {
     return slot;
 }
 
+// A generous estimate of the size of the fields of an insert oplog entry besides the document.
+constexpr int kOplogEntryEnvelopeBytes = 512;
+
 std::vector<OpTime> logInsertOps(OperationContext* opCtx,
                                  MutableOplogEntry* oplogEntryTemplate,
                                  std::vector<InsertStatement>::const_iterator begin,
@@ -401,7 +404,11 @@ std::vector<OpTime> logInsertOps(OperationContext* opCtx,
 
         opTimes[i] = insertStatementOplogSlot;
         timestamps[i] = insertStatementOplogSlot.getTimestamp();
-        bsonOplogEntries[i] = oplogEntry.toBSON();
+        // Size the entry for the document it carries, so that building it copies the document once
+        // instead of again each time the builder outgrows its buffer.
+        BSONObjBuilder oplogEntryBuilder(begin[i].doc.objsize() + kOplogEntryEnvelopeBytes);
+        oplogEntry.serialize(&oplogEntryBuilder);
+        bsonOplogEntries[i] = oplogEntryBuilder.obj();
         // The storage engine will assign the RecordId based on the "ts" field of the oplog entry,
         // see oploghack::extractKey.
         records[i] = Record{
@@ -31,6 +31,8 @@
 
 #include "mongo/db/repl/oplog_applier_impl.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database.h"
@@ -52,6 +54,7 @@
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace repl {
@@ -315,6 +318,10 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         const auto lastOpTimeInBatch = lastOpInBatch.getOpTime();
         const auto lastWallTimeInBatch = lastOpInBatch.getWallClockTime();
         const auto lastAppliedOpTimeAtStartOfBatch = _replCoord->getMyLastAppliedOpTime();
+        std::size_t numOpsInBatch = 0;
+        for (const auto& op : ops.getBatch()) {
+            numOpsInBatch += OplogBatcher::getOpCount(op);
+        }
 
         // Make sure the oplog doesn't go back in time or repeat an entry.
         if (firstOpTimeInBatch <= lastAppliedOpTimeAtStartOfBatch) {
@@ -331,6 +338,8 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
         // last op that was applied, which should be the last optime in the batch.
+        Timer applyTimer;
+        _lastVisibleOpTimeInBatch = OpTime();
         auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
@@ -342,6 +351,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         }
         fassertNoTrace(34437, swLastOpTimeAppliedInBatch);
         invariant(swLastOpTimeAppliedInBatch.getValue() == lastOpTimeInBatch);
+        _oplogBatcher->recordBatchApplied(numOpsInBatch, Milliseconds(applyTimer.millis()));
 
         // Update various things that care about our last applied optime. Tests rely on 1 happening
         // before 2 even though it isn't strictly necessary.
@@ -349,11 +359,15 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
         // 1. Persist our "applied through" optime to disk.
         _consistencyMarkers->setAppliedThrough(&opCtx, lastOpTimeInBatch);
 
-        // 2. Ensure that the last applied op time hasn't changed since the start of this batch.
+        // 2. Ensure that the last applied op time hasn't changed since the start of this batch,
+        // other than to make the chunks of the batch visible.
         const auto lastAppliedOpTimeAtEndOfBatch = _replCoord->getMyLastAppliedOpTime();
-        invariant(lastAppliedOpTimeAtStartOfBatch == lastAppliedOpTimeAtEndOfBatch,
+        const auto lastAppliedOpTimeBeforeEndOfBatch = _lastVisibleOpTimeInBatch.isNull()
+            ? lastAppliedOpTimeAtStartOfBatch
+            : _lastVisibleOpTimeInBatch;
+        invariant(lastAppliedOpTimeBeforeEndOfBatch == lastAppliedOpTimeAtEndOfBatch,
                   str::stream() << "the last known applied OpTime has changed from "
-                                << lastAppliedOpTimeAtStartOfBatch.toString() << " to "
+                                << lastAppliedOpTimeBeforeEndOfBatch.toString() << " to "
                                 << lastAppliedOpTimeAtEndOfBatch.toString()
                                 << " in the middle of batch application");
 
@@ -455,7 +469,11 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
     // Increment the batch size stat.
     oplogApplicationBatchSize.increment(ops.size());
 
-    std::vector<WorkerMultikeyPathInfo> multikeyVector(_writerPool->getStats().numThreads);
+    // Dividing the batch into more writer vectors than there are writer threads lets the threads
+    // balance the batch between them as they go, rather than each applying a fixed share of it.
+    const size_t numThreads = _writerPool->getStats().numThreads;
+    const size_t numWriterVectors = numThreads * replWriterVectorsPerThread.load();
+    std::vector<WorkerMultikeyPathInfo> multikeyVector(numWriterVectors);
     {
         // Each node records cumulative batch application stats for itself using this timer.
         TimerHolder timer(&applyBatchStats);
@@ -471,64 +489,95 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
         }
 
-        // Holds 'pseudo operations' generated by secondaries to aid in replication.
-        // Keep in scope until all operations in 'ops' and 'derivedOps' have been applied.
-        // Pseudo operations include:
-        // - applyOps operations expanded to individual ops.
-        // - ops to update config.transactions. Normal writes to config.transactions in the
-        //   primary don't create an oplog entry, so extract info from writes with transactions
-        //   and create a pseudo oplog.
-        std::vector<std::vector<OplogEntry>> derivedOps;
-
-        std::vector<std::vector<const OplogEntry*>> writerVectors(
-            _writerPool->getStats().numThreads);
-        fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
-
-        // Wait for writes to finish before applying ops.
-        _writerPool->waitForIdle();
-
-        // Use this fail point to hold the PBWM lock after we have written the oplog entries but
-        // before we have applied them.
-        if (MONGO_unlikely(pauseBatchApplicationAfterWritingOplogEntries.shouldFail())) {
-            LOGV2(21231,
-                  "pauseBatchApplicationAfterWritingOplogEntries fail point enabled. Blocking "
-                  "until fail point is disabled");
-            pauseBatchApplicationAfterWritingOplogEntries.pauseWhileSet(opCtx);
+        // Secondaries may apply the batch in consecutive chunks, making each of them visible to
+        // reads from lastApplied once it is applied, so that those reads don't have to wait for
+        // the whole batch to see its first operations.
+        std::vector<std::vector<OplogEntry>> chunks;
+        const size_t visibilityIntervalOps =
+            getOptions().mode == OplogApplication::Mode::kSecondary
+            ? static_cast<size_t>(replBatchReadVisibilityIntervalOps.load())
+            : 0;
+        if (visibilityIntervalOps > 0 && ops.size() > visibilityIntervalOps) {
+            // The oplog writes still read 'ops', so the chunks are copies of it.
+            for (auto it = ops.cbegin(); it != ops.cend();) {
+                auto chunkEnd = it + std::min<size_t>(visibilityIntervalOps, ops.cend() - it);
+                chunks.emplace_back(it, chunkEnd);
+                it = chunkEnd;
+            }
         }
+        const size_t numChunks = std::max<size_t>(chunks.size(), 1);
+
+        for (size_t chunk = 0; chunk < numChunks; chunk++) {
+            auto& chunkOps = chunks.empty() ? ops : chunks[chunk];
+
+            // Holds 'pseudo operations' generated by secondaries to aid in replication.
+            // Keep in scope until all operations in 'chunkOps' and 'derivedOps' have been applied.
+            // Pseudo operations include:
+            // - applyOps operations expanded to individual ops.
+            // - ops to update config.transactions. Normal writes to config.transactions in the
+            //   primary don't create an oplog entry, so extract info from writes with transactions
+            //   and create a pseudo oplog.
+            std::vector<std::vector<OplogEntry>> derivedOps;
+
+            std::vector<std::vector<const OplogEntry*>> writerVectors(numWriterVectors);
+            fillWriterVectors(opCtx, &chunkOps, &writerVectors, &derivedOps);
+
+            if (chunk == 0) {
+                // Wait for writes to finish before applying ops.
+                _writerPool->waitForIdle();
+
+                // Use this fail point to hold the PBWM lock after we have written the oplog entries
+                // but before we have applied them.
+                if (MONGO_unlikely(pauseBatchApplicationAfterWritingOplogEntries.shouldFail())) {
+                    LOGV2(21231,
+                          "pauseBatchApplicationAfterWritingOplogEntries fail point enabled. "
+                          "Blocking until fail point is disabled");
+                    pauseBatchApplicationAfterWritingOplogEntries.pauseWhileSet(opCtx);
+                }
 
-        // Reset consistency markers in case the node fails while applying ops.
-        if (!getOptions().skipWritesToOplog) {
-            _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
-            _consistencyMarkers->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
-        }
+                // Reset consistency markers in case the node fails while applying ops.
+                if (!getOptions().skipWritesToOplog) {
+                    _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+                    _consistencyMarkers->setMinValidToAtLeast(opCtx, ops.back().getOpTime());
+                }
+            }
 
-        {
-            std::vector<Status> statusVector(_writerPool->getStats().numThreads, Status::OK());
+            std::vector<Status> statusVector(numWriterVectors, Status::OK());
+
+            // The writer threads take the writer vectors largest first, so that the longest ones
+            // are started early and the short ones fill in the threads which finish first.
+            std::vector<size_t> writerOrder;
+            for (size_t i = 0; i < writerVectors.size(); i++) {
+                if (!writerVectors[i].empty())
+                    writerOrder.push_back(i);
+            }
+            std::stable_sort(writerOrder.begin(), writerOrder.end(), [&](size_t l, size_t r) {
+                return writerVectors[l].size() > writerVectors[r].size();
+            });
+            AtomicWord<size_t> nextWriter{0};
 
             // Doles out all the work to the writer pool threads. writerVectors is not modified,
             // but  applyOplogBatchPerWorker will modify the vectors that it contains.
             invariant(writerVectors.size() == statusVector.size());
-            for (size_t i = 0; i < writerVectors.size(); i++) {
-                if (writerVectors[i].empty())
-                    continue;
-
-                _writerPool->schedule(
-                    [this,
-                     &writer = writerVectors.at(i),
-                     &status = statusVector.at(i),
-                     &multikeyVector = multikeyVector.at(i)](auto scheduleStatus) {
-                        invariant(scheduleStatus);
+            for (size_t t = 0; t < std::min(numThreads, writerOrder.size()); t++) {
+                _writerPool->schedule([&](auto scheduleStatus) {
+                    invariant(scheduleStatus);
 
+                    for (auto n = nextWriter.fetchAndAdd(1); n < writerOrder.size();
+                         n = nextWriter.fetchAndAdd(1)) {
+                        const size_t i = writerOrder[n];
                         auto opCtx = cc().makeOperationContext();
 
                         // This code path is only executed on secondaries and initial syncing nodes,
                         // so it is safe to exclude any writes from Flow Control.
                         opCtx->setShouldParticipateInFlowControl(false);
 
-                        status = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
-                            return applyOplogBatchPerWorker(opCtx.get(), &writer, &multikeyVector);
+                        statusVector[i] = opCtx->runWithoutInterruptionExceptAtGlobalShutdown([&] {
+                            return applyOplogBatchPerWorker(
+                                opCtx.get(), &writerVectors[i], &multikeyVector[i]);
                         });
-                    });
+                    }
+                });
             }
 
             _writerPool->waitForIdle();
@@ -553,6 +602,10 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     return status;
                 }
             }
+
+            if (chunk + 1 < numChunks) {
+                _makeChunkVisible(opCtx, chunkOps, &multikeyVector);
+            }
         }
     }
 
@@ -579,11 +632,23 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         }
     }
 
-    Timestamp firstTimeInBatch = ops.front().getTimestamp();
     // Set any indexes to multikey that this batch ignored. This must be done while holding the
     // parallel batch writer mode lock.
-    for (WorkerMultikeyPathInfo infoVector : multikeyVector) {
-        for (MultikeyPathInfo info : infoVector) {
+    _setIndexesMultikey(opCtx, &multikeyVector, ops.front().getTimestamp());
+
+    // Increment the counter for the number of ops applied during catchup if the node is in catchup
+    // mode.
+    _replCoord->incrementNumCatchUpOpsIfCatchingUp(ops.size());
+
+    // We have now written all database writes and updated the oplog to match.
+    return ops.back().getOpTime();
+}
+
+void OplogApplierImpl::_setIndexesMultikey(OperationContext* opCtx,
+                                           std::vector<WorkerMultikeyPathInfo>* multikeyVector,
+                                           Timestamp firstTimeInBatch) {
+    for (auto& infoVector : *multikeyVector) {
+        for (const MultikeyPathInfo& info : infoVector) {
             // We timestamp every multikey write with the first timestamp in the batch. It is always
             // safe to set an index as multikey too early, just not too late. We conservatively pick
             // the first timestamp in the batch since we do not have enough information to find out
@@ -596,14 +661,23 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                           info.multikeyPaths,
                                                           firstTimeInBatch));
         }
+        infoVector.clear();
     }
+}
 
-    // Increment the counter for the number of ops applied during catchup if the node is in catchup
-    // mode.
-    _replCoord->incrementNumCatchUpOpsIfCatchingUp(ops.size());
-
-    // We have now written all database writes and updated the oplog to match.
-    return ops.back().getOpTime();
+void OplogApplierImpl::_makeChunkVisible(OperationContext* opCtx,
+                                         const std::vector<OplogEntry>& chunkOps,
+                                         std::vector<WorkerMultikeyPathInfo>* multikeyVector) {
+    // Readers of the chunk's last optime must see the indexes it made multikey as such.
+    _setIndexesMultikey(opCtx, multikeyVector, chunkOps.front().getTimestamp());
+
+    // The whole batch is already in the oplog, so the chunk's oplog entries can be made visible.
+    const auto& lastOpInChunk = chunkOps.back();
+    const bool orderedCommit = true;
+    _storageInterface->oplogDiskLocRegister(opCtx, lastOpInChunk.getTimestamp(), orderedCommit);
+    _replCoord->setMyLastAppliedOpTimeAndWallTimeForward(
+        {lastOpInChunk.getOpTime(), lastOpInChunk.getWallClockTime()});
+    _lastVisibleOpTimeInBatch = lastOpInChunk.getOpTime();
 }
 
 /**
@@ -783,6 +857,10 @@ Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
     // destroyed by unstash in its destructor. Thus we set the flag explicitly.
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
+    // Reads on this node wait for the batch to be applied, so do not queue behind user operations
+    // for tickets.
+    opCtx->lockState()->setAdmissionPriority(TicketHolder::Priority::kHigh);
+
     // Ensure future transactions read without a timestamp.
     invariant(RecoveryUnit::ReadSource::kNoTimestamp ==
               opCtx->recoveryUnit()->getTimestampReadSource());
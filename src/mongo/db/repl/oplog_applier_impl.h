@@ -95,9 +95,28 @@ private:
      * To provide crash resilience, this function will advance the persistent value of 'minValid'
      * to at least the last optime of the batch. If 'minValid' is already greater than or equal
      * to the last optime of this batch, it will not be updated.
+     *
+     * On secondaries, the batch may be applied in consecutive chunks of
+     * replBatchReadVisibilityIntervalOps operations, each of which is made visible to reads from
+     * lastApplied once it is applied.
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Marks the indexes in 'multikeyVector' multikey at 'firstTimeInBatch', and clears it.
+     */
+    void _setIndexesMultikey(OperationContext* opCtx,
+                             std::vector<WorkerMultikeyPathInfo>* multikeyVector,
+                             Timestamp firstTimeInBatch);
+
+    /**
+     * Makes the chunk of the batch being applied which ends with the last operation of
+     * 'chunkOps' visible to reads from lastApplied, once all its operations are applied.
+     */
+    void _makeChunkVisible(OperationContext* opCtx,
+                           const std::vector<OplogEntry>& chunkOps,
+                           std::vector<WorkerMultikeyPathInfo>* multikeyVector);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -119,6 +138,10 @@ private:
     // we will apply all operations that were fetched.
     OpTime _beginApplyingOpTime = OpTime();
 
+    // The optime of the last operation of the batch being applied which _applyOplogBatch has made
+    // visible before the whole batch is applied, or null if there is none.
+    OpTime _lastVisibleOpTimeInBatch;
+
     void fillWriterVectors(OperationContext* opCtx,
                            std::vector<OplogEntry>* ops,
                            std::vector<std::vector<const OplogEntry*>>* writerVectors,
@@ -0,0 +1,388 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <vector>
+
+#include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/database_holder_impl.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/index/index_access_method_factory_impl.h"
+#include "mongo/db/index_builds_coordinator_mongod.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/db/repl/replication_consistency_markers_mock.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/s/collection_sharding_state_factory_shard.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/control/storage_control.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/vector_clock_mutable.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+constexpr size_t kBatchSize = 5000;
+constexpr int kNumSeedDocs = 10000;
+constexpr int kOpsPerApplyOps = 5;
+
+/**
+ * A replica set member with the WiredTiger storage engine running inside the benchmark process,
+ * set up the same way as OplogApplierImplTest. The data files live in a temporary directory under
+ * TMPDIR. The environment is built by the first benchmark that needs it and torn down at exit.
+ */
+class OplogApplierBenchmarkEnvironment {
+public:
+    static OplogApplierBenchmarkEnvironment& get() {
+        static OplogApplierBenchmarkEnvironment env;
+        return env;
+    }
+
+    ReplicationConsistencyMarkers* consistencyMarkers() {
+        return &_consistencyMarkers;
+    }
+
+    /**
+     * Creates a new, empty collection for a benchmark run. Applied entries cannot be applied
+     * again, so each run starts from its own collection.
+     */
+    std::pair<NamespaceString, UUID> makeCollection(OperationContext* opCtx) {
+        NamespaceString nss("oplog_applier_bm", "coll" + std::to_string(_numCollections++));
+        CollectionOptions options;
+        options.uuid = UUID::gen();
+        uassertStatusOK(StorageInterface::get(opCtx)->createCollection(opCtx, nss, options));
+        return {nss, *options.uuid};
+    }
+
+    /**
+     * Returns optimes that keep increasing across benchmark runs.
+     */
+    OpTime nextOpTime() {
+        return OpTime(Timestamp(Seconds(++_lastSecond), 0), 1LL);
+    }
+
+private:
+    OplogApplierBenchmarkEnvironment() : _serviceContext(getGlobalServiceContext()) {
+        storageGlobalParams.engine = "wiredTiger";
+        storageGlobalParams.engineSetByUser = true;
+        storageGlobalParams.dbpath = _tempDir.path();
+
+        _serviceContext->setPeriodicRunner(makePeriodicRunner(_serviceContext));
+        _serviceContext->setOpObserver(std::make_unique<OpObserverRegistry>());
+
+        auto client = _serviceContext->makeClient("oplog_applier_bm");
+        AlternativeClientRegion acr(client);
+        auto opCtx = cc().makeOperationContext();
+        initializeStorageEngine(opCtx.get(),
+                                StorageEngineInitFlags::kAllowNoLockFile |
+                                    StorageEngineInitFlags::kSkipMetadataFile);
+        StorageControl::startStorageControls(_serviceContext, true /*forTestOnly*/);
+
+        DatabaseHolder::set(_serviceContext, std::make_unique<DatabaseHolderImpl>());
+        IndexAccessMethodFactory::set(_serviceContext,
+                                      std::make_unique<IndexAccessMethodFactoryImpl>());
+        Collection::Factory::set(_serviceContext, std::make_unique<CollectionImpl::FactoryImpl>());
+        IndexBuildsCoordinator::set(_serviceContext,
+                                    std::make_unique<IndexBuildsCoordinatorMongod>());
+        CollectionShardingStateFactory::set(
+            _serviceContext,
+            std::make_unique<CollectionShardingStateFactoryShard>(_serviceContext));
+        _serviceContext->getStorageEngine()->notifyStartupComplete();
+
+        ReplicationCoordinator::set(_serviceContext,
+                                    std::make_unique<ReplicationCoordinatorMock>(_serviceContext));
+        uassertStatusOK(
+            ReplicationCoordinator::get(_serviceContext)->setFollowerMode(MemberState::RS_PRIMARY));
+        StorageInterface::set(_serviceContext, std::make_unique<StorageInterfaceImpl>());
+        setOplogCollectionName(_serviceContext);
+        createOplog(opCtx.get());
+
+        // (Generic FCV reference): This FCV reference should exist across LTS binary versions.
+        serverGlobalParams.mutableFeatureCompatibility.setVersion(
+            ServerGlobalParams::FeatureCompatibility::kLatest);
+        VectorClockMutable::get(_serviceContext)->tickClusterTimeTo(LogicalTime(Timestamp(1, 0)));
+    }
+
+    ~OplogApplierBenchmarkEnvironment() {
+        auto client = _serviceContext->makeClient("oplog_applier_bm");
+        AlternativeClientRegion acr(client);
+        auto opCtx = cc().makeOperationContext();
+        IndexBuildsCoordinator::get(opCtx.get())->shutdown(opCtx.get());
+        {
+            Lock::GlobalLock lk(opCtx.get(), MODE_X);
+            DatabaseHolder::get(opCtx.get())->closeAll(opCtx.get());
+        }
+        opCtx.reset();
+        shutdownGlobalStorageEngineCleanly(_serviceContext);
+        CollectionShardingStateFactory::clear(_serviceContext);
+        StorageInterface::set(_serviceContext, {});
+    }
+
+    ServiceContext* const _serviceContext;
+    unittest::TempDir _tempDir{"oplog_applier_impl_bm"};
+    ReplicationConsistencyMarkersMock _consistencyMarkers;
+
+    int _numCollections = 0;
+    long long _lastSecond = 1;
+};
+
+/**
+ * Generates batches of CRUD oplog entries for one collection. Roughly 40% of the entries insert a
+ * new document, 40% update one of the seed documents, 10% delete a document inserted earlier and
+ * 10% are applyOps entries that each insert kOpsPerApplyOps new documents.
+ *
+ * 'conflictPercent' percent of the updates go to a single hot document rather than a random seed
+ * document. The applier serializes the operations on a document onto one writer, so this controls
+ * how much of the batch can be applied in parallel.
+ */
+class OplogGenerator {
+public:
+    OplogGenerator(OplogApplierBenchmarkEnvironment* env,
+                   NamespaceString nss,
+                   UUID uuid,
+                   int conflictPercent)
+        : _env(env),
+          _nss(std::move(nss)),
+          _uuid(std::move(uuid)),
+          _conflictPercent(conflictPercent) {}
+
+    /**
+     * Returns insert entries for the documents the updates go to.
+     */
+    std::vector<OplogEntry> makeSeedBatch() {
+        std::vector<OplogEntry> ops;
+        for (int i = 0; i < kNumSeedDocs; ++i) {
+            ops.push_back(makeCrudEntry(OpTypeEnum::kInsert, BSON("_id" << i << "a" << 0)));
+        }
+        return ops;
+    }
+
+    std::vector<OplogEntry> makeBatch() {
+        std::vector<OplogEntry> ops;
+        ops.reserve(kBatchSize);
+        while (ops.size() < kBatchSize) {
+            auto roll = _random.nextInt32(100);
+            if (roll < 40) {
+                ops.push_back(makeInsert());
+            } else if (roll < 80) {
+                const int id = _random.nextInt32(100) < _conflictPercent
+                    ? 0
+                    : _random.nextInt32(kNumSeedDocs);
+                ops.push_back(makeCrudEntry(OpTypeEnum::kUpdate,
+                                            BSON("$v" << 1 << "$set" << BSON("a" << roll)),
+                                            BSON("_id" << id)));
+            } else if (roll < 90 && !_deletableIds.empty()) {
+                const int id = _deletableIds.front();
+                _deletableIds.pop_front();
+                ops.push_back(makeCrudEntry(OpTypeEnum::kDelete, BSON("_id" << id)));
+            } else {
+                BSONArrayBuilder applyOps;
+                for (int i = 0; i < kOpsPerApplyOps; ++i) {
+                    applyOps.append(BSON("op"
+                                         << "i"
+                                         << "ns" << _nss.ns() << "ui" << _uuid << "o"
+                                         << BSON("_id" << _nextInsertId++)));
+                }
+                ops.push_back(makeCommandOplogEntry(_env->nextOpTime(),
+                                                    NamespaceString("admin.$cmd"),
+                                                    BSON("applyOps" << applyOps.arr())));
+            }
+        }
+        return ops;
+    }
+
+private:
+    OplogEntry makeCrudEntry(OpTypeEnum opType,
+                             BSONObj object,
+                             boost::optional<BSONObj> object2 = boost::none) {
+        return makeOplogEntry(_env->nextOpTime(),
+                              opType,
+                              _nss,
+                              std::move(object),
+                              std::move(object2),
+                              {},
+                              Date_t::now(),
+                              boost::none,
+                              _uuid);
+    }
+
+    OplogEntry makeInsert() {
+        const int id = _nextInsertId++;
+        _deletableIds.push_back(id);
+        return makeCrudEntry(OpTypeEnum::kInsert, BSON("_id" << id << "a" << 0));
+    }
+
+    OplogApplierBenchmarkEnvironment* const _env;
+    const NamespaceString _nss;
+    const UUID _uuid;
+    const int _conflictPercent;
+    PseudoRandom _random{1};
+
+    int _nextInsertId = kNumSeedDocs;
+    std::deque<int> _deletableIds;
+};
+
+/**
+ * OplogApplierImpl that records how long each writer thread spends applying its share of each
+ * batch.
+ */
+class TimedOplogApplier : public OplogApplierImpl {
+public:
+    using OplogApplierImpl::OplogApplierImpl;
+
+    /**
+     * Returns the time each writer thread has spent applying operations since the last call,
+     * busiest writer first.
+     */
+    std::vector<long long> takeBusyMicros() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        std::vector<long long> busyMicros;
+        for (auto&& [threadId, micros] : _busyMicros) {
+            busyMicros.push_back(micros);
+        }
+        _busyMicros.clear();
+        std::sort(busyMicros.rbegin(), busyMicros.rend());
+        return busyMicros;
+    }
+
+protected:
+    Status applyOplogBatchPerWorker(OperationContext* opCtx,
+                                    std::vector<const OplogEntry*>* ops,
+                                    WorkerMultikeyPathInfo* workerMultikeyPathInfo) override {
+        Timer timer;
+        auto status =
+            OplogApplierImpl::applyOplogBatchPerWorker(opCtx, ops, workerMultikeyPathInfo);
+        auto micros = timer.micros();
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        _busyMicros[stdx::this_thread::get_id()] += micros;
+        return status;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TimedOplogApplier::_mutex");
+    stdx::unordered_map<stdx::thread::id, long long> _busyMicros;
+};
+
+/**
+ * Applies one generated batch of kBatchSize entries per iteration through
+ * OplogApplierImpl::applyOplogBatch as a secondary would, with state.range(0) writer threads and
+ * state.range(1) percent of the updates conflicting on one document.
+ *
+ * Besides ops/sec, reports the fraction of the timed wall clock each writer thread spent applying
+ * operations, busiest writer first, and their average.
+ */
+void BM_ApplyOplogBatch(benchmark::State& state) {
+    auto& env = OplogApplierBenchmarkEnvironment::get();
+    auto client = getGlobalServiceContext()->makeClient("oplog_applier_bm");
+    AlternativeClientRegion acr(client);
+    auto opCtx = cc().makeOperationContext();
+
+    const int numWriters = state.range(0);
+    auto writerPool = makeReplWriterPool(numWriters);
+    TimedOplogApplier applier(nullptr,  // executor
+                              nullptr,  // oplogBuffer
+                              &noopOplogApplierObserver,
+                              ReplicationCoordinator::get(opCtx.get()),
+                              env.consistencyMarkers(),
+                              StorageInterface::get(opCtx.get()),
+                              OplogApplier::Options(OplogApplication::Mode::kSecondary),
+                              writerPool.get());
+
+    auto [nss, uuid] = env.makeCollection(opCtx.get());
+    OplogGenerator generator(&env, nss, uuid, state.range(1));
+    uassertStatusOK(applier.applyOplogBatch(opCtx.get(), generator.makeSeedBatch()).getStatus());
+    applier.takeBusyMicros();
+
+    long long applyMicros = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto batch = generator.makeBatch();
+        state.ResumeTiming();
+
+        Timer timer;
+        auto lastApplied = applier.applyOplogBatch(opCtx.get(), std::move(batch));
+        applyMicros += timer.micros();
+        if (!lastApplied.isOK()) {
+            state.SkipWithError(lastApplied.getStatus().toString().c_str());
+            break;
+        }
+
+        // Let the storage engine discard the history it no longer needs to keep.
+        state.PauseTiming();
+        opCtx->getServiceContext()->getStorageEngine()->setStableTimestamp(
+            lastApplied.getValue().getTimestamp());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+
+    auto busyMicros = applier.takeBusyMicros();
+    if (applyMicros == 0 || busyMicros.empty()) {
+        return;
+    }
+    double totalUtilization = 0;
+    for (size_t i = 0; i < busyMicros.size(); ++i) {
+        double utilization = static_cast<double>(busyMicros[i]) / applyMicros;
+        state.counters["writer" + std::to_string(i)] = utilization;
+        totalUtilization += utilization;
+    }
+    state.counters["writerAvg"] = totalUtilization / numWriters;
+}
+
+BENCHMARK(BM_ApplyOplogBatch)
+    ->ArgNames({"writers", "conflictPercent"})
+    ->Args({1, 0})
+    ->Args({4, 0})
+    ->Args({16, 0})
+    ->Args({16, 10})
+    ->Args({16, 50})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -67,6 +67,7 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/transaction_participant_gen.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -375,6 +376,8 @@ public:
     Status applyOplogBatchPerWorker(OperationContext* opCtx,
                                     std::vector<const OplogEntry*>* ops,
                                     WorkerMultikeyPathInfo* workerMultikeyPathInfo) override;
+
+    Mutex mutex = MONGO_MAKE_LATCH("TrackOpsAppliedApplier::mutex");
     std::vector<OplogEntry> operationsApplied;
 };
 
@@ -382,6 +385,7 @@ Status TrackOpsAppliedApplier::applyOplogBatchPerWorker(
     OperationContext* opCtx,
     std::vector<const OplogEntry*>* ops,
     WorkerMultikeyPathInfo* workerMultikeyPathInfo) {
+    stdx::lock_guard<Latch> lk(mutex);
     for (auto&& opPtr : *ops) {
         operationsApplied.push_back(*opPtr);
     }
@@ -435,6 +439,82 @@ bool _testOplogEntryIsForCappedCollection(OperationContext* opCtx,
     return opApplied.isForCappedCollection;
 }
 
+TEST_F(OplogApplierImplTest, MultiApplyAppliesEveryOpOnceInOrderForEachDocument) {
+    NamespaceString nss("test.t");
+    createCollection(_opCtx.get(), nss, {});
+
+    // Two ops for each document, so that the order of the ops of each document can be checked.
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 200; i++) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i), 1LL}, nss, BSON("_id" << (i % 100) << "a" << i)));
+    }
+
+    for (int vectorsPerThread : {1, 4, 64}) {
+        const int oldVectorsPerThread = replWriterVectorsPerThread.load();
+        replWriterVectorsPerThread.store(vectorsPerThread);
+        ON_BLOCK_EXIT([&] { replWriterVectorsPerThread.store(oldVectorsPerThread); });
+
+        auto writerPool = makeReplWriterPool();
+        NoopOplogApplierObserver observer;
+        TrackOpsAppliedApplier oplogApplier(
+            nullptr,  // executor
+            nullptr,  // oplogBuffer
+            &observer,
+            ReplicationCoordinator::get(_opCtx.get()),
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+            writerPool.get());
+        auto lastOpTime = unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops));
+        ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+
+        ASSERT_EQUALS(ops.size(), oplogApplier.operationsApplied.size());
+        stdx::unordered_map<int, Timestamp> lastApplied;
+        for (const auto& op : oplogApplier.operationsApplied) {
+            auto& last = lastApplied[op.getObject()["_id"].numberInt()];
+            ASSERT_LT(last, op.getTimestamp());
+            last = op.getTimestamp();
+        }
+        ASSERT_EQUALS(100U, lastApplied.size());
+    }
+}
+
+TEST_F(OplogApplierImplTest, MultiApplyMakesEachChunkOfTheBatchVisibleOnceApplied) {
+    NamespaceString nss("test.t");
+    createCollection(_opCtx.get(), nss, {});
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 5; i++) {
+        ops.push_back(makeInsertDocumentOplogEntry(
+            {Timestamp(Seconds(1), i + 1), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    const int oldVisibilityIntervalOps = replBatchReadVisibilityIntervalOps.load();
+    replBatchReadVisibilityIntervalOps.store(2);
+    ON_BLOCK_EXIT([&] { replBatchReadVisibilityIntervalOps.store(oldVisibilityIntervalOps); });
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    TrackOpsAppliedApplier oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+    auto lastOpTime = unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops));
+    ASSERT_EQUALS(ops.back().getOpTime(), lastOpTime);
+    ASSERT_EQUALS(ops.size(), oplogApplier.operationsApplied.size());
+
+    // The chunks before the last one are made visible by the applier, and the last one by the
+    // caller once the whole batch is applied.
+    ASSERT_EQUALS(ops[3].getOpTime(),
+                  ReplicationCoordinator::get(_opCtx.get())->getMyLastAppliedOpTime());
+}
+
 TEST_F(
     OplogApplierImplTest,
     MultiApplyDoesNotSetOplogEntryIsForCappedCollectionWhenProcessingNonCappedCollectionInsertOperation) {
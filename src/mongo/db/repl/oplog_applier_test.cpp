@@ -347,6 +347,45 @@ TEST_F(OplogApplierTest, LastOpInLargeTransactionIsProcessedIndividually) {
     ASSERT_EQUALS(srcOps[4], batch[0]);
 }
 
+TEST(OplogBatcherTest, AdaptiveBatchLimitMovesTowardsTargetApplyTime) {
+    const Milliseconds target(100);
+    const std::size_t maxOps = 5000;
+
+    // Starts from the limit on the number of operations, and moves halfway to the number of
+    // operations that would take the target time to apply.
+    ASSERT_EQUALS(3000U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      0, 5000, Milliseconds(500), target, maxOps));
+    ASSERT_EQUALS(2000U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      3000, 3000, Milliseconds(300), target, maxOps));
+
+    // Grows by at most half per batch, and no larger than the limit on the number of operations.
+    ASSERT_EQUALS(1500U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      1000, 1000, Milliseconds(10), target, maxOps));
+    ASSERT_EQUALS(1500U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      1000, 1000, Milliseconds(0), target, maxOps));
+    ASSERT_EQUALS(maxOps,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      4000, 4000, Milliseconds(10), target, maxOps));
+
+    // A batch which wasn't full and was applied within the target time leaves the limit as it is,
+    // but one which took too long shrinks it.
+    ASSERT_EQUALS(1000U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      1000, 10, Milliseconds(5), target, maxOps));
+    ASSERT_EQUALS(550U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      1000, 200, Milliseconds(200), target, maxOps));
+
+    // Never shrinks below a small minimum.
+    ASSERT_EQUALS(16U,
+                  OplogBatcher::computeAdaptiveBatchLimitOps(
+                      16, 16, Milliseconds(10000), target, maxOps));
+}
+
 }  // namespace
 }  // namespace repl
 }  // namespace mongo
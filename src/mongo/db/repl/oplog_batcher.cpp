@@ -263,6 +263,10 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
 
         // Check the limits once per batch since users can change them at runtime.
         batchLimits.ops = getBatchLimitOplogEntries();
+        if (auto adaptiveLimit = _adaptiveBatchLimitOps.load();
+            adaptiveLimit && replBatchTargetApplyMillis.load() > 0) {
+            batchLimits.ops = std::min(batchLimits.ops, std::size_t(adaptiveLimit));
+        }
 
         // Use the OplogBuffer to populate a local OplogBatch. Note that the buffer may be empty.
         OplogBatch ops(batchLimits.ops);
@@ -340,6 +344,54 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
     }
 }
 
+void OplogBatcher::recordBatchApplied(std::size_t numOps, Milliseconds applyTime) {
+    const Milliseconds targetApplyTime(replBatchTargetApplyMillis.load());
+    if (targetApplyTime <= Milliseconds(0)) {
+        _adaptiveBatchLimitOps.store(0);
+        return;
+    }
+
+    // Only the batcher thread reads the limit, and only the applier thread updates it.
+    auto limit = computeAdaptiveBatchLimitOps(_adaptiveBatchLimitOps.load(),
+                                              numOps,
+                                              applyTime,
+                                              targetApplyTime,
+                                              getBatchLimitOplogEntries());
+    _adaptiveBatchLimitOps.store(limit);
+}
+
+std::size_t OplogBatcher::computeAdaptiveBatchLimitOps(std::size_t currentLimit,
+                                                       std::size_t numOps,
+                                                       Milliseconds applyTime,
+                                                       Milliseconds targetApplyTime,
+                                                       std::size_t maxOps) {
+    // Batches are never limited to fewer operations than this, so that the fixed cost of
+    // applying each batch doesn't come to dominate.
+    const std::size_t kMinBatchLimitOps = 16;
+    const std::size_t minOps = std::min(kMinBatchLimitOps, maxOps);
+
+    if (currentLimit == 0 || currentLimit > maxOps) {
+        currentLimit = maxOps;
+    }
+
+    // A batch which wasn't full and took less than the target time to apply says little about how
+    // many operations could be applied in the target time.
+    if (numOps < currentLimit && applyTime <= targetApplyTime) {
+        return std::max(minOps, currentLimit);
+    }
+
+    // A full batch too quick to measure could have been at least twice as large.
+    std::size_t desired = currentLimit * 2;
+    if (applyTime > Milliseconds(0)) {
+        desired = std::min(desired,
+                           static_cast<std::size_t>(static_cast<double>(numOps) *
+                                                    durationCount<Milliseconds>(targetApplyTime) /
+                                                    durationCount<Milliseconds>(applyTime)));
+    }
+    desired = currentLimit / 2 + desired / 2;
+    return std::max(minOps, std::min(desired, maxOps));
+}
+
 std::size_t getBatchLimitOplogEntries() {
     return std::size_t(replBatchLimitOperations.load());
 }
@@ -32,9 +32,11 @@
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/invariant.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace repl {
@@ -185,6 +187,28 @@ public:
      */
     static std::size_t getOpCount(const OplogEntry& entry);
 
+    /**
+     * Records that the applier took 'applyTime' to apply a batch of 'numOps' operations. When
+     * replBatchTargetApplyMillis is set, the limit on the number of operations in the next batches
+     * is adjusted towards the number of operations the applier can apply in that time.
+     */
+    void recordBatchApplied(std::size_t numOps, Milliseconds applyTime);
+
+    /**
+     * Returns the limit on the number of operations in the next batch, given the current limit
+     * 'currentLimit' (0 if there is none yet), that a batch of 'numOps' operations took
+     * 'applyTime' to apply, and that batches should take 'targetApplyTime'. The limit moves
+     * halfway to the number of operations that would take 'targetApplyTime' at the rate of the
+     * last batch, grows by at most half per batch, and stays between a small minimum and
+     * 'maxOps'. A batch which wasn't full and was applied within 'targetApplyTime' leaves the
+     * limit as it is.
+     */
+    static std::size_t computeAdaptiveBatchLimitOps(std::size_t currentLimit,
+                                                    std::size_t numOps,
+                                                    Milliseconds applyTime,
+                                                    Milliseconds targetApplyTime,
+                                                    std::size_t maxOps);
+
 private:
     /**
      * If slaveDelay is enabled, this function calculates the most recent timestamp of any oplog
@@ -210,6 +234,10 @@ private:
      */
     OplogBatch _ops;
 
+    // The limit on the number of operations in a batch computed from the time taken to apply the
+    // previous batches, or 0 if there is none.
+    AtomicWord<unsigned long long> _adaptiveBatchLimitOps{0};
+
     std::unique_ptr<stdx::thread> _thread;
 };
 
@@ -348,6 +348,10 @@ void OplogFetcher::_runQuery(const executor::TaskExecutor::CallbackArgs& callbac
     {
         stdx::lock_guard<Latch> lock(_mutex);
         _conn = _createClientFn();
+
+        // The sync source compresses the batches of the oplog it sends in the compressor the
+        // connection negotiates first. Cross-region members benefit from the denser compressors.
+        _conn->getCompressorManager().setClientPreferredCompressor(oplogFetcherPreferredCompressor);
     }
 
     hangAfterOplogFetcherCallbackScheduled.pauseWhileSet();
@@ -4515,10 +4515,28 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
+    // The waiters are visited in optime order, and a write concern which isn't satisfied at an
+    // optime isn't satisfied at any later one either. So once most waiters share a write concern,
+    // such as w:majority, only the first of them which must keep waiting is checked.
+    std::vector<WriteConcernOptions> unsatisfiedWriteConcerns;
     _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        [&](const OpTime& waiterOpTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            const auto& writeConcern = waiter->writeConcern.get();
+            if (std::any_of(unsatisfiedWriteConcerns.begin(),
+                            unsatisfiedWriteConcerns.end(),
+                            [&](const WriteConcernOptions& unsatisfied) {
+                                return unsatisfied.wNumNodes == writeConcern.wNumNodes &&
+                                    unsatisfied.wMode == writeConcern.wMode &&
+                                    unsatisfied.syncMode == writeConcern.syncMode;
+                            })) {
+                return false;
+            }
+            if (_doneWaitingForReplication_inlock(waiterOpTime, writeConcern)) {
+                return true;
+            }
+            unsatisfiedWriteConcerns.push_back(writeConcern);
+            return false;
         },
         opTime);
 }
@@ -1122,6 +1122,59 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesLaterWaitersWhenAnEarlierWaiterWithAnotherWriteConcernWaits) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 2);
+    OpTimeWithTermOne time2(100, 3);
+    OpTimeWithTermOne time3(100, 4);
+
+    WriteConcernOptions twoNodes;
+    twoNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    twoNodes.wNumNodes = 2;
+    WriteConcernOptions threeNodes = twoNodes;
+    threeNodes.wNumNodes = 3;
+
+    // The waiters for two nodes are on either side of the one for all three.
+    ReplicationAwaiter awaiter1(getReplCoord(), getServiceContext());
+    awaiter1.setOpTime(time1);
+    awaiter1.setWriteConcern(twoNodes);
+    awaiter1.start();
+    ReplicationAwaiter awaiter2(getReplCoord(), getServiceContext());
+    awaiter2.setOpTime(time2);
+    awaiter2.setWriteConcern(threeNodes);
+    awaiter2.start();
+    ReplicationAwaiter awaiter3(getReplCoord(), getServiceContext());
+    awaiter3.setOpTime(time3);
+    awaiter3.setWriteConcern(twoNodes);
+    awaiter3.start();
+
+    replCoordSetMyLastAppliedOpTime(time3, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time3, Date_t() + Seconds(100));
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time3));
+    ASSERT_OK(awaiter1.getResult().status);
+    ASSERT_OK(awaiter3.getResult().status);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time2));
+    ASSERT_OK(awaiter2.getResult().status);
+}
+
 TEST_F(ReplCoordTest, NodeReturnsWriteConcernFailedWhenAWriteConcernTimesOutBeforeBeingSatisified) {
     assertStartSuccess(BSON("_id"
                             << "mySet"
@@ -63,6 +63,7 @@
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_config_version.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -1113,6 +1114,7 @@ boost::optional<BSONObj> RollbackImpl::_findDocumentById(OperationContext* opCtx
 Status RollbackImpl::_writeRollbackFiles(OperationContext* opCtx) {
     const auto& catalog = CollectionCatalog::get(opCtx);
     auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    std::vector<std::tuple<UUID, NamespaceString, const SimpleBSONObjUnorderedSet*>> namespaces;
     for (auto&& entry : _observerInfo.rollbackDeletedIdsMap) {
         const auto& uuid = entry.first;
         const auto nss = catalog.lookupNSSByUUID(opCtx, uuid);
@@ -1134,9 +1136,38 @@ Status RollbackImpl::_writeRollbackFiles(OperationContext* opCtx) {
                   str::stream() << "The collection with UUID " << uuid
                                 << " is unexpectedly missing in the CollectionCatalog");
 
-        _writeRollbackFileForNamespace(opCtx, uuid, *nss, entry.second);
+        namespaces.emplace_back(uuid, *nss, &entry.second);
     }
 
+    const size_t numThreads =
+        std::min(static_cast<size_t>(gRollbackDataFileWriterThreads.load()), namespaces.size());
+    if (numThreads <= 1) {
+        for (auto&& [uuid, nss, idSet] : namespaces) {
+            _writeRollbackFileForNamespace(opCtx, uuid, nss, *idSet);
+        }
+        return Status::OK();
+    }
+
+    // The rollback files of several collections are written at once, each on its own thread.
+    ThreadPool::Options options;
+    options.threadNamePrefix = "RollbackDataFileWriter-";
+    options.poolName = "RollbackDataFileWriterThreadPool";
+    options.maxThreads = options.minThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName);
+    };
+    ThreadPool pool(options);
+    pool.startup();
+    for (auto&& [uuid, nss, idSet] : namespaces) {
+        pool.schedule([this, uuid = uuid, nss = nss, idSet = idSet](auto status) {
+            invariant(status);
+            auto opCtx = cc().makeOperationContext();
+            _writeRollbackFileForNamespace(opCtx.get(), uuid, nss, *idSet);
+        });
+    }
+    pool.shutdown();
+    pool.join();
+
     return Status::OK();
 }
 
@@ -1165,6 +1196,7 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
     // If this is the first data directory created, we save the full directory path in
     // _rollbackStats. Otherwise, we store the longest common prefix of the two directories.
     const auto& newDirectoryPath = removeSaver.root().generic_string();
+    stdx::unique_lock<Latch> lk(_rollbackDataFileMutex);
     if (!_rollbackStats.rollbackDataFileDirectory) {
         _rollbackStats.rollbackDataFileDirectory = newDirectoryPath;
     } else {
@@ -1176,6 +1208,7 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
                                     .first;
         _rollbackStats.rollbackDataFileDirectory = std::string(newDirectoryPath.begin(), prefixEnd);
     }
+    lk.unlock();
 
     for (auto&& id : idSet) {
         // StorageInterface::findById() does not respect the collation, but because we are using
@@ -1186,6 +1219,7 @@ void RollbackImpl::_writeRollbackFileForNamespace(OperationContext* opCtx,
             fassert(50750, removeSaver.goingToDelete(*document));
         }
     }
+    stdx::lock_guard<Latch> listenerLock(_rollbackDataFileMutex);
     _listener->onRollbackFileWrittenForNamespace(std::move(uuid), std::move(nss));
 }
 
@@ -431,6 +431,9 @@ private:
      * Before each namespace is examined, we check for interrupt and return a non-OK status if
      * shutdown is in progress.
      *
+     * The files of up to 'rollbackDataFileWriterThreads' namespaces are written concurrently, each
+     * by a thread of a pool created for the occasion.
+     *
      * This function causes the server to terminate if an error occurs while fetching documents from
      * disk or while writing documents to the rollback file. It must be called before marking the
      * oplog truncate point, and before the storage engine recovers to the stable timestamp.
@@ -475,6 +478,10 @@ private:
     // method.
     OpObserver::RollbackObserverInfo _observerInfo = {};  // (N)
 
+    // Serializes the updates made to '_rollbackStats' and the calls to '_listener' while the
+    // rollback files of several namespaces are being written.
+    Mutex _rollbackDataFileMutex = MONGO_MAKE_LATCH("RollbackImpl::_rollbackDataFileMutex");
+
     // Holds information about this rollback event.
     RollbackStats _rollbackStats;  // (N)
 
@@ -44,6 +44,7 @@
 #include "mongo/db/repl/oplog_interface_local.h"
 #include "mongo/db/repl/oplog_interface_mock.h"
 #include "mongo/db/repl/rollback_impl.h"
+#include "mongo/db/repl/rollback_impl_gen.h"
 #include "mongo/db/repl/rollback_test_fixture.h"
 #include "mongo/db/s/shard_identity_rollback_notifier.h"
 #include "mongo/db/s/type_shard_identity.h"
@@ -55,6 +56,7 @@
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/uuid.h"
 
 namespace {
@@ -124,13 +126,17 @@ protected:
                       id.jsonString(JsonStringFormat::LegacyStrict));
             auto document = _findDocumentById(opCtx, uuid, nss, id.firstElement());
             if (document) {
+                stdx::lock_guard<Latch> lk(_uuidToObjsMapMutex);
                 _uuidToObjsMap[uuid].push_back(*document);
             }
         }
+        stdx::lock_guard<Latch> lk(_uuidToObjsMapMutex);
         _listener->onRollbackFileWrittenForNamespace(std::move(uuid), std::move(nss));
     }
 
 private:
+    // Rollback files for several namespaces may be written at once.
+    Mutex _uuidToObjsMapMutex = MONGO_MAKE_LATCH("RollbackImplForTest::_uuidToObjsMapMutex");
     stdx::unordered_map<UUID, std::vector<BSONObj>, UUID::Hash> _uuidToObjsMap;
 };
 
@@ -969,6 +975,36 @@ TEST_F(RollbackImplTest, RollbackSavesInsertedDocumentToFile) {
     ASSERT_BSONOBJ_EQ(deletedObjs.front(), obj);
 }
 
+TEST_F(RollbackImplTest, RollbackSavesInsertedDocumentsOfSeveralCollectionsToFilesConcurrently) {
+    const auto oldThreads = gRollbackDataFileWriterThreads.load();
+    gRollbackDataFileWriterThreads.store(2);
+    ON_BLOCK_EXIT([&] { gRollbackDataFileWriterThreads.store(oldThreads); });
+
+    const auto commonOp = makeOpAndRecordId(1);
+    _remoteOplog->setOperations({commonOp});
+    ASSERT_OK(_insertOplogEntry(commonOp.first));
+    _storageInterface->setStableTimestamp(nullptr, Timestamp(1, 1));
+
+    std::vector<std::pair<UUID, BSONObj>> inserted;
+    for (int i = 0; i < 3; ++i) {
+        const auto nss = NamespaceString("db.people" + std::to_string(i));
+        const auto uuid = UUID::gen();
+        const auto coll = _initializeCollection(_opCtx.get(), uuid, nss);
+        const auto obj = BSON("_id" << i << "name"
+                                    << "kyle");
+        _insertDocAndGenerateOplogEntry(obj, uuid, nss);
+        inserted.emplace_back(uuid, obj);
+    }
+
+    ASSERT_OK(_rollback->runRollback(_opCtx.get()));
+
+    for (auto&& [uuid, obj] : inserted) {
+        const auto& deletedObjs = _rollback->docsDeletedForNamespace_forTest(uuid);
+        ASSERT_EQ(deletedObjs.size(), 1UL);
+        ASSERT_BSONOBJ_EQ(deletedObjs.front(), obj);
+    }
+}
+
 TEST_F(RollbackImplTest, RollbackSavesLatestVersionOfDocumentWhenThereAreMultipleInserts) {
     const auto commonOp = makeOpAndRecordId(1);
     _remoteOplog->setOperations({commonOp});
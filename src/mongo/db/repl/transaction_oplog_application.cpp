@@ -45,6 +45,7 @@
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace mongo {
 using repl::OplogEntry;
@@ -63,19 +64,30 @@ MONGO_FAIL_POINT_DEFINE(applyPrepareTxnOpsFailsWithWriteConflict);
 Status _applyOperationsForTransaction(OperationContext* opCtx,
                                       const std::vector<OplogEntry>& ops,
                                       repl::OplogApplication::Mode oplogApplicationMode) noexcept {
+    // The collection is kept locked and looked up for as long as consecutive operations of the
+    // transaction are on it. A transaction holds its locks until it commits or aborts anyway.
+    boost::optional<AutoGetCollection> coll;
+    NamespaceString collNss;
+
     // Apply each the operations via repl::applyOperation.
     for (const auto& op : ops) {
         try {
             // Presently, it is not allowed to run a prepared transaction with a command
             // inside. TODO(SERVER-46105)
             invariant(!op.isCommand());
-            AutoGetCollection coll(opCtx, op.getNss(), MODE_IX);
+            if (!coll || collNss != op.getNss()) {
+                coll.reset();
+                coll.emplace(opCtx, op.getNss(), MODE_IX);
+                collNss = op.getNss();
+            }
             auto status = repl::applyOperation_inlock(
-                opCtx, coll.getDb(), &op, false /*alwaysUpsert*/, oplogApplicationMode);
+                opCtx, coll->getDb(), &op, false /*alwaysUpsert*/, oplogApplicationMode);
             if (!status.isOK()) {
                 return status;
             }
         } catch (const DBException& ex) {
+            coll.reset();
+
             // Ignore NamespaceNotFound errors if we are in initial sync or recovering mode.
             const bool ignoreException = ex.code() == ErrorCodes::NamespaceNotFound &&
                 (oplogApplicationMode == repl::OplogApplication::Mode::kInitialSync ||
@@ -391,10 +403,15 @@ Status _applyPrepareTransaction(OperationContext* opCtx,
     // This blocking behavior can also introduce a deadlock with two-phase index builds on
     // a secondary if a prepared transaction blocks on an index build, but the index build can't
     // re-acquire its X lock because of the transaction.
+    // Each collection is only checked once, however many of the transaction's operations are on it.
+    stdx::unordered_set<UUID, UUID::Hash> checkedCollections;
     for (const auto& op : ops) {
         auto indexBuildsCoord = IndexBuildsCoordinator::get(opCtx);
         auto ns = op.getNss();
         auto uuid = *op.getUuid();
+        if (!checkedCollections.insert(uuid).second) {
+            continue;
+        }
         if (indexBuildsCoord->inProgForCollection(uuid, IndexBuildProtocol::kSinglePhase)) {
             LOGV2_WARNING(21849,
                           "Blocking replication until single-phase index builds are finished on "
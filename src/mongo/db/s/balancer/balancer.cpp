@@ -84,6 +84,7 @@ const Seconds kShortBalanceRoundInterval(1);
 static constexpr StringData kBalancerPolicyStatusDraining = "draining"_sd;
 static constexpr StringData kBalancerPolicyStatusZoneViolation = "zoneViolation"_sd;
 static constexpr StringData kBalancerPolicyStatusChunksImbalance = "chunksImbalance"_sd;
+static constexpr StringData kBalancerPolicyStatusLoadImbalance = "loadImbalance"_sd;
 
 /**
  * Utility class to generate timing and statistics for a single balancer round.
@@ -777,6 +778,8 @@ Balancer::BalancerStatus Balancer::getBalancerStatusForNs(OperationContext* opCt
             return {false, kBalancerPolicyStatusZoneViolation.toString()};
         case MigrateInfo::chunksImbalance:
             return {false, kBalancerPolicyStatusChunksImbalance.toString()};
+        case MigrateInfo::loadImbalance:
+            return {false, kBalancerPolicyStatusLoadImbalance.toString()};
     }
 
     return {true, boost::none};
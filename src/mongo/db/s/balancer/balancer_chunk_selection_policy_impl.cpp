@@ -397,8 +397,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        auto candidatesStatus =
-            _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+        auto candidatesStatus = _getMigrateCandidatesForCollection(
+            opCtx, nss, shardStats, &usedShards, balancerMigrateHotChunks.load());
         if (candidatesStatus == ErrorCodes::NamespaceNotFound) {
             // Namespace got dropped before we managed to get to it, so just skip it
             continue;
@@ -443,7 +443,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
 
     std::set<ShardId> usedShards;
 
-    auto candidatesStatus = _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards);
+    auto candidatesStatus =
+        _getMigrateCandidatesForCollection(opCtx, nss, shardStats, &usedShards, false);
     if (!candidatesStatus.isOK()) {
         return candidatesStatus.getStatus();
     }
@@ -563,7 +564,8 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
     OperationContext* opCtx,
     const NamespaceString& nss,
     const ShardStatisticsVector& shardStats,
-    std::set<ShardId>* usedShards) {
+    std::set<ShardId>* usedShards,
+    bool considerHotChunks) {
     auto routingInfoStatus =
         Grid::get(opCtx)->catalogCache()->getShardedCollectionRoutingInfoWithRefresh(opCtx, nss);
     if (!routingInfoStatus.isOK()) {
@@ -616,11 +618,38 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::_getMigrateCandi
         }
     }
 
-    return BalancerPolicy::balance(
+    auto migrations = BalancerPolicy::balance(
         shardStats,
         distribution,
         usedShards,
         Grid::get(opCtx)->getBalancerConfiguration()->attemptToBalanceJumboChunks());
+    if (!migrations.empty() || !considerHotChunks) {
+        return migrations;
+    }
+
+    // Leave out the shards whose last reported write heat may still include load which an earlier
+    // hot chunk migration has already moved
+    auto excludedShards = *usedShards;
+    for (const auto& stat : shardStats) {
+        const auto it = _lastHotChunkMigrations.find(stat.shardId);
+        if (it != _lastHotChunkMigrations.end() &&
+            (!stat.heatWindowStart || *stat.heatWindowStart <= it->second)) {
+            excludedShards.insert(stat.shardId);
+        }
+    }
+
+    auto hotChunkMigration = BalancerPolicy::balanceHotChunk(
+        shardStats, distribution, balancerHotShardLoadRatio.load(), excludedShards);
+    if (hotChunkMigration) {
+        const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        _lastHotChunkMigrations[hotChunkMigration->from] = now;
+        _lastHotChunkMigrations[hotChunkMigration->to] = now;
+        usedShards->insert(hotChunkMigration->from);
+        usedShards->insert(hotChunkMigration->to);
+        migrations.push_back(std::move(*hotChunkMigration));
+    }
+
+    return migrations;
 }
 
 }  // namespace mongo
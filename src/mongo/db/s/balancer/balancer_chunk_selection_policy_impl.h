@@ -70,13 +70,15 @@ private:
 
     /**
      * Synchronous method, which iterates the collection's chunks and uses the cluster statistics to
-     * figure out where to place them.
+     * figure out where to place them. If 'considerHotChunks' is true and the collection's chunk
+     * counts are balanced, may suggest migrating one of its hot chunks instead.
      */
     StatusWith<MigrateInfoVector> _getMigrateCandidatesForCollection(
         OperationContext* opCtx,
         const NamespaceString& nss,
         const ShardStatisticsVector& shardStats,
-        std::set<ShardId>* usedShards);
+        std::set<ShardId>* usedShards,
+        bool considerHotChunks);
 
     // Source for obtaining cluster statistics. Not owned and must not be destroyed before the
     // policy object is destroyed.
@@ -84,6 +86,11 @@ private:
 
     // Source of randomness when metadata needs to be randomized.
     BalancerRandomSource& _random;
+
+    // When each shard last took part in a hot chunk migration. Its write heat is not used again
+    // until it reports a window which started after that, so that the balancer doesn't act twice
+    // on the load the first migration already moved. Only accessed by the balancer round.
+    std::map<ShardId, Date_t> _lastHotChunkMigrations;
 };
 
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
@@ -558,6 +559,68 @@ boost::optional<MigrateInfo> BalancerPolicy::balanceSingleChunk(
         newShardId, chunk, MoveChunkRequest::ForceJumbo::kDoNotForce, MigrateInfo::chunksImbalance);
 }
 
+boost::optional<MigrateInfo> BalancerPolicy::balanceHotChunk(
+    const ShardStatisticsVector& shardStats,
+    const DistributionStatus& distribution,
+    double loadRatio,
+    const set<ShardId>& excludedShards) {
+    const auto isCandidate = [&](const ClusterStatistics::ShardStatistics& stat) {
+        return stat.heatWindowStart && !excludedShards.count(stat.shardId);
+    };
+
+    const ClusterStatistics::ShardStatistics* hottest = nullptr;
+    for (const auto& stat : shardStats) {
+        if (isCandidate(stat) && (!hottest || stat.operations > hottest->operations)) {
+            hottest = &stat;
+        }
+    }
+
+    if (!hottest || hottest->operations < kMinHotShardOperations) {
+        return boost::none;
+    }
+
+    const auto& donorChunks = distribution.getChunks(hottest->shardId);
+    for (const auto& hotChunk : hottest->hotChunks) {
+        if (hotChunk.nss != distribution.nss()) {
+            continue;
+        }
+
+        // The chunk may have been split or moved since the shard counted its writes
+        const auto chunkIt =
+            std::find_if(donorChunks.begin(), donorChunks.end(), [&](const ChunkType& chunk) {
+                return chunk.getMin().woCompare(hotChunk.min) == 0;
+            });
+        if (chunkIt == donorChunks.end() || chunkIt->getJumbo()) {
+            continue;
+        }
+
+        const string tag = distribution.getTagForChunk(*chunkIt);
+
+        const ClusterStatistics::ShardStatistics* coldest = nullptr;
+        for (const auto& stat : shardStats) {
+            if (stat.shardId == hottest->shardId || !isCandidate(stat) ||
+                !isShardSuitableReceiver(stat, tag).isOK()) {
+                continue;
+            }
+            if (!coldest || stat.operations < coldest->operations) {
+                coldest = &stat;
+            }
+        }
+
+        if (!coldest || hottest->operations < coldest->operations * loadRatio ||
+            coldest->operations + 2 * hotChunk.operations > hottest->operations) {
+            continue;
+        }
+
+        return MigrateInfo(coldest->shardId,
+                           *chunkIt,
+                           MoveChunkRequest::ForceJumbo::kDoNotForce,
+                           MigrateInfo::loadImbalance);
+    }
+
+    return boost::none;
+}
+
 bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
                                         const DistributionStatus& distribution,
                                         const string& tag,
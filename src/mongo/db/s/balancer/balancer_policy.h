@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, loadImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -210,6 +210,24 @@ public:
                                                            const ShardStatisticsVector& shardStats,
                                                            const DistributionStatus& distribution);
 
+    /**
+     * Returns a suggested migration of one of the collection's hot chunks away from the shard,
+     * which received the most writes over its last reported chunk heat window, to the suitable
+     * shard which received the fewest. Only applies if the former received at least 'loadRatio'
+     * times as many writes as the latter and at least kMinHotShardOperations of them. Chunks whose
+     * writes would make the receiver hotter than the donor becomes are never moved, so a single
+     * chunk which takes most of a shard's load stays in place.
+     *
+     * Shards which have not reported a heat window and those in 'excludedShards' are not used.
+     */
+    static boost::optional<MigrateInfo> balanceHotChunk(const ShardStatisticsVector& shardStats,
+                                                        const DistributionStatus& distribution,
+                                                        double loadRatio,
+                                                        const std::set<ShardId>& excludedShards);
+
+    // The minimum number of writes in a heat window for a shard to be considered hot
+    static constexpr uint64_t kMinHotShardOperations = 1000;
+
 private:
     /**
      * Return the shard with the specified tag, which has the least number of chunks. If the tag is
@@ -843,5 +843,89 @@ TEST(DistributionStatus, ChunkTagsSelectorWithMinMaxKeys) {
     }
 }
 
+/**
+ * Sets the write heat reported by the shard at 'index', with its hottest chunks given as pairs of
+ * the chunk's min value of 'x' and the number of writes to it.
+ */
+void setShardHeat(ShardStatisticsVector* shardStats,
+                  size_t index,
+                  uint64_t operations,
+                  const vector<std::pair<int, uint64_t>>& hotChunks = {}) {
+    auto& stat = (*shardStats)[index];
+    stat.heatWindowStart = Date_t::fromMillisSinceEpoch(1000);
+    stat.operations = operations;
+    for (const auto& hotChunk : hotChunks) {
+        stat.hotChunks.push_back({kNamespace, BSON("x" << hotChunk.first), hotChunk.second});
+    }
+}
+
+TEST(BalancerPolicy, HotChunkMovesToLeastWrittenShard) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId2, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+    setShardHeat(&cluster.first, 0, 10000, {{1, 3000}});
+    setShardHeat(&cluster.first, 1, 2000);
+    setShardHeat(&cluster.first, 2, 1000);
+
+    const auto migration = BalancerPolicy::balanceHotChunk(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), 2.0, {});
+    ASSERT(migration);
+    ASSERT_EQ(kShardId0, migration->from);
+    ASSERT_EQ(kShardId2, migration->to);
+    ASSERT_BSONOBJ_EQ(BSON("x" << 1), migration->minKey);
+    ASSERT_EQ(MigrateInfo::loadImbalance, migration->reason);
+}
+
+TEST(BalancerPolicy, HotChunkTakingMostOfTheLoadDoesNotMove) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+    setShardHeat(&cluster.first, 0, 10000, {{1, 6000}});
+    setShardHeat(&cluster.first, 1, 1000);
+
+    ASSERT(!BalancerPolicy::balanceHotChunk(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), 2.0, {}));
+}
+
+TEST(BalancerPolicy, HotChunkDoesNotMoveBelowLoadRatio) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+    setShardHeat(&cluster.first, 0, 3000, {{1, 500}});
+    setShardHeat(&cluster.first, 1, 2000);
+
+    ASSERT(!BalancerPolicy::balanceHotChunk(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), 2.0, {}));
+}
+
+TEST(BalancerPolicy, HotChunkSkipsShardsWithoutHeatAndExcludedShards) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId2, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+    setShardHeat(&cluster.first, 0, 10000, {{1, 3000}});
+    setShardHeat(&cluster.first, 1, 2000);
+    DistributionStatus distribution(kNamespace, cluster.second);
+
+    // The shard which has not reported any heat is not chosen, even though it may be idle
+    const auto migration = BalancerPolicy::balanceHotChunk(cluster.first, distribution, 2.0, {});
+    ASSERT(migration);
+    ASSERT_EQ(kShardId1, migration->to);
+
+    ASSERT(!BalancerPolicy::balanceHotChunk(cluster.first, distribution, 2.0, {kShardId1}));
+}
+
+TEST(BalancerPolicy, HotChunkWhichNoLongerExistsDoesNotMove) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+    setShardHeat(&cluster.first, 0, 10000, {{2, 3000}});
+    setShardHeat(&cluster.first, 1, 1000);
+
+    ASSERT(!BalancerPolicy::balanceHotChunk(
+        cluster.first, DistributionStatus(kNamespace, cluster.second), 2.0, {}));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -34,7 +34,10 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/s/client/shard.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -93,6 +96,24 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        /**
+         * A chunk reported by the shard as one of its hottest, identified by its min key.
+         */
+        struct HotChunk {
+            NamespaceString nss;
+            BSONObj min;
+            uint64_t operations{0};
+        };
+
+        // Start of the last complete window over which the shard counted the writes to its
+        // chunks. Not set if the shard has not reported one.
+        boost::optional<Date_t> heatWindowStart;
+
+        // Number of writes to the shard during that window, and its hottest chunks during it, most
+        // written first
+        uint64_t operations{0};
+        std::vector<HotChunk> hotChunks;
     };
 
     virtual ~ClusterStatistics();
@@ -48,17 +48,21 @@
 namespace mongo {
 namespace {
 
+using ShardStatistics = ClusterStatistics::ShardStatistics;
+
 const char kVersionField[] = "version";
 
 /**
  * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * running MongoD service, along with the write heat the shard reports in 'stats'.
  *
  * Returns the MongoD version in strig format or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
  *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx,
+                                                   ShardId shardId,
+                                                   ShardStatistics* stats) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -81,6 +85,20 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
 
     BSONObj serverStatus = std::move(commandResponse.getValue().response);
 
+    // Shards which don't count chunk heat, or have not completed a window yet, leave it unset
+    const auto chunkHeat = serverStatus["shardingStatistics"]["chunkHeat"];
+    if (chunkHeat.type() == Object && chunkHeat["windowStart"].type() == Date &&
+        chunkHeat["hottestChunks"].type() == Array) {
+        stats->heatWindowStart = chunkHeat["windowStart"].date();
+        stats->operations = chunkHeat["operations"].safeNumberLong();
+        for (const auto& hotChunk : chunkHeat["hottestChunks"].Obj()) {
+            stats->hotChunks.push_back({NamespaceString(hotChunk["ns"].str()),
+                                        hotChunk["min"].Obj().getOwned(),
+                                        static_cast<uint64_t>(
+                                            hotChunk["operations"].safeNumberLong())});
+        }
+    }
+
     std::string version;
     Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
     if (!status.isOK()) {
@@ -92,8 +110,6 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
 
 }  // namespace
 
-using ShardStatistics = ClusterStatistics::ShardStatistics;
-
 ClusterStatisticsImpl::ClusterStatisticsImpl(BalancerRandomSource& random) : _random(random) {}
 
 ClusterStatisticsImpl::~ClusterStatisticsImpl() = default;
@@ -133,21 +149,6 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                                       << shard.getName());
         }
 
-        std::string mongoDVersion;
-
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
-        if (mongoDVersionStatus.isOK()) {
-            mongoDVersion = std::move(mongoDVersionStatus.getValue());
-        } else {
-            // Since the mongod version is only used for reporting, there is no need to fail the
-            // entire round if it cannot be retrieved, so just leave it empty
-            LOGV2(21895,
-                  "Unable to obtain shard version for {shardId}: {error}",
-                  "Unable to obtain shard version",
-                  "shardId"_attr = shard.getName(),
-                  "error"_attr = mongoDVersionStatus.getStatus());
-        }
-
         std::set<std::string> shardTags;
 
         for (const auto& shardTag : shard.getTags()) {
@@ -159,7 +160,21 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shardSizeStatus.getValue() / 1024 / 1024,
                            shard.getDraining(),
                            std::move(shardTags),
-                           std::move(mongoDVersion));
+                           std::string());
+
+        auto mongoDVersionStatus =
+            retrieveShardMongoDVersion(opCtx, shard.getName(), &stats.back());
+        if (mongoDVersionStatus.isOK()) {
+            stats.back().mongoVersion = std::move(mongoDVersionStatus.getValue());
+        } else {
+            // Since the mongod version is only used for reporting, there is no need to fail the
+            // entire round if it cannot be retrieved, so just leave it empty
+            LOGV2(21895,
+                  "Unable to obtain shard version for {shardId}: {error}",
+                  "Unable to obtain shard version",
+                  "shardId"_attr = shard.getName(),
+                  "error"_attr = mongoDVersionStatus.getStatus());
+        }
     }
 
     return stats;
@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/chunk_heat_statistics.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getChunkHeatStatistics = ServiceContext::declareDecoration<ChunkHeatStatistics>();
+
+}  // namespace
+
+ChunkHeatStatistics& ChunkHeatStatistics::get(ServiceContext* serviceContext) {
+    return getChunkHeatStatistics(serviceContext);
+}
+
+ChunkHeatStatistics& ChunkHeatStatistics::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void ChunkHeatStatistics::recordOperations(const NamespaceString& nss,
+                                           const ChunkRange& range,
+                                           uint64_t operations,
+                                           Date_t now) {
+    const auto& min = range.getMin();
+    std::string key = nss.ns();
+    key.push_back('\0');
+    key.append(min.objdata(), min.objsize());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    _rotateIfNeeded(lk, now);
+
+    _current.operations += operations;
+
+    auto it = _current.chunks.find(key);
+    if (it == _current.chunks.end()) {
+        if (_current.chunks.size() >= kMaxTrackedChunks) {
+            return;
+        }
+        it = _current.chunks.emplace(std::move(key), ChunkHeat{nss, range, 0}).first;
+    }
+    it->second.operations += operations;
+}
+
+void ChunkHeatStatistics::report(BSONObjBuilder* builder, Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _rotateIfNeeded(lk, now);
+
+    BSONObjBuilder heatBuilder(builder->subobjStart("chunkHeat"));
+    heatBuilder.append("windowSecs", chunkHeatWindowSecs.load());
+    if (!_previous) {
+        return;
+    }
+
+    heatBuilder.append("windowStart", _previous->start);
+    heatBuilder.append("operations", static_cast<long long>(_previous->operations));
+
+    std::vector<const ChunkHeat*> hottestChunks;
+    hottestChunks.reserve(_previous->chunks.size());
+    for (const auto& entry : _previous->chunks) {
+        hottestChunks.push_back(&entry.second);
+    }
+
+    const auto numReported = std::min(hottestChunks.size(), kMaxReportedChunks);
+    std::partial_sort(hottestChunks.begin(),
+                      hottestChunks.begin() + numReported,
+                      hottestChunks.end(),
+                      [](const ChunkHeat* lhs, const ChunkHeat* rhs) {
+                          return lhs->operations > rhs->operations;
+                      });
+
+    BSONArrayBuilder chunksBuilder(heatBuilder.subarrayStart("hottestChunks"));
+    for (size_t i = 0; i < numReported; ++i) {
+        BSONObjBuilder chunkBuilder(chunksBuilder.subobjStart());
+        chunkBuilder.append("ns", hottestChunks[i]->nss.ns());
+        chunkBuilder.append("min", hottestChunks[i]->range.getMin());
+        chunkBuilder.append("max", hottestChunks[i]->range.getMax());
+        chunkBuilder.append("operations", static_cast<long long>(hottestChunks[i]->operations));
+    }
+}
+
+void ChunkHeatStatistics::_rotateIfNeeded(WithLock, Date_t now) {
+    const Milliseconds windowLength = Seconds(chunkHeatWindowSecs.load());
+
+    if (_current.start == Date_t()) {
+        _current.start = now;
+        return;
+    }
+
+    const auto currentEnd = _current.start + windowLength;
+    if (now < currentEnd) {
+        return;
+    }
+
+    if (now < currentEnd + windowLength) {
+        _previous = std::move(_current);
+        _current = Window();
+        _current.start = currentEnd;
+        return;
+    }
+
+    // Nothing was written during the last complete window, so report it as empty rather than
+    // reporting the window before it as if it were recent
+    _previous = Window();
+    _previous->start = now - windowLength;
+    _current = Window();
+    _current.start = now;
+}
+
+}  // namespace mongo
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Counts the writes to each chunk owned by this shard over consecutive windows of
+ * 'chunkHeatWindowSecs' seconds, so the balancer can tell which shards, and which of their chunks,
+ * receive the most load. Only the last complete window is reported, so that the balancer compares
+ * shards over windows of the same length.
+ *
+ * This class is thread-safe.
+ */
+class ChunkHeatStatistics {
+public:
+    // The maximum number of chunks tracked in a single window; writes to further chunks only count
+    // towards the shard's total
+    static constexpr size_t kMaxTrackedChunks = 10000;
+
+    // The number of chunks included in the report
+    static constexpr size_t kMaxReportedChunks = 16;
+
+    // Writers record their operations in batches of this many per chunk, so that most writes don't
+    // have to take the mutex
+    static constexpr uint64_t kOperationsPerRecord = 16;
+
+    static ChunkHeatStatistics& get(ServiceContext* serviceContext);
+    static ChunkHeatStatistics& get(OperationContext* opCtx);
+
+    /**
+     * Records 'operations' writes to the chunk with the given range as of 'now'.
+     */
+    void recordOperations(const NamespaceString& nss,
+                          const ChunkRange& range,
+                          uint64_t operations,
+                          Date_t now);
+
+    /**
+     * Reports the writes of the last complete window and its hottest chunks for serverStatus.
+     */
+    void report(BSONObjBuilder* builder, Date_t now);
+
+private:
+    struct ChunkHeat {
+        NamespaceString nss;
+        ChunkRange range;
+        uint64_t operations;
+    };
+
+    struct Window {
+        Date_t start;
+        uint64_t operations{0};
+        stdx::unordered_map<std::string, ChunkHeat> chunks;
+    };
+
+    void _rotateIfNeeded(WithLock, Date_t now);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ChunkHeatStatistics::_mutex");
+
+    // The window currently being counted, and the last complete one, if any
+    Window _current;
+    boost::optional<Window> _previous;
+};
+
+}  // namespace mongo
@@ -0,0 +1,97 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/chunk_heat_statistics.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.foo");
+const ChunkRange kLowRange(BSON("a" << MINKEY), BSON("a" << 0));
+const ChunkRange kHighRange(BSON("a" << 0), BSON("a" << MAXKEY));
+const Date_t kStart = Date_t::fromMillisSinceEpoch(100000);
+
+BSONObj report(ChunkHeatStatistics* heat, Date_t now) {
+    BSONObjBuilder builder;
+    heat->report(&builder, now);
+    return builder.obj()["chunkHeat"].Obj().getOwned();
+}
+
+TEST(ChunkHeatStatisticsTest, NothingReportedUntilAWindowCompletes) {
+    ChunkHeatStatistics heat;
+    heat.recordOperations(kNss, kLowRange, 16, kStart);
+
+    const auto chunkHeat = report(&heat, kStart + Seconds(30));
+    ASSERT_EQ(60, chunkHeat["windowSecs"].numberInt());
+    ASSERT(chunkHeat["windowStart"].eoo());
+    ASSERT(chunkHeat["hottestChunks"].eoo());
+}
+
+TEST(ChunkHeatStatisticsTest, ReportsHottestChunksOfLastCompleteWindow) {
+    ChunkHeatStatistics heat;
+    heat.recordOperations(kNss, kHighRange, 16, kStart);
+    for (int i = 0; i < 3; ++i) {
+        heat.recordOperations(kNss, kLowRange, 16, kStart + Seconds(i));
+    }
+
+    // Writes to the current window are not reported
+    heat.recordOperations(kNss, kHighRange, 16, kStart + Seconds(61));
+
+    const auto chunkHeat = report(&heat, kStart + Seconds(62));
+    ASSERT_EQ(kStart, chunkHeat["windowStart"].date());
+    ASSERT_EQ(64, chunkHeat["operations"].numberLong());
+
+    const auto hottestChunks = chunkHeat["hottestChunks"].Array();
+    ASSERT_EQ(2UL, hottestChunks.size());
+    ASSERT_EQ(kNss.ns(), hottestChunks[0]["ns"].str());
+    ASSERT_BSONOBJ_EQ(kLowRange.getMin(), hottestChunks[0]["min"].Obj());
+    ASSERT_BSONOBJ_EQ(kLowRange.getMax(), hottestChunks[0]["max"].Obj());
+    ASSERT_EQ(48, hottestChunks[0]["operations"].numberLong());
+    ASSERT_BSONOBJ_EQ(kHighRange.getMin(), hottestChunks[1]["min"].Obj());
+    ASSERT_EQ(16, hottestChunks[1]["operations"].numberLong());
+}
+
+TEST(ChunkHeatStatisticsTest, IdleWindowIsReportedEmpty) {
+    ChunkHeatStatistics heat;
+    heat.recordOperations(kNss, kLowRange, 16, kStart);
+
+    const auto now = kStart + Seconds(200);
+    const auto chunkHeat = report(&heat, now);
+    ASSERT_EQ(now - Seconds(60), chunkHeat["windowStart"].date());
+    ASSERT_EQ(0, chunkHeat["operations"].numberLong());
+    ASSERT_EQ(0UL, chunkHeat["hottestChunks"].Array().size());
+}
+
+}  // namespace
+}  // namespace mongo
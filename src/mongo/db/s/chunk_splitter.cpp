@@ -40,6 +40,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/chunk_split_state_driver.h"
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
@@ -49,6 +50,7 @@
 #include "mongo/s/catalog/type_chunk.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/chunk_manager.h"
+#include "mongo/s/chunk_writes_tracker.h"
 #include "mongo/s/config_server_client.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/shard_key_pattern.h"
@@ -337,15 +339,33 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                     "maxChunkSizeBytes"_attr = maxChunkSizeBytes);
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = splitVector(opCtx.get(),
-                                       nss,
-                                       shardKeyPattern.toBSON(),
-                                       chunk.getMin(),
-                                       chunk.getMax(),
-                                       false,
-                                       boost::none,
-                                       boost::none,
-                                       maxChunkSizeBytes);
+
+        // If most of the chunk's data is known from its insertions, take the split points from the
+        // sampled inserted keys rather than scanning the chunk's range, which would add I/O on a
+        // chunk which is hot enough to need splitting
+        std::vector<BSONObj> splitPoints;
+        if (autoSplitUseSampledSplitPoints.load()) {
+            splitPoints = chunk.getWritesTracker()->getSampledSplitPoints(maxChunkSizeBytes);
+            if (!splitPoints.empty()) {
+                LOGV2_DEBUG(5191330,
+                            1,
+                            "Using sampled split points for autosplit",
+                            "chunk"_attr = redact(chunk.toString()),
+                            "splitPoints"_attr = splitPoints.size());
+            }
+        }
+
+        if (splitPoints.empty()) {
+            splitPoints = splitVector(opCtx.get(),
+                                      nss,
+                                      shardKeyPattern.toBSON(),
+                                      chunk.getMin(),
+                                      chunk.getMax(),
+                                      false,
+                                      boost::none,
+                                      boost::none,
+                                      maxChunkSizeBytes);
+        }
 
         if (splitPoints.empty()) {
             LOGV2_DEBUG(21907,
@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/migration_destination_manager.h"
 
+#include <algorithm>
 #include <list>
 #include <vector>
 
@@ -436,15 +437,18 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    size_t numInserterThreads) {
+    invariant(numInserterThreads > 0);
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    // Let the fetcher get one batch ahead of each of the inserters.
+    SingleProducerMultiConsumerQueue<BSONObj>::Options options;
+    options.maxQueueDepth = numInserterThreads;
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
-    repl::OpTime lastOpApplied;
+    SingleProducerMultiConsumerQueue<BSONObj> batches(options);
+    std::vector<repl::OpTime> lastOpsApplied(numInserterThreads);
 
-    stdx::thread inserterThread{[&] {
+    auto runInserter = [&](size_t inserterIndex) {
         Client::initThread("chunkInserter", opCtx->getServiceContext(), nullptr);
         auto client = Client::getCurrent();
         {
@@ -453,21 +457,20 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
         }
 
         auto inserterOpCtx = client->makeOperationContext();
-        auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+        ON_BLOCK_EXIT([&] {
+            lastOpsApplied[inserterIndex] =
+                repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
         });
 
         try {
             while (true) {
                 auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
+                insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Either the donor has no more documents to clone, or another inserter failed.
         } catch (...) {
+            batches.closeConsumerEnd();
             stdx::lock_guard<Client> lk(*opCtx->getClient());
             opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
             LOGV2(21999,
@@ -475,33 +478,39 @@ repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
                   "Batch insertion failed",
                   "error"_attr = redact(exceptionToStatus()));
         }
-    }};
+    };
 
+    std::vector<stdx::thread> inserterThreads;
+    inserterThreads.reserve(numInserterThreads);
+    for (size_t i = 0; i < numInserterThreads; ++i) {
+        inserterThreads.emplace_back(runInserter, i);
+    }
 
     {
-        auto inserterThreadJoinGuard = makeGuard([&] {
+        auto inserterThreadsJoinGuard = makeGuard([&] {
             batches.closeProducerEnd();
-            inserterThread.join();
+            for (auto& inserterThread : inserterThreads) {
+                inserterThread.join();
+            }
         });
 
         while (true) {
             auto res = fetchBatchFn(opCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                break;
+            }
             try {
                 batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
-                }
             } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
                 break;
             }
         }
     }  // This scope ensures that the guard is destroyed
 
-    // This check is necessary because the consumer thread uses killOp to propagate errors to the
+    // This check is necessary because the consumer threads use killOp to propagate errors to the
     // producer thread (this thread)
     opCtx->checkForInterrupt();
-    return lastOpApplied;
+    return *std::max_element(lastOpsApplied.begin(), lastOpsApplied.end());
 }
 
 Status MigrationDestinationManager::abort(const MigrationSessionId& sessionId) {
@@ -1067,7 +1076,13 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        // The secondaryThrottle wait checks the session of the outer operation in and out, which
+        // only one thread may do at a time, so batches are then inserted by a single thread.
+        const size_t numInserterThreads = _writeConcern.needToWaitForOtherNodes()
+            ? 1
+            : static_cast<size_t>(migrateCloneInserterThreads.load());
+        lastOpApplied =
+            cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn, numInserterThreads);
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
@@ -113,12 +113,15 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Batches are fetched by the calling thread while the
+     * previous ones are inserted by 'numInserterThreads' threads, which call 'insertBatchFn'
+     * concurrently. Returns the latest optime written by the inserters.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        size_t numInserterThreads = 1);
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
@@ -30,7 +30,11 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/s/migration_destination_manager.h"
+
+#include <set>
+
 #include "mongo/db/s/shard_server_test_fixture.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 namespace {
@@ -104,6 +108,40 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWorksCorrectly) {
     }
 }
 
+// Tests that every batch is inserted exactly once when several threads insert the batches.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithSeveralInserters) {
+    const int kNumBatches = 20;
+    int numBatchesFetched = 0;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        BSONArrayBuilder arrayBuilder(fetchBatchResultBuilder.subarrayStart("objects"));
+        if (numBatchesFetched < kNumBatches) {
+            arrayBuilder.append(createDocument(numBatchesFetched++));
+        }
+        arrayBuilder.done();
+
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto mutex = MONGO_MAKE_LATCH("CloneDocumentsFromDonorWithSeveralInserters::mutex");
+    std::set<int> insertedIds;
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            ASSERT(insertedIds.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4);
+
+    ASSERT_EQ(static_cast<size_t>(kNumBatches), insertedIds.size());
+    ASSERT_EQ(0, *insertedIds.begin());
+    ASSERT_EQ(kNumBatches - 1, *insertedIds.rbegin());
+}
+
 // Tests that an exception in the fetch logic will successfully throw an exception on the main
 // thread.
 TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrors) {
@@ -57,9 +57,11 @@
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/s/range_deletion_task_gen.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/remove_saver.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/logv2/log.h"
@@ -196,6 +198,22 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         hangBeforeDoingDeletion.pauseWhileSet(opCtx);
     }
 
+    // Delete the documents in groups under a single WriteUnitOfWork each. The plan executor does
+    // not yield, so a write conflict aborts the whole group, which is retried with the next batch.
+    const int docsPerWriteUnitOfWork = rangeDeleterDocsPerWriteUnitOfWork.load();
+    std::unique_ptr<WriteUnitOfWork> wuow;
+    int numDeletedInWriteUnitOfWork = 0;
+    const auto commitWriteUnitOfWork = [&] {
+        if (!wuow) {
+            return;
+        }
+        wuow->commit();
+        wuow.reset();
+        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(
+            numDeletedInWriteUnitOfWork);
+        numDeletedInWriteUnitOfWork = 0;
+    };
+
     int numDeleted = 0;
     do {
         BSONObj deletedObj;
@@ -208,6 +226,10 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
             uasserted(ErrorCodes::InternalError, "Failing for test");
         }
 
+        if (!wuow) {
+            wuow = std::make_unique<WriteUnitOfWork>(opCtx);
+        }
+
         PlanExecutor::ExecState state;
         try {
             state = exec->getNext(&deletedObj, nullptr);
@@ -229,10 +251,13 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         }
 
         invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
+        if (++numDeletedInWriteUnitOfWork >= docsPerWriteUnitOfWork) {
+            commitWriteUnitOfWork();
+        }
 
     } while (++numDeleted < numDocsToRemovePerBatch);
 
+    commitWriteUnitOfWork();
     return numDeleted;
 }
 
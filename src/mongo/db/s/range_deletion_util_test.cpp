@@ -42,6 +42,7 @@
 #include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -190,6 +191,41 @@ TEST_F(RangeDeleterTest,
     ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 0);
 }
 
+TEST_F(RangeDeleterTest,
+       RemoveDocumentsInRangeRemovesAllDocumentsInRangeWhenABatchSpansSeveralWriteUnitsOfWork) {
+    const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
+    const auto numDocsToInsert = 5;
+    const auto numDocsToRemovePerBatch = 10;
+    auto queriesComplete = SemiFuture<void>::makeReady();
+
+    const auto oldDocsPerWriteUnitOfWork = rangeDeleterDocsPerWriteUnitOfWork.load();
+    rangeDeleterDocsPerWriteUnitOfWork.store(2);
+    ON_BLOCK_EXIT([&] { rangeDeleterDocsPerWriteUnitOfWork.store(oldDocsPerWriteUnitOfWork); });
+
+    // Insert documents in range, and one after it which must be kept.
+    setFilteringMetadataWithUUID(uuid());
+    DBDirectClient dbclient(operationContext());
+    for (auto i = 0; i < numDocsToInsert; ++i) {
+        dbclient.insert(kNss.toString(), BSON(kShardKey << i));
+    }
+    dbclient.insert(kNss.toString(), BSON(kShardKey << 10));
+
+    auto cleanupComplete =
+        removeDocumentsInRange(executor(),
+                               std::move(queriesComplete),
+                               kNss,
+                               uuid(),
+                               kShardKeyPattern,
+                               range,
+                               boost::none,
+                               numDocsToRemovePerBatch,
+                               Seconds(0) /* delayForActiveQueriesOnSecondariesToComplete*/,
+                               Milliseconds(0) /* delayBetweenBatches */);
+
+    cleanupComplete.get();
+    ASSERT_EQUALS(dbclient.count(kNss, BSONObj()), 1);
+}
+
 TEST_F(RangeDeleterTest, RemoveDocumentsInRangeInsertsDocumentToNotifySecondariesOfRangeDeletion) {
     const ChunkRange range(BSON(kShardKey << 0), BSON(kShardKey << 10));
     const int numDocsToRemovePerBatch = 10;
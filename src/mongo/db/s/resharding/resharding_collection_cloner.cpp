@@ -0,0 +1,211 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/resharding/resharding_collection_cloner.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/ops/write_ops_exec.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/process_interface/mongo_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/s/resharding_util.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/producer_consumer_queue.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+
+ReshardingCollectionCloner::ReshardingCollectionCloner(ShardKeyPattern newShardKeyPattern,
+                                                       NamespaceString sourceNss,
+                                                       NamespaceString tempNss,
+                                                       ShardId recipientShard,
+                                                       Timestamp atClusterTime)
+    : _newShardKeyPattern(std::move(newShardKeyPattern)),
+      _sourceNss(std::move(sourceNss)),
+      _tempNss(std::move(tempNss)),
+      _recipientShard(std::move(recipientShard)),
+      _atClusterTime(atClusterTime) {}
+
+std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipeline(
+    OperationContext* opCtx, std::shared_ptr<MongoProcessInterface> mongoProcessInterface) {
+    // The pipeline looks up the owner of each document in the routing table of the temporary
+    // resharding collection, which none of the involved namespaces is a view of.
+    const NamespaceString tempCacheChunksNss(NamespaceString::kConfigDb,
+                                             "cache.chunks." + _tempNss.ns());
+    StringMap<ExpressionContext::ResolvedNamespace> resolvedNamespaces;
+    resolvedNamespaces[_sourceNss.coll()] = {_sourceNss, std::vector<BSONObj>{}};
+    resolvedNamespaces[tempCacheChunksNss.coll()] = {tempCacheChunksNss, std::vector<BSONObj>{}};
+
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx,
+                                                    boost::none, /* explain */
+                                                    false,       /* fromMongos */
+                                                    false,       /* needsMerge */
+                                                    false,       /* allowDiskUse */
+                                                    false,       /* bypassDocumentValidation */
+                                                    false,       /* isMapReduceCommand */
+                                                    _sourceNss,
+                                                    boost::none, /* runtimeConstants */
+                                                    nullptr,     /* collator */
+                                                    std::move(mongoProcessInterface),
+                                                    std::move(resolvedNamespaces),
+                                                    boost::none /* collUUID */);
+
+    auto pipeline =
+        createAggForCollectionCloning(expCtx, _newShardKeyPattern, _tempNss, _recipientShard);
+    return expCtx->mongoProcessInterface->attachCursorSourceToPipeline(pipeline.release());
+}
+
+void ReshardingCollectionCloner::run(OperationContext* opCtx, size_t numInserterThreads) {
+    invariant(numInserterThreads > 0);
+
+    // All of the donor shards are read at the same snapshot, which the recipient later applies the
+    // donors' oplog entries on top of.
+    repl::ReadConcernArgs::get(opCtx) = repl::ReadConcernArgs(
+        LogicalTime(_atClusterTime), repl::ReadConcernLevel::kSnapshotReadConcern);
+
+    Timer timer;
+    auto pipeline = makePipeline(opCtx, MongoProcessInterface::create(opCtx));
+
+    // Let the reader get one batch ahead of each of the inserters.
+    SingleProducerMultiConsumerQueue<std::vector<BSONObj>>::Options options;
+    options.maxQueueDepth = numInserterThreads;
+    SingleProducerMultiConsumerQueue<std::vector<BSONObj>> batches(options);
+
+    auto runInserter = [&] {
+        Client::initThread(
+            "reshardingCollectionClonerInserter", opCtx->getServiceContext(), nullptr);
+        auto client = Client::getCurrent();
+        {
+            stdx::lock_guard lk(*client);
+            client->setSystemOperationKillableByStepdown(lk);
+        }
+
+        auto inserterOpCtx = client->makeOperationContext();
+        try {
+            while (true) {
+                _insertBatch(inserterOpCtx.get(), batches.pop(inserterOpCtx.get()));
+            }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Either there are no more documents to clone, or another inserter failed.
+        } catch (...) {
+            batches.closeConsumerEnd();
+            stdx::lock_guard<Client> lk(*opCtx->getClient());
+            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(5190700));
+            LOGV2(5190701,
+                  "Resharding collection cloner failed to insert a batch",
+                  "namespace"_attr = _tempNss,
+                  "error"_attr = redact(exceptionToStatus()));
+        }
+    };
+
+    std::vector<stdx::thread> inserterThreads;
+    inserterThreads.reserve(numInserterThreads);
+    for (size_t i = 0; i < numInserterThreads; ++i) {
+        inserterThreads.emplace_back(runInserter);
+    }
+
+    {
+        auto inserterThreadsJoinGuard = makeGuard([&] {
+            batches.closeProducerEnd();
+            for (auto& inserterThread : inserterThreads) {
+                inserterThread.join();
+            }
+        });
+
+        const auto maxBatchSize = static_cast<size_t>(internalInsertMaxBatchSize.load());
+        std::vector<BSONObj> batch;
+        size_t batchBytes = 0;
+        auto pushBatch = [&] {
+            batches.push(std::exchange(batch, {}), opCtx);
+            batchBytes = 0;
+        };
+
+        try {
+            while (auto doc = pipeline->getNext()) {
+                batch.push_back(doc->toBson());
+                batchBytes += batch.back().objsize();
+                if (batch.size() >= maxBatchSize || batchBytes >= write_ops::insertVectorMaxBytes) {
+                    pushBatch();
+                }
+            }
+            if (!batch.empty()) {
+                pushBatch();
+            }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // An inserter failed, and has interrupted this operation with its error.
+        }
+    }  // This scope ensures that the guard is destroyed
+
+    // The inserters use killOp to propagate their errors to this thread.
+    opCtx->checkForInterrupt();
+    pipeline->dispose(opCtx);
+
+    const long long elapsedMillis = timer.millis();
+    LOGV2(5190702,
+          "Finished cloning the documents for the resharding operation",
+          "namespace"_attr = _sourceNss,
+          "tempNamespace"_attr = _tempNss,
+          "docsCopied"_attr = getNumDocumentsCopied(),
+          "bytesCopied"_attr = getNumBytesCopied(),
+          "durationMillis"_attr = elapsedMillis,
+          "bytesPerSecond"_attr = getNumBytesCopied() * 1000 / std::max(elapsedMillis, 1LL));
+}
+
+void ReshardingCollectionCloner::_insertBatch(OperationContext* opCtx,
+                                              std::vector<BSONObj> batch) {
+    long long batchBytes = 0;
+    for (const auto& doc : batch) {
+        batchBytes += doc.objsize();
+    }
+    const auto batchSize = static_cast<long long>(batch.size());
+
+    write_ops::Insert insertOp(_tempNss);
+    insertOp.getWriteCommandBase().setOrdered(true);
+    insertOp.setDocuments(std::move(batch));
+
+    const auto reply = write_ops_exec::performInserts(opCtx, insertOp);
+    for (size_t i = 0; i < reply.results.size(); ++i) {
+        uassertStatusOKWithContext(reply.results[i],
+                                   str::stream() << "Insert of " << insertOp.getDocuments()[i]
+                                                 << " into " << _tempNss << " failed");
+    }
+
+    _numDocumentsCopied.addAndFetch(batchSize);
+    _numBytesCopied.addAndFetch(batchBytes);
+}
+
+}  // namespace mongo
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/bson/timestamp.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/s/shard_id.h"
+#include "mongo/s/shard_key_pattern.h"
+
+namespace mongo {
+
+class MongoProcessInterface;
+class OperationContext;
+
+/**
+ * Copies the documents of the collection being resharded, which this recipient shard owns under
+ * the new shard key, into the temporary resharding collection, as of the fetchTimestamp.
+ *
+ * The documents are read through a single sharded aggregation, which fetches from all of the donor
+ * shards at once, and the batches it produces are inserted by several threads in parallel.
+ */
+class ReshardingCollectionCloner {
+public:
+    ReshardingCollectionCloner(ShardKeyPattern newShardKeyPattern,
+                               NamespaceString sourceNss,
+                               NamespaceString tempNss,
+                               ShardId recipientShard,
+                               Timestamp atClusterTime);
+
+    /**
+     * Returns the pipeline, with its cursor source attached, which reads the documents to clone
+     * from the donor shards.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> makePipeline(
+        OperationContext* opCtx, std::shared_ptr<MongoProcessInterface> mongoProcessInterface);
+
+    /**
+     * Clones all of the documents. The calling thread reads the batches from the donor shards
+     * while 'numInserterThreads' threads insert them into the temporary resharding collection.
+     * Throws if any of the reads or inserts fails.
+     */
+    void run(OperationContext* opCtx, size_t numInserterThreads);
+
+    long long getNumDocumentsCopied() const {
+        return _numDocumentsCopied.load();
+    }
+
+    long long getNumBytesCopied() const {
+        return _numBytesCopied.load();
+    }
+
+private:
+    void _insertBatch(OperationContext* opCtx, std::vector<BSONObj> batch);
+
+    const ShardKeyPattern _newShardKeyPattern;
+    const NamespaceString _sourceNss;
+    const NamespaceString _tempNss;
+    const ShardId _recipientShard;
+    const Timestamp _atClusterTime;
+
+    AtomicWord<long long> _numDocumentsCopied{0};
+    AtomicWord<long long> _numBytesCopied{0};
+};
+
+}  // namespace mongo
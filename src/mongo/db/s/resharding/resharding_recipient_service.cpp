@@ -33,7 +33,13 @@
 
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/persistent_task_store.h"
+#include "mongo/db/s/resharding/resharding_collection_cloner.h"
+#include "mongo/db/s/resharding_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
+#include "mongo/db/s/sharding_state.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/grid.h"
 
 namespace mongo {
 
@@ -106,6 +112,22 @@ void RecipientStateMachine::_cloneThenTransitionToApplying() {
         return;
     }
 
+    // The donors report the fetchTimestamp to clone at once they are prepared to donate.
+    if (auto fetchTimestamp = _recipientDoc.getFetchTimestamp()) {
+        auto opCtx = cc().makeOperationContext();
+        const auto& sourceNss = _recipientDoc.getNss();
+        const auto cm = uassertStatusOK(
+            Grid::get(opCtx.get())->catalogCache()->getCollectionRoutingInfo(opCtx.get(),
+                                                                              sourceNss));
+
+        ReshardingCollectionCloner cloner(ShardKeyPattern(_recipientDoc.getReshardingKey()),
+                                          sourceNss,
+                                          constructTemporaryReshardingNss(sourceNss, cm),
+                                          ShardingState::get(opCtx.get())->shardId(),
+                                          *fetchTimestamp);
+        cloner.run(opCtx.get(), reshardingCollectionClonerInserterThreads.load());
+    }
+
     _transitionState(RecipientStateEnum::kApplying);
 }
 
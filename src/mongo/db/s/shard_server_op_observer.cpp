@@ -36,6 +36,7 @@
 #include "mongo/bson/util/bson_extract.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/op_observer_impl.h"
+#include "mongo/db/s/chunk_heat_statistics.h"
 #include "mongo/db/s/chunk_split_state_driver.h"
 #include "mongo/db/s/chunk_splitter.h"
 #include "mongo/db/s/database_sharding_state.h"
@@ -173,14 +174,16 @@ void onConfigDeleteInvalidateCachedCollectionMetadataAndNotify(OperationContext*
 /**
  * If the collection is sharded, finds the chunk that contains the specified document and increments
  * the size tracked for that chunk by the specified amount of data written, in bytes. Returns the
- * number of total bytes on that chunk after the data is written.
+ * number of total bytes on that chunk after the data is written. Inserted documents also feed the
+ * chunk's sample of shard keys, which the chunk splitter can take split points from.
  */
 void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
                                     const NamespaceString& nss,
                                     const ChunkManager& chunkManager,
                                     const BSONObj& document,
                                     long dataWritten,
-                                    bool fromMigrate) {
+                                    bool fromMigrate,
+                                    bool isInsert) {
     const auto& shardKeyPattern = chunkManager.getShardKeyPattern();
     BSONObj shardKey = shardKeyPattern.extractShardKeyFromDoc(document);
 
@@ -192,9 +195,20 @@ void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
     auto chunk = chunkManager.findIntersectingChunkWithSimpleCollation(shardKey);
     auto chunkWritesTracker = chunk.getWritesTracker();
     chunkWritesTracker->addBytesWritten(dataWritten);
+    if (isInsert) {
+        chunkWritesTracker->addInsertedKey(shardKey, dataWritten);
+    }
     // Don't trigger chunk splits from inserts happening due to migration since
     // we don't necessarily own that chunk yet
     if (!fromMigrate) {
+        if (chunkWritesTracker->addOperation() % ChunkHeatStatistics::kOperationsPerRecord == 0) {
+            ChunkHeatStatistics::get(opCtx).recordOperations(
+                nss,
+                chunk.getRange(),
+                ChunkHeatStatistics::kOperationsPerRecord,
+                opCtx->getServiceContext()->getFastClockSource()->now());
+        }
+
         const auto balancerConfig = Grid::get(opCtx)->getBalancerConfiguration();
 
         if (balancerConfig->getShouldAutoSplit() &&
@@ -275,7 +289,8 @@ void ShardServerOpObserver::onInserts(OperationContext* opCtx,
                                            *metadata->getChunkManager(),
                                            insertedDoc,
                                            insertedDoc.objsize(),
-                                           fromMigrate);
+                                           fromMigrate,
+                                           true /* isInsert */);
         }
     }
 }
@@ -392,7 +407,8 @@ void ShardServerOpObserver::onUpdate(OperationContext* opCtx, const OplogUpdateE
                                        *metadata->getChunkManager(),
                                        args.updateArgs.updatedDoc,
                                        args.updateArgs.updatedDoc.objsize(),
-                                       args.updateArgs.fromMigrate);
+                                       args.updateArgs.fromMigrate,
+                                       false /* isInsert */);
     }
 }
 
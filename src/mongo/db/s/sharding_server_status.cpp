@@ -32,9 +32,11 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/s/active_migrations_registry.h"
+#include "mongo/db/s/chunk_heat_statistics.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/sharding_statistics.h"
+#include "mongo/db/server_options.h"
 #include "mongo/s/balancer_configuration.h"
 #include "mongo/s/catalog_cache.h"
 #include "mongo/s/client/shard_registry.h"
@@ -111,6 +113,10 @@ public:
 
         BSONObjBuilder result;
         ShardingStatistics::get(opCtx).report(&result);
+        if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
+            ChunkHeatStatistics::get(opCtx).report(
+                &result, opCtx->getServiceContext()->getFastClockSource()->now());
+        }
         catalogCache->report(&result);
         CollectionShardingState::appendInfoForServerStatus(opCtx, &result);
 
@@ -48,6 +48,7 @@
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
+#include "mongo/db/cpu_profiler.h"
 #include "mongo/db/curop_metrics.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/dbdirectclient.h"
@@ -128,21 +129,39 @@ namespace {
 
 using namespace fmt::literals;
 
-/** Allows for the very complex handleRequest function to be decomposed into parts. */
-struct HandleRequest {
+/**
+ * Allows for the very complex handleRequest function to be decomposed into parts.
+ *
+ * The request is processed as a chain of future continuations, and the HandleRequest keeps itself
+ * alive until the last of them has run. An OpRunner that has to wait may therefore return a future
+ * that is not yet ready instead of blocking the thread that is serving the session.
+ */
+struct HandleRequest : public std::enable_shared_from_this<HandleRequest> {
     struct OpRunner {
         explicit OpRunner(HandleRequest* hr) : hr{hr} {}
         virtual ~OpRunner() = default;
-        virtual DbResponse run() = 0;
+        virtual Future<DbResponse> run() = 0;
         HandleRequest* hr;
     };
 
+    /**
+     * Base for the runners whose work completes on the calling thread. They implement `runSync`,
+     * and `run` hands its result back as a ready future.
+     */
+    struct SynchronousOpRunner : OpRunner {
+        using OpRunner::OpRunner;
+        virtual DbResponse runSync() = 0;
+        Future<DbResponse> run() final {
+            return makeReadyFutureWith([&] { return runSync(); });
+        }
+    };
+
     HandleRequest(OperationContext* opCtx,
                   const Message& m,
-                  const ServiceEntryPointCommon::Hooks& behaviors)
-        : opCtx{opCtx}, m{m}, behaviors{behaviors}, dbmsg{m} {}
+                  std::unique_ptr<const ServiceEntryPointCommon::Hooks> behaviors)
+        : opCtx{opCtx}, m{m}, behaviors{std::move(behaviors)}, dbmsg{m} {}
 
-    DbResponse run();
+    Future<DbResponse> run();
 
     NetworkOp op() const {
         return m.operation();
@@ -174,7 +193,7 @@ struct HandleRequest {
 
     OperationContext* opCtx;
     const Message& m;
-    const ServiceEntryPointCommon::Hooks& behaviors;
+    const std::unique_ptr<const ServiceEntryPointCommon::Hooks> behaviors;
 
     DbMessage dbmsg;
 
@@ -985,6 +1004,8 @@ void execCommandDatabase(OperationContext* opCtx,
     std::shared_ptr<CommandInvocation> invocation = command->parse(opCtx, request);
     CommandInvocation::set(opCtx, invocation);
 
+    CpuProfilerOperationScope cpuProfilerScope(command->getName(), invocation->ns().ns());
+
     OperationSessionInfoFromClient sessionOptions;
 
     const auto isInternalClient = opCtx->getClient()->session() &&
@@ -1725,10 +1746,10 @@ DbResponse receivedGetMore(OperationContext* opCtx,
     return dbresponse;
 }
 
-struct CommandOpRunner : HandleRequest::OpRunner {
-    using HandleRequest::OpRunner::OpRunner;
-    DbResponse run() override {
-        DbResponse r = receivedCommands(hr->opCtx, hr->m, hr->behaviors);
+struct CommandOpRunner : HandleRequest::SynchronousOpRunner {
+    using HandleRequest::SynchronousOpRunner::SynchronousOpRunner;
+    DbResponse runSync() override {
+        DbResponse r = receivedCommands(hr->opCtx, hr->m, *hr->behaviors);
         // Hello should take kMaxAwaitTimeMs at most, log if it takes twice that.
         if (auto command = hr->currentOp().getCommand();
             command && (command->getName() == "hello")) {
@@ -1739,32 +1760,32 @@ struct CommandOpRunner : HandleRequest::OpRunner {
     }
 };
 
-struct QueryOpRunner : HandleRequest::OpRunner {
-    using HandleRequest::OpRunner::OpRunner;
-    DbResponse run() override {
+struct QueryOpRunner : HandleRequest::SynchronousOpRunner {
+    using HandleRequest::SynchronousOpRunner::SynchronousOpRunner;
+    DbResponse runSync() override {
         hr->opCtx->markKillOnClientDisconnect();
         return receivedQuery(
-            hr->opCtx, hr->nsString(), *hr->opCtx->getClient(), hr->m, hr->behaviors);
+            hr->opCtx, hr->nsString(), *hr->opCtx->getClient(), hr->m, *hr->behaviors);
     }
 };
 
-struct GetMoreOpRunner : HandleRequest::OpRunner {
-    using HandleRequest::OpRunner::OpRunner;
-    DbResponse run() override {
+struct GetMoreOpRunner : HandleRequest::SynchronousOpRunner {
+    using HandleRequest::SynchronousOpRunner::SynchronousOpRunner;
+    DbResponse runSync() override {
         return receivedGetMore(hr->opCtx, hr->m, hr->currentOp(), &hr->forceLog);
     }
 };
 
 /**
  * Fire and forget network operations don't produce a `DbResponse`.
- * They override `runAndForget` instead of `run`, and this base
- * class provides a `run` that calls it and handles error reporting
+ * They override `runAndForget` instead of `runSync`, and this base
+ * class provides a `runSync` that calls it and handles error reporting
  * via the `LastError` slot.
  */
-struct FireAndForgetOpRunner : HandleRequest::OpRunner {
-    using HandleRequest::OpRunner::OpRunner;
+struct FireAndForgetOpRunner : HandleRequest::SynchronousOpRunner {
+    using HandleRequest::SynchronousOpRunner::SynchronousOpRunner;
     virtual void runAndForget() = 0;
-    DbResponse run() final;
+    DbResponse runSync() final;
 };
 
 struct KillCursorsOpRunner : FireAndForgetOpRunner {
@@ -1827,7 +1848,7 @@ std::unique_ptr<HandleRequest::OpRunner> HandleRequest::makeOpRunner() {
     }
 }
 
-DbResponse FireAndForgetOpRunner::run() {
+DbResponse FireAndForgetOpRunner::runSync() {
     try {
         runAndForget();
     } catch (const AssertionException& ue) {
@@ -1877,17 +1898,23 @@ void HandleRequest::startOperation() {
     }
 }
 
-DbResponse HandleRequest::run() {
+Future<DbResponse> HandleRequest::run() {
     startOperation();
-    DbResponse dbresponse;
-    if (auto opRunner = makeOpRunner()) {
-        dbresponse = opRunner->run();
-    } else {
+    auto opRunner = makeOpRunner();
+    if (!opRunner) {
         currentOp().done();
         forceLog = true;
+        DbResponse dbresponse;
+        completeOperation(dbresponse);
+        return dbresponse;
     }
-    completeOperation(dbresponse);
-    return dbresponse;
+
+    auto future = opRunner->run();
+    return std::move(future).then(
+        [this, anchor = shared_from_this(), opRunner = std::move(opRunner)](DbResponse dbresponse) {
+            completeOperation(dbresponse);
+            return dbresponse;
+        });
 }
 
 void HandleRequest::completeOperation(const DbResponse& dbresponse) {
@@ -1902,13 +1929,29 @@ void HandleRequest::completeOperation(const DbResponse& dbresponse) {
             durationCount<Microseconds>(currentOp().elapsedTimeExcludingPauses()),
             currentOp().getReadWriteType());
 
+    if (const auto& queryHash = currentOp().debug().queryHash;
+        queryHash && currentOp().getCommand()) {
+        const auto& additiveMetrics = currentOp().debug().additiveMetrics;
+        Top::get(opCtx->getServiceContext())
+            .recordQueryShapeStats(
+                opCtx,
+                currentOp().getNS(),
+                currentOp().getCommand()->getName(),
+                *queryHash,
+                durationCount<Microseconds>(currentOp().elapsedTimeExcludingPauses()),
+                currentOp().getReadWriteType(),
+                additiveMetrics.keysExamined.value_or(0),
+                additiveMetrics.docsExamined.value_or(0),
+                currentOp().getPlanSummary());
+    }
+
     if (shouldProfile) {
         // Performance profiling is on
         if (opCtx->lockState()->isReadLocked()) {
             LOGV2_DEBUG(21970, 1, "Note: not profiling because of recursive read lock");
         } else if (client().isInDirectClient()) {
             LOGV2_DEBUG(21971, 1, "Note: not profiling because we are in DBDirectClient");
-        } else if (behaviors.lockedForWriting()) {
+        } else if (behaviors->lockedForWriting()) {
             // TODO SERVER-26825: Fix race condition where fsyncLock is acquired post
             // lockedForWriting() call but prior to profile collection lock acquisition.
             LOGV2_DEBUG(21972, 1, "Note: not profiling because doing fsync+lock");
@@ -1934,15 +1977,12 @@ BSONObj ServiceEntryPointCommon::getRedactedCopyForLogging(const Command* comman
     return bob.obj();
 }
 
-Future<DbResponse> ServiceEntryPointCommon::handleRequest(OperationContext* opCtx,
-                                                          const Message& m,
-                                                          const Hooks& behaviors) noexcept {
-    try {
-        return Future<DbResponse>::makeReady(HandleRequest{opCtx, m, behaviors}.run());
-    } catch (DBException& e) {
-        LOGV2_ERROR(4879802, "Failed to handle request", "error"_attr = redact(e));
-        return e.toStatus();
-    }
+Future<DbResponse> ServiceEntryPointCommon::handleRequest(
+    OperationContext* opCtx, const Message& m, std::unique_ptr<const Hooks> behaviors) noexcept {
+    auto hr = std::make_shared<HandleRequest>(opCtx, m, std::move(behaviors));
+    return makeReadyFutureWith([&] { return hr->run(); }).tapError([](const Status& status) {
+        LOGV2_ERROR(4879802, "Failed to handle request", "error"_attr = redact(status));
+    });
 }
 
 ServiceEntryPointCommon::Hooks::~Hooks() = default;
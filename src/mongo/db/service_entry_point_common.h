@@ -99,9 +99,13 @@ struct ServiceEntryPointCommon {
                                          BSONObjBuilder* metadataBob) const = 0;
     };
 
+    /**
+     * Handles the request in 'm'. The returned future may become ready after this function has
+     * returned, so the hooks are owned by the request for as long as it is being processed.
+     */
     static Future<DbResponse> handleRequest(OperationContext* opCtx,
                                             const Message& m,
-                                            const Hooks& hooks) noexcept;
+                                            std::unique_ptr<const Hooks> hooks) noexcept;
 
     /**
      * Produce a new object based on cmdObj, but with redactions applied as specified by
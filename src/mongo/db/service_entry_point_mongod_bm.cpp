@@ -0,0 +1,261 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/catalog/collection_impl.h"
+#include "mongo/db/catalog/database_holder_impl.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/index/index_access_method_factory_impl.h"
+#include "mongo/db/index_builds_coordinator_mongod.h"
+#include "mongo/db/op_observer_registry.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/s/collection_sharding_state_factory_shard.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/service_entry_point_mongod.h"
+#include "mongo/db/storage/control/storage_control.h"
+#include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/transport/transport_layer_mock.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/periodic_runner_factory.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+constexpr auto kDbName = "crud_bm"_sd;
+constexpr auto kReadCollName = "read"_sd;
+constexpr auto kInsertCollName = "insert"_sd;
+constexpr int kNumDocs = 10000;
+constexpr int kInsertBatchSize = 1000;
+
+/**
+ * Runs 'cmdObj' against 'dbName' through the ServiceEntryPoint on the current thread's Client and
+ * returns the reply body.
+ */
+BSONObj runCommand(StringData dbName, const BSONObj& cmdObj) {
+    auto opCtx = cc().makeOperationContext();
+    auto request = OpMsgRequest::fromDBAndBody(dbName, cmdObj).serialize();
+    auto response = opCtx->getServiceContext()
+                        ->getServiceEntryPoint()
+                        ->handleRequest(opCtx.get(), request)
+                        .get();
+    return OpMsg::parse(response.response).body.getOwned();
+}
+
+/**
+ * A standalone mongod running the WiredTiger storage engine inside the benchmark process, set up
+ * the same way as ServiceContextMongoDTest. Commands reach it through
+ * ServiceEntryPointMongod::handleRequest, so they take the full command path without any network
+ * in between. The data files live in a temporary directory under TMPDIR, which should point at a
+ * tmpfs to keep disk latency out of the results.
+ *
+ * The environment is built by the first benchmark thread that needs it and torn down at exit.
+ */
+class CrudBenchmarkEnvironment {
+public:
+    static CrudBenchmarkEnvironment& get() {
+        static CrudBenchmarkEnvironment env;
+        return env;
+    }
+
+    /**
+     * Returns a new Client with its own mock session, as if it had connected over the network.
+     */
+    ServiceContext::UniqueClient makeClient() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _serviceContext->makeClient("crud_bm", _transportLayer.createSession());
+    }
+
+private:
+    CrudBenchmarkEnvironment() : _serviceContext(getGlobalServiceContext()) {
+        storageGlobalParams.engine = "wiredTiger";
+        storageGlobalParams.engineSetByUser = true;
+        storageGlobalParams.dbpath = _tempDir.path();
+
+        _serviceContext->setServiceEntryPoint(
+            std::make_unique<ServiceEntryPointMongod>(_serviceContext));
+        _serviceContext->setPeriodicRunner(makePeriodicRunner(_serviceContext));
+        _serviceContext->setOpObserver(std::make_unique<OpObserverRegistry>());
+        repl::ReplicationCoordinator::set(
+            _serviceContext,
+            std::make_unique<repl::ReplicationCoordinatorMock>(_serviceContext,
+                                                               repl::ReplSettings()));
+
+        auto client = makeClient();
+        AlternativeClientRegion acr(client);
+        {
+            auto opCtx = cc().makeOperationContext();
+            initializeStorageEngine(opCtx.get(),
+                                    StorageEngineInitFlags::kAllowNoLockFile |
+                                        StorageEngineInitFlags::kSkipMetadataFile);
+        }
+        StorageControl::startStorageControls(_serviceContext, true /*forTestOnly*/);
+
+        DatabaseHolder::set(_serviceContext, std::make_unique<DatabaseHolderImpl>());
+        IndexAccessMethodFactory::set(_serviceContext,
+                                      std::make_unique<IndexAccessMethodFactoryImpl>());
+        Collection::Factory::set(_serviceContext, std::make_unique<CollectionImpl::FactoryImpl>());
+        IndexBuildsCoordinator::set(_serviceContext,
+                                    std::make_unique<IndexBuildsCoordinatorMongod>());
+        CollectionShardingStateFactory::set(
+            _serviceContext,
+            std::make_unique<CollectionShardingStateFactoryShard>(_serviceContext));
+        _serviceContext->getStorageEngine()->notifyStartupComplete();
+
+        for (int i = 0; i < kNumDocs; i += kInsertBatchSize) {
+            BSONArrayBuilder docs;
+            for (int j = i; j < std::min(i + kInsertBatchSize, kNumDocs); ++j) {
+                docs.append(BSON("_id" << j << "a" << j << "payload" << std::string(64, 'x')));
+            }
+            auto reply = runCommand(kDbName,
+                                    BSON("insert" << kReadCollName << "documents" << docs.arr()));
+            uassertStatusOK(getStatusFromWriteCommandReply(reply));
+        }
+    }
+
+    ~CrudBenchmarkEnvironment() {
+        auto client = makeClient();
+        AlternativeClientRegion acr(client);
+        auto opCtx = cc().makeOperationContext();
+        IndexBuildsCoordinator::get(opCtx.get())->shutdown(opCtx.get());
+        {
+            Lock::GlobalLock lk(opCtx.get(), MODE_X);
+            DatabaseHolder::get(opCtx.get())->closeAll(opCtx.get());
+        }
+        opCtx.reset();
+        shutdownGlobalStorageEngineCleanly(_serviceContext);
+        CollectionShardingStateFactory::clear(_serviceContext);
+    }
+
+    ServiceContext* const _serviceContext;
+    unittest::TempDir _tempDir{"service_entry_point_mongod_bm"};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CrudBenchmarkEnvironment::_mutex");
+    transport::TransportLayerMock _transportLayer;
+};
+
+/**
+ * Reports the median and tail latency of the commands run by this thread. The reported values are
+ * averaged across threads.
+ */
+void reportLatencies(benchmark::State& state, std::vector<long long>* latencies) {
+    if (latencies->empty()) {
+        return;
+    }
+    std::sort(latencies->begin(), latencies->end());
+    auto percentile = [&](double p) {
+        return static_cast<double>((*latencies)[static_cast<size_t>(p * (latencies->size() - 1))]);
+    };
+    state.counters["p50Micros"] =
+        benchmark::Counter(percentile(0.5), benchmark::Counter::kAvgThreads);
+    state.counters["p99Micros"] =
+        benchmark::Counter(percentile(0.99), benchmark::Counter::kAvgThreads);
+    state.counters["maxMicros"] =
+        benchmark::Counter(percentile(1.0), benchmark::Counter::kAvgThreads);
+}
+
+/**
+ * Runs the command built by 'makeCommand' once per iteration on a Client owned by this benchmark
+ * thread, recording the latency of each call.
+ */
+template <typename MakeCommand>
+void runCrudBenchmark(benchmark::State& state, MakeCommand makeCommand) {
+    auto& env = CrudBenchmarkEnvironment::get();
+    auto client = env.makeClient();
+    AlternativeClientRegion acr(client);
+    PseudoRandom random(state.thread_index);
+
+    std::vector<long long> latencies;
+    for (auto _ : state) {
+        auto cmdObj = makeCommand(random);
+        Timer timer;
+        auto reply = runCommand(kDbName, cmdObj);
+        latencies.push_back(timer.micros());
+
+        if (auto status = getStatusFromWriteCommandReply(reply); !status.isOK()) {
+            state.SkipWithError(status.toString().c_str());
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    reportLatencies(state, &latencies);
+}
+
+void BM_Insert(benchmark::State& state) {
+    runCrudBenchmark(state, [](PseudoRandom& random) {
+        return BSON("insert" << kInsertCollName << "documents"
+                             << BSON_ARRAY(BSON("a" << random.nextInt32(kNumDocs) << "payload"
+                                                    << std::string(64, 'x'))));
+    });
+}
+
+void BM_FindById(benchmark::State& state) {
+    runCrudBenchmark(state, [](PseudoRandom& random) {
+        return BSON("find" << kReadCollName << "filter"
+                           << BSON("_id" << random.nextInt32(kNumDocs)) << "singleBatch" << true);
+    });
+}
+
+void BM_UpdateById(benchmark::State& state) {
+    runCrudBenchmark(state, [](PseudoRandom& random) {
+        return BSON("update" << kReadCollName << "updates"
+                             << BSON_ARRAY(BSON("q" << BSON("_id" << random.nextInt32(kNumDocs))
+                                                    << "u" << BSON("$inc" << BSON("a" << 1)))));
+    });
+}
+
+void BM_AggregateGroup(benchmark::State& state) {
+    const auto group = fromjson("{$group: {_id: null, total: {$sum: '$a'}}}");
+    runCrudBenchmark(state, [&](PseudoRandom& random) {
+        auto match = BSON("$match" << BSON("_id" << BSON("$lt" << random.nextInt32(1000))));
+        return BSON("aggregate" << kReadCollName << "pipeline" << BSON_ARRAY(match << group)
+                                << "cursor" << BSONObj());
+    });
+}
+
+BENCHMARK(BM_Insert)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_FindById)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_UpdateById)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_AggregateGroup)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
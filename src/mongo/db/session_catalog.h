@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -92,7 +93,9 @@ public:
 
     /**
      * Iterates through the SessionCatalog under the SessionCatalog mutex and applies 'workerFn' to
-     * each Session which matches the specified 'matcher'.
+     * each Session which matches the specified 'matcher'. The catalog is sharded by session id and
+     * each shard is scanned under its own mutex, so sessions in shards which have not been reached
+     * yet may be checked out or created while the scan is in progress.
      *
      * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
      * not allowed to block, perform I/O or acquire any lock manager locks.
@@ -129,22 +132,42 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the shard owning this
+        // session to protect the state transitions.
         stdx::condition_variable availableCondVar;
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    // Every session is owned by exactly one shard, chosen by the hash of its id, so that checking
+    // out different sessions does not contend on a single mutex. A thread never holds more than
+    // one shard mutex at a time.
+    static constexpr size_t kNumShards = 16;
+
+    struct Shard {
+        // Protects the state below
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::Shard::mutex");
+
+        // Owns the Session objects for all current Sessions hashing to this shard.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    Shard& _getShard(const LogicalSessionId& lsid) {
+        return _shards[LogicalSessionIdHash()(lsid) % kNumShards];
+    }
+
     /**
      * Blocking method, which checks-out the session set on 'opCtx'.
      */
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The returned
-     * pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Creates or returns the session runtime info for 'lsid' from the map of 'shard', which must be
+     * the shard owning 'lsid'. The returned pointer is guaranteed to be linked on the map for as
+     * long as the shard mutex is held.
      */
     SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock,
+                                                       Shard& shard,
                                                        OperationContext* opCtx,
                                                        const LogicalSessionId& lsid);
 
@@ -153,12 +176,7 @@ private:
      */
     void _releaseSession(SessionRuntimeInfo* sri, boost::optional<KillToken> killToken);
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    std::array<Shard, kNumShards> _shards;
 };
 
 /**
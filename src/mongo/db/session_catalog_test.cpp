@@ -225,6 +225,50 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessions) {
     lsidsFound.clear();
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, SessionsCheckedOutConcurrentlyAcrossShards) {
+    // Enough sessions that every shard of the catalog owns some of them.
+    std::vector<LogicalSessionId> lsids;
+    for (int i = 0; i < 100; ++i) {
+        lsids.push_back(makeLogicalSessionIdForTest());
+    }
+
+    // Hold every session checked out at the same time, each from its own thread.
+    unittest::Barrier sessionsCheckedOut(lsids.size() + 1);
+    unittest::Barrier sessionsCheckedIn(lsids.size() + 1);
+    std::vector<stdx::future<void>> futures;
+    for (const auto& lsid : lsids) {
+        futures.push_back(stdx::async(stdx::launch::async, [&, lsid] {
+            ThreadClient tc(getServiceContext());
+            auto opCtx = makeOperationContext();
+            opCtx->setLogicalSessionId(lsid);
+            OperationContextSession ocs(opCtx.get());
+            sessionsCheckedOut.countDownAndWait();
+            sessionsCheckedIn.countDownAndWait();
+        }));
+    }
+    sessionsCheckedOut.countDownAndWait();
+
+    ASSERT_EQ(lsids.size(), catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](const ObservableSession& session) {
+        ASSERT(session.currentOperation());
+        lsidsFound.insert(session.getSessionId());
+    });
+    ASSERT_EQ(lsids.size(), lsidsFound.size());
+
+    sessionsCheckedIn.countDownAndWait();
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    catalog()->scanSessions(matcherAllSessions, [&](const ObservableSession& session) {
+        ASSERT(!session.currentOperation());
+    });
+}
+
 TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     // Create three sessions in the catalog.
     const std::vector<LogicalSessionId> lsids{makeLogicalSessionIdForTest(),
@@ -49,13 +49,14 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
-#include <snappy.h>
 #include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_compression.h"
+#include "mongo/db/sorter/sorter_thread_pool.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
@@ -63,6 +64,7 @@
 #include "mongo/s/is_mongos.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
+#include "mongo/util/future.h"
 #include "mongo/util/str.h"
 #include "mongo/util/unowned_ptr.h"
 
@@ -179,13 +181,15 @@ public:
                  std::streampos fileStartOffset,
                  std::streampos fileEndOffset,
                  const Settings& settings,
-                 const uint32_t checksum)
+                 const uint32_t checksum,
+                 SorterCompressorEnum compressor)
         : _settings(settings),
           _done(false),
           _fileFullPath(fileFullPath),
           _fileStartOffset(fileStartOffset),
           _fileEndOffset(fileEndOffset),
-          _originalChecksum(checksum) {
+          _originalChecksum(checksum),
+          _compressor(compressor) {
         uassert(16815,
                 str::stream() << "unexpected empty file: " << _fileFullPath,
                 boost::filesystem::file_size(_fileFullPath) != 0);
@@ -255,7 +259,9 @@ public:
     }
 
     SorterRange getRange() const {
-        return {_fileStartOffset, _fileEndOffset, _originalChecksum};
+        SorterRange range{_fileStartOffset, _fileEndOffset, _originalChecksum};
+        range.setCompressor(_compressor);
+        return range;
     }
 
 private:
@@ -309,17 +315,9 @@ private:
             return;
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
-
         size_t uncompressedSize;
-        uassert(17061,
-                "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
-
-        std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
-        uassert(17062,
-                "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+        std::unique_ptr<char[]> decompressionBuffer =
+            decompressBlock(_compressor, _buffer.get(), blockSize, &uncompressedSize);
 
         // hold on to decompressed data and throw out compressed data at block exit
         _buffer.swap(decompressionBuffer);
@@ -373,6 +371,9 @@ private:
     // to disk. This is not modified, and is only used for comparison against _afterReadChecksum
     // when the FileIterator is exhausted to ensure no data corruption.
     const uint32_t _originalChecksum;
+
+    // The codec the SortedFileWriter used for the compressed blocks of this data range.
+    const SorterCompressorEnum _compressor;
 };
 
 /**
@@ -524,6 +525,145 @@ private:
     std::string _itersSourceFileFullPath;
 };
 
+/**
+ * Merges a set of sorted runs in one pass using a tournament tree of losers. Each internal node
+ * of the tree remembers the run that lost the match played there, so replacing the overall winner
+ * only replays the matches on the path from its leaf to the root, costing log2(k) comparisons per
+ * element for k runs. Ties are broken in favor of the earlier run, which keeps the merge stable.
+ */
+template <typename RandomIt, typename Compare>
+class LoserTree {
+public:
+    using Run = std::pair<RandomIt, RandomIt>;
+
+    LoserTree(std::vector<Run> runs, const Compare& less)
+        : _runs(std::move(runs)), _less(less), _tree(_runs.size()) {
+        invariant(!_runs.empty());
+        _tree[0] = _initialize(1);
+    }
+
+    bool more() const {
+        return !_exhausted(_tree[0]);
+    }
+
+    /**
+     * Returns an iterator to the smallest remaining element and advances past it. Illegal to call
+     * if there are no more elements.
+     */
+    RandomIt next() {
+        size_t winner = _tree[0];
+        RandomIt out = _runs[winner].first++;
+
+        for (size_t node = (winner + _runs.size()) / 2; node > 0; node /= 2) {
+            if (_beats(_tree[node], winner)) {
+                std::swap(_tree[node], winner);
+            }
+        }
+        _tree[0] = winner;
+        return out;
+    }
+
+private:
+    // The leaf of run 'i' is node 'k + i' of an implicit binary tree whose internal nodes are
+    // numbered 1 through k - 1, so the shape works for any number of runs.
+    size_t _initialize(size_t node) {
+        if (node >= _runs.size()) {
+            return node - _runs.size();
+        }
+
+        size_t left = _initialize(2 * node);
+        size_t right = _initialize(2 * node + 1);
+        if (_beats(left, right)) {
+            _tree[node] = right;
+            return left;
+        }
+        _tree[node] = left;
+        return right;
+    }
+
+    bool _exhausted(size_t run) const {
+        return _runs[run].first == _runs[run].second;
+    }
+
+    bool _beats(size_t lhs, size_t rhs) const {
+        if (_exhausted(lhs) || _exhausted(rhs)) {
+            return _exhausted(rhs) && !_exhausted(lhs);
+        }
+        if (_less(*_runs[rhs].first, *_runs[lhs].first)) {
+            return false;
+        }
+        return lhs < rhs || _less(*_runs[lhs].first, *_runs[rhs].first);
+    }
+
+    std::vector<Run> _runs;
+    const Compare& _less;
+    std::vector<size_t> _tree;  // _tree[0] is the winner, the other nodes hold losers.
+};
+
+/**
+ * Stable-sorts 'data' by splitting it into up to 'numThreads' pieces, sorting the pieces
+ * concurrently on the sorter thread pool and merging them with a LoserTree. The calling thread
+ * sorts the first piece itself. Falls back to a serial sort when there is too little data for the
+ * split to pay off.
+ */
+template <typename Data, typename Compare>
+void parallelStableSort(std::deque<Data>& data, const Compare& less, size_t numThreads) {
+    // Below this many elements per piece, scheduling and merging cost more than they save.
+    const size_t kMinElementsPerPiece = 1024;
+
+    const size_t numPieces = std::min(numThreads, data.size() / kMinElementsPerPiece);
+    if (numPieces <= 1) {
+        std::stable_sort(data.begin(), data.end(), less);
+        return;
+    }
+
+    using Run = typename LoserTree<typename std::deque<Data>::iterator, Compare>::Run;
+    std::vector<Run> runs;
+    runs.reserve(numPieces);
+    for (size_t i = 0; i < numPieces; ++i) {
+        runs.emplace_back(data.begin() + data.size() * i / numPieces,
+                          data.begin() + data.size() * (i + 1) / numPieces);
+    }
+
+    std::vector<Future<void>> pieces;
+    pieces.reserve(numPieces - 1);
+    for (size_t i = 1; i < numPieces; ++i) {
+        auto pf = makePromiseFuture<void>();
+        getSortThreadPool().schedule(
+            [run = runs[i], &less, promise = std::move(pf.promise)](Status status) mutable {
+                if (!status.isOK()) {
+                    promise.setError(std::move(status));
+                    return;
+                }
+                promise.setWith([&] { std::stable_sort(run.first, run.second, less); });
+            });
+        pieces.push_back(std::move(pf.future));
+    }
+
+    // The pieces running on the pool reference 'data' and 'less', so every one of them must have
+    // finished before an error from any of them, or from this thread, is allowed to escape.
+    Status status = Status::OK();
+    try {
+        std::stable_sort(runs[0].first, runs[0].second, less);
+    } catch (const DBException& ex) {
+        status = ex.toStatus();
+    }
+    for (auto& piece : pieces) {
+        auto pieceStatus = piece.getNoThrow();
+        if (status.isOK()) {
+            status = std::move(pieceStatus);
+        }
+    }
+    uassertStatusOK(status);
+
+    std::deque<Data> merged;
+    LoserTree<typename std::deque<Data>::iterator, Compare> tree(std::move(runs), less);
+    while (tree.more()) {
+        merged.push_back(std::move(*tree.next()));
+    }
+    data.swap(merged);
+}
+
 template <typename Key, typename Value, typename Comparator>
 class NoLimitSorter : public Sorter<Key, Value> {
 public:
@@ -562,7 +702,8 @@ public:
                                range.getStartOffset(),
                                range.getEndOffset(),
                                this->_settings,
-                               range.getChecksum());
+                               range.getChecksum(),
+                               range.getCompressor());
                        });
     }
 
@@ -625,6 +766,10 @@ private:
 
     void sort() {
         STLComparator less(_comp);
+        if (this->_opts.numSortThreads > 1) {
+            parallelStableSort(_data, less, this->_opts.numSortThreads);
+            return;
+        }
         std::stable_sort(_data.begin(), _data.end(), less);
 
         // Does 2x more compares than stable_sort
@@ -1015,6 +1160,7 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
                                                const std::streampos fileStartOffset,
                                                const Settings& settings)
     : _settings(settings),
+      _compressor(opts.compressor),
       _fileFullPath(fileFullPath),
       // The file descriptor is positioned at the end of a file when opened in append mode, but
       // _file.tellp() is not initialized on all systems to reflect this. Therefore, we must also
@@ -1072,10 +1218,7 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
-    verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
-
-    const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
+    const bool shouldCompress = sorter::compressBlock(_compressor, outBuffer, size, &compressed);
     if (shouldCompress) {
         size = compressed.size();
         outBuffer = const_cast<char*>(compressed.data());
@@ -1128,7 +1271,7 @@ SortIteratorInterface<Key, Value>* SortedFileWriter<Key, Value>::done() {
     _file.close();
 
     return new sorter::FileIterator<Key, Value>(
-        _fileFullPath, _fileStartOffset, _fileEndOffset, _settings, _checksum);
+        _fileFullPath, _fileStartOffset, _fileEndOffset, _settings, _checksum, _compressor);
 }
 
 //
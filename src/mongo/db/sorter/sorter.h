@@ -108,7 +108,21 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // The codec used to compress the blocks of data ranges spilled to disk. The codec is recorded
+    // in each range's SorterRange so that persisted ranges are read back with the right codec.
+    SorterCompressorEnum compressor;
+
+    // The number of threads used to sort each batch of in-memory data before it is spilled or
+    // returned. With more than one, the batch is split into pieces that are sorted concurrently on
+    // the sorter thread pool and then merged. Only honored by sorters without a limit.
+    size_t numSortThreads;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          compressor(SorterCompressorEnum::kSnappy),
+          numSortThreads(1) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -131,6 +145,16 @@ struct SortOptions {
         tempDir = newTempDir;
         return *this;
     }
+
+    SortOptions& Compressor(SorterCompressorEnum newCompressor) {
+        compressor = newCompressor;
+        return *this;
+    }
+
+    SortOptions& NumSortThreads(size_t newNumSortThreads) {
+        numSortThreads = newNumSortThreads;
+        return *this;
+    }
 };
 
 /**
@@ -263,6 +287,13 @@ public:
         return _usedDisk;
     }
 
+    /**
+     * Returns the number of sorted runs which have been written to disk so far.
+     */
+    size_t numSpills() const {
+        return _iters.size();
+    }
+
     PersistedState getPersistedState() const {
         return {_fileName, _getRanges()};
     }
@@ -334,6 +365,7 @@ private:
     void spill();
 
     const Settings _settings;
+    const SorterCompressorEnum _compressor;
     std::string _fileFullPath;
     std::ofstream _file;
     BufBuilder _buffer;
@@ -0,0 +1,164 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo {
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the comment on the same function in sorter_test.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> sorterBenchmarkFileCounter;
+    return "extsort-sorter-bm." + std::to_string(sorterBenchmarkFileCounter.fetchAndAdd(1));
+}
+
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace {
+
+// The benchmarks sort the same key and value types as an index build's BulkBuilder.
+using KeySorter = Sorter<KeyString::Value, NullValue>;
+
+struct KeyStringComparison {
+    int operator()(const KeySorter::Data& lhs, const KeySorter::Data& rhs) const {
+        return lhs.first.compare(rhs.first);
+    }
+};
+
+constexpr int kNumKeys = 100 * 1000;
+const Ordering kAllAscending = Ordering::make(BSONObj());
+
+enum KeyDistribution : int64_t { kSequential, kReverse, kRandom, kFewDistinct };
+
+/**
+ * Returns 'kNumKeys' index keys over a single int field, generated in the order described by
+ * 'distribution'. Each key carries a distinct RecordId as it would in a non-unique index.
+ */
+std::vector<KeyString::Value> makeKeys(KeyDistribution distribution) {
+    PseudoRandom random(1);
+    std::vector<KeyString::Value> keys;
+    keys.reserve(kNumKeys);
+    for (int i = 0; i < kNumKeys; ++i) {
+        int value = i;
+        switch (distribution) {
+            case kSequential:
+                break;
+            case kReverse:
+                value = kNumKeys - i;
+                break;
+            case kRandom:
+                value = random.nextInt32();
+                break;
+            case kFewDistinct:
+                value = random.nextInt32(16);
+                break;
+        }
+        KeyString::Builder builder(
+            KeyString::Version::kLatestVersion, BSON("" << value), kAllAscending, RecordId(i + 1));
+        keys.push_back(builder.getValueCopy());
+    }
+    return keys;
+}
+
+StringData distributionName(KeyDistribution distribution) {
+    switch (distribution) {
+        case kSequential:
+            return "sequential"_sd;
+        case kReverse:
+            return "reverse"_sd;
+        case kRandom:
+            return "random"_sd;
+        case kFewDistinct:
+            return "fewDistinct"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+/**
+ * Adds 'kNumKeys' keys to a Sorter and drains the sorted output once per iteration.
+ *
+ * state.range(0) selects the KeyDistribution. state.range(1) is the memory limit in KB; the sorter
+ * spills to disk and merges the spilled ranges whenever the keys do not fit in it. state.range(2)
+ * is the number of sort threads.
+ */
+void BM_SortKeys(benchmark::State& state) {
+    const auto distribution = static_cast<KeyDistribution>(state.range(0));
+    const auto keys = makeKeys(distribution);
+    unittest::TempDir tempDir("sorter_bm");
+    const auto opts = SortOptions()
+                          .TempDir(tempDir.path())
+                          .MaxMemoryUsageBytes(state.range(1) * 1024)
+                          .ExtSortAllowed()
+                          .NumSortThreads(state.range(2));
+    const KeySorter::Settings settings{KeyString::Version::kLatestVersion, {}};
+
+    for (auto _ : state) {
+        std::unique_ptr<KeySorter> sorter(KeySorter::make(opts, KeyStringComparison(), settings));
+        for (const auto& key : keys) {
+            sorter->add(key, NullValue());
+        }
+
+        std::unique_ptr<KeySorter::Iterator> it(sorter->done());
+        while (it->more()) {
+            benchmark::DoNotOptimize(it->next());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumKeys);
+    state.SetLabel(distributionName(distribution).toString());
+}
+
+void SortKeysArgs(benchmark::internal::Benchmark* b) {
+    for (auto distribution : {kSequential, kReverse, kRandom, kFewDistinct}) {
+        // 100MB keeps the sort in memory, while the smaller limits spill a few and a few dozen
+        // ranges respectively.
+        for (int64_t memoryLimitKB : {100 * 1024, 1024, 256}) {
+            b->Args({distribution, memoryLimitKB, 1});
+        }
+    }
+    b->Args({kRandom, 1024, 4});
+}
+
+BENCHMARK(BM_SortKeys)->Apply(SortKeysArgs)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/sorter/sorter_compression.h"
+
+#include <limits>
+#include <snappy.h>
+#include <zstd.h>
+
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sorter {
+namespace {
+// Only keep the compressed form of a block if it saves at least 10% of its size.
+bool worthCompressing(size_t compressedSize, size_t size) {
+    return compressedSize < size / 10 * 9;
+}
+}  // namespace
+
+bool compressBlock(SorterCompressorEnum compressor,
+                   const char* data,
+                   size_t size,
+                   std::string* out) {
+    switch (compressor) {
+        case SorterCompressorEnum::kNone:
+            return false;
+        case SorterCompressorEnum::kSnappy:
+            snappy::Compress(data, size, out);
+            break;
+        case SorterCompressorEnum::kZstd: {
+            out->resize(ZSTD_compressBound(size));
+            size_t ret = ZSTD_compress(&(*out)[0], out->size(), data, size, ZSTD_CLEVEL_DEFAULT);
+            uassert(5190070,
+                    str::stream() << "Failed to compress data: " << ZSTD_getErrorName(ret),
+                    !ZSTD_isError(ret));
+            out->resize(ret);
+            break;
+        }
+    }
+
+    verify(out->size() <= size_t(std::numeric_limits<int32_t>::max()));
+    return worthCompressing(out->size(), size);
+}
+
+std::unique_ptr<char[]> decompressBlock(SorterCompressorEnum compressor,
+                                        const char* data,
+                                        size_t size,
+                                        size_t* uncompressedSize) {
+    std::unique_ptr<char[]> decompressionBuffer;
+    switch (compressor) {
+        case SorterCompressorEnum::kNone:
+            uasserted(5190071, "found a compressed block in an uncompressed data range");
+        case SorterCompressorEnum::kSnappy:
+            dassert(snappy::IsValidCompressedBuffer(data, size));
+
+            uassert(17061,
+                    "couldn't get uncompressed length",
+                    snappy::GetUncompressedLength(data, size, uncompressedSize));
+
+            decompressionBuffer.reset(new char[*uncompressedSize]);
+            uassert(17062,
+                    "decompression failed",
+                    snappy::RawUncompress(data, size, decompressionBuffer.get()));
+            break;
+        case SorterCompressorEnum::kZstd: {
+            auto contentSize = ZSTD_getFrameContentSize(data, size);
+            uassert(5190072,
+                    "couldn't get uncompressed length",
+                    contentSize != ZSTD_CONTENTSIZE_UNKNOWN &&
+                        contentSize != ZSTD_CONTENTSIZE_ERROR);
+            *uncompressedSize = contentSize;
+
+            decompressionBuffer.reset(new char[*uncompressedSize]);
+            size_t ret =
+                ZSTD_decompress(decompressionBuffer.get(), *uncompressedSize, data, size);
+            uassert(5190073,
+                    str::stream() << "decompression failed: " << ZSTD_getErrorName(ret),
+                    !ZSTD_isError(ret) && ret == *uncompressedSize);
+            break;
+        }
+    }
+    return decompressionBuffer;
+}
+
+}  // namespace mongo::sorter
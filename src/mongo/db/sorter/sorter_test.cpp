@@ -310,10 +310,63 @@ public:
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
 
+        for (auto compressor : {SorterCompressorEnum::kNone,
+                                SorterCompressorEnum::kSnappy,
+                                SorterCompressorEnum::kZstd}) {  // every block codec
+            const SortOptions compressedOpts = SortOptions(opts).Compressor(compressor);
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(compressedOpts, fileName, 0);
+            for (int i = 0; i < 100 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+
+            std::shared_ptr<IWIterator> it(sorter.done());
+            ASSERT(it->getRange().getCompressor() == compressor);
+            ASSERT_ITERATORS_EQUIVALENT(it, make_shared<IntIterator>(0, 100 * 1000));
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
+
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
 };
 
+/**
+ * Resumes a sorter from ranges spilled with a codec other than the one in the resuming sorter's
+ * options, which must read each range back with the codec recorded for it.
+ */
+class ResumeFromCompressedRanges : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        unittest::TempDir tempDir("sorterResumeTests");
+        const SortOptions opts =
+            SortOptions().TempDir(tempDir.path()).MaxMemoryUsageBytes(64 * 1024).ExtSortAllowed();
+
+        IWSorter::PersistedState state;
+        {
+            std::unique_ptr<IWSorter> sorter(IWSorter::make(
+                SortOptions(opts).Compressor(SorterCompressorEnum::kZstd), IWComparator(ASC)));
+            for (int i = kNumItems - 1; i >= 0; i--)
+                sorter->add(i, -i);
+            sorter->persistDataForShutdown();
+            state = sorter->getPersistedState();
+        }
+
+        ASSERT_GT(state.ranges.size(), 1U);
+        for (const auto& range : state.ranges)
+            ASSERT(range.getCompressor() == SorterCompressorEnum::kZstd);
+
+        std::unique_ptr<IWSorter> sorter(IWSorter::makeFromExistingRanges(
+            state.fileName, state.ranges, opts, IWComparator(ASC)));
+        ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter->done()),
+                                    make_shared<IntIterator>(0, kNumItems));
+
+        ASSERT(boost::filesystem::is_empty(tempDir.path()));
+    }
+
+private:
+    static constexpr int kNumItems = 50 * 1000;
+};
+
 
 class MergeIteratorTests {
 public:
@@ -613,6 +666,56 @@ class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     }
     enum { MEM_LIMIT = 32 * 1024 };
 };
+
+template <bool Random = true>
+class ParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return Parent::adjustSortOptions(opts).NumSortThreads(4);
+    }
+};
+
+class ParallelSortInMemory : public LotsOfDataLittleMemory</*random=*/true> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return opts.NumSortThreads(4);
+    }
+    boost::optional<size_t> correctNumRanges() const override {
+        return 0;
+    }
+};
+
+/**
+ * Elements with equal keys must come back in insertion order even though the pieces they were
+ * sorted in are merged back together.
+ */
+class ParallelSortIsStable : public ScopedGlobalServiceContextForTest {
+public:
+    void run() {
+        const SortOptions opts = SortOptions().NumSortThreads(8);
+        std::unique_ptr<IWSorter> sorter(IWSorter::make(opts, IWComparator(ASC)));
+        for (int i = 0; i < kNumItems; i++)
+            sorter->add(i % kNumKeys, i);
+
+        std::unique_ptr<IWIterator> it(sorter->done());
+        it->openSource();
+        int count = 0;
+        IWPair prev(-1, -1);
+        while (it->more()) {
+            IWPair cur = it->next();
+            ASSERT_LTE(prev.first, cur.first);
+            if (prev.first == cur.first)
+                ASSERT_LT(prev.second, cur.second);
+            prev = cur;
+            count++;
+        }
+        it->closeSource();
+        ASSERT_EQ(count, kNumItems);
+    }
+
+private:
+    static constexpr int kNumItems = 100 * 1000;
+    static constexpr int kNumKeys = 7;
+};
 }  // namespace SorterTests
 
 class SorterSuite : public mongo::unittest::OldStyleSuiteSpecification {
@@ -625,6 +728,7 @@ public:
     void setupTests() override {
         add<InMemIterTests>();
         add<SortedFileWriterAndFileIteratorTests>();
+        add<ResumeFromCompressedRanges>();
         add<MergeIteratorTests>();
         add<SorterTests::Basic>();
         add<SorterTests::Limit>();
@@ -637,6 +741,10 @@ public:
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/true>>();    // fits in mem
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/false>>();  // spills
         add<SorterTests::LotsOfDataWithLimit<5000, /*random=*/true>>();   // spills
+        add<SorterTests::ParallelSort</*random=*/false>>();
+        add<SorterTests::ParallelSort</*random=*/true>>();
+        add<SorterTests::ParallelSortInMemory>();
+        add<SorterTests::ParallelSortIsStable>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t>>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> - 1>>();
         add<SorterTests::LimitExtreme<kMaxAsU64<uint32_t> + 1>>();
@@ -60,5 +60,32 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the per query shape histograms to the server status, when requested.
+ */
+class QueryShapeHistogramServerStatusSection final : public ServerStatusSection {
+public:
+    QueryShapeHistogramServerStatusSection() : ServerStatusSection("queryShapeLatencies") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        bool includeHistograms = false;
+        if (configElem.type() == BSONType::Object) {
+            includeHistograms = configElem.Obj()["histograms"].trueValue();
+        }
+        BSONObjBuilder builder;
+        BSONArrayBuilder shapesBuilder(builder.subarrayStart("shapes"));
+        for (auto&& shape : Top::get(opCtx->getServiceContext())
+                                .getQueryShapeStats(boost::none, includeHistograms)) {
+            shapesBuilder.append(shape);
+        }
+        shapesBuilder.done();
+        return builder.obj();
+    }
+} queryShapeHistogramServerStatusSection;
 }  // namespace
 }  // namespace mongo
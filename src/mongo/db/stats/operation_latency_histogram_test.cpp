@@ -134,4 +134,22 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
         ASSERT_EQUALS(bucket["count"].Long(), 83);
     }
 }
+
+TEST(OperationLatencyHistogram, AddMergesCountsAndLatency) {
+    OperationLatencyHistogram first, second;
+    first.increment(kLowerBounds[1], Command::ReadWriteType::kRead);
+    second.increment(kLowerBounds[1], Command::ReadWriteType::kRead);
+    second.increment(kLowerBounds[2], Command::ReadWriteType::kWrite);
+
+    first.add(second);
+    BSONObjBuilder outBuilder;
+    first.append(true, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["ops"].Long(), 2);
+    ASSERT_EQUALS(static_cast<uint64_t>(out["reads"]["latency"].Long()), 2 * kLowerBounds[1]);
+    ASSERT_EQUALS(out["reads"]["histogram"].Array()[1].Obj()["count"].Long(), 2);
+    ASSERT_EQUALS(out["writes"]["ops"].Long(), 1);
+    ASSERT_EQUALS(static_cast<uint64_t>(out["writes"]["latency"].Long()), kLowerBounds[2]);
+    ASSERT_EQUALS(out["commands"]["ops"].Long(), 0);
+}
 }  // namespace mongo
@@ -35,6 +35,8 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/stats/top_gen.h"
+#include "mongo/util/hex.h"
 
 namespace mongo {
 
@@ -82,12 +84,23 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& partition = _getUsagePartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = partition.usage[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
+Top::UsagePartition& Top::_getUsagePartition(const StringMapHashedKey& hashedNs) {
+    // The low bits of the hash pick the slot within the partition's own map, so use the high
+    // bits here to keep the two choices independent.
+    return _usagePartitions[(hashedNs.hash() >> 32) % kNumUsagePartitions];
+}
+
+Top::GlobalHistogramStripe& Top::_getGlobalHistogramStripe() {
+    return _globalHistogramStripes[StripedCounter64::stripeIndex()];
+}
+
 void Top::_record(OperationContext* opCtx,
                   CollectionData& c,
                   LogicalOp logicalOp,
@@ -134,18 +147,24 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
+    auto& partition = _getUsagePartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
+    partition.usage.erase(hashedNs);
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out.clear();
+    for (const auto& partition : _usagePartitions) {
+        stdx::lock_guard<SimpleMutex> lk(partition.lock);
+        out.insert(partition.usage.begin(), partition.usage.end());
+    }
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    UsageMap usage;
+    cloneMap(usage);
+    _appendToUsageMap(b, usage);
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -190,9 +209,11 @@ void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto& partition = _getUsagePartition(hashedNs);
+    stdx::lock_guard<SimpleMutex> lk(partition.lock);
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+    partition.usage[hashedNs].opLatencyHistogram.append(
+        includeHistograms, false, &latencyStatsBuilder);
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
@@ -203,20 +224,96 @@ void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    auto& stripe = _getGlobalHistogramStripe();
+    stdx::lock_guard<SimpleMutex> guard(stripe.lock);
+    _incrementHistogram(opCtx, latency, &stripe.histogram, readWriteType);
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
+    OperationLatencyHistogram globalHistogram;
+    for (const auto& stripe : _globalHistogramStripes) {
+        stdx::lock_guard<SimpleMutex> guard(stripe.lock);
+        globalHistogram.add(stripe.histogram);
+    }
+    globalHistogram.append(includeHistograms, slowMSBucketsOnly, builder);
+}
+
+void Top::recordQueryShapeStats(OperationContext* opCtx,
+                                StringData ns,
+                                StringData command,
+                                uint32_t queryHash,
+                                uint64_t latency,
+                                Command::ReadWriteType readWriteType,
+                                long long keysExamined,
+                                long long docsExamined,
+                                StringData planSummary) {
+    const auto maxEntries = static_cast<size_t>(gInternalQueryShapeLatencyStatsMaxEntries.load());
+    if (maxEntries == 0 || ns.empty() || ns[0] == '?')
+        return;
+
+    // Round up, so that every partition can hold at least one shape.
+    const auto maxEntriesPerPartition =
+        (maxEntries + kNumQueryShapePartitions - 1) / kNumQueryShapePartitions;
+
+    QueryShapeKey key{ns.toString(), command.toString(), queryHash};
+    auto& partition = _queryShapePartitions[queryHash % kNumQueryShapePartitions];
+    stdx::lock_guard<SimpleMutex> guard(partition.lock);
+    auto it = partition.shapes.promote(key);
+    if (it == partition.shapes.end()) {
+        partition.shapes.add(key, QueryShapeData());
+        while (partition.shapes.size() > maxEntriesPerPartition) {
+            partition.shapes.erase(std::prev(partition.shapes.end()));
+        }
+        it = partition.shapes.begin();
+    }
+
+    QueryShapeData& data = it->second;
+    _incrementHistogram(opCtx, latency, &data.opLatencyHistogram, readWriteType);
+    data.execCount++;
+    data.keysExamined += keysExamined;
+    data.docsExamined += docsExamined;
+    if (data.lastPlanSummary != planSummary) {
+        data.lastPlanSummary = planSummary.toString();
+    }
+    data.lastExecution = Date_t::now();
+}
+
+std::vector<BSONObj> Top::getQueryShapeStats(const boost::optional<NamespaceString>& nss,
+                                             bool includeHistograms) const {
+    std::vector<BSONObj> results;
+    for (const auto& partition : _queryShapePartitions) {
+        stdx::lock_guard<SimpleMutex> guard(partition.lock);
+        for (auto it = partition.shapes.cbegin(); it != partition.shapes.cend(); ++it) {
+            const auto& [ns, command, queryHash] = it->first;
+            if (nss && nss->ns() != ns) {
+                continue;
+            }
+
+            const QueryShapeData& data = it->second;
+            BSONObjBuilder shapeBuilder;
+            shapeBuilder.append("ns", ns);
+            shapeBuilder.append("command", command);
+            shapeBuilder.append("queryHash", zeroPaddedHex(queryHash));
+            shapeBuilder.appendNumber("execCount", data.execCount);
+            shapeBuilder.appendNumber("keysExamined", data.keysExamined);
+            shapeBuilder.appendNumber("docsExamined", data.docsExamined);
+            shapeBuilder.append("lastPlanSummary", data.lastPlanSummary);
+            shapeBuilder.append("lastExecution", data.lastExecution);
+            BSONObjBuilder latencyStatsBuilder(shapeBuilder.subobjStart("latencyStats"));
+            data.opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+            latencyStatsBuilder.done();
+            results.push_back(shapeBuilder.obj());
+        }
+    }
+    return results;
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
+    auto& stripe = _getGlobalHistogramStripe();
+    stdx::lock_guard<SimpleMutex> guard(stripe.lock);
+    stripe.histogram.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
 void Top::_incrementHistogram(OperationContext* opCtx,
@@ -33,13 +33,19 @@
  * DB usage monitor.
  */
 
+#include <array>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <limits>
+#include <tuple>
 
+#include "mongo/base/counter.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/string_map.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
@@ -95,6 +101,18 @@ public:
 
     typedef StringMap<CollectionData> UsageMap;
 
+    /**
+     * Execution statistics aggregated over every operation of one query shape.
+     */
+    struct QueryShapeData {
+        OperationLatencyHistogram opLatencyHistogram;
+        long long execCount = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        std::string lastPlanSummary;
+        Date_t lastExecution;
+    };
+
 public:
     void record(OperationContext* opCtx,
                 StringData ns,
@@ -136,6 +154,27 @@ public:
                                   bool slowMSBucketsOnly,
                                   BSONObjBuilder* builder);
 
+    /**
+     * Records an operation in the statistics of the given namespace, command and query shape,
+     * keeping at most internalQueryShapeLatencyStatsMaxEntries shapes. The least recently used
+     * shape of a partition is evicted to make room for a new one.
+     */
+    void recordQueryShapeStats(OperationContext* opCtx,
+                               StringData ns,
+                               StringData command,
+                               uint32_t queryHash,
+                               uint64_t latency,
+                               Command::ReadWriteType readWriteType,
+                               long long keysExamined,
+                               long long docsExamined,
+                               StringData planSummary);
+
+    /**
+     * Returns one document per tracked query shape, restricted to the namespace 'nss' if given.
+     */
+    std::vector<BSONObj> getQueryShapeStats(const boost::optional<NamespaceString>& nss,
+                                            bool includeHistograms) const;
+
 private:
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
@@ -153,9 +192,46 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
-    OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    // The collection usage is partitioned by namespace hash, each partition with its own mutex,
+    // so that concurrent operations on different collections rarely contend with each other.
+    static constexpr size_t kNumUsagePartitions = 16;
+
+    struct UsagePartition {
+        mutable SimpleMutex lock;
+        UsageMap usage;
+    };
+
+    UsagePartition& _getUsagePartition(const StringMapHashedKey& hashedNs);
+
+    std::array<CacheAligned<UsagePartition>, kNumUsagePartitions> _usagePartitions;
+
+    // The global histogram is striped by thread, as StripedCounter64 is, and the stripes are only
+    // merged when the statistics are read.
+    struct GlobalHistogramStripe {
+        mutable SimpleMutex lock;
+        OperationLatencyHistogram histogram;
+    };
+
+    GlobalHistogramStripe& _getGlobalHistogramStripe();
+
+    std::array<CacheAligned<GlobalHistogramStripe>, StripedCounter64::kNumStripes>
+        _globalHistogramStripes;
+
+    // Namespace, command name and query hash.
+    using QueryShapeKey = std::tuple<std::string, std::string, uint32_t>;
+
+    // The query shapes are partitioned by query hash, each partition with its own mutex, so that
+    // concurrent operations of different shapes rarely contend with each other.
+    // The size limit is split evenly across the partitions and enforced on insertion, so that it
+    // can change at runtime.
+    static constexpr size_t kNumQueryShapePartitions = 16;
+
+    struct QueryShapePartition {
+        mutable SimpleMutex lock;
+        LRUCache<QueryShapeKey, QueryShapeData> shapes{std::numeric_limits<std::size_t>::max()};
+    };
+
+    std::array<QueryShapePartition, kNumQueryShapePartitions> _queryShapePartitions;
 };
 
 }  // namespace mongo
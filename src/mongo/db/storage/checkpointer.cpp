@@ -33,9 +33,12 @@
 
 #include "mongo/db/storage/checkpointer.h"
 
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -48,6 +51,22 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+// How often the checkpoint thread wakes while waiting for the next checkpoint, to check the cache
+// if 'checkpointDirtyCacheTriggerFraction' is set. The knob is adjustable at runtime, so the thread
+// wakes regardless.
+const Seconds kDirtyCacheCheckInterval{1};
+
+Counter64 checkpointsTaken;
+Counter64 checkpointsTriggeredByDirtyCache;
+Counter64 checkpointsTotalMillis;
+
+ServerStatusMetricField<Counter64> displayCheckpointsTaken("storage.checkpoints.count",
+                                                           &checkpointsTaken);
+ServerStatusMetricField<Counter64> displayCheckpointsTriggeredByDirtyCache(
+    "storage.checkpoints.triggeredByDirtyCache", &checkpointsTriggeredByDirtyCache);
+ServerStatusMetricField<Counter64> displayCheckpointsTotalMillis("storage.checkpoints.totalMillis",
+                                                                 &checkpointsTotalMillis);
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -79,11 +98,32 @@ void Checkpointer::run() {
             MONGO_IDLE_THREAD_BLOCK;
 
             // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
+            // is signaled, a checkpoint is triggered or enough of the cache is dirty to checkpoint
+            // early.
+            const Date_t deadline = Date_t::now() +
+                Seconds(static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs));
+            while (!_shuttingDown && !_triggerCheckpoint) {
+                const Date_t now = Date_t::now();
+                if (now >= deadline) {
+                    break;
+                }
+
+                const Date_t wakeup = std::min(deadline, now + kDirtyCacheCheckInterval);
+                _sleepCV.wait_until(lock, wakeup.toSystemTimePoint(), [&] {
+                    return _shuttingDown || _triggerCheckpoint;
+                });
+
+                if (!_shuttingDown && !_triggerCheckpoint &&
+                    gCheckpointDirtyCacheTriggerFraction.load() > 0) {
+                    lock.unlock();
+                    const bool dirty = _isCacheDirtyEnoughToCheckpoint();
+                    lock.lock();
+                    if (dirty) {
+                        checkpointsTriggeredByDirtyCache.increment();
+                        break;
+                    }
+                }
+            }
 
             // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
             // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
@@ -116,7 +156,11 @@ void Checkpointer::run() {
         // TODO SERVER-50861: Access the storage engine via the ServiceContext.
         _kvEngine->checkpoint();
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
+        const auto elapsed = Date_t::now() - startTime;
+        checkpointsTaken.increment();
+        checkpointsTotalMillis.increment(durationCount<Milliseconds>(elapsed));
+
+        const auto secondsElapsed = durationCount<Seconds>(elapsed);
         if (secondsElapsed >= 30) {
             LOGV2_DEBUG(22308,
                         1,
@@ -126,6 +170,21 @@ void Checkpointer::run() {
     }
 }
 
+bool Checkpointer::_isCacheDirtyEnoughToCheckpoint() const {
+    const auto triggerFraction = gCheckpointDirtyCacheTriggerFraction.load();
+    const auto dirtyFraction = _kvEngine->getCacheDirtyFraction();
+    if (triggerFraction <= 0 || !dirtyFraction || *dirtyFraction < triggerFraction) {
+        return false;
+    }
+
+    LOGV2_DEBUG(5191480,
+                1,
+                "Taking an early checkpoint because the cache is dirty",
+                "dirtyFraction"_attr = *dirtyFraction,
+                "triggerFraction"_attr = triggerFraction);
+    return true;
+}
+
 void Checkpointer::triggerFirstStableCheckpoint(Timestamp prevStable,
                                                 Timestamp initialData,
                                                 Timestamp currStable) {
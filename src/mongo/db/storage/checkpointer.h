@@ -59,7 +59,9 @@ public:
     }
 
     /**
-     * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds.
+     * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds,
+     * or sooner once the fraction of the cache that is dirty reaches
+     * 'checkpointDirtyCacheTriggerFraction'.
      */
     void run() override;
 
@@ -88,6 +90,12 @@ public:
     void shutdown(const Status& reason);
 
 private:
+    /**
+     * Returns whether 'checkpointDirtyCacheTriggerFraction' is set and the storage engine's cache
+     * is at least that dirty.
+     */
+    bool _isCacheDirtyEnoughToCheckpoint() const;
+
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
     // TODO SERVER-50861: Remove this pointer.
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/clustered_id.h"
+
+#include <cmath>
+
+#include "mongo/bson/bson_validate.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/util/debug_util.h"
+
+namespace mongo {
+namespace clustered_id {
+
+StatusWith<RecordId> keyForId(const BSONElement& id) {
+    long long value;
+    switch (id.type()) {
+        case NumberInt:
+            value = id.numberInt();
+            break;
+        case NumberLong:
+            value = id.numberLong();
+            break;
+        case NumberDouble: {
+            const double d = id.numberDouble();
+            if (!(d >= 1 && d < static_cast<double>(RecordId::kMinReservedRepr)) ||
+                d != std::trunc(d)) {
+                return {ErrorCodes::BadValue,
+                        "the _id of a document in a clustered collection must be integral"};
+            }
+            value = static_cast<long long>(d);
+            break;
+        }
+        default:
+            return {ErrorCodes::BadValue,
+                    "the _id of a document in a clustered collection must be an int, a long or "
+                    "an integral double"};
+    }
+
+    const RecordId out(value);
+    if (!out.isNormal())
+        return {ErrorCodes::BadValue,
+                str::stream() << "the _id of a document in a clustered collection must be "
+                                 "between 1 and "
+                              << RecordId::kMinReservedRepr - 1};
+    return out;
+}
+
+StatusWith<RecordId> extractKey(const char* data, int len) {
+    if (kDebugBuild)
+        invariant(validateBSON(data, len).isOK());
+
+    const BSONObj obj(data);
+    const BSONElement elem = obj["_id"];
+    if (elem.eoo())
+        return {ErrorCodes::BadValue, "no _id field"};
+
+    return keyForId(elem);
+}
+
+}  // namespace clustered_id
+}  // namespace mongo
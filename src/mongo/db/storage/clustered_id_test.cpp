@@ -0,0 +1,73 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/clustered_id.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(ClusteredIdTest, EqualIntegralIdsHaveTheSameKey) {
+    const auto ids = BSON_ARRAY(7 << 7LL << 7.0);
+    for (auto&& id : ids) {
+        ASSERT_EQ(RecordId(7), unittest::assertGet(clustered_id::keyForId(id)));
+    }
+}
+
+TEST(ClusteredIdTest, KeysPreserveTheOrderOfIds) {
+    const auto lower = unittest::assertGet(clustered_id::keyForId(BSON("" << 2).firstElement()));
+    const auto upper = unittest::assertGet(clustered_id::keyForId(BSON("" << 10LL).firstElement()));
+    ASSERT_LT(lower, upper);
+}
+
+TEST(ClusteredIdTest, RejectsIdsWhichAreNotNormalRecordIds) {
+    const auto ids = BSON_ARRAY(0 << -1 << 1.5 << std::nan("") << RecordId::kMinReservedRepr
+                                  << "1" << OID::gen() << BSON("a" << 1));
+    for (auto&& id : ids) {
+        ASSERT_EQ(ErrorCodes::BadValue, clustered_id::keyForId(id).getStatus()) << id;
+    }
+}
+
+TEST(ClusteredIdTest, ExtractsTheKeyOfADocument) {
+    const auto doc = BSON("a" << 1 << "_id" << 42);
+    ASSERT_EQ(RecordId(42),
+              unittest::assertGet(clustered_id::extractKey(doc.objdata(), doc.objsize())));
+
+    const auto noId = BSON("a" << 1);
+    ASSERT_EQ(ErrorCodes::BadValue,
+              clustered_id::extractKey(noId.objdata(), noId.objsize()).getStatus());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -483,28 +483,26 @@ StatusWith<RecordData> EphemeralForTestRecordStore::updateWithDamages(
     stdx::lock_guard<stdx::recursive_mutex> lock(_data->recordsMutex);
 
     EphemeralForTestRecord* oldRecord = recordFor(lock, loc);
-    const int len = oldRecord->size;
 
-    EphemeralForTestRecord newRecord(len);
-    memcpy(newRecord.data.get(), oldRecord->data.get(), len);
+    // Damage events may grow or shrink the record, so apply them to a scratch copy first.
+    std::string updated(oldRecord->data.get(), oldRecord->size);
+    for (auto&& damage : damages) {
+        updated.replace(damage.targetOffset,
+                        damage.targetSize,
+                        damageSource + damage.sourceOffset,
+                        damage.sourceSize);
+    }
+
+    EphemeralForTestRecord newRecord(updated.size());
+    memcpy(newRecord.data.get(), updated.data(), updated.size());
 
     opCtx->recoveryUnit()->registerChange(
         std::make_unique<RemoveChange>(opCtx, _data, loc, *oldRecord));
+    _data->dataSize += newRecord.size - oldRecord->size;
     *oldRecord = newRecord;
 
     cappedDeleteAsNeeded(lock, opCtx);
 
-    char* root = newRecord.data.get();
-    mutablebson::DamageVector::const_iterator where = damages.begin();
-    const mutablebson::DamageVector::const_iterator end = damages.end();
-    for (; where != end; ++where) {
-        const char* sourcePtr = damageSource + where->sourceOffset;
-        char* targetPtr = root + where->targetOffset;
-        std::memcpy(targetPtr, sourcePtr, where->size);
-    }
-
-    *oldRecord = newRecord;
-
     return newRecord.toRecordData();
 }
 
@@ -196,6 +196,11 @@ public:
      */
     virtual void setRecordPreImages(OperationContext* opCtx, RecordId catalogId, bool val) = 0;
 
+    /**
+     * Updates whether the reads of this collection have a low cache priority.
+     */
+    virtual void setLowCachePriority(OperationContext* opCtx, RecordId catalogId, bool val) = 0;
+
     /**
      * Updates the validator for this collection.
      *
@@ -66,6 +66,9 @@ const char kNonRepairableFeaturesFieldName[] = "nonRepairable";
 const char kRepairableFeaturesFieldName[] = "repairable";
 const char kInternalIdentPrefix[] = "internal-";
 const char kResumableIndexBuildIdentStem[] = "resumable-index-build-";
+// The directory of the dbpath, possibly a mount of slower storage, for collections created with
+// {coldStorage: true} and their indexes.
+const char kColdStorageDirectory[] = "cold";
 
 void appendPositionsOfBitsSet(uint64_t value, StringBuilder* sb) {
     invariant(sb);
@@ -451,9 +454,14 @@ std::string DurableCatalogImpl::getFilesystemPathForDb(const std::string& dbName
     }
 }
 
-std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss, const char* kind) {
+std::string DurableCatalogImpl::_newUniqueIdent(NamespaceString nss,
+                                                const char* kind,
+                                                bool coldStorage) {
     // If this changes to not put _rand at the end, _hasEntryCollidingWithRand will need fixing.
     StringBuilder buf;
+    if (coldStorage) {
+        buf << kColdStorageDirectory << '/';
+    }
     if (_directoryPerDb) {
         buf << escapeDbName(nss.db()) << '/';
     }
@@ -534,7 +542,7 @@ StatusWith<DurableCatalog::Entry> DurableCatalogImpl::_addEntry(OperationContext
                                                                 KVPrefix prefix) {
     invariant(opCtx->lockState()->isDbLockedForMode(nss.db(), MODE_IX));
 
-    const string ident = _newUniqueIdent(nss, "collection");
+    const string ident = _newUniqueIdent(nss, "collection", options.coldStorage);
 
     BSONObj obj;
     {
@@ -629,7 +637,7 @@ void DurableCatalogImpl::putMetaData(OperationContext* opCtx,
                 continue;
             }
             // missing, create new
-            newIdentMap.append(name, _newUniqueIdent(nss, "index"));
+            newIdentMap.append(name, _newUniqueIdent(nss, "index", md.options.coldStorage));
         }
         b.append("idxIdent", newIdentMap.obj());
 
@@ -955,6 +963,14 @@ void DurableCatalogImpl::setRecordPreImages(OperationContext* opCtx, RecordId ca
     putMetaData(opCtx, catalogId, md);
 }
 
+void DurableCatalogImpl::setLowCachePriority(OperationContext* opCtx,
+                                             RecordId catalogId,
+                                             bool val) {
+    BSONCollectionCatalogEntry::MetaData md = getMetaData(opCtx, catalogId);
+    md.options.lowCachePriority = val;
+    putMetaData(opCtx, catalogId, md);
+}
+
 void DurableCatalogImpl::updateValidator(OperationContext* opCtx,
                                          RecordId catalogId,
                                          const BSONObj& validator,
@@ -145,6 +145,8 @@ public:
 
     void setRecordPreImages(OperationContext* opCtx, RecordId catalogId, bool val) override;
 
+    void setLowCachePriority(OperationContext* opCtx, RecordId catalogId, bool val) override;
+
     void updateValidator(OperationContext* opCtx,
                          RecordId catalogId,
                          const BSONObj& validator,
@@ -229,8 +231,9 @@ private:
      * Generates a new unique identifier for a new "thing".
      * @param nss - the containing namespace
      * @param kind - what this "thing" is, likely collection or index
+     * @param coldStorage - whether the "thing" belongs in the cold storage directory
      */
-    std::string _newUniqueIdent(NamespaceString nss, const char* kind);
+    std::string _newUniqueIdent(NamespaceString nss, const char* kind, bool coldStorage);
 
     std::string _newInternalIdent(StringData identStem);
 
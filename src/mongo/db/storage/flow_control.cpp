@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <fmt/format.h>
 #include <limits>
+#include <utility>
 
 #include "mongo/db/concurrency/flow_control_ticketholder.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
@@ -221,6 +222,7 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLagged", _isLagged.load());
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
+    bob.append("forecastLagMillis", _lastForecastLagMillis.load());
 
     return bob.obj();
 }
@@ -326,6 +328,63 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, kMaxTickets);
 }
 
+int FlowControl::_calculateNewTicketsForForecastLag(
+    const std::vector<repl::MemberData>& prevMemberData,
+    const std::vector<repl::MemberData>& currMemberData,
+    Timestamp prevPrimaryAppliedTs,
+    Timestamp currPrimaryAppliedTs,
+    Timestamp lastCommittedTs,
+    double locksPerOp,
+    std::uint64_t thresholdLagMillis) {
+    _lastForecastLagMillis.store(0);
+    const int forecastSeconds = gFlowControlLagForecastSeconds.load();
+    if (forecastSeconds == 0 || currMemberData.size() == 0 ||
+        currMemberData.size() != prevMemberData.size()) {
+        return -1;
+    }
+
+    const auto currSustainerAppliedTs = getMedianAppliedTimestamp(currMemberData);
+    const auto prevSustainerAppliedTs = getMedianAppliedTimestamp(prevMemberData);
+    if (currSustainerAppliedTs <= prevSustainerAppliedTs ||
+        currPrimaryAppliedTs <= prevPrimaryAppliedTs) {
+        return -1;
+    }
+
+    // Both rates are per flow control period, which is one second.
+    const std::int64_t sustainerAppliedCount =
+        _approximateOpsBetween(prevSustainerAppliedTs, currSustainerAppliedTs);
+    const std::int64_t primaryAppliedCount =
+        _approximateOpsBetween(prevPrimaryAppliedTs, currPrimaryAppliedTs);
+    if (sustainerAppliedCount <= 0 || primaryAppliedCount <= sustainerAppliedCount) {
+        // Either there isn't enough information, or the secondaries are keeping up.
+        return -1;
+    }
+
+    // The ops between the commit point and the primary's last applied optime are -1 when they fall
+    // within the same sample; there are very few of them in that case.
+    const std::int64_t opsLagged =
+        std::max(_approximateOpsBetween(lastCommittedTs, currPrimaryAppliedTs), std::int64_t(0));
+    const double forecastOpsLagged = opsLagged +
+        forecastSeconds * static_cast<double>(primaryAppliedCount - sustainerAppliedCount);
+    const double forecastLagMillis = 1000.0 * forecastOpsLagged / sustainerAppliedCount;
+    _lastForecastLagMillis.store(static_cast<std::int64_t>(forecastLagMillis));
+    LOGV2_DEBUG(5190580,
+                DEBUG_LOG_LEVEL,
+                "Forecast commit point lag",
+                "primaryAppliedCount"_attr = primaryAppliedCount,
+                "sustainerAppliedCount"_attr = sustainerAppliedCount,
+                "opsLagged"_attr = opsLagged,
+                "forecastSeconds"_attr = forecastSeconds,
+                "forecastLagMillis"_attr = forecastLagMillis,
+                "thresholdLagMillis"_attr = thresholdLagMillis);
+    if (forecastLagMillis < thresholdLagMillis) {
+        return -1;
+    }
+
+    return multiplyWithOverflowCheck(
+        locksPerOp, sustainerAppliedCount * gFlowControlFudgeFactor.load(), kMaxTickets);
+}
+
 int FlowControl::getNumTickets(Date_t now) {
     // Flow control can be disabled until a certain deadline is passed.
     const Date_t disabledUntil = _disableUntil.load();
@@ -347,6 +406,8 @@ int FlowControl::getNumTickets(Date_t now) {
     _updateTopologyData();
     const repl::OpTimeAndWallTime myLastApplied = _replCoord->getMyLastAppliedOpTimeAndWallTime();
     const repl::OpTimeAndWallTime lastCommitted = _replCoord->getLastCommittedOpTimeAndWallTime();
+    const Timestamp prevPrimaryAppliedTs =
+        std::exchange(_lastPrimaryAppliedTs, myLastApplied.opTime.getTimestamp());
     const double locksPerOp = _getLocksPerOp();
     const std::int64_t locksUsedLastPeriod = _getLocksUsedLastPeriod();
 
@@ -382,6 +443,20 @@ int FlowControl::getNumTickets(Date_t now) {
                                             gFlowControlTicketAdderConstant.load(),
                                         gFlowControlTicketMultiplierConstant.load(),
                                         kMaxTickets);
+
+        // If the secondaries apply writes slower than the primary accepts them, stop ramping up
+        // before the lag reaches the threshold.
+        const int forecastTickets =
+            _calculateNewTicketsForForecastLag(_prevMemberData,
+                                               _currMemberData,
+                                               prevPrimaryAppliedTs,
+                                               myLastApplied.opTime.getTimestamp(),
+                                               lastCommitted.opTime.getTimestamp(),
+                                               locksPerOp,
+                                               thresholdLagMillis);
+        if (forecastTickets != -1) {
+            ret = std::min(ret, forecastTickets);
+        }
         _lastTimeSustainerAdvanced = Date_t::now();
         if (_isLagged.load()) {
             _isLagged.store(false);
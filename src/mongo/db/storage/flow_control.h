@@ -132,6 +132,21 @@ public:
                                    double locksPerOp,
                                    std::uint64_t lagMillis,
                                    std::uint64_t thresholdLagMillis);
+
+    /**
+     * Forecasts the commit point lag `flowControlLagForecastSeconds` ahead, assuming the primary
+     * keeps accepting writes at the rate it applied them between `prevPrimaryAppliedTs` and
+     * `currPrimaryAppliedTs` and the sustainer keeps applying them at the rate observed between the
+     * two member data snapshots. Returns the number of tickets that paces writes to the sustainer
+     * rate if the forecast lag reaches `thresholdLagMillis`, and -1 otherwise.
+     */
+    int _calculateNewTicketsForForecastLag(const std::vector<repl::MemberData>& prevMemberData,
+                                           const std::vector<repl::MemberData>& currMemberData,
+                                           Timestamp prevPrimaryAppliedTs,
+                                           Timestamp currPrimaryAppliedTs,
+                                           Timestamp lastCommittedTs,
+                                           double locksPerOp,
+                                           std::uint64_t thresholdLagMillis);
     void _trimSamples(const Timestamp trimSamplesTo);
 
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
@@ -153,6 +168,7 @@ private:
     AtomicWord<int> _isLaggedCount{0};
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
+    AtomicWord<std::int64_t> _lastForecastLagMillis{0};
     AtomicWord<Date_t> _disableUntil;
 
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
@@ -166,6 +182,7 @@ private:
 
     std::vector<repl::MemberData> _currMemberData;
     std::vector<repl::MemberData> _prevMemberData;
+    Timestamp _lastPrimaryAppliedTs;
 
     Date_t _lastTimeSustainerAdvanced;
 
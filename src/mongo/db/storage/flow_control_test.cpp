@@ -40,6 +40,7 @@
 #include "mongo/db/storage/flow_control_parameters_gen.h"
 #include "mongo/logv2/log_debug.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -266,6 +267,60 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, CalculatingTicketsForForecastLag) {
+    gFlowControlFudgeFactor.store(0.95);
+    const auto oldForecastSeconds = gFlowControlLagForecastSeconds.load();
+    ON_BLOCK_EXIT([&] { gFlowControlLagForecastSeconds.store(oldForecastSeconds); });
+
+    auto constructMemberData = [](Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+
+    // In the previous observation, all nodes are applied up through 1000.
+    std::vector<repl::MemberData> prevMemberData;
+    prevMemberData.emplace_back(constructMemberData(Timestamp(1000)));
+    prevMemberData.emplace_back(constructMemberData(Timestamp(1000)));
+    prevMemberData.emplace_back(constructMemberData(Timestamp(1000)));
+
+    // Over the last period, the primary accepted 2,000 operations while the secondaries applied
+    // 500 of them, and the commit point is at 1500.
+    std::vector<repl::MemberData> currMemberData;
+    currMemberData.emplace_back(constructMemberData(Timestamp(1500)));
+    currMemberData.emplace_back(constructMemberData(Timestamp(1500)));
+    currMemberData.emplace_back(constructMemberData(Timestamp(3000)));
+
+    // Construct samples where Timestamp X maps to operation number X.
+    for (int ts = 1; ts <= 3000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    auto calculateTickets = [&](std::uint64_t thresholdLag) {
+        return flowControl->_calculateNewTicketsForForecastLag(prevMemberData,
+                                                               currMemberData,
+                                                               Timestamp(1000),
+                                                               Timestamp(3000),
+                                                               Timestamp(1500),
+                                                               2.0,
+                                                               thresholdLag);
+    };
+
+    // The forecast is disabled by default.
+    gFlowControlLagForecastSeconds.store(0);
+    ASSERT_EQ(-1, calculateTickets(5000));
+
+    // Two seconds from now, 1,500 + 2 * 1,500 operations are lagged, which the secondaries apply in
+    // 9 seconds at 500 operations per second.
+    gFlowControlLagForecastSeconds.store(2);
+    ASSERT_EQ(-1, calculateTickets(10000));
+
+    // Writes are paced to 95% of the sustainer rate, at 2.0 locksPerOp.
+    ASSERT_EQ(950, calculateTickets(9000));
+    BSONElement noopVar;
+    ASSERT_EQ(9000, flowControl->generateSection(opCtx.get(), noopVar)["forecastLagMillis"].Long());
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
@@ -1835,6 +1835,31 @@ void toBsonValue(uint8_t ctype,
 
 void filterKeyFromKeyString(uint8_t ctype, BufReader* reader, bool inverted, Version version);
 
+/**
+ * A stream for 'toBsonValue()' which discards the values streamed to it, so that the type bits of a
+ * component can be read without converting the component.
+ */
+class DiscardingStream {
+public:
+    template <typename T>
+    DiscardingStream& operator<<(const T&) {
+        return *this;
+    }
+
+    BufBuilder& subobjStart() {
+        _scratch.reset();
+        return _scratch;
+    }
+
+    BufBuilder& subarrayStart() {
+        _scratch.reset();
+        return _scratch;
+    }
+
+private:
+    BufBuilder _scratch;
+};
+
 void readBson(BufReader* reader, bool inverted, Version version) {
     while (readType<uint8_t>(reader, inverted) != 0) {
         if (inverted) {
@@ -2520,6 +2545,26 @@ bool readSBEValue(BufReader* reader,
     return true;
 }
 
+bool skipSBEValue(BufReader* reader, TypeBits::Reader* typeBits, bool inverted, Version version) {
+    uint8_t ctype;
+    if (!reader->remaining() || (ctype = readType<uint8_t>(reader, inverted)) == kEnd) {
+        return false;
+    }
+
+    invariant(ctype > kLess && ctype < kGreater);
+
+    if (typeBits->isAllZeros()) {
+        // There are no type bits to keep in step with, so the component's bytes can just be
+        // skipped.
+        filterKeyFromKeyString(ctype, reader, inverted, version);
+    } else {
+        DiscardingStream stream;
+        const uint32_t depth = 1;
+        toBsonValue(ctype, reader, typeBits, inverted, version, &stream, depth);
+    }
+    return true;
+}
+
 void Value::serializeWithoutRecordId(BufBuilder& buf) const {
     dassert(decodeRecordIdAtEnd(_buffer.get(), _ksSize).isValid());
 
@@ -246,6 +246,10 @@ public:
         }
         uint8_t readZero();
 
+        bool isAllZeros() const {
+            return _typeBits.isAllZeros();
+        }
+
         // Given a decimal zero type between kDecimalZero0xxx and kDecimal5xxx, read the
         // remaining 12 bits and return which of the 24576 decimal zeros to produce.
         uint32_t readDecimalZero(uint8_t zeroType);
@@ -974,6 +978,12 @@ bool readSBEValue(BufReader* reader,
                   Version version,
                   sbe::value::ValueBuilder* valueBuilder);
 
+/**
+ * Like 'readSBEValue()', but skips over the KeyString component without converting it. Only the
+ * type bits of the component are decoded, and only when the KeyString has any that are not zero.
+ */
+bool skipSBEValue(BufReader* reader, TypeBits::Reader* typeBits, bool inverted, Version version);
+
 template <class BufferT>
 template <class T>
 int BuilderBase<BufferT>::compare(const T& other) const {
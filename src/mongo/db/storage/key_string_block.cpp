@@ -0,0 +1,161 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/key_string_block.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mongo {
+namespace {
+
+// The size of the buffers the KeyStrings returned by next() share.
+constexpr size_t kFragmentBlockBytes = 16 * 1024;
+
+// Returns the length of the common prefix of the 'size1' bytes at 'buf1' and the 'size2' bytes at
+// 'buf2', starting with the 'offset' bytes known to be equal.
+size_t commonPrefix(
+    const char* buf1, size_t size1, const char* buf2, size_t size2, size_t offset = 0) {
+    const size_t size = std::min(size1, size2);
+    return std::mismatch(buf1 + offset, buf1 + size, buf2 + offset).first - buf1;
+}
+
+}  // namespace
+
+KeyStringBlock::KeyStringBlock(KeyString::Version version)
+    : _version(version), _fragments(kFragmentBlockBytes) {}
+
+void KeyStringBlock::append(const char* keyString,
+                            size_t size,
+                            const KeyString::TypeBits& typeBits,
+                            const RecordId& loc) {
+    const auto sharedPrefix =
+        commonPrefix(_lastAppended.data(), _lastAppended.size(), keyString, size);
+    const auto suffixSize = size - sharedPrefix;
+
+    Entry entry;
+    entry.offset = _data.len();
+    entry.sharedPrefix = sharedPrefix;
+    entry.suffixSize = suffixSize;
+    entry.typeBitsSize = typeBits.getSize();
+    entry.loc = loc;
+    _entries.push_back(entry);
+
+    _data.appendBuf(keyString + sharedPrefix, suffixSize);
+    _data.appendBuf(typeBits.getBuffer(), typeBits.getSize());
+    _lastAppended.resize(sharedPrefix);
+    _lastAppended.append(keyString + sharedPrefix, suffixSize);
+}
+
+void KeyStringBlock::append(const KeyStringEntry& entry) {
+    append(entry.keyString.getBuffer(),
+           entry.keyString.getSize(),
+           entry.keyString.getTypeBits(),
+           entry.loc);
+}
+
+void KeyStringBlock::clear() {
+    _entries.clear();
+    _data.reset();
+    _lastAppended.clear();
+    _lastReturned.clear();
+    _nextEntry = 0;
+}
+
+size_t KeyStringBlock::numWithinBound(const KeyString::Value& bound, bool forward) const {
+    const char* boundBuf = bound.getBuffer();
+    const size_t boundSize = bound.getSize();
+
+    // The KeyString of the previous entry agrees with 'bound' on its first 'matched' bytes, and
+    // compares to it as 'cmp'. When an entry shares more than 'matched' bytes with the previous
+    // one it also differs from 'bound' at byte 'matched' as the previous one does, so it compares
+    // the same way without looking at its bytes. Otherwise only the bytes from its shared prefix
+    // on are compared.
+    std::string key;
+    size_t matched = 0;
+    int cmp = 0;
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        const auto& entry = _entries[i];
+        key.resize(entry.sharedPrefix);
+        key.append(_data.buf() + entry.offset, entry.suffixSize);
+
+        if (i == 0 || entry.sharedPrefix <= matched) {
+            const size_t from = i == 0 ? 0 : entry.sharedPrefix;
+            matched = commonPrefix(key.data(), key.size(), boundBuf, boundSize, from);
+            cmp = KeyString::compare(key.data() + matched,
+                                     boundBuf + matched,
+                                     key.size() - matched,
+                                     boundSize - matched);
+        }
+
+        if (forward ? cmp > 0 : cmp < 0) {
+            return i;
+        }
+    }
+    return _entries.size();
+}
+
+void KeyStringBlock::truncate(size_t n) {
+    if (n >= _entries.size()) {
+        return;
+    }
+    _entries.resize(n);
+    _nextEntry = std::min(_nextEntry, n);
+
+    // Rebuild the last appended KeyString, which starts with the shared prefixes of the entries.
+    _lastAppended.clear();
+    for (auto&& entry : _entries) {
+        _lastAppended.resize(entry.sharedPrefix);
+        _lastAppended.append(_data.buf() + entry.offset, entry.suffixSize);
+    }
+}
+
+boost::optional<KeyStringEntry> KeyStringBlock::next() {
+    if (exhausted()) {
+        return boost::none;
+    }
+
+    const auto& entry = _entries[_nextEntry++];
+    _lastReturned.resize(entry.sharedPrefix);
+    _lastReturned.append(_data.buf() + entry.offset, entry.suffixSize);
+
+    const size_t size = _lastReturned.size() + entry.typeBitsSize;
+    _fragments.start(size);
+    memcpy(_fragments.get(), _lastReturned.data(), _lastReturned.size());
+    memcpy(_fragments.get() + _lastReturned.size(),
+           _data.buf() + entry.offset + entry.suffixSize,
+           entry.typeBitsSize);
+    KeyString::Value keyString(_version, _lastReturned.size(), _fragments.finish(size));
+    return KeyStringEntry(std::move(keyString), entry.loc);
+}
+
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/util/shared_buffer_fragment.h"
+
+namespace mongo {
+
+/**
+ * A block of consecutive index entries, as filled in by
+ * SortedDataInterface::Cursor::nextKeyStringBlock(). Each KeyString is stored as the length of
+ * the prefix it shares with the KeyString before it and the bytes which follow that prefix, so
+ * the entries of a range scan, which tend to share long prefixes, take little memory and can be
+ * checked against a bound without comparing each of them in full.
+ *
+ * The entries are returned in the order they were appended, by next(), in KeyStrings which share
+ * the buffers of the block rather than each allocating their own.
+ */
+class KeyStringBlock {
+public:
+    explicit KeyStringBlock(KeyString::Version version);
+
+    /**
+     * Appends the entry for the 'size' bytes of the KeyString at 'keyString', which ends with the
+     * RecordId 'loc', and its 'typeBits'.
+     */
+    void append(const char* keyString,
+                size_t size,
+                const KeyString::TypeBits& typeBits,
+                const RecordId& loc);
+    void append(const KeyStringEntry& entry);
+
+    /**
+     * Removes all of the entries, keeping the memory allocated for them.
+     */
+    void clear();
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    /**
+     * Returns the number of entries, from the first one, which are not past 'bound' in the
+     * direction of a scan that appended them in ascending order if 'forward', and in descending
+     * order otherwise. All of the entries after those are past 'bound'.
+     */
+    size_t numWithinBound(const KeyString::Value& bound, bool forward) const;
+
+    /**
+     * Removes the entries from position 'n' on.
+     */
+    void truncate(size_t n);
+
+    /**
+     * Returns true if next() has returned all of the entries.
+     */
+    bool exhausted() const {
+        return _nextEntry == _entries.size();
+    }
+
+    /**
+     * Returns the first entry which next() hasn't returned yet, or boost::none if there are none.
+     */
+    boost::optional<KeyStringEntry> next();
+
+private:
+    struct Entry {
+        // Offset in '_data' of the bytes of the KeyString after the shared prefix, followed by
+        // the bytes of its TypeBits.
+        size_t offset;
+        uint32_t sharedPrefix;
+        uint32_t suffixSize;
+        uint32_t typeBitsSize;
+        RecordId loc;
+    };
+
+    const KeyString::Version _version;
+
+    std::vector<Entry> _entries;
+    BufBuilder _data;
+
+    // The last KeyString appended, and the last one returned by next().
+    std::string _lastAppended;
+    std::string _lastReturned;
+    size_t _nextEntry = 0;
+
+    SharedBufferFragmentBuilder _fragments;
+};
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/key_string_block.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const auto kVersion = KeyString::Version::kLatestVersion;
+const auto kOrdering = Ordering::make(BSONObj());
+
+KeyStringEntry makeEntry(const BSONObj& key, int64_t loc) {
+    KeyString::Builder builder(kVersion, key, kOrdering, RecordId(loc));
+    return KeyStringEntry(builder.getValueCopy(), RecordId(loc));
+}
+
+// Entries with long shared prefixes, some type bits, and duplicate keys, in ascending order.
+std::vector<KeyStringEntry> makeEntries() {
+    std::vector<KeyStringEntry> entries;
+    int64_t loc = 1;
+    for (auto&& prefix : {"a", "abc", "abcd", "b"}) {
+        for (int i = 0; i < 3; ++i) {
+            entries.push_back(makeEntry(BSON("" << prefix << "" << i), loc++));
+            entries.push_back(makeEntry(BSON("" << prefix << "" << i + 0.5), loc++));
+        }
+        entries.push_back(makeEntry(BSON("" << prefix << "" << 4LL), loc++));
+        entries.push_back(makeEntry(BSON("" << prefix << "" << 4LL), loc++));
+    }
+    return entries;
+}
+
+TEST(KeyStringBlock, ReturnsTheEntriesInOrder) {
+    auto entries = makeEntries();
+    KeyStringBlock block(kVersion);
+    for (auto&& entry : entries) {
+        block.append(entry);
+    }
+    ASSERT_EQ(entries.size(), block.size());
+
+    std::vector<KeyStringEntry> returned;
+    while (auto entry = block.next()) {
+        returned.push_back(*entry);
+    }
+    ASSERT_TRUE(block.exhausted());
+    ASSERT_EQ(entries.size(), returned.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ASSERT_EQ(0, entries[i].keyString.compareWithTypeBits(returned[i].keyString));
+        ASSERT_EQ(entries[i].loc, returned[i].loc);
+        ASSERT_BSONOBJ_EQ(KeyString::toBson(entries[i].keyString, kOrdering),
+                          KeyString::toBson(returned[i].keyString, kOrdering));
+    }
+
+    // The entries returned stay valid once the block is reused.
+    block.clear();
+    ASSERT_TRUE(block.empty());
+    block.append(entries.back());
+    ASSERT_EQ(0, block.next()->keyString.compare(entries.back().keyString));
+    ASSERT_EQ(0, returned.front().keyString.compareWithTypeBits(entries.front().keyString));
+}
+
+TEST(KeyStringBlock, CountsTheEntriesWithinABound) {
+    auto entries = makeEntries();
+    std::vector<KeyString::Value> bounds;
+    for (auto&& entry : entries) {
+        bounds.push_back(entry.keyString);
+    }
+    for (auto&& key : {BSON("" << ""), BSON("" << "ab"), BSON("" << "abc" << "" << 1.5),
+                       BSON("" << "abcd"), BSON("" << "z")}) {
+        for (bool inclusive : {false, true}) {
+            for (bool forward : {false, true}) {
+                bounds.push_back(IndexEntryComparison::makeKeyStringFromBSONKeyForSeek(
+                    key, kVersion, kOrdering, forward, inclusive));
+            }
+        }
+    }
+
+    for (bool forward : {true, false}) {
+        auto ordered = entries;
+        if (!forward) {
+            std::reverse(ordered.begin(), ordered.end());
+        }
+        KeyStringBlock block(kVersion);
+        for (auto&& entry : ordered) {
+            block.append(entry);
+        }
+
+        for (auto&& bound : bounds) {
+            auto pastBound = std::find_if(ordered.begin(), ordered.end(), [&](auto&& entry) {
+                auto cmp = entry.keyString.compare(bound);
+                return forward ? cmp > 0 : cmp < 0;
+            });
+            ASSERT_EQ(static_cast<size_t>(pastBound - ordered.begin()),
+                      block.numWithinBound(bound, forward))
+                << bound.toString() << " forward: " << forward;
+        }
+    }
+}
+
+TEST(KeyStringBlock, TruncateKeepsTheFirstEntries) {
+    auto entries = makeEntries();
+    KeyStringBlock block(kVersion);
+    for (auto&& entry : entries) {
+        block.append(entry);
+    }
+    block.truncate(5);
+    ASSERT_EQ(5U, block.size());
+
+    // Entries appended after truncating share their prefixes with the last entry kept.
+    block.append(entries.back());
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(0, block.next()->keyString.compare(entries[i].keyString));
+    }
+    ASSERT_EQ(0, block.next()->keyString.compareWithTypeBits(entries.back().keyString));
+    ASSERT_FALSE(block.next());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,6 +33,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "mongo/base/status.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/timestamp.h"
@@ -265,6 +267,14 @@ public:
 
     virtual void checkpoint() {}
 
+    /**
+     * Returns the fraction of the storage engine's cache holding data that a checkpoint has yet to
+     * write, or boost::none if the engine does not track it.
+     */
+    virtual boost::optional<double> getCacheDirtyFraction() const {
+        return boost::none;
+    }
+
     virtual bool isDurable() const = 0;
 
     /**
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/optional.hpp>
+#include <numeric>
+#include <vector>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -172,6 +175,29 @@ public:
      */
     virtual boost::optional<Record> seekExact(const RecordId& id) = 0;
 
+    /**
+     * Returns the Records with the provided ids, in the same order, or boost::none for the ids
+     * of Records which can't be found. The Records are owned, so they stay valid after other calls
+     * to this cursor, but not across a save.
+     *
+     * The Records are looked up in the order of their ids, so that neighboring Records are read
+     * from the same part of the storage. The resulting position of the cursor is unspecified.
+     */
+    virtual std::vector<boost::optional<Record>> multiGet(const std::vector<RecordId>& ids) {
+        std::vector<size_t> order(ids.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+        std::vector<boost::optional<Record>> records(ids.size());
+        for (auto i : order) {
+            records[i] = seekExact(ids[i]);
+            if (records[i]) {
+                records[i]->data.makeOwned();
+            }
+        }
+        return records;
+    }
+
     /**
      * Prepares for state changes in underlying data without necessarily saving the current
      * state.
@@ -240,6 +266,15 @@ public:
 
     virtual bool isCapped() const = 0;
 
+    /**
+     * Returns true if this RecordStore keys each record by the _id of its document, as converted
+     * by clustered_id::keyForId(), rather than by a RecordId of its own choosing. Inserting a
+     * document whose _id is already present fails with DuplicateKey.
+     */
+    virtual bool isClustered() const {
+        return false;
+    }
+
     virtual void setCappedCallback(CappedCallback*) {
         MONGO_UNREACHABLE;
     }
@@ -348,7 +383,9 @@ public:
     /**
      * Updates the record positioned at 'loc' in-place using the deltas described by 'damages'. The
      * 'damages' vector describes contiguous ranges of 'damageSource' from which to copy and apply
-     * byte-level changes to the data. Behavior is undefined for calling this on a non-existant loc.
+     * byte-level changes to the data. A damage event may replace a range of a different size, in
+     * which case the record grows or shrinks. Behavior is undefined for calling this on a
+     * non-existant loc.
      *
      * @return the updated version of the record. If unowned data is returned, then it is valid
      * until the next modification of this Record or the lock on the collection has been released.
@@ -385,6 +422,16 @@ public:
         return {};
     }
 
+    /**
+     * Like getRandomCursor(), but tells the storage engine that about 'numSamples' records will be
+     * read from the cursor, so that it can spread them over the whole record store instead of
+     * positioning the cursor from scratch for each of them.
+     */
+    virtual std::unique_ptr<RecordCursor> getRandomCursorForSampleSize(OperationContext* opCtx,
+                                                                       long long numSamples) const {
+        return getRandomCursor(opCtx);
+    }
+
     // higher level
 
 
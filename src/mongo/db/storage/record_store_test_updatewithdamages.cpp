@@ -83,13 +83,16 @@ TEST(RecordStoreTestHarness, UpdateWithDamages) {
             mutablebson::DamageVector dv(3);
             dv[0].sourceOffset = 5;
             dv[0].targetOffset = 0;
-            dv[0].size = 2;
+            dv[0].sourceSize = 2;
+            dv[0].targetSize = 2;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 2;
-            dv[1].size = 3;
+            dv[1].sourceSize = 3;
+            dv[1].targetSize = 3;
             dv[2].sourceOffset = 0;
             dv[2].targetOffset = 5;
-            dv[2].size = 3;
+            dv[2].sourceSize = 3;
+            dv[2].targetSize = 3;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -149,10 +152,12 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEvents) {
             mutablebson::DamageVector dv(2);
             dv[0].sourceOffset = 3;
             dv[0].targetOffset = 0;
-            dv[0].size = 5;
+            dv[0].sourceSize = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 0;
             dv[1].targetOffset = 3;
-            dv[1].size = 5;
+            dv[1].sourceSize = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -213,10 +218,12 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
             mutablebson::DamageVector dv(2);
             dv[0].sourceOffset = 0;
             dv[0].targetOffset = 3;
-            dv[0].size = 5;
+            dv[0].sourceSize = 5;
+            dv[0].targetSize = 5;
             dv[1].sourceOffset = 3;
             dv[1].targetOffset = 0;
-            dv[1].size = 5;
+            dv[1].sourceSize = 5;
+            dv[1].targetSize = 5;
 
             WriteUnitOfWork uow(opCtx.get());
             auto newRecStatus = rs->updateWithDamages(opCtx.get(), loc, rec, data.c_str(), dv);
@@ -235,6 +242,60 @@ TEST(RecordStoreTestHarness, UpdateWithOverlappingDamageEventsReversed) {
     }
 }
 
+// Insert a record and try to perform an update with damages that grow and shrink the record. Later
+// damage events address the record as modified by the earlier ones.
+TEST(RecordStoreTestHarness, UpdateWithDamagesChangingSize) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    if (!rs->updateWithDamagesSupported())
+        return;
+
+    string data = "00010111";
+    RecordId loc;
+    const RecordData rec(data.c_str(), data.size() + 1);
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), rec.data(), rec.size(), Timestamp());
+            ASSERT_OK(res.getStatus());
+            loc = res.getValue();
+            uow.commit();
+        }
+    }
+
+    string damageSource = "abcd";
+    string modifiedData = "0abcd111";
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            // Replace "001" with "abcd", then drop the "0" which follows it.
+            mutablebson::DamageVector dv;
+            dv.emplace_back(0, 4, 1, 3);
+            dv.emplace_back(0, 0, 5, 1);
+
+            WriteUnitOfWork uow(opCtx.get());
+            auto newRecStatus =
+                rs->updateWithDamages(opCtx.get(), loc, rec, damageSource.c_str(), dv);
+            ASSERT_OK(newRecStatus.getStatus());
+            ASSERT_EQUALS(modifiedData, newRecStatus.getValue().data());
+            ASSERT_EQUALS(static_cast<int>(modifiedData.size() + 1),
+                          newRecStatus.getValue().size());
+            uow.commit();
+        }
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            RecordData record = rs->dataFor(opCtx.get(), loc);
+            ASSERT_EQUALS(modifiedData, record.data());
+        }
+    }
+}
+
 // Insert a record and try to call updateWithDamages() with an empty DamageVector.
 TEST(RecordStoreTestHarness, UpdateWithNoDamages) {
     const auto harnessHelper(newRecordStoreHarnessHelper());
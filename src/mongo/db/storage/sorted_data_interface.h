@@ -37,6 +37,7 @@
 #include "mongo/db/storage/ident.h"
 #include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/key_string_block.h"
 
 #pragma once
 
@@ -255,6 +256,21 @@ public:
         virtual boost::optional<IndexKeyEntry> next(RequestedInfo parts = kKeyAndLoc) = 0;
         virtual boost::optional<KeyStringEntry> nextKeyString() = 0;
 
+        /**
+         * Moves forward over up to 'maxKeys' entries, appending each of them to 'block', as if by
+         * calling nextKeyString() until it returns boost::none or 'block' holds 'maxKeys'
+         * entries. The cursor is left positioned on the last entry appended.
+         */
+        virtual void nextKeyStringBlock(KeyStringBlock* block, size_t maxKeys) {
+            while (block->size() < maxKeys) {
+                auto entry = nextKeyString();
+                if (!entry) {
+                    return;
+                }
+                block->append(*entry);
+            }
+        }
+
         //
         // Seeking
         //
@@ -44,12 +44,14 @@
 #include "mongo/db/storage/durable_catalog_feature_tracker.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -206,7 +208,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         }
     }
 
-    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    std::vector<DurableCatalog::Entry> entriesToInit;
+    entriesToInit.reserve(catalogEntries.size());
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -245,22 +248,109 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
-        auto maxPrefixForCollection = _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
-        maxSeenPrefix = std::max(maxSeenPrefix, maxPrefixForCollection);
-
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
                   "Orphaned collection found: {namespace}",
                   "Orphaned collection found",
                   "namespace"_attr = entry.nss);
         }
+
+        entriesToInit.push_back(std::move(entry));
     }
 
-    KVPrefix::setLargestPrefix(maxSeenPrefix);
+    KVPrefix::setLargestPrefix(_initCollections(opCtx, entriesToInit));
     opCtx->recoveryUnit()->abandonSnapshot();
 }
 
+KVPrefix StorageEngineImpl::_initCollections(OperationContext* opCtx,
+                                             const std::vector<DurableCatalog::Entry>& entries) {
+    auto initCollection = [this](OperationContext* opCtx, const DurableCatalog::Entry& entry) {
+        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair);
+        return _catalog->getMetaData(opCtx, entry.catalogId).getMaxPrefix();
+    };
+
+    KVPrefix maxSeenPrefix = KVPrefix::kNotPrefixed;
+    const size_t numThreads =
+        std::min(static_cast<size_t>(gStorageEngineCatalogLoadThreads), entries.size());
+    if (numThreads <= 1) {
+        for (const auto& entry : entries) {
+            maxSeenPrefix = std::max(maxSeenPrefix, initCollection(opCtx, entry));
+        }
+        return maxSeenPrefix;
+    }
+
+    // Opening the oplog starts the oplog manager, so keep it on the caller's thread and only fan
+    // out the remaining collections.
+    std::vector<const DurableCatalog::Entry*> remaining;
+    remaining.reserve(entries.size());
+    for (const auto& entry : entries) {
+        if (entry.nss.isOplog()) {
+            maxSeenPrefix = std::max(maxSeenPrefix, initCollection(opCtx, entry));
+        } else {
+            remaining.push_back(&entry);
+        }
+    }
+
+    LOGV2(5191150,
+          "Loading collections from the durable catalog in parallel",
+          "numCollections"_attr = remaining.size(),
+          "numThreads"_attr = numThreads);
+
+    ThreadPool::Options options;
+    options.poolName = "StorageEngineCatalogLoader";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName.c_str());
+    };
+    ThreadPool pool(options);
+    pool.startup();
+
+    AtomicWord<size_t> nextEntry{0};
+    Mutex mutex = MONGO_MAKE_LATCH("StorageEngineImpl::_initCollections::mutex");
+    Status firstError = Status::OK();
+    for (size_t i = 0; i < numThreads; ++i) {
+        pool.schedule([&](Status status) {
+            invariant(status);
+
+            // Workers need their own recovery unit. When loading the catalog during storage engine
+            // construction, the service context does not know about this engine yet and would
+            // hand out a noop recovery unit.
+            auto workerOpCtx = cc().makeOperationContext();
+            if (workerOpCtx->recoveryUnit()->isNoop()) {
+                workerOpCtx->setRecoveryUnit(
+                    std::unique_ptr<RecoveryUnit>(_engine->newRecoveryUnit()),
+                    WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+            }
+
+            KVPrefix workerMaxPrefix = KVPrefix::kNotPrefixed;
+            try {
+                for (auto idx = nextEntry.fetchAndAdd(1); idx < remaining.size();
+                     idx = nextEntry.fetchAndAdd(1)) {
+                    auto prefix = initCollection(workerOpCtx.get(), *remaining[idx]);
+                    workerMaxPrefix = std::max(workerMaxPrefix, prefix);
+                }
+            } catch (const DBException& ex) {
+                // Make the other workers stop claiming entries.
+                nextEntry.store(remaining.size());
+                stdx::lock_guard<Latch> lk(mutex);
+                if (firstError.isOK()) {
+                    firstError = ex.toStatus();
+                }
+            }
+            workerOpCtx->recoveryUnit()->abandonSnapshot();
+
+            stdx::lock_guard<Latch> lk(mutex);
+            maxSeenPrefix = std::max(maxSeenPrefix, workerMaxPrefix);
+        });
+    }
+    pool.shutdown();
+    pool.join();
+
+    uassertStatusOK(firstError);
+    return maxSeenPrefix;
+}
+
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
@@ -359,6 +359,14 @@ public:
 private:
     using CollIter = std::list<std::string>::iterator;
 
+    /**
+     * Initializes every collection in 'entries' and returns the largest KVPrefix among them. When
+     * 'storageEngineCatalogLoadThreads' is greater than 1, the collections are opened concurrently
+     * on a thread pool, each worker using its own OperationContext.
+     */
+    KVPrefix _initCollections(OperationContext* opCtx,
+                              const std::vector<DurableCatalog::Entry>& entries);
+
     void _initCollection(OperationContext* opCtx,
                          RecordId catalogId,
                          const NamespaceString& nss,
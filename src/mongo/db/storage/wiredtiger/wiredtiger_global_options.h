@@ -62,6 +62,9 @@ public:
     std::string collectionConfig;
     std::string indexConfig;
 
+    // Overrides collectionBlockCompressor for the oplog when not empty.
+    std::string oplogBlockCompressor;
+
     static Status validateWiredTigerCompressor(const std::string&);
 
     /**
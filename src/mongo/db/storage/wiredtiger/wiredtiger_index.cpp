@@ -49,6 +49,7 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -580,6 +581,7 @@ public:
           _prefix(prefix) {}
 
     ~BulkBuilder() {
+        commitInsertBatch();
         _cursor->close(_cursor);
     }
 
@@ -599,8 +601,10 @@ protected:
         WT_SESSION* session = _session->getSession();
         int err = session->open_cursor(
             session, idx->uri().c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
-        if (!err)
+        if (!err) {
+            _isBulk = true;
             return cursor;
+        }
 
         LOGV2_WARNING(51783,
                       "failed to create WiredTiger bulk cursor: {error} falling back to non-bulk "
@@ -621,9 +625,42 @@ protected:
         }
     }
 
+    /**
+     * Inserts the key and value set on the cursor. A bulk cursor builds the pages of the index
+     * directly from its sorted stream of keys. Without one, the keys are inserted in batches of
+     * 'wiredTigerIndexBuildInsertBatchSize' per transaction on our own session, rather than one
+     * transaction per key.
+     */
+    void insertCursorKey() {
+        if (!_isBulk && _insertsInBatch == 0) {
+            WT_SESSION* session = _session->getSession();
+            invariantWTOK(session->begin_transaction(session, nullptr));
+        }
+
+        invariantWTOK(_cursor->insert(_cursor));
+
+        if (!_isBulk && ++_insertsInBatch >= gWiredTigerIndexBuildInsertBatchSize.load()) {
+            commitInsertBatch();
+        }
+    }
+
+    /**
+     * Commits the keys inserted since the last batch was committed, when not using a bulk cursor.
+     */
+    void commitInsertBatch() {
+        if (_insertsInBatch == 0) {
+            return;
+        }
+        WT_SESSION* session = _session->getSession();
+        invariantWTOK(session->commit_transaction(session, nullptr));
+        _insertsInBatch = 0;
+    }
+
     const Ordering _ordering;
     OperationContext* const _opCtx;
     UniqueWiredTigerSession const _session;
+    bool _isBulk = false;
+    int _insertsInBatch = 0;
     WT_CURSOR* const _cursor;
     KVPrefix _prefix;
 };
@@ -651,12 +688,14 @@ public:
 
         _cursor->set_value(_cursor, valueItem.Get());
 
-        invariantWTOK(_cursor->insert(_cursor));
+        insertCursorKey();
 
         return Status::OK();
     }
 
     void commit(bool mayInterrupt) override {
+        commitInsertBatch();
+
         // TODO do we still need this?
         // this is bizarre, but required as part of the contract
         WriteUnitOfWork uow(_opCtx);
@@ -701,6 +740,7 @@ public:
             // This handles inserting the last unique key.
             doInsert();
         }
+        commitInsertBatch();
         uow.commit();
     }
 
@@ -739,7 +779,7 @@ private:
 
         _cursor->set_value(_cursor, valueItem.Get());
 
-        invariantWTOK(_cursor->insert(_cursor));
+        insertCursorKey();
 
         // Don't copy the key again if dups are allowed.
         if (!_dupsAllowed)
@@ -803,7 +843,7 @@ private:
         setKey(_cursor, keyItem.Get());
         _cursor->set_value(_cursor, valueItem.Get());
 
-        invariantWTOK(_cursor->insert(_cursor));
+        insertCursorKey();
 
         _records.clear();
     }
@@ -830,6 +870,7 @@ public:
           _forward(forward),
           _key(idx.getKeyStringVersion()),
           _typeBits(idx.getKeyStringVersion()),
+          _keyWithRecordId(idx.getKeyStringVersion()),
           _query(idx.getKeyStringVersion()),
           _prefix(prefix) {
         _cursor.emplace(_idx.uri(), _idx.tableId(), false, _opCtx);
@@ -853,6 +894,21 @@ public:
         return getKeyStringEntry();
     }
 
+    void nextKeyStringBlock(KeyStringBlock* block, size_t maxKeys) override {
+        // Appends the current key directly, rather than copying it into its own KeyStringEntry.
+        while (block->size() < maxKeys && advanceNext() && !_eof) {
+            if (keyLacksRecordId()) {
+                _keyWithRecordId.resetToEmpty();
+                _keyWithRecordId.resetFromBuffer(_key.getBuffer(), _key.getSize());
+                _keyWithRecordId.appendRecordId(_id);
+                block->append(
+                    _keyWithRecordId.getBuffer(), _keyWithRecordId.getSize(), _typeBits, _id);
+            } else {
+                block->append(_key.getBuffer(), _key.getSize(), _typeBits, _id);
+            }
+        }
+    }
+
     void setEndPosition(const BSONObj& key, bool inclusive) override {
         LOGV2_TRACE_CURSOR(20098,
                            "setEndPosition inclusive: {inclusive} {key}",
@@ -1208,15 +1264,20 @@ protected:
         return true;
     }
 
-    KeyStringEntry getKeyStringEntry() {
-        // Most keys will have a RecordId appended to the end, with the exception of the _id index
-        // and timestamp unsafe unique indexes. The contract of this function is to always return a
-        // KeyString with a RecordId, so append one if it does not exists already.
-        if (_idx.unique() &&
+    // Most keys will have a RecordId appended to the end, with the exception of the _id index and
+    // timestamp unsafe unique indexes.
+    bool keyLacksRecordId() const {
+        return _idx.unique() &&
             (_idx.isIdIndex() ||
              _key.getSize() ==
                  KeyString::getKeySize(
-                     _key.getBuffer(), _key.getSize(), _idx.getOrdering(), _typeBits))) {
+                     _key.getBuffer(), _key.getSize(), _idx.getOrdering(), _typeBits));
+    }
+
+    KeyStringEntry getKeyStringEntry() {
+        // The contract of this function is to always return a KeyString with a RecordId, so append
+        // one if it does not exists already.
+        if (keyLacksRecordId()) {
             // Create a copy of _key with a RecordId. Because _key is used during cursor restore(),
             // appending the RecordId would cause the cursor to be repositioned incorrectly.
             KeyString::Builder keyWithRecordId(_key);
@@ -1256,6 +1317,9 @@ protected:
     // false by any operation that moves the cursor, other than subsequent save/restore pairs.
     bool _lastMoveSkippedKey = false;
 
+    // Reused to append the RecordId to the keys which lack it for nextKeyStringBlock().
+    KeyString::Builder _keyWithRecordId;
+
     KeyString::Builder _query;
     KVPrefix _prefix;
 
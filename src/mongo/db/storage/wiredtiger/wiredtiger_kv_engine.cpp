@@ -82,10 +82,12 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
@@ -300,6 +302,149 @@ Status OpenReadTransactionParam::setFromString(const std::string& str) {
     return _data->resize(num);
 }
 
+/**
+ * Periodically resizes the read and write ticket pools with a WiredTigerTicketSizer each, while
+ * wiredTigerTicketSizingIntervalMillis is non-zero.
+ */
+class WiredTigerKVEngine::WiredTigerTicketSizingThread : public BackgroundJob {
+public:
+    explicit WiredTigerTicketSizingThread(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTTicketSizer";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(5190800, 1, "starting {name} thread", "name"_attr = name());
+
+        std::vector<Pool> pools;
+        pools.emplace_back("read"_sd, &openReadTransaction);
+        pools.emplace_back("write"_sd, &openWriteTransaction);
+
+        while (!_shuttingDown.load()) {
+            // While disabled, check once a second whether sizing has been turned on.
+            const auto intervalMillis = gWiredTigerTicketSizingIntervalMillis.load();
+            const auto waitMillis = intervalMillis > 0 ? intervalMillis : 1000;
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, stdx::chrono::milliseconds(waitMillis));
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            const bool enabled = gWiredTigerTicketSizingIntervalMillis.load() > 0;
+            const auto cache = enabled ? _sampleCache() : CacheSample{};
+            for (auto&& pool : pools) {
+                _adjust(&pool, enabled, cache);
+            }
+        }
+        LOGV2_DEBUG(5190801, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    struct Pool {
+        Pool(StringData name, TicketHolder* holder)
+            : name(name),
+              holder(holder),
+              sizer(gWiredTigerTicketSizingMinTickets,
+                    std::max(gWiredTigerTicketSizingMinTickets,
+                             gWiredTigerTicketSizingMaxTickets)) {}
+
+        StringData name;
+        TicketHolder* holder;
+        WiredTigerTicketSizer sizer;
+
+        // The state at the previous sample, unset while sizing is disabled.
+        boost::optional<Date_t> lastSampleDate;
+        long long lastAcquired = 0;
+    };
+
+    struct CacheSample {
+        double dirtyFraction = 0;
+        double usedFraction = 0;
+    };
+
+    CacheSample _sampleCache() {
+        WiredTigerSession session(_conn);
+        auto stat = [&](int key) -> double {
+            auto value = WiredTigerUtil::getStatisticsValue(
+                session.getSession(), "statistics:", "statistics=(fast)", key);
+            return value.isOK() ? value.getValue() : 0;
+        };
+
+        CacheSample sample;
+        if (const auto maxBytes = stat(WT_STAT_CONN_CACHE_BYTES_MAX); maxBytes > 0) {
+            sample.dirtyFraction = stat(WT_STAT_CONN_CACHE_BYTES_DIRTY) / maxBytes;
+            sample.usedFraction = stat(WT_STAT_CONN_CACHE_BYTES_INUSE) / maxBytes;
+        }
+        return sample;
+    }
+
+    void _adjust(Pool* pool, bool enabled, const CacheSample& cache) {
+        const auto now = Date_t::now();
+        const auto acquired = pool->holder->totalAcquired();
+        ON_BLOCK_EXIT([&] {
+            pool->lastSampleDate = enabled ? boost::make_optional(now) : boost::none;
+            pool->lastAcquired = acquired;
+        });
+        if (!enabled || !pool->lastSampleDate) {
+            return;
+        }
+
+        const auto elapsedMillis = durationCount<Milliseconds>(now - *pool->lastSampleDate);
+        if (elapsedMillis <= 0) {
+            return;
+        }
+
+        WiredTigerTicketSizer::Sample sample;
+        sample.throughput = (acquired - pool->lastAcquired) * 1000.0 / elapsedMillis;
+        for (auto priority : {TicketHolder::Priority::kLow,
+                              TicketHolder::Priority::kNormal,
+                              TicketHolder::Priority::kHigh}) {
+            sample.queued += pool->holder->queued(priority);
+        }
+        sample.cacheDirtyFraction = cache.dirtyFraction;
+        sample.cacheUsedFraction = cache.usedFraction;
+
+        const auto currentSize = pool->holder->outof();
+        const auto nextSize = pool->sizer.nextSize(currentSize, sample);
+        if (nextSize == currentSize) {
+            return;
+        }
+
+        LOGV2_DEBUG(5190802,
+                    1,
+                    "Resizing ticket pool",
+                    "pool"_attr = pool->name,
+                    "from"_attr = currentSize,
+                    "to"_attr = nextSize,
+                    "throughput"_attr = sample.throughput,
+                    "queued"_attr = sample.queued,
+                    "cacheDirtyFraction"_attr = sample.cacheDirtyFraction,
+                    "cacheUsedFraction"_attr = sample.cacheUsedFraction);
+        uassertStatusOK(pool->holder->resize(nextSize));
+    }
+
+    WT_CONNECTION* const _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketSizingThread::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+};
+
 StringData WiredTigerKVEngine::kTableUriPrefix = "table:"_sd;
 
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
@@ -478,6 +623,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     _sessionSweeper = std::make_unique<WiredTigerSessionSweeper>(_sessionCache.get());
     _sessionSweeper->go();
 
+    if (!_ephemeral) {
+        _readAhead = std::make_unique<WiredTigerReadAhead>(_sessionCache.get(),
+                                                           gWiredTigerReadAheadThreads);
+    }
+
     // Until the Replication layer installs a real callback, prevent truncating the oplog.
     setOldestActiveTransactionTimestampCallback(
         [](Timestamp) { return StatusWith(boost::make_optional(Timestamp::min())); });
@@ -517,6 +667,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
+    if (!_readOnly) {
+        _ticketSizingThread = std::make_unique<WiredTigerTicketSizingThread>(_conn);
+        _ticketSizingThread->go();
+    }
+
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
     _runTimeConfigParam->_data.second = this;
@@ -543,6 +698,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        BSONObjBuilder queues(bbb.subobjStart("queues"));
+        openWriteTransaction.appendStats(&queues);
+        queues.done();
         bbb.done();
     }
     {
@@ -550,6 +708,9 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        BSONObjBuilder queues(bbb.subobjStart("queues"));
+        openReadTransaction.appendStats(&queues);
+        queues.done();
         bbb.done();
     }
     bb.done();
@@ -661,6 +822,12 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_ticketSizingThread) {
+        _ticketSizingThread->shutdown();
+    }
+    if (_readAhead) {
+        _readAhead->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -1400,6 +1567,7 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getGroupedRecordStore(
     params.ident = ident.toString();
     params.engineName = _canonicalName;
     params.isCapped = options.capped;
+    params.isClustered = options.clusteredIndex;
     params.isEphemeral = _ephemeral;
     params.cappedCallback = nullptr;
     params.sizeStorer = _sizeStorer.get();
@@ -1701,8 +1869,7 @@ void WiredTigerKVEngine::checkpoint() {
         // case.
         if (initialDataTimestamp.asULL() <= 1) {
             UniqueWiredTigerSession session = _sessionCache->getSession();
-            WT_SESSION* s = session->getSession();
-            invariantWTOK(s->checkpoint(s, "use_timestamp=false"));
+            _checkpoint(session->getSession(), "use_timestamp=false");
         } else if (stableTimestamp < initialDataTimestamp) {
             LOGV2_FOR_RECOVERY(
                 23985,
@@ -1720,8 +1887,7 @@ void WiredTigerKVEngine::checkpoint() {
                                "oplogNeededForRollback"_attr = toString(oplogNeededForRollback));
 
             UniqueWiredTigerSession session = _sessionCache->getSession();
-            WT_SESSION* s = session->getSession();
-            invariantWTOK(s->checkpoint(s, "use_timestamp=true"));
+            _checkpoint(session->getSession(), "use_timestamp=true");
 
             if (oplogNeededForRollback.isOK()) {
                 // Now that the checkpoint is durable, publish the oplog needed to recover from it.
@@ -1736,6 +1902,91 @@ void WiredTigerKVEngine::checkpoint() {
     }
 }
 
+void WiredTigerKVEngine::_applyCheckpointIOBudget() {
+    const auto budgetMBPerSec = gWiredTigerCheckpointIOBudgetMBPerSec.load();
+    if (budgetMBPerSec == _checkpointIOBudgetMBPerSec) {
+        return;
+    }
+
+    // WiredTiger throttles checkpoint writes to its I/O capacity, so a checkpoint of more dirty
+    // data than the budget allows per second is spread over several seconds rather than written in
+    // a single burst.
+    const std::string config = fmt::format("io_capacity=(total={}MB)", budgetMBPerSec);
+    const int ret = _conn->reconfigure(_conn, config.c_str());
+    if (ret != 0) {
+        LOGV2_WARNING(5191481,
+                      "Failed to apply the checkpoint I/O budget",
+                      "config"_attr = config,
+                      "error"_attr = wtRCToStatus(ret));
+        return;
+    }
+
+    LOGV2(5191482,
+          "Applied the checkpoint I/O budget",
+          "previousMBPerSec"_attr = _checkpointIOBudgetMBPerSec,
+          "budgetMBPerSec"_attr = budgetMBPerSec);
+    _checkpointIOBudgetMBPerSec = budgetMBPerSec;
+}
+
+void WiredTigerKVEngine::_checkpoint(WT_SESSION* session, const char* config) {
+    _applyCheckpointIOBudget();
+
+    auto stat = [&](int key) -> long long {
+        auto value = WiredTigerUtil::getStatisticsValue(
+            session, "statistics:", "statistics=(fast)", key);
+        return value.isOK() ? value.getValue() : 0;
+    };
+
+    const auto bytesBefore = stat(WT_STAT_CONN_BLOCK_BYTE_WRITE_CHECKPOINT);
+    const auto throttledBefore = stat(WT_STAT_CONN_CAPACITY_TIME_CKPT);
+    const Date_t start = _clockSource->now();
+
+    invariantWTOK(session->checkpoint(session, config));
+
+    const auto millis = durationCount<Milliseconds>(_clockSource->now() - start);
+    const auto bytes = std::max(0LL, stat(WT_STAT_CONN_BLOCK_BYTE_WRITE_CHECKPOINT) - bytesBefore);
+    const auto throttledMicros =
+        std::max(0LL, stat(WT_STAT_CONN_CAPACITY_TIME_CKPT) - throttledBefore);
+
+    _lastCheckpointMillis.store(millis);
+    _lastCheckpointBytesWritten.store(bytes);
+    _lastCheckpointThrottledMicros.store(throttledMicros);
+    _totalCheckpointBytesWritten.fetchAndAdd(bytes);
+    _totalCheckpointThrottledMicros.fetchAndAdd(throttledMicros);
+}
+
+boost::optional<double> WiredTigerKVEngine::getCacheDirtyFraction() const {
+    WiredTigerSession session(_conn);
+    auto stat = [&](int key) -> boost::optional<double> {
+        auto value = WiredTigerUtil::getStatisticsValue(
+            session.getSession(), "statistics:", "statistics=(fast)", key);
+        return value.isOK() ? boost::make_optional<double>(value.getValue()) : boost::none;
+    };
+
+    const auto maxBytes = stat(WT_STAT_CONN_CACHE_BYTES_MAX);
+    const auto dirtyBytes = stat(WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!maxBytes || !dirtyBytes || *maxBytes <= 0) {
+        return boost::none;
+    }
+    return *dirtyBytes / *maxBytes;
+}
+
+void WiredTigerKVEngine::appendCheckpointStats(BSONObjBuilder* builder) const {
+    const auto millis = _lastCheckpointMillis.load();
+    const auto bytes = _lastCheckpointBytesWritten.load();
+
+    builder->append("io budget MB per second", gWiredTigerCheckpointIOBudgetMBPerSec.load());
+    builder->append("last checkpoint time (msecs)", millis);
+    builder->append("last checkpoint bytes written", bytes);
+    builder->append("last checkpoint write rate (bytes per second)",
+                    millis > 0 ? bytes * 1000 / millis : bytes);
+    builder->append("last checkpoint time throttled (usecs)",
+                    _lastCheckpointThrottledMicros.load());
+    builder->append("total checkpoint bytes written", _totalCheckpointBytesWritten.load());
+    builder->append("total checkpoint time throttled (usecs)",
+                    _totalCheckpointThrottledMicros.load());
+}
+
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
@@ -1946,17 +2197,29 @@ Timestamp WiredTigerKVEngine::_calculateHistoryLagFromStableTimestamp(Timestamp
         invariant(minSnapshotHistoryWindowInSeconds.load() == 0);
     }
 
-    if (stableTimestamp.getSecs() <
-        static_cast<unsigned>(minSnapshotHistoryWindowInSeconds.load())) {
+    const auto windowSecs = static_cast<unsigned>(minSnapshotHistoryWindowInSeconds.load());
+    const bool pinOnlyForActiveReaders = pinSnapshotHistoryOnlyForActiveReaders.load();
+
+    Timestamp calculatedOldestTimestamp;
+    if (stableTimestamp.getSecs() >= windowSecs) {
+        calculatedOldestTimestamp =
+            Timestamp(stableTimestamp.getSecs() - windowSecs, stableTimestamp.getInc());
+    } else if (!pinOnlyForActiveReaders) {
         // The history window is larger than the timestamp history thus far. We must wait for
         // the history to reach the window size before moving oldest_timestamp forward. This should
         // only happen in unit tests.
         return Timestamp();
     }
 
-    Timestamp calculatedOldestTimestamp(stableTimestamp.getSecs() -
-                                            minSnapshotHistoryWindowInSeconds.load(),
-                                        stableTimestamp.getInc());
+    if (pinOnlyForActiveReaders) {
+        // The window is only an upper bound: keep the history back to the oldest active reader,
+        // or none at all if there is no reader older than the stable_timestamp.
+        auto oldestReader = getOldestOpenReadTimestamp();
+        if (oldestReader.isNull() || oldestReader > stableTimestamp) {
+            oldestReader = stableTimestamp;
+        }
+        calculatedOldestTimestamp = std::max(calculatedOldestTimestamp, oldestReader);
+    }
 
     if (calculatedOldestTimestamp.asULL() <= _oldestTimestamp.load()) {
         // The stable_timestamp is not far enough ahead of the oldest_timestamp for the
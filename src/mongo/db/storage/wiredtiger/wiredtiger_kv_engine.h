@@ -53,6 +53,7 @@ namespace mongo {
 class ClockSource;
 class JournalListener;
 class WiredTigerRecordStore;
+class WiredTigerReadAhead;
 class WiredTigerSessionCache;
 class WiredTigerSizeStorer;
 class WiredTigerEngineRuntimeConfigParameter;
@@ -119,6 +120,14 @@ public:
 
     void checkpoint() override;
 
+    boost::optional<double> getCacheDirtyFraction() const override;
+
+    /**
+     * Appends the I/O budget in effect for checkpoints, and how much the most recent checkpoint
+     * wrote and was throttled, to 'builder'.
+     */
+    void appendCheckpointStats(BSONObjBuilder* builder) const;
+
     bool isDurable() const override {
         return _durable;
     }
@@ -290,6 +299,14 @@ public:
     WT_CONNECTION* getConnection() {
         return _conn;
     }
+
+    /**
+     * Returns the threads which read Records ahead of cursors, or nullptr when the data is in
+     * memory.
+     */
+    WiredTigerReadAhead* getReadAhead() const {
+        return _readAhead.get();
+    }
     void dropSomeQueuedIdents();
     std::list<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
         std::list<WiredTigerCachedCursor>* cache);
@@ -369,6 +386,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerTicketSizingThread;
 
     /**
      * Opens a connection on the WiredTiger database 'path' with the configuration 'wtOpenConfig'.
@@ -420,6 +438,17 @@ private:
 
     std::uint64_t _getCheckpointTimestamp() const;
 
+    /**
+     * Reconfigures WiredTiger's I/O capacity if 'wiredTigerCheckpointIOBudgetMBPerSec' changed
+     * since the previous checkpoint.
+     */
+    void _applyCheckpointIOBudget();
+
+    /**
+     * Takes a checkpoint on 'session' with 'config' and records how much it wrote.
+     */
+    void _checkpoint(WT_SESSION* session, const char* config);
+
     mutable Mutex _oldestActiveTransactionTimestampCallbackMutex =
         MONGO_MAKE_LATCH("::_oldestActiveTransactionTimestampCallbackMutex");
     StorageEngine::OldestActiveTransactionTimestampCallback
@@ -457,6 +486,8 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerTicketSizingThread> _ticketSizingThread;
+    std::unique_ptr<WiredTigerReadAhead> _readAhead;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -485,6 +516,16 @@ private:
 
     AtomicWord<std::uint64_t> _oplogNeededForCrashRecovery;
 
+    // The I/O budget WiredTiger was last configured with. Only accessed by the checkpoint thread.
+    int _checkpointIOBudgetMBPerSec = 0;
+
+    // Statistics about the checkpoints taken, reported in serverStatus.
+    AtomicWord<long long> _lastCheckpointMillis{0};
+    AtomicWord<long long> _lastCheckpointBytesWritten{0};
+    AtomicWord<long long> _lastCheckpointThrottledMicros{0};
+    AtomicWord<long long> _totalCheckpointBytesWritten{0};
+    AtomicWord<long long> _totalCheckpointThrottledMicros{0};
+
     std::unique_ptr<WiredTigerEngineRuntimeConfigParameter> _runTimeConfigParam;
 
     mutable Mutex _highestDurableTimestampMutex =
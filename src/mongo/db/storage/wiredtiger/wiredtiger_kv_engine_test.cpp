@@ -242,6 +242,42 @@ TEST_F(WiredTigerKVEngineRepairTest, UnrecoverableOrphanedDataFilesAreRebuilt) {
 #endif
 }
 
+TEST_F(WiredTigerKVEngineTest, CheckpointReportsDirtyCacheAndBytesWritten) {
+    auto opCtxPtr = makeOperationContext();
+
+    NamespaceString nss("a.b");
+    std::string ident = "collection-1234";
+    std::string record(64 * 1024, 'x');
+    CollectionOptions defaultCollectionOptions;
+
+    ASSERT_OK(
+        _engine->createRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions));
+    auto rs = _engine->getRecordStore(opCtxPtr.get(), nss.ns(), ident, defaultCollectionOptions);
+    ASSERT(rs);
+
+    for (int i = 0; i < 16; ++i) {
+        WriteUnitOfWork uow(opCtxPtr.get());
+        ASSERT_OK(rs->insertRecord(opCtxPtr.get(), record.c_str(), record.length(), Timestamp())
+                      .getStatus());
+        uow.commit();
+    }
+
+    auto dirtyFraction = _engine->getCacheDirtyFraction();
+    ASSERT(dirtyFraction);
+    ASSERT_GT(*dirtyFraction, 0.0);
+    ASSERT_LTE(*dirtyFraction, 1.0);
+
+    _engine->checkpoint();
+
+    BSONObjBuilder builder;
+    _engine->appendCheckpointStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_GT(stats["last checkpoint bytes written"].numberLong(), 0) << stats;
+    ASSERT_EQ(stats["total checkpoint bytes written"].numberLong(),
+              stats["last checkpoint bytes written"].numberLong())
+        << stats;
+}
+
 TEST_F(WiredTigerKVEngineTest, TestOplogTruncation) {
     std::unique_ptr<Checkpointer> checkpointer = std::make_unique<Checkpointer>(_engine);
     checkpointer->go();
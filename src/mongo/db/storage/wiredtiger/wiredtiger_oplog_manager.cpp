@@ -48,7 +48,8 @@ MONGO_FAIL_POINT_DEFINE(WTPauseOplogVisibilityUpdateLoop);
 
 // Arbitrary. Using the storageGlobalParams.journalCommitIntervalMs default, which used to
 // dynamically control the visibility thread's delay back when the visibility thread also flushed
-// the journal.
+// the journal. Bounds how often the visibility thread updates the oplog read timestamp when nobody
+// is waiting for it.
 const int kDelayMillis = 100;
 
 void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
@@ -140,6 +141,9 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     invariant(_opsWaitingForOplogVisibilityUpdate > 0);
     auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
 
+    // Cut short a batching delay the visibility thread may be in right now.
+    _oplogVisibilityThreadCV.notify_one();
+
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
     // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
     // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
@@ -181,6 +185,11 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
     // uncommitted entries behind them. This prevents cursors from seeing 'holes' in the oplog and
     // consequently missing data that was not there yet when scanning went passed up to a later
     // timestamp.
+    //
+    // Updates are batched by delaying them until kDelayMillis after the previous one, unless
+    // somebody is waiting. A commit which arrives after a quiet period is thus made visible right
+    // away, while a steady stream of commits still costs at most one update per delay period.
+    Date_t lastUpdate;
     while (true) {
         stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
         {
@@ -191,7 +200,7 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
             // If we are not shutting down and nobody is actively waiting for the oplog to become
             // visible, delay a bit to batch more requests into one update and reduce system load.
             auto now = Date_t::now();
-            auto deadline = now + Milliseconds(kDelayMillis);
+            auto deadline = lastUpdate + Milliseconds(kDelayMillis);
 
             auto wakeUpEarlyForWaitersPredicate = [&] {
                 return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
@@ -199,7 +208,8 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
             };
 
             // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
+            // preempted because of waiting capped cursors, which don't signal this thread. Waiting
+            // callers and shutdown signal it.
             while (now < deadline &&
                    !_oplogVisibilityThreadCV.wait_until(
                        lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
@@ -225,6 +235,7 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
 
         // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
         // any holes behind it in-memory.
+        lastUpdate = Date_t::now();
         const uint64_t newTimestamp = sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
 
         // The newTimestamp may actually go backward during secondary batch application,
@@ -127,9 +127,15 @@ int wiredTigerPrepareConflictRetry(OperationContext* opCtx, F&& f) {
         return WT_ROLLBACK;
     }
 
+    // Only the ending of the prepared units of work which can conflict with this read wakes it.
+    auto sessionCache = recoveryUnit->getSessionCache();
+    WiredTigerSessionCache::PrepareConflictWaiter waiter(
+        recoveryUnit->inActiveTxn() ? recoveryUnit->getActiveTxnReadTimestamp() : Timestamp());
+    sessionCache->registerPrepareConflictWaiter(&waiter);
+    ON_BLOCK_EXIT([&] { sessionCache->unregisterPrepareConflictWaiter(&waiter); });
+
     while (true) {
         attempts++;
-        auto lastCount = recoveryUnit->getSessionCache()->getPrepareCommitOrAbortCount();
         // If the failpoint is enabled, don't call the function, just simulate a conflict.
         ret = MONGO_unlikely(WTPrepareConflictForReads.shouldFail()) ? WT_PREPARE_CONFLICT
                                                                      : WT_READ_CHECK(f());
@@ -141,8 +147,7 @@ int wiredTigerPrepareConflictRetry(OperationContext* opCtx, F&& f) {
         wiredTigerPrepareConflictLog(attempts);
 
         // Wait on the session cache to signal that a unit of work has been committed or aborted.
-        recoveryUnit->getSessionCache()->waitUntilPreparedUnitOfWorkCommitsOrAborts(opCtx,
-                                                                                    lastCount);
+        sessionCache->waitUntilPreparedUnitOfWorkCommitsOrAborts(opCtx, &waiter);
     }
 }
 }  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+
+namespace mongo {
+namespace {
+
+ThreadPool::Options makeOptions(int numThreads) {
+    ThreadPool::Options options;
+    options.poolName = "WiredTigerReadAhead";
+    options.minThreads = 0;
+    options.maxThreads = numThreads;
+    return options;
+}
+
+}  // namespace
+
+WiredTigerReadAhead::WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, int numThreads)
+    : _sessionCache(sessionCache), _numThreads(numThreads), _pool(makeOptions(numThreads)) {
+    _pool.startup();
+}
+
+WiredTigerReadAhead::~WiredTigerReadAhead() {
+    shutdown();
+}
+
+void WiredTigerReadAhead::shutdown() {
+    if (_shuttingDown.swap(true)) {
+        return;
+    }
+    _pool.shutdown();
+    _pool.join();
+}
+
+bool WiredTigerReadAhead::scheduleScan(const std::string& uri,
+                                       int64_t startId,
+                                       bool forward,
+                                       int numRecords,
+                                       std::shared_ptr<ScanProgress> progress) {
+    auto scan = [this, startId, forward, numRecords, progress](WT_CURSOR* c) {
+        c->set_key(c, startId);
+        int exact;
+        int ret = c->search_near(c, &exact);
+        if (ret == 0 && (forward ? exact < 0 : exact > 0)) {
+            ret = forward ? c->next(c) : c->prev(c);
+        }
+        for (int i = 0; ret == 0 && i < numRecords && !_shuttingDown.load(); ++i) {
+            int64_t id;
+            WT_ITEM value;
+            if (c->get_key(c, &id) != 0 || c->get_value(c, &value) != 0) {
+                break;
+            }
+            progress->lastId.store(id);
+            ret = forward ? c->next(c) : c->prev(c);
+        }
+        progress->reachedEnd.store(ret == WT_NOTFOUND);
+        progress->running.store(false);
+    };
+    return _schedule(uri, std::move(scan));
+}
+
+bool WiredTigerReadAhead::scheduleSeeks(const std::string& uri, std::vector<int64_t> ids) {
+    return _schedule(uri, [this, ids = std::move(ids)](WT_CURSOR* c) {
+        for (auto id : ids) {
+            if (_shuttingDown.load()) {
+                return;
+            }
+            c->set_key(c, id);
+            WT_ITEM value;
+            if (c->search(c) == 0) {
+                c->get_value(c, &value);
+            }
+        }
+    });
+}
+
+bool WiredTigerReadAhead::_schedule(const std::string& uri,
+                                    unique_function<void(WT_CURSOR*)> read) {
+    if (_shuttingDown.load() || _pending.addAndFetch(1) > 2 * _numThreads) {
+        _pending.subtractAndFetch(1);
+        return false;
+    }
+
+    // Sessions must be taken from the cache while holding the global lock, which our caller does.
+    auto session = _sessionCache->getSession();
+    _pool.schedule(
+        [this, uri, session = std::move(session), read = std::move(read)](Status status) mutable {
+            if (status.isOK() && !_shuttingDown.load()) {
+                WT_SESSION* s = session->getSession();
+                WT_CURSOR* c;
+                // Failures to read only lose the hint: the table may be gone, or busy being
+                // dropped, or the cache may be too full to read more into it.
+                if (s->open_cursor(s, uri.c_str(), nullptr, nullptr, &c) == 0) {
+                    read(c);
+                    c->close(c);
+                }
+            }
+            session.reset();
+            _pending.subtractAndFetch(1);
+        });
+    return true;
+}
+
+}  // namespace mongo
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wiredtiger.h>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/functional.h"
+
+namespace mongo {
+
+class WiredTigerSessionCache;
+
+/**
+ * Reads Records of standard (non-prefixed) record stores in background threads, so that the pages
+ * holding them are in the WiredTiger cache by the time a cursor reaches them. A cursor which has
+ * to read its pages from disk otherwise only ever has a single outstanding I/O.
+ *
+ * The reads use sessions of their own, without a transaction, and only warm the cache: nothing
+ * they read is returned to a caller. Read-ahead is a hint, so requests are dropped rather than
+ * queued when the threads are busy.
+ */
+class WiredTigerReadAhead {
+public:
+    /**
+     * Tracks how far a scheduled scan has read. The fields are written by the background thread.
+     * A scan which fails to open its table never stops 'running', which ends the read-ahead of its
+     * cursor.
+     */
+    struct ScanProgress {
+        AtomicWord<bool> running{true};
+        AtomicWord<bool> reachedEnd{false};
+        AtomicWord<long long> lastId{0};
+    };
+
+    WiredTigerReadAhead(WiredTigerSessionCache* sessionCache, int numThreads);
+    ~WiredTigerReadAhead();
+
+    /**
+     * Waits for the reads in progress and drops the others. Must be called before the sessions of
+     * the session cache are closed.
+     */
+    void shutdown();
+
+    /**
+     * Reads the 'numRecords' Records of 'uri' at and after, or before when '!forward', the
+     * RecordId 'startId'. Returns false if the scan could not be scheduled.
+     */
+    bool scheduleScan(const std::string& uri,
+                      int64_t startId,
+                      bool forward,
+                      int numRecords,
+                      std::shared_ptr<ScanProgress> progress);
+
+    /**
+     * Reads the Records of 'uri' with the given RecordIds, which should be sorted.
+     */
+    bool scheduleSeeks(const std::string& uri, std::vector<int64_t> ids);
+
+    int numThreads() const {
+        return _numThreads;
+    }
+
+private:
+    bool _schedule(const std::string& uri, unique_function<void(WT_CURSOR*)> read);
+
+    WiredTigerSessionCache* const _sessionCache;
+    const int _numThreads;
+    ThreadPool _pool;
+
+    // The reads scheduled and not yet finished.
+    AtomicWord<int> _pending{0};
+    AtomicWord<bool> _shuttingDown{false};
+};
+
+}  // namespace mongo
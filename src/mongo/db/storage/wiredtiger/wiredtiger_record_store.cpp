@@ -53,11 +53,14 @@
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/server_recovery.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/clustered_id.h"
+#include "mongo/db/storage/index_entry_comparison.h"
 #include "mongo/db/storage/oplog_hack.h"
 #include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -237,6 +240,15 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
     // Wait until kill() is called or there are too many oplog stones.
     stdx::unique_lock<Latch> lock(_oplogReclaimMutex);
     while (!_isDead) {
+        const Date_t now = Date_t::now();
+        if (now < _nextTruncationDate) {
+            // Pace the truncation of the oplog to 'oplogTruncationMaxBytesPerSec'.
+            MONGO_IDLE_THREAD_BLOCK;
+            _oplogReclaimCv.wait_until(lock, _nextTruncationDate.toSystemTimePoint());
+            _totalTimeThrottled.fetchAndAdd(durationCount<Microseconds>(Date_t::now() - now));
+            continue;
+        }
+
         {
             MONGO_IDLE_THREAD_BLOCK;
             stdx::lock_guard<Latch> lk(_mutex);
@@ -287,6 +299,32 @@ bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
     return currRetentionHours >= minRetentionHours;
 }
 
+void WiredTigerRecordStore::OplogStones::getOplogStonesStats(BSONObjBuilder& builder) const {
+    builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
+    builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+    if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
+        builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
+    }
+
+    // The truncation lag is the size of the oplog stones which are beyond the maximum size of the
+    // oplog, and have yet to be truncated.
+    int64_t totalBytes = 0;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto&& stone : _stones) {
+            totalBytes += stone.bytes;
+        }
+    }
+    builder.append("bytesAboveMaxSize",
+                   std::max(totalBytes - static_cast<int64_t>(_rs->cappedMaxSize()), int64_t(0)));
+    builder.append("totalTimeThrottledMicros", _totalTimeThrottled.load());
+}
+
+void WiredTigerRecordStore::OplogStones::delayNextTruncation(Date_t date) {
+    stdx::lock_guard<Latch> lk(_oplogReclaimMutex);
+    _nextTruncationDate = date;
+}
+
 boost::optional<WiredTigerRecordStore::OplogStones::Stone>
 WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
     stdx::lock_guard<Latch> lk(_mutex);
@@ -747,7 +785,13 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
         ss << "prefix_compression,";
     }
 
-    ss << "block_compressor=" << wiredTigerGlobalOptions.collectionBlockCompressor << ",";
+    // The oplog is only ever appended to and read in order, so it can afford a compressor which
+    // is slower than the one used for collections.
+    ss << "block_compressor="
+       << (NamespaceString::oplog(ns) && !wiredTigerGlobalOptions.oplogBlockCompressor.empty()
+               ? wiredTigerGlobalOptions.oplogBlockCompressor
+               : wiredTigerGlobalOptions.collectionBlockCompressor)
+       << ",";
 
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())->getTableCreateConfig(ns);
 
@@ -812,6 +856,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                     getGlobalReplSettings().usingReplSets() ||
                         repl::ReplSettings::shouldRecoverFromOplogAsStandalone())),
       _isOplog(NamespaceString::oplog(params.ns)),
+      _isClustered(params.isClustered),
       _cappedMaxSize(params.cappedMaxSize),
       _cappedMaxSizeSlack(std::min(params.cappedMaxSize / 10, int64_t(16 * 1024 * 1024))),
       _cappedMaxDocs(params.cappedMaxDocs),
@@ -1365,6 +1410,7 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
     Timer timer;
     while (auto stone = _oplogStones->peekOldestStoneIfNeeded()) {
         invariant(stone->lastRecord.isValid());
+        Timer stoneTimer;
 
         if (static_cast<std::uint64_t>(stone->lastRecord.repr()) >= mayTruncateUpTo.asULL()) {
             // Do not truncate oplogs needed for replication recovery.
@@ -1419,6 +1465,19 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
         } catch (const WriteConflictException&) {
             LOGV2_DEBUG(
                 22400, 1, "Caught WriteConflictException while truncating oplog entries, retrying");
+            continue;
+        }
+
+        // To stay under the maximum truncation rate, return to the reclaim thread, which waits out
+        // the rest of the time this stone should have taken without holding any locks.
+        const long long maxBytesPerSec = gOplogTruncationMaxBytesPerSec.load();
+        if (maxBytesPerSec > 0) {
+            const Microseconds minDuration{stone->bytes * 1000 * 1000 / maxBytesPerSec};
+            const Microseconds elapsed{stoneTimer.micros()};
+            if (elapsed < minDuration) {
+                _oplogStones->delayNextTruncation(Date_t::now() + (minDuration - elapsed));
+                break;
+            }
         }
     }
 
@@ -1461,7 +1520,8 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
     if (_isCapped && totalLength > _cappedMaxSize)
         return Status(ErrorCodes::BadValue, "object to insert exceeds cappedMaxSize");
 
-    WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
+    // A clustered collection relies on the insert failing to enforce the uniqueness of _id.
+    WiredTigerCursor curwrap(_uri, _tableId, !_isClustered, opCtx);
     curwrap.assertInActiveTxn();
     WT_CURSOR* c = curwrap.get();
     invariant(c);
@@ -1476,6 +1536,13 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
             if (!status.isOK())
                 return status.getStatus();
             record.id = status.getValue();
+        } else if (_isClustered) {
+            StatusWith<RecordId> status =
+                clustered_id::extractKey(record.data.data(), record.data.size());
+            if (!status.isOK())
+                return status.getStatus();
+            record.id = status.getValue();
+            continue;
         } else {
             record.id = _nextId(opCtx);
         }
@@ -1506,6 +1573,14 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         WiredTigerItem value(record.data.data(), record.data.size());
         c->set_value(c, value.Get());
         int ret = WT_OP_CHECK(c->insert(c));
+        if (ret == WT_DUPLICATE_KEY) {
+            invariant(_isClustered);
+            return buildDupKeyErrorStatus(BSON("" << BSONObj(record.data.data())["_id"]),
+                                          NamespaceString(ns()),
+                                          "_id_",
+                                          BSON("_id" << 1),
+                                          BSONObj());
+        }
         if (ret)
             return wtRCToStatus(ret, "WiredTigerRecordStore::insertRecord");
     }
@@ -1674,15 +1749,34 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     const char* damageSource,
     const mutablebson::DamageVector& damages) {
 
+    // Damages which grow or shrink the record are not idempotent. Like updateRecord(), don't trust
+    // WiredTiger's recovery with such modify operations on logged tables; write the whole record.
+    if (_isLogged && std::any_of(damages.begin(), damages.end(), [](const auto& damage) {
+            return damage.sourceSize != damage.targetSize;
+        })) {
+        std::string updated(oldRec.data(), oldRec.size());
+        for (auto&& damage : damages) {
+            updated.replace(damage.targetOffset,
+                            damage.targetSize,
+                            damageSource + damage.sourceOffset,
+                            damage.sourceSize);
+        }
+        auto status = updateRecord(opCtx, id, updated.data(), updated.size());
+        if (!status.isOK()) {
+            return status;
+        }
+        return RecordData(updated.data(), updated.size()).getOwned();
+    }
+
     const int nentries = damages.size();
     mutablebson::DamageVector::const_iterator where = damages.begin();
     const mutablebson::DamageVector::const_iterator end = damages.cend();
     std::vector<WT_MODIFY> entries(nentries);
     for (u_int i = 0; where != end; ++i, ++where) {
         entries[i].data.data = damageSource + where->sourceOffset;
-        entries[i].data.size = where->size;
+        entries[i].data.size = where->sourceSize;
         entries[i].offset = where->targetOffset;
-        entries[i].size = where->size;
+        entries[i].size = where->targetSize;
     }
 
     WiredTigerCursor curwrap(_uri, _tableId, true, opCtx);
@@ -1700,6 +1794,10 @@ StatusWith<RecordData> WiredTigerRecordStore::updateWithDamages(
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    if (const int64_t sizeDiff = static_cast<int64_t>(value.size) - oldRec.size()) {
+        _increaseDataSize(opCtx, sizeDiff);
+    }
+
     return RecordData(static_cast<const char*>(value.data), value.size).getOwned();
 }
 
@@ -1709,6 +1807,14 @@ std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursor(
     return getRandomCursorWithOptions(opCtx, extraConfig);
 }
 
+std::unique_ptr<RecordCursor> WiredTigerRecordStore::getRandomCursorForSampleSize(
+    OperationContext* opCtx, long long numSamples) const {
+    // WiredTiger then divides the tree into 'numSamples' pieces, and takes each record from one of
+    // them.
+    const std::string extraConfig = str::stream() << "next_random_sample_size=" << numSamples;
+    return getRandomCursorWithOptions(opCtx, extraConfig);
+}
+
 Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
     WT_CURSOR* start = startWrap.get();
@@ -2178,6 +2284,7 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
+    scheduleReadAhead(id);
     _lastReturnedId = id;
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
@@ -2194,6 +2301,10 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     // options we pass when we explicitly start transactions in the RecoveryUnit.
     WiredTigerRecoveryUnit::get(_opCtx)->getSession();
 
+    _readAheadProgress.reset();
+    _readAheadLead = 0;
+    _numReturnedSinceSeek = 0;
+
     _skipNextAdvance = false;
     WT_CURSOR* c = _cursor->get();
     setKey(c, id);
@@ -2214,6 +2325,122 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordI
     return {{id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+std::vector<boost::optional<Record>> WiredTigerRecordStoreCursorBase::multiGet(
+    const std::vector<RecordId>& ids) {
+    invariant(_hasRestored);
+    // Stepping may reach Records which the visibility rules of the oplog hide.
+    if (_oplogVisibleTs) {
+        return SeekableRecordCursor::multiGet(ids);
+    }
+
+    // The most Records the cursor steps over to reach the next id before searching for it.
+    const int64_t kMaxSteps = 8;
+
+    std::vector<size_t> order(ids.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+    // Read the later ids in the background while the cursor finds the earlier ones.
+    auto readAhead = _rs._kvEngine ? _rs._kvEngine->getReadAhead() : nullptr;
+    if (gWiredTigerCursorReadAheadRecords.load() > 0 && readAhead && supportsReadAhead()) {
+        const size_t kMinIdsPerReadAhead = 8;
+        const size_t chunkSize =
+            std::max(kMinIdsPerReadAhead, order.size() / (readAhead->numThreads() + 1));
+        for (size_t begin = chunkSize; begin < order.size(); begin += chunkSize) {
+            std::vector<int64_t> chunk;
+            for (size_t j = begin; j < std::min(begin + chunkSize, order.size()); ++j) {
+                chunk.push_back(ids[order[j]].repr());
+            }
+            if (!readAhead->scheduleSeeks(_rs._uri, std::move(chunk))) {
+                break;
+            }
+        }
+    }
+
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+    WT_CURSOR* c = _cursor->get();
+
+    // The id of the Record the WT_CURSOR is positioned on, if any.
+    boost::optional<RecordId> position;
+    std::vector<boost::optional<Record>> records(ids.size());
+    for (auto i : order) {
+        const auto& id = ids[i];
+        if (!position || id < *position || id.repr() - position->repr() > kMaxSteps) {
+            records[i] = seekExact(id);
+            position = records[i] ? boost::make_optional(id) : boost::none;
+        } else {
+            while (position && *position < id) {
+                // Nothing after the next line can throw WCEs.
+                int advanceRet = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->next(c); });
+                if (advanceRet == WT_NOTFOUND) {
+                    position = boost::none;
+                    break;
+                }
+                invariantWTOK(advanceRet);
+                RecordId key;
+                if (hasWrongPrefix(c, &key)) {
+                    position = boost::none;
+                    break;
+                }
+                position = key.isValid() ? key : getKey(c);
+            }
+
+            if (position && *position == id) {
+                WT_ITEM value;
+                invariantWTOK(c->get_value(c, &value));
+                records[i] = Record{
+                    id, {static_cast<const char*>(value.data), static_cast<int>(value.size)}};
+            }
+        }
+
+        if (records[i]) {
+            records[i]->data.makeOwned();
+        }
+    }
+
+    // As after seekExact(), a call to next() continues from the Record the cursor is on.
+    _skipNextAdvance = false;
+    _eof = !position;
+    if (position) {
+        _lastReturnedId = *position;
+    }
+    return records;
+}
+
+void WiredTigerRecordStoreCursorBase::scheduleReadAhead(const RecordId& id) {
+    // Short scans don't wait on enough reads for it to be worth reading ahead of them.
+    const int64_t kMinRecordsBeforeReadAhead = 128;
+
+    const int window = gWiredTigerCursorReadAheadRecords.load();
+    auto readAhead = _rs._kvEngine ? _rs._kvEngine->getReadAhead() : nullptr;
+    if (window <= 0 || !readAhead || !supportsReadAhead() ||
+        ++_numReturnedSinceSeek < kMinRecordsBeforeReadAhead) {
+        return;
+    }
+
+    --_readAheadLead;
+    if (_readAheadLead >= window / 2 ||
+        (_readAheadProgress && _readAheadProgress->running.load())) {
+        return;
+    }
+
+    int64_t startId = id.repr();
+    int numRecords = window;
+    if (_readAheadProgress && _readAheadLead > 0) {
+        // The last scan is still ahead of us, so continue from where it stopped.
+        if (_readAheadProgress->reachedEnd.load()) {
+            return;
+        }
+        startId = _readAheadProgress->lastId.load();
+        numRecords = window - _readAheadLead;
+    }
+
+    auto progress = std::make_shared<WiredTigerReadAhead::ScanProgress>();
+    if (readAhead->scheduleScan(_rs._uri, startId, _forward, numRecords, progress)) {
+        _readAheadProgress = std::move(progress);
+        _readAheadLead = window;
+    }
+}
 
 void WiredTigerRecordStoreCursorBase::save() {
     try {
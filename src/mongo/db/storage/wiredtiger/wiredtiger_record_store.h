@@ -40,6 +40,7 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_read_ahead.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/platform/atomic_word.h"
@@ -114,6 +115,7 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        bool isClustered = false;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -133,6 +135,10 @@ public:
 
     virtual bool isCapped() const;
 
+    bool isClustered() const final {
+        return _isClustered;
+    }
+
     virtual int64_t storageSize(OperationContext* opCtx,
                                 BSONObjBuilder* extraInfo = nullptr,
                                 int infoLevel = 0) const;
@@ -167,6 +173,9 @@ public:
 
     std::unique_ptr<RecordCursor> getRandomCursor(OperationContext* opCtx) const final;
 
+    std::unique_ptr<RecordCursor> getRandomCursorForSampleSize(OperationContext* opCtx,
+                                                               long long numSamples) const final;
+
     virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
         OperationContext* opCtx, StringData extraConfig) const = 0;
 
@@ -351,6 +360,8 @@ private:
     const bool _isLogged;
     // True if the namespace of this record store starts with "local.oplog.", and false otherwise.
     const bool _isOplog;
+    // True if the records are keyed by the _id of their documents.
+    const bool _isClustered;
     int64_t _cappedMaxSize;
     const int64_t _cappedMaxSizeSlack;  // when to start applying backpressure
     const int64_t _cappedMaxDocs;
@@ -440,6 +451,12 @@ public:
 
     boost::optional<Record> seekExact(const RecordId& id);
 
+    /**
+     * Steps the WT_CURSOR forward to the next id when it is only a few Records ahead of the last
+     * one found, rather than searching for it from the root of the tree.
+     */
+    std::vector<boost::optional<Record>> multiGet(const std::vector<RecordId>& ids);
+
     void save();
 
     void saveUnpositioned();
@@ -469,6 +486,13 @@ protected:
      */
     virtual void initCursorToBeginning() = 0;
 
+    /**
+     * Whether background threads can read the Records after the ones this cursor returns.
+     */
+    virtual bool supportsReadAhead() const {
+        return false;
+    }
+
     const WiredTigerRecordStore& _rs;
     OperationContext* _opCtx;
     const bool _forward;
@@ -481,6 +505,17 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Keeps a scan of the Records after 'id', the Record about to be returned by next(), running
+     * in the background once this cursor has returned enough Records since it was positioned.
+     */
+    void scheduleReadAhead(const RecordId& id);
+
+    std::shared_ptr<WiredTigerReadAhead::ScanProgress> _readAheadProgress;
+    // How many Records the last scan read ahead of this cursor, less the ones it has returned.
+    int _readAheadLead = 0;
+    int64_t _numReturnedSinceSeek = 0;
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
@@ -510,6 +545,10 @@ protected:
     virtual bool hasWrongPrefix(WT_CURSOR* cursor, RecordId* id) const override;
 
     virtual void initCursorToBeginning(){};
+
+    bool supportsReadAhead() const override {
+        return true;
+    }
 };
 
 class WiredTigerRecordStorePrefixedCursor final : public WiredTigerRecordStoreCursorBase {
@@ -65,13 +65,13 @@ public:
 
     void awaitHasExcessStonesOrDead();
 
-    void getOplogStonesStats(BSONObjBuilder& builder) const {
-        builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
-        if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
-            builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
-        }
-    }
+    void getOplogStonesStats(BSONObjBuilder& builder) const;
+
+    /**
+     * Delays the next truncation of the oplog until 'date', once the reclaim thread waits for
+     * excess stones again.
+     */
+    void delayNextTruncation(Date_t date);
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
 
@@ -149,6 +149,12 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<int64_t> _totalTimeThrottled;   // Amount of time the reclaim thread waited to
+                                               // pace the truncation of the oplog.
+
+    // The earliest time at which the reclaim thread may truncate the oplog again. Protected by
+    // '_oplogReclaimMutex'.
+    Date_t _nextTruncationDate;
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
@@ -176,7 +176,8 @@ void WiredTigerRecoveryUnit::_commit() {
     // be boost::none and we'll set the commit time to that.
     auto commitTime = _commitTimestamp.isNull() ? _lastTimestampSet : _commitTimestamp;
 
-    bool notifyDone = !_prepareTimestamp.isNull();
+    const auto prepareTimestamp = _prepareTimestamp;
+    bool notifyDone = !prepareTimestamp.isNull();
     if (_session && _isActive()) {
         _txnClose(true);
     }
@@ -187,7 +188,7 @@ void WiredTigerRecoveryUnit::_commit() {
     }
 
     if (notifyDone) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(prepareTimestamp);
     }
 
     commitRegisteredChanges(commitTime);
@@ -195,14 +196,15 @@ void WiredTigerRecoveryUnit::_commit() {
 }
 
 void WiredTigerRecoveryUnit::_abort() {
-    bool notifyDone = !_prepareTimestamp.isNull();
+    const auto prepareTimestamp = _prepareTimestamp;
+    bool notifyDone = !prepareTimestamp.isNull();
     if (_session && _isActive()) {
         _txnClose(false);
     }
     _setState(State::kAborting);
 
     if (notifyDone || MONGO_unlikely(WTAlwaysNotifyPrepareConflictWaiters.shouldFail())) {
-        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted();
+        _sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(prepareTimestamp);
     }
 
     abortRegisteredChanges();
@@ -673,6 +675,11 @@ Timestamp WiredTigerRecoveryUnit::_beginTransactionAtNoOverlapTimestamp(WT_SESSI
     return readTimestamp;
 }
 
+Timestamp WiredTigerRecoveryUnit::getActiveTxnReadTimestamp() {
+    assertInActiveTxn();
+    return _getTransactionReadTimestamp(_session->getSession());
+}
+
 Timestamp WiredTigerRecoveryUnit::_getTransactionReadTimestamp(WT_SESSION* session) {
     char buf[(2 * 8 /*bytes in hex*/) + 1 /*nul terminator*/];
     auto wtstatus = session->query_timestamp(session, buf, "get=read");
@@ -200,6 +200,12 @@ public:
     }
     void assertInActiveTxn() const;
 
+    /**
+     * Returns the read timestamp of the active WT txn, or a null timestamp if it reads without
+     * one.
+     */
+    Timestamp getActiveTxnReadTimestamp();
+
     boost::optional<int64_t> getOplogVisibilityTs();
 
     static WiredTigerRecoveryUnit* get(OperationContext* opCtx) {
@@ -33,9 +33,16 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 #include "mongo/base/error_codes.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
 #include "mongo/db/repl/repl_settings.h"
@@ -44,7 +51,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/bits.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -118,9 +127,11 @@ WT_CURSOR* WiredTigerSession::getCachedCursor(const std::string& uri, uint64_t i
             WT_CURSOR* c = i->_cursor;
             _cursors.erase(i);
             _cursorsOut++;
+            _cursorCacheHits++;
             return c;
         }
     }
+    _cursorCacheMisses++;
     return nullptr;
 }
 
@@ -173,6 +184,16 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
     }
 }
 
+void WiredTigerSession::closeColdCursors(size_t numToKeep) {
+    invariant(_session);
+
+    while (_cursors.size() > numToKeep) {
+        WT_CURSOR* cursor = _cursors.back()._cursor;
+        _cursors.pop_back();
+        invariantWTOK(cursor->close(cursor));
+    }
+}
+
 void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
     invariant(_session);
 
@@ -197,19 +218,44 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+
+// The most pools of idle sessions, however many CPUs there are.
+const size_t kMaxPartitions = 64;
+
+// How many of the most recently released sessions of its partition getSession() looks through for
+// the one its thread released last.
+const size_t kMaxLastReleasedSearch = 16;
+
+struct LastReleasedSession {
+    const WiredTigerSessionCache* cache = nullptr;
+    const WiredTigerSession* session = nullptr;
+};
+
+// The session this thread last returned to a cache.
+thread_local LastReleasedSession lastReleasedSession;
+
+size_t numPartitions() {
+    return std::clamp<size_t>(ProcessInfo::getNumAvailableCores(), 1, kMaxPartitions);
+}
+
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
     : _engine(engine),
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _numPartitions(numPartitions()),
+      _partitions(new CacheAligned<Partition>[_numPartitions]) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
     : _engine(nullptr),
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _numPartitions(numPartitions()),
+      _partitions(new CacheAligned<Partition>[_numPartitions]) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -322,6 +368,7 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         token = journalListener->getToken(opCtx);
     }
 
+    _waitersSinceLastSync.fetchAndAdd(1);
     uint32_t start = _lastSyncTime.load();
     // Do the remainder in a critical section that ensures only a single thread at a time
     // will attempt to synchronize.
@@ -331,8 +378,21 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
         // Someone else synced already since we read lastSyncTime, so we're done!
         return;
     }
+
+    // When others shared the last sync, give the writers about to wait a chance to share this one
+    // too. They read lastSyncTime before we bump it, so they return once we are done.
+    const auto groupCommitWindow = gWiredTigerJournalGroupCommitWindowMicros.load();
+    if (groupCommitWindow > 0 && _lastSyncBatchSize.load() > 1) {
+        sleepmicros(groupCommitWindow);
+    }
     _lastSyncTime.store(current + 1);
 
+    // A waiter may have been counted by the last sync, which it came too late to share.
+    const auto batchSize = std::max(_waitersSinceLastSync.swap(0), 1ULL);
+    _lastSyncBatchSize.store(batchSize);
+    _syncBatchSizes[std::min(kNumSyncBatchSizeBuckets - 1, 63 - countLeadingZeros64(batchSize))]
+        .fetchAndAdd(1);
+
     // Nobody has synched yet, so we have to sync ourselves.
 
     // Initialize on first use.
@@ -355,28 +415,54 @@ void WiredTigerSessionCache::waitUntilDurable(OperationContext* opCtx,
     }
 }
 
-void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx,
-                                                                        std::uint64_t lastCount) {
+void WiredTigerSessionCache::registerPrepareConflictWaiter(PrepareConflictWaiter* waiter) {
+    stdx::lock_guard<Latch> lk(_prepareCommittedOrAbortedMutex);
+    waiter->pos = _prepareConflictWaiters.emplace(waiter->readTimestamp, waiter);
+}
+
+void WiredTigerSessionCache::unregisterPrepareConflictWaiter(PrepareConflictWaiter* waiter) {
+    stdx::lock_guard<Latch> lk(_prepareCommittedOrAbortedMutex);
+    _prepareConflictWaiters.erase(waiter->pos);
+}
+
+void WiredTigerSessionCache::waitUntilPreparedUnitOfWorkCommitsOrAborts(
+    OperationContext* opCtx, PrepareConflictWaiter* waiter) {
     invariant(opCtx);
     stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    if (lastCount == _prepareCommitOrAbortCounter.loadRelaxed()) {
-        opCtx->waitForConditionOrInterrupt(_prepareCommittedOrAbortedCond, lk, [&] {
-            return _prepareCommitOrAbortCounter.loadRelaxed() > lastCount;
-        });
-    }
+    opCtx->waitForConditionOrInterrupt(waiter->cond, lk, [&] { return waiter->notified; });
+    waiter->notified = false;
 }
 
-void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
-    stdx::unique_lock<Latch> lk(_prepareCommittedOrAbortedMutex);
-    _prepareCommitOrAbortCounter.fetchAndAdd(1);
-    _prepareCommittedOrAbortedCond.notify_all();
+void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted(
+    Timestamp prepareTimestamp) {
+    auto notify = [](auto begin, auto end) {
+        for (auto it = begin; it != end; ++it) {
+            if (!it->second->notified) {
+                it->second->notified = true;
+                it->second->cond.notify_one();
+            }
+        }
+    };
+
+    stdx::lock_guard<Latch> lk(_prepareCommittedOrAbortedMutex);
+    if (prepareTimestamp.isNull()) {
+        notify(_prepareConflictWaiters.begin(), _prepareConflictWaiters.end());
+        return;
+    }
+
+    // The readers without a timestamp, and those reading at or after the prepare timestamp.
+    notify(_prepareConflictWaiters.begin(), _prepareConflictWaiters.upper_bound(Timestamp()));
+    notify(_prepareConflictWaiters.lower_bound(prepareTimestamp), _prepareConflictWaiters.end());
 }
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto&& session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -384,15 +470,60 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto&& session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        count += partition.sessions.size();
+    }
+    return count;
+}
+
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) {
+    uint64_t idle = 0, reused = 0, reusedByThread = 0, opened = 0, hits = 0, misses = 0;
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        idle += partition.sessions.size();
+        reused += partition.sessionsReused;
+        reusedByThread += partition.sessionsReusedByThread;
+        opened += partition.sessionsOpened;
+        hits += partition.cursorCacheHits;
+        misses += partition.cursorCacheMisses;
+    }
+
+    BSONObjBuilder bob(builder->subobjStart("session cache"));
+    bob.append("idle sessions", static_cast<long long>(idle));
+    bob.append("sessions reused", static_cast<long long>(reused));
+    bob.append("sessions reused by the thread which released them",
+               static_cast<long long>(reusedByThread));
+    bob.append("sessions opened", static_cast<long long>(opened));
+    bob.append("cached cursor hits", static_cast<long long>(hits));
+    bob.append("cached cursor misses", static_cast<long long>(misses));
+    bob.done();
+
+    // The number of journal syncs shared by 1, 2-3, 4-7, ... waiters.
+    BSONObjBuilder syncs(builder->subobjStart("journal sync batch sizes"));
+    for (int i = 0; i < kNumSyncBatchSizeBuckets; ++i) {
+        const auto low = 1ULL << i;
+        std::string name = std::to_string(low);
+        if (i == kNumSyncBatchSizeBuckets - 1) {
+            name += "+";
+        } else if (low > 1) {
+            name += "-" + std::to_string(2 * low - 1);
+        }
+        syncs.append(name, _syncBatchSizes[i].load());
+    }
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -402,14 +533,15 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[p];
+        stdx::lock_guard<Latch> lock(partition.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 delete (session);
             } else {
                 ++it;
@@ -419,18 +551,32 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+    // Increment the epoch as we are now closing all sessions with this epoch. A session released
+    // concurrently either sees the new epoch under its partition's lock, or is swapped out below.
+    _epoch.fetchAndAdd(1);
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        SessionCache swap;
+        {
+            auto& partition = _partitions[p];
+            stdx::lock_guard<Latch> lock(partition.lock);
+            partition.sessions.swap(swap);
+        }
+
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
     }
+}
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+size_t WiredTigerSessionCache::_localPartition() const {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return cpu % _numPartitions;
     }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % _numPartitions;
 }
 
 bool WiredTigerSessionCache::isEphemeral() {
@@ -442,19 +588,47 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in the partition of our CPU first, then take a session from another one rather than
+    // open a new session while there are idle ones.
+    const size_t local = _localPartition();
+    for (size_t p = 0; p < _numPartitions; ++p) {
+        auto& partition = _partitions[(local + p) % _numPartitions];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            auto it = std::prev(partition.sessions.end());
+
+            // Prefer the session this thread released last, whose cached cursors are likely to be
+            // on the collections this thread's client uses. Its pointer is only compared, as the
+            // session may have been taken and closed since.
+            if (p == 0 && lastReleasedSession.cache == this) {
+                const auto searchFrom = partition.sessions.size() > kMaxLastReleasedSearch
+                    ? partition.sessions.end() - kMaxLastReleasedSearch
+                    : partition.sessions.begin();
+                auto found =
+                    std::find(searchFrom, partition.sessions.end(), lastReleasedSession.session);
+                if (found != partition.sessions.end()) {
+                    it = found;
+                    partition.sessionsReusedByThread++;
+                }
+            }
+
+            WiredTigerSession* cachedSession = *it;
+            partition.sessions.erase(it);
+            partition.sessionsReused++;
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
         }
     }
 
+    {
+        auto& partition = _partitions[local];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        partition.sessionsOpened++;
+    }
+
     // Outside of the cache partition lock, but on release will be put back on the cache
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
@@ -487,10 +661,10 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         invariant(range == 0);
 
         // Release resources in the session we're about to cache.
-        // If we are using hybrid caching, then close cursors now and let them
-        // be cached at the WiredTiger level.
+        // If we are using hybrid caching, then close all but the most recently used cursors now
+        // and let them be cached at the WiredTiger level.
         if (gWiredTigerCursorCacheSize.load() < 0) {
-            session->closeAllCursors("");
+            session->closeColdCursors(gWiredTigerIdleSessionCursors.load());
         }
         invariantWTOK(ss->reset(ss));
     }
@@ -510,10 +684,14 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_localPartition()];
+        stdx::lock_guard<Latch> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
+            partition.cursorCacheHits += std::exchange(session->_cursorCacheHits, 0);
+            partition.cursorCacheMisses += std::exchange(session->_cursorCacheMisses, 0);
+            lastReleasedSession = {this, session};
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
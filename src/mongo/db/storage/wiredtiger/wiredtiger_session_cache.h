@@ -29,19 +29,25 @@
 
 #pragma once
 
+#include <array>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 
 #include <wiredtiger.h>
 
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
+#include "mongo/bson/timestamp.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/spin_lock.h"
+#include "mongo/util/with_alignment.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
@@ -137,6 +143,11 @@ public:
      */
     void closeAllCursors(const std::string& uri);
 
+    /**
+     * Closes all cached cursors but the 'numToKeep' most recently released ones.
+     */
+    void closeColdCursors(size_t numToKeep);
+
     int cursorsOut() const {
         return _cursorsOut;
     }
@@ -201,6 +212,10 @@ private:
     int _cursorsOut;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
+
+    // How often getCachedCursor() found a cursor since the session was last released.
+    uint64_t _cursorCacheHits = 0;
+    uint64_t _cursorCacheMisses = 0;
 };
 
 /**
@@ -259,6 +274,12 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Appends how often sessions and their cached cursors were reused, and how many callers of
+     * waitUntilDurable() shared each journal sync.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
@@ -320,24 +341,50 @@ public:
     void waitUntilDurable(OperationContext* opCtx, Fsync syncType, UseJournalListener useListener);
 
     /**
-     * Waits until a prepared unit of work has ended (either been commited or aborted). This
-     * should be used when encountering WT_PREPARE_CONFLICT errors. The caller is required to retry
-     * the conflicting WiredTiger API operation. A return from this function does not guarantee that
-     * the conflicting transaction has ended, only that one prepared unit of work in the process has
-     * signaled that it has ended.
+     * A reader which hit a WT_PREPARE_CONFLICT error, reading at 'readTimestamp', or without a
+     * timestamp if it is null. A prepared unit of work can only conflict with the readers at or
+     * after its prepare timestamp, or without a timestamp, so only its ending wakes them.
+     */
+    struct PrepareConflictWaiter {
+        explicit PrepareConflictWaiter(Timestamp readTimestamp) : readTimestamp(readTimestamp) {}
+
+        const Timestamp readTimestamp;
+        bool notified = false;
+        stdx::condition_variable cond;
+        std::multimap<Timestamp, PrepareConflictWaiter*>::iterator pos;
+    };
+
+    /**
+     * Registers 'waiter' to be notified when a prepared unit of work it can conflict with ends.
+     * The waiter must be registered before the conflicting WiredTiger API operation is retried, so
+     * that it is notified of the units of work ending during the retry, and unregistered before it
+     * is destroyed.
+     */
+    void registerPrepareConflictWaiter(PrepareConflictWaiter* waiter);
+    void unregisterPrepareConflictWaiter(PrepareConflictWaiter* waiter);
+
+    /**
+     * Waits until 'waiter' is notified that a prepared unit of work it can conflict with has ended
+     * (either been commited or aborted) since it last waited. This should be used when
+     * encountering WT_PREPARE_CONFLICT errors. The caller is required to retry the conflicting
+     * WiredTiger API operation. A return from this function does not guarantee that the
+     * conflicting transaction has ended, only that one prepared unit of work which may have been
+     * the conflicting one has signaled that it has ended.
      * Accepts an OperationContext that will throw an AssertionException when interrupted.
      *
      * This method is provided in WiredTigerSessionCache and not RecoveryUnit because all recovery
-     * units share the same session cache, and we want a recovery unit on one thread to signal all
+     * units share the same session cache, and we want a recovery unit on one thread to signal the
      * recovery units waiting for prepare conflicts across all other threads.
      */
-    void waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx, uint64_t lastCount);
+    void waitUntilPreparedUnitOfWorkCommitsOrAborts(OperationContext* opCtx,
+                                                    PrepareConflictWaiter* waiter);
 
     /**
-     * Notifies waiters that the caller's perpared unit of work has ended (either committed or
-     * aborted).
+     * Notifies the waiters which can conflict with the caller's prepared unit of work, prepared at
+     * 'prepareTimestamp', that it has ended (either committed or aborted). A null
+     * 'prepareTimestamp' notifies all waiters.
      */
-    void notifyPreparedUnitOfWorkHasCommittedOrAborted();
+    void notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp prepareTimestamp);
 
     WT_CONNECTION* conn() const {
         return _conn;
@@ -360,10 +407,6 @@ public:
         return _engine;
     }
 
-    std::uint64_t getPrepareCommitOrAbortCount() const {
-        return _prepareCommitOrAbortCounter.loadRelaxed();
-    }
-
 private:
     WiredTigerKVEngine* _engine;      // not owned, might be NULL
     WT_CONNECTION* _conn;             // not owned
@@ -376,9 +419,31 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    /**
+     * The idle sessions are kept in pools, one per CPU up to a limit, so that threads running on
+     * different CPUs don't contend on the same mutex to get and release them.
+     */
+    struct Partition {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::Partition::lock");
+        SessionCache sessions;
+
+        // The statistics of the sessions taken from and released into this partition.
+        uint64_t sessionsReused = 0;
+        uint64_t sessionsReusedByThread = 0;
+        uint64_t sessionsOpened = 0;
+        uint64_t cursorCacheHits = 0;
+        uint64_t cursorCacheMisses = 0;
+    };
+
+    /**
+     * Returns the index of the partition of the CPU the calling thread runs on.
+     */
+    size_t _localPartition() const;
+
+    const size_t _numPartitions;
+    std::unique_ptr<CacheAligned<Partition>[]> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -390,11 +455,17 @@ private:
     AtomicWord<unsigned> _lastSyncTime;
     Mutex _lastSyncMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_lastSyncMutex");
 
-    // Mutex and cond var for waiting on prepare commit or abort.
+    // The callers of waitUntilDurable which started waiting since the last journal sync, and how
+    // many shared each journal sync, bucketed by powers of two.
+    AtomicWord<unsigned long long> _waitersSinceLastSync{0};
+    AtomicWord<unsigned long long> _lastSyncBatchSize{0};
+    static constexpr int kNumSyncBatchSizeBuckets = 8;
+    std::array<AtomicWord<long long>, kNumSyncBatchSizeBuckets> _syncBatchSizes;
+
+    // Mutex and waiters, by read timestamp, for waiting on prepare commit or abort.
     Mutex _prepareCommittedOrAbortedMutex =
         MONGO_MAKE_LATCH("WiredTigerSessionCache::_prepareCommittedOrAbortedMutex");
-    stdx::condition_variable _prepareCommittedOrAbortedCond;
-    AtomicWord<std::uint64_t> _prepareCommitOrAbortCounter{0};
+    std::multimap<Timestamp, PrepareConflictWaiter*> _prepareConflictWaiters;
 
     // Protects getting and setting the _journalListener below.
     Mutex _journalListenerMutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::_journalListenerMutex");
@@ -31,12 +31,18 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/barrier.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -113,4 +119,124 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ReusesIdleSessionsReleasedFromAnyThread) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const size_t kNumSessions = 10;
+
+    // Sessions released by other threads, and so maybe into the pools of other CPUs, are taken
+    // rather than new ones opened.
+    std::vector<stdx::thread> threads;
+    unittest::Barrier barrier(kNumSessions);
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        threads.emplace_back([&] {
+            UniqueWiredTigerSession session = sessionCache->getSession();
+            barrier.countDownAndWait();
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), kNumSessions);
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        sessions.push_back(sessionCache->getSession());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    sessions.clear();
+
+    threads.clear();
+    for (size_t i = 0; i < kNumSessions; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 1000; ++j) {
+                UniqueWiredTigerSession session = sessionCache->getSession();
+            }
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT_GTE(sessionCache->getIdleSessionsCount(), kNumSessions);
+
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, IdleSessionsKeepTheirMostRecentlyUsedCursors) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::vector<std::string> uris = {"table:a", "table:b", "table:c"};
+
+    WiredTigerSession* released;
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* s = session->getSession();
+        for (size_t i = 0; i < uris.size(); ++i) {
+            ASSERT_OK(wtRCToStatus(s->create(s, uris[i].c_str(), "key_format=q,value_format=u")));
+            ASSERT(!session->getCachedCursor(uris[i], i));
+            session->releaseCursor(i, session->getNewCursor(uris[i]));
+        }
+        released = session.get();
+    }
+
+    // With hybrid caching, only the two most recently released cursors stay open.
+    gWiredTigerIdleSessionCursors.store(2);
+    ON_BLOCK_EXIT([] { gWiredTigerIdleSessionCursors.store(4); });
+    ASSERT_LT(gWiredTigerCursorCacheSize.load(), 0);
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(session.get(), released);
+        ASSERT_EQUALS(session->cachedCursors(), 3);
+    }
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(session->cachedCursors(), 2);
+        ASSERT(!session->getCachedCursor(uris[0], 0));
+        WT_CURSOR* cursor = session->getCachedCursor(uris[2], 2);
+        ASSERT(cursor);
+        session->releaseCursor(2, cursor);
+    }
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    auto stats = builder.obj()["session cache"].Obj();
+    ASSERT_EQUALS(stats["sessions opened"].numberLong(), 1);
+    ASSERT_EQUALS(stats["sessions reused"].numberLong(), 2);
+    ASSERT_EQUALS(stats["cached cursor hits"].numberLong(), 1);
+    ASSERT_EQUALS(stats["cached cursor misses"].numberLong(), 4);
+}
+
+TEST(WiredTigerSessionCacheTest, PreparedUnitOfWorkOnlyNotifiesReadersItCanConflictWith) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    WiredTigerSessionCache::PrepareConflictWaiter noTimestamp(Timestamp{});
+    WiredTigerSessionCache::PrepareConflictWaiter olderReader(Timestamp(10, 1));
+    WiredTigerSessionCache::PrepareConflictWaiter sameReader(Timestamp(15, 1));
+    WiredTigerSessionCache::PrepareConflictWaiter newerReader(Timestamp(20, 1));
+    std::vector<WiredTigerSessionCache::PrepareConflictWaiter*> waiters{
+        &noTimestamp, &olderReader, &sameReader, &newerReader};
+    for (auto waiter : waiters) {
+        sessionCache->registerPrepareConflictWaiter(waiter);
+    }
+    ON_BLOCK_EXIT([&] {
+        for (auto waiter : waiters) {
+            sessionCache->unregisterPrepareConflictWaiter(waiter);
+        }
+    });
+
+    // A reader before the prepare timestamp cannot have conflicted with the unit of work.
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp(15, 1));
+    ASSERT(noTimestamp.notified);
+    ASSERT_FALSE(olderReader.notified);
+    ASSERT(sameReader.notified);
+    ASSERT(newerReader.notified);
+
+    // Without a prepare timestamp, all readers are notified.
+    sessionCache->notifyPreparedUnitOfWorkHasCommittedOrAborted(Timestamp{});
+    for (auto waiter : waiters) {
+        ASSERT(waiter->notified);
+    }
+}
+
 }  // namespace mongo
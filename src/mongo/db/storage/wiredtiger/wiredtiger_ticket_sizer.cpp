@@ -0,0 +1,84 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
+
+#include <algorithm>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+constexpr double WiredTigerTicketSizer::kCacheDirtyLimit;
+constexpr double WiredTigerTicketSizer::kCacheUsedLimit;
+constexpr double WiredTigerTicketSizer::kThroughputTolerance;
+constexpr double WiredTigerTicketSizer::kDecreaseFactor;
+
+WiredTigerTicketSizer::WiredTigerTicketSizer(int minTickets, int maxTickets)
+    : _minTickets(minTickets), _maxTickets(maxTickets) {
+    invariant(_minTickets > 0);
+    invariant(_minTickets <= _maxTickets);
+}
+
+int WiredTigerTicketSizer::nextSize(int currentSize, const Sample& sample) {
+    const double lastThroughput = _lastThroughput;
+    const bool lastStepWasIncrease = _lastStepWasIncrease;
+    _lastThroughput = sample.throughput;
+    _lastStepWasIncrease = false;
+
+    auto decrease = [&] { return _clamp(static_cast<int>(currentSize * kDecreaseFactor)); };
+
+    if (sample.cacheDirtyFraction > kCacheDirtyLimit ||
+        sample.cacheUsedFraction > kCacheUsedLimit) {
+        return decrease();
+    }
+
+    if (lastStepWasIncrease && sample.throughput < lastThroughput * (1 - kThroughputTolerance)) {
+        // The extra tickets cost more in contention than they gained in concurrency.
+        return decrease();
+    }
+
+    if (sample.queued == 0) {
+        // The pool is not the bottleneck, so there is nothing to learn from growing it.
+        return _clamp(currentSize);
+    }
+
+    // Grow by a fraction of the pool so that large pools converge as quickly as small ones.
+    const int next = _clamp(currentSize + std::max(1, currentSize / 16));
+    _lastStepWasIncrease = next > currentSize;
+    return next;
+}
+
+int WiredTigerTicketSizer::_clamp(int size) const {
+    return std::max(_minTickets, std::min(_maxTickets, size));
+}
+
+}  // namespace mongo
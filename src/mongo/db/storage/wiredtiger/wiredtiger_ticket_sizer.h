@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+namespace mongo {
+
+/**
+ * Chooses the number of tickets of a TicketHolder from periodic samples of its throughput, in the
+ * style of TCP congestion control. While operations are queued for tickets the pool grows
+ * additively for as long as each step raises the throughput. It shrinks multiplicatively when a
+ * step lowered the throughput, or when the WiredTiger cache is under pressure and more concurrent
+ * transactions would only make eviction fall further behind.
+ */
+class WiredTigerTicketSizer {
+public:
+    struct Sample {
+        // Tickets acquired per second since the previous sample.
+        double throughput = 0;
+        // Operations queued for a ticket when the sample was taken.
+        int queued = 0;
+        // Dirty and total bytes in the cache, as fractions of the configured cache size.
+        double cacheDirtyFraction = 0;
+        double cacheUsedFraction = 0;
+    };
+
+    // Cache usage above which more tickets are not handed out. These are WiredTiger's default
+    // eviction_dirty_trigger and eviction_trigger, at which application threads start evicting.
+    static constexpr double kCacheDirtyLimit = 0.20;
+    static constexpr double kCacheUsedLimit = 0.95;
+
+    // A step is kept when the throughput it led to is within this fraction of the previous one.
+    static constexpr double kThroughputTolerance = 0.02;
+
+    static constexpr double kDecreaseFactor = 0.75;
+
+    WiredTigerTicketSizer(int minTickets, int maxTickets);
+
+    /**
+     * Returns the size for a pool which has 'currentSize' tickets and performed as in 'sample'
+     * since the last call.
+     */
+    int nextSize(int currentSize, const Sample& sample);
+
+private:
+    int _clamp(int size) const;
+
+    const int _minTickets;
+    const int _maxTickets;
+
+    // The throughput of the previous sample, and whether the pool grew after it.
+    double _lastThroughput = 0;
+    bool _lastStepWasIncrease = false;
+};
+
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_ticket_sizer.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+WiredTigerTicketSizer::Sample makeSample(double throughput, int queued) {
+    WiredTigerTicketSizer::Sample sample;
+    sample.throughput = throughput;
+    sample.queued = queued;
+    return sample;
+}
+
+TEST(WiredTigerTicketSizerTest, GrowsWhileQueuedAndThroughputRises) {
+    WiredTigerTicketSizer sizer(8, 256);
+    ASSERT_EQ(sizer.nextSize(128, makeSample(1000, 10)), 136);
+    ASSERT_EQ(sizer.nextSize(136, makeSample(1100, 10)), 144);
+    // A throughput within the tolerance keeps growing.
+    ASSERT_EQ(sizer.nextSize(144, makeSample(1090, 10)), 153);
+}
+
+TEST(WiredTigerTicketSizerTest, ShrinksWhenGrowingLoweredThroughput) {
+    WiredTigerTicketSizer sizer(8, 256);
+    ASSERT_EQ(sizer.nextSize(128, makeSample(1000, 10)), 136);
+    ASSERT_EQ(sizer.nextSize(136, makeSample(800, 10)), 102);
+    // After a decrease, a lower throughput is not blamed on the previous step.
+    ASSERT_EQ(sizer.nextSize(102, makeSample(700, 10)), 108);
+}
+
+TEST(WiredTigerTicketSizerTest, HoldsWhenNothingIsQueued) {
+    WiredTigerTicketSizer sizer(8, 256);
+    ASSERT_EQ(sizer.nextSize(128, makeSample(1000, 0)), 128);
+    ASSERT_EQ(sizer.nextSize(128, makeSample(10, 0)), 128);
+}
+
+TEST(WiredTigerTicketSizerTest, ShrinksUnderCachePressure) {
+    WiredTigerTicketSizer sizer(8, 256);
+    auto dirty = makeSample(1000, 10);
+    dirty.cacheDirtyFraction = 0.25;
+    ASSERT_EQ(sizer.nextSize(128, dirty), 96);
+
+    auto full = makeSample(1000, 10);
+    full.cacheUsedFraction = 0.97;
+    ASSERT_EQ(sizer.nextSize(96, full), 72);
+}
+
+TEST(WiredTigerTicketSizerTest, StaysWithinLimits) {
+    WiredTigerTicketSizer sizer(8, 130);
+    ASSERT_EQ(sizer.nextSize(128, makeSample(1000, 10)), 130);
+    ASSERT_EQ(sizer.nextSize(130, makeSample(2000, 10)), 130);
+
+    auto dirty = makeSample(1000, 10);
+    dirty.cacheDirtyFraction = 0.5;
+    ASSERT_EQ(sizer.nextSize(9, dirty), 8);
+    // Sizes set outside of the limits are brought back within them.
+    ASSERT_EQ(sizer.nextSize(500, makeSample(1000, 0)), 130);
+}
+
+}  // namespace
+}  // namespace mongo
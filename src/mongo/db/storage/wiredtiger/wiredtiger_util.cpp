@@ -922,6 +922,18 @@ void WiredTigerUtil::appendSnapshotWindowSettings(WiredTigerKVEngine* engine,
                     stableTimestamp.toStringPretty());
     settings.append("oldest majority snapshot timestamp available",
                     oldestTimestamp.toStringPretty());
+    settings.append("snapshot history pinned only for active readers",
+                    pinSnapshotHistoryOnlyForActiveReaders.load());
+    settings.append("oldest active snapshot reader timestamp",
+                    engine->getOldestOpenReadTimestamp().toStringPretty());
+
+    // Report the history store size next to the window it keeps history for.
+    auto hsSize = getStatisticsValue(
+        session->getSession(), "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_HS_ONDISK);
+    if (hsSize.isOK()) {
+        settings.append("history store table on-disk size",
+                        static_cast<long long>(hsSize.getValue()));
+    }
 }
 
 }  // namespace mongo
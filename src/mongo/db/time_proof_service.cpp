@@ -31,6 +31,8 @@
 
 #include "mongo/db/time_proof_service.h"
 
+#include <algorithm>
+
 #include "mongo/base/status.h"
 #include "mongo/db/logical_time.h"
 #include "mongo/platform/random.h"
@@ -53,18 +55,25 @@ TimeProofService::Key TimeProofService::generateRandomKey() {
 TimeProofService::TimeProof TimeProofService::getProof(LogicalTime time, const Key& key) {
     stdx::lock_guard<Latch> lk(_cacheMutex);
     auto timeCeil = LogicalTime(Timestamp(time.asTimestamp().asULL() | kRangeMask));
-    if (_cache && _cache->hasProof(timeCeil, key)) {
-        return _cache->_proof;
+    auto it = std::find_if(_cache.begin(), _cache.end(), [&](const CacheEntry& entry) {
+        return entry.hasProof(timeCeil, key);
+    });
+    if (it != _cache.end()) {
+        std::rotate(_cache.begin(), it, it + 1);
+        return _cache.front()._proof;
     }
 
     auto unsignedTimeArray = timeCeil.toUnsignedArray();
-    // update cache
-    _cache =
-        CacheEntry(SHA1Block::computeHmac(
+    // update cache, evicting the least recently used proof
+    if (_cache.size() == kCacheSize) {
+        _cache.pop_back();
+    }
+    _cache.emplace(_cache.begin(),
+                   SHA1Block::computeHmac(
                        key.data(), key.size(), unsignedTimeArray.data(), unsignedTimeArray.size()),
                    timeCeil,
                    key);
-    return _cache->_proof;
+    return _cache.front()._proof;
 }
 
 Status TimeProofService::checkProof(LogicalTime time, const TimeProof& proof, const Key& key) {
@@ -77,9 +86,7 @@ Status TimeProofService::checkProof(LogicalTime time, const TimeProof& proof, co
 
 void TimeProofService::resetCache() {
     stdx::lock_guard<Latch> lk(_cacheMutex);
-    if (_cache) {
-        _cache = boost::none;
-    }
+    _cache.clear();
 }
 
 }  // namespace mongo
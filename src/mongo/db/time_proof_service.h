@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "mongo/base/status.h"
 #include "mongo/crypto/sha1_block.h"
 #include "mongo/db/logical_time.h"
@@ -89,11 +91,16 @@ private:
         Key _key;
     };
 
+    // The number of time ranges for which proofs are cached. Signing the latest cluster time while
+    // validating gossiped cluster times, from other ranges or signed with other keys, then reuses
+    // the proofs of each of them instead of recomputing them in turn.
+    static constexpr size_t kCacheSize = 8;
+
     // protects _cache
     Mutex _cacheMutex = MONGO_MAKE_LATCH("TimeProofService::_cacheMutex");
 
-    // one-entry cache
-    boost::optional<CacheEntry> _cache;
+    // The cached proofs, most recently used first.
+    std::vector<CacheEntry> _cache;
 };
 
 }  // namespace mongo
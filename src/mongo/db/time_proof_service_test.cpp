@@ -82,5 +82,33 @@ TEST(TimeProofService, VerifyLogicalTimeProofCache) {
     ASSERT_EQUALS(ErrorCodes::TimeProofMismatch, timeProofService.checkProof(time3, proof2, key));
 }
 
+TEST(TimeProofService, VerifyLogicalTimeProofCacheHoldsSeveralRangesAndKeys) {
+    TimeProofService timeProofService;
+    const TimeProofService::Key otherKey = {{{1, 2, 3}}};
+
+    // Interleave more ranges than the cache holds, with two keys, so that proofs are both served
+    // from the cache and computed again after being evicted.
+    std::vector<std::pair<LogicalTime, TimeProof>> proofs;
+    for (uint64_t range = 0; range < 20; ++range) {
+        LogicalTime time(Timestamp(0x1111'2222'0000'0001 + (range << 16)));
+        proofs.emplace_back(time, timeProofService.getProof(time, key));
+        ASSERT_NOT_EQUALS(proofs.back().second, timeProofService.getProof(time, otherKey));
+    }
+
+    for (size_t i = 0; i < proofs.size(); ++i) {
+        const auto& [time, proof] = proofs[i];
+        ASSERT_OK(timeProofService.checkProof(time, proof, key));
+        ASSERT_EQUALS(ErrorCodes::TimeProofMismatch,
+                      timeProofService.checkProof(time, proof, otherKey));
+        if (i > 0) {
+            ASSERT_EQUALS(ErrorCodes::TimeProofMismatch,
+                          timeProofService.checkProof(time, proofs[i - 1].second, key));
+        }
+    }
+
+    timeProofService.resetCache();
+    ASSERT_OK(timeProofService.checkProof(proofs.front().first, proofs.front().second, key));
+}
+
 }  // unnamed namespace
 }  // namespace mongo
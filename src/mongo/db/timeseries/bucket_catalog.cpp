@@ -0,0 +1,206 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_catalog.h"
+
+#include <map>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const auto getBucketCatalog = ServiceContext::declareDecoration<BucketCatalog>();
+
+/**
+ * Returns the key of the open bucket of the measurement 'doc' in the buckets collection 'ns', made
+ * of the namespace and the type and value of the metadata of the measurement.
+ */
+std::string makeBucketKey(const NamespaceString& ns,
+                          const TimeseriesOptions& options,
+                          const BSONObj& doc) {
+    std::string key = ns.ns();
+    key.push_back('\0');
+    if (auto metaField = options.getMetaField()) {
+        if (auto metaElem = doc[*metaField]) {
+            key.push_back(static_cast<char>(metaElem.type()));
+            key.append(metaElem.value(), metaElem.valuesize());
+        }
+    }
+    return key;
+}
+
+}  // namespace
+
+BucketCatalog& BucketCatalog::get(ServiceContext* svcCtx) {
+    return getBucketCatalog(svcCtx);
+}
+
+BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+BucketCatalog::Slot BucketCatalog::insert(const NamespaceString& ns,
+                                          const TimeseriesOptions& options,
+                                          const BSONObj& doc) {
+    auto timeElem = doc[options.getTimeField()];
+    uassert(5190411,
+            str::stream() << "'" << options.getTimeField()
+                          << "' must be present and contain a valid BSON UTC datetime value",
+            timeElem.type() == BSONType::Date);
+    const auto time = timeElem.Date();
+    const auto key = makeBucketKey(ns, options, doc);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& bucket = _buckets[key];
+    const bool fits = bucket.id.isSet() && time >= bucket.minTime &&
+        durationCount<Milliseconds>(time - bucket.minTime) / 1000 <
+            options.getBucketMaxSpanSeconds() &&
+        bucket.numMeasurements < gTimeseriesBucketMaxCount.load() &&
+        bucket.size + doc.objsize() <= gTimeseriesBucketMaxSize.load();
+    boost::optional<OID> closedBucketId;
+    if (!fits && bucket.id.isSet()) {
+        auto pending = _pendingWrites.find(bucket.id);
+        invariant(pending != _pendingWrites.end());
+        if (pending->second.numMeasurements == 0) {
+            _pendingWrites.erase(pending);
+            closedBucketId = bucket.id;
+        } else {
+            pending->second.closed = true;
+        }
+    }
+    if (!fits) {
+        // The id of a bucket starts with the time of its first measurement, so that the buckets of
+        // a collection are ordered roughly by time.
+        bucket = Bucket();
+        bucket.id = OID::gen();
+        bucket.id.setTimestamp(durationCount<Seconds>(time.toDurationSinceEpoch()));
+        bucket.minTime = time;
+        _pendingWrites[bucket.id].ns = ns.ns();
+    }
+    bucket.size += doc.objsize();
+    ++_pendingWrites[bucket.id].numMeasurements;
+    return {bucket.id, bucket.numMeasurements++, closedBucketId};
+}
+
+bool BucketCatalog::finish(const OID& bucketId, int numMeasurements) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto pending = _pendingWrites.find(bucketId);
+    if (pending == _pendingWrites.end()) {
+        // The collection was dropped.
+        return false;
+    }
+    pending->second.numMeasurements -= numMeasurements;
+    invariant(pending->second.numMeasurements >= 0);
+    if (!pending->second.closed || pending->second.numMeasurements > 0) {
+        return false;
+    }
+    _pendingWrites.erase(pending);
+    return true;
+}
+
+void BucketCatalog::clear(const NamespaceString& ns) {
+    std::string prefix = ns.ns();
+    prefix.push_back('\0');
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto it = _buckets.begin(); it != _buckets.end();) {
+        if (StringData(it->first).startsWith(prefix)) {
+            _buckets.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = _pendingWrites.begin(); it != _pendingWrites.end();) {
+        if (it->second.ns == ns.ns()) {
+            _pendingWrites.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+BSONObj BucketCatalog::makeBucketUpdate(const TimeseriesOptions& options,
+                                        const std::vector<std::pair<int, BSONObj>>& measurements) {
+    invariant(!measurements.empty());
+    const auto metaField = options.getMetaField();
+
+    BSONObjBuilder set;
+    std::map<StringData, std::pair<BSONElement, BSONElement>> bounds;
+    for (auto&& [index, doc] : measurements) {
+        for (auto&& elem : doc) {
+            const auto field = elem.fieldNameStringData();
+            if (metaField && field == *metaField) {
+                continue;
+            }
+            set.appendAs(elem, str::stream() << "data." << field << "." << index);
+
+            auto [it, inserted] = bounds.emplace(field, std::make_pair(elem, elem));
+            if (!inserted) {
+                auto& [min, max] = it->second;
+                if (elem.woCompare(min, false) < 0) {
+                    min = elem;
+                }
+                if (elem.woCompare(max, false) > 0) {
+                    max = elem;
+                }
+            }
+        }
+    }
+
+    BSONObjBuilder min;
+    BSONObjBuilder max;
+    for (auto&& [field, bound] : bounds) {
+        min.appendAs(bound.first, str::stream() << "control.min." << field);
+        max.appendAs(bound.second, str::stream() << "control.max." << field);
+    }
+
+    BSONObjBuilder setOnInsert;
+    setOnInsert.append("control.version", 1);
+    if (metaField) {
+        if (auto metaElem = measurements.front().second[*metaField]) {
+            setOnInsert.appendAs(metaElem, "meta");
+        }
+    }
+
+    BSONObjBuilder update;
+    update.append("$set", set.obj());
+    update.append("$min", min.obj());
+    update.append("$max", max.obj());
+    update.append("$setOnInsert", setOnInsert.obj());
+    return update.obj();
+}
+
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/oid.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/timeseries/timeseries_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Assigns the measurements inserted into time-series collections to the buckets which store them.
+ *
+ * A bucket holds the measurements of one collection with the same metadata, whose times are within
+ * 'bucketMaxSpanSeconds' of the first of them, up to a maximum count and size. Only the open bucket
+ * of each collection and metadata is tracked, in memory. A bucket is closed, and a new one opened,
+ * when a measurement doesn't fit into it, so a measurement never goes into a bucket the catalog
+ * forgot about, e.g. on restart.
+ *
+ * The catalog only reserves the position of each measurement in its bucket. The measurements are
+ * then written into the bucket by an upsert built with makeBucketUpdate(), so the measurements of
+ * concurrent inserts into the same bucket don't conflict with each other. Once a closed bucket has
+ * no write left to finish, it won't change anymore and its columns can be compressed.
+ */
+class BucketCatalog {
+public:
+    /**
+     * The position reserved for a measurement in a bucket.
+     */
+    struct Slot {
+        OID bucketId;
+        int index;
+
+        // The bucket closed to make room for the measurement, if it has no write left to finish.
+        boost::optional<OID> closedBucketId;
+    };
+
+    static BucketCatalog& get(ServiceContext* svcCtx);
+    static BucketCatalog& get(OperationContext* opCtx);
+
+    /**
+     * Reserves a position for the measurement 'doc' in the open bucket of its metadata in the
+     * buckets collection 'ns', opening a new bucket if it doesn't fit into that one. Throws if the
+     * time field of the measurement isn't a date.
+     */
+    Slot insert(const NamespaceString& ns, const TimeseriesOptions& options, const BSONObj& doc);
+
+    /**
+     * Records that the writes of 'numMeasurements' measurements with positions reserved in the
+     * bucket 'bucketId' finished, whether or not they succeeded. Returns whether the bucket is
+     * closed and has no write left to finish.
+     */
+    bool finish(const OID& bucketId, int numMeasurements);
+
+    /**
+     * Forgets the open buckets of the buckets collection 'ns', e.g. when it is dropped.
+     */
+    void clear(const NamespaceString& ns);
+
+    /**
+     * Returns the update which upserts the measurements with the given positions into their bucket.
+     * All the measurements must have the same metadata. The bucket has the form
+     *
+     *     {_id: <bucketId>,
+     *      control: {version: 1, min: {<field>: <min>, ...}, max: {<field>: <max>, ...}},
+     *      meta: <metadata>,
+     *      data: {<field>: {<position>: <value>, ...}, ...}}
+     *
+     * where the metadata field of the measurements is only stored once, as 'meta'.
+     */
+    static BSONObj makeBucketUpdate(const TimeseriesOptions& options,
+                                    const std::vector<std::pair<int, BSONObj>>& measurements);
+
+private:
+    struct Bucket {
+        OID id;
+        Date_t minTime;
+        int numMeasurements = 0;
+        int size = 0;
+    };
+
+    // The writes which reserved positions in a bucket and haven't finished yet.
+    struct PendingWrites {
+        std::string ns;
+        int numMeasurements = 0;
+        bool closed = false;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("BucketCatalog::_mutex");  // Protects all members.
+
+    // The open buckets, by the buckets collection followed by the metadata of their measurements.
+    stdx::unordered_map<std::string, Bucket> _buckets;
+
+    // The pending writes of the open buckets, and of the closed buckets which still have some.
+    stdx::unordered_map<OID, PendingWrites, OID::Hasher> _pendingWrites;
+};
+
+}  // namespace mongo
@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNs("test.system.buckets.coll");
+
+TimeseriesOptions makeOptions() {
+    TimeseriesOptions options;
+    options.setTimeField("t");
+    options.setMetaField(StringData("m"));
+    options.setBucketMaxSpanSeconds(60);
+    return options;
+}
+
+BSONObj makeMeasurement(long long millis, int meta, int x = 0) {
+    return BSON("t" << Date_t::fromMillisSinceEpoch(millis) << "m" << meta << "x" << x);
+}
+
+TEST(BucketCatalogTest, MeasurementsWithSameMetadataShareABucket) {
+    BucketCatalog catalog;
+    auto options = makeOptions();
+    auto first = catalog.insert(kNs, options, makeMeasurement(1000, 1));
+    auto second = catalog.insert(kNs, options, makeMeasurement(2000, 1));
+    auto other = catalog.insert(kNs, options, makeMeasurement(2000, 2));
+
+    ASSERT_EQ(first.bucketId, second.bucketId);
+    ASSERT_EQ(0, first.index);
+    ASSERT_EQ(1, second.index);
+    ASSERT_NE(first.bucketId, other.bucketId);
+    ASSERT_EQ(0, other.index);
+    ASSERT_EQ(1, first.bucketId.getTimestamp());
+}
+
+TEST(BucketCatalogTest, MeasurementOutsideTheSpanOfTheBucketOpensANewOne) {
+    BucketCatalog catalog;
+    auto options = makeOptions();
+    auto first = catalog.insert(kNs, options, makeMeasurement(60 * 1000, 1));
+    ASSERT_EQ(first.bucketId, catalog.insert(kNs, options, makeMeasurement(119999, 1)).bucketId);
+
+    auto later = catalog.insert(kNs, options, makeMeasurement(120 * 1000, 1));
+    ASSERT_NE(first.bucketId, later.bucketId);
+    ASSERT_EQ(0, later.index);
+
+    auto earlier = catalog.insert(kNs, options, makeMeasurement(0, 1));
+    ASSERT_NE(later.bucketId, earlier.bucketId);
+}
+
+TEST(BucketCatalogTest, ClearForgetsTheOpenBucketsOfACollection) {
+    BucketCatalog catalog;
+    auto options = makeOptions();
+    const NamespaceString otherNs("test.system.buckets.other");
+    auto first = catalog.insert(kNs, options, makeMeasurement(1000, 1));
+    auto other = catalog.insert(otherNs, options, makeMeasurement(1000, 1));
+    ASSERT_NE(first.bucketId, other.bucketId);
+
+    catalog.clear(kNs);
+    ASSERT_NE(first.bucketId, catalog.insert(kNs, options, makeMeasurement(1000, 1)).bucketId);
+    ASSERT_EQ(other.bucketId, catalog.insert(otherNs, options, makeMeasurement(1000, 1)).bucketId);
+}
+
+TEST(BucketCatalogTest, ClosedBucketIsReturnedOnceItsWritesFinish) {
+    BucketCatalog catalog;
+    auto options = makeOptions();
+    auto first = catalog.insert(kNs, options, makeMeasurement(1000, 1));
+    ASSERT_FALSE(first.closedBucketId);
+    ASSERT_FALSE(catalog.finish(first.bucketId, 1));
+
+    // The bucket has no write left to finish as it is closed.
+    auto second = catalog.insert(kNs, options, makeMeasurement(61 * 1000, 1));
+    ASSERT_EQ(first.bucketId, *second.closedBucketId);
+
+    // The bucket is closed with a write left to finish.
+    auto third = catalog.insert(kNs, options, makeMeasurement(200 * 1000, 1));
+    ASSERT_FALSE(third.closedBucketId);
+    ASSERT_TRUE(catalog.finish(second.bucketId, 1));
+    ASSERT_FALSE(catalog.finish(third.bucketId, 1));
+}
+
+TEST(BucketCatalogTest, RejectsMeasurementWithoutADate) {
+    BucketCatalog catalog;
+    ASSERT_THROWS_CODE(catalog.insert(kNs, makeOptions(), BSON("t" << 1 << "m" << 1)),
+                       DBException,
+                       5190411);
+}
+
+TEST(BucketCatalogTest, MakeBucketUpdateStoresMeasurementsByPosition) {
+    auto options = makeOptions();
+    auto update = BucketCatalog::makeBucketUpdate(
+        options, {{3, makeMeasurement(1000, 1, 5)}, {4, makeMeasurement(2000, 1, -5)}});
+
+    auto expected = BSON("$set" << BSON("data.t.3" << Date_t::fromMillisSinceEpoch(1000)
+                                                   << "data.x.3" << 5 << "data.t.4"
+                                                   << Date_t::fromMillisSinceEpoch(2000)
+                                                   << "data.x.4" << -5)
+                                << "$min"
+                                << BSON("control.min.t" << Date_t::fromMillisSinceEpoch(1000)
+                                                        << "control.min.x" << -5)
+                                << "$max"
+                                << BSON("control.max.t" << Date_t::fromMillisSinceEpoch(2000)
+                                                        << "control.max.x" << 5)
+                                << "$setOnInsert" << BSON("control.version" << 1 << "meta" << 1));
+    ASSERT_BSONOBJ_EQ(expected, update);
+}
+
+}  // namespace
+}  // namespace mongo
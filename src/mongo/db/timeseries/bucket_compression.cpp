@@ -0,0 +1,368 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <cstring>
+#include <string>
+
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+namespace {
+
+// The encodings of a column, stored in its first byte. It is followed by the number of values of
+// the column, as a little-endian 32-bit integer, and then by the bits of the encoded values.
+enum class Encoding : uint8_t {
+    kDeltaOfDelta = 1,  // Dates.
+    kXor = 2,           // Doubles.
+};
+constexpr size_t kHeaderSize = 1 + sizeof(uint32_t);
+
+// The widths of the zigzag-encoded differences of consecutive time differences, chosen by a
+// prefix of as many one bits as the index of the width, ended by a zero bit below the last width.
+constexpr int kDeltaOfDeltaWidths[] = {0, 7, 9, 12, 64};
+constexpr int kNumDeltaOfDeltaWidths = sizeof(kDeltaOfDeltaWidths) / sizeof(int);
+
+/**
+ * Writes bits least significant first, a 64-bit word at a time.
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::string* out) : _out(out) {}
+
+    void write(uint64_t bits, int numBits) {
+        if (numBits < 64) {
+            bits &= (uint64_t(1) << numBits) - 1;
+        }
+        _word |= bits << _used;
+        if (_used + numBits < 64) {
+            _used += numBits;
+            return;
+        }
+        appendBytes(sizeof(_word));
+        _word = _used ? bits >> (64 - _used) : 0;
+        _used = _used + numBits - 64;
+    }
+
+    void finish() {
+        appendBytes((_used + 7) / 8);
+        _word = 0;
+        _used = 0;
+    }
+
+private:
+    void appendBytes(size_t numBytes) {
+        char bytes[sizeof(_word)];
+        DataView(bytes).write<LittleEndian<uint64_t>>(_word);
+        _out->append(bytes, numBytes);
+    }
+
+    std::string* _out;
+    uint64_t _word = 0;
+    int _used = 0;
+};
+
+/**
+ * Reads the bits written by a BitWriter, a 64-bit word at a time.
+ */
+class BitReader {
+public:
+    BitReader(const char* data, size_t size) : _data(data), _size(size) {}
+
+    uint64_t read(int numBits) {
+        uassert(5190421,
+                "Time-series bucket column is truncated",
+                _bitPos + numBits <= _size * 8);
+        const size_t byte = _bitPos / 8;
+        const int offset = _bitPos % 8;
+        uint64_t bits = load(byte) >> offset;
+        if (offset && numBits > 64 - offset) {
+            bits |= uint64_t(static_cast<uint8_t>(_data[byte + 8])) << (64 - offset);
+        }
+        _bitPos += numBits;
+        return numBits < 64 ? bits & ((uint64_t(1) << numBits) - 1) : bits;
+    }
+
+private:
+    uint64_t load(size_t byte) const {
+        if (byte + 8 <= _size) {
+            return ConstDataView(_data + byte).read<LittleEndian<uint64_t>>();
+        }
+        char bytes[8] = {};
+        std::memcpy(bytes, _data + byte, _size - byte);
+        return ConstDataView(bytes).read<LittleEndian<uint64_t>>();
+    }
+
+    const char* _data;
+    size_t _size;
+    size_t _bitPos = 0;
+};
+
+uint64_t zigzagEncode(uint64_t value) {
+    return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+}
+
+uint64_t zigzagDecode(uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * Returns the encoding of 'column' if it holds a date or a double at each position from 0.
+ */
+boost::optional<Encoding> getEncoding(const BSONElement& column) {
+    if (column.type() != BSONType::Object || column.embeddedObject().isEmpty()) {
+        return boost::none;
+    }
+    const auto type = column.embeddedObject().firstElementType();
+    if (type != BSONType::Date && type != BSONType::NumberDouble) {
+        return boost::none;
+    }
+    size_t position = 0;
+    for (auto&& value : column.embeddedObject()) {
+        if (value.type() != type ||
+            str::parseUnsignedBase10Integer(value.fieldNameStringData()) != position++) {
+            return boost::none;
+        }
+    }
+    return type == BSONType::Date ? Encoding::kDeltaOfDelta : Encoding::kXor;
+}
+
+void encodeDeltaOfDelta(const BSONObj& values, BitWriter* writer) {
+    uint64_t prev = 0;
+    uint64_t prevDelta = 0;
+    bool first = true;
+    for (auto&& value : values) {
+        const uint64_t time = value.date().toMillisSinceEpoch();
+        if (first) {
+            writer->write(time, 64);
+            prev = time;
+            first = false;
+            continue;
+        }
+        const uint64_t delta = time - prev;
+        const uint64_t zigzag = zigzagEncode(delta - prevDelta);
+        prev = time;
+        prevDelta = delta;
+
+        int width = 0;
+        while (width < kNumDeltaOfDeltaWidths - 1 &&
+               zigzag >= uint64_t(1) << kDeltaOfDeltaWidths[width]) {
+            writer->write(1, 1);
+            ++width;
+        }
+        if (width < kNumDeltaOfDeltaWidths - 1) {
+            writer->write(0, 1);
+        }
+        if (kDeltaOfDeltaWidths[width]) {
+            writer->write(zigzag, kDeltaOfDeltaWidths[width]);
+        }
+    }
+}
+
+void decodeDeltaOfDelta(BitReader* reader, uint32_t count, BSONObjBuilder* builder) {
+    uint64_t time = reader->read(64);
+    uint64_t delta = 0;
+    builder->appendDate("0", Date_t::fromMillisSinceEpoch(time));
+    for (uint32_t i = 1; i < count; ++i) {
+        int width = 0;
+        while (width < kNumDeltaOfDeltaWidths - 1 && reader->read(1)) {
+            ++width;
+        }
+        if (kDeltaOfDeltaWidths[width]) {
+            delta += zigzagDecode(reader->read(kDeltaOfDeltaWidths[width]));
+        }
+        time += delta;
+        builder->appendDate(std::to_string(i), Date_t::fromMillisSinceEpoch(time));
+    }
+}
+
+void encodeXor(const BSONObj& values, BitWriter* writer) {
+    uint64_t prev = 0;
+    int prevLeading = -1;
+    int prevTrailing = 0;
+    for (auto&& value : values) {
+        const uint64_t bits = doubleBits(value.numberDouble());
+        const uint64_t diff = bits ^ prev;
+        prev = bits;
+        if (diff == 0) {
+            writer->write(0, 1);
+            continue;
+        }
+        writer->write(1, 1);
+
+        // The meaningful bits of the difference are stored within the window of the previous
+        // difference when they fit, and with a new window otherwise.
+        const int leading = std::min(countLeadingZeros64(diff), 31);
+        const int trailing = countTrailingZeros64(diff);
+        if (prevLeading >= 0 && leading >= prevLeading && trailing >= prevTrailing) {
+            writer->write(0, 1);
+            writer->write(diff >> prevTrailing, 64 - prevLeading - prevTrailing);
+            continue;
+        }
+        writer->write(1, 1);
+        writer->write(leading, 5);
+        writer->write(64 - leading - trailing - 1, 6);
+        writer->write(diff >> trailing, 64 - leading - trailing);
+        prevLeading = leading;
+        prevTrailing = trailing;
+    }
+}
+
+void decodeXor(BitReader* reader, uint32_t count, BSONObjBuilder* builder) {
+    uint64_t bits = 0;
+    int leading = -1;
+    int trailing = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (reader->read(1)) {
+            if (reader->read(1)) {
+                leading = reader->read(5);
+                const int meaningful = reader->read(6) + 1;
+                uassert(5190422,
+                        "Time-series bucket column is corrupt",
+                        leading + meaningful <= 64);
+                trailing = 64 - leading - meaningful;
+            } else {
+                uassert(5190423, "Time-series bucket column is corrupt", leading >= 0);
+            }
+            bits ^= reader->read(64 - leading - trailing) << trailing;
+        }
+        builder->append(std::to_string(i), bitsDouble(bits));
+    }
+}
+
+}  // namespace
+
+boost::optional<BSONObj> compressBucket(const BSONObj& bucket) {
+    auto data = bucket["data"];
+    if (data.type() != BSONType::Object) {
+        return boost::none;
+    }
+
+    BSONObjBuilder compressedData;
+    bool compressed = false;
+    for (auto&& column : data.embeddedObject()) {
+        auto encoding = getEncoding(column);
+        if (!encoding) {
+            compressedData.append(column);
+            continue;
+        }
+
+        const auto values = column.embeddedObject();
+        std::string encoded(kHeaderSize, '\0');
+        encoded[0] = static_cast<char>(*encoding);
+        DataView(&encoded[1]).write<LittleEndian<uint32_t>>(values.nFields());
+        BitWriter writer(&encoded);
+        if (*encoding == Encoding::kDeltaOfDelta) {
+            encodeDeltaOfDelta(values, &writer);
+        } else {
+            encodeXor(values, &writer);
+        }
+        writer.finish();
+        compressedData.appendBinData(
+            column.fieldNameStringData(), encoded.size(), BinDataType::Column, encoded.data());
+        compressed = true;
+    }
+    if (!compressed) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucket) {
+        if (elem.fieldNameStringData() == "data") {
+            builder.append("data", compressedData.obj());
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+bool isCompressedColumn(const BSONElement& column) {
+    return column.type() == BSONType::BinData && column.binDataType() == BinDataType::Column;
+}
+
+BSONObj decompressColumn(const BSONElement& column) {
+    invariant(isCompressedColumn(column));
+    int size;
+    const char* data = column.binData(size);
+    uassert(5190424,
+            "Time-series bucket column is corrupt",
+            static_cast<size_t>(size) >= kHeaderSize);
+    const auto encoding = static_cast<Encoding>(data[0]);
+    const auto count = ConstDataView(data + 1).read<LittleEndian<uint32_t>>();
+
+    // Every value takes at least one bit.
+    BitReader reader(data + kHeaderSize, size - kHeaderSize);
+    uassert(5190425,
+            "Time-series bucket column is corrupt",
+            count <= (static_cast<size_t>(size) - kHeaderSize) * 8);
+
+    BSONObjBuilder builder;
+    if (count == 0) {
+        return builder.obj();
+    }
+    switch (encoding) {
+        case Encoding::kDeltaOfDelta:
+            decodeDeltaOfDelta(&reader, count, &builder);
+            break;
+        case Encoding::kXor:
+            decodeXor(&reader, count, &builder);
+            break;
+        default:
+            uasserted(5190426,
+                      str::stream() << "Unknown time-series bucket column encoding: "
+                                    << static_cast<int>(encoding));
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Returns 'bucket' with the columns of its 'data' which hold a date or a double at each position
+ * from 0 encoded as BinData columns, or boost::none if it has no such column. The times of a column
+ * of dates are stored as the differences between their consecutive differences, and the doubles of
+ * a column of doubles as the differences of the bits of consecutive values, so that regular times
+ * and slowly changing values take a few bits each.
+ */
+boost::optional<BSONObj> compressBucket(const BSONObj& bucket);
+
+/**
+ * Returns whether 'column' is a column encoded by compressBucket().
+ */
+bool isCompressedColumn(const BSONElement& column);
+
+/**
+ * Returns the values of the column 'column' encoded by compressBucket(), keyed by their positions
+ * like the columns of an uncompressed bucket. Throws if the column is corrupt.
+ */
+BSONObj decompressColumn(const BSONElement& column);
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/json.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeBucket(const BSONObj& data) {
+    return BSON("_id" << 1 << "control" << BSON("version" << 1) << "data" << data);
+}
+
+BSONObj makeDateColumn(const std::vector<long long>& millis) {
+    BSONObjBuilder column;
+    for (size_t i = 0; i < millis.size(); ++i) {
+        column.appendDate(std::to_string(i), Date_t::fromMillisSinceEpoch(millis[i]));
+    }
+    return column.obj();
+}
+
+BSONObj makeDoubleColumn(const std::vector<double>& values) {
+    BSONObjBuilder column;
+    for (size_t i = 0; i < values.size(); ++i) {
+        column.append(std::to_string(i), values[i]);
+    }
+    return column.obj();
+}
+
+/**
+ * Compresses a bucket with 'column' as its only column, and checks that it decompresses to the
+ * values of 'column'. Returns the compressed column.
+ */
+BSONElement assertRoundTrips(const BSONObj& column, BSONObj* compressedBucket) {
+    auto compressed = timeseries::compressBucket(makeBucket(BSON("x" << column)));
+    ASSERT(compressed);
+    *compressedBucket = *compressed;
+    ASSERT_BSONOBJ_EQ(BSON("version" << 1), compressedBucket->getObjectField("control"));
+
+    auto compressedColumn = compressedBucket->getObjectField("data")["x"];
+    ASSERT(timeseries::isCompressedColumn(compressedColumn));
+    auto values = timeseries::decompressColumn(compressedColumn);
+    ASSERT_EQ(column.nFields(), values.nFields());
+
+    // Compares the bits of the values, so that NaNs and negative zeros must be preserved.
+    BSONObjIterator expected(column);
+    for (auto&& value : values) {
+        auto expectedValue = expected.next();
+        ASSERT_EQ(expectedValue.fieldNameStringData(), value.fieldNameStringData());
+        ASSERT_EQ(expectedValue.type(), value.type());
+        ASSERT_EQ(0, memcmp(expectedValue.value(), value.value(), value.valuesize()));
+    }
+    return compressedColumn;
+}
+
+TEST(BucketCompressionTest, RegularTimesTakeABitEach) {
+    std::vector<long long> times;
+    for (int i = 0; i < 1000; ++i) {
+        times.push_back(1609459200000LL + i * 1000);
+    }
+    BSONObj bucket;
+    auto column = assertRoundTrips(makeDateColumn(times), &bucket);
+    int size;
+    column.binData(size);
+    ASSERT_LT(size, 160);
+}
+
+TEST(BucketCompressionTest, IrregularAndExtremeTimesRoundTrip) {
+    BSONObj bucket;
+    assertRoundTrips(makeDateColumn({0, 5, 3, 100000, 100001, -1, 1LL << 50, 7}), &bucket);
+    assertRoundTrips(makeDateColumn({std::numeric_limits<long long>::min(),
+                                     std::numeric_limits<long long>::max(),
+                                     0,
+                                     std::numeric_limits<long long>::min()}),
+                     &bucket);
+    assertRoundTrips(makeDateColumn({42}), &bucket);
+}
+
+TEST(BucketCompressionTest, DoublesRoundTrip) {
+    BSONObj bucket;
+    assertRoundTrips(makeDoubleColumn({20.5, 20.5, 20.75, 21.0, 20.0, 0.0, -0.0, 1e300, -1e-300}),
+                     &bucket);
+    assertRoundTrips(makeDoubleColumn({std::numeric_limits<double>::quiet_NaN(),
+                                       std::numeric_limits<double>::infinity(),
+                                       -std::numeric_limits<double>::infinity(),
+                                       std::numeric_limits<double>::denorm_min(),
+                                       1.0}),
+                     &bucket);
+}
+
+TEST(BucketCompressionTest, RepeatedDoublesTakeABitEach) {
+    BSONObj bucket;
+    auto column = assertRoundTrips(makeDoubleColumn(std::vector<double>(1000, 98.6)), &bucket);
+    int size;
+    column.binData(size);
+    ASSERT_LT(size, 160);
+}
+
+TEST(BucketCompressionTest, LeavesOtherColumnsUncompressed) {
+    auto data = BSON("t" << makeDateColumn({1000, 2000}) << "mixed"
+                         << fromjson("{'0': 1, '1': 2.5}") << "sparse"
+                         << fromjson("{'0': 1.5, '2': 2.5}") << "ints"
+                         << fromjson("{'0': 1, '1': 2}"));
+    auto compressed = timeseries::compressBucket(makeBucket(data));
+    ASSERT(compressed);
+
+    auto compressedData = compressed->getObjectField("data");
+    ASSERT_EQ(4, compressedData.nFields());
+    ASSERT(timeseries::isCompressedColumn(compressedData["t"]));
+    ASSERT_BSONOBJ_EQ(data.getObjectField("mixed"), compressedData.getObjectField("mixed"));
+    ASSERT_BSONOBJ_EQ(data.getObjectField("sparse"), compressedData.getObjectField("sparse"));
+    ASSERT_BSONOBJ_EQ(data.getObjectField("ints"), compressedData.getObjectField("ints"));
+
+    ASSERT_FALSE(timeseries::compressBucket(
+        makeBucket(BSON("ints" << data.getObjectField("ints")))));
+}
+
+TEST(BucketCompressionTest, RejectsCorruptColumns) {
+    BSONObj bucket;
+    auto column = assertRoundTrips(makeDateColumn({1000, 2000, 3500}), &bucket);
+    int size;
+    const char* data = column.binData(size);
+
+    BSONObjBuilder truncated;
+    truncated.appendBinData("x", size - 1, BinDataType::Column, data);
+    ASSERT_THROWS_CODE(timeseries::decompressColumn(truncated.obj().firstElement()),
+                       DBException,
+                       5190421);
+
+    std::string unknownEncoding(data, size);
+    unknownEncoding[0] = 100;
+    BSONObjBuilder unknown;
+    unknown.appendBinData("x", size, BinDataType::Column, unknownEncoding.data());
+    ASSERT_THROWS_CODE(
+        timeseries::decompressColumn(unknown.obj().firstElement()), DBException, 5190426);
+}
+
+}  // namespace
+}  // namespace mongo
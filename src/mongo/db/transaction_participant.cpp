@@ -38,6 +38,7 @@
 
 #include <fmt/format.h>
 
+#include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
@@ -251,13 +252,11 @@ void updateSessionEntry(OperationContext* opCtx, const UpdateRequest& updateRequ
     auto originalRecordData = collection->getRecordStore()->dataFor(opCtx, recordId);
     auto originalDoc = originalRecordData.toBson();
 
+    // The query only constrains the _id, so rather than parsing it into a MatchExpression on every
+    // retryable write, compare the _id of the document that was found directly.
     invariant(collection->getDefaultCollator() == nullptr);
-    boost::intrusive_ptr<ExpressionContext> expCtx(
-        new ExpressionContext(opCtx, nullptr, updateRequest.getNamespaceString()));
-
-    auto matcher =
-        fassert(40673, MatchExpressionParser::parse(updateRequest.getQuery(), std::move(expCtx)));
-    if (!matcher->matchesBSON(originalDoc)) {
+    dassert(updateRequest.getQuery().nFields() == 1);
+    if (SimpleBSONElementComparator::kInstance.evaluate(originalDoc["_id"] != idToFetch)) {
         // Document no longer match what we expect so throw WCE to make the caller re-examine.
         throw WriteConflictException();
     }
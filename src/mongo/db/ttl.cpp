@@ -33,6 +33,8 @@
 
 #include "mongo/db/ttl.h"
 
+#include <map>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -57,6 +59,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/thread_pool.h"
 
 namespace mongo {
 
@@ -72,10 +75,39 @@ MONGO_FAIL_POINT_DEFINE(hangTTLMonitorWithLock);
 
 Counter64 ttlPasses;
 Counter64 ttlDeletedDocuments;
+Counter64 ttlDeferredForReplicationLag;
 
 ServerStatusMetricField<Counter64> ttlPassesDisplay("ttl.passes", &ttlPasses);
 ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocuments",
                                                               &ttlDeletedDocuments);
+ServerStatusMetricField<Counter64> ttlDeferredForReplicationLagDisplay(
+    "ttl.deferredForReplicationLag", &ttlDeferredForReplicationLag);
+
+namespace {
+
+/**
+ * Returns true if the majority commit point trails this node's last applied write by more than
+ * ttlMonitorMaxMajorityLagSecs, in which case TTL deletions should wait for the secondaries.
+ */
+bool isMajorityLagging(OperationContext* opCtx) {
+    const auto maxLagSecs = ttlMonitorMaxMajorityLagSecs.load();
+    if (maxLagSecs <= 0) {
+        return false;
+    }
+
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (replCoord->getReplicationMode() != repl::ReplicationCoordinator::modeReplSet) {
+        return false;
+    }
+
+    // Wall clock recordings are not guaranteed to be monotonic, so a commit point that appears
+    // ahead of the last applied write is treated as no lag.
+    const auto lastApplied = replCoord->getMyLastAppliedOpTimeAndWallTime();
+    const auto lastCommitted = replCoord->getLastCommittedOpTimeAndWallTime();
+    return lastApplied.wallTime - lastCommitted.wallTime > Seconds(maxLagSecs);
+}
+
+}  // namespace
 
 class TTLMonitor : public BackgroundJob {
 public:
@@ -167,12 +199,16 @@ public:
 
 private:
     /**
-     * Gets all TTL indexes from every collection and performs doTTLForIndex().
+     * Gets all TTL indexes from every collection and performs doTTLForCollection() on each
+     * collection, up to ttlMonitorMaxConcurrentCollections of them at a time.
      */
     void doTTLPass() {
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext& opCtx = *opCtxPtr;
 
+        // TTL deletes are background work and must not take tickets ahead of user operations.
+        opCtx.lockState()->setAdmissionPriority(TicketHolder::Priority::kLow);
+
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::ReplicationCoordinator::get(&opCtx)->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
@@ -182,8 +218,9 @@ private:
         TTLCollectionCache& ttlCollectionCache = TTLCollectionCache::get(getGlobalServiceContext());
         std::vector<std::pair<UUID, std::string>> ttlInfos = ttlCollectionCache.getTTLInfos();
 
-        // Pair of collection namespace and index spec.
-        std::vector<std::pair<NamespaceString, BSONObj>> ttlIndexes;
+        // TTL index specs, grouped by collection namespace so that a collection is only ever
+        // processed by one thread at a time.
+        std::map<NamespaceString, std::vector<BSONObj>> ttlIndexes;
 
         ttlPasses.increment();
 
@@ -235,29 +272,93 @@ private:
                      ->isIndexReady(&opCtx, coll->getCatalogId(), indexName))
                 continue;
 
-            ttlIndexes.push_back(std::make_pair(*nss, spec.getOwned()));
+            ttlIndexes[*nss].push_back(spec.getOwned());
         }
 
+        const size_t numThreads = std::min(
+            static_cast<size_t>(ttlMonitorMaxConcurrentCollections.load()), ttlIndexes.size());
+        if (numThreads <= 1) {
+            for (const auto& it : ttlIndexes) {
+                if (!doTTLForCollection(&opCtx, it.first, it.second)) {
+                    return;
+                }
+            }
+            return;
+        }
+
+        // Each worker deletes from one collection at a time on its own client, so deletions from
+        // different collections proceed in parallel while each collection stays single-threaded.
+        // Once any worker is interrupted the collections that have not started yet are skipped.
+        AtomicWord<bool> interrupted{false};
+        ThreadPool::Options options;
+        options.threadNamePrefix = "TTLMonitorWorker-";
+        options.poolName = "TTLMonitorWorkerPool";
+        options.minThreads = 0;
+        options.maxThreads = numThreads;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+            stdx::lock_guard<Client> lk(cc());
+            cc().setSystemOperationKillableByStepdown(lk);
+        };
+        ThreadPool pool(options);
+        pool.startup();
         for (const auto& it : ttlIndexes) {
+            pool.schedule([this, &it, &interrupted](auto status) {
+                invariant(status);
+                if (interrupted.load()) {
+                    return;
+                }
+                auto workerOpCtx = cc().makeOperationContext();
+                workerOpCtx->lockState()->setAdmissionPriority(TicketHolder::Priority::kLow);
+                if (!doTTLForCollection(workerOpCtx.get(), it.first, it.second)) {
+                    interrupted.store(true);
+                }
+            });
+        }
+        pool.shutdown();
+        pool.join();
+    }
+
+    /**
+     * Performs doTTLForIndex() for each of the given TTL indexes of 'collectionNSS'. Stops early,
+     * leaving the remaining deletions to the next pass, when the majority commit point lags too
+     * far behind. Returns false if the operation was interrupted.
+     */
+    bool doTTLForCollection(OperationContext* opCtx,
+                            const NamespaceString& collectionNSS,
+                            const std::vector<BSONObj>& indexSpecs) {
+        for (const auto& spec : indexSpecs) {
             try {
-                doTTLForIndex(&opCtx, it.first, it.second);
+                if (isMajorityLagging(opCtx)) {
+                    ttlDeferredForReplicationLag.increment();
+                    LOGV2_DEBUG(5191010,
+                                1,
+                                "Deferring TTL deletions until the majority commit point "
+                                "catches up",
+                                logAttrs(collectionNSS),
+                                "maxLagSecs"_attr = ttlMonitorMaxMajorityLagSecs.load());
+                    return true;
+                }
+                doTTLForIndex(opCtx, collectionNSS, spec);
             } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
                 LOGV2_WARNING(22537,
                               "TTLMonitor was interrupted, waiting {ttlMonitorSleepSecs_load} "
                               "seconds before doing another pass",
                               "TTLMonitor was interrupted, waiting before doing another pass",
                               "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
-                return;
+                return false;
             } catch (const DBException& dbex) {
                 LOGV2_ERROR(22538,
                             "Error processing ttl index: {it_second} -- {dbex}",
                             "Error processing TTL index",
-                            "index"_attr = it.second,
+                            "index"_attr = spec,
                             "error"_attr = dbex);
                 // Continue on to the next index.
                 continue;
             }
         }
+        return true;
     }
 
     /**
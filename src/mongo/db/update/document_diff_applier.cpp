@@ -291,6 +291,113 @@ private:
     const UpdateIndexData* _indexData;
     bool _indexesAffected = false;
 };
+
+/**
+ * Translates an object diff into damage events which turn the pre-image buffer into the post-image
+ * buffer. This relies on the field order produced by DiffApplier: fields which are not modified,
+ * updated or sub-diffed keep their relative positions, deleted fields disappear and inserted fields
+ * are appended at the end. Each run of modified fields becomes one damage event, and sub-diffs of
+ * embedded objects are recursed into so that only the changed parts of large sub-documents are
+ * rewritten.
+ */
+class DamagesCalculator {
+public:
+    explicit DamagesCalculator(mutablebson::DamageVector* damages) : _damages(damages) {}
+
+    /**
+     * Appends the damage events for the object starting at 'preOffset' in the pre-image and at
+     * 'postOffset' in the post-image. Returns false if the two objects are not laid out the way
+     * applying 'reader' would have produced them.
+     */
+    bool computeObjectDamages(const BSONObj& pre,
+                              size_t preOffset,
+                              const BSONObj& post,
+                              size_t postOffset,
+                              DocumentDiffReader* reader) {
+        const DocumentDiffTables tables = buildObjDiffTables(reader);
+        const size_t preEnd = preOffset + pre.objsize();
+        const size_t postEnd = postOffset + post.objsize();
+
+        if (pre.objsize() != post.objsize()) {
+            _damages->emplace_back(postOffset, sizeof(int32_t), postOffset, sizeof(int32_t));
+        }
+        preOffset += sizeof(int32_t);
+        postOffset += sizeof(int32_t);
+
+        // Start of the pending run of modified fields, in the pre-image and post-image.
+        boost::optional<std::pair<size_t, size_t>> runStart;
+        auto flushRun = [&] {
+            if (runStart) {
+                _damages->emplace_back(runStart->second,
+                                       postOffset - runStart->second,
+                                       runStart->second,
+                                       preOffset - runStart->first);
+                runStart = boost::none;
+            }
+        };
+
+        BSONObjIterator postIt(post);
+        for (auto&& preElt : pre) {
+            const auto fieldName = preElt.fieldNameStringData();
+            const auto postElt = postIt.more() ? *postIt : BSONElement();
+            const bool keptInPlace = !postElt.eoo() && postElt.fieldNameStringData() == fieldName;
+
+            auto it = tables.fieldMap.find(fieldName);
+            if (it == tables.fieldMap.end()) {
+                // Unmodified fields must be carried over byte for byte.
+                if (!keptInPlace || postElt.size() != preElt.size()) {
+                    return false;
+                }
+                dassert(std::memcmp(preElt.rawdata(), postElt.rawdata(), preElt.size()) == 0);
+                flushRun();
+            } else if (auto subDiff = stdx::get_if<SubDiff>(&it->second); keptInPlace &&
+                       subDiff && subDiff->type() == DiffType::kDocument &&
+                       preElt.type() == BSONType::Object && postElt.type() == BSONType::Object) {
+                flushRun();
+                const size_t valueOffset = preElt.fieldNameSize() + 1;
+                auto subReader = stdx::get<DocumentDiffReader>(subDiff->reader);
+                if (!computeObjectDamages(preElt.embeddedObject(),
+                                          preOffset + valueOffset,
+                                          postElt.embeddedObject(),
+                                          postOffset + valueOffset,
+                                          &subReader)) {
+                    return false;
+                }
+            } else {
+                // Deleted, updated, moved or replaced field: fold it into the pending run. Fields
+                // which keep their position take their post-image bytes along with them.
+                if (!runStart) {
+                    runStart.emplace(preOffset, postOffset);
+                }
+                preOffset += preElt.size();
+                if (keptInPlace) {
+                    postOffset += postElt.size();
+                    postIt.next();
+                }
+                continue;
+            }
+
+            preOffset += preElt.size();
+            postOffset += postElt.size();
+            postIt.next();
+        }
+
+        // Whatever remains in the post-image was appended by the diff's inserts.
+        while (postIt.more()) {
+            if (!runStart) {
+                runStart.emplace(preOffset, postOffset);
+            }
+            postOffset += postIt.next().size();
+        }
+        flushRun();
+
+        // Both objects must have been consumed up to their terminating EOO byte.
+        return preOffset + 1 == preEnd && postOffset + 1 == postEnd;
+    }
+
+private:
+    mutablebson::DamageVector* const _damages;
+};
 }  // namespace
 
 ApplyDiffOutput applyDiff(const BSONObj& pre, const Diff& diff, const UpdateIndexData* indexData) {
@@ -301,4 +408,16 @@ ApplyDiffOutput applyDiff(const BSONObj& pre, const Diff& diff, const UpdateInde
     applier.applyDiffToObject(pre, &path, &reader, &out);
     return {out.obj(), applier.indexesAffected()};
 }
+
+boost::optional<mutablebson::DamageVector> computeDamages(const BSONObj& pre,
+                                                          const BSONObj& post,
+                                                          const Diff& diff) {
+    DocumentDiffReader reader(diff);
+    mutablebson::DamageVector damages;
+    DamagesCalculator calculator(&damages);
+    if (!calculator.computeObjectDamages(pre, 0, post, 0, &reader)) {
+        return boost::none;
+    }
+    return damages;
+}
 }  // namespace mongo::doc_diff
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/mutable/damage_vector.h"
 #include "mongo/db/update/document_diff_serialization.h"
 #include "mongo/db/update_index_data.h"
 
@@ -46,5 +49,17 @@ struct ApplyDiffOutput {
  * indexData' parameter is optional, if provided computes whether the indexes are affected.
  */
 ApplyDiffOutput applyDiff(const BSONObj& pre, const Diff& diff, const UpdateIndexData* indexData);
+
+/**
+ * Computes the damage events which turn the buffer of 'pre' into that of 'post', where 'post' is
+ * the result of applying 'diff' to 'pre'. The source offsets of the damages refer to the buffer of
+ * 'post'. The damages only cover the fields touched by the diff, so writing them costs in
+ * proportion to the size of the change rather than of the document. Returns boost::none if the
+ * images are not laid out the way applyDiff() would have produced them. Throws if the diff is
+ * invalid.
+ */
+boost::optional<mutablebson::DamageVector> computeDamages(const BSONObj& pre,
+                                                          const BSONObj& post,
+                                                          const Diff& diff);
 }  // namespace doc_diff
 }  // namespace mongo
@@ -40,6 +40,26 @@
 
 namespace mongo::doc_diff {
 namespace {
+/**
+ * Checks that the damages computed for the diff turn the buffer of 'preImage' into that of
+ * 'postImage', applying them the way a storage engine would.
+ */
+void checkDamages(const BSONObj& preImage, const BSONObj& postImage, const Diff& diff) {
+    auto damages = computeDamages(preImage, postImage, diff);
+    ASSERT(damages);
+
+    std::string buffer(preImage.objdata(), preImage.objsize());
+    for (auto&& damage : *damages) {
+        ASSERT_LTE(damage.targetOffset + damage.targetSize, buffer.size());
+        buffer.replace(damage.targetOffset,
+                       damage.targetSize,
+                       postImage.objdata() + damage.sourceOffset,
+                       damage.sourceSize);
+    }
+    ASSERT_BSONOBJ_BINARY_EQ(BSONObj(buffer.data()), postImage);
+    ASSERT_EQ(buffer.size(), static_cast<size_t>(postImage.objsize()));
+}
+
 /**
  * Checks that applying the diff (once or twice) to 'preImage' produces the expected post image.
  */
@@ -50,9 +70,11 @@ void checkDiff(const BSONObj& preImage, const BSONObj& expectedPost, const Diff&
     // members. Logical equality (through woCompare() or ASSERT_BSONOBJ_EQ) is not enough to show
     // that the applier actually works.
     ASSERT_BSONOBJ_BINARY_EQ(postImage, expectedPost);
+    checkDamages(preImage, postImage, diff);
 
     BSONObj postImageAgain = applyDiffTestHelper(postImage, diff);
     ASSERT_BSONOBJ_BINARY_EQ(postImageAgain, expectedPost);
+    checkDamages(postImage, postImageAgain, diff);
 }
 
 TEST(DiffApplierTest, DeleteSimple) {
@@ -398,5 +420,37 @@ TEST(DiffApplierTest, DuplicateFieldNames) {
         4728000);
 }
 
+TEST(DiffApplierTest, DamagesOnlyCoverModifiedFields) {
+    const BSONObj preImage(BSON("big" << std::string(1024, 'x') << "counter" << 1 << "obj"
+                                      << BSON("big" << std::string(1024, 'y') << "a" << 1)));
+
+    const BSONObj storage(BSON("a" << 2 << "b" << 2LL));
+    diff_tree::DocumentSubDiffNode diffNode;
+    diffNode.addUpdate("counter", storage["a"]);
+    {
+        auto subDiffNode = std::make_unique<diff_tree::DocumentSubDiffNode>();
+        subDiffNode->addUpdate("a", storage["b"]);
+        diffNode.addChild("obj", std::move(subDiffNode));
+    }
+    auto diff = diffNode.serialize();
+
+    const BSONObj postImage = applyDiffTestHelper(preImage, diff);
+    checkDamages(preImage, postImage, diff);
+
+    // Neither of the large strings should be rewritten.
+    size_t damagedBytes = 0;
+    for (auto&& damage : *computeDamages(preImage, postImage, diff)) {
+        damagedBytes += damage.sourceSize;
+    }
+    ASSERT_LT(damagedBytes, 64U);
+}
+
+TEST(DiffApplierTest, DamagesAreNotComputedForMismatchedImages) {
+    const BSONObj preImage(BSON("a" << 1 << "b" << 1));
+    auto diff = fromjson("{u: {a: 2}}");
+    ASSERT_FALSE(computeDamages(preImage, BSON("a" << 2 << "c" << 1), diff));
+    ASSERT_FALSE(computeDamages(preImage, BSON("a" << 2), diff));
+}
+
 }  // namespace
 }  // namespace mongo::doc_diff
@@ -34,7 +34,9 @@
 #include "mongo/base/data_view.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/update/document_diff_calculator.h"
 #include "mongo/db/update/storage_validation.h"
 #include "mongo/db/update/update_oplog_entry_serialization.h"
 #include "mongo/db/vector_clock_mutable.h"
@@ -146,11 +148,28 @@ UpdateExecutor::ApplyResult ObjectReplaceExecutor::applyReplacementUpdate(
 }
 
 UpdateExecutor::ApplyResult ObjectReplaceExecutor::applyUpdate(ApplyParams applyParams) const {
+    // A replacement which only changes a few fields of a large document can be logged as the delta
+    // between the documents.
+    const bool mayLogDelta = applyParams.logMode == ApplyParams::LogMode::kGenerateOplogEntry &&
+        !applyParams.insert && internalQueryEnableLoggingV2OplogEntriesForReplacements.load();
+    const auto originalDoc =
+        mayLogDelta ? applyParams.element.getDocument().getObject() : BSONObj();
+
     auto ret = applyReplacementUpdate(applyParams, _replacementDoc, _containsId);
 
     if (!ret.noop && applyParams.logMode != ApplyParams::LogMode::kDoNotGenerateOplogEntry) {
-        ret.oplogEntry = update_oplog_entry::makeReplacementOplogEntry(
-            applyParams.element.getDocument().getObject());
+        const auto replacementDoc = applyParams.element.getDocument().getObject();
+        if (mayLogDelta) {
+            if (auto diffOutput =
+                    doc_diff::computeDiff(originalDoc,
+                                          replacementDoc,
+                                          update_oplog_entry::kSizeOfDeltaOplogEntryMetadata,
+                                          nullptr)) {
+                ret.oplogEntry = update_oplog_entry::makeDeltaOplogEntry(diffOutput->diff);
+                return ret;
+            }
+        }
+        ret.oplogEntry = update_oplog_entry::makeReplacementOplogEntry(replacementDoc);
     }
     return ret;
 }
@@ -34,8 +34,10 @@
 #include "mongo/bson/mutable/algorithm.h"
 #include "mongo/bson/mutable/mutable_bson_test_utils.h"
 #include "mongo/db/json.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/update/update_node_test_fixture.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -296,5 +298,30 @@ TEST_F(ObjectReplaceExecutorTest, NoLogBuilder) {
     ASSERT_FALSE(doc.isInPlaceModeEnabled());
 }
 
+TEST_F(ObjectReplaceExecutorTest, LogsDeltaWhenSmallerThanReplacementIfEnabled) {
+    const bool oldEnabled = internalQueryEnableLoggingV2OplogEntriesForReplacements.load();
+    internalQueryEnableLoggingV2OplogEntriesForReplacements.store(true);
+    ON_BLOCK_EXIT(
+        [&] { internalQueryEnableLoggingV2OplogEntriesForReplacements.store(oldEnabled); });
+
+    const std::string padding(100, 'x');
+    auto obj = BSON("_id" << 0 << "a" << padding << "b" << 3);
+    ObjectReplaceExecutor node(obj);
+
+    mutablebson::Document doc(BSON("_id" << 0 << "a" << padding << "b" << 2));
+    auto result = node.applyUpdate(getApplyParams(doc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_EQUALS(obj, doc);
+    ASSERT_BSONOBJ_BINARY_EQ(fromjson("{$v: 2, diff: {u: {b: 3}}}"), result.oplogEntry);
+
+    // A delta no smaller than the replacement is not logged.
+    auto smallObj = fromjson("{a: 1}");
+    ObjectReplaceExecutor smallNode(smallObj);
+    mutablebson::Document smallDoc(fromjson("{b: 1}"));
+    result = smallNode.applyUpdate(getApplyParams(smallDoc.root()));
+    ASSERT_FALSE(result.noop);
+    ASSERT_BSONOBJ_BINARY_EQ(smallObj, result.oplogEntry);
+}
+
 }  // namespace
 }  // namespace mongo
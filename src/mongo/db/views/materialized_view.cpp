@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view.h"
+
+#include <limits>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/pipeline/document_source_queue.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/views/view.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace materialized_view {
+namespace {
+
+// The number of documents grouped at a time when computing the results of a new materialized view.
+constexpr size_t kBuildBatchSize = 1000;
+
+/**
+ * Returns the pipeline of 'view' with an accumulator which counts the documents of each group
+ * appended to its final $group stage.
+ */
+std::vector<BSONObj> makeDeltaPipeline(const ViewDefinition& view) {
+    std::vector<BSONObj> pipeline = view.pipeline();
+    invariant(!pipeline.empty());
+
+    BSONObjBuilder groupStage;
+    {
+        BSONObjBuilder groupSpec(groupStage.subobjStart("$group"));
+        groupSpec.appendElements(pipeline.back().firstElement().Obj());
+        groupSpec.append(ViewDefinition::kMaterializedCountField, BSON("$sum" << 1));
+    }
+    pipeline.back() = groupStage.obj();
+    return pipeline;
+}
+
+/**
+ * Returns the groups of 'docs', along with their sums and number of documents.
+ */
+std::vector<Document> groupDocuments(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                     const std::vector<BSONObj>& deltaPipeline,
+                                     const std::vector<BSONObj>& docs) {
+    std::vector<Document> groups;
+    if (docs.empty()) {
+        return groups;
+    }
+
+    auto pipeline = Pipeline::parse(deltaPipeline, expCtx);
+    auto queue = DocumentSourceQueue::create(expCtx);
+    for (auto&& doc : docs) {
+        queue->emplace_back(Document(doc));
+    }
+    pipeline->addInitialSource(std::move(queue));
+
+    while (auto group = pipeline->getNext()) {
+        groups.push_back(std::move(*group));
+    }
+    return groups;
+}
+
+/**
+ * Returns the negation of the numeric value 'value', widening its type if the negation doesn't fit.
+ * The sums of a $group are always numeric.
+ */
+Value negate(const Value& value) {
+    switch (value.getType()) {
+        case NumberInt:
+            if (value.getInt() == std::numeric_limits<int>::min()) {
+                return Value(-static_cast<long long>(value.getInt()));
+            }
+            return Value(-value.getInt());
+        case NumberLong:
+            if (value.getLong() == std::numeric_limits<long long>::min()) {
+                return Value(-static_cast<double>(value.getLong()));
+            }
+            return Value(-value.getLong());
+        case NumberDouble:
+            return Value(-value.getDouble());
+        case NumberDecimal:
+            return Value(value.getDecimal().negate());
+        default:
+            MONGO_UNREACHABLE;
+    }
+}
+
+/**
+ * Adds the sums of 'group' to, or subtracts them from if 'deleted' is true, the document of the
+ * same group in the materialized collection 'coll', and removes the document when no more
+ * documents are in its group.
+ */
+void applyGroup(OperationContext* opCtx,
+                ExpressionContext* expCtx,
+                const Collection* coll,
+                const Document& group,
+                bool deleted) {
+    const Value key = group["_id"];
+    uassert(5190280,
+            str::stream() << "Cannot maintain a materialized view with a group key of type "
+                          << typeName(key.getType()),
+            key.getType() != Array && key.getType() != RegEx && key.getType() != Undefined);
+
+    BSONObjBuilder idQuery;
+    key.addToBsonObj(&idQuery, "_id");
+    const RecordId id = Helpers::findById(opCtx, coll, idQuery.obj());
+
+    Snapshotted<BSONObj> oldDoc;
+    const bool exists = !id.isNull() && coll->findDoc(opCtx, id, &oldDoc);
+    const Document old = exists ? Document(oldDoc.value()) : Document();
+
+    MutableDocument updated;
+    updated.addField("_id", exists ? old["_id"] : key);
+    for (auto it = group.fieldIterator(); it.more();) {
+        auto field = it.next();
+        if (field.first == "_id") {
+            continue;
+        }
+        auto sum = AccumulatorSum::create(expCtx);
+        if (exists) {
+            sum->process(old[field.first], false);
+        }
+        sum->process(deleted ? negate(field.second) : field.second, false);
+        updated.addField(field.first, sum->getValue(false));
+    }
+
+    // The view's results are written on behalf of the user's write, so they don't count towards
+    // its statistics.
+    OpDebug* const opDebug = nullptr;
+    if (updated.peek()[ViewDefinition::kMaterializedCountField].coerceToLong() <= 0) {
+        if (exists) {
+            coll->deleteDocument(opCtx, kUninitializedStmtId, id, opDebug);
+        }
+        return;
+    }
+
+    const BSONObj newDoc = updated.freeze().toBson();
+    if (!exists) {
+        uassertStatusOK(coll->insertDocument(opCtx, InsertStatement(newDoc), opDebug));
+        return;
+    }
+
+    CollectionUpdateArgs args;
+    args.update = newDoc;
+    args.criteria = BSON("_id" << old["_id"]);
+    args.fromMigrate = false;
+
+    const bool assumeIndexesAreAffected = true;
+    coll->updateDocument(opCtx, id, oldDoc, newDoc, assumeIndexesAreAffected, opDebug, &args);
+}
+
+}  // namespace
+
+Status materialize(OperationContext* opCtx, Database* db, const ViewDefinition& view) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+    invariant(opCtx->lockState()->isCollectionLockedForMode(view.viewOn(), MODE_S));
+    invariant(opCtx->lockState()->isCollectionLockedForMode(view.materializedNss(), MODE_X));
+
+    const Collection* source =
+        CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, view.viewOn());
+    if (!source) {
+        return Status(ErrorCodes::NamespaceNotFound,
+                      str::stream() << "Cannot materialize view " << view.name()
+                                    << " because collection " << view.viewOn()
+                                    << " does not exist");
+    }
+    if (!source->getRecordPreImages()) {
+        return Status(ErrorCodes::InvalidOptions,
+                      str::stream() << "Cannot materialize view " << view.name()
+                                    << " because collection " << view.viewOn()
+                                    << " does not record the pre-images of its updates; set its "
+                                       "'recordPreImages' option with collMod");
+    }
+
+    CollectionOptions options;
+    if (view.defaultCollator()) {
+        options.collation = view.defaultCollator()->getSpec().toBSON();
+    }
+    Status status = db->userCreateNS(opCtx, view.materializedNss(), options);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    try {
+        std::vector<BSONObj> batch;
+        auto cursor = source->getCursor(opCtx);
+        while (auto record = cursor->next()) {
+            batch.push_back(record->data.toBson().getOwned());
+            if (batch.size() == kBuildBatchSize) {
+                applyChanges(opCtx, view, batch, {});
+                batch.clear();
+            }
+        }
+        applyChanges(opCtx, view, batch, {});
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+    return Status::OK();
+}
+
+void applyChanges(OperationContext* opCtx,
+                  const ViewDefinition& view,
+                  const std::vector<BSONObj>& inserted,
+                  const std::vector<BSONObj>& deleted) {
+    if (inserted.empty() && deleted.empty()) {
+        return;
+    }
+
+    Lock::CollectionLock materializedLock(opCtx, view.materializedNss(), MODE_IX);
+    const Collection* coll =
+        CollectionCatalog::get(opCtx).lookupCollectionByNamespace(opCtx, view.materializedNss());
+    if (!coll) {
+        // The view is being created or dropped by another operation.
+        return;
+    }
+
+    auto expCtx = make_intrusive<ExpressionContext>(
+        opCtx,
+        view.defaultCollator() ? view.defaultCollator()->clone() : nullptr,
+        view.viewOn(),
+        boost::none /* runtimeConstants */,
+        boost::none /* letParameters */,
+        false /* mayDbProfile */);
+    const auto deltaPipeline = makeDeltaPipeline(view);
+
+    // Apply the insertions first, so that a group isn't removed while an update moves documents
+    // within it.
+    for (auto&& group : groupDocuments(expCtx, deltaPipeline, inserted)) {
+        applyGroup(opCtx, expCtx.get(), coll, group, false /* deleted */);
+    }
+    for (auto&& group : groupDocuments(expCtx, deltaPipeline, deleted)) {
+        applyGroup(opCtx, expCtx.get(), coll, group, true /* deleted */);
+    }
+}
+
+}  // namespace materialized_view
+}  // namespace mongo
@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+
+namespace mongo {
+
+class Database;
+class OperationContext;
+class ViewDefinition;
+
+/**
+ * Keeps the collection which holds the results of a materialized view up to date. Each document of
+ * that collection is a group of the view's final $group stage, along with the number of documents
+ * of the view's 'viewOn' collection in the group. Since the view only has $sum accumulators, the
+ * changes to a collection are applied to its materialized views by grouping the changed documents
+ * and adding, or subtracting, their sums from the stored groups.
+ */
+namespace materialized_view {
+
+/**
+ * Creates the collection which holds the results of the materialized view 'view' and computes them
+ * from the documents 'view' is defined on. The caller must hold the view's 'viewOn' collection in
+ * MODE_S and its materialized collection in MODE_X, and be in a WriteUnitOfWork.
+ */
+Status materialize(OperationContext* opCtx, Database* db, const ViewDefinition& view);
+
+/**
+ * Applies the insertion of the documents 'inserted' and the deletion of the documents 'deleted' of
+ * the 'viewOn' collection of 'view' to its materialized collection. An update is applied as the
+ * deletion of its pre-image and the insertion of its post-image. Must be called in the
+ * WriteUnitOfWork which writes to the 'viewOn' collection.
+ */
+void applyChanges(OperationContext* opCtx,
+                  const ViewDefinition& view,
+                  const std::vector<BSONObj>& inserted,
+                  const std::vector<BSONObj>& deleted);
+
+}  // namespace materialized_view
+}  // namespace mongo
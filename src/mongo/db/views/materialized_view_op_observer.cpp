@@ -0,0 +1,147 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/views/materialized_view_op_observer.h"
+
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/views/materialized_view.h"
+#include "mongo/db/views/view_catalog.h"
+#include "mongo/util/assert_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// The document being deleted, set by aboutToDelete when the collection may have materialized views.
+const auto deletedDocDecoration = OperationContext::declareDecoration<boost::optional<BSONObj>>();
+
+/**
+ * Returns the catalog of the views of the database of 'nss' if the writes to 'nss' may have to be
+ * applied to materialized views.
+ */
+ViewCatalog* getViewCatalogToMaintain(OperationContext* opCtx,
+                                      const NamespaceString& nss,
+                                      bool fromMigrate) {
+    if (fromMigrate || !opCtx->writesAreReplicated() || nss.isSystem()) {
+        return nullptr;
+    }
+    auto db = DatabaseHolder::get(opCtx)->getDb(opCtx, nss.db());
+    if (!db) {
+        return nullptr;
+    }
+    auto viewCatalog = ViewCatalog::get(db);
+    return viewCatalog && viewCatalog->hasMaterializedViews() ? viewCatalog : nullptr;
+}
+
+void applyChanges(OperationContext* opCtx,
+                  const NamespaceString& nss,
+                  bool fromMigrate,
+                  const std::vector<BSONObj>& inserted,
+                  const std::vector<BSONObj>& deleted) {
+    auto viewCatalog = getViewCatalogToMaintain(opCtx, nss, fromMigrate);
+    if (!viewCatalog) {
+        return;
+    }
+    for (auto&& view : viewCatalog->lookupMaterializedViewsOn(opCtx, nss)) {
+        materialized_view::applyChanges(opCtx, *view, inserted, deleted);
+    }
+}
+
+}  // namespace
+
+void MaterializedViewOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           OptionalCollectionUUID uuid,
+                                           std::vector<InsertStatement>::const_iterator first,
+                                           std::vector<InsertStatement>::const_iterator last,
+                                           bool fromMigrate) {
+    if (!getViewCatalogToMaintain(opCtx, nss, fromMigrate)) {
+        return;
+    }
+
+    std::vector<BSONObj> inserted;
+    inserted.reserve(std::distance(first, last));
+    for (auto it = first; it != last; ++it) {
+        inserted.push_back(it->doc);
+    }
+    applyChanges(opCtx, nss, fromMigrate, inserted, {});
+}
+
+void MaterializedViewOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    const auto& updateArgs = args.updateArgs;
+    if (updateArgs.updatedDoc.isEmpty() ||
+        !getViewCatalogToMaintain(opCtx, args.nss, updateArgs.fromMigrate)) {
+        return;
+    }
+
+    uassert(5190281,
+            str::stream() << "Cannot update collection " << args.nss
+                          << " which has materialized views because it does not record the "
+                             "pre-images of its updates",
+            updateArgs.preImageDoc);
+    applyChanges(opCtx,
+                 args.nss,
+                 updateArgs.fromMigrate,
+                 {updateArgs.updatedDoc},
+                 {*updateArgs.preImageDoc});
+}
+
+void MaterializedViewOpObserver::aboutToDelete(OperationContext* opCtx,
+                                               const NamespaceString& nss,
+                                               const BSONObj& doc) {
+    auto& deletedDoc = deletedDocDecoration(opCtx);
+    deletedDoc = boost::none;
+
+    // Whether the deletion is from a migration is only known once it happens.
+    if (getViewCatalogToMaintain(opCtx, nss, false /* fromMigrate */)) {
+        deletedDoc = doc.getOwned();
+    }
+}
+
+void MaterializedViewOpObserver::onDelete(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          OptionalCollectionUUID uuid,
+                                          StmtId stmtId,
+                                          bool fromMigrate,
+                                          const boost::optional<BSONObj>& deletedDoc) {
+    auto doc = std::move(deletedDocDecoration(opCtx));
+    deletedDocDecoration(opCtx) = boost::none;
+    if (!doc) {
+        return;
+    }
+    applyChanges(opCtx, nss, fromMigrate, {}, {*doc});
+}
+
+}  // namespace mongo
@@ -111,6 +111,7 @@ AggregationRequest ResolvedView::asExpandedViewAggregation(
     expandedRequest.setUnwrappedReadPref(request.getUnwrappedReadPref());
     expandedRequest.setBypassDocumentValidation(request.shouldBypassDocumentValidation());
     expandedRequest.setAllowDiskUse(request.shouldAllowDiskUse());
+    expandedRequest.setReadOnce(request.isReadOnce());
     expandedRequest.setIsMapReduceCommand(request.getIsMapReduceCommand());
     expandedRequest.setLetParameters(request.getLetParameters());
 
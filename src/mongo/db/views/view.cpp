@@ -37,28 +37,42 @@
 
 namespace mongo {
 
+constexpr StringData ViewDefinition::kMaterializedCountField;
+
 ViewDefinition::ViewDefinition(StringData dbName,
                                StringData viewName,
                                StringData viewOnName,
                                const BSONObj& pipeline,
-                               std::unique_ptr<CollatorInterface> collator)
-    : _viewNss(dbName, viewName), _viewOnNss(dbName, viewOnName), _collator(std::move(collator)) {
+                               std::unique_ptr<CollatorInterface> collator,
+                               bool materialized)
+    : _viewNss(dbName, viewName),
+      _viewOnNss(dbName, viewOnName),
+      _collator(std::move(collator)),
+      _materialized(materialized) {
     for (BSONElement e : pipeline) {
         _pipeline.push_back(e.Obj().getOwned());
     }
+    if (_materialized) {
+        _materializedNss = NamespaceString(
+            dbName, NamespaceString::kMaterializedViewCollectionPrefix.toString() + viewName);
+    }
 }
 
 ViewDefinition::ViewDefinition(const ViewDefinition& other)
     : _viewNss(other._viewNss),
       _viewOnNss(other._viewOnNss),
       _collator(CollatorInterface::cloneCollator(other._collator.get())),
-      _pipeline(other._pipeline) {}
+      _pipeline(other._pipeline),
+      _materialized(other._materialized),
+      _materializedNss(other._materializedNss) {}
 
 ViewDefinition& ViewDefinition::operator=(const ViewDefinition& other) {
     _viewNss = other._viewNss;
     _viewOnNss = other._viewOnNss;
     _collator = CollatorInterface::cloneCollator(other._collator.get());
     _pipeline = other._pipeline;
+    _materialized = other._materialized;
+    _materializedNss = other._materializedNss;
 
     return *this;
 }
@@ -44,15 +44,23 @@ namespace mongo {
  */
 class ViewDefinition {
 public:
+    // The field of each result of a materialized view which holds the number of documents in its
+    // group. It is not returned by reads of the view.
+    static constexpr StringData kMaterializedCountField = "__count"_sd;
+
     /**
      * In the database 'dbName', create a new view 'viewName' on the view or collection
      * 'viewOnName'. Neither 'viewName' nor 'viewOnName' should include the name of the database.
+     *
+     * The results of a 'materialized' view are kept up to date in the collection named by
+     * materializedNss() as the documents of 'viewOnName' change, rather than computed on each read.
      */
     ViewDefinition(StringData dbName,
                    StringData viewName,
                    StringData viewOnName,
                    const BSONObj& pipeline,
-                   std::unique_ptr<CollatorInterface> collation);
+                   std::unique_ptr<CollatorInterface> collation,
+                   bool materialized = false);
 
     /**
      * Copying a view 'other' clones its collator and does a simple copy of all other fields.
@@ -90,6 +98,19 @@ public:
         return _collator.get();
     }
 
+    bool materialized() const {
+        return _materialized;
+    }
+
+    /**
+     * Returns the namespace of the collection which holds the results of this view. Only valid if
+     * the view is materialized.
+     */
+    const NamespaceString& materializedNss() const {
+        invariant(_materialized);
+        return _materializedNss;
+    }
+
     void setViewOn(const NamespaceString& viewOnNss);
 
     /**
@@ -102,5 +123,7 @@ private:
     NamespaceString _viewOnNss;
     std::unique_ptr<CollatorInterface> _collator;
     std::vector<BSONObj> _pipeline;
+    bool _materialized;
+    NamespaceString _materializedNss;
 };
 }  // namespace mongo
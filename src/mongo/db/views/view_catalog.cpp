@@ -33,6 +33,7 @@
 
 #include "mongo/db/views/view_catalog.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -90,7 +91,7 @@ Status ViewCatalog::reload(OperationContext* opCtx, ViewCatalogLookupBehavior lo
     return _reload(lk, opCtx, ViewCatalogLookupBehavior::kValidateDurableViews);
 }
 
-Status ViewCatalog::_reload(WithLock,
+Status ViewCatalog::_reload(WithLock lk,
                             OperationContext* opCtx,
                             ViewCatalogLookupBehavior lookupBehavior) {
     LOGV2_DEBUG(22546, 1, "Reloading view catalog for database", "db"_attr = _durable->getName());
@@ -118,11 +119,13 @@ Status ViewCatalog::_reload(WithLock,
             }
         }
 
-        _viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(viewName.db(),
-                                                                   viewName.coll(),
-                                                                   view["viewOn"].str(),
-                                                                   pipeline,
-                                                                   std::move(collator.getValue()));
+        _viewMap[viewName.ns()] =
+            std::make_shared<ViewDefinition>(viewName.db(),
+                                             viewName.coll(),
+                                             view["viewOn"].str(),
+                                             pipeline,
+                                             std::move(collator.getValue()),
+                                             view["materialized"].trueValue());
         return Status::OK();
     };
 
@@ -135,6 +138,7 @@ Status ViewCatalog::_reload(WithLock,
             MONGO_UNREACHABLE;
         }
     } catch (const DBException& ex) {
+        _updateNumMaterializedViews(lk);
         auto status = ex.toStatus();
         LOGV2(22547,
               "Could not load view catalog for database",
@@ -143,14 +147,22 @@ Status ViewCatalog::_reload(WithLock,
         return status;
     }
 
+    _updateNumMaterializedViews(lk);
     _valid = true;
     return Status::OK();
 }
 
+void ViewCatalog::_updateNumMaterializedViews(WithLock) {
+    _numMaterializedViews.store(std::count_if(_viewMap.begin(), _viewMap.end(), [](auto&& view) {
+        return view.second->materialized();
+    }));
+}
+
 void ViewCatalog::clear() {
     stdx::unique_lock<Latch> lk(_mutex);
 
     _viewMap.clear();
+    _numMaterializedViews.store(0);
     _viewGraph.clear();
     _valid = true;
     _viewGraphNeedsRefresh = false;
@@ -185,7 +197,8 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
                                         const NamespaceString& viewName,
                                         const NamespaceString& viewOn,
                                         const BSONArray& pipeline,
-                                        std::unique_ptr<CollatorInterface> collator) {
+                                        std::unique_ptr<CollatorInterface> collator,
+                                        bool materialized) {
     invariant(opCtx->lockState()->isDbLockedForMode(viewName.db(), MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(viewName, MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(
@@ -206,10 +219,24 @@ Status ViewCatalog::_createOrUpdateView(WithLock lk,
     if (collator) {
         viewDefBuilder.append("collation", collator->getSpec().toBSON());
     }
+    if (materialized) {
+        viewDefBuilder.append("materialized", true);
+    }
 
     BSONObj ownedPipeline = pipeline.getOwned();
-    auto view = std::make_shared<ViewDefinition>(
-        viewName.db(), viewName.coll(), viewOn.coll(), ownedPipeline, std::move(collator));
+    auto view = std::make_shared<ViewDefinition>(viewName.db(),
+                                                 viewName.coll(),
+                                                 viewOn.coll(),
+                                                 ownedPipeline,
+                                                 std::move(collator),
+                                                 materialized);
+
+    if (materialized) {
+        Status materializedStatus = _validateMaterializedView(lk, opCtx, *view);
+        if (!materializedStatus.isOK()) {
+            return materializedStatus;
+        }
+    }
 
     // Check that the resulting dependency graph is acyclic and within the maximum depth.
     Status graphStatus = _upsertIntoGraph(lk, opCtx, *(view.get()));
@@ -397,7 +424,8 @@ Status ViewCatalog::createView(OperationContext* opCtx,
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               const BSONObj& collation) {
+                               const BSONObj& collation,
+                               bool materialized) {
     invariant(opCtx->lockState()->isDbLockedForMode(viewName.db(), MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(viewName, MODE_IX));
     invariant(opCtx->lockState()->isCollectionLockedForMode(
@@ -422,7 +450,7 @@ Status ViewCatalog::createView(OperationContext* opCtx,
         return collator.getStatus();
 
     return _createOrUpdateView(
-        lk, opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()));
+        lk, opCtx, viewName, viewOn, pipeline, std::move(collator.getValue()), materialized);
 }
 
 Status ViewCatalog::modifyView(OperationContext* opCtx,
@@ -445,6 +473,10 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
         return Status(ErrorCodes::NamespaceNotFound,
                       str::stream() << "cannot modify missing view " << viewName.ns());
 
+    if (viewPtr->materialized())
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      str::stream() << "cannot modify materialized view " << viewName.ns());
+
     if (!NamespaceString::validCollectionName(viewOn.coll()))
         return Status(ErrorCodes::InvalidNamespace,
                       str::stream() << "invalid name for 'viewOn': " << viewOn.coll());
@@ -463,7 +495,8 @@ Status ViewCatalog::modifyView(OperationContext* opCtx,
                                viewName,
                                viewOn,
                                pipeline,
-                               CollatorInterface::cloneCollator(savedDefinition.defaultCollator()));
+                               CollatorInterface::cloneCollator(savedDefinition.defaultCollator()),
+                               false);
 }
 
 Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& viewName) {
@@ -501,6 +534,9 @@ Status ViewCatalog::dropView(OperationContext* opCtx, const NamespaceString& vie
     opCtx->recoveryUnit()->onRollback([this, viewName, savedDefinition, opCtx, viewRid]() {
         this->_viewGraphNeedsRefresh = true;
         this->_viewMap[viewName.ns()] = std::make_shared<ViewDefinition>(savedDefinition);
+        if (savedDefinition.materialized()) {
+            this->_numMaterializedViews.fetchAndAdd(1);
+        }
         CollectionCatalog& catalog = CollectionCatalog::get(opCtx);
         catalog.addResource(viewRid, viewName.ns());
     });
@@ -551,6 +587,71 @@ std::shared_ptr<ViewDefinition> ViewCatalog::lookupWithoutValidatingDurableViews
     return _lookup(lk, opCtx, ns, ViewCatalogLookupBehavior::kAllowInvalidDurableViews);
 }
 
+std::vector<std::shared_ptr<ViewDefinition>> ViewCatalog::lookupMaterializedViewsOn(
+    OperationContext* opCtx, const NamespaceString& nss) {
+    Lock::CollectionLock systemViewsLock(
+        opCtx,
+        NamespaceString(_durable->getName(), NamespaceString::kSystemDotViewsCollectionName),
+        MODE_IS);
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    std::vector<std::shared_ptr<ViewDefinition>> views;
+    for (auto&& view : _viewMap) {
+        if (view.second->materialized() && view.second->viewOn() == nss) {
+            views.push_back(view.second);
+        }
+    }
+    return views;
+}
+
+Status ViewCatalog::_validateMaterializedView(WithLock lk,
+                                              OperationContext* opCtx,
+                                              const ViewDefinition& view) {
+    auto notSupported = [&](const std::string& reason) {
+        return Status(ErrorCodes::OptionNotSupportedOnView,
+                      str::stream() << "Cannot materialize view " << view.name() << ": " << reason);
+    };
+
+    if (_lookup(lk, opCtx, view.viewOn().ns(), ViewCatalogLookupBehavior::kValidateDurableViews) ||
+        view.viewOn().isSystem()) {
+        return notSupported("a materialized view must be defined on a user collection");
+    }
+
+    const auto& pipeline = view.pipeline();
+    if (pipeline.empty() || pipeline.back().firstElementFieldNameStringData() != "$group") {
+        return notSupported("the pipeline must end with a $group stage");
+    }
+    for (auto stage = pipeline.begin(); stage != pipeline.end() - 1; ++stage) {
+        if (stage->firstElementFieldNameStringData() != "$match") {
+            return notSupported("only $match stages may precede the $group stage");
+        }
+    }
+
+    // Each output field must be a sum, so that the change to each group can be computed from the
+    // documents which were inserted into or deleted from the collection.
+    const auto groupSpec = pipeline.back().firstElement();
+    if (groupSpec.type() != BSONType::Object) {
+        return notSupported("the $group specification must be an object");
+    }
+    for (auto&& field : groupSpec.Obj()) {
+        const auto fieldName = field.fieldNameStringData();
+        if (fieldName == "_id") {
+            continue;
+        }
+        if (fieldName == ViewDefinition::kMaterializedCountField) {
+            return notSupported(str::stream() << "the field name '" << fieldName
+                                              << "' is reserved");
+        }
+        if (field.type() != BSONType::Object || field.Obj().nFields() != 1 ||
+            field.Obj().firstElementFieldNameStringData() != "$sum") {
+            return notSupported(str::stream() << "the $group stage may only compute $sum "
+                                                 "accumulators, but '"
+                                              << fieldName << "' is not one");
+        }
+    }
+    return Status::OK();
+}
+
 StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                                                   const NamespaceString& nss) {
     Lock::CollectionLock systemViewsLock(
@@ -599,12 +700,23 @@ StatusWith<ResolvedView> ViewCatalog::resolveView(OperationContext* opCtx,
                      collation ? std::move(collation.get()) : CollationSpec::kSimpleSpec});
             }
 
-            resolvedNss = &view->viewOn();
             if (!collation) {
                 collation = view->defaultCollator() ? view->defaultCollator()->getSpec().toBSON()
                                                     : CollationSpec::kSimpleSpec;
             }
 
+            // The results of a materialized view are read from the collection which holds them,
+            // without the count of the documents in each group.
+            if (view->materialized()) {
+                resolvedNss = &view->materializedNss();
+                resolvedPipeline.insert(
+                    resolvedPipeline.begin(),
+                    BSON("$project" << BSON(ViewDefinition::kMaterializedCountField << 0)));
+                continue;
+            }
+
+            resolvedNss = &view->viewOn();
+
             // Prepend the underlying view's pipeline to the current working pipeline.
             const std::vector<BSONObj>& toPrepend = view->pipeline();
             resolvedPipeline.insert(resolvedPipeline.begin(), toPrepend.begin(), toPrepend.end());
@@ -44,6 +44,7 @@
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/db/views/view.h"
 #include "mongo/db/views/view_graph.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/string_map.h"
@@ -90,13 +91,18 @@ public:
      * database's catalog, so the check for an existing collection with the same name must be done
      * before calling createView.
      *
+     * A 'materialized' view must be defined on a collection by $match stages followed by a $group
+     * stage which only has $sum accumulators. This method does not create the collection which
+     * holds its results.
+     *
      * Must be in WriteUnitOfWork. View creation rolls back if the unit of work aborts.
      */
     Status createView(OperationContext* opCtx,
                       const NamespaceString& viewName,
                       const NamespaceString& viewOn,
                       const BSONArray& pipeline,
-                      const BSONObj& collation);
+                      const BSONObj& collation,
+                      bool materialized = false);
 
     /**
      * Drop the view named 'viewName'.
@@ -106,7 +112,8 @@ public:
     Status dropView(OperationContext* opCtx, const NamespaceString& viewName);
 
     /**
-     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'.
+     * Modify the view named 'viewName' to have the new 'viewOn' and 'pipeline'. Materialized views
+     * cannot be modified.
      *
      * Must be in WriteUnitOfWork. The modification rolls back if the unit of work aborts.
      */
@@ -128,6 +135,20 @@ public:
     std::shared_ptr<ViewDefinition> lookupWithoutValidatingDurableViews(OperationContext* opCtx,
                                                                         StringData nss);
 
+    /**
+     * Returns the materialized views defined on the collection 'nss'.
+     */
+    std::vector<std::shared_ptr<ViewDefinition>> lookupMaterializedViewsOn(
+        OperationContext* opCtx, const NamespaceString& nss);
+
+    /**
+     * Returns false if the catalog has no materialized views. Unlike the other methods, this
+     * doesn't lock the catalog, so that writes can cheaply skip looking for views to maintain.
+     */
+    bool hasMaterializedViews() const {
+        return _numMaterializedViews.load() > 0;
+    }
+
     /**
      * Resolve the views on 'nss', transforming the pipeline appropriately. This function returns a
      * fully-resolved view definition containing the backing namespace, the resolved pipeline and
@@ -162,7 +183,8 @@ private:
                                const NamespaceString& viewName,
                                const NamespaceString& viewOn,
                                const BSONArray& pipeline,
-                               std::unique_ptr<CollatorInterface> collator);
+                               std::unique_ptr<CollatorInterface> collator,
+                               bool materialized);
     /**
      * Parses the view definition pipeline, attempts to upsert into the view graph, and refreshes
      * the graph if necessary. Returns an error status if the resulting graph would be invalid.
@@ -185,6 +207,19 @@ private:
                               const ViewDefinition& view,
                               const std::vector<NamespaceString>& refs);
 
+    /**
+     * Returns Status::OK if the results of 'view' can be kept up to date as the documents of its
+     * 'viewOn' collection change. Otherwise, returns ErrorCodes::OptionNotSupportedOnView.
+     */
+    Status _validateMaterializedView(WithLock lk,
+                                     OperationContext* opCtx,
+                                     const ViewDefinition& view);
+
+    /**
+     * Recounts the materialized views in '_viewMap'.
+     */
+    void _updateNumMaterializedViews(WithLock);
+
     std::shared_ptr<ViewDefinition> _lookup(WithLock,
                                             OperationContext* opCtx,
                                             StringData ns,
@@ -207,5 +242,6 @@ private:
     ViewGraph _viewGraph;
     bool _viewGraphNeedsRefresh;
     bool _ignoreExternalChange;
+    AtomicWord<int> _numMaterializedViews{0};
 };
 }  // namespace mongo
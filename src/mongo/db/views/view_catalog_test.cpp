@@ -114,7 +114,8 @@ public:
                       const NamespaceString& viewName,
                       const NamespaceString& viewOn,
                       const BSONArray& pipeline,
-                      const BSONObj& collation) {
+                      const BSONObj& collation,
+                      bool materialized = false) {
         Lock::DBLock dbLock(operationContext(), viewName.db(), MODE_IX);
         Lock::CollectionLock collLock(operationContext(), viewName, MODE_IX);
         Lock::CollectionLock sysCollLock(
@@ -123,7 +124,8 @@ public:
             MODE_X);
 
         WriteUnitOfWork wuow(opCtx);
-        Status s = _viewCatalog->createView(opCtx, viewName, viewOn, pipeline, collation);
+        Status s =
+            _viewCatalog->createView(opCtx, viewName, viewOn, pipeline, collation, materialized);
         wuow.commit();
 
         return s;
@@ -673,6 +675,80 @@ TEST_F(ViewCatalogFixture, ResolveViewCorrectPipeline) {
     }
 }
 
+TEST_F(ViewCatalogFixture, MaterializedViewMustOnlyGroupSumsOfACollection) {
+    const NamespaceString viewName("db.view");
+    const NamespaceString viewOn("db.coll");
+    const auto match = BSON("$match" << BSON("a" << 1));
+    const auto group = BSON("$group" << BSON("_id"
+                                             << "$b"
+                                             << "total" << BSON("$sum"
+                                                                << "$c")));
+
+    const auto createMaterializedView = [&](const NamespaceString& on, BSONArray pipeline) {
+        return createView(operationContext(), viewName, on, pipeline, emptyCollation, true);
+    };
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              createMaterializedView(viewOn, BSON_ARRAY(match)));
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              createMaterializedView(viewOn, BSON_ARRAY(group << match)));
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              createMaterializedView(
+                  viewOn,
+                  BSON_ARRAY(BSON("$group" << BSON("_id"
+                                                   << "$b"
+                                                   << "top" << BSON("$max"
+                                                                    << "$c"))))));
+    const auto countGroup = BSON("$group" << BSON("_id"
+                                                  << "$b" << ViewDefinition::kMaterializedCountField
+                                                  << BSON("$sum" << 1)));
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              createMaterializedView(viewOn, BSON_ARRAY(countGroup)));
+
+    ASSERT_OK(createView(operationContext(), NamespaceString("db.other"), viewOn, {}, {}));
+    ASSERT_EQ(ErrorCodes::OptionNotSupportedOnView,
+              createMaterializedView(NamespaceString("db.other"), BSON_ARRAY(group)));
+    ASSERT_FALSE(getViewCatalog()->hasMaterializedViews());
+
+    ASSERT_OK(createMaterializedView(viewOn, BSON_ARRAY(match << match << group)));
+    ASSERT_TRUE(getViewCatalog()->hasMaterializedViews());
+
+    Lock::DBLock dbLock(operationContext(), "db", MODE_IX);
+    auto views = getViewCatalog()->lookupMaterializedViewsOn(operationContext(), viewOn);
+    ASSERT_EQ(1U, views.size());
+    ASSERT_EQ(viewName, views[0]->name());
+    ASSERT_EQ(NamespaceString("db.system.materialized.view"), views[0]->materializedNss());
+}
+
+TEST_F(ViewCatalogFixture, ResolveMaterializedViewReadsItsResults) {
+    const NamespaceString materialized("db.materialized");
+    const NamespaceString view("db.view");
+    const NamespaceString viewOn("db.coll");
+    const auto group = BSON("$group" << BSON("_id"
+                                             << "$b"
+                                             << "total" << BSON("$sum"
+                                                                << "$c")));
+    const auto match = BSON("$match" << BSON("total" << BSON("$gt" << 1)));
+
+    ASSERT_OK(createView(
+        operationContext(), materialized, viewOn, BSON_ARRAY(group), emptyCollation, true));
+    ASSERT_OK(
+        createView(operationContext(), view, materialized, BSON_ARRAY(match), emptyCollation));
+
+    Lock::DBLock dbLock(operationContext(), "db", MODE_IX);
+    auto resolvedView = getViewCatalog()->resolveView(operationContext(), view);
+    ASSERT_OK(resolvedView.getStatus());
+    ASSERT_EQ(NamespaceString("db.system.materialized.materialized"),
+              resolvedView.getValue().getNamespace());
+
+    std::vector<BSONObj> expected = {
+        BSON("$project" << BSON(ViewDefinition::kMaterializedCountField << 0)), match};
+    std::vector<BSONObj> result = resolvedView.getValue().getPipeline();
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        ASSERT_BSONOBJ_EQ(expected[i], result[i]);
+    }
+}
+
 TEST_F(ViewCatalogFixture, ResolveViewOnCollectionNamespace) {
     const NamespaceString collectionNamespace("db.coll");
 
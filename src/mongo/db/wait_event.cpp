@@ -0,0 +1,133 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/wait_event.h"
+
+#include "mongo/db/service_context.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+
+const auto kNumWaitEvents = static_cast<int>(WaitEvent::kNumWaitEvents);
+
+}  // namespace
+
+const OperationContext::Decoration<WaitEventStats> WaitEventStats::get =
+    OperationContext::declareDecoration<WaitEventStats>();
+
+WaitEventStats::CountersArray WaitEventStats::_globalCounters;
+
+StringData toString(WaitEvent event) {
+    switch (event) {
+        case WaitEvent::kTicket:
+            return "ticket"_sd;
+        case WaitEvent::kLock:
+            return "lock"_sd;
+        case WaitEvent::kPrepareConflict:
+            return "prepareConflict"_sd;
+        case WaitEvent::kNetwork:
+            return "network"_sd;
+        case WaitEvent::kInterruptibleWait:
+            return "interruptibleWait"_sd;
+        case WaitEvent::kNumWaitEvents:
+            break;
+    }
+    MONGO_UNREACHABLE;
+}
+
+bool WaitEventStats::beginWait(OperationContext* opCtx, WaitEvent event) {
+    if (_currentEvent.load() != -1) {
+        return false;
+    }
+
+    _currentWaitStart.store(opCtx->getServiceContext()->getTickSource()->getTicks());
+    _currentEvent.store(static_cast<int>(event));
+    return true;
+}
+
+void WaitEventStats::endWait(OperationContext* opCtx) {
+    const auto event = _currentEvent.load();
+    invariant(event >= 0 && event < kNumWaitEvents);
+
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    const auto micros = durationCount<Microseconds>(
+        tickSource->ticksTo<Microseconds>(tickSource->getTicks() - _currentWaitStart.load()));
+
+    for (auto counters : {&_counters[event], &_globalCounters[event]}) {
+        counters->count.fetchAndAddRelaxed(1);
+        counters->timeWaitingMicros.fetchAndAddRelaxed(micros);
+    }
+
+    _currentEvent.store(-1);
+}
+
+void WaitEventStats::report(BSONObjBuilder* builder) const {
+    _report(_counters, false, builder);
+}
+
+void WaitEventStats::reportCurrentWait(OperationContext* opCtx, BSONObjBuilder* builder) const {
+    const auto event = _currentEvent.load();
+    if (event == -1) {
+        return;
+    }
+
+    auto tickSource = opCtx->getServiceContext()->getTickSource();
+    const auto start = _currentWaitStart.load();
+    const auto now = tickSource->getTicks();
+
+    BSONObjBuilder waitBuilder(builder->subobjStart("waitingFor"));
+    waitBuilder.append("event", toString(static_cast<WaitEvent>(event)));
+    waitBuilder.append("waitingMicros",
+                       durationCount<Microseconds>(
+                           tickSource->ticksTo<Microseconds>(now > start ? now - start : 0)));
+}
+
+void WaitEventStats::reportGlobal(BSONObjBuilder* builder) {
+    _report(_globalCounters, true, builder);
+}
+
+void WaitEventStats::_report(const CountersArray& counters,
+                             bool includeEmpty,
+                             BSONObjBuilder* builder) {
+    for (int event = 0; event < kNumWaitEvents; ++event) {
+        const auto count = counters[event].count.loadRelaxed();
+        if (count == 0 && !includeEmpty) {
+            continue;
+        }
+
+        BSONObjBuilder eventBuilder(builder->subobjStart(toString(static_cast<WaitEvent>(event))));
+        eventBuilder.append("count", count);
+        eventBuilder.append("timeWaitingMicros", counters[event].timeWaitingMicros.loadRelaxed());
+    }
+}
+
+}  // namespace mongo
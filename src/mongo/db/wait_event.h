@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/tick_source.h"
+
+namespace mongo {
+
+/**
+ * The kinds of waits an operation can block on. Each wait is attributed to exactly one event.
+ */
+enum class WaitEvent : int {
+    kTicket,             // Waiting for a read or write ticket to enter the storage engine.
+    kLock,               // Waiting for a lock request to be granted.
+    kPrepareConflict,    // Waiting for a prepared transaction to commit or abort.
+    kNetwork,            // Waiting for responses to remote requests.
+    kInterruptibleWait,  // Any other wait on the operation's baton or a condition variable.
+
+    kNumWaitEvents
+};
+
+StringData toString(WaitEvent event);
+
+/**
+ * Records how many times, and for how long, an operation waited on each kind of WaitEvent, and
+ * which event it is currently waiting on, if any. Waits are also accumulated server-wide.
+ *
+ * Waits nest: a lock wait, for instance, blocks on the operation's condition variable. A wait which
+ * begins while another one is in progress is attributed to the outermost event only, so that the
+ * times of all events add up to at most the time the operation spent blocked.
+ *
+ * Only the thread running the operation begins and ends waits, but the stats may be reported from
+ * any thread holding the client lock, such as $currentOp.
+ */
+class WaitEventStats {
+public:
+    static const OperationContext::Decoration<WaitEventStats> get;
+
+    WaitEventStats() = default;
+
+    /**
+     * Marks the start of a wait on 'event'. Returns false without doing anything if a wait is
+     * already in progress, in which case endWait() must not be called.
+     */
+    bool beginWait(OperationContext* opCtx, WaitEvent event);
+
+    /**
+     * Marks the end of the wait begun by the last successful call to beginWait().
+     */
+    void endWait(OperationContext* opCtx);
+
+    /**
+     * Appends {<event>: {count: <n>, timeWaitingMicros: <t>}} for every event which was waited on.
+     */
+    void report(BSONObjBuilder* builder) const;
+
+    /**
+     * Appends the event currently waited on, and for how long, if a wait is in progress.
+     */
+    void reportCurrentWait(OperationContext* opCtx, BSONObjBuilder* builder) const;
+
+    /**
+     * Appends the waits of all operations since startup, in the format of report(). Events which
+     * were never waited on are included, so that the format is stable.
+     */
+    static void reportGlobal(BSONObjBuilder* builder);
+
+private:
+    struct Counters {
+        AtomicWord<long long> count{0};
+        AtomicWord<long long> timeWaitingMicros{0};
+    };
+
+    using CountersArray = std::array<Counters, static_cast<size_t>(WaitEvent::kNumWaitEvents)>;
+
+    static void _report(const CountersArray& counters, bool includeEmpty, BSONObjBuilder* builder);
+
+    // Accumulates the waits of all operations.
+    static CountersArray _globalCounters;
+
+    CountersArray _counters;
+
+    // The event currently waited on, or -1 when not waiting.
+    AtomicWord<int> _currentEvent{-1};
+    AtomicWord<TickSource::Tick> _currentWaitStart{0};
+};
+
+/**
+ * RAII type which records the time spent in its scope as a wait on the given event. Does nothing
+ * when constructed without an OperationContext.
+ */
+class WaitEventTimer {
+    WaitEventTimer(const WaitEventTimer&) = delete;
+    WaitEventTimer& operator=(const WaitEventTimer&) = delete;
+
+public:
+    WaitEventTimer(OperationContext* opCtx, WaitEvent event)
+        : _opCtx(opCtx), _active(opCtx && WaitEventStats::get(opCtx).beginWait(opCtx, event)) {}
+
+    ~WaitEventTimer() {
+        if (_active) {
+            WaitEventStats::get(_opCtx).endWait(_opCtx);
+        }
+    }
+
+private:
+    OperationContext* const _opCtx;
+    const bool _active;
+};
+
+}  // namespace mongo
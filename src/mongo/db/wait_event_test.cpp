@@ -0,0 +1,138 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/wait_event.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/service_context.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/tick_source_mock.h"
+
+namespace mongo {
+namespace {
+
+class WaitEventTest : public unittest::Test {
+public:
+    void setUp() {
+        service = ServiceContext::make();
+        auto uniqueTickSource = std::make_unique<TickSourceMock<Microseconds>>();
+        tickSource = uniqueTickSource.get();
+        service->setTickSource(std::move(uniqueTickSource));
+        client = service->makeClient("WaitEventTest");
+    }
+
+    ServiceContext::UniqueServiceContext service;
+    ServiceContext::UniqueClient client;
+    TickSourceMock<Microseconds>* tickSource;
+};
+
+TEST_F(WaitEventTest, RecordsCountAndTimePerEvent) {
+    auto opCtx = client->makeOperationContext();
+
+    {
+        WaitEventTimer waitTimer(opCtx.get(), WaitEvent::kLock);
+        tickSource->advance(Microseconds(10));
+    }
+    {
+        WaitEventTimer waitTimer(opCtx.get(), WaitEvent::kLock);
+        tickSource->advance(Microseconds(5));
+    }
+    {
+        WaitEventTimer waitTimer(opCtx.get(), WaitEvent::kTicket);
+        tickSource->advance(Microseconds(7));
+    }
+
+    BSONObjBuilder builder;
+    WaitEventStats::get(opCtx.get()).report(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("ticket" << BSON("count" << 1LL << "timeWaitingMicros" << 7LL) << "lock"
+                                    << BSON("count" << 2LL << "timeWaitingMicros" << 15LL)));
+}
+
+TEST_F(WaitEventTest, NestedWaitsAreAttributedToOutermostEvent) {
+    auto opCtx = client->makeOperationContext();
+
+    {
+        WaitEventTimer outer(opCtx.get(), WaitEvent::kLock);
+        tickSource->advance(Microseconds(3));
+        {
+            WaitEventTimer inner(opCtx.get(), WaitEvent::kInterruptibleWait);
+            tickSource->advance(Microseconds(4));
+        }
+    }
+
+    BSONObjBuilder builder;
+    WaitEventStats::get(opCtx.get()).report(&builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("lock" << BSON("count" << 1LL << "timeWaitingMicros" << 7LL)));
+}
+
+TEST_F(WaitEventTest, ReportsCurrentWait) {
+    auto opCtx = client->makeOperationContext();
+    auto& stats = WaitEventStats::get(opCtx.get());
+
+    {
+        BSONObjBuilder builder;
+        stats.reportCurrentWait(opCtx.get(), &builder);
+        ASSERT_BSONOBJ_EQ(builder.obj(), BSONObj());
+    }
+
+    WaitEventTimer waitTimer(opCtx.get(), WaitEvent::kNetwork);
+    tickSource->advance(Microseconds(20));
+
+    BSONObjBuilder builder;
+    stats.reportCurrentWait(opCtx.get(), &builder);
+    ASSERT_BSONOBJ_EQ(builder.obj(),
+                      BSON("waitingFor" << BSON("event"
+                                                << "network"
+                                                << "waitingMicros" << 20LL)));
+}
+
+TEST_F(WaitEventTest, GlobalReportIncludesAllEvents) {
+    BSONObjBuilder builder;
+    WaitEventStats::reportGlobal(&builder);
+    auto obj = builder.obj();
+
+    for (auto event : {WaitEvent::kTicket,
+                       WaitEvent::kLock,
+                       WaitEvent::kPrepareConflict,
+                       WaitEvent::kNetwork,
+                       WaitEvent::kInterruptibleWait}) {
+        ASSERT_TRUE(obj.hasField(toString(event))) << obj;
+    }
+}
+
+TEST_F(WaitEventTest, TimerWithoutOperationContextDoesNothing) {
+    WaitEventTimer waitTimer(nullptr, WaitEvent::kLock);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/catalog/multi_index_block_gen.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/client.h"
@@ -231,6 +232,70 @@ public:
     }
 };
 
+/** Keys generated on several threads during the collection scan all make it into the index. */
+class InsertBuildParallelKeyGeneration : public IndexBuildBase {
+public:
+    void run() {
+        const int originalNumThreads = maxIndexBuildKeyGenerationThreads.load();
+        maxIndexBuildKeyGenerationThreads.store(4);
+        ON_BLOCK_EXIT([&] { maxIndexBuildKeyGenerationThreads.store(originalNumThreads); });
+
+        AutoGetOrCreateDb dbRaii(_opCtx, _nss.db(), LockMode::MODE_IX);
+        boost::optional<Lock::CollectionLock> collLk;
+        collLk.emplace(_opCtx, _nss, LockMode::MODE_IX);
+        auto& coll = collection();
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            OpDebug* const nullOpDebug = nullptr;
+            for (int i = 0; i < kNumDocs; ++i) {
+                ASSERT_OK(coll->insertDocument(
+                    _opCtx,
+                    InsertStatement(BSON("_id" << i << "a" << BSON_ARRAY(i << -i - 1))),
+                    nullOpDebug,
+                    true));
+            }
+            wunit.commit();
+        }
+
+        MultiIndexBlock indexer;
+
+        const BSONObj spec = BSON("name"
+                                  << "a"
+                                  << "key" << BSON("a" << 1) << "v"
+                                  << static_cast<int>(kIndexVersion));
+
+        collLk.emplace(_opCtx, _nss, LockMode::MODE_X);
+        auto abortOnExit = makeGuard([&] {
+            indexer.abortIndexBuild(_opCtx, collection(), MultiIndexBlock::kNoopOnCleanUpFn);
+        });
+
+        ASSERT_OK(
+            indexer.init(_opCtx, collection(), spec, MultiIndexBlock::kNoopOnInitFn).getStatus());
+        ASSERT_OK(indexer.insertAllDocumentsInCollection(_opCtx, coll.get()));
+        ASSERT_OK(indexer.checkConstraints(_opCtx, coll.get()));
+
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            ASSERT_OK(indexer.commit(_opCtx,
+                                     coll.getWritableCollection(),
+                                     MultiIndexBlock::kNoopOnCreateEachFn,
+                                     MultiIndexBlock::kNoopOnCommitFn));
+            wunit.commit();
+        }
+        abortOnExit.dismiss();
+
+        auto desc = coll->getIndexCatalog()->findIndexByName(_opCtx, "a");
+        ASSERT(desc);
+        auto entry = coll->getIndexCatalog()->getEntry(desc);
+        ASSERT(entry->isMultikey());
+        ASSERT_EQUALS(2 * kNumDocs,
+                      entry->accessMethod()->getSortedDataInterface()->numEntries(_opCtx));
+    }
+
+private:
+    static constexpr int kNumDocs = 10 * 1000;
+};
+
 /** Index creation is killed if mayInterrupt is true. */
 class InsertBuildIndexInterrupt : public IndexBuildBase {
 public:
@@ -681,6 +746,7 @@ public:
         addIf<InsertBuildEnforceUnique<true>>();
         addIf<InsertBuildEnforceUnique<false>>();
 
+        add<InsertBuildParallelKeyGeneration>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIdIndexInterrupt>();
         add<SameSpecDifferentOption>();
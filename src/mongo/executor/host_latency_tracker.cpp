@@ -0,0 +1,71 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace executor {
+
+void HostLatencyTracker::record(const HostAndPort& host, Milliseconds latency) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& samples = _samples[host];
+    samples.push_back(latency);
+    if (samples.size() > kMaxSamplesPerHost) {
+        samples.pop_front();
+    }
+}
+
+boost::optional<Milliseconds> HostLatencyTracker::getPercentile(const HostAndPort& host,
+                                                                int percentile) const {
+    invariant(percentile >= 0 && percentile < 100);
+
+    std::vector<Milliseconds> samples;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _samples.find(host);
+        if (it == _samples.end() || it->second.size() < kMinSamplesForPercentile) {
+            return boost::none;
+        }
+        samples.assign(it->second.begin(), it->second.end());
+    }
+
+    auto nth = samples.begin() + samples.size() * percentile / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+}  // namespace executor
+}  // namespace mongo
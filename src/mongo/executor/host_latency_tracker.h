@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <deque>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
+
+namespace mongo {
+namespace executor {
+
+/**
+ * Keeps a sliding window of the most recent round trip latencies observed for each remote host and
+ * answers percentile queries over it. Used by the network interface to decide how long to wait
+ * before hedging a request to a given host.
+ *
+ * This class is thread-safe.
+ */
+class HostLatencyTracker {
+public:
+    // Number of most recent samples retained per host
+    static constexpr size_t kMaxSamplesPerHost = 128;
+
+    // Number of samples a host needs before percentiles are reported for it
+    static constexpr size_t kMinSamplesForPercentile = 16;
+
+    /**
+     * Records that a request to 'host' took 'latency' to complete.
+     */
+    void record(const HostAndPort& host, Milliseconds latency);
+
+    /**
+     * Returns the latency below which 'percentile' percent of the recent requests to 'host'
+     * completed, or boost::none if too few requests to 'host' have been recorded so far.
+     */
+    boost::optional<Milliseconds> getPercentile(const HostAndPort& host, int percentile) const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("HostLatencyTracker::_mutex");
+
+    stdx::unordered_map<HostAndPort, std::deque<Milliseconds>> _samples;
+};
+
+}  // namespace executor
+}  // namespace mongo
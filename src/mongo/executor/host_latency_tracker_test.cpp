@@ -0,0 +1,81 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/host_latency_tracker.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace executor {
+namespace {
+
+const HostAndPort kHost("host1", 27017);
+const HostAndPort kOtherHost("host2", 27017);
+
+TEST(HostLatencyTrackerTest, NoPercentileUntilEnoughSamples) {
+    HostLatencyTracker tracker;
+    ASSERT_FALSE(tracker.getPercentile(kHost, 95));
+
+    for (size_t i = 1; i < HostLatencyTracker::kMinSamplesForPercentile; ++i) {
+        tracker.record(kHost, Milliseconds(1));
+    }
+    ASSERT_FALSE(tracker.getPercentile(kHost, 95));
+
+    tracker.record(kHost, Milliseconds(1));
+    ASSERT_EQ(Milliseconds(1), *tracker.getPercentile(kHost, 95));
+    ASSERT_FALSE(tracker.getPercentile(kOtherHost, 95));
+}
+
+TEST(HostLatencyTrackerTest, ReturnsPercentileOfSamples) {
+    HostLatencyTracker tracker;
+    for (int i = 100; i > 0; --i) {
+        tracker.record(kHost, Milliseconds(i));
+    }
+
+    ASSERT_EQ(Milliseconds(1), *tracker.getPercentile(kHost, 0));
+    ASSERT_EQ(Milliseconds(51), *tracker.getPercentile(kHost, 50));
+    ASSERT_EQ(Milliseconds(96), *tracker.getPercentile(kHost, 95));
+}
+
+TEST(HostLatencyTrackerTest, OnlyKeepsMostRecentSamples) {
+    HostLatencyTracker tracker;
+    for (size_t i = 0; i < HostLatencyTracker::kMaxSamplesPerHost; ++i) {
+        tracker.record(kHost, Milliseconds(1000));
+    }
+    for (size_t i = 0; i < HostLatencyTracker::kMaxSamplesPerHost; ++i) {
+        tracker.record(kHost, Milliseconds(10));
+    }
+
+    ASSERT_EQ(Milliseconds(10), *tracker.getPercentile(kHost, 99));
+}
+
+}  // namespace
+}  // namespace executor
+}  // namespace mongo
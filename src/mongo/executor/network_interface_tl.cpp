@@ -537,8 +537,42 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         return Status::OK();
     }
 
+    // Hedge only once the first target has taken longer than its usual tail latency to respond. If
+    // too few of its latencies are known yet, hedge right away.
+    boost::optional<Milliseconds> hedgeDelay;
+    if (cmdState->delaysHedgedRequests() && request.target.size() > 1 &&
+        !targetHostsInAlphabeticalOrder) {
+        hedgeDelay =
+            _hostLatencies.getPercentile(request.target[0], request.hedgeOptions->delayPercentile);
+    }
+
     // Attempt to get a connection to every target host
     for (size_t idx = 0; idx < request.target.size(); ++idx) {
+        if (idx > 0 && hedgeDelay) {
+            std::shared_ptr<transport::ReactorTimer> hedgeTimer = _reactor->makeTimer();
+            hedgeTimer->waitUntil(now() + *hedgeDelay, baton)
+                .getAsync([this, cmdState = cmdState, hedgeTimer, idx](Status status) {
+                    if (!status.isOK()) {
+                        cmdState->requestManager->trySend(std::move(status), idx);
+                        return;
+                    }
+
+                    if (cmdState->finishLine.isReady()) {
+                        // A response arrived before the delay elapsed, so there is nothing to hedge
+                        return;
+                    }
+
+                    const auto& requestOnAny = cmdState->requestOnAny;
+                    _pool
+                        ->get(requestOnAny.target[idx], requestOnAny.sslMode, requestOnAny.timeout)
+                        .thenRunOn(_reactor)
+                        .getAsync([cmdState = cmdState, idx](auto swConn) {
+                            cmdState->requestManager->trySend(std::move(swConn), idx);
+                        });
+                });
+            continue;
+        }
+
         auto connFuture = _pool->get(request.target[idx], request.sslMode, request.timeout);
 
         // If connection future is ready or requests should be sent in order, send the request
@@ -827,6 +861,11 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
             returnConnection(status);
 
             auto commandStatus = getStatusFromCommandResult(response.data);
+            if (cmdState->delaysHedgedRequests() && commandStatus.isOK() && response.elapsed) {
+                interface()->_hostLatencies.record(
+                    host, duration_cast<Milliseconds>(*response.elapsed));
+            }
+
             // Ignore maxTimeMS expiration errors for hedged reads without triggering the finish
             // line.
             if (isHedge && commandStatus == ErrorCodes::MaxTimeMSExpired) {
@@ -34,6 +34,7 @@
 #include "mongo/client/async_client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/executor/connection_pool.h"
+#include "mongo/executor/host_latency_tracker.h"
 #include "mongo/executor/network_interface.h"
 #include "mongo/logv2/log_severity.h"
 #include "mongo/platform/mutex.h"
@@ -160,6 +161,13 @@ private:
             return requestOnAny.target.size();
         }
 
+        /**
+         * Return true if the hedged requests of this command wait on the latencies of the targets.
+         */
+        bool delaysHedgedRequests() const noexcept {
+            return requestOnAny.hedgeOptions && requestOnAny.hedgeOptions->delayPercentile > 0;
+        }
+
         NetworkInterfaceTL* interface;
 
         RemoteCommandRequestOnAny requestOnAny;
@@ -351,6 +359,10 @@ private:
 
     std::unique_ptr<rpc::EgressMetadataHook> _metadataHook;
 
+    // Recent latencies of the hosts targeted by hedged commands, used to decide how long to wait
+    // before sending their hedged requests
+    HostLatencyTracker _hostLatencies;
+
     // We start in kDefault, transition to kStarted after startup() is complete and enter kStopped
     // at the first call to shutdown()
     enum State : int {
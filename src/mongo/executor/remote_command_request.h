@@ -47,6 +47,9 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+        // When non-zero, the hedged requests are only sent if no response has arrived by the time
+        // this percentile of the recent latencies of the first target host has elapsed
+        int delayPercentile = 0;
     };
 
     enum FireAndForgetMode { kOn, kOff };
@@ -33,6 +33,7 @@
 
 #include "mongo/executor/thread_pool_task_executor.h"
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <iterator>
 #include <utility>
@@ -436,12 +437,12 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
     if (!swCbHandle.isOK())
         return swCbHandle;
     const auto cbState = _networkInProgressQueue.back();
+    lk.unlock();
     LOGV2_DEBUG(22607,
                 3,
                 "Scheduling remote command request: {request}",
                 "Scheduling remote command request",
                 "request"_attr = redact(scheduledRequest.toString()));
-    lk.unlock();
 
     auto commandStatus = _net->startCommand(
         swCbHandle.getValue(),
@@ -451,16 +452,16 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
             CallbackFn newCb = [cb, scheduledRequest, response](const CallbackArgs& cbData) {
                 remoteCommandFinished(cbData, cb, scheduledRequest, response);
             };
-            stdx::unique_lock<Latch> lk(_mutex);
-            if (_inShutdown_inlock()) {
-                return;
-            }
             LOGV2_DEBUG(22608,
                         3,
                         "Received remote response: {response}",
                         "Received remote response",
                         "response"_attr = redact(response.isOK() ? response.toString()
                                                                  : response.status.toString()));
+            stdx::unique_lock<Latch> lk(_mutex);
+            if (_inShutdown_inlock()) {
+                return;
+            }
             swap(cbState->callback, newCb);
             scheduleIntoPool_inlock(&_networkInProgressQueue, cbState->iter, std::move(lk));
         },
@@ -579,7 +580,9 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
-    std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    // Almost every caller hands over a single callback (one remote response, one alarm), so keep
+    // that case free of a heap allocation while '_mutex' is held.
+    boost::container::small_vector<std::shared_ptr<CallbackState>, 1> todo(begin, end);
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
@@ -647,8 +650,11 @@ void ThreadPoolTaskExecutor::runCallback(std::shared_ptr<CallbackState> cbStateA
         callback(std::move(args));
     }
     cbStateArg->isFinished.store(true);
+    // Splice the finished entry out rather than erasing it so that the list node is freed after
+    // '_mutex' has been released.
+    WorkQueue finished;
     stdx::lock_guard<Latch> lk(_mutex);
-    _poolInProgressQueue.erase(cbStateArg->iter);
+    finished.splice(finished.end(), _poolInProgressQueue, cbStateArg->iter);
     if (cbStateArg->finishedCondition) {
         cbStateArg->finishedCondition->notify_all();
     }
@@ -32,13 +32,19 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
+#include <vector>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/string_map.h"
 
 
@@ -65,19 +71,63 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
         file->put('\n');
     return file;
 }
+
+/**
+ * Formats a line the way the server would log it, for messages that the sink itself has to write
+ * out.
+ */
+std::string formatSinkMessage(LogTimestampFormat timestampFormat,
+                              LogSeverity severity,
+                              int32_t id,
+                              StringData message,
+                              const DynamicAttributes& attrs) {
+    fmt::memory_buffer buffer;
+    JSONFormatter(nullptr, timestampFormat)
+        .format(buffer,
+                severity,
+                LogComponent::kControl,
+                Date_t::now(),
+                id,
+                getThreadName(),
+                message,
+                TypeErasedAttributeStorage(attrs),
+                LogTag::kNone,
+                LogTruncation::Disabled);
+    return fmt::to_string(buffer);
+}
 }  // namespace
 
 struct FileRotateSink::Impl {
     Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Serializes use of the streams between consume(), rotate() and the async writer thread.
+    stdx::mutex streamsMutex;  // NOLINT
+
+    // State shared with the async writer thread, all guarded by 'queueMutex'.
+    stdx::mutex queueMutex;  // NOLINT
+    stdx::condition_variable queuedCV;
+    stdx::condition_variable writtenCV;
+    stdx::thread writer;
+    std::vector<std::string> queued;
+    size_t queuedBytes = 0;
+    size_t maxQueuedBytes = 0;
+    bool dropOnOverflow = false;
+    bool stopping = false;
+    uint64_t numQueued = 0;
+    uint64_t numWritten = 0;
+    uint64_t numDropped = 0;
 };
 
 FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
     : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+FileRotateSink::~FileRotateSink() {
+    stopAsyncWriter();
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -87,6 +137,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -95,6 +146,7 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -138,10 +190,130 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
     return Status::OK();
 }
 
+void FileRotateSink::startAsyncWriter(size_t maxBufferedBytes, bool dropOnOverflow) {
+    stopAsyncWriter();
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
+        // The writer flushes once per batch instead.
+        auto_flush(false);
+    }
+    _impl->maxQueuedBytes = maxBufferedBytes;
+    _impl->dropOnOverflow = dropOnOverflow;
+    _impl->writer = stdx::thread([this] { _runAsyncWriter(); });
+}
+
+void FileRotateSink::stopAsyncWriter() {
+    if (!_impl->writer.joinable()) {
+        return;
+    }
+
+    {
+        stdx::lock_guard<stdx::mutex> lk(_impl->queueMutex);
+        _impl->stopping = true;
+    }
+    _impl->queuedCV.notify_one();
+    _impl->writer.join();
+    _impl->stopping = false;
+
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
+    auto_flush(true);
+}
+
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
+    if (!_impl->writer.joinable()) {
+        stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        _abortIfWriteFailed();
+        return;
+    }
+
+    // The process may go down right after logging an error, so don't leave those in the buffer.
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    const bool waitForWrite = severity && severity.get() >= LogSeverity::Error();
+
+    stdx::unique_lock<stdx::mutex> lk(_impl->queueMutex);
+    auto hasRoom = [&] {
+        return _impl->queued.empty() ||
+            _impl->queuedBytes + formatted_string.size() <= _impl->maxQueuedBytes;
+    };
+    if (!hasRoom()) {
+        if (_impl->dropOnOverflow && !waitForWrite) {
+            ++_impl->numDropped;
+            return;
+        }
+        _impl->writtenCV.wait(lk, hasRoom);
+    }
+
+    _impl->queued.push_back(formatted_string);
+    _impl->queuedBytes += formatted_string.size();
+    const auto lineNumber = ++_impl->numQueued;
+    _impl->queuedCV.notify_one();
+
+    if (waitForWrite) {
+        _impl->writtenCV.wait(lk, [&] { return _impl->numWritten >= lineNumber; });
+    }
+}
+
+void FileRotateSink::flush() {
+    if (_impl->writer.joinable()) {
+        stdx::unique_lock<stdx::mutex> lk(_impl->queueMutex);
+        const auto numQueued = _impl->numQueued;
+        _impl->writtenCV.wait(lk, [&] { return _impl->numWritten >= numQueued; });
+    }
+
+    stdx::lock_guard<stdx::mutex> lk(_impl->streamsMutex);
+    boost::log::sinks::text_ostream_backend::flush();
+}
+
+void FileRotateSink::_runAsyncWriter() {
+    stdx::unique_lock<stdx::mutex> lk(_impl->queueMutex);
+    while (true) {
+        _impl->queuedCV.wait(lk, [&] { return _impl->stopping || !_impl->queued.empty(); });
+        if (_impl->queued.empty()) {
+            return;
+        }
+
+        auto batch = std::exchange(_impl->queued, {});
+        auto numDropped = std::exchange(_impl->numDropped, 0);
+        _impl->queuedBytes = 0;
+        lk.unlock();
+        // Wake up the loggers waiting for room in the buffer.
+        _impl->writtenCV.notify_all();
+
+        {
+            stdx::lock_guard<stdx::mutex> streamsLk(_impl->streamsMutex);
+            if (numDropped > 0) {
+                DynamicAttributes attrs;
+                attrs.add("numDropped", numDropped);
+                // Commented out log line below to get validation of the log id with the
+                // errorcodes linter LOGV2_WARNING(5191140, "Dropped log lines because the
+                // asynchronous log writer fell behind");
+                boost::log::sinks::text_ostream_backend::consume(
+                    boost::log::record_view(),
+                    formatSinkMessage(_impl->timestampFormat,
+                                      LogSeverity::Warning(),
+                                      5191140,
+                                      "Dropped log lines because the asynchronous log writer "
+                                      "fell behind",
+                                      attrs));
+            }
+            for (const auto& line : batch) {
+                boost::log::sinks::text_ostream_backend::consume(boost::log::record_view(), line);
+            }
+            boost::log::sinks::text_ostream_backend::flush();
+            _abortIfWriteFailed();
+        }
+
+        lk.lock();
+        _impl->numWritten += batch.size();
+        _impl->writtenCV.notify_all();
+    }
+}
+
+void FileRotateSink::_abortIfWriteFailed() {
     auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
     if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
         try {
             auto failedBegin =
@@ -159,21 +331,14 @@ void FileRotateSink::consume(const boost::log::record_view& rec,
             DynamicAttributes attrs;
             attrs.add("files", sequence);
 
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
             // Commented out log line below to get validation of the log id with the errorcodes
             // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cout << StringData(buffer.data(), buffer.size()) << std::endl;
+            std::cout << formatSinkMessage(_impl->timestampFormat,
+                                           LogSeverity::Severe(),
+                                           4522200,
+                                           "Writing to log file failed, aborting application",
+                                           attrs)
+                      << std::endl;
         } catch (...) {
             // If the formatting code throws for any reason, ignore and proceed with aborting the
             // application.
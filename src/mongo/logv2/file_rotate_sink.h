@@ -50,9 +50,31 @@ public:
 
     Status rotate(bool rename, StringData renameSuffix);
 
+    /**
+     * Hands formatted lines to a background thread that writes them to the files in batches,
+     * flushing once per batch, so that logging threads do not wait on file I/O or on each other.
+     * At most 'maxBufferedBytes' of lines are held in memory. When that is full, logging threads
+     * wait for the writer to catch up, or discard their line if 'dropOnOverflow' is set. Lines of
+     * severity Error and above are always written out before consume() returns for them.
+     *
+     * Neither this nor stopAsyncWriter() may run concurrently with consume(), so the writer should
+     * be started before the sink is added to the logging core.
+     */
+    void startAsyncWriter(size_t maxBufferedBytes, bool dropOnOverflow);
+
+    /**
+     * Writes out any buffered lines and stops the background writer, if one is running.
+     */
+    void stopAsyncWriter();
+
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    void flush();
+
 private:
+    void _runAsyncWriter();
+    void _abortIfWriteFailed();
+
     struct Impl;
     std::unique_ptr<Impl> _impl;
 };
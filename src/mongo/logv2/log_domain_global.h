@@ -39,12 +39,17 @@ public:
     struct ConfigurationOptions {
         enum class RotationMode { kRename, kReopen };
         enum class OpenMode { kTruncate, kAppend };
+        enum class AsyncOverflowPolicy { kBlock, kDrop };
 
         bool consoleEnabled{true};
         bool fileEnabled{false};
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // Write to the log file from a background thread, see FileRotateSink::startAsyncWriter().
+        bool fileAsync{false};
+        size_t fileAsyncBufferBytes{16 * 1024 * 1024};
+        AsyncOverflowPolicy fileAsyncOverflowPolicy{AsyncOverflowPolicy::kBlock};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
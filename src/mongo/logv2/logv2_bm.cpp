@@ -36,6 +36,7 @@
 #include "mongo/platform/basic.h"
 
 #include <benchmark/benchmark.h>
+#include <boost/filesystem.hpp>
 #include <boost/iostreams/device/null.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <boost/log/sinks/sync_frontend.hpp>
@@ -97,6 +98,38 @@ private:
     bool _shouldInit;
 };
 
+// RAII style helper class that logs to a file through the global domain's file sink, as the server
+// does when started with --logpath.
+class ScopedFileLogV2Bench {
+public:
+    ScopedFileLogV2Bench(benchmark::State& state, bool async) {
+        _shouldInit = state.thread_index == 0;
+        if (_shouldInit) {
+            _path = boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("logv2_bm-%%%%-%%%%.log");
+
+            logv2::LogDomainGlobal::ConfigurationOptions config;
+            config.consoleEnabled = false;
+            config.fileEnabled = true;
+            config.filePath = _path.string();
+            config.fileAsync = async;
+            invariant(
+                logv2::LogManager::global().getGlobalDomainInternal().configure(config).isOK());
+        }
+    }
+
+    ~ScopedFileLogV2Bench() {
+        if (_shouldInit) {
+            invariant(logv2::LogManager::global().getGlobalDomainInternal().configure({}).isOK());
+            boost::filesystem::remove(_path);
+        }
+    }
+
+private:
+    boost::filesystem::path _path;
+    bool _shouldInit;
+};
+
 // "Expensive" way to create a string.
 std::string createLongString() {
     return std::string(1000, 'a') + std::string(1000, 'b') + std::string(1000, 'c') +
@@ -150,6 +183,20 @@ void BM_EnabledLogV2ManySmallArg(benchmark::State& state) {
     }
 }
 
+void BM_FileLogV2(benchmark::State& state) {
+    ScopedFileLogV2Bench init(state, false);
+
+    for (auto _ : state)
+        LOGV2(5191141, "file log {}", "i"_attr = 1);
+}
+
+void BM_FileLogV2Async(benchmark::State& state) {
+    ScopedFileLogV2Bench init(state, true);
+
+    for (auto _ : state)
+        LOGV2(5191142, "async file log {}", "i"_attr = 1);
+}
+
 void ThreadCounts(benchmark::internal::Benchmark* b) {
     int tc[] = {1, 2, 4, 8};
     for (int t : tc)
@@ -161,6 +208,8 @@ BENCHMARK(BM_NoopLogV2Arg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ExpensiveArg)->Apply(ThreadCounts);
 BENCHMARK(BM_EnabledLogV2ManySmallArg)->Apply(ThreadCounts);
+BENCHMARK(BM_FileLogV2)->Apply(ThreadCounts);
+BENCHMARK(BM_FileLogV2Async)->Apply(ThreadCounts);
 
 }  // namespace
 }  // namespace mongo
@@ -182,8 +182,13 @@ OpMsg OpMsg::parse(const Message& message) try {
                         !msg.getSequence(name));  // TODO IDL
 
                 msg.sequences.push_back({name.toString()});
+                if (serverGlobalParams.objcheck) {
+                    // Validate all documents of the sequence in one pass.
+                    uassertStatusOK(validateBSONSequence(static_cast<const char*>(seqBuf.pos()),
+                                                         seqBuf.remaining()));
+                }
                 while (!seqBuf.atEof()) {
-                    msg.sequences.back().objs.push_back(seqBuf.read<Validated<BSONObj>>());
+                    msg.sequences.back().objs.push_back(seqBuf.read<BSONObj>());
                 }
                 break;
             }
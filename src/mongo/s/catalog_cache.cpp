@@ -398,9 +398,46 @@ void CatalogCache::invalidateCollectionEntry_LINEARIZABLE(const NamespaceString&
     _collectionCache.invalidate(nss);
 }
 
+std::vector<std::pair<NamespaceString, ChunkVersion>>
+CatalogCache::getCachedShardedCollectionVersions() {
+    std::vector<std::pair<NamespaceString, ChunkVersion>> versions;
+    for (const auto& cachedItem : _collectionCache.getCacheInfo()) {
+        auto collectionEntry = _collectionCache.peekLatestCached(cachedItem.key);
+        if (collectionEntry && collectionEntry->optRt) {
+            versions.emplace_back(cachedItem.key, collectionEntry->optRt->getVersion());
+        }
+    }
+    return versions;
+}
+
+void CatalogCache::prefetchCollectionRoutingInfo(const NamespaceString& nss,
+                                                 const ChunkVersion& latestVersion) {
+    auto collectionEntry = _collectionCache.peekLatestCached(nss);
+    if (!collectionEntry || !collectionEntry->optRt) {
+        return;
+    }
+
+    const auto& cachedVersion = collectionEntry->optRt->getVersion();
+    if (cachedVersion.epoch() == latestVersion.epoch() &&
+        !cachedVersion.isOlderThan(latestVersion)) {
+        return;
+    }
+
+    _stats.countRoutingTablePrefetches.addAndFetch(1);
+    _collectionCache.advanceTimeInStore(
+        nss, ComparableChunkVersion::makeComparableChunkVersion(latestVersion));
+
+    // Kick off the lookup now, so that it has likely completed by the time an operation targets
+    // the collection. The lookup keeps running after the future is dropped and any error is left
+    // to the next operation which acquires the entry to observe.
+    auto lookupFuture = _collectionCache.acquireAsync(nss, CacheCausalConsistency::kLatestKnown);
+}
+
 void CatalogCache::Stats::report(BSONObjBuilder* builder) const {
     builder->append("countStaleConfigErrors", countStaleConfigErrors.load());
 
+    builder->append("countRoutingTablePrefetches", countRoutingTablePrefetches.load());
+
     builder->append("totalRefreshWaitTimeMicros", totalRefreshWaitTimeMicros.load());
 
     if (isMongos()) {
@@ -285,6 +285,21 @@ public:
      */
     void invalidateCollectionEntry_LINEARIZABLE(const NamespaceString& nss);
 
+    /**
+     * Returns the namespaces of the sharded collections currently in the cache, together with the
+     * version of their cached routing tables.
+     */
+    std::vector<std::pair<NamespaceString, ChunkVersion>> getCachedShardedCollectionVersions();
+
+    /**
+     * Non-blocking method, which marks the cached routing table of 'nss' as older than
+     * 'latestVersion' and starts refreshing it in the background, without waiting for an operation
+     * to target the collection. Does nothing if the cached routing table is already at least as
+     * recent. Used to learn of chunk changes before the shards report them through StaleConfig.
+     */
+    void prefetchCollectionRoutingInfo(const NamespaceString& nss,
+                                       const ChunkVersion& latestVersion);
+
 private:
     class DatabaseCache
         : public ReadThroughCache<std::string, DatabaseType, ComparableDatabaseVersion> {
@@ -370,6 +385,10 @@ private:
         // refreshes)
         AtomicWord<long long> countStaleConfigErrors{0};
 
+        // Counts how many routing table refreshes were started in the background because newer
+        // chunks were found on the config server
+        AtomicWord<long long> countRoutingTablePrefetches{0};
+
         // Cumulative, always-increasing counter of how much time threads waiting for refresh
         // combined
         AtomicWord<long long> totalRefreshWaitTimeMicros{0};
@@ -258,5 +258,35 @@ TEST_F(CatalogCacheTest, CheckEpochWithMatch) {
     _catalogCache->checkEpochOrThrow(kNss, collVersion, kShards[0]);
 }
 
+TEST_F(CatalogCacheTest, PrefetchCollectionRoutingInfoRefreshesStaleEntry) {
+    const auto dbVersion = DatabaseVersion();
+    const auto cachedCollVersion = ChunkVersion(1, 0, OID::gen());
+    const auto latestCollVersion = ChunkVersion(2, 0, cachedCollVersion.epoch());
+
+    loadDatabases({DatabaseType(kNss.db().toString(), kShards[0], true, dbVersion)});
+    loadCollection(cachedCollVersion);
+
+    // A version which is not newer than the cached one must not cause a refresh
+    _catalogCache->prefetchCollectionRoutingInfo(kNss, cachedCollVersion);
+
+    auto cachedVersions = _catalogCache->getCachedShardedCollectionVersions();
+    ASSERT_EQ(1U, cachedVersions.size());
+    ASSERT_EQ(kNss, cachedVersions[0].first);
+    ASSERT_EQ(cachedCollVersion, cachedVersions[0].second);
+
+    _catalogCacheLoader->setCollectionRefreshReturnValue(makeCollectionType(latestCollVersion));
+    _catalogCacheLoader->setChunkRefreshReturnValue(makeChunks(latestCollVersion));
+
+    _catalogCache->prefetchCollectionRoutingInfo(kNss, latestCollVersion);
+
+    const auto swChunkManager = _catalogCache->getCollectionRoutingInfo(operationContext(), kNss);
+    ASSERT_OK(swChunkManager.getStatus());
+    ASSERT_EQ(latestCollVersion, swChunkManager.getValue().getVersion());
+
+    cachedVersions = _catalogCache->getCachedShardedCollectionVersions();
+    ASSERT_EQ(1U, cachedVersions.size());
+    ASSERT_EQ(latestCollVersion, cachedVersions[0].second);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -33,38 +33,72 @@
 
 #include "mongo/s/chunk.h"
 
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/chunk_writes_tracker.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
+namespace {
+
+Mutex internedShardIdsMutex = MONGO_MAKE_LATCH("ChunkInfo::internedShardIdsMutex");
+
+/**
+ * Returns a pointer to the process-wide copy of 'shardId', which stays valid for the lifetime of
+ * the process. The set of shards in a cluster is small, so the table is never shrunk.
+ */
+const ShardId* internShardId(const ShardId& shardId) {
+    static auto& internedShardIds = *new stdx::unordered_set<ShardId, ShardId::Hasher>();
+
+    stdx::lock_guard<Latch> lk(internedShardIdsMutex);
+    return &*internedShardIds.insert(shardId).first;
+}
+
+boost::optional<Timestamp> getLatestValidAfter(const ChunkType& from) {
+    const auto& history = from.getHistory();
+    if (history.empty()) {
+        return boost::none;
+    }
+    return history.front().getValidAfter();
+}
+
+}  // namespace
 
 ChunkInfo::ChunkInfo(const ChunkType& from)
     : _range(from.getMin(), from.getMax()),
       _maxKeyString(ShardKeyPattern::toKeyString(from.getMax())),
-      _shardId(from.getShard()),
+      _shardId(internShardId(from.getShard())),
       _lastmod(from.getVersion()),
-      _history(from.getHistory()),
+      _latestValidAfter(getLatestValidAfter(from)),
+      _olderHistory([&] {
+          const auto& history = from.getHistory();
+          std::vector<HistoryEntry> olderHistory;
+          if (history.size() > 1) {
+              olderHistory.reserve(history.size() - 1);
+              for (auto it = std::next(history.begin()); it != history.end(); ++it) {
+                  olderHistory.push_back({it->getValidAfter(), internShardId(it->getShard())});
+              }
+          }
+          return olderHistory;
+      }()),
       _jumbo(from.getJumbo()),
       _writesTracker(std::make_shared<ChunkWritesTracker>()) {
+    // Validation also guarantees that the most recent history entry, whose shard is not stored
+    // separately, is on the chunk's current shard
     uassertStatusOK(from.validate());
 }
 
 const ShardId& ChunkInfo::getShardIdAt(const boost::optional<Timestamp>& ts) const {
-    // This chunk was refreshed from FCV 3.6 config server so it doesn't have history
-    if (_history.empty()) {
-        return _shardId;
-    }
-
-    // If the timestamp is not provided than we return the latest shardid
-    if (!ts) {
-        invariant(_shardId == _history.front().getShard());
-        return _history.front().getShard();
+    // This chunk was refreshed from FCV 3.6 config server so it doesn't have history. If the
+    // timestamp is not provided than we return the latest shardid.
+    if (!_latestValidAfter || !ts || *_latestValidAfter <= *ts) {
+        return *_shardId;
     }
 
-    for (const auto& h : _history) {
-        if (h.getValidAfter() <= ts) {
-            return h.getShard();
+    for (const auto& h : _olderHistory) {
+        if (h.validAfter <= *ts) {
+            return *h.shardId;
         }
     }
 
@@ -74,9 +108,9 @@ const ShardId& ChunkInfo::getShardIdAt(const boost::optional<Timestamp>& ts) con
 }
 
 void ChunkInfo::throwIfMovedSince(const Timestamp& ts) const {
-    uassert(50978, "Chunk has no history entries", !_history.empty());
+    uassert(50978, "Chunk has no history entries", _latestValidAfter);
 
-    const auto& latestValidAfter = _history.front().getValidAfter();
+    const auto& latestValidAfter = *_latestValidAfter;
     if (latestValidAfter <= ts) {
         return;
     }
@@ -84,20 +118,35 @@ void ChunkInfo::throwIfMovedSince(const Timestamp& ts) const {
     uassert(ErrorCodes::StaleChunkHistory,
             str::stream() << "Cannot find shardId the chunk belonged to at cluster time "
                           << ts.toString(),
-            _history.back().getValidAfter() <= ts);
+            !_olderHistory.empty() && _olderHistory.back().validAfter <= ts);
 
     uasserted(ErrorCodes::MigrationConflict,
               str::stream() << "Chunk has moved since timestamp: " << ts.toString()
                             << ", most recently at timestamp: " << latestValidAfter.toString());
 }
 
+std::vector<ChunkHistory> ChunkInfo::getHistory() const {
+    std::vector<ChunkHistory> history;
+    if (!_latestValidAfter) {
+        return history;
+    }
+
+    history.reserve(_olderHistory.size() + 1);
+    history.emplace_back(*_latestValidAfter, *_shardId);
+    for (const auto& h : _olderHistory) {
+        history.emplace_back(h.validAfter, *h.shardId);
+    }
+    return history;
+}
+
 bool ChunkInfo::containsKey(const BSONObj& shardKey) const {
     return getMin().woCompare(shardKey) <= 0 && shardKey.woCompare(getMax()) < 0;
 }
 
 std::string ChunkInfo::toString() const {
-    return str::stream() << ChunkType::shard() << ": " << _shardId << ", " << ChunkType::lastmod()
-                         << ": " << _lastmod.toString() << ", " << _range.toString();
+    return str::stream() << ChunkType::shard() << ": " << *_shardId << ", "
+                         << ChunkType::lastmod() << ": " << _lastmod.toString() << ", "
+                         << _range.toString();
 }
 
 void ChunkInfo::markAsJumbo() {
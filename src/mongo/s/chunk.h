@@ -75,9 +75,10 @@ public:
         return _lastmod;
     }
 
-    const auto& getHistory() const {
-        return _history;
-    }
+    /**
+     * Reconstructs the chunk's history entries, most recent first, from their compact form.
+     */
+    std::vector<ChunkHistory> getHistory() const;
 
     bool isJumbo() const {
         return _jumbo;
@@ -107,14 +108,31 @@ public:
     void markAsJumbo();
 
 private:
+    /**
+     * Compact form of a ChunkHistory entry, which refers to its shard through the process-wide
+     * table of interned shard ids rather than holding a copy of the id string.
+     */
+    struct HistoryEntry {
+        Timestamp validAfter;
+        const ShardId* shardId;
+    };
+
     const ChunkRange _range;
     const std::string _maxKeyString;
 
-    const ShardId _shardId;
+    // Points into the table of interned shard ids, which is never shrunk, so the many chunks owned
+    // by the same shard share a single copy of its id.
+    const ShardId* const _shardId;
 
     const ChunkVersion _lastmod;
 
-    const std::vector<ChunkHistory> _history;
+    // The 'validAfter' of the most recent history entry, which is always on '_shardId'. Not set if
+    // the chunk was refreshed from a config server that doesn't store history.
+    const boost::optional<Timestamp> _latestValidAfter;
+
+    // The remaining history entries, most recent first. Empty for chunks which have not moved
+    // within the history window, which is the common case.
+    const std::vector<HistoryEntry> _olderHistory;
 
     // Indicates whether this chunk should be treated as jumbo and not attempted to be moved or
     // split
@@ -159,7 +177,7 @@ public:
         return _chunkInfo.getLastmod();
     }
 
-    const auto& getHistory() const {
+    auto getHistory() const {
         return _chunkInfo.getHistory();
     }
 
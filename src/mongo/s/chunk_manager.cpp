@@ -76,6 +76,26 @@ void appendChunkTo(std::vector<std::shared_ptr<ChunkInfo>>& chunks,
     }
 }
 
+// Checks that "chunk", which follows "lastChunk" in the routing table, starts where "lastChunk"
+// ends.
+void checkChunksAreContiguous(const ChunkInfo& lastChunk, const ChunkInfo& chunk) {
+    const auto& lastMax = lastChunk.getMax();
+    const auto& min = chunk.getMin();
+    if (SimpleBSONObjComparator::kInstance.evaluate(lastMax == min))
+        return;
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(lastMax < min))
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Gap exists in the routing table between chunks "
+                                << lastChunk.getRange().toString() << " and "
+                                << chunk.getRange().toString());
+    else
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Overlap exists in the routing table between chunks "
+                                << lastChunk.getRange().toString() << " and "
+                                << chunk.getRange().toString());
+}
+
 // This function processes the passed in chunks by removing the older versions of any overlapping
 // chunks. The resulting chunks must be ordered by the maximum bound and not have any
 // overlapping chunks. In order to process the original set of chunks correctly which may have
@@ -115,88 +135,131 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 ShardVersionMap ChunkMap::constructShardVersionMap() const {
     ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
 
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
+    // The chunks within each block were checked for continuity when the block was built, so only
+    // the boundaries between blocks remain to be checked.
+    std::shared_ptr<ChunkInfo> lastChunk;
+    for (const auto& block : _chunkBlocks) {
+        const auto& firstChunk = block->chunks.front();
+        if (lastChunk &&
+            lastChunk->getShardIdAt(boost::none) != firstChunk->getShardIdAt(boost::none))
+            checkChunksAreContiguous(*lastChunk, *firstChunk);
+
+        lastChunk = block->chunks.back();
+
+        for (const auto& [shardId, blockShardVersion] : block->shardVersions) {
+            // Tracks the max shard version for the shard on which the block's chunks reside
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt = shardVersions.emplace(shardId, _collectionVersion.epoch()).first;
+            }
 
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (blockShardVersion > maxShardVersion)
+                maxShardVersion = blockShardVersion;
 
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt =
-                shardVersions.emplace(currentRangeShardId, _collectionVersion.epoch()).first;
+            // If a shard has chunks it must have a shard version, otherwise we have an invalid
+            // chunk somewhere, which should have been caught at chunk load time
+            invariant(maxShardVersion.isSet());
         }
+    }
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
+    if (!_chunkBlocks.empty()) {
+        invariant(!shardVersions.empty());
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+        checkAllElementsAreOfType(MinKey, _chunkBlocks.front()->chunks.front()->getMin());
+        checkAllElementsAreOfType(MaxKey, lastChunk->getMax());
+    }
 
-                             if (currentChunk->getLastmod() > maxShardVersion)
-                                 maxShardVersion = currentChunk->getLastmod();
+    return shardVersions;
+}
 
-                             return false;
-                         });
+bool ChunkMap::_lastChunkOverlaps(const ChunkVector& pendingChunks, const ChunkInfo& chunk) const {
+    if (!pendingChunks.empty())
+        return chunk.getRange().overlaps(pendingChunks.back()->getRange());
 
-        const auto rangeLast = *std::prev(current);
+    return !_chunkBlocks.empty() &&
+        chunk.getRange().overlaps(_chunkBlocks.back()->chunks.back()->getRange());
+}
 
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
+void ChunkMap::_appendChunk(ChunkVector& pendingChunks, const std::shared_ptr<ChunkInfo>& chunk) {
+    if (pendingChunks.empty() && _lastChunkOverlaps(pendingChunks, *chunk)) {
+        // The chunk may replace the last chunk of the last block, so that block has to be rebuilt.
+        pendingChunks = _chunkBlocks.back()->chunks;
+        _size -= pendingChunks.size();
+        _chunkBlocks.pop_back();
+    } else if (pendingChunks.size() == kMaxChunksPerBlock &&
+               !_lastChunkOverlaps(pendingChunks, *chunk)) {
+        _sealPendingChunks(pendingChunks);
+    }
 
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-        }
+    appendChunkTo(pendingChunks, chunk);
 
-        if (!firstMin)
-            firstMin = rangeMin;
+    _collectionVersion = std::max(_collectionVersion, chunk->getLastmod());
+}
 
-        lastMax = rangeMax;
+void ChunkMap::_appendBlock(ChunkVector& pendingChunks,
+                            const std::shared_ptr<const ChunkBlock>& block) {
+    if (!pendingChunks.empty() &&
+        pendingChunks.size() + block->chunks.size() <= kMaxChunksPerBlock) {
+        // Rather than leaving a small block behind, copy the chunks of the block.
+        pendingChunks.insert(pendingChunks.end(), block->chunks.begin(), block->chunks.end());
+    } else {
+        _sealPendingChunks(pendingChunks);
+        _chunkBlocks.push_back(block);
+        _size += block->chunks.size();
+    }
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+    for (const auto& [shardId, blockShardVersion] : block->shardVersions) {
+        _collectionVersion = std::max(_collectionVersion, blockShardVersion);
     }
+}
 
-    if (!_chunkMap.empty()) {
-        invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
+void ChunkMap::_sealPendingChunks(ChunkVector& pendingChunks) {
+    if (pendingChunks.empty())
+        return;
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+    // Merge the pending chunks into the last block if they fit, to keep blocks from shrinking as
+    // they get rebuilt by successive merges.
+    if (!_chunkBlocks.empty() &&
+        _chunkBlocks.back()->chunks.size() + pendingChunks.size() <= kMaxChunksPerBlock) {
+        const auto& lastBlockChunks = _chunkBlocks.back()->chunks;
+        pendingChunks.insert(pendingChunks.begin(), lastBlockChunks.begin(), lastBlockChunks.end());
+        _size -= lastBlockChunks.size();
+        _chunkBlocks.pop_back();
     }
 
-    return shardVersions;
-}
+    auto block = std::make_shared<ChunkBlock>();
+    for (size_t i = 0; i < pendingChunks.size(); ++i) {
+        const auto& chunk = pendingChunks[i];
+        const auto& shardId = chunk->getShardIdAt(boost::none);
+
+        // Check the continuity of the chunks map
+        if (i > 0 && pendingChunks[i - 1]->getShardIdAt(boost::none) != shardId)
+            checkChunksAreContiguous(*pendingChunks[i - 1], *chunk);
+
+        auto shardVersionIt =
+            std::find_if(block->shardVersions.begin(),
+                         block->shardVersions.end(),
+                         [&shardId](const auto& entry) { return entry.first == shardId; });
+        if (shardVersionIt == block->shardVersions.end()) {
+            block->shardVersions.emplace_back(shardId, chunk->getLastmod());
+        } else if (chunk->getLastmod() > shardVersionIt->second) {
+            shardVersionIt->second = chunk->getLastmod();
+        }
+    }
 
-void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    block->chunks = std::move(pendingChunks);
+    pendingChunks.clear();
 
-    _collectionVersion = std::max(_collectionVersion, chunk->getLastmod());
+    _size += block->chunks.size();
+    _chunkBlocks.push_back(std::move(block));
 }
 
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
     const auto it = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
+    if (it != _end())
         return *it;
 
     return std::shared_ptr<ChunkInfo>();
@@ -213,40 +276,65 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
+    size_t blockIndex = 0;
+    size_t chunkIndex = 0;
     size_t changedChunkIndex = 0;
 
-    ChunkMap updatedChunkMap(getVersion().epoch(), _chunkMap.size() + changedChunks.size());
+    ChunkMap updatedChunkMap(getVersion().epoch());
+    ChunkVector pendingChunks;
 
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
+    while (blockIndex < _chunkBlocks.size() || changedChunkIndex < changedChunks.size()) {
+        if (blockIndex >= _chunkBlocks.size()) {
             validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+            updatedChunkMap._appendChunk(pendingChunks, changedChunks[changedChunkIndex++]);
+            continue;
+        }
+
+        const auto& block = _chunkBlocks[blockIndex];
+        const auto& chunkInfo = block->chunks[chunkIndex];
+        auto advanceChunkIndex = [&] {
+            if (++chunkIndex == block->chunks.size()) {
+                ++blockIndex;
+                chunkIndex = 0;
+            }
+        };
+
+        // Share the blocks which end before the next changed chunk begins, unless the last chunk
+        // appended to the updated map overlaps them.
+        if (chunkIndex == 0 &&
+            (changedChunkIndex >= changedChunks.size() ||
+             block->chunks.back()->getMax().woCompare(
+                 changedChunks[changedChunkIndex]->getMin()) <= 0) &&
+            !updatedChunkMap._lastChunkOverlaps(pendingChunks, *chunkInfo)) {
+            updatedChunkMap._appendBlock(pendingChunks, block);
+            ++blockIndex;
             continue;
         }
 
         if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap._appendChunk(pendingChunks, chunkInfo);
+            advanceChunkIndex();
             continue;
         }
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+        auto overlap = chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange());
 
         if (overlap) {
             auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
 
             auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
             changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
             validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
+            updatedChunkMap._appendChunk(pendingChunks, changedChunk);
         } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap._appendChunk(pendingChunks, chunkInfo);
+            advanceChunkIndex();
         }
     }
 
+    updatedChunkMap._sealPendingChunks(pendingChunks);
+
     return updatedChunkMap;
 }
 
@@ -254,45 +342,48 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
+ChunkMap::ConstIterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                         bool isMaxInclusive) const {
     auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
-    }
+    // Whether the chunk ends before the one 'shardKey' falls into
+    auto endsBefore = [&](const std::shared_ptr<ChunkInfo>& chunkInfo) {
+        return isMaxInclusive ? !(shardKeyString < chunkInfo->getMaxKeyString())
+                              : chunkInfo->getMaxKeyString() < shardKeyString;
+    };
+
+    const auto blockIt = std::partition_point(
+        _chunkBlocks.begin(), _chunkBlocks.end(), [&](const auto& block) {
+            return endsBefore(block->chunks.back());
+        });
+    if (blockIt == _chunkBlocks.end())
+        return _end();
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto chunkIt = std::partition_point(chunks.begin(), chunks.end(), endsBefore);
+    return ConstIterator(
+        &_chunkBlocks, blockIt - _chunkBlocks.begin(), chunkIt - chunks.begin());
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+std::pair<ChunkMap::ConstIterator, ChunkMap::ConstIterator> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
     const auto itMin = _findIntersectingChunk(min);
     const auto itMax = [&]() {
         auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+        return it == _end() ? it : ++it;
     }();
 
     return {itMin, itMax};
@@ -74,13 +74,58 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // Run of consecutive chunks ordered by max key, along with the max chunk version of each shard
+    // owning any of them. Blocks are immutable once built and are shared between a map and the
+    // maps merged from it, so that merging a few changed chunks into a map only copies the blocks
+    // they overlap rather than all the chunks of the collection.
+    struct ChunkBlock {
+        ChunkVector chunks;
+        std::vector<std::pair<ShardId, ChunkVersion>> shardVersions;
+    };
+    using ChunkBlockVector = std::vector<std::shared_ptr<const ChunkBlock>>;
+
 public:
-    explicit ChunkMap(OID epoch, size_t initialCapacity = 0) : _collectionVersion(0, 0, epoch) {
-        _chunkMap.reserve(initialCapacity);
-    }
+    // Maximum number of chunks held by a block.
+    static constexpr size_t kMaxChunksPerBlock = 512;
+
+    /**
+     * Forward iterator over the chunks of the map, in ascending order of max key.
+     */
+    class ConstIterator {
+    public:
+        ConstIterator(const ChunkBlockVector* blocks, size_t blockIndex, size_t chunkIndex)
+            : _blocks(blocks), _blockIndex(blockIndex), _chunkIndex(chunkIndex) {}
+
+        const std::shared_ptr<ChunkInfo>& operator*() const {
+            return (*_blocks)[_blockIndex]->chunks[_chunkIndex];
+        }
+
+        ConstIterator& operator++() {
+            if (++_chunkIndex == (*_blocks)[_blockIndex]->chunks.size()) {
+                ++_blockIndex;
+                _chunkIndex = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return _blockIndex == other._blockIndex && _chunkIndex == other._chunkIndex;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const ChunkBlockVector* _blocks;
+        size_t _blockIndex;
+        size_t _chunkIndex;
+    };
+
+    explicit ChunkMap(OID epoch) : _collectionVersion(0, 0, epoch) {}
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -89,9 +134,9 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        auto it = shardKey.isEmpty() ? _begin() : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
+        for (; it != _end(); ++it) {
             if (!handler(*it))
                 break;
         }
@@ -113,19 +158,42 @@ public:
     ShardVersionMap constructShardVersionMap() const;
     std::shared_ptr<ChunkInfo> findIntersectingChunk(const BSONObj& shardKey) const;
 
-    void appendChunk(const std::shared_ptr<ChunkInfo>& chunk);
-
+    /**
+     * Returns a map with the chunks in "changedChunks" merged in, which shares with this map all
+     * the blocks none of the changed chunks overlap.
+     */
     ChunkMap createMerged(const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const;
 
     BSONObj toBSON() const;
 
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    ConstIterator _begin() const {
+        return ConstIterator(&_chunkBlocks, 0, 0);
+    }
+
+    ConstIterator _end() const {
+        return ConstIterator(&_chunkBlocks, _chunkBlocks.size(), 0);
+    }
+
+    ConstIterator _findIntersectingChunk(const BSONObj& shardKey,
+                                         bool isMaxInclusive = true) const;
+    std::pair<ConstIterator, ConstIterator> _overlappingBounds(const BSONObj& min,
+                                                               const BSONObj& max,
+                                                               bool isMaxInclusive) const;
+
+    /**
+     * Helpers used while building a map. Chunks are appended to "pendingChunks", which is turned
+     * into a new block whenever it is full, or before an existing block is appended to the map.
+     */
+    void _appendChunk(ChunkVector& pendingChunks, const std::shared_ptr<ChunkInfo>& chunk);
+    void _appendBlock(ChunkVector& pendingChunks, const std::shared_ptr<const ChunkBlock>& block);
+    void _sealPendingChunks(ChunkVector& pendingChunks);
+    bool _lastChunkOverlaps(const ChunkVector& pendingChunks, const ChunkInfo& chunk) const;
+
+    ChunkBlockVector _chunkBlocks;
 
-    ChunkVector _chunkMap;
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
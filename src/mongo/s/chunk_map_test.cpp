@@ -38,6 +38,7 @@ namespace {
 
 const NamespaceString kNss("TestDB", "TestColl");
 const ShardId kThisShard("testShard");
+const ShardId kOtherShard("otherShard");
 
 class ChunkMapTest : public unittest::Test {
 public:
@@ -165,4 +166,69 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeIntoChunksSpanningSeveralBlocks) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    const int numChunks = 3 * ChunkMap::kMaxChunksPerBlock;
+    auto bound = [&](int i) {
+        if (i == 0)
+            return getShardKeyPattern().globalMin();
+        if (i == numChunks)
+            return getShardKeyPattern().globalMax();
+        return BSON("a" << i * 10);
+    };
+    auto makeChunk = [&](BSONObj min, BSONObj max, const ShardId& shardId) {
+        auto chunk = std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{std::move(min), std::move(max)}, version, shardId});
+        version.incMinor();
+        return chunk;
+    };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        chunks.push_back(makeChunk(bound(i), bound(i + 1), kThisShard));
+    }
+    const auto chunkMap = ChunkMap{epoch}.createMerged(chunks);
+    ASSERT_EQ(chunkMap.size(), numChunks);
+
+    // Merge the two chunks around the boundary between the first two blocks, and split a chunk of
+    // the last block.
+    const int mergedIndex = ChunkMap::kMaxChunksPerBlock - 1;
+    const int splitIndex = numChunks - 10;
+    const auto merged = makeChunk(bound(mergedIndex), bound(mergedIndex + 2), kOtherShard);
+    const auto splitLeft =
+        makeChunk(bound(splitIndex), BSON("a" << splitIndex * 10 + 5), kThisShard);
+    const auto splitRight =
+        makeChunk(BSON("a" << splitIndex * 10 + 5), bound(splitIndex + 1), kThisShard);
+    const auto updatedChunkMap = chunkMap.createMerged({merged, splitLeft, splitRight});
+
+    ASSERT_EQ(updatedChunkMap.size(), numChunks);
+    ASSERT_EQ(updatedChunkMap.getVersion(), splitRight->getLastmod());
+
+    int count = 0;
+    auto lastMax = getShardKeyPattern().globalMin();
+    updatedChunkMap.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, numChunks);
+    ASSERT_BSONOBJ_EQ(lastMax, getShardKeyPattern().globalMax());
+
+    ASSERT_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << mergedIndex * 10 + 15)), merged);
+    ASSERT_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << splitIndex * 10 + 7)), splitRight);
+    ASSERT_EQ(updatedChunkMap.findIntersectingChunk(BSON("a" << 5)), chunks[0]);
+
+    const auto shardVersions = updatedChunkMap.constructShardVersionMap();
+    ASSERT_EQ(shardVersions.size(), 2UL);
+    ASSERT_EQ(shardVersions.at(kOtherShard).shardVersion, merged->getLastmod());
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion, splitRight->getLastmod());
+
+    // The original map is left untouched.
+    ASSERT_EQ(chunkMap.findIntersectingChunk(BSON("a" << mergedIndex * 10 + 15)),
+              chunks[mergedIndex + 1]);
+}
+
 }  // namespace mongo
\ No newline at end of file
@@ -126,5 +126,46 @@ TEST(ChunkTest, HasNoHistoryValidForPinnedTimestamp_MoreThanOneEntry) {
     ASSERT_THROWS_CODE(chunk.throwIfMoved(), AssertionException, ErrorCodes::StaleChunkHistory);
 }
 
+TEST(ChunkTest, ShardIdAtClusterTimeAndHistoryAreReconstructed) {
+    const OID epoch = OID::gen();
+    ChunkVersion version{1, 0, epoch};
+
+    ChunkType chunkType(kNss,
+                        ChunkRange{kShardKeyPattern.globalMin(), kShardKeyPattern.globalMax()},
+                        version,
+                        kShardOne);
+    chunkType.setHistory({ChunkHistory(Timestamp(102, 0), kShardOne),
+                          ChunkHistory(Timestamp(101, 0), kShardTwo),
+                          ChunkHistory(Timestamp(100, 0), kShardOne)});
+
+    ChunkInfo chunkInfo(chunkType);
+    ASSERT_EQ(kShardOne, chunkInfo.getShardIdAt(boost::none));
+    ASSERT_EQ(kShardOne, chunkInfo.getShardIdAt(Timestamp(103, 0)));
+    ASSERT_EQ(kShardTwo, chunkInfo.getShardIdAt(Timestamp(101, 5)));
+    ASSERT_EQ(kShardOne, chunkInfo.getShardIdAt(Timestamp(100, 0)));
+    ASSERT_THROWS_CODE(chunkInfo.getShardIdAt(Timestamp(99, 0)),
+                       AssertionException,
+                       ErrorCodes::StaleChunkHistory);
+    ASSERT(chunkInfo.getHistory() == chunkType.getHistory());
+}
+
+TEST(ChunkTest, ChunksOnTheSameShardShareTheShardId) {
+    const OID epoch = OID::gen();
+
+    ChunkType lowChunkType(kNss,
+                           ChunkRange{kShardKeyPattern.globalMin(), BSON("a" << 0)},
+                           ChunkVersion{1, 0, epoch},
+                           ShardId("shardOne"));
+    ChunkType highChunkType(kNss,
+                            ChunkRange{BSON("a" << 0), kShardKeyPattern.globalMax()},
+                            ChunkVersion{1, 1, epoch},
+                            ShardId("shardOne"));
+
+    ChunkInfo lowChunkInfo(lowChunkType);
+    ChunkInfo highChunkInfo(highChunkType);
+    ASSERT_EQ(&lowChunkInfo.getShardIdAt(boost::none), &highChunkInfo.getShardIdAt(boost::none));
+    ASSERT(lowChunkInfo.getHistory().empty());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,17 +31,86 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "mongo/s/chunk_writes_tracker.h"
+
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/platform/random.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+PseudoRandom& threadLocalRandom() {
+    thread_local PseudoRandom random(SecureRandom().nextInt64());
+    return random;
+}
+
+}  // namespace
 
 uint64_t ChunkWritesTracker::clearBytesWritten() {
     return _bytesWritten.swap(0);
 }
 
+void ChunkWritesTracker::addInsertedKey(const BSONObj& shardKey, uint64_t bytesInserted) {
+    _bytesInserted.fetchAndAdd(bytesInserted);
+    const auto keysBefore = _keysInserted.fetchAndAdd(1);
+
+    // Reservoir sampling: the n-th key replaces a random sampled key with probability
+    // kMaxSampledKeys / n, so that once the reservoir is full most insertions take no lock.
+    size_t slot = keysBefore;
+    if (keysBefore >= kMaxSampledKeys) {
+        slot = threadLocalRandom().nextInt64(keysBefore + 1);
+        if (slot >= kMaxSampledKeys) {
+            return;
+        }
+    }
+
+    auto ownedKey = shardKey.getOwned();
+    stdx::lock_guard<Latch> lk(_samplesMutex);
+    if (_sampledKeys.size() < kMaxSampledKeys) {
+        // Concurrent insertions may fill the reservoir out of order
+        _sampledKeys.push_back(std::move(ownedKey));
+    } else {
+        _sampledKeys[slot] = std::move(ownedKey);
+    }
+}
+
+std::vector<BSONObj> ChunkWritesTracker::getSampledSplitPoints(uint64_t maxChunkSize) {
+    const auto bytesInserted = getBytesInserted();
+    if (maxChunkSize == 0 || bytesInserted < maxChunkSize) {
+        return {};
+    }
+
+    std::vector<BSONObj> sortedKeys;
+    {
+        stdx::lock_guard<Latch> lk(_samplesMutex);
+        sortedKeys = _sampledKeys;
+    }
+    std::sort(
+        sortedKeys.begin(), sortedKeys.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+
+    const uint64_t targetChunkSize = std::max<uint64_t>(maxChunkSize / 2, 1);
+    const size_t numChunks =
+        std::min<uint64_t>((bytesInserted + targetChunkSize - 1) / targetChunkSize,
+                           sortedKeys.size() / kMinSampledKeysPerChunk);
+
+    // A split point equal to the smallest sampled key would leave next to no data to its left, and
+    // repeated keys must not produce the same split point twice
+    std::vector<BSONObj> splitPoints;
+    for (size_t i = 1; i < numChunks; ++i) {
+        const auto& key = sortedKeys[i * sortedKeys.size() / numChunks];
+        const auto& previousKey = splitPoints.empty() ? sortedKeys.front() : splitPoints.back();
+        if (SimpleBSONObjComparator::kInstance.evaluate(key == previousKey)) {
+            continue;
+        }
+        splitPoints.push_back(key);
+    }
+    return splitPoints;
+}
+
 bool ChunkWritesTracker::shouldSplit(uint64_t maxChunkSize) {
     if (_isLockedForSplitting) {
         return false;
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 
@@ -42,6 +45,13 @@ public:
      */
     static constexpr uint64_t kSplitTestFactor = 5;
 
+    /**
+     * The maximum number of shard keys kept in the sample of inserted documents, and the minimum
+     * number of sampled keys for each chunk that split points chosen from the sample would create.
+     */
+    static constexpr size_t kMaxSampledKeys = 512;
+    static constexpr size_t kMinSampledKeysPerChunk = 16;
+
     /**
      * Add more bytes written to the chunk.
      */
@@ -49,6 +59,13 @@ public:
         _bytesWritten.fetchAndAdd(bytesWritten);
     }
 
+    /**
+     * Counts one more write operation to the chunk and returns the total number of them.
+     */
+    uint64_t addOperation() {
+        return _operations.addAndFetch(1);
+    }
+
     /**
      * Returns the total number of bytes that have been written to the chunk.
      */
@@ -62,6 +79,28 @@ public:
      */
     uint64_t clearBytesWritten();
 
+    /**
+     * Records the insertion of a document of 'bytesInserted' bytes with the given shard key. The
+     * key is kept in a uniform random sample of at most kMaxSampledKeys of the inserted keys, which
+     * is maintained for as long as this chunk exists and is not reset by splitting attempts.
+     */
+    void addInsertedKey(const BSONObj& shardKey, uint64_t bytesInserted);
+
+    /**
+     * Returns the total number of bytes of the documents inserted into the chunk.
+     */
+    uint64_t getBytesInserted() {
+        return _bytesInserted.loadRelaxed();
+    }
+
+    /**
+     * Chooses split points for the chunk from the quantiles of the sampled inserted keys, aiming
+     * for chunks half of 'maxChunkSize' in size, as splitVector does. Returns an empty vector if
+     * less than 'maxChunkSize' bytes have been inserted, since then the sample does not describe
+     * most of the chunk's data, or if there are too few samples.
+     */
+    std::vector<BSONObj> getSampledSplitPoints(uint64_t maxChunkSize);
+
     /**
      * Returns whether or not this chunk is ready to be split based on the
      * maximum allowable size of a chunk.
@@ -86,6 +125,24 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * The number of write operations to this chunk.
+     */
+    AtomicWord<unsigned long long> _operations{0};
+
+    /**
+     * The number of bytes and documents inserted into this chunk.
+     */
+    AtomicWord<unsigned long long> _bytesInserted{0};
+    AtomicWord<unsigned long long> _keysInserted{0};
+
+    /**
+     * Protects _sampledKeys, which is a reservoir sample of the shard keys of the documents
+     * inserted into this chunk.
+     */
+    Mutex _samplesMutex = MONGO_MAKE_LATCH("ChunkWritesTracker::_samplesMutex");
+    std::vector<BSONObj> _sampledKeys;
+
     /**
      * Protects _splitState when starting a split.
      */
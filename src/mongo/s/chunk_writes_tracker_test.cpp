@@ -31,6 +31,7 @@
 
 #include "mongo/s/chunk_writes_tracker.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -149,4 +150,48 @@ DEATH_TEST(ChunkWritesTrackerTest, ReleaseSplitLockWithoutAcquiringErrors, "Inva
     wt.releaseSplitLock();
 }
 
+TEST(ChunkWritesTrackerTest, NoSampledSplitPointsUntilAFullChunkIsInserted) {
+    ChunkWritesTracker wt;
+    const uint64_t maxChunkSize{64 * 1024};
+    for (int i = 0; i < 63; ++i) {
+        wt.addInsertedKey(BSON("a" << i), 1024);
+    }
+    ASSERT_EQ(wt.getBytesInserted(), 63 * 1024ull);
+    ASSERT(wt.getSampledSplitPoints(maxChunkSize).empty());
+}
+
+TEST(ChunkWritesTrackerTest, SampledSplitPointsAreOrderedQuantiles) {
+    ChunkWritesTracker wt;
+    const uint64_t maxChunkSize{256 * 1024};
+    for (int i = 0; i < 1000; ++i) {
+        wt.addInsertedKey(BSON("a" << i), 1024);
+    }
+
+    // 1000KB inserted makes eight chunks of half the maximum chunk size
+    const auto splitPoints = wt.getSampledSplitPoints(maxChunkSize);
+    ASSERT_EQ(splitPoints.size(), 7ul);
+    int previous = 0;
+    for (const auto& splitPoint : splitPoints) {
+        ASSERT_GT(splitPoint["a"].numberInt(), previous);
+        previous = splitPoint["a"].numberInt();
+    }
+    ASSERT_LT(previous, 1000);
+}
+
+TEST(ChunkWritesTrackerTest, RepeatedKeysProduceNoSampledSplitPoints) {
+    ChunkWritesTracker wt;
+    const uint64_t maxChunkSize{64 * 1024};
+    for (int i = 0; i < 1000; ++i) {
+        wt.addInsertedKey(BSON("a" << 5), 1024);
+    }
+    ASSERT(wt.getSampledSplitPoints(maxChunkSize).empty());
+}
+
+TEST(ChunkWritesTrackerTest, BytesWrittenDoNotCountAsInserted) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(1024 * 1024);
+    ASSERT_EQ(wt.getBytesInserted(), 0ull);
+    ASSERT(wt.getSampledSplitPoints(64 * 1024).empty());
+}
+
 }  // namespace mongo
@@ -48,11 +48,13 @@
 #include "mongo/s/commands/strategy.h"
 #include "mongo/s/grid.h"
 #include "mongo/s/multi_statement_transaction_requests_sender.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/s/transaction_router.h"
 #include "mongo/s/would_change_owning_shard_exception.h"
 #include "mongo/s/write_ops/cluster_write.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
 
 namespace mongo {
@@ -274,6 +276,9 @@ public:
              BSONObjBuilder& result) override {
         const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbName, cmdObj));
 
+        // Drop the cached query results of the namespace once the write has been attempted.
+        ON_BLOCK_EXIT([&] { ClusterFindResultCache::get(opCtx)->invalidate(nss); });
+
         // Collect metrics.
         _updateMetrics.collectMetrics(cmdObj);
 
@@ -93,10 +93,13 @@ protected:
     static inline const std::string kReadHedgingModeFieldName = "readHedgingMode";
     static inline const std::string kMaxTimeMSForHedgedReadsFieldName = "maxTimeMSForHedgedReads";
     static inline const int kMaxTimeMSForHedgedReadsDefault = 10;
+    static inline const std::string kReadHedgingDelayPercentileFieldName =
+        "readHedgingDelayPercentile";
 
     static inline const BSONObj kDefaultParameters =
         BSON(kReadHedgingModeFieldName << "on" << kMaxTimeMSForHedgedReadsFieldName
-                                       << kMaxTimeMSForHedgedReadsDefault);
+                                       << kMaxTimeMSForHedgedReadsDefault
+                                       << kReadHedgingDelayPercentileFieldName << 0);
 
 private:
     ServiceContext::UniqueServiceContext _serviceCtx = ServiceContext::make();
@@ -191,5 +194,22 @@ TEST_F(HedgeOptionsUtilTestFixture, MaxTimeMSForHedgedReads) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true, 100);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, ReadHedgingDelayPercentile) {
+    const auto cmdObj = BSON("find" << kCollName);
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+    const auto readPref = uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(rspObj));
+
+    auto hedgeOptions = extractHedgeOptions(cmdObj, readPref);
+    ASSERT_TRUE(hedgeOptions.has_value());
+    ASSERT_EQ(hedgeOptions->delayPercentile, 0);
+
+    setParameters(BSON(kReadHedgingDelayPercentileFieldName << 95));
+    hedgeOptions = extractHedgeOptions(cmdObj, readPref);
+    ASSERT_TRUE(hedgeOptions.has_value());
+    ASSERT_EQ(hedgeOptions->delayPercentile, 95);
+}
+
 }  // namespace
 }  // namespace mongo
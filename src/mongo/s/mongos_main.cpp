@@ -90,6 +90,7 @@
 #include "mongo/s/query/cluster_cursor_cleanup_job.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
 #include "mongo/s/read_write_concern_defaults_cache_lookup_mongos.h"
+#include "mongo/s/routing_table_prefetcher.h"
 #include "mongo/s/service_entry_point_mongos.h"
 #include "mongo/s/session_catalog_router.h"
 #include "mongo/s/sessions_collection_sharded.h"
@@ -779,6 +780,8 @@ ExitCode runMongosServer(ServiceContext* serviceContext) {
 
     clusterCursorCleanupJob.go();
 
+    RoutingTablePrefetcher::start(serviceContext);
+
     UserCacheInvalidator::start(serviceContext, opCtx);
 
     PeriodicTask::startRunningPeriodicTasks();
@@ -39,6 +39,7 @@
 #include "mongo/db/query/cursor_response.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/kill_cursors_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/s/catalog/type_shard.h"
@@ -86,7 +87,9 @@ BSONObj extractSortKey(BSONObj obj, bool compareWholeSortKey) {
  * Returns an int less than 0 if 'leftSortKey' < 'rightSortKey', 0 if the two are equal, and an int
  * > 0 if 'leftSortKey' > 'rightSortKey' according to the pattern 'sortKeyPattern'.
  */
-int compareSortKeys(BSONObj leftSortKey, BSONObj rightSortKey, BSONObj sortKeyPattern) {
+int compareSortKeys(const BSONObj& leftSortKey,
+                    const BSONObj& rightSortKey,
+                    const BSONObj& sortKeyPattern) {
     // This does not need to sort with a collator, since mongod has already mapped strings to their
     // ICU comparison keys as part of the $sortKey meta projection.
     const BSONObj::ComparisonRulesSet rules = 0;  // 'considerFieldNames' flag is not set.
@@ -105,8 +108,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
       // since that is not supported we treat boost::none (unspecified) to mean 'kNormal'.
       _tailableMode(params.getTailableMode().value_or(TailableModeEnum::kNormal)),
       _params(std::move(params)),
-      _mergeQueue(MergingComparator(
-          _remotes, _params.getSort().value_or(BSONObj()), _params.getCompareWholeSortKey())),
+      _mergeQueue(MergingComparator(_remotes, _params.getSort().value_or(BSONObj()))),
       _promisedMinSortKeys(PromisedMinSortKeyComparator(_params.getSort().value_or(BSONObj()))) {
     if (params.getTxnNumber()) {
         invariant(params.getSessionId());
@@ -124,7 +126,7 @@ AsyncResultsMerger::AsyncResultsMerger(OperationContext* opCtx,
 
         // We don't check the return value of _addBatchToBuffer here; if there was an error,
         // it will be stored in the remote and the first call to ready() will return true.
-        _addBatchToBuffer(WithLock::withoutLock(), remoteIndex, remote.getCursorResponse());
+        _addFirstBatchToBuffer(WithLock::withoutLock(), remoteIndex, remote.getCursorResponse());
         ++remoteIndex;
     }
     // If this is a change stream, then we expect to have already received PBRTs from every shard.
@@ -219,7 +221,7 @@ void AsyncResultsMerger::addNewShardCursors(std::vector<RemoteCursor>&& newCurso
                               remote.getCursorResponse().getNSS(),
                               remote.getCursorResponse().getCursorId(),
                               remote.getCursorResponse().getPartialResultsReturned());
-        _addBatchToBuffer(lk, newIndex, remote.getCursorResponse());
+        _addFirstBatchToBuffer(lk, newIndex, remote.getCursorResponse());
     }
 }
 
@@ -312,9 +314,7 @@ bool AsyncResultsMerger::_readySortedTailable(WithLock lk) {
     }
 
     auto smallestRemote = _mergeQueue.top();
-    auto smallestResult = _remotes[smallestRemote].docBuffer.front();
-    auto keyWeWantToReturn =
-        extractSortKey(*smallestResult.getResult(), _params.getCompareWholeSortKey());
+    const auto& keyWeWantToReturn = _remotes[smallestRemote].sortKeyBuffer.front();
     // We should always have a minPromisedSortKey from every shard in the sorted tailable case.
     auto minPromisedSortKey = _getMinPromisedSortKey(lk);
     invariant(minPromisedSortKey);
@@ -355,7 +355,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -371,12 +371,14 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _remotes[smallestRemote].sortKeyBuffer.pop();
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
     if (!_remotes[smallestRemote].docBuffer.empty()) {
         _mergeQueue.push(smallestRemote);
     }
+    _prefetchNextBatch(lk, smallestRemote);
 
     // For sorted tailable awaitData cursors, update the high water mark to the document's sort key.
     if (_tailableMode == TailableModeEnum::kTailableAndAwaitData) {
@@ -389,7 +391,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
@@ -407,6 +409,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
                 _eofNext = true;
             }
 
+            _prefetchNextBatch(lk, _gettingFromRemote);
             return front;
         }
 
@@ -470,8 +473,11 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
 
     auto callbackStatus =
         _executor->scheduleRemoteCommand(request, [this, remoteIndex](auto const& cbData) {
+            // Parse the batch before taking the lock, so that the batches of several remotes can
+            // be parsed at the same time.
+            auto batch = this->_parseBatch(cbData.response);
             stdx::lock_guard<Latch> lk(this->_mutex);
-            this->_handleBatchResponse(lk, cbData, remoteIndex);
+            this->_handleBatchResponse(lk, cbData, std::move(batch), remoteIndex);
         });
 
     if (!callbackStatus.isOK()) {
@@ -482,6 +488,22 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
     return Status::OK();
 }
 
+void AsyncResultsMerger::_prefetchNextBatch(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    const auto maxBufferedDocs = internalQueryAsyncResultsMergerPrefetchBufferedDocs.load();
+    if (maxBufferedDocs <= 0 || _tailableMode != TailableModeEnum::kNormal ||
+        _lifecycleState != kAlive || !_opCtx) {
+        return;
+    }
+
+    if (!remote.status.isOK() || remote.exhausted() || remote.cbHandle.isValid() ||
+        remote.docBuffer.size() >= static_cast<size_t>(maxBufferedDocs)) {
+        return;
+    }
+
+    remote.status = _askForNextBatch(lk, remoteIndex);
+}
+
 Status AsyncResultsMerger::scheduleGetMores() {
     stdx::lock_guard<Latch> lk(_mutex);
     return _scheduleGetMores(lk);
@@ -552,25 +574,45 @@ StatusWith<executor::TaskExecutor::EventHandle> AsyncResultsMerger::nextEvent()
     return eventToReturn;
 }
 
-StatusWith<CursorResponse> AsyncResultsMerger::_parseCursorResponse(
-    const BSONObj& responseObj, const RemoteCursorData& remote) {
-
-    auto getMoreParseStatus = CursorResponse::parseFromBSON(responseObj);
-    if (!getMoreParseStatus.isOK()) {
-        return getMoreParseStatus.getStatus();
+AsyncResultsMerger::ParsedBatch AsyncResultsMerger::_parseBatch(
+    const CbResponse& response) const {
+    ParsedBatch batch;
+    if (!response.isOK()) {
+        return batch;
     }
 
-    auto cursorResponse = std::move(getMoreParseStatus.getValue());
+    batch.cursorResponse = CursorResponse::parseFromBSON(response.data);
+    if (batch.cursorResponse.isOK()) {
+        batch.sortKeysStatus = _extractSortKeys(batch.cursorResponse.getValue(), &batch.sortKeys);
+    }
+    return batch;
+}
 
-    // If we get a non-zero cursor id that is not equal to the established cursor id, we will fail
-    // the operation.
-    if (cursorResponse.getCursorId() != 0 && remote.cursorId != cursorResponse.getCursorId()) {
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Expected cursorid " << remote.cursorId << " but received "
-                                    << cursorResponse.getCursorId());
+Status AsyncResultsMerger::_extractSortKeys(const CursorResponse& response,
+                                            std::vector<BSONObj>* sortKeys) const {
+    // If there's a sort, we're expecting the remote node to have given us back a sort key.
+    if (!_params.getSort()) {
+        return Status::OK();
     }
 
-    return std::move(cursorResponse);
+    sortKeys->reserve(response.getBatch().size());
+    for (const auto& obj : response.getBatch()) {
+        auto key = obj[AsyncResultsMerger::kSortKeyField];
+        if (!key) {
+            return Status(ErrorCodes::InternalError,
+                          str::stream() << "Missing field '" << AsyncResultsMerger::kSortKeyField
+                                        << "' in document: " << obj);
+        } else if (!_params.getCompareWholeSortKey() && !key.isABSONObj()) {
+            return Status(ErrorCodes::InternalError,
+                          str::stream() << "Field '" << AsyncResultsMerger::kSortKeyField
+                                        << "' was not of type Object in document: " << obj);
+        }
+
+        // The sort key may point into the result, which 'docBuffer' keeps alive for as long as the
+        // sort key is buffered.
+        sortKeys->push_back(extractSortKey(obj, _params.getCompareWholeSortKey()));
+    }
+    return Status::OK();
 }
 
 void AsyncResultsMerger::_updateRemoteMetadata(WithLock lk,
@@ -663,6 +705,7 @@ bool AsyncResultsMerger::_checkHighWaterMarkEligibility(WithLock,
 
 void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
                                               CbData const& cbData,
+                                              ParsedBatch batch,
                                               size_t remoteIndex) {
     // Got a response from remote, so indicate we are no longer waiting for one.
     _remotes[remoteIndex].cbHandle = executor::TaskExecutor::CallbackHandle();
@@ -674,7 +717,7 @@ void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
         return;
     }
     try {
-        _processBatchResults(lk, cbData.response, remoteIndex);
+        _processBatchResults(lk, cbData.response, std::move(batch), remoteIndex);
     } catch (DBException const& e) {
         _remotes[remoteIndex].status = e.toStatus();
     }
@@ -711,6 +754,8 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
         std::queue<ClusterQueryResult> emptyBuffer;
         std::swap(remote.docBuffer, emptyBuffer);
+        std::queue<BSONObj> emptySortKeyBuffer;
+        std::swap(remote.sortKeyBuffer, emptySortKeyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -718,13 +763,25 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
 
 void AsyncResultsMerger::_processBatchResults(WithLock lk,
                                               CbResponse const& response,
+                                              ParsedBatch batch,
                                               size_t remoteIndex) {
     auto& remote = _remotes[remoteIndex];
     if (!response.isOK()) {
         _cleanUpFailedBatch(lk, response.status, remoteIndex);
         return;
     }
-    auto cursorResponseStatus = _parseCursorResponse(response.data, remote);
+
+    // If we get a non-zero cursor id that is not equal to the established cursor id, we will fail
+    // the operation.
+    auto& cursorResponseStatus = batch.cursorResponse;
+    if (cursorResponseStatus.isOK() && cursorResponseStatus.getValue().getCursorId() != 0 &&
+        remote.cursorId != cursorResponseStatus.getValue().getCursorId()) {
+        cursorResponseStatus = Status(ErrorCodes::BadValue,
+                                      str::stream()
+                                          << "Expected cursorid " << remote.cursorId
+                                          << " but received "
+                                          << cursorResponseStatus.getValue().getCursorId());
+    }
     if (!cursorResponseStatus.isOK()) {
         _cleanUpFailedBatch(lk,
                             cursorResponseStatus.getStatus().withContext(
@@ -739,7 +796,8 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
     remote.cursorId = cursorResponse.getCursorId();
 
     // Save the batch in the remote's buffer.
-    if (!_addBatchToBuffer(lk, remoteIndex, cursorResponse)) {
+    if (!_addBatchToBuffer(
+            lk, remoteIndex, cursorResponse, batch.sortKeysStatus, std::move(batch.sortKeys))) {
         return;
     }
 
@@ -758,37 +816,40 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
         // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
         // remote command on a user's behalf without a non-null OperationContext.
         remote.status = _askForNextBatch(lk, remoteIndex);
+    } else {
+        // Otherwise keep the remote's next batch in flight while the buffered results are merged.
+        _prefetchNextBatch(lk, remoteIndex);
     }
 }
 
+bool AsyncResultsMerger::_addFirstBatchToBuffer(WithLock lk,
+                                                size_t remoteIndex,
+                                                const CursorResponse& response) {
+    std::vector<BSONObj> sortKeys;
+    auto sortKeysStatus = _extractSortKeys(response, &sortKeys);
+    return _addBatchToBuffer(lk, remoteIndex, response, sortKeysStatus, std::move(sortKeys));
+}
+
 bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            size_t remoteIndex,
-                                           const CursorResponse& response) {
+                                           const CursorResponse& response,
+                                           const Status& sortKeysStatus,
+                                           std::vector<BSONObj> sortKeys) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
-    for (const auto& obj : response.getBatch()) {
-        // If there's a sort, we're expecting the remote node to have given us back a sort key.
-        if (_params.getSort()) {
-            auto key = obj[AsyncResultsMerger::kSortKeyField];
-            if (!key) {
-                remote.status =
-                    Status(ErrorCodes::InternalError,
-                           str::stream() << "Missing field '" << AsyncResultsMerger::kSortKeyField
-                                         << "' in document: " << obj);
-                return false;
-            } else if (!_params.getCompareWholeSortKey() && !key.isABSONObj()) {
-                remote.status =
-                    Status(ErrorCodes::InternalError,
-                           str::stream() << "Field '" << AsyncResultsMerger::kSortKeyField
-                                         << "' was not of type Object in document: " << obj);
-                return false;
-            }
-        }
+    if (!sortKeysStatus.isOK()) {
+        remote.status = sortKeysStatus;
+        return false;
+    }
 
+    for (const auto& obj : response.getBatch()) {
         ClusterQueryResult result(obj);
         remote.docBuffer.push(result);
         ++remote.fetchedCount;
     }
+    for (auto& sortKey : sortKeys) {
+        remote.sortKeyBuffer.push(std::move(sortKey));
+    }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
     // queue.
@@ -911,12 +972,8 @@ bool AsyncResultsMerger::RemoteCursorData::exhausted() const {
 //
 
 bool AsyncResultsMerger::MergingComparator::operator()(const size_t& lhs, const size_t& rhs) {
-    const ClusterQueryResult& leftDoc = _remotes[lhs].docBuffer.front();
-    const ClusterQueryResult& rightDoc = _remotes[rhs].docBuffer.front();
-
-    return compareSortKeys(extractSortKey(*leftDoc.getResult(), _compareWholeSortKey),
-                           extractSortKey(*rightDoc.getResult(), _compareWholeSortKey),
-                           _sort) > 0;
+    return compareSortKeys(
+               _remotes[lhs].sortKeyBuffer.front(), _remotes[rhs].sortKeyBuffer.front(), _sort) > 0;
 }
 
 bool AsyncResultsMerger::PromisedMinSortKeyComparator::operator()(
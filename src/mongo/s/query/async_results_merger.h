@@ -308,6 +308,9 @@ private:
         // The buffer of results that have been retrieved but not yet returned to the caller.
         std::queue<ClusterQueryResult> docBuffer;
 
+        // For sorted merges, the sort keys of the results in 'docBuffer', in the same order.
+        std::queue<BSONObj> sortKeyBuffer;
+
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
@@ -322,22 +325,19 @@ private:
 
     class MergingComparator {
     public:
-        MergingComparator(const std::vector<RemoteCursorData>& remotes,
-                          const BSONObj& sort,
-                          bool compareWholeSortKey)
-            : _remotes(remotes), _sort(sort), _compareWholeSortKey(compareWholeSortKey) {}
+        MergingComparator(const std::vector<RemoteCursorData>& remotes, const BSONObj& sort)
+            : _remotes(remotes), _sort(sort) {}
 
+        /**
+         * Compares the sort keys buffered at the front of each remote's 'sortKeyBuffer', which
+         * were extracted from the results when their batch was received.
+         */
         bool operator()(const size_t& lhs, const size_t& rhs);
 
     private:
         const std::vector<RemoteCursorData>& _remotes;
 
         const BSONObj _sort;
-
-        // When '_compareWholeSortKey' is true, $sortKey is a scalar value, rather than an object.
-        // We extract the sort key {$sortKey: <value>}. The sort key pattern '_sort' is verified to
-        // be {$sortKey: 1}.
-        const bool _compareWholeSortKey;
     };
 
     using MinSortKeyRemoteIdPair = std::pair<BSONObj, size_t>;
@@ -354,13 +354,34 @@ private:
 
     enum LifecycleState { kAlive, kKillStarted, kKillComplete };
 
+    using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
+    using CbResponse = executor::TaskExecutor::ResponseStatus;
+
     /**
-     * Parses the find or getMore command response object to a CursorResponse.
-     *
-     * Returns a non-OK response if the response fails to parse or if there is a cursor id mismatch.
+     * A batch of results received from a remote, parsed before '_mutex' is acquired to process it.
+     */
+    struct ParsedBatch {
+        // The parsed find or getMore command response, or the reason it failed to parse.
+        StatusWith<CursorResponse> cursorResponse{ErrorCodes::InternalError, "Batch not parsed"};
+
+        // For sorted merges, the sort key of each result in the batch, or the reason one could not
+        // be extracted.
+        Status sortKeysStatus = Status::OK();
+        std::vector<BSONObj> sortKeys;
+    };
+
+    /**
+     * Parses the find or getMore command 'response' and extracts the sort keys of its results.
+     * Only reads the immutable parameters of the merger, so that the batches received from several
+     * remotes can be parsed concurrently, on the threads running their callbacks.
      */
-    static StatusWith<CursorResponse> _parseCursorResponse(const BSONObj& responseObj,
-                                                           const RemoteCursorData& remote);
+    ParsedBatch _parseBatch(const CbResponse& response) const;
+
+    /**
+     * For sorted merges, fills 'sortKeys' with the sort key of each result in 'response'. Returns a
+     * non-OK status if a result lacks a valid sort key.
+     */
+    Status _extractSortKeys(const CursorResponse& response, std::vector<BSONObj>* sortKeys) const;
 
     /**
      * Helper to schedule a command asking the remote node for another batch of results.
@@ -372,6 +393,14 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * Asks the remote at 'remoteIndex' for its next batch ahead of time if prefetching is enabled
+     * through 'internalQueryAsyncResultsMergerPrefetchBufferedDocs', the buffer of the remote has
+     * room, and the remote has no outstanding request. Only non-tailable cursors are prefetched.
+     * An error scheduling the request is recorded as the remote's status.
+     */
+    void _prefetchNextBatch(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -393,9 +422,6 @@ private:
     ClusterQueryResult _nextReadySorted(WithLock);
     ClusterQueryResult _nextReadyUnsorted(WithLock);
 
-    using CbData = executor::TaskExecutor::RemoteCommandCallbackArgs;
-    using CbResponse = executor::TaskExecutor::ResponseStatus;
-
     /**
      * When nextEvent() schedules remote work, the callback uses this function to process results.
      *
@@ -403,7 +429,7 @@ private:
      * indicates which node the response came from and where the new result documents should be
      * buffered.
      */
-    void _handleBatchResponse(WithLock, CbData const&, size_t remoteIndex);
+    void _handleBatchResponse(WithLock, CbData const&, ParsedBatch batch, size_t remoteIndex);
 
     /**
      * Cleans up if the remote cursor was killed while waiting for a response.
@@ -418,13 +444,22 @@ private:
     /**
      * Processes results from a remote query.
      */
-    void _processBatchResults(WithLock, CbResponse const&, size_t remoteIndex);
+    void _processBatchResults(WithLock, CbResponse const&, ParsedBatch batch, size_t remoteIndex);
+
+    /**
+     * Adds the batch of results to the RemoteCursorData, along with their sort keys for sorted
+     * merges. Returns false if 'sortKeysStatus' reports that some sort keys could not be extracted.
+     */
+    bool _addBatchToBuffer(WithLock,
+                           size_t remoteIndex,
+                           const CursorResponse& response,
+                           const Status& sortKeysStatus,
+                           std::vector<BSONObj> sortKeys);
 
     /**
-     * Adds the batch of results to the RemoteCursorData. Returns false if there was an error
-     * parsing the batch.
+     * Adds a batch received along with the establishment of a cursor to the RemoteCursorData.
      */
-    bool _addBatchToBuffer(WithLock, size_t remoteIndex, const CursorResponse& response);
+    bool _addFirstBatchToBuffer(WithLock, size_t remoteIndex, const CursorResponse& response);
 
     /**
      * If there is a valid unsignaled event that has been requested via nextEvent() and there are
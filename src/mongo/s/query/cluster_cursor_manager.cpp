@@ -148,25 +148,32 @@ void ClusterCursorManager::PinnedCursor::returnAndKillCursor() {
 }
 
 ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
-    : _clockSource(clockSource),
-      _randomSeed(SecureRandom().nextInt64()),
-      _pseudoRandom(_randomSeed) {
+    : _clockSource(clockSource) {
     invariant(_clockSource);
+    SecureRandom secureRandom;
+    for (auto& partition : _partitions) {
+        partition = std::make_unique<Partition>(secureRandom.nextInt64());
+    }
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
-    invariant(_cursorIdPrefixToNamespaceMap.empty());
-    invariant(_namespaceToContainerMap.empty());
+    for (const auto& partition : _partitions) {
+        invariant(partition->cursorIdPrefixToNamespaceMap.empty());
+        invariant(partition->namespaceToContainerMap.empty());
+    }
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
-    }
+    // A registration either sees this under its partition's mutex and fails, or completes before
+    // killAllCursors() gets to its partition.
+    _inShutdown.store(true);
     killAllCursors(opCtx);
 }
 
+auto ClusterCursorManager::_getPartition(CursorId cursorId) const -> Partition& {
+    return *_partitions[extractPrefixFromCursorId(cursorId) % kNumPartitions];
+}
+
 StatusWith<CursorId> ClusterCursorManager::registerCursor(
     OperationContext* opCtx,
     std::unique_ptr<ClusterClientCursor> cursor,
@@ -177,10 +184,13 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
+    const size_t partitionIndex = _nextRegistrationPartition.fetchAndAdd(1) % kNumPartitions;
+    Partition& partition = *_partitions[partitionIndex];
 
-    if (_inShutdown) {
+    stdx::unique_lock<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
+
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -190,9 +200,12 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    // Find the CursorEntryContainer for this namespace in the partition.  If none exists, create
+    // one.
+    auto& namespaceToContainerMap = partition.namespaceToContainerMap;
+    auto& cursorIdPrefixToNamespaceMap = partition.cursorIdPrefixToNamespaceMap;
+    auto nsToContainerIt = namespaceToContainerMap.find(nss);
+    if (nsToContainerIt == namespaceToContainerMap.end()) {
         uint32_t containerPrefix = 0;
         do {
             // The server has always generated positive values for CursorId (which is a signed
@@ -201,16 +214,20 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
             // undefined behavior on 2's complement systems so we need to generate a new number.
             int32_t randomNumber = 0;
             do {
-                randomNumber = _pseudoRandom.nextInt32();
+                randomNumber = partition.pseudoRandom.nextInt32();
             } while (randomNumber == std::numeric_limits<int32_t>::min());
             containerPrefix = static_cast<uint32_t>(std::abs(randomNumber));
-        } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
-        _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
+
+            // The low bits of the prefix locate the partition from the cursor id alone.
+            containerPrefix = (containerPrefix & ~static_cast<uint32_t>(kNumPartitions - 1)) |
+                static_cast<uint32_t>(partitionIndex);
+        } while (cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
+        cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
 
         auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
+            namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
         invariant(emplaceResult.second);
-        invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+        invariant(namespaceToContainerMap.size() == cursorIdPrefixToNamespaceMap.size());
 
         nsToContainerIt = emplaceResult.first;
     } else {
@@ -222,7 +239,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     CursorEntryMap& entryMap = container.entryMap;
     CursorId cursorId = 0;
     do {
-        const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
+        const uint32_t cursorSuffix = static_cast<uint32_t>(partition.pseudoRandom.nextInt32());
         cursorId = createCursorId(container.containerPrefix, cursorSuffix);
     } while (cursorId == 0 || entryMap.count(cursorId) > 0);
 
@@ -235,7 +252,7 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
                                                       authenticatedUsers,
                                                       opCtx->getOperationKey()));
     invariant(emplaceResult.second);
-    _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
 
     return cursorId;
 }
@@ -248,15 +265,16 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     AuthCheck checkSessionAuth) {
     const auto now = _clockSource->now();
 
-    stdx::lock_guard<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
+    Partition& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -281,6 +299,10 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
 
     auto cursorGuard = entry->releaseCursor(opCtx);
+    partition.log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
+
+    // The cursor now belongs to this operation, so nothing below needs the partition.
+    lk.unlock();
 
     // We use pinning of a cursor as a proxy for active, user-initiated use of a cursor.  Therefore,
     // we pass down to the logical session cache and vivify the record (updating last use).
@@ -293,7 +315,6 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
     cursorGuard->reattachToOperationContext(opCtx);
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -311,10 +332,11 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
+    Partition& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
+    partition.log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -324,22 +346,23 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     entry->returnCursor(std::move(cursor));
 
     if (cursorState == CursorState::NotExhausted && !killPending) {
-        _log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
+        partition.log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
         // The caller may need the cursor again.
         return;
     }
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    Partition& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto entry = _getEntry(lk, partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -367,11 +390,12 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     invariant(opCtx);
 
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
+    Partition& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
 
-    _log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
+    partition.log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -386,7 +410,7 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(lk), partition, opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
@@ -394,10 +418,11 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
 }
 
 void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                                               Partition& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = _detachCursor(lk, partition, opCtx, nss, cursorId);
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
@@ -408,7 +433,6 @@ void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
 
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal &&
@@ -424,119 +448,124 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    return killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
     const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    killCursorsSatisfying(opCtx, std::move(pred), now);
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred,
-    Date_t now) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred, Date_t now) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    _log.push(
-        {LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt, boost::none, now, boost::none});
-
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
-            auto cursorId = cursorIdEntryIt->first;
-            auto& entry = cursorIdEntryIt->second;
-
-            if (!pred(cursorId, entry)) {
-                ++cursorIdEntryIt;
-                continue;
-            }
+    for (auto& partitionPtr : _partitions) {
+        Partition& partition = *partitionPtr;
+        stdx::unique_lock<Latch> lk(partition.mutex);
+
+        partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt,
+                            boost::none,
+                            now,
+                            boost::none});
+
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
+        auto nsContainerIt = partition.namespaceToContainerMap.begin();
+        while (nsContainerIt != partition.namespaceToContainerMap.end()) {
+            auto&& entryMap = nsContainerIt->second.entryMap;
+            auto cursorIdEntryIt = entryMap.begin();
+            while (cursorIdEntryIt != entryMap.end()) {
+                auto cursorId = cursorIdEntryIt->first;
+                auto& entry = cursorIdEntryIt->second;
+
+                if (!pred(cursorId, entry)) {
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-            ++nKilled;
+                ++nKilled;
 
-            if (entry.getOperationUsingCursor()) {
-                // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
-                ++cursorIdEntryIt;
-                continue;
-            }
+                if (entry.getOperationUsingCursor()) {
+                    // Mark the OperationContext using the cursor as killed, and move on.
+                    killOperationUsingCursor(lk, &entry);
+                    ++cursorIdEntryIt;
+                    continue;
+                }
 
-            _log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
-                       cursorId,
-                       // While we collected 'now' above, we ran caller-provided predicates which
-                       // may have been expensive. To avoid re-reading from the clock while the
-                       // lock is held, we do not provide a value for 'now' in this log entry.
-                       boost::none,
-                       nsContainerIt->first});
+                partition.log.push(
+                    {LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
+                     cursorId,
+                     // While we collected 'now' above, we ran caller-provided predicates which
+                     // may have been expensive. To avoid re-reading from the clock while the
+                     // lock is held, we do not provide a value for 'now' in this log entry.
+                     boost::none,
+                     nsContainerIt->first});
 
-            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+                cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
 
-            // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
-        }
+                // Destroy the entry and set the iterator to the next element.
+                entryMap.erase(cursorIdEntryIt++);
+            }
 
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+            if (entryMap.empty()) {
+                nsContainerIt = eraseContainer(lk, partition, nsContainerIt);
+            } else {
+                ++nsContainerIt;
+            }
         }
-    }
-
-    _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
-               boost::none,
-               // While we collected 'now' above, we ran caller-provided predicates which may have
-               // been expensive. To avoid re-reading from the clock while the lock is held, we do
-               // not provide a value for 'now' in this log entry.
-               boost::none,
-               boost::none});
 
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
+        partition.log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
+                            boost::none,
+                            // While we collected 'now' above, we ran caller-provided predicates
+                            // which may have been expensive. To avoid re-reading from the clock
+                            // while the lock is held, we do not provide a value for 'now' in this
+                            // log entry.
+                            boost::none,
+                            boost::none});
+
+        // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks
+        // to finish.
+        lk.unlock();
 
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
+        }
     }
 
     return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (auto& nsContainerPair : partition->namespaceToContainerMap) {
+            for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
 
-            if (entry.isKillPending()) {
-                // Killed cursors do not count towards the number of pinned cursors or the number of
-                // open cursors.
-                continue;
-            }
+                if (entry.isKillPending()) {
+                    // Killed cursors do not count towards the number of pinned cursors or the
+                    // number of open cursors.
+                    continue;
+                }
 
-            if (entry.getOperationUsingCursor()) {
-                ++stats.cursorsPinned;
-            }
+                if (entry.getOperationUsingCursor()) {
+                    ++stats.cursorsPinned;
+                }
 
-            switch (entry.getCursorType()) {
-                case CursorType::SingleTarget:
-                    ++stats.cursorsSingleTarget;
-                    break;
-                case CursorType::MultiTarget:
-                    ++stats.cursorsMultiTarget;
-                    break;
+                switch (entry.getCursorType()) {
+                    case CursorType::SingleTarget:
+                        ++stats.cursorsSingleTarget;
+                        break;
+                    case CursorType::MultiTarget:
+                        ++stats.cursorsMultiTarget;
+                        break;
+                }
             }
         }
     }
@@ -545,20 +574,21 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (const auto& nsContainerPair : partition->namespaceToContainerMap) {
+            for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+                const CursorEntry& entry = cursorIdEntryPair.second;
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
-            const CursorEntry& entry = cursorIdEntryPair.second;
-
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
 
-            auto lsid = entry.getLsid();
-            if (lsid) {
-                lsids->insert(*lsid);
+                auto lsid = entry.getLsid();
+                if (lsid) {
+                    lsids->insert(*lsid);
+                }
             }
         }
     }
@@ -586,28 +616,29 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (const auto& nsContainerPair : partition->namespaceToContainerMap) {
+            for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+
+                const CursorEntry& entry = cursorIdEntryPair.second;
+                // If auth is enabled, and userMode is allUsers, check if the current user has
+                // permission to see this cursor.
+                if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
+                    userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
+                    !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
+                    continue;
+                }
+                if (entry.isKillPending() || entry.getOperationUsingCursor()) {
+                    // Don't include sessions for killed or pinned cursors.
+                    continue;
+                }
 
-            const CursorEntry& entry = cursorIdEntryPair.second;
-            // If auth is enabled, and userMode is allUsers, check if the current user has
-            // permission to see this cursor.
-            if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
-                userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
-                !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
-                continue;
-            }
-            if (entry.isKillPending() || entry.getOperationUsingCursor()) {
-                // Don't include sessions for killed or pinned cursors.
-                continue;
+                cursors.emplace_back(
+                    entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
             }
-
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
         }
     }
 
@@ -635,20 +666,21 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-            if (entry.isKillPending()) {
-                // Don't include sessions for killed cursors.
-                continue;
-            }
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (auto&& nsContainerPair : partition->namespaceToContainerMap) {
+            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+                if (entry.isKillPending()) {
+                    // Don't include sessions for killed cursors.
+                    continue;
+                }
 
-            auto cursorLsid = entry.getLsid();
-            if (lsid == cursorLsid) {
-                cursorIds.insert(cursorId);
+                auto cursorLsid = entry.getLsid();
+                if (lsid == cursorLsid) {
+                    cursorIds.insert(cursorId);
+                }
             }
         }
     }
@@ -658,23 +690,24 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
     // While we could maintain a cached mapping of OperationKey to CursorID to increase performance,
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
-    for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
-                if (entry.isKillPending()) {
-                    // Don't include any killed cursors.
-                    continue;
-                }
-
-                if (opKey == entry.getOperationKey()) {
-                    cursorIds.insert(cursorId);
+    for (const auto& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
+        for (auto&& opKey : opKeys) {
+            for (auto&& nsContainerPair : partition->namespaceToContainerMap) {
+                for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+                    if (entry.isKillPending()) {
+                        // Don't include any killed cursors.
+                        continue;
+                    }
+
+                    if (opKey == entry.getOperationKey()) {
+                        cursorIds.insert(cursorId);
+                    }
                 }
             }
         }
@@ -685,20 +718,24 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    const Partition& partition = _getPartition(cursorId);
+    stdx::lock_guard<Latch> lk(partition.mutex);
 
-    const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
-    if (it == _cursorIdPrefixToNamespaceMap.end()) {
+    const auto it =
+        partition.cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
+    if (it == partition.cursorIdPrefixToNamespaceMap.end()) {
         return boost::none;
     }
     return it->second;
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
+auto ClusterCursorManager::_getEntry(WithLock,
+                                     Partition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
 
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
+    auto nsToContainerIt = partition.namespaceToContainerMap.find(nss);
+    if (nsToContainerIt == partition.namespaceToContainerMap.end()) {
         return nullptr;
     }
     CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
@@ -710,7 +747,9 @@ auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, Curso
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
+auto ClusterCursorManager::eraseContainer(WithLock,
+                                          Partition& partition,
+                                          NssToCursorContainerMap::iterator it)
     -> NssToCursorContainerMap::iterator {
     auto&& container = it->second;
     auto&& entryMap = container.entryMap;
@@ -718,7 +757,7 @@ auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
 
     // This was the last cursor remaining in the given namespace.  Erase all state associated
     // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
+    size_t numDeleted = partition.cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
     if (numDeleted != 1) {
         LOGV2_ERROR(
             4786901,
@@ -730,26 +769,28 @@ auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
             "nss"_attr = it->first,
             "prefix"_attr = container.containerPrefix,
             "actualNumDeleted"_attr = numDeleted);
-        logCursorManagerInfo();
+        logCursorManagerInfo(partition);
         MONGO_UNREACHABLE;
     }
     const auto nssRemoved = it->first;
-    _namespaceToContainerMap.erase(it++);
-    _log.push({LogEvent::Type::kNamespaceEntryMapErased,
-               boost::none,
-               boost::none,
-               std::move(nssRemoved)});
-
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+    partition.namespaceToContainerMap.erase(it++);
+    partition.log.push({LogEvent::Type::kNamespaceEntryMapErased,
+                        boost::none,
+                        boost::none,
+                        std::move(nssRemoved)});
+
+    invariant(partition.namespaceToContainerMap.size() ==
+              partition.cursorIdPrefixToNamespaceMap.size());
     return it;
 }
 
 StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
+                                                                         Partition& partition,
                                                                          OperationContext* opCtx,
                                                                          const NamespaceString& nss,
                                                                          CursorId cursorId) {
-    _log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    partition.log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
+    CursorEntry* entry = _getEntry(lk, partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -762,21 +803,21 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
+    auto nsToContainerIt = partition.namespaceToContainerMap.find(nss);
+    invariant(nsToContainerIt != partition.namespaceToContainerMap.end());
     CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
     size_t eraseResult = entryMap.erase(cursorId);
     invariant(1 == eraseResult);
     if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
+        eraseContainer(lk, partition, nsToContainerIt);
     }
 
-    _log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
+    partition.log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
 
     return std::move(cursor);
 }
 
-void ClusterCursorManager::logCursorManagerInfo() const {
+void ClusterCursorManager::logCursorManagerInfo(const Partition& partition) {
     LOGV2_ERROR_OPTIONS(4786900,
                         logv2::LogTruncation::Disabled,
                         "Dumping cursor manager contents. "
@@ -784,9 +825,9 @@ void ClusterCursorManager::logCursorManagerInfo() const {
                         "Cursor ID Prefix -> NSS map: {cursorIdToNss} "
                         "Internal log: {internalLog}",
                         "Dumping cursor manager contents.",
-                        "{nssToContainer}"_attr = dumpNssToContainerMap(),
-                        "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(),
-                        "{internalLog}"_attr = dumpInternalLog());
+                        "{nssToContainer}"_attr = dumpNssToContainerMap(partition),
+                        "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(partition),
+                        "{internalLog}"_attr = dumpInternalLog(partition));
 }
 
 std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::LogEvent::Type t) {
@@ -811,12 +852,12 @@ std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::L
     return "unknown " + std::to_string(static_cast<int>(t));
 }
 
-BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
+BSONObj ClusterCursorManager::dumpNssToContainerMap(const Partition& partition) {
     BSONObjBuilder bob;
     // Record an object for the NSS -> Container map.
     {
         BSONObjBuilder nssToContainer(bob.subobjStart("nssToContainer"));
-        for (auto&& [nss, cursorContainer] : _namespaceToContainerMap) {
+        for (auto&& [nss, cursorContainer] : partition.namespaceToContainerMap) {
             BSONObjBuilder nssBob(nssToContainer.subobjStart(nss.toString()));
             nssBob.appendIntOrLL("containerPrefix",
                                  static_cast<int64_t>(cursorContainer.containerPrefix));
@@ -831,13 +872,13 @@ BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
     return bob.obj();
 }
 
-BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
+BSONObj ClusterCursorManager::dumpCursorIdToNssMap(const Partition& partition) {
     BSONObjBuilder bob;
 
     // Record an array for the Cursor ID Prefix -> NSS map.
     {
         BSONArrayBuilder cursorIdPrefixToNss(bob.subarrayStart("cursorIdPrefixToNss"));
-        for (auto&& [cursorIdPrefix, nss] : _cursorIdPrefixToNamespaceMap) {
+        for (auto&& [cursorIdPrefix, nss] : partition.cursorIdPrefixToNamespaceMap) {
             BSONObjBuilder bob(cursorIdPrefixToNss.subobjStart());
             bob.appendIntOrLL("cursorIdPrefix", static_cast<int64_t>(cursorIdPrefix));
             bob.append("nss", nss.toString());
@@ -847,15 +888,15 @@ BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
     return bob.obj();
 }
 
-BSONObj ClusterCursorManager::dumpInternalLog() const {
+BSONObj ClusterCursorManager::dumpInternalLog(const Partition& partition) {
     BSONObjBuilder bob;
     // Dump the internal log maintained by the ClusterCursorManager.
     {
         BSONArrayBuilder logBuilder(bob.subarrayStart("log"));
-        size_t i = _log.start;
-        while (i != _log.end) {
+        size_t i = partition.log.start;
+        while (i != partition.log.end) {
             BSONObjBuilder bob(logBuilder.subobjStart());
-            const auto& logEntry = _log.events[i];
+            const auto& logEntry = partition.log.events[i];
             if (logEntry.cursorId) {
                 bob.appendIntOrLL("cursorId", *logEntry.cursorId);
             }
@@ -869,7 +910,7 @@ BSONObj ClusterCursorManager::dumpInternalLog() const {
                 bob.append("nss", logEntry.nss->toString());
             }
 
-            i = (i + 1) % _log.events.size();
+            i = (i + 1) % partition.log.events.size();
         }
     }
     return bob.obj();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
@@ -389,6 +391,7 @@ public:
 private:
     class CursorEntry;
     struct CursorEntryContainer;
+    struct Partition;
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
     using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
 
@@ -480,6 +483,7 @@ private:
      * Will detach a cursor, release the lock and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
+                             Partition& partition,
                              OperationContext* opCtx,
                              const NamespaceString& nss,
                              CursorId cursorId);
@@ -490,7 +494,10 @@ private:
      *
      * Not thread-safe.
      */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
+    CursorEntry* _getEntry(WithLock,
+                           Partition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
 
     /**
      * De-registers the given cursor, and returns an owned pointer to the underlying
@@ -502,6 +509,7 @@ private:
      * Not thread-safe.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
+                                                       Partition& partition,
                                                        OperationContext* opCtx,
                                                        const NamespaceString& nss,
                                                        CursorId cursorId);
@@ -512,13 +520,12 @@ private:
     void killOperationUsingCursor(WithLock, CursorEntry* entry);
 
     /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry. The
-     * 'now' parameter is only used for the internal logging mechansim.
+     * Kill the cursors satisfying the given predicate, one partition at a time. The 'now'
+     * parameter is only used for the internal logging mechansim.
      *
      * Returns the number of cursors killed.
      */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
                                       std::function<bool(CursorId, const CursorEntry&)> pred,
                                       Date_t now);
 
@@ -670,60 +677,84 @@ private:
         CursorEntryMap entryMap;
     };
 
+    /**
+     * The cursors are partitioned by the low bits of their cursor id prefix, and each partition
+     * has its own mutex, so that operations on different cursors rarely contend with each other.
+     * This holds even for cursors on the same namespace, which gets a separate container, and so
+     * a separate prefix, in every partition it has cursors in.
+     */
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Partition {
+        explicit Partition(int64_t seed) : pseudoRandom(seed) {}
+
+        // Synchronizes access to all state variables below.
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
+
+        // Randomness source.  Used for cursor id generation.
+        PseudoRandom pseudoRandom;
+
+        // Map from cursor id prefix to associated namespace.  Exists only to provide namespace
+        // lookup for (deprecated) getNamespaceForCursorId() method.
+        //
+        // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the
+        // first cursor on a given namespace is registered in a partition, it is given a CursorId
+        // with a prefix that is unique to that namespace and whose low bits are the partition
+        // index, and an arbitrary suffix.  Cursors subsequently registered on that namespace in
+        // the same partition will all share the same prefix.
+        //
+        // Entries are added when the first cursor on the given namespace is registered in the
+        // partition, and removed when the last such cursor is destroyed.
+        stdx::unordered_map<uint32_t, NamespaceString> cursorIdPrefixToNamespaceMap;
+
+        // Map from namespace to the CursorEntryContainer for that namespace.
+        //
+        // Entries are added when the first cursor on the given namespace is registered in the
+        // partition, and removed when the last such cursor is destroyed.
+        NssToCursorContainerMap namespaceToContainerMap;
+
+        CircularLogQueue log;
+    };
+
+    /**
+     * Returns the partition which holds the cursor with id 'cursorId', if it is registered.
+     */
+    Partition& _getPartition(CursorId cursorId) const;
+
     /**
      * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
+     * is an iterator in the namespaceToContainerMap of 'partition'.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    NssToCursorContainerMap::iterator eraseContainer(WithLock,
+                                                     Partition& partition,
+                                                     NssToCursorContainerMap::iterator it);
 
     /**
-     * Functions which dump the state/history of the cursor manager into a BSONObj for debug
-     * purposes.
+     * Functions which dump the state/history of a partition of the cursor manager into a BSONObj
+     * for debug purposes.
      */
-    BSONObj dumpCursorIdToNssMap() const;
-    BSONObj dumpNssToContainerMap() const;
-    BSONObj dumpInternalLog() const;
+    static BSONObj dumpCursorIdToNssMap(const Partition& partition);
+    static BSONObj dumpNssToContainerMap(const Partition& partition);
+    static BSONObj dumpInternalLog(const Partition& partition);
 
     /**
-     * Logs objects which summarize the current state of the cursor manager as well as its recent
-     * history.
+     * Logs objects which summarize the current state of a partition of the cursor manager as well
+     * as its recent history.
      */
-    void logCursorManagerInfo() const;
+    static void logCursorManagerInfo(const Partition& partition);
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    AtomicWord<bool> _inShutdown{false};
 
-    bool _inShutdown{false};
+    // Used to spread the registration of new cursors evenly across the partitions.
+    AtomicWord<unsigned> _nextRegistrationPartition{0};
 
-    // Randomness source.  Used for cursor id generation.
-    const int64_t _randomSeed;
-    PseudoRandom _pseudoRandom;
-
-    // Map from cursor id prefix to associated namespace.  Exists only to provide namespace lookup
-    // for (deprecated) getNamespaceForCursorId() method.
-    //
-    // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the first
-    // cursor on a given namespace is registered, it is given a CursorId with a prefix that is
-    // unique to that namespace, and an arbitrary suffix.  Cursors subsequently registered on that
-    // namespace will all share the same prefix.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
-
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    std::array<std::unique_ptr<Partition>, kNumPartitions> _partitions;
 
     size_t _cursorsTimedOut = 0;
-
-    CircularLogQueue _log;
 };
 
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "mongo/db/logical_session_cache_noop.h"
@@ -771,6 +772,29 @@ TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdMultipleCursorsSameNames
     }
 }
 
+// Test that cursors on one namespace are spread over several cursor id prefixes, so that they do
+// not all share a partition of the manager, and that they can still all be killed.
+TEST_F(ClusterCursorManagerTest, CursorsOnSameNamespaceSpreadAcrossPartitions) {
+    const size_t numCursors = 64;
+    std::set<uint32_t> cursorIdPrefixes;
+    for (size_t i = 0; i < numCursors; ++i) {
+        auto cursorId =
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   nss,
+                                                   ClusterCursorManager::CursorType::SingleTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator()));
+        ASSERT_GT(cursorId, 0);
+        cursorIdPrefixes.insert(static_cast<uint64_t>(cursorId) >> 32);
+    }
+    ASSERT_GT(cursorIdPrefixes.size(), 1U);
+    ASSERT_EQ(numCursors, getManager()->stats().cursorsSingleTarget);
+
+    getManager()->killAllCursors(_opCtx.get());
+    ASSERT_EQ(0U, getManager()->stats().cursorsSingleTarget);
+}
+
 // Test that getting the namespace for a cursor returns the correct namespace, when there are
 // multiple cursors registered on different namespaces.
 TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdMultipleCursorsDifferentNamespaces) {
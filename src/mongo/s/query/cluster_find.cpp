@@ -60,6 +60,7 @@
 #include "mongo/s/query/async_results_merger.h"
 #include "mongo/s/query/cluster_client_cursor_impl.h"
 #include "mongo/s/query/cluster_cursor_manager.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
 #include "mongo/s/query/establish_cursors.h"
 #include "mongo/s/query/store_possible_cursor.h"
 #include "mongo/s/stale_exception.h"
@@ -498,6 +499,22 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
             !query.getQueryRequest().getRequestResumeToken() &&
                 query.getQueryRequest().getResumeAfter().isEmpty());
 
+    // Serve the query from the result cache if it was run recently enough on a cacheable
+    // namespace. Otherwise remember what the cache looked like before running it, so that results
+    // which may predate a concurrent write are not cached.
+    auto resultCache = ClusterFindResultCache::get(opCtx);
+    auto resultCacheKey = ClusterFindResultCache::makeKey(opCtx, query, readPref);
+    auto resultCacheEpoch = resultCache->getInvalidationEpoch();
+    if (resultCacheKey) {
+        auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+        if (auto cachedResults = resultCache->lookup(*resultCacheKey, now)) {
+            *results = std::move(*cachedResults);
+            CurOp::get(opCtx)->debug().nreturned = results->size();
+            CurOp::get(opCtx)->debug().cursorExhausted = true;
+            return CursorId(0);
+        }
+    }
+
     auto const catalogCache = Grid::get(opCtx)->catalogCache();
 
     // Re-target and re-send the initial find command to the shards until we have established the
@@ -513,8 +530,22 @@ CursorId ClusterFind::runQuery(OperationContext* opCtx,
         const auto cm = uassertStatusOK(std::move(swCM));
 
         try {
-            return runQueryWithoutRetrying(
-                opCtx, query, readPref, cm, results, partialResultsReturned);
+            bool resultsArePartial = false;
+            auto cursorId =
+                runQueryWithoutRetrying(opCtx, query, readPref, cm, results, &resultsArePartial);
+            if (partialResultsReturned) {
+                *partialResultsReturned = resultsArePartial;
+            }
+
+            // Only complete results, which did not leave a cursor open, are cached.
+            if (resultCacheKey && cursorId == 0 && !resultsArePartial) {
+                resultCache->insert(query.nss(),
+                                    std::move(*resultCacheKey),
+                                    *results,
+                                    resultCacheEpoch,
+                                    opCtx->getServiceContext()->getFastClockSource()->now());
+            }
+            return cursorId;
         } catch (ExceptionFor<ErrorCodes::StaleDbVersion>& ex) {
             if (retries >= kMaxRetries) {
                 // Check if there are no retries remaining, so the last received error can be
@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_result_cache.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/repl/read_concern_args.h"
+#include "mongo/db/service_context.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/s/transaction_router.h"
+
+namespace mongo {
+namespace {
+
+const auto getClusterFindResultCache =
+    ServiceContext::declareDecoration<ClusterFindResultCache>();
+
+Counter64 clusterFindResultCacheHits;
+ServerStatusMetricField<Counter64> clusterFindResultCacheHitsStats(
+    "query.clusterResultCache.hits", &clusterFindResultCacheHits);
+
+Counter64 clusterFindResultCacheMisses;
+ServerStatusMetricField<Counter64> clusterFindResultCacheMissesStats(
+    "query.clusterResultCache.misses", &clusterFindResultCacheMisses);
+
+bool isCacheableNamespace(const NamespaceString& nss) {
+    const auto namespaces = clusterQueryResultCacheNamespaces.get();
+    return std::find(namespaces.begin(), namespaces.end(), nss.ns()) != namespaces.end();
+}
+
+bool isCacheableReadConcern(const repl::ReadConcernArgs& readConcernArgs) {
+    if (readConcernArgs.getArgsAfterClusterTime() || readConcernArgs.getArgsAtClusterTime() ||
+        readConcernArgs.getArgsOpTime()) {
+        return false;
+    }
+    const auto level = readConcernArgs.getLevel();
+    return level == repl::ReadConcernLevel::kLocalReadConcern ||
+        level == repl::ReadConcernLevel::kAvailableReadConcern;
+}
+
+}  // namespace
+
+ClusterFindResultCache* ClusterFindResultCache::get(ServiceContext* serviceContext) {
+    return &getClusterFindResultCache(serviceContext);
+}
+
+ClusterFindResultCache* ClusterFindResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+boost::optional<std::string> ClusterFindResultCache::makeKey(
+    OperationContext* opCtx, const CanonicalQuery& query, const ReadPreferenceSetting& readPref) {
+    const auto& qr = query.getQueryRequest();
+    if (!isCacheableNamespace(query.nss()) || TransactionRouter::get(opCtx) ||
+        !isCacheableReadConcern(repl::ReadConcernArgs::get(opCtx)) || qr.isTailable()) {
+        return boost::none;
+    }
+
+    // Key on the normalized filter of the canonical query, so that equivalent filters written
+    // differently share their results, and on everything else the find command carries.
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", query.nss().ns());
+    keyBuilder.append("filter", query.root()->serialize());
+    keyBuilder.append("find", qr.asFindCommand().removeField(QueryRequest::kFilterField));
+    readPref.toContainingBSON(&keyBuilder);
+
+    const auto key = keyBuilder.obj();
+    return std::string(key.objdata(), key.objsize());
+}
+
+boost::optional<std::vector<BSONObj>> ClusterFindResultCache::lookup(const std::string& key,
+                                                                     Date_t now) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        clusterFindResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    if (it->second.expiresAt <= now) {
+        _entries.erase(it);
+        clusterFindResultCacheMisses.increment();
+        return boost::none;
+    }
+
+    clusterFindResultCacheHits.increment();
+    return it->second.results;
+}
+
+uint64_t ClusterFindResultCache::getInvalidationEpoch() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _invalidationEpoch;
+}
+
+void ClusterFindResultCache::insert(const NamespaceString& nss,
+                                    std::string key,
+                                    const std::vector<BSONObj>& results,
+                                    uint64_t invalidationEpoch,
+                                    Date_t now) {
+    const auto maxEntries = static_cast<size_t>(clusterQueryResultCacheMaxEntries.load());
+    const auto maxEntryBytes = clusterQueryResultCacheMaxEntryBytes.load();
+
+    long long totalBytes = 0;
+    for (const auto& result : results) {
+        totalBytes += result.objsize();
+        if (totalBytes > maxEntryBytes) {
+            return;
+        }
+    }
+
+    Entry entry{nss, {}, now + Seconds(clusterQueryResultCacheTTLSecs.load())};
+    entry.results.reserve(results.size());
+    for (const auto& result : results) {
+        entry.results.push_back(result.getOwned());
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_invalidationEpoch != invalidationEpoch) {
+        return;
+    }
+
+    _entries.add(std::move(key), std::move(entry));
+    while (_entries.size() > maxEntries) {
+        _entries.erase(std::prev(_entries.end()));
+    }
+}
+
+void ClusterFindResultCache::invalidate(const NamespaceString& nss) {
+    // Keep writes to other namespaces off the cache mutex. The results of a namespace which is no
+    // longer cacheable are never served, so they need not be dropped either.
+    if (!isCacheableNamespace(nss)) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_invalidationEpoch;
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->second.nss == nss) {
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t ClusterFindResultCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class CanonicalQuery;
+class OperationContext;
+class ServiceContext;
+struct ReadPreferenceSetting;
+
+/**
+ * Decoration on the mongos ServiceContext which caches the complete results of find commands on
+ * the namespaces listed in 'clusterQueryResultCacheNamespaces', so that repeated reads of rarely
+ * written collections can be answered without contacting the shards.
+ *
+ * Cached results expire after 'clusterQueryResultCacheTTLSecs', and the results of a namespace
+ * are dropped whenever a write to it is routed through this mongos. Writes made through other
+ * routers are only seen once the cached results expire.
+ */
+class ClusterFindResultCache {
+    ClusterFindResultCache(const ClusterFindResultCache&) = delete;
+    ClusterFindResultCache& operator=(const ClusterFindResultCache&) = delete;
+
+public:
+    ClusterFindResultCache() = default;
+
+    static ClusterFindResultCache* get(ServiceContext* serviceContext);
+    static ClusterFindResultCache* get(OperationContext* opCtx);
+
+    /**
+     * Returns the key under which the results of 'query' are cached, or boost::none if its
+     * results may not be cached. Only queries outside of transactions, with a local or available
+     * read concern, on a namespace listed in 'clusterQueryResultCacheNamespaces' may be cached.
+     *
+     * The key is made of the normalized filter of the query together with its other parameters
+     * and the read preference, so that queries of the same shape with different values do not
+     * share results.
+     */
+    static boost::optional<std::string> makeKey(OperationContext* opCtx,
+                                                const CanonicalQuery& query,
+                                                const ReadPreferenceSetting& readPref);
+
+    /**
+     * Returns the cached results for 'key' if they have not expired as of 'now'.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const std::string& key, Date_t now);
+
+    /**
+     * Returns a token which must be passed to insert() for results read after this call.
+     */
+    uint64_t getInvalidationEpoch() const;
+
+    /**
+     * Caches 'results' of the query on 'nss' under 'key' until 'now' plus the configured TTL.
+     * The results are not cached if they are too large, or if any namespace was invalidated since
+     * 'invalidationEpoch' was obtained, since they may then predate a write.
+     */
+    void insert(const NamespaceString& nss,
+                std::string key,
+                const std::vector<BSONObj>& results,
+                uint64_t invalidationEpoch,
+                Date_t now);
+
+    /**
+     * Drops all the cached results of queries on 'nss'.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Returns the number of cached query results.
+     */
+    size_t size() const;
+
+private:
+    struct Entry {
+        NamespaceString nss;
+        std::vector<BSONObj> results;
+        Date_t expiresAt;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterFindResultCache::_mutex");
+
+    // The capacity is enforced against 'clusterQueryResultCacheMaxEntries' on every insert, so
+    // that it can be changed at runtime.
+    LRUCache<std::string, Entry> _entries{std::numeric_limits<std::size_t>::max()};
+
+    // Incremented by every invalidation.
+    uint64_t _invalidationEpoch = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,130 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/query/cluster_find_result_cache.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/s/query/cluster_query_knobs_gen.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.cacheable");
+const NamespaceString kOtherNss("test.alsoCacheable");
+
+class ClusterFindResultCacheTest : public unittest::Test {
+protected:
+    void setUp() override {
+        _oldNamespaces = clusterQueryResultCacheNamespaces.get();
+        clusterQueryResultCacheNamespaces = std::vector<std::string>{kNss.ns(), kOtherNss.ns()};
+    }
+
+    void tearDown() override {
+        clusterQueryResultCacheNamespaces = _oldNamespaces;
+    }
+
+    const Date_t _now = Date_t::fromMillisSinceEpoch(100000);
+    ClusterFindResultCache _cache;
+
+private:
+    std::vector<std::string> _oldNamespaces;
+};
+
+TEST_F(ClusterFindResultCacheTest, LookupReturnsInsertedResultsUntilTheyExpire) {
+    const std::vector<BSONObj> results = {BSON("_id" << 1), BSON("_id" << 2)};
+    _cache.insert(kNss, "key", results, _cache.getInvalidationEpoch(), _now);
+    ASSERT_EQ(1U, _cache.size());
+    ASSERT_FALSE(_cache.lookup("otherKey", _now));
+
+    auto cachedResults = _cache.lookup("key", _now + Seconds(1));
+    ASSERT(cachedResults);
+    ASSERT_EQ(2U, cachedResults->size());
+    ASSERT_BSONOBJ_EQ(results[0], (*cachedResults)[0]);
+    ASSERT_BSONOBJ_EQ(results[1], (*cachedResults)[1]);
+
+    ASSERT_FALSE(_cache.lookup("key", _now + Seconds(clusterQueryResultCacheTTLSecs.load())));
+    ASSERT_EQ(0U, _cache.size());
+}
+
+TEST_F(ClusterFindResultCacheTest, InvalidateDropsOnlyTheResultsOfTheNamespace) {
+    _cache.insert(kNss, "key", {BSON("_id" << 1)}, _cache.getInvalidationEpoch(), _now);
+    _cache.insert(kOtherNss, "otherKey", {BSON("_id" << 2)}, _cache.getInvalidationEpoch(), _now);
+
+    _cache.invalidate(kNss);
+    ASSERT_FALSE(_cache.lookup("key", _now));
+    ASSERT(_cache.lookup("otherKey", _now));
+}
+
+TEST_F(ClusterFindResultCacheTest, ResultsReadBeforeAnInvalidationAreNotCached) {
+    const auto epoch = _cache.getInvalidationEpoch();
+    _cache.invalidate(kNss);
+    _cache.insert(kNss, "key", {BSON("_id" << 1)}, epoch, _now);
+    ASSERT_EQ(0U, _cache.size());
+
+    // Writes to namespaces which are not cacheable do not invalidate anything.
+    const auto newEpoch = _cache.getInvalidationEpoch();
+    _cache.invalidate(NamespaceString("test.notCacheable"));
+    _cache.insert(kNss, "key", {BSON("_id" << 1)}, newEpoch, _now);
+    ASSERT_EQ(1U, _cache.size());
+}
+
+TEST_F(ClusterFindResultCacheTest, ResultsLargerThanTheEntryLimitAreNotCached) {
+    const auto oldMaxEntryBytes = clusterQueryResultCacheMaxEntryBytes.load();
+    clusterQueryResultCacheMaxEntryBytes.store(BSON("_id" << 1).objsize());
+    ON_BLOCK_EXIT([&] { clusterQueryResultCacheMaxEntryBytes.store(oldMaxEntryBytes); });
+
+    _cache.insert(kNss, "small", {BSON("_id" << 1)}, _cache.getInvalidationEpoch(), _now);
+    _cache.insert(
+        kNss, "large", {BSON("_id" << 1), BSON("_id" << 2)}, _cache.getInvalidationEpoch(), _now);
+    ASSERT(_cache.lookup("small", _now));
+    ASSERT_FALSE(_cache.lookup("large", _now));
+}
+
+TEST_F(ClusterFindResultCacheTest, LeastRecentlyUsedResultsAreEvicted) {
+    const auto oldMaxEntries = clusterQueryResultCacheMaxEntries.load();
+    clusterQueryResultCacheMaxEntries.store(2);
+    ON_BLOCK_EXIT([&] { clusterQueryResultCacheMaxEntries.store(oldMaxEntries); });
+
+    _cache.insert(kNss, "first", {BSON("_id" << 1)}, _cache.getInvalidationEpoch(), _now);
+    _cache.insert(kNss, "second", {BSON("_id" << 2)}, _cache.getInvalidationEpoch(), _now);
+    ASSERT(_cache.lookup("first", _now));
+
+    _cache.insert(kNss, "third", {BSON("_id" << 3)}, _cache.getInvalidationEpoch(), _now);
+    ASSERT_EQ(2U, _cache.size());
+    ASSERT(_cache.lookup("first", _now));
+    ASSERT_FALSE(_cache.lookup("second", _now));
+    ASSERT(_cache.lookup("third", _now));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kSharding
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/s/routing_table_prefetcher.h"
+
+#include <boost/optional.hpp>
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/s/catalog/sharding_catalog_client.h"
+#include "mongo/s/catalog/type_chunk.h"
+#include "mongo/s/catalog_cache.h"
+#include "mongo/s/grid.h"
+#include "mongo/s/mongos_server_parameters_gen.h"
+#include "mongo/util/periodic_runner.h"
+
+namespace mongo {
+namespace {
+
+const auto getPrefetcherJob =
+    ServiceContext::declareDecoration<boost::optional<PeriodicJobAnchor>>();
+
+}  // namespace
+
+void RoutingTablePrefetcher::start(ServiceContext* serviceContext) {
+    const auto intervalMS = gRoutingTablePrefetchIntervalMS.load();
+    if (intervalMS <= 0) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    PeriodicRunner::PeriodicJob job(
+        "routingTablePrefetcher",
+        [](Client* client) {
+            auto opCtx = client->makeOperationContext();
+            try {
+                prefetchStaleRoutingTables(opCtx.get());
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(5190660,
+                            1,
+                            "Failed to prefetch routing tables",
+                            "error"_attr = redact(ex.toStatus()));
+            }
+        },
+        Milliseconds(intervalMS));
+
+    auto& anchor = getPrefetcherJob(serviceContext);
+    invariant(!anchor);
+    anchor.emplace(periodicRunner->makeJob(std::move(job)));
+    anchor->start();
+}
+
+void RoutingTablePrefetcher::prefetchStaleRoutingTables(OperationContext* opCtx) {
+    const auto grid = Grid::get(opCtx);
+    if (!grid->isShardingInitialized()) {
+        return;
+    }
+
+    const auto catalogCache = grid->catalogCache();
+    const auto catalogClient = grid->catalogClient();
+
+    for (const auto& [nss, cachedVersion] : catalogCache->getCachedShardedCollectionVersions()) {
+        // Only the most recent chunk is needed, since its version is the collection version
+        auto swChunks = catalogClient->getChunks(
+            opCtx,
+            BSON(ChunkType::ns() << nss.ns() << ChunkType::lastmod() << GT
+                                 << Timestamp(cachedVersion.toLong())),
+            BSON(ChunkType::lastmod() << -1),
+            1,
+            nullptr,
+            repl::ReadConcernLevel::kMajorityReadConcern);
+        if (!swChunks.isOK()) {
+            LOGV2_DEBUG(5190661,
+                        1,
+                        "Failed to check the config server for newer chunks",
+                        "namespace"_attr = nss,
+                        "error"_attr = redact(swChunks.getStatus()));
+            continue;
+        }
+
+        if (!swChunks.getValue().empty()) {
+            catalogCache->prefetchCollectionRoutingInfo(nss,
+                                                        swChunks.getValue().front().getVersion());
+        }
+    }
+}
+
+}  // namespace mongo
@@ -31,9 +31,12 @@
 
 #include "mongo/platform/basic.h"
 
-#include "mongo/client/replica_set_monitor.h"
 #include "mongo/s/sharding_task_executor_pool_controller.h"
 
+#include <cmath>
+
+#include "mongo/client/replica_set_monitor.h"
+
 namespace mongo {
 
 namespace {
@@ -216,7 +219,7 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t maxConns = gParameters.maxConnections.load();
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    poolData.target = _targetForDemand(lk, poolData, stats);
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -264,6 +267,35 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     return {groupData->members, shouldShutdown};
 }
 
+size_t ShardingTaskExecutorPoolController::_targetForDemand(WithLock,
+                                                           PoolData& poolData,
+                                                           const HostState& stats) {
+    const size_t demand = stats.requests + stats.active;
+    const auto windowMS = gParameters.adaptiveSizingWindowMS.load();
+    if (windowMS <= 0) {
+        return demand;
+    }
+
+    // Average the demand over the window, weighting each sample by how long it was current. By
+    // Little's law, this average concurrency is the number of connections needed to serve the
+    // host's request rate at its current latency, while a burst of requests, such as the one that
+    // follows a failover, only raises the target as it persists rather than all at once.
+    const auto now = Date_t::now();
+    if (poolData.lastUpdate == Date_t()) {
+        poolData.averageDemand = demand;
+    } else {
+        const auto elapsedMS = durationCount<Milliseconds>(now - poolData.lastUpdate);
+        const double weight = 1 - std::exp(-static_cast<double>(std::max(elapsedMS, 0LL)) /
+                                           static_cast<double>(windowMS));
+        poolData.averageDemand += weight * (static_cast<double>(demand) - poolData.averageDemand);
+    }
+    poolData.lastUpdate = now;
+
+    // Never drop connections which are in use, and always allow one to serve waiting requests.
+    const size_t target = std::ceil(poolData.averageDemand);
+    return std::max({target, stats.active, stats.requests ? size_t{1} : size_t{0}});
+}
+
 void ShardingTaskExecutorPoolController::removeHost(PoolId id) {
     stdx::lock_guard lk(_mutex);
     auto it = _poolDatas.find(id);
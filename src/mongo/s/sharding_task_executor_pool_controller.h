@@ -87,6 +87,8 @@ public:
         AtomicWord<int> pendingTimeoutMS;
         AtomicWord<int> toRefreshTimeoutMS;
 
+        AtomicWord<int> adaptiveSizingWindowMS;
+
         synchronized_value<std::string> matchingStrategyString;
         AtomicWord<MatchingStrategy> matchingStrategy;
     };
@@ -133,6 +135,16 @@ private:
     void _addGroup(WithLock, const ReplicaSetChangeNotifier::State& state);
     void _removeGroup(WithLock, const std::string& key);
 
+    struct PoolData;
+
+    /**
+     * Returns the number of connections which the pool should maintain for its current demand.
+     *
+     * Without adaptive sizing, that is its number of requests plus its number of active
+     * connections. With adaptive sizing, it is their average over the adaptive sizing window.
+     */
+    static size_t _targetForDemand(WithLock, PoolData& poolData, const HostState& stats);
+
     /**
      * GroupData is a shared state for a set of hosts (a replica set).
      *
@@ -179,6 +191,11 @@ private:
 
         // This host is able to shutdown
         bool isAbleToShutdown = false;
+
+        // The average of the requests plus active connections of the pool over the adaptive
+        // sizing window, as of lastUpdate
+        double averageDemand = 0;
+        Date_t lastUpdate;
     };
 
     /**
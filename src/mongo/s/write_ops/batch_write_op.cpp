@@ -301,6 +301,27 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
 
     const size_t numWriteOps = _clientRequest.sizeWriteOps();
 
+    // The remaining inserts of an unordered batch are targeted all at once, which lets the targeter
+    // share the work between the documents falling into the same chunk. Ordered batches stop at
+    // the first write going to another shard, so they keep targeting one write at a time.
+    std::vector<boost::optional<StatusWith<ShardEndpoint>>> insertEndpoints;
+    if (!ordered && _clientRequest.getBatchType() == BatchedCommandRequest::BatchType_Insert) {
+        std::vector<size_t> readyOpIndexes;
+        std::vector<BSONObj> docs;
+        for (size_t i = 0; i < numWriteOps; ++i) {
+            if (_writeOps[i].getWriteState() == WriteOpState_Ready) {
+                readyOpIndexes.push_back(i);
+                docs.push_back(_writeOps[i].getWriteItem().getDocument());
+            }
+        }
+
+        auto endpoints = targeter.targetInserts(_opCtx, docs);
+        insertEndpoints.resize(numWriteOps);
+        for (size_t i = 0; i < readyOpIndexes.size(); ++i) {
+            insertEndpoints[readyOpIndexes[i]] = std::move(endpoints[i]);
+        }
+    }
+
     for (size_t i = 0; i < numWriteOps; ++i) {
         WriteOp& writeOp = _writeOps[i];
 
@@ -317,10 +338,19 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         vector<TargetedWrite*>& writes = writesOwned.mutableVector();
 
         Status targetStatus = Status::OK();
-        try {
-            writeOp.targetWrites(_opCtx, targeter, &writes);
-        } catch (const DBException& ex) {
-            targetStatus = ex.toStatus();
+        if (!insertEndpoints.empty()) {
+            auto& swEndpoint = *insertEndpoints[i];
+            if (swEndpoint.isOK()) {
+                writeOp.targetInsert(std::move(swEndpoint.getValue()), &writes);
+            } else {
+                targetStatus = swEndpoint.getStatus();
+            }
+        } else {
+            try {
+                writeOp.targetWrites(_opCtx, targeter, &writes);
+            } catch (const DBException& ex) {
+                targetStatus = ex.toStatus();
+            }
         }
 
         if (!targetStatus.isOK()) {
@@ -390,17 +420,24 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         const int errorResponsePotentialSizeBytes =
             ordered ? 0 : write_ops::kWriteCommandBSONArrayPerElementOverheadBytes + 256;
 
+        // A write which does not fit in the batches of this round is left for the next one. Since
+        // unordered writes may be applied in any order, targeting carries on with the following
+        // writes, so that the shards other than the ones with a full batch still get all of their
+        // writes in this round, instead of waiting on the slowest shard of this round to get them.
         if (wouldMakeBatchesTooBig(
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered) {
+                break;
+            }
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
             isNewBatchRequiredUnordered(writes, batchMap, targetedShards)) {
             writeOp.cancelWrites(nullptr);
-            break;
+            continue;
         }
 
         //
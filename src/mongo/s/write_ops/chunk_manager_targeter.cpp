@@ -383,6 +383,62 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
     return ShardEndpoint(_cm->dbPrimary(), ChunkVersion::UNSHARDED(), _cm->dbVersion());
 }
 
+std::vector<StatusWith<ShardEndpoint>> ChunkManagerTargeter::targetInserts(
+    OperationContext* opCtx, const std::vector<BSONObj>& docs) const {
+    if (!_cm->isSharded()) {
+        return NSTargeter::targetInserts(opCtx, docs);
+    }
+
+    std::vector<StatusWith<ShardEndpoint>> endpoints(
+        docs.size(), Status(ErrorCodes::InternalError, "Document was not targeted"));
+
+    struct DocShardKey {
+        std::string keyString;
+        BSONObj shardKey;
+        size_t docIndex;
+    };
+    std::vector<DocShardKey> docShardKeys;
+    docShardKeys.reserve(docs.size());
+    for (size_t i = 0; i < docs.size(); ++i) {
+        try {
+            auto shardKey = _cm->getShardKeyPattern().extractShardKeyFromDoc(docs[i]);
+            uassert(ErrorCodes::ShardKeyNotFound,
+                    "Shard key cannot contain array values or array descendants.",
+                    !shardKey.isEmpty());
+            auto keyString = ShardKeyPattern::toKeyString(shardKey);
+            docShardKeys.push_back({std::move(keyString), std::move(shardKey), i});
+        } catch (const DBException& ex) {
+            endpoints[i] = ex.toStatus();
+        }
+    }
+
+    // Once sorted by KeyString, the documents of a chunk follow one another, so each chunk only has
+    // to be looked up in the routing table once.
+    std::sort(docShardKeys.begin(), docShardKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.keyString < rhs.keyString;
+    });
+
+    boost::optional<Chunk> chunk;
+    boost::optional<ShardEndpoint> chunkEndpoint;
+    for (const auto& docShardKey : docShardKeys) {
+        if (!chunk || !chunk->containsKey(docShardKey.shardKey)) {
+            chunk.reset();
+            try {
+                chunk.emplace(
+                    _cm->findIntersectingChunk(docShardKey.shardKey, CollationSpec::kSimpleSpec));
+                chunkEndpoint.emplace(chunk->getShardId(), _cm->getVersion(chunk->getShardId()));
+            } catch (const DBException& ex) {
+                chunk.reset();
+                endpoints[docShardKey.docIndex] = ex.toStatus();
+                continue;
+            }
+        }
+        endpoints[docShardKey.docIndex] = *chunkEndpoint;
+    }
+
+    return endpoints;
+}
+
 std::vector<ShardEndpoint> ChunkManagerTargeter::targetUpdate(OperationContext* opCtx,
                                                               const BatchItemRef& itemRef) const {
     // If the update is replacement-style:
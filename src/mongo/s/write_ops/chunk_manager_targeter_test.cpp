@@ -117,6 +117,42 @@ TEST_F(ChunkManagerTargeterTest, TargetInsertWithRangePrefixHashedShardKey) {
                        ErrorCodes::ShardKeyNotFound);
 }
 
+TEST_F(ChunkManagerTargeterTest, TargetInsertsMatchesTargetInsertForEachDocument) {
+    std::vector<BSONObj> splitPoints = {
+        BSON("a.b" << BSONNULL), BSON("a.b" << -100), BSON("a.b" << 0), BSON("a.b" << 100)};
+    auto cmTargeter = prepare(BSON("a.b" << 1 << "c.d"
+                                         << "hashed"),
+                              splitPoints);
+
+    const std::vector<BSONObj> docs = {fromjson("{a: {b: 1000}, c: null, d: {}}"),
+                                       fromjson("{a: {b: -10}}"),
+                                       fromjson("{a: [1,2]}"),
+                                       fromjson("{a: {b: 0}, c: {d: 4}}"),
+                                       fromjson("{a: {b: -111}, c: {d: '1'}}"),
+                                       fromjson("{a: {b: -20}}"),
+                                       BSONObj(),
+                                       fromjson("{a: {b: 101}}"),
+                                       fromjson("{c: {d: [1,2]}}")};
+
+    auto endpoints = cmTargeter.targetInserts(operationContext(), docs);
+    ASSERT_EQ(endpoints.size(), docs.size());
+
+    const std::vector<std::string> expectedShards = {"4", "2", "", "3", "1", "2", "1", "4", ""};
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (expectedShards[i].empty()) {
+            ASSERT_EQ(endpoints[i].getStatus(), ErrorCodes::ShardKeyNotFound);
+            continue;
+        }
+
+        ASSERT_OK(endpoints[i].getStatus());
+        ASSERT_EQUALS(endpoints[i].getValue().shardName, expectedShards[i]);
+
+        auto res = cmTargeter.targetInsert(operationContext(), docs[i]);
+        ASSERT_EQUALS(endpoints[i].getValue().shardName, res.shardName);
+        ASSERT_EQUALS(endpoints[i].getValue().shardVersion, res.shardVersion);
+    }
+}
+
 TEST_F(ChunkManagerTargeterTest, TargetInsertsWithVaryingHashedPrefixAndConstantRangedSuffix) {
     // Create 4 chunks and 4 shards such that shardId '0' has chunk [MinKey, -2^62), '1' has chunk
     // [-2^62, 0), '2' has chunk ['0', 2^62) and '3' has chunk [2^62, MaxKey).
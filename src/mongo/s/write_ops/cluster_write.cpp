@@ -37,7 +37,9 @@
 
 #include "mongo/db/lasterror.h"
 #include "mongo/s/grid.h"
+#include "mongo/s/query/cluster_find_result_cache.h"
 #include "mongo/s/write_ops/chunk_manager_targeter.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -48,6 +50,10 @@ void ClusterWriter::write(OperationContext* opCtx,
                           boost::optional<OID> targetEpoch) {
     LastError::Disabled disableLastError(&LastError::get(opCtx->getClient()));
 
+    // Drop the cached query results of the namespace once the write has been attempted, whether
+    // or not it succeeded, since it may have been applied on some of the shards.
+    ON_BLOCK_EXIT([&] { ClusterFindResultCache::get(opCtx)->invalidate(request.getNS()); });
+
     ChunkManagerTargeter targeter(opCtx, request.getNS(), targetEpoch);
 
     if (targeter.endpointIsConfigServer()) {
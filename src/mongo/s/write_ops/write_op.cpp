@@ -76,6 +76,20 @@ void WriteOp::targetWrites(OperationContext* opCtx,
         endpoints = targeter.targetAllShards(opCtx);
     }
 
+    _addTargetedWrites(std::move(endpoints), inTransaction, targetedWrites);
+}
+
+void WriteOp::targetInsert(ShardEndpoint endpoint, std::vector<TargetedWrite*>* targetedWrites) {
+    invariant(_itemRef.getOpType() == BatchedCommandRequest::BatchType_Insert);
+
+    std::vector<ShardEndpoint> endpoints;
+    endpoints.push_back(std::move(endpoint));
+    _addTargetedWrites(std::move(endpoints), _inTxn, targetedWrites);
+}
+
+void WriteOp::_addTargetedWrites(std::vector<ShardEndpoint> endpoints,
+                                 bool inTransaction,
+                                 std::vector<TargetedWrite*>* targetedWrites) {
     for (auto&& endpoint : endpoints) {
         // If the operation was already successfull on that shard, do not repeat it
         if (_successfulShardSet.count(endpoint.shardName))
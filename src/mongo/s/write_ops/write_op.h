@@ -123,6 +123,12 @@ public:
                       const NSTargeter& targeter,
                       std::vector<TargetedWrite*>* targetedWrites);
 
+    /**
+     * Same as targetWrites() for an insert whose endpoint was already targeted, along with the
+     * other inserts of its batch.
+     */
+    void targetInsert(ShardEndpoint endpoint, std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Returns the number of child writes that were last targeted.
      */
@@ -161,6 +167,13 @@ public:
     void setOpError(const WriteErrorDetail& error);
 
 private:
+    /**
+     * Creates a TargetedWrite for each of 'endpoints' on which this write op hasn't succeeded yet.
+     */
+    void _addTargetedWrites(std::vector<ShardEndpoint> endpoints,
+                            bool inTransaction,
+                            std::vector<TargetedWrite*>* targetedWrites);
+
     /**
      * Updates the op state after new information is received.
      */
@@ -33,6 +33,8 @@
 
 #include "mongo/transport/message_compressor_manager.h"
 
+#include <algorithm>
+
 #include "mongo/base/data_range_cursor.h"
 #include "mongo/base/data_type_endian.h"
 #include "mongo/bson/bsonobj.h"
@@ -213,8 +215,16 @@ void MessageCompressorManager::clientBegin(BSONObjBuilder* output) {
     if (compressorList.size() == 0)
         return;
 
+    // The server negotiates the compressors in the order they are offered, and the first one is
+    // used for the messages of the connection.
+    std::vector<std::string> offered(compressorList.begin(), compressorList.end());
+    auto preferred = std::find(offered.begin(), offered.end(), _clientPreferredCompressor);
+    if (preferred != offered.end()) {
+        std::rotate(offered.begin(), preferred, preferred + 1);
+    }
+
     BSONArrayBuilder sub(output->subarrayStart("compression"));
-    for (const auto e : _registry->getCompressorNames()) {
+    for (const auto& e : offered) {
         LOGV2_DEBUG(22929,
                     3,
                     "Offering {compressor} compressor to server",
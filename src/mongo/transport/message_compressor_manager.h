@@ -33,6 +33,7 @@
 #include "mongo/transport/message_compressor_base.h"
 #include "mongo/transport/session.h"
 
+#include <string>
 #include <vector>
 
 namespace mongo {
@@ -68,6 +69,15 @@ public:
      */
     void clientBegin(BSONObjBuilder* output);
 
+    /*
+     * Makes clientBegin offer the compressor named 'name' before the others, so that the messages
+     * of this connection are compressed with it when the server supports it. An empty name, or
+     * the name of a compressor which isn't configured, keeps the order of the registry.
+     */
+    void setClientPreferredCompressor(std::string name) {
+        _clientPreferredCompressor = std::move(name);
+    }
+
     /*
      * Called by a client that has received an isMaster response (received after calling
      * clientBegin) and wants to finish negotiating compression.
@@ -129,6 +139,7 @@ public:
 private:
     std::vector<MessageCompressorBase*> _negotiated;
     MessageCompressorRegistry* _registry;
+    std::string _clientPreferredCompressor;
 };
 
 }  // namespace mongo
@@ -220,6 +220,44 @@ TEST(MessageCompressorManager, FullNormalCompression) {
     clientManager.clientFinish(serverObj);
 }
 
+TEST(MessageCompressorManager, ClientPreferredCompressorIsOfferedFirst) {
+    MessageCompressorRegistry registry;
+    registry.setSupportedCompressors({"snappy", "zstd", "noop"});
+    registry.registerImplementation(std::make_unique<SnappyMessageCompressor>());
+    registry.registerImplementation(std::make_unique<ZstdMessageCompressor>());
+    registry.registerImplementation(std::make_unique<NoopMessageCompressor>());
+    ASSERT_OK(registry.finalizeSupportedCompressors());
+
+    MessageCompressorManager clientManager(&registry);
+    BSONObjBuilder defaultOutput;
+    clientManager.clientBegin(&defaultOutput);
+    checkNegotiationResult(defaultOutput.done(), {"snappy", "zstd", "noop"});
+
+    clientManager.setClientPreferredCompressor("zstd");
+    BSONObjBuilder clientOutput;
+    clientManager.clientBegin(&clientOutput);
+    auto clientObj = clientOutput.done();
+    checkNegotiationResult(clientObj, {"zstd", "snappy", "noop"});
+
+    MessageCompressorManager serverManager(&registry);
+    BSONObjBuilder serverOutput;
+    serverManager.serverNegotiate(clientObj, &serverOutput);
+    auto serverObj = serverOutput.done();
+    checkNegotiationResult(serverObj, {"zstd", "snappy", "noop"});
+    clientManager.clientFinish(serverObj);
+
+    auto compressed = assertOk(clientManager.compressMessage(buildMessage()));
+    MessageCompressorId compressorId;
+    assertOk(serverManager.decompressMessage(compressed, &compressorId));
+    ASSERT_EQ(compressorId, registry.getCompressor("zstd")->getId());
+
+    // A compressor which isn't configured leaves the order of the registry.
+    clientManager.setClientPreferredCompressor("zlib");
+    BSONObjBuilder zlibOutput;
+    clientManager.clientBegin(&zlibOutput);
+    checkNegotiationResult(zlibOutput.done(), {"snappy", "zstd", "noop"});
+}
+
 TEST(NoopMessageCompressor, Fidelity) {
     auto testMessage = buildMessage();
     checkFidelity(testMessage, std::make_unique<NoopMessageCompressor>());
@@ -36,8 +36,32 @@
 #include "mongo/base/init.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
+#include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+// ZSTD_compress() and ZSTD_decompress() allocate and initialize a fresh context on every call,
+// which costs more than compressing a small message does. Each thread keeps its contexts instead,
+// as a thread only ever compresses or decompresses one message at a time.
+struct ZstdContexts {
+    ZstdContexts() : cctx(ZSTD_createCCtx()), dctx(ZSTD_createDCtx()) {
+        invariant(cctx && dctx);
+    }
+
+    ~ZstdContexts() {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+
+    ZSTD_CCtx* const cctx;
+    ZSTD_DCtx* const dctx;
+};
+
+ZstdContexts& getThreadZstdContexts() {
+    thread_local ZstdContexts contexts;
+    return contexts;
+}
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +71,12 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    size_t ret = ZSTD_compressCCtx(getThreadZstdContexts().cctx,
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +88,11 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    size_t ret = ZSTD_decompressDCtx(getThreadZstdContexts().dctx,
+                                     const_cast<char*>(output.data()),
+                                     output.length(),
+                                     input.data(),
+                                     input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
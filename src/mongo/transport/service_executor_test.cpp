@@ -41,6 +41,7 @@
 #include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/transport_layer.h"
 #include "mongo/transport/transport_layer_mock.h"
 #include "mongo/unittest/barrier.h"
@@ -73,7 +74,8 @@ public:
     ASIOReactor() : _ioContext() {}
 
     void run() noexcept final {
-        MONGO_UNREACHABLE;
+        asio::io_context::work work(_ioContext);
+        _ioContext.run();
     }
 
     void runFor(Milliseconds time) noexcept final {
@@ -398,5 +400,79 @@ TEST_F(ServiceExecutorFixedFixture, StartAndShutdownAreDeterministic) {
     shutdownThread.join();
 }
 
+class ServiceExecutorWorkStealingFixture : public unittest::Test {
+public:
+    static constexpr auto kNumWorkers = 2;
+
+protected:
+    void setUp() override {
+        executor = std::make_unique<ServiceExecutorWorkStealing>(
+            std::make_shared<ASIOReactor>(), kNumWorkers, false /* pinWorkersToCores */);
+    }
+
+    std::unique_ptr<ServiceExecutorWorkStealing> executor;
+};
+
+TEST_F(ServiceExecutorWorkStealingFixture, ScheduleFailsBeforeStartup) {
+    scheduleBasicTask(executor.get(), false);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, BasicTaskRuns) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    scheduleBasicTask(executor.get(), true);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, IdleWorkerStealsTaskFromBusyWorker) {
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    // The inner task is queued on the worker running the outer task, which then blocks until the
+    // inner task has run, so it can only run if the other worker steals it.
+    auto stolen = std::make_shared<unittest::Barrier>(2);
+    auto done = std::make_shared<unittest::Barrier>(2);
+    ASSERT_OK(executor->scheduleTask(
+        [this, stolen, done] {
+            ASSERT_OK(executor->scheduleTask([stolen] { stolen->countDownAndWait(); },
+                                             ServiceExecutor::kEmptyFlags));
+            stolen->countDownAndWait();
+            done->countDownAndWait();
+        },
+        ServiceExecutor::kEmptyFlags));
+    done->countDownAndWait();
+
+    BSONObjBuilder bob;
+    executor->appendStats(&bob);
+    auto obj = bob.obj();
+    ASSERT_EQ(obj.getStringField("executor"), "workStealing"_sd);
+    ASSERT_EQ(obj.getIntField("threadsRunning"), kNumWorkers);
+    ASSERT_EQ(obj.getField("tasksStolen").numberLong(), 1);
+}
+
+TEST_F(ServiceExecutorWorkStealingFixture, RunTaskAfterWaitingForData) {
+    auto tl = std::make_unique<TransportLayerMock>();
+    auto session = tl->createSession();
+
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([this] { ASSERT_OK(executor->shutdown(kShutdownTime)); });
+
+    const auto mainThreadId = stdx::this_thread::get_id();
+    AtomicWord<bool> ranOnDataAvailable{false};
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    executor->runOnDataAvailable(
+        session.get(), [&ranOnDataAvailable, mainThreadId, barrier](Status status) mutable {
+            ASSERT_OK(status);
+            ranOnDataAvailable.store(true);
+            ASSERT(stdx::this_thread::get_id() != mainThreadId);
+            barrier->countDownAndWait();
+        });
+
+    ASSERT(!ranOnDataAvailable.load());
+    reinterpret_cast<MockSession*>(session.get())->signalAvailableData();
+    barrier->countDownAndWait();
+    ASSERT(ranOnDataAvailable.load());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,10 +38,13 @@
 #include <memory>
 
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/transport/service_executor.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/debug_util.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/thread_safety_context.h"
 
@@ -104,6 +107,23 @@ Status launchServiceWorkerThread(unique_function<void()> task) noexcept {
                           "stackSizeKiB"_attr = (limits.rlim_cur / 1024));
         }
 
+        // Spread the threads over the NUMA nodes, binding each before it runs `task` so that its
+        // stack and the memory its connection allocates come from the node it runs on.
+        const auto numNumaNodes = ProcessInfo::getNumaNodes().size();
+        if (transport::gServiceExecutorBindThreadsToNumaNodes && numNumaNodes > 0) {
+            static AtomicWord<unsigned> nextNumaNode{0};
+            task = [node = nextNumaNode.fetchAndAdd(1) % numNumaNodes,
+                    f = std::move(task)]() mutable {
+                if (!ProcessInfo::bindCurrentThreadToNumaNode(node)) {
+                    LOGV2_WARNING(5190831,
+                                  "Failed to bind service worker thread to NUMA node",
+                                  "node"_attr = node,
+                                  "error"_attr = errnoWithDescription());
+                }
+                f();
+            };
+        }
+
         // Wrap the user-specified `task` so it runs with an installed `sigaltstack`.
         task = [sigAltStackController = std::make_shared<stdx::support::SigAltStackController>(),
                 f = std::move(task)]() mutable {
@@ -0,0 +1,263 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kExecutor
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/service_executor_work_stealing.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "mongo/logv2/log.h"
+#include "mongo/transport/service_executor_gen.h"
+#include "mongo/transport/session.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/processinfo.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+constexpr auto kThreadsRunning = "threadsRunning"_sd;
+constexpr auto kTasksQueued = "tasksQueued"_sd;
+constexpr auto kTasksStolen = "tasksStolen"_sd;
+constexpr auto kExecutorLabel = "executor"_sd;
+constexpr auto kExecutorName = "workStealing"_sd;
+
+void pinThreadToCore(size_t core) {
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    if (auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+        LOGV2_WARNING(5190721,
+                      "Failed to pin service executor worker thread to a core",
+                      "core"_attr = core,
+                      "error"_attr = errnoWithDescription(err));
+    }
+#endif
+}
+}  // namespace
+
+ServiceExecutorWorkStealing::ServiceExecutorWorkStealing(ReactorHandle reactor,
+                                                         size_t numWorkers,
+                                                         bool pinWorkersToCores)
+    : _reactor(std::move(reactor)), _pinWorkersToCores(pinWorkersToCores) {
+    invariant(numWorkers > 0);
+    _workers.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        _workers.push_back(std::make_unique<Worker>(this));
+    }
+}
+
+ServiceExecutorWorkStealing::~ServiceExecutorWorkStealing() {
+    invariant(!_stillRunning.load());
+    for (auto& thread : _workerThreads) {
+        thread.join();
+    }
+    if (_reactorThread.joinable()) {
+        _reactorThread.join();
+    }
+}
+
+Status ServiceExecutorWorkStealing::start() {
+    invariant(_workerThreads.empty());
+    _stillRunning.store(true);
+
+    _reactorThread = stdx::thread([this] {
+        setThreadName("serviceExecutorReactor");
+        _reactor->run();
+    });
+
+    const auto numCores = static_cast<size_t>(ProcessInfo::getNumAvailableCores());
+    const auto numNumaNodes =
+        gServiceExecutorBindThreadsToNumaNodes ? ProcessInfo::getNumaNodes().size() : 0;
+    _workerThreads.reserve(_workers.size());
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        _workerThreads.emplace_back([this, i, numCores, numNumaNodes] {
+            setThreadName(str::stream() << "serviceExecutorWorker-" << i);
+            if (_pinWorkersToCores) {
+                pinThreadToCore(i % numCores);
+            } else if (numNumaNodes > 0 &&
+                       !ProcessInfo::bindCurrentThreadToNumaNode(i % numNumaNodes)) {
+                LOGV2_WARNING(5190832,
+                              "Failed to bind service executor worker thread to NUMA node",
+                              "node"_attr = i % numNumaNodes,
+                              "error"_attr = errnoWithDescription());
+            }
+            _runWorker(i);
+        });
+    }
+
+    LOGV2_DEBUG(5190722,
+                3,
+                "Started work-stealing service executor",
+                "numWorkers"_attr = _workers.size(),
+                "pinWorkersToCores"_attr = _pinWorkersToCores);
+    return Status::OK();
+}
+
+Status ServiceExecutorWorkStealing::shutdown(Milliseconds timeout) {
+    LOGV2_DEBUG(5190723, 3, "Shutting down work-stealing service executor");
+
+    {
+        stdx::lock_guard<Latch> lk(_idleMutex);
+        _stillRunning.store(false);
+    }
+    _idleCondition.notify_all();
+    _reactor->stop();
+
+    stdx::unique_lock<Latch> lk(_idleMutex);
+    bool result = _shutdownCondition.wait_for(lk, timeout.toSystemDuration(), [this] {
+        return _numRunningWorkerThreads.load() == 0;
+    });
+
+    return result ? Status::OK()
+                  : Status(ErrorCodes::ExceededTimeLimit,
+                           "work-stealing executor couldn't shutdown all worker threads within "
+                           "time limit.");
+}
+
+Status ServiceExecutorWorkStealing::scheduleTask(Task task, ScheduleFlags flags) {
+    if (!_stillRunning.load()) {
+        return Status(ErrorCodes::ShutdownInProgress, "Executor is not running");
+    }
+
+    auto worker = _localWorker();
+    if (worker && (flags & ScheduleFlags::kMayRecurse) &&
+        worker->recursionDepth < workStealingServiceExecutorRecursionLimit.loadRelaxed()) {
+        ++worker->recursionDepth;
+        task();
+        --worker->recursionDepth;
+        return Status::OK();
+    }
+
+    _enqueue(std::move(task));
+    return Status::OK();
+}
+
+void ServiceExecutorWorkStealing::runOnDataAvailable(Session* session,
+                                                     OutOfLineExecutor::Task onCompletionCallback) {
+    invariant(session);
+    session->waitForData().getAsync(
+        [this, callback = std::move(onCompletionCallback)](Status status) mutable {
+            if (status.isOK() && !_stillRunning.load()) {
+                status = Status(ErrorCodes::ShutdownInProgress, "Executor is not running");
+            }
+            if (!status.isOK()) {
+                callback(std::move(status));
+                return;
+            }
+
+            _enqueue([callback = std::move(callback)]() mutable { callback(Status::OK()); });
+        });
+}
+
+void ServiceExecutorWorkStealing::appendStats(BSONObjBuilder* bob) const {
+    *bob << kExecutorLabel << kExecutorName << kThreadsRunning
+         << static_cast<int>(_numRunningWorkerThreads.load()) << kTasksQueued
+         << static_cast<long long>(_numQueuedTasks.load()) << kTasksStolen
+         << _numTasksStolen.load();
+}
+
+void ServiceExecutorWorkStealing::_enqueue(Task task) {
+    auto worker = _localWorker();
+    if (!worker) {
+        worker = _workers[_nextWorker.fetchAndAdd(1) % _workers.size()].get();
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(worker->mutex);
+        worker->tasks.push_back(std::move(task));
+    }
+
+    // A worker only goes to sleep after it has counted itself as sleeping and then seen no queued
+    // tasks, so either it sees this task or we see it sleeping and wake it up.
+    _numQueuedTasks.addAndFetch(1);
+    if (_numSleepingWorkers.load() > 0) {
+        stdx::lock_guard<Latch> lk(_idleMutex);
+        _idleCondition.notify_one();
+    }
+}
+
+bool ServiceExecutorWorkStealing::_tryPop(size_t workerIndex, Task* task) {
+    // Take the oldest task of our own queue first, so that the sessions it holds are served in
+    // order, and otherwise the newest task of the next worker which has one.
+    for (size_t i = 0; i < _workers.size(); ++i) {
+        auto& worker = *_workers[(workerIndex + i) % _workers.size()];
+        stdx::lock_guard<Latch> lk(worker.mutex);
+        if (worker.tasks.empty()) {
+            continue;
+        }
+
+        if (i == 0) {
+            *task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        } else {
+            *task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            _numTasksStolen.addAndFetch(1);
+        }
+        _numQueuedTasks.subtractAndFetch(1);
+        return true;
+    }
+    return false;
+}
+
+void ServiceExecutorWorkStealing::_runWorker(size_t workerIndex) {
+    _numRunningWorkerThreads.addAndFetch(1);
+    _currentWorker = _workers[workerIndex].get();
+
+    while (_stillRunning.load()) {
+        Task task;
+        if (_tryPop(workerIndex, &task)) {
+            _currentWorker->recursionDepth = 1;
+            task();
+            continue;
+        }
+
+        stdx::unique_lock<Latch> lk(_idleMutex);
+        _numSleepingWorkers.addAndFetch(1);
+        _idleCondition.wait(
+            lk, [&] { return _numQueuedTasks.load() > 0 || !_stillRunning.load(); });
+        _numSleepingWorkers.subtractAndFetch(1);
+    }
+
+    _currentWorker = nullptr;
+    stdx::lock_guard<Latch> lk(_idleMutex);
+    if (_numRunningWorkerThreads.subtractAndFetch(1) == 0) {
+        _shutdownCondition.notify_all();
+    }
+}
+
+}  // namespace transport
+}  // namespace mongo
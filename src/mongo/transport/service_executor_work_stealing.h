@@ -0,0 +1,121 @@
+/**
+ *    Copyright (C) 2018-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/transport_layer.h"
+
+namespace mongo {
+namespace transport {
+
+/**
+ * A service executor that runs the tasks of all sessions on a fixed number of worker threads,
+ * so that the number of threads does not grow with the number of connections.
+ *
+ * Each worker has its own queue. Tasks scheduled from a worker go to the back of its own queue,
+ * which keeps the continuations of a session on the thread that ran it last, and other tasks are
+ * spread across the queues in turn. A worker whose queue is empty steals from the back of the
+ * other workers' queues before going to sleep. The workers can be pinned to cores, so that what a
+ * worker touches stays in the caches, and the memory, of one core.
+ *
+ * Sessions use asynchronous networking with this executor. A dedicated thread runs the ingress
+ * reactor which their reads and writes wait on.
+ */
+class ServiceExecutorWorkStealing final : public ServiceExecutor {
+public:
+    ServiceExecutorWorkStealing(ReactorHandle reactor, size_t numWorkers, bool pinWorkersToCores);
+    ~ServiceExecutorWorkStealing();
+
+    Status start() override;
+    Status shutdown(Milliseconds timeout) override;
+    Status scheduleTask(Task task, ScheduleFlags flags) override;
+
+    void runOnDataAvailable(Session* session,
+                            OutOfLineExecutor::Task onCompletionCallback) override;
+
+    Mode transportMode() const override {
+        return Mode::kAsynchronous;
+    }
+
+    void appendStats(BSONObjBuilder* bob) const override;
+
+private:
+    struct Worker {
+        explicit Worker(ServiceExecutorWorkStealing* executor) : executor(executor) {}
+
+        ServiceExecutorWorkStealing* const executor;
+        Mutex mutex = MONGO_MAKE_LATCH("ServiceExecutorWorkStealing::Worker::mutex");
+        std::deque<Task> tasks;
+        int recursionDepth = 0;
+    };
+
+    /**
+     * Returns the worker of this executor which the calling thread runs, if any.
+     */
+    Worker* _localWorker() const {
+        return _currentWorker && _currentWorker->executor == this ? _currentWorker : nullptr;
+    }
+
+    void _enqueue(Task task);
+    bool _tryPop(size_t workerIndex, Task* task);
+    void _runWorker(size_t workerIndex);
+
+    const ReactorHandle _reactor;
+    const bool _pinWorkersToCores;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<stdx::thread> _workerThreads;
+    stdx::thread _reactorThread;
+
+    AtomicWord<bool> _stillRunning{false};
+    AtomicWord<size_t> _nextWorker{0};
+    AtomicWord<size_t> _numQueuedTasks{0};
+    AtomicWord<size_t> _numSleepingWorkers{0};
+    AtomicWord<size_t> _numRunningWorkerThreads{0};
+    AtomicWord<long long> _numTasksStolen{0};
+
+    Mutex _idleMutex = MONGO_MAKE_LATCH("ServiceExecutorWorkStealing::_idleMutex");
+    stdx::condition_variable _idleCondition;
+    stdx::condition_variable _shutdownCondition;
+
+    static inline thread_local Worker* _currentWorker = nullptr;
+};
+
+}  // namespace transport
+}  // namespace mongo
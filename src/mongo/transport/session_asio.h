@@ -37,6 +37,7 @@
 #include "mongo/transport/asio_utils.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/transport_layer_asio.h"
+#include "mongo/transport/transport_options_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/net/socket_utils.h"
 #ifdef MONGO_CONFIG_SSL
@@ -168,6 +169,9 @@ public:
     }
 
     Future<void> waitForData() override {
+        if (_readAheadEnd > _readAheadBegin) {
+            return Future<void>::makeReady();
+        }
 #ifdef MONGO_CONFIG_SSL
         if (_sslSocket)
             return asio::async_read(*_sslSocket, asio::null_buffers(), UseFuture{}).ignoreValue();
@@ -281,6 +285,7 @@ protected:
         }
 
         _sslSocket.emplace(std::move(_socket), *_sslContext->egress, removeFQDNRoot(target.host()));
+        getSSLManager()->prepareEgressSessionResumption(_sslSocket->native_handle(), target);
         lk.unlock();
 
         auto doHandshake = [&] {
@@ -408,7 +413,7 @@ private:
 
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
-        return read(asio::buffer(ptr, kHeaderSize), baton)
+        return readBuffered(asio::buffer(ptr, kHeaderSize), baton)
             .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
                 if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
                     return sendHTTPResponse(baton);
@@ -442,7 +447,7 @@ private:
                 memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
 
                 MsgData::View msgView(buffer.get());
-                return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
+                return readBuffered(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                     .then([this, buffer = std::move(buffer), msgLen]() mutable {
                         if (_isIngressSession) {
                             networkCounter.hitPhysicalIn(msgLen);
@@ -452,6 +457,112 @@ private:
             });
     }
 
+    /**
+     * Reads into 'buffer' from the read-ahead buffer, refilling it from the socket when it runs
+     * out, or falls back to read() on sessions which do not read ahead and for the part of a read
+     * that would not fit in the read-ahead buffer.
+     */
+    Future<void> readBuffered(asio::mutable_buffer buffer, const BatonHandle& baton) {
+        const auto buffered = std::min(buffer.size(), _readAheadEnd - _readAheadBegin);
+        if (buffered > 0) {
+            memcpy(buffer.data(), _readAheadBuffer.get() + _readAheadBegin, buffered);
+            _readAheadBegin += buffered;
+            buffer += buffered;
+        }
+        if (_readAheadBegin == _readAheadEnd) {
+            _readAheadBegin = _readAheadEnd = 0;
+        }
+
+        if (buffer.size() == 0) {
+            return Future<void>::makeReady();
+        }
+        if (!canReadAhead() || buffer.size() >= _readAheadBufferSize) {
+            return read(buffer, baton);
+        }
+
+        return fillReadAhead(buffer.size(), baton).then([this, buffer, baton] {
+            return readBuffered(buffer, baton);
+        });
+    }
+
+    /**
+     * Whether reads can go through the read-ahead buffer. TLS sessions never read ahead, as the
+     * SSL stream does its own buffering, and neither does a session before it knows whether it
+     * will use TLS.
+     */
+    bool canReadAhead() {
+#ifdef MONGO_CONFIG_SSL
+        if (_sslSocket || !_ranHandshake) {
+            return false;
+        }
+#endif
+        if (MONGO_unlikely(transportLayerASIOshortOpportunisticReadWrite.shouldFail())) {
+            return false;
+        }
+
+        if (!_readAheadBuffer) {
+            _readAheadBufferSize = gReceiveReadAheadBufferSizeBytes;
+            if (_readAheadBufferSize == 0) {
+                return false;
+            }
+            _readAheadBuffer = SharedBuffer::allocate(_readAheadBufferSize);
+        }
+        return true;
+    }
+
+    /**
+     * Reads at least 'minBytes' into the empty read-ahead buffer, along with whatever else the
+     * socket has available that fits, waiting for the socket to become readable if necessary.
+     */
+    Future<void> fillReadAhead(size_t minBytes, const BatonHandle& baton) {
+        invariant(minBytes <= _readAheadBufferSize);
+
+        std::error_code ec;
+        while (_readAheadEnd < minBytes) {
+            size_t size;
+            do {
+                size = _socket.read_some(asio::buffer(_readAheadBuffer.get() + _readAheadEnd,
+                                                      _readAheadBufferSize - _readAheadEnd),
+                                         ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+            _readAheadEnd += size;
+
+            if (ec) {
+                break;
+            }
+        }
+
+        if (!ec) {
+            return Future<void>::makeReady();
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            auto refill = [this, minBytes, baton] { return fillReadAhead(minBytes, baton); };
+
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        if (ErrorCodes::isShutdownError(error)) {
+                            // As in opportunisticRead(), fall back to waiting on the reactor once
+                            // the baton has detached.
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then(std::move(refill));
+            }
+
+            return asio::async_read(_socket, asio::null_buffers(), UseFuture{})
+                .ignoreValue()
+                .then(std::move(refill));
+        }
+
+        return futurize(ec);
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancelation here.
@@ -812,6 +923,14 @@ private:
     boost::optional<Milliseconds> _socketTimeout;
 
     GenericSocket _socket;
+
+    // Bytes received from the socket which have not been returned by a read yet, only used for
+    // non-TLS sessions. See readBuffered().
+    SharedBuffer _readAheadBuffer;
+    size_t _readAheadBufferSize = 0;
+    size_t _readAheadBegin = 0;
+    size_t _readAheadEnd = 0;
+
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
     bool _ranHandshake = false;
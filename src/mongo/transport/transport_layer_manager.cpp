@@ -42,10 +42,13 @@
 #include "mongo/db/server_options.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_synchronous.h"
+#include "mongo/transport/service_executor_work_stealing.h"
 #include "mongo/transport/session.h"
 #include "mongo/transport/transport_layer_asio.h"
 #include "mongo/util/net/ssl_types.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -134,12 +137,32 @@ std::unique_ptr<TransportLayer> TransportLayerManager::createWithConfig(
     auto sep = ctx->getServiceEntryPoint();
 
     transport::TransportLayerASIO::Options opts(config);
-    opts.transportMode = transport::Mode::kSynchronous;
+    if (gServiceExecutor == "workStealing") {
+        opts.transportMode = transport::Mode::kAsynchronous;
+    } else {
+        uassert(5190720,
+                str::stream() << "Unknown serviceExecutor '" << gServiceExecutor
+                              << "', expected 'synchronous' or 'workStealing'",
+                gServiceExecutor == "synchronous");
+        opts.transportMode = transport::Mode::kSynchronous;
+    }
 
-    ctx->setServiceExecutor(std::make_unique<ServiceExecutorSynchronous>(ctx));
+    auto tl = std::make_unique<transport::TransportLayerASIO>(opts, sep);
+    if (opts.transportMode == transport::Mode::kAsynchronous) {
+        auto numThreads = static_cast<size_t>(gWorkStealingServiceExecutorNumThreads);
+        if (numThreads == 0) {
+            numThreads = static_cast<size_t>(ProcessInfo::getNumAvailableCores());
+        }
+        ctx->setServiceExecutor(std::make_unique<ServiceExecutorWorkStealing>(
+            tl->getReactor(TransportLayer::kIngress),
+            numThreads,
+            gWorkStealingServiceExecutorPinThreads));
+    } else {
+        ctx->setServiceExecutor(std::make_unique<ServiceExecutorSynchronous>(ctx));
+    }
 
     std::vector<std::unique_ptr<TransportLayer>> retVector;
-    retVector.emplace_back(std::make_unique<transport::TransportLayerASIO>(opts, sep));
+    retVector.emplace_back(std::move(tl));
     return std::make_unique<TransportLayerManager>(std::move(retVector));
 }
 
@@ -33,104 +33,102 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
-
-#include "mongo/logv2/log.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
-#if defined(__linux__)
 namespace {
 
-/**
- * Accepts an errno code, prints its error message, and exits.
- */
-void failWithErrno(int err) {
-    LOGV2_FATAL(28604,
-                "error in Ticketholder: {errnoWithDescription_err}",
-                "errnoWithDescription_err"_attr = errnoWithDescription(err));
-}
-
-/*
- * Checks the return value from a Linux semaphore function call, and fails with the set errno if the
- * call was unsucessful.
- */
-void check(int ret) {
-    if (ret == 0)
-        return;
-    failWithErrno(errno);
+StringData priorityName(TicketHolder::Priority priority) {
+    switch (priority) {
+        case TicketHolder::Priority::kLow:
+            return "low"_sd;
+        case TicketHolder::Priority::kNormal:
+            return "normal"_sd;
+        case TicketHolder::Priority::kHigh:
+            return "high"_sd;
+    }
+    MONGO_UNREACHABLE;
 }
 
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    check(sem_init(&_sem, 0, num));
-}
+constexpr std::array<int, 5> TicketHolder::kWaitTimeBucketBoundsMillis;
 
-TicketHolder::~TicketHolder() {
-    check(sem_destroy(&_sem));
-}
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {}
+
+TicketHolder::~TicketHolder() = default;
 
 bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
+    // Taking a ticket ahead of the queued operations would defeat the FIFO order.
+    if (_numWaiters.load() > 0) {
+        return false;
     }
-    return true;
+    return _tryAcquireAvailable();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, Priority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until, Priority priority) {
+    // Attempt to get a ticket without queueing in order to avoid taking the mutex.
+    if (tryAcquire()) {
         return true;
     }
 
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
+    stdx::unique_lock<Latch> lk(_mutex);
 
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
+    // A ticket released after the check above is either still available, or has been handed to an
+    // operation which was queued ahead of this one.
+    _numWaiters.fetchAndAdd(1);
+    auto& queue = _queues[static_cast<int>(priority)];
+    Waiter waiter;
+    auto iter = queue.insert(queue.end(), &waiter);
+    _grantToWaiters(lk);
+
+    Timer timer;
+    ON_BLOCK_EXIT([&] {
+        if (!waiter.granted) {
+            queue.erase(iter);
+        }
+        _numWaiters.subtractAndFetch(1);
+        _recordWait(lk, priority, Microseconds(timer.micros()));
+    });
+
+    auto isGranted = [&] { return waiter.granted; };
+    try {
+        if (opCtx) {
+            return opCtx->waitForConditionOrInterruptUntil(waiter.cv, lk, until, isGranted);
+        } else if (until == Date_t::max()) {
+            waiter.cv.wait(lk, isGranted);
+            return true;
+        } else {
+            return waiter.cv.wait_until(lk, until.toSystemTimePoint(), isGranted);
+        }
+    } catch (const DBException&) {
+        if (waiter.granted) {
+            // The ticket was handed over just as the wait was interrupted, so pass it on.
+            _available.fetchAndAdd(1);
+            _grantToWaiters(lk);
+        }
+        throw;
     }
-    return true;
 }
 
 void TicketHolder::release() {
-    check(sem_post(&_sem));
+    _available.fetchAndAdd(1);
+
+    // Pairs with the increment of '_numWaiters' in waitForTicketUntil: either the waiter sees the
+    // released ticket before it queues, or this sees the waiter and hands the ticket over.
+    if (_numWaiters.load() > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _grantToWaiters(lk);
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
@@ -140,18 +138,14 @@ Status TicketHolder::resize(int newSize) {
         return Status(ErrorCodes::BadValue,
                       str::stream() << "Minimum value for semaphore is 5; given " << newSize);
 
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given " << newSize);
-
     while (_outof.load() < newSize) {
         release();
         _outof.fetchAndAdd(1);
     }
 
+    // Retire tickets as they are released, ahead of the operations queued at normal priority.
     while (_outof.load() > newSize) {
-        waitForTicket();
+        waitForTicket(nullptr, Priority::kHigh);
         _outof.subtractAndFetch(1);
     }
 
@@ -160,9 +154,7 @@ Status TicketHolder::resize(int newSize) {
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    check(sem_getvalue(&_sem, &val));
-    return val;
+    return _available.load();
 }
 
 int TicketHolder::used() const {
@@ -173,90 +165,68 @@ int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
-
-bool TicketHolder::tryAcquire() {
+int TicketHolder::queued(Priority priority) const {
     stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
+    return _queues[static_cast<int>(priority)].size();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
+void TicketHolder::appendStats(BSONObjBuilder* b) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (int lane = 0; lane < kNumPriorities; ++lane) {
+        const auto& stats = _laneStats[lane];
+        BSONObjBuilder laneBuilder(b->subobjStart(priorityName(static_cast<Priority>(lane))));
+        laneBuilder.appendNumber("queueLength", static_cast<long long>(_queues[lane].size()));
+        laneBuilder.appendNumber("totalWaits", stats.totalWaits);
+        laneBuilder.appendNumber("totalTimeQueuedMicros", stats.totalTimeQueuedMicros);
+
+        BSONObjBuilder histogramBuilder(laneBuilder.subobjStart("waitTimeMillis"));
+        for (size_t i = 0; i < kWaitTimeBucketBoundsMillis.size(); ++i) {
+            histogramBuilder.appendNumber(str::stream() << "lt" << kWaitTimeBucketBoundsMillis[i],
+                                          stats.waitTimeHistogram[i]);
+        }
+        histogramBuilder.appendNumber(str::stream() << "ge" << kWaitTimeBucketBoundsMillis.back(),
+                                      stats.waitTimeHistogram.back());
     }
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+bool TicketHolder::_tryAcquireAvailable() {
+    auto available = _available.load();
+    while (available > 0) {
+        if (_available.compareAndSwap(&available, available - 1)) {
+            _totalAcquired.fetchAndAdd(1);
+            return true;
+        }
     }
-}
-
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
+    return false;
+}
+
+void TicketHolder::_grantToWaiters(WithLock) {
+    for (int lane = kNumPriorities - 1; lane >= 0; --lane) {
+        auto& queue = _queues[lane];
+        while (!queue.empty()) {
+            if (!_tryAcquireAvailable()) {
+                return;
+            }
+            auto waiter = queue.front();
+            queue.pop_front();
+            waiter->granted = true;
+            waiter->cv.notify_one();
+        }
     }
-    _newTicket.notify_one();
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
+void TicketHolder::_recordWait(WithLock, Priority priority, Microseconds timeQueued) {
+    auto& stats = _laneStats[static_cast<int>(priority)];
+    stats.totalWaits++;
+    stats.totalTimeQueuedMicros += durationCount<Microseconds>(timeQueued);
 
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+    const auto millis = durationCount<Milliseconds>(timeQueued);
+    size_t bucket = 0;
+    while (bucket < kWaitTimeBucketBoundsMillis.size() &&
+           millis >= kWaitTimeBucketBoundsMillis[bucket]) {
+        ++bucket;
     }
-
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
-}
-
-int TicketHolder::available() const {
-    return _num;
+    stats.waitTimeHistogram[bucket]++;
 }
 
-int TicketHolder::used() const {
-    return outof() - _num;
-}
-
-int TicketHolder::outof() const {
-    return _outof.load();
-}
-
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
-        return false;
-    }
-    _num--;
-    return true;
-}
-#endif
 }  // namespace mongo
@@ -28,24 +28,43 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <array>
+#include <list>
 
-#include "mongo/db/operation_context.h"
+#include "mongo/base/status.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
-#include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
+class OperationContext;
+
+/**
+ * A counting semaphore which queues the operations that have to wait for a ticket.
+ *
+ * Waiters are kept in one FIFO queue per priority lane. A released ticket goes to the longest
+ * waiting operation of the highest priority lane that has waiters, and new arrivals cannot take a
+ * ticket ahead of operations that are already queued. Acquiring an available ticket when nobody is
+ * queued does not take a mutex.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
 
 public:
+    /**
+     * The lane an operation queues in when no ticket is available. Background work such as TTL
+     * deletes uses kLow, and internal work which user operations depend upon, such as secondary
+     * oplog application, uses kHigh.
+     */
+    enum class Priority { kLow, kNormal, kHigh };
+    static constexpr int kNumPriorities = 3;
+
     explicit TicketHolder(int num);
     ~TicketHolder();
 
@@ -56,7 +75,7 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, Priority priority = Priority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +87,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            Priority priority = Priority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,22 +103,70 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of operations currently queued for a ticket in the given lane.
+     */
+    int queued(Priority priority) const;
+
+    /**
+     * Returns the number of tickets acquired since construction.
+     */
+    long long totalAcquired() const {
+        return _totalAcquired.load();
+    }
+
+    /**
+     * Appends, for every lane, the current queue length, the number of waits and the time spent
+     * queued, including a histogram of the wait times.
+     */
+    void appendStats(BSONObjBuilder* b) const;
+
 private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool granted = false;
+    };
+
+    using WaitQueue = std::list<Waiter*>;
+
+    // Upper bounds, in milliseconds, of the wait time histogram buckets. The last bucket counts
+    // the waits which took longer than the last bound.
+    static constexpr std::array<int, 5> kWaitTimeBucketBoundsMillis{1, 10, 100, 1000, 10000};
+
+    struct LaneStats {
+        long long totalWaits = 0;
+        long long totalTimeQueuedMicros = 0;
+        std::array<long long, kWaitTimeBucketBoundsMillis.size() + 1> waitTimeHistogram{};
+    };
+
+    /**
+     * Takes an available ticket without queueing.
+     */
+    bool _tryAcquireAvailable();
+
+    /**
+     * Hands the available tickets to the queued waiters, highest priority lane first.
+     */
+    void _grantToWaiters(WithLock);
+
+    void _recordWait(WithLock, Priority priority, Microseconds timeQueued);
+
+    // An available ticket may be taken by a compare-and-swap on '_available' without holding
+    // '_mutex', but only while '_numWaiters' is zero. Tickets are handed to waiters, and waiters
+    // join or leave the queues, with '_mutex' held.
+    AtomicWord<int> _available;
+    AtomicWord<int> _numWaiters{0};
+    AtomicWord<long long> _totalAcquired{0};
 
     // You can read _outof without a lock, but have to hold _resizeMutex to change.
     AtomicWord<int> _outof;
     Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
-#else
-    bool _tryAcquire();
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1), "TicketHolder::_resizeMutex");
 
-    AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
-#endif
+    mutable Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
+    std::array<WaitQueue, kNumPriorities> _queues;
+    std::array<LaneStats, kNumPriorities> _laneStats;
 };
 
 class ScopedTicket {
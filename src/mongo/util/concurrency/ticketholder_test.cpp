@@ -32,6 +32,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
 
@@ -72,4 +74,87 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+void waitUntilQueued(TicketHolder& holder, TicketHolder::Priority priority, int count) {
+    while (holder.queued(priority) != count) {
+        sleepmillis(1);
+    }
+}
+
+TEST(TicketholderTest, ReleasedTicketGoesToHighestPriorityLane) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    std::vector<TicketHolder::Priority> order;
+    Mutex orderMutex;
+    auto waitThenRecord = [&](TicketHolder::Priority priority) {
+        holder.waitForTicket(nullptr, priority);
+        stdx::lock_guard<Latch> lk(orderMutex);
+        order.push_back(priority);
+    };
+
+    stdx::thread low(waitThenRecord, TicketHolder::Priority::kLow);
+    waitUntilQueued(holder, TicketHolder::Priority::kLow, 1);
+    stdx::thread high(waitThenRecord, TicketHolder::Priority::kHigh);
+    waitUntilQueued(holder, TicketHolder::Priority::kHigh, 1);
+
+    // Queued operations keep newcomers from taking a ticket.
+    holder.release();
+    high.join();
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    low.join();
+    holder.release();
+
+    ASSERT_EQ(order.size(), 2U);
+    ASSERT(order[0] == TicketHolder::Priority::kHigh);
+    ASSERT(order[1] == TicketHolder::Priority::kLow);
+    ASSERT_EQ(holder.available(), 1);
+
+    BSONObjBuilder b;
+    holder.appendStats(&b);
+    auto stats = b.obj();
+    ASSERT_EQ(stats["high"]["totalWaits"].numberLong(), 1);
+    ASSERT_EQ(stats["normal"]["totalWaits"].numberLong(), 0);
+    ASSERT_EQ(stats["low"]["totalWaits"].numberLong(), 1);
+    ASSERT_EQ(stats["low"]["queueLength"].numberLong(), 0);
+}
+
+TEST(TicketholderTest, WaitersInTheSameLaneAreServedInArrivalOrder) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    std::vector<int> order;
+    Mutex orderMutex;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([&, i] {
+            holder.waitForTicket();
+            {
+                stdx::lock_guard<Latch> lk(orderMutex);
+                order.push_back(i);
+            }
+            holder.release();
+        });
+        waitUntilQueued(holder, TicketHolder::Priority::kNormal, i + 1);
+    }
+
+    holder.release();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT(order == std::vector<int>({0, 1, 2}));
+}
+
+TEST(TicketholderTest, TimedOutWaiterLeavesTheQueue) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(nullptr, Date_t::now() + Milliseconds(5)));
+    ASSERT_EQ(holder.queued(TicketHolder::Priority::kNormal), 0);
+
+    holder.release();
+    ASSERT(holder.tryAcquire());
+    holder.release();
+}
 }  // namespace
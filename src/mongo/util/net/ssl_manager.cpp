@@ -284,6 +284,8 @@ std::pair<std::string, RFC4514Parser::ValueTerminator> RFC4514Parser::extractVal
 }
 
 const auto getTLSVersionCounts = ServiceContext::declareDecoration<TLSVersionCounts>();
+const auto getTLSSessionResumptionCounts =
+    ServiceContext::declareDecoration<TLSSessionResumptionCounts>();
 
 
 void canonicalizeClusterDN(std::vector<std::string>* dn) {
@@ -624,6 +626,10 @@ TLSVersionCounts& TLSVersionCounts::get(ServiceContext* serviceContext) {
     return getTLSVersionCounts(serviceContext);
 }
 
+TLSSessionResumptionCounts& TLSSessionResumptionCounts::get(ServiceContext* serviceContext) {
+    return getTLSSessionResumptionCounts(serviceContext);
+}
+
 MONGO_INITIALIZER_WITH_PREREQUISITES(SSLManagerLogger, ("SSLManager"))
 (InitializerContext*) {
     if (!isSSLServer || (sslGlobalParams.sslMode.load() != SSLParams::SSLMode_disabled)) {
@@ -1285,6 +1291,15 @@ void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging) {
     }
 }
 
+void recordTLSSessionResumption(SSLManagerInterface::ConnectionDirection direction, bool resumed) {
+    auto& counts = TLSSessionResumptionCounts::get(getGlobalServiceContext());
+    if (direction == SSLManagerInterface::ConnectionDirection::kIncoming) {
+        (resumed ? counts.incomingResumed : counts.incomingNew).addAndFetch(1);
+    } else {
+        (resumed ? counts.outgoingResumed : counts.outgoingNew).addAndFetch(1);
+    }
+}
+
 // TODO SERVER-11601 Use NFC Unicode canonicalization
 bool hostNameMatchForX509Certificates(std::string nameToMatch, std::string certHostName) {
     nameToMatch = removeFQDNRoot(std::move(nameToMatch));
@@ -158,6 +158,19 @@ struct TLSVersionCounts {
     static TLSVersionCounts& get(ServiceContext* serviceContext);
 };
 
+/**
+ * Counts of TLS handshakes which resumed an earlier session, and of those which negotiated a new
+ * one, by direction of the connection.
+ */
+struct TLSSessionResumptionCounts {
+    AtomicWord<long long> incomingResumed;
+    AtomicWord<long long> incomingNew;
+    AtomicWord<long long> outgoingResumed;
+    AtomicWord<long long> outgoingNew;
+
+    static TLSSessionResumptionCounts& get(ServiceContext* serviceContext);
+};
+
 struct CertInformationToLog {
     SSLX509Name subject;
     SSLX509Name issuer;
@@ -277,6 +290,14 @@ public:
      */
     virtual Status stapleOCSPResponse(SSLContextType context, bool asyncOCSPStaple) = 0;
 
+    /**
+     * No-op function for SChannel and SecureTransport. Lets the outgoing connection 'ssl' to
+     * 'target' resume a TLS session negotiated by an earlier connection to the same peer, and
+     * remember the sessions it negotiates for later ones. Must be called before the handshake.
+     */
+    virtual void prepareEgressSessionResumption(SSLConnectionType ssl,
+                                                const HostAndPort& target) = 0;
+
     /**
      * Stop jobs after rotation is complete.
      */
@@ -384,6 +405,11 @@ StatusWith<TLSVersion> mapTLSVersion(SSLConnectionType conn);
  */
 void recordTLSVersion(TLSVersion version, const HostAndPort& hostForLogging);
 
+/**
+ * Record whether a TLS handshake in the given direction resumed an earlier session.
+ */
+void recordTLSSessionResumption(SSLManagerInterface::ConnectionDirection direction, bool resumed);
+
 /**
  * Emit a warning() explaining that a client certificate is about to expire.
  */
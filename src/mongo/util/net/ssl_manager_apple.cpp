@@ -1268,6 +1268,8 @@ public:
 
     Status stapleOCSPResponse(asio::ssl::apple::Context* context, bool asyncOCSPStaple) final;
 
+    void prepareEgressSessionResumption(::SSLContextRef ssl, const HostAndPort& target) final {}
+
     const SSLConfiguration& getSSLConfiguration() const final {
         return _sslConfiguration;
     }
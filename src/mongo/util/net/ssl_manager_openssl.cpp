@@ -57,6 +57,7 @@
 #include "mongo/util/debug_util.h"
 #include "mongo/util/exit.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/net/cidr.h"
 #include "mongo/util/net/dh_openssl.h"
 #include "mongo/util/net/ocsp/ocsp_manager.h"
@@ -346,6 +347,10 @@ const OCSP_CERTID* OCSP_SINGLERESP_get0_id(const OCSP_SINGLERESP* single) {
 inline bool ASN1_TIME_diff(int*, int*, const ASN1_TIME*, const ASN1_TIME*) {
     return false;
 }
+
+inline int SSL_is_server(const SSL* ssl) {
+    return ssl->server;
+}
 #endif
 
 int DH_set0_pqg(DH* dh, BIGNUM* p, BIGNUM* q, BIGNUM* g) {
@@ -479,6 +484,8 @@ public:
 using UniqueSSLContext =
     std::unique_ptr<SSL_CTX, OpenSSLDeleter<decltype(::SSL_CTX_free), ::SSL_CTX_free>>;
 using UniqueSSL = std::unique_ptr<SSL, OpenSSLDeleter<decltype(::SSL_free), ::SSL_free>>;
+using UniqueSSLSession =
+    std::unique_ptr<SSL_SESSION, OpenSSLDeleter<decltype(::SSL_SESSION_free), ::SSL_SESSION_free>>;
 static const int BUFFER_SIZE = 8 * 1024;
 
 using UniqueX509 = std::unique_ptr<X509, OpenSSLDeleter<decltype(X509_free), ::X509_free>>;
@@ -1114,6 +1121,89 @@ private:
     bool _shutdown{false};
 };
 
+/**
+ * Keeps the most recent TLS session negotiated by outgoing connections with each peer, so that the
+ * next connection to the same peer can resume it with an abbreviated handshake rather than a full
+ * key exchange. Sessions are keyed by the host and port the connection was made to, which are also
+ * what the peer certificate of a resumed session was validated against.
+ */
+class TLSClientSessionCache {
+public:
+    explicit TLSClientSessionCache(std::size_t maxSize) : _sessions(maxSize) {}
+
+    /**
+     * Makes the outgoing contexts 'context' store the sessions they negotiate in this cache.
+     */
+    void attach(SSL_CTX* context) {
+        ::SSL_CTX_set_session_cache_mode(context,
+                                         SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        ::SSL_CTX_sess_set_new_cb(context, &TLSClientSessionCache::newSession_cb);
+        ::SSL_CTX_set_ex_data(context, _contextIndex(), this);
+    }
+
+    /**
+     * Offers the session cached for 'peer' on 'ssl', if any, and tags 'ssl' so that the sessions
+     * it negotiates are cached for 'peer'. Does nothing if the context of 'ssl' has no cache.
+     */
+    static void prepare(SSL* ssl, const HostAndPort& peer) {
+        auto cache = static_cast<TLSClientSessionCache*>(
+            ::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), _contextIndex()));
+        if (!cache) {
+            return;
+        }
+
+        auto key = std::make_unique<std::string>(peer.toString());
+        {
+            stdx::lock_guard<Latch> lk(cache->_mutex);
+            auto it = cache->_sessions.find(*key);
+            // SSL_set_session takes its own reference on the session. If the server no longer
+            // accepts it, the handshake falls back to a full one.
+            if (it != cache->_sessions.end() && ::SSL_set_session(ssl, it->second.get()) != 1) {
+                cache->_sessions.erase(it);
+            }
+        }
+        ::SSL_set_ex_data(ssl, _connectionIndex(), key.release());
+    }
+
+private:
+    /**
+     * Called by OpenSSL with each session the server issues to a connection, which can happen after
+     * the handshake with TLS 1.3. Returns 1 when the cache keeps the reference to 'session'.
+     */
+    static int newSession_cb(SSL* ssl, SSL_SESSION* session) {
+        auto cache = static_cast<TLSClientSessionCache*>(
+            ::SSL_CTX_get_ex_data(::SSL_get_SSL_CTX(ssl), _contextIndex()));
+        auto peer = static_cast<const std::string*>(::SSL_get_ex_data(ssl, _connectionIndex()));
+        if (!cache || !peer) {
+            return 0;
+        }
+
+        stdx::lock_guard<Latch> lk(cache->_mutex);
+        cache->_sessions.add(*peer, UniqueSSLSession(session));
+        return 1;
+    }
+
+    static void freePeer_cb(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+        delete static_cast<std::string*>(ptr);
+    }
+
+    // Index of the ex_data slot holding the cache of an SSL_CTX.
+    static int _contextIndex() {
+        static const int index = ::SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+        return index;
+    }
+
+    // Index of the ex_data slot holding the peer name of an SSL connection.
+    static int _connectionIndex() {
+        static const int index = ::SSL_get_ex_new_index(
+            0, nullptr, nullptr, nullptr, &TLSClientSessionCache::freePeer_cb);
+        return index;
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("TLSClientSessionCache::_mutex");
+    LRUCache<std::string, UniqueSSLSession> _sessions;
+};
+
 class SSLManagerOpenSSL : public SSLManagerInterface,
                           public std::enable_shared_from_this<SSLManagerOpenSSL> {
 public:
@@ -1150,6 +1240,10 @@ public:
      */
     Status stapleOCSPResponse(SSL_CTX* context, bool asyncOCSPStaple) final;
 
+    void prepareEgressSessionResumption(SSL* ssl, const HostAndPort& target) final {
+        TLSClientSessionCache::prepare(ssl, target);
+    }
+
     void stopJobs() final;
 
     const SSLConfiguration& getSSLConfiguration() const final {
@@ -1191,6 +1285,9 @@ private:
 
     OCSPFetcher _fetcher;
 
+    // Sessions of outgoing connections, for every outgoing context set up by this manager.
+    TLSClientSessionCache _clientSessionCache{static_cast<std::size_t>(tlsSessionCacheSize)};
+
     /** Password caching helper class.
      * Objects of this type will remember the config provided password they had access to at
      * construction.
@@ -2065,6 +2162,19 @@ Status SSLManagerOpenSSL::initSSLContext(SSL_CTX* context,
     options |= SSL_OP_NO_RENEGOTIATION;
 #endif
 
+    // Resuming TLS sessions saves the key exchange and certificate verification of a full
+    // handshake. The server keeps sessions in its internal cache, and can also issue them as
+    // tickets, while outgoing sessions are cached per peer.
+    if (tlsSessionCacheSize == 0) {
+        options |= SSL_OP_NO_TICKET;
+        ::SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_OFF);
+    } else if (direction == ConnectionDirection::kIncoming) {
+        ::SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_SERVER);
+        ::SSL_CTX_sess_set_cache_size(context, tlsSessionCacheSize);
+    } else {
+        _clientSessionCache.attach(context);
+    }
+
     ::SSL_CTX_set_options(context, options);
 
     if (0 == ::SSL_CTX_set_cipher_list(context, params.sslCipherConfig.c_str())) {
@@ -2618,6 +2728,9 @@ Future<SSLPeerInfo> SSLManagerOpenSSL::parseAndValidatePeerCertificate(
     }
 
     recordTLSVersion(tlsVersionStatus.getValue(), hostForLogging);
+    recordTLSSessionResumption(::SSL_is_server(conn) ? ConnectionDirection::kIncoming
+                                                     : ConnectionDirection::kOutgoing,
+                               ::SSL_session_reused(conn));
 
     if (!_sslConfiguration.hasCA && isSSLServer)
         return SSLPeerInfo(sni);
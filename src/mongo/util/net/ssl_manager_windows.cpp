@@ -287,6 +287,8 @@ public:
 
     Status stapleOCSPResponse(SCHANNEL_CRED* cred, bool asyncOCSPStaple) final;
 
+    void prepareEgressSessionResumption(PCtxtHandle ssl, const HostAndPort& target) final {}
+
     const SSLConfiguration& getSSLConfiguration() const final {
         return _sslConfiguration;
     }
@@ -102,4 +102,13 @@ private:
 bool writePidFile(const std::string& path) {
     return pidFileWiper.write(path);
 }
+
+#if !defined(__linux__)
+// NUMA topology is only collected on Linux, so there is never a node to bind to or report on.
+bool ProcessInfo::bindCurrentThreadToNumaNode(size_t i) {
+    return false;
+}
+
+void ProcessInfo::appendNumaStats(BSONObjBuilder* builder) {}
+#endif
 }  // namespace mongo
@@ -32,6 +32,7 @@
 #include <boost/optional.hpp>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/platform/mutex.h"
@@ -134,6 +135,33 @@ public:
         return sysInfo().hasNuma;
     }
 
+    struct NumaNode {
+        unsigned id;
+        std::vector<unsigned> cpus;
+    };
+
+    /**
+     * Get the NUMA nodes which have CPUs, ordered by node id. Empty unless the host has more than
+     * one NUMA node and the platform exposes its topology.
+     */
+    static const std::vector<NumaNode>& getNumaNodes() {
+        return sysInfo().numaNodes;
+    }
+
+    /**
+     * Restrict the calling thread to the CPUs of the i-th entry of getNumaNodes(), so that the
+     * memory it first touches is allocated on that node.
+     * @return true on success, false otherwise
+     */
+    static bool bindCurrentThreadToNumaNode(size_t i);
+
+    /**
+     * Append the host's per-node page allocation counters, such as allocations served from the
+     * intended node and those which had to fall back to a remote one. Appends nothing if
+     * getNumaNodes() is empty.
+     */
+    static void appendNumaStats(BSONObjBuilder* builder);
+
     /**
      * Determine if we need to workaround slow msync performance on Illumos/Solaris
      */
@@ -199,6 +227,7 @@ private:
         unsigned long long pageSize;
         std::string cpuArch;
         bool hasNuma;
+        std::vector<NumaNode> numaNodes;
         BSONObj _extraStats;
 
         // On non-Solaris (ie, Linux, Darwin, *BSD) kernels, prefer msync.
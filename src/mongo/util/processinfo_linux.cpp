@@ -33,6 +33,9 @@
 
 #include "processinfo.h"
 
+#include <algorithm>
+#include <fmt/format.h>
+#include <fstream>
 #include <iostream>
 #include <malloc.h>
 #include <sched.h>
@@ -61,6 +64,8 @@
 #define KLONG long
 #define KLF "l"
 
+using namespace fmt::literals;
+
 namespace mongo {
 
 class LinuxProc {
@@ -333,6 +338,55 @@ public:
         return fstr;
     }
 
+    /**
+     * Parse a kernel CPU list such as "0-3,8-11" into the CPU numbers it contains
+     */
+    static std::vector<unsigned> parseCpuList(const std::string& cpuList) {
+        std::vector<unsigned> cpus;
+        std::stringstream ss(cpuList);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            unsigned first, last;
+            int found = sscanf(range.c_str(), "%u-%u", &first, &last);
+            if (found < 1)
+                continue;
+            if (found == 1)
+                last = first;
+            for (unsigned cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    /**
+     * Get the NUMA nodes which have CPUs, or nothing if there is only a single node. Node ids may
+     * be sparse, and memory-only nodes have an empty CPU list.
+     */
+    static std::vector<ProcessInfo::NumaNode> getNumaNodes() {
+        std::vector<ProcessInfo::NumaNode> nodes;
+        boost::filesystem::path nodeRoot("/sys/devices/system/node");
+        if (!boost::filesystem::exists(nodeRoot))
+            return nodes;
+
+        for (const auto& entry : boost::filesystem::directory_iterator(nodeRoot)) {
+            unsigned id;
+            char trailing;
+            const auto name = entry.path().filename().string();
+            if (sscanf(name.c_str(), "node%u%c", &id, &trailing) != 1)
+                continue;
+
+            auto cpus = parseCpuList(readLineFromFile((entry.path() / "cpulist").c_str()));
+            if (!cpus.empty())
+                nodes.push_back({id, std::move(cpus)});
+        }
+        if (nodes.size() < 2)
+            nodes.clear();
+        std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) {
+            return a.id < b.id;
+        });
+        return nodes;
+    }
+
     /**
      * Get some details about the CPU
      */
@@ -602,6 +656,14 @@ void ProcessInfo::SystemInfo::collectSystemInfo() {
     pageSize = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
     cpuArch = unameData.machine;
     hasNuma = checkNumaEnabled();
+    try {
+        numaNodes = LinuxSysHelper::getNumaNodes();
+    } catch (boost::filesystem::filesystem_error& e) {
+        LOGV2(5190830,
+              "Cannot detect NUMA topology",
+              "path"_attr = e.path1().string(),
+              "error"_attr = e.code().message());
+    }
 
     BSONObjBuilder bExtra;
     bExtra.append("versionString", LinuxSysHelper::readLineFromFile("/proc/version"));
@@ -666,6 +728,34 @@ bool ProcessInfo::checkNumaEnabled() {
     return false;
 }
 
+bool ProcessInfo::bindCurrentThreadToNumaNode(size_t i) {
+    const auto& nodes = getNumaNodes();
+    if (i >= nodes.size())
+        return false;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpu : nodes[i].cpus)
+        CPU_SET(cpu, &cpuSet);
+    return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+}
+
+void ProcessInfo::appendNumaStats(BSONObjBuilder* builder) {
+    for (const auto& node : getNumaNodes()) {
+        BSONObjBuilder nodeBuilder(builder->subobjStart("node{}"_format(node.id)));
+        nodeBuilder.append("cpus", static_cast<int>(node.cpus.size()));
+
+        // Each line of numastat is a counter name followed by a number of pages, e.g.
+        // "numa_miss 1234". numa_miss and numa_foreign count allocations which were intended for
+        // one node but served from another.
+        std::ifstream numastat("/sys/devices/system/node/node{}/numastat"_format(node.id));
+        std::string name;
+        long long pages;
+        while (numastat >> name >> pages)
+            nodeBuilder.append(name, pages);
+    }
+}
+
 bool ProcessInfo::blockCheckSupported() {
     return true;
 }
@@ -65,4 +65,21 @@ TEST(ProcessInfo, GetNumAvailableCores) {
 TEST(ProcessInfo, GetNumCoresReturnsNonZeroNumberOfProcessors) {
     ASSERT_GREATER_THAN(ProcessInfo::getNumCores(), 0u);
 }
+
+TEST(ProcessInfo, NumaNodes) {
+    const auto& nodes = ProcessInfo::getNumaNodes();
+    if (nodes.empty()) {
+        ASSERT_FALSE(ProcessInfo::bindCurrentThreadToNumaNode(0));
+        return;
+    }
+
+    ASSERT_GREATER_THAN(nodes.size(), 1u);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        ASSERT_FALSE(nodes[i].cpus.empty());
+        if (i > 0) {
+            ASSERT_GREATER_THAN(nodes[i].id, nodes[i - 1].id);
+        }
+    }
+    ASSERT_FALSE(ProcessInfo::bindCurrentThreadToNumaNode(nodes.size()));
+}
 }  // namespace mongo_test